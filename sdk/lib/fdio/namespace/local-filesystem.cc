@@ -15,7 +15,6 @@
 #include <new>
 
 #include <fbl/auto_lock.h>
-#include <fbl/mutex.h>
 #include <fbl/ref_counted.h>
 #include <fbl/ref_ptr.h>
 #include <fbl/string.h>
@@ -120,7 +119,7 @@ zx_status_t fdio_namespace::WalkLocked(fbl::RefPtr<LocalVnode>* in_out_vn,
 zx::status<fdio_ptr> fdio_namespace::Open(fbl::RefPtr<LocalVnode> vn, std::string_view path,
                                           fio::wire::OpenFlags flags, uint32_t mode) const {
   {
-    fbl::AutoLock lock(&lock_);
+    fdio_internal::NamespaceSharedLock lock(&lock_);
     zx_status_t status = WalkLocked(&vn, &path);
     if (status != ZX_OK) {
       return zx::error(status);
@@ -146,7 +145,7 @@ zx::status<fdio_ptr> fdio_namespace::Open(fbl::RefPtr<LocalVnode> vn, std::strin
 zx_status_t fdio_namespace::AddInotifyFilter(fbl::RefPtr<LocalVnode> vn, std::string_view path,
                                              uint32_t mask, uint32_t watch_descriptor,
                                              zx::socket socket) const {
-  fbl::AutoLock lock(&lock_);
+  fdio_internal::NamespaceSharedLock lock(&lock_);
   zx_status_t status = WalkLocked(&vn, &path);
   if (status != ZX_OK) {
     return status;
@@ -168,7 +167,7 @@ zx_status_t fdio_namespace::AddInotifyFilter(fbl::RefPtr<LocalVnode> vn, std::st
 
 zx_status_t fdio_namespace::Readdir(const LocalVnode& vn, DirentIteratorState* state,
                                     zxio_dirent_t* inout_entry) const {
-  fbl::AutoLock lock(&lock_);
+  fdio_internal::NamespaceSharedLock lock(&lock_);
 
   auto populate_entry = [](zxio_dirent_t* inout_entry, std::string_view name) {
     if (name.size() > NAME_MAX) {
@@ -213,7 +212,7 @@ zx_status_t fdio_namespace::Connect(std::string_view path, fio::wire::OpenFlags
 
   fbl::RefPtr<LocalVnode> vn;
   {
-    fbl::AutoLock lock(&lock_);
+    fdio_internal::NamespaceSharedLock lock(&lock_);
     vn = root_;
     zx_status_t status = WalkLocked(&vn, &path);
     if (status != ZX_OK) {
@@ -314,7 +313,7 @@ bool fdio_namespace::IsBound(std::string_view path) {
   }
   path.remove_prefix(1);
 
-  fbl::AutoLock lock(&lock_);
+  fdio_internal::NamespaceSharedLock lock(&lock_);
   fbl::RefPtr<LocalVnode> vn = root_;
   zx_status_t status = WalkLocked(&vn, &path);
   if (status != ZX_OK) {
@@ -405,7 +404,7 @@ zx_status_t fdio_namespace::Bind(std::string_view path, fidl::ClientEnd<fio::Dir
 
 zx::status<fdio_ptr> fdio_namespace::OpenRoot() const {
   fbl::RefPtr<LocalVnode> vn = [this]() {
-    fbl::AutoLock lock(&lock_);
+    fdio_internal::NamespaceSharedLock lock(&lock_);
     return root_;
   }();
 
@@ -461,7 +460,7 @@ zx_status_t fdio_namespace::Export(fdio_flat_namespace_t** out) const {
   es.count = 0;
 
   fbl::RefPtr<LocalVnode> vn = [this]() {
-    fbl::AutoLock lock(&lock_);
+    fdio_internal::NamespaceSharedLock lock(&lock_);
     return root_;
   }();
 
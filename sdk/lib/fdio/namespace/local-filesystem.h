@@ -9,9 +9,11 @@
 #include <lib/fdio/namespace.h>
 #include <lib/zx/channel.h>
 #include <lib/zxio/zxio.h>
+#include <zircon/compiler.h>
+
+#include <shared_mutex>
 
 #include <fbl/macros.h>
-#include <fbl/mutex.h>
 #include <fbl/ref_counted.h>
 #include <fbl/ref_ptr.h>
 
@@ -21,7 +23,37 @@ struct fdio;
 
 namespace fdio_internal {
 struct DirentIteratorState;
-}
+
+// Lets lookups in the namespace proceed concurrently, since the namespace is rarely changed once a
+// process is running but may be walked by every |open()|.
+//
+// TODO(https://fxbug.dev/75544): Use std::shared_mutex directly once it has thread analysis
+// annotations.
+class __TA_CAPABILITY("shared_mutex") NamespaceMutex {
+ public:
+  void Acquire() __TA_ACQUIRE() { m_.lock(); }
+  void Release() __TA_RELEASE() { m_.unlock(); }
+  void AcquireShared() __TA_ACQUIRE_SHARED() { m_.lock_shared(); }
+  void ReleaseShared() __TA_RELEASE_SHARED() { m_.unlock_shared(); }
+
+ private:
+  std::shared_mutex m_;
+};
+
+class __TA_SCOPED_CAPABILITY NamespaceSharedLock {
+ public:
+  explicit NamespaceSharedLock(NamespaceMutex* m) __TA_ACQUIRE_SHARED(m) : m_(m) {
+    m_->AcquireShared();
+  }
+  ~NamespaceSharedLock() __TA_RELEASE() { m_->ReleaseShared(); }
+
+  DISALLOW_COPY_ASSIGN_AND_MOVE(NamespaceSharedLock);
+
+ private:
+  NamespaceMutex* m_;
+};
+
+}  // namespace fdio_internal
 
 // A local filesystem consisting of LocalVnodes, mapping string names
 // to remote handles.
@@ -98,9 +130,9 @@ struct fdio_namespace : public fbl::RefCounted<fdio_namespace> {
   //
   // |in_out_vn| and |in_out_path| are input and output parameters.
   zx_status_t WalkLocked(fbl::RefPtr<LocalVnode>* in_out_vn, std::string_view* in_out_path) const
-      __TA_REQUIRES(lock_);
+      __TA_REQUIRES_SHARED(lock_);
 
-  mutable fbl::Mutex lock_;
+  mutable fdio_internal::NamespaceMutex lock_;
   fbl::RefPtr<LocalVnode> root_ __TA_GUARDED(lock_);
 };
 
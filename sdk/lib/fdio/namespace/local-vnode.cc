@@ -54,7 +54,7 @@ void LocalVnode::Unlink() {
 // Returns a child if it has the name |name|.
 // Otherwise, returns nullptr.
 fbl::RefPtr<LocalVnode> LocalVnode::Lookup(std::string_view name) const {
-  auto it = entries_by_name_.find(fbl::String{name});
+  auto it = entries_by_name_.find(name);
   if (it != entries_by_name_.end()) {
     return it->node();
   }
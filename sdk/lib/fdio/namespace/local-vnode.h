@@ -12,6 +12,7 @@
 #include <limits.h>
 #include <zircon/types.h>
 
+#include <string_view>
 #include <utility>
 
 #include <fbl/intrusive_wavl_tree.h>
@@ -120,15 +121,18 @@ class LocalVnode : public fbl::RefCounted<LocalVnode> {
     static bool EqualTo(uint64_t key1, uint64_t key2) { return key1 == key2; }
   };
 
+  // Names are keyed by view so that lookups don't need to copy the name being looked up. The
+  // views refer to |LocalVnode::name_|, which never changes.
   struct KeyByNameTraits {
-    static fbl::String GetKey(const Entry& entry) { return entry.name(); }
-    static bool LessThan(const fbl::String& key1, const fbl::String& key2) { return key1 < key2; }
-    static bool EqualTo(const fbl::String& key1, const fbl::String& key2) { return key1 == key2; }
+    static std::string_view GetKey(const Entry& entry) { return entry.name(); }
+    static bool LessThan(std::string_view key1, std::string_view key2) { return key1 < key2; }
+    static bool EqualTo(std::string_view key1, std::string_view key2) { return key1 == key2; }
   };
 
   using EntryByIdMap =
       fbl::TaggedWAVLTree<uint64_t, std::unique_ptr<Entry>, IdTreeTag, KeyByIdTraits>;
-  using EntryByNameMap = fbl::TaggedWAVLTree<fbl::String, Entry*, NameTreeTag, KeyByNameTraits>;
+  using EntryByNameMap =
+      fbl::TaggedWAVLTree<std::string_view, Entry*, NameTreeTag, KeyByNameTraits>;
 
   uint64_t next_node_id_ = 1;
   EntryByIdMap entries_by_id_;
@@ -143,6 +143,46 @@ TEST(UnistdTest, LinkAtFollow) {
 #endif
 }
 
+// stat() and faccessat(F_OK) learn that the path can't be opened from the epitaph the server closes
+// the channel with, rather than from an OnOpen event.
+TEST(UnistdTest, StatErrors) {
+  char root_abs[] = "/tmp/fdio-stat.XXXXXX";
+  ASSERT_NOT_NULL(mkdtemp(root_abs), "%s", strerror(errno));
+  auto cleanup_root =
+      fit::defer([&root_abs]() { EXPECT_EQ(0, rmdir(root_abs), "%s", strerror(errno)); });
+  fbl::unique_fd root_fd(open(root_abs, O_RDONLY | O_DIRECTORY));
+  ASSERT_TRUE(root_fd, "%s", strerror(errno));
+
+  constexpr char file_name[] = "file";
+  ASSERT_TRUE(fbl::unique_fd(openat(root_fd.get(), file_name, O_CREAT | O_RDWR, 0666)), "%s",
+              strerror(errno));
+  auto cleanup_file = fit::defer([&root_fd, &file_name]() {
+    EXPECT_EQ(0, unlinkat(root_fd.get(), file_name, 0), "%s", strerror(errno));
+  });
+
+  const std::string file_abs = fxl::Concatenate({root_abs, "/", file_name});
+  struct stat s;
+  ASSERT_EQ(0, stat(file_abs.c_str(), &s), "%s", strerror(errno));
+  EXPECT_EQ(S_IFREG, s.st_mode & S_IFMT);
+  ASSERT_EQ(0, fstatat(root_fd.get(), file_name, &s, 0), "%s", strerror(errno));
+  EXPECT_EQ(S_IFREG, s.st_mode & S_IFMT);
+  EXPECT_EQ(0, faccessat(root_fd.get(), file_name, F_OK, 0), "%s", strerror(errno));
+
+  const std::string missing_abs = fxl::Concatenate({root_abs, "/", "missing"});
+  ASSERT_EQ(-1, stat(missing_abs.c_str(), &s));
+  EXPECT_EQ(ENOENT, errno, "%s", strerror(errno));
+  ASSERT_EQ(-1, fstatat(root_fd.get(), "missing", &s, 0));
+  EXPECT_EQ(ENOENT, errno, "%s", strerror(errno));
+  ASSERT_EQ(-1, faccessat(root_fd.get(), "missing", F_OK, 0));
+  EXPECT_EQ(ENOENT, errno, "%s", strerror(errno));
+
+  const std::string under_file_abs = fxl::Concatenate({file_abs, "/", "x"});
+  ASSERT_EQ(-1, stat(under_file_abs.c_str(), &s));
+  EXPECT_EQ(ENOTDIR, errno, "%s", strerror(errno));
+  ASSERT_EQ(-1, faccessat(AT_FDCWD, under_file_abs.c_str(), F_OK, 0));
+  EXPECT_EQ(ENOTDIR, errno, "%s", strerror(errno));
+}
+
 TEST(UnistdTest, ReadAndWriteWithNegativeOffsets) {
   const char* filename = "/tmp/read-write-with-negative-offsets-test";
   fbl::unique_fd fd(open(filename, O_CREAT | O_RDWR, 0666));
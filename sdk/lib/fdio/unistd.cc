@@ -14,6 +14,7 @@
 #include <lib/fdio/unsafe.h>
 #include <lib/fdio/vfs.h>
 #include <lib/stdcompat/string_view.h>
+#include <lib/zx/clock.h>
 #include <lib/zxio/posix_mode.h>
 #include <lib/zxio/types.h>
 #include <poll.h>
@@ -33,7 +34,9 @@
 #include <zircon/processargs.h>
 #include <zircon/syscalls.h>
 
+#include <algorithm>
 #include <cstdarg>
+#include <optional>
 #include <thread>
 #include <utility>
 #include <variant>
@@ -551,6 +554,40 @@ static zx_status_t fdio_stat(const fdio_ptr& io, struct stat* s) {
   return ZX_OK;
 }
 
+// Stats |path| relative to |dirfd| in a single round trip.
+//
+// The node is opened without waiting for the server to describe it, and its attributes are
+// requested on the new channel straight away. The server handles the two requests in order, so
+// this saves waiting for the open to complete before asking for the attributes.
+static zx_status_t fdio_stat_at(int dirfd, const char* path, struct stat* s) {
+  const fio::wire::OpenFlags flags =
+      fdio_flags_to_zxio(O_PATH) & ~fio::wire::OpenFlags::kDescribe;
+  zx::status io = fdio_internal::open_at_impl(dirfd, path, flags, 0,
+                                              {
+                                                  .disallow_directory = false,
+                                                  .allow_absolute_path = true,
+                                              });
+  if (io.is_error()) {
+    return io.status_value();
+  }
+  zx_status_t status = fdio_stat(io.value(), s);
+  if (status == ZX_ERR_PEER_CLOSED) {
+    // Without |kDescribe|, a failure to open is reported by closing the channel with an epitaph,
+    // which is left behind in the channel by the failed call.
+    zx_handle_t channel;
+    if (io->borrow_channel(&channel) == ZX_OK) {
+      fidl_epitaph_t epitaph;
+      uint32_t actual_bytes;
+      if (zx_channel_read(channel, 0, &epitaph, nullptr, sizeof(epitaph), 0, &actual_bytes,
+                          nullptr) == ZX_OK &&
+          actual_bytes == sizeof(epitaph) && epitaph.hdr.ordinal == kFidlOrdinalEpitaph) {
+        status = epitaph.error;
+      }
+    }
+  }
+  return status;
+}
+
 // The functions from here on provide implementations of fd and path
 // centric posix-y io operations.
 
@@ -1144,11 +1181,7 @@ int fstat(int fd, struct stat* s) {
 }
 
 int fstatat(int dirfd, std::string_view filename, struct stat* s, int flags) {
-  zx::status io = fdio_internal::open_at(dirfd, filename.data(), O_PATH, 0);
-  if (io.is_error()) {
-    return ERROR(io.status_value());
-  }
-  return STATUS(fdio_stat(io.value(), s));
+  return STATUS(fdio_stat_at(dirfd, filename.data(), s));
 }
 
 __EXPORT
@@ -1344,12 +1377,8 @@ int faccessat(int dirfd, const char* filename, int amode, int flag) {
 
   if (amode == F_OK) {
     // Check that the file exists a la fstatat.
-    zx::status io = fdio_internal::open_at(dirfd, filename, O_PATH, 0);
-    if (io.is_error()) {
-      return ERROR(io.status_value());
-    }
     struct stat s;
-    return STATUS(fdio_stat(io.value(), &s));
+    return STATUS(fdio_stat_at(dirfd, filename, &s));
   }
 
   // Check that the file has each of the permissions in mode.
@@ -1938,12 +1967,9 @@ ssize_t recvfrom(int fd, void* __restrict buf, size_t buflen, int flags,
   return n;
 }
 
-__EXPORT
-ssize_t sendmsg(int fd, const struct msghdr* msg, int flags) {
-  const fdio_ptr io = fd_to_io(fd);
-  if (io == nullptr) {
-    return ERRNO(EBADF);
-  }
+// Sends |msg| through |io|. Shared by sendmsg and sendmmsg so that the latter only resolves its
+// file descriptor once.
+static ssize_t fdio_sendmsg(const fdio_ptr& io, const struct msghdr* msg, int flags) {
   auto& ioflag = io->ioflag();
   // The |flags| are typically used to express intent *not* to issue SIGPIPE
   // via MSG_NOSIGNAL. Applications use this frequently to avoid having to
@@ -1985,12 +2011,9 @@ ssize_t sendmsg(int fd, const struct msghdr* msg, int flags) {
   }
 }
 
-__EXPORT
-ssize_t recvmsg(int fd, struct msghdr* msg, int flags) {
-  const fdio_ptr io = fd_to_io(fd);
-  if (io == nullptr) {
-    return ERRNO(EBADF);
-  }
+// Receives into |msg| from |io|. Shared by recvmsg and recvmmsg so that the latter only resolves
+// its file descriptor once.
+static ssize_t fdio_recvmsg(const fdio_ptr& io, struct msghdr* msg, int flags) {
   auto& ioflag = io->ioflag();
   const bool blocking = ((ioflag & IOFLAG_NONBLOCK) | (flags & MSG_DONTWAIT)) == 0;
   flags &= ~MSG_DONTWAIT;
@@ -2026,6 +2049,95 @@ ssize_t recvmsg(int fd, struct msghdr* msg, int flags) {
   }
 }
 
+__EXPORT
+ssize_t sendmsg(int fd, const struct msghdr* msg, int flags) {
+  const fdio_ptr io = fd_to_io(fd);
+  if (io == nullptr) {
+    return ERRNO(EBADF);
+  }
+  return fdio_sendmsg(io, msg, flags);
+}
+
+__EXPORT
+ssize_t recvmsg(int fd, struct msghdr* msg, int flags) {
+  const fdio_ptr io = fd_to_io(fd);
+  if (io == nullptr) {
+    return ERRNO(EBADF);
+  }
+  return fdio_recvmsg(io, msg, flags);
+}
+
+// Like Linux, sendmmsg and recvmmsg report an error only if it happens on the first message.
+// Otherwise they return the number of messages transferred, and an error which persists is reported
+// by the next call.
+__EXPORT
+int sendmmsg(int fd, struct mmsghdr* msgvec, unsigned int vlen, unsigned int flags) {
+  const fdio_ptr io = fd_to_io(fd);
+  if (io == nullptr) {
+    return ERRNO(EBADF);
+  }
+  vlen = std::min(vlen, static_cast<unsigned int>(UIO_MAXIOV));
+  unsigned int sent = 0;
+  for (; sent < vlen; ++sent) {
+    const int saved_errno = errno;
+    const ssize_t n = fdio_sendmsg(io, &msgvec[sent].msg_hdr, static_cast<int>(flags));
+    if (n < 0) {
+      if (sent == 0) {
+        return -1;
+      }
+      errno = saved_errno;
+      break;
+    }
+    msgvec[sent].msg_len = static_cast<unsigned int>(n);
+  }
+  return static_cast<int>(sent);
+}
+
+__EXPORT
+int recvmmsg(int fd, struct mmsghdr* msgvec, unsigned int vlen, unsigned int flags,
+             struct timespec* timeout) {
+  const fdio_ptr io = fd_to_io(fd);
+  if (io == nullptr) {
+    return ERRNO(EBADF);
+  }
+  std::optional<zx::time> deadline;
+  if (timeout != nullptr) {
+    if (timeout->tv_sec < 0 || timeout->tv_nsec < 0 || timeout->tv_nsec >= ZX_SEC(1)) {
+      return ERRNO(EINVAL);
+    }
+    deadline = zx::deadline_after(zx::sec(timeout->tv_sec) + zx::nsec(timeout->tv_nsec));
+  }
+  vlen = std::min(vlen, static_cast<unsigned int>(UIO_MAXIOV));
+  int msg_flags = static_cast<int>(flags & ~MSG_WAITFORONE);
+  unsigned int received = 0;
+  while (received < vlen) {
+    const int saved_errno = errno;
+    const ssize_t n = fdio_recvmsg(io, &msgvec[received].msg_hdr, msg_flags);
+    if (n < 0) {
+      if (received == 0) {
+        return -1;
+      }
+      errno = saved_errno;
+      break;
+    }
+    msgvec[received++].msg_len = static_cast<unsigned int>(n);
+    if (flags & MSG_WAITFORONE) {
+      msg_flags |= MSG_DONTWAIT;
+    }
+    // As on Linux, the timeout is only checked after each message is received.
+    if (deadline.has_value() && zx::clock::get_monotonic() >= deadline.value()) {
+      break;
+    }
+  }
+  if (deadline.has_value()) {
+    const zx::duration remaining =
+        std::max(deadline.value() - zx::clock::get_monotonic(), zx::duration());
+    timeout->tv_sec = remaining.to_secs();
+    timeout->tv_nsec = (remaining - zx::sec(remaining.to_secs())).to_nsecs();
+  }
+  return static_cast<int>(received);
+}
+
 __EXPORT
 int shutdown(int fd, int how) {
   const fdio_ptr io = fd_to_io(fd);
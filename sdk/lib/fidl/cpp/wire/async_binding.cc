@@ -9,6 +9,7 @@
 #include <lib/fidl/cpp/wire/async_transaction.h>
 #include <lib/fidl/cpp/wire/client_base.h>
 #include <lib/fidl/cpp/wire/internal/transport.h>
+#include <lib/fidl/cpp/wire/internal/transport_channel.h>
 #include <lib/fidl/epitaph.h>
 #include <lib/fidl/trace.h>
 #include <zircon/assert.h>
@@ -63,23 +64,39 @@ void AsyncBinding::MessageHandler(fidl::IncomingHeaderAndMessage& msg,
   ScopedThreadGuard guard(thread_checker_);
   ZX_ASSERT(keep_alive_);
 
-  // Flag indicating whether this thread still has access to the binding.
-  bool next_wait_begun_early = false;
-  // Dispatch the message.
-  std::optional<DispatchError> maybe_error = Dispatch(msg, &next_wait_begun_early, storage_view);
-  // If |next_wait_begun_early| is true, then the interest for the next
-  // message had been eagerly registered in the method handler, and another
-  // thread may already be running |MessageHandler|. We should exit without
-  // attempting to register yet another wait or attempting to modify the
-  // binding state here.
-  if (next_wait_begun_early)
-    return;
-
-  // If there was any error enabling dispatch or an unexpected message, destroy the binding.
-  if (maybe_error) {
-    if (maybe_error->RequiresImmediateTeardown()) {
-      return PerformTeardown(maybe_error->info);
+  const uint32_t max_messages = max_messages_per_wakeup_.load(std::memory_order_relaxed);
+  for (uint32_t dispatched = 1;; dispatched++) {
+    // Flag indicating whether this thread still has access to the binding.
+    bool next_wait_begun_early = false;
+    // Dispatch the message.
+    std::optional<DispatchError> maybe_error = Dispatch(msg, &next_wait_begun_early, storage_view);
+    // If |next_wait_begun_early| is true, then the interest for the next
+    // message had been eagerly registered in the method handler, and another
+    // thread may already be running |MessageHandler|. We should exit without
+    // attempting to register yet another wait or attempting to modify the
+    // binding state here.
+    if (next_wait_begun_early)
+      return;
+
+    // If there was any error enabling dispatch or an unexpected message, destroy the binding.
+    if (maybe_error) {
+      if (maybe_error->RequiresImmediateTeardown()) {
+        return PerformTeardown(maybe_error->info);
+      }
     }
+
+    if (dispatched == max_messages)
+      break;
+
+    // Dispatch the next message right away if one is already pending. The
+    // storage of the message that was just dispatched is no longer in use.
+    zx_status_t status = CheckForTeardownAndReadNextMessage(msg, storage_view);
+    if (status == ZX_ERR_CANCELED)
+      return PerformTeardown(std::nullopt);
+    if (status == ZX_ERR_SHOULD_WAIT)
+      break;
+    if (!msg.ok())
+      return PerformTeardown(fidl::UnbindInfo{msg});
   }
 
   if (CheckForTeardownAndBeginNextWait() != ZX_OK)
@@ -170,6 +187,33 @@ zx_status_t AsyncBinding::CheckForTeardownAndBeginNextWait() {
   }
 }
 
+zx_status_t AsyncBinding::CheckForTeardownAndReadNextMessage(
+    fidl::IncomingHeaderAndMessage& msg, internal::MessageStorageViewBase* storage_view) {
+  std::scoped_lock lock(lock_);
+
+  switch (lifecycle_.state()) {
+    case Lifecycle::kMustTeardown:
+      return ZX_ERR_CANCELED;
+
+    case Lifecycle::kBound: {
+      if (transport_.type() != FIDL_TRANSPORT_TYPE_CHANNEL)
+        return ZX_ERR_SHOULD_WAIT;
+      auto* channel_storage_view = static_cast<ChannelMessageStorageView*>(storage_view);
+      fidl_trace(WillLLCPPAsyncChannelRead);
+      msg = fidl::MessageRead(transport_.get<ChannelTransport>(), *channel_storage_view);
+      if (!msg.ok())
+        return msg.reason() == fidl::Reason::kTransportError ? ZX_ERR_SHOULD_WAIT : ZX_OK;
+      fidl_trace(DidLLCPPAsyncChannelRead, nullptr /* type */, channel_storage_view->bytes.data,
+                 msg.byte_actual(), msg.handle_actual());
+      return ZX_OK;
+    }
+
+    default:
+      // Other lifecycle states are illegal.
+      __builtin_abort();
+  }
+}
+
 void AsyncBinding::HandleError(std::shared_ptr<AsyncBinding>&& calling_ref, DispatchError error) {
   if (error.RequiresImmediateTeardown()) {
     StartTeardownWithInfo(std::move(calling_ref), error.info);
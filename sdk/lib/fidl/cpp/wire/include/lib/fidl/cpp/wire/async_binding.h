@@ -22,6 +22,7 @@
 #include <lib/zx/channel.h>
 #include <zircon/fidl.h>
 
+#include <atomic>
 #include <mutex>
 #include <optional>
 #include <variant>
@@ -125,6 +126,19 @@ class AsyncBinding : public std::enable_shared_from_this<AsyncBinding> {
   // event loop, or has already torn down and pending deletion.
   bool IsDestructionImminent() const __TA_EXCLUDES(lock_);
 
+  // Sets the number of messages the binding may dispatch each time the
+  // dispatcher reports the transport readable. After dispatching a message,
+  // the binding reads the next one directly rather than waiting for the
+  // dispatcher again, until this many messages have been dispatched or none
+  // are pending. This saves a wait per message for pipelining peers, at the
+  // cost of fairness towards other work on the same dispatcher.
+  //
+  // Defaults to 1. Only applies to Zircon channel transports.
+  void set_max_messages_per_wakeup(uint32_t max_messages) {
+    ZX_ASSERT(max_messages > 0);
+    max_messages_per_wakeup_.store(max_messages, std::memory_order_relaxed);
+  }
+
  protected:
   AsyncBinding(async_dispatcher_t* dispatcher, internal::AnyUnownedTransport transport,
                ThreadingPolicy threading_policy);
@@ -143,6 +157,20 @@ class AsyncBinding : public std::enable_shared_from_this<AsyncBinding> {
 
   void WaitFailureHandler(UnbindInfo info) __TA_EXCLUDES(thread_checker_) __TA_EXCLUDES(lock_);
 
+  // Checks for the need to teardown and reads the next message pending on the
+  // transport into |msg| in one critical section:
+  //
+  // - If we are already in |Lifecycle::MustTeardown|, returns
+  //   |ZX_ERR_CANCELED|.
+  // - If no message could be read, returns |ZX_ERR_SHOULD_WAIT|. The message
+  //   handler should wait for the next message as usual; errors such as the
+  //   peer having closed are reported by the waiter.
+  // - Otherwise, returns |ZX_OK|. |msg| may still hold an error if the message
+  //   was malformed.
+  zx_status_t CheckForTeardownAndReadNextMessage(fidl::IncomingHeaderAndMessage& msg,
+                                                 internal::MessageStorageViewBase* storage_view)
+      __TA_EXCLUDES(lock_);
+
   // Dispatches a generic incoming message.
   //
   // ## Message ownership
@@ -232,6 +260,9 @@ class AsyncBinding : public std::enable_shared_from_this<AsyncBinding> {
   // The bound transport.
   AnyUnownedTransport transport_;
 
+  // See |set_max_messages_per_wakeup|.
+  std::atomic<uint32_t> max_messages_per_wakeup_ = 1;
+
   // Storage for a |TransportWaiter|, which waits for messages and calls back
   // into |AsyncBinding| when they are received, or if the channel is closed.
   AnyTransportWaiter any_transport_waiter_;
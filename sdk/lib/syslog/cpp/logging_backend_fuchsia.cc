@@ -336,6 +336,12 @@ class LogState {
 
   syslog::LogSeverity min_severity() const { return min_severity_; }
 
+  // Also publishes |severity| for |GetMinLogLevel|.
+  void set_min_severity(syslog::LogSeverity severity) {
+    min_severity_ = severity;
+    SetMinSeverity(severity);
+  }
+
   const std::string* tags() const { return tags_; }
   size_t tag_count() const { return num_tags_; }
   // Allowed to be const because descriptor_ is mutable
@@ -436,9 +442,9 @@ void LogState::HandleInterest() {
       [=](fuchsia::logger::LogSink_WaitForInterestChange_Result interest_result) {
         auto interest = std::move(interest_result.response().data);
         if (!interest.has_min_severity()) {
-          min_severity_ = default_severity_;
+          set_min_severity(default_severity_);
         } else {
-          min_severity_ = IntoLogSeverity(interest.min_severity());
+          set_min_severity(IntoLogSeverity(interest.min_severity()));
         }
         handler_(handler_context_, min_severity_);
         HandleInterest();
@@ -786,7 +792,7 @@ LogState::LogState(const syslog::LogSettings& in_settings,
   interest_listener_dispatcher_ =
       static_cast<async_dispatcher_t*>(settings.single_threaded_dispatcher);
   serve_interest_listener_ = !settings.disable_interest_listener;
-  min_severity_ = in_settings.min_log_level;
+  set_min_severity(in_settings.min_log_level);
 
   std::ostringstream tag_str;
 
@@ -817,6 +823,12 @@ void SetLogSettings(const syslog::LogSettings& settings,
 }
 
 syslog::LogSeverity GetMinLogLevel() {
+  // Severity checks guard every log statement, so avoid acquiring the state
+  // unless it has yet to be initialized.
+  syslog::LogSeverity severity;
+  if (GetMinSeverity(&severity)) {
+    return severity;
+  }
   GlobalStateLock lock;
   return lock->min_severity();
 }
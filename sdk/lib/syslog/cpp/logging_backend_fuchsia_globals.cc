@@ -16,6 +16,9 @@
 namespace {
 
 std::atomic<uint32_t> dropped_count = std::atomic<uint32_t>(0);
+// Outside of the range of severities while no state has published one.
+constexpr int32_t kMinSeverityUnset = INT32_MIN;
+std::atomic<int32_t> min_severity = std::atomic<int32_t>(kMinSeverityUnset);
 syslog_backend::LogState* state = nullptr;
 std::mutex state_lock;
 // This thread's koid.
@@ -58,4 +61,17 @@ uint32_t GetAndResetDropped() { return dropped_count.exchange(0, std::memory_ord
 EXPORT
 void AddDropped(uint32_t count) { dropped_count.fetch_add(count, std::memory_order_relaxed); }
 
+EXPORT
+bool GetMinSeverity(int8_t* out_severity) {
+  int32_t severity = min_severity.load(std::memory_order_relaxed);
+  if (severity == kMinSeverityUnset) {
+    return false;
+  }
+  *out_severity = static_cast<int8_t>(severity);
+  return true;
+}
+
+EXPORT
+void SetMinSeverity(int8_t severity) { min_severity.store(severity, std::memory_order_relaxed); }
+
 }  // extern "C"
@@ -29,6 +29,14 @@ void AddDropped(uint32_t count);
 
 zx_koid_t GetCurrentThreadKoid();
 
+// The minimum severity of the current state is also published here, so that it
+// can be checked without acquiring the state.
+//
+// Returns false if no state has published a severity yet.
+bool GetMinSeverity(int8_t* out_severity);
+
+void SetMinSeverity(int8_t severity);
+
 }  // extern "C"
 
 #endif  // LIB_SYSLOG_CPP_LOGGING_BACKEND_FUCHSIA_GLOBALS_H_
@@ -37,10 +37,10 @@ zx_status_t PseudoDir::AddEntry(std::unique_ptr<Entry> entry) {
 
   std::lock_guard<std::mutex> guard(mutex_);
 
-  if (entries_by_name_.find(entry->name()) != entries_by_name_.end()) {
+  // The key refers to the name owned by the entry.
+  if (!entries_by_name_.emplace(entry->name(), entry.get()).second) {
     return ZX_ERR_ALREADY_EXISTS;
   }
-  entries_by_name_[entry->name()] = entry.get();
   auto id = entry->id();
   entries_by_id_.emplace_hint(entries_by_id_.end(), id, std::move(entry));
 
@@ -53,8 +53,10 @@ zx_status_t PseudoDir::RemoveEntry(const std::string& name) {
   if (entry == entries_by_name_.end()) {
     return ZX_ERR_NOT_FOUND;
   }
-  entries_by_id_.erase(entry->second->id());
-  entries_by_name_.erase(name);
+  // Erase the name first; its key refers to the name owned by the entry.
+  auto id = entry->second->id();
+  entries_by_name_.erase(entry);
+  entries_by_id_.erase(id);
 
   return ZX_OK;
 }
@@ -65,8 +67,10 @@ zx_status_t PseudoDir::RemoveEntry(const std::string& name, Node* node) {
   if (entry == entries_by_name_.end() || entry->second->node() != node) {
     return ZX_ERR_NOT_FOUND;
   }
-  entries_by_id_.erase(entry->second->id());
-  entries_by_name_.erase(name);
+  // Erase the name first; its key refers to the name owned by the entry.
+  auto id = entry->second->id();
+  entries_by_name_.erase(entry);
+  entries_by_id_.erase(id);
 
   return ZX_OK;
 }
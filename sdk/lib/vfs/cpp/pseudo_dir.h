@@ -7,8 +7,10 @@
 
 #include <lib/vfs/cpp/internal/directory.h>
 
+#include <functional>
 #include <map>
 #include <mutex>
+#include <string_view>
 
 namespace vfs {
 
@@ -127,8 +129,8 @@ class PseudoDir : public vfs::internal::Directory {
   // for enumeration
   std::map<uint64_t, std::unique_ptr<Entry>> entries_by_id_ __TA_GUARDED(mutex_);
 
-  // for lookup
-  std::map<std::string, Entry*> entries_by_name_ __TA_GUARDED(mutex_);
+  // for lookup, keyed by the names owned by the entries
+  std::map<std::string_view, Entry*, std::less<>> entries_by_name_ __TA_GUARDED(mutex_);
 };
 
 }  // namespace vfs
@@ -11,6 +11,8 @@
 #include <lib/zxio/cpp/socket_address.h>
 #include <zircon/types.h>
 
+#include <iterator>
+#include <mutex>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -60,12 +62,43 @@ bool RequestedCmsgSet::ipv6_pktinfo() const {
 
 // TODO(https://fxbug.dev/97260): Implement cache eviction strategy to avoid unbounded cache
 // growth.
+std::optional<RequestedCmsgSet> RequestedCmsgCache::GetValid(const zx_wait_item_t& err_wait_item) {
+  if (!cache_.has_value()) {
+    return std::nullopt;
+  }
+  zx_wait_item_t wait_items[] = {
+      err_wait_item,
+      {
+          .handle = cache_.value().validity.get(),
+          .waitfor = ZX_EVENTPAIR_PEER_CLOSED,
+      },
+  };
+  if (zx::handle::wait_many(wait_items, std::size(wait_items), zx::time::infinite_past()) !=
+      ZX_ERR_TIMED_OUT) {
+    return std::nullopt;
+  }
+  return cache_.value().requested_cmsg_set;
+}
+
 using RequestedCmsgResult = fitx::result<ErrOrOutCode, std::optional<RequestedCmsgSet>>;
 RequestedCmsgResult RequestedCmsgCache::Get(zx_wait_item_t err_wait_item,
                                             bool get_requested_cmsg_set,
                                             fidl::WireSyncClient<fsocket::DatagramSocket>& client) {
-  // TODO(https://fxbug.dev/103653): Circumvent fast-path pessimization caused by lock
-  // contention between multiple fast paths.
+  // Fast path: no error is pending and, if it was asked for, the cached set is still valid.
+  if (!get_requested_cmsg_set) {
+    // Nothing in the cache is needed, so don't take the lock at all.
+    zx_wait_item_t wait_item = err_wait_item;
+    if (zx::handle::wait_many(&wait_item, 1, zx::time::infinite_past()) == ZX_ERR_TIMED_OUT) {
+      return fitx::ok(std::nullopt);
+    }
+  } else {
+    DgramSharedLock lock(lock_);
+    if (std::optional requested_cmsg_set = GetValid(err_wait_item);
+        requested_cmsg_set.has_value()) {
+      return fitx::ok(requested_cmsg_set);
+    }
+  }
+
   std::lock_guard lock(lock_);
 
   constexpr size_t MAX_WAIT_ITEMS = 2;
@@ -172,6 +205,49 @@ size_t RouteCache::KeyHasher::operator()(const Key& k) const {
   return h;
 }
 
+const RouteCache::Value* RouteCache::Find(const Key& key) {
+  // Senders usually send to the same destination over and over, skip hashing the key then.
+  if (last_found_.has_value() && last_found_.value()->first == key) {
+    return &last_found_.value()->second;
+  }
+  auto it = cache_.find(key);
+  if (it == cache_.end()) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+const RouteCache::Value* RouteCache::FindAndRemember(const Key& key) {
+  auto it = cache_.find(key);
+  if (it == cache_.end()) {
+    return nullptr;
+  }
+  last_found_ = it;
+  return &it->second;
+}
+
+std::optional<uint32_t> RouteCache::GetValid(const Key& key, const zx_wait_item_t& err_wait_item) {
+  const Value* value = Find(key);
+  if (value == nullptr || value->eventpairs.size() + 1 > ZX_WAIT_MANY_MAX_ITEMS) {
+    return std::nullopt;
+  }
+  zx_wait_item_t wait_items[ZX_WAIT_MANY_MAX_ITEMS];
+  wait_items[0] = err_wait_item;
+  uint32_t num_wait_items = 1;
+  for (const zx::eventpair& eventpair : value->eventpairs) {
+    wait_items[num_wait_items] = {
+        .handle = eventpair.get(),
+        .waitfor = ZX_EVENTPAIR_PEER_CLOSED,
+    };
+    num_wait_items++;
+  }
+  if (zx::handle::wait_many(wait_items, num_wait_items, zx::time::infinite_past()) !=
+      ZX_ERR_TIMED_OUT) {
+    return std::nullopt;
+  }
+  return value->maximum_size;
+}
+
 // TODO(https://fxbug.dev/97260): Implement cache eviction strategy to avoid unbounded cache
 // growth.
 using RouteCacheResult = fitx::result<ErrOrOutCode, uint32_t>;
@@ -179,8 +255,26 @@ RouteCacheResult RouteCache::Get(
     std::optional<SocketAddress>& remote_addr,
     const std::optional<std::pair<uint64_t, fuchsia_net::wire::Ipv6Address>>& local_iface_and_addr,
     const zx_wait_item_t& err_wait_item, fidl::WireSyncClient<fsocket::DatagramSocket>& client) {
+  // Fast path: the route is cached, still valid, and no error is pending.
+  {
+    DgramSharedLock lock(lock_);
+    const std::optional<SocketAddress>& addr_to_lookup =
+        remote_addr.has_value() ? remote_addr : connected_;
+    if (addr_to_lookup.has_value()) {
+      if (std::optional maximum_size = GetValid(
+              {
+                  .remote_addr = addr_to_lookup.value(),
+                  .local_iface_and_addr = local_iface_and_addr,
+              },
+              err_wait_item);
+          maximum_size.has_value()) {
+        return fitx::success(maximum_size.value());
+      }
+    }
+  }
+
   // TODO(https://fxbug.dev/103653): Circumvent fast-path pessimization caused by lock
-  // contention 1) between multiple fast paths and 2) between fast path and slow path.
+  // contention between fast path and slow path.
   std::lock_guard lock(lock_);
 
   zx_wait_item_t wait_items[ZX_WAIT_MANY_MAX_ITEMS];
@@ -201,12 +295,12 @@ RouteCacheResult RouteCache::Get(
     // TODO(https://fxbug.dev/103655): Test errors are returned when connected
     // addr looked up for the first time.
     if (addr_to_lookup.has_value()) {
-      if (auto it = cache_.find({
+      if (const Value* found = FindAndRemember({
               .remote_addr = addr_to_lookup.value(),
               .local_iface_and_addr = local_iface_and_addr,
           });
-          it != cache_.end()) {
-        const Value& value = it->second;
+          found != nullptr) {
+        const Value& value = *found;
         ZX_ASSERT_MSG(value.eventpairs.size() + 1 <= ZX_WAIT_MANY_MAX_ITEMS,
                       "number of wait_items (%lu) exceeds maximum allowed (%zu)",
                       value.eventpairs.size() + 1, ZX_WAIT_MANY_MAX_ITEMS);
@@ -293,13 +387,16 @@ RouteCacheResult RouteCache::Get(
     eventpairs.reserve(res.validity().count());
     std::move(res.validity().begin(), res.validity().end(), std::back_inserter(eventpairs));
 
-    cache_[{
-        .remote_addr = addr_to_store.value(),
-        .local_iface_and_addr = local_iface_and_addr,
-    }] = {
-        .eventpairs = std::move(eventpairs),
-        .maximum_size = res.maximum_size(),
-    };
+    auto [it, inserted] = cache_.insert_or_assign(
+        Key{
+            .remote_addr = addr_to_store.value(),
+            .local_iface_and_addr = local_iface_and_addr,
+        },
+        Value{
+            .eventpairs = std::move(eventpairs),
+            .maximum_size = res.maximum_size(),
+        });
+    last_found_ = it;
 
     if (!remote_addr.has_value()) {
       connected_ = addr_to_store.value();
@@ -9,10 +9,12 @@
 #include <lib/fitx/result.h>
 #include <lib/zx/eventpair.h>
 #include <lib/zxio/cpp/socket_address.h>
+#include <zircon/compiler.h>
 #include <zircon/types.h>
 
 #include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <unordered_map>
 
 using ErrOrOutCode = zx::status<int16_t>;
@@ -24,6 +26,31 @@ struct hash<SocketAddress> {
 };
 }  // namespace std
 
+// TODO(https://fxbug.dev/75544): Get rid of these classes once std::shared_mutex and
+// std::shared_lock have thread analysis annotations.
+class __TA_CAPABILITY("shared_mutex") DgramSharedMutex {
+ public:
+  void lock() __TA_ACQUIRE() { m_.lock(); }
+  void unlock() __TA_RELEASE() { m_.unlock(); }
+  void lock_shared() __TA_ACQUIRE_SHARED() { m_.lock_shared(); }
+  void unlock_shared() __TA_RELEASE_SHARED() { m_.unlock_shared(); }
+
+ private:
+  std::shared_mutex m_;
+};
+
+class __TA_SCOPED_CAPABILITY DgramSharedLock {
+ public:
+  explicit DgramSharedLock(DgramSharedMutex& m) __TA_ACQUIRE_SHARED(m) : m_(m) { m_.lock_shared(); }
+  ~DgramSharedLock() __TA_RELEASE() { m_.unlock_shared(); }
+
+  DgramSharedLock(const DgramSharedLock&) = delete;
+  DgramSharedLock& operator=(const DgramSharedLock&) = delete;
+
+ private:
+  DgramSharedMutex& m_;
+};
+
 class RequestedCmsgSet {
  public:
   explicit RequestedCmsgSet(
@@ -49,6 +76,10 @@ class RequestedCmsgSet {
   std::optional<fuchsia_posix_socket::wire::TimestampOption> so_timestamp_filter_;
 };
 
+// Caches the set of control messages requested on a socket.
+//
+// Lookups only hold |lock_| shared, so concurrent receivers don't contend with each other unless
+// the cached set has to be fetched from the netstack again.
 class RequestedCmsgCache {
  public:
   using Result = fitx::result<ErrOrOutCode, std::optional<RequestedCmsgSet>>;
@@ -60,10 +91,19 @@ class RequestedCmsgCache {
     zx::eventpair validity;
     RequestedCmsgSet requested_cmsg_set;
   };
+
+  // Returns the cached set if it is still valid and no error is pending on the socket.
+  std::optional<RequestedCmsgSet> GetValid(const zx_wait_item_t& err_wait_item)
+      __TA_REQUIRES_SHARED(lock_);
+
   std::optional<Value> cache_ __TA_GUARDED(lock_);
-  std::mutex lock_;
+  DgramSharedMutex lock_;
 };
 
+// Caches the maximum payload size of routes to the destinations a socket sends to.
+//
+// Lookups only hold |lock_| shared, so concurrent senders don't contend with each other unless a
+// route has to be (re)validated with the netstack.
 class RouteCache {
  public:
   using Result = fitx::result<ErrOrOutCode, uint32_t>;
@@ -89,9 +129,25 @@ class RouteCache {
     uint32_t maximum_size;
   };
 
-  std::unordered_map<Key, Value, KeyHasher> cache_ __TA_GUARDED(lock_);
+  using Map = std::unordered_map<Key, Value, KeyHasher>;
+
+  // Looks |key| up, comparing it against the entry found last before hashing it.
+  const Value* Find(const Key& key) __TA_REQUIRES_SHARED(lock_);
+
+  // Like |Find|, but also remembers the entry found for the lookups that follow.
+  const Value* FindAndRemember(const Key& key) __TA_REQUIRES(lock_);
+
+  // Returns the cached maximum size of the route to |key| if the route is still valid and no error
+  // is pending on the socket.
+  std::optional<uint32_t> GetValid(const Key& key, const zx_wait_item_t& err_wait_item)
+      __TA_REQUIRES_SHARED(lock_);
+
+  Map cache_ __TA_GUARDED(lock_);
   std::optional<SocketAddress> connected_ __TA_GUARDED(lock_);
-  std::mutex lock_;
+  // The entry found or stored last with |lock_| held exclusively. Inserting into |cache_| may
+  // rehash it, which invalidates its iterators, so this is replaced on every insertion.
+  std::optional<Map::const_iterator> last_found_ __TA_GUARDED(lock_);
+  DgramSharedMutex lock_;
 };
 
 std::optional<ErrOrOutCode> GetErrorWithClient(
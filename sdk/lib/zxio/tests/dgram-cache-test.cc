@@ -0,0 +1,259 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <errno.h>
+#include <fidl/fuchsia.posix.socket/cpp/wire_test_base.h>
+#include <lib/async-loop/cpp/loop.h>
+#include <lib/async-loop/default.h>
+#include <lib/zx/event.h>
+#include <lib/zx/eventpair.h>
+#include <lib/zxio/cpp/dgram_cache.h>
+#include <lib/zxio/cpp/socket_address.h>
+#include <netinet/in.h>
+#include <zircon/types.h>
+
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include <zxtest/zxtest.h>
+
+namespace {
+
+namespace fsocket = fuchsia_posix_socket;
+
+constexpr uint32_t kMaximumSizeBase = 1000;
+
+// Answers the preflight and postflight calls of the caches. Destinations are IPv4 loopback
+// addresses, and the maximum payload size of the route to one is |kMaximumSizeBase| plus its port.
+class PreflightServer final : public fidl::testing::WireTestBase<fsocket::DatagramSocket> {
+ public:
+  void NotImplemented_(const std::string& name, fidl::CompleterBase& completer) final {
+    ADD_FAILURE("unexpected message received: %s", name.c_str());
+    completer.Close(ZX_ERR_NOT_SUPPORTED);
+  }
+
+  void SendMsgPreflight(SendMsgPreflightRequestView request,
+                        SendMsgPreflightCompleter::Sync& completer) final {
+    preflights_++;
+    fidl::Arena alloc;
+    fidl::WireTableBuilder response =
+        fsocket::wire::DatagramSocketSendMsgPreflightResponse::Builder(alloc);
+    uint16_t port = connected_port_;
+    if (request->has_to()) {
+      ASSERT_TRUE(request->to().is_ipv4());
+      port = request->to().ipv4().port;
+    } else {
+      response.to(fuchsia_net::wire::SocketAddress::WithIpv4(
+          alloc, fuchsia_net::wire::Ipv4SocketAddress{
+                     .address = {.addr = {127, 0, 0, 1}},
+                     .port = port,
+                 }));
+    }
+    fidl::VectorView<zx::eventpair> validity(alloc, 1);
+    validity[0] = NewValidity();
+    response.validity(validity);
+    response.maximum_size(kMaximumSizeBase + port);
+    completer.ReplySuccess(response.Build());
+  }
+
+  void RecvMsgPostflight(RecvMsgPostflightCompleter::Sync& completer) final {
+    postflights_++;
+    fidl::Arena alloc;
+    fidl::WireTableBuilder response =
+        fsocket::wire::DatagramSocketRecvMsgPostflightResponse::Builder(alloc);
+    response.validity(NewValidity());
+    response.requests(fsocket::wire::CmsgRequests::kIpTos);
+    completer.ReplySuccess(response.Build());
+  }
+
+  void GetError(GetErrorCompleter::Sync& completer) final {
+    completer.ReplyError(fuchsia_posix::wire::Errno::kEconnrefused);
+  }
+
+  void Close(CloseCompleter::Sync& completer) final {
+    completer.ReplySuccess();
+    completer.Close(ZX_OK);
+  }
+
+  // The port of the loopback address returned to preflights which don't name a destination.
+  void set_connected_port(uint16_t port) { connected_port_ = port; }
+
+  // Invalidates every cache entry handed out so far.
+  void Invalidate() {
+    std::lock_guard lock(lock_);
+    validity_peers_.clear();
+  }
+
+  int preflights() const { return preflights_; }
+  int postflights() const { return postflights_; }
+
+ private:
+  zx::eventpair NewValidity() {
+    zx::eventpair validity, peer;
+    ZX_ASSERT(zx::eventpair::create(0, &validity, &peer) == ZX_OK);
+    std::lock_guard lock(lock_);
+    validity_peers_.push_back(std::move(peer));
+    return validity;
+  }
+
+  std::atomic<int> preflights_ = 0;
+  std::atomic<int> postflights_ = 0;
+  uint16_t connected_port_ = 0;
+  std::mutex lock_;
+  std::vector<zx::eventpair> validity_peers_ __TA_GUARDED(lock_);
+};
+
+class DgramCacheTest : public zxtest::Test {
+ public:
+  void SetUp() final {
+    zx::status endpoints = fidl::CreateEndpoints<fsocket::DatagramSocket>();
+    ASSERT_OK(endpoints.status_value());
+    fidl::BindServer(control_loop_.dispatcher(), std::move(endpoints->server), &server_);
+    ASSERT_OK(control_loop_.StartThread("control"));
+    client_ = fidl::BindSyncClient(std::move(endpoints->client));
+    ASSERT_OK(zx::event::create(0, &error_));
+  }
+
+  void TearDown() final { control_loop_.Shutdown(); }
+
+  static SocketAddress Address(uint16_t port) {
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(port),
+        .sin_addr = {.s_addr = htonl(INADDR_LOOPBACK)},
+    };
+    SocketAddress address;
+    ZX_ASSERT(address.LoadSockAddr(reinterpret_cast<const struct sockaddr*>(&addr),
+                                   sizeof(addr)) == ZX_OK);
+    return address;
+  }
+
+  // Returns the maximum payload size of the route to |port|, or to the connected address.
+  RouteCache::Result GetRoute(std::optional<uint16_t> port) {
+    std::optional<SocketAddress> remote_addr;
+    if (port.has_value()) {
+      remote_addr = Address(port.value());
+    }
+    return route_cache_.Get(remote_addr, std::nullopt, error_wait_item(), client_);
+  }
+
+  RequestedCmsgCache::Result GetCmsgs(bool get_requested_cmsg_set) {
+    return cmsg_cache_.Get(error_wait_item(), get_requested_cmsg_set, client_);
+  }
+
+  void SignalError() { ASSERT_OK(error_.signal(0, ZX_USER_SIGNAL_0)); }
+
+  PreflightServer& server() { return server_; }
+
+ private:
+  zx_wait_item_t error_wait_item() const {
+    return {
+        .handle = error_.get(),
+        .waitfor = ZX_USER_SIGNAL_0,
+    };
+  }
+
+  async::Loop control_loop_{&kAsyncLoopConfigNoAttachToCurrentThread};
+  PreflightServer server_;
+  fidl::WireSyncClient<fsocket::DatagramSocket> client_;
+  zx::event error_;
+  RouteCache route_cache_;
+  RequestedCmsgCache cmsg_cache_;
+};
+
+TEST_F(DgramCacheTest, RouteIsCached) {
+  for (int i = 0; i < 3; ++i) {
+    RouteCache::Result result = GetRoute(7);
+    ASSERT_TRUE(result.is_ok());
+    EXPECT_EQ(result.value(), kMaximumSizeBase + 7);
+  }
+  EXPECT_EQ(server().preflights(), 1);
+}
+
+TEST_F(DgramCacheTest, InvalidatedRouteIsFetchedAgain) {
+  ASSERT_TRUE(GetRoute(7).is_ok());
+  server().Invalidate();
+  RouteCache::Result result = GetRoute(7);
+  ASSERT_TRUE(result.is_ok());
+  EXPECT_EQ(result.value(), kMaximumSizeBase + 7);
+  EXPECT_EQ(server().preflights(), 2);
+}
+
+// Lookups compare against the entry found last, which has to stay valid while the cache grows and
+// rehashes, and must never stand in for the route to another destination.
+TEST_F(DgramCacheTest, RoutesToManyDestinations) {
+  constexpr uint16_t kDestinations = 200;
+  for (int round = 0; round < 2; ++round) {
+    for (uint16_t port = 1; port <= kDestinations; ++port) {
+      for (int i = 0; i < 2; ++i) {
+        RouteCache::Result result = GetRoute(port);
+        ASSERT_TRUE(result.is_ok());
+        ASSERT_EQ(result.value(), kMaximumSizeBase + port);
+      }
+    }
+  }
+  EXPECT_EQ(server().preflights(), kDestinations);
+}
+
+TEST_F(DgramCacheTest, ConnectedRouteIsCached) {
+  server().set_connected_port(9);
+  for (int i = 0; i < 3; ++i) {
+    RouteCache::Result result = GetRoute(std::nullopt);
+    ASSERT_TRUE(result.is_ok());
+    EXPECT_EQ(result.value(), kMaximumSizeBase + 9);
+  }
+  EXPECT_EQ(server().preflights(), 1);
+
+  // The connected route is shared with sends naming the same destination.
+  RouteCache::Result result = GetRoute(9);
+  ASSERT_TRUE(result.is_ok());
+  EXPECT_EQ(result.value(), kMaximumSizeBase + 9);
+  EXPECT_EQ(server().preflights(), 1);
+}
+
+TEST_F(DgramCacheTest, RouteLookupReportsPendingError) {
+  ASSERT_TRUE(GetRoute(7).is_ok());
+  SignalError();
+  RouteCache::Result result = GetRoute(7);
+  ASSERT_TRUE(result.is_error());
+  ASSERT_TRUE(result.error_value().is_ok());
+  EXPECT_EQ(result.error_value().value(), ECONNREFUSED);
+}
+
+TEST_F(DgramCacheTest, RequestedCmsgSetIsCached) {
+  for (int i = 0; i < 3; ++i) {
+    RequestedCmsgCache::Result result = GetCmsgs(true);
+    ASSERT_TRUE(result.is_ok());
+    ASSERT_TRUE(result.value().has_value());
+    EXPECT_TRUE(result.value().value().ip_tos());
+    EXPECT_FALSE(result.value().value().ip_ttl());
+  }
+  EXPECT_EQ(server().postflights(), 1);
+
+  server().Invalidate();
+  ASSERT_TRUE(GetCmsgs(true).is_ok());
+  EXPECT_EQ(server().postflights(), 2);
+}
+
+TEST_F(DgramCacheTest, RequestedCmsgSetIsOnlyFetchedWhenNeeded) {
+  RequestedCmsgCache::Result result = GetCmsgs(false);
+  ASSERT_TRUE(result.is_ok());
+  EXPECT_FALSE(result.value().has_value());
+  EXPECT_EQ(server().postflights(), 0);
+}
+
+TEST_F(DgramCacheTest, RequestedCmsgLookupReportsPendingError) {
+  SignalError();
+  for (bool get_requested_cmsg_set : {false, true}) {
+    RequestedCmsgCache::Result result = GetCmsgs(get_requested_cmsg_set);
+    ASSERT_TRUE(result.is_error());
+    ASSERT_TRUE(result.error_value().is_ok());
+    EXPECT_EQ(result.error_value().value(), ECONNREFUSED);
+  }
+  EXPECT_EQ(server().postflights(), 0);
+}
+
+}  // namespace
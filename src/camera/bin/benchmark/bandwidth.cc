@@ -6,6 +6,7 @@
 #include <lib/async/cpp/task.h>
 #include <lib/stdcompat/source_location.h>
 #include <lib/syslog/cpp/macros.h>
+#include <lib/zx/clock.h>
 
 namespace camera::benchmark {
 
@@ -78,6 +79,7 @@ void Bandwidth::OnConfigurationChanged(uint32_t index) {
   StartAllStreams(index, [this, index] {
     MeasureRamChannels([this, index](std::vector<RamChannelMeasurement> results) {
       WriteResults("Configuration" + std::to_string(index), results);
+      WriteLatencyResults("Configuration" + std::to_string(index));
       streams_.clear();
       async::PostDelayedTask(
           dispatcher_,
@@ -110,6 +112,9 @@ void Bandwidth::StartAllStreams(uint32_t configuration_index, fit::closure callb
     stream.collection.set_error_handler(MakeErrorHandler("Sysmem BufferCollection"));
     stream.frame_callback = [this, &stream, warm = warm.share()](fuchsia::camera3::FrameInfo info) {
       constexpr uint32_t kWarmupFrames = 20;
+      if (stream.frames_received >= kWarmupFrames) {
+        stream.latencies.push_back(zx::clock::get_monotonic() - zx::time(info.capture_timestamp));
+      }
       if (++stream.frames_received == kWarmupFrames) {
         warm();
       }
@@ -190,21 +195,43 @@ void Bandwidth::MeasureRamChannels(
 
 void Bandwidth::WriteResults(std::string mode, std::vector<RamChannelMeasurement> results) {
   for (auto result : results) {
-    if (!first_result_) {
-      sink() << ",";
+    WriteResult(mode + "/" + std::string(result.name), "bytes/second",
+                {result.bandwidth_bytes_per_second});
+  }
+}
+
+void Bandwidth::WriteLatencyResults(std::string mode) {
+  for (uint32_t i = 0; i < streams_.size(); ++i) {
+    std::vector<uint64_t> values;
+    for (auto latency : streams_[i].latencies) {
+      values.push_back(static_cast<uint64_t>(latency.to_nsecs()));
+    }
+    if (!values.empty()) {
+      WriteResult(mode + "/Stream" + std::to_string(i) + "/Latency", "nanoseconds", values);
     }
-    first_result_ = false;
-    sink() << "\n";
-    sink() << "    {\n";
-    sink() << "        \"label\":\"" << mode << "/" << result.name << "\",\n";
-    sink() << "        \"test_suite\":\"fuchsia.camera-benchmark\",\n";
-    sink() << "        \"unit\":\"bytes/second\",\n";
-    sink() << "        \"values\":[" << result.bandwidth_bytes_per_second << "]\n";
-    sink() << "    }";
-    sink().flush();
   }
 }
 
+void Bandwidth::WriteResult(const std::string& label, std::string_view unit,
+                            const std::vector<uint64_t>& values) {
+  if (!first_result_) {
+    sink() << ",";
+  }
+  first_result_ = false;
+  sink() << "\n";
+  sink() << "    {\n";
+  sink() << "        \"label\":\"" << label << "\",\n";
+  sink() << "        \"test_suite\":\"fuchsia.camera-benchmark\",\n";
+  sink() << "        \"unit\":\"" << unit << "\",\n";
+  sink() << "        \"values\":[";
+  for (size_t i = 0; i < values.size(); ++i) {
+    sink() << (i ? "," : "") << values[i];
+  }
+  sink() << "]\n";
+  sink() << "    }";
+  sink().flush();
+}
+
 std::ostream& Bandwidth::sink() { return *sink_; }
 
 }  // namespace camera::benchmark
@@ -8,15 +8,18 @@
 #include <fuchsia/hardware/ram/metrics/cpp/fidl.h>
 #include <fuchsia/sysmem/cpp/fidl.h>
 #include <lib/fit/function.h>
+#include <lib/zx/time.h>
 
 #include <sstream>
 #include <string_view>
+#include <vector>
 
 #include <soc/aml-common/aml-ram.h>
 
 namespace camera::benchmark {
 
-// Measures memory bandwidth consumption by the camera stack.
+// Measures memory bandwidth consumption by the camera stack, and the latency of the frames it
+// delivers while doing so.
 class Bandwidth {
  public:
   Bandwidth(fuchsia::sysmem::AllocatorHandle sysmem_allocator,
@@ -40,6 +43,9 @@ class Bandwidth {
   };
   void MeasureRamChannels(fit::function<void(std::vector<RamChannelMeasurement>)> callback);
   void WriteResults(std::string mode, std::vector<RamChannelMeasurement> results);
+  void WriteLatencyResults(std::string mode);
+  void WriteResult(const std::string& label, std::string_view unit,
+                   const std::vector<uint64_t>& values);
   std::ostream& sink();
 
   fuchsia::sysmem::AllocatorPtr sysmem_allocator_;
@@ -56,6 +62,8 @@ class Bandwidth {
     fuchsia::sysmem::BufferCollectionPtr collection;
     fuchsia::camera3::Stream::GetNextFrameCallback frame_callback;
     uint64_t frames_received = 0;
+    // Time from capture to delivery of each frame received after warming up.
+    std::vector<zx::duration> latencies;
   };
   std::vector<PerStream> streams_;
   uint32_t warm_streams_ = 0;
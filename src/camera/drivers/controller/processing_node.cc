@@ -69,6 +69,11 @@ void ProcessNode::SendFrame(uint32_t index, frame_metadata_t metadata,
   TRACE_DURATION("camera", "ProcessNode::SendFrame", "this", this, "index", index);
   ZX_ASSERT(metadata.timestamp > 0);
   ZX_ASSERT(metadata.capture_timestamp > 0);
+  // Record how long after capture each node produces its frames. The difference between adjacent
+  // nodes is the latency of each stage of the pipeline.
+  TRACE_COUNTER("camera", "ProcessNode::SendFrame.capture_latency",
+                reinterpret_cast<uint64_t>(this), "nanoseconds",
+                metadata.timestamp - metadata.capture_timestamp);
   // If the node is shutting down, immediately release the frame.
   if (shutdown_state_.requested) {
     release_callback();
@@ -14,16 +14,17 @@ namespace bt::hci {
 namespace {
 
 // Type containing both a fixed packet storage buffer and a ACLDataPacket interface to the buffer.
-// Limit to 3 template instantiations: small, medium, and large.
-using SmallACLDataPacket =
-    allocators::internal::FixedSizePacket<hci_spec::ACLDataHeader,
-                                          allocators::kSmallACLDataPacketSize>;
-using MediumACLDataPacket =
-    allocators::internal::FixedSizePacket<hci_spec::ACLDataHeader,
-                                          allocators::kMediumACLDataPacketSize>;
-using LargeACLDataPacket =
-    allocators::internal::FixedSizePacket<hci_spec::ACLDataHeader,
-                                          allocators::kLargeACLDataPacketSize>;
+// Limit to 3 template instantiations: small, medium, and large. Each size keeps up to a slab's
+// worth of freed packets for reuse.
+using SmallACLDataPacket = allocators::internal::RecycledFixedSizePacket<
+    hci_spec::ACLDataHeader, allocators::kSmallACLDataPacketSize,
+    allocators::kNumSmallACLDataPackets>;
+using MediumACLDataPacket = allocators::internal::RecycledFixedSizePacket<
+    hci_spec::ACLDataHeader, allocators::kMediumACLDataPacketSize,
+    allocators::kNumMediumACLDataPackets>;
+using LargeACLDataPacket = allocators::internal::RecycledFixedSizePacket<
+    hci_spec::ACLDataHeader, allocators::kLargeACLDataPacketSize,
+    allocators::kNumLargeACLDataPackets>;
 
 ACLDataPacketPtr NewACLDataPacket(size_t payload_size) {
   BT_ASSERT_MSG(payload_size <= allocators::kLargeACLDataPayloadSize,
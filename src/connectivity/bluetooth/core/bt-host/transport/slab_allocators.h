@@ -6,7 +6,10 @@
 #define SRC_CONNECTIVITY_BLUETOOTH_CORE_BT_HOST_TRANSPORT_SLAB_ALLOCATORS_H_
 
 #include <memory>
+#include <mutex>
+#include <new>
 
+#include "src/connectivity/bluetooth/core/bt-host/common/assert.h"
 #include "src/connectivity/bluetooth/core/bt-host/common/macros.h"
 #include "src/connectivity/bluetooth/core/bt-host/hci-spec/constants.h"
 #include "src/connectivity/bluetooth/core/bt-host/hci-spec/protocol.h"
@@ -81,6 +84,88 @@ class FixedSizePacket : public FixedSizePacketStorage<BufferSize>, public Packet
   FixedSizePacket& operator=(const FixedSizePacket&) = delete;
 };
 
+// Keeps up to |MaxFreeCount| freed objects of type |T| around so that they can be handed out again
+// without going through the system allocator. Objects freed beyond that are returned to the system
+// allocator, which bounds the memory held by the free list to roughly one slab.
+template <typename T, size_t MaxFreeCount>
+class FreeList {
+ public:
+  static void* Allocate() {
+    {
+      std::lock_guard<std::mutex> lock(mutex());
+      Node*& head = free_head();
+      if (head) {
+        Node* node = head;
+        head = node->next;
+        free_count()--;
+        return node;
+      }
+    }
+    return ::operator new(sizeof(T));
+  }
+
+  static void Free(void* ptr) {
+    if (!ptr) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex());
+      if (free_count() < MaxFreeCount) {
+        Node*& head = free_head();
+        head = new (ptr) Node{head};
+        free_count()++;
+        return;
+      }
+    }
+    ::operator delete(ptr);
+  }
+
+  // The number of objects currently held for reuse.
+  static size_t size() {
+    std::lock_guard<std::mutex> lock(mutex());
+    return free_count();
+  }
+
+ private:
+  struct Node {
+    Node* next;
+  };
+  static_assert(sizeof(T) >= sizeof(Node));
+
+  // Function-local statics avoid static initialization order issues for packets allocated from
+  // other static initializers.
+  static std::mutex& mutex() {
+    static std::mutex mutex;
+    return mutex;
+  }
+  static Node*& free_head() {
+    static Node* head = nullptr;
+    return head;
+  }
+  static size_t& free_count() {
+    static size_t count = 0;
+    return count;
+  }
+};
+
+// A FixedSizePacket whose storage is recycled through a FreeList when it's destroyed. Packets on
+// the data path are allocated and freed at a high rate with only a few alive at a time (bounded
+// by the controller's buffer credits), so recycling them saves a round trip through the system
+// allocator for every packet.
+template <typename HeaderType, size_t BufferSize, size_t MaxFreeCount>
+class RecycledFixedSizePacket final : public FixedSizePacket<HeaderType, BufferSize> {
+ public:
+  using Pool = FreeList<RecycledFixedSizePacket, MaxFreeCount>;
+
+  using FixedSizePacket<HeaderType, BufferSize>::FixedSizePacket;
+
+  static void* operator new(size_t size) {
+    BT_DEBUG_ASSERT(size == sizeof(RecycledFixedSizePacket));
+    return Pool::Allocate();
+  }
+  static void operator delete(void* ptr) { Pool::Free(ptr); }
+};
+
 }  // namespace internal
 
 }  // namespace bt::hci::allocators
@@ -112,5 +112,42 @@ TEST(SlabAllocatorsTest, LargeACLDataPacketFallback) {
   packet->mutable_view()->mutable_data().Fill('m');
 }
 
+TEST(SlabAllocatorsTest, FreeListReusesFreedObjects) {
+  struct Object {
+    uint64_t data[4];
+  };
+  using Pool = internal::FreeList<Object, 2>;
+  ASSERT_EQ(0u, Pool::size());
+
+  void* first = Pool::Allocate();
+  void* second = Pool::Allocate();
+  void* third = Pool::Allocate();
+  Pool::Free(first);
+  Pool::Free(second);
+  // The free list is full, so this goes back to the system allocator.
+  Pool::Free(third);
+  EXPECT_EQ(2u, Pool::size());
+
+  // Most recently freed objects are handed out first.
+  EXPECT_EQ(second, Pool::Allocate());
+  EXPECT_EQ(first, Pool::Allocate());
+  EXPECT_EQ(0u, Pool::size());
+  Pool::Free(first);
+  Pool::Free(second);
+}
+
+TEST(SlabAllocatorsTest, ACLDataPacketStorageIsRecycled) {
+  auto packet = ACLDataPacket::New(kMediumACLDataPayloadSize);
+  ASSERT_TRUE(packet);
+  const void* const storage = packet.get();
+  packet = nullptr;
+
+  packet = ACLDataPacket::New(kSmallACLDataPayloadSize + 1);
+  ASSERT_TRUE(packet);
+  EXPECT_EQ(storage, packet.get());
+  EXPECT_EQ(kSmallACLDataPacketSize + 1, packet->view().size());
+  packet->mutable_view()->mutable_data().Fill('m');
+}
+
 }  // namespace
 }  // namespace bt::hci::allocators
@@ -79,6 +79,8 @@ zx::status<std::unique_ptr<DeviceInterface>> DeviceInterface::Create(
 }
 
 DeviceInterface::~DeviceInterface() {
+  // Diagnostics requests reach into the queues, stop serving them before anything is destroyed.
+  diagnostics_.Shutdown();
   ZX_ASSERT_MSG(primary_session_ == nullptr,
                 "can't destroy DeviceInterface with active primary session. (%s)",
                 primary_session_->name());
@@ -1088,6 +1090,9 @@ void DeviceInterface::CommitAllSessions() {
   PruneDeadSessions();
 }
 
+// Every session other than the owner gets its own copy of the frame, since each session only
+// shares its own data VMO with the device. Loaning the owner's buffers to other sessions instead
+// would need a way to hand out and reclaim buffers in another session's VMO.
 void DeviceInterface::CopySessionData(const Session& owner, const RxFrameInfo& frame_info) {
   if (primary_session_ && primary_session_.get() != &owner) {
     primary_session_->AssertParentRxLock(*this);
@@ -1146,6 +1151,11 @@ bool DeviceInterface::IsDataPlaneOpen() { return device_status_ == DeviceStatus:
 DeviceInterface::DeviceInterface(async_dispatcher_t* dispatcher,
                                  ddk::NetworkDeviceImplProtocolClient parent)
     : dispatcher_(dispatcher),
+      diagnostics_([this]() {
+        if (rx_queue_) {
+          rx_queue_->LogDebugInfo();
+        }
+      }),
       device_(parent),
       vmo_store_(vmo_store::Options{
           vmo_store::MapOptions{ZX_VM_PERM_READ | ZX_VM_PERM_WRITE | ZX_VM_REQUIRE_NON_RESIZABLE,
@@ -305,6 +305,10 @@ class DeviceInterface : public fidl::WireServer<netdev::Device>,
   PendingDeviceOperation pending_device_op_ = PendingDeviceOperation::NONE;
   std::atomic_bool has_listen_sessions_ = false;
 
+  // Devices with multiple hardware rings are served by a single Rx and Tx queue, each with one
+  // thread. Spreading the data path over several queues would need the device protocol to describe
+  // its rings and report completions per ring, and fuchsia.hardware.network to let sessions pick a
+  // queue.
   std::unique_ptr<TxQueue> tx_queue_;
   std::unique_ptr<RxQueue> rx_queue_;
 
@@ -17,10 +17,15 @@ void TriggerBacktrace() {
 }
 }  // namespace
 
-DiagnosticsService::DiagnosticsService()
-    : loop_(&kAsyncLoopConfigNeverAttachToThread), trigger_stack_trace_(TriggerBacktrace) {}
+DiagnosticsService::DiagnosticsService(fit::function<void()> log_debug_info)
+    : loop_(&kAsyncLoopConfigNeverAttachToThread),
+      log_debug_info_(std::move(log_debug_info)),
+      trigger_stack_trace_(TriggerBacktrace) {}
+
+DiagnosticsService::~DiagnosticsService() { Shutdown(); }
 
 void DiagnosticsService::LogDebugInfoToSyslog(LogDebugInfoToSyslogCompleter::Sync& completer) {
+  log_debug_info_();
   trigger_stack_trace_();
   completer.Reply();
 }
@@ -33,4 +38,6 @@ void DiagnosticsService::Bind(fidl::ServerEnd<netdev::Diagnostics> server_end) {
   fidl::BindServer(loop_.dispatcher(), std::move(server_end), this);
 }
 
+void DiagnosticsService::Shutdown() { loop_.Shutdown(); }
+
 }  // namespace network
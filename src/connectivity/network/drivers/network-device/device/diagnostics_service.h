@@ -20,7 +20,10 @@ class NetworkDeviceTest;
 namespace network {
 class DiagnosticsService : public fidl::WireServer<netdev::Diagnostics> {
  public:
-  DiagnosticsService();
+  // |log_debug_info| is called to log the owner's debug information when LogDebugInfoToSyslog is
+  // requested.
+  explicit DiagnosticsService(fit::function<void()> log_debug_info);
+  ~DiagnosticsService() override;
   void LogDebugInfoToSyslog(LogDebugInfoToSyslogCompleter::Sync& completer) override;
 
   // Binds |server_end| to the diagnostics service.
@@ -28,11 +31,16 @@ class DiagnosticsService : public fidl::WireServer<netdev::Diagnostics> {
   // All requests are served from a dedicated diagnostics thread.
   void Bind(fidl::ServerEnd<netdev::Diagnostics> server_end);
 
+  // Stops serving requests, so |log_debug_info| is no longer called once this returns.
+  void Shutdown();
+
  private:
   friend testing::NetworkDeviceTest;
   async::Loop loop_;
   std::atomic<bool> thread_started_ = false;
 
+  fit::function<void()> log_debug_info_;
+
   // Functions hooks for override in tests.
   fit::function<void()> trigger_stack_trace_;
 };
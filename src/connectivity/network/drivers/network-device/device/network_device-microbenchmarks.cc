@@ -21,6 +21,8 @@ class FakeDeviceImpl : public ddk::NetworkPortProtocol<FakeDeviceImpl>,
   static constexpr uint16_t kDepth = 256;
   static constexpr uint16_t kPortId = 1;
   static constexpr uint32_t kMtu = 1500;
+  // Length of every frame the device receives.
+  static constexpr uint32_t kRxFrameLength = 1024;
   static constexpr uint8_t kRxFrameTypes[] = {
       static_cast<uint8_t>(netdev::wire::FrameType::kEthernet),
   };
@@ -28,6 +30,7 @@ class FakeDeviceImpl : public ddk::NetworkPortProtocol<FakeDeviceImpl>,
       {.type = static_cast<uint8_t>(netdev::wire::FrameType::kEthernet)},
   };
 
+  // If |state| is not null, the device moves it on to the next step whenever it's given buffers.
   FakeDeviceImpl(perftest::RepeatState* state) : perftest_state_(state) {}
 
   zx_status_t NetworkDeviceImplInit(const network_device_ifc_protocol_t* iface) {
@@ -56,7 +59,9 @@ class FakeDeviceImpl : public ddk::NetworkPortProtocol<FakeDeviceImpl>,
     // NB: This may be called on a thread different than the test thread. To guarantee this doesn't
     // happen concurrently with other perftest actions, the latency test must make sure that no
     // descriptors belong to the device upon each test iteration.
-    perftest_state_->NextStep();
+    if (perftest_state_) {
+      perftest_state_->NextStep();
+    }
     std::array<tx_result_t, kDepth> result;
     auto iter = result.begin();
     for (auto& buff : cpp20::span(buf_list, buf_count)) {
@@ -73,7 +78,9 @@ class FakeDeviceImpl : public ddk::NetworkPortProtocol<FakeDeviceImpl>,
     // NB: This may be called on a thread different than the test thread. To guarantee this doesn't
     // happen concurrently with other perftest actions, the latency test must make sure that no
     // descriptors belong to the device upon each test iteration.
-    perftest_state_->NextStep();
+    if (perftest_state_) {
+      perftest_state_->NextStep();
+    }
     std::array<rx_buffer_t, kDepth> result;
     std::array<rx_buffer_part_t, kDepth> parts;
     auto result_iter = result.begin();
@@ -84,7 +91,7 @@ class FakeDeviceImpl : public ddk::NetworkPortProtocol<FakeDeviceImpl>,
           .id = buff.id,
           // Any length different than zero will cause the buffer to reach the session, it's
           // irrelevant for the performance test.
-          .length = 1024,
+          .length = kRxFrameLength,
       };
       *result_iter++ = {
           .meta =
@@ -172,6 +179,75 @@ class RxTestSession : public BaseTestSession {
   const zx::fifo& test_fifo() override { return rx_fifo(); }
 };
 
+// A fake network device with a primary session attached to its only port, the session's first
+// |buffer_count| descriptors are ready to be sent.
+template <class Session>
+class BenchmarkDevice {
+ public:
+  BenchmarkDevice(perftest::RepeatState* device_state, uint16_t buffer_count)
+      : loop_(&kAsyncLoopConfigNeverAttachToThread), impl_(device_state) {
+    ZX_ASSERT_MSG(buffer_count <= network::FakeDeviceImpl::kDepth,
+                  "can't use more buffers (%d) than device depth (%d)", buffer_count,
+                  network::FakeDeviceImpl::kDepth);
+    zx_status_t status = loop_.StartThread("netdevice-dispatcher");
+    ZX_ASSERT_OK(status, "failed to start thread");
+
+    zx::status device_status =
+        network::internal::DeviceInterface::Create(loop_.dispatcher(), impl_.client());
+    ZX_ASSERT_OK(device_status.status_value(), "failed to create device");
+    device_ = std::move(device_status.value());
+
+    zx::status device_endpoints = fidl::CreateEndpoints<network::netdev::Device>();
+    ZX_ASSERT_OK(device_endpoints.status_value(), "failed to create device endpoints");
+    ZX_ASSERT_OK(device_->Bind(std::move(device_endpoints->server)), "failed to bind to device");
+
+    zx::status port_endpoints = fidl::CreateEndpoints<network::netdev::Port>();
+    ZX_ASSERT_OK(port_endpoints.status_value(), "failed to create port endpoints");
+    ZX_ASSERT_OK(
+        device_->BindPort(network::FakeDeviceImpl::kPortId, std::move(port_endpoints->server)),
+        "failed to bind port");
+    port_ = fidl::WireSyncClient{std::move(port_endpoints->client)};
+    fidl::WireResult port_info_result = port_->GetInfo();
+    ZX_ASSERT_OK(port_info_result.status(), "failed to get port info");
+    const network::netdev::wire::PortInfo& port_info = port_info_result->info;
+    ZX_ASSERT_MSG(port_info.has_id(), "port id missing");
+    const network::netdev::wire::PortId& port_id = port_info.id();
+
+    client_ = fidl::WireSyncClient{std::move(device_endpoints->client)};
+    status = session_.Open(client_, "session", network::netdev::wire::SessionFlags::kPrimary,
+                           buffer_count);
+    ZX_ASSERT_OK(status, "failed to open session");
+    status = session_.AttachPort(port_id, {network::netdev::wire::FrameType::kEthernet});
+    ZX_ASSERT_OK(status, "failed to attach port");
+
+    for (uint16_t i = 0; i < buffer_count; i++) {
+      buffer_descriptor_t& descriptor = session_.ResetDescriptor(i);
+      // Tx tests need to set the port id here.
+      descriptor.port_id = {
+          .base = port_id.base,
+          .salt = port_id.salt,
+      };
+    }
+  }
+
+  ~BenchmarkDevice() {
+    sync_completion_t completion;
+    device_->Teardown([&completion]() { sync_completion_signal(&completion); });
+    zx_status_t status = sync_completion_wait(&completion, zx::duration::infinite().get());
+    ZX_ASSERT_OK(status, "sync_completion_wait(_, _) failed ");
+  }
+
+  Session& session() { return session_; }
+
+ private:
+  async::Loop loop_;
+  network::FakeDeviceImpl impl_;
+  std::unique_ptr<network::internal::DeviceInterface> device_;
+  fidl::WireSyncClient<network::netdev::Port> port_;
+  fidl::WireSyncClient<network::netdev::Device> client_;
+  Session session_;
+};
+
 // LatencyTest measures the round trip latency between a client and a device using an in-process
 // fake network device.
 //
@@ -187,52 +263,11 @@ class RxTestSession : public BaseTestSession {
 // a single batch (limited to the device's FIFO depth).
 template <class Session>
 bool LatencyTest(perftest::RepeatState* state, const uint16_t buffer_count) {
-  ZX_ASSERT_MSG(buffer_count <= network::FakeDeviceImpl::kDepth,
-                "can't measure latency with more buffers (%d) than device depth (%d)", buffer_count,
-                network::FakeDeviceImpl::kDepth);
-  async::Loop loop(&kAsyncLoopConfigNeverAttachToThread);
-  zx_status_t status = loop.StartThread("netdevice-dispatcher");
-  ZX_ASSERT_OK(status, "failed to start thread");
-
-  network::FakeDeviceImpl impl(state);
-
-  zx::status device_status =
-      network::internal::DeviceInterface::Create(loop.dispatcher(), impl.client());
-  ZX_ASSERT_OK(device_status.status_value(), "failed to create device");
-  std::unique_ptr device = std::move(device_status.value());
-
-  zx::status device_endpoints = fidl::CreateEndpoints<network::netdev::Device>();
-  ZX_ASSERT_OK(device_endpoints.status_value(), "failed to create device endpoints");
-  ZX_ASSERT_OK(device->Bind(std::move(device_endpoints->server)), "failed to bind to device");
-
-  zx::status port_endpoints = fidl::CreateEndpoints<network::netdev::Port>();
-  ZX_ASSERT_OK(port_endpoints.status_value(), "failed to create port endpoints");
-  ZX_ASSERT_OK(
-      device->BindPort(network::FakeDeviceImpl::kPortId, std::move(port_endpoints->server)),
-      "failed to bind port");
-  fidl::WireSyncClient port{(std::move(port_endpoints->client))};
-  fidl::WireResult port_info_result = port->GetInfo();
-  ZX_ASSERT_OK(port_info_result.status(), "failed to get port info");
-  const network::netdev::wire::PortInfo& port_info = port_info_result->info;
-  ZX_ASSERT_MSG(port_info.has_id(), "port id missing");
-  const network::netdev::wire::PortId& port_id = port_info.id();
-
-  Session session;
-  fidl::WireSyncClient client{std::move(device_endpoints->client)};
-  status =
-      session.Open(client, "session", network::netdev::wire::SessionFlags::kPrimary, buffer_count);
-  ZX_ASSERT_OK(status, "failed to open session");
-  status = session.AttachPort(port_id, {network::netdev::wire::FrameType::kEthernet});
-  ZX_ASSERT_OK(status, "failed to attach port");
+  BenchmarkDevice<Session> device(state, buffer_count);
+  Session& session = device.session();
 
   std::array<uint16_t, network::FakeDeviceImpl::kDepth> write_descriptors, returned_descriptors;
   for (uint16_t i = 0; i < buffer_count; i++) {
-    buffer_descriptor_t& descriptor = session.ResetDescriptor(i);
-    // Tx tests need to set the port id here.
-    descriptor.port_id = {
-        .base = port_id.base,
-        .salt = port_id.salt,
-    };
     write_descriptors[i] = i;
   }
 
@@ -240,7 +275,7 @@ bool LatencyTest(perftest::RepeatState* state, const uint16_t buffer_count) {
   state->DeclareStep("return");
   while (state->KeepRunning()) {
     size_t actual;
-    status = session.SendDescriptors(write_descriptors.begin(), buffer_count, &actual);
+    zx_status_t status = session.SendDescriptors(write_descriptors.begin(), buffer_count, &actual);
     ZX_ASSERT_OK(status, "failed to send descriptors");
     ZX_ASSERT_MSG(actual == buffer_count, "partial FIFO write %ld/%d", actual, buffer_count);
 
@@ -253,11 +288,44 @@ bool LatencyTest(perftest::RepeatState* state, const uint16_t buffer_count) {
     ZX_ASSERT_MSG(actual == buffer_count, "unexpected partial FIFO batch read %ld/%d", actual,
                   buffer_count);
   }
+  return true;
+}
 
-  sync_completion_t completion;
-  device->Teardown([&completion]() { sync_completion_signal(&completion); });
-  status = sync_completion_wait(&completion, zx::duration::infinite().get());
-  ZX_ASSERT_OK(status, "sync_completion_wait(_, _) failed ");
+// RxThroughputTest measures how quickly a client receives frames when it hands every buffer back
+// as soon as it gets it, keeping the device busy all the time. This is the load under which the rx
+// queue coalesces completion wakeups and polls the device instead.
+//
+// The variation on the test is the number of buffers the client keeps in circulation.
+bool RxThroughputTest(perftest::RepeatState* state, const uint16_t buffer_count) {
+  constexpr size_t kFramesPerRun = 4096;
+  state->SetBytesProcessedPerRun(kFramesPerRun * network::FakeDeviceImpl::kRxFrameLength);
+  // The device doesn't report steps, frames are completed continuously in the background.
+  BenchmarkDevice<RxTestSession> device(nullptr, buffer_count);
+  RxTestSession& session = device.session();
+
+  std::array<uint16_t, network::FakeDeviceImpl::kDepth> descriptors;
+  for (uint16_t i = 0; i < buffer_count; i++) {
+    descriptors[i] = i;
+  }
+  size_t actual;
+  zx_status_t status = session.SendDescriptors(descriptors.begin(), buffer_count, &actual);
+  ZX_ASSERT_OK(status, "failed to send descriptors");
+  ZX_ASSERT_MSG(actual == buffer_count, "partial FIFO write %ld/%d", actual, buffer_count);
+
+  while (state->KeepRunning()) {
+    for (size_t received = 0; received < kFramesPerRun;) {
+      status = session.test_fifo().wait_one(ZX_FIFO_READABLE, zx::time::infinite(), nullptr);
+      ZX_ASSERT_OK(status, "wait FIFO readable");
+      size_t fetched;
+      status = session.FetchDescriptors(descriptors.begin(), buffer_count, &fetched);
+      ZX_ASSERT_OK(status, "failed to fetch descriptors");
+      received += fetched;
+      // The FIFO has room for every buffer in circulation, so the write can't be partial.
+      status = session.SendDescriptors(descriptors.begin(), fetched, &actual);
+      ZX_ASSERT_OK(status, "failed to send descriptors");
+      ZX_ASSERT_MSG(actual == fetched, "partial FIFO write %ld/%ld", actual, fetched);
+    }
+  }
   return true;
 }
 
@@ -268,6 +336,8 @@ void RegisterTests() {
                            LatencyTest<RxTestSession>, batch_size);
     perftest::RegisterTest(fxl::StringPrintf("Latency/Tx/%d", batch_size).c_str(),
                            LatencyTest<TxTestSession>, batch_size);
+    perftest::RegisterTest(fxl::StringPrintf("Throughput/Rx/%d", batch_size).c_str(),
+                           RxThroughputTest, batch_size);
   }
 }
 PERFTEST_CTOR(RegisterTests)
@@ -274,7 +274,13 @@ void RxQueue::CompleteRxList(const rx_buffer_t* rx_buffer_list, size_t count) {
   }
   parent_->CommitAllSessions();
   if (device_buffer_count_ <= parent_->rx_notify_threshold()) {
-    TriggerRxWatch();
+    if (refill_scheduled_) {
+      // The watcher thread is already going to refill the device, don't wake it up again.
+      coalesced_triggers_++;
+    } else {
+      refill_scheduled_ = true;
+      TriggerRxWatch();
+    }
   }
 }
 
@@ -282,15 +288,26 @@ int RxQueue::WatchThread(std::unique_ptr<rx_space_buffer_t[]> space_buffers) {
   auto loop = [this, space_buffers = std::move(space_buffers)]() -> zx_status_t {
     fbl::RefPtr<RefCountedFifo> observed_fifo(nullptr);
     bool waiting_on_fifo = false;
+    // Number of consecutive polling rounds, zero when not polling.
+    uint32_t polling_rounds = 0;
     for (;;) {
       zx_port_packet_t packet;
       zx_status_t status;
       bool fifo_readable = false;
-      if ((status = rx_watch_port_.wait(zx::time::infinite(), &packet)) != ZX_OK) {
+      const zx::time deadline =
+          polling_rounds != 0 ? zx::deadline_after(kPollInterval) : zx::time::infinite();
+      status = rx_watch_port_.wait(deadline, &packet);
+      if (status == ZX_ERR_TIMED_OUT && polling_rounds != 0) {
+        // Time for the next polling round, which refills the device as if we had been triggered.
+        packet.key = kTriggerRxKey;
+        poll_rounds_++;
+      } else if (status != ZX_OK) {
         LOGF_ERROR("RxQueue::WatchThread port wait failed %s", zx_status_get_string(status));
         return status;
+      } else {
+        wakeups_++;
+        parent_->NotifyRxQueuePacket(packet.key);
       }
-      parent_->NotifyRxQueuePacket(packet.key);
       switch (packet.key) {
         case kQuitWatchKey:
           LOG_TRACE("RxQueue::WatchThread got quit key");
@@ -344,6 +361,20 @@ int RxQueue::WatchThread(std::unique_ptr<rx_space_buffer_t[]> space_buffers) {
         RxSessionTransaction transaction(this);
         parent_->LoadRxDescriptors(transaction);
       }
+
+      // Keep polling while the device drains buffers quickly, go back to being woken up by
+      // completions once traffic is light or the polling budget is exhausted.
+      const uint32_t divisor = polling_rounds != 0 ? kPollExitDivisor : kPollEnterDivisor;
+      const bool busy = pushed != 0 && pushed >= parent_->info().rx_depth / divisor;
+      if (busy && polling_rounds < kPollBudget) {
+        polling_rounds++;
+      } else {
+        polling_rounds = 0;
+      }
+      // Every completion from now on needs to wake us up, unless we're polling. Clearing this under
+      // the rx lock after refilling guarantees that no completion goes unnoticed.
+      refill_scheduled_ = polling_rounds != 0;
+
       // We only need to wait on the FIFO if we didn't get enough buffers.
       // Otherwise, we'll trigger the loop again once the device calls CompleteRx.
       //
@@ -389,6 +420,14 @@ int RxQueue::WatchThread(std::unique_ptr<rx_space_buffer_t[]> space_buffers) {
   return 0;
 }
 
+void RxQueue::LogDebugInfo() const {
+  LOGF_INFO(
+      "rx queue: poll interval=%ldus budget=%u enter=1/%u exit=1/%u; wakeups=%lu "
+      "coalesced triggers=%lu poll rounds=%lu",
+      kPollInterval.to_usecs(), kPollBudget, kPollEnterDivisor, kPollExitDivisor, wakeups_.load(),
+      coalesced_triggers_.load(), poll_rounds_.load());
+}
+
 uint32_t RxQueue::SessionTransaction::remaining() __TA_REQUIRES(queue_->parent_->rx_lock()) {
   // NB: __TA_REQUIRES here is just encoding that a SessionTransaction always holds a lock for
   // its parent queue, the protection from misuse comes from the annotations on
@@ -7,6 +7,7 @@
 
 #include <fuchsia/hardware/network/device/cpp/banjo.h>
 #include <lib/zx/port.h>
+#include <lib/zx/time.h>
 
 #include <fbl/alloc_checker.h>
 #include <fbl/auto_lock.h>
@@ -27,6 +28,18 @@ class RxQueue {
   static constexpr uint64_t kFifoWatchKey = 3;
   static constexpr uint64_t kQuitWatchKey = 4;
 
+  // Adaptive polling parameters.
+  //
+  // A refill that hands at least 1/|kPollEnterDivisor| of the device's rx depth back to the device
+  // means the device is draining buffers quickly. The watcher thread then stops being woken by
+  // every completion and instead refills every |kPollInterval|, for at most |kPollBudget|
+  // consecutive rounds. Polling stops as soon as a round refills less than 1/|kPollExitDivisor| of
+  // the rx depth, at which point completions wake the watcher thread again.
+  static constexpr zx::duration kPollInterval = zx::usec(50);
+  static constexpr uint32_t kPollBudget = 64;
+  static constexpr uint32_t kPollEnterDivisor = 2;
+  static constexpr uint32_t kPollExitDivisor = 8;
+
   static zx::status<std::unique_ptr<RxQueue>> Create(DeviceInterface* parent);
   ~RxQueue();
 
@@ -52,6 +65,8 @@ class RxQueue {
   void TriggerRxWatch();
   // Kills and joins the watcher thread.
   void JoinThread();
+  // Logs the adaptive polling parameters and counters.
+  void LogDebugInfo() const;
 
   // A transaction to add buffers from a session to the RxQueue.
   class SessionTransaction {
@@ -100,6 +115,15 @@ class RxQueue {
   std::unique_ptr<IndexedSlab<InFlightBuffer>> in_flight_ __TA_GUARDED(parent_->rx_lock());
   std::unique_ptr<RingQueue<uint32_t>> available_queue_ __TA_GUARDED(parent_->rx_lock());
   size_t device_buffer_count_ __TA_GUARDED(parent_->rx_lock()) = 0;
+  // Set when the watcher thread is already going to refill the device, either because a trigger
+  // packet is queued or because it is polling. Completions don't queue more trigger packets while
+  // this is set.
+  bool refill_scheduled_ __TA_GUARDED(parent_->rx_lock()) = false;
+
+  // Counters reported through |LogDebugInfo|.
+  std::atomic<uint64_t> wakeups_ = 0;
+  std::atomic<uint64_t> coalesced_triggers_ = 0;
+  std::atomic<uint64_t> poll_rounds_ = 0;
 
   zx::port rx_watch_port_;
   std::optional<thrd_t> rx_watch_thread_{};
@@ -345,13 +345,16 @@ zx_status_t Session::FetchTx(TxQueue::SessionTransaction& transaction) {
       return ZX_ERR_IO_INVALID;
     }
 
+    // No info type carries the segment size of a TX buffer larger than the MTU (or the coalesced
+    // segment count of an RX buffer), so devices can only advertise segmentation offload through
+    // the opaque acceleration flags.
     auto info_type = static_cast<netdev::wire::InfoType>(desc.info_type);
     switch (info_type) {
       case netdev::wire::InfoType::kNoInfo:
         break;
       default:
         LOGF_ERROR("%s: info type (%d) not recognized, discarding information", name(),
-                   buffer->meta.info_type);
+                   desc.info_type);
         info_type = netdev::wire::InfoType::kNoInfo;
         break;
     }
@@ -49,11 +49,12 @@ void AddressResponder::ReceiveQuestion(const DnsQuestion& question,
       (question.type_ == DnsType::kA || question.type_ == DnsType::kAaaa ||
        question.type_ == DnsType::kAny) &&
       question.name_.dotted_string_ == host_full_name_) {
-    MaybeSendAddresses(reply_address);
+    MaybeSendAddresses(reply_address, known_answers());
   }
 }
 
-void AddressResponder::MaybeSendAddresses(ReplyAddress reply_address) {
+void AddressResponder::MaybeSendAddresses(ReplyAddress reply_address,
+                                          std::shared_ptr<const KnownAnswers> known_answers) {
   // We only throttle multicast sends. A V4 multicast reply address indicates V4 and V6 multicast.
   if (reply_address.is_multicast_placeholder()) {
     // Replace the general multicast placeholder with one that's restricted to the desired |Media|
@@ -67,10 +68,11 @@ void AddressResponder::MaybeSendAddresses(ReplyAddress reply_address) {
 
     if (throttle_state_ + kMinMulticastInterval > now()) {
       // A send happened less than a second ago, and no send is currently scheduled. We need to
-      // schedule a multicast send for one second after the previous one.
+      // schedule a multicast send for one second after the previous one. That send answers any
+      // queries that arrive in the meantime, so it can't rely on the known answers of this one.
       PostTaskForTime(
           [this, reply_address]() {
-            SendAddressResources(reply_address);
+            SendAddressResources(reply_address, nullptr);
             throttle_state_ = now();
           },
           throttle_state_ + kMinMulticastInterval);
@@ -80,22 +82,42 @@ void AddressResponder::MaybeSendAddresses(ReplyAddress reply_address) {
     }
   }
 
-  SendAddressResources(reply_address);
+  SendAddressResources(reply_address, known_answers.get());
 
   throttle_state_ = now();
 }
 
-void AddressResponder::SendAddressResources(ReplyAddress reply_address) {
+void AddressResponder::SendAddressResources(ReplyAddress reply_address,
+                                            const KnownAnswers* known_answers) {
   if (addresses_.empty()) {
-    // Send addresses for the local host.
-    SendAddresses(MdnsResourceSection::kAnswer, reply_address);
+    // Send addresses for the local host. These are sent as a placeholder that's replaced with
+    // each interface's addresses, so they're only left out if the querier knows all of them.
+    if (!known_answers || !AllLocalHostAddressesKnown(*known_answers)) {
+      SendAddresses(MdnsResourceSection::kAnswer, reply_address);
+    }
   } else {
     // Send addresses that were provided in the constructor.
     for (const auto& address : addresses_) {
       SendResource(std::make_shared<DnsResource>(host_full_name_, address),
-                   MdnsResourceSection::kAnswer, reply_address);
+                   MdnsResourceSection::kAnswer, reply_address, known_answers);
+    }
+  }
+}
+
+bool AddressResponder::AllLocalHostAddressesKnown(const KnownAnswers& known_answers) {
+  std::vector<HostAddress> addresses = local_host_addresses();
+  if (addresses.empty()) {
+    return false;
+  }
+
+  for (const auto& address : addresses) {
+    // This is the record each interface sends in place of the placeholder.
+    if (!IsKnownAnswer(DnsResource(host_full_name_, address.address()), known_answers)) {
+      return false;
     }
   }
+
+  return true;
 }
 
 }  // namespace mdns
@@ -41,9 +41,16 @@ class AddressResponder : public MdnsAgent {
   static constexpr zx::time kThrottleStateIdle = zx::time::infinite_past();
   static constexpr zx::time kThrottleStatePending = zx::time::infinite();
 
-  void MaybeSendAddresses(ReplyAddress reply_address);
+  // Sends the addresses now or, if multicast sends are being throttled, schedules a send.
+  // |known_answers| are those of the query being answered, if any.
+  void MaybeSendAddresses(ReplyAddress reply_address,
+                          std::shared_ptr<const KnownAnswers> known_answers);
 
-  void SendAddressResources(ReplyAddress reply_address);
+  // Sends the addresses, leaving out any answers in |known_answers|, which may be null.
+  void SendAddressResources(ReplyAddress reply_address, const KnownAnswers* known_answers);
+
+  // Determines whether |known_answers| lists every local host address.
+  bool AllLocalHostAddressesKnown(const KnownAnswers& known_answers);
 
   std::string host_full_name_;
   std::vector<inet::IpAddress> addresses_;
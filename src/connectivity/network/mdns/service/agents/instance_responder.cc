@@ -66,27 +66,33 @@ void InstanceResponder::ReceiveQuestion(const DnsQuestion& question,
                                ? PublicationCause::kQueryMulticastResponse
                                : PublicationCause::kQueryUnicastResponse;
 
+  // The publication is supplied asynchronously, so the query's known answers go along with it.
+  std::shared_ptr<const KnownAnswers> query_known_answers = known_answers();
+
   switch (question.type_) {
     case DnsType::kPtr:
       if (MdnsNames::MatchServiceName(name, instance_.service_name_, &subtype)) {
         LogSenderAddress(sender_address);
-        MaybeGetAndSendPublication(publication_cause, subtype, Constrain(reply_address));
+        MaybeGetAndSendPublication(publication_cause, subtype, Constrain(reply_address),
+                                   query_known_answers);
       } else if (question.name_.dotted_string_ == MdnsNames::kAnyServiceFullName) {
-        SendAnyServiceResponse(Constrain(reply_address));
+        SendAnyServiceResponse(Constrain(reply_address), query_known_answers.get());
       }
       break;
     case DnsType::kSrv:
     case DnsType::kTxt:
       if (question.name_.dotted_string_ == instance_full_name_) {
         LogSenderAddress(sender_address);
-        MaybeGetAndSendPublication(publication_cause, "", Constrain(reply_address));
+        MaybeGetAndSendPublication(publication_cause, "", Constrain(reply_address),
+                                   query_known_answers);
       }
       break;
     case DnsType::kAny:
       if (question.name_.dotted_string_ == instance_full_name_ ||
           MdnsNames::MatchServiceName(name, instance_.service_name_, &subtype)) {
         LogSenderAddress(sender_address);
-        MaybeGetAndSendPublication(publication_cause, subtype, Constrain(reply_address));
+        MaybeGetAndSendPublication(publication_cause, subtype, Constrain(reply_address),
+                                   query_known_answers);
       }
       break;
     default:
@@ -160,7 +166,7 @@ void InstanceResponder::LogSenderAddress(const ReplyAddress& sender_address) {
 }
 
 void InstanceResponder::SendAnnouncement() {
-  GetAndSendPublication(PublicationCause::kAnnouncement, "", multicast_reply());
+  GetAndSendPublication(PublicationCause::kAnnouncement, "", multicast_reply(), nullptr);
 
   for (const std::string& subtype : subtypes_) {
     SendSubtypePtrRecord(subtype, DnsResource::kShortTimeToLive, multicast_reply());
@@ -175,16 +181,17 @@ void InstanceResponder::SendAnnouncement() {
   announcement_interval_ = announcement_interval_ * 2;
 }
 
-void InstanceResponder::SendAnyServiceResponse(const ReplyAddress& reply_address) {
+void InstanceResponder::SendAnyServiceResponse(const ReplyAddress& reply_address,
+                                               const KnownAnswers* known_answers) {
   auto ptr_resource = std::make_shared<DnsResource>(MdnsNames::kAnyServiceFullName, DnsType::kPtr);
   ptr_resource->ptr_.pointer_domain_name_ =
       DnsName(MdnsNames::ServiceFullName(instance_.service_name_));
-  SendResource(ptr_resource, MdnsResourceSection::kAnswer, reply_address);
+  SendResource(ptr_resource, MdnsResourceSection::kAnswer, reply_address, known_answers);
 }
 
-void InstanceResponder::MaybeGetAndSendPublication(PublicationCause publication_cause,
-                                                   const std::string& subtype,
-                                                   const ReplyAddress& reply_address) {
+void InstanceResponder::MaybeGetAndSendPublication(
+    PublicationCause publication_cause, const std::string& subtype,
+    const ReplyAddress& reply_address, std::shared_ptr<const KnownAnswers> known_answers) {
   if (publisher_ == nullptr) {
     return;
   }
@@ -208,10 +215,11 @@ void InstanceResponder::MaybeGetAndSendPublication(PublicationCause publication_
     if (throttle_state + kMinMulticastInterval > now()) {
       // A multicast publication of this subtype was sent less than a second ago, and no send is
       // currently scheduled. We need to schedule a multicast send for one second after the
-      // previous one.
+      // previous one. That send answers any queries that arrive in the meantime, so it can't
+      // rely on the known answers of this one.
       PostTaskForTime(
           [this, publication_cause, subtype, reply_address]() {
-            GetAndSendPublication(publication_cause, subtype, reply_address);
+            GetAndSendPublication(publication_cause, subtype, reply_address, nullptr);
           },
           throttle_state + kMinMulticastInterval);
       return;
@@ -221,12 +229,13 @@ void InstanceResponder::MaybeGetAndSendPublication(PublicationCause publication_
     // immediately.
   }
 
-  GetAndSendPublication(publication_cause, subtype, reply_address);
+  GetAndSendPublication(publication_cause, subtype, reply_address, std::move(known_answers));
 }
 
 void InstanceResponder::GetAndSendPublication(PublicationCause publication_cause,
                                               const std::string& subtype,
-                                              const ReplyAddress& reply_address) {
+                                              const ReplyAddress& reply_address,
+                                              std::shared_ptr<const KnownAnswers> known_answers) {
   if (publisher_ == nullptr) {
     return;
   }
@@ -235,9 +244,10 @@ void InstanceResponder::GetAndSendPublication(PublicationCause publication_cause
 
   publisher_->GetPublication(
       publication_cause, subtype, sender_addresses_,
-      [this, query, subtype, reply_address](std::unique_ptr<Mdns::Publication> publication) {
+      [this, query, subtype, reply_address,
+       known_answers = std::move(known_answers)](std::unique_ptr<Mdns::Publication> publication) {
         if (publication) {
-          SendPublication(*publication, subtype, reply_address);
+          SendPublication(*publication, subtype, reply_address, known_answers.get());
           // Make sure messages get sent immediately if this callback happens asynchronously
           // with respect to |ReceiveQuestion| or posted task execution.
           FlushSentItems();
@@ -257,16 +267,17 @@ void InstanceResponder::GetAndSendPublication(PublicationCause publication_cause
 
 void InstanceResponder::SendPublication(const Mdns::Publication& publication,
                                         const std::string& subtype,
-                                        const ReplyAddress& reply_address) {
+                                        const ReplyAddress& reply_address,
+                                        const KnownAnswers* known_answers) {
   if (!subtype.empty()) {
-    SendSubtypePtrRecord(subtype, publication.ptr_ttl_seconds_, reply_address);
+    SendSubtypePtrRecord(subtype, publication.ptr_ttl_seconds_, reply_address, known_answers);
   }
 
   auto ptr_resource = std::make_shared<DnsResource>(
       MdnsNames::ServiceFullName(instance_.service_name_), DnsType::kPtr);
   ptr_resource->time_to_live_ = publication.ptr_ttl_seconds_;
   ptr_resource->ptr_.pointer_domain_name_ = DnsName(instance_full_name_);
-  SendResource(ptr_resource, MdnsResourceSection::kAnswer, reply_address);
+  SendResource(ptr_resource, MdnsResourceSection::kAnswer, reply_address, known_answers);
 
   auto srv_resource = std::make_shared<DnsResource>(instance_full_name_, DnsType::kSrv);
   srv_resource->time_to_live_ = publication.srv_ttl_seconds_;
@@ -332,14 +343,15 @@ void InstanceResponder::SendPublication(const Mdns::Publication& publication,
 }
 
 void InstanceResponder::SendSubtypePtrRecord(const std::string& subtype, uint32_t ttl,
-                                             const ReplyAddress& reply_address) const {
+                                             const ReplyAddress& reply_address,
+                                             const KnownAnswers* known_answers) const {
   FX_DCHECK(!subtype.empty());
 
   auto ptr_resource = std::make_shared<DnsResource>(
       MdnsNames::ServiceSubtypeFullName(instance_.service_name_, subtype), DnsType::kPtr);
   ptr_resource->time_to_live_ = ttl;
   ptr_resource->ptr_.pointer_domain_name_ = DnsName(instance_full_name_);
-  SendResource(ptr_resource, MdnsResourceSection::kAnswer, reply_address);
+  SendResource(ptr_resource, MdnsResourceSection::kAnswer, reply_address, known_answers);
 }
 
 void InstanceResponder::SendGoodbye() {
@@ -70,26 +70,33 @@ class InstanceResponder : public MdnsAgent {
   // Sends an announcement and schedules the next announcement, as appropriate.
   void SendAnnouncement();
 
-  // Sends a reply to a query for any service.
-  void SendAnyServiceResponse(const ReplyAddress& reply_address);
+  // Sends a reply to a query for any service. Answers in |known_answers| (which may be null)
+  // aren't sent.
+  void SendAnyServiceResponse(const ReplyAddress& reply_address,
+                              const KnownAnswers* known_answers);
 
   // Calls |GetAndSendPublication| with |query| set to true after first determining if the send
-  // should be throttled.
+  // should be throttled. |known_answers| are those of the query being answered, if any.
   void MaybeGetAndSendPublication(PublicationCause publication_cause, const std::string& subtype,
-                                  const ReplyAddress& reply_address);
+                                  const ReplyAddress& reply_address,
+                                  std::shared_ptr<const KnownAnswers> known_answers);
 
   // Gets an |Mdns::Publication| from |mdns_responder_| and, if not null, sends
-  // it. An empty |subtype| indicates no subtype.
+  // it. An empty |subtype| indicates no subtype. Answers in |known_answers| aren't sent.
   void GetAndSendPublication(PublicationCause publication_cause, const std::string& subtype,
-                             const ReplyAddress& reply_address);
+                             const ReplyAddress& reply_address,
+                             std::shared_ptr<const KnownAnswers> known_answers);
 
-  // Sends a publication. An empty |subtype| indicates no subtype.
+  // Sends a publication. An empty |subtype| indicates no subtype. Answers in |known_answers|
+  // (which may be null) aren't sent.
   void SendPublication(const Mdns::Publication& publication, const std::string& subtype,
-                       const ReplyAddress& reply_address);
+                       const ReplyAddress& reply_address,
+                       const KnownAnswers* known_answers = nullptr);
 
-  // Sends a subtype PTR record for this instance.
+  // Sends a subtype PTR record for this instance, unless |known_answers| lists it.
   void SendSubtypePtrRecord(const std::string& subtype, uint32_t ttl,
-                            const ReplyAddress& reply_address) const;
+                            const ReplyAddress& reply_address,
+                            const KnownAnswers* known_answers = nullptr) const;
 
   // Sends a publication with zero ttls, indicating the service instance is
   // no longer published.
@@ -0,0 +1,35 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/connectivity/network/mdns/service/agents/mdns_agent.h"
+
+namespace mdns {
+
+// static
+bool MdnsAgent::IsKnownAnswer(const DnsResource& resource, const KnownAnswers& known_answers) {
+  if (resource.time_to_live_ == 0) {
+    // Goodbyes are never suppressed.
+    return false;
+  }
+
+  for (const auto& known_answer : known_answers) {
+    if (known_answer->name_.dotted_string_ != resource.name_.dotted_string_ ||
+        known_answer->type_ != resource.type_ ||
+        known_answer->time_to_live_ < resource.time_to_live_ / 2) {
+      continue;
+    }
+
+    // Compare everything else, ignoring the TTL and cache flush bit.
+    DnsResource comparable = *known_answer;
+    comparable.time_to_live_ = resource.time_to_live_;
+    comparable.cache_flush_ = resource.cache_flush_;
+    if (comparable == resource) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+}  // namespace mdns
@@ -10,6 +10,7 @@
 #include <lib/zx/time.h>
 
 #include <memory>
+#include <vector>
 
 #include "src/connectivity/network/mdns/service/common/reply_address.h"
 #include "src/connectivity/network/mdns/service/common/service_instance.h"
@@ -18,6 +19,9 @@
 
 namespace mdns {
 
+// Answers listed in a query, which needn't be sent in reply to it (RFC 6762 section 7.1).
+using KnownAnswers = std::vector<std::shared_ptr<DnsResource>>;
+
 // Base class for objects that drive mDNS question and record traffic.
 //
 // Agents that have been 'started' receive all inbound questions and resource records via their
@@ -87,6 +91,10 @@ class MdnsAgent : public std::enable_shared_from_this<MdnsAgent> {
 
     // Returns the addresses for the local host.
     virtual std::vector<HostAddress> LocalHostAddresses() = 0;
+
+    // Returns the known answers of the query whose questions are currently being presented to
+    // agents, or null if there are none.
+    virtual std::shared_ptr<const KnownAnswers> CurrentKnownAnswers() = 0;
   };
 
   virtual ~MdnsAgent() {}
@@ -175,6 +183,14 @@ class MdnsAgent : public std::enable_shared_from_this<MdnsAgent> {
   // Returns the addresses for the local host.
   std::vector<HostAddress> local_host_addresses() { return owner_->LocalHostAddresses(); }
 
+  // Returns the known answers of the query being presented by |ReceiveQuestion|, or null if there
+  // are none. Agents that reply later must hold on to these and pass them to |SendResource|.
+  std::shared_ptr<const KnownAnswers> known_answers() { return owner_->CurrentKnownAnswers(); }
+
+  // Determines whether |resource| is among |known_answers| with a TTL of at least half of its own,
+  // in which case it must not be sent in answer to the query that listed the known answers.
+  static bool IsKnownAnswer(const DnsResource& resource, const KnownAnswers& known_answers);
+
   // Sends a question to the specified address.
   void SendQuestion(std::shared_ptr<DnsQuestion> question,
                     const ReplyAddress& reply_address) const {
@@ -187,6 +203,18 @@ class MdnsAgent : public std::enable_shared_from_this<MdnsAgent> {
     owner_->SendResource(std::move(resource), section, reply_address);
   }
 
+  // Sends a resource in reply to a query, unless it's an answer the query's |known_answers| lists.
+  // |known_answers| may be null.
+  void SendResource(std::shared_ptr<DnsResource> resource, MdnsResourceSection section,
+                    const ReplyAddress& reply_address, const KnownAnswers* known_answers) const {
+    if (section == MdnsResourceSection::kAnswer && known_answers &&
+        IsKnownAnswer(*resource, *known_answers)) {
+      return;
+    }
+
+    owner_->SendResource(std::move(resource), section, reply_address);
+  }
+
   // Sends address resources to the specified address.
   void SendAddresses(MdnsResourceSection section, const ReplyAddress& reply_address) const {
     owner_->SendAddresses(section, reply_address);
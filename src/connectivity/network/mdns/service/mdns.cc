@@ -89,6 +89,11 @@ void Mdns::Start(fuchsia::net::interfaces::WatcherPtr interfaces_watcher,
         // to |FlushSentItems| in the interim.
         defer_flush_ = true;
 
+        // The answer section of a query lists the answers the querier already knows about.
+        if (!message->header_.response() && !message->answers_.empty()) {
+          known_answers_ = std::make_shared<KnownAnswers>(message->answers_);
+        }
+
         for (const auto& question : message->questions_) {
           // We reply to questions using unicast if specifically requested in
           // the question or if the sender's port isn't 5353.
@@ -119,6 +124,7 @@ void Mdns::Start(fuchsia::net::interfaces::WatcherPtr interfaces_watcher,
         }
         DALLOW_AGENT_REMOVAL();
 
+        known_answers_ = nullptr;
         defer_flush_ = false;
 
         SendMessages();
@@ -577,6 +583,8 @@ void Mdns::ChangeLocalServiceInstance(const ServiceInstance& instance, bool from
 
 std::vector<HostAddress> Mdns::LocalHostAddresses() { return transceiver_.LocalHostAddresses(); }
 
+std::shared_ptr<const KnownAnswers> Mdns::CurrentKnownAnswers() { return known_answers_; }
+
 void Mdns::AddAgent(std::shared_ptr<MdnsAgent> agent) {
   if (state_ == State::kActive) {
     agents_.emplace(agent);
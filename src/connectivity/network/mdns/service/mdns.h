@@ -499,6 +499,8 @@ class Mdns : public MdnsAgent::Owner {
 
   std::vector<HostAddress> LocalHostAddresses() override;
 
+  std::shared_ptr<const KnownAnswers> CurrentKnownAnswers() override;
+
   // Adds an agent and, if |started_|, starts it.
   void AddAgent(std::shared_ptr<MdnsAgent> agent);
 
@@ -550,6 +552,9 @@ class Mdns : public MdnsAgent::Owner {
   std::shared_ptr<ResourceRenewer> resource_renewer_;
   bool prohibit_agent_removal_ = false;
   bool defer_flush_ = false;
+  // Answers listed in the query being processed, if any. Agents take a reference to these when
+  // they reply to the query, so they're still available if the reply is built asynchronously.
+  std::shared_ptr<const KnownAnswers> known_answers_;
 
 #ifdef NDEBUG
 #define DPROHIBIT_AGENT_REMOVAL() ((void)0)
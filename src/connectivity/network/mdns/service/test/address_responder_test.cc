@@ -114,6 +114,59 @@ TEST_F(AddressResponderTest, HostNameAndAddresses) {
   ExpectNoOther();
 }
 
+// Tests that local host addresses aren't sent if the querier knows all of them.
+TEST_F(AddressResponderTest, KnownAnswerSuppression) {
+  AddressResponder under_test(this, Media::kBoth, IpVersions::kBoth);
+  SetAgent(under_test);
+  SetLocalHostAddresses({HostAddress(kAddresses[0], kInterfaceId, zx::sec(450)),
+                         HostAddress(kAddresses[1], kInterfaceId, zx::sec(450))});
+
+  // Normal startup.
+  under_test.Start(kLocalHostFullName);
+  ExpectNoOther();
+
+  ReplyAddress sender_address(
+      inet::SocketAddress(192, 168, 1, 1, inet::IpPort::From_uint16_t(5353)),
+      inet::IpAddress(192, 168, 1, 100), kInterfaceId, Media::kWireless, IpVersions::kV4);
+
+  SetKnownAnswers({std::make_shared<DnsResource>(kLocalHostFullName, kAddresses[0]),
+                   std::make_shared<DnsResource>(kLocalHostFullName, kAddresses[1])});
+  under_test.ReceiveQuestion(DnsQuestion(kLocalHostFullName, DnsType::kA), sender_address,
+                             sender_address);
+  ExpectNoOutboundMessage();
+  ExpectNoOther();
+
+  // If any address is unknown, they're all sent.
+  SetKnownAnswers({std::make_shared<DnsResource>(kLocalHostFullName, kAddresses[0])});
+  under_test.ReceiveQuestion(DnsQuestion(kLocalHostFullName, DnsType::kA), sender_address,
+                             sender_address);
+  auto message = ExpectOutboundMessage(sender_address);
+  ExpectAddressPlaceholder(message.get(), MdnsResourceSection::kAnswer);
+  ExpectNoOtherQuestionOrResource(message.get());
+  ExpectNoOther();
+}
+
+// Tests that explicit addresses the querier knows about aren't sent.
+TEST_F(AddressResponderTest, KnownAnswerSuppressionHostNameAndAddresses) {
+  AddressResponder under_test(this, kHostFullName, kAddresses, Media::kBoth, IpVersions::kBoth);
+  SetAgent(under_test);
+
+  // Normal startup.
+  under_test.Start(kLocalHostFullName);
+  ExpectNoOther();
+
+  ReplyAddress sender_address(
+      inet::SocketAddress(192, 168, 1, 1, inet::IpPort::From_uint16_t(5353)),
+      inet::IpAddress(192, 168, 1, 100), kInterfaceId, Media::kWireless, IpVersions::kV4);
+
+  SetKnownAnswers({std::make_shared<DnsResource>(kHostFullName, kAddresses[0])});
+  under_test.ReceiveQuestion(DnsQuestion(kHostFullName, DnsType::kA),
+                             ReplyAddress::Multicast(Media::kBoth, IpVersions::kBoth),
+                             sender_address);
+  ExpectAddresses(kHostFullName, {kAddresses[1]}, Media::kBoth, IpVersions::kBoth);
+  ExpectNoOther();
+}
+
 // Tests operation with wired media only.
 TEST_F(AddressResponderTest, WiredOnly) {
   AddressResponder under_test(this, kHostFullName, kAddresses, Media::kWired, IpVersions::kBoth);
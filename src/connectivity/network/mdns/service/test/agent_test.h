@@ -36,6 +36,14 @@ class AgentTest : public ::testing::Test, public MdnsAgent::Owner {
     local_host_addresses_ = std::move(local_host_addresses);
   }
 
+  // Sets the known answers returned by |CurrentKnownAnswers|, as if the agent were being presented
+  // with the questions of a query listing |known_answers|. An empty list clears them.
+  void SetKnownAnswers(KnownAnswers known_answers) {
+    known_answers_ = known_answers.empty()
+                         ? nullptr
+                         : std::make_shared<const KnownAnswers>(std::move(known_answers));
+  }
+
   // Advances the current time (as returned by |now()|) to |time|. |time| must be greater than
   // or equal to the time currently returned by |now()|.
   void AdvanceTo(zx::time time);
@@ -196,8 +204,11 @@ class AgentTest : public ::testing::Test, public MdnsAgent::Owner {
 
   std::vector<HostAddress> LocalHostAddresses() override { return local_host_addresses_; }
 
+  std::shared_ptr<const KnownAnswers> CurrentKnownAnswers() override { return known_answers_; }
+
   const MdnsAgent* agent_;
   std::vector<HostAddress> local_host_addresses_;
+  std::shared_ptr<const KnownAnswers> known_answers_;
   std::shared_ptr<DnsResource> address_placeholder_ =
       std::make_shared<DnsResource>(kLocalHostFullName, DnsType::kA);
 
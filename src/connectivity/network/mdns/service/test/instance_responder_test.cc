@@ -600,6 +600,76 @@ TEST_F(InstanceResponderTest, HostAndAddresses) {
   ExpectNoOther();
 }
 
+// Tests that an answer the querier already knows about isn't sent, even though the publication is
+// supplied after the query has been processed.
+TEST_F(InstanceResponderTest, KnownAnswerSuppression) {
+  InstanceResponder under_test(this, "", {}, kServiceName, kInstanceName, Media::kBoth,
+                               IpVersions::kBoth, this);
+  SetAgent(under_test);
+
+  // Normal startup.
+  under_test.Start(kLocalHostFullName);
+  ExpectAnnouncements();
+
+  ReplyAddress sender_address(inet::SocketAddress(192, 168, 1, 1, kPort),
+                              inet::IpAddress(192, 168, 1, 100), kInterfaceId, Media::kWired,
+                              IpVersions::kBoth);
+
+  auto known_answer = std::make_shared<DnsResource>(service_full_name(), DnsType::kPtr);
+  known_answer->time_to_live_ = Mdns::Publication::Create(kPort)->ptr_ttl_seconds_ / 2;
+  known_answer->ptr_.pointer_domain_name_ = DnsName(instance_full_name());
+  SetKnownAnswers({known_answer});
+
+  auto question = DnsQuestion(service_full_name(), DnsType::kPtr);
+  question.unicast_response_ = true;
+  under_test.ReceiveQuestion(question, sender_address, sender_address);
+  auto callback = ExpectGetPublicationCall(PublicationCause::kQueryUnicastResponse, "",
+                                           {sender_address.socket_address()});
+
+  // The owner is done with the query by the time the publisher replies.
+  SetKnownAnswers({});
+  callback(Mdns::Publication::Create(kPort));
+
+  auto message = ExpectOutboundMessage(sender_address);
+  ExpectResource(message.get(), MdnsResourceSection::kAdditional, instance_full_name(),
+                 DnsType::kSrv);
+  ExpectResource(message.get(), MdnsResourceSection::kAdditional, instance_full_name(),
+                 DnsType::kTxt);
+  ExpectAddressPlaceholder(message.get(), MdnsResourceSection::kAdditional);
+  ExpectNoOtherQuestionOrResource(message.get());
+  ExpectNoOther();
+}
+
+// Tests that a known answer is still sent if the querier's TTL for it is less than half of the
+// real one.
+TEST_F(InstanceResponderTest, KnownAnswerWithLowTtl) {
+  InstanceResponder under_test(this, "", {}, kServiceName, kInstanceName, Media::kBoth,
+                               IpVersions::kBoth, this);
+  SetAgent(under_test);
+
+  // Normal startup.
+  under_test.Start(kLocalHostFullName);
+  ExpectAnnouncements();
+
+  ReplyAddress sender_address(inet::SocketAddress(192, 168, 1, 1, kPort),
+                              inet::IpAddress(192, 168, 1, 100), kInterfaceId, Media::kWired,
+                              IpVersions::kBoth);
+
+  auto known_answer = std::make_shared<DnsResource>(service_full_name(), DnsType::kPtr);
+  known_answer->time_to_live_ = Mdns::Publication::Create(kPort)->ptr_ttl_seconds_ / 2 - 1;
+  known_answer->ptr_.pointer_domain_name_ = DnsName(instance_full_name());
+  SetKnownAnswers({known_answer});
+
+  auto question = DnsQuestion(service_full_name(), DnsType::kPtr);
+  question.unicast_response_ = true;
+  under_test.ReceiveQuestion(question, sender_address, sender_address);
+  SetKnownAnswers({});
+  ExpectGetPublicationCall(PublicationCause::kQueryUnicastResponse, "",
+                           {sender_address.socket_address()})(Mdns::Publication::Create(kPort));
+  ExpectPublication(sender_address);
+  ExpectNoOther();
+}
+
 // Tests that local service instance notifications are properly generated.
 TEST_F(InstanceResponderTest, LocalServiceInstanceNotifications) {
   InstanceResponder under_test(this, "", {}, kServiceName, kInstanceName, Media::kBoth,
@@ -10,8 +10,15 @@
 #include <sys/socket.h>
 
 #include <array>
+#include <condition_variable>
+#include <functional>
 #include <iostream>
+#include <mutex>
+#include <optional>
 #include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include <fbl/unique_fd.h>
 #include <perftest/perftest.h>
@@ -156,8 +163,12 @@ bool TcpWriteRead(perftest::RepeatState* state, size_t transfer) {
 // Measures the time to write `message_count` messages of size `message_size`
 // bytes on one end of the socket and read them out on the other end on the
 // same thread and calculates the throughput.
+//
+// If `batched` is true, all of the messages are written with one sendmmsg call
+// and read with one recvmmsg call.
 template <typename Ip>
-bool UdpWriteRead(perftest::RepeatState* state, size_t message_size, size_t message_count) {
+bool UdpWriteRead(perftest::RepeatState* state, size_t message_size, size_t message_count,
+                  bool batched) {
   TemplateIsIpVersion<Ip>();
   using Addr = typename Ip::SockAddr;
 
@@ -201,8 +212,31 @@ bool UdpWriteRead(perftest::RepeatState* state, size_t message_size, size_t mess
   send_bytes.resize(message_size, 0xAA);
   recv_bytes.resize(message_size, 0xBB);
 
+  // Every message is sent from, and received into, the same buffer.
+  iovec send_iov = {.iov_base = send_bytes.data(), .iov_len = message_size};
+  iovec recv_iov = {.iov_base = recv_bytes.data(), .iov_len = message_size};
+  std::vector<mmsghdr> send_msgs(message_count), recv_msgs(message_count);
+  for (size_t i = 0; i < message_count; i++) {
+    send_msgs[i].msg_hdr = {.msg_iov = &send_iov, .msg_iovlen = 1};
+    recv_msgs[i].msg_hdr = {.msg_iov = &recv_iov, .msg_iovlen = 1};
+  }
+
   state->SetBytesProcessedPerRun(message_size);
   while (state->KeepRunning()) {
+    if (batched) {
+      int sent = sendmmsg(client_sock.get(), send_msgs.data(),
+                          static_cast<unsigned int>(message_count), 0);
+      CHECK_TRUE_ERRNO(sent >= 0);
+      FX_CHECK(static_cast<size_t>(sent) == message_count)
+          << "sent " << sent << " expected " << message_count;
+      for (size_t received = 0; received < message_count;) {
+        int rd = recvmmsg(server_sock.get(), recv_msgs.data() + received,
+                          static_cast<unsigned int>(message_count - received), 0, nullptr);
+        CHECK_TRUE_ERRNO(rd >= 0);
+        received += rd;
+      }
+      continue;
+    }
     for (size_t i = 0; i < message_count; i++) {
       ssize_t wr = write(client_sock.get(), send_bytes.data(), message_size);
       CHECK_TRUE_ERRNO(wr >= 0);
@@ -265,6 +299,282 @@ bool PingLatency(perftest::RepeatState* state) {
   return true;
 }
 
+// Runs a function on a set of threads one round at a time, so that benchmarks can measure flows
+// running concurrently without paying for thread creation on every run.
+class ParallelRounds {
+ public:
+  // `fn` is called with the index of the thread it runs on, once per round on every thread.
+  ParallelRounds(size_t thread_count, std::function<void(size_t)> fn) : fn_(std::move(fn)) {
+    threads_.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; i++) {
+      threads_.emplace_back([this, i]() { Worker(i); });
+    }
+  }
+
+  ~ParallelRounds() {
+    {
+      std::lock_guard lock(mutex_);
+      quit_ = true;
+    }
+    start_.notify_all();
+    for (std::thread& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  // Runs one round on every thread and waits for all of them to finish it.
+  void RunRound() {
+    std::unique_lock lock(mutex_);
+    round_++;
+    pending_ = threads_.size();
+    start_.notify_all();
+    done_.wait(lock, [this]() { return pending_ == 0; });
+  }
+
+ private:
+  void Worker(size_t index) {
+    uint64_t last_round = 0;
+    for (;;) {
+      {
+        std::unique_lock lock(mutex_);
+        start_.wait(lock, [this, last_round]() { return quit_ || round_ != last_round; });
+        if (quit_) {
+          return;
+        }
+        last_round = round_;
+      }
+      fn_(index);
+      std::lock_guard lock(mutex_);
+      if (--pending_ == 0) {
+        done_.notify_one();
+      }
+    }
+  }
+
+  const std::function<void(size_t)> fn_;
+  std::vector<std::thread> threads_;
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable done_;
+  uint64_t round_ = 0;
+  size_t pending_ = 0;
+  bool quit_ = false;
+};
+
+// A TCP connection over loopback, with Nagle's algorithm disabled on both ends.
+struct TcpFlow {
+  fbl::unique_fd client;
+  fbl::unique_fd server;
+};
+
+template <typename Ip>
+TcpFlow ConnectTcpFlow(const fbl::unique_fd& listen_sock,
+                       const typename Ip::SockAddr& listen_addr) {
+  TcpFlow flow;
+  CHECK_TRUE_ERRNO(flow.client = fbl::unique_fd(socket(Ip::kFamily, SOCK_STREAM, 0)));
+  CHECK_ZERO_ERRNO(
+      connect(flow.client.get(), listen_addr.as_sockaddr(), listen_addr.socklen()));
+  CHECK_TRUE_ERRNO(flow.server = fbl::unique_fd(accept(listen_sock.get(), nullptr, nullptr)));
+  const int32_t no_delay = 1;
+  for (int fd : {flow.client.get(), flow.server.get()}) {
+    CHECK_ZERO_ERRNO(setsockopt(fd, SOL_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay)));
+  }
+  return flow;
+}
+
+// Creates a TCP socket listening on an ephemeral loopback port and stores its address in `addr`.
+template <typename Ip>
+fbl::unique_fd ListenTcp(typename Ip::SockAddr& addr) {
+  fbl::unique_fd listen_sock;
+  CHECK_TRUE_ERRNO(listen_sock = fbl::unique_fd(socket(Ip::kFamily, SOCK_STREAM, 0)));
+  addr = Ip::loopback();
+  CHECK_ZERO_ERRNO(bind(listen_sock.get(), addr.as_sockaddr(), addr.socklen()));
+  CHECK_ZERO_ERRNO(listen(listen_sock.get(), SOMAXCONN));
+  socklen_t socklen = addr.socklen();
+  CHECK_ZERO_ERRNO(getsockname(listen_sock.get(), addr.as_sockaddr(), &socklen));
+  return listen_sock;
+}
+
+// Computes the aggregate unidirectional throughput of `flows` concurrent TCP loopback connections.
+//
+// Every run, each connection carries `transfer` bytes, written and read on two different threads.
+template <typename Ip>
+bool TcpMultiFlowThroughput(perftest::RepeatState* state, size_t transfer, size_t flows) {
+  TemplateIsIpVersion<Ip>();
+  typename Ip::SockAddr addr;
+  const fbl::unique_fd listen_sock = ListenTcp<Ip>(addr);
+  std::vector<TcpFlow> tcp_flows;
+  for (size_t i = 0; i < flows; i++) {
+    tcp_flows.push_back(ConnectTcpFlow<Ip>(listen_sock, addr));
+  }
+
+  // Avoid large memory regions with zeroes that can cause the system to try and reclaim pages from
+  // us. For more information see Zircon page scanner and eviction strategies.
+  const std::vector<uint8_t> send_bytes(transfer, 0xAA);
+  std::vector<std::vector<uint8_t>> recv_bytes(flows, std::vector<uint8_t>(transfer, 0xBB));
+
+  // The first `flows` threads write, the others read.
+  ParallelRounds rounds(2 * flows, [&](size_t index) {
+    if (index < flows) {
+      const fbl::unique_fd& fd = tcp_flows[index].client;
+      for (size_t sent = 0; sent < transfer;) {
+        ssize_t wr = write(fd.get(), send_bytes.data() + sent, transfer - sent);
+        CHECK_POSITIVE(wr);
+        sent += wr;
+      }
+    } else {
+      const fbl::unique_fd& fd = tcp_flows[index - flows].server;
+      std::vector<uint8_t>& buffer = recv_bytes[index - flows];
+      for (size_t recv = 0; recv < transfer;) {
+        ssize_t rd = read(fd.get(), buffer.data() + recv, transfer - recv);
+        CHECK_POSITIVE(rd);
+        recv += rd;
+      }
+    }
+  });
+
+  state->SetBytesProcessedPerRun(transfer * flows);
+  while (state->KeepRunning()) {
+    rounds.RunRound();
+  }
+  return true;
+}
+
+// Computes the aggregate packet rate of `flows` concurrent UDP loopback flows.
+//
+// Every run, each flow carries `message_count` messages of `message_size` bytes, written and read
+// on two different threads. The receive buffers are large enough to hold all of the messages of a
+// run, so none of them are dropped.
+template <typename Ip>
+bool UdpMultiFlowThroughput(perftest::RepeatState* state, size_t message_size, size_t flows) {
+  TemplateIsIpVersion<Ip>();
+  using Addr = typename Ip::SockAddr;
+  constexpr size_t kMessageCount = 32;
+
+  struct UdpFlow {
+    fbl::unique_fd client;
+    fbl::unique_fd server;
+  };
+  std::vector<UdpFlow> udp_flows(flows);
+  for (UdpFlow& flow : udp_flows) {
+    CHECK_TRUE_ERRNO(flow.server = fbl::unique_fd(socket(Ip::kFamily, SOCK_DGRAM, 0)));
+    Addr addr = Ip::loopback();
+    CHECK_ZERO_ERRNO(bind(flow.server.get(), addr.as_sockaddr(), addr.socklen()));
+    socklen_t socklen = addr.socklen();
+    CHECK_ZERO_ERRNO(getsockname(flow.server.get(), addr.as_sockaddr(), &socklen));
+
+    // See UdpWriteRead for why the receive buffer is only set when the default is too small.
+    int rcvbuf_opt;
+    socklen_t rcvbuf_optlen = sizeof(rcvbuf_opt);
+    CHECK_ZERO_ERRNO(
+        getsockopt(flow.server.get(), SOL_SOCKET, SO_RCVBUF, &rcvbuf_opt, &rcvbuf_optlen));
+    if (static_cast<size_t>(rcvbuf_opt) < message_size * kMessageCount) {
+      int rcv_bufsize = static_cast<int>(message_size * kMessageCount);
+      CHECK_ZERO_ERRNO(
+          setsockopt(flow.server.get(), SOL_SOCKET, SO_RCVBUF, &rcv_bufsize, sizeof(rcv_bufsize)));
+    }
+
+    CHECK_TRUE_ERRNO(flow.client = fbl::unique_fd(socket(Ip::kFamily, SOCK_DGRAM, 0)));
+    CHECK_ZERO_ERRNO(connect(flow.client.get(), addr.as_sockaddr(), addr.socklen()));
+  }
+
+  const std::vector<uint8_t> send_bytes(message_size, 0xAA);
+  std::vector<std::vector<uint8_t>> recv_bytes(flows, std::vector<uint8_t>(message_size, 0xBB));
+
+  // The first `flows` threads write, the others read.
+  ParallelRounds rounds(2 * flows, [&](size_t index) {
+    if (index < flows) {
+      const fbl::unique_fd& fd = udp_flows[index].client;
+      for (size_t i = 0; i < kMessageCount; i++) {
+        ssize_t wr = write(fd.get(), send_bytes.data(), message_size);
+        CHECK_TRUE_ERRNO(wr >= 0);
+        FX_CHECK(static_cast<size_t>(wr) == message_size)
+            << "wrote " << wr << " expected " << message_size;
+      }
+    } else {
+      const fbl::unique_fd& fd = udp_flows[index - flows].server;
+      std::vector<uint8_t>& buffer = recv_bytes[index - flows];
+      for (size_t i = 0; i < kMessageCount; i++) {
+        ssize_t rd = read(fd.get(), buffer.data(), message_size);
+        CHECK_TRUE_ERRNO(rd >= 0);
+        FX_CHECK(static_cast<size_t>(rd) == message_size)
+            << "read " << rd << " expected " << message_size;
+      }
+    }
+  });
+
+  state->SetBytesProcessedPerRun(message_size * kMessageCount * flows);
+  while (state->KeepRunning()) {
+    rounds.RunRound();
+  }
+  return true;
+}
+
+// Computes the rate at which `flows` threads can concurrently set up and tear down TCP loopback
+// connections.
+//
+// Every run, each thread connects to its own listening socket, accepts the connection and closes
+// both ends.
+template <typename Ip>
+bool TcpConnectionRate(perftest::RepeatState* state, size_t flows) {
+  TemplateIsIpVersion<Ip>();
+  std::vector<typename Ip::SockAddr> addrs(flows);
+  std::vector<fbl::unique_fd> listen_socks;
+  for (typename Ip::SockAddr& addr : addrs) {
+    listen_socks.push_back(ListenTcp<Ip>(addr));
+  }
+
+  ParallelRounds rounds(flows, [&](size_t index) {
+    TcpFlow flow = ConnectTcpFlow<Ip>(listen_socks[index], addrs[index]);
+    // Reset the connection rather than closing it gracefully, so that ephemeral ports don't pile
+    // up in TIME_WAIT over many runs.
+    const linger reset = {.l_onoff = 1, .l_linger = 0};
+    CHECK_ZERO_ERRNO(setsockopt(flow.client.get(), SOL_SOCKET, SO_LINGER, &reset, sizeof(reset)));
+    flow.client.reset();
+    flow.server.reset();
+  });
+
+  while (state->KeepRunning()) {
+    rounds.RunRound();
+  }
+  return true;
+}
+
+// Measures the round trip latency of a small message on `flows` concurrent TCP loopback
+// connections.
+//
+// Every run, each connection echoes one message back. perftest records the time of every run, so
+// the tail latency (e.g. p99) can be computed from the results.
+template <typename Ip>
+bool TcpRoundTripLatency(perftest::RepeatState* state, size_t flows) {
+  TemplateIsIpVersion<Ip>();
+  typename Ip::SockAddr addr;
+  const fbl::unique_fd listen_sock = ListenTcp<Ip>(addr);
+  std::vector<TcpFlow> tcp_flows;
+  for (size_t i = 0; i < flows; i++) {
+    tcp_flows.push_back(ConnectTcpFlow<Ip>(listen_sock, addr));
+  }
+
+  // The first `flows` threads send the request and wait for the response, the others echo it.
+  ParallelRounds rounds(2 * flows, [&](size_t index) {
+    uint8_t message = 0xAA;
+    if (index < flows) {
+      const fbl::unique_fd& fd = tcp_flows[index].client;
+      CHECK_POSITIVE(write(fd.get(), &message, sizeof(message)));
+      CHECK_POSITIVE(read(fd.get(), &message, sizeof(message)));
+    } else {
+      const fbl::unique_fd& fd = tcp_flows[index - flows].server;
+      CHECK_POSITIVE(read(fd.get(), &message, sizeof(message)));
+      CHECK_POSITIVE(write(fd.get(), &message, sizeof(message)));
+    }
+  });
+
+  while (state->KeepRunning()) {
+    rounds.RunRound();
+  }
+  return true;
+}
+
 constexpr char kFakeNetstackEnvVar[] = "FAKE_NETSTACK";
 constexpr char kNetstack3EnvVar[] = "NETSTACK3";
 
@@ -300,13 +610,14 @@ void RegisterTests() {
   };
 
   auto get_udp_test_name = [&bytes_with_unit, &network_to_string, &kSingleReadTestNameFmt](
-                               Network network, size_t raw_bytes,
-                               size_t message_count) -> std::string {
+                               Network network, size_t raw_bytes, size_t message_count,
+                               bool batched) -> std::string {
     std::string_view network_name = network_to_string(network);
     auto [bytes, bytes_unit] = bytes_with_unit(raw_bytes);
     constexpr std::string_view kUDP = "UDP";
     if (message_count > 1) {
-      return fxl::StringPrintf("MultiWriteRead/%s/%s/%ld%s/%ldMessages", kUDP.data(),
+      return fxl::StringPrintf("%s/%s/%s/%ld%s/%ldMessages",
+                               batched ? "BatchWriteRead" : "MultiWriteRead", kUDP.data(),
                                network_name.data(), bytes, bytes_unit.data(), message_count);
     } else {
       return fxl::StringPrintf(kSingleReadTestNameFmt.data(), kUDP.data(), network_name.data(),
@@ -328,16 +639,81 @@ void RegisterTests() {
     }
   }
 
+  constexpr size_t kFlowCounts[] = {1, 2, 4, 8};
+  auto get_multi_flow_test_name = [&bytes_with_unit, &network_to_string](
+                                      std::string_view name, std::string_view protocol,
+                                      Network network, std::optional<size_t> raw_bytes,
+                                      size_t flows) -> std::string {
+    std::string size;
+    if (raw_bytes.has_value()) {
+      auto [bytes, bytes_unit] = bytes_with_unit(raw_bytes.value());
+      size = fxl::StringPrintf("%ld%s/", bytes, bytes_unit.data());
+    }
+    return fxl::StringPrintf("%s/%s/%s/%s%ldFlows", name.data(), protocol.data(),
+                             network_to_string(network), size.c_str(), flows);
+  };
+
+  // TODO(https://fxbug.dev/104013): Remove the conditional once Netstack3
+  // supports enough of the POSIX TCP socket API.
+  if (!std::getenv(kNetstack3EnvVar)) {
+    constexpr size_t kTransferSizeForTcpMultiFlow = 100 << 10;
+    for (size_t flows : kFlowCounts) {
+      perftest::RegisterTest(get_multi_flow_test_name("MultiFlow", "TCP", Network::kIpv4,
+                                                      kTransferSizeForTcpMultiFlow, flows)
+                                 .c_str(),
+                             TcpMultiFlowThroughput<Ipv4>, kTransferSizeForTcpMultiFlow, flows);
+      perftest::RegisterTest(get_multi_flow_test_name("MultiFlow", "TCP", Network::kIpv6,
+                                                      kTransferSizeForTcpMultiFlow, flows)
+                                 .c_str(),
+                             TcpMultiFlowThroughput<Ipv6>, kTransferSizeForTcpMultiFlow, flows);
+      perftest::RegisterTest(
+          get_multi_flow_test_name("ConnectionRate", "TCP", Network::kIpv4, std::nullopt, flows)
+              .c_str(),
+          TcpConnectionRate<Ipv4>, flows);
+      perftest::RegisterTest(
+          get_multi_flow_test_name("ConnectionRate", "TCP", Network::kIpv6, std::nullopt, flows)
+              .c_str(),
+          TcpConnectionRate<Ipv6>, flows);
+      perftest::RegisterTest(
+          get_multi_flow_test_name("RoundTrip", "TCP", Network::kIpv4, std::nullopt, flows)
+              .c_str(),
+          TcpRoundTripLatency<Ipv4>, flows);
+      perftest::RegisterTest(
+          get_multi_flow_test_name("RoundTrip", "TCP", Network::kIpv6, std::nullopt, flows)
+              .c_str(),
+          TcpRoundTripLatency<Ipv6>, flows);
+    }
+  }
+
   // NB: Knowledge encoded at a distance: these datagrams avoid IP fragmentation
   // only because loopback has a very large MTU.
   constexpr size_t kMessageSizesForUdp[] = {1, 100, 1 << 10, 10 << 10, 60 << 10};
   constexpr size_t kMessageCountsForUdp[] = {1, 10, 50};
   for (size_t message_size : kMessageSizesForUdp) {
     for (size_t message_count : kMessageCountsForUdp) {
-      perftest::RegisterTest(get_udp_test_name(Network::kIpv4, message_size, message_count).c_str(),
-                             UdpWriteRead<Ipv4>, message_size, message_count);
-      perftest::RegisterTest(get_udp_test_name(Network::kIpv6, message_size, message_count).c_str(),
-                             UdpWriteRead<Ipv6>, message_size, message_count);
+      for (bool batched : {false, true}) {
+        if (batched && message_count == 1) {
+          continue;
+        }
+        perftest::RegisterTest(
+            get_udp_test_name(Network::kIpv4, message_size, message_count, batched).c_str(),
+            UdpWriteRead<Ipv4>, message_size, message_count, batched);
+        perftest::RegisterTest(
+            get_udp_test_name(Network::kIpv6, message_size, message_count, batched).c_str(),
+            UdpWriteRead<Ipv6>, message_size, message_count, batched);
+      }
+    }
+  }
+
+  constexpr size_t kMessageSizesForUdpMultiFlow[] = {100, 1 << 10};
+  for (size_t message_size : kMessageSizesForUdpMultiFlow) {
+    for (size_t flows : kFlowCounts) {
+      perftest::RegisterTest(
+          get_multi_flow_test_name("MultiFlow", "UDP", Network::kIpv4, message_size, flows).c_str(),
+          UdpMultiFlowThroughput<Ipv4>, message_size, flows);
+      perftest::RegisterTest(
+          get_multi_flow_test_name("MultiFlow", "UDP", Network::kIpv6, message_size, flows).c_str(),
+          UdpMultiFlowThroughput<Ipv6>, message_size, flows);
     }
   }
 
@@ -13,6 +13,7 @@
 #include <array>
 #include <future>
 #include <latch>
+#include <string_view>
 
 #include <fbl/unique_fd.h>
 #include <gtest/gtest.h>
@@ -1298,6 +1299,73 @@ TEST(NetDatagramTest, DatagramSendtoRecvfrom) {
   EXPECT_EQ(close(recvfd.release()), 0) << strerror(errno);
 }
 
+TEST(NetDatagramTest, DatagramSendmmsgRecvmmsg) {
+  fbl::unique_fd recvfd;
+  ASSERT_TRUE(recvfd = fbl::unique_fd(socket(AF_INET, SOCK_DGRAM, 0))) << strerror(errno);
+  sockaddr_in addr = LoopbackSockaddrV4(0);
+  ASSERT_EQ(bind(recvfd.get(), reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)), 0)
+      << strerror(errno);
+  socklen_t addrlen = sizeof(addr);
+  ASSERT_EQ(getsockname(recvfd.get(), reinterpret_cast<sockaddr*>(&addr), &addrlen), 0)
+      << strerror(errno);
+
+  fbl::unique_fd sendfd;
+  ASSERT_TRUE(sendfd = fbl::unique_fd(socket(AF_INET, SOCK_DGRAM, 0))) << strerror(errno);
+  ASSERT_EQ(connect(sendfd.get(), reinterpret_cast<const sockaddr*>(&addr), addrlen), 0)
+      << strerror(errno);
+
+  constexpr std::array<std::string_view, 3> kMessages = {"hello", "batched", "world"};
+  std::array<iovec, kMessages.size()> send_iovs;
+  std::array<mmsghdr, kMessages.size()> send_msgs = {};
+  for (size_t i = 0; i < kMessages.size(); ++i) {
+    send_iovs[i] = {
+        .iov_base = const_cast<char*>(kMessages[i].data()),
+        .iov_len = kMessages[i].size(),
+    };
+    send_msgs[i].msg_hdr.msg_iov = &send_iovs[i];
+    send_msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+  ASSERT_EQ(
+      sendmmsg(sendfd.get(), send_msgs.data(), static_cast<unsigned int>(send_msgs.size()), 0),
+      static_cast<int>(kMessages.size()))
+      << strerror(errno);
+  for (size_t i = 0; i < kMessages.size(); ++i) {
+    EXPECT_EQ(send_msgs[i].msg_len, kMessages[i].size());
+  }
+
+  // Ask for one more message than was sent; MSG_WAITFORONE returns what is available instead of
+  // blocking for it.
+  std::array<std::array<char, 16>, kMessages.size() + 1> bufs;
+  std::array<iovec, bufs.size()> recv_iovs;
+  std::array<mmsghdr, bufs.size()> recv_msgs = {};
+  for (size_t i = 0; i < bufs.size(); ++i) {
+    recv_iovs[i] = {.iov_base = bufs[i].data(), .iov_len = bufs[i].size()};
+    recv_msgs[i].msg_hdr.msg_iov = &recv_iovs[i];
+    recv_msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+  // The datagrams may not all be readable by the time the first one is.
+  size_t received = 0;
+  while (received < kMessages.size()) {
+    int result = recvmmsg(recvfd.get(), recv_msgs.data() + received,
+                          static_cast<unsigned int>(recv_msgs.size() - received), MSG_WAITFORONE,
+                          nullptr);
+    ASSERT_GT(result, 0) << strerror(errno);
+    received += result;
+  }
+  ASSERT_EQ(received, kMessages.size());
+  for (size_t i = 0; i < kMessages.size(); ++i) {
+    EXPECT_EQ(std::string_view(bufs[i].data(), recv_msgs[i].msg_len), kMessages[i]);
+  }
+
+  EXPECT_EQ(recvmmsg(recvfd.get(), recv_msgs.data(), static_cast<unsigned int>(recv_msgs.size()),
+                     MSG_DONTWAIT, nullptr),
+            -1);
+  EXPECT_EQ(errno, EAGAIN) << strerror(errno);
+
+  EXPECT_EQ(close(sendfd.release()), 0) << strerror(errno);
+  EXPECT_EQ(close(recvfd.release()), 0) << strerror(errno);
+}
+
 // DatagramSendtoRecvfromV6 tests if UDP send automatically binds an ephemeral
 // port where the receiver can responds to.
 TEST(NetDatagramTest, DatagramSendtoRecvfromV6) {
@@ -214,15 +214,7 @@ TEST_F(NetStreamSocketsTest, Sendmmsg) {
       .msg_hdr = {},
       .msg_len = 0,
   };
-  int result = sendmmsg(client().get(), &header, 0u, 0u);
-  if (kIsFuchsia) {
-    // Fuchsia does not support sendmmsg().
-    // TODO(https://fxbug.dev/45262, https://fxbug.dev/42678): Implement sendmmsg().
-    EXPECT_EQ(result, -1);
-    EXPECT_EQ(errno, ENOSYS) << strerror(errno);
-  } else {
-    EXPECT_EQ(result, 0) << strerror(errno);
-  }
+  EXPECT_EQ(sendmmsg(client().get(), &header, 0u, 0u), 0) << strerror(errno);
 }
 
 TEST_F(NetStreamSocketsTest, Recvmmsg) {
@@ -230,15 +222,8 @@ TEST_F(NetStreamSocketsTest, Recvmmsg) {
       .msg_hdr = {},
       .msg_len = 0,
   };
-  int result = recvmmsg(client().get(), &header, 1u, MSG_DONTWAIT, nullptr);
-  EXPECT_EQ(result, -1);
-  if (kIsFuchsia) {
-    // Fuchsia does not support recvmmsg().
-    // TODO(https://fxbug.dev/45260): Implement recvmmsg().
-    EXPECT_EQ(errno, ENOSYS) << strerror(errno);
-  } else {
-    EXPECT_EQ(errno, EAGAIN) << strerror(errno);
-  }
+  EXPECT_EQ(recvmmsg(client().get(), &header, 1u, MSG_DONTWAIT, nullptr), -1);
+  EXPECT_EQ(errno, EAGAIN) << strerror(errno);
 }
 
 TEST_F(NetStreamSocketsTest, BlockingAcceptDupWrite) {
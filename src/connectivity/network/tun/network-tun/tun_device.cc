@@ -156,7 +156,9 @@ void TunDevice::RunReadFrame() {
       if (!ports_[port_id] || !ports_[port_id]->adapter().online()) {
         return ZX_ERR_UNAVAILABLE;
       }
-      std::vector<uint8_t> data;
+      // Reuse the same allocation for every frame, only its size changes.
+      std::vector<uint8_t>& data = read_frame_data_;
+      data.clear();
       zx_status_t status = buff.Read(data);
       if (status != ZX_OK) {
         FX_LOGF(ERROR, "tun", "Failed to read from tx buffer: %s", zx_status_get_string(status));
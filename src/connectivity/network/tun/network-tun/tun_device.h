@@ -9,6 +9,7 @@
 #include <lib/async-loop/cpp/loop.h>
 
 #include <queue>
+#include <vector>
 
 #include <fbl/intrusive_double_list.h>
 #include <fbl/mutex.h>
@@ -154,8 +155,12 @@ class TunDevice : public fbl::DoublyLinkedListable<std::unique_ptr<TunDevice>>,
     }
   };
 
+  // Every frame costs a FIDL round trip. Moving many frames per call, or through a ring in a VMO
+  // shared with the client, would need new methods in fuchsia.net.tun/Device.
   std::queue<ReadFrameCompleter::Async> pending_read_frame_;
   std::queue<PendingWriteRequest> pending_write_frame_;
+  // Scratch space the data of a tx buffer is read into to serve ReadFrame.
+  std::vector<uint8_t> read_frame_data_;
 
   zx::eventpair signals_self_;
   zx::eventpair signals_peer_;
@@ -813,21 +813,14 @@ void Device::Recv(RecvRequestView request, fdf::Arena& arena, RecvCompleter::Syn
   wlan_rx_packet_t rx_packet;
 
   {
-    // Lock the buffer operations to prevent data corruption when multiple thread are calling into
-    // this function.
+    // Serialize the frames delivered to MLME when multiple threads are calling into this function.
     std::lock_guard lock(rx_lock_);
+    // The converted packet borrows the frame from the request, which outlives the recv() call.
     if ((status = ConvertRxPacket(request->packet, &rx_packet)) != ZX_OK) {
       errorf("RxPacket conversion failed: %s", zx_status_get_string(status));
     }
 
     wlan_softmac_ifc_protocol_->ops->recv(wlan_softmac_ifc_protocol_->ctx, &rx_packet);
-    if (unlikely(request->packet.mac_frame.count() > PRE_ALLOC_RECV_BUFFER_SIZE)) {
-      // Freeing the frame buffer allocated in ConvertRxPacket() above.
-      memset(const_cast<uint8_t*>(rx_packet.mac_frame_buffer), 0, rx_packet.mac_frame_size);
-      free(const_cast<uint8_t*>(rx_packet.mac_frame_buffer));
-    } else {
-      memset(pre_alloc_recv_buffer, 0, PRE_ALLOC_RECV_BUFFER_SIZE);
-    }
   }
 
   completer.buffer(arena).Reply();
@@ -272,6 +272,7 @@ TEST(ConvertTest, ToBanjoRxPacket) {
 
   // Verify outputs
   EXPECT_EQ(kFakePacketSize, out.mac_frame_size);
+  EXPECT_EQ(rx_packet, out.mac_frame_buffer);
   for (size_t i = 0; i < kFakePacketSize; i++) {
     EXPECT_EQ(kRandomPopulaterUint8, out.mac_frame_buffer[i]);
   }
@@ -306,7 +306,11 @@ zx_status_t UnwindStackFuchsia(const ProcessHandle& process, const ModuleList& m
                                const ThreadHandle& thread, const GeneralRegisters& regs,
                                size_t max_depth, std::vector<debug_ipc::StackFrame>* stack) {
   // Prepare arguments for unwinder::Unwind.
-  unwinder::FuchsiaMemory memory(process.GetNativeHandle().get());
+  //
+  // The unwinder reads the stack and the modules' unwind tables in many small pieces. Reading them
+  // a page at a time through the cache saves a syscall for most of those reads.
+  unwinder::FuchsiaMemory process_memory(process.GetNativeHandle().get());
+  unwinder::CachedMemory memory(&process_memory);
   std::vector<uint64_t> module_bases;
   module_bases.reserve(modules.modules().size());
   for (const auto& module : modules.modules()) {
@@ -4,8 +4,10 @@
 
 #include "src/developer/debug/unwinder/memory.h"
 
+#include <algorithm>
 #include <cstdint>
 
+#include "lib/syslog/cpp/macros.h"
 #include "src/developer/debug/unwinder/error.h"
 
 namespace unwinder {
@@ -172,4 +174,44 @@ Error BoundedLocalMemory::ReadBytes(uint64_t addr, uint64_t size, void* dst) {
   return Error("out of boundry");
 }
 
+CachedMemory::CachedMemory(Memory* backing, uint64_t block_size)
+    : backing_(backing), block_size_(block_size) {
+  FX_DCHECK(block_size_ && (block_size_ & (block_size_ - 1)) == 0);
+}
+
+Error CachedMemory::ReadBytes(uint64_t addr, uint64_t size, void* dst) {
+  auto out = static_cast<uint8_t*>(dst);
+  uint64_t cur = addr;
+  uint64_t remaining = size;
+  while (remaining) {
+    uint64_t block_addr = cur & ~(block_size_ - 1);
+    uint64_t offset = cur - block_addr;
+    uint64_t count = std::min(remaining, block_size_ - offset);
+
+    const uint8_t* block = GetBlock(block_addr);
+    if (!block) {
+      // Part of the block is inaccessible, e.g. the end of a stack. The requested range itself may
+      // still be readable.
+      return backing_->ReadBytes(addr, size, dst);
+    }
+    memcpy(out, block + offset, count);
+
+    out += count;
+    cur += count;
+    remaining -= count;
+  }
+  return Success();
+}
+
+const uint8_t* CachedMemory::GetBlock(uint64_t block_addr) {
+  auto [it, inserted] = blocks_.try_emplace(block_addr);
+  if (inserted) {
+    it->second.resize(block_size_);
+    if (backing_->ReadBytes(block_addr, block_size_, it->second.data()).has_err()) {
+      it->second.clear();
+    }
+  }
+  return it->second.empty() ? nullptr : it->second.data();
+}
+
 }  // namespace unwinder
@@ -8,6 +8,7 @@
 #include <cstdint>
 #include <cstring>
 #include <map>
+#include <vector>
 
 #include "src/developer/debug/unwinder/error.h"
 
@@ -61,6 +62,34 @@ class BoundedLocalMemory : public LocalMemory {
   std::map<uint64_t, uint64_t> regions_;
 };
 
+// Memory that reads from another Memory in whole aligned blocks and keeps them. Unwinding reads
+// the same stack and unwind table pages many times in small pieces, and for remote memory each of
+// those reads is a syscall. Reads that cover a block that can't be read as a whole go directly to
+// the backing memory and are not cached.
+//
+// Nothing is ever evicted, so this is only for short-lived use such as a single unwind, during
+// which the memory is not expected to change.
+class CachedMemory : public Memory {
+ public:
+  static constexpr uint64_t kDefaultBlockSize = 4096;
+
+  // The backing memory must outlive this object. The block size must be a power of 2.
+  explicit CachedMemory(Memory* backing, uint64_t block_size = kDefaultBlockSize);
+
+  Error ReadBytes(uint64_t addr, uint64_t size, void* dst) override;
+
+ private:
+  // Returns the contents of the block at the given aligned address, reading it if necessary.
+  // Returns null if the block can't be read as a whole.
+  const uint8_t* GetBlock(uint64_t block_addr);
+
+  Memory* backing_;
+  uint64_t block_size_;
+
+  // Cached blocks indexed by address. An empty vector marks a block that failed to read.
+  std::map<uint64_t, std::vector<uint8_t>> blocks_;
+};
+
 }  // namespace unwinder
 
 #endif  // SRC_DEVELOPER_DEBUG_UNWINDER_MEMORY_H_
@@ -90,4 +90,46 @@ TEST(BoundedLocalMemory, Read) {
   ASSERT_TRUE(mem.Read(p, res).has_err());
 }
 
+// Counts the reads that reach the backing memory.
+class CountingMemory : public BoundedLocalMemory {
+ public:
+  Error ReadBytes(uint64_t addr, uint64_t size, void* dst) override {
+    reads++;
+    return BoundedLocalMemory::ReadBytes(addr, size, dst);
+  }
+
+  int reads = 0;
+};
+
+TEST(CachedMemory, Read) {
+  alignas(64) uint8_t data[256];
+  for (size_t i = 0; i < sizeof(data); i++) {
+    data[i] = static_cast<uint8_t>(i);
+  }
+  auto p = reinterpret_cast<uint64_t>(data);
+
+  // The last block is only partially readable.
+  CountingMemory backing;
+  backing.AddRegion(p, 200);
+  CachedMemory mem(&backing, 64);
+
+  // Reads within one block only read it once.
+  uint32_t u32;
+  ASSERT_TRUE(mem.Read(p + 4, u32).ok());
+  ASSERT_EQ(0x07060504u, u32);
+  ASSERT_TRUE(mem.Read(p + 8, u32).ok());
+  ASSERT_EQ(0x0B0A0908u, u32);
+  ASSERT_EQ(1, backing.reads);
+
+  // A read spanning two blocks reads the new one only.
+  ASSERT_TRUE(mem.Read(p + 62, u32).ok());
+  ASSERT_EQ(0x41403F3Eu, u32);
+  ASSERT_EQ(2, backing.reads);
+
+  // The readable part of a partially readable block falls back to reading directly.
+  ASSERT_TRUE(mem.Read(p + 192, u32).ok());
+  ASSERT_EQ(0xC3C2C1C0u, u32);
+  ASSERT_TRUE(mem.Read(p + 198, u32).has_err());
+}
+
 }  // namespace unwinder
@@ -110,6 +110,19 @@ void BuildIDIndex::SetCacheDir(const std::string& cache_dir) {
   cache_dir_ = std::make_unique<CacheDir>(cache_dir);
 }
 
+std::filesystem::path BuildIDIndex::GetIndexCachePath(const std::string& build_id) const {
+  if (!cache_dir_ || build_id.empty())
+    return std::filesystem::path();
+
+  // Keep the indexes out of the build ID layout of the rest of the cache directory.
+  return cache_dir_->path() / "zxdb_index" / (build_id + ".index");
+}
+
+void BuildIDIndex::NotifyCacheFileAccess(const std::filesystem::path& path) {
+  if (cache_dir_)
+    cache_dir_->NotifyFileAccess(path);
+}
+
 void BuildIDIndex::AddSymbolIndexFile(const std::string& path) {
   if (StringEndsWith(path, ".json")) {
     LoadSymbolIndexFileJSON(path);
@@ -110,6 +110,14 @@ class BuildIDIndex {
   // Returns the path to the cache directory or an empty path if it's not set.
   std::filesystem::path GetCacheDir() const { return cache_dir_ ? cache_dir_->path() : ""; }
 
+  // Returns the path in the cache directory where the symbol index of the module with the given
+  // build ID is saved, or an empty path if there's no cache directory. The file may not exist.
+  std::filesystem::path GetIndexCachePath(const std::string& build_id) const;
+
+  // Notifies the cache directory that a file in it was read or created, so it's accounted for in
+  // the cache's size limit. Does nothing if there's no cache directory.
+  void NotifyCacheFileAccess(const std::filesystem::path& path);
+
   // Add a symbol-index file that indexes various symbol sources.
   //
   // Two versions of symbol-index files are supported currently:
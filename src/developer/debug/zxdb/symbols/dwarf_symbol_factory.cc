@@ -127,11 +127,29 @@ fxl::RefPtr<Symbol> DwarfSymbolFactory::CreateSymbol(uint64_t factory_data) cons
   if (!symbols_)
     return fxl::MakeRefCounted<Symbol>();
 
+  if (auto found = symbol_cache_index_.find(factory_data); found != symbol_cache_index_.end()) {
+    symbol_cache_.splice(symbol_cache_.begin(), symbol_cache_, found->second);
+    return found->second->second;
+  }
+
   llvm::DWARFDie die = GetLLVMContext()->getDIEForOffset(factory_data);
   if (!die.isValid())
     return fxl::MakeRefCounted<Symbol>();
 
-  return DecodeSymbol(die);
+  fxl::RefPtr<Symbol> symbol = DecodeSymbol(die);
+
+  symbol_cache_.emplace_front(factory_data, symbol);
+  symbol_cache_index_[factory_data] = symbol_cache_.begin();
+  if (symbol_cache_.size() > kMaxCachedSymbols) {
+    symbol_cache_index_.erase(symbol_cache_.back().first);
+    symbol_cache_.pop_back();
+  }
+  return symbol;
+}
+
+void DwarfSymbolFactory::ClearCache() const {
+  symbol_cache_index_.clear();
+  symbol_cache_.clear();
 }
 
 llvm::DWARFContext* DwarfSymbolFactory::GetLLVMContext() const {
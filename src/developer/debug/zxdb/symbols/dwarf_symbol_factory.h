@@ -5,6 +5,10 @@
 #ifndef SRC_DEVELOPER_DEBUG_ZXDB_SYMBOLS_DWARF_SYMBOL_FACTORY_H_
 #define SRC_DEVELOPER_DEBUG_ZXDB_SYMBOLS_DWARF_SYMBOL_FACTORY_H_
 
+#include <list>
+#include <unordered_map>
+#include <utility>
+
 #include "src/developer/debug/zxdb/symbols/dwarf_tag.h"
 #include "src/developer/debug/zxdb/symbols/symbol_factory.h"
 #include "src/lib/fxl/memory/weak_ptr.h"
@@ -34,6 +38,13 @@ class DwarfSymbolFactory : public SymbolFactory {
   UncachedLazySymbol MakeUncachedLazy(const llvm::DWARFDie& die) const;
   UncachedLazySymbol MakeUncachedLazy(uint64_t die_offset) const;
 
+  // Drops all symbols cached by CreateSymbol(). Cached symbols can hold LazySymbols referencing
+  // this factory, so the module must call this when it goes away to break the reference cycle.
+  void ClearCache() const;
+
+  // Maximum number of symbols kept by the CreateSymbol() cache.
+  static constexpr size_t kMaxCachedSymbols = 4096;
+
  private:
   FRIEND_REF_COUNTED_THREAD_SAFE(DwarfSymbolFactory);
   FRIEND_MAKE_REF_COUNTED(DwarfSymbolFactory);
@@ -82,6 +93,13 @@ class DwarfSymbolFactory : public SymbolFactory {
   // This can be null if the module is unloaded but there are still some dangling type references to
   // it.
   fxl::WeakPtr<ModuleSymbolsImpl> symbols_;
+
+  // Recently created symbols by DIE offset, most recently used first. Separate LazySymbols for the
+  // same DIE (such as ones made for each lookup of the same index entry, or for each frame of a
+  // backtrace in the same function) then decode it only once.
+  using SymbolCache = std::list<std::pair<uint64_t, fxl::RefPtr<Symbol>>>;
+  mutable SymbolCache symbol_cache_;
+  mutable std::unordered_map<uint64_t, SymbolCache::iterator> symbol_cache_index_;
 };
 
 }  // namespace zxdb
@@ -63,6 +63,21 @@ fxl::RefPtr<Function> GetFunctionWithName(ModuleSymbolsImpl* module_symbols,
 
 }  // namespace
 
+TEST(DwarfSymbolFactory, CachesCreatedSymbols) {
+  TestSymbolModule setup(TestSymbolModule::kBuilt);
+  ASSERT_TRUE(setup.Init("/build_dir").ok());
+
+  std::vector<IndexNode::SymbolRef> refs =
+      setup.symbols()->GetIndex().FindExact(TestSymbolModule::SplitName(kGetIntPtrName));
+  ASSERT_EQ(1u, refs.size());
+
+  // Independent LazySymbols for the same DIE resolve to the same decoded symbol.
+  LazySymbol first = setup.symbols()->IndexSymbolRefToSymbol(refs[0]);
+  LazySymbol second = setup.symbols()->IndexSymbolRefToSymbol(refs[0]);
+  ASSERT_TRUE(first.Get()->As<Function>());
+  EXPECT_EQ(first.Get(), second.Get());
+}
+
 TEST(DwarfSymbolFactory, Function) {
   TestSymbolModule setup(TestSymbolModule::kBuilt);
   ASSERT_TRUE(setup.Init("/build_dir").ok());
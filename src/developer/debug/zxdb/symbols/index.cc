@@ -4,6 +4,12 @@
 
 #include "src/developer/debug/zxdb/symbols/index.h"
 
+#include <string.h>
+
+#include <istream>
+#include <ostream>
+#include <type_traits>
+
 #include "llvm/DebugInfo/DWARF/DWARFContext.h"
 #include "llvm/DebugInfo/DWARF/DWARFDebugInfoEntry.h"
 #include "llvm/DebugInfo/DWARF/DWARFUnit.h"
@@ -21,6 +27,106 @@ namespace {
 // Don't index more than this number of levels to prevent infinite recursion.
 constexpr size_t kMaxParentPath = 16;
 
+// Identifies a serialized index. The version must be incremented whenever the format below or the
+// contents of the index change, since caches persist across zxdb versions.
+constexpr char kCacheMagic[8] = {'Z', 'X', 'D', 'B', 'I', 'D', 'X', '\0'};
+constexpr uint32_t kCacheVersion = 1;
+
+// Limits on the serialized data, used to reject corrupt caches. Indexing gives up on anything
+// deeper than kMaxParentPath components, so a valid index tree is never deeper than this.
+constexpr size_t kMaxCacheNodeDepth = kMaxParentPath + 2;
+constexpr uint32_t kMaxCacheStringSize = 1024 * 1024;
+
+template <typename T>
+void WriteCacheValue(std::ostream& out, T value) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool ReadCacheValue(std::istream& in, T* value) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  in.read(reinterpret_cast<char*>(value), sizeof(T));
+  return static_cast<bool>(in);
+}
+
+void WriteCacheString(std::ostream& out, const std::string& str) {
+  WriteCacheValue<uint32_t>(out, static_cast<uint32_t>(str.size()));
+  out.write(str.data(), str.size());
+}
+
+bool ReadCacheString(std::istream& in, std::string* str) {
+  uint32_t size = 0;
+  if (!ReadCacheValue(in, &size) || size > kMaxCacheStringSize)
+    return false;
+  str->resize(size);
+  in.read(str->data(), size);
+  return static_cast<bool>(in);
+}
+
+void WriteCacheSymbolRef(std::ostream& out, const IndexNode::SymbolRef& ref) {
+  WriteCacheValue<uint8_t>(out, static_cast<uint8_t>(ref.kind()));
+  WriteCacheValue<uint64_t>(out, ref.offset());
+}
+
+bool ReadCacheSymbolRef(std::istream& in, IndexNode::SymbolRef* ref) {
+  uint8_t kind = 0;
+  uint64_t offset = 0;
+  if (!ReadCacheValue(in, &kind) || !ReadCacheValue(in, &offset))
+    return false;
+  if (kind > IndexNode::SymbolRef::kDwarfDeclaration)
+    return false;
+  *ref = IndexNode::SymbolRef(static_cast<IndexNode::SymbolRef::Kind>(kind), offset);
+  return true;
+}
+
+void WriteCacheNode(std::ostream& out, const IndexNode& node) {
+  WriteCacheValue<uint32_t>(out, static_cast<uint32_t>(node.dies().size()));
+  for (const auto& ref : node.dies())
+    WriteCacheSymbolRef(out, ref);
+
+  for (int i = 0; i < static_cast<int>(IndexNode::Kind::kEndPhysical); i++) {
+    const IndexNode::Map& map = node.MapForKind(static_cast<IndexNode::Kind>(i));
+    WriteCacheValue<uint32_t>(out, static_cast<uint32_t>(map.size()));
+    for (const auto& [name, child] : map) {
+      WriteCacheString(out, name);
+      WriteCacheNode(out, child);
+    }
+  }
+}
+
+bool ReadCacheNode(std::istream& in, IndexNode* node, size_t depth) {
+  if (depth > kMaxCacheNodeDepth)
+    return false;
+
+  uint32_t die_count = 0;
+  if (!ReadCacheValue(in, &die_count))
+    return false;
+  if (die_count > 0 && node->kind() == IndexNode::Kind::kRoot)
+    return false;  // The root never has DIEs, and AddDie() asserts on it.
+  for (uint32_t i = 0; i < die_count; i++) {
+    IndexNode::SymbolRef ref;
+    if (!ReadCacheSymbolRef(in, &ref))
+      return false;
+    node->AddDie(ref);
+  }
+
+  std::string name;
+  for (int i = 0; i < static_cast<int>(IndexNode::Kind::kEndPhysical); i++) {
+    uint32_t child_count = 0;
+    if (!ReadCacheValue(in, &child_count))
+      return false;
+    for (uint32_t child_i = 0; child_i < child_count; child_i++) {
+      if (!ReadCacheString(in, &name))
+        return false;
+      IndexNode* child = node->AddChild(static_cast<IndexNode::Kind>(i), name.c_str());
+      if (!ReadCacheNode(in, child, depth + 1))
+        return false;
+    }
+  }
+  return true;
+}
+
 // Stores a name with a SymbolRef for later indexing.
 class NamedSymbolRef : public IndexNode::SymbolRef {
  public:
@@ -593,6 +699,75 @@ void Index::CreateIndex(llvm::object::ObjectFile* object_file, bool force_slow_p
     compile_units[i].reset();
 }
 
+void Index::WriteCache(std::ostream& out) const {
+  out.write(kCacheMagic, sizeof(kCacheMagic));
+  WriteCacheValue(out, kCacheVersion);
+
+  WriteCacheNode(out, root_);
+
+  WriteCacheValue<uint32_t>(out, static_cast<uint32_t>(main_functions_.size()));
+  for (const auto& ref : main_functions_)
+    WriteCacheSymbolRef(out, ref);
+
+  WriteCacheValue<uint32_t>(out, static_cast<uint32_t>(files_.size()));
+  for (const auto& [file_name, unit_indices] : files_) {
+    WriteCacheString(out, file_name);
+    WriteCacheValue<uint32_t>(out, static_cast<uint32_t>(unit_indices.size()));
+    for (unsigned unit_index : unit_indices)
+      WriteCacheValue<uint32_t>(out, unit_index);
+  }
+}
+
+bool Index::ReadCache(std::istream& in) {
+  Clear();
+
+  // Reading is done straight into the members, so any failure must leave them empty again.
+  auto fail = [this]() {
+    Clear();
+    return false;
+  };
+
+  char magic[sizeof(kCacheMagic)];
+  in.read(magic, sizeof(magic));
+  uint32_t version = 0;
+  if (!in || memcmp(magic, kCacheMagic, sizeof(magic)) != 0 || !ReadCacheValue(in, &version) ||
+      version != kCacheVersion)
+    return fail();
+
+  if (!ReadCacheNode(in, &root_, 0))
+    return fail();
+
+  uint32_t main_count = 0;
+  if (!ReadCacheValue(in, &main_count))
+    return fail();
+  for (uint32_t i = 0; i < main_count; i++) {
+    IndexNode::SymbolRef ref;
+    if (!ReadCacheSymbolRef(in, &ref))
+      return fail();
+    main_functions_.push_back(ref);
+  }
+
+  uint32_t file_count = 0;
+  if (!ReadCacheValue(in, &file_count))
+    return fail();
+  std::string file_name;
+  for (uint32_t i = 0; i < file_count; i++) {
+    uint32_t unit_count = 0;
+    if (!ReadCacheString(in, &file_name) || !ReadCacheValue(in, &unit_count))
+      return fail();
+    std::vector<unsigned>& unit_indices = files_[file_name];
+    for (uint32_t unit_i = 0; unit_i < unit_count; unit_i++) {
+      uint32_t unit_index = 0;
+      if (!ReadCacheValue(in, &unit_index))
+        return fail();
+      unit_indices.push_back(unit_index);
+    }
+  }
+
+  IndexFileNames();
+  return true;
+}
+
 void Index::DumpFileIndex(std::ostream& out) const {
   for (const auto& [filename, file_index_entry] : file_name_index_) {
     const auto& [filepath, compilation_units] = *file_index_entry;
@@ -695,4 +870,11 @@ void Index::IndexFileNames() {
     file_name_index_.insert(std::make_pair(ExtractLastFileComponent(iter->first), iter));
 }
 
+void Index::Clear() {
+  root_ = IndexNode(IndexNode::Kind::kRoot);
+  file_name_index_.clear();
+  files_.clear();
+  main_functions_.clear();
+}
+
 }  // namespace zxdb
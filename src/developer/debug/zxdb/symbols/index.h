@@ -43,6 +43,15 @@ class Index {
   // indexed with the slow path for validation purposes.
   void CreateIndex(llvm::object::ObjectFile* object_file, bool force_slow_path = false);
 
+  // Serializes the index to the given stream so it can be loaded by ReadCache() in a later session
+  // without reparsing the DWARF. The cache format is specific to the host and the zxdb version, and
+  // the caller is responsible for keying the cache to the module (normally by build ID).
+  void WriteCache(std::ostream& out) const;
+
+  // Replaces the contents of this index with one previously written by WriteCache(). Returns false
+  // and leaves the index empty if the data is not a valid cache of the current format.
+  bool ReadCache(std::istream& in);
+
   // Dumps the file index to the stream for debugging.
   void DumpFileIndex(std::ostream& out) const;
 
@@ -94,6 +103,9 @@ class Index {
   // Populates the file_name_index_ given a now-unchanging files_ map.
   void IndexFileNames();
 
+  // Resets the index to the empty state.
+  void Clear();
+
   // Symbol index.
   IndexNode root_ = IndexNode(IndexNode::Kind::kRoot);
 
@@ -2,10 +2,15 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <sstream>
+
 #include <gtest/gtest.h>
 
 #include "src/developer/debug/zxdb/common/perf_test.h"
+#include "src/developer/debug/zxdb/symbols/dwarf_binary_impl.h"
 #include "src/developer/debug/zxdb/symbols/index.h"
+#include "src/developer/debug/zxdb/symbols/module_symbols_impl.h"
+#include "src/developer/debug/zxdb/symbols/test_symbol_module.h"
 
 namespace zxdb {
 
@@ -14,4 +19,28 @@ TEST(ModuleLoad, Perf) {
   // TODO(brettw) write this.
 }
 
+// Compares creating the index from DWARF with loading it from the on-disk cache.
+TEST(IndexCache, Perf) {
+  TestSymbolModule setup(TestSymbolModule::kCheckedIn);
+  ASSERT_TRUE(setup.Init("", false).ok());
+
+  Index index;
+  {
+    PerfTimeLogger logger("zxdb", "IndexCreate");
+    index.CreateIndex(setup.symbols()->binary()->GetLLVMObjectFile());
+  }
+
+  std::stringstream cache;
+  {
+    PerfTimeLogger logger("zxdb", "IndexCacheWrite");
+    index.WriteCache(cache);
+  }
+
+  Index loaded;
+  {
+    PerfTimeLogger logger("zxdb", "IndexCacheRead");
+    ASSERT_TRUE(loaded.ReadCache(cache));
+  }
+}
+
 }  // namespace zxdb
@@ -218,6 +218,38 @@ TEST(Index, FindFileMatches) {
   EXPECT_EQ(0u, result.size());
 }
 
+TEST(Index, Cache) {
+  TestSymbolModule setup(TestSymbolModule::kCheckedIn);
+  ASSERT_TRUE(setup.Init("", false).ok());
+
+  Index index;
+  index.CreateIndex(setup.symbols()->binary()->GetLLVMObjectFile());
+
+  std::stringstream cache;
+  index.WriteCache(cache);
+
+  // The loaded index should be indistinguishable from the original.
+  Index loaded;
+  ASSERT_TRUE(loaded.ReadCache(cache));
+  EXPECT_EQ(index.root().AsString(), loaded.root().AsString());
+  EXPECT_EQ(index.main_functions().size(), loaded.main_functions().size());
+  EXPECT_EQ(index.files_indexed(), loaded.files_indexed());
+  EXPECT_EQ(index.FindFileMatches("zxdb_symbol_test.cc"),
+            loaded.FindFileMatches("zxdb_symbol_test.cc"));
+
+  // A truncated cache is rejected and leaves the index empty.
+  std::string truncated = cache.str();
+  truncated.resize(truncated.size() / 2);
+  std::istringstream truncated_stream(truncated);
+  EXPECT_FALSE(loaded.ReadCache(truncated_stream));
+  EXPECT_EQ(0u, loaded.CountSymbolsIndexed());
+  EXPECT_EQ(0u, loaded.files_indexed());
+
+  // So is data that isn't a cache at all.
+  std::istringstream garbage("not an index");
+  EXPECT_FALSE(loaded.ReadCache(garbage));
+}
+
 TEST(Index, FindFilePrefixes) {
   TestSymbolModule setup(TestSymbolModule::kCheckedIn);
   ASSERT_TRUE(setup.Init("", false).ok());
@@ -7,7 +7,9 @@
 #include <stdio.h>
 
 #include <algorithm>
+#include <fstream>
 #include <memory>
+#include <system_error>
 
 #include "llvm/DebugInfo/DIContext.h"
 #include "llvm/DebugInfo/DWARF/DWARFContext.h"
@@ -146,7 +148,8 @@ bool HasOnlySupportedSpecialIdentifierTypes(const Identifier& ident) {
 }  // namespace
 
 ModuleSymbolsImpl::ModuleSymbolsImpl(std::unique_ptr<DwarfBinaryImpl> binary,
-                                     const std::string& build_dir, bool create_index)
+                                     const std::string& build_dir, bool create_index,
+                                     const std::filesystem::path& index_cache_file)
     : binary_(std::move(binary)), build_dir_(build_dir), weak_factory_(this) {
   symbol_factory_ = fxl::MakeRefCounted<DwarfSymbolFactory>(GetWeakPtr());
   FillElfSymbols();
@@ -159,11 +162,11 @@ ModuleSymbolsImpl::ModuleSymbolsImpl(std::unique_ptr<DwarfBinaryImpl> binary,
     // Although it will be slightly slower to create, the memory savings may make such a change
     // worth it for large programs.
     if (llvm::object::ObjectFile* object_file = binary_->GetLLVMObjectFile())
-      index_.CreateIndex(object_file);
+      LoadOrCreateIndex(object_file, index_cache_file);
   }
 }
 
-ModuleSymbolsImpl::~ModuleSymbolsImpl() = default;
+ModuleSymbolsImpl::~ModuleSymbolsImpl() { symbol_factory_->ClearCache(); }
 
 fxl::WeakPtr<ModuleSymbolsImpl> ModuleSymbolsImpl::GetWeakPtr() {
   return weak_factory_.GetWeakPtr();
@@ -727,6 +730,41 @@ Location ModuleSymbolsImpl::MakeElfSymbolLocation(const SymbolContext& symbol_co
       fxl::MakeRefCounted<ElfSymbol>(const_cast<ModuleSymbolsImpl*>(this)->GetWeakPtr(), record));
 }
 
+void ModuleSymbolsImpl::LoadOrCreateIndex(llvm::object::ObjectFile* object_file,
+                                          const std::filesystem::path& index_cache_file) {
+  if (!index_cache_file.empty()) {
+    if (std::ifstream in(index_cache_file, std::ios::binary); in && index_.ReadCache(in))
+      return;
+  }
+
+  index_.CreateIndex(object_file);
+
+  if (index_cache_file.empty())
+    return;
+
+  // Write to a temporary file and rename it into place so a concurrent or interrupted session never
+  // sees a partial cache.
+  std::error_code ec;
+  std::filesystem::create_directories(index_cache_file.parent_path(), ec);
+  std::filesystem::path temp_file = index_cache_file;
+  temp_file += ".tmp";
+  {
+    std::ofstream out(temp_file, std::ios::binary | std::ios::trunc);
+    index_.WriteCache(out);
+    out.close();
+    if (!out) {
+      LOGS(Warn) << "Could not write symbol index cache " << temp_file;
+      std::filesystem::remove(temp_file, ec);
+      return;
+    }
+  }
+  std::filesystem::rename(temp_file, index_cache_file, ec);
+  if (ec) {
+    LOGS(Warn) << "Could not write symbol index cache " << index_cache_file << ": " << ec.message();
+    std::filesystem::remove(temp_file, ec);
+  }
+}
+
 void ModuleSymbolsImpl::FillElfSymbols() {
   FX_DCHECK(mangled_elf_symbols_.empty());
   FX_DCHECK(elf_addresses_.empty());
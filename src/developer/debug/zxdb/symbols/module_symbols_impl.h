@@ -5,6 +5,7 @@
 #ifndef SRC_DEVELOPER_DEBUG_ZXDB_SYMBOLS_MODULE_SYMBOLS_IMPL_H_
 #define SRC_DEVELOPER_DEBUG_ZXDB_SYMBOLS_MODULE_SYMBOLS_IMPL_H_
 
+#include <filesystem>
 #include <map>
 
 #include "gtest/gtest_prod.h"
@@ -80,8 +81,13 @@ class ModuleSymbolsImpl final : public ModuleSymbols {
   // If create_index is true, an index will be created for fast symbol lookup.
   // Normal callers will always want to create the index, unless you don't need to query a symbol
   // from its name, e.g., in some test scenarios or in symbolizer.
+  //
+  // If index_cache_file is not empty, the index is loaded from that file when it holds a valid
+  // cache, and otherwise is created and then written there. The file must be specific to this
+  // binary, normally by being named after its build ID.
   explicit ModuleSymbolsImpl(std::unique_ptr<DwarfBinaryImpl> binary, const std::string& build_dir,
-                             bool create_index = true);
+                             bool create_index = true,
+                             const std::filesystem::path& index_cache_file = {});
   ~ModuleSymbolsImpl() override;
 
   // Helpers for ResolveInputLocation() for the different types of inputs.
@@ -151,6 +157,11 @@ class ModuleSymbolsImpl final : public ModuleSymbols {
   // Fills the forward and backward indices for ELF symbols.
   void FillElfSymbols();
 
+  // Fills in index_ from the given cache file if possible. Otherwise creates it from the object
+  // file and saves it to the cache file. An empty path disables the cache.
+  void LoadOrCreateIndex(llvm::object::ObjectFile* object_file,
+                         const std::filesystem::path& index_cache_file);
+
   std::unique_ptr<DwarfBinaryImpl> binary_;  // Guaranteed non-null.
 
   std::string build_dir_;
@@ -4,6 +4,7 @@
 
 #include "src/developer/debug/zxdb/symbols/system_symbols.h"
 
+#include <filesystem>
 #include <memory>
 
 #include "src/developer/debug/zxdb/common/file_util.h"
@@ -90,8 +91,13 @@ Err SystemSymbols::GetModule(const std::string& name, const std::string& build_i
   if (Err err = binary->Load(); err.has_error())
     return err;  // Symbols corrupt.
 
-  *module =
-      fxl::MakeRefCounted<ModuleSymbolsImpl>(std::move(binary), entry.build_dir, create_index_);
+  std::filesystem::path index_cache_file;
+  if (create_index_)
+    index_cache_file = build_id_index_.GetIndexCachePath(build_id);
+  *module = fxl::MakeRefCounted<ModuleSymbolsImpl>(std::move(binary), entry.build_dir,
+                                                   create_index_, index_cache_file);
+  if (!index_cache_file.empty())
+    build_id_index_.NotifyCacheFileAccess(index_cache_file);
 
   SaveModule(build_id, module->get());  // Save in cache for future use.
   return Err();
@@ -7,6 +7,7 @@
 #include <lib/fpromise/promise.h>
 #include <lib/syslog/cpp/macros.h>
 
+#include <memory>
 #include <utility>
 
 #include "src/developer/forensics/feedback/attachments/static_attachments.h"
@@ -47,13 +48,36 @@ AttachmentManager::AttachmentManager(const std::set<std::string>& allowlist,
   }
 }
 
-::fpromise::promise<Attachments> AttachmentManager::GetAttachments(const zx::duration timeout) {
+::fpromise::promise<Attachments> AttachmentManager::GetAttachments(
+    const zx::duration timeout,
+    fit::function<void(const AttachmentKey&, const AttachmentValue&)> on_collected) {
+  // Shared so that every provider's result can be reported as soon as it arrives.
+  auto on_collected_ptr =
+      std::make_shared<fit::function<void(const AttachmentKey&, const AttachmentValue&)>>(
+          std::move(on_collected));
+  if (*on_collected_ptr) {
+    for (const auto& [k, v] : static_attachments_) {
+      (*on_collected_ptr)(k, v);
+    }
+  }
+
   std::vector<std::string> keys;
   std::vector<::fpromise::promise<AttachmentValue>> promises;
 
   for (auto& [k, p] : providers_) {
     keys.push_back(k);
-    promises.push_back(p->Get(timeout));
+    promises.push_back(p->Get(timeout).and_then(
+        [k = k, on_collected_ptr](AttachmentValue& attachment) mutable {
+          // Consider any attachments without content as missing attachments.
+          if (attachment.HasValue() && attachment.Value().empty()) {
+            attachment = attachment.HasError() ? attachment.Error() : Error::kMissingValue;
+          }
+
+          if (*on_collected_ptr) {
+            (*on_collected_ptr)(k, attachment);
+          }
+          return ::fpromise::ok(std::move(attachment));
+        }));
   }
 
   auto join = ::fpromise::join_promise_vector(std::move(promises));
@@ -63,12 +87,6 @@ AttachmentManager::AttachmentManager(const std::set<std::string>& allowlist,
   return join.and_then([keys, attachments = static_attachments_](result_t& results) mutable {
     for (size_t i = 0; i < results.size(); ++i) {
       attachments.insert({keys[i], results[i].take_value()});
-
-      // Consider any attachments without content as missing attachments.
-      if (auto& attachment = attachments.at(keys[i]);
-          attachment.HasValue() && attachment.Value().empty()) {
-        attachment = attachment.HasError() ? attachment.Error() : Error::kMissingValue;
-      }
     }
 
     return ::fpromise::ok(std::move(attachments));
@@ -6,6 +6,7 @@
 #define SRC_DEVELOPER_FORENSICS_FEEDBACK_ATTACHMENTS_ATTACHMENT_MANAGER_H_
 
 #include <lib/async/dispatcher.h>
+#include <lib/fit/function.h>
 #include <lib/fpromise/promise.h>
 #include <lib/sys/cpp/service_directory.h>
 #include <lib/zx/time.h>
@@ -27,7 +28,14 @@ class AttachmentManager {
                              Attachments static_attachments = {},
                              std::map<std::string, AttachmentProvider*> providers = {});
 
-  ::fpromise::promise<Attachments> GetAttachments(zx::duration timeout);
+  // Collects all attachments concurrently, each within |timeout|.
+  //
+  // If set, |on_collected| is called with each attachment as soon as it has been collected so it
+  // can be processed while the others are still being collected. Static attachments are passed to
+  // it before this returns.
+  ::fpromise::promise<Attachments> GetAttachments(
+      zx::duration timeout,
+      fit::function<void(const AttachmentKey&, const AttachmentValue&)> on_collected = nullptr);
 
   void DropStaticAttachment(const AttachmentKey& key, Error error);
 
@@ -136,6 +136,50 @@ TEST_F(AttachmentManagerTest, Dynamic) {
                            }));
 }
 
+TEST_F(AttachmentManagerTest, ReportsEachAttachmentWhenCollected) {
+  async::Executor executor(dispatcher());
+
+  SimpleAttachmentProvider provider1(dispatcher(), zx::sec(1), AttachmentValue("value1"));
+  SimpleAttachmentProvider provider2(dispatcher(), zx::sec(3), AttachmentValue(""));
+
+  AttachmentManager manager({"static", "dynamic1", "dynamic2"},
+                            {{"static", AttachmentValue("value")}},
+                            {
+                                {"dynamic1", &provider1},
+                                {"dynamic2", &provider2},
+                            });
+
+  Attachments collected;
+  Attachments attachments;
+  executor.schedule_task(
+      manager
+          .GetAttachments(zx::duration::infinite(),
+                          [&collected](const AttachmentKey& key, const AttachmentValue& value) {
+                            collected.insert({key, value});
+                          })
+          .and_then([&attachments](Attachments& result) { attachments = std::move(result); })
+          .or_else([] { FX_LOGS(FATAL) << "Unreachable branch"; }));
+
+  // Static attachments are reported immediately.
+  EXPECT_THAT(collected, ElementsAreArray({Pair("static", AttachmentValue("value"))}));
+
+  RunLoopFor(zx::sec(1));
+  EXPECT_THAT(collected, ElementsAreArray({
+                             Pair("dynamic1", AttachmentValue("value1")),
+                             Pair("static", AttachmentValue("value")),
+                         }));
+  EXPECT_THAT(attachments, IsEmpty());
+
+  // Empty attachments are reported as missing.
+  RunLoopFor(zx::sec(2));
+  EXPECT_THAT(collected, ElementsAreArray({
+                             Pair("dynamic1", AttachmentValue("value1")),
+                             Pair("dynamic2", AttachmentValue(Error::kMissingValue)),
+                             Pair("static", AttachmentValue("value")),
+                         }));
+  EXPECT_EQ(attachments, collected);
+}
+
 TEST_F(AttachmentManagerTest, NoProvider) {
   ASSERT_DEATH({ AttachmentManager manager({"unknown.attachment"}); },
                HasSubstr("Attachment \"unknown.attachment\" collected by 0 providers"));
@@ -82,9 +82,11 @@ DataProvider::DataProvider(async_dispatcher_t* dispatcher,
 }
 
 ::fpromise::promise<feedback::Attachments> DataProvider::GetAttachments(
-    const zx::duration timeout) {
-  return attachment_manager_->GetAttachments(timeout).and_then(
-      [this](feedback::Attachments& attachments) {
+    const zx::duration timeout,
+    fit::function<void(const feedback::AttachmentKey&, const feedback::AttachmentValue&)>
+        on_collected) {
+  return attachment_manager_->GetAttachments(timeout, std::move(on_collected))
+      .and_then([this](feedback::Attachments& attachments) {
         attachment_metrics_.LogMetrics(attachments);
         return ::fpromise::ok(std::move(attachments));
       });
@@ -149,48 +151,47 @@ void DataProvider::GetSnapshotInternal(
     zx::duration timeout, fit::callback<void(feedback::Annotations, fsl::SizedVmo)> callback) {
   const uint64_t timer_id = cobalt_->StartTimer();
 
-  auto join = ::fpromise::join_promises(GetAnnotations(timeout), GetAttachments(timeout));
-  using result_t = decltype(join)::value_type;
-
-  auto promise =
-      join.and_then([this, timer_id, callback = std::move(callback)](result_t& results) mutable {
-        FX_CHECK(std::get<0>(results).is_ok()) << "Impossible annotation collection failure";
-        FX_CHECK(std::get<1>(results).is_ok()) << "Impossible attachment collection failure";
-
-        const auto& annotations = std::get<0>(results).value();
-        const auto& attachments = std::get<1>(results).value();
-        std::map<std::string, std::string> snapshot_files;
-
-        // Add the annotations to |snapshot_files|
-        auto file = feedback::Encode<std::string>(annotations);
-        snapshot_files[kAttachmentAnnotations] = std::move(file);
-
-        // Add the attachments to |snapshot_files|
-        for (const auto& [key, value] : attachments) {
-          if (value.HasValue()) {
-            snapshot_files[key] = value.Value();
-          }
+  // Annotations and attachments are collected concurrently and each attachment is compressed into
+  // the archive as soon as it's collected, while the others are still being collected.
+  auto archive_writer = std::make_shared<ArchiveWriter>();
+  auto join = ::fpromise::join_promises(
+      GetAnnotations(timeout),
+      GetAttachments(timeout, [archive_writer](const feedback::AttachmentKey& key,
+                                               const feedback::AttachmentValue& value) {
+        if (value.HasValue()) {
+          archive_writer->Add(key, value.Value());
         }
+      }));
+  using result_t = decltype(join)::value_type;
 
-        snapshot_files[kAttachmentMetadata] =
-            metadata_.MakeMetadata(annotations, attachments, uuid::Generate(),
-                                   annotation_manager_->IsMissingNonPlatformAnnotations());
-
-        fsl::SizedVmo archive;
-
-        // We bundle the attachments into a single archive.
-        if (std::map<std::string, ArchiveFileStats> file_size_stats;
-            Archive(snapshot_files, &archive, &file_size_stats)) {
-          inspect_data_budget_->UpdateBudget(file_size_stats);
-          cobalt_->LogCount(SnapshotVersion::kCobalt, archive.size());
-          cobalt_->LogElapsedTime(cobalt::SnapshotGenerationFlow::kSuccess, timer_id);
-        } else {
-          cobalt_->LogElapsedTime(cobalt::SnapshotGenerationFlow::kFailure, timer_id);
-          archive.vmo().reset();
-        }
-        callback(annotations, std::move(archive));
-        return ::fpromise::ok();
-      });
+  auto promise = join.and_then([this, timer_id, archive_writer,
+                                callback = std::move(callback)](result_t& results) mutable {
+    FX_CHECK(std::get<0>(results).is_ok()) << "Impossible annotation collection failure";
+    FX_CHECK(std::get<1>(results).is_ok()) << "Impossible attachment collection failure";
+
+    const auto& annotations = std::get<0>(results).value();
+    const auto& attachments = std::get<1>(results).value();
+
+    // Add the annotations and the metadata to the archive, which already contains the attachments.
+    archive_writer->Add(kAttachmentAnnotations, feedback::Encode<std::string>(annotations));
+    archive_writer->Add(
+        kAttachmentMetadata,
+        metadata_.MakeMetadata(annotations, attachments, uuid::Generate(),
+                               annotation_manager_->IsMissingNonPlatformAnnotations()));
+
+    fsl::SizedVmo archive;
+    if (std::map<std::string, ArchiveFileStats> file_size_stats;
+        archive_writer->Finish(&archive, &file_size_stats)) {
+      inspect_data_budget_->UpdateBudget(file_size_stats);
+      cobalt_->LogCount(SnapshotVersion::kCobalt, archive.size());
+      cobalt_->LogElapsedTime(cobalt::SnapshotGenerationFlow::kSuccess, timer_id);
+    } else {
+      cobalt_->LogElapsedTime(cobalt::SnapshotGenerationFlow::kFailure, timer_id);
+      archive.vmo().reset();
+    }
+    callback(annotations, std::move(archive));
+    return ::fpromise::ok();
+  });
 
   executor_.schedule_task(std::move(promise));
 }
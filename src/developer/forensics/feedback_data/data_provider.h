@@ -8,6 +8,7 @@
 #include <fuchsia/feedback/cpp/fidl.h>
 #include <lib/async/cpp/executor.h>
 #include <lib/async/dispatcher.h>
+#include <lib/fit/function.h>
 #include <lib/sys/cpp/service_directory.h>
 #include <lib/vfs/cpp/vmo_file.h>
 
@@ -78,7 +79,10 @@ class DataProvider : public fuchsia::feedback::DataProvider, public DataProvider
 
  private:
   ::fpromise::promise<feedback::Annotations> GetAnnotations(const zx::duration timeout);
-  ::fpromise::promise<feedback::Attachments> GetAttachments(const zx::duration timeout);
+  ::fpromise::promise<feedback::Attachments> GetAttachments(
+      const zx::duration timeout,
+      fit::function<void(const feedback::AttachmentKey&, const feedback::AttachmentValue&)>
+          on_collected = nullptr);
   void GetSnapshotInternal(zx::duration timeout,
                            fit::callback<void(feedback::Annotations, fsl::SizedVmo)> callback);
 
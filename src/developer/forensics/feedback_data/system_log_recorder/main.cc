@@ -24,6 +24,9 @@ namespace feedback_data {
 namespace system_log_recorder {
 
 constexpr zx::duration kWritePeriod = zx::sec(1);
+// Logs are written to flash in whole pages, holding back what doesn't fill one for up to 4s.
+constexpr StorageSize kWritePageSize = StorageSize::Kilobytes(4);
+constexpr size_t kMaxDeferredWrites = 4;
 
 int main() {
   syslog::SetTags({"forensics", "feedback"});
@@ -62,6 +65,8 @@ int main() {
                                  .logs_dir = kCurrentLogsDir,
                                  .max_num_files = kMaxNumLogFiles,
                                  .total_log_size = kPersistentLogsMaxSize,
+                                 .write_page_size = kWritePageSize,
+                                 .max_deferred_writes = kMaxDeferredWrites,
                              },
                              // Don't set up Inspect because all messages in the previous boot log
                              // are in the current boot log and counted in Inspect.
@@ -30,7 +30,8 @@ SystemLogRecorder::SystemLogRecorder(async_dispatcher_t* archive_dispatcher,
       store_(write_parameters.total_log_size / write_parameters.max_num_files,
              write_parameters.max_write_size, std::move(redactor), std::move(encoder)),
       log_source_(archive_dispatcher, services, &store_),
-      writer_(logs_dir_, write_parameters.max_num_files, &store_) {}
+      writer_(logs_dir_, write_parameters.max_num_files, &store_, write_parameters.write_page_size,
+              write_parameters.max_deferred_writes) {}
 
 void SystemLogRecorder::Start() {
   log_source_.Start();
@@ -28,6 +28,10 @@ class SystemLogRecorder {
     std::string logs_dir;
     size_t max_num_files;
     StorageSize total_log_size;
+    // Writes are batched into whole pages of this size, if it isn't zero, for at most
+    // |max_deferred_writes| periods.
+    StorageSize write_page_size = StorageSize::Bytes(0);
+    size_t max_deferred_writes = 0;
   };
 
   SystemLogRecorder(async_dispatcher_t* archive_dispatcher, async_dispatcher_t* write_dispatcher,
@@ -223,6 +223,54 @@ TEST(WriterTest, WritesMessages) {
 )");
 }
 
+TEST(WriterTest, BatchesWritesIntoPages) {
+  testing::ScopedMemFsManager memfs_manager;
+  memfs_manager.Create(kRootDirectory);
+
+  // Set up the writer such that a page fits 2 log messages and a block fits many pages.
+  const StorageSize kPageSize = kMaxLogLineSize * 2;
+  LogMessageStore store(kMaxLogLineSize * 16, kMaxLogLineSize * 16, MakeIdentityRedactor(),
+                        MakeIdentityEncoder());
+  store.TurnOnRateLimiting();
+  SystemLogWriter writer(kWriteDirectory, 2u, &store, kPageSize, /*max_deferred_writes=*/2u);
+
+  std::string contents;
+
+  // Less than a page is held back.
+  EXPECT_TRUE(store.Add(BuildLogMessage(syslog::LOG_INFO, "line 0")));
+  writer.Write();
+  ASSERT_TRUE(files::ReadFileToString(MakeLogFilePath(0u), &contents));
+  EXPECT_EQ(contents, "");
+
+  // A whole page is written.
+  EXPECT_TRUE(store.Add(BuildLogMessage(syslog::LOG_INFO, "line 1")));
+  EXPECT_TRUE(store.Add(BuildLogMessage(syslog::LOG_INFO, "line 2")));
+  writer.Write();
+  ASSERT_TRUE(files::ReadFileToString(MakeLogFilePath(0u), &contents));
+  EXPECT_EQ(contents, R"([15604.000][07559][07687][] INFO: line 0
+[15604.000][07559][07687][] INFO: line 1
+)");
+
+  // What is held back is written once |max_deferred_writes| writes have been deferred.
+  writer.Write();
+  ASSERT_TRUE(files::ReadFileToString(MakeLogFilePath(0u), &contents));
+  EXPECT_EQ(contents, R"([15604.000][07559][07687][] INFO: line 0
+[15604.000][07559][07687][] INFO: line 1
+[15604.000][07559][07687][] INFO: line 2
+)");
+
+  // Fsync() writes everything held back.
+  EXPECT_TRUE(store.Add(BuildLogMessage(syslog::LOG_INFO, "line 3")));
+  writer.Write();
+  writer.Fsync();
+  ASSERT_TRUE(files::ReadFileToString(MakeLogFilePath(0u), &contents));
+  EXPECT_EQ(contents, R"([15604.000][07559][07687][] INFO: line 0
+[15604.000][07559][07687][] INFO: line 1
+[15604.000][07559][07687][] INFO: line 2
+[15604.000][07559][07687][] INFO: line 3
+)");
+}
+
 TEST(WriterTest, VerifyCompressionRatio) {
   // Generate 2x data when decoding. The decoder data output is not useful, just its size.
   testing::ScopedMemFsManager memfs_manager;
@@ -21,8 +21,14 @@ namespace feedback_data {
 namespace system_log_recorder {
 
 SystemLogWriter::SystemLogWriter(const std::string& logs_dir, size_t max_num_files,
-                                 LogMessageStore* store)
-    : logs_dir_(logs_dir), max_num_files_(max_num_files), file_queue_(), store_(store) {
+                                 LogMessageStore* store, const StorageSize page_size,
+                                 const size_t max_deferred_writes)
+    : logs_dir_(logs_dir),
+      max_num_files_(max_num_files),
+      file_queue_(),
+      store_(store),
+      page_size_(page_size.Get()),
+      max_deferred_writes_(max_deferred_writes) {
   FX_CHECK(max_num_files_ > 0);
   if (!files::CreateDirectory(logs_dir)) {
     FX_LOGS(WARNING) << "Failed to create logs directory, will re-try on the next block, no logs "
@@ -78,21 +84,35 @@ void SystemLogWriter::StartNewFile() {
 void SystemLogWriter::Write() {
   TRACE_DURATION("feedback:io", "SystemLogWriter::Write");
   bool end_of_block;
-  const std::string str = store_->Consume(&end_of_block);
+  pending_ += store_->Consume(&end_of_block);
 
-  // The file descriptor could be negative if the file failed to open.
-  if (current_file_descriptor_.is_valid()) {
+  if (end_of_block) {
     // Overcommit, i.e. write everything we consumed before starting a new file for the next
     // block as we cannot have a block spanning multiple files.
-    write(current_file_descriptor_.get(), str.c_str(), str.size());
-  }
-
-  if (end_of_block) {
+    WritePending(pending_.size());
     StartNewFile();
+  } else if (page_size_ == 0 || num_deferred_writes_ >= max_deferred_writes_) {
+    WritePending(pending_.size());
+  } else {
+    // Only write whole pages and hold the remainder back until the next write fills the page.
+    WritePending(pending_.size() - pending_.size() % page_size_);
   }
+  num_deferred_writes_ = (pending_.empty()) ? 0 : num_deferred_writes_ + 1;
 }
 
-void SystemLogWriter::Fsync() { fsync(current_file_descriptor_.get()); }
+void SystemLogWriter::Fsync() {
+  WritePending(pending_.size());
+  num_deferred_writes_ = 0;
+  fsync(current_file_descriptor_.get());
+}
+
+void SystemLogWriter::WritePending(const size_t size) {
+  // The file descriptor could be negative if the file failed to open.
+  if (size > 0 && current_file_descriptor_.is_valid()) {
+    write(current_file_descriptor_.get(), pending_.data(), size);
+  }
+  pending_.erase(0, size);
+}
 
 std::string SystemLogWriter::Path(const size_t file_num) const {
   return files::JoinPath(logs_dir_, std::to_string(file_num));
@@ -12,19 +12,28 @@
 #include <fbl/unique_fd.h>
 
 #include "src/developer/forensics/feedback_data/system_log_recorder/log_message_store.h"
+#include "src/developer/forensics/utils/storage_size.h"
 
 namespace forensics {
 namespace feedback_data {
 namespace system_log_recorder {
 
 // Consumes the full content of a store on request, writing it to a rotating set of files.
+//
+// If |page_size| isn't zero, writes are batched so that only whole pages are written to the
+// current file, which keeps the flash from rewriting the same page on every write. The remainder is
+// held back for at most |max_deferred_writes| calls to Write(), and is always written at the end of
+// a block and on Fsync().
 class SystemLogWriter {
  public:
-  SystemLogWriter(const std::string& logs_dir, size_t max_num_files, LogMessageStore* store);
+  SystemLogWriter(const std::string& logs_dir, size_t max_num_files, LogMessageStore* store,
+                  StorageSize page_size = StorageSize::Bytes(0), size_t max_deferred_writes = 0);
 
   void Write();
 
   // Instructs the class to call `fsync` on the currently open file to ensure data makes it disk.
+  //
+  // Data held back to fill a page is written first.
   void Fsync();
 
  private:
@@ -34,12 +43,20 @@ class SystemLogWriter {
   // Returns the path the |file_num|'th file created.
   std::string Path(size_t file_num) const;
 
+  // Writes the first |size| bytes of |pending_| to the current file.
+  void WritePending(size_t size);
+
   const std::string logs_dir_;
   const size_t max_num_files_;
   std::deque<size_t> file_queue_;
 
   fbl::unique_fd current_file_descriptor_;
   LogMessageStore* store_;
+
+  const uint64_t page_size_;
+  const size_t max_deferred_writes_;
+  std::string pending_;
+  size_t num_deferred_writes_ = 0;
 };
 
 }  // namespace system_log_recorder
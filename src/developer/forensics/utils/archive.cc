@@ -20,80 +20,101 @@ namespace {
 
 using fuchsia::mem::Buffer;
 
-bool Archive(const std::map<std::string, std::string>& files, const std::string& archive_filename,
-             zipFile* zf, std::map<std::string, ArchiveFileStats>* file_to_size_stats) {
-  uint64_t old_zip_size = 0;
-  uint64_t new_zip_size = 0;
-
-  for (const auto& [filename, content] : files) {
-    zip_fileinfo zf_info = {};
-    if (const int status =
-            zipOpenNewFileInZip64(*zf, filename.c_str(), &zf_info, nullptr, 0, nullptr, 0, nullptr,
-                                  Z_DEFLATED, Z_DEFAULT_COMPRESSION, /*zip64=*/1);
-        status != ZIP_OK) {
-      FX_LOGS(ERROR) << fxl::Substitute("cannot create $0 in output zip archive: ", filename)
-                     << status;
-      return false;
-    }
-
-    if (const int status = zipWriteInFileInZip(*zf, content.data(), (uint32_t)content.size());
-        status != ZIP_OK) {
-      FX_LOGS(ERROR) << fxl::Substitute("cannot write $0 in output zip archive: ", filename)
-                     << status;
-      return false;
-    }
-
-    if (const int status = zipCloseFileInZip(*zf); status != ZIP_OK) {
-      FX_LOGS(WARNING) << fxl::Substitute("cannot close $0 in output zip archive: ", filename)
-                       << status;
-    }
+}  // namespace
 
-    if (file_to_size_stats != nullptr) {
-      files::GetFileSize(archive_filename.c_str(), &new_zip_size);
-      (*file_to_size_stats)[filename] = {.raw_bytes = content.size(),
-                                         .compressed_bytes = new_zip_size - old_zip_size};
-    }
+ArchiveWriter::ArchiveWriter() {
+  // We write the archive to a temporary file because in-memory archiving in minizip is complicated.
+  tmp_dir_.NewTempFile(&archive_filename_);
 
-    old_zip_size = new_zip_size;
+  zf_ = zipOpen64(archive_filename_.c_str(), APPEND_STATUS_CREATE);
+  if (zf_ == nullptr) {
+    FX_LOGS(ERROR) << "cannot create output zip archive";
   }
-
-  return true;
 }
 
-}  // namespace
+ArchiveWriter::~ArchiveWriter() { Close(); }
 
-bool Archive(const std::map<std::string, std::string>& files, fsl::SizedVmo* archive,
-             std::map<std::string, ArchiveFileStats>* file_to_size_stats) {
-  // We write the archive to a temporary file because in-memory archiving in minizip is complicated.
-  files::ScopedTempDir tmp_dir;
-  std::string archive_filename;
-  tmp_dir.NewTempFile(&archive_filename);
+bool ArchiveWriter::Add(const std::string& filename, const std::string& content) {
+  if (zf_ == nullptr) {
+    return false;
+  }
 
-  zipFile zf = zipOpen64(archive_filename.c_str(), APPEND_STATUS_CREATE);
-  if (zf == nullptr) {
-    FX_LOGS(ERROR) << "cannot create output zip archive";
+  zip_fileinfo zf_info = {};
+  if (const int status =
+          zipOpenNewFileInZip64(zf_, filename.c_str(), &zf_info, nullptr, 0, nullptr, 0, nullptr,
+                                Z_DEFLATED, Z_DEFAULT_COMPRESSION, /*zip64=*/1);
+      status != ZIP_OK) {
+    FX_LOGS(ERROR) << fxl::Substitute("cannot create $0 in output zip archive: ", filename)
+                   << status;
+    Close();
     return false;
   }
 
-  const bool success = Archive(files, archive_filename, &zf, file_to_size_stats);
+  if (const int status = zipWriteInFileInZip(zf_, content.data(), (uint32_t)content.size());
+      status != ZIP_OK) {
+    FX_LOGS(ERROR) << fxl::Substitute("cannot write $0 in output zip archive: ", filename)
+                   << status;
+    Close();
+    return false;
+  }
 
-  // We always close the archive regardless of the success status.
-  if (const int status = zipClose(zf, nullptr); status != ZIP_OK) {
-    FX_LOGS(WARNING) << "cannot close output zip archive: " << status;
+  if (const int status = zipCloseFileInZip(zf_); status != ZIP_OK) {
+    FX_LOGS(WARNING) << fxl::Substitute("cannot close $0 in output zip archive: ", filename)
+                     << status;
   }
 
-  if (!success) {
+  uint64_t new_zip_size = 0;
+  files::GetFileSize(archive_filename_.c_str(), &new_zip_size);
+  file_to_size_stats_[filename] = {.raw_bytes = content.size(),
+                                   .compressed_bytes = new_zip_size - zip_size_};
+  zip_size_ = new_zip_size;
+
+  return true;
+}
+
+bool ArchiveWriter::Finish(fsl::SizedVmo* archive,
+                           std::map<std::string, ArchiveFileStats>* file_to_size_stats) {
+  if (!Close()) {
     return false;
   }
 
-  if (!fsl::VmoFromFilename(archive_filename, archive)) {
+  if (!fsl::VmoFromFilename(archive_filename_, archive)) {
     FX_LOGS(ERROR) << "error loading output zip archive into VMO";
     return false;
   }
 
+  if (file_to_size_stats != nullptr) {
+    *file_to_size_stats = std::move(file_to_size_stats_);
+  }
+
   return true;
 }
 
+bool ArchiveWriter::Close() {
+  if (zf_ == nullptr) {
+    return false;
+  }
+
+  // A failure to close is only worth a warning, the content has been written already.
+  if (const int status = zipClose(zf_, nullptr); status != ZIP_OK) {
+    FX_LOGS(WARNING) << "cannot close output zip archive: " << status;
+  }
+  zf_ = nullptr;
+  return true;
+}
+
+bool Archive(const std::map<std::string, std::string>& files, fsl::SizedVmo* archive,
+             std::map<std::string, ArchiveFileStats>* file_to_size_stats) {
+  ArchiveWriter writer;
+  for (const auto& [filename, content] : files) {
+    if (!writer.Add(filename, content)) {
+      return false;
+    }
+  }
+
+  return writer.Finish(archive, file_to_size_stats);
+}
+
 namespace {
 
 bool Unpack(unzFile* uf, std::map<std::string, std::string>* files) {
@@ -10,7 +10,9 @@
 #include <map>
 #include <string>
 
+#include "src/lib/files/scoped_temp_dir.h"
 #include "src/lib/fsl/vmo/sized_vmo.h"
+#include "third_party/zlib/contrib/minizip/zip.h"
 
 namespace forensics {
 
@@ -24,6 +26,36 @@ struct ArchiveFileStats {
 bool Archive(const std::map<std::string, std::string>& files, fsl::SizedVmo* archive,
              std::map<std::string, ArchiveFileStats>* file_to_size_stats = nullptr);
 
+// Incrementally bundles files into a single ZIP archive with DEFLATE compression, so files can be
+// compressed as soon as their content is available rather than all at once.
+class ArchiveWriter {
+ public:
+  ArchiveWriter();
+  ~ArchiveWriter();
+
+  ArchiveWriter(const ArchiveWriter&) = delete;
+  ArchiveWriter& operator=(const ArchiveWriter&) = delete;
+
+  // Adds |filename| with |content| to the archive. Once this fails, nothing else can be added and
+  // the archive can't be finished.
+  bool Add(const std::string& filename, const std::string& content);
+
+  // Closes the archive and loads it into |archive|. Also returns a map of the added filenames to
+  // size stats. Nothing can be added afterwards.
+  bool Finish(fsl::SizedVmo* archive,
+              std::map<std::string, ArchiveFileStats>* file_to_size_stats = nullptr);
+
+ private:
+  // Closes the archive file, if it's open, and returns whether that succeeded.
+  bool Close();
+
+  files::ScopedTempDir tmp_dir_;
+  std::string archive_filename_;
+  zipFile zf_ = nullptr;
+  uint64_t zip_size_ = 0;
+  std::map<std::string, ArchiveFileStats> file_to_size_stats_;
+};
+
 // Unpack a ZIP archive into a map of filenames to string content.
 bool Unpack(const fuchsia::mem::Buffer& archive, std::map<std::string, std::string>* files);
 
@@ -8,6 +8,7 @@
 #include <fuchsia/mem/cpp/fidl.h>
 #include <lib/syslog/cpp/macros.h>
 
+#include <cstring>
 #include <map>
 #include <string>
 #include <vector>
@@ -82,5 +83,25 @@ TEST(ArchiveTest, UnpackArchive) {
   EXPECT_EQ(unpacked_attachments, kAttachments);
 }
 
+TEST(ArchiveTest, ArchiveWriter) {
+  ArchiveWriter writer;
+  for (const auto& [filename, content] : kAttachments) {
+    ASSERT_TRUE(writer.Add(filename, content));
+  }
+
+  fsl::SizedVmo archive;
+  std::map<std::string, ArchiveFileStats> file_size_stats;
+  ASSERT_TRUE(writer.Finish(&archive, &file_size_stats));
+  EXPECT_EQ(file_size_stats.size(), kAttachments.size());
+  EXPECT_EQ(file_size_stats[kPlainTextFilename].raw_bytes, strlen(kPlainTextFileContent));
+
+  // Nothing can be added once the archive is finished.
+  EXPECT_FALSE(writer.Add(kPlainTextFilename, kPlainTextFileContent));
+
+  std::map<std::string, std::string> unpacked_attachments;
+  ASSERT_TRUE(Unpack(std::move(archive).ToTransport(), &unpacked_attachments));
+  EXPECT_EQ(unpacked_attachments, kAttachments);
+}
+
 }  // namespace
 }  // namespace forensics
@@ -7,10 +7,12 @@
 #include <lib/syslog/cpp/macros.h>
 #include <lib/trace/event.h>
 
+#include <algorithm>
 #include <filesystem>
 #include <optional>
 
 #include <re2/re2.h>
+#include <re2/set.h>
 
 #include "third_party/rapidjson/include/rapidjson/document.h"
 #include "third_party/rapidjson/include/rapidjson/ostreamwrapper.h"
@@ -54,6 +56,20 @@ bool BucketMatch::VmoMatch(const std::string& vmo) {
   return match;
 }
 
+std::optional<std::string> BucketMatch::process_pattern() const {
+  if (match_all_processes_) {
+    return std::nullopt;
+  }
+  return process_->pattern();
+}
+
+std::optional<std::string> BucketMatch::vmo_pattern() const {
+  if (match_all_vmos_) {
+    return std::nullopt;
+  }
+  return vmo_->pattern();
+}
+
 std::optional<std::vector<BucketMatch>> BucketMatch::ReadBucketMatchesFromConfig(
     const std::string& config_string) {
   std::vector<BucketMatch> result;
@@ -84,4 +100,45 @@ std::optional<std::vector<BucketMatch>> BucketMatch::ReadBucketMatchesFromConfig
   return result;
 }
 
+BucketSetMatch::BucketSetMatch(const std::vector<std::optional<std::string>>& patterns) {
+  auto set = std::make_shared<re2::RE2::Set>(re2::RE2::DefaultOptions, re2::RE2::ANCHOR_BOTH);
+  for (size_t bucket = 0; bucket < patterns.size(); bucket++) {
+    if (!patterns[bucket]) {
+      match_all_.push_back(bucket);
+      continue;
+    }
+    std::string error;
+    // An invalid pattern matches nothing, as with BucketMatch.
+    if (set->Add(*patterns[bucket], &error) < 0) {
+      FX_LOGS(WARNING) << "Invalid pattern \"" << *patterns[bucket] << "\": " << error;
+      continue;
+    }
+    set_buckets_.push_back(bucket);
+  }
+  if (set_buckets_.empty()) {
+    return;
+  }
+  if (!set->Compile()) {
+    FX_LOGS(ERROR) << "Unable to compile bucket patterns";
+    set_buckets_.clear();
+    return;
+  }
+  set_ = std::move(set);
+}
+
+void BucketSetMatch::Match(const std::string& name, std::vector<size_t>* buckets) const {
+  *buckets = match_all_;
+  if (!set_) {
+    return;
+  }
+  std::vector<int> matches;
+  if (!set_->Match(name, &matches)) {
+    return;
+  }
+  for (int match : matches) {
+    buckets->push_back(set_buckets_[match]);
+  }
+  std::sort(buckets->begin(), buckets->end());
+}
+
 }  // namespace memory
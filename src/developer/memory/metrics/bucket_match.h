@@ -8,12 +8,14 @@
 #include <zircon/types.h>
 
 #include <functional>
+#include <memory>
 #include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include <re2/re2.h>
+#include <re2/set.h>
 
 #include "src/developer/memory/metrics/capture.h"
 #include "src/lib/files/file.h"
@@ -35,6 +37,11 @@ class BucketMatch {
   bool ProcessMatch(const Process& process);
   bool VmoMatch(const std::string& vmo);
 
+  // The regexps the process and VMO names are matched against, or std::nullopt if every name
+  // matches.
+  std::optional<std::string> process_pattern() const;
+  std::optional<std::string> vmo_pattern() const;
+
   // Parses a configuration string (e.g. stored in a file) to create bucket matches. The
   // configuration format is described in the README.md file in this directory. Returns true if the
   // parsing succeded, false otherwise.
@@ -55,6 +62,26 @@ class BucketMatch {
   std::unordered_map<std::string, bool> vmo_match_;
 };
 
+// Matches a name against the patterns of many buckets at once. The patterns are compiled into a
+// single automaton, so that a name is scanned once however many buckets there are.
+class BucketSetMatch {
+ public:
+  // |patterns[i]| is the pattern for bucket i, or std::nullopt if every name matches bucket i.
+  // Patterns are matched against whole names, as for BucketMatch.
+  explicit BucketSetMatch(const std::vector<std::optional<std::string>>& patterns);
+
+  // Sets |buckets| to the indices of the buckets whose patterns match |name|, in increasing order.
+  void Match(const std::string& name, std::vector<size_t>* buckets) const;
+
+ private:
+  // The buckets which every name matches, in increasing order.
+  std::vector<size_t> match_all_;
+  // Null if no bucket has a pattern.
+  std::shared_ptr<re2::RE2::Set> set_;  // shared_ptr because RE2::Set is not copyable
+  // The bucket of each pattern in |set_|.
+  std::vector<size_t> set_buckets_;
+};
+
 }  // namespace memory
 
 #endif  // SRC_DEVELOPER_MEMORY_METRICS_BUCKET_MATCH_H_
@@ -15,6 +15,8 @@
 #include <zircon/status.h>
 #include <zircon/types.h>
 
+#include <unordered_set>
+
 #include <task-utils/walker.h>
 
 namespace memory {
@@ -171,8 +173,17 @@ zx_status_t Capture::GetCapture(Capture* capture, const CaptureState& state, Cap
   return GetCapture(capture, state, level, &osImpl, rooted_vmo_names);
 }
 
+// static.
+zx_status_t Capture::GetCapture(Capture* capture, const CaptureState& state, CaptureLevel level,
+                                CaptureCache* cache,
+                                const std::vector<std::string>& rooted_vmo_names) {
+  OSImpl osImpl;
+  return GetCapture(capture, state, level, &osImpl, rooted_vmo_names, cache);
+}
+
 zx_status_t Capture::GetCapture(Capture* capture, const CaptureState& state, CaptureLevel level,
-                                OS* os, const std::vector<std::string>& rooted_vmo_names) {
+                                OS* os, const std::vector<std::string>& rooted_vmo_names,
+                                CaptureCache* cache) {
   TRACE_DURATION("memory_metrics", "Capture::GetCapture");
   capture->time_ = os->GetMonotonic();
 
@@ -194,7 +205,8 @@ zx_status_t Capture::GetCapture(Capture* capture, const CaptureState& state, Cap
   }
 
   err = os->GetProcesses(
-      [&state, capture, &os](int depth, zx_handle_t handle, zx_koid_t koid, zx_koid_t parent_koid) {
+      [&state, capture, &os, cache](int depth, zx_handle_t handle, zx_koid_t koid,
+                                    zx_koid_t parent_koid) {
         if (koid == state.self_koid) {
           return ZX_OK;
         }
@@ -204,53 +216,119 @@ zx_status_t Capture::GetCapture(Capture* capture, const CaptureState& state, Cap
           return s == ZX_ERR_BAD_STATE ? ZX_OK : s;
         }
 
-        TRACE_DURATION_BEGIN("memory_metrics", "Capture::GetProcesses::GetVMOCount");
-        size_t num_vmos;
-        s = os->GetInfo(handle, ZX_INFO_PROCESS_VMOS, nullptr, 0, nullptr, &num_vmos);
+        std::vector<zx_info_vmo_t> buffer;
+        const std::vector<zx_info_vmo_t>* vmos;
+        s = GetProcessVmos(handle, koid, os, cache, &buffer, &vmos);
         if (s != ZX_OK) {
           return s == ZX_ERR_BAD_STATE ? ZX_OK : s;
         }
-        TRACE_DURATION_END("memory_metrics", "Capture::GetProcesses::GetVMOCount");
-
-        TRACE_DURATION_BEGIN("memory_metrics", "Capture::GetProcesses::GetVMOs");
-        auto vmos = std::make_unique<zx_info_vmo_t[]>(num_vmos);
-        s = os->GetInfo(handle, ZX_INFO_PROCESS_VMOS, vmos.get(), num_vmos * sizeof(zx_info_vmo_t),
-                        &num_vmos, nullptr);
-        if (s != ZX_OK) {
-          return s == ZX_ERR_BAD_STATE ? ZX_OK : s;
-        }
-        TRACE_DURATION_END("memory_metrics", "Capture::GetProcesses::GetVMOs");
-
-        TRACE_DURATION_BEGIN("memory_metrics", "Capture::GetProcesses::UniqueProcessVMOs");
-        std::unordered_map<zx_koid_t, const zx_info_vmo_t*> unique_vmos;
-        unique_vmos.reserve(num_vmos);
-        for (size_t i = 0; i < num_vmos; i++) {
-          const auto* vmo_info = vmos.get() + i;
-          unique_vmos.try_emplace(vmo_info->koid, vmo_info);
-        }
-        TRACE_DURATION_END("memory_metrics", "Capture::GetProcesses::UniqueProcessVMOs");
-
-        TRACE_DURATION_BEGIN("memory_metrics", "Capture::GetProcesses::InsertProcess");
-        auto [it, _] = capture->koid_to_process_.insert({koid, {}});
-        auto& process = it->second;
-        process.koid = koid;
-        strncpy(process.name, name, ZX_MAX_NAME_LEN);
-        TRACE_DURATION_END("memory_metrics", "Capture::GetProcesses::InsertProcess");
-
-        TRACE_DURATION_BEGIN("memory_metrics", "Capture::GetProcesses::UniqueVMOs");
-        process.vmos.reserve(unique_vmos.size());
-        for (const auto& [koid, vmo] : unique_vmos) {
-          capture->koid_to_vmo_.try_emplace(koid, *vmo);
-          process.vmos.push_back(koid);
-        }
-        TRACE_DURATION_END("memory_metrics", "Capture::GetProcesses::UniqueVMOs");
-
+        capture->AddProcess(koid, name, *vmos);
         return ZX_OK;
       });
+  if (cache != nullptr) {
+    // Forget the processes which have gone away.
+    for (auto it = cache->processes_.begin(); it != cache->processes_.end();) {
+      if (capture->koid_to_process_.count(it->first) == 0) {
+        it = cache->processes_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
   capture->ReallocateDescendents(rooted_vmo_names);
   return err;
 }
 
+// static.
+zx_status_t Capture::GetProcessVmos(zx_handle_t handle, zx_koid_t koid, OS* os,
+                                    CaptureCache* cache, std::vector<zx_info_vmo_t>* buffer,
+                                    const std::vector<zx_info_vmo_t>** out_vmos) {
+  zx_info_task_stats_t stats = {};
+  zx_status_t s;
+  if (cache != nullptr) {
+    TRACE_DURATION("memory_metrics", "Capture::GetProcesses::GetTaskStats");
+    s = os->GetInfo(handle, ZX_INFO_TASK_STATS, &stats, sizeof(stats), nullptr, nullptr);
+    if (s != ZX_OK) {
+      return s;
+    }
+  }
+
+  TRACE_DURATION_BEGIN("memory_metrics", "Capture::GetProcesses::GetVMOCount");
+  size_t num_vmos;
+  s = os->GetInfo(handle, ZX_INFO_PROCESS_VMOS, nullptr, 0, nullptr, &num_vmos);
+  if (s != ZX_OK) {
+    return s;
+  }
+  TRACE_DURATION_END("memory_metrics", "Capture::GetProcesses::GetVMOCount");
+
+  // With a cache, the VMOs are kept in it rather than in |buffer|.
+  std::vector<zx_info_vmo_t>* vmos = buffer;
+  CaptureCache::CachedProcess* cached = nullptr;
+  if (cache != nullptr) {
+    auto [it, inserted] = cache->processes_.try_emplace(koid);
+    cached = &it->second;
+    vmos = &cached->vmos;
+    *out_vmos = vmos;
+    if (!inserted && cached->num_vmos == num_vmos &&
+        memcmp(&cached->stats, &stats, sizeof(stats)) == 0 &&
+        cached->reuse_count < cache->max_reuse_count_) {
+      cached->reuse_count++;
+      return ZX_OK;
+    }
+  }
+
+  TRACE_DURATION_BEGIN("memory_metrics", "Capture::GetProcesses::GetVMOs");
+  vmos->resize(num_vmos);
+  s = os->GetInfo(handle, ZX_INFO_PROCESS_VMOS, vmos->data(), num_vmos * sizeof(zx_info_vmo_t),
+                  &num_vmos, nullptr);
+  if (s != ZX_OK) {
+    if (cached != nullptr) {
+      cache->processes_.erase(koid);
+    }
+    return s;
+  }
+  vmos->resize(num_vmos);
+  TRACE_DURATION_END("memory_metrics", "Capture::GetProcesses::GetVMOs");
+
+  TRACE_DURATION_BEGIN("memory_metrics", "Capture::GetProcesses::UniqueProcessVMOs");
+  // A VMO is listed once for each mapping of it and once for each handle to it.
+  std::unordered_set<zx_koid_t> seen;
+  seen.reserve(vmos->size());
+  size_t num_unique = 0;
+  for (size_t i = 0; i < vmos->size(); i++) {
+    if (seen.insert((*vmos)[i].koid).second) {
+      (*vmos)[num_unique++] = (*vmos)[i];
+    }
+  }
+  vmos->resize(num_unique);
+  TRACE_DURATION_END("memory_metrics", "Capture::GetProcesses::UniqueProcessVMOs");
+
+  if (cached != nullptr) {
+    cached->stats = stats;
+    cached->num_vmos = num_vmos;
+    cached->reuse_count = 0;
+  }
+  *out_vmos = vmos;
+  return ZX_OK;
+}
+
+void Capture::AddProcess(zx_koid_t koid, const char* name, const std::vector<zx_info_vmo_t>& vmos) {
+  TRACE_DURATION_BEGIN("memory_metrics", "Capture::GetProcesses::InsertProcess");
+  auto [it, _] = koid_to_process_.insert({koid, {}});
+  auto& process = it->second;
+  process.koid = koid;
+  strncpy(process.name, name, ZX_MAX_NAME_LEN);
+  TRACE_DURATION_END("memory_metrics", "Capture::GetProcesses::InsertProcess");
+
+  TRACE_DURATION_BEGIN("memory_metrics", "Capture::GetProcesses::UniqueVMOs");
+  process.vmos.reserve(vmos.size());
+  for (const auto& vmo : vmos) {
+    koid_to_vmo_.try_emplace(vmo.koid, vmo);
+    process.vmos.push_back(vmo.koid);
+  }
+  TRACE_DURATION_END("memory_metrics", "Capture::GetProcesses::UniqueVMOs");
+}
+
 // Descendents of this vmo will have their allocated_bytes treated as an allocation of their
 // immediate parent. This supports a usage pattern where a potentially large allocation is done
 // and then slices are given to read / write children. In this case the children have no
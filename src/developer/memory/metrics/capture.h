@@ -68,6 +68,38 @@ class OS {
       zx_info_kmem_stats_extended_t* kmem_ext, zx_info_kmem_stats_t* kmem = nullptr) = 0;
 };
 
+// Keeps the VMOs of each process from one capture to the next, so that a capture made with a cache
+// only enumerates the VMOs of the processes whose memory use has changed since the previous one.
+//
+// The kernel has no per-process counter of changes to a process's VMOs, so a process is taken to be
+// unchanged when its ZX_INFO_TASK_STATS and its VMO count are. Those are cheap compared to copying
+// out and indexing thousands of zx_info_vmo_t, but they can miss changes, e.g. to the committed
+// size of a VMO which is only reachable through a handle. To bound how stale the results can get,
+// each process is queried in full at least once every |max_reuse_count| + 1 captures.
+class CaptureCache {
+ public:
+  static constexpr uint32_t kDefaultMaxReuseCount = 9;
+
+  explicit CaptureCache(uint32_t max_reuse_count = kDefaultMaxReuseCount)
+      : max_reuse_count_(max_reuse_count) {}
+
+  size_t size() const { return processes_.size(); }
+
+ private:
+  struct CachedProcess {
+    zx_info_task_stats_t stats;
+    size_t num_vmos;
+    uint32_t reuse_count;
+    // Unique by koid.
+    std::vector<zx_info_vmo_t> vmos;
+  };
+
+  const uint32_t max_reuse_count_;
+  std::unordered_map<zx_koid_t, CachedProcess> processes_;
+
+  friend class Capture;
+};
+
 class Capture {
  public:
   static const std::vector<std::string> kDefaultRootedVmoNames;
@@ -87,6 +119,12 @@ class Capture {
       Capture* capture, const CaptureState& state, CaptureLevel level,
       const std::vector<std::string>& rooted_vmo_names = kDefaultRootedVmoNames);
 
+  // Like the above, but for a level of VMO the VMOs of processes which appear not to have changed
+  // are taken from |cache|, which is then updated for the next capture. See CaptureCache.
+  static zx_status_t GetCapture(
+      Capture* capture, const CaptureState& state, CaptureLevel level, CaptureCache* cache,
+      const std::vector<std::string>& rooted_vmo_names = kDefaultRootedVmoNames);
+
   zx_time_t time() const { return time_; }
   const zx_info_kmem_stats_t& kmem() const { return kmem_; }
   const zx_info_kmem_stats_extended_t& kmem_extended() const { return kmem_extended_; }
@@ -102,7 +140,14 @@ class Capture {
  private:
   static zx_status_t GetCaptureState(CaptureState* state, OS* os);
   static zx_status_t GetCapture(Capture* capture, const CaptureState& state, CaptureLevel level,
-                                OS* os, const std::vector<std::string>& rooted_vmo_names);
+                                OS* os, const std::vector<std::string>& rooted_vmo_names,
+                                CaptureCache* cache = nullptr);
+  // Points |out_vmos| at the unique VMOs of a process. These are kept in |cache| if it is given,
+  // and only queried if they appear to have changed, or in |buffer| otherwise.
+  static zx_status_t GetProcessVmos(zx_handle_t handle, zx_koid_t koid, OS* os,
+                                    CaptureCache* cache, std::vector<zx_info_vmo_t>* buffer,
+                                    const std::vector<zx_info_vmo_t>** out_vmos);
+  void AddProcess(zx_koid_t koid, const char* name, const std::vector<zx_info_vmo_t>& vmos);
   void ReallocateDescendents(const std::vector<std::string>& rooted_vmo_names);
   void ReallocateDescendents(Vmo* parent);
 
@@ -6,48 +6,133 @@
 
 #include <lib/trace/event.h>
 
+#include <optional>
+
 #include "src/developer/memory/metrics/bucket_match.h"
 
 namespace memory {
 Digest::Digest(const Capture& capture, Digester* digester) { digester->Digest(capture, this); }
 
-Digester::Digester(const std::vector<BucketMatch>& bucket_matches) {
-  bucket_matches_.reserve(bucket_matches.size());
+namespace {
+
+std::vector<std::optional<std::string>> ProcessPatterns(
+    const std::vector<BucketMatch>& bucket_matches) {
+  std::vector<std::optional<std::string>> patterns;
+  patterns.reserve(bucket_matches.size());
+  for (const auto& bucket_match : bucket_matches) {
+    patterns.push_back(bucket_match.process_pattern());
+  }
+  return patterns;
+}
+
+std::vector<std::optional<std::string>> VmoPatterns(
+    const std::vector<BucketMatch>& bucket_matches) {
+  std::vector<std::optional<std::string>> patterns;
+  patterns.reserve(bucket_matches.size());
+  for (const auto& bucket_match : bucket_matches) {
+    patterns.push_back(bucket_match.vmo_pattern());
+  }
+  return patterns;
+}
+
+// Returns the smallest bucket in both |a| and |b|, which are in increasing order.
+std::optional<size_t> FirstCommonBucket(const std::vector<size_t>& a,
+                                        const std::vector<size_t>& b) {
+  auto ai = a.begin();
+  auto bi = b.begin();
+  while (ai != a.end() && bi != b.end()) {
+    if (*ai < *bi) {
+      ++ai;
+    } else if (*bi < *ai) {
+      ++bi;
+    } else {
+      return *ai;
+    }
+  }
+  return std::nullopt;
+}
+
+// Drops the entries of |cache| for koids which aren't in |current|.
+template <typename Map, typename Cache>
+void Prune(const Map& current, Cache* cache) {
+  for (auto it = cache->begin(); it != cache->end();) {
+    if (current.count(it->first) == 0) {
+      it = cache->erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+}  // namespace
+
+Digester::Digester(const std::vector<BucketMatch>& bucket_matches)
+    : process_matcher_(ProcessPatterns(bucket_matches)),
+      vmo_matcher_(VmoPatterns(bucket_matches)) {
+  bucket_names_.reserve(bucket_matches.size());
   for (const auto& bucket_match : bucket_matches) {
-    bucket_matches_.emplace_back(bucket_match);
+    bucket_names_.push_back(bucket_match.name());
   }
 }
 
+// static.
+const std::vector<size_t>& Digester::Match(const BucketSetMatch& matcher, zx_koid_t koid,
+                                           const char* name,
+                                           std::unordered_map<zx_koid_t, CachedMatch>* cache) {
+  auto [it, inserted] = cache->try_emplace(koid);
+  CachedMatch& match = it->second;
+  if (inserted || match.name != name) {
+    match.name = name;
+    matcher.Match(match.name, &match.buckets);
+  }
+  return match.buckets;
+}
+
 void Digester::Digest(const Capture& capture, class Digest* digest) {
   TRACE_DURATION("memory_metrics", "Digester::Digest");
   digest->time_ = capture.time();
-  digest->undigested_vmos_.reserve(capture.koid_to_vmo().size());
-  for (const auto& [koid, _] : capture.koid_to_vmo()) {
-    digest->undigested_vmos_.emplace(koid);
-  }
+  Prune(capture.koid_to_process(), &process_matches_);
+  Prune(capture.koid_to_vmo(), &vmo_matches_);
 
-  digest->buckets_.reserve(bucket_matches_.size());
-  for (auto& bucket_match : bucket_matches_) {
-    auto& bucket = digest->buckets_.emplace_back(bucket_match.name(), 0);
-    for (const auto& [_, process] : capture.koid_to_process()) {
-      if (!bucket_match.ProcessMatch(process)) {
+  // The bucket of each VMO which is in one.
+  std::unordered_map<zx_koid_t, size_t> vmo_buckets;
+  vmo_buckets.reserve(capture.koid_to_vmo().size());
+  for (const auto& [koid, process] : capture.koid_to_process()) {
+    const auto& process_buckets = Match(process_matcher_, koid, process.name, &process_matches_);
+    if (process_buckets.empty()) {
+      continue;
+    }
+    for (const auto& v : process.vmos) {
+      const auto vi = capture.koid_to_vmo().find(v);
+      if (vi == capture.koid_to_vmo().end()) {
+        continue;
+      }
+      const auto& matched = Match(vmo_matcher_, v, vi->second.name, &vmo_matches_);
+      const auto bucket = FirstCommonBucket(process_buckets, matched);
+      if (!bucket) {
         continue;
       }
-      for (const auto& v : process.vmos) {
-        auto it = digest->undigested_vmos_.find(v);
-        if (it == digest->undigested_vmos_.end()) {
-          continue;
-        }
-        const auto& vmo = capture.vmo_for_koid(v);
-        if (!bucket_match.VmoMatch(vmo.name)) {
-          continue;
-        }
-        bucket.size_ += vmo.committed_bytes;
-        digest->undigested_vmos_.erase(it);
+      auto [it, inserted] = vmo_buckets.emplace(v, *bucket);
+      if (!inserted && *bucket < it->second) {
+        it->second = *bucket;
       }
     }
   }
 
+  digest->buckets_.reserve(bucket_names_.size());
+  for (const auto& name : bucket_names_) {
+    digest->buckets_.emplace_back(name, 0);
+  }
+  digest->undigested_vmos_.reserve(capture.koid_to_vmo().size() - vmo_buckets.size());
+  for (const auto& [koid, vmo] : capture.koid_to_vmo()) {
+    const auto it = vmo_buckets.find(koid);
+    if (it == vmo_buckets.end()) {
+      digest->undigested_vmos_.emplace(koid);
+      continue;
+    }
+    digest->buckets_[it->second].size_ += vmo.committed_bytes;
+  }
+
   std::sort(digest->buckets_.begin(), digest->buckets_.end(),
             [](const Bucket& a, const Bucket& b) { return a.size() > b.size(); });
   uint64_t undigested_size = 0;
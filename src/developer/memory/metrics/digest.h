@@ -47,13 +47,35 @@ class Digest {
   friend class Digester;
 };
 
+// Sorts the VMOs of captures into buckets. A VMO goes into the first bucket whose VMO pattern
+// matches it and whose process pattern matches one of the processes which hold it.
+//
+// The patterns of all of the buckets are matched at once, and the buckets matched by each process
+// and VMO are remembered by koid from one digest to the next, so that only new or renamed processes
+// and VMOs are matched again.
 class Digester {
  public:
   explicit Digester(const std::vector<BucketMatch>& bucket_matches);
   void Digest(const Capture& capture, Digest* digest);
 
  private:
-  std::vector<BucketMatch> bucket_matches_;
+  struct CachedMatch {
+    std::string name;
+    // The buckets whose patterns match |name|, in increasing order.
+    std::vector<size_t> buckets;
+  };
+
+  // Returns the buckets matching |name| from |cache|, matching it with |matcher| if |koid| isn't
+  // in |cache| or had another name.
+  static const std::vector<size_t>& Match(const BucketSetMatch& matcher, zx_koid_t koid,
+                                          const char* name,
+                                          std::unordered_map<zx_koid_t, CachedMatch>* cache);
+
+  std::vector<std::string> bucket_names_;
+  BucketSetMatch process_matcher_;
+  BucketSetMatch vmo_matcher_;
+  std::unordered_map<zx_koid_t, CachedMatch> process_matches_;
+  std::unordered_map<zx_koid_t, CachedMatch> vmo_matches_;
 
   friend class Digest;
 };
@@ -12,6 +12,8 @@
 #include "src/developer/memory/metrics/tests/test_utils.h"
 #include "zircon/system/public/zircon/types.h"
 
+using testing::ElementsAre;
+using testing::IsEmpty;
 using testing::SizeIs;
 
 namespace memory {
@@ -67,5 +69,21 @@ TEST_F(ConfigUnitTest, InvalidConfiguration) {
       BucketMatch::ReadBucketMatchesFromConfig(R"([{"name": "a", "process": ".*", "vmo": ".*"]})"));
 }
 
+TEST_F(ConfigUnitTest, BucketSetMatch) {
+  BucketSetMatch matcher({"a.*", std::nullopt, "ab", "b|ab", "("});
+  std::vector<size_t> buckets;
+  matcher.Match("ab", &buckets);
+  EXPECT_THAT(buckets, ElementsAre(0, 1, 2, 3));
+  matcher.Match("abc", &buckets);
+  EXPECT_THAT(buckets, ElementsAre(0, 1));
+  // Patterns match whole names.
+  matcher.Match("cab", &buckets);
+  EXPECT_THAT(buckets, ElementsAre(1));
+
+  BucketSetMatch empty({});
+  empty.Match("ab", &buckets);
+  EXPECT_THAT(buckets, IsEmpty());
+}
+
 }  // namespace test
 }  // namespace memory
@@ -84,6 +84,15 @@ const static zx_info_vmo_t _vmo2 = {
 const static GetInfoResponse vmos2_info = {
     proc2_handle, ZX_INFO_PROCESS_VMOS, &_vmo2, sizeof(_vmo2), 1, ZX_OK};
 
+const static zx_info_task_stats_t _stats = {.mem_private_bytes = 100};
+const static GetInfoResponse stats_info = {
+    proc_handle, ZX_INFO_TASK_STATS, &_stats, sizeof(_stats), 1, ZX_OK};
+const static zx_info_task_stats_t _stats_changed = {.mem_private_bytes = 200};
+const static GetInfoResponse stats_changed_info = {
+    proc_handle, ZX_INFO_TASK_STATS, &_stats_changed, sizeof(_stats_changed), 1, ZX_OK};
+const static GetInfoResponse stats2_info = {
+    proc2_handle, ZX_INFO_TASK_STATS, &_stats, sizeof(_stats), 1, ZX_OK};
+
 TEST_F(CaptureUnitTest, KMEM) {
   Capture c;
   auto ret = TestUtils::GetCapture(&c, KMEM,
@@ -298,5 +307,93 @@ TEST_F(CaptureUnitTest, VMORootedPartialCommit) {
   EXPECT_EQ(0U, c.vmo_for_koid(2).committed_bytes);
   EXPECT_EQ(75U, c.vmo_for_koid(3).committed_bytes);
 }
+
+TEST_F(CaptureUnitTest, CacheReusesUnchangedProcess) {
+  CaptureCache cache;
+  Capture c1;
+  ASSERT_EQ(ZX_OK, TestUtils::GetCapture(
+                       &c1, VMO,
+                       {.get_processes = {{ZX_OK, {proc_cb}}},
+                        .get_property = {proc_prop},
+                        .get_info = {self_info, kmem_info, stats_info, vmos_info, vmos_info}},
+                       &cache));
+  EXPECT_EQ(1U, cache.size());
+
+  // The stats and VMO count are unchanged, so the VMOs aren't queried again.
+  Capture c2;
+  ASSERT_EQ(ZX_OK,
+            TestUtils::GetCapture(&c2, VMO,
+                                  {.get_processes = {{ZX_OK, {proc_cb}}},
+                                   .get_property = {proc_prop},
+                                   .get_info = {self_info, kmem_info, stats_info, vmos_info}},
+                                  &cache));
+  ASSERT_EQ(1U, c2.koid_to_process().size());
+  const auto& process = c2.process_for_koid(proc_koid);
+  ASSERT_EQ(1U, process.vmos.size());
+  EXPECT_EQ(vmo_koid, process.vmos[0]);
+  EXPECT_STREQ(vmo_name, c2.vmo_for_koid(vmo_koid).name);
+}
+
+TEST_F(CaptureUnitTest, CacheRequeriesChangedProcess) {
+  CaptureCache cache;
+  Capture c1;
+  ASSERT_EQ(ZX_OK, TestUtils::GetCapture(
+                       &c1, VMO,
+                       {.get_processes = {{ZX_OK, {proc_cb}}},
+                        .get_property = {proc_prop},
+                        .get_info = {self_info, kmem_info, stats_info, vmos_info, vmos_info}},
+                       &cache));
+
+  Capture c2;
+  ASSERT_EQ(ZX_OK,
+            TestUtils::GetCapture(
+                &c2, VMO,
+                {.get_processes = {{ZX_OK, {proc_cb}}},
+                 .get_property = {proc_prop},
+                 .get_info = {self_info, kmem_info, stats_changed_info, vmos_info, vmos_info}},
+                &cache));
+  EXPECT_EQ(1U, c2.koid_to_vmo().size());
+}
+
+TEST_F(CaptureUnitTest, CacheBoundsReuse) {
+  CaptureCache cache(1);
+  const OsResponses full = {
+      .get_processes = {{ZX_OK, {proc_cb}}},
+      .get_property = {proc_prop},
+      .get_info = {self_info, kmem_info, stats_info, vmos_info, vmos_info}};
+  const OsResponses reused = {.get_processes = {{ZX_OK, {proc_cb}}},
+                              .get_property = {proc_prop},
+                              .get_info = {self_info, kmem_info, stats_info, vmos_info}};
+  Capture c1, c2, c3;
+  ASSERT_EQ(ZX_OK, TestUtils::GetCapture(&c1, VMO, full, &cache));
+  ASSERT_EQ(ZX_OK, TestUtils::GetCapture(&c2, VMO, reused, &cache));
+  // Reused as often as allowed, so queried in full again even though nothing changed.
+  ASSERT_EQ(ZX_OK, TestUtils::GetCapture(&c3, VMO, full, &cache));
+  EXPECT_EQ(1U, c3.koid_to_vmo().size());
+}
+
+TEST_F(CaptureUnitTest, CacheForgetsExitedProcesses) {
+  CaptureCache cache;
+  Capture c1;
+  ASSERT_EQ(ZX_OK, TestUtils::GetCapture(&c1, VMO,
+                                         {.get_processes = {{ZX_OK, {proc_cb, proc2_cb}}},
+                                          .get_property = {proc_prop, proc2_prop},
+                                          .get_info = {self_info, kmem_info, stats_info, vmos_info,
+                                                       vmos_info, stats2_info, vmos2_info,
+                                                       vmos2_info}},
+                                         &cache));
+  EXPECT_EQ(2U, cache.size());
+
+  Capture c2;
+  ASSERT_EQ(ZX_OK,
+            TestUtils::GetCapture(&c2, VMO,
+                                  {.get_processes = {{ZX_OK, {proc_cb}}},
+                                   .get_property = {proc_prop},
+                                   .get_info = {self_info, kmem_info, stats_info, vmos_info}},
+                                  &cache));
+  EXPECT_EQ(1U, cache.size());
+  EXPECT_EQ(1U, c2.koid_to_process().size());
+}
+
 }  // namespace test
 }  // namespace memory
@@ -272,5 +272,61 @@ TEST_F(DigestUnitTest, DefaultBuckets) {
                     });
 }
 
+TEST_F(DigestUnitTest, FirstMatchingBucket) {
+  // VMO 1 is shared by p1 and q1. Only q1 matches the first bucket which matches VMO 1.
+  Capture c;
+  TestUtils::CreateCapture(&c, {
+                                   .vmos =
+                                       {
+                                           {.koid = 1, .name = "a1", .committed_bytes = 100},
+                                           {.koid = 2, .name = "a2", .committed_bytes = 200},
+                                       },
+                                   .processes =
+                                       {
+                                           {.koid = 1, .name = "p1", .vmos = {1, 2}},
+                                           {.koid = 2, .name = "q1", .vmos = {1}},
+                                       },
+                               });
+
+  Digester digester({{"B", ".*", "b.*"}, {"Q", "q.*", "a.*"}, {"A", ".*", "a.*"}});
+  Digest d(c, &digester);
+  EXPECT_EQ(0U, d.undigested_vmos().size());
+  ConfirmBuckets(d, {{"B", 0U}, {"Q", 100U}, {"A", 200U}});
+}
+
+TEST_F(DigestUnitTest, RenamedBetweenDigests) {
+  Digester digester({{"A", "p.*", "a.*"}, {"B", ".*", "b.*"}});
+  Capture c1;
+  TestUtils::CreateCapture(&c1, {
+                                    .vmos =
+                                        {
+                                            {.koid = 1, .name = "a1", .committed_bytes = 100},
+                                        },
+                                    .processes =
+                                        {
+                                            {.koid = 1, .name = "p1", .vmos = {1}},
+                                        },
+                                });
+  Digest d1(c1, &digester);
+  ConfirmBuckets(d1, {{"A", 100U}, {"B", 0U}});
+
+  // The same koids with other names must be matched again.
+  Capture c2;
+  TestUtils::CreateCapture(&c2, {
+                                    .vmos =
+                                        {
+                                            {.koid = 1, .name = "b1", .committed_bytes = 100},
+                                            {.koid = 2, .name = "a2", .committed_bytes = 200},
+                                        },
+                                    .processes =
+                                        {
+                                            {.koid = 1, .name = "q1", .vmos = {1, 2}},
+                                        },
+                                });
+  Digest d2(c2, &digester);
+  ASSERT_EQ(1U, d2.undigested_vmos().size());
+  ConfirmBuckets(d2, {{"A", 0U}, {"B", 100U}, {"Undigested", 200U}});
+}
+
 }  // namespace test
 }  // namespace memory
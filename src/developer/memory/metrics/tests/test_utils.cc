@@ -123,12 +123,13 @@ std::vector<ProcessSummary> TestUtils::GetProcessSummaries(const Summary& summar
   return summaries;
 }
 
-zx_status_t TestUtils::GetCapture(Capture* capture, CaptureLevel level, const OsResponses& r) {
+zx_status_t TestUtils::GetCapture(Capture* capture, CaptureLevel level, const OsResponses& r,
+                                  CaptureCache* cache) {
   MockOS os(r);
   CaptureState state;
   zx_status_t ret = Capture::GetCaptureState(&state, &os);
   EXPECT_EQ(ZX_OK, ret);
-  return Capture::GetCapture(capture, state, level, &os, Capture::kDefaultRootedVmoNames);
+  return Capture::GetCapture(capture, state, level, &os, Capture::kDefaultRootedVmoNames, cache);
 }
 
 zx_status_t CaptureSupplier::GetCapture(Capture* capture, CaptureLevel level,
@@ -20,12 +20,15 @@
 #include <zircon/status.h>
 #include <zircon/types.h>
 
+#include <algorithm>
 #include <filesystem>
+#include <functional>
 #include <iostream>
 #include <iterator>
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <unordered_map>
 #include <utility>
 
 #include <soc/aml-common/aml-ram.h>
@@ -36,6 +39,7 @@
 #include "src/developer/memory/metrics/bucket_match.h"
 #include "src/developer/memory/metrics/capture.h"
 #include "src/developer/memory/metrics/printer.h"
+#include "src/developer/memory/metrics/summary.h"
 #include "src/developer/memory/monitor/high_water.h"
 #include "src/developer/memory/monitor/memory_metrics_registry.cb.h"
 #include "src/developer/memory/monitor/pressure_observer.h"
@@ -57,6 +61,14 @@ const std::string kBucketConfigPath = "/config/data/buckets.json";
 const zx::duration kHighWaterPollFrequency = zx::sec(10);
 const uint64_t kHighWaterThreshold = 10 * 1024 * 1024;
 const zx::duration kMetricsPollFrequency = zx::min(5);
+// How far ahead the Warning memory pressure level is predicted, from the free memory sampled at
+// kHighWaterPollFrequency.
+const zx::duration kPressurePredictionHorizon = zx::sec(60);
+// How long watchers are given to shed memory once the Warning level is predicted, before what they
+// reclaimed is measured.
+const zx::duration kReclaimMeasurementDelay = zx::sec(10);
+// The number of processes which reclaimed the most that are recorded.
+const size_t kMaxReclaimProcesses = 10;
 const char kTraceNameHighPrecisionBandwidth[] = "memory_monitor:high_precision_bandwidth";
 const char kTraceNameHighPrecisionBandwidthCamera[] =
     "memory_monitor:high_precision_bandwidth_camera";
@@ -138,14 +150,23 @@ Monitor::Monitor(std::unique_ptr<sys::ComponentContext> context,
       component_context_(std::move(context)),
       inspector_(component_context_.get()),
       logger_(
-          dispatcher_, [this](Capture* c) { return GetCapture(c); },
+          dispatcher_, [this](Capture* c) { return GetIncrementalCapture(c); },
           [this](const Capture& c, Digest* d) { GetDigest(c, d); }),
+      pressure_predictor_(kPressurePredictionHorizon),
+      pressure_prediction_node_(inspector_.root().CreateChild("pressure_prediction")),
+      warnings_predicted_(pressure_prediction_node_.CreateUint("warnings_predicted", 0)),
       level_(Level::kNumLevels) {
   auto bucket_matches = CreateBucketMatchesFromConfigData();
   digester_ = std::make_unique<Digester>(Digester(bucket_matches));
   high_water_ = std::make_unique<HighWater>(
       "/cache", kHighWaterPollFrequency, kHighWaterThreshold, dispatcher,
-      [this](Capture* c, CaptureLevel l) { return Capture::GetCapture(c, capture_state_, l); },
+      [this](Capture* c, CaptureLevel l) {
+        const zx_status_t s = Capture::GetCapture(c, capture_state_, l);
+        if (s == ZX_OK && l == KMEM) {
+          PredictPressure(*c);
+        }
+        return s;
+      },
       [this](const Capture& c, Digest* d) { digester_->Digest(c, d); });
   auto s = Capture::GetCaptureState(&capture_state_);
   if (s != ZX_OK) {
@@ -262,7 +283,7 @@ void Monitor::CreateMetrics(const std::vector<memory::BucketMatch>& bucket_match
 
   metrics_ = std::make_unique<Metrics>(
       bucket_matches, kMetricsPollFrequency, dispatcher_, &inspector_, metric_event_logger_.get(),
-      [this](Capture* c) { return GetCapture(c); },
+      [this](Capture* c) { return GetIncrementalCapture(c); },
       [this](const Capture& c, Digest* d) { GetDigest(c, d); });
 }
 
@@ -544,6 +565,11 @@ zx_status_t Monitor::GetCapture(memory::Capture* capture) {
   return Capture::GetCapture(capture, capture_state_, VMO);
 }
 
+zx_status_t Monitor::GetIncrementalCapture(memory::Capture* capture) {
+  std::lock_guard<std::mutex> lock(capture_cache_mutex_);
+  return Capture::GetCapture(capture, capture_state_, VMO, &capture_cache_);
+}
+
 void Monitor::GetDigest(const memory::Capture& capture, memory::Digest* digest) {
   std::lock_guard<std::mutex> lock(digester_mutex_);
   digester_->Digest(capture, digest);
@@ -571,6 +597,91 @@ void Monitor::PressureLevelChanged(Level level) {
 
   level_ = level;
   logger_.SetPressureLevel(level_);
+
+  // Any prediction was made at the previous level.
+  pressure_notifier_->SetWarningPredicted(false);
+  Capture capture;
+  const zx_status_t s = Capture::GetCapture(&capture, capture_state_, KMEM);
+  if (s != ZX_OK) {
+    FX_LOGS(ERROR) << "Error getting capture: " << zx_status_get_string(s);
+    return;
+  }
+  pressure_predictor_.OnLevelChanged(level_, capture.kmem().free_bytes);
+}
+
+void Monitor::PredictPressure(const memory::Capture& capture) {
+  if (!pressure_notifier_) {
+    return;
+  }
+  const bool was_predicted = pressure_predictor_.warning_predicted();
+  const bool predicted =
+      pressure_predictor_.AddSample(zx::time(capture.time()), capture.kmem().free_bytes);
+  if (predicted == was_predicted) {
+    return;
+  }
+  pressure_notifier_->SetWarningPredicted(predicted);
+  if (!predicted) {
+    return;
+  }
+
+  FX_LOGS(INFO) << "Warning memory pressure predicted with " << capture.kmem().free_bytes
+                << " bytes free, threshold " << pressure_predictor_.warning_free_bytes();
+  TRACE_INSTANT("memory_monitor", "MemoryPressureWarningPredicted", TRACE_SCOPE_THREAD,
+                "free_bytes", capture.kmem().free_bytes);
+  warnings_predicted_.Add(1);
+  auto before = std::make_unique<Capture>();
+  const zx_status_t s = GetCapture(before.get());
+  if (s != ZX_OK) {
+    FX_LOGS(ERROR) << "Error getting capture: " << zx_status_get_string(s);
+    return;
+  }
+  async::PostDelayedTask(
+      dispatcher_, [this, before = std::move(before)] { RecordReclaim(*before); },
+      kReclaimMeasurementDelay);
+}
+
+void Monitor::RecordReclaim(const memory::Capture& before) {
+  Capture after;
+  const zx_status_t s = GetCapture(&after);
+  if (s != ZX_OK) {
+    FX_LOGS(ERROR) << "Error getting capture: " << zx_status_get_string(s);
+    return;
+  }
+
+  // Only processes which are still running are counted, as those which exited may have been killed
+  // rather than have shed memory.
+  const Summary summary_before(before);
+  std::unordered_map<zx_koid_t, uint64_t> private_bytes_before;
+  for (const auto& process : summary_before.process_summaries()) {
+    private_bytes_before.emplace(process.koid(), process.sizes().private_bytes);
+  }
+  std::vector<std::pair<uint64_t, std::string>> reclaimed;
+  uint64_t total_reclaimed = 0;
+  const Summary summary_after(after);
+  for (const auto& process : summary_after.process_summaries()) {
+    const auto it = private_bytes_before.find(process.koid());
+    if (it == private_bytes_before.end() || it->second <= process.sizes().private_bytes) {
+      continue;
+    }
+    const uint64_t bytes = it->second - process.sizes().private_bytes;
+    total_reclaimed += bytes;
+    reclaimed.emplace_back(bytes, process.name());
+  }
+  const size_t count = std::min(reclaimed.size(), kMaxReclaimProcesses);
+  std::partial_sort(reclaimed.begin(), reclaimed.begin() + count, reclaimed.end(),
+                    std::greater<>());
+  FX_LOGS(INFO) << total_reclaimed << " bytes reclaimed by " << reclaimed.size()
+                << " processes after Warning memory pressure was predicted";
+
+  last_reclaim_values_ = inspect::ValueList();
+  last_reclaim_node_ = pressure_prediction_node_.CreateChild("last_reclaim");
+  last_reclaim_node_.CreateInt("timestamp", after.time(), &last_reclaim_values_);
+  last_reclaim_node_.CreateUint("total_bytes", total_reclaimed, &last_reclaim_values_);
+  auto processes = last_reclaim_node_.CreateChild("processes");
+  for (size_t i = 0; i < count; i++) {
+    processes.CreateUint(reclaimed[i].second, reclaimed[i].first, &last_reclaim_values_);
+  }
+  last_reclaim_values_.emplace(std::move(processes));
 }
 
 }  // namespace monitor
@@ -9,6 +9,7 @@
 #include <fuchsia/memory/cpp/fidl.h>
 #include <lib/async/dispatcher.h>
 #include <lib/fidl/cpp/binding_set.h>
+#include <lib/inspect/cpp/inspect.h>
 #include <lib/sys/cpp/component_context.h>
 #include <lib/trace/observer.h>
 #include <lib/zx/vmo.h>
@@ -24,6 +25,7 @@
 #include "src/developer/memory/monitor/logger.h"
 #include "src/developer/memory/monitor/metrics.h"
 #include "src/developer/memory/monitor/pressure_notifier.h"
+#include "src/developer/memory/monitor/pressure_predictor.h"
 #include "src/lib/fxl/command_line.h"
 
 namespace monitor {
@@ -74,10 +76,21 @@ class Monitor : public fuchsia::memory::Monitor {
   void NotifyWatchers(const zx_info_kmem_stats_t& stats);
 
   zx_status_t GetCapture(memory::Capture* capture);
+  // Like |GetCapture|, but reuses the VMOs of processes which appear unchanged since the last
+  // periodic capture. Used only for the periodic logging and metrics, which tolerate that.
+  zx_status_t GetIncrementalCapture(memory::Capture* capture);
   void GetDigest(const memory::Capture& capture, memory::Digest* digest);
   void PressureLevelChanged(Level level);
+  // Feeds a periodic sample of free memory to |pressure_predictor_|, and tells watchers when the
+  // prediction changes.
+  void PredictPressure(const memory::Capture& capture);
+  // Records in Inspect how much each process has shrunk since |before|, which was captured when
+  // the Warning level was predicted.
+  void RecordReclaim(const memory::Capture& before);
 
   memory::CaptureState capture_state_;
+  memory::CaptureCache capture_cache_;
+  std::mutex capture_cache_mutex_;
   std::unique_ptr<HighWater> high_water_;
   uint64_t prealloc_size_;
   zx::vmo prealloc_vmo_;
@@ -95,6 +108,11 @@ class Monitor : public fuchsia::memory::Monitor {
   Logger logger_;
   std::unique_ptr<Metrics> metrics_;
   std::unique_ptr<PressureNotifier> pressure_notifier_;
+  PressurePredictor pressure_predictor_;
+  inspect::Node pressure_prediction_node_;
+  inspect::UintProperty warnings_predicted_;
+  inspect::Node last_reclaim_node_;
+  inspect::ValueList last_reclaim_values_;
   std::unique_ptr<MemoryDebugger> memory_debugger_;
   std::unique_ptr<memory::Digester> digester_;
   std::mutex digester_mutex_;
@@ -91,17 +91,40 @@ void PressureNotifier::PostLevelChange() {
     FileCrashReport(CrashReportType::kCritical);
   }
 
+  NotifyWatchers(GetLevelForWatchers());
+}
+
+void PressureNotifier::SetWarningPredicted(bool predicted) {
+  if (predicted == warning_predicted_) {
+    return;
+  }
+  const Level level_before = GetLevelForWatchers();
+  warning_predicted_ = predicted;
+  const Level level_after = GetLevelForWatchers();
+  if (level_after != level_before) {
+    FX_LOGS(INFO) << "Warning memory pressure " << (predicted ? "predicted" : "no longer predicted")
+                  << ", notifying watchers of " << kLevelNames[level_after];
+    NotifyWatchers(level_after);
+  }
+}
+
+void PressureNotifier::NotifyWatchers(Level level) {
   // TODO(rashaeqbal): Throttle notifications to prevent thrashing.
   for (auto& watcher : watchers_) {
     // Notify the watcher only if we received a response for the previous level change, i.e. there
     // is no pending callback.
     if (!watcher->pending_callback) {
       watcher->pending_callback = true;
-      NotifyWatcher(watcher.get(), level_to_send);
+      NotifyWatcher(watcher.get(), level);
     }
   }
 }
 
+Level PressureNotifier::GetLevelForWatchers() const {
+  Level level = observer_.GetCurrentLevelForWatcher();
+  return (level == Level::kNormal && warning_predicted_) ? Level::kWarning : level;
+}
+
 void PressureNotifier::DebugNotify(fuchsia::memorypressure::Level level) const {
   FX_LOGS(INFO) << "Simulating memory pressure level "
                 << kLevelNames[ConvertFromMemoryPressureServiceLevel(level)];
@@ -141,7 +164,7 @@ void PressureNotifier::OnLevelChangedCallback(WatcherState* watcher) {
     return;
   }
 
-  Level current_level = observer_.GetCurrentLevelForWatcher();
+  Level current_level = GetLevelForWatchers();
   // The watcher might have missed a level change if it occurred before this callback. If the
   // level has changed, notify the watcher.
   if (watcher->level_sent != current_level) {
@@ -164,7 +187,7 @@ void PressureNotifier::RegisterWatcher(
   watcher_proxy.set_error_handler(
       [this, proxy_raw_ptr](zx_status_t status) { ReleaseWatcher(proxy_raw_ptr); });
 
-  Level current_level = observer_.GetCurrentLevelForWatcher();
+  Level current_level = GetLevelForWatchers();
   watchers_.emplace_back(std::make_unique<WatcherState>(
       WatcherState{std::move(watcher_proxy), current_level, false, false}));
 
@@ -43,11 +43,20 @@ class PressureNotifier : public fuchsia::memorypressure::Provider {
   // Notify watchers with a simulated memory pressure |level|. For diagnostic use by MemoryDebugger.
   void DebugNotify(fuchsia::memorypressure::Level level) const;
 
+  // Sets whether the Warning level is predicted. While it is and the actual level is Normal,
+  // watchers are sent Warning, so that they can shed memory before the kernel signals Warning.
+  // Must be called on the dispatcher the notifier was created with.
+  void SetWarningPredicted(bool predicted);
+
  private:
   void PostLevelChange();
   void ReleaseWatcher(fuchsia::memorypressure::Watcher* watcher);
   void OnLevelChangedCallback(WatcherState* watcher);
   void NotifyWatcher(WatcherState* watcher, Level level);
+  // Notifies every watcher which isn't waiting to respond to a previous notification.
+  void NotifyWatchers(Level level);
+  // The level sent to watchers.
+  Level GetLevelForWatchers() const;
 
   bool CanGenerateNewCriticalCrashReports();
   enum CrashReportType : uint8_t {
@@ -64,6 +73,7 @@ class PressureNotifier : public fuchsia::memorypressure::Provider {
   std::vector<std::unique_ptr<WatcherState>> watchers_;
   PressureObserver observer_;
 
+  bool warning_predicted_ = false;
   bool observed_normal_level_ = true;
   zx::time prev_critical_crash_report_time_ = zx::time(ZX_TIME_INFINITE_PAST);
   zx::duration critical_crash_report_interval_ = zx::min(30);
@@ -0,0 +1,78 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/developer/memory/monitor/pressure_predictor.h"
+
+namespace monitor {
+
+PressurePredictor::PressurePredictor(zx::duration horizon) : horizon_(horizon) {}
+
+bool PressurePredictor::AddSample(zx::time time, uint64_t free_bytes) {
+  samples_.push_back({time, free_bytes});
+  if (samples_.size() > kMaxSamples) {
+    samples_.pop_front();
+  }
+  if (level_ != Level::kNormal) {
+    warning_predicted_ = false;
+    return false;
+  }
+  const auto time_to_warning = TimeToWarning();
+  warning_predicted_ = time_to_warning && *time_to_warning <= horizon_;
+  return warning_predicted_;
+}
+
+void PressurePredictor::OnLevelChanged(Level level, uint64_t free_bytes) {
+  if (level == Level::kWarning && level_ == Level::kNormal) {
+    warning_free_bytes_ = free_bytes;
+  }
+  level_ = level;
+  samples_.clear();
+  warning_predicted_ = false;
+}
+
+std::optional<zx::duration> PressurePredictor::TimeToWarning() const {
+  if (samples_.size() < kMinSamples) {
+    return std::nullopt;
+  }
+
+  // Least squares fit of free bytes against time, in seconds since the first sample.
+  const zx::time start = samples_.front().time;
+  auto secs_since_start = [start](zx::time time) {
+    return static_cast<double>((time - start).to_nsecs()) / ZX_SEC(1);
+  };
+  double mean_t = 0;
+  double mean_free = 0;
+  for (const auto& sample : samples_) {
+    mean_t += secs_since_start(sample.time);
+    mean_free += static_cast<double>(sample.free_bytes);
+  }
+  mean_t /= static_cast<double>(samples_.size());
+  mean_free /= static_cast<double>(samples_.size());
+  double covariance = 0;
+  double variance = 0;
+  for (const auto& sample : samples_) {
+    const double dt = secs_since_start(sample.time) - mean_t;
+    covariance += dt * (static_cast<double>(sample.free_bytes) - mean_free);
+    variance += dt * dt;
+  }
+  if (variance == 0) {
+    return std::nullopt;
+  }
+  const double bytes_per_sec = covariance / variance;
+  if (bytes_per_sec >= 0) {
+    return std::nullopt;
+  }
+
+  const uint64_t free_bytes = samples_.back().free_bytes;
+  if (free_bytes <= warning_free_bytes_) {
+    return zx::duration(0);
+  }
+  const double secs = static_cast<double>(free_bytes - warning_free_bytes_) / -bytes_per_sec;
+  if (secs >= static_cast<double>(zx::duration::infinite().to_secs())) {
+    return zx::duration::infinite();
+  }
+  return zx::duration(static_cast<zx_duration_t>(secs * ZX_SEC(1)));
+}
+
+}  // namespace monitor
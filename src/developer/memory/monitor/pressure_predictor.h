@@ -0,0 +1,66 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SRC_DEVELOPER_MEMORY_MONITOR_PRESSURE_PREDICTOR_H_
+#define SRC_DEVELOPER_MEMORY_MONITOR_PRESSURE_PREDICTOR_H_
+
+#include <lib/zx/time.h>
+#include <zircon/types.h>
+
+#include <deque>
+#include <optional>
+
+#include "src/developer/memory/monitor/pressure_observer.h"
+
+namespace monitor {
+
+// Predicts from the recent trend of free memory whether the kernel is about to signal the Warning
+// memory pressure level, so that watchers can be asked to shed memory before the system gets there.
+//
+// The kernel doesn't expose its pressure thresholds, so the free memory at which the Warning level
+// was last signalled is used as the threshold. Until it has been signalled, the kernel's default
+// threshold is assumed.
+class PressurePredictor {
+ public:
+  // The kernel's default for kernel.oom.warning-mb.
+  static constexpr uint64_t kDefaultWarningFreeBytes = 300 * 1024 * 1024;
+  // The number of most recent samples the trend is taken from.
+  static constexpr size_t kMaxSamples = 12;
+  // The number of samples needed before anything is predicted.
+  static constexpr size_t kMinSamples = 3;
+
+  // The Warning level is predicted when the trend reaches its threshold within |horizon|.
+  explicit PressurePredictor(zx::duration horizon);
+
+  // Records that |free_bytes| were free at |time|, and returns whether the Warning level is now
+  // predicted. Nothing is predicted unless the level is Normal.
+  bool AddSample(zx::time time, uint64_t free_bytes);
+
+  // Records that the kernel signalled |level| when |free_bytes| were free. The samples so far are
+  // forgotten, as they don't say anything about the trend at the new level.
+  void OnLevelChanged(Level level, uint64_t free_bytes);
+
+  bool warning_predicted() const { return warning_predicted_; }
+  uint64_t warning_free_bytes() const { return warning_free_bytes_; }
+
+  // Returns how long the trend of the samples takes to reach the Warning threshold, or
+  // std::nullopt if there are too few samples or free memory isn't falling.
+  std::optional<zx::duration> TimeToWarning() const;
+
+ private:
+  struct Sample {
+    zx::time time;
+    uint64_t free_bytes;
+  };
+
+  const zx::duration horizon_;
+  Level level_ = Level::kNormal;
+  uint64_t warning_free_bytes_ = kDefaultWarningFreeBytes;
+  std::deque<Sample> samples_;
+  bool warning_predicted_ = false;
+};
+
+}  // namespace monitor
+
+#endif  // SRC_DEVELOPER_MEMORY_MONITOR_PRESSURE_PREDICTOR_H_
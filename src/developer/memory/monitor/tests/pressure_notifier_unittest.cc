@@ -99,6 +99,11 @@ class PressureNotifierUnitTest : public fuchsia::memory::Debugger, public gtest:
     memdebug->SignalMemoryPressure(level);
   }
 
+  void SetWarningPredicted(bool predicted) {
+    notifier_->SetWarningPredicted(predicted);
+    RunLoopUntilIdle();
+  }
+
   void SetCrashReportInterval(uint32_t mins) {
     notifier_->critical_crash_report_interval_ = zx::min(mins);
   }
@@ -421,6 +426,42 @@ TEST_F(PressureNotifierUnitTest, DelayedWatcherDoesNotSeeImminentOOM) {
   ASSERT_EQ(watcher.LastLevel(), fmp::Level::CRITICAL);
 }
 
+TEST_F(PressureNotifierUnitTest, WatcherSeesPredictedWarning) {
+  PressureWatcherForTest watcher(true);
+
+  TriggerLevelChange(Level::kNormal);
+  watcher.Register(Provider());
+  RunLoopUntilIdle();
+  ASSERT_EQ(watcher.NumChanges(), 1);
+  ASSERT_EQ(watcher.LastLevel(), fmp::Level::NORMAL);
+
+  SetWarningPredicted(true);
+  ASSERT_EQ(watcher.NumChanges(), 2);
+  ASSERT_EQ(watcher.LastLevel(), fmp::Level::WARNING);
+  TriggerLevelChange(Level::kWarning);
+  ASSERT_EQ(watcher.NumChanges(), 3);
+  // The level the watcher sees doesn't change, so there is nothing new to tell it.
+  SetWarningPredicted(false);
+  ASSERT_EQ(watcher.NumChanges(), 3);
+  ASSERT_EQ(watcher.LastLevel(), fmp::Level::WARNING);
+
+  TriggerLevelChange(Level::kNormal);
+  ASSERT_EQ(watcher.NumChanges(), 4);
+  ASSERT_EQ(watcher.LastLevel(), fmp::Level::NORMAL);
+  // Predictions don't change higher levels.
+  TriggerLevelChange(Level::kCritical);
+  SetWarningPredicted(true);
+  ASSERT_EQ(watcher.NumChanges(), 5);
+  ASSERT_EQ(watcher.LastLevel(), fmp::Level::CRITICAL);
+
+  SetWarningPredicted(false);
+  TriggerLevelChange(Level::kNormal);
+  SetWarningPredicted(true);
+  SetWarningPredicted(false);
+  ASSERT_EQ(watcher.NumChanges(), 8);
+  ASSERT_EQ(watcher.LastLevel(), fmp::Level::NORMAL);
+}
+
 TEST_F(PressureNotifierUnitTest, CrashReportOnCritical) {
   ASSERT_EQ(num_crash_reports(), 0ul);
   ASSERT_TRUE(CanGenerateNewCriticalCrashReports());
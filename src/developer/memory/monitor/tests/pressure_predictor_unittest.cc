@@ -0,0 +1,93 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/developer/memory/monitor/pressure_predictor.h"
+
+#include <gtest/gtest.h>
+
+namespace monitor {
+namespace test {
+
+constexpr uint64_t kMiB = 1024 * 1024;
+constexpr zx::duration kHorizon = zx::sec(60);
+
+// Adds a sample every 10 seconds starting at |start|, with free memory falling from |free_bytes| by
+// |bytes_per_sample| each time. Returns whether the last sample predicted the Warning level.
+bool AddFallingSamples(PressurePredictor* predictor, zx::time start, uint64_t free_bytes,
+                       uint64_t bytes_per_sample, size_t count) {
+  bool predicted = false;
+  for (size_t i = 0; i < count; i++) {
+    predicted = predictor->AddSample(start + zx::sec(10) * i, free_bytes - i * bytes_per_sample);
+  }
+  return predicted;
+}
+
+TEST(PressurePredictorUnitTest, NeedsMinimumSamples) {
+  PressurePredictor predictor(kHorizon);
+  const uint64_t free_bytes = PressurePredictor::kDefaultWarningFreeBytes + 10 * kMiB;
+  EXPECT_FALSE(AddFallingSamples(&predictor, zx::time(0), free_bytes, 100 * kMiB,
+                                 PressurePredictor::kMinSamples - 1));
+  EXPECT_FALSE(predictor.TimeToWarning());
+}
+
+TEST(PressurePredictorUnitTest, PredictsFallingFreeMemory) {
+  PressurePredictor predictor(kHorizon);
+  // 1MiB/s falling, which reaches the default threshold 50 seconds after the last sample.
+  const uint64_t free_bytes = PressurePredictor::kDefaultWarningFreeBytes + 70 * kMiB;
+  EXPECT_TRUE(AddFallingSamples(&predictor, zx::time(0), free_bytes, 10 * kMiB, 3));
+  EXPECT_TRUE(predictor.warning_predicted());
+  ASSERT_TRUE(predictor.TimeToWarning());
+  EXPECT_EQ(zx::sec(50), *predictor.TimeToWarning());
+}
+
+TEST(PressurePredictorUnitTest, IgnoresSlowAndRisingTrends) {
+  PressurePredictor predictor(kHorizon);
+  // Reaches the threshold well beyond the horizon.
+  const uint64_t free_bytes = PressurePredictor::kDefaultWarningFreeBytes + 1000 * kMiB;
+  EXPECT_FALSE(AddFallingSamples(&predictor, zx::time(0), free_bytes, kMiB, 5));
+  ASSERT_TRUE(predictor.TimeToWarning());
+  EXPECT_GT(*predictor.TimeToWarning(), kHorizon);
+
+  PressurePredictor rising(kHorizon);
+  for (size_t i = 0; i < 5; i++) {
+    EXPECT_FALSE(rising.AddSample(zx::time(0) + zx::sec(10) * i,
+                                  PressurePredictor::kDefaultWarningFreeBytes + i * kMiB));
+  }
+  EXPECT_FALSE(rising.TimeToWarning());
+}
+
+TEST(PressurePredictorUnitTest, LearnsWarningThreshold) {
+  PressurePredictor predictor(kHorizon);
+  predictor.OnLevelChanged(Level::kWarning, 500 * kMiB);
+  EXPECT_EQ(500 * kMiB, predictor.warning_free_bytes());
+  // Nothing is predicted while the level isn't Normal.
+  EXPECT_FALSE(AddFallingSamples(&predictor, zx::time(0), 510 * kMiB, 10 * kMiB, 3));
+
+  // Only a change from Normal to Warning says where the threshold is.
+  predictor.OnLevelChanged(Level::kCritical, 100 * kMiB);
+  predictor.OnLevelChanged(Level::kWarning, 200 * kMiB);
+  predictor.OnLevelChanged(Level::kNormal, 700 * kMiB);
+  EXPECT_EQ(500 * kMiB, predictor.warning_free_bytes());
+
+  // The samples from before the level changed are forgotten.
+  EXPECT_FALSE(predictor.AddSample(zx::time(0) + zx::min(10), 540 * kMiB));
+  EXPECT_FALSE(predictor.TimeToWarning());
+  EXPECT_TRUE(AddFallingSamples(&predictor, zx::time(0) + zx::min(10) + zx::sec(10), 530 * kMiB,
+                                10 * kMiB, 3));
+}
+
+TEST(PressurePredictorUnitTest, UsesRecentSamplesOnly) {
+  PressurePredictor predictor(kHorizon);
+  const uint64_t free_bytes = PressurePredictor::kDefaultWarningFreeBytes + 70 * kMiB;
+  // A steep fall, followed by enough flat samples to push it out of the window.
+  EXPECT_TRUE(AddFallingSamples(&predictor, zx::time(0), free_bytes + 20 * kMiB, 10 * kMiB, 4));
+  for (size_t i = 0; i < PressurePredictor::kMaxSamples; i++) {
+    predictor.AddSample(zx::time(0) + zx::sec(40) + zx::sec(10) * i, free_bytes);
+  }
+  EXPECT_FALSE(predictor.warning_predicted());
+  EXPECT_FALSE(predictor.TimeToWarning());
+}
+
+}  // namespace test
+}  // namespace monitor
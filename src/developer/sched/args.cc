@@ -19,6 +19,8 @@ std::unique_ptr<cmdline::ArgsParser<CommandLineArgs>> GetParser() {
   auto parser = std::make_unique<cmdline::ArgsParser<CommandLineArgs>>();
   parser->AddSwitch("priority", 'p', "Run command at the given scheduler priority.",
                     &CommandLineArgs::priority);
+  parser->AddSwitch("stats", 's', "Print a stall summary when the command exits.",
+                    &CommandLineArgs::stats);
   parser->AddSwitch("verbose", 'v', "Add verbose logging.", &CommandLineArgs::verbose);
   parser->AddSwitch("help", 'h', "Show this help.", &CommandLineArgs::help);
   return parser;
@@ -36,6 +38,10 @@ Options:
   -p <priority>       Run command at the given scheduler priority.
                       Valid priorities are 0 to 31, inclusive.
 
+  -s                  Once the command exits, print how long its threads
+                      were running, runnable but not running, handling
+                      page faults, and waiting on kernel locks.
+
   -v                  Show verbose logging.
   --help              Show this help.
 )");
@@ -17,6 +17,9 @@ struct CommandLineArgs {
   // Desired priority.
   int priority = -1;
 
+  // Print a summary of the time the command spent stalled once it exits.
+  bool stats = false;
+
   // Verbose printing.
   bool verbose = false;
 
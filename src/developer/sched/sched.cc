@@ -12,6 +12,7 @@
 #include <lib/fdio/limits.h>
 #include <lib/fdio/spawn.h>
 #include <lib/sys/cpp/component_context.h>
+#include <lib/zx/clock.h>
 #include <stdio.h>
 #include <unistd.h>
 #include <zircon/status.h>
@@ -118,6 +119,30 @@ zx_status_t ApplyProfileToProcess(const zx::process& process, const zx::profile&
   return final_result;
 }
 
+std::string FormatRuntimeStats(const zx_info_task_runtime_t& runtime, zx_duration_t wall_time) {
+  const struct {
+    const char* name;
+    zx_duration_t time;
+  } kRows[] = {
+      {"running", runtime.cpu_time},
+      {"queued", runtime.queue_time},
+      {"page faults", runtime.page_fault_time},
+      {"lock contention", runtime.lock_contention_time},
+  };
+
+  std::string result;
+  for (const auto& row : kRows) {
+    double percent = wall_time > 0 ? 100.0 * static_cast<double>(row.time) /
+                                         static_cast<double>(wall_time)
+                                   : 0.0;
+    char line[80];
+    snprintf(line, sizeof(line), "%-16s %12.3f ms %7.2f%%\n", row.name,
+             static_cast<double>(row.time) / static_cast<double>(ZX_MSEC(1)), percent);
+    result += line;
+  }
+  return result;
+}
+
 int Run(int argc, const char** argv) {
   // Parse arguments.
   CommandLineArgs args = ParseArgsOrExit(argc, argv);
@@ -131,6 +156,7 @@ int Run(int argc, const char** argv) {
   }
 
   // Launch the given command.
+  zx::time start = zx::clock::get_monotonic();
   std::string error_message;
   zx::process process;
   result = Launch(ZX_HANDLE_INVALID, args.params, &process, &error_message);
@@ -157,6 +183,17 @@ int Run(int argc, const char** argv) {
     printf("Child process terminated.\n");
   }
 
+  if (args.stats) {
+    zx_duration_t wall_time = (zx::clock::get_monotonic() - start).get();
+    zx_info_task_runtime_t runtime;
+    result = process.get_info(ZX_INFO_TASK_RUNTIME, &runtime, sizeof(runtime), nullptr, nullptr);
+    if (result != ZX_OK) {
+      fprintf(stderr, "sched: Could not read child runtime: %s\n", zx_status_get_string(result));
+    } else {
+      printf("%s", FormatRuntimeStats(runtime, wall_time).c_str());
+    }
+  }
+
   return 0;
 }
 
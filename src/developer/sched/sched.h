@@ -11,6 +11,7 @@
 #include <zircon/status.h>
 
 #include <string>
+#include <vector>
 
 namespace sched {
 
@@ -27,6 +28,12 @@ zx_status_t Launch(zx_handle_t job, const std::vector<std::string>& args, zx::pr
 zx_status_t ApplyProfileToProcess(const zx::process& process, const zx::profile& profile,
                                   bool verbose);
 
+// Format a stall summary of |runtime| over a |wall_time| interval.
+//
+// Each of the running, queued (runnable but not running), page fault and lock contention times is
+// shown along with its share of |wall_time|, in the manner of Linux pressure stall information.
+std::string FormatRuntimeStats(const zx_info_task_runtime_t& runtime, zx_duration_t wall_time);
+
 // Run the main binary with the given command line args.
 int Run(int argc, const char** argv);
 
@@ -70,5 +70,19 @@ TEST(SchedTest, TestGoodLaunch) {
   EXPECT_TRUE(error_message.empty());
 }
 
+TEST(SchedTest, TestFormatRuntimeStats) {
+  zx_info_task_runtime_t runtime = {
+      .cpu_time = ZX_MSEC(50),
+      .queue_time = ZX_MSEC(25),
+      .page_fault_time = ZX_MSEC(10),
+      .lock_contention_time = 0,
+  };
+  EXPECT_EQ(FormatRuntimeStats(runtime, ZX_MSEC(100)),
+            "running                50.000 ms   50.00%\n"
+            "queued                 25.000 ms   25.00%\n"
+            "page faults            10.000 ms   10.00%\n"
+            "lock contention         0.000 ms    0.00%\n");
+}
+
 }  // namespace
 }  // namespace sched
@@ -13,6 +13,49 @@
 #include "src/devices/bin/driver_manager/v1/device_group_v1.h"
 #include "src/devices/lib/log/log.h"
 
+namespace {
+
+// Returns a string which is equal for two devices only if they have the same bind properties.
+// Strings are length-prefixed so that no two property sets produce the same key.
+std::string BindPropertiesKey(const Device& dev) {
+  std::string key = std::to_string(dev.protocol_id());
+  auto append_string = [&key](std::string_view str) {
+    key += ';';
+    key += std::to_string(str.size());
+    key += ':';
+    key += str;
+  };
+  for (const zx_device_prop_t& prop : dev.props()) {
+    key += ';';
+    key += std::to_string(prop.id);
+    key += '=';
+    key += std::to_string(prop.value);
+  }
+  for (const StrProperty& prop : dev.str_props()) {
+    append_string(prop.key);
+    key += ';';
+    key += std::to_string(prop.value.index());
+    switch (prop.value.index()) {
+      case StrPropValueType::Integer:
+        key += '=';
+        key += std::to_string(std::get<StrPropValueType::Integer>(prop.value));
+        break;
+      case StrPropValueType::String:
+        append_string(std::get<StrPropValueType::String>(prop.value));
+        break;
+      case StrPropValueType::Bool:
+        key += std::get<StrPropValueType::Bool>(prop.value) ? "=1" : "=0";
+        break;
+      case StrPropValueType::Enum:
+        append_string(std::get<StrPropValueType::Enum>(prop.value));
+        break;
+    }
+  }
+  return key;
+}
+
+}  // namespace
+
 BindDriverManager::BindDriverManager(Coordinator* coordinator, AttemptBindFunc attempt_bind)
     : coordinator_(coordinator), attempt_bind_(std::move(attempt_bind)) {}
 
@@ -192,7 +235,8 @@ zx::status<std::vector<MatchedDriver>> BindDriverManager::GetMatchingDrivers(
 }
 
 zx::status<std::vector<MatchedDriver>> BindDriverManager::MatchDeviceWithDriverIndex(
-    const fbl::RefPtr<Device>& dev, const DriverLoader::MatchDeviceConfig& config) const {
+    const fbl::RefPtr<Device>& dev, const DriverLoader::MatchDeviceConfig& config,
+    MatchCache* cache) const {
   if (dev->IsAlreadyBound()) {
     return zx::error(ZX_ERR_ALREADY_BOUND);
   }
@@ -205,12 +249,24 @@ zx::status<std::vector<MatchedDriver>> BindDriverManager::MatchDeviceWithDriverI
     return zx::error(ZX_ERR_NEXT);
   }
 
-  return zx::ok(coordinator_->driver_loader().MatchDeviceDriverIndex(dev, config));
+  if (!cache) {
+    return zx::ok(coordinator_->driver_loader().MatchDeviceDriverIndex(dev, config));
+  }
+
+  std::string key = BindPropertiesKey(*dev);
+  auto it = cache->find(key);
+  if (it == cache->end()) {
+    it = cache->emplace(std::move(key),
+                        coordinator_->driver_loader().MatchDeviceDriverIndex(dev, config))
+             .first;
+  }
+  return zx::ok(it->second);
 }
 
 zx_status_t BindDriverManager::MatchAndBindWithDriverIndex(
-    const fbl::RefPtr<Device>& dev, const DriverLoader::MatchDeviceConfig& config) {
-  auto result = MatchDeviceWithDriverIndex(dev, config);
+    const fbl::RefPtr<Device>& dev, const DriverLoader::MatchDeviceConfig& config,
+    MatchCache* cache) {
+  auto result = MatchDeviceWithDriverIndex(dev, config, cache);
   if (!result.is_ok()) {
     return result.error_value();
   }
@@ -239,9 +295,12 @@ void BindDriverManager::BindAllDevicesDriverIndex(const DriverLoader::MatchDevic
     return;
   }
 
+  // Boards often have many devices with identical properties, so only query the Driver Index
+  // once for each distinct set of properties during this pass.
+  MatchCache cache;
   for (auto& dev : coordinator_->device_manager()->devices()) {
     auto dev_ref = fbl::RefPtr(&dev);
-    zx_status_t status = MatchAndBindWithDriverIndex(dev_ref, config);
+    zx_status_t status = MatchAndBindWithDriverIndex(dev_ref, config, &cache);
     if (status == ZX_ERR_NEXT || status == ZX_ERR_ALREADY_BOUND) {
       continue;
     }
@@ -8,6 +8,9 @@
 #include <lib/ddk/device.h>
 
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "src/devices/bin/driver_manager/driver_loader.h"
 
@@ -66,13 +69,21 @@ class BindDriverManager {
   void set_attempt_bind(AttemptBindFunc attempt_bind) { attempt_bind_ = std::move(attempt_bind); }
 
  private:
-  // Find and return matching drivers for |dev| in the Driver Index.
+  // Driver Index matches keyed by the bind properties of the device they were found for. The
+  // Driver Index result depends only on the properties, so within a single pass over all devices,
+  // devices with the same properties need only query it once.
+  using MatchCache = std::unordered_map<std::string, std::vector<MatchedDriver>>;
+
+  // Find and return matching drivers for |dev| in the Driver Index. If |cache| is not null, it is
+  // used to look up and record the matches for |dev|'s properties.
   zx::status<std::vector<MatchedDriver>> MatchDeviceWithDriverIndex(
-      const fbl::RefPtr<Device>& dev, const DriverLoader::MatchDeviceConfig& config) const;
+      const fbl::RefPtr<Device>& dev, const DriverLoader::MatchDeviceConfig& config,
+      MatchCache* cache = nullptr) const;
 
   // Find matching drivers for |dev| through the Driver Index and then bind them.
   zx_status_t MatchAndBindWithDriverIndex(const fbl::RefPtr<Device>& dev,
-                                          const DriverLoader::MatchDeviceConfig& config);
+                                          const DriverLoader::MatchDeviceConfig& config,
+                                          MatchCache* cache = nullptr);
 
   // Binds the matched fragment in |driver| to |dev|. If a CompositeDevice for |driver| doesn't
   // exists in |driver_index_composite_devices_|, this function creates and adds it.
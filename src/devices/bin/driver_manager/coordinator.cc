@@ -473,6 +473,58 @@ zx_status_t Coordinator::GetTopologicalPath(const fbl::RefPtr<const Device>& dev
 }
 
 zx_status_t Coordinator::NewDriverHost(const char* name, fbl::RefPtr<DriverHost>* out) {
+  if (fbl::RefPtr<DriverHost> spare = std::move(spare_driver_host_); spare) {
+    zx_signals_t signals = 0;
+    spare->proc()->wait_one(ZX_PROCESS_TERMINATED, zx::time::infinite_past(), &signals);
+    if (!(signals & ZX_PROCESS_TERMINATED)) {
+      spare->proc()->set_property(ZX_PROP_NAME, name, strlen(name));
+      VLOGF(1, "Using spare driver_host %p for '%s'", spare.get(), name);
+      *out = std::move(spare);
+      PrestartDriverHost();
+      return ZX_OK;
+    }
+    LOGF(WARNING, "Spare driver_host %p exited, launching a new one", spare.get());
+  }
+
+  zx_status_t status = LaunchDriverHost(name, out);
+  if (status == ZX_OK) {
+    PrestartDriverHost();
+  }
+  return status;
+}
+
+void Coordinator::PrestartDriverHost() {
+  if (!config_.prestart_driver_host || spare_driver_host_ || prestart_pending_) {
+    return;
+  }
+  // Launch the spare after the current work, so that it is not on the critical path of the device
+  // that needs a driver_host now.
+  prestart_pending_ = true;
+  async::PostTask(dispatcher_, [this]() {
+    prestart_pending_ = false;
+    if (spare_driver_host_) {
+      return;
+    }
+    // Don't hold onto an idle process while the system is short on memory.
+    for (const zx::event& event : config_.memory_pressure_events) {
+      if (event.wait_one(ZX_EVENT_SIGNALED, zx::time::infinite_past(), nullptr) == ZX_OK) {
+        return;
+      }
+    }
+    zx_status_t status = LaunchDriverHost("driver_host:spare", &spare_driver_host_);
+    if (status != ZX_OK) {
+      LOGF(WARNING, "Failed to start spare driver_host: %s", zx_status_get_string(status));
+    }
+  });
+}
+
+void Coordinator::StopPrestartingDriverHosts() {
+  // The spare has no devices to suspend, so just let it go.
+  config_.prestart_driver_host = false;
+  spare_driver_host_.reset();
+}
+
+zx_status_t Coordinator::LaunchDriverHost(const char* name, fbl::RefPtr<DriverHost>* out) {
   std::string root_driver_path_arg;
   std::vector<const char*> env;
   if (driver_host_is_asan()) {
@@ -1061,6 +1113,7 @@ void Coordinator::UnregisterSystemStorageForShutdown(
 
 void Coordinator::SuspendWithoutExit(SuspendWithoutExitCompleter::Sync& completer) {
   LOGF(INFO, "Received administrator suspend event");
+  StopPrestartingDriverHosts();
   suspend_resume_manager()->Suspend(
       suspend_resume_manager()->GetSuspendFlagsFromSystemPowerState(shutdown_system_state()),
       [](zx_status_t status) {
@@ -31,6 +31,7 @@
 #include <memory>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include <fbl/auto_lock.h>
 #include <fbl/intrusive_double_list.h>
@@ -96,6 +97,10 @@ struct CoordinatorConfig {
   zx::job driver_host_job;
   // Event that is signaled by the kernel in OOM situation.
   zx::event oom_event;
+  // Events signaled by the kernel while memory pressure is at each level from warning up to out
+  // of memory. The kernel signals only the event for the current level, so all of them are needed
+  // to tell whether the system is above normal.
+  std::vector<zx::event> memory_pressure_events;
   // Client for the Arguments service.
   fidl::WireSyncClient<fuchsia_boot::Arguments>* boot_args;
   // Client for the DriverIndex.
@@ -118,6 +123,9 @@ struct CoordinatorConfig {
   std::string path_prefix = "/boot/";
   // The decision to make when we encounter a driver host crash.
   DriverHostCrashPolicy crash_policy = DriverHostCrashPolicy::kRestartDriverHost;
+  // Whether to keep a spare driver_host started ahead of time once the first one is needed, so
+  // that isolating a new device does not wait for a process launch.
+  bool prestart_driver_host = false;
 };
 
 class Coordinator : public CompositeManagerBridge,
@@ -238,6 +246,14 @@ class Coordinator : public CompositeManagerBridge,
 
   SuspendResumeManager* suspend_resume_manager() { return suspend_resume_manager_.get(); }
 
+  // Returns a new driver_host named |name|. This hands out the spare driver_host if there is one.
+  // This method is public only for the test suite.
+  zx_status_t NewDriverHost(const char* name, fbl::RefPtr<DriverHost>* out);
+  // Stops keeping a spare driver_host and releases the current one. Called when the system starts
+  // suspending.
+  void StopPrestartingDriverHosts();
+  const fbl::RefPtr<DriverHost>& spare_driver_host() const { return spare_driver_host_; }
+
   const Driver* fragment_driver() { return driver_loader_.LoadDriverUrl(GetFragmentDriverUrl()); }
 
   InspectManager& inspect_manager() { return *inspect_manager_; }
@@ -283,7 +299,10 @@ class Coordinator : public CompositeManagerBridge,
       UnregisterSystemStorageForShutdownCompleter::Sync& completer) override;
   void SuspendWithoutExit(SuspendWithoutExitCompleter::Sync& completer) override;
 
-  zx_status_t NewDriverHost(const char* name, fbl::RefPtr<DriverHost>* out);
+  zx_status_t LaunchDriverHost(const char* name, fbl::RefPtr<DriverHost>* out);
+  // Schedules starting a spare driver_host if configured, there is none, and the system is not
+  // under memory pressure.
+  void PrestartDriverHost();
 
   // Creates a DFv2 component with a given `url` and attaches it to `dev`.
   zx_status_t CreateAndStartDFv2Component(const Dfv2Driver& driver, const fbl::RefPtr<Device>& dev);
@@ -307,6 +326,11 @@ class Coordinator : public CompositeManagerBridge,
   // All DriverHosts
   fbl::DoublyLinkedList<DriverHost*> driver_hosts_;
 
+  // A started driver_host with no devices, handed out by the next NewDriverHost call. This must be
+  // declared after |driver_hosts_| since it unregisters itself on destruction.
+  fbl::RefPtr<DriverHost> spare_driver_host_;
+  bool prestart_pending_ = false;
+
   InspectManager* const inspect_manager_;
 
   fbl::RefPtr<Device> root_device_;
@@ -8,7 +8,8 @@
 #include "src/lib/loader_service/loader_service.h"
 
 // A loader service for driver_hosts that restricts access to dynamic libraries by applying an
-// allowlist, but then otherwise simply loads them from the given lib directory.
+// allowlist, but then otherwise simply loads them from the given lib directory. The lib directory
+// is immutable (/boot/lib), so loaded objects are cached and shared by all driver_hosts.
 class DriverHostLoaderService : public loader::LoaderService {
  public:
   static std::shared_ptr<DriverHostLoaderService> Create(async_dispatcher_t* dispatcher,
@@ -17,7 +18,7 @@ class DriverHostLoaderService : public loader::LoaderService {
 
  private:
   DriverHostLoaderService(async_dispatcher_t* dispatcher, fbl::unique_fd lib_fd, std::string name)
-      : LoaderService(dispatcher, std::move(lib_fd), std::move(name)) {}
+      : LoaderService(dispatcher, std::move(lib_fd), std::move(name), /*cache_objects=*/true) {}
 
   virtual zx::status<zx::vmo> LoadObjectImpl(std::string path) override;
 };
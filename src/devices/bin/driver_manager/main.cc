@@ -198,6 +198,7 @@ int main(int argc, char** argv) {
   config.fs_provider = &system_instance;
   config.path_prefix = "/boot/";
   config.crash_policy = driver_manager_params.crash_policy;
+  config.prestart_driver_host = true;
 
   // Waiting an infinite amount of time before falling back is effectively not
   // falling back at all.
@@ -234,6 +235,15 @@ int main(int argc, char** argv) {
     config.oom_event = zx::event(oom_event);
   }
 
+  for (zx_system_event_type_t kind :
+       {ZX_SYSTEM_EVENT_MEMORY_PRESSURE_WARNING, ZX_SYSTEM_EVENT_MEMORY_PRESSURE_CRITICAL,
+        ZX_SYSTEM_EVENT_IMMINENT_OUT_OF_MEMORY, ZX_SYSTEM_EVENT_OUT_OF_MEMORY}) {
+    zx_handle_t memory_pressure_event;
+    if (zx_system_get_event(root_job.get(), kind, &memory_pressure_event) == ZX_OK) {
+      config.memory_pressure_events.emplace_back(memory_pressure_event);
+    }
+  }
+
   async::Loop firmware_loop(&kAsyncLoopConfigNeverAttachToThread);
   firmware_loop.StartThread("firmware-loop");
 
@@ -0,0 +1,157 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <lib/async-loop/cpp/loop.h>
+#include <lib/async-loop/default.h>
+#include <lib/zx/event.h>
+#include <lib/zx/job.h>
+
+#include <optional>
+#include <vector>
+
+#include <zxtest/zxtest.h>
+
+#include "src/devices/bin/driver_manager/coordinator.h"
+#include "src/devices/bin/driver_manager/driver_host.h"
+#include "src/devices/bin/driver_manager/tests/coordinator_test_utils.h"
+
+namespace {
+
+// Hands out a live channel for each namespace entry, so that driver_host processes can be
+// launched. The server ends are held open for the lifetime of the provider.
+class ChannelFsProvider : public FsProvider {
+ public:
+  fidl::ClientEnd<fuchsia_io::Directory> CloneFs(const char* path) override {
+    auto endpoints = fidl::CreateEndpoints<fuchsia_io::Directory>();
+    ZX_ASSERT(endpoints.status_value() == ZX_OK);
+    servers_.push_back(std::move(endpoints->server));
+    return std::move(endpoints->client);
+  }
+
+ private:
+  std::vector<fidl::ServerEnd<fuchsia_io::Directory>> servers_;
+};
+
+class DriverHostPrestartTest : public zxtest::Test {
+ public:
+  void SetUp() override {
+    ASSERT_OK(boot_args_loop_.StartThread("mock-boot-args"));
+    ASSERT_OK(zx::job::create(*zx::job::default_job(), 0, &job_));
+    ASSERT_OK(zx::event::create(0, &memory_pressure_event_));
+  }
+
+  void TearDown() override {
+    coordinator_.reset();
+    job_.kill();
+    boot_args_loop_.Shutdown();
+  }
+
+  Coordinator& StartCoordinator() {
+    CoordinatorConfig config = DefaultConfig(boot_args_loop_.dispatcher(), &boot_args_, &client_);
+    config.fs_provider = &fs_provider_;
+    config.prestart_driver_host = true;
+    EXPECT_OK(job_.duplicate(ZX_RIGHT_SAME_RIGHTS, &config.driver_host_job));
+    zx::event event;
+    EXPECT_OK(memory_pressure_event_.duplicate(ZX_RIGHT_SAME_RIGHTS, &event));
+    config.memory_pressure_events.push_back(std::move(event));
+    coordinator_.emplace(std::move(config), &inspect_manager_, loop_.dispatcher(),
+                         loop_.dispatcher());
+    return *coordinator_;
+  }
+
+  async::Loop& loop() { return loop_; }
+  zx::event& memory_pressure_event() { return memory_pressure_event_; }
+
+ private:
+  async::Loop loop_{&kAsyncLoopConfigNoAttachToCurrentThread};
+  async::Loop boot_args_loop_{&kAsyncLoopConfigNoAttachToCurrentThread};
+  mock_boot_arguments::Server boot_args_;
+  fidl::WireSyncClient<fuchsia_boot::Arguments> client_;
+  ChannelFsProvider fs_provider_;
+  InspectManager inspect_manager_{loop_.dispatcher()};
+  zx::job job_;
+  zx::event memory_pressure_event_;
+  std::optional<Coordinator> coordinator_;
+};
+
+TEST_F(DriverHostPrestartTest, SpareIsHandedOut) {
+  Coordinator& coordinator = StartCoordinator();
+
+  fbl::RefPtr<DriverHost> first;
+  ASSERT_OK(coordinator.NewDriverHost("driver_host:first", &first));
+  // The spare is only started once the dispatcher gets to it.
+  EXPECT_NULL(coordinator.spare_driver_host());
+  loop().RunUntilIdle();
+  ASSERT_NOT_NULL(coordinator.spare_driver_host());
+  DriverHost* spare = coordinator.spare_driver_host().get();
+  EXPECT_NE(spare, first.get());
+
+  fbl::RefPtr<DriverHost> second;
+  ASSERT_OK(coordinator.NewDriverHost("driver_host:second", &second));
+  EXPECT_EQ(second.get(), spare);
+  char name[ZX_MAX_NAME_LEN];
+  ASSERT_OK(second->proc()->get_property(ZX_PROP_NAME, name, sizeof(name)));
+  EXPECT_STREQ(name, "driver_host:second");
+
+  // Handing out the spare schedules a replacement.
+  EXPECT_NULL(coordinator.spare_driver_host());
+  loop().RunUntilIdle();
+  ASSERT_NOT_NULL(coordinator.spare_driver_host());
+  EXPECT_NE(coordinator.spare_driver_host().get(), second.get());
+}
+
+TEST_F(DriverHostPrestartTest, ExitedSpareIsReplaced) {
+  Coordinator& coordinator = StartCoordinator();
+
+  fbl::RefPtr<DriverHost> first;
+  ASSERT_OK(coordinator.NewDriverHost("driver_host:first", &first));
+  loop().RunUntilIdle();
+  ASSERT_NOT_NULL(coordinator.spare_driver_host());
+  fbl::RefPtr<DriverHost> spare = coordinator.spare_driver_host();
+  ASSERT_OK(spare->proc()->kill());
+  ASSERT_OK(spare->proc()->wait_one(ZX_PROCESS_TERMINATED, zx::time::infinite(), nullptr));
+
+  fbl::RefPtr<DriverHost> second;
+  ASSERT_OK(coordinator.NewDriverHost("driver_host:second", &second));
+  EXPECT_NE(second.get(), spare.get());
+  zx_signals_t signals = 0;
+  second->proc()->wait_one(ZX_PROCESS_TERMINATED, zx::time::infinite_past(), &signals);
+  EXPECT_FALSE(signals & ZX_PROCESS_TERMINATED);
+}
+
+TEST_F(DriverHostPrestartTest, NoSpareUnderMemoryPressure) {
+  Coordinator& coordinator = StartCoordinator();
+  ASSERT_OK(memory_pressure_event().signal(0, ZX_EVENT_SIGNALED));
+
+  fbl::RefPtr<DriverHost> first;
+  ASSERT_OK(coordinator.NewDriverHost("driver_host:first", &first));
+  loop().RunUntilIdle();
+  EXPECT_NULL(coordinator.spare_driver_host());
+
+  // Once the pressure is gone, the next driver_host brings the spare back.
+  ASSERT_OK(memory_pressure_event().signal(ZX_EVENT_SIGNALED, 0));
+  fbl::RefPtr<DriverHost> second;
+  ASSERT_OK(coordinator.NewDriverHost("driver_host:second", &second));
+  loop().RunUntilIdle();
+  EXPECT_NOT_NULL(coordinator.spare_driver_host());
+}
+
+TEST_F(DriverHostPrestartTest, NoSpareAfterSuspend) {
+  Coordinator& coordinator = StartCoordinator();
+
+  fbl::RefPtr<DriverHost> first;
+  ASSERT_OK(coordinator.NewDriverHost("driver_host:first", &first));
+  loop().RunUntilIdle();
+  ASSERT_NOT_NULL(coordinator.spare_driver_host());
+
+  coordinator.StopPrestartingDriverHosts();
+  EXPECT_NULL(coordinator.spare_driver_host());
+
+  fbl::RefPtr<DriverHost> second;
+  ASSERT_OK(coordinator.NewDriverHost("driver_host:second", &second));
+  loop().RunUntilIdle();
+  EXPECT_NULL(coordinator.spare_driver_host());
+}
+
+}  // namespace
@@ -6,6 +6,23 @@
 
 #include <fbl/ref_ptr.h>
 
+#include "src/devices/bin/driver_runtime/recycler.h"
+
+namespace {
+
+using ArenaRecycler = driver_runtime::Recycler<sizeof(fdf_arena), 16>;
+
+}  // namespace
+
+// static
+void* fdf_arena::operator new(size_t size) noexcept {
+  ZX_DEBUG_ASSERT(size == sizeof(fdf_arena));
+  return ArenaRecycler::Allocate();
+}
+
+// static
+void fdf_arena::operator delete(void* ptr) { ArenaRecycler::Free(ptr); }
+
 // static
 zx_status_t fdf_arena::Create(uint32_t options, uint32_t tag, fdf_arena** out_arena) {
   auto arena = fbl::AdoptRef(new fdf_arena(tag));
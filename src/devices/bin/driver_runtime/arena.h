@@ -28,6 +28,11 @@ struct fdf_arena : public fbl::RefCounted<fdf_arena> {
   void Free(void* data);
   void Destroy();
 
+  // Arenas are usually created and destroyed for every message, so the storage of destroyed
+  // arenas is kept in a per-thread cache for reuse. Extra blocks are still freed on destruction.
+  static void* operator new(size_t size) noexcept;
+  static void operator delete(void* ptr);
+
  private:
   // Size of the buffer allocated on construction of the arena.
   static constexpr size_t kInitialBufferSize = 4ull * 1024;
@@ -95,3 +95,22 @@ TEST(fdf_arena, InitialBufferContains) {
 
   arena->Destroy();
 }
+
+TEST(fdf_arena, Recycled) {
+  fdf_arena* arena;
+  ASSERT_EQ(ZX_OK, fdf_arena::Create(0, 'AREN', &arena));
+  void* addr1 = arena->Allocate(0x500);
+  EXPECT_NOT_NULL(addr1);
+  void* addr2 = arena->Allocate(0x10000);
+  EXPECT_NOT_NULL(addr2);
+  arena->Destroy();
+
+  // A new arena may reuse the storage of the destroyed one, but starts out empty.
+  ASSERT_EQ(ZX_OK, fdf_arena::Create(0, 'AREN', &arena));
+  EXPECT_FALSE(arena->Contains(addr2, 0x10000));
+  void* addr3 = arena->Allocate(0x100);
+  EXPECT_NOT_NULL(addr3);
+  EXPECT_TRUE(arena->Contains(addr3, 0x100));
+  EXPECT_FALSE(arena->Contains(increment_ptr(addr3, 0x100), 0x100));
+  arena->Destroy();
+}
@@ -1047,6 +1047,18 @@ void Dispatcher::DispatchCallbacks(std::unique_ptr<EventWaiter> event_waiter,
                                    fbl::RefPtr<Dispatcher> dispatcher_ref) {
   ZX_ASSERT(dispatcher_ref != nullptr);
 
+  // Only threads of the process shared loop are tracked, as tests may inject their own loop.
+  DispatcherCoordinator& coordinator = GetDispatcherCoordinator();
+  const bool shared_loop = process_shared_dispatcher_ == coordinator.loop()->dispatcher();
+  if (shared_loop) {
+    coordinator.OnThreadBusy();
+  }
+  auto idle = fit::defer([&]() {
+    if (shared_loop) {
+      coordinator.OnThreadIdle();
+    }
+  });
+
   auto defer = fit::defer([&]() {
     fbl::AutoLock lock(&callback_lock_);
 
@@ -1066,6 +1078,7 @@ void Dispatcher::DispatchCallbacks(std::unique_ptr<EventWaiter> event_waiter,
   });
 
   fbl::DoublyLinkedList<std::unique_ptr<CallbackRequest>> to_call;
+  bool backlog = false;
   {
     fbl::AutoLock lock(&callback_lock_);
     num_active_threads_++;
@@ -1109,9 +1122,17 @@ void Dispatcher::DispatchCallbacks(std::unique_ptr<EventWaiter> event_waiter,
       if (status == ZX_ERR_BAD_STATE) {
         event_waiter_ = nullptr;
       }
+      backlog = true;
     }
   }
 
+  // If all threads are busy, the callbacks left in the queue would wait for one of them to
+  // finish, so grow the thread pool instead. This is done outside of |callback_lock_| as the
+  // coordinator lock must not be acquired while holding it.
+  if (backlog && shared_loop) {
+    coordinator.OnDispatcherBacklog();
+  }
+
   // Call the callbacks outside of the lock.
   while (!to_call.is_empty()) {
     auto callback_request = to_call.pop_front();
@@ -1502,10 +1523,7 @@ void DispatcherCoordinator::OnThreadWakeup(uint32_t thread_irq_generation_id,
 zx_status_t DispatcherCoordinator::AddThread() {
   fbl::AutoLock lock(&lock_);
   dispatcher_threads_needed_++;
-  // TODO(surajmalhotra): We are clamping number_threads_ to 10 to avoid spawning too many threads.
-  // Technically this can result in a deadlock scenario in a very complex driver host. We need
-  // better support for dynamically starting threads as necessary.
-  if (number_threads_ >= dispatcher_threads_needed_ || number_threads_ == 10) {
+  if (number_threads_ >= dispatcher_threads_needed_ || number_threads_ >= kMaxThreads) {
     return ZX_OK;
   }
   auto name = "fdf-dispatcher-thread-" + std::to_string(number_threads_);
@@ -1516,6 +1534,19 @@ zx_status_t DispatcherCoordinator::AddThread() {
   return status;
 }
 
+void DispatcherCoordinator::OnDispatcherBacklog() {
+  fbl::AutoLock lock(&lock_);
+  if (busy_threads_.load(std::memory_order_relaxed) < number_threads_ ||
+      number_threads_ >= kMaxThreads) {
+    // An idle thread will pick up the work.
+    return;
+  }
+  auto name = "fdf-dispatcher-thread-" + std::to_string(number_threads_);
+  if (loop_.StartThread(name.c_str()) == ZX_OK) {
+    number_threads_++;
+  }
+}
+
 void DispatcherCoordinator::Reset() {
   {
     fbl::AutoLock al(&lock_);
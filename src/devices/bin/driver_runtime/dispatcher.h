@@ -19,6 +19,7 @@
 #include <zircon/compiler.h>
 #include <zircon/types.h>
 
+#include <atomic>
 #include <unordered_set>
 #include <vector>
 
@@ -578,6 +579,15 @@ class DispatcherCoordinator {
                              uint32_t* out_cur_irq_generation_id);
   zx_status_t AddThread();
 
+  // Called by an unsynchronized dispatcher backed by |loop_| which has more queued callbacks than
+  // the current thread will process. Starts another thread if every thread is already busy
+  // running callbacks, up to |kMaxThreads|.
+  void OnDispatcherBacklog();
+
+  // Track the number of |loop_| threads currently running dispatcher callbacks.
+  void OnThreadBusy() { busy_threads_.fetch_add(1, std::memory_order_relaxed); }
+  void OnThreadIdle() { busy_threads_.fetch_sub(1, std::memory_order_relaxed); }
+
   // Resets back down to 1 thread.
   // Must only be called when there are no outstanding dispatchers.
   // Must not be called from within a driver_runtime managed thread as that will result in a
@@ -732,8 +742,16 @@ class DispatcherCoordinator {
   // Notified when all drivers are destroyed.
   fbl::ConditionVariable drivers_destroyed_event_ __TA_GUARDED(&lock_);
 
+  // TODO(surajmalhotra): We are clamping number_threads_ to 10 to avoid spawning too many threads.
+  // Technically this can result in a deadlock scenario in a very complex driver host. We need
+  // better support for dynamically starting threads as necessary.
+  static constexpr uint32_t kMaxThreads = 10;
+
   // Tracks the number of threads we've spawned via |loop_|.
   uint32_t number_threads_ __TA_GUARDED(&lock_) = 1;
+  // The number of threads currently running dispatcher callbacks. This is not locked so that
+  // threads do not contend on |lock_| for every wakeup.
+  std::atomic<uint32_t> busy_threads_ = 0;
   // Tracks the number of dispatchers which have sync calls allowed. We will only spawn additional
   // threads if this number exceeds |number_threads_|.
   uint32_t dispatcher_threads_needed_ __TA_GUARDED(&lock_) = 1;
@@ -8,9 +8,17 @@
 
 #include "src/devices/bin/driver_runtime/arena.h"
 #include "src/devices/bin/driver_runtime/handle.h"
+#include "src/devices/bin/driver_runtime/recycler.h"
 
 namespace driver_runtime {
 
+namespace {
+
+// Message packets for messages without an arena are recycled per thread.
+using MessagePacketRecycler = Recycler<sizeof(MessagePacket), 16>;
+
+}  // namespace
+
 // static
 MessagePacketOwner MessagePacket::Create(fbl::RefPtr<fdf_arena> arena, void* data,
                                          uint32_t num_bytes, zx_handle_t* handles,
@@ -20,7 +28,7 @@ MessagePacketOwner MessagePacket::Create(fbl::RefPtr<fdf_arena> arena, void* dat
     message_packet = arena->Allocate(sizeof(MessagePacket));
   } else {
     // The user wrote an empty message that did not provide an arena.
-    message_packet = calloc(1, sizeof(MessagePacket));
+    message_packet = MessagePacketRecycler::Allocate();
   }
   if (!message_packet) {
     return nullptr;
@@ -39,8 +47,7 @@ void MessagePacket::Delete(MessagePacket* message_packet) {
 
   if (!arena) {
     // The user wrote an empty message that did not provide an arena.
-    // TODO(fxbug.dev/86856): we should consider recycling deleted packets.
-    free(message_packet);
+    MessagePacketRecycler::Free(message_packet);
   }
 }
 
@@ -32,6 +32,20 @@ bool ArenaAllocFreeTest(perftest::RepeatState* state, size_t buffer_size) {
   return true;
 }
 
+// Measure the time taken to create an arena, allocate a |buffer_size|-byte block from it and
+// destroy it, as is done for each message written to a channel.
+bool ArenaCreateDestroyTest(perftest::RepeatState* state, size_t buffer_size) {
+  constexpr uint32_t kTag = 'BNCH';
+
+  while (state->KeepRunning()) {
+    fdf::Arena arena(kTag);
+    if (!arena.Allocate(buffer_size)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 // Measure the time taken to check whether a block is contained in an arena
 // which holds |num_blocks|.
 bool ArenaContainsTest(perftest::RepeatState* state, uint32_t num_blocks) {
@@ -63,6 +77,8 @@ void RegisterTests() {
   for (auto block_size : kBlockSize) {
     auto alloc_free_name = fbl::StringPrintf("Arena/AllocFree/%ubytes", block_size);
     perftest::RegisterTest(alloc_free_name.c_str(), ArenaAllocFreeTest, block_size);
+    auto create_destroy_name = fbl::StringPrintf("Arena/CreateDestroy/%ubytes", block_size);
+    perftest::RegisterTest(create_destroy_name.c_str(), ArenaCreateDestroyTest, block_size);
   }
 
   static const unsigned kNumBlocks[] = {
@@ -0,0 +1,59 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SRC_DEVICES_BIN_DRIVER_RUNTIME_RECYCLER_H_
+#define SRC_DEVICES_BIN_DRIVER_RUNTIME_RECYCLER_H_
+
+#include <cstddef>
+#include <new>
+
+namespace driver_runtime {
+
+// Thread-local cache of freed memory blocks of |kSize| bytes, so that objects which are created and
+// destroyed for every message, such as arenas, do not go to the heap each time.
+// Up to |kMaxCached| freed blocks are kept per thread. A block may be freed on a different thread
+// than allocated it, in which case it is cached by the freeing thread.
+template <size_t kSize, size_t kMaxCached>
+class Recycler {
+ public:
+  // Returns a block of |kSize| bytes, or nullptr if out of memory.
+  static void* Allocate() {
+    Cache& cache = cache_;
+    if (cache.count > 0) {
+      return cache.blocks[--cache.count];
+    }
+    return ::operator new(kSize, std::nothrow);
+  }
+
+  // Returns a block obtained from |Allocate| to the cache of the calling thread.
+  static void Free(void* block) {
+    Cache& cache = cache_;
+    if (cache.count < kMaxCached) {
+      cache.blocks[cache.count++] = block;
+    } else {
+      ::operator delete(block);
+    }
+  }
+
+ private:
+  struct Cache {
+    ~Cache() {
+      while (count > 0) {
+        ::operator delete(blocks[--count]);
+      }
+    }
+
+    void* blocks[kMaxCached];
+    size_t count = 0;
+  };
+
+  static thread_local Cache cache_;
+};
+
+template <size_t kSize, size_t kMaxCached>
+thread_local typename Recycler<kSize, kMaxCached>::Cache Recycler<kSize, kMaxCached>::cache_;
+
+}  // namespace driver_runtime
+
+#endif  // SRC_DEVICES_BIN_DRIVER_RUNTIME_RECYCLER_H_
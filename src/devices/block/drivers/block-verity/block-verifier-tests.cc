@@ -193,6 +193,17 @@ TEST_F(BlockVerifierTestFixture, CorruptedDataBlockFails) {
   }
 }
 
+TEST_F(BlockVerifierTestFixture, CorruptedDataBlockFailsAfterItsIntegrityBlockIsVerified) {
+  // Once the integrity blocks covering a data block have been verified, the
+  // data block itself still has to match.
+  uint8_t non_zero_block[block_verity::kBlockSize] = {0x01};
+  for (uint64_t data_index = 0; data_index < kDataBlocks; data_index++) {
+    EXPECT_OK(bv_.VerifyDataBlockSync(data_index, kZeroBlock));
+    EXPECT_EQ(ZX_ERR_IO_DATA_INTEGRITY, bv_.VerifyDataBlockSync(data_index, non_zero_block));
+    EXPECT_OK(bv_.VerifyDataBlockSync(data_index, kZeroBlock));
+  }
+}
+
 TEST(BlockVerifierTest, CorruptRootHashFailsAllBlocks) {
   async::Loop loop(&kAsyncLoopConfigAttachToCurrentThread);
   TestBlockLoader bl;
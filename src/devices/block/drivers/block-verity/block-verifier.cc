@@ -68,6 +68,8 @@ zx_status_t BlockVerifier::PrepareAsync(void* cookie, BlockVerifierCallback call
     integrity_block_base_ = reinterpret_cast<const uint8_t*>(address);
     cleanup.cancel();
 
+    verified_integrity_blocks_.assign(
+        geometry_.allocation_.integrity_shape.integrity_block_count, false);
     cookie_ = cookie;
     callback_ = callback;
     state_ = kLoading;
@@ -112,6 +114,25 @@ const uint8_t* BlockVerifier::MemoryLocationForBlock(IntegrityBlockIndex i) cons
   return integrity_block_base_ + offset;
 }
 
+bool BlockVerifier::IsIntegrityBlockVerified(IntegrityBlockIndex i) {
+  fbl::AutoLock lock(&mtx_);
+  return verified_integrity_blocks_[i];
+}
+
+void BlockVerifier::MarkIntegrityBlocksVerified(HashLocation leaf) {
+  fbl::AutoLock lock(&mtx_);
+  HashLocation location = leaf;
+  uint32_t distance_from_leaf = 0;
+  while (!verified_integrity_blocks_[location.integrity_block]) {
+    verified_integrity_blocks_[location.integrity_block] = true;
+    if (distance_from_leaf == geometry_.allocation_.integrity_shape.tree_depth - 1) {
+      break;
+    }
+    location = geometry_.NextIntegrityBlockUp(distance_from_leaf, location.integrity_block);
+    distance_from_leaf++;
+  }
+}
+
 zx_status_t BlockVerifier::VerifyDataBlockSync(uint64_t data_block_index,
                                                const uint8_t* block_data) {
   {
@@ -133,11 +154,15 @@ zx_status_t BlockVerifier::VerifyDataBlockSync(uint64_t data_block_index,
     return ZX_ERR_IO_DATA_INTEGRITY;
   }
 
-  // Future performance improvement: make this cache successfully-hashed
-  // indirect integrity blocks rather than rehashing to the root every time.
+  // Chain up the tree until reaching an integrity block which has already been
+  // checked against the root.
   uint32_t distance_from_leaf = 0;
   HashLocation previous = leaf_hash_location;
   while (distance_from_leaf < geometry_.allocation_.integrity_shape.tree_depth - 1) {
+    if (IsIntegrityBlockVerified(previous.integrity_block)) {
+      return ZX_OK;
+    }
+
     // Get address of containing block.  Hash it.
     const uint8_t* containing_block = MemoryLocationForBlock(previous.integrity_block);
     hasher.Hash(containing_block, kBlockSize);
@@ -158,12 +183,15 @@ zx_status_t BlockVerifier::VerifyDataBlockSync(uint64_t data_block_index,
   ZX_ASSERT(previous.integrity_block ==
             geometry_.allocation_.integrity_shape.integrity_block_count - 1);
 
-  const uint8_t* root_integrity_block = MemoryLocationForBlock(previous.integrity_block);
-  hasher.Hash(root_integrity_block, kBlockSize);
-  if (!hasher.Equals(root_hash_.data(), kHashOutputSize)) {
-    return ZX_ERR_IO_DATA_INTEGRITY;
+  if (!IsIntegrityBlockVerified(previous.integrity_block)) {
+    const uint8_t* root_integrity_block = MemoryLocationForBlock(previous.integrity_block);
+    hasher.Hash(root_integrity_block, kBlockSize);
+    if (!hasher.Equals(root_hash_.data(), kHashOutputSize)) {
+      return ZX_ERR_IO_DATA_INTEGRITY;
+    }
   }
 
+  MarkIntegrityBlocksVerified(leaf_hash_location);
   return ZX_OK;
 }
 
@@ -6,6 +6,7 @@
 #define SRC_DEVICES_BLOCK_DRIVERS_BLOCK_VERITY_BLOCK_VERIFIER_H_
 
 #include <array>
+#include <vector>
 
 #include <fbl/auto_lock.h>
 
@@ -50,7 +51,7 @@ class BlockVerifier final {
   // Actually do the hashing to determine if the kBlockSize bytes of data
   // pointed to by block_data correctly represent the contents of data block
   // `block_index`.  In the future, it might make sense to move to async
-  // block verification.
+  // block verification.  Safe to call from several threads at once.
   zx_status_t VerifyDataBlockSync(uint64_t data_block_index, const uint8_t* block_data)
       __TA_EXCLUDES(&mtx_);
 
@@ -72,6 +73,14 @@ class BlockVerifier final {
   // be found mapped into the current address space.
   const uint8_t* MemoryLocationForBlock(IntegrityBlockIndex i) const;
 
+  // Returns true if integrity block `i` has already been checked all the way
+  // up to the root hash.
+  bool IsIntegrityBlockVerified(IntegrityBlockIndex i) __TA_EXCLUDES(&mtx_);
+
+  // Records that every integrity block on the path from `leaf` up to the first
+  // one which was already verified has now been checked against the root hash.
+  void MarkIntegrityBlocksVerified(HashLocation leaf) __TA_EXCLUDES(&mtx_);
+
   enum BlockVerifierState {
     // State on construction.
     kInitial,
@@ -108,6 +117,12 @@ class BlockVerifier final {
   // look at all integrity data in a flat array.
   const uint8_t* integrity_block_base_;
 
+  // Which integrity blocks are known to chain up to the root hash.  The
+  // integrity data is never modified once it's loaded, so a data block only
+  // has to be checked against the hashes up to the first verified block.
+  // Takes one bit per integrity block, so it's never worth evicting from.
+  std::vector<bool> verified_integrity_blocks_ __TA_GUARDED(mtx_);
+
   // Args to `PrepareAsync` that we save so we can call them back later,
   // possibly across an async boundary.
   void* cookie_;
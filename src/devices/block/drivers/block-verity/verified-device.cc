@@ -5,9 +5,13 @@
 #include "src/devices/block/drivers/block-verity/verified-device.h"
 
 #include <lib/ddk/debug.h>
+#include <lib/fit/defer.h>
+#include <lib/zx/vmar.h>
 #include <lib/zx/vmo.h>
 #include <zircon/status.h>
+#include <zircon/syscalls.h>
 
+#include <fbl/algorithm.h>
 #include <fbl/auto_lock.h>
 
 #include "src/devices/block/drivers/block-verity/constants.h"
@@ -217,9 +221,6 @@ void VerifiedDevice::ForwardTranslatedBlockOp(block_op_t* block_op) {
 }
 
 void VerifiedDevice::OnClientBlockRequestComplete(zx_status_t status, block_op_t* block) {
-  fbl::AutoLock lock(&mtx_);
-  outstanding_block_requests_--;
-
   // Restore data that may have changed
   extra_op_t* extra = BlockToExtra(block, info_.op_size);
   block->rw.vmo = extra->vmo;
@@ -229,33 +230,55 @@ void VerifiedDevice::OnClientBlockRequestComplete(zx_status_t status, block_op_t
 
   if (status != ZX_OK) {
     zxlogf(DEBUG, "parent device returned %s", zx_status_get_string(status));
-    BlockComplete(block, status);
-    return;
+  } else {
+    // Verification doesn't need the lock, so that reads which complete on
+    // different threads are verified in parallel.  The request still counts as
+    // outstanding until it's done, which keeps teardown waiting for it.
+    status = VerifyReadData(block);
   }
 
+  fbl::AutoLock lock(&mtx_);
+  outstanding_block_requests_--;
+  BlockComplete(block, status);
+}
+
+zx_status_t VerifiedDevice::VerifyReadData(const block_op_t* block) {
+  if (block->rw.length == 0) {
+    return ZX_OK;
+  }
+
+  // Map the whole range that was read once, rather than copying it out one
+  // block at a time.
+  const uint64_t page_size = zx_system_get_page_size();
+  const uint64_t offset = block->rw.offset_vmo * kBlockSize;
+  const uint64_t mapping_offset = fbl::round_down(offset, page_size);
+  const uint64_t mapping_length =
+      fbl::round_up(offset + uint64_t{block->rw.length} * kBlockSize, page_size) - mapping_offset;
+  zx_vaddr_t address;
+  zx_status_t status =
+      zx::vmar::root_self()->map(ZX_VM_PERM_READ, 0, *zx::unowned_vmo(block->rw.vmo),
+                                 mapping_offset, mapping_length, &address);
+  if (status != ZX_OK) {
+    zxlogf(WARNING, "Couldn't map VMO to verify block data: %s", zx_status_get_string(status));
+    return status;
+  }
+  auto unmap = fit::defer(
+      [address, mapping_length]() { zx::vmar::root_self()->unmap(address, mapping_length); });
+
   // Verify each block that we read against the hash from the integrity data.
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(address) + (offset - mapping_offset);
   for (uint32_t block_offset = 0; block_offset < block->rw.length; block_offset++) {
-    uint8_t buf[kBlockSize];
-    off_t vmo_offset = extra->offset_vmo + (block_offset * kBlockSize);
-    status = zx_vmo_read(extra->vmo, buf, vmo_offset, kBlockSize);
-    if (status != ZX_OK) {
-      zxlogf(WARNING, "Couldn't read from VMO to verify block data: %s",
-             zx_status_get_string(status));
-      BlockComplete(block, status);
-      return;
-    }
-
     // Check integrity of the block with BlockVerifier.
     // The offset given is the index into the data block section.
-    uint64_t data_block_index = extra->offset_dev + block_offset;
-    status = block_verifier_.VerifyDataBlockSync(data_block_index, buf);
+    uint64_t data_block_index = block->rw.offset_dev + block_offset;
+    status =
+        block_verifier_.VerifyDataBlockSync(data_block_index, data + block_offset * kBlockSize);
     if (status != ZX_OK) {
-      BlockComplete(block, status);
-      return;
+      return status;
     }
   }
 
-  BlockComplete(block, ZX_OK);
+  return ZX_OK;
 }
 
 void VerifiedDevice::OnBlockVerifierPrepareComplete(zx_status_t status) {
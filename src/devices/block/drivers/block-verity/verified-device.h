@@ -74,7 +74,7 @@ class VerifiedDevice final : public VerifiedDeviceType,
   // The callback that we give to the underlying block device when we queue
   // operations against it.  It simply translates block offsets back and completes the
   // matched block requests.
-  void OnClientBlockRequestComplete(zx_status_t status, block_op_t* block);
+  void OnClientBlockRequestComplete(zx_status_t status, block_op_t* block) __TA_EXCLUDES(mtx_);
 
   // Callback for `BlockVerifier::PrepareAsync`
   void OnBlockVerifierPrepareComplete(zx_status_t status);
@@ -86,6 +86,10 @@ class VerifiedDevice final : public VerifiedDeviceType,
  private:
   void ForwardTranslatedBlockOp(block_op_t* block_op) __TA_REQUIRES(mtx_);
 
+  // Checks the data read by the completed client request `block` against the
+  // integrity data.
+  zx_status_t VerifyReadData(const block_op_t* block) __TA_EXCLUDES(mtx_);
+
   // Completes the UnbindTxn if outstanding_block_requests_ has gone to 0.
   void TeardownIfQuiesced() __TA_REQUIRES(mtx_);
 
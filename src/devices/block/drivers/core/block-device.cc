@@ -401,7 +401,8 @@ zx_status_t BlockDevice::Bind(void* ctx, zx_device_t* dev) {
 
   // We implement |ZX_PROTOCOL_BLOCK|, not |ZX_PROTOCOL_BLOCK_IMPL|. This is the
   // "core driver" protocol for block device drivers.
-  status = bdev->DdkAdd("block");
+  status = bdev->DdkAdd(
+      ddk::DeviceAddArgs("block").set_inspect_vmo(bdev->inspect_.DuplicateVmo()));
   if (status != ZX_OK) {
     return status;
   }
@@ -14,6 +14,7 @@
 #include <lib/ddk/driver.h>
 #include <lib/ddk/metadata.h>
 #include <lib/fidl-utils/bind.h>
+#include <lib/inspect/cpp/inspect.h>
 #include <lib/operation/block.h>
 #include <lib/zircon-internal/thread_annotations.h>
 #include <lib/zx/fifo.h>
@@ -62,7 +63,8 @@ class BlockDevice : public BlockDeviceType,
       : BlockDeviceType(parent),
         parent_protocol_(parent),
         parent_partition_protocol_(parent),
-        parent_volume_protocol_(parent) {
+        parent_volume_protocol_(parent),
+        manager_(inspect_.GetRoot().CreateChild("fifo-sessions")) {
     block_protocol_t self{&block_protocol_ops_, this};
     self_protocol_ = ddk::BlockProtocolClient(&self);
   }
@@ -189,6 +191,8 @@ class BlockDevice : public BlockDeviceType,
   // True if we have metadata for a ZBI partition map.
   bool has_bootpart_ = false;
 
+  inspect::Inspector inspect_;
+
   // Manages the background FIFO server.
   Manager manager_;
 
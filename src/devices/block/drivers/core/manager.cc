@@ -12,6 +12,8 @@
 
 Manager::Manager() = default;
 
+Manager::Manager(inspect::Node inspect_root) : inspect_root_(std::move(inspect_root)) {}
+
 Manager::~Manager() { CloseFifoServer(); }
 
 bool Manager::IsFifoServerRunning() {
@@ -45,7 +47,9 @@ zx_status_t Manager::StartServer(zx_device_t* device, ddk::BlockProtocolClient*
   ZX_DEBUG_ASSERT(server_ == nullptr);
   std::unique_ptr<Server> server;
   fzl::fifo<block_fifo_request_t, block_fifo_response_t> fifo;
-  zx_status_t status = Server::Create(protocol, &fifo, &server);
+  Server::Options options;
+  options.inspect_node = inspect_root_.CreateChild(inspect_root_.UniqueName("session-"));
+  zx_status_t status = Server::Create(protocol, &fifo, &server, std::move(options));
   if (status != ZX_OK) {
     return status;
   }
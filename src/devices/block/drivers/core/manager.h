@@ -6,6 +6,7 @@
 #define SRC_DEVICES_BLOCK_DRIVERS_CORE_MANAGER_H_
 
 #include <fuchsia/hardware/block/cpp/banjo.h>
+#include <lib/inspect/cpp/inspect.h>
 #include <lib/zx/fifo.h>
 #include <lib/zx/vmo.h>
 #include <threads.h>
@@ -23,6 +24,9 @@ class Manager {
   DISALLOW_COPY_ASSIGN_AND_MOVE(Manager);
 
   Manager();
+  // Statistics for each FIFO session are recorded under a child of |inspect_root| while the session
+  // is running.
+  explicit Manager(inspect::Node inspect_root);
   ~Manager();
 
   // Launches the Fifo server in a background thread.
@@ -85,6 +89,7 @@ class Manager {
   std::condition_variable_any condition_;
   ThreadState state_ TA_GUARDED(mutex_) = ThreadState::None;
 
+  inspect::Node inspect_root_;
   std::unique_ptr<Server> server_;
 };
 
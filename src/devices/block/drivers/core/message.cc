@@ -5,6 +5,7 @@
 #include "message.h"
 
 #include <fuchsia/hardware/block/c/banjo.h>
+#include <lib/zx/clock.h>
 
 #include "server.h"
 
@@ -20,13 +21,18 @@ zx_status_t Message::Create(fbl::RefPtr<IoBuffer> iobuf, Server* server, block_f
   msg->op_size_ = block_op_size;
   msg->result_ = ZX_OK;
   memcpy(&msg->req_, req, sizeof(msg->req_));
+  msg->start_time_ = zx::clock::get_monotonic();
   memset(msg->_op_raw_, 0, block_op_size);
   *out = std::move(msg);
   return ZX_OK;
 }
 
 void Message::Complete() {
+  server_->RecordLatency(req_.opcode, zx::clock::get_monotonic() - start_time_);
   completer_(result(), req_);
+  for (block_fifo_request_t& req : merged_reqs_) {
+    completer_(result(), req);
+  }
   server_->TxnEnd();
   server_ = nullptr;  // server_ can be destroyed after calling TxnEnd().
   iobuf_ = nullptr;
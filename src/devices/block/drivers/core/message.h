@@ -7,6 +7,11 @@
 
 #include <fuchsia/hardware/block/c/banjo.h>
 #include <lib/fit/function.h>
+#include <lib/zx/time.h>
+
+#include <io-scheduler/stream-op.h>
+
+#include <vector>
 
 #include <fbl/intrusive_double_list.h>
 
@@ -35,7 +40,11 @@ class Message final : public fbl::DoublyLinkedListable<Message*> {
                             size_t block_op_size, MessageCompleter completer,
                             std::unique_ptr<Message>* out);
 
-  // End the transaction specified by reqid and group, and release iobuf.
+  // Adds a request which was merged into this message's operation. It completes along with the
+  // message's own request.
+  void AddMergedRequest(const block_fifo_request_t& req) { merged_reqs_.push_back(req); }
+
+  // End the transactions specified by reqid and group, and release iobuf.
   void Complete();
 
   zx_status_t result() { return result_; }
@@ -43,15 +52,25 @@ class Message final : public fbl::DoublyLinkedListable<Message*> {
 
   block_op_t* Op() { return &op_; }
 
+  // The message as scheduled by its server's io-scheduler. The op's cookie is the message.
+  ioscheduler::StreamOp* sop() { return &sop_; }
+
+  Server* server() const { return server_; }
+
  private:
-  explicit Message(MessageCompleter completer) : completer_(std::move(completer)) {}
+  explicit Message(MessageCompleter completer)
+      : sop_(ioscheduler::OpType::kOpTypeUnknown, 0, ioscheduler::kOpGroupNone, 0, this),
+        completer_(std::move(completer)) {}
 
+  ioscheduler::StreamOp sop_;
   fbl::RefPtr<IoBuffer> iobuf_;
   MessageCompleter completer_;
   Server* server_;
   size_t op_size_;
   zx_status_t result_ = ZX_OK;
   block_fifo_request_t req_{};
+  std::vector<block_fifo_request_t> merged_reqs_;
+  zx::time start_time_;
   // Must be at the end of structure.
   union {
     block_op_t op_;
@@ -13,6 +13,7 @@
 #include <string.h>
 #include <unistd.h>
 #include <zircon/compiler.h>
+#include <zircon/device/block.h>
 #include <zircon/status.h>
 #include <zircon/syscalls.h>
 
@@ -38,10 +39,9 @@ constexpr zx_signals_t kSignalFifoTerminate = ZX_USER_SIGNAL_0;
 
 void BlockCompleteCb(void* cookie, zx_status_t status, block_op_t* bop) {
   ZX_DEBUG_ASSERT(bop != nullptr);
-  std::unique_ptr<Message> msg(static_cast<Message*>(cookie));
+  Message* msg = static_cast<Message*>(cookie);
   msg->set_result(status);
-  msg->Complete();
-  msg.reset();
+  msg->server()->IssuedOpComplete(msg);
 }
 
 uint32_t OpcodeToCommand(uint32_t opcode) {
@@ -54,11 +54,98 @@ uint32_t OpcodeToCommand(uint32_t opcode) {
 void Server::Enqueue(std::unique_ptr<Message> message) {
   {
     fbl::AutoLock server_lock(&server_lock_);
+    while (max_pending_ops_ != 0 && pending_count_ >= max_pending_ops_) {
+      condition_.Wait(&server_lock_);
+    }
     ++pending_count_;
   }
-  bp_->Queue(message->Op(), BlockCompleteCb, message.release());
+
+  const bool is_read = (message->Op()->command & BLOCK_OP_MASK) == BLOCK_OP_READ;
+  message->sop()->set_type(is_read ? ioscheduler::OpType::kOpTypeRead
+                                   : ioscheduler::OpType::kOpTypeWrite);
+  message->sop()->set_stream_id(is_read ? kReadStreamId : kWriteStreamId);
+  {
+    fbl::AutoLock lock(&intake_lock_);
+    intake_.push_back(message.release());
+  }
+  intake_available_.Signal();
+}
+
+void Server::WaitForPendingOps() {
+  fbl::AutoLock lock(&server_lock_);
+  while (pending_count_ > 0) {
+    condition_.Wait(&server_lock_);
+  }
+}
+
+zx_status_t Server::Acquire(ioscheduler::StreamOp** sop_list, size_t list_count,
+                            size_t* actual_count, bool wait) {
+  fbl::AutoLock lock(&intake_lock_);
+  // The worker only releases completed ops between calls to Acquire(), so it has to return when
+  // there are any, even if there's nothing new to acquire.
+  while (intake_.is_empty() && !completions_available_) {
+    if (intake_cancelled_) {
+      return ZX_ERR_CANCELED;
+    }
+    if (!wait) {
+      return ZX_ERR_SHOULD_WAIT;
+    }
+    intake_available_.Wait(&intake_lock_);
+  }
+  completions_available_ = false;
+  size_t count = 0;
+  while (count < list_count && !intake_.is_empty()) {
+    sop_list[count++] = intake_.pop_front()->sop();
+  }
+  *actual_count = count;
+  return ZX_OK;
 }
 
+zx_status_t Server::Issue(ioscheduler::StreamOp* sop) {
+  {
+    fbl::AutoLock lock(&server_lock_);
+    while (max_issued_ops_ != 0 && issued_count_ >= max_issued_ops_) {
+      issued_condition_.Wait(&server_lock_);
+    }
+    ++issued_count_;
+  }
+  Message* msg = static_cast<Message*>(sop->cookie());
+  bp_->Queue(msg->Op(), BlockCompleteCb, msg);
+  return ZX_ERR_ASYNC;
+}
+
+void Server::IssuedOpComplete(Message* message) {
+  {
+    fbl::AutoLock lock(&server_lock_);
+    if (issued_count_-- == max_issued_ops_) {
+      issued_condition_.Signal();
+    }
+  }
+  scheduler_.AsyncComplete(message->sop());
+  {
+    fbl::AutoLock lock(&intake_lock_);
+    completions_available_ = true;
+  }
+  intake_available_.Signal();
+}
+
+void Server::Release(ioscheduler::StreamOp* sop) {
+  std::unique_ptr<Message> msg(static_cast<Message*>(sop->cookie()));
+  // Ops which the scheduler couldn't issue only have their status in |sop|.
+  if (msg->result() == ZX_OK) {
+    msg->set_result(sop->result());
+  }
+  msg->Complete();
+}
+
+void Server::CancelAcquire() {
+  fbl::AutoLock lock(&intake_lock_);
+  intake_cancelled_ = true;
+  intake_available_.Broadcast();
+}
+
+void Server::Fatal() { zxlogf(ERROR, "Block server's io-scheduler failed"); }
+
 void Server::SendResponse(const block_fifo_response_t& response) {
   TRACE_DURATION("storage", "SendResponse");
   for (;;) {
@@ -169,16 +256,42 @@ void Server::TxnEnd() {
   fbl::AutoLock lock(&server_lock_);
   // N.B. If pending_count_ hits zero, after dropping the lock the instance of Server can be
   // destroyed.
-  if (--pending_count_ == 0) {
+  --pending_count_;
+  // Wake up the destructor, or |Enqueue()| if it is waiting for room.
+  if (pending_count_ == 0 || pending_count_ + 1 == max_pending_ops_) {
     condition_.Broadcast();
   }
 }
 
+void Server::RecordLatency(uint32_t opcode, zx::duration latency) {
+  const uint64_t latency_us = static_cast<uint64_t>(latency.to_usecs());
+  switch (opcode & BLOCK_OP_MASK) {
+    case BLOCK_OP_READ:
+      read_latency_.Insert(latency_us);
+      break;
+    case BLOCK_OP_WRITE:
+      write_latency_.Insert(latency_us);
+      break;
+    case BLOCK_OP_FLUSH:
+      flush_latency_.Insert(latency_us);
+      break;
+    case BLOCK_OP_TRIM:
+      trim_latency_.Insert(latency_us);
+      break;
+  }
+}
+
 zx_status_t Server::Create(ddk::BlockProtocolClient* bp,
                            fzl::fifo<block_fifo_request_t, block_fifo_response_t>* fifo_out,
                            std::unique_ptr<Server>* out) {
+  return Create(bp, fifo_out, out, Options());
+}
+
+zx_status_t Server::Create(ddk::BlockProtocolClient* bp,
+                           fzl::fifo<block_fifo_request_t, block_fifo_response_t>* fifo_out,
+                           std::unique_ptr<Server>* out, Options options) {
   fbl::AllocChecker ac;
-  std::unique_ptr<Server> bs(new (&ac) Server(bp));
+  std::unique_ptr<Server> bs(new (&ac) Server(bp, std::move(options)));
   if (!ac.check()) {
     return ZX_ERR_NO_MEMORY;
   }
@@ -188,6 +301,21 @@ zx_status_t Server::Create(ddk::BlockProtocolClient* bp,
     return status;
   }
 
+  if ((status = bs->scheduler_.Init(bs.get(), ioscheduler::kOptionReorderReadsAheadOfWrites)) !=
+      ZX_OK) {
+    return status;
+  }
+  const uint32_t write_priority = bs->priority_ > 0 ? bs->priority_ - 1 : 0;
+  if ((status = bs->scheduler_.StreamOpen(kReadStreamId, bs->priority_)) != ZX_OK) {
+    return status;
+  }
+  if ((status = bs->scheduler_.StreamOpen(kWriteStreamId, write_priority)) != ZX_OK) {
+    return status;
+  }
+  if ((status = bs->scheduler_.Serve()) != ZX_OK) {
+    return status;
+  }
+
   for (size_t i = 0; i < std::size(bs->groups_); i++) {
     bs->groups_[i] = std::make_unique<MessageGroup>(*bs, static_cast<groupid_t>(i));
   }
@@ -208,7 +336,35 @@ zx_status_t Server::Create(ddk::BlockProtocolClient* bp,
   return ZX_OK;
 }
 
-zx_status_t Server::ProcessReadWriteRequest(block_fifo_request_t* request) {
+bool Server::CanMerge(const block_fifo_request_t& first, uint64_t merged_length,
+                      const block_fifo_request_t& next) const {
+  // Anything with flags besides the group ones (barriers, for example) is sent down on its own.
+  constexpr uint32_t kMergeableBits = BLOCK_OP_MASK | BLOCK_GROUP_ITEM | BLOCK_GROUP_LAST;
+  if ((first.opcode & ~kMergeableBits) != 0 || (next.opcode & ~kMergeableBits) != 0) {
+    return false;
+  }
+  const uint32_t command = first.opcode & BLOCK_OP_MASK;
+  if ((command != BLOCK_OP_READ && command != BLOCK_OP_WRITE) ||
+      (next.opcode & BLOCK_OP_MASK) != command) {
+    return false;
+  }
+  if (next.vmoid != first.vmoid || next.length == 0 ||
+      next.dev_offset != first.dev_offset + merged_length ||
+      next.vmo_offset != first.vmo_offset + merged_length) {
+    return false;
+  }
+  // Merged requests must not need splitting again.
+  const uint64_t max_length = info_.max_transfer_size == 0
+                                  ? std::numeric_limits<uint32_t>::max()
+                                  : info_.max_transfer_size / info_.block_size;
+  return merged_length + next.length <= max_length;
+}
+
+zx_status_t Server::ProcessReadWriteRequest(block_fifo_request_t* requests, size_t* count) {
+  block_fifo_request_t* request = &requests[0];
+  // Until the merged requests have been validated, a failure only fails the first of them.
+  const size_t requested = *count;
+  *count = 1;
   fbl::RefPtr<IoBuffer> iobuf;
   {
     fbl::AutoLock lock(&server_lock_);
@@ -232,14 +388,27 @@ zx_status_t Server::ProcessReadWriteRequest(block_fifo_request_t* request) {
   // Hack to ensure that the vmo is valid.
   // In the future, this code will be responsible for pinning VMO pages,
   // and the completion will be responsible for un-pinning those same pages.
+  // Each request is checked on its own, so that one which is out of range fails alone rather than
+  // taking down the requests it was merged with. Only the valid prefix is sent down here.
   uint64_t bsz = info_.block_size;
-  zx_status_t status = iobuf->ValidateVmoHack(bsz * request->length, bsz * request->vmo_offset);
-  if (status != ZX_OK) {
-    return status;
+  uint64_t length = 0;
+  size_t valid = 0;
+  for (; valid < requested; valid++) {
+    zx_status_t status =
+        iobuf->ValidateVmoHack(bsz * requests[valid].length, bsz * requests[valid].vmo_offset);
+    if (status != ZX_OK) {
+      if (valid == 0) {
+        return status;
+      }
+      break;
+    }
+    length += requests[valid].length;
   }
+  *count = valid;
 
   const uint32_t max_xfer = info_.max_transfer_size / bsz;
   if (max_xfer != 0 && max_xfer < request->length) {
+    ZX_DEBUG_ASSERT(*count == 1);
     // If the request is larger than the maximum transfer size,
     // split it up into a collection of smaller block messages.
     uint32_t len_remaining = request->length;
@@ -320,11 +489,15 @@ zx_status_t Server::ProcessReadWriteRequest(block_fifo_request_t* request) {
         status != ZX_OK) {
       return status;
     }
+    // The completer is run for each of the merged requests.
+    for (size_t i = 1; i < *count; i++) {
+      msg->AddMergedRequest(requests[i]);
+    }
 
     *msg->Op() = block_op{.rw = {
                               .command = OpcodeToCommand(request->opcode),
                               .vmo = iobuf->vmo(),
-                              .length = request->length,
+                              .length = static_cast<uint32_t>(length),
                               .offset_dev = request->dev_offset,
                               .offset_vmo = request->vmo_offset,
                           }};
@@ -387,16 +560,29 @@ zx_status_t Server::ProcessTrimRequest(block_fifo_request_t* request) {
   return ZX_OK;
 }
 
-void Server::ProcessRequest(block_fifo_request_t* request) {
-  TRACE_DURATION("storage", "Server::ProcessRequest", "opcode", request->opcode);
-  if (request->trace_flow_id) {
-    TRACE_FLOW_STEP("storage", "BlockOp", request->trace_flow_id);
+void Server::ProcessRequest(block_fifo_request_t* requests, size_t count) {
+  block_fifo_request_t* request = &requests[0];
+  TRACE_DURATION("storage", "Server::ProcessRequest", "opcode", request->opcode, "count", count);
+  for (size_t i = 0; i < count; i++) {
+    if (requests[i].trace_flow_id) {
+      TRACE_FLOW_STEP("storage", "BlockOp", requests[i].trace_flow_id);
+    }
   }
+  // Only reads and writes are merged.
+  ZX_DEBUG_ASSERT(count == 1 || (request->opcode & BLOCK_OP_MASK) == BLOCK_OP_READ ||
+                  (request->opcode & BLOCK_OP_MASK) == BLOCK_OP_WRITE);
   switch (request->opcode & BLOCK_OP_MASK) {
     case BLOCK_OP_READ:
     case BLOCK_OP_WRITE:
-      if (zx_status_t status = ProcessReadWriteRequest(request); status != ZX_OK) {
-        FinishTransaction(status, request->reqid, request->group);
+      while (count > 0) {
+        size_t processed = count;
+        if (zx_status_t status = ProcessReadWriteRequest(requests, &processed); status != ZX_OK) {
+          for (size_t i = 0; i < processed; i++) {
+            FinishTransaction(status, requests[i].reqid, requests[i].group);
+          }
+        }
+        requests += processed;
+        count -= processed;
       }
       break;
     case BLOCK_OP_FLUSH:
@@ -427,6 +613,9 @@ zx_status_t Server::Serve() {
       return status;
     }
 
+    // Requests which fail before they're processed are dropped from |requests|, so that the ones
+    // either side of them can still be merged.
+    size_t valid_count = 0;
     for (size_t i = 0; i < count; i++) {
       bool wants_reply = requests[i].opcode & BLOCK_GROUP_LAST;
       bool use_group = requests[i].opcode & BLOCK_GROUP_ITEM;
@@ -456,21 +645,53 @@ zx_status_t Server::Serve() {
         requests[i].group = kNoGroup;
       }
 
-      ProcessRequest(&requests[i]);
+      requests[valid_count++] = requests[i];
+    }
+
+    // Runs of contiguous reads or writes are sent down as a single operation.
+    for (size_t i = 0; i < valid_count;) {
+      if (requests[i].opcode & BLOCKIO_BARRIER_BEFORE) {
+        WaitForPendingOps();
+      }
+      size_t merged = 1;
+      uint64_t merged_length = requests[i].length;
+      while (i + merged < valid_count &&
+             CanMerge(requests[i], merged_length, requests[i + merged])) {
+        merged_length += requests[i + merged].length;
+        merged++;
+      }
+      if (merged > 1) {
+        merged_requests_.Add(merged - 1);
+      }
+      ProcessRequest(&requests[i], merged);
+      i += merged;
     }
   }
 }
 
-Server::Server(ddk::BlockProtocolClient* bp)
-    : bp_(bp), block_op_size_(0), pending_count_(0), last_id_(BLOCK_VMOID_INVALID + 1) {
+Server::Server(ddk::BlockProtocolClient* bp, Options options)
+    : bp_(bp),
+      block_op_size_(0),
+      pending_count_(0),
+      max_pending_ops_(options.max_pending_ops),
+      max_issued_ops_(options.max_issued_ops),
+      priority_(options.priority),
+      inspect_node_(std::move(options.inspect_node)),
+      last_id_(BLOCK_VMOID_INVALID + 1) {
   size_t block_op_size;
   bp->Query(&info_, &block_op_size);
+
+  // Latencies are in microseconds. The last bucket starts at about four seconds.
+  read_latency_ = inspect_node_.CreateExponentialUintHistogram("read-latency-us", 0, 8, 2, 20);
+  write_latency_ = inspect_node_.CreateExponentialUintHistogram("write-latency-us", 0, 8, 2, 20);
+  flush_latency_ = inspect_node_.CreateExponentialUintHistogram("flush-latency-us", 0, 8, 2, 20);
+  trim_latency_ = inspect_node_.CreateExponentialUintHistogram("trim-latency-us", 0, 8, 2, 20);
+  merged_requests_ = inspect_node_.CreateUint("merged-requests", 0);
 }
 
 Server::~Server() {
-  fbl::AutoLock lock(&server_lock_);
-  while (pending_count_ > 0)
-    condition_.Wait(&server_lock_);
+  WaitForPendingOps();
+  scheduler_.Shutdown();
 }
 
 void Server::Shutdown() { fifo_.signal(0, kSignalFifoTerminate); }
@@ -8,8 +8,10 @@
 #include <fuchsia/hardware/block/c/banjo.h>
 #include <fuchsia/hardware/block/cpp/banjo.h>
 #include <lib/fzl/fifo.h>
+#include <lib/inspect/cpp/inspect.h>
 #include <lib/sync/completion.h>
 #include <lib/zircon-internal/thread_annotations.h>
+#include <lib/zx/time.h>
 #include <lib/zx/vmo.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -25,14 +27,41 @@
 #include <fbl/intrusive_wavl_tree.h>
 #include <fbl/mutex.h>
 #include <fbl/ref_ptr.h>
+#include <io-scheduler/io-scheduler.h>
 
 #include "iobuffer.h"
 #include "message-group.h"
 #include "message.h"
 
-class Server {
+// Requests read from the FIFO are queued to an io-scheduler, which issues them to the device. Each
+// session has a stream for reads at the session's priority, and a stream for everything else one
+// step below it, so that reads which something is waiting on don't queue behind bulk writes.
+class Server : public ioscheduler::SchedulerClient {
  public:
+  // Enough for several FIFOs' worth of requests, each of which might be split, to be in flight.
+  static constexpr size_t kDefaultMaxPendingOps = 1024;
+  // Operations beyond this many wait in the scheduler, where they can be reordered.
+  static constexpr size_t kDefaultMaxIssuedOps = 128;
+
+  struct Options {
+    // The most operations that are sent down the stack at once. Reading from the FIFO stops while
+    // this many are outstanding. Zero means there is no limit.
+    size_t max_pending_ops = kDefaultMaxPendingOps;
+
+    // The most operations that are issued to the device at once. Zero means there is no limit.
+    size_t max_issued_ops = kDefaultMaxIssuedOps;
+
+    // The priority of the session's reads, up to |ioscheduler::kMaxPriority|.
+    uint32_t priority = ioscheduler::kDefaultPriority;
+
+    // If valid, latency histograms and counters for the session are recorded under this node.
+    inspect::Node inspect_node;
+  };
+
   // Creates a new Server.
+  static zx_status_t Create(ddk::BlockProtocolClient* bp,
+                            fzl::fifo<block_fifo_request_t, block_fifo_response_t>* fifo_out,
+                            std::unique_ptr<Server>* out, Options options);
   static zx_status_t Create(ddk::BlockProtocolClient* bp,
                             fzl::fifo<block_fifo_request_t, block_fifo_response_t>* fifo_out,
                             std::unique_ptr<Server>* out);
@@ -47,6 +76,12 @@ class Server {
   // Updates the total number of pending requests.
   void TxnEnd();
 
+  // Records how long a request with the given |opcode| took to complete.
+  void RecordLatency(uint32_t opcode, zx::duration latency);
+
+  // Called when the device has finished |message|, which was issued by |Issue()|.
+  void IssuedOpComplete(Message* message) TA_EXCL(server_lock_, intake_lock_);
+
   // Wrapper around "SendResponse", as a convenience
   // for finishing both one-shot and group-based transactions.
   void FinishTransaction(zx_status_t status, reqid_t reqid, groupid_t group);
@@ -63,11 +98,36 @@ class Server {
 
  private:
   DISALLOW_COPY_ASSIGN_AND_MOVE(Server);
-  Server(ddk::BlockProtocolClient* bp);
-
-  // Helper for processing a single message read from the FIFO.
-  void ProcessRequest(block_fifo_request_t* request);
-  zx_status_t ProcessReadWriteRequest(block_fifo_request_t* request);
+  static constexpr uint32_t kReadStreamId = 0;
+  static constexpr uint32_t kWriteStreamId = 1;
+
+  Server(ddk::BlockProtocolClient* bp, Options options);
+
+  // ioscheduler::SchedulerClient implementation. Only the scheduler's worker calls these.
+  bool CanReorder(ioscheduler::StreamOp* first, ioscheduler::StreamOp* second) override {
+    return false;
+  }
+  zx_status_t Acquire(ioscheduler::StreamOp** sop_list, size_t list_count, size_t* actual_count,
+                      bool wait) override TA_EXCL(intake_lock_);
+  zx_status_t Issue(ioscheduler::StreamOp* sop) override TA_EXCL(server_lock_);
+  void Release(ioscheduler::StreamOp* sop) override;
+  void CancelAcquire() override TA_EXCL(intake_lock_);
+  void Fatal() override;
+
+  // Waits until every message which has been enqueued has completed.
+  void WaitForPendingOps() TA_EXCL(server_lock_);
+
+  // Returns true if |next| can be sent to the device in the same operation as |first| and the
+  // requests which have already been merged into it, which span |merged_length| blocks.
+  bool CanMerge(const block_fifo_request_t& first, uint64_t merged_length,
+                const block_fifo_request_t& next) const;
+
+  // Helper for processing messages read from the FIFO. If |count| is more than one, the requests
+  // are merged into one operation, which |CanMerge()| must have allowed.
+  void ProcessRequest(block_fifo_request_t* requests, size_t count);
+  // Sends down as many of the |*count| merged requests as are valid, and sets |*count| to the
+  // number consumed. On failure, |*count| is the number of requests to fail with the status.
+  zx_status_t ProcessReadWriteRequest(block_fifo_request_t* requests, size_t* count);
   zx_status_t ProcessCloseVmoRequest(block_fifo_request_t* request);
   zx_status_t ProcessFlushRequest(block_fifo_request_t* request);
   zx_status_t ProcessTrimRequest(block_fifo_request_t* request);
@@ -76,8 +136,9 @@ class Server {
 
   zx_status_t FindVmoIdLocked(vmoid_t* out) TA_REQ(server_lock_);
 
-  // Sends the request embedded in the message down to the lower layers.
-  void Enqueue(std::unique_ptr<Message> message) TA_EXCL(server_lock_);
+  // Queues the request embedded in the message to the scheduler, which sends it down to the lower
+  // layers.
+  void Enqueue(std::unique_ptr<Message> message) TA_EXCL(server_lock_, intake_lock_);
 
   fzl::fifo<block_fifo_response_t, block_fifo_request_t> fifo_;
   block_info_t info_;
@@ -89,12 +150,40 @@ class Server {
 
   // The number of outstanding requests that have been sent down the stack.
   size_t pending_count_ TA_GUARDED(server_lock_);
+  const size_t max_pending_ops_;
+
+  // Used to wait for issued_count_ to drop below max_issued_ops_.
+  fbl::ConditionVariable issued_condition_;
+  // The number of operations which have been issued to the device and haven't completed.
+  size_t issued_count_ TA_GUARDED(server_lock_) = 0;
+  const size_t max_issued_ops_;
+  const uint32_t priority_;
+
+  // Messages which have been enqueued but not yet acquired by the scheduler.
+  fbl::Mutex intake_lock_;
+  fbl::DoublyLinkedList<Message*> intake_ TA_GUARDED(intake_lock_);
+  fbl::ConditionVariable intake_available_;
+  bool intake_cancelled_ TA_GUARDED(intake_lock_) = false;
+  // Set when an issued op completes, so that the scheduler's worker stops waiting for new messages
+  // and releases it.
+  bool completions_available_ TA_GUARDED(intake_lock_) = false;
+
+  inspect::Node inspect_node_;
+  inspect::ExponentialUintHistogram read_latency_;
+  inspect::ExponentialUintHistogram write_latency_;
+  inspect::ExponentialUintHistogram flush_latency_;
+  inspect::ExponentialUintHistogram trim_latency_;
+  // The number of requests which were sent down the stack as part of an earlier request.
+  inspect::UintProperty merged_requests_;
 
   std::unique_ptr<MessageGroup> groups_[MAX_TXN_GROUP_COUNT];
 
   fbl::Mutex server_lock_;
   fbl::WAVLTree<vmoid_t, fbl::RefPtr<IoBuffer>> tree_ TA_GUARDED(server_lock_);
   vmoid_t last_id_ TA_GUARDED(server_lock_);
+
+  // Declared last, so that its worker is stopped before anything it uses is destroyed.
+  ioscheduler::Scheduler scheduler_;
 };
 
 #endif  // SRC_DEVICES_BLOCK_DRIVERS_CORE_SERVER_H_
@@ -8,7 +8,9 @@
 #include <lib/sync/completion.h>
 #include <unistd.h>
 
+#include <map>
 #include <thread>
+#include <vector>
 
 #include <zxtest/zxtest.h>
 
@@ -199,4 +201,251 @@ TEST_F(ServerTestFixture, SplitRequestAfterFailedRequestReturnsFailure) {
   EXPECT_EQ(response.reqid, 104);
 }
 
+TEST_F(ServerTestFixture, ContiguousRequestsAreMerged) {
+  ASSERT_OK(Server::Create(&client_, &fifo_, &server_));
+  zx::vmo vmo;
+  ASSERT_OK(zx::vmo::create(16 * kBlockSize, 0, &vmo));
+  vmoid_t vmoid;
+  ASSERT_OK(server_->AttachVmo(std::move(vmo), &vmoid));
+
+  std::vector<block_op_t> ops;
+  blkdev_.set_callback([&](const block_op_t& op) {
+    ops.push_back(op);
+    return ZX_OK;
+  });
+
+  block_fifo_request_t requests[] = {
+      {.opcode = BLOCK_OP_READ, .reqid = 1, .vmoid = vmoid, .length = 1, .vmo_offset = 0,
+       .dev_offset = 10},
+      {.opcode = BLOCK_OP_READ, .reqid = 2, .vmoid = vmoid, .length = 2, .vmo_offset = 1,
+       .dev_offset = 11},
+      {.opcode = BLOCK_OP_READ, .reqid = 3, .vmoid = vmoid, .length = 1, .vmo_offset = 3,
+       .dev_offset = 13},
+      // Not contiguous on the device.
+      {.opcode = BLOCK_OP_READ, .reqid = 4, .vmoid = vmoid, .length = 1, .vmo_offset = 4,
+       .dev_offset = 20},
+      // A write can't be merged with a read.
+      {.opcode = BLOCK_OP_WRITE, .reqid = 5, .vmoid = vmoid, .length = 1, .vmo_offset = 5,
+       .dev_offset = 21},
+  };
+  size_t actual_count = 0;
+  ASSERT_OK(fifo_.write(requests, std::size(requests), &actual_count));
+  ASSERT_EQ(actual_count, std::size(requests));
+
+  // The server thread is only started once the requests are all in the FIFO, so that they're read
+  // together.
+  CreateThread();
+  auto cleanup = fit::defer([&] {
+    server_->Shutdown();
+    JoinThread();
+  });
+
+  std::vector<reqid_t> reqids;
+  while (reqids.size() < std::size(requests)) {
+    zx_signals_t seen;
+    ASSERT_OK(fifo_.wait_one(ZX_FIFO_READABLE | ZX_FIFO_PEER_CLOSED, zx::time::infinite(), &seen));
+    block_fifo_response_t response;
+    ASSERT_OK(fifo_.read_one(&response));
+    EXPECT_OK(response.status);
+    reqids.push_back(response.reqid);
+  }
+  EXPECT_EQ(reqids, (std::vector<reqid_t>{1, 2, 3, 4, 5}));
+
+  ASSERT_EQ(ops.size(), 3);
+  EXPECT_EQ(ops[0].rw.offset_dev, 10);
+  EXPECT_EQ(ops[0].rw.offset_vmo, 0);
+  EXPECT_EQ(ops[0].rw.length, 4);
+  EXPECT_EQ(ops[1].rw.offset_dev, 20);
+  EXPECT_EQ(ops[1].rw.length, 1);
+  EXPECT_EQ(ops[2].command, BLOCK_OP_WRITE);
+}
+
+TEST_F(ServerTestFixture, MergedRequestsDoNotExceedMaxTransferSize) {
+  ASSERT_OK(Server::Create(&client_, &fifo_, &server_));
+  constexpr uint32_t kMaxTransferBlocks = 131'072 / kBlockSize;
+  zx::vmo vmo;
+  ASSERT_OK(zx::vmo::create(2 * kMaxTransferBlocks * kBlockSize, 0, &vmo));
+  vmoid_t vmoid;
+  ASSERT_OK(server_->AttachVmo(std::move(vmo), &vmoid));
+
+  std::vector<block_op_t> ops;
+  blkdev_.set_callback([&](const block_op_t& op) {
+    ops.push_back(op);
+    return ZX_OK;
+  });
+
+  block_fifo_request_t requests[] = {
+      {.opcode = BLOCK_OP_WRITE, .reqid = 1, .vmoid = vmoid, .length = kMaxTransferBlocks - 1,
+       .vmo_offset = 0, .dev_offset = 0},
+      {.opcode = BLOCK_OP_WRITE, .reqid = 2, .vmoid = vmoid, .length = 1,
+       .vmo_offset = kMaxTransferBlocks - 1, .dev_offset = kMaxTransferBlocks - 1},
+      {.opcode = BLOCK_OP_WRITE, .reqid = 3, .vmoid = vmoid, .length = 1,
+       .vmo_offset = kMaxTransferBlocks, .dev_offset = kMaxTransferBlocks},
+  };
+  size_t actual_count = 0;
+  ASSERT_OK(fifo_.write(requests, std::size(requests), &actual_count));
+  ASSERT_EQ(actual_count, std::size(requests));
+
+  CreateThread();
+  auto cleanup = fit::defer([&] {
+    server_->Shutdown();
+    JoinThread();
+  });
+
+  for (size_t i = 0; i < std::size(requests); i++) {
+    zx_signals_t seen;
+    ASSERT_OK(fifo_.wait_one(ZX_FIFO_READABLE | ZX_FIFO_PEER_CLOSED, zx::time::infinite(), &seen));
+    block_fifo_response_t response;
+    ASSERT_OK(fifo_.read_one(&response));
+    EXPECT_OK(response.status);
+  }
+
+  ASSERT_EQ(ops.size(), 2);
+  EXPECT_EQ(ops[0].rw.length, kMaxTransferBlocks);
+  EXPECT_EQ(ops[1].rw.offset_dev, kMaxTransferBlocks);
+}
+
+TEST_F(ServerTestFixture, InvalidRequestIsNotMergedWithValidOnes) {
+  ASSERT_OK(Server::Create(&client_, &fifo_, &server_));
+  zx::vmo vmo;
+  ASSERT_OK(zx::vmo::create(4 * kBlockSize, 0, &vmo));
+  vmoid_t vmoid;
+  ASSERT_OK(server_->AttachVmo(std::move(vmo), &vmoid));
+
+  std::vector<block_op_t> ops;
+  blkdev_.set_callback([&](const block_op_t& op) {
+    ops.push_back(op);
+    return ZX_OK;
+  });
+
+  // The last request runs off the end of the VMO. It's contiguous with the others, but only it
+  // should fail.
+  block_fifo_request_t requests[] = {
+      {.opcode = BLOCK_OP_WRITE, .reqid = 1, .vmoid = vmoid, .length = 1, .vmo_offset = 0,
+       .dev_offset = 0},
+      {.opcode = BLOCK_OP_WRITE, .reqid = 2, .vmoid = vmoid, .length = 1, .vmo_offset = 1,
+       .dev_offset = 1},
+      {.opcode = BLOCK_OP_WRITE, .reqid = 3, .vmoid = vmoid, .length = 4, .vmo_offset = 2,
+       .dev_offset = 2},
+  };
+  size_t actual_count = 0;
+  ASSERT_OK(fifo_.write(requests, std::size(requests), &actual_count));
+  ASSERT_EQ(actual_count, std::size(requests));
+
+  CreateThread();
+  auto cleanup = fit::defer([&] {
+    server_->Shutdown();
+    JoinThread();
+  });
+
+  std::map<reqid_t, zx_status_t> statuses;
+  while (statuses.size() < std::size(requests)) {
+    zx_signals_t seen;
+    ASSERT_OK(fifo_.wait_one(ZX_FIFO_READABLE | ZX_FIFO_PEER_CLOSED, zx::time::infinite(), &seen));
+    block_fifo_response_t response;
+    ASSERT_OK(fifo_.read_one(&response));
+    statuses[response.reqid] = response.status;
+  }
+  EXPECT_OK(statuses[1]);
+  EXPECT_OK(statuses[2]);
+  EXPECT_STATUS(statuses[3], ZX_ERR_OUT_OF_RANGE);
+
+  ASSERT_EQ(ops.size(), 1);
+  EXPECT_EQ(ops[0].rw.offset_dev, 0);
+  EXPECT_EQ(ops[0].rw.length, 2);
+}
+
+TEST_F(ServerTestFixture, PendingOpsAreBounded) {
+  constexpr size_t kMaxPendingOps = 2;
+  ASSERT_OK(Server::Create(&client_, &fifo_, &server_,
+                           Server::Options{.max_pending_ops = kMaxPendingOps}));
+  zx::vmo vmo;
+  ASSERT_OK(zx::vmo::create(4 * kBlockSize, 0, &vmo));
+  vmoid_t vmoid;
+  ASSERT_OK(server_->AttachVmo(std::move(vmo), &vmoid));
+
+  blkdev_.set_hold_ops(true);
+
+  // None of these are contiguous on the device, so each is its own operation.
+  block_fifo_request_t requests[4];
+  for (uint32_t i = 0; i < std::size(requests); i++) {
+    requests[i] = {.opcode = BLOCK_OP_READ, .reqid = i, .vmoid = vmoid, .length = 1,
+                   .vmo_offset = i, .dev_offset = 2 * i};
+  }
+  size_t actual_count = 0;
+  ASSERT_OK(fifo_.write(requests, std::size(requests), &actual_count));
+  ASSERT_EQ(actual_count, std::size(requests));
+
+  CreateThread();
+  auto cleanup = fit::defer([&] {
+    blkdev_.set_hold_ops(false);
+    blkdev_.CompleteHeldOps();
+    server_->Shutdown();
+    JoinThread();
+  });
+
+  size_t completed = 0;
+  while (completed < std::size(requests)) {
+    while (blkdev_.held_op_count() == 0) {
+      usleep(1000);
+    }
+    // Give the server a chance to send down more than it should.
+    usleep(20 * 1000);
+    EXPECT_LE(blkdev_.held_op_count(), kMaxPendingOps);
+    completed += blkdev_.CompleteHeldOps();
+  }
+  EXPECT_EQ(completed, std::size(requests));
+
+  for (size_t i = 0; i < std::size(requests); i++) {
+    zx_signals_t seen;
+    ASSERT_OK(fifo_.wait_one(ZX_FIFO_READABLE | ZX_FIFO_PEER_CLOSED, zx::time::infinite(), &seen));
+    block_fifo_response_t response;
+    ASSERT_OK(fifo_.read_one(&response));
+    EXPECT_OK(response.status);
+  }
+}
+
+TEST_F(ServerTestFixture, BarrierWaitsForEarlierRequests) {
+  ASSERT_OK(Server::Create(&client_, &fifo_, &server_));
+  zx::vmo vmo;
+  ASSERT_OK(zx::vmo::create(2 * kBlockSize, 0, &vmo));
+  vmoid_t vmoid;
+  ASSERT_OK(server_->AttachVmo(std::move(vmo), &vmoid));
+
+  std::vector<block_op_t> ops;
+  blkdev_.set_callback([&](const block_op_t& op) {
+    ops.push_back(op);
+    return ZX_OK;
+  });
+
+  // Without the barrier, the read could be issued ahead of the write.
+  block_fifo_request_t requests[] = {
+      {.opcode = BLOCK_OP_WRITE, .reqid = 1, .vmoid = vmoid, .length = 1, .vmo_offset = 0,
+       .dev_offset = 0},
+      {.opcode = BLOCK_OP_READ | BLOCKIO_BARRIER_BEFORE, .reqid = 2, .vmoid = vmoid, .length = 1,
+       .vmo_offset = 1, .dev_offset = 0},
+  };
+  size_t actual_count = 0;
+  ASSERT_OK(fifo_.write(requests, std::size(requests), &actual_count));
+  ASSERT_EQ(actual_count, std::size(requests));
+
+  CreateThread();
+  auto cleanup = fit::defer([&] {
+    server_->Shutdown();
+    JoinThread();
+  });
+
+  for (size_t i = 0; i < std::size(requests); i++) {
+    zx_signals_t seen;
+    ASSERT_OK(fifo_.wait_one(ZX_FIFO_READABLE | ZX_FIFO_PEER_CLOSED, zx::time::infinite(), &seen));
+    block_fifo_response_t response;
+    ASSERT_OK(fifo_.read_one(&response));
+    EXPECT_OK(response.status);
+  }
+
+  ASSERT_EQ(ops.size(), 2);
+  EXPECT_EQ(ops[0].command, BLOCK_OP_WRITE);
+  EXPECT_EQ(ops[1].command, BLOCK_OP_READ);
+}
+
 }  // namespace
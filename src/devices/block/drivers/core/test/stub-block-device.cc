@@ -6,9 +6,35 @@
 
 void StubBlockDevice::BlockQueue(block_op_t* operation, block_queue_callback completion_cb,
                                  void* cookie) {
-  if (callback_) {
-    completion_cb(cookie, callback_(*operation), operation);
-  } else {
-    completion_cb(cookie, ZX_OK, operation);
+  zx_status_t status = callback_ ? callback_(*operation) : ZX_OK;
+  {
+    std::lock_guard lock(lock_);
+    if (hold_ops_) {
+      held_ops_.push_back({operation, completion_cb, cookie, status});
+      return;
+    }
   }
+  completion_cb(cookie, status, operation);
+}
+
+void StubBlockDevice::set_hold_ops(bool hold_ops) {
+  std::lock_guard lock(lock_);
+  hold_ops_ = hold_ops;
+}
+
+size_t StubBlockDevice::held_op_count() {
+  std::lock_guard lock(lock_);
+  return held_ops_.size();
+}
+
+size_t StubBlockDevice::CompleteHeldOps() {
+  std::vector<HeldOp> held_ops;
+  {
+    std::lock_guard lock(lock_);
+    held_ops.swap(held_ops_);
+  }
+  for (const HeldOp& op : held_ops) {
+    op.completion_cb(op.cookie, op.status, op.operation);
+  }
+  return held_ops.size();
 }
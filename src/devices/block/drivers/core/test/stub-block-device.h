@@ -11,6 +11,8 @@
 #include <cstdint>
 #include <cstdlib>
 #include <functional>
+#include <mutex>
+#include <vector>
 
 constexpr uint32_t kBlockSize = 1024;
 constexpr uint64_t kBlockCount = 4096;
@@ -30,6 +32,12 @@ class StubBlockDevice : public ddk::BlockProtocol<StubBlockDevice> {
 
   void set_callback(Callback callback) { callback_ = callback; }
 
+  // While set, queued operations aren't completed until |CompleteHeldOps()| is called.
+  void set_hold_ops(bool hold_ops);
+  size_t held_op_count();
+  // Returns the number of operations completed.
+  size_t CompleteHeldOps();
+
   // BlockProtocol ops implementation.
   // -----------------------------------
   void BlockQuery(block_info_t* info_out, size_t* block_op_size_out) {
@@ -44,6 +52,16 @@ class StubBlockDevice : public ddk::BlockProtocol<StubBlockDevice> {
   block_protocol_t proto_{};
   block_info_t info_{};
   Callback callback_;
+
+  struct HeldOp {
+    block_op_t* operation;
+    block_queue_callback completion_cb;
+    void* cookie;
+    zx_status_t status;
+  };
+  std::mutex lock_;
+  bool hold_ops_ = false;
+  std::vector<HeldOp> held_ops_;
 };
 
 #endif  // SRC_DEVICES_BLOCK_DRIVERS_CORE_TEST_STUB_BLOCK_DEVICE_H_
@@ -11,6 +11,7 @@
 #include <zircon/errors.h>
 #include <zircon/fidl.h>
 #include <zircon/status.h>
+#include <zircon/syscalls.h>
 #include <zircon/threads.h>
 #include <zircon/types.h>
 
@@ -29,6 +30,14 @@ namespace {
 
 constexpr char kDeviceName[] = "ftl";
 
+// Flush any pending data after 15 seconds of inactivity. This is meant to reduce the chances of
+// data loss if power is removed. This value is only a guess.
+constexpr zx_duration_t kIdleFlushDelay = ZX_SEC(15);
+
+// Reclaim dirty blocks and erase free ones once there has been no I/O for a little while, so that
+// the work doesn't have to be done inline with a later write.
+constexpr zx_duration_t kIdleGarbageCollectDelay = ZX_MSEC(100);
+
 // Encapsulates a block operation that is created by this device (so that it
 // goes through the worker thread).
 class LocalOperation {
@@ -216,6 +225,7 @@ void BlockDevice::BlockImplQueue(block_op_t* operation, block_impl_queue_callbac
   FtlOp* block_op = reinterpret_cast<FtlOp*>(operation);
   block_op->completion_cb = completion_cb;
   block_op->cookie = cookie;
+  block_op->queue_time = zx_clock_get_monotonic();
   if (AddToList(block_op)) {
     sync_completion_signal(&wake_signal_);
   } else {
@@ -324,14 +334,10 @@ int BlockDevice::WorkerThread() {
           operation->completion_cb(operation->cookie, ZX_ERR_BAD_STATE, &operation->op);
         }
       } else if (alive) {
-        // Flush any pending data after 15 seconds of inactivity. This is
-        // meant to reduce the chances of data loss if power is removed.
-        // This value is only a guess.
-        zx_duration_t timeout = pending_flush_ ? ZX_SEC(15) : ZX_TIME_INFINITE;
-        zx_status_t status = sync_completion_wait(&wake_signal_, timeout);
-        if (status == ZX_ERR_TIMED_OUT) {
-          Flush();
-          pending_flush_ = false;
+        // Idle work is done one step at a time so that new operations don't have to wait for
+        // more than a single garbage collection cycle.
+        if (!DoIdleWork()) {
+          sync_completion_wait_deadline(&wake_signal_, GetIdleWorkDeadline());
         }
       } else {
         return 0;
@@ -356,6 +362,7 @@ int BlockDevice::WorkerThread() {
       switch (operation->op.command) {
         case BLOCK_OP_WRITE:
           pending_flush_ = true;
+          pending_garbage_collect_ = true;
           status = ReadWriteData(&operation->op);
           op_stats = &metrics_.write();
           break;
@@ -368,6 +375,7 @@ int BlockDevice::WorkerThread() {
 
         case BLOCK_OP_TRIM:
           pending_flush_ = true;
+          pending_garbage_collect_ = true;
           status = TrimData(&operation->op);
           op_stats = &metrics_.trim();
           break;
@@ -391,9 +399,13 @@ int BlockDevice::WorkerThread() {
       metrics_.running_bad_blocks().Set(counters.running_bad_blocks);
     }
 
+    last_operation_time_ = zx_clock_get_monotonic();
+
     // Update all counters and rates for the supported operation type.
     if (op_stats != nullptr) {
       op_stats->count.Add(1);
+      op_stats->latency.Insert(
+          static_cast<uint64_t>((last_operation_time_ - operation->queue_time) / ZX_USEC(1)));
       op_stats->all.count.Add(nand_counters_.GetSum());
       op_stats->all.rate.Add(nand_counters_.GetSum());
       op_stats->block_erase.count.Add(nand_counters_.block_erase);
@@ -407,6 +419,42 @@ int BlockDevice::WorkerThread() {
   }
 }
 
+bool BlockDevice::DoIdleWork() {
+  zx_time_t now = zx_clock_get_monotonic();
+  if (pending_garbage_collect_ && now >= last_operation_time_ + kIdleGarbageCollectDelay) {
+    TRACE_DURATION("block:ftl", "IdleGarbageCollect");
+    zx_status_t status = volume_->GarbageCollect();
+    if (status == ZX_OK) {
+      metrics_.idle_garbage_collections().Add(1);
+      // Reclaiming blocks moves data around, so make sure it eventually gets flushed.
+      pending_flush_ = true;
+    } else {
+      if (status != ZX_ERR_STOP) {
+        zxlogf(WARNING, "FTL: Idle garbage collection failed: %s", zx_status_get_string(status));
+      }
+      pending_garbage_collect_ = false;
+    }
+    return true;
+  }
+
+  if (pending_flush_ && now >= last_operation_time_ + kIdleFlushDelay) {
+    Flush();
+    pending_flush_ = false;
+    return true;
+  }
+  return false;
+}
+
+zx_time_t BlockDevice::GetIdleWorkDeadline() const {
+  if (pending_garbage_collect_) {
+    return last_operation_time_ + kIdleGarbageCollectDelay;
+  }
+  if (pending_flush_) {
+    return last_operation_time_ + kIdleFlushDelay;
+  }
+  return ZX_TIME_INFINITE;
+}
+
 int BlockDevice::WorkerThreadStub(void* arg) {
   BlockDevice* device = reinterpret_cast<BlockDevice*>(arg);
   return device->WorkerThread();
@@ -46,6 +46,7 @@ struct FtlOp {
   list_node_t node;
   block_impl_queue_callback completion_cb;
   void* cookie;
+  zx_time_t queue_time;
 };
 
 class BlockDevice;
@@ -118,6 +119,13 @@ class BlockDevice : public DeviceType,
   int WorkerThread();
   static int WorkerThreadStub(void* arg);
 
+  // Performs any deferred work that is due now that the device has been idle for a while. Returns
+  // false if there is nothing left to do yet.
+  bool DoIdleWork();
+
+  // Returns the time at which there will be idle work to do.
+  zx_time_t GetIdleWorkDeadline() const;
+
   // Implementation of the actual commands.
   zx_status_t ReadWriteData(block_op_t* operation);
   zx_status_t TrimData(block_op_t* operation);
@@ -130,7 +138,12 @@ class BlockDevice : public DeviceType,
   bool dead_ TA_GUARDED(lock_) = false;
 
   bool thread_created_ = false;
+
+  // Idle work, owned by the worker thread. Both are scheduled relative to the completion of the
+  // last operation.
   bool pending_flush_ = false;
+  bool pending_garbage_collect_ = false;
+  zx_time_t last_operation_time_ = 0;
 
   sync_completion_t wake_signal_;
   thrd_t worker_;
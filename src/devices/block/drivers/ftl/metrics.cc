@@ -63,6 +63,11 @@ std::string GetCounterPropertyName(BlockOperationType operation_type) {
   return name + ".count";
 }
 
+std::string GetLatencyPropertyName(BlockOperationType operation_type) {
+  auto name = GetName(operation_type);
+  return name + ".latency_us";
+}
+
 std::string GetCounterPropertyName(BlockOperationType operation_type,
                                    NandOperationType nand_operation) {
   auto name = GetName(operation_type);
@@ -86,6 +91,11 @@ std::string GetMapBlockEndPageFailureReasonPropertyName(int reason) {
 BlockOperationProperties MakePropertyForBlockOperation(inspect::Node& root,
                                                        BlockOperationType block_operation) {
   auto count = root.CreateUint(GetCounterPropertyName(block_operation), 0);
+  // Buckets go from 8us up to ~4s, which covers everything from a cached read to a write that had
+  // to wait for several blocks to be reclaimed.
+  auto latency = root.CreateExponentialUintHistogram(GetLatencyPropertyName(block_operation),
+                                                     /*floor=*/0, /*initial_step=*/8,
+                                                     /*step_multiplier=*/2, /*buckets=*/20);
   auto all_nand = NestedNandOperationProperties(
       root.CreateUint(GetCounterPropertyName(block_operation, NandOperationType::kAll), 0),
       root.CreateDouble(GetRatePropertyName(block_operation, NandOperationType::kAll), 0));
@@ -100,6 +110,7 @@ BlockOperationProperties MakePropertyForBlockOperation(inspect::Node& root,
       root.CreateDouble(GetRatePropertyName(block_operation, NandOperationType::kBlockErase), 0));
 
   return BlockOperationProperties{.count = std::move(count),
+                                  .latency = std::move(latency),
                                   .all = std::move(all_nand),
                                   .page_read = std::move(nand_page_read),
                                   .page_write = std::move(nand_page_write),
@@ -120,6 +131,7 @@ std::vector<std::string> Metrics::GetPropertyNames<inspect::UintProperty>() {
   property_names.push_back("nand.erase_block.max_wear");
   property_names.push_back("nand.initial_bad_blocks");
   property_names.push_back("nand.running_bad_blocks");
+  property_names.push_back("nand.idle_garbage_collect.count");
   for (int i = 0; i < kReasonCount; ++i)
     property_names.push_back(GetMapBlockEndPageFailureReasonPropertyName(i));
   return property_names;
@@ -136,6 +148,15 @@ std::vector<std::string> Metrics::GetPropertyNames<inspect::DoubleProperty>() {
   return property_names;
 }
 
+template <>
+std::vector<std::string> Metrics::GetPropertyNames<inspect::ExponentialUintHistogram>() {
+  std::vector<std::string> property_names;
+  for (auto block_op : kAllBlockOps) {
+    property_names.push_back(GetLatencyPropertyName(block_op));
+  }
+  return property_names;
+}
+
 Metrics::Metrics()
     : inspector_(),
       root_(inspector_.GetRoot().CreateChild("ftl")),
@@ -146,6 +167,7 @@ Metrics::Metrics()
   max_wear_ = root_.CreateUint("nand.erase_block.max_wear", 0);
   initial_bad_blocks_ = root_.CreateUint("nand.initial_bad_blocks", 0);
   running_bad_blocks_ = root_.CreateUint("nand.running_bad_blocks", 0);
+  idle_garbage_collections_ = root_.CreateUint("nand.idle_garbage_collect.count", 0);
   for (int i = 0; i < kReasonCount; ++i) {
     map_block_end_page_failure_reasons_[i] =
         root_.CreateUint(GetMapBlockEndPageFailureReasonPropertyName(i), 0);
@@ -67,6 +67,9 @@ struct BlockOperationProperties {
   // Number of block operations of a given type that have been processed by the FTL.
   inspect::UintProperty count;
 
+  // Time from an operation being queued until it completes, in microseconds.
+  inspect::ExponentialUintHistogram latency;
+
   // Operation stats per nand operation type for operation issued for this block operation type.
   NestedNandOperationProperties all;
   NestedNandOperationProperties page_read;
@@ -94,6 +97,9 @@ class Metrics {
   inspect::UintProperty& initial_bad_blocks() { return initial_bad_blocks_; }
   inspect::UintProperty& running_bad_blocks() { return running_bad_blocks_; }
 
+  // Number of garbage collection cycles that were run while the device was idle.
+  inspect::UintProperty& idle_garbage_collections() { return idle_garbage_collections_; }
+
   BlockOperationProperties& read() { return read_; }
   BlockOperationProperties& write() { return write_; }
   BlockOperationProperties& trim() { return trim_; }
@@ -121,6 +127,8 @@ class Metrics {
   inspect::UintProperty initial_bad_blocks_;
   inspect::UintProperty running_bad_blocks_;
 
+  inspect::UintProperty idle_garbage_collections_;
+
   // Properties for each block operation type.
   BlockOperationProperties read_;
   BlockOperationProperties write_;
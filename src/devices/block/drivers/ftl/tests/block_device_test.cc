@@ -10,9 +10,13 @@
 #include <lib/fzl/owned-vmo-mapper.h>
 #include <lib/inspect/cpp/reader.h>
 #include <lib/inspect/cpp/vmo/types.h>
+#include <lib/zx/clock.h>
+#include <lib/zx/time.h>
 
 #include <atomic>
+#include <map>
 #include <memory>
+#include <string>
 #include <utility>
 
 #include <fbl/array.h>
@@ -125,7 +129,10 @@ class FakeVolume final : public ftl::Volume {
     return ZX_OK;
   }
 
-  zx_status_t GarbageCollect() final { return ZX_OK; }
+  zx_status_t GarbageCollect() final {
+    int calls = garbage_collect_calls_++;
+    return calls < garbage_collect_cycles_ ? ZX_OK : ZX_ERR_STOP;
+  }
 
   zx_status_t GetStats(Stats* stats) final {
     *stats = {};
@@ -153,6 +160,10 @@ class FakeVolume final : public ftl::Volume {
 
   void SetOnOperation(fit::function<void()> callback) { on_operation_ = std::move(callback); }
 
+  // Sets the number of garbage collection calls that will find work to do.
+  void SetGarbageCollectCycles(int cycles) { garbage_collect_cycles_ = cycles; }
+  int garbage_collect_calls() const { return garbage_collect_calls_; }
+
  private:
   void OnOperation() {
     if (on_operation_) {
@@ -167,6 +178,8 @@ class FakeVolume final : public ftl::Volume {
   uint32_t initial_bad_blocks_ = kInitialBadBlocks;
   uint32_t running_bad_blocks_ = kRunningBadBlocks;
   fit::function<void()> on_operation_;
+  std::atomic<int> garbage_collect_cycles_ = 0;
+  std::atomic<int> garbage_collect_calls_ = 0;
   bool written_ = false;
   bool flushed_ = false;
   bool formatted_ = false;
@@ -754,6 +767,52 @@ TEST_F(BlockDeviceTest, InspectBadBlockMetricsPopulation) {
   ASSERT_EQ(counters["nand.running_bad_blocks"], 8);
 }
 
+TEST_F(BlockDeviceTest, InspectLatencyHistogramUpdated) {
+  ftl::BlockDevice* device = GetDevice();
+  ASSERT_TRUE(device);
+  Read();
+
+  auto base_hierarchy = inspect::ReadFromVmo(device->DuplicateInspectVmo()).take_value();
+  auto* hierarchy = base_hierarchy.GetByPath({"ftl"});
+  ASSERT_NOT_NULL(hierarchy);
+  auto* histogram =
+      hierarchy->node().get_property<inspect::UintArrayValue>("block.read.latency_us");
+  ASSERT_NOT_NULL(histogram);
+
+  // The first three entries hold the histogram parameters.
+  uint64_t samples = 0;
+  for (size_t i = 3; i < histogram->value().size(); ++i) {
+    samples += histogram->value()[i];
+  }
+  EXPECT_EQ(samples, 1);
+}
+
+TEST_F(BlockDeviceTest, GarbageCollectsWhenIdleAfterWrite) {
+  ftl::BlockDevice* device = GetDevice();
+  ASSERT_TRUE(device);
+  constexpr int kCycles = 3;
+  GetVolume()->SetGarbageCollectCycles(kCycles);
+
+  // Reads don't generate garbage.
+  Read();
+  zx::nanosleep(zx::deadline_after(zx::msec(200)));
+  EXPECT_EQ(GetVolume()->garbage_collect_calls(), 0);
+
+  Write();
+  // Garbage collection keeps going until the volume reports that there is nothing left to do.
+  zx::time deadline = zx::deadline_after(zx::sec(10));
+  while (GetVolume()->garbage_collect_calls() <= kCycles) {
+    ASSERT_LT(zx::clock::get_monotonic(), deadline);
+    zx::nanosleep(zx::deadline_after(zx::msec(10)));
+  }
+
+  std::map<std::string, uint64_t> counters;
+  std::map<std::string, double> rates;
+  ReadProperties(device, counters, rates);
+  EXPECT_EQ(counters["nand.idle_garbage_collect.count"], kCycles);
+  EXPECT_EQ(GetVolume()->garbage_collect_calls(), kCycles + 1);
+}
+
 TEST_F(BlockDeviceTest, Suspend) {
   ftl::BlockDevice* device = GetDevice();
   ASSERT_TRUE(device);
@@ -23,6 +23,12 @@ TEST(MetricsTest, GetInspectVmoReflectsExistingMetrics) {
     auto* property = hierarchy->node().get_property<inspect::DoublePropertyValue>(property_name);
     EXPECT_NOT_NULL(property, "Missing Inspect Property: %s", property_name.c_str());
   }
+
+  for (const auto& property_name :
+       ftl::Metrics::GetPropertyNames<inspect::ExponentialUintHistogram>()) {
+    auto* property = hierarchy->node().get_property<inspect::UintArrayValue>(property_name);
+    EXPECT_NOT_NULL(property, "Missing Inspect Property: %s", property_name.c_str());
+  }
 }
 
 TEST(MetricsTest, MetricsInitializedToZero) {
@@ -0,0 +1,53 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SRC_DEVICES_BLOCK_DRIVERS_NVME_CPP_COMMANDS_FEATURES_H_
+#define SRC_DEVICES_BLOCK_DRIVERS_NVME_CPP_COMMANDS_FEATURES_H_
+
+#include <hwreg/bitfields.h>
+
+#include "src/devices/block/drivers/nvme-cpp/commands.h"
+
+namespace nvme {
+
+// NVM Express Base Specification 2.0, section 5.27.1, Figure 317, "Feature Identifiers"
+enum class Feature : uint8_t {
+  kNumberOfQueues = 0x07,
+};
+
+// NVM Express Base Specification 2.0, section 5.27, "Set Features command"
+class SetFeaturesSubmission : public Submission {
+ public:
+  static constexpr uint8_t kOpcode = 0x09;
+  SetFeaturesSubmission() : Submission(kOpcode) {}
+
+  DEF_SUBBIT(dword10, 31, save);
+  DEF_ENUM_SUBFIELD(dword10, Feature, 7, 0, feature_id);
+};
+
+// NVM Express Base Specification 2.0, section 5.27.1.5, "Number of Queues"
+// The counts don't include the admin queues, and are zero-based.
+class SetNumberOfQueuesSubmission : public SetFeaturesSubmission {
+ public:
+  SetNumberOfQueuesSubmission() { set_feature_id(Feature::kNumberOfQueues); }
+
+  DEF_SUBFIELD(dword11, 31, 16, completion_queue_count);
+  DEF_SUBFIELD(dword11, 15, 0, submission_queue_count);
+};
+
+// The completion of a |SetNumberOfQueuesSubmission| reports how many queues the controller has
+// allocated, which may be more or fewer than were asked for. The counts are zero-based.
+struct NumberOfQueuesCompletion {
+  explicit NumberOfQueuesCompletion(const Completion& completion)
+      : dword0(completion.command[0]) {}
+
+  uint32_t dword0;
+
+  DEF_SUBFIELD(dword0, 31, 16, completion_queue_count);
+  DEF_SUBFIELD(dword0, 15, 0, submission_queue_count);
+};
+
+}  // namespace nvme
+
+#endif  // SRC_DEVICES_BLOCK_DRIVERS_NVME_CPP_COMMANDS_FEATURES_H_
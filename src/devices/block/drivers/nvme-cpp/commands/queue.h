@@ -0,0 +1,48 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SRC_DEVICES_BLOCK_DRIVERS_NVME_CPP_COMMANDS_QUEUE_H_
+#define SRC_DEVICES_BLOCK_DRIVERS_NVME_CPP_COMMANDS_QUEUE_H_
+
+#include <hwreg/bitfields.h>
+
+#include "src/devices/block/drivers/nvme-cpp/commands.h"
+
+namespace nvme {
+
+// NVM Express Base Specification 2.0, section 5.4, "Create I/O Completion Queue command"
+// The queue's address goes in the first data pointer.
+class CreateIoCompletionQueueSubmission : public Submission {
+ public:
+  static constexpr uint8_t kOpcode = 0x05;
+  CreateIoCompletionQueueSubmission() : Submission(kOpcode) {}
+
+  // This is zero-based.
+  DEF_SUBFIELD(dword10, 31, 16, queue_size);
+  DEF_SUBFIELD(dword10, 15, 0, queue_id);
+
+  DEF_SUBFIELD(dword11, 31, 16, interrupt_vector);
+  DEF_SUBBIT(dword11, 1, interrupts_enabled);
+  DEF_SUBBIT(dword11, 0, contiguous);
+};
+
+// NVM Express Base Specification 2.0, section 5.5, "Create I/O Submission Queue command"
+// The queue's address goes in the first data pointer.
+class CreateIoSubmissionQueueSubmission : public Submission {
+ public:
+  static constexpr uint8_t kOpcode = 0x01;
+  CreateIoSubmissionQueueSubmission() : Submission(kOpcode) {}
+
+  // This is zero-based.
+  DEF_SUBFIELD(dword10, 31, 16, queue_size);
+  DEF_SUBFIELD(dword10, 15, 0, queue_id);
+
+  DEF_SUBFIELD(dword11, 31, 16, completion_queue_id);
+  DEF_SUBFIELD(dword11, 2, 1, priority);
+  DEF_SUBBIT(dword11, 0, contiguous);
+};
+
+}  // namespace nvme
+
+#endif  // SRC_DEVICES_BLOCK_DRIVERS_NVME_CPP_COMMANDS_QUEUE_H_
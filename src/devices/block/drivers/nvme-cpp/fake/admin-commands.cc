@@ -6,8 +6,12 @@
 
 #include <lib/ddk/debug.h>
 
+#include <algorithm>
+
 #include "src/devices/block/drivers/nvme-cpp/commands.h"
+#include "src/devices/block/drivers/nvme-cpp/commands/features.h"
 #include "src/devices/block/drivers/nvme-cpp/commands/identify.h"
+#include "src/devices/block/drivers/nvme-cpp/commands/queue.h"
 #include "src/devices/block/drivers/nvme-cpp/fake/fake-nvme-controller.h"
 
 namespace fake_nvme {
@@ -19,6 +23,14 @@ DefaultAdminCommands::DefaultAdminCommands(FakeNvmeController& controller)
     : controller_(controller) {
   controller.AddAdminCommand(nvme::IdentifySubmission::kOpcode,
                              fit::bind_member(this, &DefaultAdminCommands::Identify));
+  controller.AddAdminCommand(nvme::SetFeaturesSubmission::kOpcode,
+                             fit::bind_member(this, &DefaultAdminCommands::SetFeatures));
+  controller.AddAdminCommand(
+      nvme::CreateIoCompletionQueueSubmission::kOpcode,
+      fit::bind_member(this, &DefaultAdminCommands::CreateIoCompletionQueue));
+  controller.AddAdminCommand(
+      nvme::CreateIoSubmissionQueueSubmission::kOpcode,
+      fit::bind_member(this, &DefaultAdminCommands::CreateIoSubmissionQueue));
 }
 namespace {
 void MakeIdentifyController(nvme::IdentifyController* out) {
@@ -81,4 +93,56 @@ void DefaultAdminCommands::Identify(nvme::Submission& default_submission,
   }
 }
 
+void DefaultAdminCommands::SetFeatures(nvme::Submission& default_submission,
+                                       const nvme::TransactionData& data, Completion& completion) {
+  using nvme::SetFeaturesSubmission;
+  completion.set_status_code_type(StatusCodeType::kGeneric)
+      .set_status_code(GenericStatus::kSuccess);
+  SetFeaturesSubmission& submission = default_submission.GetSubmission<SetFeaturesSubmission>();
+
+  switch (submission.feature_id()) {
+    case nvme::Feature::kNumberOfQueues: {
+      auto& queues = default_submission.GetSubmission<nvme::SetNumberOfQueuesSubmission>();
+      // Both counts are zero-based.
+      uint32_t completion_queues =
+          std::min(static_cast<uint32_t>(queues.completion_queue_count()), kMaxIoQueues - 1);
+      uint32_t submission_queues =
+          std::min(static_cast<uint32_t>(queues.submission_queue_count()), kMaxIoQueues - 1);
+      completion.command[0] = (completion_queues << 16) | submission_queues;
+      break;
+    }
+    default:
+      zxlogf(ERROR, "unsupported feature");
+      completion.set_status_code(GenericStatus::kInvalidField);
+      break;
+  }
+}
+
+void DefaultAdminCommands::CreateIoCompletionQueue(nvme::Submission& default_submission,
+                                                   const nvme::TransactionData& data,
+                                                   Completion& completion) {
+  auto& submission = default_submission.GetSubmission<nvme::CreateIoCompletionQueueSubmission>();
+  completion.set_status_code_type(StatusCodeType::kGeneric)
+      .set_status_code(GenericStatus::kSuccess);
+  pending_completion_queues_.emplace(submission.queue_id(), submission.interrupt_vector());
+}
+
+void DefaultAdminCommands::CreateIoSubmissionQueue(nvme::Submission& default_submission,
+                                                   const nvme::TransactionData& data,
+                                                   Completion& completion) {
+  auto& submission = default_submission.GetSubmission<nvme::CreateIoSubmissionQueueSubmission>();
+  auto completion_queue = pending_completion_queues_.find(submission.completion_queue_id());
+  if (submission.queue_id() != submission.completion_queue_id() ||
+      completion_queue == pending_completion_queues_.end()) {
+    // The fake only supports one submission queue per completion queue, with the same ID. This is
+    // "Completion Queue Invalid".
+    completion.set_status_code_type(StatusCodeType::kCommandSpecific).set_status_code(0);
+    return;
+  }
+  completion.set_status_code_type(StatusCodeType::kGeneric)
+      .set_status_code(GenericStatus::kSuccess);
+  controller_.AddIoQueuePair(submission.queue_id(), completion_queue->second);
+  pending_completion_queues_.erase(completion_queue);
+}
+
 }  // namespace fake_nvme
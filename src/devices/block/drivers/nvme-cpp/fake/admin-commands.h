@@ -5,6 +5,8 @@
 #ifndef SRC_DEVICES_BLOCK_DRIVERS_NVME_CPP_FAKE_ADMIN_COMMANDS_H_
 #define SRC_DEVICES_BLOCK_DRIVERS_NVME_CPP_FAKE_ADMIN_COMMANDS_H_
 
+#include <unordered_map>
+
 #include "src/devices/block/drivers/nvme-cpp/commands.h"
 #include "src/devices/block/drivers/nvme-cpp/nvme.h"
 #include "src/devices/block/drivers/nvme-cpp/queue-pair.h"
@@ -18,13 +20,24 @@ class DefaultAdminCommands {
   constexpr static const char* kModelNumber = "PL4T-1234";
   constexpr static const char* kFirmwareRev = "7.4.2.1";
 
+  // The most I/O queues that "Set Features" will allocate.
+  constexpr static uint32_t kMaxIoQueues = 4;
+
   explicit DefaultAdminCommands(FakeNvmeController& controller);
 
  private:
   void Identify(nvme::Submission& submission, const nvme::TransactionData& data,
                 nvme::Completion& completion);
+  void SetFeatures(nvme::Submission& submission, const nvme::TransactionData& data,
+                   nvme::Completion& completion);
+  void CreateIoCompletionQueue(nvme::Submission& submission, const nvme::TransactionData& data,
+                               nvme::Completion& completion);
+  void CreateIoSubmissionQueue(nvme::Submission& submission, const nvme::TransactionData& data,
+                               nvme::Completion& completion);
 
   FakeNvmeController& controller_;
+  // Interrupt vector of each I/O completion queue which doesn't have a submission queue yet.
+  std::unordered_map<size_t, size_t> pending_completion_queues_;
 };
 
 }  // namespace fake_nvme
@@ -29,7 +29,7 @@ void FakeNvmeController::HandleSubmission(size_t queue_id, size_t index,
   if (cmd != command_set.end()) {
     // Find transaction data.
     auto& txn_data = (queue_id == kAdminQueueId) ? nvme_->admin_queue_->txn_data()
-                                                 : nvme_->io_queue_->txn_data();
+                                                 : nvme_->io_queues_[queue_id - 1]->txn_data();
     cmd->second(submission, txn_data[submission.cid()], completion);
   } else {
     // Command did not exist, return an error.
@@ -62,7 +62,9 @@ void FakeNvmeController::SubmitCompletion(nvme::Completion& completion) {
     queue.producer_location = 0;
     queue.phase ^= 1;
   }
-  irqs_.find(0)->second.Trigger();
+  auto irq = irqs_.find(queue.interrupt_vector);
+  ZX_ASSERT(irq != irqs_.end());
+  irq->second.Trigger();
 }
 
 zx::status<zx::interrupt> FakeNvmeController::GetOrCreateInterrupt(size_t index) {
@@ -145,4 +147,12 @@ void FakeNvmeController::UpdateAdminQueue() {
                const_cast<nvme::Queue*>(&nvme_->admin_queue_->submission()));
 }
 
+void FakeNvmeController::AddIoQueuePair(size_t queue_id, size_t interrupt_vector) {
+  ZX_ASSERT(queue_id > 0 && queue_id <= nvme_->io_queues_.size());
+  auto& io_queue = nvme_->io_queues_[queue_id - 1];
+  regs_.SetUpDoorbells(queue_id);
+  AddQueuePair(queue_id, const_cast<nvme::Queue*>(&io_queue->completion()),
+               const_cast<nvme::Queue*>(&io_queue->submission()), interrupt_vector);
+}
+
 }  // namespace fake_nvme
@@ -48,6 +48,11 @@ class FakeNvmeController {
 
   // Called when one of the Admin Queue address registers is written to.
   void UpdateAdminQueue();
+  // Called when the driver creates an I/O queue pair. |queue_id| must be the ID of one of the
+  // driver's I/O queues.
+  void AddIoQueuePair(size_t queue_id, size_t interrupt_vector);
+
+  size_t io_queue_count() const { return completion_queues_.size() - 1; }
 
   // Add a namespace to this controller.
   void AddNamespace(uint32_t nsid, FakeNvmeNamespace& ns) { namespaces_.emplace(nsid, ns); }
@@ -57,13 +62,15 @@ class FakeNvmeController {
   // register are fake values from fake_bti.
   void SetNvme(nvme::Nvme* nvme) { nvme_ = nvme; }
 
-  void AddQueuePair(size_t queue_id, nvme::Queue* completion_queue, nvme::Queue* submission_queue) {
+  void AddQueuePair(size_t queue_id, nvme::Queue* completion_queue, nvme::Queue* submission_queue,
+                    size_t interrupt_vector = 0) {
     completion_queues_.emplace(
         queue_id,
         QueueState{
             .queue = completion_queue,
             .consumer_location = static_cast<uint16_t>(completion_queue->entry_count() - 1),
             .producer_location = 0,
+            .interrupt_vector = interrupt_vector,
         });
 
     submission_queues_.emplace(queue_id, QueueState{
@@ -94,6 +101,8 @@ class FakeNvmeController {
     // Only used by completion queues. Phase bit that should be sit
     // in completion queue entries so that the NVME driver consumes them.
     uint8_t phase = 1;
+    // Only used by completion queues. Interrupt to trigger when a completion is posted.
+    size_t interrupt_vector = 0;
   };
   // Controller-side information about an interrupt.
   class IrqState {
@@ -9,7 +9,9 @@
 #include <lib/fdf/dispatcher.h>
 #include <lib/fit/defer.h>
 #include <lib/inspect/testing/cpp/zxtest/inspect.h>
+#include <zircon/syscalls.h>
 
+#include <algorithm>
 #include <memory>
 
 #include <zxtest/zxtest.h>
@@ -76,7 +78,7 @@ class NvmeTest : public inspect::InspectTestHelper, public zxtest::Test {
         std::make_unique<Nvme>(fake_root_.get(), ddk::Pci(), controller_.registers().GetBuffer());
     driver->bti_ = std::move(fake_bti);
     driver->dispatcher_ = dispatcher_.borrow();
-    driver->irq_ = std::move(*irq);
+    driver->irqs_.push_back(std::move(*irq));
     ASSERT_OK(driver->Bind());
     __UNUSED auto unused = driver.release();
 
@@ -120,6 +122,18 @@ TEST_F(NvmeTest, BasicTest) {
                             fake_nvme::DefaultAdminCommands::kSerialNumber);
 }
 
+TEST_F(NvmeTest, CreatesIoQueues) {
+  ASSERT_NO_FATAL_FAILURE(RunInit());
+  const size_t expected =
+      std::min(zx_system_get_num_cpus(), fake_nvme::DefaultAdminCommands::kMaxIoQueues);
+  ASSERT_EQ(expected, nvme_->io_queues_.size());
+  ASSERT_EQ(expected, controller_.io_queue_count());
+  for (size_t i = 0; i < nvme_->io_queues_.size(); i++) {
+    // All of the queues share the only interrupt.
+    EXPECT_EQ(0, nvme_->IoQueueInterruptVector(i));
+  }
+}
+
 TEST_F(NvmeTest, NamespaceBlockSize) {
   fake_nvme::FakeNvmeNamespace ns;
   controller_.AddNamespace(1, ns);
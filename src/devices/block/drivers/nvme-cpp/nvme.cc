@@ -12,10 +12,13 @@
 #include <zircon/syscalls.h>
 #include <zircon/types.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 
+#include "src/devices/block/drivers/nvme-cpp/commands/features.h"
 #include "src/devices/block/drivers/nvme-cpp/commands/identify.h"
+#include "src/devices/block/drivers/nvme-cpp/commands/queue.h"
 #include "src/devices/block/drivers/nvme-cpp/namespace.h"
 #include "src/devices/block/drivers/nvme-cpp/nvme-bind.h"
 #include "src/devices/block/drivers/nvme-cpp/registers.h"
@@ -55,8 +58,15 @@ zx_status_t Nvme::Bind(void* ctx, zx_device_t* dev) {
 }
 
 zx_status_t Nvme::InitPciAndDispatcher() {
+  // Ask for an MSI-X vector for each I/O queue we might create. Anything else only gets one
+  // interrupt, which all of the queues share.
+  uint32_t irq_count = std::min(zx_system_get_num_cpus(), kMaxIoQueues);
   fuchsia_hardware_pci::InterruptMode mode;
-  zx_status_t status = pci_.ConfigureInterruptMode(1, &mode);
+  zx_status_t status = pci_.ConfigureInterruptMode(irq_count, &mode);
+  if (irq_count > 1 && (status != ZX_OK || mode != fuchsia_hardware_pci::InterruptMode::kMsiX)) {
+    irq_count = 1;
+    status = pci_.ConfigureInterruptMode(irq_count, &mode);
+  }
   if (status != ZX_OK) {
     zxlogf(ERROR, "Failed to configure interrupt: %s", zx_status_get_string(status));
     return status;
@@ -64,10 +74,14 @@ zx_status_t Nvme::InitPciAndDispatcher() {
 
   is_msix_ = (mode == fuchsia_hardware_pci::InterruptMode::kMsiX);
 
-  status = pci_.MapInterrupt(0, &irq_);
-  if (status != ZX_OK) {
-    zxlogf(ERROR, "Failed to map interrupt: %s", zx_status_get_string(status));
-    return status;
+  for (uint32_t i = 0; i < irq_count; i++) {
+    zx::interrupt irq;
+    status = pci_.MapInterrupt(i, &irq);
+    if (status != ZX_OK) {
+      zxlogf(ERROR, "Failed to map interrupt %u: %s", i, zx_status_get_string(status));
+      return status;
+    }
+    irqs_.push_back(std::move(irq));
   }
 
   status = pci_.SetBusMastering(true);
@@ -140,14 +154,6 @@ void Nvme::ResetAndPrepareQueues(zx::duration waited) {
   }
   admin_queue_ = std::move(*admin_queue);
 
-  auto io_queue = QueuePair::Create(bti_.borrow(), 0, caps_.max_queue_entries(), caps_, mmio_);
-  if (io_queue.is_error()) {
-    zxlogf(ERROR, "failed to set up admin queue: %s", io_queue.status_string());
-    init_txn_->Reply(io_queue.error_value());
-    return;
-  }
-  io_queue_ = std::move(*io_queue);
-
   // Configure the admin queue.
   AdminQueueAttributesReg::Get()
       .ReadFrom(&mmio_)
@@ -210,11 +216,17 @@ void Nvme::WaitForReadyAndStart(zx::duration waited) {
   // interrogating it to determine the available storage drives.
   zx_status_t status;
   auto finish = fit::defer([this, &status]() { init_txn_->Reply(status); });
-  irq_handler_.set_object(irq_.get());
-  status = irq_handler_.Begin(dispatcher_->async_dispatcher());
-  if (status != ZX_OK) {
-    zxlogf(ERROR, "Failed to listen for IRQ: %s", zx_status_get_string(status));
-    return;
+  for (size_t i = 0; i < irqs_.size(); i++) {
+    auto handler = std::make_unique<async::Irq>(
+        irqs_[i].get(), 0,
+        [this, i](async_dispatcher_t*, async::IrqBase*, zx_status_t status,
+                  const zx_packet_interrupt_t*) { IrqHandler(i, status); });
+    status = handler->Begin(dispatcher_->async_dispatcher());
+    if (status != ZX_OK) {
+      zxlogf(ERROR, "Failed to listen for IRQ %zu: %s", i, zx_status_get_string(status));
+      return;
+    }
+    irq_handlers_.push_back(std::move(handler));
   }
 
   zx::vmo identify_data;
@@ -276,9 +288,8 @@ void Nvme::WaitForReadyAndStart(zx::duration waited) {
                   caps_.memory_page_size_min_bytes();
             }
             zxlogf(INFO, "max data transfer size: %u bytes", maximum_data_transfer_size_);
-            init_txn_->Reply(ZX_OK);
 
-            InitializeNamespaces();
+            CreateIoQueues();
           })
           .or_else([this](Completion& result) {
             zxlogf(ERROR, "Identify failed: type=%d code=%d", result.status_code_type(),
@@ -287,6 +298,92 @@ void Nvme::WaitForReadyAndStart(zx::duration waited) {
           }));
 }
 
+void Nvme::CreateIoQueues() {
+  const uint32_t wanted = std::min(zx_system_get_num_cpus(), kMaxIoQueues);
+  SetNumberOfQueuesSubmission submission;
+  submission.set_completion_queue_count(wanted - 1).set_submission_queue_count(wanted - 1);
+
+  executor_->schedule_task(
+      SubmitAdminCommand(submission)
+          .and_then([this, wanted](Completion& result) -> fpromise::promise<void, zx_status_t> {
+            NumberOfQueuesCompletion allocated(result);
+            const size_t count = std::min<size_t>(
+                {wanted, allocated.completion_queue_count() + 1ul,
+                 allocated.submission_queue_count() + 1ul});
+            zxlogf(INFO, "Using %zu I/O queues and %zu interrupts", count, irqs_.size());
+
+            for (size_t i = 0; i < count; i++) {
+              auto io_queue =
+                  QueuePair::Create(bti_.borrow(), i + 1, caps_.max_queue_entries(), caps_, mmio_);
+              if (io_queue.is_error()) {
+                zxlogf(ERROR, "Failed to set up I/O queue %zu: %s", i + 1,
+                       io_queue.status_string());
+                return fpromise::make_result_promise<void, zx_status_t>(
+                    fpromise::error(io_queue.error_value()));
+              }
+              io_queues_.push_back(std::move(*io_queue));
+            }
+            inspect_.GetRoot().CreateUint("io-queues", count, &inspect_);
+            return RegisterIoQueues(0);
+          })
+          .and_then([this]() {
+            init_txn_->Reply(ZX_OK);
+            InitializeNamespaces();
+          })
+          .or_else([this](zx_status_t& status) {
+            zxlogf(ERROR, "Failed to create I/O queues: %s", zx_status_get_string(status));
+            init_txn_->Reply(status);
+          }));
+}
+
+fpromise::promise<void, zx_status_t> Nvme::RegisterIoQueues(size_t index) {
+  if (index == io_queues_.size()) {
+    return fpromise::make_result_promise<void, zx_status_t>(fpromise::ok());
+  }
+  QueuePair& io_queue = *io_queues_[index];
+  const size_t queue_id = index + 1;
+
+  // The completion queue has to exist before the submission queue which uses it.
+  CreateIoCompletionQueueSubmission completion_queue;
+  completion_queue.set_queue_id(queue_id)
+      .set_queue_size(io_queue.completion().entry_count() - 1)
+      .set_interrupt_vector(IoQueueInterruptVector(index))
+      .set_interrupts_enabled(true)
+      .set_contiguous(true);
+  completion_queue.data_pointer[0] = io_queue.completion().GetDeviceAddress();
+
+  CreateIoSubmissionQueueSubmission submission_queue;
+  submission_queue.set_queue_id(queue_id)
+      .set_queue_size(io_queue.submission().entry_count() - 1)
+      .set_completion_queue_id(queue_id)
+      .set_contiguous(true);
+  submission_queue.data_pointer[0] = io_queue.submission().GetDeviceAddress();
+
+  return SubmitAdminCommand(completion_queue)
+      .and_then([this, submission_queue](Completion& result) mutable {
+        return SubmitAdminCommand(submission_queue);
+      })
+      .and_then([this, index](Completion& result) { return RegisterIoQueues(index + 1); });
+}
+
+fpromise::promise<Completion, zx_status_t> Nvme::SubmitAdminCommand(Submission& submission) {
+  auto bridge = fpromise::bridge<Completion, Completion>();
+  auto status = admin_queue_->Submit(submission, std::nullopt, 0, bridge.completer);
+  if (status.is_error()) {
+    zxlogf(ERROR, "Failed to submit admin command 0x%x: %s", submission.opcode(),
+           status.status_string());
+    return fpromise::make_result_promise<Completion, zx_status_t>(
+        fpromise::error(status.error_value()));
+  }
+  return bridge.consumer.promise().or_else(
+      [opcode = submission.opcode()](
+          Completion& result) -> fpromise::result<Completion, zx_status_t> {
+        zxlogf(ERROR, "Admin command 0x%x failed: type=%d code=%d", opcode,
+               result.status_code_type(), result.status_code());
+        return fpromise::error(ZX_ERR_INTERNAL);
+      });
+}
+
 void Nvme::InitializeNamespaces() {
   zx::vmo identify_data;
   zx_status_t status = zx::vmo::create(zx_system_get_page_size(), 0, &identify_data);
@@ -366,8 +463,7 @@ void Nvme::DdkInit(ddk::InitTxn txn) {
   }
 }
 
-void Nvme::IrqHandler(async_dispatcher_t* dispatcher, async::IrqBase* irq, zx_status_t status,
-                      const zx_packet_interrupt_t* interrupt) {
+void Nvme::IrqHandler(size_t vector, zx_status_t status) {
   if (status != ZX_OK) {
     zxlogf(ERROR, "Failed to process interrupt: %s", zx_status_get_string(status));
   }
@@ -377,13 +473,17 @@ void Nvme::IrqHandler(async_dispatcher_t* dispatcher, async::IrqBase* irq, zx_st
     InterruptReg::MaskSet().FromValue(1).WriteTo(&mmio_);
   }
 
-  async::PostTask(dispatcher_->async_dispatcher(), [this]() {
+  async::PostTask(dispatcher_->async_dispatcher(), [this, vector]() {
     // Check queues to see what triggered the IRQ.
-    admin_queue_->CheckForNewCompletions();
-    io_queue_->CheckForNewCompletions();
+    if (vector == 0) {
+      admin_queue_->CheckForNewCompletions();
+    }
+    for (size_t i = vector; i < io_queues_.size(); i += irqs_.size()) {
+      io_queues_[i]->CheckForNewCompletions();
+    }
 
     if (is_msix_) {
-      irq_.ack();
+      irqs_[vector].ack();
     } else {
       // Unmask the interrupt
       InterruptReg::MaskClear().FromValue(1).WriteTo(&mmio_);
@@ -394,7 +494,7 @@ void Nvme::IrqHandler(async_dispatcher_t* dispatcher, async::IrqBase* irq, zx_st
   // If we are using MSI-X, we leave it unacked (and masked) until we're finished checking for
   // completions.
   if (!is_msix_) {
-    irq_.ack();
+    irqs_[vector].ack();
   }
 }
 
@@ -406,7 +506,9 @@ void Nvme::DdkUnbind(ddk::UnbindTxn txn) {
     executor_.reset();
     // TODO(fxb/103753): Currently the runtime dispatcher expects the interrupt to be cancelled from
     // the synchronized dispatcher thread.
-    irq_handler_.Cancel();
+    for (auto& handler : irq_handlers_) {
+      handler->Cancel();
+    }
     txn.Reply();
   });
 }
@@ -12,8 +12,12 @@
 #include <lib/ddk/io-buffer.h>
 #include <lib/device-protocol/pci.h>
 #include <lib/fdf/cpp/dispatcher.h>
+#include <lib/fpromise/promise.h>
 #include <lib/inspect/cpp/inspect.h>
 
+#include <memory>
+#include <vector>
+
 #include <ddktl/device.h>
 #include <ddktl/unbind-txn.h>
 
@@ -36,6 +40,9 @@ class Nvme : public DeviceType {
       : DeviceType(parent), pci_(std::move(pci)), mmio_(std::move(buffer)) {}
   virtual ~Nvme() = default;
 
+  // The most I/O queue pairs we use. We try to have one per CPU, each with its own interrupt.
+  static constexpr uint32_t kMaxIoQueues = 32;
+
   static zx_status_t Bind(void* ctx, zx_device_t* dev);
   zx_status_t Bind();
   void DdkInit(ddk::InitTxn txn);
@@ -65,11 +72,23 @@ class Nvme : public DeviceType {
   // to find out about it.
   void WaitForReadyAndStart(zx::duration waited);
 
+  // Called once the controller has been identified. Asks it for I/O queues and registers them
+  // with it, before replying to |init_txn_|.
+  void CreateIoQueues();
+  // Registers |io_queues_| with the controller, starting at |index|.
+  fpromise::promise<void, zx_status_t> RegisterIoQueues(size_t index);
+  // Submits a command without any data to the admin queue.
+  fpromise::promise<Completion, zx_status_t> SubmitAdminCommand(Submission& submission);
+
   // Enumerate namespaces attached to this controller, and create devices for them.
   void InitializeNamespaces();
 
-  void IrqHandler(async_dispatcher_t* dispatcher, async::IrqBase* irq, zx_status_t status,
-                  const zx_packet_interrupt_t* interrupt);
+  // The interrupt vector which signals completions on |io_queues_[index]|.
+  size_t IoQueueInterruptVector(size_t index) const { return index % irqs_.size(); }
+
+  // Handles interrupt vector |vector|, which signals completions on the admin queue (for vector 0)
+  // and on the I/O queues assigned to it.
+  void IrqHandler(size_t vector, zx_status_t status);
 
   inspect::Inspector inspect_;
   ddk::Pci pci_;
@@ -80,16 +99,17 @@ class Nvme : public DeviceType {
 
   std::optional<ddk::InitTxn> init_txn_;
 
-  // For now, we only have a single I/O completion queue and a single interrupt.
-  zx::interrupt irq_;
-  async::IrqMethod<Nvme, &Nvme::IrqHandler> irq_handler_{this};
+  // One interrupt per I/O queue if MSI-X provides enough of them, otherwise the I/O queues share
+  // them round-robin. The first one is shared with the admin queue.
+  std::vector<zx::interrupt> irqs_;
+  std::vector<std::unique_ptr<async::Irq>> irq_handlers_;
   // MSI-X affects how we mask/unmask interrupts.
   bool is_msix_ = false;
 
   // Admin queues (completion and submission)
   std::unique_ptr<QueuePair> admin_queue_;
-  // IO queues (completion and submission)
-  std::unique_ptr<QueuePair> io_queue_;
+  // IO queues (completion and submission). The queue at index i has queue ID i + 1.
+  std::vector<std::unique_ptr<QueuePair>> io_queues_;
 
   fdf::UnownedDispatcher dispatcher_;
   std::unique_ptr<async::Executor> executor_;
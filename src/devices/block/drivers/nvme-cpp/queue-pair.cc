@@ -108,9 +108,9 @@ zx::status<> QueuePair::Submit(cpp20::span<uint8_t> submission_data,
   // We do not support metadata.
   submission->metadata_pointer = 0;
   submission->set_cid(static_cast<uint32_t>(index)).set_fused(0).set_data_transfer_mode(0);
-  submission->data_pointer[0] = submission->data_pointer[1] = 0;
 
   if (data_vmo.has_value()) {
+    submission->data_pointer[0] = submission->data_pointer[1] = 0;
     // Map the VMO in.
     zx_status_t status =
         txn_data.buffer.InitVmo(bti_->get(), data_vmo.value()->get(), vmo_offset, IO_BUFFER_RW);
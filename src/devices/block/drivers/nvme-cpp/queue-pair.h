@@ -67,6 +67,8 @@ class QueuePair {
 
   // Submit will take ownership of |completer| only if submission succeeds. If submission fails, it
   // is up to the caller to appropriately fail the completer.
+  // If there is no |data|, the data pointers in |submission| are passed to the controller as they
+  // are. Commands such as "Create I/O Completion Queue" use them for other addresses.
   zx::status<> Submit(Submission& submission, std::optional<zx::unowned_vmo> data,
                       zx_off_t vmo_offset, TransactionData::Completer& completer) {
     return Submit(cpp20::span<uint8_t>(reinterpret_cast<uint8_t*>(&submission), sizeof(submission)),
@@ -106,7 +106,19 @@ zx_status_t BlockDevice::Init() {
 
   DriverStatusAck();
 
-  // TODO: Check features bits and ack/nak them
+  if (DeviceFeatureSupported(VIRTIO_F_VERSION_1)) {
+    DriverFeatureAck(VIRTIO_F_VERSION_1);
+  }
+  // Lets each side skip notifying the other while it's still busy with earlier requests.
+  const bool event_idx = DeviceFeatureSupported(VIRTIO_RING_F_EVENT_IDX);
+  if (event_idx) {
+    DriverFeatureAck(VIRTIO_RING_F_EVENT_IDX);
+  }
+  zx_status_t status = DeviceStatusFeaturesOk();
+  if (status != ZX_OK) {
+    zxlogf(ERROR, "%s: Feature negotiation failed (%d)", tag(), status);
+    return status;
+  }
 
   // Allocate the main vring.
   auto err = vring_.Init(0, ring_size);
@@ -114,12 +126,14 @@ zx_status_t BlockDevice::Init() {
     zxlogf(ERROR, "failed to allocate vring");
     return err;
   }
+  if (event_idx) {
+    vring_.EnableEventIdx();
+  }
 
   // Allocate a queue of block requests.
   size_t size = sizeof(virtio_blk_req_t) * blk_req_count + sizeof(uint8_t) * blk_req_count;
 
-  zx_status_t status =
-      io_buffer_init(&blk_req_buf_, bti_.get(), size, IO_BUFFER_RW | IO_BUFFER_CONTIG);
+  status = io_buffer_init(&blk_req_buf_, bti_.get(), size, IO_BUFFER_RW | IO_BUFFER_CONTIG);
   if (status != ZX_OK) {
     zxlogf(ERROR, "cannot alloc blk_req buffers %d", status);
     return status;
@@ -468,7 +482,7 @@ void BlockDevice::WorkerThread() {
         fbl::AutoLock lock(&txn_lock_);
         list_add_tail(&pending_txn_list_, &txn->node);
         vring_.SubmitChain(idx);
-        vring_.Kick();
+        kick_needed_ = true;
         LTRACEF("WorkerThread submitted txn %p\n", txn);
         break;
       }
@@ -499,6 +513,7 @@ void BlockDevice::WorkerThread() {
         sync_completion_reset(&txn_signal_);
       }
 
+      KickSubmittedTxns();
       sync_completion_wait(&txn_signal_, ZX_TIME_INFINITE);
       if (worker_shutdown_.load()) {
         return;
@@ -510,10 +525,30 @@ void BlockDevice::WorkerThread() {
     if (do_flush) {
       FlushPendingTxns();
     }
+
+    // Txns that were queued together are all submitted before the device is told about them, so
+    // that they cost a single notification.
+    bool more_queued;
+    {
+      fbl::AutoLock lock(&lock_);
+      more_queued = !list_is_empty(&worker_txn_list_);
+    }
+    if (!more_queued) {
+      KickSubmittedTxns();
+    }
+  }
+}
+
+void BlockDevice::KickSubmittedTxns() {
+  fbl::AutoLock lock(&txn_lock_);
+  if (kick_needed_) {
+    vring_.Kick();
+    kick_needed_ = false;
   }
 }
 
 void BlockDevice::FlushPendingTxns() {
+  KickSubmittedTxns();
   for (;;) {
     {
       fbl::AutoLock lock(&txn_lock_);
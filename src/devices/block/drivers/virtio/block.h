@@ -69,6 +69,9 @@ class BlockDevice : public Device,
   void FlushPendingTxns();
   void CleanupPendingTxns();
 
+  // Notifies the device of the txns that have been submitted since it was last notified.
+  void KickSubmittedTxns();
+
   zx_status_t QueueTxn(block_txn_t* txn, uint32_t type, size_t bytes, zx_paddr_t* pages,
                        size_t pagecount, uint16_t* idx);
 
@@ -116,6 +119,9 @@ class BlockDevice : public Device,
   fbl::Mutex txn_lock_;
   list_node pending_txn_list_ = LIST_INITIAL_VALUE(pending_txn_list_);
   sync_completion_t txn_signal_;
+  // Set if txns have been submitted to the ring that the device hasn't been told about. Guarded by
+  // txn_lock_.
+  bool kick_needed_ = false;
 
   // Worker state.
   thrd_t worker_thread_;
@@ -8,7 +8,9 @@
 #include <lib/fake_ddk/fake_ddk.h>
 #include <lib/sync/completion.h>
 #include <lib/virtio/backends/fake.h>
+#include <lib/zx/time.h>
 
+#include <atomic>
 #include <condition_variable>
 #include <memory>
 
@@ -42,8 +44,53 @@ class FakeBackendForBlock : public virtio::FakeBackend {
 
   void set_status(uint8_t status) { status_ = status; }
 
+  // Offers VIRTIO_RING_F_EVENT_IDX. The device then only interrupts once the driver has seen the
+  // chains used before, as published in used_event, and asks to be kicked again through
+  // avail_event after it has processed the avail ring.
+  void OfferEventIdx() {
+    OfferFeature(VIRTIO_RING_F_EVENT_IDX);
+    event_idx_ = true;
+  }
+
+  // While kicks are deferred, the device only counts them, as if it was still busy with earlier
+  // chains. The chains are processed by the next |ProcessAvail|.
+  void set_defer_kicks(bool defer) { defer_kicks_ = defer; }
+
+  int kicks() const { return kicks_; }
+
+  void WaitForKicks(int kicks) {
+    while (kicks_ < kicks) {
+      zx::nanosleep(zx::deadline_after(zx::msec(1)));
+    }
+  }
+
   void RingKick(uint16_t ring_index) override {
     FakeBackend::RingKick(ring_index);
+    kicks_++;
+    if (!defer_kicks_) {
+      ProcessAvail();
+    }
+  }
+
+  // Waits until the driver has made |idx| chains available in total.
+  void WaitForAvail(uint16_t idx) {
+    for (;;) {
+      fake_bti_pinned_vmo_info_t vmos[16];
+      size_t count;
+      ASSERT_OK(fake_bti_get_pinned_vmos(fake_bti_, vmos, 16, &count));
+      ASSERT_LE(2, count);
+      vring_avail avail;
+      ASSERT_OK(zx_vmo_read(vmos[0].vmo, &avail, vmos[0].offset + avail_offset_, sizeof(avail)));
+      if (avail.idx == idx) {
+        return;
+      }
+      zx::nanosleep(zx::deadline_after(zx::msec(1)));
+    }
+  }
+
+  // Completes every chain the driver has made available.
+  void ProcessAvail() {
+    std::scoped_lock ring_lock(ring_mutex_);
 
     fake_bti_pinned_vmo_info_t vmos[16];
     size_t count;
@@ -55,6 +102,7 @@ class FakeBackendForBlock : public virtio::FakeBackend {
       struct __PACKED {
         uint8_t header[sizeof(vring_used)];
         vring_used_elem elements[kRingSize];
+        uint16_t avail_event;
       };
     } used;
     union __PACKED Avail {
@@ -62,6 +110,7 @@ class FakeBackendForBlock : public virtio::FakeBackend {
       struct __PACKED {
         uint8_t header[sizeof(vring_avail)];
         uint16_t ring[kRingSize];
+        uint16_t used_event;
       };
     } avail;
 
@@ -69,9 +118,8 @@ class FakeBackendForBlock : public virtio::FakeBackend {
     ASSERT_OK(zx_vmo_read(vmos[0].vmo, &used, vmos[0].offset + used_offset_, sizeof(used)));
     ASSERT_OK(zx_vmo_read(vmos[0].vmo, &avail, vmos[0].offset + avail_offset_, sizeof(avail)));
 
-    if (avail.head.idx != used.head.idx) {
-      ASSERT_EQ(avail.head.idx, used.head.idx + 1);  // We can only handle one queued entry.
-
+    const uint16_t old_used_idx = used.head.idx;
+    while (avail.head.idx != used.head.idx) {
       size_t index = used.head.idx & (kRingSize - 1);
 
       // Read the descriptors.
@@ -98,19 +146,32 @@ class FakeBackendForBlock : public virtio::FakeBackend {
       used.elements[index].len = count;
 
       ++used.head.idx;
+    }
+    if (event_idx_) {
+      // Ask to be kicked for the next chain made available.
+      used.avail_event = avail.head.idx;
+    }
 
-      ASSERT_OK(zx_vmo_write(vmos[0].vmo, &used, vmos[0].offset + used_offset_, sizeof(used)));
-
-      // Trigger an interrupt.
-      uint8_t isr_status;
-      ReadRegister(kISRStatus, &isr_status);
-      isr_status |= VIRTIO_ISR_QUEUE_INT;
-      SetRegister(kISRStatus, isr_status);
+    ASSERT_OK(zx_vmo_write(vmos[0].vmo, &used, vmos[0].offset + used_offset_, sizeof(used)));
 
-      std::scoped_lock lock(mutex_);
-      interrupt_ = true;
-      cond_.notify_all();
+    if (used.head.idx == old_used_idx) {
+      return;
     }
+    // Without EVENT_IDX the driver is interrupted for every chain used. With it, the driver is only
+    // interrupted if it has seen the chains used before.
+    if (event_idx_ && !vring_need_event(avail.used_event, used.head.idx, old_used_idx)) {
+      return;
+    }
+
+    // Trigger an interrupt.
+    uint8_t isr_status;
+    ReadRegister(kISRStatus, &isr_status);
+    isr_status |= VIRTIO_ISR_QUEUE_INT;
+    SetRegister(kISRStatus, isr_status);
+
+    std::scoped_lock lock(mutex_);
+    interrupt_ = true;
+    cond_.notify_all();
   }
 
   zx_status_t SetRing(uint16_t index, uint16_t count, zx_paddr_t pa_desc, zx_paddr_t pa_avail,
@@ -158,6 +219,12 @@ class FakeBackendForBlock : public virtio::FakeBackend {
 
   zx_handle_t fake_bti_;
 
+  bool event_idx_ = false;
+  std::atomic<bool> defer_kicks_ = false;
+  std::atomic<int> kicks_ = 0;
+  // Serializes the processing of the avail ring between the driver's kicks and the test.
+  std::mutex ring_mutex_;
+
   std::mutex mutex_;
   std::condition_variable cond_;
   bool terminate_ = false;
@@ -184,11 +251,15 @@ class BlockDeviceTest : public zxtest::Test {
  public:
   ~BlockDeviceTest() {}
 
-  void InitDevice(uint8_t status = VIRTIO_BLK_S_OK) {
+  void InitDevice(uint8_t status = VIRTIO_BLK_S_OK, bool event_idx = false) {
     zx::bti bti(ZX_HANDLE_INVALID);
     ASSERT_OK(fake_bti_create(bti.reset_and_get_address()));
     auto backend = std::make_unique<FakeBackendForBlock>(bti.get());
     backend->set_status(status);
+    if (event_idx) {
+      backend->OfferEventIdx();
+    }
+    backend_ = backend.get();
     ddk_ = std::make_unique<fake_ddk::Bind>();
     device_ = std::make_unique<virtio::BlockDevice>(fake_ddk::FakeParent(), std::move(bti),
                                                     std::move(backend));
@@ -208,6 +279,21 @@ class BlockDeviceTest : public zxtest::Test {
     sync_completion_signal(&operation->event_);
   }
 
+  // Queues a read of one block into |vmo|, completing |txn| into |completion|.
+  void QueueRead(virtio::block_txn_t* txn, const zx::vmo& vmo, sync_completion_t* completion) {
+    memset(txn, 0, sizeof(*txn));
+    txn->op.rw.command = BLOCK_OP_READ;
+    txn->op.rw.length = 1;
+    txn->op.rw.vmo = vmo.get();
+    device_->BlockImplQueue(
+        reinterpret_cast<block_op_t*>(txn),
+        [](void* cookie, zx_status_t status, block_op_t* op) {
+          EXPECT_OK(status);
+          sync_completion_signal(static_cast<sync_completion_t*>(cookie));
+        },
+        completion);
+  }
+
   bool Wait() {
     zx_status_t status = sync_completion_wait(&event_, ZX_SEC(5));
     sync_completion_reset(&event_);
@@ -218,6 +304,7 @@ class BlockDeviceTest : public zxtest::Test {
 
  protected:
   std::unique_ptr<virtio::BlockDevice> device_;
+  FakeBackendForBlock* backend_ = nullptr;
   block_info_t info_;
   size_t operation_size_;
 
@@ -295,4 +382,88 @@ TEST_F(BlockDeviceTest, ReadError) {
   RemoveDevice();
 }
 
+TEST_F(BlockDeviceTest, EventIdxIsNegotiated) {
+  InitDevice(VIRTIO_BLK_S_OK, /*event_idx=*/true);
+  EXPECT_TRUE(backend_->FeatureAcked(VIRTIO_RING_F_EVENT_IDX));
+  RemoveDevice();
+
+  InitDevice();
+  EXPECT_FALSE(backend_->FeatureAcked(VIRTIO_RING_F_EVENT_IDX));
+  RemoveDevice();
+}
+
+// The device only interrupts if the driver has published used_event for the chains used before,
+// so every request after the first one relies on it.
+TEST_F(BlockDeviceTest, EventIdxPublishesUsedEvent) {
+  InitDevice(VIRTIO_BLK_S_OK, /*event_idx=*/true);
+
+  zx::vmo vmo;
+  ASSERT_OK(zx::vmo::create(zx_system_get_page_size(), 0, &vmo));
+  for (int i = 0; i < 5; ++i) {
+    virtio::block_txn_t txn;
+    sync_completion_t completion;
+    QueueRead(&txn, vmo, &completion);
+    ASSERT_OK(sync_completion_wait(&completion, ZX_SEC(5)), "request %d", i);
+  }
+  EXPECT_EQ(backend_->kicks(), 5);
+
+  RemoveDevice();
+}
+
+// While the device hasn't processed the avail ring since the last kick, it hasn't asked for
+// another one through avail_event, and the driver doesn't kick it again.
+TEST_F(BlockDeviceTest, EventIdxSuppressesKicksUntilAvailEvent) {
+  InitDevice(VIRTIO_BLK_S_OK, /*event_idx=*/true);
+
+  zx::vmo vmo;
+  ASSERT_OK(zx::vmo::create(zx_system_get_page_size(), 0, &vmo));
+  backend_->set_defer_kicks(true);
+  virtio::block_txn_t txns[3];
+  sync_completion_t completions[3];
+  QueueRead(&txns[0], vmo, &completions[0]);
+  backend_->WaitForKicks(1);
+  QueueRead(&txns[1], vmo, &completions[1]);
+  backend_->WaitForAvail(2);
+
+  // The device gets to both requests on its own, and asks to be kicked for the next one.
+  backend_->set_defer_kicks(false);
+  backend_->ProcessAvail();
+  ASSERT_OK(sync_completion_wait(&completions[0], ZX_SEC(5)));
+  ASSERT_OK(sync_completion_wait(&completions[1], ZX_SEC(5)));
+
+  QueueRead(&txns[2], vmo, &completions[2]);
+  ASSERT_OK(sync_completion_wait(&completions[2], ZX_SEC(5)));
+  // The worker kicks in order, so any kick for the second request would have come before the one
+  // which completed the third.
+  EXPECT_EQ(backend_->kicks(), 2);
+
+  RemoveDevice();
+}
+
+// Without EVENT_IDX, every request which isn't batched with others is kicked.
+TEST_F(BlockDeviceTest, KicksWithoutEventIdx) {
+  InitDevice();
+
+  zx::vmo vmo;
+  ASSERT_OK(zx::vmo::create(zx_system_get_page_size(), 0, &vmo));
+  backend_->set_defer_kicks(true);
+  virtio::block_txn_t txns[3];
+  sync_completion_t completions[3];
+  QueueRead(&txns[0], vmo, &completions[0]);
+  backend_->WaitForKicks(1);
+  QueueRead(&txns[1], vmo, &completions[1]);
+  backend_->WaitForKicks(2);
+
+  backend_->set_defer_kicks(false);
+  backend_->ProcessAvail();
+  ASSERT_OK(sync_completion_wait(&completions[0], ZX_SEC(5)));
+  ASSERT_OK(sync_completion_wait(&completions[1], ZX_SEC(5)));
+
+  QueueRead(&txns[2], vmo, &completions[2]);
+  ASSERT_OK(sync_completion_wait(&completions[2], ZX_SEC(5)));
+  EXPECT_EQ(backend_->kicks(), 3);
+
+  RemoveDevice();
+}
+
 }  // anonymous namespace
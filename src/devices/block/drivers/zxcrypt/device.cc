@@ -10,6 +10,7 @@
 #include <string.h>
 #include <zircon/errors.h>
 #include <zircon/status.h>
+#include <zircon/syscalls.h>
 #include <zircon/syscalls/port.h>
 
 #include <algorithm>
@@ -53,7 +54,15 @@ zx_status_t Device::Init(const DdkVolume& volume) {
   }
 
   // Start workers
-  for (size_t i = 0; i < kNumWorkers; ++i) {
+  const size_t num_workers =
+      std::clamp(size_t{zx_system_get_num_cpus()}, kMinWorkers, kMaxWorkers);
+  fbl::AllocChecker ac;
+  workers_ = fbl::Array<Worker>(new (&ac) Worker[num_workers], num_workers);
+  if (!ac.check()) {
+    zxlogf(ERROR, "failed to allocate %zu workers", num_workers);
+    return ZX_ERR_NO_MEMORY;
+  }
+  for (size_t i = 0; i < workers_.size(); ++i) {
     if ((rc = workers_[i].Start(this, volume, worker_queue_)) != ZX_OK) {
       zxlogf(ERROR, "failed to start worker %zu: %s", i, zx_status_get_string(rc));
       return rc;
@@ -127,8 +136,8 @@ void Device::DdkRelease() {
 
   // Stop workers; send a stop message to each, then join each (possibly in different order).
   StopWorkersIfDone();
-  for (size_t i = 0; i < kNumWorkers; ++i) {
-    workers_[i].Stop();
+  for (Worker& worker : workers_) {
+    worker.Stop();
   }
 }
 
@@ -22,6 +22,7 @@
 #include <bitmap/raw-bitmap.h>
 #include <bitmap/storage.h>
 #include <ddktl/device.h>
+#include <fbl/array.h>
 #include <fbl/macros.h>
 #include <fbl/mutex.h>
 
@@ -92,9 +93,11 @@ class Device final : public DeviceType,
  private:
   DISALLOW_COPY_ASSIGN_AND_MOVE(Device);
 
-  // TODO(aarongreen): Investigate performance impact of changing this.
-  // Number of encrypting/decrypting workers
-  static const size_t kNumWorkers = 2;
+  // Bounds on the number of encrypting/decrypting workers, which is otherwise one per CPU. While
+  // a worker is transforming one request, the requests before it are with the parent device, so
+  // even a single CPU benefits from having more than one worker.
+  static constexpr size_t kMinWorkers = 2;
+  static constexpr size_t kMaxWorkers = 8;
 
   // Adds |block| to the write queue if not null, and sends to the workers as many write requests
   // as fit in the space available in the write buffer.
@@ -126,8 +129,8 @@ class Device final : public DeviceType,
   // will hold a reference to the queue and should therefore be destroyed first.
   Queue<block_op_t*> worker_queue_;
 
-  // Threads that performs encryption/decryption.
-  Worker workers_[kNumWorkers];
+  // Threads that performs encryption/decryption. Allocated by |Init|.
+  fbl::Array<Worker> workers_;
 
   // Primary lock for accessing the write queue
   fbl::Mutex mtx_;
@@ -142,7 +142,6 @@ bool PciLegacyBackend::ReadFeature(uint32_t feature) {
   fbl::AutoLock guard(&lock());
   uint32_t val;
 
-  ZX_DEBUG_ASSERT((feature & (feature - 1)) == 0);
   legacy_io_->Read(bar0_base_ + VIRTIO_PCI_DEVICE_FEATURES, &val);
   bool is_set = (val & (1u << feature)) > 0;
   zxlogf(TRACE, "%s: read feature bit %u = %u", tag(), feature, is_set);
@@ -157,7 +156,6 @@ void PciLegacyBackend::SetFeature(uint32_t feature) {
 
   fbl::AutoLock guard(&lock());
   uint32_t val;
-  ZX_DEBUG_ASSERT((feature & (feature - 1)) == 0);
   legacy_io_->Read(bar0_base_ + VIRTIO_PCI_DRIVER_FEATURES, &val);
   legacy_io_->Write(bar0_base_ + VIRTIO_PCI_DRIVER_FEATURES, val | (1u << feature));
   zxlogf(TRACE, "%s: feature bit %u now set", tag(), feature);
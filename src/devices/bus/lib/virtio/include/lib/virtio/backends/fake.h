@@ -36,8 +36,11 @@ class FakeBackend : public Backend {
 
   zx_status_t Bind() override { return ZX_OK; }
   void Unbind() override {}
-  bool ReadFeature(uint32_t bit) override { return false; }
-  void SetFeature(uint32_t bit) override { EXPECT_NE(state_, State::DRIVER_OK); }
+  bool ReadFeature(uint32_t bit) override { return offered_features_.count(bit) > 0; }
+  void SetFeature(uint32_t bit) override {
+    EXPECT_NE(state_, State::DRIVER_OK);
+    acked_features_.insert(bit);
+  }
   zx_status_t ConfirmFeatures() override { return ZX_OK; }
   void DriverStatusOk() override {
     EXPECT_EQ(state_, State::DEVICE_STATUS_ACK);
@@ -104,6 +107,9 @@ class FakeBackend : public Backend {
 
   State DeviceState() const { return state_; }
 
+  // Returns true if the driver has acked feature |bit|.
+  bool FeatureAcked(uint32_t bit) const { return acked_features_.count(bit) > 0; }
+
  protected:
   // virtio header register offsets.
   static constexpr uint16_t kDeviceFeatures = 0;
@@ -132,6 +138,9 @@ class FakeBackend : public Backend {
     irq_mode() = PCI_INTERRUPT_MODE_LEGACY;
   }
 
+  // Offers feature |bit| to the driver. No features are offered by default.
+  void OfferFeature(uint32_t bit) { offered_features_.insert(bit); }
+
   // Returns true if a queue has been kicked (notified) and clears the notified bit.
   bool QueueKicked(uint16_t queue_index) {
     bool is_queue_kicked = (kicked_queues_.count(queue_index));
@@ -186,6 +195,8 @@ class FakeBackend : public Backend {
   std::map<uint16_t, uint32_t> registers32_;
   std::map<uint16_t, uint16_t> queue_sizes_;
   std::set<uint16_t> kicked_queues_;
+  std::set<uint32_t> offered_features_;
+  std::set<uint32_t> acked_features_;
 };
 
 }  // namespace virtio
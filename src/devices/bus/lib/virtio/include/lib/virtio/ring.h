@@ -27,9 +27,17 @@ class Ring {
   zx_status_t Init(uint16_t index);
   zx_status_t Init(uint16_t index, uint16_t count);
 
+  // Enables the notification suppression of VIRTIO_RING_F_EVENT_IDX, which must have been
+  // negotiated with the device. |Kick| then only notifies the device if it has asked to be told
+  // about the chains submitted since the last kick, and |IrqRingUpdate| asks the device to only
+  // interrupt again once it has used a chain the driver hasn't seen.
+  void EnableEventIdx() { event_idx_ = true; }
+
   void FreeDesc(uint16_t desc_index);
   struct vring_desc* AllocDescChain(uint16_t count, uint16_t* start_index);
   void SubmitChain(uint16_t desc_index);
+  // Notifies the device of every chain submitted since the last kick, so several chains can be
+  // submitted for the cost of one notification.
   void Kick();
 
   struct vring_desc* DescFromIndex(uint16_t index) {
@@ -68,6 +76,10 @@ class Ring {
   uint16_t index_ = 0;
 
   vring ring_ = {};
+
+  bool event_idx_ = false;
+  // avail->idx as of the last call to |Kick|.
+  uint16_t kicked_avail_idx_ = 0;
 };
 
 // perform the main loop of finding free descriptor chains and passing it to a passed in function
@@ -76,22 +88,35 @@ inline void Ring::IrqRingUpdate(T free_chain) {
   zxlogf(TRACE, "used flags %#x idx %#x last_used %u", ring_.used->flags, ring_.used->idx,
          ring_.last_used);
 
-  // find a new free chain of descriptors
-  uint16_t cur_idx = ring_.used->idx;
-  uint16_t i = ring_.last_used;
-  // Read memory barrier before processing a descriptor chain. If we see an updated used->idx
-  // we must see updated descriptor chains in the used ring.
-  hw_rmb();
-  for (; i != cur_idx; ++i) {
-    // TRACEF("looking at idx %u\n", i);
-
-    struct vring_used_elem* used_elem = &ring_.used->ring[i & ring_.num_mask];
-    // TRACEF("used chain id %u, len %u\n", used_elem->id, used_elem->len);
-
-    // free the chain
-    free_chain(used_elem);
+  for (;;) {
+    // find a new free chain of descriptors
+    uint16_t cur_idx = ring_.used->idx;
+    uint16_t i = ring_.last_used;
+    // Read memory barrier before processing a descriptor chain. If we see an updated used->idx
+    // we must see updated descriptor chains in the used ring.
+    hw_rmb();
+    for (; i != cur_idx; ++i) {
+      // TRACEF("looking at idx %u\n", i);
+
+      struct vring_used_elem* used_elem = &ring_.used->ring[i & ring_.num_mask];
+      // TRACEF("used chain id %u, len %u\n", used_elem->id, used_elem->len);
+
+      // free the chain
+      free_chain(used_elem);
+    }
+    ring_.last_used = i;
+
+    if (!event_idx_) {
+      return;
+    }
+    // Ask for an interrupt when the next chain is used. The device doesn't interrupt for chains it
+    // used before seeing this, so check for them again after the barrier.
+    vring_used_event(&ring_) = ring_.last_used;
+    hw_mb();
+    if (ring_.used->idx == ring_.last_used) {
+      return;
+    }
   }
-  ring_.last_used = i;
 }
 
 void virtio_dump_desc(const struct vring_desc* desc);
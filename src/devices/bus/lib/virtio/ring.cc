@@ -34,6 +34,8 @@ Ring::Ring(Ring&& other) noexcept {
   other.ring_buf_ = io_buffer_t{};
   ring_ = other.ring_;
   other.ring_ = vring{};
+  event_idx_ = other.event_idx_;
+  kicked_avail_idx_ = other.kicked_avail_idx_;
 }
 
 Ring::~Ring() { io_buffer_release(&ring_buf_); }
@@ -47,6 +49,8 @@ Ring& Ring::operator=(Ring&& other) noexcept {
   other.ring_buf_ = io_buffer_t{};
   ring_ = other.ring_;
   other.ring_ = vring{};
+  event_idx_ = other.event_idx_;
+  kicked_avail_idx_ = other.kicked_avail_idx_;
   return *this;
 }
 
@@ -165,6 +169,17 @@ void Ring::Kick() {
   // before the device sees the wakeup notification (so it processes the latest descriptors).
   hw_mb();
 
+  if (event_idx_) {
+    const uint16_t new_idx = ring_.avail->idx;
+    const uint16_t old_idx = kicked_avail_idx_;
+    kicked_avail_idx_ = new_idx;
+    // The device is still working through the avail ring, and will find the new chains without
+    // being told about them.
+    if (!vring_need_event(vring_avail_event(&ring_), new_idx, old_idx)) {
+      return;
+    }
+  }
+
   device_->RingKick(index_);
 }
 
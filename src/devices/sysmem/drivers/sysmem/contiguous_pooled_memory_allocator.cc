@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <numeric>
+#include <optional>
 
 #include <fbl/string_printf.h>
 
@@ -127,6 +128,9 @@ ContiguousPooledMemoryAllocator::ContiguousPooledMemoryAllocator(
   last_failed_guard_region_check_timestamp_ns_property_ =
       node_.CreateUint("last_failed_guard_region_check_timestamp_ns", 0);
   large_contiguous_region_sum_property_ = node_.CreateUint("large_contiguous_region_sum", 0);
+  free_region_count_property_ = node_.CreateUint("free_region_count", 0);
+  max_free_size_property_ = node_.CreateUint("max_free_size", 0);
+  fragmentation_permille_property_ = node_.CreateUint("fragmentation_permille", 0);
 
   // CMM/PCMM properties - these values aren't quite true yet, but will be soon.
   loanable_efficiency_property_ =
@@ -420,11 +424,8 @@ zx_status_t ContiguousPooledMemoryAllocator::Allocate(uint64_t size,
 
   const uint64_t guard_region_size = has_internal_guard_regions_ ? guard_region_size_ : 0;
   uint64_t allocation_size = size + guard_region_size_ * 2;
-  // TODO(fxbug.dev/43184): Use a fragmentation-reducing allocator (such as best fit).
-  //
   // The "region" param is an out ref.
-  zx_status_t status =
-      region_allocator_.GetRegion(allocation_size, zx_system_get_page_size(), region);
+  zx_status_t status = GetBestFitRegion(allocation_size, region);
   if (status != ZX_OK) {
     LOG(WARNING, "GetRegion failed (out of space?) - size: %zu status: %d", size, status);
     DumpPoolStats();
@@ -1159,6 +1160,34 @@ uint64_t ContiguousPooledMemoryAllocator::CalculateLargeContiguousRegionSize() {
   return top_region_sum;
 }
 
+zx_status_t ContiguousPooledMemoryAllocator::GetBestFitRegion(
+    uint64_t size, RegionAllocator::Region::UPtr& region) {
+  const uint64_t page_size = zx_system_get_page_size();
+  std::optional<ralloc_region_t> best_fit;
+  region_allocator_.WalkAvailableRegions([&](const ralloc_region_t* r) -> bool {
+    const uint64_t aligned_base = fbl::round_up(r->base, page_size);
+    if (aligned_base - r->base > r->size || r->size - (aligned_base - r->base) < size) {
+      return true;
+    }
+    // Regions are walked in address order, so on ties this keeps the lowest region.
+    if (!best_fit || r->size < best_fit->size) {
+      best_fit = *r;
+    }
+    // An exact fit can't be improved on.
+    return r->size != size;
+  });
+  if (!best_fit) {
+    // Same as RegionAllocator::GetRegion() when out of space.
+    return ZX_ERR_NOT_FOUND;
+  }
+  uint64_t base = fbl::round_up(best_fit->base, page_size);
+  if (size >= kLargeAllocationMinSize) {
+    // This can't go below the page-aligned base since the region fits |size| from there.
+    base = fbl::round_down(best_fit->base + best_fit->size - size, page_size);
+  }
+  return region_allocator_.GetRegion({.base = base, .size = size}, region);
+}
+
 void ContiguousPooledMemoryAllocator::DumpPoolStats() {
   uint64_t unused_size = 0;
   uint64_t max_free_size = 0;
@@ -1195,6 +1224,18 @@ void ContiguousPooledMemoryAllocator::TracePoolSize(bool initial_trace) {
   });
   used_size_property_.Set(used_size);
   large_contiguous_region_sum_property_.Set(CalculateLargeContiguousRegionSize());
+  uint64_t unused_size = 0;
+  uint64_t max_free_size = 0;
+  region_allocator_.WalkAvailableRegions(
+      [&unused_size, &max_free_size](const ralloc_region_t* r) -> bool {
+        unused_size += r->size;
+        max_free_size = std::max(max_free_size, r->size);
+        return true;
+      });
+  free_region_count_property_.Set(region_allocator_.AvailableRegionCount());
+  max_free_size_property_.Set(max_free_size);
+  fragmentation_permille_property_.Set(
+      unused_size ? (unused_size - max_free_size) * 1000 / unused_size : 0);
   TRACE_COUNTER("gfx", "Contiguous pool size", pool_id_, "size", used_size);
   bool trace_high_water_mark = initial_trace;
   if (used_size > high_water_mark_used_size_) {
@@ -81,6 +81,9 @@ class ContiguousPooledMemoryAllocator : public MemoryAllocator {
 
   bool is_already_cleared_on_allocate() override;
 
+  // Protected memory can't be cleared by the CPU on reuse.
+  bool can_recycle_vmos() override { return is_always_cpu_accessible_; }
+
   // When this is set from unit tests only, we skip any operation that's only allowed on contiguous
   // VMOs, since we don't have a real contiguous VMO, since a fake BTI can't be used to create one.
   // This ends up limiting the fidelity of the unit tests somewhat; in the long run we probably
@@ -124,6 +127,12 @@ class ContiguousPooledMemoryAllocator : public MemoryAllocator {
   // Zircon.
   static constexpr uint64_t kUnusedGuardPatternPeriodPages = 128;
 
+  // Allocations of at least this size (including any guard regions) are placed at the high end of
+  // the smallest free region that fits them, while smaller allocations are placed at the low end.
+  // Keeping large and small buffers apart avoids small buffers with different lifetimes pinning
+  // down free space that a later large buffer would need.
+  static constexpr uint64_t kLargeAllocationMinSize = 1024ull * 1024;
+
  private:
   struct RegionData {
     std::string name;
@@ -185,6 +194,9 @@ class ContiguousPooledMemoryAllocator : public MemoryAllocator {
   void DumpPoolHighWaterMark();
   void TracePoolSize(bool initial_trace);
   uint64_t CalculateLargeContiguousRegionSize();
+  // Gets a region of |size| bytes using best-fit, placed within the chosen free region according
+  // to kLargeAllocationMinSize.
+  zx_status_t GetBestFitRegion(uint64_t size, RegionAllocator::Region::UPtr& region);
   void UpdateLoanableMetrics();
 
   // This method iterates over all the sub-regions of an unused region.  The sub-regions are regions
@@ -317,6 +329,11 @@ class ContiguousPooledMemoryAllocator : public MemoryAllocator {
   inspect::UintProperty last_failed_guard_region_check_timestamp_ns_property_;
   // This tracks the sum of the size of the 10 largest free regions.
   inspect::UintProperty large_contiguous_region_sum_property_;
+  // Fragmentation of the free space: the number of free regions, the size of the largest one, and
+  // how much of the free space is outside the largest free region (in parts per thousand).
+  inspect::UintProperty free_region_count_property_;
+  inspect::UintProperty max_free_size_property_;
+  inspect::UintProperty fragmentation_permille_property_;
 
   // CMM / PCMM properties regarding loaning of pages to Zircon.
   //
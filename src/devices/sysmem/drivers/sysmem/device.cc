@@ -62,6 +62,12 @@ constexpr int64_t kDefaultProtectedMemorySize = 0;
 // fail if physical memory has gotten too fragmented.
 constexpr int64_t kDefaultContiguousMemorySize = -5;
 
+// Unless overridden by the kernel cmdline parameter driver.sysmem.max_recycled_bytes, up to this
+// many bytes of freed buffers are kept for reuse by later collections.  The recycled buffers are
+// flushed back to their allocator whenever an allocation from it fails, so keeping them around
+// doesn't cause allocations to fail that would otherwise succeed.
+constexpr int64_t kDefaultMaxRecycledBytes = 16 * 1024 * 1024;
+
 // fbl::round_up() doesn't work on signed types.
 template <typename T>
 T AlignUp(T value, T divisor) {
@@ -198,6 +204,9 @@ class ContiguousSystemRamMemoryAllocator : public MemoryAllocator {
   // allocator since the VMOs independently track what pages they're using.  So this allocator can
   // always claim is_empty() true.
   bool is_empty() override { return true; }
+  // Recycling avoids repeating zx::vmo::create_contiguous(), which gets slower (and more likely to
+  // fail) as physical memory fragments.
+  bool can_recycle_vmos() override { return true; }
 
  private:
   Owner* const parent_device_;
@@ -375,6 +384,8 @@ void Device::CheckForUnbind() {
   std::lock_guard checker(*loop_checker_);
   if (!waiting_for_unbind_)
     return;
+  // Recycled VMOs would otherwise keep their allocators non-empty forever.
+  FlushRecycledVmos(nullptr);
   if (!logical_buffer_collections().empty()) {
     zxlogf(INFO, "Not unbinding because there are logical buffer collections count %ld",
            logical_buffer_collections().size());
@@ -521,6 +532,8 @@ zx_status_t Device::Bind() {
   sysmem_root_ = inspector_.GetRoot().CreateChild("sysmem");
   heaps_ = sysmem_root_.CreateChild("heaps");
   collections_node_ = sysmem_root_.CreateChild("collections");
+  recycled_bytes_property_ = sysmem_root_.CreateUint("recycled_bytes", 0);
+  recycled_vmo_reuse_count_property_ = sysmem_root_.CreateUint("recycled_vmo_reuse_count", 0);
 
   zx_status_t status = ddk::PDevProtocolClient::CreateFromDevice(parent_, &pdev_);
   if (status != ZX_OK) {
@@ -575,6 +588,19 @@ zx_status_t Device::Bind() {
     contiguous_memory_size = zx_system_get_physmem() * contiguous_memory_size / 100;
   }
 
+  int64_t max_recycled_bytes = kDefaultMaxRecycledBytes;
+  status = OverrideSizeFromCommandLine("driver.sysmem.max_recycled_bytes", &max_recycled_bytes);
+  if (status != ZX_OK) {
+    // OverrideSizeFromCommandLine() already printed an error.
+    return status;
+  }
+  if (max_recycled_bytes < 0) {
+    max_recycled_bytes = -max_recycled_bytes;
+    ZX_DEBUG_ASSERT(max_recycled_bytes >= 1 && max_recycled_bytes <= 99);
+    max_recycled_bytes = zx_system_get_physmem() * max_recycled_bytes / 100;
+  }
+  settings_.max_recycled_bytes = max_recycled_bytes;
+
   constexpr int64_t kMinProtectedAlignment = 64 * 1024;
   assert(kMinProtectedAlignment % zx_system_get_page_size() == 0);
   protected_memory_size = AlignUp(protected_memory_size, kMinProtectedAlignment);
@@ -740,8 +766,10 @@ zx_status_t Device::SysmemRegisterHeap(uint64_t heap_param, zx::channel heap_con
       std::lock_guard checker(*device_->loop_checker_);
       auto existing = device_->allocators_.find(heap_);
       if (existing != device_->allocators_.end() &&
-          existing->second == weak_associated_allocator_.lock())
+          existing->second == weak_associated_allocator_.lock()) {
+        device_->FlushRecycledVmos(existing->second.get());
         device_->allocators_.erase(heap_);
+      }
     }
 
     static void Bind(Device* device, fidl::ClientEnd<fuchsia_sysmem2::Heap> heap_client_end,
@@ -1060,6 +1088,62 @@ MemoryAllocator* Device::GetAllocator(const fuchsia_sysmem2::wire::BufferMemoryS
   return iter->second.get();
 }
 
+zx::vmo Device::TakeRecycledVmo(MemoryAllocator* allocator, uint64_t size) {
+  std::lock_guard checker(*loop_checker_);
+  // Prefer the most recently recycled VMO, as it's the most likely to still be warm in cache.
+  for (auto iter = recycled_vmos_.rbegin(); iter != recycled_vmos_.rend(); ++iter) {
+    if (iter->allocator == allocator && iter->size == size) {
+      zx::vmo parent_vmo = std::move(iter->parent_vmo);
+      recycled_bytes_ -= size;
+      recycled_vmos_.erase(std::next(iter).base());
+      recycled_bytes_property_.Set(recycled_bytes_);
+      recycled_vmo_reuse_count_property_.Add(1);
+      return parent_vmo;
+    }
+  }
+  return zx::vmo();
+}
+
+void Device::RecycleOrDeleteVmo(MemoryAllocator* allocator, zx::vmo parent_vmo, uint64_t size,
+                                bool recyclable) {
+  std::lock_guard checker(*loop_checker_);
+  const uint64_t max_recycled_bytes = settings_.max_recycled_bytes;
+  if (!recyclable || waiting_for_unbind_ || size > max_recycled_bytes) {
+    allocator->Delete(std::move(parent_vmo));
+    return;
+  }
+  recycled_vmos_.push_back(
+      {.allocator = allocator, .size = size, .parent_vmo = std::move(parent_vmo)});
+  recycled_bytes_ += size;
+  // Evict the oldest first.  Delete() can re-enter via CheckForUnbind(), so each evicted entry is
+  // removed from recycled_vmos_ before its allocator sees it.
+  while (recycled_bytes_ > max_recycled_bytes) {
+    RecycledVmo oldest = std::move(recycled_vmos_.front());
+    recycled_vmos_.pop_front();
+    recycled_bytes_ -= oldest.size;
+    oldest.allocator->Delete(std::move(oldest.parent_vmo));
+  }
+  recycled_bytes_property_.Set(recycled_bytes_);
+}
+
+void Device::FlushRecycledVmos(MemoryAllocator* allocator) {
+  std::lock_guard checker(*loop_checker_);
+  std::list<RecycledVmo> to_delete;
+  for (auto iter = recycled_vmos_.begin(); iter != recycled_vmos_.end();) {
+    auto next = std::next(iter);
+    if (!allocator || iter->allocator == allocator) {
+      recycled_bytes_ -= iter->size;
+      to_delete.splice(to_delete.end(), recycled_vmos_, iter);
+    }
+    iter = next;
+  }
+  recycled_bytes_property_.Set(recycled_bytes_);
+  // Delete() can re-enter via CheckForUnbind(), so only call it once recycled_vmos_ is consistent.
+  for (auto& recycled : to_delete) {
+    recycled.allocator->Delete(std::move(recycled.parent_vmo));
+  }
+}
+
 const fuchsia_sysmem2::wire::HeapProperties& Device::GetHeapProperties(
     fuchsia_sysmem2::wire::HeapType heap) const {
   std::lock_guard checker(*loop_checker_);
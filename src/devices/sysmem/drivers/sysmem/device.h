@@ -25,6 +25,7 @@
 #include <lib/zx/channel.h>
 
 #include <limits>
+#include <list>
 #include <map>
 #include <memory>
 #include <unordered_set>
@@ -55,6 +56,13 @@ class Node;
 struct Settings {
   // Maximum size of a single allocation. Mainly useful for unit tests.
   uint64_t max_allocation_size = UINT64_MAX;
+
+  // Maximum total size of freed buffers kept around for reuse by later collections that need a
+  // buffer of the same size from the same allocator.  Only allocators that can_recycle_vmos() have
+  // their buffers recycled, and secure buffers never are.  Zero disables recycling.  Bind() sets
+  // a nonzero default, which the driver.sysmem.max_recycled_bytes kernel cmdline parameter can
+  // override.
+  uint64_t max_recycled_bytes = 0;
 };
 
 class Device final : public DdkDeviceType,
@@ -129,6 +137,19 @@ class Device final : public DdkDeviceType,
   [[nodiscard]] MemoryAllocator* GetAllocator(
       const fuchsia_sysmem2::wire::BufferMemorySettings& settings);
 
+  // Takes a previously-recycled parent VMO of exactly |size| bytes from |allocator|, or returns an
+  // invalid VMO if there isn't one.  The contents of the returned VMO are stale; the caller must
+  // clear it before handing it out.
+  [[nodiscard]] zx::vmo TakeRecycledVmo(MemoryAllocator* allocator, uint64_t size);
+
+  // Either keeps |parent_vmo| for a later TakeRecycledVmo() (if |recyclable| and there's room under
+  // Settings::max_recycled_bytes), or passes it to allocator->Delete().
+  void RecycleOrDeleteVmo(MemoryAllocator* allocator, zx::vmo parent_vmo, uint64_t size,
+                          bool recyclable);
+
+  // Passes all recycled VMOs from |allocator| (or from all allocators if nullptr) to Delete().
+  void FlushRecycledVmos(MemoryAllocator* allocator);
+
   // Get heap properties of a specific memory heap allocator.
   //
   // Clients should guarantee that the heap is valid and already registered
@@ -159,6 +180,12 @@ class Device final : public DdkDeviceType,
     CheckForUnbind();
   }
 
+  // Test hook
+  [[nodiscard]] uint64_t recycled_bytes() {
+    std::lock_guard checker(*loop_checker_);
+    return recycled_bytes_;
+  }
+
   [[nodiscard]] inspect::Node& collections_node() { return collections_node_; }
 
   void set_settings(const Settings& settings) { settings_ = settings; }
@@ -282,6 +309,18 @@ class Device final : public DdkDeviceType,
   std::unordered_set<LogicalBufferCollection*> logical_buffer_collections_
       __TA_GUARDED(*loop_checker_);
 
+  struct RecycledVmo {
+    MemoryAllocator* allocator;
+    uint64_t size;
+    zx::vmo parent_vmo;
+  };
+  // Oldest first.  This stays short (bounded by Settings::max_recycled_bytes), so lookups are
+  // linear.
+  std::list<RecycledVmo> recycled_vmos_ __TA_GUARDED(*loop_checker_);
+  uint64_t recycled_bytes_ __TA_GUARDED(*loop_checker_) = 0;
+  inspect::UintProperty recycled_bytes_property_;
+  inspect::UintProperty recycled_vmo_reuse_count_property_;
+
   Settings settings_;
 
   bool waiting_for_unbind_ __TA_GUARDED(*loop_checker_) = false;
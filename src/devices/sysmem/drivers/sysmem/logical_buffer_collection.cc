@@ -3155,7 +3155,26 @@ fpromise::result<zx::vmo> LogicalBufferCollection::AllocateVmo(
   if (name_) {
     name = fbl::StringPrintf("%s:%d", name_->name.c_str(), index).c_str();
   }
-  zx_status_t status = allocator->Allocate(rounded_size_bytes, name, &raw_parent_vmo);
+  // Buffers of a collection that was recently torn down can be handed out again, which saves
+  // re-searching for contiguous memory when a client re-creates a collection with the same
+  // constraints (for example a swapchain or camera stream being re-created).  Secure buffers are
+  // never recycled since they can't be cleared by the CPU below.
+  const bool is_recyclable =
+      allocator->can_recycle_vmos() && !settings.buffer_settings().is_secure();
+  bool is_recycled = false;
+  zx_status_t status = ZX_OK;
+  if (is_recyclable) {
+    raw_parent_vmo = parent_device_->TakeRecycledVmo(allocator, rounded_size_bytes);
+    is_recycled = raw_parent_vmo.is_valid();
+  }
+  if (!is_recycled) {
+    status = allocator->Allocate(rounded_size_bytes, name, &raw_parent_vmo);
+    if (status != ZX_OK && is_recyclable) {
+      // The recycled VMOs may be what's holding the memory this allocation needs.
+      parent_device_->FlushRecycledVmos(allocator);
+      status = allocator->Allocate(rounded_size_bytes, name, &raw_parent_vmo);
+    }
+  }
   if (status != ZX_OK) {
     LogError(FROM_HERE,
              "allocator.Allocate failed - size_bytes: %zu "
@@ -3187,11 +3206,15 @@ fpromise::result<zx::vmo> LogicalBufferCollection::AllocateVmo(
   // pre-zeroed VMOs.  And/or zero allocator backing space async during deallocation, but wait on
   // deallocations to be done before failing a new allocation.
   //
+  // A recycled VMO still holds whatever its previous collection's participants wrote, so it's
+  // always cleared and flushed regardless of heap properties.
+  //
   // TODO(fxbug.dev/34590): Zero secure/protected VMOs.
   const auto& heap_properties = allocator->heap_properties();
   ZX_DEBUG_ASSERT(heap_properties.has_coherency_domain_support());
   ZX_DEBUG_ASSERT(heap_properties.has_need_clear());
-  if (heap_properties.need_clear() && !allocator->is_already_cleared_on_allocate()) {
+  if (is_recycled ||
+      (heap_properties.need_clear() && !allocator->is_already_cleared_on_allocate())) {
     uint64_t offset = 0;
     while (offset < info.size_bytes) {
       uint64_t bytes_to_write = std::min(sizeof(kZeroes), info.size_bytes - offset);
@@ -3204,7 +3227,7 @@ fpromise::result<zx::vmo> LogicalBufferCollection::AllocateVmo(
       offset += bytes_to_write;
     }
   }
-  if (heap_properties.need_clear() ||
+  if (is_recycled || heap_properties.need_clear() ||
       (heap_properties.has_need_flush() && heap_properties.need_flush())) {
     // Flush out the zeroes written above, or the zeroes that are already in the pages (but not
     // flushed yet) thanks to zx_vmo_create_contiguous(), or zeroes that are already in the pages
@@ -3238,10 +3261,12 @@ fpromise::result<zx::vmo> LogicalBufferCollection::AllocateVmo(
   // The fbl::RefPtr(this) is fairly similar (in this usage) to shared_from_this().
   auto tracked_parent_vmo = std::unique_ptr<TrackedParentVmo>(new TrackedParentVmo(
       fbl::RefPtr(this), std::move(raw_parent_vmo),
-      [this, allocator](TrackedParentVmo* tracked_parent_vmo) mutable {
+      [this, allocator, rounded_size_bytes,
+       is_recyclable](TrackedParentVmo* tracked_parent_vmo) mutable {
         auto node_handle = parent_vmos_.extract(tracked_parent_vmo->vmo().get());
         ZX_DEBUG_ASSERT(!node_handle || node_handle.mapped().get() == tracked_parent_vmo);
-        allocator->Delete(tracked_parent_vmo->TakeVmo());
+        parent_device_->RecycleOrDeleteVmo(allocator, tracked_parent_vmo->TakeVmo(),
+                                           rounded_size_bytes, is_recyclable);
         SweepLifetimeTracking();
         // ~node_handle may delete "this".
       }));
@@ -101,6 +101,11 @@ class MemoryAllocator {
 
   virtual bool is_already_cleared_on_allocate() { return false; }
 
+  // Returns true if a parent VMO passed to Delete() can instead be held back and handed out again
+  // by a later Allocate() of the same size without any allocator involvement, because
+  // SetupChildVmo() tracks nothing per child.  The VMO is re-cleared by the caller on reuse.
+  virtual bool can_recycle_vmos() { return false; }
+
  public:
   std::map<intptr_t, fit::callback<void()>> destroy_callbacks_;
 
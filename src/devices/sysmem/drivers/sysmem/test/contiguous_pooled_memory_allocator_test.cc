@@ -434,5 +434,49 @@ TEST_F(ContiguousPooledSystem, FreeRegionReporting) {
   }
 }
 
+TEST_F(ContiguousPooledSystem, BestFitAndSizeClasses) {
+  EXPECT_OK(PrepareAllocator());
+
+  // Small allocations go at the low end of the pool, large ones at the high end.
+  zx::vmo small_vmo;
+  EXPECT_OK(allocator_.Allocate(kVmoSize, {}, &small_vmo));
+  EXPECT_EQ(0u, allocator_.GetVmoRegionOffsetForTest(small_vmo));
+  zx::vmo big_vmo;
+  EXPECT_OK(allocator_.Allocate(kBigVmoSize, {}, &big_vmo));
+  EXPECT_EQ(kVmoSize * kVmoCount - kBigVmoSize, allocator_.GetVmoRegionOffsetForTest(big_vmo));
+
+  // Make a hole of exactly two small buffers just above small_vmo.
+  std::vector<zx::vmo> vmos;
+  for (uint32_t i = 0; i < 3; ++i) {
+    zx::vmo vmo;
+    EXPECT_OK(allocator_.Allocate(kVmoSize, {}, &vmo));
+    vmos.push_back(std::move(vmo));
+  }
+  const uint64_t hole_offset = allocator_.GetVmoRegionOffsetForTest(vmos[0]);
+  allocator_.Delete(std::move(vmos[0]));
+  allocator_.Delete(std::move(vmos[1]));
+
+  // A two-buffer allocation fills the hole instead of splitting the big free region.
+  zx::vmo fit_vmo;
+  EXPECT_OK(allocator_.Allocate(kVmoSize * 2, {}, &fit_vmo));
+  EXPECT_EQ(hole_offset, allocator_.GetVmoRegionOffsetForTest(fit_vmo));
+
+  auto hierarchy = inspect::ReadFromVmo(inspector_.DuplicateVmo());
+  auto* value = hierarchy.value().GetByPath({"test-pool"});
+  ASSERT_TRUE(value);
+  EXPECT_EQ(1u,
+            value->node().get_property<inspect::UintPropertyValue>("free_region_count")->value());
+  EXPECT_EQ(kVmoSize * kVmoCount - kBigVmoSize - 4 * kVmoSize,
+            value->node().get_property<inspect::UintPropertyValue>("max_free_size")->value());
+  EXPECT_EQ(
+      0u,
+      value->node().get_property<inspect::UintPropertyValue>("fragmentation_permille")->value());
+
+  allocator_.Delete(std::move(small_vmo));
+  allocator_.Delete(std::move(big_vmo));
+  allocator_.Delete(std::move(fit_vmo));
+  allocator_.Delete(std::move(vmos[2]));
+}
+
 }  // namespace
 }  // namespace sysmem_driver
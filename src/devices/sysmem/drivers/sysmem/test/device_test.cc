@@ -10,6 +10,7 @@
 #include <lib/async/cpp/task.h>
 #include <lib/sync/completion.h>
 #include <lib/zx/bti.h>
+#include <lib/zx/time.h>
 #include <stdlib.h>
 #include <zircon/errors.h>
 
@@ -462,5 +463,69 @@ TEST_F(FakeDdkSysmem, AuxBufferLeak) {
   }
 }
 
+// Check that buffers of a torn-down collection get reused by an identical collection, and don't leak
+// the previous contents.
+TEST_F(FakeDdkSysmem, RecycledBuffersAreCleared) {
+  sysmem_->set_settings(
+      sysmem_driver::Settings{.max_recycled_bytes = 4ull * zx_system_get_page_size()});
+
+  auto get_recycled_bytes = [this] {
+    uint64_t recycled_bytes = 0;
+    sync_completion_t completion;
+    async::PostTask(sysmem_->dispatcher(), [&] {
+      recycled_bytes = sysmem_->recycled_bytes();
+      sync_completion_signal(&completion);
+    });
+    sync_completion_wait(&completion, ZX_TIME_INFINITE);
+    return recycled_bytes;
+  };
+
+  fidl::WireSyncClient<fuchsia_sysmem::Allocator> allocator(Connect());
+  using CollectionAndVmo = std::pair<fidl::ClientEnd<fuchsia_sysmem::BufferCollection>, zx::vmo>;
+  auto allocate = [&allocator]() -> CollectionAndVmo {
+    zx::status collection_endpoints = fidl::CreateEndpoints<fuchsia_sysmem::BufferCollection>();
+    EXPECT_OK(collection_endpoints);
+    auto [collection_client_end, collection_server_end] = std::move(*collection_endpoints);
+    EXPECT_OK(allocator->AllocateNonSharedCollection(std::move(collection_server_end)));
+
+    fuchsia_sysmem::wire::BufferCollectionConstraints constraints;
+    constraints.min_buffer_count = 1;
+    constraints.has_buffer_memory_constraints = true;
+    constraints.buffer_memory_constraints.min_size_bytes = zx_system_get_page_size();
+    constraints.buffer_memory_constraints.physically_contiguous_required = true;
+    constraints.buffer_memory_constraints.cpu_domain_supported = true;
+    constraints.usage.cpu = fuchsia_sysmem_cpuUsageRead | fuchsia_sysmem_cpuUsageWrite;
+
+    fidl::WireSyncClient<fuchsia_sysmem::BufferCollection> collection(
+        std::move(collection_client_end));
+    EXPECT_OK(collection->SetConstraints(true, std::move(constraints)));
+    fidl::WireResult result = collection->WaitForBuffersAllocated();
+    EXPECT_OK(result);
+    EXPECT_OK(result.value().status);
+    return {collection.TakeClientEnd(),
+            std::move(result.value().buffer_collection_info.buffers[0].vmo)};
+  };
+
+  {
+    auto [collection_client_end, vmo] = allocate();
+    const uint8_t kPattern[] = {0xab, 0xcd, 0xef};
+    EXPECT_OK(vmo.write(kPattern, 0, sizeof(kPattern)));
+  }
+
+  // The buffer is recycled asynchronously once all handles to it are gone.
+  while (get_recycled_bytes() == 0) {
+    zx::nanosleep(zx::deadline_after(zx::msec(10)));
+  }
+  EXPECT_EQ(zx_system_get_page_size(), get_recycled_bytes());
+
+  auto [collection_client_end, vmo] = allocate();
+  EXPECT_EQ(0u, get_recycled_bytes());
+  uint8_t contents[3] = {0xff, 0xff, 0xff};
+  EXPECT_OK(vmo.read(contents, 0, sizeof(contents)));
+  for (uint8_t byte : contents) {
+    EXPECT_EQ(0u, byte);
+  }
+}
+
 }  // namespace
 }  // namespace sysmem_driver
@@ -0,0 +1,193 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+#ifndef SRC_DIAGNOSTICS_LIB_CPP_LOG_DECODER_LOG_VISITOR_H_
+#define SRC_DIAGNOSTICS_LIB_CPP_LOG_DECODER_LOG_VISITOR_H_
+
+#include <zircon/errors.h>
+#include <zircon/types.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <variant>
+
+namespace log_decoder {
+
+// The value of a log record argument. Strings point into the buffer being decoded and are only
+// valid as long as it is. Arguments without a value, or of types unknown to this decoder, are
+// std::monostate.
+using ArgumentValue =
+    std::variant<std::monostate, int64_t, uint64_t, double, std::string_view, bool>;
+
+// Decodes the structured log records in |data|, calling |visitor| for each of them without
+// allocating or copying anything.
+//
+// |visitor| must provide:
+//   // Called at the start of every record. Returning false skips the record's arguments.
+//   bool OnRecord(zx_time_t timestamp, uint8_t severity);
+//   void OnArgument(std::string_view name, const ArgumentValue& value);
+//
+// Records are read back to back until the end of |data| or a header word of zero, so a zero-filled
+// buffer can be passed whole. Returns ZX_ERR_IO_DATA_INTEGRITY on the first malformed record,
+// after the records before it have been visited, and ZX_ERR_NOT_SUPPORTED on a reference to a
+// string table, which log records never use. |records| is set to the number of records visited.
+template <typename Visitor>
+zx_status_t VisitLogRecords(const uint8_t* data, size_t size, Visitor& visitor,
+                            size_t* records = nullptr);
+
+namespace internal {
+
+constexpr size_t kWordSize = sizeof(uint64_t);
+constexpr uint64_t kLogRecordType = 9;
+
+constexpr uint64_t Bits(uint64_t word, size_t begin, size_t end) {
+  return (word >> begin) & ((uint64_t(1) << (end - begin + 1)) - 1);
+}
+
+// Words are copied out rather than dereferenced as |data| needn't be aligned.
+inline uint64_t ReadWord(const uint8_t* data, size_t word) {
+  uint64_t value;
+  memcpy(&value, data + word * kWordSize, kWordSize);
+  return value;
+}
+
+// Reads the inline string referred to by the 16 bit |ref|, starting at |*word| and never going
+// past |end|. Advances |*word| past the string's padding.
+inline zx_status_t ReadStringRef(const uint8_t* data, uint64_t ref, size_t* word, size_t end,
+                                 std::string_view* out) {
+  if (ref == 0) {
+    *out = {};
+    return ZX_OK;
+  }
+  if ((ref & 0x8000) == 0) {
+    return ZX_ERR_NOT_SUPPORTED;
+  }
+  const size_t length = ref & 0x7fff;
+  const size_t words = (length + kWordSize - 1) / kWordSize;
+  if (words > end - *word) {
+    return ZX_ERR_IO_DATA_INTEGRITY;
+  }
+  *out = std::string_view(reinterpret_cast<const char*>(data + *word * kWordSize), length);
+  *word += words;
+  return ZX_OK;
+}
+
+// Decodes the argument starting at |word|, which takes |size| words.
+inline zx_status_t ReadArgument(const uint8_t* data, size_t word, size_t size,
+                                std::string_view* name, ArgumentValue* value) {
+  const uint64_t header = ReadWord(data, word);
+  const size_t end = word + size;
+  size_t next = word + 1;
+  if (zx_status_t status = ReadStringRef(data, Bits(header, 16, 31), &next, end, name);
+      status != ZX_OK) {
+    return status;
+  }
+
+  switch (Bits(header, 0, 3)) {
+    case 1:  // int32, inline.
+      *value = static_cast<int64_t>(static_cast<int32_t>(Bits(header, 32, 63)));
+      return ZX_OK;
+    case 2:  // uint32, inline.
+      *value = Bits(header, 32, 63);
+      return ZX_OK;
+    case 3:  // int64
+    case 4:  // uint64
+    case 5: {  // double
+      if (next >= end) {
+        return ZX_ERR_IO_DATA_INTEGRITY;
+      }
+      const uint64_t raw = ReadWord(data, next);
+      if (Bits(header, 0, 3) == 3) {
+        *value = static_cast<int64_t>(raw);
+      } else if (Bits(header, 0, 3) == 4) {
+        *value = raw;
+      } else {
+        double d;
+        memcpy(&d, &raw, sizeof(d));
+        *value = d;
+      }
+      return ZX_OK;
+    }
+    case 6: {  // string
+      std::string_view str;
+      if (zx_status_t status = ReadStringRef(data, Bits(header, 32, 47), &next, end, &str);
+          status != ZX_OK) {
+        return status;
+      }
+      *value = str;
+      return ZX_OK;
+    }
+    case 9:  // bool, inline.
+      *value = Bits(header, 32, 32) != 0;
+      return ZX_OK;
+    default:
+      // Null and unknown arguments have no value, their size is enough to skip them.
+      *value = std::monostate();
+      return ZX_OK;
+  }
+}
+
+}  // namespace internal
+
+template <typename Visitor>
+zx_status_t VisitLogRecords(const uint8_t* data, size_t size, Visitor& visitor, size_t* records) {
+  using internal::Bits;
+  using internal::ReadWord;
+
+  // Trailing bytes that don't make up a whole word can't hold a record.
+  const size_t total_words = size / internal::kWordSize;
+  size_t visited = 0;
+  zx_status_t status = ZX_OK;
+
+  // Every header holds the size of what it starts, so the record and argument boundaries are found
+  // by hopping from header to header without looking at anything in between.
+  for (size_t word = 0; word < total_words;) {
+    const uint64_t header = ReadWord(data, word);
+    if (header == 0) {
+      break;
+    }
+
+    const size_t record_words = Bits(header, 4, 15);
+    if (Bits(header, 0, 3) != internal::kLogRecordType || record_words < 2 ||
+        record_words > total_words - word) {
+      status = ZX_ERR_IO_DATA_INTEGRITY;
+      break;
+    }
+    const size_t record_end = word + record_words;
+
+    const zx_time_t timestamp = static_cast<zx_time_t>(ReadWord(data, word + 1));
+    if (visitor.OnRecord(timestamp, static_cast<uint8_t>(Bits(header, 56, 63)))) {
+      for (size_t arg = word + 2; arg < record_end;) {
+        const size_t arg_words = Bits(ReadWord(data, arg), 4, 15);
+        if (arg_words == 0 || arg_words > record_end - arg) {
+          status = ZX_ERR_IO_DATA_INTEGRITY;
+          break;
+        }
+
+        std::string_view name;
+        ArgumentValue value;
+        if (status = internal::ReadArgument(data, arg, arg_words, &name, &value); status != ZX_OK) {
+          break;
+        }
+        visitor.OnArgument(name, value);
+        arg += arg_words;
+      }
+      if (status != ZX_OK) {
+        break;
+      }
+    }
+
+    ++visited;
+    word = record_end;
+  }
+
+  if (records != nullptr) {
+    *records = visited;
+  }
+  return status;
+}
+
+}  // namespace log_decoder
+
+#endif  // SRC_DIAGNOSTICS_LIB_CPP_LOG_DECODER_LOG_VISITOR_H_
@@ -6,6 +6,11 @@
 #include <lib/zx/socket.h>
 #include <zircon/types.h>
 
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <rapidjson/document.h>
@@ -13,6 +18,7 @@
 #include <rapidjson/pointer.h>
 
 #include "log_decoder.h"
+#include "log_visitor.h"
 
 namespace log_decoder {
 namespace {
@@ -46,5 +52,85 @@ TEST(LogDecoder, DecodesCorrectly) {
   fuchsia_free_decoded_log_message(json);
 }
 
+// Writes a record like the one in DecodesCorrectly to |data| and returns its size.
+size_t WriteRecord(uint8_t* data, size_t size) {
+  syslog_backend::LogBuffer buffer;
+  zx::socket logger_socket, our_socket;
+  zx::socket::create(ZX_SOCKET_DATAGRAM, &logger_socket, &our_socket);
+  syslog_backend::BeginRecordWithSocket(&buffer, syslog::LOG_INFO, __FILE__, __LINE__,
+                                        "test message", nullptr, logger_socket.release());
+  syslog_backend::WriteKeyValue(&buffer, "tag", "some tag");
+  syslog_backend::WriteKeyValue(&buffer, "user property", 5.2);
+  syslog_backend::EndRecord(&buffer);
+  syslog_backend::FlushRecord(&buffer);
+  size_t processed = 0;
+  our_socket.read(0, data, size, &processed);
+  return processed;
+}
+
+// Keeps copies of what it visits so they can be checked after decoding.
+struct RecordingVisitor {
+  bool OnRecord(zx_time_t /*timestamp*/, uint8_t /*severity*/) {
+    ++records;
+    return visit_arguments;
+  }
+  void OnArgument(std::string_view name, const ArgumentValue& value) {
+    if (const auto* str = std::get_if<std::string_view>(&value)) {
+      strings.emplace(name, *str);
+    } else if (const auto* d = std::get_if<double>(&value)) {
+      doubles.emplace(name, *d);
+    }
+    ++arguments;
+  }
+
+  bool visit_arguments = true;
+  size_t records = 0;
+  size_t arguments = 0;
+  std::multimap<std::string, std::string> strings;
+  std::map<std::string, double> doubles;
+};
+
+TEST(LogVisitor, VisitsArguments) {
+  uint8_t data[2048] = {};
+  WriteRecord(data, sizeof(data));
+
+  RecordingVisitor visitor;
+  size_t records = 0;
+  ASSERT_EQ(VisitLogRecords(data, sizeof(data), visitor, &records), ZX_OK);
+  EXPECT_EQ(records, 1u);
+  EXPECT_EQ(visitor.records, 1u);
+  EXPECT_THAT(visitor.strings, ::testing::Contains(::testing::Pair("message", "test message")));
+  EXPECT_THAT(visitor.strings, ::testing::Contains(::testing::Pair("tag", "some tag")));
+  EXPECT_EQ(visitor.doubles["user property"], 5.2);
+}
+
+TEST(LogVisitor, VisitsConsecutiveRecords) {
+  uint8_t data[4096] = {};
+  const size_t size = WriteRecord(data, sizeof(data) / 2);
+  WriteRecord(data + size, sizeof(data) / 2);
+
+  RecordingVisitor visitor;
+  visitor.visit_arguments = false;
+  size_t records = 0;
+  ASSERT_EQ(VisitLogRecords(data, sizeof(data), visitor, &records), ZX_OK);
+  EXPECT_EQ(records, 2u);
+  EXPECT_EQ(visitor.records, 2u);
+  EXPECT_EQ(visitor.arguments, 0u);
+}
+
+TEST(LogVisitor, RejectsTruncatedRecord) {
+  uint8_t data[4096] = {};
+  const size_t size = WriteRecord(data, sizeof(data) / 2);
+  WriteRecord(data + size, sizeof(data) / 2);
+
+  // Only the first record, and the second's header, fit.
+  RecordingVisitor visitor;
+  size_t records = 0;
+  EXPECT_EQ(VisitLogRecords(data, size + sizeof(uint64_t), visitor, &records),
+            ZX_ERR_IO_DATA_INTEGRITY);
+  EXPECT_EQ(records, 1u);
+  EXPECT_THAT(visitor.strings, ::testing::Contains(::testing::Pair("message", "test message")));
+}
+
 }  // namespace
 }  // namespace log_decoder
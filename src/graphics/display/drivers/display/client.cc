@@ -851,6 +851,8 @@ void Client::ApplyConfig(ApplyConfigCompleter::Sync& /*_completer*/) {
   // the configuration is applied with vsync.
   client_apply_count_++;
 
+  // This apply also picks up any images whose fences have fired.
+  apply_config_from_fences_task_.Cancel();
   ApplyConfig();
 
   // no Reply defined
@@ -1488,8 +1490,8 @@ void Client::OnFenceFired(FenceReference* fence) {
       new_image_ready |= waiting->self->OnFenceReady(fence);
     }
   }
-  if (new_image_ready) {
-    ApplyConfig();
+  if (new_image_ready && !apply_config_from_fences_task_.is_pending()) {
+    apply_config_from_fences_task_.Post(controller_->loop().dispatcher());
   }
 }
 
@@ -1542,6 +1544,7 @@ void Client::TearDown() {
   // The layer's images have already been handled in CleanUpImageLayerState
   layers_.clear();
 
+  apply_config_from_fences_task_.Cancel();
   ApplyConfig();
 
   proxy_->OnClientDead();
@@ -330,6 +330,12 @@ class Client : public fidl::WireServer<fuchsia_hardware_display::Controller> {
 
   FenceCollection fences_;
 
+  // Several wait fences often fire within the same pass of the loop (e.g. one per layer, or one
+  // per display); this collapses the configurations they make ready into a single apply.
+  void ApplyConfigFromFences() { ApplyConfig(); }
+  async::TaskClosureMethod<Client, &Client::ApplyConfigFromFences> apply_config_from_fences_task_{
+      this};
+
   Layer::Map layers_;
   uint64_t next_layer_id = 1;
 
@@ -438,7 +438,16 @@ void Controller::DisplayControllerInterfaceOnDisplayVsync(uint64_t display_id, z
     // the given |config_stamp|.
     if (!config_image_queue.empty() &&
         config_image_queue.front().config_stamp == controller_config_stamp) {
-      for (const auto& image : config_image_queue.front().images) {
+      auto& config_images = config_image_queue.front();
+      // The same config is reported on every vsync until a newer one replaces it; only the first
+      // of those is when it was presented.
+      if (!config_images.presented) {
+        config_images.presented = true;
+        const zx_duration_t latency = timestamp - config_images.apply_timestamp;
+        last_apply_to_vsync_latency_ns_property_.Set(latency);
+        apply_to_vsync_latency_us_.Insert(latency / 1000);
+      }
+      for (const auto& image : config_images.images) {
         // End of the flow for the image going to be presented.
         //
         // NOTE: If changing this flow name or ID, please also do so in the
@@ -547,7 +556,8 @@ void Controller::ApplyConfig(DisplayConfig* configs[], int32_t count, bool is_vc
       }
 
       auto& config_image_queue = display->config_image_queue;
-      config_image_queue.push({.config_stamp = controller_stamp_, .images = {}});
+      config_image_queue.push(
+          {.config_stamp = controller_stamp_, .apply_timestamp = timestamp, .images = {}});
 
       display->switching_client = switching_client;
       display->pending_layer_change = config->apply_layer_change();
@@ -990,6 +1000,11 @@ Controller::Controller(zx_device_t* parent)
   last_valid_apply_config_interval_ns_property_ =
       root_.CreateUint("last_valid_apply_config_interval_ns", 0);
   vsync_stalls_detected_ = root_.CreateUint("vsync_stalls", 0);
+  last_apply_to_vsync_latency_ns_property_ =
+      root_.CreateUint("last_apply_to_vsync_latency_ns", 0);
+  apply_to_vsync_latency_us_ = root_.CreateExponentialUintHistogram(
+      "apply_to_vsync_latency_us", /*floor=*/100, /*initial_step=*/100, /*step_multiplier=*/2,
+      /*buckets=*/10);
 }
 
 Controller::~Controller() { zxlogf(INFO, "Controller::~Controller"); }
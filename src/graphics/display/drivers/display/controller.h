@@ -190,6 +190,10 @@ class Controller : public ControllerParent,
   inspect::UintProperty last_valid_apply_config_timestamp_ns_property_;
   inspect::UintProperty last_valid_apply_config_interval_ns_property_;
 
+  // Time from a config being applied to the display engine to the first vsync that presents it.
+  inspect::UintProperty last_apply_to_vsync_latency_ns_property_;
+  inspect::ExponentialUintHistogram apply_to_vsync_latency_us_;
+
   config_stamp_t controller_stamp_ __TA_GUARDED(mtx()) = INVALID_CONFIG_STAMP_BANJO;
 };
 
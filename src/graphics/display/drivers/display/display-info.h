@@ -116,6 +116,11 @@ class DisplayInfo : public IdMappable<fbl::RefPtr<DisplayInfo>>,
   struct ConfigImages {
     const config_stamp_t config_stamp;
 
+    // When the config was applied to the display engine, to measure how long it took to reach the
+    // screen.
+    zx_time_t apply_timestamp = 0;
+    bool presented = false;
+
     struct ImageMetadata {
       uint64_t image_id;
       uint64_t client_id;
@@ -605,23 +605,39 @@ class ZirconPlatformConnectionClient : public PlatformConnectionClient {
           FitCommands(fuchsia_gpu_magma::wire::kMaxImmediateCommandsDataSize, num_buffers, buffers,
                       buffers_sent, &command_bytes, &num_semaphores);
 
-      // TODO(fxbug.dev/13144): Figure out how to move command and semaphore bytes across the FIDL
-      //               interface without copying.
-      std::vector<uint8_t> command_vec;
-      command_vec.reserve(command_bytes);
-      std::vector<uint64_t> semaphore_vec;
-      semaphore_vec.reserve(num_semaphores);
-
-      for (int i = 0; i < buffers_to_send; ++i) {
-        const auto& buffer = buffers[buffers_sent + i];
-        const auto buffer_data = static_cast<uint8_t*>(buffer.data);
-        std::copy(buffer_data, buffer_data + buffer.size, std::back_inserter(command_vec));
-        std::copy(buffer.semaphore_ids, buffer.semaphore_ids + buffer.semaphore_count,
-                  std::back_inserter(semaphore_vec));
+      magma_status_t result;
+      if (buffers_to_send == 1) {
+        // A batch of one needs no gathering, so the command bytes and semaphore ids are encoded
+        // straight from the caller's memory.
+        const auto& buffer = buffers[buffers_sent];
+        result = client_.ExecuteImmediateCommands(
+            context_id,
+            fidl::VectorView<uint8_t>::FromExternal(static_cast<uint8_t*>(buffer.data),
+                                                    buffer.size),
+            fidl::VectorView<uint64_t>::FromExternal(buffer.semaphore_ids, buffer.semaphore_count));
+      } else {
+        // TODO(fxbug.dev/13144): Figure out how to move command and semaphore bytes across the FIDL
+        //               interface without copying.
+        //
+        // The scratch vectors are kept across calls so that steady-state submission doesn't
+        // allocate.
+        immediate_command_scratch_.clear();
+        immediate_command_scratch_.reserve(command_bytes);
+        immediate_semaphore_scratch_.clear();
+        immediate_semaphore_scratch_.reserve(num_semaphores);
+
+        for (int i = 0; i < buffers_to_send; ++i) {
+          const auto& buffer = buffers[buffers_sent + i];
+          const auto buffer_data = static_cast<uint8_t*>(buffer.data);
+          std::copy(buffer_data, buffer_data + buffer.size,
+                    std::back_inserter(immediate_command_scratch_));
+          std::copy(buffer.semaphore_ids, buffer.semaphore_ids + buffer.semaphore_count,
+                    std::back_inserter(immediate_semaphore_scratch_));
+        }
+        result = client_.ExecuteImmediateCommands(
+            context_id, fidl::VectorView<uint8_t>::FromExternal(immediate_command_scratch_),
+            fidl::VectorView<uint64_t>::FromExternal(immediate_semaphore_scratch_));
       }
-      magma_status_t result = client_.ExecuteImmediateCommands(
-          context_id, fidl::VectorView<uint8_t>::FromExternal(command_vec),
-          fidl::VectorView<uint64_t>::FromExternal(semaphore_vec));
       if (result != MAGMA_STATUS_OK) {
         return result;
       }
@@ -822,6 +838,9 @@ class ZirconPlatformConnectionClient : public PlatformConnectionClient {
   PrimaryWrapper client_;
   zx::channel notification_channel_;
   uint32_t next_context_id_ = 1;
+  // Used to gather multi-buffer ExecuteImmediateCommands() batches.
+  std::vector<uint8_t> immediate_command_scratch_;
+  std::vector<uint64_t> immediate_semaphore_scratch_;
 };
 
 std::unique_ptr<PlatformConnectionClient> PlatformConnectionClient::Create(
@@ -82,10 +82,27 @@ magma::Status MagmaSystemContext::ExecuteCommandBufferWithResources(
       msd_ctx(), cmd_buf.get(), resources.data(), msd_resources.data(), msd_wait_semaphores.data(),
       msd_signal_semaphores.data());
 
+  if (result == MAGMA_STATUS_OK) {
+    submission_stats_.command_buffer_count++;
+    submission_stats_.resource_count += cmd_buf->resource_count;
+    submission_stats_.semaphore_count +=
+        cmd_buf->wait_semaphore_count + cmd_buf->signal_semaphore_count;
+    TraceSubmissionStats();
+  }
+
   return DRET_MSG(result, "ExecuteCommandBuffer: msd_context_execute_command_buffer failed: %d",
                   result);
 }
 
+void MagmaSystemContext::TraceSubmissionStats() {
+  TRACE_COUNTER("magma", "MagmaSystemContext submissions", reinterpret_cast<uintptr_t>(this),
+                "command_buffers", submission_stats_.command_buffer_count, "resources",
+                submission_stats_.resource_count, "immediate_command_batches",
+                submission_stats_.immediate_command_batch_count, "immediate_command_bytes",
+                submission_stats_.immediate_command_bytes, "semaphores",
+                submission_stats_.semaphore_count);
+}
+
 magma::Status MagmaSystemContext::ExecuteImmediateCommands(uint64_t commands_size, void* commands,
                                                            uint64_t semaphore_count,
                                                            uint64_t* semaphore_ids) {
@@ -105,6 +122,13 @@ magma::Status MagmaSystemContext::ExecuteImmediateCommands(uint64_t commands_siz
   magma_status_t result = msd_context_execute_immediate_commands(
       msd_ctx(), commands_size, commands, semaphore_count, msd_semaphores.data());
 
+  if (result == MAGMA_STATUS_OK) {
+    submission_stats_.immediate_command_batch_count++;
+    submission_stats_.immediate_command_bytes += commands_size;
+    submission_stats_.semaphore_count += semaphore_count;
+    TraceSubmissionStats();
+  }
+
   return DRET_MSG(result,
                   "ExecuteImmediateCommands: msd_context_execute_immediate_commands failed: %d",
                   result);
@@ -29,6 +29,16 @@ class MagmaSystemContext {
     virtual std::shared_ptr<MagmaSystemSemaphore> LookupSemaphoreForContext(uint64_t id) = 0;
   };
 
+  // Running totals of what has been successfully submitted on this context.  These are also
+  // emitted as trace counters after every submission.
+  struct SubmissionStats {
+    uint64_t command_buffer_count = 0;
+    uint64_t resource_count = 0;
+    uint64_t immediate_command_batch_count = 0;
+    uint64_t immediate_command_bytes = 0;
+    uint64_t semaphore_count = 0;
+  };
+
   MagmaSystemContext(Owner* owner, msd_context_unique_ptr_t msd_ctx)
       : owner_(owner), msd_ctx_(std::move(msd_ctx)) {}
 
@@ -38,13 +48,19 @@ class MagmaSystemContext {
   magma::Status ExecuteImmediateCommands(uint64_t commands_size, void* commands,
                                          uint64_t semaphore_count, uint64_t* semaphore_ids);
 
+  const SubmissionStats& submission_stats() const { return submission_stats_; }
+
  private:
   msd_context_t* msd_ctx() { return msd_ctx_.get(); }
 
+  void TraceSubmissionStats();
+
   Owner* owner_;
 
   msd_context_unique_ptr_t msd_ctx_;
 
+  SubmissionStats submission_stats_;
+
   friend class CommandBufferHelper;
 };
 
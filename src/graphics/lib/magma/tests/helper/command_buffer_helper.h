@@ -53,6 +53,7 @@ class CommandBufferHelper {
   std::vector<msd_buffer_t*>& msd_resources() { return msd_resources_; }
 
   msd_context_t* ctx() { return ctx_->msd_ctx(); }
+  MagmaSystemContext* system_context() { return ctx_; }
   MagmaSystemDevice* dev() { return dev_.get(); }
   MagmaSystemConnection* connection() { return connection_.get(); }
 
@@ -24,6 +24,25 @@ TEST(MagmaSystemContext, ExecuteCommandBuffer_Normal) {
   }
 }
 
+TEST(MagmaSystemContext, ExecuteCommandBuffer_SubmissionStats) {
+  auto cmd_buf = CommandBufferHelper::Create();
+  EXPECT_TRUE(cmd_buf->Execute());
+  EXPECT_TRUE(cmd_buf->Execute());
+
+  const auto& stats = cmd_buf->system_context()->submission_stats();
+  EXPECT_EQ(2u, stats.command_buffer_count);
+  EXPECT_EQ(2u * CommandBufferHelper::kNumResources, stats.resource_count);
+  EXPECT_EQ(2u * (CommandBufferHelper::kWaitSemaphoreCount +
+                  CommandBufferHelper::kSignalSemaphoreCount),
+            stats.semaphore_count);
+  EXPECT_EQ(0u, stats.immediate_command_batch_count);
+
+  // Failed submissions aren't counted.
+  cmd_buf->abi_cmd_buf()->batch_start_offset = UINT32_MAX;
+  EXPECT_FALSE(cmd_buf->Execute());
+  EXPECT_EQ(2u, stats.command_buffer_count);
+}
+
 TEST(MagmaSystemContext, ExecuteCommandBuffer_InvalidBatchBufferIndex) {
   auto cmd_buf = CommandBufferHelper::Create();
   cmd_buf->abi_cmd_buf()->batch_buffer_resource_index =
@@ -111,8 +111,13 @@ Status HeaderReader::Parse(const void* void_data, size_t len, size_t file_length
   if ((status = ParseSeekTable(data, len, file_length, &table)) != kStatusOk) {
     return status;
   }
+  uint32_t dictionary_id;
+  if ((status = GetDictionaryId(data, len, &dictionary_id)) != kStatusOk) {
+    return status;
+  }
 
   out->entries_ = std::move(table);
+  out->dictionary_id_ = dictionary_id;
 
   return kStatusOk;
 }
@@ -164,6 +169,15 @@ Status HeaderReader::GetNumChunks(const uint8_t* data, size_t len, ChunkCountTyp
   return kStatusOk;
 }
 
+Status HeaderReader::GetDictionaryId(const uint8_t* data, size_t len,
+                                     uint32_t* dictionary_id_out) {
+  if (len < kChunkArchiveDictionaryIdOffset + sizeof(uint32_t)) {
+    return kStatusErrBufferTooSmall;
+  }
+  *dictionary_id_out = reinterpret_cast<const uint32_t*>(data + kChunkArchiveDictionaryIdOffset)[0];
+  return kStatusOk;
+}
+
 Status HeaderReader::ParseSeekTable(const uint8_t* data, size_t len, size_t file_length,
                                     fbl::Array<SeekTableEntry>* entries_out) {
   ChunkCountType num_chunks;
@@ -316,6 +330,7 @@ Status HeaderWriter::Finalize() {
   memcpy(dst_, kChunkArchiveMagic, kArchiveMagicLength);
   reinterpret_cast<ArchiveVersionType*>(dst_ + kChunkArchiveVersionOffset)[0] = kVersion;
   reinterpret_cast<ChunkCountType*>(dst_ + kChunkArchiveNumChunksOffset)[0] = num_frames_;
+  reinterpret_cast<uint32_t*>(dst_ + kChunkArchiveDictionaryIdOffset)[0] = dictionary_id_;
 
   // Always compute checkum last.
   reinterpret_cast<uint32_t*>(dst_ + kChunkArchiveHeaderCrc32Offset)[0] =
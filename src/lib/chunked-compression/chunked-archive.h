@@ -30,7 +30,7 @@
 //    +-----+-----+-----+-----+-----+-----+-----+-----+
 //  8 |  Version  |  Reserved |       Num Frames      |  // Reserved bytes must be zero.
 //    +-----+-----+-----+-----+-----+-----+-----+-----+
-// 16 |    Header CRC32       |        Reserved       |  // Reserved bytes must be zero.
+// 16 |    Header CRC32       |     Dictionary ID     |
 //    +-----+-----+-----+-----+-----+-----+-----+-----+
 // 24 |                    Reserved                   |  // Reserved bytes must be zero.
 //    +-----+-----+-----+-----+-----+-----+-----+-----+
@@ -47,6 +47,9 @@
 //
 // The Header CRC32 is computed based on the entire header including each Seek Table Entry.
 //
+// The Dictionary ID identifies the dictionary which every frame was compressed against (see
+// |CompressionDictionary::id()|), or is zero if no dictionary was used.
+//
 // ### Seek Table
 //
 // Each Seek Table Entry describes a contiguous range of data in the compressed space, and where
@@ -108,7 +111,7 @@ constexpr size_t kChunkArchiveVersionOffset = 8ul;
 constexpr size_t kChunkArchiveReserved1Offset = 10ul;
 constexpr size_t kChunkArchiveNumChunksOffset = 12ul;
 constexpr size_t kChunkArchiveHeaderCrc32Offset = 16ul;
-constexpr size_t kChunkArchiveReserved2Offset = 20ul;
+constexpr size_t kChunkArchiveDictionaryIdOffset = 20ul;
 constexpr size_t kChunkArchiveSeekTableOffset = 32ul;
 
 // A single entry into the seek table. Describes where an extent of decompressed
@@ -142,10 +145,10 @@ static_assert(kChunkArchiveNumChunksOffset == kChunkArchiveReserved1Offset + siz
 static_assert(kChunkArchiveHeaderCrc32Offset ==
                   kChunkArchiveNumChunksOffset + sizeof(ChunkCountType),
               "Breaking change to archive format");
-static_assert(kChunkArchiveReserved2Offset == kChunkArchiveHeaderCrc32Offset + sizeof(uint32_t),
+static_assert(kChunkArchiveDictionaryIdOffset == kChunkArchiveHeaderCrc32Offset + sizeof(uint32_t),
               "Breaking change to archive format");
 static_assert(kChunkArchiveSeekTableOffset ==
-                  kChunkArchiveReserved2Offset + sizeof(uint32_t) + sizeof(uint64_t),
+                  kChunkArchiveDictionaryIdOffset + sizeof(uint32_t) + sizeof(uint64_t),
               "Breaking change to archive format");
 
 // A parsed view of a chunked archive's seek table.
@@ -180,11 +183,15 @@ class SeekTable {
   std::optional<size_t> EntryForCompressedOffset(size_t offset) const;
   std::optional<size_t> EntryForDecompressedOffset(size_t offset) const;
 
+  // Returns the ID of the dictionary the archive was compressed with, or zero if none was used.
+  uint32_t DictionaryId() const { return dictionary_id_; }
+
   // Allow HeaderReader to initialize these objects with a validated parsed seek table
   friend class HeaderReader;
 
  private:
   fbl::Array<SeekTableEntry> entries_;
+  uint32_t dictionary_id_ = 0;
 };
 
 // HeaderReader reads chunked archive headers and produces in-memory SeekTable representations.
@@ -210,6 +217,7 @@ class HeaderReader {
   static Status CheckVersion(const uint8_t* data, size_t len);
   static Status CheckChecksum(const uint8_t* data, size_t len);
   static Status GetNumChunks(const uint8_t* data, size_t len, ChunkCountType* num_chunks_out);
+  static Status GetDictionaryId(const uint8_t* data, size_t len, uint32_t* dictionary_id_out);
   static Status ParseSeekTable(const uint8_t* data, size_t len, size_t file_length,
                                fbl::Array<SeekTableEntry>* entries_out);
   static Status CheckSeekTable(const fbl::Array<SeekTableEntry>& seek_table, size_t header_end,
@@ -250,6 +258,9 @@ class HeaderWriter {
   // full.
   Status AddEntry(const SeekTableEntry& entry);
 
+  // Records that the frames were compressed against the dictionary identified by |dictionary_id|.
+  void SetDictionaryId(uint32_t dictionary_id) { dictionary_id_ = dictionary_id; }
+
   // Finishes writing the header out to the target buffer.
   //
   // Returns an error if the header was not fully initialized (i.e. not every seek table entry
@@ -270,6 +281,7 @@ class HeaderWriter {
   SeekTableEntry* entries_ = nullptr;
   size_t current_frame_ = 0;
   ChunkCountType num_frames_;
+  uint32_t dictionary_id_ = 0;
 };
 
 }  // namespace chunked_compression
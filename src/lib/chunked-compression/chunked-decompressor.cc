@@ -7,6 +7,7 @@
 #include <fbl/array.h>
 #include <src/lib/chunked-compression/chunked-archive.h>
 #include <src/lib/chunked-compression/chunked-decompressor.h>
+#include <src/lib/chunked-compression/compression-dictionary.h>
 #include <src/lib/chunked-compression/status.h>
 #include <zstd/zstd.h>
 #include <zstd/zstd_errors.h>
@@ -31,8 +32,12 @@ struct ChunkedDecompressor::DecompressionContext {
   ZSTD_DCtx* inner_;
 };
 
-ChunkedDecompressor::ChunkedDecompressor()
-    : context_(std::make_unique<DecompressionContext>(ZSTD_createDCtx())) {}
+ChunkedDecompressor::ChunkedDecompressor() : ChunkedDecompressor(nullptr) {}
+
+ChunkedDecompressor::ChunkedDecompressor(std::shared_ptr<const CompressionDictionary> dictionary)
+    : context_(std::make_unique<DecompressionContext>(ZSTD_createDCtx())),
+      dictionary_(std::move(dictionary)) {}
+
 ChunkedDecompressor::~ChunkedDecompressor() {}
 
 Status ChunkedDecompressor::DecompressBytes(const void* input, size_t len,
@@ -61,6 +66,9 @@ Status ChunkedDecompressor::Decompress(const SeekTable& table, const void* input
   if (output_len < table.DecompressedSize() || len < table.CompressedSize()) {
     return kStatusErrBufferTooSmall;
   }
+  if (!HasDictionaryFor(table)) {
+    return kStatusErrNotSupported;
+  }
 
   size_t bytes_written = 0;
   for (unsigned i = 0; i < table.Entries().size(); ++i) {
@@ -88,8 +96,11 @@ Status ChunkedDecompressor::Decompress(const SeekTable& table, const void* input
 Status ChunkedDecompressor::DecompressFrame(const void* compressed_buffer,
                                             size_t compressed_buffer_len, void* dst, size_t dst_len,
                                             size_t* bytes_written_out) {
-  size_t decompressed_size = ZSTD_decompressDCtx(context_->inner_, dst, dst_len,
-                                                 compressed_buffer, compressed_buffer_len);
+  size_t decompressed_size =
+      dictionary_ ? ZSTD_decompress_usingDDict(context_->inner_, dst, dst_len, compressed_buffer,
+                                               compressed_buffer_len, dictionary_->ddict())
+                  : ZSTD_decompressDCtx(context_->inner_, dst, dst_len, compressed_buffer,
+                                        compressed_buffer_len);
   if (ZSTD_isError(decompressed_size)) {
     FX_SLOG(ERROR, "Decompression failed", KV("status", decompressed_size),
             KV("status_str", ZSTD_getErrorName(decompressed_size)));
@@ -120,9 +131,20 @@ Status ChunkedDecompressor::DecompressFrame(const SeekTable& table, unsigned tab
   if (compressed_buffer_len < entry.compressed_size || dst_len < entry.decompressed_size) {
     return kStatusErrBufferTooSmall;
   }
+  if (!HasDictionaryFor(table)) {
+    return kStatusErrNotSupported;
+  }
 
   return DecompressFrame(
       compressed_buffer, entry.compressed_size, dst, entry.decompressed_size, bytes_written_out);
 }
 
+bool ChunkedDecompressor::HasDictionaryFor(const SeekTable& table) const {
+  if (table.DictionaryId() == 0) {
+    // Frames compressed without a dictionary decompress the same way with one.
+    return true;
+  }
+  return dictionary_ && dictionary_->id() == table.DictionaryId();
+}
+
 }  // namespace chunked_compression
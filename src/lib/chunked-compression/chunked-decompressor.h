@@ -11,6 +11,7 @@
 #include <fbl/macros.h>
 
 #include "chunked-archive.h"
+#include "compression-dictionary.h"
 #include "status.h"
 
 namespace chunked_compression {
@@ -45,6 +46,8 @@ namespace chunked_compression {
 class ChunkedDecompressor {
  public:
   ChunkedDecompressor();
+  // Decompresses archives which were compressed against |dictionary|.
+  explicit ChunkedDecompressor(std::shared_ptr<const CompressionDictionary> dictionary);
   ~ChunkedDecompressor();
   ChunkedDecompressor(ChunkedDecompressor&& o) = default;
   ChunkedDecompressor& operator=(ChunkedDecompressor&& o) = default;
@@ -66,6 +69,9 @@ class ChunkedDecompressor {
   // not validated (having already been validated during construction of |table|).
   // |output_len| must be at least |ComputeOutputSize(table)| bytes long.
   //
+  // Fails with kStatusErrNotSupported if the archive was compressed against a dictionary other than
+  // the one this decompressor was created with.
+  //
   // Returns the number of decompressed bytes written in |bytes_written_out|.
   Status Decompress(const SeekTable& table, const void* input, size_t len, void* output,
                     size_t output_len, size_t* bytes_written_out);
@@ -86,14 +92,22 @@ class ChunkedDecompressor {
   // to span the entire frame.
   // |output_len| must be at least as big as |table.Entries()[table_index].decompressed_size|.
   //
+  // Fails with kStatusErrNotSupported if the archive was compressed against a dictionary other than
+  // the one this decompressor was created with.
+  //
   // Returns the number of decompressed bytes written in |bytes_written_out|.
   Status DecompressFrame(const SeekTable& table, unsigned table_index, const void* input_frame,
                          size_t input_frame_len, void* output, size_t output_len,
                          size_t* bytes_written_out);
 
  private:
+  // Returns whether this decompressor has the dictionary which |table|'s archive was compressed
+  // against.
+  bool HasDictionaryFor(const SeekTable& table) const;
+
   struct DecompressionContext;
   std::unique_ptr<DecompressionContext> context_;
+  std::shared_ptr<const CompressionDictionary> dictionary_;
 };
 
 }  // namespace chunked_compression
@@ -0,0 +1,185 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/lib/chunked-compression/compression-dictionary.h"
+
+#include <lib/stdcompat/span.h>
+#include <zircon/errors.h>
+
+#include <memory>
+#include <vector>
+
+#include <zxtest/zxtest.h>
+
+#include "src/lib/chunked-compression/chunked-archive.h"
+#include "src/lib/chunked-compression/chunked-compressor.h"
+#include "src/lib/chunked-compression/chunked-decompressor.h"
+#include "src/lib/chunked-compression/compression-params.h"
+#include "src/lib/chunked-compression/multithreaded-chunked-compressor.h"
+#include "src/lib/chunked-compression/multithreaded-chunked-decompressor.h"
+#include "src/lib/chunked-compression/status.h"
+
+namespace chunked_compression {
+namespace {
+
+constexpr size_t kDataSize = 4096;
+
+std::vector<uint8_t> CreateRandomData(size_t size, unsigned int seed) {
+  std::vector<uint8_t> data(size);
+  for (uint8_t& byte : data) {
+    byte = static_cast<uint8_t>(rand_r(&seed));
+  }
+  return data;
+}
+
+// Random content which can only be compressed well by referring back to the dictionary.
+std::vector<uint8_t> CreateDataSimilarTo(const std::vector<uint8_t>& dictionary) {
+  std::vector<uint8_t> data = dictionary;
+  for (size_t i = 0; i < data.size(); i += 512) {
+    data[i] ^= 0xff;
+  }
+  return data;
+}
+
+std::shared_ptr<const CompressionDictionary> CreateDictionary(const std::vector<uint8_t>& data) {
+  auto dictionary = CompressionDictionary::Create(data);
+  ZX_ASSERT(dictionary.is_ok());
+  return *std::move(dictionary);
+}
+
+std::vector<uint8_t> Compress(const std::vector<uint8_t>& data,
+                              std::shared_ptr<const CompressionDictionary> dictionary) {
+  CompressionParams params;
+  params.dictionary = std::move(dictionary);
+  std::vector<uint8_t> compressed(params.ComputeOutputSizeLimit(data.size()));
+  ChunkedCompressor compressor(params);
+  size_t compressed_size;
+  ZX_ASSERT(compressor.Compress(data.data(), data.size(), compressed.data(), compressed.size(),
+                                &compressed_size) == kStatusOk);
+  compressed.resize(compressed_size);
+  return compressed;
+}
+
+void ParseTable(const std::vector<uint8_t>& compressed, SeekTable* table) {
+  HeaderReader reader;
+  ASSERT_EQ(reader.Parse(compressed.data(), compressed.size(), compressed.size(), table),
+            kStatusOk);
+}
+
+TEST(CompressionDictionaryTest, CreateRejectsEmptyData) {
+  EXPECT_EQ(CompressionDictionary::Create({}).status_value(), ZX_ERR_INVALID_ARGS);
+}
+
+TEST(CompressionDictionaryTest, IdDependsOnContents) {
+  const std::vector<uint8_t> data = CreateRandomData(kDataSize, 1);
+  auto dictionary = CreateDictionary(data);
+  EXPECT_NE(dictionary->id(), 0u);
+  EXPECT_EQ(CreateDictionary(data)->id(), dictionary->id());
+  EXPECT_NE(CreateDictionary(CreateRandomData(kDataSize, 2))->id(), dictionary->id());
+}
+
+TEST(CompressionDictionaryTest, RoundTrip) {
+  const std::vector<uint8_t> dictionary_data = CreateRandomData(kDataSize, 1);
+  const std::vector<uint8_t> data = CreateDataSimilarTo(dictionary_data);
+  auto dictionary = CreateDictionary(dictionary_data);
+
+  const std::vector<uint8_t> compressed = Compress(data, dictionary);
+  SeekTable table;
+  ASSERT_NO_FATAL_FAILURE(ParseTable(compressed, &table));
+  EXPECT_EQ(table.DictionaryId(), dictionary->id());
+
+  ChunkedDecompressor decompressor(dictionary);
+  std::vector<uint8_t> output(table.DecompressedSize());
+  size_t bytes_written;
+  ASSERT_EQ(decompressor.Decompress(table, compressed.data(), compressed.size(), output.data(),
+                                    output.size(), &bytes_written),
+            kStatusOk);
+  ASSERT_EQ(bytes_written, data.size());
+  EXPECT_BYTES_EQ(output.data(), data.data(), data.size());
+}
+
+TEST(CompressionDictionaryTest, ImprovesCompressionOfSimilarData) {
+  const std::vector<uint8_t> dictionary_data = CreateRandomData(kDataSize, 1);
+  const std::vector<uint8_t> data = CreateDataSimilarTo(dictionary_data);
+
+  const std::vector<uint8_t> without_dictionary = Compress(data, nullptr);
+  const std::vector<uint8_t> with_dictionary = Compress(data, CreateDictionary(dictionary_data));
+  EXPECT_LT(with_dictionary.size() * 4, without_dictionary.size());
+}
+
+TEST(CompressionDictionaryTest, DecompressWithoutDictionaryFails) {
+  const std::vector<uint8_t> dictionary_data = CreateRandomData(kDataSize, 1);
+  const std::vector<uint8_t> compressed =
+      Compress(CreateDataSimilarTo(dictionary_data), CreateDictionary(dictionary_data));
+  SeekTable table;
+  ASSERT_NO_FATAL_FAILURE(ParseTable(compressed, &table));
+
+  std::vector<uint8_t> output(table.DecompressedSize());
+  size_t bytes_written;
+  ChunkedDecompressor decompressor;
+  EXPECT_EQ(decompressor.Decompress(table, compressed.data(), compressed.size(), output.data(),
+                                    output.size(), &bytes_written),
+            kStatusErrNotSupported);
+  const SeekTableEntry& entry = table.Entries()[0];
+  EXPECT_EQ(decompressor.DecompressFrame(table, 0, compressed.data() + entry.compressed_offset,
+                                         entry.compressed_size, output.data(), output.size(),
+                                         &bytes_written),
+            kStatusErrNotSupported);
+
+  ChunkedDecompressor wrong_decompressor(CreateDictionary(CreateRandomData(kDataSize, 2)));
+  EXPECT_EQ(wrong_decompressor.Decompress(table, compressed.data(), compressed.size(),
+                                          output.data(), output.size(), &bytes_written),
+            kStatusErrNotSupported);
+}
+
+TEST(CompressionDictionaryTest, DecompressArchiveWithoutDictionaryUsingDictionary) {
+  const std::vector<uint8_t> data = CreateRandomData(kDataSize, 1);
+  const std::vector<uint8_t> compressed = Compress(data, nullptr);
+  SeekTable table;
+  ASSERT_NO_FATAL_FAILURE(ParseTable(compressed, &table));
+  EXPECT_EQ(table.DictionaryId(), 0u);
+
+  ChunkedDecompressor decompressor(CreateDictionary(CreateRandomData(kDataSize, 2)));
+  std::vector<uint8_t> output(table.DecompressedSize());
+  size_t bytes_written;
+  ASSERT_EQ(decompressor.Decompress(table, compressed.data(), compressed.size(), output.data(),
+                                    output.size(), &bytes_written),
+            kStatusOk);
+  EXPECT_BYTES_EQ(output.data(), data.data(), data.size());
+}
+
+TEST(CompressionDictionaryTest, MultithreadedRoundTrip) {
+  constexpr size_t kThreadCount = 2;
+  const std::vector<uint8_t> dictionary_data = CreateRandomData(kDataSize, 1);
+  auto dictionary = CreateDictionary(dictionary_data);
+  // Every frame is compressed against the dictionary.
+  std::vector<uint8_t> data;
+  for (int i = 0; i < 4; ++i) {
+    std::vector<uint8_t> frame = CreateDataSimilarTo(dictionary_data);
+    frame[i] ^= 0xff;
+    data.insert(data.end(), frame.begin(), frame.end());
+  }
+
+  MultithreadedChunkedCompressor compressor(kThreadCount);
+  auto compressed = compressor.Compress({.chunk_size = CompressionParams::MinChunkSize(),
+                                         .dictionary = dictionary},
+                                        data);
+  ASSERT_OK(compressed.status_value());
+  SeekTable table;
+  ASSERT_NO_FATAL_FAILURE(ParseTable(*compressed, &table));
+  EXPECT_EQ(table.DictionaryId(), dictionary->id());
+
+  std::vector<uint8_t> output(table.DecompressedSize());
+  MultithreadedChunkedDecompressor without_dictionary(kThreadCount);
+  EXPECT_STATUS(without_dictionary.Decompress(table, *compressed, output).status_value(),
+                ZX_ERR_NOT_SUPPORTED);
+
+  MultithreadedChunkedDecompressor decompressor(kThreadCount, dictionary);
+  ASSERT_OK(decompressor.Decompress(table, *compressed, output).status_value());
+  ASSERT_EQ(output.size(), data.size());
+  EXPECT_BYTES_EQ(output.data(), data.data(), data.size());
+}
+
+}  // namespace
+}  // namespace chunked_compression
@@ -0,0 +1,45 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/lib/chunked-compression/compression-dictionary.h"
+
+#include <lib/cksum.h>
+#include <lib/stdcompat/span.h>
+#include <lib/zx/status.h>
+#include <zircon/errors.h>
+
+#include <memory>
+#include <vector>
+
+#include <zstd/zstd.h>
+
+namespace chunked_compression {
+
+zx::status<std::shared_ptr<const CompressionDictionary>> CompressionDictionary::Create(
+    cpp20::span<const uint8_t> data) {
+  if (data.empty()) {
+    return zx::error(ZX_ERR_INVALID_ARGS);
+  }
+  std::vector<uint8_t> copy(data.begin(), data.end());
+  ZSTD_DDict* ddict = ZSTD_createDDict(copy.data(), copy.size());
+  if (ddict == nullptr) {
+    return zx::error(ZX_ERR_INVALID_ARGS);
+  }
+  // A checksum of the contents rather than zstd's own dictionary ID is used, since raw content
+  // dictionaries don't have one and a mismatched dictionary would produce garbage output.
+  uint32_t id = crc32(0, copy.data(), copy.size());
+  if (id == 0) {
+    id = 1;
+  }
+  return zx::ok(std::shared_ptr<const CompressionDictionary>(
+      new CompressionDictionary(std::move(copy), id, ddict)));
+}
+
+CompressionDictionary::CompressionDictionary(std::vector<uint8_t> data, uint32_t id,
+                                             ZSTD_DDict* ddict)
+    : data_(std::move(data)), id_(id), ddict_(ddict) {}
+
+CompressionDictionary::~CompressionDictionary() { ZSTD_freeDDict(ddict_); }
+
+}  // namespace chunked_compression
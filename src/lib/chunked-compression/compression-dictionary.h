@@ -0,0 +1,59 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SRC_LIB_CHUNKED_COMPRESSION_COMPRESSION_DICTIONARY_H_
+#define SRC_LIB_CHUNKED_COMPRESSION_COMPRESSION_DICTIONARY_H_
+
+#include <lib/stdcompat/span.h>
+#include <lib/zx/status.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <fbl/macros.h>
+
+// Declared by zstd.h as ZSTD_DDict.
+struct ZSTD_DDict_s;
+
+namespace chunked_compression {
+
+// A zstd dictionary which frames are compressed against. Small inputs compress poorly on their own
+// since there is little history for zstd to refer back to; a dictionary trained on representative
+// content (e.g. with `zstd --train`) provides that history instead.
+//
+// Either a dictionary in zstd's format or raw content can be used. Archives compressed with a
+// dictionary record its |id()| and can only be decompressed with the same dictionary.
+//
+// This class is immutable and can be shared between threads.
+class CompressionDictionary {
+ public:
+  // Creates a dictionary from a copy of |data|, which must not be empty.
+  static zx::status<std::shared_ptr<const CompressionDictionary>> Create(
+      cpp20::span<const uint8_t> data);
+
+  ~CompressionDictionary();
+  DISALLOW_COPY_ASSIGN_AND_MOVE(CompressionDictionary);
+
+  // Identifies the contents of the dictionary. Never zero, since that marks archives which don't
+  // use a dictionary.
+  uint32_t id() const { return id_; }
+
+  cpp20::span<const uint8_t> data() const { return data_; }
+
+  // The dictionary pre-digested for decompression. This is created once so that the cost isn't paid
+  // for every frame.
+  const ZSTD_DDict_s* ddict() const { return ddict_; }
+
+ private:
+  CompressionDictionary(std::vector<uint8_t> data, uint32_t id, ZSTD_DDict_s* ddict);
+
+  const std::vector<uint8_t> data_;
+  const uint32_t id_;
+  ZSTD_DDict_s* const ddict_;
+};
+
+}  // namespace chunked_compression
+
+#endif  // SRC_LIB_CHUNKED_COMPRESSION_COMPRESSION_DICTIONARY_H_
@@ -7,6 +7,10 @@
 
 #include <zircon/types.h>
 
+#include <memory>
+
+#include "compression-dictionary.h"
+
 namespace chunked_compression {
 
 // CompressionParams describes the configuration for compression.
@@ -31,6 +35,11 @@ struct CompressionParams {
   // Each frame is independently validated with its checksum when decompressed.
   bool frame_checksum = false;
 
+  // Optional dictionary to compress every frame against.
+  // Archives compressed with a dictionary can only be decompressed with the same dictionary, which
+  // is worthwhile for small inputs that share a lot of content with each other.
+  std::shared_ptr<const CompressionDictionary> dictionary;
+
   static int DefaultCompressionLevel();
   static int MinCompressionLevel();
   static int MaxCompressionLevel();
@@ -14,6 +14,7 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <string>
@@ -23,6 +24,8 @@
 #include <fbl/unique_fd.h>
 #include <src/lib/chunked-compression/chunked-compressor.h>
 #include <src/lib/chunked-compression/chunked-decompressor.h>
+#include <src/lib/chunked-compression/compression-dictionary.h>
+#include <src/lib/chunked-compression/multithreaded-chunked-decompressor.h>
 #include <src/lib/chunked-compression/status.h>
 #include <src/lib/chunked-compression/streaming-chunked-compressor.h>
 
@@ -30,8 +33,10 @@ namespace {
 
 using chunked_compression::ChunkedCompressor;
 using chunked_compression::ChunkedDecompressor;
+using chunked_compression::CompressionDictionary;
 using chunked_compression::CompressionParams;
 using chunked_compression::HeaderReader;
+using chunked_compression::MultithreadedChunkedDecompressor;
 using chunked_compression::SeekTable;
 using chunked_compression::StreamingChunkedCompressor;
 
@@ -82,14 +87,17 @@ class ProgressWriter {
 };
 
 void usage(const char* fname) {
-  fprintf(stderr, "Usage: %s [--level #] [--stream] [--checksum] (d | c) source dest\n", fname);
+  fprintf(stderr,
+          "Usage: %s [--level #] [--stream] [--checksum] [--dictionary file] (d | c) source dest\n",
+          fname);
   fprintf(stderr,
           "\
   c: Compress source, writing to dest.\n\
   d: Decompress source, writing to dest.\n\
   --stream: (compression only) Use stream compression\n\
   --checksum: (compression only) Include a per-frame checksum\n\
-  --level #: Compression level\n");
+  --level #: Compression level\n\
+  --dictionary file: Compress against, or decompress with, the zstd dictionary in file\n");
 }
 
 // Opens |file|, truncates to |write_size|, and mmaps the file for writing.
@@ -173,9 +181,11 @@ int OpenAndMapForReading(const char* file, fbl::unique_fd* out_fd, const uint8_t
 }
 
 // Reads |sz| bytes from |src| and compresses it, writing the output to |dst_file|.
-int Compress(const uint8_t* src, size_t sz, const char* dst_file, int level, bool checksum) {
+int Compress(const uint8_t* src, size_t sz, const char* dst_file, int level, bool checksum,
+             std::shared_ptr<const CompressionDictionary> dictionary) {
   CompressionParams params;
   params.frame_checksum = checksum;
+  params.dictionary = std::move(dictionary);
   params.compression_level = level;
   params.chunk_size = CompressionParams::ChunkSizeForInputSize(sz, kTargetFrameSize);
   size_t output_limit = params.ComputeOutputSizeLimit(sz);
@@ -215,9 +225,10 @@ int Compress(const uint8_t* src, size_t sz, const char* dst_file, int level, boo
 // Reads |sz| bytes from |src_fd| and compresses it using a streaming compressor, writing the output
 // to |dst_file|.
 int CompressStream(fbl::unique_fd src_fd, size_t sz, const char* dst_file, int level,
-                   bool checksum) {
+                   bool checksum, std::shared_ptr<const CompressionDictionary> dictionary) {
   CompressionParams params;
   params.frame_checksum = checksum;
+  params.dictionary = std::move(dictionary);
   params.compression_level = level;
   params.chunk_size = CompressionParams::ChunkSizeForInputSize(sz, kTargetFrameSize);
   size_t output_limit = params.ComputeOutputSizeLimit(sz);
@@ -285,7 +296,8 @@ int CompressStream(fbl::unique_fd src_fd, size_t sz, const char* dst_file, int l
 }
 
 // Reads |sz| bytes from |src| and decompresses them, writing the results to |dst_file|.
-int Decompress(const uint8_t* src, size_t sz, const char* dst_file) {
+int Decompress(const uint8_t* src, size_t sz, const char* dst_file,
+               std::shared_ptr<const CompressionDictionary> dictionary) {
   SeekTable table;
   HeaderReader reader;
   if ((reader.Parse(src, sz, sz, &table)) != chunked_compression::kStatusOk) {
@@ -300,32 +312,58 @@ int Decompress(const uint8_t* src, size_t sz, const char* dst_file) {
     return 1;
   }
 
-  ChunkedDecompressor decompressor;
-  size_t bytes_written;
-  if (decompressor.Decompress(table, src, sz, write_buf, output_size, &bytes_written) !=
-      chunked_compression::kStatusOk) {
+  // Frames are independent, so they are decompressed in parallel.
+  MultithreadedChunkedDecompressor decompressor(std::max(std::thread::hardware_concurrency(), 1u),
+                                                std::move(dictionary));
+  zx::status<> status =
+      decompressor.Decompress(table, cpp20::span(src, sz), cpp20::span(write_buf, output_size));
+  if (status.status_value() == chunked_compression::kStatusErrNotSupported) {
+    fprintf(stderr, "Input file was compressed with a different dictionary\n");
+    return 1;
+  }
+  if (status.is_error()) {
     return 1;
   }
+  size_t bytes_written = output_size;
 
   printf("Wrote %lu bytes (%2.0f%% compression)\n", bytes_written,
          static_cast<double>(sz) / static_cast<double>(bytes_written) * 100);
   return 0;
 }
 
+// Loads the dictionary in |file|.
+std::shared_ptr<const CompressionDictionary> LoadDictionary(const char* file) {
+  fbl::unique_fd fd;
+  const uint8_t* data;
+  size_t size;
+  if (OpenAndMapForReading(file, &fd, &data, &size)) {
+    return nullptr;
+  }
+  auto dictionary = CompressionDictionary::Create(cpp20::span(data, size));
+  munmap(const_cast<uint8_t*>(data), size);
+  if (dictionary.is_error()) {
+    fprintf(stderr, "'%s' is not a valid dictionary\n", file);
+    return nullptr;
+  }
+  return *std::move(dictionary);
+}
+
 }  // namespace
 
 int main(int argc, char* const* argv) {
   bool checksum = false;
   bool stream = false;
+  const char* dictionary_file = nullptr;
   int level = CompressionParams::DefaultCompressionLevel();
   while (1) {
     static struct option opts[] = {
         {"stream", no_argument, nullptr, 's'},
         {"level", required_argument, nullptr, 'l'},
         {"checksum", no_argument, nullptr, 'c'},
+        {"dictionary", required_argument, nullptr, 'D'},
         {nullptr, 0, nullptr, 0},
     };
-    int c = getopt_long(argc, argv, "sl:c", opts, nullptr);
+    int c = getopt_long(argc, argv, "sl:cD:", opts, nullptr);
 
     if (c < 0) {
       break;
@@ -355,6 +393,10 @@ int main(int argc, char* const* argv) {
         checksum = true;
         break;
       }
+      case 'D': {
+        dictionary_file = optarg;
+        break;
+      }
       default:
         usage(argv[0]);
         return 1;
@@ -389,6 +431,14 @@ int main(int argc, char* const* argv) {
     return 1;
   }
 
+  std::shared_ptr<const CompressionDictionary> dictionary;
+  if (dictionary_file != nullptr) {
+    dictionary = LoadDictionary(dictionary_file);
+    if (!dictionary) {
+      return 1;
+    }
+  }
+
   if (stream) {
     if (mode == Mode::DECOMPRESS) {
       printf("Ignoring --stream flag for decompression\n");
@@ -398,7 +448,8 @@ int main(int argc, char* const* argv) {
         fprintf(stderr, "Failed to open '%s': %s\n", input_file, strerror(errno));
         return 1;
       }
-      return CompressStream(std::move(fd), GetFileSize(input_file), output_file, level, checksum);
+      return CompressStream(std::move(fd), GetFileSize(input_file), output_file, level, checksum,
+                            std::move(dictionary));
     }
   }
   if (checksum && mode == Mode::DECOMPRESS) {
@@ -412,6 +463,7 @@ int main(int argc, char* const* argv) {
     return 1;
   }
 
-  return mode == Mode::COMPRESS ? Compress(src_data, src_size, output_file, level, checksum)
-                                : Decompress(src_data, src_size, output_file);
+  return mode == Mode::COMPRESS
+             ? Compress(src_data, src_size, output_file, level, checksum, std::move(dictionary))
+             : Decompress(src_data, src_size, output_file, std::move(dictionary));
 }
@@ -5,8 +5,10 @@
 #include "src/lib/chunked-compression/multithreaded-chunked-compressor.h"
 
 #include <lib/stdcompat/span.h>
+#include <string.h>
 #include <zircon/errors.h>
 
+#include <algorithm>
 #include <thread>
 #include <vector>
 
@@ -136,5 +138,52 @@ TEST(MultithreadedChunkedCompressorTest, CompressMultipleBuffersWithDifferentPar
   }
 }
 
+TEST(MultithreadedChunkedCompressorTest, StreamCompressesDataAsItBecomesAvailable) {
+  CompressionParams params{
+      .chunk_size = kChunkSize,
+  };
+  auto data = CreateRandomData(kChunkSize * 4 + 200);
+  std::vector<uint8_t> input(data.size());
+  MultithreadedChunkedCompressor compressor(kThreadCount);
+  auto stream = compressor.StartStream(params, input);
+  ASSERT_OK(stream.status_value());
+  // Fill the input in pieces which don't line up with the frames.
+  constexpr size_t kStep = kChunkSize / 3;
+  for (size_t offset = 0; offset < data.size(); offset += kStep) {
+    size_t length = std::min(kStep, data.size() - offset);
+    memcpy(input.data() + offset, data.data() + offset, length);
+    stream->SetAvailable(offset + length);
+  }
+  auto result = stream->Finish();
+  ASSERT_OK(result.status_value());
+  ASSERT_NO_FATAL_FAILURE(CheckCompressedData(result.value(), data));
+}
+
+TEST(MultithreadedChunkedCompressorTest, StreamCanBeDestroyedBeforeFinishing) {
+  CompressionParams params{
+      .chunk_size = kChunkSize,
+  };
+  auto data = CreateRandomData(kChunkSize * 8);
+  MultithreadedChunkedCompressor compressor(kThreadCount);
+  {
+    auto stream = compressor.StartStream(params, data);
+    ASSERT_OK(stream.status_value());
+    stream->SetAvailable(kChunkSize * 5);
+  }
+  // The compressor is still usable.
+  auto result = compressor.Compress(params, data);
+  ASSERT_OK(result.status_value());
+  ASSERT_NO_FATAL_FAILURE(CheckCompressedData(result.value(), data));
+}
+
+TEST(MultithreadedChunkedCompressorTest, StreamInputTooLargeForChunkSize) {
+  CompressionParams params{
+      .chunk_size = kChunkSize,
+  };
+  std::vector<uint8_t> data(kChunkSize * (kChunkArchiveMaxFrames + 1));
+  MultithreadedChunkedCompressor compressor(kThreadCount);
+  ASSERT_EQ(compressor.StartStream(params, data).status_value(), ZX_ERR_INVALID_ARGS);
+}
+
 }  // namespace
 }  // namespace chunked_compression
@@ -9,11 +9,9 @@
 #include <string.h>
 #include <zircon/errors.h>
 
-#include <condition_variable>
+#include <algorithm>
 #include <cstdint>
-#include <deque>
 #include <memory>
-#include <mutex>
 #include <optional>
 #include <thread>
 #include <vector>
@@ -23,7 +21,7 @@
 #include "src/lib/chunked-compression/chunked-archive.h"
 #include "src/lib/chunked-compression/compression-params.h"
 #include "src/lib/chunked-compression/status.h"
-#include "src/lib/fxl/synchronization/thread_annotations.h"
+#include "src/lib/chunked-compression/task-queue.h"
 
 namespace chunked_compression {
 namespace {
@@ -33,50 +31,6 @@ size_t CalculateLastFrameSize(size_t frame_size, size_t data_size) {
   return remainder == 0 ? frame_size : remainder;
 }
 
-// Multi-producer multi-consumer task queue.
-template <typename T>
-class TaskQueue {
- public:
-  // Terminates the queue and signals to all threads waiting in |TakeTask| that the queue has been
-  // stopped. Any tasks added to the queue after it has been terminated won't be handled.
-  void Terminate() {
-    std::scoped_lock lock(mutex_);
-    terminated_ = true;
-    condition_.notify_all();
-  }
-
-  void AddTask(T value) {
-    std::scoped_lock lock(mutex_);
-    queue_.push_back(value);
-    condition_.notify_one();
-  }
-
-  // Returns the next task in the queue. If there are no tasks in the queue then this method wait
-  // for a task to be added. Returns |std::nullopt| if the |TaskQueue| has been terminated.
-  //
-  // Thread-safety analysis doesn't work with unique_lock.
-  std::optional<T> TakeTask() FXL_NO_THREAD_SAFETY_ANALYSIS {
-    std::unique_lock lock(mutex_);
-    for (;;) {
-      if (terminated_) {
-        return std::nullopt;
-      }
-      if (!queue_.empty()) {
-        auto task = std::move(queue_.front());
-        queue_.pop_front();
-        return task;
-      }
-      condition_.wait(lock);
-    }
-  }
-
- private:
-  std::mutex mutex_;
-  std::condition_variable condition_;
-  bool terminated_ FXL_GUARDED_BY(mutex_) = false;
-  std::deque<T> queue_ FXL_GUARDED_BY(mutex_);
-};
-
 struct CompressFrameResponse {
   zx::status<std::vector<uint8_t>> compressed_data;
   size_t frame_id;
@@ -86,10 +40,13 @@ struct CompressFrameRequest {
   cpp20::span<const uint8_t> data;
   size_t frame_id;
   const CompressionParams* params;
+  // The dictionary of |params| prepared for compression, if it has one.
+  const ZSTD_CDict* cdict;
   TaskQueue<CompressFrameResponse>* response_queue;
 };
 
 zx::status<std::vector<uint8_t>> CompressFrame(const CompressionParams& params,
+                                               const ZSTD_CDict* cdict,
                                                cpp20::span<const uint8_t> data, ZSTD_CCtx* ctx) {
   if (ZSTD_isError(
           ZSTD_CCtx_setParameter(ctx, ZSTD_c_compressionLevel, params.compression_level))) {
@@ -100,6 +57,11 @@ zx::status<std::vector<uint8_t>> CompressFrame(const CompressionParams& params,
       return zx::error(ZX_ERR_INTERNAL);
     }
   }
+  if (cdict) {
+    if (ZSTD_isError(ZSTD_CCtx_refCDict(ctx, cdict))) {
+      return zx::error(ZX_ERR_INTERNAL);
+    }
+  }
   std::vector<uint8_t> output(ZSTD_compressBound(data.size()));
   size_t compressed_size =
       ZSTD_compress2(ctx, output.data(), output.size(), data.data(), data.size());
@@ -119,7 +81,8 @@ void StartWorker(TaskQueue<CompressFrameRequest>* queue) {
       return;
     }
     request->response_queue->AddTask({
-        .compressed_data = CompressFrame(*request->params, request->data, ctx.get()),
+        .compressed_data =
+            CompressFrame(*request->params, request->cdict, request->data, ctx.get()),
         .frame_id = request->frame_id,
     });
     ZSTD_CCtx_reset(ctx.get(), ZSTD_reset_session_and_parameters);
@@ -128,80 +91,101 @@ void StartWorker(TaskQueue<CompressFrameRequest>* queue) {
 
 }  // namespace
 
-class MultithreadedChunkedCompressor::MultithreadedChunkedCompressorImpl {
+class MultithreadedChunkedCompressor::Stream::StreamImpl {
  public:
-  explicit MultithreadedChunkedCompressorImpl(size_t thread_count) {
-    for (size_t i = 0; i < thread_count; ++i) {
-      worker_threads_.emplace_back([this]() { StartWorker(&this->work_queue_); });
+  StreamImpl(TaskQueue<CompressFrameRequest>* work_queue, const CompressionParams& params,
+             cpp20::span<const uint8_t> input)
+      : work_queue_(work_queue),
+        params_(params),
+        input_(input),
+        frame_count_(HeaderWriter::NumFramesForDataSize(input.size(), params.chunk_size)),
+        last_frame_size_(CalculateLastFrameSize(params.chunk_size, input.size())),
+        frames_(frame_count_) {}
+
+  ~StreamImpl() {
+    // The workers refer to |params_|, |cdict_| and |responses_| until they've responded to every
+    // request.
+    while (frames_received_ < frames_queued_) {
+      responses_.TakeTask();
+      ++frames_received_;
     }
   }
 
-  ~MultithreadedChunkedCompressorImpl() {
-    work_queue_.Terminate();
-    for (auto& thread : worker_threads_) {
-      thread.join();
+  // Prepares the dictionary, if any, once for all frames. Loading it into the context of every
+  // frame instead would digest it again each time. It can't be shared beyond the stream, since it
+  // is built for the compression level of |params_|.
+  zx::status<> Init() {
+    if (params_.dictionary) {
+      cdict_.reset(ZSTD_createCDict(params_.dictionary->data().data(),
+                                    params_.dictionary->data().size(),
+                                    params_.compression_level));
+      if (!cdict_) {
+        return zx::error(ZX_ERR_NO_MEMORY);
+      }
     }
+    return zx::ok();
   }
 
-  zx::status<std::vector<uint8_t>> Compress(const CompressionParams& params,
-                                            cpp20::span<const uint8_t> input) {
-    if (!params.IsValid()) {
-      return zx::error(ZX_ERR_INVALID_ARGS);
-    }
-    if (input.empty()) {
-      return zx::ok(std::vector<uint8_t>());
-    }
-    TaskQueue<CompressFrameResponse> compression_responses;
-    size_t frame_count = HeaderWriter::NumFramesForDataSize(input.size(), params.chunk_size);
-    size_t last_frame_size = CalculateLastFrameSize(params.chunk_size, input.size());
-    for (size_t frame = 0; frame < frame_count; ++frame) {
-      auto frame_data =
-          input.subspan(frame * params.chunk_size,
-                        frame + 1 == frame_count ? last_frame_size : params.chunk_size);
-      work_queue_.AddTask({
-          .data = frame_data,
-          .frame_id = frame,
-          .params = &params,
-          .response_queue = &compression_responses,
+  size_t frame_count() const { return frame_count_; }
+
+  void SetAvailable(size_t bytes) {
+    bytes = std::min(bytes, input_.size());
+    while (frames_queued_ < frame_count_ &&
+           frames_queued_ * params_.chunk_size + FrameSize(frames_queued_) <= bytes) {
+      work_queue_->AddTask({
+          .data = input_.subspan(frames_queued_ * params_.chunk_size, FrameSize(frames_queued_)),
+          .frame_id = frames_queued_,
+          .params = &params_,
+          .cdict = cdict_.get(),
+          .response_queue = &responses_,
       });
+      ++frames_queued_;
     }
+  }
 
-    std::vector<std::vector<uint8_t>> frames(frame_count);
+  zx::status<std::vector<uint8_t>> Finish() {
+    SetAvailable(input_.size());
     size_t compressed_data_size = 0;
-    for (size_t frame = 0; frame < frame_count; ++frame) {
-      auto response = compression_responses.TakeTask();
+    while (frames_received_ < frame_count_) {
+      auto response = responses_.TakeTask();
       if (!response.has_value()) {
         // Nothing should terminate the response queue.
         return zx::error(ZX_ERR_INTERNAL);
       }
+      ++frames_received_;
       if (response->compressed_data.is_error()) {
         return response->compressed_data.take_error();
       }
       compressed_data_size += response->compressed_data->size();
-      frames[response->frame_id] = *std::move(response->compressed_data);
+      frames_[response->frame_id] = *std::move(response->compressed_data);
     }
 
-    size_t metadata_size = HeaderWriter::MetadataSizeForNumFrames(frame_count);
+    size_t metadata_size = HeaderWriter::MetadataSizeForNumFrames(frame_count_);
     std::vector<uint8_t> output(metadata_size + compressed_data_size);
     HeaderWriter header_writer;
     if (Status status =
-            HeaderWriter::Create(output.data(), metadata_size, frame_count, &header_writer);
+            HeaderWriter::Create(output.data(), metadata_size, frame_count_, &header_writer);
         status != kStatusOk) {
       return zx::error(status);
     }
+    if (params_.dictionary) {
+      header_writer.SetDictionaryId(params_.dictionary->id());
+    }
 
     size_t compressed_offset = metadata_size;
-    for (size_t frame = 0; frame < frame_count; ++frame) {
-      std::vector<uint8_t>& compressed_frame = frames[frame];
+    for (size_t frame = 0; frame < frame_count_; ++frame) {
+      std::vector<uint8_t>& compressed_frame = frames_[frame];
       SeekTableEntry entry{
-          .decompressed_offset = frame * params.chunk_size,
-          .decompressed_size = frame + 1 == frame_count ? last_frame_size : params.chunk_size,
+          .decompressed_offset = frame * params_.chunk_size,
+          .decompressed_size = FrameSize(frame),
           .compressed_offset = compressed_offset,
           .compressed_size = compressed_frame.size(),
       };
       header_writer.AddEntry(entry);
       memcpy(output.data() + compressed_offset, compressed_frame.data(), compressed_frame.size());
       compressed_offset += compressed_frame.size();
+      // Release each frame as soon as it's been copied.
+      std::vector<uint8_t>().swap(compressed_frame);
     }
 
     if (Status status = header_writer.Finalize(); status != kStatusOk) {
@@ -210,11 +194,77 @@ class MultithreadedChunkedCompressor::MultithreadedChunkedCompressorImpl {
     return zx::ok(std::move(output));
   }
 
+ private:
+  size_t FrameSize(size_t frame) const {
+    return frame + 1 == frame_count_ ? last_frame_size_ : params_.chunk_size;
+  }
+
+  TaskQueue<CompressFrameRequest>* const work_queue_;
+  const CompressionParams params_;
+  const cpp20::span<const uint8_t> input_;
+  const size_t frame_count_;
+  const size_t last_frame_size_;
+  std::unique_ptr<ZSTD_CDict, decltype(&ZSTD_freeCDict)> cdict_{nullptr, ZSTD_freeCDict};
+
+  TaskQueue<CompressFrameResponse> responses_;
+  std::vector<std::vector<uint8_t>> frames_;
+  size_t frames_queued_ = 0;
+  size_t frames_received_ = 0;
+};
+
+class MultithreadedChunkedCompressor::MultithreadedChunkedCompressorImpl {
+ public:
+  explicit MultithreadedChunkedCompressorImpl(size_t thread_count) {
+    for (size_t i = 0; i < thread_count; ++i) {
+      worker_threads_.emplace_back([this]() { StartWorker(&this->work_queue_); });
+    }
+  }
+
+  ~MultithreadedChunkedCompressorImpl() {
+    work_queue_.Terminate();
+    for (auto& thread : worker_threads_) {
+      thread.join();
+    }
+  }
+
+  zx::status<std::unique_ptr<Stream::StreamImpl>> StartStream(const CompressionParams& params,
+                                                              cpp20::span<const uint8_t> input) {
+    if (!params.IsValid()) {
+      return zx::error(ZX_ERR_INVALID_ARGS);
+    }
+    auto stream = std::make_unique<Stream::StreamImpl>(&work_queue_, params, input);
+    if (stream->frame_count() > kChunkArchiveMaxFrames) {
+      return zx::error(ZX_ERR_INVALID_ARGS);
+    }
+    if (zx::status<> status = stream->Init(); status.is_error()) {
+      return status.take_error();
+    }
+    return zx::ok(std::move(stream));
+  }
+
  private:
   TaskQueue<CompressFrameRequest> work_queue_;
   std::vector<std::thread> worker_threads_;
 };
 
+MultithreadedChunkedCompressor::Stream::Stream(std::unique_ptr<StreamImpl> impl)
+    : impl_(std::move(impl)) {}
+
+MultithreadedChunkedCompressor::Stream::Stream(Stream&& other) noexcept = default;
+
+MultithreadedChunkedCompressor::Stream& MultithreadedChunkedCompressor::Stream::operator=(
+    Stream&& other) noexcept = default;
+
+MultithreadedChunkedCompressor::Stream::~Stream() = default;
+
+void MultithreadedChunkedCompressor::Stream::SetAvailable(size_t bytes) {
+  impl_->SetAvailable(bytes);
+}
+
+zx::status<std::vector<uint8_t>> MultithreadedChunkedCompressor::Stream::Finish() {
+  return impl_->Finish();
+}
+
 MultithreadedChunkedCompressor::MultithreadedChunkedCompressor(size_t thread_count)
     : impl_(std::make_unique<MultithreadedChunkedCompressor::MultithreadedChunkedCompressorImpl>(
           thread_count)) {}
@@ -223,7 +273,26 @@ MultithreadedChunkedCompressor::~MultithreadedChunkedCompressor() = default;
 
 zx::status<std::vector<uint8_t>> MultithreadedChunkedCompressor::Compress(
     const CompressionParams& params, cpp20::span<const uint8_t> input) {
-  return impl_->Compress(params, input);
+  if (input.empty()) {
+    if (!params.IsValid()) {
+      return zx::error(ZX_ERR_INVALID_ARGS);
+    }
+    return zx::ok(std::vector<uint8_t>());
+  }
+  zx::status<Stream> stream = StartStream(params, input);
+  if (stream.is_error()) {
+    return stream.take_error();
+  }
+  return stream->Finish();
+}
+
+zx::status<MultithreadedChunkedCompressor::Stream> MultithreadedChunkedCompressor::StartStream(
+    const CompressionParams& params, cpp20::span<const uint8_t> input) {
+  zx::status<std::unique_ptr<Stream::StreamImpl>> impl = impl_->StartStream(params, input);
+  if (impl.is_error()) {
+    return impl.take_error();
+  }
+  return zx::ok(Stream(std::move(impl).value()));
 }
 
 }  // namespace chunked_compression
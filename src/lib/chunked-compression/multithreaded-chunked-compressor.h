@@ -10,6 +10,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "compression-params.h"
 
@@ -20,6 +21,33 @@ namespace chunked_compression {
 // same time.
 class MultithreadedChunkedCompressor {
  public:
+  // An archive which is compressed while its input is still being produced. The input buffer is
+  // filled in front to back and each frame is queued for compression as soon as all of its data is
+  // available. This class is not thread safe, and must be destroyed before the compressor which
+  // created it.
+  class Stream {
+   public:
+    Stream(Stream&& other) noexcept;
+    Stream& operator=(Stream&& other) noexcept;
+    // Waits for any frames which are still being compressed.
+    ~Stream();
+
+    // Marks the first |bytes| bytes of the input as final and queues the frames they complete.
+    void SetAvailable(size_t bytes);
+
+    // Marks the whole input as available, waits for every frame and returns the compressed
+    // archive. Must only be called once.
+    zx::status<std::vector<uint8_t>> Finish();
+
+   private:
+    friend class MultithreadedChunkedCompressor;
+    class StreamImpl;
+
+    explicit Stream(std::unique_ptr<StreamImpl> impl);
+
+    std::unique_ptr<StreamImpl> impl_;
+  };
+
   explicit MultithreadedChunkedCompressor(size_t thread_count);
   ~MultithreadedChunkedCompressor();
 
@@ -27,6 +55,11 @@ class MultithreadedChunkedCompressor {
   zx::status<std::vector<uint8_t>> Compress(const CompressionParams& params,
                                             cpp20::span<const uint8_t> input);
 
+  // Starts compressing |input|, which doesn't need to be filled in yet. Data passed to
+  // |Stream::SetAvailable| must not change, and |input| must stay valid, until the stream is
+  // destroyed.
+  zx::status<Stream> StartStream(const CompressionParams& params, cpp20::span<const uint8_t> input);
+
  private:
   class MultithreadedChunkedCompressorImpl;
   std::unique_ptr<MultithreadedChunkedCompressorImpl> impl_;
@@ -0,0 +1,156 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/lib/chunked-compression/multithreaded-chunked-decompressor.h"
+
+#include <lib/stdcompat/span.h>
+#include <zircon/errors.h>
+
+#include <thread>
+#include <vector>
+
+#include <zxtest/zxtest.h>
+
+#include "src/lib/chunked-compression/chunked-archive.h"
+#include "src/lib/chunked-compression/compression-params.h"
+#include "src/lib/chunked-compression/multithreaded-chunked-compressor.h"
+
+namespace chunked_compression {
+namespace {
+
+constexpr size_t kThreadCount = 2;
+constexpr size_t kChunkSize = 8192;
+
+std::vector<uint8_t> CreateRandomData(size_t size) {
+  std::vector<uint8_t> data(size);
+  unsigned int seed = zxtest::Runner::GetInstance()->random_seed();
+  for (uint8_t& byte : data) {
+    byte = static_cast<uint8_t>(rand_r(&seed));
+  }
+  return data;
+}
+
+// A compressed archive along with its parsed seek table.
+struct Archive {
+  std::vector<uint8_t> data;
+  std::vector<uint8_t> compressed;
+  SeekTable table;
+};
+
+void CreateArchive(size_t size, Archive* archive) {
+  archive->data = CreateRandomData(size);
+  MultithreadedChunkedCompressor compressor(kThreadCount);
+  auto result = compressor.Compress({.chunk_size = kChunkSize}, archive->data);
+  ASSERT_OK(result.status_value());
+  archive->compressed = *std::move(result);
+  HeaderReader reader;
+  ASSERT_OK(reader.Parse(archive->compressed.data(), archive->compressed.size(),
+                         archive->compressed.size(), &archive->table));
+}
+
+TEST(MultithreadedChunkedDecompressorTest, DecompressWholeArchive) {
+  Archive archive;
+  ASSERT_NO_FATAL_FAILURE(CreateArchive(kChunkSize * 8 + 200, &archive));
+
+  MultithreadedChunkedDecompressor decompressor(kThreadCount);
+  std::vector<uint8_t> output(archive.table.DecompressedSize());
+  ASSERT_OK(decompressor.Decompress(archive.table, archive.compressed, output).status_value());
+  ASSERT_EQ(output.size(), archive.data.size());
+  ASSERT_BYTES_EQ(output.data(), archive.data.data(), archive.data.size());
+}
+
+TEST(MultithreadedChunkedDecompressorTest, DecompressSubsetOfFrames) {
+  Archive archive;
+  ASSERT_NO_FATAL_FAILURE(CreateArchive(kChunkSize * 8 + 200, &archive));
+  const auto& entries = archive.table.Entries();
+  ASSERT_EQ(entries.size(), 9);
+
+  // Includes the short last frame.
+  constexpr size_t kFirstFrame = 5;
+  constexpr size_t kFrameCount = 4;
+  const SeekTableEntry& first = entries[kFirstFrame];
+  const SeekTableEntry& last = entries[kFirstFrame + kFrameCount - 1];
+  cpp20::span<const uint8_t> input =
+      cpp20::span<const uint8_t>(archive.compressed)
+          .subspan(first.compressed_offset,
+                   last.compressed_offset + last.compressed_size - first.compressed_offset);
+  std::vector<uint8_t> output(last.decompressed_offset + last.decompressed_size -
+                              first.decompressed_offset);
+
+  MultithreadedChunkedDecompressor decompressor(kThreadCount);
+  ASSERT_OK(decompressor.DecompressFrames(archive.table, kFirstFrame, kFrameCount, input, output)
+                .status_value());
+  ASSERT_BYTES_EQ(output.data(), archive.data.data() + first.decompressed_offset, output.size());
+}
+
+TEST(MultithreadedChunkedDecompressorTest, DecompressFramesRejectsBadArguments) {
+  Archive archive;
+  ASSERT_NO_FATAL_FAILURE(CreateArchive(kChunkSize * 4, &archive));
+  const size_t frame_count = archive.table.Entries().size();
+  const SeekTableEntry& first = archive.table.Entries()[0];
+  cpp20::span<const uint8_t> input =
+      cpp20::span<const uint8_t>(archive.compressed).subspan(first.compressed_offset);
+  std::vector<uint8_t> output(archive.table.DecompressedSize());
+
+  MultithreadedChunkedDecompressor decompressor(kThreadCount);
+  EXPECT_EQ(
+      decompressor.DecompressFrames(archive.table, 1, frame_count, input, output).status_value(),
+      ZX_ERR_INVALID_ARGS);
+  EXPECT_EQ(decompressor
+                .DecompressFrames(archive.table, 0, frame_count, input,
+                                  cpp20::span<uint8_t>(output).subspan(1))
+                .status_value(),
+            ZX_ERR_BUFFER_TOO_SMALL);
+  EXPECT_EQ(decompressor
+                .DecompressFrames(archive.table, 0, frame_count, input.subspan(0, input.size() - 1),
+                                  output)
+                .status_value(),
+            ZX_ERR_BUFFER_TOO_SMALL);
+}
+
+TEST(MultithreadedChunkedDecompressorTest, CorruptFrameFailsDecompression) {
+  Archive archive;
+  ASSERT_NO_FATAL_FAILURE(CreateArchive(kChunkSize * 4, &archive));
+  // Clobber the zstd magic number at the start of the third frame.
+  archive.compressed[archive.table.Entries()[2].compressed_offset] ^= 0xff;
+
+  MultithreadedChunkedDecompressor decompressor(kThreadCount);
+  std::vector<uint8_t> output(archive.table.DecompressedSize());
+  EXPECT_EQ(decompressor.Decompress(archive.table, archive.compressed, output).status_value(),
+            ZX_ERR_IO_DATA_INTEGRITY);
+
+  // The decompressor is still usable.
+  archive.compressed[archive.table.Entries()[2].compressed_offset] ^= 0xff;
+  ASSERT_OK(decompressor.Decompress(archive.table, archive.compressed, output).status_value());
+  ASSERT_BYTES_EQ(output.data(), archive.data.data(), archive.data.size());
+}
+
+TEST(MultithreadedChunkedDecompressorTest, DecompressMultipleArchivesAtOnce) {
+  constexpr size_t kArchiveCount = 3;
+  Archive archives[kArchiveCount];
+  std::vector<uint8_t> outputs[kArchiveCount];
+  zx::status<> results[kArchiveCount];
+  for (size_t i = 0; i < kArchiveCount; ++i) {
+    ASSERT_NO_FATAL_FAILURE(CreateArchive(kChunkSize * (i + 2) + 5, &archives[i]));
+    outputs[i].resize(archives[i].table.DecompressedSize());
+  }
+
+  MultithreadedChunkedDecompressor decompressor(kThreadCount);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kArchiveCount; ++i) {
+    threads.emplace_back([&, i]() {
+      results[i] = decompressor.Decompress(archives[i].table, archives[i].compressed, outputs[i]);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (size_t i = 0; i < kArchiveCount; ++i) {
+    ASSERT_OK(results[i].status_value());
+    ASSERT_BYTES_EQ(outputs[i].data(), archives[i].data.data(), archives[i].data.size());
+  }
+}
+
+}  // namespace
+}  // namespace chunked_compression
@@ -0,0 +1,167 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/lib/chunked-compression/multithreaded-chunked-decompressor.h"
+
+#include <lib/stdcompat/span.h>
+#include <lib/zx/status.h>
+#include <zircon/errors.h>
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "src/lib/chunked-compression/chunked-archive.h"
+#include "src/lib/chunked-compression/chunked-decompressor.h"
+#include "src/lib/chunked-compression/compression-dictionary.h"
+#include "src/lib/chunked-compression/status.h"
+#include "src/lib/chunked-compression/task-queue.h"
+
+namespace chunked_compression {
+namespace {
+
+struct DecompressFrameResponse {
+  Status status;
+};
+
+struct DecompressFrameRequest {
+  cpp20::span<const uint8_t> input;
+  cpp20::span<uint8_t> output;
+  TaskQueue<DecompressFrameResponse>* response_queue;
+};
+
+void StartWorker(TaskQueue<DecompressFrameRequest>* queue,
+                 std::shared_ptr<const CompressionDictionary> dictionary) {
+  ChunkedDecompressor decompressor(std::move(dictionary));
+  for (;;) {
+    auto request = queue->TakeTask();
+    if (!request.has_value()) {
+      // TaskQueue terminated, stop the worker.
+      return;
+    }
+    size_t bytes_written;
+    Status status = decompressor.DecompressFrame(request->input.data(), request->input.size(),
+                                                 request->output.data(), request->output.size(),
+                                                 &bytes_written);
+    request->response_queue->AddTask({.status = status});
+  }
+}
+
+}  // namespace
+
+class MultithreadedChunkedDecompressor::MultithreadedChunkedDecompressorImpl {
+ public:
+  MultithreadedChunkedDecompressorImpl(size_t thread_count,
+                                       std::shared_ptr<const CompressionDictionary> dictionary)
+      : dictionary_id_(dictionary ? dictionary->id() : 0) {
+    for (size_t i = 0; i < thread_count; ++i) {
+      worker_threads_.emplace_back(
+          [this, dictionary]() { StartWorker(&this->work_queue_, dictionary); });
+    }
+  }
+
+  ~MultithreadedChunkedDecompressorImpl() {
+    work_queue_.Terminate();
+    for (auto& thread : worker_threads_) {
+      thread.join();
+    }
+  }
+
+  zx::status<> DecompressFrames(const SeekTable& table, size_t first_frame, size_t frame_count,
+                                cpp20::span<const uint8_t> input, cpp20::span<uint8_t> output) {
+    const size_t entry_count = table.Entries().size();
+    if (first_frame > entry_count || frame_count > entry_count - first_frame) {
+      return zx::error(ZX_ERR_INVALID_ARGS);
+    }
+    if (table.DictionaryId() != 0 && table.DictionaryId() != dictionary_id_) {
+      return zx::error(ZX_ERR_NOT_SUPPORTED);
+    }
+    if (frame_count == 0) {
+      return zx::ok();
+    }
+
+    // Every frame is checked before any are queued so that a bad request doesn't have to be
+    // unwound.
+    const SeekTableEntry& first_entry = table.Entries()[first_frame];
+    std::vector<DecompressFrameRequest> requests;
+    requests.reserve(frame_count);
+    TaskQueue<DecompressFrameResponse> responses;
+    for (size_t frame = first_frame; frame < first_frame + frame_count; ++frame) {
+      const SeekTableEntry& entry = table.Entries()[frame];
+      const size_t input_offset = entry.compressed_offset - first_entry.compressed_offset;
+      const size_t output_offset = entry.decompressed_offset - first_entry.decompressed_offset;
+      if (input_offset > input.size() || entry.compressed_size > input.size() - input_offset ||
+          output_offset > output.size() ||
+          entry.decompressed_size > output.size() - output_offset) {
+        return zx::error(ZX_ERR_BUFFER_TOO_SMALL);
+      }
+      requests.push_back({
+          .input = input.subspan(input_offset, entry.compressed_size),
+          .output = output.subspan(output_offset, entry.decompressed_size),
+          .response_queue = &responses,
+      });
+    }
+    for (const DecompressFrameRequest& request : requests) {
+      work_queue_.AddTask(request);
+    }
+
+    // The workers refer to |responses|, |input| and |output| until they've responded to every
+    // request, so all of the responses are collected even once a frame has failed.
+    Status status = kStatusOk;
+    for (size_t i = 0; i < frame_count; ++i) {
+      auto response = responses.TakeTask();
+      if (!response.has_value()) {
+        // Nothing should terminate the response queue.
+        return zx::error(ZX_ERR_INTERNAL);
+      }
+      if (status == kStatusOk) {
+        status = response->status;
+      }
+    }
+    return zx::make_status(status);
+  }
+
+ private:
+  // The ID of the dictionary the workers decompress with, or zero if they don't have one.
+  const uint32_t dictionary_id_;
+  TaskQueue<DecompressFrameRequest> work_queue_;
+  std::vector<std::thread> worker_threads_;
+};
+
+MultithreadedChunkedDecompressor::MultithreadedChunkedDecompressor(size_t thread_count)
+    : MultithreadedChunkedDecompressor(thread_count, nullptr) {}
+
+MultithreadedChunkedDecompressor::MultithreadedChunkedDecompressor(
+    size_t thread_count, std::shared_ptr<const CompressionDictionary> dictionary)
+    : impl_(std::make_unique<
+            MultithreadedChunkedDecompressor::MultithreadedChunkedDecompressorImpl>(
+          thread_count, std::move(dictionary))) {}
+
+MultithreadedChunkedDecompressor::~MultithreadedChunkedDecompressor() = default;
+
+zx::status<> MultithreadedChunkedDecompressor::Decompress(const SeekTable& table,
+                                                          cpp20::span<const uint8_t> input,
+                                                          cpp20::span<uint8_t> output) {
+  if (output.size() < table.DecompressedSize() || input.size() < table.CompressedSize()) {
+    return zx::error(ZX_ERR_BUFFER_TOO_SMALL);
+  }
+  if (table.Entries().size() == 0) {
+    return zx::ok();
+  }
+  const SeekTableEntry& first_entry = table.Entries()[0];
+  return impl_->DecompressFrames(table, 0, table.Entries().size(),
+                                 input.subspan(first_entry.compressed_offset),
+                                 output.subspan(first_entry.decompressed_offset));
+}
+
+zx::status<> MultithreadedChunkedDecompressor::DecompressFrames(const SeekTable& table,
+                                                                size_t first_frame,
+                                                                size_t frame_count,
+                                                                cpp20::span<const uint8_t> input,
+                                                                cpp20::span<uint8_t> output) {
+  return impl_->DecompressFrames(table, first_frame, frame_count, input, output);
+}
+
+}  // namespace chunked_compression
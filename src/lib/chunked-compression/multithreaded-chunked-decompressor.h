@@ -0,0 +1,57 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SRC_LIB_CHUNKED_COMPRESSION_MULTITHREADED_CHUNKED_DECOMPRESSOR_H_
+#define SRC_LIB_CHUNKED_COMPRESSION_MULTITHREADED_CHUNKED_DECOMPRESSOR_H_
+
+#include <lib/stdcompat/span.h>
+#include <lib/zx/status.h>
+
+#include <cstdint>
+#include <memory>
+
+#include "chunked-archive.h"
+#include "compression-dictionary.h"
+
+namespace chunked_compression {
+
+// MultithreadedChunkedDecompressor decompresses chunked archives by using a thread pool to
+// decompress frames in parallel. Every frame is decompressed into its own range of the output, so
+// no copies are needed. This class is thread safe and can be used to decompress multiple archives
+// at the same time.
+class MultithreadedChunkedDecompressor {
+ public:
+  explicit MultithreadedChunkedDecompressor(size_t thread_count);
+  // Decompresses archives which were compressed against |dictionary|.
+  MultithreadedChunkedDecompressor(size_t thread_count,
+                                   std::shared_ptr<const CompressionDictionary> dictionary);
+  ~MultithreadedChunkedDecompressor();
+
+  // Decompresses the archive described by |table| from |input| into |output|.
+  //
+  // |input| should include the full archive contents, including the table itself. |output| must be
+  // at least |table.DecompressedSize()| bytes long.
+  zx::status<> Decompress(const SeekTable& table, cpp20::span<const uint8_t> input,
+                          cpp20::span<uint8_t> output);
+
+  // Decompresses the |frame_count| frames of the archive described by |table| starting at
+  // |first_frame|, which is what is needed to serve a read of part of an archive.
+  //
+  // |input| should start at the first byte of |first_frame| and must span all of the frames.
+  // |output| starts at the first byte to write the result, which corresponds to the decompressed
+  // offset of |first_frame|, and must be big enough to hold all of the frames.
+  //
+  // Both methods fail with ZX_ERR_NOT_SUPPORTED if the archive was compressed against a dictionary
+  // other than the one this decompressor was created with.
+  zx::status<> DecompressFrames(const SeekTable& table, size_t first_frame, size_t frame_count,
+                                cpp20::span<const uint8_t> input, cpp20::span<uint8_t> output);
+
+ private:
+  class MultithreadedChunkedDecompressorImpl;
+  std::unique_ptr<MultithreadedChunkedDecompressorImpl> impl_;
+};
+
+}  // namespace chunked_compression
+
+#endif  // SRC_LIB_CHUNKED_COMPRESSION_MULTITHREADED_CHUNKED_DECOMPRESSOR_H_
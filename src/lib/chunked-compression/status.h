@@ -23,6 +23,10 @@ constexpr Status kStatusOk = 0;
 // The system encountered an otherwise unspecified error while performing the operation.
 constexpr Status kStatusErrInternal = -1;
 
+// Equivalent to ZX_ERR_NOT_SUPPORTED
+// The operation is not supported, ex. the data requires a dictionary which wasn't provided.
+constexpr Status kStatusErrNotSupported = -2;
+
 // Equivalent to ZX_ERR_INVALID_ARGS
 // An argument is invalid, ex. null pointer
 constexpr Status kStatusErrInvalidArgs = -10;
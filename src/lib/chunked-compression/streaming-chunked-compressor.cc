@@ -87,6 +87,14 @@ Status StreamingChunkedCompressor::Init(size_t stream_len, void* output, size_t
       return kStatusErrInternal;
     }
   }
+  if (params_.dictionary) {
+    r = ZSTD_CCtx_loadDictionary(context_->inner_, params_.dictionary->data().data(),
+                                 params_.dictionary->data().size());
+    if (ZSTD_isError(r)) {
+      FX_SLOG(ERROR, "Failed to load dictionary");
+      return kStatusErrInternal;
+    }
+  }
 
   compressed_output_ = static_cast<uint8_t*>(output);
   compressed_output_len_ = output_len;
@@ -106,6 +114,9 @@ Status StreamingChunkedCompressor::Init(size_t stream_len, void* output, size_t
     compressed_output_ = nullptr;
     return status;
   }
+  if (params_.dictionary) {
+    header_writer_.SetDictionaryId(params_.dictionary->id());
+  }
 
   return kStatusOk;
 }
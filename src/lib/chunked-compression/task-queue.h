@@ -0,0 +1,64 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SRC_LIB_CHUNKED_COMPRESSION_TASK_QUEUE_H_
+#define SRC_LIB_CHUNKED_COMPRESSION_TASK_QUEUE_H_
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+#include "src/lib/fxl/synchronization/thread_annotations.h"
+
+namespace chunked_compression {
+
+// Multi-producer multi-consumer task queue, shared by the multithreaded compressor and
+// decompressor.
+template <typename T>
+class TaskQueue {
+ public:
+  // Terminates the queue and signals to all threads waiting in |TakeTask| that the queue has been
+  // stopped. Any tasks added to the queue after it has been terminated won't be handled.
+  void Terminate() {
+    std::scoped_lock lock(mutex_);
+    terminated_ = true;
+    condition_.notify_all();
+  }
+
+  void AddTask(T value) {
+    std::scoped_lock lock(mutex_);
+    queue_.push_back(std::move(value));
+    condition_.notify_one();
+  }
+
+  // Returns the next task in the queue. If there are no tasks in the queue then this method wait
+  // for a task to be added. Returns |std::nullopt| if the |TaskQueue| has been terminated.
+  //
+  // Thread-safety analysis doesn't work with unique_lock.
+  std::optional<T> TakeTask() FXL_NO_THREAD_SAFETY_ANALYSIS {
+    std::unique_lock lock(mutex_);
+    for (;;) {
+      if (terminated_) {
+        return std::nullopt;
+      }
+      if (!queue_.empty()) {
+        auto task = std::move(queue_.front());
+        queue_.pop_front();
+        return task;
+      }
+      condition_.wait(lock);
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool terminated_ FXL_GUARDED_BY(mutex_) = false;
+  std::deque<T> queue_ FXL_GUARDED_BY(mutex_);
+};
+
+}  // namespace chunked_compression
+
+#endif  // SRC_LIB_CHUNKED_COMPRESSION_TASK_QUEUE_H_
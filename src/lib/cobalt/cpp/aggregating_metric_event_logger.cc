@@ -0,0 +1,140 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/lib/cobalt/cpp/aggregating_metric_event_logger.h"
+
+#include <lib/syslog/cpp/macros.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "src/lib/cobalt/cpp/metric_event_builder.h"
+
+namespace cobalt {
+namespace {
+
+// Returns |a| + |b|, saturating instead of overflowing.
+int64_t SaturatingAdd(int64_t a, int64_t b) {
+  int64_t result;
+  return __builtin_add_overflow(a, b, &result) ? std::numeric_limits<int64_t>::max() : result;
+}
+
+}  // namespace
+
+IntegerHistogramBuckets IntegerHistogramBuckets::Linear(const int64_t floor,
+                                                        const uint32_t num_buckets,
+                                                        const uint32_t step_size) {
+  std::vector<int64_t> bounds;
+  bounds.reserve(num_buckets + 1);
+  for (uint32_t i = 0; i <= num_buckets; ++i) {
+    bounds.push_back(SaturatingAdd(floor, static_cast<int64_t>(i) * step_size));
+  }
+  return IntegerHistogramBuckets(std::move(bounds));
+}
+
+IntegerHistogramBuckets IntegerHistogramBuckets::Exponential(const int64_t floor,
+                                                             const uint32_t num_buckets,
+                                                             const uint32_t initial_step,
+                                                             const uint32_t step_multiplier) {
+  // The buckets are [floor, floor + initial_step), [floor + initial_step,
+  // floor + initial_step * step_multiplier), ...
+  std::vector<int64_t> bounds;
+  bounds.reserve(num_buckets + 1);
+  bounds.push_back(floor);
+  int64_t offset = initial_step;
+  for (uint32_t i = 0; i < num_buckets; ++i) {
+    bounds.push_back(SaturatingAdd(floor, offset));
+    if (__builtin_mul_overflow(offset, static_cast<int64_t>(step_multiplier), &offset)) {
+      offset = std::numeric_limits<int64_t>::max();
+    }
+  }
+  return IntegerHistogramBuckets(std::move(bounds));
+}
+
+uint32_t IntegerHistogramBuckets::IndexOf(const int64_t value) const {
+  return static_cast<uint32_t>(std::upper_bound(bounds_.begin(), bounds_.end(), value) -
+                               bounds_.begin());
+}
+
+AggregatedIntegerHistogram::AggregatedIntegerHistogram(IntegerHistogramBuckets buckets)
+    : buckets_(std::move(buckets)), counts_(buckets_.num_buckets() + 2) {}
+
+AggregatingMetricEventLogger::AggregatingMetricEventLogger(
+    async_dispatcher_t* dispatcher, fuchsia::metrics::MetricEventLogger* logger,
+    const zx::duration flush_period)
+    : dispatcher_(dispatcher), logger_(logger), flush_period_(flush_period) {
+  flush_task_.PostDelayed(dispatcher_, flush_period_);
+}
+
+AggregatedCounter* AggregatingMetricEventLogger::GetCounter(const uint32_t metric_id,
+                                                            std::vector<uint32_t> event_codes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& counter = counters_[{metric_id, std::move(event_codes)}];
+  if (!counter) {
+    counter = std::make_unique<AggregatedCounter>();
+  }
+  return counter.get();
+}
+
+AggregatedIntegerHistogram* AggregatingMetricEventLogger::GetIntegerHistogram(
+    const uint32_t metric_id, IntegerHistogramBuckets buckets, std::vector<uint32_t> event_codes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& histogram = histograms_[{metric_id, std::move(event_codes)}];
+  if (!histogram) {
+    histogram = std::make_unique<AggregatedIntegerHistogram>(std::move(buckets));
+  }
+  return histogram.get();
+}
+
+std::vector<fuchsia::metrics::MetricEvent> AggregatingMetricEventLogger::TakeEvents() {
+  std::vector<fuchsia::metrics::MetricEvent> events;
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  for (const auto& [key, counter] : counters_) {
+    if (const uint64_t count = counter->count_.exchange(0, std::memory_order_relaxed); count > 0) {
+      events.push_back(
+          MetricEventBuilder(key.first).with_event_codes(key.second).as_occurrence(count));
+    }
+  }
+
+  for (const auto& [key, histogram] : histograms_) {
+    std::vector<fuchsia::metrics::HistogramBucket> buckets;
+    for (size_t i = 0; i < histogram->counts_.size(); ++i) {
+      if (const uint64_t count = histogram->counts_[i].exchange(0, std::memory_order_relaxed);
+          count > 0) {
+        buckets.push_back({.index = static_cast<uint32_t>(i), .count = count});
+      }
+    }
+    if (!buckets.empty()) {
+      events.push_back(MetricEventBuilder(key.first)
+                           .with_event_codes(key.second)
+                           .as_integer_histogram(std::move(buckets)));
+    }
+  }
+
+  return events;
+}
+
+void AggregatingMetricEventLogger::Flush() {
+  std::vector<fuchsia::metrics::MetricEvent> events = TakeEvents();
+  if (events.empty()) {
+    return;
+  }
+
+  logger_->LogMetricEvents(
+      std::move(events),
+      [](fuchsia::metrics::MetricEventLogger_LogMetricEvents_Result result) {
+        if (result.is_err()) {
+          FX_LOGS_FIRST_N(WARNING, 3) << "Failed to log aggregated events: "
+                                      << static_cast<uint32_t>(result.err());
+        }
+      });
+}
+
+void AggregatingMetricEventLogger::PeriodicFlush() {
+  Flush();
+  flush_task_.PostDelayed(dispatcher_, flush_period_);
+}
+
+}  // namespace cobalt
@@ -0,0 +1,123 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SRC_LIB_COBALT_CPP_AGGREGATING_METRIC_EVENT_LOGGER_H_
+#define SRC_LIB_COBALT_CPP_AGGREGATING_METRIC_EVENT_LOGGER_H_
+
+#include <fuchsia/metrics/cpp/fidl.h>
+#include <lib/async/cpp/task.h>
+#include <lib/zx/time.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace cobalt {
+
+// The bucket layout of an integer histogram metric. It must match the int_buckets of the metric in
+// the Cobalt registry.
+class IntegerHistogramBuckets {
+ public:
+  // |num_buckets| buckets of |step_size| starting at |floor|.
+  static IntegerHistogramBuckets Linear(int64_t floor, uint32_t num_buckets, uint32_t step_size);
+
+  // |num_buckets| buckets starting at |floor|, the first of |initial_step| and every following one
+  // |step_multiplier| times as large as the one before it.
+  static IntegerHistogramBuckets Exponential(int64_t floor, uint32_t num_buckets,
+                                             uint32_t initial_step, uint32_t step_multiplier);
+
+  // Returns the Cobalt index of the bucket |value| falls in: 0 is the underflow bucket and
+  // num_buckets() + 1 the overflow bucket.
+  uint32_t IndexOf(int64_t value) const;
+
+  uint32_t num_buckets() const { return static_cast<uint32_t>(bounds_.size() - 1); }
+
+ private:
+  explicit IntegerHistogramBuckets(std::vector<int64_t> bounds) : bounds_(std::move(bounds)) {}
+
+  // The lower bound of every bucket, followed by the upper bound of the last one.
+  std::vector<int64_t> bounds_;
+};
+
+// A count of occurrences accumulated locally. Adding to it is lock-free and may happen on any
+// thread.
+class AggregatedCounter {
+ public:
+  void Add(uint64_t count = 1) { count_.fetch_add(count, std::memory_order_relaxed); }
+
+ private:
+  friend class AggregatingMetricEventLogger;
+
+  std::atomic<uint64_t> count_{0};
+};
+
+// An integer histogram accumulated locally. Recording into it is lock-free and may happen on any
+// thread.
+class AggregatedIntegerHistogram {
+ public:
+  explicit AggregatedIntegerHistogram(IntegerHistogramBuckets buckets);
+
+  void Record(int64_t value, uint64_t count = 1) {
+    counts_[buckets_.IndexOf(value)].fetch_add(count, std::memory_order_relaxed);
+  }
+
+ private:
+  friend class AggregatingMetricEventLogger;
+
+  const IntegerHistogramBuckets buckets_;
+  // Indexed by Cobalt bucket index, including the underflow and overflow buckets.
+  std::vector<std::atomic<uint64_t>> counts_;
+};
+
+// Aggregates high frequency occurrence and integer events in the client and periodically logs them
+// to Cobalt in a single LogMetricEvents() call, rather than sending every event over FIDL.
+//
+// Only use this for metrics whose reports don't need individual events, e.g. occurrence counts and
+// integer histograms. Anything logged after the last flush is lost when this is destroyed.
+class AggregatingMetricEventLogger {
+ public:
+  // Flushes every |flush_period| on |dispatcher|, which must be the one |logger| is bound to.
+  AggregatingMetricEventLogger(async_dispatcher_t* dispatcher,
+                               fuchsia::metrics::MetricEventLogger* logger,
+                               zx::duration flush_period);
+
+  // The returned pointers stay valid for the lifetime of this object and always refer to the
+  // same aggregate for the same metric and event codes.
+  AggregatedCounter* GetCounter(uint32_t metric_id, std::vector<uint32_t> event_codes = {});
+  // |buckets| is ignored if the histogram already exists.
+  AggregatedIntegerHistogram* GetIntegerHistogram(uint32_t metric_id,
+                                                  IntegerHistogramBuckets buckets,
+                                                  std::vector<uint32_t> event_codes = {});
+
+  // Logs everything aggregated since the last flush. Must be called on the dispatcher.
+  void Flush();
+
+  // Returns an event for everything aggregated since the last call, and resets the aggregates.
+  std::vector<fuchsia::metrics::MetricEvent> TakeEvents();
+
+ private:
+  using Key = std::pair<uint32_t, std::vector<uint32_t>>;
+
+  void PeriodicFlush();
+
+  async_dispatcher_t* dispatcher_;
+  fuchsia::metrics::MetricEventLogger* logger_;
+  const zx::duration flush_period_;
+
+  // Only guards the maps. The aggregates themselves are updated without taking it.
+  std::mutex mutex_;
+  std::map<Key, std::unique_ptr<AggregatedCounter>> counters_;
+  std::map<Key, std::unique_ptr<AggregatedIntegerHistogram>> histograms_;
+
+  async::TaskClosureMethod<AggregatingMetricEventLogger,
+                           &AggregatingMetricEventLogger::PeriodicFlush>
+      flush_task_{this};
+};
+
+}  // namespace cobalt
+
+#endif  // SRC_LIB_COBALT_CPP_AGGREGATING_METRIC_EVENT_LOGGER_H_
@@ -0,0 +1,162 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/lib/cobalt/cpp/aggregating_metric_event_logger.h"
+
+#include <fuchsia/metrics/cpp/fidl_test_base.h>
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "src/lib/cobalt/cpp/metric_event_builder.h"
+#include "src/lib/testing/loop_fixture/test_loop_fixture.h"
+
+namespace cobalt {
+namespace {
+
+using fuchsia::metrics::HistogramBucket;
+using fuchsia::metrics::MetricEvent;
+
+const uint32_t kMetricId = 123;
+const uint32_t kDimension = 456;
+const zx::duration kFlushPeriod = zx::min(1);
+
+class FakeMetricEventLogger : public fuchsia::metrics::testing::MetricEventLogger_TestBase {
+ public:
+  void LogMetricEvents(std::vector<MetricEvent> events,
+                       LogMetricEventsCallback callback) override {
+    ++calls_;
+    for (auto& event : events) {
+      events_.push_back(std::move(event));
+    }
+    callback(fpromise::ok());
+  }
+
+  void NotImplemented_(const std::string& name) override { FAIL() << name << " called"; }
+
+  size_t calls() const { return calls_; }
+  const std::vector<MetricEvent>& events() const { return events_; }
+
+ private:
+  size_t calls_ = 0;
+  std::vector<MetricEvent> events_;
+};
+
+using AggregatingMetricEventLoggerTest = gtest::TestLoopFixture;
+
+TEST(IntegerHistogramBuckets, Linear) {
+  const auto buckets = IntegerHistogramBuckets::Linear(0, 3, 10);
+  EXPECT_EQ(buckets.num_buckets(), 3u);
+  EXPECT_EQ(buckets.IndexOf(-1), 0u);
+  EXPECT_EQ(buckets.IndexOf(0), 1u);
+  EXPECT_EQ(buckets.IndexOf(9), 1u);
+  EXPECT_EQ(buckets.IndexOf(10), 2u);
+  EXPECT_EQ(buckets.IndexOf(29), 3u);
+  EXPECT_EQ(buckets.IndexOf(30), 4u);
+}
+
+TEST(IntegerHistogramBuckets, Exponential) {
+  const auto buckets = IntegerHistogramBuckets::Exponential(5, 3, 10, 2);
+  EXPECT_EQ(buckets.num_buckets(), 3u);
+  EXPECT_EQ(buckets.IndexOf(4), 0u);
+  EXPECT_EQ(buckets.IndexOf(5), 1u);
+  EXPECT_EQ(buckets.IndexOf(15), 2u);
+  EXPECT_EQ(buckets.IndexOf(24), 2u);
+  EXPECT_EQ(buckets.IndexOf(25), 3u);
+  EXPECT_EQ(buckets.IndexOf(44), 3u);
+  EXPECT_EQ(buckets.IndexOf(45), 4u);
+}
+
+TEST_F(AggregatingMetricEventLoggerTest, AggregatesCounters) {
+  FakeMetricEventLogger fake;
+  AggregatingMetricEventLogger logger(dispatcher(), &fake, kFlushPeriod);
+
+  AggregatedCounter* counter = logger.GetCounter(kMetricId, {kDimension});
+  EXPECT_EQ(logger.GetCounter(kMetricId, {kDimension}), counter);
+  for (int i = 0; i < 100; ++i) {
+    counter->Add();
+  }
+  logger.GetCounter(kMetricId)->Add(5);
+
+  const std::vector<MetricEvent> events = logger.TakeEvents();
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_TRUE(fidl::Equals(events[0], MetricEventBuilder(kMetricId).as_occurrence(5)));
+  EXPECT_TRUE(fidl::Equals(
+      events[1], MetricEventBuilder(kMetricId).with_event_code(kDimension).as_occurrence(100)));
+
+  // Nothing is reported once it has been taken.
+  EXPECT_TRUE(logger.TakeEvents().empty());
+}
+
+TEST_F(AggregatingMetricEventLoggerTest, AggregatesHistograms) {
+  FakeMetricEventLogger fake;
+  AggregatingMetricEventLogger logger(dispatcher(), &fake, kFlushPeriod);
+
+  AggregatedIntegerHistogram* histogram =
+      logger.GetIntegerHistogram(kMetricId, IntegerHistogramBuckets::Linear(0, 3, 10));
+  histogram->Record(-5);
+  histogram->Record(12);
+  histogram->Record(15, 2);
+  histogram->Record(100);
+
+  const std::vector<MetricEvent> events = logger.TakeEvents();
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_TRUE(fidl::Equals(events[0], MetricEventBuilder(kMetricId).as_integer_histogram({
+                                          HistogramBucket{.index = 0, .count = 1},
+                                          HistogramBucket{.index = 2, .count = 3},
+                                          HistogramBucket{.index = 4, .count = 1},
+                                      })));
+}
+
+TEST_F(AggregatingMetricEventLoggerTest, FlushesPeriodicallyInOneBatch) {
+  FakeMetricEventLogger fake;
+  AggregatingMetricEventLogger logger(dispatcher(), &fake, kFlushPeriod);
+
+  AggregatedCounter* counter = logger.GetCounter(kMetricId);
+  AggregatedIntegerHistogram* histogram =
+      logger.GetIntegerHistogram(kMetricId + 1, IntegerHistogramBuckets::Linear(0, 3, 10));
+  counter->Add();
+  histogram->Record(1);
+
+  RunLoopFor(kFlushPeriod);
+  EXPECT_EQ(fake.calls(), 1u);
+  EXPECT_EQ(fake.events().size(), 2u);
+
+  // Nothing is logged when nothing has been aggregated.
+  RunLoopFor(kFlushPeriod);
+  EXPECT_EQ(fake.calls(), 1u);
+
+  counter->Add();
+  RunLoopFor(kFlushPeriod);
+  EXPECT_EQ(fake.calls(), 2u);
+  EXPECT_EQ(fake.events().size(), 3u);
+}
+
+TEST_F(AggregatingMetricEventLoggerTest, AddsFromManyThreads) {
+  FakeMetricEventLogger fake;
+  AggregatingMetricEventLogger logger(dispatcher(), &fake, kFlushPeriod);
+
+  constexpr size_t kThreads = 4;
+  constexpr uint64_t kAddsPerThread = 10000;
+  AggregatedCounter* counter = logger.GetCounter(kMetricId);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreads; ++i) {
+    threads.emplace_back([counter] {
+      for (uint64_t j = 0; j < kAddsPerThread; ++j) {
+        counter->Add();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const std::vector<MetricEvent> events = logger.TakeEvents();
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_EQ(events[0].payload.count(), kThreads * kAddsPerThread);
+}
+
+}  // namespace
+}  // namespace cobalt
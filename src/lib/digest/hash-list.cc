@@ -10,6 +10,8 @@
 #include <zircon/types.h>
 
 #include <algorithm>
+#include <thread>
+#include <vector>
 
 #include <fbl/algorithm.h>
 
@@ -70,6 +72,20 @@ zx_status_t HashListBase::ProcessData(const uint8_t *buf, size_t buf_len, size_t
   list_off_ = GetListOffset(data_off);
   size_t data_len_with_padding =
       pad_data_to_node_size_ ? fbl::round_up(data_len_, GetNodeSize()) : data_len_;
+  // Whole nodes are independent of each other, so large runs of them can be hashed in parallel.
+  // Any partial node at either end is left for the loop below.
+  size_t node_count = buf_len / GetNodeSize();
+  if (thread_count_ > 1 && node_digest_.IsAligned(data_off_) &&
+      node_count >= 2 * kMinNodesPerThread) {
+    if ((rc = ProcessNodesInParallel(buf, node_count, data_off_, data_len_with_padding)) != ZX_OK) {
+      return rc;
+    }
+    size_t chunk = node_count * GetNodeSize();
+    buf += chunk;
+    buf_len -= chunk;
+    data_off_ += chunk;
+    list_off_ += node_count * GetDigestSize();
+  }
   while (buf_len != 0) {
     if (node_digest_.IsAligned(data_off_) &&
         (rc = node_digest_.Reset(data_off_, data_len_with_padding)) != ZX_OK) {
@@ -90,8 +106,53 @@ zx_status_t HashListBase::ProcessData(const uint8_t *buf, size_t buf_len, size_t
   return ZX_OK;
 }
 
+zx_status_t HashListBase::ProcessNodesInParallel(const uint8_t *buf, size_t node_count,
+                                                 size_t data_off, size_t data_len_with_padding) {
+  size_t node_size = GetNodeSize();
+  size_t thread_count = std::min(thread_count_, node_count / kMinNodesPerThread);
+  std::vector<zx_status_t> results(thread_count, ZX_OK);
+  std::vector<uint8_t> matched(thread_count, true);
+  auto hash_nodes = [&](size_t index) {
+    // Spread the remainder over the first few threads.
+    size_t first = index * (node_count / thread_count) + std::min(index, node_count % thread_count);
+    size_t count = node_count / thread_count + (index < node_count % thread_count ? 1 : 0);
+    NodeDigest node_digest;
+    node_digest.set_id(GetNodeId());
+    if ((results[index] = node_digest.SetNodeSize(node_size)) != ZX_OK) {
+      return;
+    }
+    for (size_t i = first; i < first + count; ++i) {
+      size_t node_off = data_off + i * node_size;
+      if ((results[index] = node_digest.Reset(node_off, data_len_with_padding)) != ZX_OK) {
+        return;
+      }
+      node_digest.Append(buf + i * node_size, node_size);
+      matched[index] &= HandleOne(GetListOffset(node_off), node_digest.get());
+    }
+  };
+
+  // The calling thread takes the last share rather than waiting idle.
+  std::vector<std::thread> threads;
+  threads.reserve(thread_count - 1);
+  for (size_t i = 0; i + 1 < thread_count; ++i) {
+    threads.emplace_back(hash_nodes, i);
+  }
+  hash_nodes(thread_count - 1);
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  for (size_t i = 0; i < thread_count; ++i) {
+    if (results[i] != ZX_OK) {
+      return results[i];
+    }
+    matched_ &= matched[i];
+  }
+  return ZX_OK;
+}
+
 void HashListBase::HandleOne() {
-  HandleOne(node_digest_.get());
+  matched_ &= HandleOne(list_off_, node_digest_.get());
   list_off_ += GetDigestSize();
 }
 
@@ -126,8 +187,9 @@ zx_status_t HashListCreator::Append(const void *buf, size_t buf_len) {
   return this->ProcessData(static_cast<const uint8_t *>(buf), buf_len, this->data_off());
 }
 
-void HashListCreator::HandleOne(const Digest &digest) {
-  digest.CopyTo(list() + list_off(), GetDigestSize());
+bool HashListCreator::HandleOne(size_t list_off, const Digest &digest) {
+  digest.CopyTo(list() + list_off, GetDigestSize());
+  return true;
 }
 
 // HashListVerifier
@@ -138,7 +200,7 @@ template zx_status_t internal::HashList<const uint8_t>::SetList(const uint8_t *l
 
 zx_status_t HashListVerifier::Verify(const void *buf, size_t buf_len, size_t data_off) {
   zx_status_t rc;
-  verified_ = true;
+  ResetMatched();
   if (data_len() == 0) {
     rc = SetList(list(), list_len());
   } else {
@@ -147,7 +209,7 @@ zx_status_t HashListVerifier::Verify(const void *buf, size_t buf_len, size_t dat
   if (rc != ZX_OK) {
     return rc;
   }
-  return verified_ ? ZX_OK : ZX_ERR_IO_DATA_INTEGRITY;
+  return matched() ? ZX_OK : ZX_ERR_IO_DATA_INTEGRITY;
 }
 
 bool HashListVerifier::IsValidRange(size_t data_off, size_t buf_len) {
@@ -163,8 +225,8 @@ bool HashListVerifier::IsValidRange(size_t data_off, size_t buf_len) {
   }
 }
 
-void HashListVerifier::HandleOne(const Digest &digest) {
-  verified_ &= (digest.Equals(list() + list_off(), GetDigestSize()));
+bool HashListVerifier::HandleOne(size_t list_off, const Digest &digest) {
+  return digest.Equals(list() + list_off, GetDigestSize());
 }
 
 size_t CalculateHashListSize(size_t data_size, size_t node_size) {
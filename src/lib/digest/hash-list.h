@@ -9,6 +9,8 @@
 #include <zircon/errors.h>
 #include <zircon/types.h>
 
+#include <algorithm>
+
 #include "src/lib/digest/digest.h"
 #include "src/lib/digest/node-digest.h"
 
@@ -52,6 +54,13 @@ class HashListBase {
     pad_data_to_node_size_ = pad_data_to_node_size;
   }
 
+  // Sets the maximum number of threads used to hash the nodes of a single call. A call is only
+  // split up when each thread gets at least |kMinNodesPerThread| whole nodes; anything smaller is
+  // cheaper to hash on the calling thread than it is to start another one. Defaults to 1.
+  void SetThreadCount(size_t thread_count) { thread_count_ = std::max(thread_count, size_t{1}); }
+  size_t GetThreadCount() const { return thread_count_; }
+  static constexpr size_t kMinNodesPerThread = 64;
+
   // Returns the corresponding offset in the hash list for an offset in the data. This method
   // does not check if |data_off| is within bounds.
   size_t GetListOffset(size_t data_off) const;
@@ -72,14 +81,26 @@ class HashListBase {
   zx_status_t ProcessData(const uint8_t *buf, size_t buf_len, size_t data_off);
 
   // Process the next digest in the hash list, e.g. write a digest when creating, or compare when
-  // verifying. The no-argument version simply invokes the second version with the current digest.
-  // The second version is implemented in derived classes.
+  // verifying. The no-argument version simply invokes the second version with the current digest
+  // and offset. The second version is implemented in derived classes, and returns false if the
+  // digest does not match the one at |list_off|. It may be called concurrently for different
+  // offsets when using more than one thread.
   void HandleOne();
-  virtual void HandleOne(const Digest &digest) {}
+  virtual bool HandleOne(size_t list_off, const Digest &digest) { return true; }
+
+  // Returns false if |HandleOne| reported a mismatch since the last call to |ResetMatched|.
+  bool matched() const { return matched_; }
+  void ResetMatched() { matched_ = true; }
 
  private:
   zx_status_t Check(size_t off, size_t len, size_t max, size_t *out = nullptr) const;
 
+  // Hashes |node_count| whole nodes from |buf| corresponding to the data sequence starting at the
+  // node-aligned |data_off|, splitting them between up to |thread_count_| threads. This does not
+  // use or modify |node_digest_|.
+  zx_status_t ProcessNodesInParallel(const uint8_t *buf, size_t node_count, size_t data_off,
+                                     size_t data_len_with_padding);
+
   // Digest object used to create hashes to store or check.
   NodeDigest node_digest_;
 
@@ -94,6 +115,11 @@ class HashListBase {
   // Whether the hash list should pad the length of the data it's given up to the next multiple of
   // the node size.
   bool pad_data_to_node_size_ = false;
+
+  size_t thread_count_ = 1;
+
+  // Whether every digest handled since the last |ResetMatched| matched.
+  bool matched_ = true;
 };
 
 // |digest::internal::HashList| contains code templated on the list type. Callers MUST NOT use this
@@ -130,7 +156,7 @@ class HashListCreator : public internal::HashList<uint8_t> {
 
  protected:
   // Writes a single calculated digest to the appropriate position in the list.
-  void HandleOne(const Digest &digest) override;
+  bool HandleOne(size_t list_off, const Digest &digest) override;
 };
 
 // |digest::HashListVerifier| verifies data against a hash list.
@@ -152,13 +178,10 @@ class HashListVerifier : public internal::HashList<const uint8_t> {
   // data.
   bool IsValidRange(size_t data_off, size_t buf_len) override;
 
-  // Compares a single calculated digest to the corresponding one in the list.
-  void HandleOne(const Digest &digest) override;
-
- private:
-  // Used to store the verification result. The verification logic intentionally does NOT short
-  // circuit; we want the hash checks to be as close to constant time as possible.
-  bool verified_ = false;
+  // Compares a single calculated digest to the corresponding one in the list. The verification
+  // logic intentionally does NOT short circuit; we want the hash checks to be as close to constant
+  // time as possible.
+  bool HandleOne(size_t list_off, const Digest &digest) override;
 };
 
 // Convenience method for calculating the minimum size needed to hold a hash list for the given
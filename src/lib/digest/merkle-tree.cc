@@ -41,6 +41,7 @@ zx_status_t MerkleTree<T, VP, MT, HL>::SetDataLength(size_t data_len) {
   next_->hash_list_.SetNodeId(hash_list_.GetNodeId() + 1);
   next_->SetNodeSize(GetNodeSize());
   next_->SetUseCompactFormat(use_compact_format_);
+  next_->SetThreadCount(GetThreadCount());
   size_t next_len = use_compact_format_ ? list_len : fbl::round_up(list_len, GetNodeSize());
   return next_->SetDataLength(next_len);
 }
@@ -79,6 +80,14 @@ void MerkleTree<T, VP, MT, HL>::SetUseCompactFormat(bool use_compact_format) {
   hash_list_.SetPadDataToNodeSize(use_compact_format_ && hash_list_.GetNodeId());
 }
 
+template <typename T, typename VP, class MT, class HL>
+void MerkleTree<T, VP, MT, HL>::SetThreadCount(size_t thread_count) {
+  hash_list_.SetThreadCount(thread_count);
+  if (next_ != nullptr) {
+    next_->SetThreadCount(thread_count);
+  }
+}
+
 }  // namespace internal
 
 // MerkleTreeCreator
@@ -97,15 +106,19 @@ template zx_status_t internal::MerkleTree<uint8_t, void *, MerkleTreeCreator,
 template void internal::MerkleTree<uint8_t, void *, MerkleTreeCreator,
                                    HashListCreator>::SetUseCompactFormat(bool use_compact_format);
 
+template void internal::MerkleTree<uint8_t, void *, MerkleTreeCreator,
+                                   HashListCreator>::SetThreadCount(size_t thread_count);
+
 // static
 zx_status_t MerkleTreeCreator::Create(const void *data, size_t data_len,
                                       std::unique_ptr<uint8_t[]> *out_tree, size_t *out_tree_len,
-                                      Digest *out_root) {
+                                      Digest *out_root, size_t thread_count) {
   if (out_tree == nullptr || out_tree_len == nullptr || out_root == nullptr) {
     return ZX_ERR_INVALID_ARGS;
   }
   uint8_t root[kSha256Length];
   MerkleTreeCreator creator;
+  creator.SetThreadCount(thread_count);
   zx_status_t rc = creator.SetDataLength(data_len);
   if (rc != ZX_OK) {
     return rc;
@@ -175,6 +188,9 @@ internal::MerkleTree<const uint8_t, const void *, MerkleTreeVerifier, HashListVe
 template void internal::MerkleTree<const uint8_t, const void *, MerkleTreeVerifier,
                                    HashListVerifier>::SetUseCompactFormat(bool use_compact_format);
 
+template void internal::MerkleTree<const uint8_t, const void *, MerkleTreeVerifier,
+                                   HashListVerifier>::SetThreadCount(size_t thread_count);
+
 // static
 zx_status_t MerkleTreeVerifier::Verify(const void *buf, size_t buf_len, size_t data_off,
                                        size_t data_len, const void *tree, size_t tree_len,
@@ -38,6 +38,11 @@ class MerkleTree {
   void SetUseCompactFormat(bool use_compact_format);
   bool GetUseCompactFormat() { return use_compact_format_; }
 
+  // Sets the maximum number of threads used to hash each level of the tree. Only large appends or
+  // verifications are split up; see |HashListBase::SetThreadCount|.
+  void SetThreadCount(size_t thread_count);
+  size_t GetThreadCount() const { return hash_list_.GetThreadCount(); }
+
   // Returns true if |data_off| is aligned to a node boundary.
   bool IsAligned(size_t data_off) const { return hash_list_.IsAligned(data_off); }
 
@@ -89,9 +94,9 @@ class MerkleTreeCreator
     : public internal::MerkleTree<uint8_t, void *, MerkleTreeCreator, HashListCreator> {
  public:
   // Convenience method to create and return a Merkle tree for the given |data| via |out_tree| and
-  // |out_root|.
+  // |out_root|, using up to |thread_count| threads.
   static zx_status_t Create(const void *data, size_t data_len, std::unique_ptr<uint8_t[]> *out_tree,
-                            size_t *out_tree_len, Digest *out_root);
+                            size_t *out_tree_len, Digest *out_root, size_t thread_count = 1);
 
   // Reads |buf_len| bytes of data from |buf| and appends digests to the hash |list|.
   zx_status_t Append(const void *buf, size_t buf_len);
@@ -12,6 +12,7 @@
 #include <iterator>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <fbl/alloc_checker.h>
 #include <gmock/gmock.h>
@@ -346,6 +347,59 @@ TEST_P(MerkleTreeTest, Verify) {
   }
 }
 
+TEST_P(MerkleTreeTest, CreateAndVerifyWithThreads) {
+  srand(::testing::UnitTest::GetInstance()->random_seed());
+  TreeParam tree_param = GetTreeParam();
+  size_t data_len = tree_param.data_len;
+  std::unique_ptr<uint8_t[]> data = AllocateBuffer(data_len, 0x00);
+  for (size_t i = 0; i < data_len; ++i) {
+    data[i] = static_cast<uint8_t>(rand());
+  }
+  size_t tree_len = tree_param.tree_len;
+  std::unique_ptr<uint8_t[]> tree = AllocateBuffer(tree_len, 0x00);
+  std::unique_ptr<uint8_t[]> threaded_tree = AllocateBuffer(tree_len, 0x00);
+
+  uint8_t root[kSha256Length];
+  MerkleTreeCreator creator;
+  creator.SetNodeSize(tree_param.node_size);
+  creator.SetUseCompactFormat(tree_param.use_compact_format);
+  ASSERT_OK(creator.SetDataLength(data_len));
+  ASSERT_OK(creator.SetTree(tree.get(), tree_len, root, sizeof(root)));
+  ASSERT_OK(creator.Append(data.get(), data_len));
+
+  // Threads must not change the tree.
+  uint8_t threaded_root[kSha256Length];
+  MerkleTreeCreator threaded_creator;
+  threaded_creator.SetNodeSize(tree_param.node_size);
+  threaded_creator.SetUseCompactFormat(tree_param.use_compact_format);
+  threaded_creator.SetThreadCount(4);
+  ASSERT_OK(threaded_creator.SetDataLength(data_len));
+  ASSERT_OK(
+      threaded_creator.SetTree(threaded_tree.get(), tree_len, threaded_root, sizeof(threaded_root)));
+  ASSERT_OK(threaded_creator.Append(data.get(), data_len));
+  EXPECT_THAT(threaded_root, ElementsAreArray(root));
+  if (tree_len > 0) {
+    EXPECT_THAT(std::vector<uint8_t>(threaded_tree.get(), threaded_tree.get() + tree_len),
+                ElementsAreArray(tree.get(), tree_len));
+  }
+
+  MerkleTreeVerifier verifier;
+  verifier.SetNodeSize(tree_param.node_size);
+  verifier.SetUseCompactFormat(tree_param.use_compact_format);
+  verifier.SetThreadCount(4);
+  ASSERT_OK(verifier.SetDataLength(data_len));
+  ASSERT_OK(verifier.SetTree(tree.get(), tree_len, root, sizeof(root)));
+  EXPECT_OK(verifier.Verify(data.get(), data_len, 0));
+  // A mismatch in any thread's share of the nodes fails verification.
+  if (data_len != 0) {
+    size_t flip = rand() % data_len;
+    data[flip] ^= 0xff;
+    EXPECT_STATUS(verifier.Verify(data.get(), data_len, 0), ZX_ERR_IO_DATA_INTEGRITY);
+    data[flip] ^= 0xff;
+    EXPECT_OK(verifier.Verify(data.get(), data_len, 0));
+  }
+}
+
 TEST_P(MerkleTreeTest, CalculateMerkleTreeSize) {
   TreeParam tree_param = GetTreeParam();
   EXPECT_EQ(CalculateMerkleTreeSize(tree_param.data_len, tree_param.node_size,
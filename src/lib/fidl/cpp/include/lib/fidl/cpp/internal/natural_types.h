@@ -237,6 +237,10 @@ struct NaturalStructPadding final {
   [[nodiscard]] bool ValidatePadding(NaturalDecoder* decoder, size_t base_offset) {
     return (*decoder->GetPtr<MaskType>(base_offset + offset) & mask) == 0;
   }
+
+  void ZeroPadding(NaturalEncoder* encoder, size_t base_offset) {
+    *encoder->GetPtr<MaskType>(base_offset + offset) &= static_cast<MaskType>(~mask);
+  }
 };
 
 template <typename T, size_t Size>
@@ -252,10 +256,21 @@ struct NaturalStructCodingTraits {
   // True iff fields are memcpy compatible and there is no padding.
   static constexpr bool is_memcpy_compatible =
       are_members_memcpy_compatible && std::tuple_size_v<decltype(T::kPadding)> == 0;
+  // True iff fields are memcpy compatible but there is padding between them. Such a struct is
+  // still copied as a whole, and only its padding is zeroed on encode and checked on decode. It
+  // isn't memcpy compatible itself since containing objects would skip over its padding.
+  static constexpr bool is_memcpy_compatible_with_padding =
+      are_members_memcpy_compatible && !is_memcpy_compatible && sizeof(T) == Size;
 
   static void Encode(NaturalEncoder* encoder, T* value, size_t offset, size_t recursion_depth) {
     if constexpr (is_memcpy_compatible) {
       memcpy(encoder->GetPtr<T>(offset), value, sizeof(T));
+    } else if constexpr (is_memcpy_compatible_with_padding) {
+      memcpy(encoder->GetPtr<T>(offset), value, sizeof(T));
+      TupleVisitor::All(T::kPadding, [encoder, offset](auto padding) {
+        padding.ZeroPadding(encoder, offset);
+        return true;
+      });
     } else {
       MemberVisitor<T>::Visit(value, [&](auto* member, auto& member_info) -> void {
         using Constraint = typename std::remove_reference_t<decltype(member_info)>::Constraint;
@@ -268,6 +283,15 @@ struct NaturalStructCodingTraits {
   static void Decode(NaturalDecoder* decoder, T* value, size_t offset, size_t recursion_depth) {
     if constexpr (is_memcpy_compatible) {
       memcpy(value, decoder->GetPtr<T>(offset), sizeof(T));
+    } else if constexpr (is_memcpy_compatible_with_padding) {
+      auto valid_padding_predicate = [decoder, offset](auto padding) {
+        return padding.ValidatePadding(decoder, offset);
+      };
+      if (!TupleVisitor::All(T::kPadding, valid_padding_predicate)) {
+        decoder->SetError(kCodingErrorInvalidPaddingBytes);
+        return;
+      }
+      memcpy(value, decoder->GetPtr<T>(offset), sizeof(T));
     } else {
       MemberVisitor<T>::Visit(value, [&](auto* member, auto& member_info) {
         using Constraint = typename std::remove_reference_t<decltype(member_info)>::Constraint;
@@ -387,10 +387,8 @@ struct NaturalCodingTraits<cpp17::optional<std::vector<T>>, Constraint> {
     fidl_vector_t* vec = decoder->template GetPtr<fidl_vector_t>(offset);
     switch (reinterpret_cast<uintptr_t>(vec->data)) {
       case FIDL_ALLOC_PRESENT: {
-        std::vector<T> unwrapped;
         fidl::internal::NaturalCodingTraits<std::vector<T>, Constraint>::Decode(
-            decoder, &unwrapped, offset, recursion_depth);
-        value->emplace(std::move(unwrapped));
+            decoder, &value->emplace(), offset, recursion_depth);
         return;
       }
       case FIDL_ALLOC_ABSENT: {
@@ -545,7 +543,7 @@ struct NaturalCodingTraits<::std::string, Constraint> final {
       decoder->SetError(kCodingErrorStringNotValidUtf8);
       return;
     }
-    *value = std::string(payload, string->size);
+    value->assign(payload, string->size);
   }
 };
 
@@ -570,10 +568,9 @@ struct NaturalCodingTraits<cpp17::optional<std::string>, Constraint> {
     fidl_string_t* string = decoder->template GetPtr<fidl_string_t>(offset);
     switch (reinterpret_cast<uintptr_t>(string->data)) {
       case FIDL_ALLOC_PRESENT: {
-        std::string unwrapped;
+        // Decode in place, so that the string data is only allocated once.
         fidl::internal::NaturalCodingTraits<std::string, Constraint>::Decode(
-            decoder, &unwrapped, offset, recursion_depth);
-        value->emplace(unwrapped);
+            decoder, &value->emplace(), offset, recursion_depth);
         return;
       }
       case FIDL_ALLOC_ABSENT: {
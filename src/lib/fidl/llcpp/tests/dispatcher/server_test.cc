@@ -16,6 +16,7 @@
 #include <zxtest/zxtest.h>
 
 #include "lsan_disabler.h"
+#include "test_messages.h"
 
 //
 // Mock FIDL protocol and its |WireServer| definition.
@@ -57,6 +58,46 @@ class ::fidl::WireServer<fidl_test::TestProtocol>
   }
 };
 
+// A protocol whose server counts the one-way messages it receives.
+namespace fidl_test {
+namespace {
+class CountingProtocol {
+ public:
+  CountingProtocol() = delete;
+
+  using Transport = fidl::internal::ChannelTransport;
+  using WeakEventSender = fidl::internal::WireWeakEventSender<fidl_test::CountingProtocol>;
+};
+}  // namespace
+}  // namespace fidl_test
+
+template <>
+class ::fidl::internal::WireWeakEventSender<fidl_test::CountingProtocol> {
+ public:
+  explicit WireWeakEventSender(std::weak_ptr<fidl::internal::AsyncServerBinding>&& binding) {}
+};
+
+template <>
+class ::fidl::WireServer<fidl_test::CountingProtocol>
+    : public ::fidl::internal::IncomingMessageDispatcher {
+ public:
+  WireServer() = default;
+  ~WireServer() override = default;
+
+  using _EnclosingProtocol = fidl_test::CountingProtocol;
+  using _Transport = fidl::internal::ChannelTransport;
+
+  uint32_t message_count() const { return message_count_; }
+
+ private:
+  void dispatch_message(::fidl::IncomingHeaderAndMessage&& msg, ::fidl::Transaction* txn,
+                        internal::MessageStorageViewBase* storage_view) final {
+    message_count_++;
+  }
+
+  uint32_t message_count_ = 0;
+};
+
 namespace {
 
 class TestServer : public fidl::WireServer<fidl_test::TestProtocol> {};
@@ -129,6 +170,37 @@ TEST(BindServerTestCase, PeerAlreadyClosed) {
   ASSERT_OK(sync_completion_wait(&unbound, ZX_TIME_INFINITE));
 }
 
+//
+// Tests covering how |BindServer| reads messages.
+//
+
+TEST(BindServerTestCase, DispatchesPendingMessagesPerWakeup) {
+  async::Loop loop(&kAsyncLoopConfigNoAttachToCurrentThread);
+  zx::status endpoints = fidl::CreateEndpoints<fidl_test::CountingProtocol>();
+  ASSERT_OK(endpoints.status_value());
+
+  auto server = std::make_unique<fidl::WireServer<fidl_test::CountingProtocol>>();
+  auto* server_ptr = server.get();
+  fidl::ServerBindingRef binding =
+      fidl::BindServer(loop.dispatcher(), std::move(endpoints->server), std::move(server));
+  binding.SetMaxMessagesPerWakeup(3);
+
+  for (int i = 0; i < 5; i++) {
+    fidl_message_header_t header;
+    fidl::InitTxnHeader(&header, 0, fidl_testing::kTestOrdinal,
+                        fidl::MessageDynamicFlags::kStrictMethod);
+    ASSERT_OK(endpoints->client.channel().write(0, &header, sizeof(header), nullptr, 0));
+  }
+
+  // Each wakeup dispatches at most three of the pending messages.
+  ASSERT_OK(loop.Run(zx::time::infinite(), true));
+  EXPECT_EQ(3u, server_ptr->message_count());
+  ASSERT_OK(loop.Run(zx::time::infinite(), true));
+  EXPECT_EQ(5u, server_ptr->message_count());
+  ASSERT_OK(loop.RunUntilIdle());
+  EXPECT_EQ(5u, server_ptr->message_count());
+}
+
 // Test the behavior of |fidl::internal::[Try]Dispatch| in case of a message
 // with an error.
 TEST(TryDispatchTestCase, MessageStatusNotOk) {
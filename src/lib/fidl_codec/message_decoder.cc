@@ -69,10 +69,46 @@ bool DecodedMessage::DecodeMessage(MessageDecoderDispatcher* dispatcher, uint64_
 
   method_ = (*methods)[0];
 
-  matched_request_ = DecodeRequest(method_, bytes, num_bytes, handles, num_handles,
-                                   &decoded_request_, request_error_stream_);
-  matched_response_ = DecodeResponse(method_, bytes, num_bytes, handles, num_handles,
-                                     &decoded_response_, response_error_stream_);
+  auto decode_request = [&]() {
+    matched_request_ = DecodeRequest(method_, bytes, num_bytes, handles, num_handles,
+                                     &decoded_request_, request_error_stream_);
+  };
+  auto decode_response = [&]() {
+    matched_response_ = DecodeResponse(method_, bytes, num_bytes, handles, num_handles,
+                                       &decoded_response_, response_error_stream_);
+  };
+
+  // Decoding is the most expensive part of this function. When we already know if the message is
+  // a request or a response, only that side is decoded: FidlMessageValue drops the other one. The
+  // other side is only needed when the expected one doesn't decode, to check the direction.
+  switch (type) {
+    case SyscallFidlType::kOutputMessage:
+    case SyscallFidlType::kInputMessage: {
+      Direction known_direction = dispatcher->GetDirection(process_koid, handle);
+      if (known_direction == Direction::kUnknown) {
+        decode_request();
+        decode_response();
+      } else if ((known_direction == Direction::kClient) ==
+                 (type == SyscallFidlType::kOutputMessage)) {
+        decode_request();
+        if (!matched_request_) {
+          decode_response();
+        }
+      } else {
+        decode_response();
+        if (!matched_response_) {
+          decode_request();
+        }
+      }
+      break;
+    }
+    case SyscallFidlType::kOutputRequest:
+      decode_request();
+      break;
+    case SyscallFidlType::kInputResponse:
+      decode_response();
+      break;
+  }
 
   direction_ = dispatcher->ComputeDirection(process_koid, handle, type, method_,
                                             matched_request_ != matched_response_);
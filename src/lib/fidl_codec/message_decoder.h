@@ -107,6 +107,13 @@ class MessageDecoderDispatcher {
   Direction ComputeDirection(uint64_t process_koid, zx_handle_t handle, SyscallFidlType type,
                              const ProtocolMethod* method, bool only_one_valid);
 
+  // Returns the direction already computed for this handle, or kUnknown if there is none yet.
+  Direction GetDirection(uint64_t process_koid, zx_handle_t handle) const {
+    auto handle_direction = handle_directions_.find(std::make_tuple(handle, process_koid));
+    return (handle_direction == handle_directions_.end()) ? Direction::kUnknown
+                                                          : handle_direction->second;
+  }
+
   // Update the direction. Used when the heuristic was wrong.
   void UpdateDirection(uint64_t process_koid, zx_handle_t handle, Direction direction) {
     handle_directions_[std::make_tuple(handle, process_koid)] = direction;
@@ -149,6 +149,23 @@ TEST_F(MessageDecoderTest, TestEchoAttached) {
                       "Hello World", [](const ::fidl::StringPtr&) {});
 }
 
+// When the direction of the handle is known, the side which can't match is not decoded.
+TEST_F(MessageDecoderTest, TestEchoKnownDirectionDecodesOneSide) {
+  decoder()->UpdateDirection(process_koid(), ZX_HANDLE_INVALID, Direction::kClient);
+  auto message = InvokeAndIntercept<Echo>([](fidl::InterfacePtr<Echo>& ptr) {
+    ptr->EchoString("Hello World", [](const ::fidl::StringPtr&) {});
+  });
+  DecodedMessage decoded_message;
+  std::stringstream error_stream;
+  ASSERT_TRUE(decoded_message.DecodeMessage(decoder(), process_koid(), ZX_HANDLE_INVALID,
+                                            message.bytes().data(), message.bytes().size(),
+                                            nullptr, 0, SyscallFidlType::kOutputMessage,
+                                            error_stream));
+  ASSERT_TRUE(decoded_message.is_request());
+  ASSERT_NE(decoded_message.decoded_request(), nullptr);
+  ASSERT_EQ(decoded_message.decoded_response(), nullptr);
+}
+
 TEST_F(MessageDecoderTest, TestEpitaphReceived) {
   auto message = InvokeAndReceiveEpitaph(ZX_ERR_UNAVAILABLE);
   AssertDecoded(message, SyscallFidlType::kInputMessage, "received epitaph ZX_ERR_UNAVAILABLE\n");
@@ -4,14 +4,19 @@
 
 #include "src/lib/icu_data/cpp/icu_data.h"
 
+#include <fcntl.h>
+#include <lib/fdio/io.h>
 #include <lib/syslog/cpp/macros.h>
 #include <lib/zx/vmar.h>
+#include <sys/stat.h>
 #include <zircon/errors.h>
 
 #include <fstream>
 #include <optional>
 #include <string>
+#include <utility>
 
+#include <fbl/unique_fd.h>
 #include <src/lib/files/directory.h>
 
 #include "src/lib/fsl/vmo/file.h"
@@ -52,6 +57,36 @@ uintptr_t GetData(const fsl::SizedVmo& icu_data, size_t* size_out) {
   return 0u;
 }
 
+// Gets the ICU data as a VMO that shares its pages with the filesystem, so that all the
+// components using ICU map the same memory. The file's own VMO is preferred since it needs no
+// clone bookkeeping in the kernel. Filesystems with immutable files (e.g. blobfs) only hand out
+// clones, which share the pages just as well. Only when neither is granted is the data copied
+// into memory private to this process.
+bool GetIcuDataVmo(fsl::SizedVmo* icu_data) {
+  fbl::unique_fd fd(open(kIcuDataPath, O_RDONLY));
+  if (!fd.is_valid())
+    return false;
+  struct stat stat_struct;
+  if (fstat(fd.get(), &stat_struct) == -1)
+    return false;
+  zx::vmo vmo;
+  zx_status_t status = fdio_get_vmo_exact(fd.get(), vmo.reset_and_get_address());
+  if (status != ZX_OK) {
+    status = fdio_get_vmo_clone(fd.get(), vmo.reset_and_get_address());
+  }
+  if (status == ZX_OK) {
+    // Check the VMO the filesystem granted actually holds the whole file before mapping it.
+    uint64_t vmo_size = 0;
+    status = vmo.get_size(&vmo_size);
+    if (status == ZX_OK && vmo_size >= static_cast<uint64_t>(stat_struct.st_size)) {
+      *icu_data = fsl::SizedVmo(std::move(vmo), stat_struct.st_size);
+      return true;
+    }
+  }
+  FX_LOGS(WARNING) << "could not get a shared VMO for " << kIcuDataPath << ", copying it";
+  return fsl::VmoFromFd(std::move(fd), icu_data);
+}
+
 }  // namespace
 
 zx_status_t Initialize() { return InitializeWithTzResourceDir(nullptr); }
@@ -98,7 +133,7 @@ zx_status_t InitializeWithTzResourceDirAndValidate(const char tz_files_dir[],
   }
 
   fsl::SizedVmo icu_data;
-  if (!fsl::VmoFromFilename(kIcuDataPath, &icu_data)) {
+  if (!GetIcuDataVmo(&icu_data)) {
     FX_LOGS(ERROR) << "could not create VMO from filename: " << kIcuDataPath;
     return ZX_ERR_IO;
   }
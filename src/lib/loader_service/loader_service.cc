@@ -10,6 +10,9 @@
 #include <lib/fidl-async/cpp/bind.h>
 #include <lib/syslog/cpp/macros.h>
 #include <zircon/errors.h>
+#include <zircon/syscalls/object.h>
+
+#include <cstring>
 
 #include "src/lib/files/path.h"
 #include "src/lib/fxl/strings/string_printf.h"
@@ -136,13 +139,52 @@ void LoaderConnection::Clone(CloneRequestView request, CloneCompleter::Sync& com
 
 // static
 std::shared_ptr<LoaderService> LoaderService::Create(async_dispatcher_t* dispatcher,
-                                                     fbl::unique_fd lib_dir, std::string name) {
+                                                     fbl::unique_fd lib_dir, std::string name,
+                                                     bool cache_objects) {
   // Can't use make_shared because constructor is protected
   return std::shared_ptr<LoaderService>(
-      new LoaderService(dispatcher, std::move(lib_dir), std::move(name)));
+      new LoaderService(dispatcher, std::move(lib_dir), std::move(name), cache_objects));
 }
 
 zx::status<zx::vmo> LoaderService::LoadObjectImpl(std::string path) {
+  if (!cache_objects_) {
+    return OpenObject(path);
+  }
+
+  std::lock_guard lock(cache_lock_);
+  auto it = cache_.find(path);
+  if (it == cache_.end()) {
+    auto status = OpenObject(path);
+    if (status.is_error()) {
+      return status.take_error();
+    }
+    it = cache_.emplace(path, std::move(status).value()).first;
+  }
+  const zx::vmo& cached = it->second;
+
+  // Each client gets its own child so that none can affect what another maps. The child keeps
+  // ZX_RIGHT_EXECUTE since it can never be written.
+  uint64_t size;
+  zx_status_t status = cached.get_size(&size);
+  if (status != ZX_OK) {
+    return zx::error(status);
+  }
+  zx::vmo vmo;
+  status = cached.create_child(ZX_VMO_CHILD_SNAPSHOT_AT_LEAST_ON_WRITE | ZX_VMO_CHILD_NO_WRITE, 0,
+                               size, &vmo);
+  if (status != ZX_OK) {
+    return zx::error(status);
+  }
+
+  // Keep the name the filesystem gave the VMO, which shows up in memory diagnostics.
+  char name[ZX_MAX_NAME_LEN];
+  if (cached.get_property(ZX_PROP_NAME, name, sizeof(name)) == ZX_OK) {
+    vmo.set_property(ZX_PROP_NAME, name, strnlen(name, sizeof(name)));
+  }
+  return zx::ok(std::move(vmo));
+}
+
+zx::status<zx::vmo> LoaderService::OpenObject(const std::string& path) {
   const fio::wire::OpenFlags kFlags = fio::wire::OpenFlags::kNotDirectory |
                                       fio::wire::OpenFlags::kRightReadable |
                                       fio::wire::OpenFlags::kRightExecutable;
@@ -10,9 +10,13 @@
 #include <lib/zx/channel.h>
 #include <lib/zx/status.h>
 #include <lib/zx/vmo.h>
+#include <zircon/compiler.h>
 #include <zircon/types.h>
 
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
 #include <fbl/macros.h>
 #include <fbl/unique_fd.h>
@@ -105,16 +109,33 @@ class LoaderService : public LoaderServiceBase {
   // This takes ownership of the 'lib_dir` fd and will close it automatically once all connections
   // to the loader service are closed and copies of this object are destroyed. `name` is used to
   // provide context when logging.
+  //
+  // If `cache_objects` is true, each object is opened from `lib_dir` only the first time it is
+  // loaded, and later loads of the same path get a new read-only copy-on-write child of the same
+  // VMO. This saves a file open and VMO fetch per library for every process launched. It must only
+  // be used when the contents of `lib_dir` never change, e.g. for "/boot/lib" or "/pkg/lib".
   static std::shared_ptr<LoaderService> Create(async_dispatcher_t* dispatcher,
-                                               fbl::unique_fd lib_dir, std::string name);
+                                               fbl::unique_fd lib_dir, std::string name,
+                                               bool cache_objects = false);
 
  protected:
-  LoaderService(async_dispatcher_t* dispatcher, fbl::unique_fd lib_dir, std::string name)
-      : LoaderServiceBase(dispatcher, std::move(name)), dir_(std::move(lib_dir)) {}
+  LoaderService(async_dispatcher_t* dispatcher, fbl::unique_fd lib_dir, std::string name,
+                bool cache_objects = false)
+      : LoaderServiceBase(dispatcher, std::move(name)),
+        dir_(std::move(lib_dir)),
+        cache_objects_(cache_objects) {}
   virtual zx::status<zx::vmo> LoadObjectImpl(std::string path) override;
 
  private:
+  zx::status<zx::vmo> OpenObject(const std::string& path);
+
   fbl::unique_fd dir_;
+  const bool cache_objects_;
+
+  // Objects successfully opened so far when cache_objects_ is set, keyed by path. Failures are not
+  // cached.
+  std::mutex cache_lock_;
+  std::unordered_map<std::string, zx::vmo> cache_ __TA_GUARDED(cache_lock_);
 };
 
 }  // namespace loader
@@ -134,6 +134,30 @@ TEST_F(LoaderServiceTest, LoadObject) {
   EXPECT_NO_FATAL_FAILURE(LoadObject(client, "libnoexec.so", zx::error(ZX_ERR_ACCESS_DENIED)));
 }
 
+TEST_F(LoaderServiceTest, CachedLoadObject) {
+  std::vector<TestDirectoryEntry> config;
+  config.emplace_back("libfoo.so", "science", true);
+  fbl::unique_fd root_fd;
+  ASSERT_NO_FATAL_FAILURE(CreateTestDirectory(std::move(config), &root_fd));
+  auto loader = LoaderService::Create(loader_loop().dispatcher(), std::move(root_fd),
+                                      "CachedLoadObject", /*cache_objects=*/true);
+
+  auto status = loader->Connect();
+  ASSERT_TRUE(status.is_ok());
+  fidl::WireSyncClient<fldsvc::Loader> client(std::move(status.value()));
+
+  EXPECT_NO_FATAL_FAILURE(LoadObject(client, "libfoo.so", zx::ok("science")));
+  EXPECT_NO_FATAL_FAILURE(LoadObject(client, "libbar.so", zx::error(ZX_ERR_NOT_FOUND)));
+
+  // A cached object is still served after it is removed from the directory.
+  ASSERT_OK(root_dir()->Unlink("libfoo.so", false));
+  EXPECT_NO_FATAL_FAILURE(LoadObject(client, "libfoo.so", zx::ok("science")));
+
+  // Failures are not cached.
+  ASSERT_NO_FATAL_FAILURE(AddDirectoryEntry(root_dir(), {"libbar.so", "rules", true}));
+  EXPECT_NO_FATAL_FAILURE(LoadObject(client, "libbar.so", zx::ok("rules")));
+}
+
 TEST_F(LoaderServiceTest, Config) {
   std::shared_ptr<LoaderService> loader;
   std::vector<TestDirectoryEntry> config;
@@ -4,18 +4,33 @@
 
 #include "src/lib/storage/block_client/cpp/client.h"
 
+#include <lib/async/cpp/task.h>
 #include <lib/zx/fifo.h>
 #include <stdlib.h>
+#include <string.h>
 #include <zircon/assert.h>
 #include <zircon/device/block.h>
 #include <zircon/types.h>
 
+#include <algorithm>
+
 #include <fbl/macros.h>
 
 namespace block_client {
 
 Client::Client(zx::fifo fifo) : fifo_(std::move(fifo)) {}
 
+Client::Client(zx::fifo fifo, async_dispatcher_t* dispatcher)
+    : fifo_(std::move(fifo)), dispatcher_(dispatcher) {
+  fifo_wait_.set_object(fifo_.get());
+  fifo_wait_.set_trigger(ZX_FIFO_READABLE | ZX_FIFO_PEER_CLOSED);
+  if (zx_status_t status = fifo_wait_.Begin(dispatcher_); status != ZX_OK) {
+    fatal_status_ = status;
+  }
+}
+
+Client::~Client() { fifo_wait_.Cancel(); }
+
 zx_status_t Client::Transaction(block_fifo_request_t* requests, size_t count) {
   if (count == 0)
     return ZX_OK;
@@ -26,6 +41,8 @@ zx_status_t Client::Transaction(block_fifo_request_t* requests, size_t count) {
   {
     std::unique_lock<std::mutex> lock(mutex_);
     for (;;) {
+      if (fatal_status_ != ZX_OK)
+        return fatal_status_;
       for (group = 0; group < MAX_TXN_GROUP_COUNT && groups_[group].in_use; ++group) {
       }
       if (group < MAX_TXN_GROUP_COUNT)
@@ -63,8 +80,8 @@ zx_status_t Client::Transaction(block_fifo_request_t* requests, size_t count) {
     std::unique_lock<std::mutex> lock(mutex_);
 
     while (!block_completion->done) {
-      // Only let one thread do the reading at a time.
-      if (!reading_) {
+      // Only let one thread do the reading at a time. With a dispatcher, all reading happens there.
+      if (!reading_ && dispatcher_ == nullptr) {
         reading_ = true;
 
         constexpr size_t kMaxResponseCount = 8;
@@ -86,12 +103,11 @@ zx_status_t Client::Transaction(block_fifo_request_t* requests, size_t count) {
           return status;
         }
 
-        // Record all the responses.
-        for (size_t i = 0; i < count; ++i) {
-          assert(groups_[response[i].group].in_use);
-          groups_[response[i].group].status = response[i].status;
-          groups_[response[i].group].done = true;
-        }
+        // Record all the responses. Without a dispatcher there are no async transactions, so there
+        // are no callbacks to run.
+        CompletedTransactions completed;
+        HandleResponsesLocked(response, count, completed);
+        ZX_DEBUG_ASSERT(completed.empty());
         condition_.notify_all();  // Signal all threads that might be waiting for responses.
       } else {
         condition_.wait(lock);
@@ -107,6 +123,152 @@ zx_status_t Client::Transaction(block_fifo_request_t* requests, size_t count) {
   return status;
 }
 
+zx_status_t Client::TransactionAsync(const block_fifo_request_t* requests, size_t count,
+                                     TransactionCallback callback) {
+  if (dispatcher_ == nullptr)
+    return ZX_ERR_BAD_STATE;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fatal_status_ != ZX_OK || count == 0) {
+      async::PostTask(dispatcher_,
+                      [callback = std::move(callback), status = fatal_status_]() mutable {
+                        callback(status);
+                      });
+      return ZX_OK;
+    }
+    const reqid_t reqid = next_async_reqid_++;
+    AsyncTransaction& transaction = async_transactions_[reqid];
+    transaction.requests.assign(requests, requests + count);
+    for (block_fifo_request_t& request : transaction.requests) {
+      request.reqid = reqid;
+      request.group = 0;
+      request.opcode &= ~(BLOCKIO_GROUP_ITEM | BLOCKIO_GROUP_LAST);
+    }
+    transaction.callback = std::move(callback);
+    unsent_async_transactions_.push_back(reqid);
+  }
+  SendAsyncRequests();
+  return ZX_OK;
+}
+
+void Client::SendAsyncRequests() {
+  CompletedTransactions completed;
+  for (;;) {
+    block_fifo_request_t requests[BLOCK_FIFO_MAX_DEPTH];
+    size_t count = 0;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      while (!unsent_async_transactions_.empty() &&
+             async_requests_in_flight_ < kMaxAsyncRequestsInFlight) {
+        AsyncTransaction& transaction = async_transactions_[unsent_async_transactions_.front()];
+        const size_t batch =
+            std::min(transaction.requests.size() - transaction.sent,
+                     kMaxAsyncRequestsInFlight - async_requests_in_flight_);
+        memcpy(&requests[count], &transaction.requests[transaction.sent],
+               batch * sizeof(block_fifo_request_t));
+        count += batch;
+        transaction.sent += batch;
+        async_requests_in_flight_ += batch;
+        if (transaction.sent == transaction.requests.size())
+          unsent_async_transactions_.pop_front();
+      }
+    }
+    if (count == 0)
+      break;
+
+    if (zx_status_t status = DoWrite(requests, count); status != ZX_OK) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      FailAllLocked(status, completed);
+      break;
+    }
+  }
+  condition_.notify_all();
+  for (auto& [callback, status] : completed) {
+    callback(status);
+  }
+}
+
+void Client::HandleResponsesLocked(const block_fifo_response_t* responses, size_t count,
+                                   CompletedTransactions& completed) {
+  for (size_t i = 0; i < count; ++i) {
+    const block_fifo_response_t& response = responses[i];
+    if (response.group < MAX_TXN_GROUP_COUNT) {
+      assert(groups_[response.group].in_use);
+      groups_[response.group].status = response.status;
+      groups_[response.group].done = true;
+      continue;
+    }
+
+    // Ungrouped requests get a response each.
+    auto transaction = async_transactions_.find(response.reqid);
+    if (transaction == async_transactions_.end())
+      continue;
+    --async_requests_in_flight_;
+    if (transaction->second.status == ZX_OK)
+      transaction->second.status = response.status;
+    if (++transaction->second.completed == transaction->second.requests.size()) {
+      completed.emplace_back(std::move(transaction->second.callback), transaction->second.status);
+      async_transactions_.erase(transaction);
+    }
+  }
+}
+
+void Client::FailAllLocked(zx_status_t status, CompletedTransactions& completed) {
+  if (fatal_status_ == ZX_OK)
+    fatal_status_ = status;
+  for (BlockCompletion& group : groups_) {
+    if (group.in_use && !group.done) {
+      group.status = fatal_status_;
+      group.done = true;
+    }
+  }
+  for (auto& [reqid, transaction] : async_transactions_) {
+    completed.emplace_back(std::move(transaction.callback), fatal_status_);
+  }
+  async_transactions_.clear();
+  unsent_async_transactions_.clear();
+  async_requests_in_flight_ = 0;
+}
+
+void Client::OnFifoSignal(async_dispatcher_t* dispatcher, async::WaitBase* wait,
+                          zx_status_t status, const zx_packet_signal_t* signal) {
+  if (status == ZX_ERR_CANCELED)
+    return;
+
+  CompletedTransactions completed;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (;;) {
+      if (status != ZX_OK) {
+        FailAllLocked(status, completed);
+        break;
+      }
+      block_fifo_response_t responses[BLOCK_FIFO_MAX_DEPTH];
+      size_t count = 0;
+      status = fifo_.read(sizeof(block_fifo_response_t), responses, std::size(responses), &count);
+      if (status == ZX_ERR_SHOULD_WAIT) {
+        if (signal->observed & ZX_FIFO_PEER_CLOSED) {
+          status = ZX_ERR_PEER_CLOSED;
+          continue;
+        }
+        status = wait->Begin(dispatcher);
+        if (status == ZX_OK)
+          break;
+        continue;
+      }
+      if (status == ZX_OK)
+        HandleResponsesLocked(responses, count, completed);
+    }
+  }
+  condition_.notify_all();
+  for (auto& [callback, status] : completed) {
+    callback(status);
+  }
+
+  SendAsyncRequests();
+}
+
 zx_status_t Client::DoRead(block_fifo_response_t* response, size_t* count) {
   while (true) {
     if (zx_status_t status = fifo_.read(sizeof(*response), response, *count, count);
@@ -5,12 +5,18 @@
 #ifndef SRC_LIB_STORAGE_BLOCK_CLIENT_CPP_CLIENT_H_
 #define SRC_LIB_STORAGE_BLOCK_CLIENT_CPP_CLIENT_H_
 
+#include <lib/async/cpp/wait.h>
+#include <lib/fit/function.h>
 #include <lib/zx/fifo.h>
 #include <zircon/device/block.h>
 #include <zircon/types.h>
 
 #include <condition_variable>
+#include <deque>
+#include <map>
 #include <mutex>
+#include <utility>
+#include <vector>
 
 namespace block_client {
 
@@ -20,17 +26,37 @@ namespace block_client {
 // is threadsafe to support this many requests from different threads in parallel. Exceeding
 // MAX_TXN_GROUP_COUNT parallel transactions will block future requests until a transaction group
 // becomes available.
+//
+// A client which is given a dispatcher also supports |TransactionAsync|, which doesn't block and
+// isn't limited by the number of groups. All responses are then read on the dispatcher, so
+// |Transaction| must not be called from the dispatcher's thread, and the client must be destroyed
+// on that thread or after the dispatcher has stopped running.
 class Client {
  public:
   explicit Client(zx::fifo fifo);
+  Client(zx::fifo fifo, async_dispatcher_t* dispatcher);
 
   // This object can not be moved due to the presence of the mutex.
   Client(const Client&) = delete;
   Client(Client&&) = delete;
 
+  ~Client();
+
   // Issues a group of block requests over the underlying fifo, and waits for a response.
   zx_status_t Transaction(block_fifo_request_t* requests, size_t count);
 
+  using TransactionCallback = fit::callback<void(zx_status_t)>;
+
+  // Issues block requests over the underlying fifo without waiting for them. |callback| is called
+  // on the dispatcher once every request has completed, with the first error if any failed.
+  //
+  // The requests aren't grouped, so they may complete in any order. Requests beyond what the fifo
+  // can hold are queued, and are sent as earlier ones complete. Returns ZX_ERR_BAD_STATE if the
+  // client wasn't given a dispatcher; otherwise errors are only reported through |callback|, which
+  // can be called before this returns if writing to the fifo fails.
+  zx_status_t TransactionAsync(const block_fifo_request_t* requests, size_t count,
+                               TransactionCallback callback);
+
  private:
   struct BlockCompletion {
     bool in_use = false;
@@ -38,9 +64,41 @@ class Client {
     zx_status_t status = ZX_ERR_IO;
   };
 
+  struct AsyncTransaction {
+    std::vector<block_fifo_request_t> requests;
+    // The number of requests which have been written to the fifo.
+    size_t sent = 0;
+    size_t completed = 0;
+    zx_status_t status = ZX_OK;
+    TransactionCallback callback;
+  };
+
+  // The most ungrouped requests that are in flight at once. Together with the response to every
+  // group, the responses to these always fit in the fifo, so the server never stalls waiting for
+  // responses to be read, and writing to the fifo never blocks for long.
+  static constexpr size_t kMaxAsyncRequestsInFlight = BLOCK_FIFO_MAX_DEPTH - MAX_TXN_GROUP_COUNT;
+
   zx_status_t DoRead(block_fifo_response_t* response, size_t* count);
   zx_status_t DoWrite(block_fifo_request_t* request, size_t count);
 
+  // Callbacks to run once the mutex has been released, with the status to pass them.
+  using CompletedTransactions = std::vector<std::pair<TransactionCallback, zx_status_t>>;
+
+  // Records |responses| and moves the callbacks of the async transactions which are now complete
+  // to |completed|.
+  void HandleResponsesLocked(const block_fifo_response_t* responses, size_t count,
+                             CompletedTransactions& completed);
+
+  // Fails every outstanding transaction with |status|, which the client keeps returning from then
+  // on.
+  void FailAllLocked(zx_status_t status, CompletedTransactions& completed);
+
+  // Writes as many queued async requests as there's room for.
+  void SendAsyncRequests();
+
+  void OnFifoSignal(async_dispatcher_t* dispatcher, async::WaitBase* wait, zx_status_t status,
+                    const zx_packet_signal_t* signal);
+
   zx::fifo fifo_;
 
   std::mutex mutex_;
@@ -49,6 +107,19 @@ class Client {
 
   std::condition_variable condition_;
   bool reading_ = false;  // Guarded by mutex.
+
+  async_dispatcher_t* const dispatcher_ = nullptr;
+  async::WaitMethod<Client, &Client::OnFifoSignal> fifo_wait_{this};
+
+  // Set once the fifo can no longer be used. Guarded by mutex.
+  zx_status_t fatal_status_ = ZX_OK;
+
+  // Async transactions by the reqid their requests were sent with, and those which still have
+  // requests to send, in the order they were issued. Guarded by mutex.
+  std::map<reqid_t, AsyncTransaction> async_transactions_;
+  std::deque<reqid_t> unsent_async_transactions_;
+  reqid_t next_async_reqid_ = 0;
+  size_t async_requests_in_flight_ = 0;
 };
 
 }  // namespace block_client
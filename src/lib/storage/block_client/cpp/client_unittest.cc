@@ -0,0 +1,134 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/lib/storage/block_client/cpp/client.h"
+
+#include <lib/async-loop/cpp/loop.h>
+#include <lib/async-loop/default.h>
+#include <lib/zx/fifo.h>
+
+#include <optional>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace block_client {
+namespace {
+
+class ClientTest : public testing::Test {
+ public:
+  void SetUp() override {
+    zx::fifo client_fifo;
+    ASSERT_EQ(zx::fifo::create(BLOCK_FIFO_MAX_DEPTH, sizeof(block_fifo_request_t), 0, &client_fifo,
+                               &server_fifo_),
+              ZX_OK);
+    client_.emplace(std::move(client_fifo), loop_.dispatcher());
+  }
+
+ protected:
+  // Reads every request the client has written so far.
+  std::vector<block_fifo_request_t> ReadRequests() {
+    std::vector<block_fifo_request_t> requests(BLOCK_FIFO_MAX_DEPTH);
+    size_t actual = 0;
+    if (server_fifo_.read(sizeof(block_fifo_request_t), requests.data(), requests.size(),
+                          &actual) != ZX_OK) {
+      actual = 0;
+    }
+    requests.resize(actual);
+    return requests;
+  }
+
+  void Respond(const block_fifo_request_t& request, zx_status_t status) {
+    block_fifo_response_t response = {
+        .status = status,
+        .reqid = request.reqid,
+        .group = MAX_TXN_GROUP_COUNT,
+        .count = 1,
+    };
+    ASSERT_EQ(server_fifo_.write_one(response), ZX_OK);
+  }
+
+  async::Loop loop_{&kAsyncLoopConfigNoAttachToCurrentThread};
+  zx::fifo server_fifo_;
+  std::optional<Client> client_;
+};
+
+TEST(ClientWithoutDispatcherTest, TransactionAsyncFails) {
+  zx::fifo client_fifo, server_fifo;
+  ASSERT_EQ(zx::fifo::create(BLOCK_FIFO_MAX_DEPTH, sizeof(block_fifo_request_t), 0, &client_fifo,
+                             &server_fifo),
+            ZX_OK);
+  Client client(std::move(client_fifo));
+  block_fifo_request_t request = {.opcode = BLOCKIO_FLUSH};
+  EXPECT_EQ(client.TransactionAsync(&request, 1, [](zx_status_t) {}), ZX_ERR_BAD_STATE);
+}
+
+TEST_F(ClientTest, MoreAsyncTransactionsThanGroupsCanBeInFlight) {
+  constexpr size_t kTransactionCount = MAX_TXN_GROUP_COUNT * 2;
+  std::vector<std::optional<zx_status_t>> results(kTransactionCount);
+  for (size_t i = 0; i < kTransactionCount; ++i) {
+    block_fifo_request_t requests[2] = {{.opcode = BLOCKIO_READ}, {.opcode = BLOCKIO_READ}};
+    ASSERT_EQ(client_->TransactionAsync(requests, std::size(requests),
+                                        [&results, i](zx_status_t status) { results[i] = status; }),
+              ZX_OK);
+  }
+
+  std::vector<block_fifo_request_t> requests = ReadRequests();
+  ASSERT_EQ(requests.size(), kTransactionCount * 2);
+  // Answer in reverse order, failing one of the first transaction's requests.
+  for (auto request = requests.rbegin(); request != requests.rend(); ++request) {
+    Respond(*request, request == requests.rend() - 1 ? ZX_ERR_IO : ZX_OK);
+  }
+  loop_.RunUntilIdle();
+
+  EXPECT_EQ(results[0], ZX_ERR_IO);
+  for (size_t i = 1; i < kTransactionCount; ++i) {
+    EXPECT_EQ(results[i], ZX_OK) << i;
+  }
+}
+
+TEST_F(ClientTest, RequestsBeyondFifoCapacityAreQueued) {
+  std::vector<block_fifo_request_t> requests(BLOCK_FIFO_MAX_DEPTH * 2, {.opcode = BLOCKIO_WRITE});
+  std::optional<zx_status_t> result;
+  ASSERT_EQ(client_->TransactionAsync(requests.data(), requests.size(),
+                                      [&result](zx_status_t status) { result = status; }),
+            ZX_OK);
+
+  size_t responded = 0;
+  while (responded < requests.size()) {
+    std::vector<block_fifo_request_t> sent = ReadRequests();
+    ASSERT_FALSE(sent.empty());
+    // Leaves room for the response to every group.
+    EXPECT_LE(sent.size(), size_t{BLOCK_FIFO_MAX_DEPTH - MAX_TXN_GROUP_COUNT});
+    for (const block_fifo_request_t& request : sent) {
+      Respond(request, ZX_OK);
+    }
+    responded += sent.size();
+    loop_.RunUntilIdle();
+    EXPECT_EQ(result.has_value(), responded == requests.size());
+  }
+  EXPECT_EQ(result, ZX_OK);
+}
+
+TEST_F(ClientTest, PeerClosedFailsOutstandingTransactions) {
+  block_fifo_request_t request = {.opcode = BLOCKIO_READ};
+  std::optional<zx_status_t> result;
+  ASSERT_EQ(client_->TransactionAsync(&request, 1,
+                                      [&result](zx_status_t status) { result = status; }),
+            ZX_OK);
+  server_fifo_.reset();
+  loop_.RunUntilIdle();
+  EXPECT_EQ(result, ZX_ERR_PEER_CLOSED);
+
+  // Later transactions fail too.
+  result.reset();
+  ASSERT_EQ(client_->TransactionAsync(&request, 1,
+                                      [&result](zx_status_t status) { result = status; }),
+            ZX_OK);
+  loop_.RunUntilIdle();
+  EXPECT_EQ(result, ZX_ERR_PEER_CLOSED);
+}
+
+}  // namespace
+}  // namespace block_client
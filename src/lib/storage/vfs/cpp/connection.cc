@@ -20,6 +20,7 @@
 
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <type_traits>
 #include <utility>
 
@@ -129,7 +130,14 @@ Connection::~Connection() {
 
 void Connection::AsyncTeardown() {
   OnTeardown();
-  if (std::shared_ptr<Binding> binding = binding_; binding) {
+  std::shared_ptr<Binding> binding;
+  {
+    // This may be called from outside of the dispatch thread, while the connection is being torn
+    // down on it.
+    std::lock_guard lock(binding_lock_);
+    binding = binding_;
+  }
+  if (binding) {
     binding->AsyncTeardown();
   }
 }
@@ -143,11 +151,12 @@ void Binding::AsyncTeardown() {
 zx_status_t Connection::StartDispatching(zx::channel channel) {
   ZX_DEBUG_ASSERT(channel);
   ZX_DEBUG_ASSERT(!binding_);
-  ZX_DEBUG_ASSERT(vfs_->dispatcher());
+  ZX_DEBUG_ASSERT(vfs_->connection_dispatcher());
   ZX_DEBUG_ASSERT_MSG(InContainer(),
                       "Connection must be managed by the Vfs when dispatching FIDL messages.");
 
-  binding_ = std::make_shared<Binding>(*this, vfs_->dispatcher(), std::move(channel));
+  std::lock_guard lock(binding_lock_);
+  binding_ = std::make_shared<Binding>(*this, vfs_->connection_dispatcher(), std::move(channel));
   zx_status_t status = binding_->StartDispatching();
   if (status != ZX_OK) {
     binding_.reset();
@@ -236,7 +245,10 @@ bool Connection::OnMessage() {
 void Connection::SyncTeardown() {
   OnTeardown();
   EnsureVnodeClosed();
-  binding_.reset();
+  {
+    std::lock_guard lock(binding_lock_);
+    binding_.reset();
+  }
 
   // Tell the VFS that the connection closed remotely. This might have the side-effect of destroying
   // this object, so this must be the last statement.
@@ -20,6 +20,7 @@
 #include <zircon/fidl.h>
 
 #include <memory>
+#include <mutex>
 
 #include <fbl/intrusive_double_list.h>
 #include <fbl/ref_ptr.h>
@@ -223,6 +224,10 @@ class Connection : public fbl::DoublyLinkedListable<std::unique_ptr<Connection>>
   fbl::RefPtr<fs::Vnode> vnode_;
 
   // State related to FIDL message dispatching. See |Binding|.
+  //
+  // Only changed on the dispatch thread, while holding |binding_lock_|. Other threads must hold the
+  // lock to read it, the dispatch thread need not.
+  std::mutex binding_lock_;
   std::shared_ptr<Binding> binding_;
 
   // The operational protocol that is used to interact with the vnode over this connection. It
@@ -9,15 +9,18 @@
 #include <lib/fdio/directory.h>
 #include <lib/fdio/fd.h>
 #include <lib/fdio/fdio.h>
+#include <lib/sync/completion.h>
 #include <stdio.h>
 
 #include <atomic>
 #include <string_view>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include <zxtest/zxtest.h>
 
+#include "src/lib/storage/vfs/cpp/managed_vfs.h"
 #include "src/lib/storage/vfs/cpp/pseudo_dir.h"
 #include "src/lib/storage/vfs/cpp/pseudo_file.h"
 #include "src/lib/storage/vfs/cpp/synchronous_vfs.h"
@@ -459,4 +462,76 @@ TEST_F(ConnectionClosingTest, ClosingNodeLeadsToClosingServerEndChannel) {
   loop().Shutdown();
 }
 
+// A file whose |GetAttributes| blocks until it is released.
+class BlockingVnode : public fs::Vnode {
+ public:
+  fs::VnodeProtocolSet GetProtocols() const final { return fs::VnodeProtocol::kFile; }
+
+  zx_status_t GetNodeInfoForProtocol(fs::VnodeProtocol protocol, fs::Rights rights,
+                                     fs::VnodeRepresentation* info) final {
+    *info = fs::VnodeRepresentation::File{};
+    return ZX_OK;
+  }
+
+  zx_status_t GetAttributes(fs::VnodeAttributes* attr) final {
+    sync_completion_signal(&started_);
+    sync_completion_wait(&released_, ZX_TIME_INFINITE);
+    *attr = fs::VnodeAttributes();
+    return ZX_OK;
+  }
+
+  void WaitUntilStarted() { sync_completion_wait(&started_, ZX_TIME_INFINITE); }
+  void Release() { sync_completion_signal(&released_); }
+
+ private:
+  sync_completion_t started_;
+  sync_completion_t released_;
+};
+
+TEST(ConnectionDispatcherTest, SlowRequestDoesNotBlockOtherConnections) {
+  async::Loop loop(&kAsyncLoopConfigNoAttachToCurrentThread);
+  async::Loop connection_loop(&kAsyncLoopConfigNoAttachToCurrentThread);
+  ASSERT_OK(loop.StartThread());
+  ASSERT_OK(connection_loop.StartThread());
+  ASSERT_OK(connection_loop.StartThread());
+
+  fs::ManagedVfs vfs(loop.dispatcher());
+  vfs.SetConnectionDispatcher(connection_loop.dispatcher());
+  auto root = fbl::MakeRefCounted<fs::PseudoDir>();
+  auto blocking = fbl::MakeRefCounted<BlockingVnode>();
+  root->AddEntry("blocking", blocking);
+
+  zx::status root_endpoints = fidl::CreateEndpoints<fio::Directory>();
+  ASSERT_OK(root_endpoints.status_value());
+  ASSERT_OK(vfs.ServeDirectory(root, std::move(root_endpoints->server)));
+
+  zx::status blocking_endpoints = fidl::CreateEndpoints<fio::Node>();
+  ASSERT_OK(blocking_endpoints.status_value());
+  ASSERT_OK(fidl::WireCall(root_endpoints->client)
+                ->Open(fio::wire::OpenFlags::kRightReadable, 0755, fidl::StringView("blocking"),
+                       std::move(blocking_endpoints->server))
+                .status());
+
+  std::thread slow_client([&blocking_endpoints] {
+    auto result = fidl::WireCall(blocking_endpoints->client)->GetAttr();
+    EXPECT_OK(result.status());
+  });
+  blocking->WaitUntilStarted();
+
+  // The root connection is still served while the other one is stuck.
+  auto result = fidl::WireCall(root_endpoints->client)->GetAttr();
+  ASSERT_OK(result.status());
+  EXPECT_OK(result->s);
+
+  blocking->Release();
+  slow_client.join();
+
+  sync_completion_t shutdown;
+  vfs.Shutdown([&shutdown](zx_status_t status) {
+    EXPECT_OK(status);
+    sync_completion_signal(&shutdown);
+  });
+  ASSERT_OK(sync_completion_wait(&shutdown, ZX_TIME_INFINITE));
+}
+
 }  // namespace
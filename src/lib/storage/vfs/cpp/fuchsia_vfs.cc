@@ -99,6 +99,12 @@ void FuchsiaVfs::SetDispatcher(async_dispatcher_t* dispatcher) {
   dispatcher_ = dispatcher;
 }
 
+void FuchsiaVfs::SetConnectionDispatcher(async_dispatcher_t* dispatcher) {
+  ZX_ASSERT_MSG(!connection_dispatcher_,
+                "FuchsiaVfs::SetConnectionDispatcher may only be called once.");
+  connection_dispatcher_ = dispatcher;
+}
+
 zx_status_t FuchsiaVfs::Unlink(fbl::RefPtr<Vnode> vndir, std::string_view name, bool must_be_dir) {
   if (zx_status_t s = Vfs::Unlink(vndir, name, must_be_dir); s != ZX_OK)
     return s;
@@ -94,6 +94,20 @@ class FuchsiaVfs : public Vfs {
   async_dispatcher_t* dispatcher() const { return dispatcher_; }
   void SetDispatcher(async_dispatcher_t* dispatcher);
 
+  // The dispatcher which messages on connections are read and handled on. This is |dispatcher()|
+  // unless a separate one has been set with |SetConnectionDispatcher|.
+  async_dispatcher_t* connection_dispatcher() const {
+    return connection_dispatcher_ ? connection_dispatcher_ : dispatcher_;
+  }
+
+  // Serves connections on |dispatcher| rather than on |dispatcher()|, which continues to be used
+  // for the VFS's own work. Must be called before any connections are served.
+  //
+  // |dispatcher| may be run by several threads. Messages on any one connection are still handled
+  // one at a time and in order, but independent connections are then served concurrently, so this
+  // is only safe for filesystems whose vnodes do their own locking.
+  void SetConnectionDispatcher(async_dispatcher_t* dispatcher);
+
   // Begins serving VFS messages over the specified channel. If the vnode supports multiple
   // protocols and the client requested more than one of them, it would use |Vnode::Negotiate| to
   // tie-break and obtain the resulting protocol.
@@ -163,6 +177,7 @@ class FuchsiaVfs : public Vfs {
   fbl::HashTable<zx_koid_t, std::unique_ptr<VnodeToken>> vnode_tokens_;
 
   async_dispatcher_t* dispatcher_ = nullptr;
+  async_dispatcher_t* connection_dispatcher_ = nullptr;
 };
 
 }  // namespace fs
@@ -61,8 +61,9 @@ fpromise::result<> ToVoidError(fpromise::result<void, zx_status_t> result) {
 Journal::Journal(TransactionHandler* transaction_handler, JournalSuperblock journal_superblock,
                  std::unique_ptr<storage::BlockingRingBuffer> journal_buffer,
                  std::unique_ptr<storage::BlockingRingBuffer> writeback_buffer,
-                 uint64_t journal_start_block)
-    : journal_buffer_(std::move(journal_buffer)),
+                 uint64_t journal_start_block, Options options)
+    : options_(options),
+      journal_buffer_(std::move(journal_buffer)),
       writeback_buffer_(std::move(writeback_buffer)),
       writer_(transaction_handler, std::move(journal_superblock), journal_start_block,
               journal_buffer_->capacity()) {
@@ -82,16 +83,22 @@ Journal::~Journal() {
   executor_.Terminate();
 }
 
-void Journal::FlushPending() {
-  if (pending_ == 0)
-    return;
-
+void Journal::ReleaseDataBarrier() {
   // Writes to the journal can only proceed once all data writes have been flushed.
   if (journal_data_barrier_) {
     schedule_task(data_barrier_.sync()
                       .and_then([this]() { return ToVoidError(writer_.Flush()); })
                       .and_then(std::move(journal_data_barrier_)));
   }
+}
+
+void Journal::FlushPending() {
+  if (pending_ == 0)
+    return;
+
+  ReleaseDataBarrier();
+
+  CloseBatch();
 
   // Once all the journal writes are done, we need to flush again to flush the writes to their final
   // locations.
@@ -107,6 +114,65 @@ void Journal::FlushPending() {
   pending_ = 0;
 }
 
+Journal::CommitBatch& Journal::OpenBatch() {
+  if (!open_batch_) {
+    open_batch_ = std::make_shared<CommitBatch>();
+    schedule_task(journal_sequencer_.wrap(fpromise::make_promise(
+        [this, batch = open_batch_]() { return WriteBatch(batch); })));
+  }
+  return *open_batch_;
+}
+
+void Journal::CloseBatch() {
+  std::lock_guard lock(batch_mutex_);
+  open_batch_.reset();
+}
+
+fpromise::result<void, zx_status_t> Journal::WriteBatch(const std::shared_ptr<CommitBatch>& batch) {
+  CommitBatch work;
+  {
+    std::lock_guard lock(batch_mutex_);
+    if (open_batch_ == batch) {
+      open_batch_.reset();
+    }
+    work = std::move(*batch);
+  }
+  const size_t transaction_count = work.transactions.size();
+  const size_t sync_count = work.syncs.size();
+
+  fpromise::result<void, zx_status_t> result = fpromise::ok();
+  if (!work.transactions.empty()) {
+    result = writer_.WriteMetadataBatch(std::move(work.transactions));
+  }
+
+  if (!work.syncs.empty()) {
+    // This is what a separate Sync() would do: flush, so that all the entries are durable and
+    // written to their final locations, and then update the info block.
+    fpromise::result<void, zx_status_t> sync_result = fpromise::ok();
+    if (writer_.HavePendingWork()) {
+      sync_result = writer_.Flush();
+    }
+    if (sync_result.is_ok()) {
+      sync_result = writer_.Sync();
+    }
+    for (fpromise::completer<void, zx_status_t>& completer : work.syncs) {
+      if (sync_result.is_ok()) {
+        completer.complete_ok();
+      } else {
+        completer.complete_error(sync_result.error());
+      }
+    }
+    if (result.is_ok()) {
+      result = std::move(sync_result);
+    }
+  }
+
+  if (commit_batch_callback_) {
+    commit_batch_callback_(transaction_count, sync_count);
+  }
+  return result;
+}
+
 Journal::Promise Journal::WriteData(std::vector<storage::UnbufferedOperation> operations) {
   auto block_count_or =
       CheckOperationsAndGetTotalBlockCount<storage::OperationType::kWrite>(operations);
@@ -216,6 +282,17 @@ zx_status_t Journal::CommitTransaction(Transaction transaction) {
     trim_work = internal::JournalWorkItem({}, std::move(transaction.trim));
   }
 
+  if (options_.group_commit && !transaction.data_promise) {
+    // Nothing needs to wait for this transaction in particular, so it can be written along with
+    // whatever else arrives before the background thread gets to it.
+    pending_ += block_count;
+    std::lock_guard lock(batch_mutex_);
+    OpenBatch().transactions.push_back(
+        {.work = std::move(work), .trim_work = std::move(trim_work)});
+    return ZX_OK;
+  }
+  CloseBatch();
+
   auto promise = fpromise::make_promise(
       [this, work = std::move(work),
        trim_work = std::move(trim_work)]() mutable -> fpromise::result<void, zx_status_t> {
@@ -248,6 +325,19 @@ zx_status_t Journal::CommitTransaction(Transaction transaction) {
 }
 
 Journal::Promise Journal::Sync() {
+  if (options_.group_commit) {
+    // The batch which is written next does the flush, so that it's shared by every sync which
+    // arrives before it's written.
+    ReleaseDataBarrier();
+    pending_ = 0;
+    fpromise::bridge<void, zx_status_t> bridge;
+    {
+      std::lock_guard lock(batch_mutex_);
+      OpenBatch().syncs.push_back(std::move(bridge.completer));
+    }
+    return bridge.consumer.promise_or(fpromise::error(ZX_ERR_BAD_STATE));
+  }
+
   FlushPending();
   return journal_sequencer_.wrap(fpromise::make_promise([this] { return writer_.Sync(); }));
 }
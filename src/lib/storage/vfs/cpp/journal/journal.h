@@ -6,12 +6,17 @@
 #define SRC_LIB_STORAGE_VFS_CPP_JOURNAL_JOURNAL_H_
 
 #include <lib/fpromise/barrier.h>
+#include <lib/fpromise/bridge.h>
 #include <lib/fpromise/promise.h>
 #include <lib/fpromise/sequencer.h>
+#include <zircon/compiler.h>
 #include <zircon/status.h>
 #include <zircon/types.h>
 
 #include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include <fbl/vector.h>
 #include <storage/buffer/blocking_ring_buffer.h>
@@ -78,6 +83,16 @@ class Journal final : public fpromise::executor {
     fit::callback<void()> complete_callback;
   };
 
+  struct Options {
+    // With group commit, transactions without data and syncs which arrive while the background
+    // thread is busy are gathered into one batch: the journal entries of all the transactions are
+    // written with one request, and all the syncs are satisfied by the same flush.
+    //
+    // Transactions with data, and anything else which has to be ordered with respect to the
+    // journal, end the current batch.
+    bool group_commit = false;
+  };
+
   // Constructs a Journal with journaling enabled. This is the traditional constructor of Journals,
   // where data and metadata are treated separately.
   //
@@ -87,7 +102,13 @@ class Journal final : public fpromise::executor {
   Journal(fs::TransactionHandler* transaction_handler, JournalSuperblock journal_superblock,
           std::unique_ptr<storage::BlockingRingBuffer> journal_buffer,
           std::unique_ptr<storage::BlockingRingBuffer> writeback_buffer,
-          uint64_t journal_start_block);
+          uint64_t journal_start_block, Options options);
+  Journal(fs::TransactionHandler* transaction_handler, JournalSuperblock journal_superblock,
+          std::unique_ptr<storage::BlockingRingBuffer> journal_buffer,
+          std::unique_ptr<storage::BlockingRingBuffer> writeback_buffer,
+          uint64_t journal_start_block)
+      : Journal(transaction_handler, std::move(journal_superblock), std::move(journal_buffer),
+                std::move(writeback_buffer), journal_start_block, Options()) {}
 
   // Synchronizes with the background thread to ensure all enqueued work is complete before
   // returning.
@@ -119,6 +140,14 @@ class Journal final : public fpromise::executor {
     write_metadata_callback_ = std::move(callback);
   }
 
+  // Only used with group commit. The callback will be called on the background thread after each
+  // batch has been written, with the number of transactions and syncs in it. This can be used to
+  // expose the effectiveness of batching as metrics.
+  void set_commit_batch_callback(
+      fit::function<void(size_t transaction_count, size_t sync_count)> callback) {
+    commit_batch_callback_ = std::move(callback);
+  }
+
   // Returns true if all writeback is "off", and no further data will be written to the
   // device.
   bool IsWritebackEnabled() const { return writer_.IsWritebackEnabled(); }
@@ -127,6 +156,30 @@ class Journal final : public fpromise::executor {
   // Flushes blocks that have been delayed until we can flush.  See related |pending_ below.
   void FlushPending();
 
+  // Allows writes to the journal which are blocked behind |journal_data_barrier_| to proceed once
+  // all data writes have been flushed.
+  void ReleaseDataBarrier();
+
+  // The transactions and syncs which will be written by a single task when group commit is
+  // enabled. The batch is open to new work until that task starts running.
+  struct CommitBatch {
+    std::vector<internal::JournalWriter::MetadataWork> transactions;
+    std::vector<fpromise::completer<void, zx_status_t>> syncs;
+  };
+
+  // Returns the open batch, creating one (and scheduling the task to write it) if there isn't one.
+  CommitBatch& OpenBatch() __TA_REQUIRES(batch_mutex_);
+
+  // Ensures that nothing else is added to the open batch. This must be called before anything else
+  // is added to |journal_sequencer_|, since the batch would otherwise be reordered with it.
+  void CloseBatch() __TA_EXCLUDES(batch_mutex_);
+
+  // Runs on the background thread.
+  fpromise::result<void, zx_status_t> WriteBatch(const std::shared_ptr<CommitBatch>& batch)
+      __TA_EXCLUDES(batch_mutex_);
+
+  const Options options_;
+
   std::unique_ptr<storage::BlockingRingBuffer> journal_buffer_;
   std::unique_ptr<storage::BlockingRingBuffer> writeback_buffer_;
 
@@ -150,6 +203,11 @@ class Journal final : public fpromise::executor {
 
   internal::JournalWriter writer_;
 
+  std::mutex batch_mutex_;
+  std::shared_ptr<CommitBatch> open_batch_ __TA_GUARDED(batch_mutex_);
+
+  fit::function<void(size_t transaction_count, size_t sync_count)> commit_batch_callback_;
+
   // Intentionally place the executor at the end of the journal. This ensures that during
   // destruction, the executor can complete pending tasks operation on the writeback buffers before
   // the writeback buffers are destroyed.
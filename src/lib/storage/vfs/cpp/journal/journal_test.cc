@@ -900,6 +900,105 @@ TEST_F(JournalTest, WriteMultipleMetadataOperationsObserveTransactions) {
   }
 }
 
+// Tests that with group commit, transactions and syncs which arrive while the journal is busy are
+// written as one batch: one write to the journal and one set of flushes for all the syncs.
+//
+// Operations 1, 2: [ H, 1, C, H, 1, C, _, _, _, _ ]
+TEST_F(JournalTest, GroupCommitWritesQueuedTransactionsAndSyncsTogether) {
+  storage::VmoBuffer metadata = registry()->InitializeBuffer(3);
+
+  const std::vector<storage::UnbufferedOperation> operations = {
+      {
+          .vmo = zx::unowned_vmo(metadata.vmo().get()),
+          .op =
+              {
+                  .type = storage::OperationType::kWrite,
+                  .vmo_offset = 0,
+                  .dev_offset = 20,
+                  .length = 1,
+              },
+      },
+      {
+          .vmo = zx::unowned_vmo(metadata.vmo().get()),
+          .op =
+              {
+                  .type = storage::OperationType::kWrite,
+                  .vmo_offset = 2,
+                  .dev_offset = 1234,
+                  .length = 1,
+              },
+      },
+  };
+  const uint64_t entry_length = 1 + kEntryMetadataBlocks;
+
+  constexpr uint64_t kJournalStartBlock = 55;
+  JournalRequestVerifier verifier(registry()->info(), registry()->journal(),
+                                  registry()->writeback(), kJournalStartBlock);
+  MockTransactionHandler::TransactionCallback callbacks[] = {
+      [&](const std::vector<storage::BufferedOperation>& requests) {
+        // Both entries are written with one request.
+        EXPECT_EQ(requests.size(), 2ul);
+        CheckWriteRequest(requests[0], kJournalVmoid, /* vmo_offset= */ 0,
+                          /* dev_offset= */ kJournalStartBlock + kJournalMetadataBlocks,
+                          entry_length);
+        CheckWriteRequest(requests[1], kJournalVmoid, /* vmo_offset= */ entry_length,
+                          /* dev_offset= */ kJournalStartBlock + kJournalMetadataBlocks +
+                              entry_length,
+                          entry_length);
+        registry()->VerifyReplay(operations, 2);
+        return ZX_OK;
+      },
+      FlushCallback,
+      [&](const std::vector<storage::BufferedOperation>& requests) {
+        verifier.VerifyMetadataWrite(operations[0], requests);
+        return ZX_OK;
+      },
+      [&](const std::vector<storage::BufferedOperation>& requests) {
+        verifier.VerifyMetadataWrite(operations[1], requests);
+        verifier.ExtendJournalOffset(2 * entry_length);
+        return ZX_OK;
+      },
+      FlushCallback,
+      [&](const std::vector<storage::BufferedOperation>& requests) {
+        uint64_t sequence_number = 2;
+        verifier.VerifyInfoBlockWrite(sequence_number, requests);
+        registry()->VerifyReplay({}, sequence_number);
+        return ZX_OK;
+      },
+  };
+  MockTransactionHandler handler(registry(), callbacks, std::size(callbacks));
+  std::vector<std::pair<size_t, size_t>> batches;
+  int syncs_completed = 0;
+  {
+    Journal journal(&handler, take_info(), take_journal_buffer(), take_data_buffer(),
+                    kJournalStartBlock, Journal::Options{.group_commit = true});
+    journal.set_commit_batch_callback([&](size_t transaction_count, size_t sync_count) {
+      batches.emplace_back(transaction_count, sync_count);
+    });
+
+    // Keep the background thread busy until everything has been queued.
+    sync_completion_t unblock;
+    journal.schedule_task(
+        fpromise::make_promise([&unblock]() { sync_completion_wait(&unblock, ZX_TIME_INFINITE); }));
+
+    EXPECT_EQ(journal.CommitTransaction({.metadata_operations = {operations[0]}}), ZX_OK);
+    journal.schedule_task(journal.Sync().and_then([&]() { ++syncs_completed; }));
+    EXPECT_EQ(journal.CommitTransaction({.metadata_operations = {operations[1]}}), ZX_OK);
+    sync_completion_t synced;
+    journal.schedule_task(journal.Sync().and_then([&]() {
+      ++syncs_completed;
+      sync_completion_signal(&synced);
+    }));
+    sync_completion_signal(&unblock);
+    // Don't let the journal's own sync on destruction join the batch.
+    sync_completion_wait(&synced, ZX_TIME_INFINITE);
+  }
+  // The journal's own sync on destruction is a batch of its own.
+  EXPECT_THAT(batches, testing::ElementsAre(std::pair<size_t, size_t>(2, 2),
+                                            std::pair<size_t, size_t>(0, 1)));
+  EXPECT_EQ(syncs_completed, 2);
+}
+
 // Tests that TrimData() is observable from the "block device".
 TEST_F(JournalTest, TrimDataObserveTransaction) {
   storage::VmoBuffer metadata = registry()->InitializeBuffer(1);
@@ -105,6 +105,48 @@ fpromise::result<void, zx_status_t> JournalWriter::WriteMetadata(
   return fpromise::ok();
 }
 
+fpromise::result<void, zx_status_t> JournalWriter::WriteMetadataBatch(
+    std::vector<MetadataWork> batch) {
+  FX_LOGST(DEBUG, "journal") << "WriteMetadataBatch: Writing " << batch.size() << " entries";
+  defer_journal_writes_ = true;
+  fpromise::result<void, zx_status_t> result = fpromise::ok();
+  for (MetadataWork& item : batch) {
+    auto item_result = WriteMetadata(std::move(item.work), std::move(item.trim_work));
+    if (item_result.is_error() && result.is_ok()) {
+      result = item_result.take_error_result();
+    }
+  }
+  defer_journal_writes_ = false;
+  if (zx_status_t status = IssueDeferredJournalWrites(); status != ZX_OK && result.is_ok()) {
+    result = fpromise::error(status);
+  }
+  return result;
+}
+
+zx_status_t JournalWriter::IssueDeferredJournalWrites() {
+  if (deferred_journal_operations_.empty()) {
+    return ZX_OK;
+  }
+  FX_LOGST(DEBUG, "journal") << "IssueDeferredJournalWrites: Writing "
+                             << undecoded_entries_.size() << " entries";
+  std::vector<storage::BufferedOperation> operations = std::move(deferred_journal_operations_);
+  deferred_journal_operations_.clear();
+  zx_status_t status = WriteOperations(operations);
+  // Although the payloads may be encoded while written to the journal, they should be decoded
+  // when written to the final on-disk location later.
+  for (const storage::BlockBufferView& view : undecoded_entries_) {
+    JournalEntryView(view).DecodePayloadBlocks();
+  }
+  undecoded_entries_.clear();
+  if (status != ZX_OK) {
+    FX_LOGST(WARNING, "journal") << "IssueDeferredJournalWrites: Failed to write: "
+                                 << zx_status_get_string(status);
+    // None of the entries made it to the journal, so none of them may reach their final location.
+    pending_work_items_.clear();
+  }
+  return status;
+}
+
 zx_status_t JournalWriter::WriteOperationToJournal(const storage::BlockBufferView& view) {
   const uint64_t total_block_count = view.length();
   const uint64_t max_reservation_size = EntriesLength();
@@ -132,6 +174,12 @@ zx_status_t JournalWriter::WriteOperationToJournal(const storage::BlockBufferVie
     next_entry_start_block_ = (next_entry_start_block_ + operation.op.length) % EntriesLength();
   }
 
+  if (defer_journal_writes_) {
+    deferred_journal_operations_.insert(deferred_journal_operations_.end(),
+                                        journal_operations.begin(), journal_operations.end());
+    return ZX_OK;
+  }
+
   zx_status_t status = WriteOperations(journal_operations);
   if (status != ZX_OK) {
     FX_LOGST(WARNING, "journal") << "JournalWriter::WriteOperationToJournal: Failed to write: "
@@ -167,6 +215,11 @@ zx_status_t JournalWriter::WriteMetadataToJournal(JournalWorkItem* work) {
                          next_sequence_number_++);
 
   zx_status_t status = WriteOperationToJournal(work->reservation.buffer_view());
+  if (defer_journal_writes_) {
+    // The payload has to stay encoded until the write is issued.
+    undecoded_entries_.push_back(work->reservation.buffer_view());
+    return status;
+  }
   // Although the payload may be encoded while written to the journal, it should be decoded
   // when written to the final on-disk location later.
   entry.DecodePayloadBlocks();
@@ -296,6 +349,10 @@ fpromise::result<void, zx_status_t> JournalWriter::Flush() {
         << "JournalWriter::Flush: Not issuing writeback because writeback is disabled";
     return fpromise::error(ZX_ERR_BAD_STATE);
   }
+  // Journal entries have to be on the device before the flush which makes them durable.
+  if (zx_status_t status = IssueDeferredJournalWrites(); status != ZX_OK) {
+    return fpromise::error(status);
+  }
   if (zx_status_t status = transaction_handler_->Flush(); status != ZX_OK) {
     FX_LOGST(WARNING, "journal") << "JournalWriter::Flush: " << zx_status_get_string(status);
     DisableWriteback();
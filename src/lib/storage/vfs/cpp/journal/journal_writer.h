@@ -11,6 +11,8 @@
 #include <zircon/types.h>
 
 #include <algorithm>
+#include <optional>
+#include <vector>
 
 #include <fbl/vector.h>
 #include <range/interval-tree.h>
@@ -71,6 +73,19 @@ class JournalWriter {
   fpromise::result<void, zx_status_t> WriteMetadata(JournalWorkItem work,
                                                     std::optional<JournalWorkItem> trim_work);
 
+  // A transaction's metadata, and optionally its trim operations, for |WriteMetadataBatch|.
+  struct MetadataWork {
+    JournalWorkItem work;
+    std::optional<JournalWorkItem> trim_work;
+  };
+
+  // Like calling |WriteMetadata| on each item in |batch| in turn, except that their journal entries
+  // are issued to the device with as few requests as possible rather than one (or more) each.
+  //
+  // Returns the first error encountered; items after a failure are still attempted, just as they
+  // would be had they been written separately.
+  fpromise::result<void, zx_status_t> WriteMetadataBatch(std::vector<MetadataWork> batch);
+
   // Trims |operations| immediately.
   fpromise::result<void, zx_status_t> TrimData(std::vector<storage::BufferedOperation> operations);
 
@@ -85,6 +100,8 @@ class JournalWriter {
   // device.
   [[nodiscard]] bool IsWritebackEnabled() const { return transaction_handler_; }
 
+  // Issues any journal entries which |WriteMetadataBatch| hasn't written yet, flushes the device,
+  // and then writes the metadata of all the journaled entries to its final location.
   fpromise::result<void, zx_status_t> Flush();
 
   bool HavePendingWork() const { return !pending_work_items_.empty(); }
@@ -134,6 +151,10 @@ class JournalWriter {
   // to prevent "partial operations" from being written to the underlying device.
   zx_status_t WriteOperations(const std::vector<storage::BufferedOperation>& operations);
 
+  // Issues the journal writes deferred by |WriteMetadataBatch| and then decodes the payloads of
+  // their entries, so that they are ready to be written to their final locations.
+  zx_status_t IssueDeferredJournalWrites();
+
   fs::TransactionHandler* transaction_handler_ = nullptr;
   JournalSuperblock journal_superblock_;
 
@@ -157,6 +178,16 @@ class JournalWriter {
   // trims, so we keep track of those in pending_work_items_.
   std::vector<JournalWorkItem> pending_work_items_;
 
+  // While |WriteMetadataBatch| is running, journal entries are encoded and accounted for as usual
+  // but the requests which write them are collected here instead of being issued one at a time.
+  // They must be issued before anything else which depends on the journal being on disk, so this is
+  // done before every flush.
+  bool defer_journal_writes_ = false;
+  std::vector<storage::BufferedOperation> deferred_journal_operations_;
+  // The entries whose payloads still need to be decoded once |deferred_journal_operations_| have
+  // been issued. Their reservations are held by |pending_work_items_|.
+  std::vector<storage::BlockBufferView> undecoded_entries_;
+
   // If true, a flush (due to metadata being written to final locations) is required before we can
   // write an info block.
   bool pending_flush_ = false;
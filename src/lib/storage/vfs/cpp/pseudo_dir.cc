@@ -68,10 +68,7 @@ zx_status_t PseudoDir::Readdir(VdirCookie* cookie, void* data, size_t len, size_
 
   std::lock_guard lock(mutex_);
 
-  for (auto it = entries_by_id_.lower_bound(cookie->n); it != entries_by_id_.end(); ++it) {
-    if (cookie->n >= it->id()) {
-      continue;
-    }
+  for (auto it = entries_by_id_.upper_bound(cookie->n); it != entries_by_id_.end(); ++it) {
     VnodeAttributes attr;
     if ((r = it->node()->GetAttributes(&attr)) != ZX_OK) {
       continue;
@@ -108,15 +108,17 @@ class PseudoDir : public Vnode {
     static bool EqualTo(uint64_t key1, uint64_t key2) { return key1 == key2; }
   };
 
+  // Keyed by views of the names owned by the entries, so that lookups don't allocate.
   struct KeyByNameTraits {
-    static fbl::String GetKey(const Entry& entry) { return entry.name(); }
-    static bool LessThan(const fbl::String& key1, const fbl::String& key2) { return key1 < key2; }
-    static bool EqualTo(const fbl::String& key1, const fbl::String& key2) { return key1 == key2; }
+    static std::string_view GetKey(const Entry& entry) { return entry.name(); }
+    static bool LessThan(std::string_view key1, std::string_view key2) { return key1 < key2; }
+    static bool EqualTo(std::string_view key1, std::string_view key2) { return key1 == key2; }
   };
 
   using EntryByIdMap =
       fbl::TaggedWAVLTree<uint64_t, std::unique_ptr<Entry>, IdTreeTag, KeyByIdTraits>;
-  using EntryByNameMap = fbl::TaggedWAVLTree<fbl::String, Entry*, NameTreeTag, KeyByNameTraits>;
+  using EntryByNameMap =
+      fbl::TaggedWAVLTree<std::string_view, Entry*, NameTreeTag, KeyByNameTraits>;
 
   // Creates a directory which is initially empty.
   explicit PseudoDir(PlatformVfs* vfs = nullptr);
@@ -40,6 +40,50 @@ class OneShot {
     return DecompressImpl(dctx, out, payload);
   }
 
+  // The sizes of one zstd frame at the start of a payload.
+  struct Frame {
+    size_t compressed_size;
+    size_t decompressed_size;
+  };
+
+  // Returns the sizes of the first frame in a payload of one or more
+  // concatenated zstd frames.  This fails if the frame header does not record
+  // the decompressed size.
+  static fitx::result<std::string_view, Frame> GetFrame(ByteView payload);
+
+  // Calls `callback(cpp20::span<std::byte> out, ByteView frame)` for each
+  // frame in the payload with the part of the output buffer it decompresses
+  // into.  The frames are independent, so the callback can decompress each
+  // with Decompress (using its own scratch memory) in any order or in
+  // parallel.  This returns success only if the frames exactly fill the
+  // output buffer; if the callback returns an error, it is returned
+  // immediately.
+  template <typename Callback>
+  static fitx::result<std::string_view> ForEachFrame(cpp20::span<std::byte> out, ByteView payload,
+                                                     Callback&& callback) {
+    while (!payload.empty()) {
+      auto frame = GetFrame(payload);
+      if (frame.is_error()) {
+        return frame.take_error();
+      }
+      const auto [compressed_size, decompressed_size] = frame.value();
+      if (decompressed_size > out.size()) {
+        return fitx::error{std::string_view{"decompression would produce too much data"}};
+      }
+      auto result =
+          callback(out.subspan(0, decompressed_size), payload.subspan(0, compressed_size));
+      if (result.is_error()) {
+        return result.take_error();
+      }
+      out = out.subspan(decompressed_size);
+      payload = payload.subspan(compressed_size);
+    }
+    if (!out.empty()) {
+      return fitx::error{std::string_view{"decompression produced too little data"}};
+    }
+    return fitx::ok();
+  }
+
  private:
   struct Context;  // Opaque.
 
@@ -0,0 +1,205 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <lib/zbitl/decompress.h>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <zstd/zstd.h>
+
+namespace {
+
+using zbitl::AsBytes;
+using zbitl::ByteView;
+using zbitl::decompress::OneShot;
+
+// Each frame's contents are distinct and compressible.
+std::string FrameContents(size_t frame, size_t size) {
+  std::string contents;
+  for (size_t i = 0; i < size; ++i) {
+    contents += static_cast<char>('a' + (frame + i / 64) % 26);
+  }
+  return contents;
+}
+
+// Appends one zstd frame of the data to the payload.
+void AppendFrame(std::string& payload, std::string_view data, bool record_size = true) {
+  ZSTD_CCtx* cctx = ZSTD_createCCtx();
+  ASSERT_NE(cctx, nullptr);
+  ASSERT_FALSE(ZSTD_isError(ZSTD_CCtx_setParameter(cctx, ZSTD_c_contentSizeFlag, record_size)));
+  std::string frame(ZSTD_compressBound(data.size()), '\0');
+  const size_t size = ZSTD_compress2(cctx, frame.data(), frame.size(), data.data(), data.size());
+  ZSTD_freeCCtx(cctx);
+  ASSERT_FALSE(ZSTD_isError(size)) << ZSTD_getErrorName(size);
+  frame.resize(size);
+  payload += frame;
+}
+
+struct MultiFramePayload {
+  std::string contents, payload;
+  std::vector<size_t> frame_sizes;
+};
+
+void MakeMultiFramePayload(MultiFramePayload& multi) {
+  for (size_t size : {1000u, 5000u, 1u, 70000u}) {
+    std::string contents = FrameContents(multi.frame_sizes.size(), size);
+    ASSERT_NO_FATAL_FAILURE(AppendFrame(multi.payload, contents));
+    multi.contents += contents;
+    multi.frame_sizes.push_back(size);
+  }
+}
+
+TEST(ZbitlDecompressTests, GetFrame) {
+  std::string payload;
+  ASSERT_NO_FATAL_FAILURE(AppendFrame(payload, FrameContents(0, 1000)));
+  const size_t first_size = payload.size();
+  ASSERT_NO_FATAL_FAILURE(AppendFrame(payload, FrameContents(1, 3000)));
+
+  // Only the first frame is described.
+  auto result = OneShot::GetFrame(AsBytes(payload));
+  ASSERT_TRUE(result.is_ok()) << result.error_value();
+  EXPECT_EQ(result->compressed_size, first_size);
+  EXPECT_EQ(result->decompressed_size, 1000u);
+
+  result = OneShot::GetFrame(AsBytes(payload).subspan(first_size));
+  ASSERT_TRUE(result.is_ok()) << result.error_value();
+  EXPECT_EQ(result->compressed_size, payload.size() - first_size);
+  EXPECT_EQ(result->decompressed_size, 3000u);
+}
+
+TEST(ZbitlDecompressTests, GetFrameNeedsDecompressedSize) {
+  std::string payload;
+  ASSERT_NO_FATAL_FAILURE(AppendFrame(payload, FrameContents(0, 1000), false));
+  EXPECT_TRUE(OneShot::GetFrame(AsBytes(payload)).is_error());
+}
+
+TEST(ZbitlDecompressTests, GetFrameTruncated) {
+  std::string payload;
+  ASSERT_NO_FATAL_FAILURE(AppendFrame(payload, FrameContents(0, 1000)));
+  payload.resize(payload.size() - 1);
+  EXPECT_TRUE(OneShot::GetFrame(AsBytes(payload)).is_error());
+}
+
+TEST(ZbitlDecompressTests, ForEachFrame) {
+  MultiFramePayload multi;
+  ASSERT_NO_FATAL_FAILURE(MakeMultiFramePayload(multi));
+
+  // Each frame fills the next part of the output.
+  std::vector<std::byte> out(multi.contents.size());
+  std::vector<size_t> frame_sizes;
+  size_t offset = 0;
+  auto decompress = [&](cpp20::span<std::byte> frame_out, ByteView frame) {
+    EXPECT_EQ(frame_out.data(), out.data() + offset);
+    offset += frame_out.size();
+    frame_sizes.push_back(frame_out.size());
+    return OneShot::Decompress(frame_out, frame, zbitl::decompress::DefaultAllocator);
+  };
+  auto result = OneShot::ForEachFrame(out, AsBytes(multi.payload), decompress);
+  ASSERT_TRUE(result.is_ok()) << result.error_value();
+  EXPECT_EQ(frame_sizes, multi.frame_sizes);
+  EXPECT_EQ(std::string_view(reinterpret_cast<const char*>(out.data()), out.size()),
+            multi.contents);
+}
+
+TEST(ZbitlDecompressTests, ForEachFrameInParallel) {
+  MultiFramePayload multi;
+  ASSERT_NO_FATAL_FAILURE(MakeMultiFramePayload(multi));
+
+  // The frames are independent, so each can be decompressed on its own thread
+  // after they have all been found.
+  std::vector<std::pair<cpp20::span<std::byte>, ByteView>> frames;
+  std::vector<std::byte> out(multi.contents.size());
+  auto collect = [&frames](cpp20::span<std::byte> frame_out,
+                           ByteView frame) -> fitx::result<std::string_view> {
+    frames.emplace_back(frame_out, frame);
+    return fitx::ok();
+  };
+  auto result = OneShot::ForEachFrame(out, AsBytes(multi.payload), collect);
+  ASSERT_TRUE(result.is_ok()) << result.error_value();
+  ASSERT_EQ(frames.size(), multi.frame_sizes.size());
+
+  std::vector<fitx::result<std::string_view>> results(frames.size(), fitx::ok());
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < frames.size(); ++i) {
+    threads.emplace_back([&frames, &results, i] {
+      const auto& [frame_out, frame] = frames[i];
+      results[i] = OneShot::Decompress(frame_out, frame, zbitl::decompress::DefaultAllocator);
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  for (const auto& frame_result : results) {
+    EXPECT_TRUE(frame_result.is_ok()) << frame_result.error_value();
+  }
+  EXPECT_EQ(std::string_view(reinterpret_cast<const char*>(out.data()), out.size()),
+            multi.contents);
+}
+
+TEST(ZbitlDecompressTests, ForEachFrameOutputTooSmall) {
+  MultiFramePayload multi;
+  ASSERT_NO_FATAL_FAILURE(MakeMultiFramePayload(multi));
+
+  std::vector<std::byte> out(multi.contents.size() - 1);
+  size_t calls = 0;
+  auto count = [&calls](cpp20::span<std::byte>, ByteView) -> fitx::result<std::string_view> {
+    ++calls;
+    return fitx::ok();
+  };
+  EXPECT_TRUE(OneShot::ForEachFrame(out, AsBytes(multi.payload), count).is_error());
+
+  // The last frame doesn't fit, so it's never passed to the callback.
+  EXPECT_EQ(calls, multi.frame_sizes.size() - 1);
+}
+
+TEST(ZbitlDecompressTests, ForEachFrameOutputTooLarge) {
+  MultiFramePayload multi;
+  ASSERT_NO_FATAL_FAILURE(MakeMultiFramePayload(multi));
+
+  std::vector<std::byte> out(multi.contents.size() + 1);
+  size_t calls = 0;
+  auto count = [&calls](cpp20::span<std::byte>, ByteView) -> fitx::result<std::string_view> {
+    ++calls;
+    return fitx::ok();
+  };
+  EXPECT_TRUE(OneShot::ForEachFrame(out, AsBytes(multi.payload), count).is_error());
+  EXPECT_EQ(calls, multi.frame_sizes.size());
+}
+
+TEST(ZbitlDecompressTests, ForEachFrameStopsOnCallbackError) {
+  MultiFramePayload multi;
+  ASSERT_NO_FATAL_FAILURE(MakeMultiFramePayload(multi));
+
+  std::vector<std::byte> out(multi.contents.size());
+  size_t calls = 0;
+  auto fail = [&calls](cpp20::span<std::byte>, ByteView) -> fitx::result<std::string_view> {
+    ++calls;
+    return fitx::error{std::string_view{"callback failed"}};
+  };
+  auto result = OneShot::ForEachFrame(out, AsBytes(multi.payload), fail);
+  ASSERT_TRUE(result.is_error());
+  EXPECT_EQ(result.error_value(), "callback failed");
+  EXPECT_EQ(calls, 1u);
+}
+
+TEST(ZbitlDecompressTests, ForEachFrameNeedsDecompressedSizes) {
+  MultiFramePayload multi;
+  ASSERT_NO_FATAL_FAILURE(MakeMultiFramePayload(multi));
+  const std::string tail = FrameContents(0, 1000);
+  ASSERT_NO_FATAL_FAILURE(AppendFrame(multi.payload, tail, false));
+
+  std::vector<std::byte> out(multi.contents.size() + tail.size());
+  auto ignore = [](cpp20::span<std::byte>, ByteView) -> fitx::result<std::string_view> {
+    return fitx::ok();
+  };
+  EXPECT_TRUE(OneShot::ForEachFrame(out, AsBytes(multi.payload), ignore).is_error());
+}
+
+}  // namespace
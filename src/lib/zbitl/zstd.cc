@@ -6,6 +6,7 @@
 #include <zircon/assert.h>
 
 #include <functional>
+#include <limits>
 
 #include <zstd/zstd.h>
 
@@ -25,6 +26,28 @@ OneShot::Context* OneShot::Init(void* scratch_space, size_t size) {
   return reinterpret_cast<Context*>(ZSTD_initStaticDCtx(scratch_space, size));
 }
 
+fitx::result<std::string_view, OneShot::Frame> OneShot::GetFrame(ByteView payload) {
+  size_t compressed_size = ZSTD_findFrameCompressedSize(payload.data(), payload.size());
+  if (ZSTD_isError(compressed_size)) {
+    return fitx::error{std::string_view{ZSTD_getErrorName(compressed_size)}};
+  }
+  ZX_DEBUG_ASSERT(compressed_size <= payload.size());
+  unsigned long long decompressed_size = ZSTD_getFrameContentSize(payload.data(), payload.size());
+  if (decompressed_size == ZSTD_CONTENTSIZE_ERROR) {
+    return fitx::error{"bad or corrupted data: invalid frame header"sv};
+  }
+  if (decompressed_size == ZSTD_CONTENTSIZE_UNKNOWN) {
+    return fitx::error{"frame header does not record the decompressed size"sv};
+  }
+  if (decompressed_size > std::numeric_limits<size_t>::max()) {
+    return fitx::error{"frame decompressed size too large"sv};
+  }
+  return fitx::ok(Frame{
+      .compressed_size = compressed_size,
+      .decompressed_size = static_cast<size_t>(decompressed_size),
+  });
+}
+
 fitx::result<std::string_view> OneShot::DecompressImpl(Context* ctx, cpp20::span<std::byte> out,
                                                        ByteView in) {
   // All-in-one mode.  This will be the only call made.
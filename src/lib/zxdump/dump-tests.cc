@@ -4,11 +4,20 @@
 
 #include "dump-tests.h"
 
+#include <lib/zx/vmar.h>
+#include <lib/zx/vmo.h>
 #include <lib/zxdump/dump.h>
 #include <lib/zxdump/fd-writer.h>
 #include <lib/zxdump/task.h>
 #include <lib/zxdump/zstd-writer.h>
+#include <sys/stat.h>
 
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <utility>
+
+#include "core.h"
 #include "test-file.h"
 #include "test-tool-process.h"
 
@@ -351,5 +360,179 @@ TEST(ZxdumpTests, ProcessDumpDate) {
 
 // TODO(mcgrathr): test job archives w/&w/o dates
 
+// The memory tests dump this process's own memory, but only the mappings of a
+// VMO whose pages alternate between nonzero data and zeros, ending in zeros.
+constexpr size_t kTestVmoPages = 4;
+
+class TestVmo {
+ public:
+  void Init() {
+    const size_t size = this->size();
+    ASSERT_EQ(zx::vmo::create(size, 0, &vmo_), ZX_OK);
+    contents_.resize(size);
+    for (size_t page = 0; page < kTestVmoPages; page += 2) {
+      std::fill_n(contents_.begin() + page * page_size_, page_size_, std::byte(page + 1));
+    }
+    ASSERT_EQ(vmo_.write(contents_.data(), 0, size), ZX_OK);
+
+    zx_info_handle_basic_t info;
+    ASSERT_EQ(vmo_.get_info(ZX_INFO_HANDLE_BASIC, &info, sizeof(info), nullptr, nullptr), ZX_OK);
+    koid_ = info.koid;
+  }
+
+  ~TestVmo() {
+    for (uintptr_t vaddr : mappings_) {
+      EXPECT_EQ(zx::vmar::root_self()->unmap(vaddr, size()), ZX_OK);
+    }
+  }
+
+  uintptr_t Map() {
+    uintptr_t vaddr = 0;
+    EXPECT_EQ(zx::vmar::root_self()->map(ZX_VM_PERM_READ, 0, vmo_, 0, size(), &vaddr), ZX_OK);
+    mappings_.push_back(vaddr);
+    return vaddr;
+  }
+
+  size_t page_size() const { return page_size_; }
+
+  size_t size() const { return kTestVmoPages * page_size_; }
+
+  ByteView contents() const { return {contents_.data(), contents_.size()}; }
+
+  // Dump this process with only the memory of this VMO into the file, and
+  // collect the file ranges passed to the dump callback for memory.
+  void Dump(TestFile& file, std::vector<std::pair<size_t, size_t>>& written) const {
+    zxdump::FdWriter writer(file.RewoundFd());
+    zxdump::ProcessDump<zx::unowned_process> dump(zx::process::self());
+
+    auto prune = [koid = koid_](zxdump::SegmentDisposition segment, const zx_info_maps_t& maps,
+                                const zx_info_vmo_t& vmo)
+        -> fitx::result<zxdump::Error, zxdump::SegmentDisposition> {
+      if (vmo.koid != koid) {
+        segment.filesz = 0;
+      }
+      return fitx::ok(segment);
+    };
+    auto collect_result = dump.CollectProcess(prune);
+    ASSERT_TRUE(collect_result.is_ok()) << collect_result.error_value();
+
+    auto dump_result = dump.DumpHeaders(writer.AccumulateFragmentsCallback());
+    ASSERT_TRUE(dump_result.is_ok()) << dump_result.error_value();
+
+    auto write_result = writer.WriteFragments();
+    ASSERT_TRUE(write_result.is_ok()) << write_result.error_value();
+
+    auto write = writer.WriteCallback();
+    auto record = [&](size_t offset, ByteView data) {
+      written.emplace_back(offset, data.size());
+      return write(offset, data);
+    };
+    auto memory_result = dump.DumpMemory(record);
+    ASSERT_TRUE(memory_result.is_ok()) << memory_result.error_value();
+  }
+
+ private:
+  const size_t page_size_ = zx_system_get_page_size();
+  zx::vmo vmo_;
+  zx_koid_t koid_ = ZX_KOID_INVALID;
+  std::vector<std::byte> contents_;
+  std::vector<uintptr_t> mappings_;
+};
+
+// Find the PT_LOAD segment for the mapping at vaddr in the dump.
+std::optional<Elf::Phdr> FindLoadSegment(TestFile& file, uintptr_t vaddr) {
+  fbl::unique_fd fd = file.RewoundFd();
+  Elf::Ehdr ehdr;
+  EXPECT_EQ(pread(fd.get(), &ehdr, sizeof(ehdr), 0), static_cast<ssize_t>(sizeof(ehdr)));
+  EXPECT_NE(ehdr.phnum(), Elf::Ehdr::kPnXnum);
+  std::vector<Elf::Phdr> phdrs(ehdr.phnum());
+  const size_t phdrs_size = phdrs.size() * sizeof(Elf::Phdr);
+  EXPECT_EQ(pread(fd.get(), phdrs.data(), phdrs_size, ehdr.phoff()),
+            static_cast<ssize_t>(phdrs_size));
+  for (const Elf::Phdr& phdr : phdrs) {
+    if (phdr.type == elfldltl::ElfPhdrType::kLoad && phdr.vaddr() == vaddr) {
+      return phdr;
+    }
+  }
+  return std::nullopt;
+}
+
+// Verify the segment's data in the file matches the VMO, and return which of
+// its pages were passed to the dump callback.
+std::array<bool, kTestVmoPages> CheckSegment(
+    TestFile& file, const TestVmo& vmo, const Elf::Phdr& phdr,
+    const std::vector<std::pair<size_t, size_t>>& written) {
+  EXPECT_EQ(phdr.filesz(), vmo.size());
+
+  // The file has its full size even though the segment ends in zero pages.
+  fbl::unique_fd fd = file.RewoundFd();
+  struct stat st;
+  EXPECT_EQ(fstat(fd.get(), &st), 0);
+  EXPECT_GE(static_cast<size_t>(st.st_size), phdr.offset() + vmo.size());
+
+  std::vector<std::byte> data(vmo.size());
+  EXPECT_EQ(pread(fd.get(), data.data(), data.size(), phdr.offset()),
+            static_cast<ssize_t>(data.size()));
+  EXPECT_TRUE(ByteView(data.data(), data.size()) == vmo.contents());
+
+  std::array<bool, kTestVmoPages> pages_written{};
+  for (size_t page = 0; page < kTestVmoPages; ++page) {
+    const size_t start = phdr.offset() + page * vmo.page_size();
+    for (const auto& [offset, size] : written) {
+      if (offset < start + vmo.page_size() && start < offset + size) {
+        pages_written[page] = true;
+      }
+    }
+  }
+  return pages_written;
+}
+
+TEST(ZxdumpTests, ProcessDumpSkipsZeroPages) {
+  TestVmo vmo;
+  ASSERT_NO_FATAL_FAILURE(vmo.Init());
+  const uintptr_t vaddr = vmo.Map();
+
+  TestFile file;
+  std::vector<std::pair<size_t, size_t>> written;
+  ASSERT_NO_FATAL_FAILURE(vmo.Dump(file, written));
+
+  std::optional<Elf::Phdr> phdr = FindLoadSegment(file, vaddr);
+  ASSERT_TRUE(phdr);
+
+  // The zero page in the middle is left as a hole.  The last page is written
+  // anyway, so the file is never short.
+  constexpr std::array<bool, kTestVmoPages> kExpected = {true, false, true, true};
+  EXPECT_EQ(CheckSegment(file, vmo, *phdr, written), kExpected);
+}
+
+TEST(ZxdumpTests, ProcessDumpWritesSharedVmoRangeOnce) {
+  TestVmo vmo;
+  ASSERT_NO_FATAL_FAILURE(vmo.Init());
+  const uintptr_t first_vaddr = vmo.Map();
+  const uintptr_t second_vaddr = vmo.Map();
+
+  TestFile file;
+  std::vector<std::pair<size_t, size_t>> written;
+  ASSERT_NO_FATAL_FAILURE(vmo.Dump(file, written));
+
+  std::optional<Elf::Phdr> first = FindLoadSegment(file, first_vaddr);
+  ASSERT_TRUE(first);
+  std::optional<Elf::Phdr> second = FindLoadSegment(file, second_vaddr);
+  ASSERT_TRUE(second);
+
+  // Both segments use the same data in the file.
+  EXPECT_EQ(first->offset(), second->offset());
+  EXPECT_EQ(second->filesz(), first->filesz());
+  ASSERT_NO_FATAL_FAILURE(CheckSegment(file, vmo, *second, written));
+
+  // Only one copy of the nonzero pages and the final page was passed to the
+  // dump callback.
+  size_t total_written = 0;
+  for (const auto& [offset, size] : written) {
+    total_written += size;
+  }
+  EXPECT_EQ(total_written, 3 * vmo.page_size());
+}
+
 }  // namespace
 }  // namespace zxdump::testing
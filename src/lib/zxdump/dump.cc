@@ -16,6 +16,7 @@
 #include <charconv>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <limits>
 #include <map>
 #include <optional>
@@ -96,6 +97,14 @@ class NoteHeader {
 
 constexpr std::byte kZeroBytes[NoteAlign() - 1] = {};
 
+// This detects whole pages of zero bytes in memory.  Comparing each byte to
+// the next needs no buffer of zeros, which would have to be as big as the
+// page size only known at runtime.
+bool IsAllZero(ByteView data) {
+  return data.empty() || (data.front() == std::byte{} &&
+                          memcmp(data.data(), data.data() + 1, data.size() - 1) == 0);
+}
+
 // This returns a ByteView of as many zero bytes are needed for alignment
 // padding after the given ELF note payload data.
 constexpr ByteView PadForElfNote(ByteView data) {
@@ -574,6 +583,7 @@ class ProcessDumpBase::Collector {
 
     // Clear out from any previous use.
     phdrs_.clear();
+    shared_segments_.clear();
 
     // The first phdr is the main note segment.
     const Elf::Phdr note_phdr = {
@@ -658,8 +668,13 @@ class ProcessDumpBase::Collector {
   // value will be the "success" return value.
   fitx::result<Error, size_t> DumpMemory(DumpCallback dump, size_t limit) {
     size_t offset = headers_size_bytes() + notes_size_bytes();
-    for (const auto& segment : phdrs_) {
+    for (size_t i = 0; i < phdrs_.size(); ++i) {
+      const Elf::Phdr& segment = phdrs_[i];
       if (segment.type == elfldltl::ElfPhdrType::kLoad) {
+        if (shared_segments_.find(i) != shared_segments_.end()) {
+          // The same data was already written for an earlier segment.
+          continue;
+        }
         uintptr_t vaddr = segment.vaddr;
         if (segment.offset >= limit) {
           break;
@@ -683,8 +698,9 @@ class ProcessDumpBase::Collector {
             ZX_DEBUG_ASSERT(chunk.data());
           }
 
-          // Send it to the callback to write it out.
-          if (dump(offset, chunk)) {
+          // Send it to the callback to write it out.  Whole pages of zeros
+          // are left out and become holes the writer fills in.
+          if (DumpNonzeroPages(dump, offset, chunk, chunk.size() == left)) {
             break;
           }
 
@@ -701,6 +717,28 @@ class ProcessDumpBase::Collector {
   void set_date(time_t date) { std::get<DateNote>(notes_).Set(date); }
 
  private:
+  // Call dump on the parts of the data for the given file offset that are not
+  // whole pages of zero bytes.  The final page of a segment is always written
+  // so that the file has its full size even if it ends in a hole.  Returns
+  // true if a dump call did.
+  static bool DumpNonzeroPages(DumpCallback& dump, size_t offset, ByteView data,
+                               bool ends_segment) {
+    const size_t page_size = zx_system_get_page_size();
+    size_t run = 0;  // Start of the data not yet written or skipped.
+    for (size_t pos = 0; pos < data.size();) {
+      const size_t end = std::min(data.size(), pos + page_size - ((offset + pos) % page_size));
+      const bool last = ends_segment && end == data.size();
+      if (end - pos == page_size && !last && IsAllZero(data.substr(pos, page_size))) {
+        if (pos > run && dump(offset + run, data.substr(run, pos - run))) {
+          return true;
+        }
+        run = end;
+      }
+      pos = end;
+    }
+    return run < data.size() && dump(offset + run, data.substr(run));
+  }
+
   struct ProcessInfoClass {
     using Handle = zx::process;
     static constexpr auto MakeHeader = kMakeNote<kProcessInfoNoteName>;
@@ -1035,6 +1073,10 @@ class ProcessDumpBase::Collector {
               ((mmu_flags & ZX_VM_PERM_EXECUTE) ? Elf::Phdr::kExecute : 0));
     };
 
+    // This maps (VMO KOID, VMO offset, size) to the first segment dumping it.
+    using VmoRange = std::tuple<zx_koid_t, uint64_t, size_t>;
+    std::map<VmoRange, size_t> dumped_vmo_ranges;
+
     // Go through each mapping.  They are in ascending address order.
     uintptr_t address_limit = 0;
     for (const zx_info_maps_t& info : process_maps().info()) {
@@ -1082,6 +1124,18 @@ class ProcessDumpBase::Collector {
 
         ZX_ASSERT(dump.filesz <= info.size);
         segment.filesz = dump.filesz;
+
+        // When the same range of a VMO is mapped more than once (such as a
+        // shared memory region mapped twice), its data is only written once
+        // and the later segments point at the same file offset.
+        if (segment.filesz > 0) {
+          const VmoRange key{vmo.koid, info.u.mapping.vmo_offset, segment.filesz()};
+          const size_t index = phdrs_.size() - 1;
+          auto [it, inserted] = dumped_vmo_ranges.try_emplace(key, index);
+          if (!inserted) {
+            shared_segments_.emplace(index, it->second);
+          }
+        }
       }
     }
 
@@ -1130,11 +1184,18 @@ class ProcessDumpBase::Collector {
     ZX_DEBUG_ASSERT(phdrs_[0].type == elfldltl::ElfPhdrType::kNote);
     place(phdrs_[0]);
 
-    // Now place the remaining segments, if any.
-    for (auto& phdr : cpp20::span(phdrs_).subspan(1)) {
+    // Now place the remaining segments, if any.  A segment sharing another's
+    // data uses the same file offset.  The original always comes first.
+    for (size_t i = 1; i < phdrs_.size(); ++i) {
+      Elf::Phdr& phdr = phdrs_[i];
       switch (phdr.type) {
         case elfldltl::ElfPhdrType::kLoad:
-          place(phdr);
+          if (auto shared = shared_segments_.find(i); shared != shared_segments_.end()) {
+            ZX_DEBUG_ASSERT(shared->second < i);
+            phdr.offset = phdrs_[shared->second].offset;
+          } else {
+            place(phdr);
+          }
           break;
 
         default:
@@ -1296,6 +1357,7 @@ class ProcessDumpBase::Collector {
   std::map<zx_koid_t, size_t> thread_koid_to_index_;
 
   std::vector<Elf::Phdr> phdrs_;
+  std::map<size_t, size_t> shared_segments_;  // phdrs_ index -> earlier index.
   Elf::Ehdr ehdr_ = {};
   Elf::Shdr shdr_ = {};  // Only used for the PN_XNUM case.
 
@@ -54,7 +54,7 @@ fitx::result<ZstdWriter::error_type> ZstdWriter::Write(size_t offset, ByteView d
 
   // If there are holes we have to feed zero bytes to the compressor.
   while (offset > offset_) {
-    static constexpr std::byte kZero[32] = {};
+    static constexpr std::byte kZero[4096] = {};
     auto pad = ByteView{kZero, sizeof(kZero)}.substr(0, offset - offset_);
     auto result = Write(offset_, pad);
     if (result.is_error()) {
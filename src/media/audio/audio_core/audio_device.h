@@ -293,6 +293,7 @@ class AudioDevice : public AudioObject, public std::enable_shared_from_this<Audi
 
   ExecutionDomain& mix_domain() const { return *mix_domain_; }
   ThreadingModel& threading_model() { return threading_model_; }
+  LinkMatrix& link_matrix() { return link_matrix_; }
   std::shared_ptr<AudioCoreClockFactory> clock_factory() { return clock_factory_; }
   DeviceRegistry& device_registry() { return device_registry_; }
   const fbl::RefPtr<AudioDeviceSettings>& device_settings() const { return device_settings_; }
@@ -73,6 +73,10 @@ class AudioObject {
   // Called immediately after a new link is added to the object.
   virtual void OnLinkAdded() {}
 
+  // Called on the main message loop after a destination of this object changed its presentation
+  // delay, for example when an output switches in or out of low-latency mode.
+  virtual void OnDestPresentationDelayChanged() {}
+
   // Note: format() is subject to change and must only be accessed from the main message loop
   // thread. Outputs which are running on mixer threads should never access format() directly
   // from a mix thread. Instead, they should use the format which was assigned to the AudioLink
@@ -178,6 +178,12 @@ AudioOutput::InitializeSourceLink(const AudioObject& source,
   FX_CHECK(!source_stream->reference_clock()->adjustable() || !reference_clock()->adjustable());
 
   auto mixer = pipeline_->AddInput(std::move(source_stream), *usage);
+
+  if (IsLowLatencyUsage(*usage) && low_latency_sources_.insert(&source).second &&
+      low_latency_sources_.size() == 1) {
+    SetLowLatency(true);
+  }
+
   return fpromise::ok(std::make_pair(std::move(mixer), &mix_domain()));
 }
 
@@ -187,6 +193,9 @@ void AudioOutput::CleanupSourceLink(const AudioObject& source,
   if (source_stream) {
     pipeline_->RemoveInput(*source_stream);
   }
+  if (low_latency_sources_.erase(&source) && low_latency_sources_.empty()) {
+    SetLowLatency(false);
+  }
 }
 
 fpromise::result<std::shared_ptr<ReadableStream>, zx_status_t> AudioOutput::InitializeDestLink(
@@ -201,6 +210,25 @@ fpromise::result<std::shared_ptr<ReadableStream>, zx_status_t> AudioOutput::Init
   return fpromise::ok(pipeline_->dup_loopback());
 }
 
+void AudioOutput::UpdatePresentationDelay(zx::duration delay) {
+  TRACE_DURATION("audio", "AudioOutput::UpdatePresentationDelay");
+  SetPresentationDelay(delay);
+  if (pipeline_) {
+    pipeline_->SetPresentationDelay(delay);
+  }
+
+  // Sources compute their lead time on the main message loop, so notify them there.
+  threading_model().FidlDomain().PostTask([weak_output = weak_from_this()] {
+    auto output = std::static_pointer_cast<AudioOutput>(weak_output.lock());
+    if (!output) {
+      return;
+    }
+    output->link_matrix().ForEachSourceLink(*output, [](LinkMatrix::LinkHandle link) {
+      link.object->OnDestPresentationDelayChanged();
+    });
+  });
+}
+
 std::shared_ptr<OutputPipeline> AudioOutput::CreateOutputPipeline(
     const PipelineConfig& config, const VolumeCurve& volume_curve, size_t max_block_size_frames,
     TimelineFunction device_reference_clock_to_fractional_frame, std::shared_ptr<Clock> ref_clock) {
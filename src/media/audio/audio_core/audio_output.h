@@ -10,6 +10,7 @@
 #include <lib/zx/time.h>
 
 #include <optional>
+#include <unordered_set>
 
 #include "src/media/audio/audio_core/audio_device.h"
 #include "src/media/audio/audio_core/audio_driver.h"
@@ -123,7 +124,22 @@ class AudioOutput : public AudioDevice {
   // wakes up to process pending jobs.
   virtual zx::duration MixDeadline() const FXL_EXCLUSIVE_LOCKS_REQUIRED(mix_domain().token()) = 0;
 
+  // Called on the main message loop when the first low-latency renderer links to this output, and
+  // again when the last one unlinks. Outputs which can mix with a shorter period override this.
+  // See |IsLowLatencyUsage|.
+  virtual void SetLowLatency(bool low_latency) {}
+
+  // Updates the presentation delay of this output and its pipeline, then asks every source linked
+  // to this output to recompute its lead time.
+  void UpdatePresentationDelay(zx::duration delay)
+      FXL_EXCLUSIVE_LOCKS_REQUIRED(mix_domain().token());
+
  private:
+  // Renderers with this usage ask for the lowest latency output can provide.
+  static bool IsLowLatencyUsage(const StreamUsage& usage) {
+    return usage.is_render_usage() && usage.render_usage() == RenderUsage::COMMUNICATION;
+  }
+
   // Timer used to schedule periodic mixing.
   void MixTimerThunk() {
     OBTAIN_EXECUTION_DOMAIN_TOKEN(token, &mix_domain());
@@ -136,6 +152,11 @@ class AudioOutput : public AudioDevice {
   size_t max_block_size_frames_;
 
   std::shared_ptr<OutputPipeline> pipeline_;
+
+  // Linked sources for which |IsLowLatencyUsage| is true. Only accessed while linking or unlinking
+  // objects, which happens on the main message loop.
+  std::unordered_set<const AudioObject*> low_latency_sources_;
+
   Reporter::Container<Reporter::OutputDevice, Reporter::kObjectsToCache>::Ptr reporter_;
   EffectsLoaderV2* effects_loader_v2_;
 };
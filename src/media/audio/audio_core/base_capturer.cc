@@ -623,6 +623,11 @@ zx_status_t BaseCapturer::Process() {
       return ZX_OK;
     }
 
+    // Mix any following packets which can already be captured along with this one, rather than
+    // running the mix once per packet.
+    pq->ExtendMixerJob(*mix_state, std::min(static_cast<size_t>(dest_safe_frame - frame_pointer_),
+                                            static_cast<size_t>(max_frames_per_capture_)));
+
     // Assign a timestamp if one has not already been assigned.
     if (mix_state->capture_timestamp == fuchsia::media::NO_TIMESTAMP) {
       mix_state->capture_timestamp =
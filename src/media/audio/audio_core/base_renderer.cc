@@ -79,6 +79,11 @@ fpromise::result<std::shared_ptr<ReadableStream>, zx_status_t> BaseRenderer::Ini
   TRACE_DURATION("audio", "BaseRenderer::InitializeDestLink");
 
   // The PacketQueue uses our same clock.
+  //
+  // Each destination gets its own queue, and so its own Mixer in that destination's MixStage.
+  // RouteGraph links a renderer to at most one output (see `RouteGraph::TargetForUsage`), so this
+  // doesn't duplicate any resampling. Sharing a queue's resampled output between destinations
+  // would only be valid if they also shared a reference clock and a frame timeline.
   auto queue =
       std::make_shared<PacketQueue>(*format(), reference_clock_to_fractional_frames_, clock_);
 
@@ -759,6 +764,8 @@ void BaseRenderer::ReportStop() {
 
 void BaseRenderer::OnLinkAdded() { RecomputeMinLeadTime(); }
 
+void BaseRenderer::OnDestPresentationDelayChanged() { RecomputeMinLeadTime(); }
+
 void BaseRenderer::EnableMinLeadTimeEvents(bool enabled) {
   EnableMinLeadTimeEventsInternal(enabled);
 }
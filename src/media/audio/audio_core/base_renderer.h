@@ -72,6 +72,7 @@ class BaseRenderer : public AudioObject,
 
   // |media::audio::AudioObject|
   void OnLinkAdded() override;
+  void OnDestPresentationDelayChanged() override;
   fpromise::result<std::shared_ptr<ReadableStream>, zx_status_t> InitializeDestLink(
       const AudioObject& dest) override;
   void CleanupDestLink(const AudioObject& dest) override;
@@ -110,6 +110,32 @@ std::optional<CapturePacketQueue::PacketMixState> CapturePacketQueue::NextMixerJ
   };
 }
 
+void CapturePacketQueue::ExtendMixerJob(PacketMixState& state, size_t max_frames) {
+  TRACE_INSTANT("audio", "CapturePacketQueue::ExtendMixerJob", TRACE_SCOPE_THREAD);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (pending_.empty() || pending_.front() != state.packet || state.packets != 1 ||
+      state.frames != state.packet->num_frames_ - state.packet->state_.filled_frames) {
+    return;
+  }
+
+  auto bytes_per_frame = format_.bytes_per_frame();
+  for (size_t k = 1; k < pending_.size() && state.frames < max_frames; ++k) {
+    auto& prev = pending_[k - 1];
+    auto& p = pending_[k];
+    auto prev_end = prev->payload_buffer_start_ + prev->num_frames_ * bytes_per_frame;
+    if (p->payload_buffer_start_ != prev_end) {
+      break;
+    }
+    FX_DCHECK(p->state_.filled_frames == 0);
+    auto frames = std::min(p->num_frames_, max_frames - state.frames);
+    state.frames += frames;
+    state.packets++;
+    if (frames < p->num_frames_) {
+      break;
+    }
+  }
+}
+
 CapturePacketQueue::PacketMixStatus CapturePacketQueue::FinishMixerJob(
     const PacketMixState& state) {
   TRACE_INSTANT("audio", "CapturePacketQueue::FinishMixerJob", TRACE_SCOPE_THREAD);
@@ -117,15 +143,34 @@ CapturePacketQueue::PacketMixStatus CapturePacketQueue::FinishMixerJob(
   if (pending_.empty() || pending_.front() != state.packet) {
     return PacketMixStatus::Discarded;
   }
-  auto& p = state.packet;
-  p->state_.capture_timestamp = state.capture_timestamp;
-  p->state_.flags = state.flags;
-  p->state_.filled_frames += state.frames;
-  if (p->state_.filled_frames < p->num_frames_) {
-    return PacketMixStatus::Partial;
+  FX_DCHECK(state.packets <= pending_.size());
+
+  auto status = PacketMixStatus::Partial;
+  auto frames_left = state.frames;
+  // Frames from the start of the first packet to the start of the current one.
+  size_t packet_start_frame = 0;
+  for (size_t k = 0; k < state.packets && !pending_.empty(); ++k) {
+    // Completed packets are popped, so the current packet is always at the front.
+    auto p = pending_.front();
+    if (k == 0) {
+      p->state_.capture_timestamp = state.capture_timestamp;
+      p->state_.flags = state.flags;
+    } else if (state.capture_timestamp != fuchsia::media::NO_TIMESTAMP) {
+      p->state_.capture_timestamp =
+          state.capture_timestamp +
+          format_.frames_per_ns().Inverse().Scale(static_cast<int64_t>(packet_start_frame));
+    }
+    auto frames = std::min(frames_left, p->num_frames_ - p->state_.filled_frames);
+    p->state_.filled_frames += frames;
+    frames_left -= frames;
+    packet_start_frame += p->num_frames_;
+    if (p->state_.filled_frames < p->num_frames_) {
+      break;
+    }
+    PopPendingLocked();
+    status = PacketMixStatus::Done;
   }
-  PopPendingLocked();
-  return PacketMixStatus::Done;
+  return status;
 }
 
 void CapturePacketQueue::DiscardPendingPackets() {
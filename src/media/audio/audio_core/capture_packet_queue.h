@@ -143,13 +143,23 @@ class CapturePacketQueue {
     uint32_t flags = 0;
     void* target = nullptr;
     size_t frames = 0;
+    // The number of packets the job spans, see ExtendMixerJob.
+    size_t packets = 1;
   };
   std::optional<PacketMixState> NextMixerJob();
 
+  // Extend a job returned by NextMixerJob over the pending packets which directly follow its
+  // packet in the payload buffer, up to max_frames in total, so that a single mix can fill several
+  // small packets. Does nothing unless the job covers the rest of its packet. The capture_timestamp
+  // and flags of the job apply to its first packet; FinishMixerJob derives the timestamps of the
+  // following packets from it.
+  void ExtendMixerJob(PacketMixState& state, size_t max_frames);
+
   // Complete the job started by the last call to NextMixerJob().
   enum class PacketMixStatus {
     // If the packet was fully mixed, it will be moved from the pending queue to
-    // the back of the ready queue.
+    // the back of the ready queue. For jobs which span several packets, every packet
+    // which was fully mixed is moved, and the last one may be left partially mixed.
     Done,
     // If the packet was only partially mixed, we expect another call to NextMixerJob.
     // The packet will be left at the front of the pending queue.
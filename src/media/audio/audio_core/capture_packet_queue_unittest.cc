@@ -5,6 +5,7 @@
 #include "src/media/audio/audio_core/capture_packet_queue.h"
 
 #include <lib/syslog/cpp/macros.h>
+#include <lib/zx/time.h>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -181,6 +182,48 @@ TEST_F(CapturePacketQueueTest, Preallocated_PartialMix) {
   }
 }
 
+TEST_F(CapturePacketQueueTest, Preallocated_ExtendedMix) {
+  CreateMapper(40);
+  auto result = CapturePacketQueue::CreatePreallocated(payload_buffer_, kFormat, 10);
+  ASSERT_TRUE(result.is_ok()) << result.error();
+
+  const auto kBytesPerPacket = 10 * kBytesPerFrame;
+  auto pq = result.take_value();
+
+  ASSERT_EQ(pq->PendingSize(), 4u);
+  auto mix_state = pq->NextMixerJob().value();
+  pq->ExtendMixerJob(mix_state, 25);
+  EXPECT_EQ(mix_state.target, payload_start_ + 0);
+  EXPECT_EQ(mix_state.frames, 25u);
+  EXPECT_EQ(mix_state.packets, 3u);
+  mix_state.capture_timestamp = 1'000'000;
+  ASSERT_EQ(CapturePacketQueue::PacketMixStatus::Done, pq->FinishMixerJob(mix_state));
+
+  // Each complete packet is timestamped from its position in the mix.
+  ASSERT_EQ(pq->ReadySize(), 2u);
+  auto p = pq->PopReady();
+  EXPECT_EQ(p->stream_packet().pts, 1'000'000);
+  ExpectPacket(p, {
+                      .payload_buffer_id = 0,
+                      .payload_offset = 0,
+                      .payload_size = kBytesPerPacket,
+                  });
+  p = pq->PopReady();
+  EXPECT_EQ(p->stream_packet().pts, 1'000'000 + zx::sec(10).get() / kFrameRate);
+  ExpectPacket(p, {
+                      .payload_buffer_id = 0,
+                      .payload_offset = kBytesPerPacket,
+                      .payload_size = kBytesPerPacket,
+                  });
+
+  // The third packet was partially mixed.
+  ASSERT_EQ(pq->PendingSize(), 2u);
+  mix_state = pq->NextMixerJob().value();
+  EXPECT_EQ(mix_state.target, payload_start_ + 2 * kBytesPerPacket + 5 * kBytesPerFrame);
+  EXPECT_EQ(mix_state.frames, 5u);
+  EXPECT_EQ(mix_state.capture_timestamp, 1'000'000 + zx::sec(20).get() / kFrameRate);
+}
+
 TEST_F(CapturePacketQueueTest, Preallocated_DiscardedMix) {
   CreateMapper(20);
   auto result = CapturePacketQueue::CreatePreallocated(payload_buffer_, kFormat, 10);
@@ -74,6 +74,7 @@ DriverOutput::DriverOutput(const std::string& name, const DeviceConfig& config,
                            EffectsLoaderV2* effects_loader_v2)
     : AudioOutput(name, config, threading_model, registry, link_matrix, clock_factory,
                   effects_loader_v2, std::make_unique<AudioDriver>(this)),
+      mix_profile_config_(mix_profile_config),
       low_water_duration_(mix_profile_config.period),
       high_water_duration_(low_water_duration_ + mix_profile_config.period),
       initial_stream_channel_(channel.TakeChannel()) {}
@@ -252,7 +253,13 @@ std::optional<AudioOutput::FrameSpan> DriverOutput::StartMixJob(zx::time ref_tim
   // should give us this number.
   int64_t frames_in_flight = frames_sent_ - output_frames_transmitted;
   FX_DCHECK((frames_in_flight >= 0) && (frames_in_flight <= rb.frames()));
-  FX_DCHECK(frames_sent_ <= fill_target);
+
+  // After switching to the low-latency period we can be further ahead than the new high water
+  // mark. Skip mixing until the safe write position catches up.
+  if (frames_sent_ > fill_target) {
+    ScheduleNextLowWaterWakeup();
+    return std::nullopt;
+  }
   int64_t desired_frames = fill_target - frames_sent_;
 
   // If we woke up too early to have any work to do, just get out now.
@@ -372,6 +379,42 @@ void DriverOutput::ScheduleNextLowWaterWakeup() {
   SetNextSchedTimeMono(low_water_mono_time);
 }
 
+void DriverOutput::SetMixPeriod(zx::duration period) {
+  TRACE_DURATION("audio", "DriverOutput::SetMixPeriod", "period", period.get());
+  low_water_duration_ = period;
+  high_water_duration_ = low_water_duration_ + period;
+
+  if (state_ == State::Started) {
+    low_water_frames_ = FramesPerRefTick().Scale(low_water_duration_.get());
+  }
+  // Before the driver is configured, OnDriverConfigComplete computes the presentation delay.
+  if (state_ == State::Starting || state_ == State::Started) {
+    UpdatePresentationDelay(driver()->external_delay() + driver()->fifo_depth_duration() +
+                            high_water_duration_);
+  }
+}
+
+void DriverOutput::SetLowLatency(bool low_latency) {
+  TRACE_DURATION("audio", "DriverOutput::SetLowLatency", "low_latency", low_latency);
+  if (!mix_profile_config_.low_latency_enabled()) {
+    return;
+  }
+  // Mixing more often than the mix thread is scheduled would only cause underflows. When leaving
+  // low-latency mode, restore the regular period even if restoring the profile fails.
+  if (!threading_model().SetMixDomainLowLatency(mix_domain(), low_latency) && low_latency) {
+    return;
+  }
+
+  FX_LOGS(INFO) << "Output " << this << (low_latency ? " entering" : " leaving")
+                << " low-latency mode";
+  reporter().SetLowLatency(low_latency);
+  mix_domain().PostTask([this, low_latency]() {
+    OBTAIN_EXECUTION_DOMAIN_TOKEN(token, &mix_domain());
+    SetMixPeriod(low_latency ? mix_profile_config_.low_latency_period
+                             : mix_profile_config_.period);
+  });
+}
+
 void DriverOutput::OnDriverInfoFetched() {
   TRACE_DURATION("audio", "DriverOutput::OnDriverInfoFetched");
   auto cleanup = fit::defer([this]() FXL_NO_THREAD_SAFETY_ANALYSIS {
@@ -401,7 +444,7 @@ void DriverOutput::OnDriverInfoFetched() {
   uint32_t pref_chan = static_cast<uint32_t>(pipeline_format.channels());
   AudioSampleFormat pref_fmt = kDefaultAudioFmt;
   zx::duration min_rb_duration =
-      high_water_duration_ + kDefaultMaxRetentionNsec + kDefaultRetentionGapNsec;
+      2 * mix_profile_config_.period + kDefaultMaxRetentionNsec + kDefaultRetentionGapNsec;
 
   res = driver()->SelectBestFormat(&pref_fps, &pref_chan, &pref_fmt);
 
@@ -55,6 +55,9 @@ class DriverOutput : public AudioOutput {
 
   zx::duration MixDeadline() const override { return high_water_duration_ - low_water_duration_; }
 
+  // Mixes with |MixProfileConfig::low_latency_period| while |low_latency| is true, if configured.
+  void SetLowLatency(bool low_latency) override;
+
   // AudioDevice implementation
   void ApplyGainLimits(fuchsia::media::AudioGainInfo* in_out_info,
                        fuchsia::media::AudioGainValidFlags set_flags) override;
@@ -80,6 +83,9 @@ class DriverOutput : public AudioOutput {
 
   void ScheduleNextLowWaterWakeup() FXL_EXCLUSIVE_LOCKS_REQUIRED(mix_domain().token());
 
+  // Moves the water marks to be one and two |period|s ahead of the safe write position.
+  void SetMixPeriod(zx::duration period) FXL_EXCLUSIVE_LOCKS_REQUIRED(mix_domain().token());
+
   // Callbacks triggered by our driver object as it completes various
   // asynchronous tasks.
   void OnDriverInfoFetched() override FXL_EXCLUSIVE_LOCKS_REQUIRED(mix_domain().token());
@@ -96,6 +102,11 @@ class DriverOutput : public AudioOutput {
   // enough mixed data from its upstream pipeline to fill the ring buffer to the "high-water" level.
   // It can take as long as an entire mix profile period for the thread to be scheduled and mix the
   // needed audio into the ring buffer.
+  //
+  // While a low-latency renderer is linked, both move closer to the safe write position, using the
+  // shorter |MixProfileConfig::low_latency_period|. The ring buffer is always sized for the
+  // regular period.
+  const MixProfileConfig mix_profile_config_;
   zx::duration low_water_duration_;
   zx::duration high_water_duration_;
 
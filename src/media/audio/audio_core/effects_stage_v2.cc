@@ -392,7 +392,7 @@ EffectsStageV2::EffectsStageV2(fuchsia_audio_effects::wire::ProcessorConfigurati
       max_frames_per_call_(config.max_frames_per_call()),
       block_size_frames_(config.block_size_frames()),
       output_shift_frames_(config.outputs()[0].latency_frames()),
-      source_buffer_(source_->format(), max_frames_per_call_) {
+      source_buffer_(source_->format(), fidl_buffers_.input, max_frames_per_call_) {
   // Initialize our lead time. Passing 0 here will resolve to our effect's lead time
   // not counting the impact of any downstream processors.
   SetPresentationDelay(zx::duration(0));
@@ -535,9 +535,8 @@ void EffectsStageV2::CallProcess(ReadLockContext& ctx, StreamUsageMask source_us
   options.set_usage_mask_per_input(
       fidl::ObjectView<fidl::VectorView<uint32_t>>::FromExternal(&usage_mask_vector));
 
-  // The source data needs to be copied into the pre-negotiated input buffer.
-  memmove(fidl_buffers_.input, source_buffer_.payload(),
-          source_buffer_.length() * static_cast<int64_t>(source_->format().bytes_per_frame()));
+  // The source data was read directly into the pre-negotiated input buffer.
+  FX_DCHECK(source_buffer_.payload() == fidl_buffers_.input);
 
   // Synchronous IPC.
   StageMetricsTimer timer("EffectsStageV2::Process");
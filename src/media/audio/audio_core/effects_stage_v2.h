@@ -105,6 +105,8 @@ class EffectsStageV2 : public ReadableStream {
   std::optional<Cache> cache_;
 
   // This is non-empty iff cache_ != std::nullopt.
+  // Backed by fidl_buffers_.input, so the effect reads source frames without another copy. If the
+  // effect processes in-place, the processed frames overwrite the source frames.
   ReusableBuffer source_buffer_;
 
   // Buffer holding one pair of encoded FIDL Process request and response message.
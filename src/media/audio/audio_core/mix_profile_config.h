@@ -26,6 +26,28 @@ struct MixProfileConfig {
 
   // Mix profile period.
   zx::duration period = kDefaultPeriod;
+
+  // Mix period used by outputs while a low-latency renderer is playing to them. Zero disables
+  // low-latency mode.
+  zx::duration low_latency_period = zx::duration(0);
+
+  bool low_latency_enabled() const {
+    return low_latency_period > zx::duration(0) && low_latency_period < period;
+  }
+
+  // Returns the profile used for mixing with |low_latency_period|. Capacity and deadline scale
+  // with the period, so the mix thread gets the same share of the CPU, in smaller slices.
+  MixProfileConfig LowLatency() const {
+    if (!low_latency_enabled()) {
+      return *this;
+    }
+    return {
+        .capacity = capacity * low_latency_period.get() / period.get(),
+        .deadline = deadline * low_latency_period.get() / period.get(),
+        .period = low_latency_period,
+        .low_latency_period = low_latency_period,
+    };
+  }
 };
 
 }  // namespace media::audio
@@ -29,37 +29,65 @@ PacketQueue::PacketQueue(Format format, fbl::RefPtr<VersionedTimelineFunction> t
 
 void PacketQueue::PushPacket(const fbl::RefPtr<Packet>& packet) {
   TRACE_DURATION("audio", "PacketQueue::PushPacket");
-  std::lock_guard<std::mutex> locker(pending_mutex_);
-  pending_packet_queue_.push_back({
-      .packet = packet,
-      .seen_in_read_lock = false,
-  });
+  packet_count_.fetch_add(1, std::memory_order_acq_rel);
+  commands_.Push(Command{.packet = packet});
 }
 
 void PacketQueue::Flush(const fbl::RefPtr<PendingFlushToken>& flush_token) {
   TRACE_DURATION("audio", "PacketQueue::Flush");
-  std::lock_guard<std::mutex> locker(pending_mutex_);
+  commands_.Push(Command{.is_flush = true, .flush_token = flush_token});
+  unprocessed_flush_count_.fetch_add(1);
+
+  // Is the sink currently mixing? If so, the flush cannot complete until the mix operation has
+  // finished. The sink's thread will process the flush, releasing the 'waiting to be rendered'
+  // packets and then our flush token (if any), when it has finished its current job. Otherwise we
+  // can release them right away.
+  if (TryAcquireConsumer()) {
+    ProcessCommands();
+    ReleaseConsumer();
+  }
+}
 
-  if (read_lock_in_progress_) {
-    // Is the sink currently mixing? If so, the flush cannot complete until the mix operation has
-    // finished. Move the 'waiting to be rendered' packets to the back of the 'waiting to be
-    // flushed queue', and append our flush token (if any) to the pending flush token queue. The
-    // sink's thread will take care of releasing these objects back to the service thread for
-    // cleanup when it has finished its current job.
-    for (auto& pp : pending_packet_queue_) {
-      pending_flush_packet_queue_.emplace_back(std::move(pp.packet));
-    }
-    if (flush_token != nullptr) {
-      pending_flush_token_queue_.emplace_back(flush_token);
-    }
-  } else {
-    // Release packets in order.
-    FX_CHECK(pending_flush_packet_queue_.empty());
-    FX_CHECK(pending_flush_token_queue_.empty());
-    for (auto& pp : pending_packet_queue_) {
-      pp.packet = nullptr;
+bool PacketQueue::TryAcquireConsumer() {
+  bool expected = false;
+  return consumer_owned_.compare_exchange_strong(expected, true);
+}
+
+void PacketQueue::ReleaseConsumer() {
+  consumer_owned_.store(false);
+
+  // A flush may have been pushed after we last processed commands, but found the consumer side
+  // owned by us. If so, it's up to us to process it: nobody else might until the next mix job.
+  while (unprocessed_flush_count_.load() > 0 && TryAcquireConsumer()) {
+    ProcessCommands();
+    consumer_owned_.store(false);
+  }
+}
+
+void PacketQueue::ProcessCommands() {
+  FX_CHECK(!read_lock_in_progress_);
+
+  while (auto command = commands_.Pop()) {
+    if (!command->is_flush) {
+      pending_packet_queue_.push_back({
+          .packet = std::move(command->packet),
+          .seen_in_read_lock = false,
+      });
+      continue;
     }
+
+    // Release packets in order, then the flush token.
+    ReleasePendingPackets();
+    command->flush_token = nullptr;
+    unprocessed_flush_count_.fetch_sub(1);
   }
+}
+
+void PacketQueue::ReleasePendingPackets() {
+  for (auto& pp : pending_packet_queue_) {
+    pp.packet = nullptr;
+  }
+  packet_count_.fetch_sub(pending_packet_queue_.size(), std::memory_order_acq_rel);
 
   // Flush clears this queue.
   pending_packet_queue_.clear();
@@ -67,12 +95,16 @@ void PacketQueue::Flush(const fbl::RefPtr<PendingFlushToken>& flush_token) {
 
 std::optional<ReadableStream::Buffer> PacketQueue::ReadLockImpl(ReadLockContext& ctx, Fixed frame,
                                                                 int64_t frame_count) {
-  std::lock_guard<std::mutex> locker(pending_mutex_);
-
   if (read_lock_in_progress_) {
     FX_CHECK(false) << "PacketQueue::ReadLockImpl called while read lock still held";
   }
 
+  // If the FIDL thread is flushing, there is nothing to read: every packet we have is going away.
+  if (!TryAcquireConsumer()) {
+    return std::nullopt;
+  }
+  ProcessCommands();
+
   // Since ReadLock never goes backwards in time, we can safely trim packets before `frame`.
   // If the packet starts before the requested frame and has not been seen before, it underflowed.
   while (!pending_packet_queue_.empty()) {
@@ -84,11 +116,12 @@ std::optional<ReadableStream::Buffer> PacketQueue::ReadLockImpl(ReadLockContext&
       pp.seen_in_read_lock = true;
       break;
     }
-    pending_packet_queue_.pop_front();
+    PopPendingPacket();
   }
 
   // Skip if there are no packets
   if (pending_packet_queue_.empty()) {
+    ReleaseConsumer();
     return std::nullopt;
   }
 
@@ -102,9 +135,11 @@ std::optional<ReadableStream::Buffer> PacketQueue::ReadLockImpl(ReadLockContext&
   };
   auto isect = IntersectPacket(format(), frag, frame, frame_count);
   if (!isect) {
+    ReleaseConsumer();
     return std::nullopt;
   }
 
+  // We keep the consumer side until ReadUnlock, so that the packet can't be flushed in the meantime.
   read_lock_in_progress_ = true;
 
   // Don't use a cached buffer. We don't need caching since we don't generate any
@@ -128,34 +163,38 @@ std::optional<ReadableStream::Buffer> PacketQueue::ReadLockImpl(ReadLockContext&
 }
 
 void PacketQueue::ReadUnlock() {
-  std::lock_guard<std::mutex> locker(pending_mutex_);
-
   FX_CHECK(read_lock_in_progress_);
   read_lock_in_progress_ = false;
 
-  // Did a flush take place while we were working?  If so release each of the packets waiting to
-  // be flushed back to the service thread, then release each of the flush tokens.
-  for (auto& ptr : pending_flush_packet_queue_) {
-    ptr = nullptr;
-  }
-  for (auto& ptr : pending_flush_token_queue_) {
-    ptr = nullptr;
-  }
-  pending_flush_packet_queue_.clear();
-  pending_flush_token_queue_.clear();
+  // Did a flush take place while we were working? If so, it's waiting in `commands_`.
+  ProcessCommands();
+  ReleaseConsumer();
 }
 
 void PacketQueue::TrimImpl(Fixed frame) {
-  std::lock_guard<std::mutex> locker(pending_mutex_);
-
-  // Release packets that end before our trim position.
-  while (!pending_packet_queue_.empty()) {
-    auto packet = pending_packet_queue_.front().packet;
-    if (packet->end() > frame) {
+  // When a buffer is unlocked, we are trimmed before ReadUnlock, so we own the consumer side
+  // already. Otherwise, if the FIDL thread is flushing, there's nothing left to trim.
+  const bool in_read_lock = read_lock_in_progress_;
+  if (!in_read_lock) {
+    if (!TryAcquireConsumer()) {
       return;
     }
-    pending_packet_queue_.pop_front();
+    ProcessCommands();
+  }
+
+  // Release packets that end before our trim position.
+  while (!pending_packet_queue_.empty() && pending_packet_queue_.front().packet->end() <= frame) {
+    PopPendingPacket();
   }
+
+  if (!in_read_lock) {
+    ReleaseConsumer();
+  }
+}
+
+void PacketQueue::PopPendingPacket() {
+  pending_packet_queue_.pop_front();
+  packet_count_.fetch_sub(1, std::memory_order_acq_rel);
 }
 
 BaseStream::TimelineFunctionSnapshot PacketQueue::ref_time_to_frac_presentation_frame() const {
@@ -5,23 +5,26 @@
 #ifndef SRC_MEDIA_AUDIO_AUDIO_CORE_PACKET_QUEUE_H_
 #define SRC_MEDIA_AUDIO_AUDIO_CORE_PACKET_QUEUE_H_
 
+#include <atomic>
 #include <deque>
 #include <memory>
-#include <mutex>
 
 #include <fbl/ref_counted.h>
 #include <fbl/ref_ptr.h>
 
-#include "src/lib/fxl/synchronization/thread_annotations.h"
 #include "src/media/audio/audio_core/clock.h"
 #include "src/media/audio/audio_core/packet.h"
 #include "src/media/audio/audio_core/pending_flush_token.h"
 #include "src/media/audio/audio_core/stream.h"
 #include "src/media/audio/audio_core/versioned_timeline_function.h"
 #include "src/media/audio/lib/format/format.h"
+#include "src/media/lib/mpsc_queue/mpsc_queue.h"
 
 namespace media::audio {
 
+// Packets are pushed and flushed by the FIDL thread, and read by the mix thread. The two threads
+// never share a lock: the FIDL thread hands packets and flushes over through a lock-free queue, so
+// that a mix job never waits on client activity.
 class PacketQueue : public ReadableStream {
  public:
   PacketQueue(Format format, std::shared_ptr<Clock> audio_clock);
@@ -29,10 +32,7 @@ class PacketQueue : public ReadableStream {
               fbl::RefPtr<VersionedTimelineFunction> ref_time_to_frac_presentation_frame,
               std::shared_ptr<Clock> audio_clock);
 
-  bool empty() const {
-    std::lock_guard<std::mutex> locker(pending_mutex_);
-    return pending_packet_queue_.empty();
-  }
+  bool empty() const { return packet_count_.load(std::memory_order_acquire) == 0; }
 
   void set_usage(const StreamUsage& usage) {
     usage_mask_.clear();
@@ -59,40 +59,61 @@ class PacketQueue : public ReadableStream {
   void TrimImpl(Fixed frame) override;
   void ReadUnlock() override;
 
-  void ReportUnderflow(const fbl::RefPtr<Packet>& packet, Fixed underflow_frames)
-      FXL_REQUIRE(pending_mutex_);
+  void ReportUnderflow(const fbl::RefPtr<Packet>& packet, Fixed underflow_frames);
 
-  StreamUsageMask usage_mask_;
+  // A packet pushed by the FIDL thread or, if `is_flush`, a flush of every packet pushed before it.
+  struct Command {
+    fbl::RefPtr<Packet> packet;
+    bool is_flush = false;
+    fbl::RefPtr<PendingFlushToken> flush_token;
+  };
+
+  // `pending_packet_queue_`, `read_lock_in_progress_` and `underflow_count_` belong to whichever
+  // thread owns the consumer side of `commands_`. That is usually the mix thread, from
+  // `ReadLockImpl` until `ReadUnlock`, or for a `TrimImpl`. When the mix thread doesn't own it,
+  // `Flush` takes it over to complete the flush immediately.
+  //
+  // The mix thread never waits for the FIDL thread: if `Flush` owns the consumer side, a
+  // concurrent `ReadLockImpl` returns no data, as whatever it could read is being flushed.
+  bool TryAcquireConsumer();
+  void ReleaseConsumer();
+
+  // Applies every queued command to `pending_packet_queue_`. Must own the consumer side, and must
+  // not be in a read lock, as that would flush the locked packet.
+  void ProcessCommands();
 
-  mutable std::mutex pending_mutex_;
+  // Releases the first packet in `pending_packet_queue_`, or every packet in it.
+  void PopPendingPacket();
+  void ReleasePendingPackets();
+
+  StreamUsageMask usage_mask_;
 
   struct PendingPacket {
     fbl::RefPtr<Packet> packet;
     bool seen_in_read_lock = false;
   };
 
-  // New packets go on `pending_packet_queue_`.
+  // New packets and flushes go on `commands_`, in order.
   //
   // If a Flush happens while a ReadLock is held, then a downstream stage has a
   // non-reference-counted pointer to the first packet in `pending_packet_queue_`.
-  // We can't flush that packet until the ReadLock is released.
-  //
-  // Hence, if Flush happens while in a ReadLock, we move all pending packets to
-  // `pending_flush_packet_queue_` and add a flush token to `pending_flush_token_queue_`.
-  // After the ReadLock is released, we remove all packets and flush tokens from these
-  // queues. Each `PendingFlushToken` completes a DiscardAllPackets FIDL call when the
-  // token is destructed, so as each token is removed from the queue, a DiscardAllPackets
-  // FIDL call is completed.
+  // We can't flush that packet until the ReadLock is released, so the flush waits in
+  // `commands_` until ReadUnlock. Each `PendingFlushToken` completes a DiscardAllPackets FIDL call
+  // when the token is destructed, after every packet pushed before it has been released.
   //
-  // If a Flush happens while a ReadLock is not held, it can be serviced immediately; the
-  // pending flush queues are not used.
-  std::deque<PendingPacket> pending_packet_queue_ FXL_GUARDED_BY(pending_mutex_);
-  std::deque<fbl::RefPtr<Packet>> pending_flush_packet_queue_ FXL_GUARDED_BY(pending_mutex_);
-  std::deque<fbl::RefPtr<PendingFlushToken>> pending_flush_token_queue_
-      FXL_GUARDED_BY(pending_mutex_);
-  bool read_lock_in_progress_ FXL_GUARDED_BY(pending_mutex_) = false;
-
-  size_t underflow_count_ FXL_GUARDED_BY(pending_mutex_) = {0};
+  // If a Flush happens while a ReadLock is not held, it is serviced immediately by the FIDL thread.
+  MpscQueue<Command> commands_;
+  std::atomic<bool> consumer_owned_{false};
+  // The number of flushes pushed onto `commands_` which haven't been processed yet. May briefly be
+  // negative, as a flush can be processed before `Flush` counts it.
+  std::atomic<int64_t> unprocessed_flush_count_{0};
+  // The number of packets which have been pushed and not released yet, for `empty`.
+  std::atomic<size_t> packet_count_{0};
+
+  std::deque<PendingPacket> pending_packet_queue_;
+  bool read_lock_in_progress_ = false;
+
+  size_t underflow_count_ = {0};
   fit::function<void(zx::duration)> underflow_reporter_;
 
   fbl::RefPtr<VersionedTimelineFunction> timeline_function_;
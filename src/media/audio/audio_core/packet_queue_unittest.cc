@@ -4,8 +4,16 @@
 
 #include "src/media/audio/audio_core/packet_queue.h"
 
+#include <lib/async-loop/cpp/loop.h>
+#include <lib/async-loop/default.h>
+#include <lib/async/cpp/task.h>
 #include <lib/syslog/cpp/macros.h>
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <thread>
 #include <unordered_map>
 
 #include <fbl/ref_ptr.h>
@@ -40,6 +48,18 @@ class PacketQueueTest : public gtest::TestLoopFixture {
 
   fbl::RefPtr<Packet> CreatePacket(uint32_t payload_buffer_id, int64_t start = 0,
                                    uint32_t length = 0) {
+    auto callback = [this, payload_buffer_id] {
+      ++released_packet_count_;
+      released_packets_.push_back(payload_buffer_id);
+    };
+    return CreatePacket(payload_buffer_id, start, length, dispatcher(), std::move(callback));
+  }
+
+  // Like the above, but the release of the packet is reported to `callback` on
+  // `callback_dispatcher` instead of to `released_packets()`.
+  fbl::RefPtr<Packet> CreatePacket(uint32_t payload_buffer_id, int64_t start, uint32_t length,
+                                   async_dispatcher_t* callback_dispatcher,
+                                   fit::closure callback) {
     auto it = payload_buffers_.find(payload_buffer_id);
     if (it == payload_buffers_.end()) {
       auto vmo_mapper = fbl::MakeRefCounted<RefCountedVmoMapper>();
@@ -53,11 +73,8 @@ class PacketQueueTest : public gtest::TestLoopFixture {
       FX_CHECK(result.second);
       it = result.first;
     }
-    auto callback = [this, payload_buffer_id] {
-      ++released_packet_count_;
-      released_packets_.push_back(payload_buffer_id);
-    };
-    return allocator_.New(it->second, 0, length, Fixed(start), dispatcher(), callback);
+    return allocator_.New(it->second, 0, length, Fixed(start), callback_dispatcher,
+                          std::move(callback));
   }
 
   std::vector<int64_t> released_packets() const { return released_packets_; }
@@ -525,5 +542,63 @@ TEST_F(PacketQueueTest, ReportUnderflow) {
   EXPECT_TRUE(packet_queue->empty());
 }
 
+// Pushes and flushes packets on one thread while reading them on another, like the FIDL and mix
+// threads do, and checks that every packet is released exactly once, and read at most once.
+TEST_F(PacketQueueTest, ConcurrentPushFlushAndRead) {
+  async::Loop release_loop(&kAsyncLoopConfigNoAttachToCurrentThread);
+  ASSERT_EQ(release_loop.StartThread("packet-release"), ZX_OK);
+  auto packet_queue = CreatePacketQueue();
+
+  constexpr size_t kPackets = 10'000;
+  constexpr size_t kPacketsPerFlush = 7;
+  constexpr int64_t kPacketFrames = 10;
+  std::vector<std::atomic<uint32_t>> release_counts(kPackets);
+  std::atomic<size_t> flush_count = 0;
+  std::atomic<size_t> released_flush_count = 0;
+  std::atomic<int64_t> pushed_frames = 0;
+
+  std::thread fidl_thread([&] {
+    for (size_t i = 0; i < kPackets; ++i) {
+      packet_queue->PushPacket(CreatePacket(0, static_cast<int64_t>(i) * kPacketFrames,
+                                            kPacketFrames, release_loop.dispatcher(),
+                                            [&release_counts, i] { ++release_counts[i]; }));
+      pushed_frames.store(static_cast<int64_t>(i + 1) * kPacketFrames);
+      if (i % kPacketsPerFlush == kPacketsPerFlush - 1) {
+        ++flush_count;
+        packet_queue->Flush(PendingFlushToken::Create(
+            release_loop.dispatcher(), [&released_flush_count] { ++released_flush_count; }));
+      }
+    }
+  });
+
+  // The mix thread never reads ahead of the packets pushed so far, so that packets are read rather
+  // than trimmed as having underflowed.
+  std::vector<int64_t> read_starts;
+  for (int64_t frame = 0; frame < static_cast<int64_t>(kPackets) * kPacketFrames;) {
+    if (frame + kPacketFrames > pushed_frames.load()) {
+      std::this_thread::yield();
+      continue;
+    }
+    if (auto buffer = packet_queue->ReadLock(rlctx, Fixed(frame), kPacketFrames)) {
+      read_starts.push_back(buffer->start().Floor());
+    }
+    frame += kPacketFrames;
+  }
+  fidl_thread.join();
+  packet_queue = nullptr;
+
+  // Wait for the release callbacks, which were all posted before this task.
+  std::promise<void> released;
+  async::PostTask(release_loop.dispatcher(), [&released] { released.set_value(); });
+  released.get_future().wait();
+
+  for (size_t i = 0; i < kPackets; ++i) {
+    EXPECT_EQ(release_counts[i].load(), 1u) << "packet " << i;
+  }
+  EXPECT_EQ(released_flush_count.load(), flush_count.load());
+  EXPECT_EQ(std::adjacent_find(read_starts.begin(), read_starts.end(), std::greater_equal<>()),
+            read_starts.end());
+}
+
 }  // namespace
 }  // namespace media::audio
@@ -54,7 +54,8 @@ ProcessConfigBuilder& ProcessConfigBuilder::SetMixProfile(MixProfileConfig mix_p
   FX_LOGS(INFO) << "Setting a custom MixProfile: capacity_usec "
                 << mix_profile_config.capacity.to_usecs() << "; deadline_usec "
                 << mix_profile_config.deadline.to_usecs() << "; period_usec "
-                << mix_profile_config.period.to_usecs();
+                << mix_profile_config.period.to_usecs() << "; low_latency_period_usec "
+                << mix_profile_config.low_latency_period.to_usecs();
   return *this;
 }
 
@@ -30,6 +30,7 @@ constexpr char kJsonKeyMixProfile[] = "mix_profile";
 constexpr char kJsonKeyMixProfileCapacityUsec[] = "capacity_usec";
 constexpr char kJsonKeyMixProfileDeadlineUsec[] = "deadline_usec";
 constexpr char kJsonKeyMixProfilePeriodUsec[] = "period_usec";
+constexpr char kJsonKeyMixProfileLowLatencyPeriodUsec[] = "low_latency_period_usec";
 constexpr char kJsonKeyVolumeCurve[] = "volume_curve";
 constexpr char kJsonKeyPipeline[] = "pipeline";
 constexpr char kJsonKeyLib[] = "lib";
@@ -102,6 +103,11 @@ MixProfileConfig ParseMixProfileFromJsonObject(const rapidjson::Value& value) {
     FX_CHECK(it->value.IsUint());
     mix_profile_config.period = zx::usec(it->value.GetUint());
   }
+  if (const auto it = value.FindMember(kJsonKeyMixProfileLowLatencyPeriodUsec);
+      it != value.MemberEnd()) {
+    FX_CHECK(it->value.IsUint());
+    mix_profile_config.low_latency_period = zx::usec(it->value.GetUint());
+  }
   return mix_profile_config;
 }
 
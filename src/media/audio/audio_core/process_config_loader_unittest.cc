@@ -72,7 +72,8 @@ TEST(ProcessConfigLoaderTest, LoadProcessConfigWithMixProfile) {
     "mix_profile": {
         "capacity_usec": 1000,
         "deadline_usec": 2000,
-        "period_usec": 3000
+        "period_usec": 3000,
+        "low_latency_period_usec": 1000
     },
     "volume_curve": [
       {
@@ -94,6 +95,10 @@ TEST(ProcessConfigLoaderTest, LoadProcessConfigWithMixProfile) {
   EXPECT_EQ(config.mix_profile_config().capacity.to_usecs(), 1000);
   EXPECT_EQ(config.mix_profile_config().deadline.to_usecs(), 2000);
   EXPECT_EQ(config.mix_profile_config().period.to_usecs(), 3000);
+  EXPECT_EQ(config.mix_profile_config().low_latency_period.to_usecs(), 1000);
+  EXPECT_EQ(config.mix_profile_config().LowLatency().capacity.to_usecs(), 333);
+  EXPECT_EQ(config.mix_profile_config().LowLatency().deadline.to_usecs(), 666);
+  EXPECT_EQ(config.mix_profile_config().LowLatency().period.to_usecs(), 1000);
   EXPECT_FLOAT_EQ(config.default_volume_curve().VolumeToDb(0.0), -160.0);
   EXPECT_FLOAT_EQ(config.default_volume_curve().VolumeToDb(1.0), 0.0);
 }
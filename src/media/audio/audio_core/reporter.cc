@@ -6,6 +6,7 @@
 #include <lib/sys/component/cpp/service_client.h>
 #include <lib/syslog/cpp/macros.h>
 
+#include <atomic>
 #include <memory>
 #include <queue>
 #include <vector>
@@ -81,6 +82,7 @@ class OutputDeviceNop : public Reporter::OutputDevice {
                    fuchsia::media::AudioGainValidFlags set_flags) override {}
   void DeviceUnderflow(zx::time start_time, zx::time end_time) override {}
   void PipelineUnderflow(zx::time start_time, zx::time end_time) override {}
+  void SetLowLatency(bool low_latency) override {}
 };
 
 class InputDeviceNop : public Reporter::InputDevice {
@@ -672,7 +674,12 @@ class Reporter::OutputDeviceImpl : public Reporter::OutputDevice {
                 .is_underflow = true,
                 .cobalt_component_id =
                     AudioSessionDurationMigratedMetricDimensionComponent::OutputPipeline,
-            })) {
+            })),
+        low_latency_node_(node_.CreateChild("low latency")),
+        low_latency_(low_latency_node_.CreateBool("active", false)),
+        low_latency_count_(low_latency_node_.CreateUint("count", 0)),
+        low_latency_device_underflows_(low_latency_node_.CreateUint("device underflows", 0)),
+        low_latency_pipeline_underflows_(low_latency_node_.CreateUint("pipeline underflows", 0)) {
     time_since_death_ = node_.CreateLazyValues("OutputDeviceTimeSinceDeath", [this] {
       inspect::Inspector i;
       i.GetRoot().CreateUint(
@@ -703,10 +710,26 @@ class Reporter::OutputDeviceImpl : public Reporter::OutputDevice {
 
   void DeviceUnderflow(zx::time start_time, zx::time end_time) override {
     device_underflows_->Report(start_time, end_time);
+    if (is_low_latency_) {
+      low_latency_device_underflows_.Add(1);
+    }
   }
 
   void PipelineUnderflow(zx::time start_time, zx::time end_time) override {
     pipeline_underflows_->Report(start_time, end_time);
+    if (is_low_latency_) {
+      low_latency_pipeline_underflows_.Add(1);
+    }
+  }
+
+  void SetLowLatency(bool low_latency) override {
+    if (is_low_latency_.exchange(low_latency) == low_latency) {
+      return;
+    }
+    low_latency_.Set(low_latency);
+    if (low_latency) {
+      low_latency_count_.Add(1);
+    }
   }
 
  private:
@@ -717,6 +740,12 @@ class Reporter::OutputDeviceImpl : public Reporter::OutputDevice {
   DeviceGainInfo gain_info_;
   std::unique_ptr<OverflowUnderflowTracker> device_underflows_;
   std::unique_ptr<OverflowUnderflowTracker> pipeline_underflows_;
+  std::atomic<bool> is_low_latency_{false};
+  inspect::Node low_latency_node_;
+  inspect::BoolProperty low_latency_;
+  inspect::UintProperty low_latency_count_;
+  inspect::UintProperty low_latency_device_underflows_;
+  inspect::UintProperty low_latency_pipeline_underflows_;
   std::optional<zx::time> time_of_death_;
 };
 
@@ -79,6 +79,10 @@ class Reporter {
    public:
     virtual void DeviceUnderflow(zx::time start_time, zx::time end_time) = 0;
     virtual void PipelineUnderflow(zx::time start_time, zx::time end_time) = 0;
+
+    // Reports whether the device is mixing with the shorter low-latency period. Underflows are
+    // also counted separately while it is.
+    virtual void SetLowLatency(bool low_latency) = 0;
   };
 
   class InputDevice : public Device {};
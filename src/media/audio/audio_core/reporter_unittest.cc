@@ -243,7 +243,12 @@ TEST_F(ReporterTest, DeviceMetrics) {
                         NodeMatches(AllOf(NameMatches("pipeline underflows"),
                                           PropertyList(UnorderedElementsAre(
                                               UintIs("count", 0), UintIs("duration (ns)", 0),
-                                              UintIs("session count", 0))))))),
+                                              UintIs("session count", 0))))),
+                        NodeMatches(AllOf(NameMatches("low latency"),
+                                          PropertyList(UnorderedElementsAre(
+                                              BoolIs("active", false), UintIs("count", 0),
+                                              UintIs("device underflows", 0),
+                                              UintIs("pipeline underflows", 0))))))),
                     NodeMatches(
                         AllOf(NameMatches("output_device"),
                               PropertyList(UnorderedElementsAre(
@@ -304,6 +309,37 @@ TEST_F(ReporterTest, DeviceMetrics) {
           }))))))));
 }
 
+// Tests that underflows are also counted separately while an output device is in low-latency mode.
+TEST_F(ReporterTest, DeviceLowLatencyMetrics) {
+  auto output_device = under_test_.CreateOutputDevice("output_device", "output_thread");
+
+  output_device->StartSession(zx::time(0));
+  output_device->DeviceUnderflow(zx::time(10), zx::time(15));
+  output_device->SetLowLatency(true);
+  output_device->DeviceUnderflow(zx::time(25), zx::time(30));
+  output_device->PipelineUnderflow(zx::time(35), zx::time(40));
+  output_device->SetLowLatency(false);
+  output_device->PipelineUnderflow(zx::time(45), zx::time(50));
+  output_device->SetLowLatency(true);
+  output_device->SetLowLatency(true);
+  output_device->StopSession(zx::time(100));
+
+  EXPECT_THAT(GetHierarchy(),
+              ChildrenMatch(Contains(AllOf(
+                  NodeMatches(NameMatches("output devices")),
+                  ChildrenMatch(Contains(ChildrenMatch(IsSupersetOf({
+                      NodeMatches(AllOf(NameMatches("device underflows"),
+                                        PropertyList(Contains(UintIs("count", 2))))),
+                      NodeMatches(AllOf(NameMatches("pipeline underflows"),
+                                        PropertyList(Contains(UintIs("count", 2))))),
+                      NodeMatches(AllOf(NameMatches("low latency"),
+                                        PropertyList(UnorderedElementsAre(
+                                            BoolIs("active", true), UintIs("count", 2),
+                                            UintIs("device underflows", 1),
+                                            UintIs("pipeline underflows", 1))))),
+                  }))))))));
+}
+
 // Tests method Device::SetGainInfo.
 TEST_F(ReporterTest, DeviceSetGainInfo) {
   auto output_device = under_test_.CreateOutputDevice("output_device", "output_thread");
@@ -4,14 +4,26 @@
 
 #include "src/media/audio/audio_core/reusable_buffer.h"
 
+#include <string.h>
+
 namespace media::audio {
 
 ReusableBuffer::ReusableBuffer(const Format& format, int64_t capacity_frames)
     : capacity_frames_(capacity_frames),
       format_(format),
-      output_producer_(OutputProducer::Select(format.stream_type())) {
+      output_producer_(OutputProducer::Select(format.stream_type())),
+      owned_buf_(format_.bytes_per_frame() * capacity_frames),
+      buf_(owned_buf_.data()) {
+  FX_CHECK(capacity_frames > 0);
+}
+
+ReusableBuffer::ReusableBuffer(const Format& format, void* storage, int64_t capacity_frames)
+    : capacity_frames_(capacity_frames),
+      format_(format),
+      output_producer_(OutputProducer::Select(format.stream_type())),
+      buf_(static_cast<char*>(storage)) {
   FX_CHECK(capacity_frames > 0);
-  buf_.reserve(format_.bytes_per_frame() * capacity_frames);
+  FX_CHECK(storage);
 }
 
 void ReusableBuffer::Reset(Fixed start_frame) {
@@ -19,7 +31,7 @@ void ReusableBuffer::Reset(Fixed start_frame) {
       << ffl::String::DecRational << "buffer cannot have fractional position " << start_frame;
 
   start_ = start_frame;
-  buf_.clear();
+  size_bytes_ = 0;
 }
 
 void ReusableBuffer::Append(Fixed new_payload_start, int64_t new_payload_frames, void* new_payload,
@@ -48,17 +60,17 @@ void ReusableBuffer::Append(Fixed new_payload_start, int64_t new_payload_frames,
   }
 
   if (new_payload) {
-    char* src = reinterpret_cast<char*>(new_payload);
-    buf_.insert(buf_.end(), src, src + new_payload_frames * format_.bytes_per_frame());
+    const int64_t bytes = new_payload_frames * format_.bytes_per_frame();
+    memcpy(buf_ + size_bytes_, new_payload, bytes);
+    size_bytes_ += bytes;
   } else {
     PushSilence(new_payload_frames);
   }
 }
 
 void ReusableBuffer::PushSilence(int64_t frames) {
-  auto first_byte = buf_.size();
-  buf_.resize(buf_.size() + frames * format_.bytes_per_frame());
-  output_producer_->FillWithSilence(&buf_[first_byte], frames);
+  output_producer_->FillWithSilence(buf_ + size_bytes_, frames);
+  size_bytes_ += frames * format_.bytes_per_frame();
 }
 
 }  // namespace media::audio
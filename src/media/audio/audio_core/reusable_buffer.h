@@ -28,7 +28,9 @@ namespace media::audio {
 //
 // The buffer is initially empty. Audio data can be appended up to a specified capacity.
 // The buffer can be cleared for reuse. The capacity is preallocated by the constructor,
-// after which there are no further allocations.
+// after which there are no further allocations. Alternatively, the buffer can be backed
+// by caller-owned storage, such as a VMO shared with another process, so that appended
+// data does not need to be copied again.
 //
 // All frames must be aligned on integral positions. Despite this integral requirement,
 // method calls represent frame positions with Fixed numbers for consistency with other
@@ -37,6 +39,10 @@ class ReusableBuffer {
  public:
   ReusableBuffer(const Format& format, int64_t capacity_frames);
 
+  // Uses `storage` instead of allocating. `storage` must hold at least `capacity_frames`
+  // frames and must outlive this buffer.
+  ReusableBuffer(const Format& format, void* storage, int64_t capacity_frames);
+
   // No copying or moving.
   ReusableBuffer(const ReusableBuffer&) = delete;
   ReusableBuffer& operator=(const ReusableBuffer&) = delete;
@@ -55,10 +61,10 @@ class ReusableBuffer {
   Fixed end() const { return start() + Fixed(length()); }
 
   // Reports the total number of frames appended to the buffer since the last `Reset()`.
-  int64_t length() const { return static_cast<int64_t>(buf_.size()) / format_.bytes_per_frame(); }
+  int64_t length() const { return size_bytes_ / format_.bytes_per_frame(); }
 
   // Reports whether the buffer is empty.
-  bool empty() const { return buf_.empty(); }
+  bool empty() const { return size_bytes_ == 0; }
 
   // Reports the maximum capacity of this buffer, in frames.
   int64_t capacity() const { return capacity_frames_; }
@@ -68,11 +74,8 @@ class ReusableBuffer {
   //
   // REQUIRES: the buffer is not empty.
   void* payload() {
-    // This is required because of a technicality: although std::vector::reserve() allocates
-    // storage for the vector, index operations like buf_[x] technically have undefined behavior
-    // when x > buf_.size(), despite this preallocation.
     FX_CHECK(!empty());
-    return &buf_[0];
+    return buf_;
   }
 
   // Reports the payload's format.
@@ -115,7 +118,9 @@ class ReusableBuffer {
   const std::unique_ptr<OutputProducer> output_producer_;
 
   std::optional<Fixed> start_;  // first frame in this buffer, or nullopt if not Reset
-  std::vector<char> buf_;
+  std::vector<char> owned_buf_;  // empty if the storage is owned by the caller
+  char* const buf_;
+  int64_t size_bytes_ = 0;
 };
 
 }  // namespace media::audio
@@ -186,4 +186,29 @@ TEST(ReusableBufferTest, AppendResetAppend) {
   }
 }
 
+TEST(ReusableBufferTest, AppendToExternalStorage) {
+  std::vector<int16_t> storage(10, -1);
+  ReusableBuffer buffer(kFormatOneChan, storage.data(), 8);
+  std::vector<int16_t> payload{1, 2, 3};
+
+  EXPECT_EQ(buffer.capacity(), 8);
+  EXPECT_TRUE(buffer.empty());
+
+  buffer.Reset(Fixed(10));
+  buffer.AppendData(Fixed(10), payload.size(), &payload[0]);
+  buffer.AppendData(Fixed(15), payload.size(), &payload[0]);
+  EXPECT_EQ(buffer.start(), Fixed(10)) << "start = " << ffl::String(buffer.start()).c_str();
+  EXPECT_EQ(buffer.end(), Fixed(18)) << "end = " << ffl::String(buffer.end()).c_str();
+  EXPECT_EQ(buffer.length(), 8);
+  EXPECT_EQ(buffer.payload(), storage.data());
+  EXPECT_EQ(storage, (std::vector<int16_t>{1, 2, 3, 0, 0, 1, 2, 3, -1, -1}));
+
+  // Reset reuses the same storage.
+  buffer.Reset(Fixed(0));
+  EXPECT_TRUE(buffer.empty());
+  buffer.AppendSilence(Fixed(0), 2);
+  EXPECT_EQ(buffer.payload(), storage.data());
+  EXPECT_EQ(storage, (std::vector<int16_t>{0, 0, 3, 0, 0, 1, 2, 3, -1, -1}));
+}
+
 }  // namespace media::audio
@@ -22,20 +22,29 @@
 namespace media::audio {
 namespace {
 
-void SetMixDispatcherThreadProfile(const MixProfileConfig& mix_profile_config,
-                                   async_dispatcher_t* dispatcher) {
+bool SetMixDispatcherThreadProfile(const MixProfileConfig& mix_profile_config,
+                                   async_dispatcher_t* dispatcher, bool low_latency = false) {
   zx::profile profile;
-  zx_status_t status = AcquireHighPriorityProfile(mix_profile_config, &profile);
-  if (status != ZX_OK) {
-    FX_LOGS(ERROR)
-        << "Unable to acquire high priority profile; mix threads will run at normal priority";
-    return;
+  if (low_latency) {
+    zx_status_t status = AcquireLowLatencyProfile(mix_profile_config, &profile);
+    if (status != ZX_OK) {
+      FX_LOGS(ERROR) << "Unable to acquire low latency profile; keeping the current profile";
+      return false;
+    }
+  } else {
+    zx_status_t status = AcquireHighPriorityProfile(mix_profile_config, &profile);
+    if (status != ZX_OK) {
+      FX_LOGS(ERROR)
+          << "Unable to acquire high priority profile; mix threads will run at normal priority";
+      return false;
+    }
   }
   FX_DCHECK(profile);
   async::PostTask(dispatcher, [profile = std::move(profile)] {
     zx_status_t status = zx::thread::self()->set_profile(profile, 0);
     FX_DCHECK(status == ZX_OK);
   });
+  return true;
 }
 
 struct ExecutionDomainHolder {
@@ -158,6 +167,12 @@ class ThreadingModelThreadPerMix : public ThreadingModelBase {
     });
   }
 
+  bool SetMixDomainLowLatency(ExecutionDomain& domain, bool low_latency) final {
+    TRACE_DURATION("audio.debug", "ThreadingModelThreadPerMix::SetMixDomainLowLatency",
+                   "low_latency", low_latency);
+    return SetMixDispatcherThreadProfile(mix_profile_config(), domain.dispatcher(), low_latency);
+  }
+
   void RunAndJoinAllThreads() final {
     ThreadingModelBase::RunAndJoinAllThreads();
     {
@@ -162,6 +162,13 @@ class ThreadingModel {
   // This is a single-threaded dispatcher.
   virtual OwnedDomainPtr AcquireMixDomain(const std::string& name_hint) = 0;
 
+  // Switches the thread behind a domain returned by `AcquireMixDomain` between the regular mix
+  // profile and the shorter-period `MixProfileConfig::LowLatency()` profile.
+  //
+  // Returns false if the profile can't be switched, e.g. because the implementation shares mix
+  // domains between several outputs.
+  virtual bool SetMixDomainLowLatency(ExecutionDomain& domain, bool low_latency) { return false; }
+
   // Runs all the dispatchers. When the message loop backing |FidlDomain()| exits, the remaining
   // domains will all be shutdown.
   //
@@ -86,6 +86,12 @@ TEST(ThreadingModelTest, MixOnSingleThreadModel) {
     EXPECT_EQ(mix_domain1->dispatcher(), mix_domain2->dispatcher());
   }
 
+  // The shared mix thread keeps the regular mix profile.
+  {
+    auto mix_domain = threading_model->AcquireMixDomain("");
+    EXPECT_FALSE(threading_model->SetMixDomainLowLatency(*mix_domain, true));
+  }
+
   ValidateThreadingModel(threading_model.get());
 }
 
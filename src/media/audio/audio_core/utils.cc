@@ -431,6 +431,45 @@ zx_status_t SelectBestFormat(const std::vector<audio_stream_format_range_t>& fmt
   return ZX_OK;
 }
 
+namespace {
+
+zx_status_t GetDeadlineProfile(const MixProfileConfig& mix_profile_config, zx::profile* profile) {
+  zx::channel ch0, ch1;
+  zx_status_t res = zx::channel::create(0u, &ch0, &ch1);
+  if (res != ZX_OK) {
+    FX_LOGS(ERROR) << "Failed to create channel, res=" << res;
+    return res;
+  }
+
+  res = fdio_service_connect(
+      (std::string("/svc/") + fuchsia::scheduler::ProfileProvider::Name_).c_str(), ch0.release());
+  if (res != ZX_OK) {
+    FX_LOGS(ERROR) << "Failed to connect to ProfileProvider, res=" << res;
+    return res;
+  }
+
+  fuchsia::scheduler::ProfileProvider_SyncProxy provider(std::move(ch1));
+
+  zx_status_t fidl_status;
+  zx::profile res_profile;
+  res = provider.GetDeadlineProfile(
+      mix_profile_config.capacity.get(), mix_profile_config.deadline.get(),
+      mix_profile_config.period.get(), "src/media/audio/audio_core", &fidl_status, &res_profile);
+  if (res != ZX_OK) {
+    FX_LOGS(ERROR) << "Failed to create profile, res=" << res;
+    return res;
+  }
+  if (fidl_status != ZX_OK) {
+    FX_LOGS(ERROR) << "Failed to create profile, fidl_status=" << fidl_status;
+    return fidl_status;
+  }
+
+  *profile = std::move(res_profile);
+  return ZX_OK;
+}
+
+}  // namespace
+
 zx_status_t AcquireHighPriorityProfile(const MixProfileConfig& mix_profile_config,
                                        zx::profile* profile) {
   TRACE_DURATION("audio", "AcquireHighPriorityProfile");
@@ -438,40 +477,8 @@ zx_status_t AcquireHighPriorityProfile(const MixProfileConfig& mix_profile_confi
   // subsequent call will return a duplicate of that profile handle to ensure sharing of thread
   // pools.
   static zx::profile high_priority_profile;
-  static zx_status_t initial_status = [&mix_profile_config](zx::profile* profile) {
-    zx::channel ch0, ch1;
-    zx_status_t res = zx::channel::create(0u, &ch0, &ch1);
-    if (res != ZX_OK) {
-      FX_LOGS(ERROR) << "Failed to create channel, res=" << res;
-      return res;
-    }
-
-    res = fdio_service_connect(
-        (std::string("/svc/") + fuchsia::scheduler::ProfileProvider::Name_).c_str(), ch0.release());
-    if (res != ZX_OK) {
-      FX_LOGS(ERROR) << "Failed to connect to ProfileProvider, res=" << res;
-      return res;
-    }
-
-    fuchsia::scheduler::ProfileProvider_SyncProxy provider(std::move(ch1));
-
-    zx_status_t fidl_status;
-    zx::profile res_profile;
-    res = provider.GetDeadlineProfile(
-        mix_profile_config.capacity.get(), mix_profile_config.deadline.get(),
-        mix_profile_config.period.get(), "src/media/audio/audio_core", &fidl_status, &res_profile);
-    if (res != ZX_OK) {
-      FX_LOGS(ERROR) << "Failed to create profile, res=" << res;
-      return res;
-    }
-    if (fidl_status != ZX_OK) {
-      FX_LOGS(ERROR) << "Failed to create profile, fidl_status=" << fidl_status;
-      return fidl_status;
-    }
-
-    *profile = std::move(res_profile);
-    return ZX_OK;
-  }(&high_priority_profile);
+  static zx_status_t initial_status =
+      GetDeadlineProfile(mix_profile_config, &high_priority_profile);
 
   // If the initial acquisition of the profile failed, return that status.
   if (initial_status != ZX_OK)
@@ -481,6 +488,20 @@ zx_status_t AcquireHighPriorityProfile(const MixProfileConfig& mix_profile_confi
   return high_priority_profile.duplicate(ZX_RIGHT_SAME_RIGHTS, profile);
 }
 
+zx_status_t AcquireLowLatencyProfile(const MixProfileConfig& mix_profile_config,
+                                     zx::profile* profile) {
+  TRACE_DURATION("audio", "AcquireLowLatencyProfile");
+  // As with AcquireHighPriorityProfile, all low-latency mix threads share one profile object.
+  static zx::profile low_latency_profile;
+  static zx_status_t initial_status =
+      GetDeadlineProfile(mix_profile_config.LowLatency(), &low_latency_profile);
+
+  if (initial_status != ZX_OK)
+    return initial_status;
+
+  return low_latency_profile.duplicate(ZX_RIGHT_SAME_RIGHTS, profile);
+}
+
 void AcquireRelativePriorityProfile(uint32_t priority, sys::ComponentContext* context,
                                     fit::function<void(zx_status_t, zx::profile)> callback) {
   auto nonce = TRACE_NONCE();
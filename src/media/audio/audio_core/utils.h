@@ -81,6 +81,11 @@ class RefCountedVmoMapper : public fzl::VmoMapper, public fbl::RefCounted<fzl::V
 zx_status_t AcquireHighPriorityProfile(const MixProfileConfig& mix_profile_config,
                                        zx::profile* profile);
 
+// Like AcquireHighPriorityProfile, but for mix threads running with the shorter period of
+// MixProfileConfig::LowLatency().
+zx_status_t AcquireLowLatencyProfile(const MixProfileConfig& mix_profile_config,
+                                     zx::profile* profile);
+
 void AcquireAudioCoreImplProfile(sys::ComponentContext* context,
                                  fit::function<void(zx_status_t, zx::profile)> callback);
 
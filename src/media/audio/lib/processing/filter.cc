@@ -8,6 +8,7 @@
 #include <lib/trace/event.h>
 #include <lib/zx/clock.h>
 
+#include <cstring>
 #include <iomanip>
 #include <ios>
 #include <limits>
@@ -24,6 +25,71 @@ namespace {
 // Extremely verbose, only useful in a controlled unittest setting.
 constexpr bool kTraceFilterComputation = false;
 
+// Four floats, which the compiler maps onto a NEON register on arm64 and an SSE register on x64.
+//
+// The compiler can't vectorize a float accumulation on its own, since that changes the order of the
+// additions, so we do it explicitly. The result may differ from a sequential sum in the last bits,
+// which is well within the quality tolerance of the filter.
+using Float4 = float __attribute__((vector_size(4 * sizeof(float))));
+constexpr int64_t kLanes = 4;
+
+inline Float4 Load(const float* ptr) {
+  Float4 value;
+  std::memcpy(&value, ptr, sizeof(value));  // `ptr` might not be aligned to `sizeof(Float4)`.
+  return value;
+}
+
+inline float Sum(Float4 value) { return (value[0] + value[1]) + (value[2] + value[3]); }
+
+// Returns the sum of `samples[idx] * coefficients[idx]` for `idx` in [0, count).
+//
+// Two accumulators hide the latency of the vector additions, which the loop would otherwise be
+// bound by.
+float DotProduct(const float* samples, const float* coefficients, int64_t count) {
+  Float4 sum0 = {};
+  Float4 sum1 = {};
+  int64_t idx = 0;
+  for (; idx + 2 * kLanes <= count; idx += 2 * kLanes) {
+    sum0 += Load(&samples[idx]) * Load(&coefficients[idx]);
+    sum1 += Load(&samples[idx + kLanes]) * Load(&coefficients[idx + kLanes]);
+  }
+  if (idx + kLanes <= count) {
+    sum0 += Load(&samples[idx]) * Load(&coefficients[idx]);
+    idx += kLanes;
+  }
+  float result = Sum(sum0 + sum1);
+  for (; idx < count; ++idx) {
+    result += samples[idx] * coefficients[idx];
+  }
+  return result;
+}
+
+// Returns the sum of `samples[-idx] * coefficients[idx]` for `idx` in [0, count), the way the
+// negative side of the filter walks backwards through the source while walking forwards through the
+// coefficients.
+float ReverseDotProduct(const float* samples, const float* coefficients, int64_t count) {
+  const auto load_reversed = [samples](int64_t idx) {
+    const Float4 value = Load(&samples[-idx - (kLanes - 1)]);
+    return __builtin_shufflevector(value, value, 3, 2, 1, 0);
+  };
+  Float4 sum0 = {};
+  Float4 sum1 = {};
+  int64_t idx = 0;
+  for (; idx + 2 * kLanes <= count; idx += 2 * kLanes) {
+    sum0 += load_reversed(idx) * Load(&coefficients[idx]);
+    sum1 += load_reversed(idx + kLanes) * Load(&coefficients[idx + kLanes]);
+  }
+  if (idx + kLanes <= count) {
+    sum0 += load_reversed(idx) * Load(&coefficients[idx]);
+    idx += kLanes;
+  }
+  float result = Sum(sum0 + sum1);
+  for (; idx < count; ++idx) {
+    result += samples[-idx] * coefficients[idx];
+  }
+  return result;
+}
+
 }  // namespace
 
 void Filter::DisplayTable(const CoefficientTable& filter_coefficients) {
@@ -75,7 +141,7 @@ float Filter::ComputeSampleFromTable(const CoefficientTable& filter_coefficients
                   << (static_cast<double>(frac_offset) / static_cast<double>(frac_size_)) << "):";
   }
 
-  // We use some raw pointers here to make loops vectorizable.
+  // We use some raw pointers here to make loops vectorizable, see `DotProduct`.
   float* sample_ptr;
   const float* coefficient_ptr;
   float result = 0.0f;
@@ -89,15 +155,17 @@ float Filter::ComputeSampleFromTable(const CoefficientTable& filter_coefficients
     coefficient_ptr = filter_coefficients.ReadSlice(frac_offset, source_frames);
     FX_CHECK(coefficient_ptr != nullptr);
 
-    for (int64_t source_idx = 0; source_idx < source_frames; ++source_idx) {
-      auto contribution = (*sample_ptr) * coefficient_ptr[source_idx];
-      if constexpr (kTraceFilterComputation) {
+    if constexpr (kTraceFilterComputation) {
+      for (int64_t source_idx = 0; source_idx < source_frames; ++source_idx) {
+        auto contribution = (*sample_ptr) * coefficient_ptr[source_idx];
         FX_LOGS(INFO) << "Adding source[" << -static_cast<ssize_t>(source_idx) << "] "
                       << (*sample_ptr) << " x " << coefficient_ptr[source_idx] << " = "
                       << contribution;
+        result += contribution;
+        --sample_ptr;
       }
-      result += contribution;
-      --sample_ptr;
+    } else {
+      result += ReverseDotProduct(sample_ptr, coefficient_ptr, source_frames);
     }
   }
 
@@ -112,14 +180,16 @@ float Filter::ComputeSampleFromTable(const CoefficientTable& filter_coefficients
     coefficient_ptr = filter_coefficients.ReadSlice(frac_size_ - frac_offset, source_frames);
     FX_CHECK(coefficient_ptr != nullptr);
 
-    for (int64_t source_idx = 0; source_idx < source_frames; ++source_idx) {
-      auto contribution = sample_ptr[source_idx] * coefficient_ptr[source_idx];
-      if constexpr (kTraceFilterComputation) {
+    if constexpr (kTraceFilterComputation) {
+      for (int64_t source_idx = 0; source_idx < source_frames; ++source_idx) {
+        auto contribution = sample_ptr[source_idx] * coefficient_ptr[source_idx];
         FX_LOGS(INFO) << "Adding source[" << 1 + source_idx << "] " << std::setprecision(13)
                       << sample_ptr[source_idx] << " x " << coefficient_ptr[source_idx] << " = "
                       << contribution;
+        result += contribution;
       }
-      result += contribution;
+    } else {
+      result += DotProduct(sample_ptr, coefficient_ptr, source_frames);
     }
   }
 
@@ -6,6 +6,9 @@
 
 #include <lib/syslog/cpp/macros.h>
 
+#include <cmath>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 namespace media_audio {
@@ -281,5 +284,48 @@ TEST(SincFilterTest, ComputeSample) {
   ValidateSincComputeSample(source_rate, dest_rate, side_length, num_frac_bits);
 }
 
+// `ComputeSample` sums its products in a vectorized order, rather than one frame at a time. Check it
+// against a sequential convolution in double precision, for side lengths that exercise every tail.
+void ValidateSincComputeSampleConvolution(int32_t source_rate, int32_t dest_rate,
+                                          int64_t side_length, int32_t num_frac_bits) {
+  SincFilter filter(source_rate, dest_rate, side_length, num_frac_bits);
+  const int64_t frac_size = int64_t{1} << num_frac_bits;
+  const int64_t side_frames = (filter.side_length() + frac_size - 1) >> num_frac_bits;
+
+  std::vector<float> data(2 * side_frames + 2);
+  for (size_t idx = 0; idx < data.size(); ++idx) {
+    data[idx] = std::sin(static_cast<float>(idx) * 0.7f) + 0.25f;
+  }
+  float* center = &data[side_frames];
+
+  for (int64_t frac_offset : {int64_t{0}, int64_t{1}, frac_size / 3, frac_size / 2, frac_size - 1}) {
+    SCOPED_TRACE(testing::Message() << "side_length " << side_length << ", frac_offset "
+                                    << frac_offset);
+    double expected = 0.0;
+    for (int64_t idx = 0; frac_offset + idx * frac_size < filter.side_length(); ++idx) {
+      expected += static_cast<double>(center[-idx]) *
+                  static_cast<double>(filter[frac_offset + idx * frac_size]);
+    }
+    for (int64_t idx = 0; frac_size - frac_offset + idx * frac_size < filter.side_length(); ++idx) {
+      expected += static_cast<double>(center[1 + idx]) *
+                  static_cast<double>(filter[frac_size - frac_offset + idx * frac_size]);
+    }
+    EXPECT_NEAR(filter.ComputeSample(frac_offset, center), expected, 1e-5);
+  }
+}
+
+TEST(SincFilterTest, ComputeSampleMatchesConvolution) {
+  for (int64_t side_frames = 1; side_frames <= 20; ++side_frames) {
+    ValidateSincComputeSampleConvolution(48000, 48000, side_frames << 4, 4);
+  }
+  // Default lengths, for unity, up-sampling and down-sampling rate ratios.
+  ValidateSincComputeSampleConvolution(48000, 48000, SincFilter::kFracSideLength,
+                                       Fixed::Format::FractionalBits);
+  ValidateSincComputeSampleConvolution(
+      44100, 48000, SincFilter::Length(44100, 48000).raw_value(), Fixed::Format::FractionalBits);
+  ValidateSincComputeSampleConvolution(
+      96000, 48000, SincFilter::Length(96000, 48000).raw_value(), Fixed::Format::FractionalBits);
+}
+
 }  // namespace
 }  // namespace media_audio
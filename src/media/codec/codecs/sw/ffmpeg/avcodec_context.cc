@@ -5,7 +5,9 @@
 #include "avcodec_context.h"
 
 #include <lib/media/codec_impl/codec_buffer.h>
+#include <zircon/syscalls.h>
 
+#include <algorithm>
 #include <limits>
 #include <map>
 #include <string>
@@ -15,6 +17,10 @@ namespace {
 // TODO(turnage): Add VP9, and more.
 static const std::map<std::string, AVCodecID> codec_ids = {{"video/h264", AV_CODEC_ID_H264}};
 
+// Upper bound on decode threads per decoder. Each decoder runs in its own isolate, so this keeps
+// several concurrent decoders from each spinning up a thread per CPU.
+constexpr uint32_t kMaxDecodeThreads = 4;
+
 static inline constexpr uint32_t make_fourcc(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
   return (static_cast<uint32_t>(d) << 24) | (static_cast<uint32_t>(c) << 16) |
          (static_cast<uint32_t>(b) << 8) | static_cast<uint32_t>(a);
@@ -48,6 +54,13 @@ std::optional<std::unique_ptr<AvCodecContext>> AvCodecContext::CreateDecoder(
   // and not just frame boundaries.
   avcodec_context->flags2 |= AV_CODEC_FLAG2_CHUNKS;
 
+  // Decode the slices of a frame in parallel. Frame threading would also need whole frames per
+  // packet, which AV_CODEC_FLAG2_CHUNKS rules out, so ffmpeg only ever uses slice threads here.
+  // Slice threads call get_buffer2 from the thread calling into ffmpeg, as before.
+  avcodec_context->thread_type = FF_THREAD_SLICE;
+  avcodec_context->thread_count =
+      static_cast<int>(std::min(zx_system_get_num_cpus(), kMaxDecodeThreads));
+
   // This flag is required to override get_buffer2.
   ZX_ASSERT(avcodec_context->codec->capabilities & AV_CODEC_CAP_DR1);
 
@@ -151,6 +151,12 @@ int CodecAdapterFfmpegDecoder::GetBuffer(
         /*output_re_config_required=*/need_new_buffers);
   }
 
+  AVPixelFormat pix_fmt = FourccToPixelFormat(decoded_output_info.format.fourcc);
+  if (pix_fmt == AV_PIX_FMT_NONE) {
+    events_->onCoreCodecFailCodec("Unsupported format: %d", pix_fmt);
+    return -1;
+  }
+
   auto buffer = output_buffer_pool_.AllocateBuffer(decoded_output_info.buffer_bytes_needed);
   if (!buffer) {
     // This stream is stopping. We let ffmpeg allocate just so it can exit
@@ -158,20 +164,24 @@ int CodecAdapterFfmpegDecoder::GetBuffer(
     return avcodec_default_get_buffer2(avcodec_context, frame, flags);
   }
 
-  AVPixelFormat pix_fmt = FourccToPixelFormat(decoded_output_info.format.fourcc);
-  if (pix_fmt == AV_PIX_FMT_NONE) {
-    events_->onCoreCodecFailCodec("Unsupported format: %d", pix_fmt);
-    return -1;
-  }
-
+  // |flags| may hold AV_GET_BUFFER_FLAG_REF, which tells us ffmpeg keeps the frame as a reference.
+  // It is not an AV_BUFFER_FLAG_*: passing it on would mark the buffer read-only, and ffmpeg would
+  // copy the frame out of the output buffer the next time it needs it writable.
   AVBufferRef* buffer_ref = av_buffer_create(buffer->base(), static_cast<int>(buffer->size()),
-                                             FfmpegFreeBufferCallback, this, flags);
+                                             FfmpegFreeBufferCallback, this, /*flags=*/0);
+  if (!buffer_ref) {
+    output_buffer_pool_.FreeBuffer(buffer->base());
+    events_->onCoreCodecFailCodec("Ffmpeg buffer allocation failed");
+    return AVERROR(ENOMEM);
+  }
 
   int fill_arrays_status =
       av_image_fill_arrays(frame->data, frame->linesize, buffer_ref->data, pix_fmt,
                            decoded_output_info.format.primary_width_pixels,
                            decoded_output_info.format.primary_height_pixels, 1);
   if (fill_arrays_status < 0) {
+    // Returns the buffer to the pool.
+    av_buffer_unref(&buffer_ref);
     events_->onCoreCodecFailCodec("Ffmpeg fill arrays failed: %d", fill_arrays_status);
     return -1;
   }
@@ -214,7 +224,11 @@ void CodecAdapterFfmpegDecoder::DecodeFrames() {
         fit::defer([this, &output_packet]() { free_output_packets_.Push(output_packet); });
 
     auto buffer_alloc = output_buffer_pool_.FindBufferByBase(frame->data[0]);
-    ZX_ASSERT(buffer_alloc);
+    if (!buffer_alloc) {
+      // ffmpeg allocated this frame itself because the stream is stopping or has failed (see
+      // GetBuffer), so there is no output buffer to emit it in.
+      return;
+    }
 
     if (buffer_alloc->bytes_used > std::numeric_limits<uint32_t>::max()) {
       events_->onCoreCodecFailCodec("Could not represent bytes_used as uint32_t");
@@ -66,6 +66,11 @@ class LinearBufferManager : public SurfaceBufferManager {
 
     ZX_DEBUG_ASSERT(!output_buffer_pool_.has_buffers_in_use());
 
+    {
+      std::lock_guard<std::mutex> guard(surface_lock_);
+      imported_outputs_.clear();
+    }
+
     // Once all the buffers have been returned to the bool, deallocate them
     output_buffer_pool_.Reset(false);
   }
@@ -174,50 +179,6 @@ class LinearBufferManager : public SurfaceBufferManager {
                   "Picture size (%u bytes) exceeds buffer size (%zu bytes)", total_plane_size,
                   buffer->size());
 
-    zx::vmo vmo_dup;
-    zx_status_t zx_status = buffer->vmo().duplicate(ZX_RIGHT_SAME_RIGHTS, &vmo_dup);
-    if (zx_status != ZX_OK) {
-      FX_SLOG(ERROR, "Failed to duplicate vmo", KV("error_str", zx_status_get_string(zx_status)));
-      return std::nullopt;
-    }
-
-    // For the moment we use DRM_PRIME_2 to represent VMOs.
-    // To specify the destination VMO, we need two VASurfaceAttrib, one to set the
-    // VASurfaceAttribMemoryType to VA_SURFACE_ATTRIB_MEM_TYPE_DRM_PRIME_2 and one for the
-    // VADRMPRIMESurfaceDescriptor.
-    VADRMPRIMESurfaceDescriptor ext_attrib{};
-    VASurfaceAttrib attrib[2] = {
-        {.type = VASurfaceAttribMemoryType,
-         .flags = VA_SURFACE_ATTRIB_SETTABLE,
-         .value = {.type = VAGenericValueTypeInteger,
-                   .value = {.i = VA_SURFACE_ATTRIB_MEM_TYPE_DRM_PRIME_2}}},
-        {.type = VASurfaceAttribExternalBufferDescriptor,
-         .flags = VA_SURFACE_ATTRIB_SETTABLE,
-         .value = {.type = VAGenericValueTypePointer, .value = {.p = &ext_attrib}}},
-    };
-
-    // VADRMPRIMESurfaceDescriptor width will match the output stride instead of the coded width.
-    ext_attrib.width = surface_size.width();
-    ext_attrib.height = coded_picture_size_.height();
-    ext_attrib.fourcc = VA_FOURCC_NV12;  // 2 plane YCbCr
-    ext_attrib.num_objects = 1;
-    ext_attrib.objects[0].fd = vmo_dup.release();
-    ext_attrib.objects[0].drm_format_modifier = fuchsia::sysmem::FORMAT_MODIFIER_LINEAR;
-    ext_attrib.objects[0].size = static_cast<uint32_t>(buffer->size());
-    ext_attrib.num_layers = 1;
-    ext_attrib.layers[0].drm_format = make_fourcc('N', 'V', '1', '2');
-    ext_attrib.layers[0].num_planes = 2;
-
-    // Y plane
-    ext_attrib.layers[0].object_index[0] = 0;
-    ext_attrib.layers[0].pitch[0] = aligned_stride;
-    ext_attrib.layers[0].offset[0] = 0;
-
-    // UV Plane
-    ext_attrib.layers[0].object_index[1] = 0;
-    ext_attrib.layers[0].pitch[1] = aligned_stride;
-    ext_attrib.layers[0].offset[1] = y_plane_size;
-
     VAStatus status = vaSyncSurface(VADisplayWrapper::GetSingleton()->display(), va_surface->id());
 
     if (status != VA_STATUS_SUCCESS) {
@@ -264,44 +225,51 @@ class LinearBufferManager : public SurfaceBufferManager {
       return std::nullopt;
     }
 
-    // Create the surface backed by the destination VMO. Since we are using
-    // VADRMPRIMESurfaceDescriptor, the width and height of the vaCreateSurfaces() call will be
-    // overridden by |ext_attrib.width| and |ext_attrib.height|.
-    VASurfaceID processed_surface_id;
-    status =
-        vaCreateSurfaces(VADisplayWrapper::GetSingleton()->display(), VA_RT_FORMAT_YUV420,
-                         ext_attrib.width, ext_attrib.height, &processed_surface_id, 1, attrib, 2);
-    if (status != VA_STATUS_SUCCESS) {
-      FX_SLOG(WARNING, "vaCreateSurfaces failed", KV("error_str", vaErrorStr(status)));
-      return std::nullopt;
+    // Reuse the surface and image imported from |buffer| for an earlier frame if they are still the
+    // right size, rather than importing the output VMO into VA-API again for every frame.
+    const gfx::Size output_size(surface_size.width(), coded_picture_size_.height());
+    std::optional<ImportedOutput> imported_output;
+    {
+      std::lock_guard<std::mutex> guard(surface_lock_);
+      auto map_itr = imported_outputs_.find(buffer);
+      if (map_itr != imported_outputs_.end()) {
+        if (map_itr->second.size == output_size) {
+          imported_output = std::move(map_itr->second);
+        }
+        imported_outputs_.erase(map_itr);
+      }
     }
 
-    ScopedSurfaceID processed_surface(processed_surface_id);
+    if (!imported_output) {
+      imported_output = ImportOutputBuffer(buffer, output_size, aligned_stride, y_plane_size);
+    }
+    if (!imported_output) {
+      // The driver may be out of surfaces. Give back the ones held for other output buffers, which
+      // can be imported again later, and try once more.
+      {
+        std::lock_guard<std::mutex> guard(surface_lock_);
+        imported_outputs_.clear();
+      }
+      imported_output = ImportOutputBuffer(buffer, output_size, aligned_stride, y_plane_size);
+      if (!imported_output) {
+        return std::nullopt;
+      }
+    }
 
-    // Set up a VAImage for the destination VMO.
-    VAImage image;
-    status =
-        vaDeriveImage(VADisplayWrapper::GetSingleton()->display(), processed_surface.id(), &image);
+    // Copy from potentially-tiled surface to output surface. Intel decoders only
+    // support writing to Y-tiled textures, so this copy is necessary for linear
+    // output.
+    status = vaGetImage(VADisplayWrapper::GetSingleton()->display(), va_surface->id(), 0, 0,
+                        output_size.width(), output_size.height(), imported_output->image.id());
     if (status != VA_STATUS_SUCCESS) {
-      FX_SLOG(WARNING, "vaDeriveImage failed", KV("error_str", vaErrorStr(status)));
+      FX_SLOG(WARNING, "vaGetImage failed", KV("error_str", vaErrorStr(status)));
       return std::nullopt;
     }
 
     {
-      ScopedImageID scoped_image(image.image_id);
-
-      // Copy from potentially-tiled surface to output surface. Intel decoders only
-      // support writing to Y-tiled textures, so this copy is necessary for linear
-      // output.
-      status = vaGetImage(VADisplayWrapper::GetSingleton()->display(), va_surface->id(), 0, 0,
-                          surface_size.width(), coded_picture_size_.height(), scoped_image.id());
-      if (status != VA_STATUS_SUCCESS) {
-        FX_SLOG(WARNING, "vaGetImage failed", KV("error_str", vaErrorStr(status)));
-        return std::nullopt;
-      }
+      std::lock_guard<std::mutex> guard(surface_lock_);
+      imported_outputs_.emplace(buffer, std::move(*imported_output));
     }
-    // ~processed_surface: Clean up the image; the data was already copied to the destination VMO
-    // above.
 
     {
       std::lock_guard<std::mutex> guard(codec_lock_);
@@ -354,6 +322,9 @@ class LinearBufferManager : public SurfaceBufferManager {
     // destroyed instead of being returned back to |dpb_surfaces_|.
     dpb_surfaces_.clear();
 
+    // Output buffers imported at the old stride have to be imported again.
+    imported_outputs_.clear();
+
     // Given the new picture size and the current surface size, create a surface size that will
     // allow us to hold decoded picture without shrinking the dimensions of the current DPB surface.
     // Since media-driver does not allow the surfaces to become smaller, ensure that the surface
@@ -386,6 +357,92 @@ class LinearBufferManager : public SurfaceBufferManager {
   }
 
  private:
+  // A linear output buffer imported into VA-API, with an image derived from it that vaGetImage()
+  // can copy decoded surfaces into. The image is declared last so that it is destroyed before the
+  // surface backing it.
+  struct ImportedOutput {
+    gfx::Size size;
+    ScopedSurfaceID surface{VA_INVALID_SURFACE};
+    ScopedImageID image;
+  };
+
+  // Imports |buffer| as a linear NV12 surface of |size| and derives an image from it. Returns
+  // std::nullopt on failure.
+  static std::optional<ImportedOutput> ImportOutputBuffer(const CodecBuffer* buffer,
+                                                          const gfx::Size& size,
+                                                          uint32_t aligned_stride,
+                                                          uint32_t y_plane_size) {
+    zx::vmo vmo_dup;
+    zx_status_t zx_status = buffer->vmo().duplicate(ZX_RIGHT_SAME_RIGHTS, &vmo_dup);
+    if (zx_status != ZX_OK) {
+      FX_SLOG(ERROR, "Failed to duplicate vmo", KV("error_str", zx_status_get_string(zx_status)));
+      return std::nullopt;
+    }
+
+    // For the moment we use DRM_PRIME_2 to represent VMOs.
+    // To specify the destination VMO, we need two VASurfaceAttrib, one to set the
+    // VASurfaceAttribMemoryType to VA_SURFACE_ATTRIB_MEM_TYPE_DRM_PRIME_2 and one for the
+    // VADRMPRIMESurfaceDescriptor.
+    VADRMPRIMESurfaceDescriptor ext_attrib{};
+    VASurfaceAttrib attrib[2] = {
+        {.type = VASurfaceAttribMemoryType,
+         .flags = VA_SURFACE_ATTRIB_SETTABLE,
+         .value = {.type = VAGenericValueTypeInteger,
+                   .value = {.i = VA_SURFACE_ATTRIB_MEM_TYPE_DRM_PRIME_2}}},
+        {.type = VASurfaceAttribExternalBufferDescriptor,
+         .flags = VA_SURFACE_ATTRIB_SETTABLE,
+         .value = {.type = VAGenericValueTypePointer, .value = {.p = &ext_attrib}}},
+    };
+
+    // VADRMPRIMESurfaceDescriptor width will match the output stride instead of the coded width.
+    ext_attrib.width = size.width();
+    ext_attrib.height = size.height();
+    ext_attrib.fourcc = VA_FOURCC_NV12;  // 2 plane YCbCr
+    ext_attrib.num_objects = 1;
+    ext_attrib.objects[0].fd = vmo_dup.release();
+    ext_attrib.objects[0].drm_format_modifier = fuchsia::sysmem::FORMAT_MODIFIER_LINEAR;
+    ext_attrib.objects[0].size = static_cast<uint32_t>(buffer->size());
+    ext_attrib.num_layers = 1;
+    ext_attrib.layers[0].drm_format = make_fourcc('N', 'V', '1', '2');
+    ext_attrib.layers[0].num_planes = 2;
+
+    // Y plane
+    ext_attrib.layers[0].object_index[0] = 0;
+    ext_attrib.layers[0].pitch[0] = aligned_stride;
+    ext_attrib.layers[0].offset[0] = 0;
+
+    // UV Plane
+    ext_attrib.layers[0].object_index[1] = 0;
+    ext_attrib.layers[0].pitch[1] = aligned_stride;
+    ext_attrib.layers[0].offset[1] = y_plane_size;
+
+    // Create the surface backed by the destination VMO. Since we are using
+    // VADRMPRIMESurfaceDescriptor, the width and height of the vaCreateSurfaces() call will be
+    // overridden by |ext_attrib.width| and |ext_attrib.height|.
+    VASurfaceID processed_surface_id;
+    VAStatus status =
+        vaCreateSurfaces(VADisplayWrapper::GetSingleton()->display(), VA_RT_FORMAT_YUV420,
+                         ext_attrib.width, ext_attrib.height, &processed_surface_id, 1, attrib, 2);
+    if (status != VA_STATUS_SUCCESS) {
+      FX_SLOG(WARNING, "vaCreateSurfaces failed", KV("error_str", vaErrorStr(status)));
+      return std::nullopt;
+    }
+
+    ImportedOutput imported_output{.size = size, .surface = ScopedSurfaceID(processed_surface_id)};
+
+    // Set up a VAImage for the destination VMO.
+    VAImage image;
+    status = vaDeriveImage(VADisplayWrapper::GetSingleton()->display(),
+                           imported_output.surface.id(), &image);
+    if (status != VA_STATUS_SUCCESS) {
+      FX_SLOG(WARNING, "vaDeriveImage failed", KV("error_str", vaErrorStr(status)));
+      return std::nullopt;
+    }
+    imported_output.image = ScopedImageID(image.image_id);
+
+    return imported_output;
+  }
+
   // VA-API outputs are distinct from the DPB and are stored in a regular
   // BufferPool, since the hardware doesn't necessarily support decoding to a
   // linear format like downstream consumers might need.
@@ -434,6 +491,12 @@ class LinearBufferManager : public SurfaceBufferManager {
   // wrapper to the a scoped_refptr<VASurface> wrapper and can not be destroyed until all references
   // of the wrapper are released.
   std::vector<ScopedSurfaceID> dpb_surfaces_ FXL_GUARDED_BY(surface_lock_) = {};
+
+  // Output buffers which have already been imported into VA-API, so that later frames copied into
+  // the same buffer skip the import. Entries are taken out while a frame is being copied and are
+  // dropped whenever the output buffers or the surface size change.
+  std::unordered_map<const CodecBuffer*, ImportedOutput> imported_outputs_
+      FXL_GUARDED_BY(surface_lock_);
 };
 
 // This class manages output buffers when the client selects a tiled buffer output. Since the output
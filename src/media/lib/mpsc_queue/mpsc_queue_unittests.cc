@@ -60,6 +60,46 @@ TEST(MpscQueueTest, TwoThreads) {
   EXPECT_EQ(expectation.size(), 0u);
 }
 
+TEST(MpscQueueTest, ManyProducersDeliverEachElementOnce) {
+  MpscQueue<int> under_test;
+
+  const int kElements = 10000;
+  const int kThreads = 8;
+
+  // Each producer pushes its own range of elements, while the consumer pops concurrently.
+  std::unique_ptr<async::Loop> producer_loops[kThreads];
+  for (int i = 0; i < kThreads; ++i) {
+    auto& producer_loop = producer_loops[i];
+    producer_loop = std::make_unique<async::Loop>(&kAsyncLoopConfigNoAttachToCurrentThread);
+    async::PostTask(producer_loop->dispatcher(), [&under_test, i] {
+      for (int j = 0; j < kElements; ++j) {
+        under_test.Push(i * kElements + j);
+      }
+    });
+    producer_loop->StartThread(nullptr, nullptr);
+  }
+
+  std::vector<int> delivery_counts(kElements * kThreads);
+  int element_count = 0;
+  while (element_count < kElements * kThreads) {
+    std::optional<int> maybe_elem = under_test.Pop();
+    if (maybe_elem.has_value()) {
+      ++element_count;
+      ASSERT_GE(*maybe_elem, 0);
+      ASSERT_LT(*maybe_elem, kElements * kThreads);
+      ++delivery_counts[*maybe_elem];
+    }
+  }
+
+  for (auto& producer_loop : producer_loops) {
+    producer_loop->Shutdown();
+  }
+  EXPECT_FALSE(under_test.Pop().has_value());
+  for (int i = 0; i < kElements * kThreads; ++i) {
+    EXPECT_EQ(delivery_counts[i], 1) << "element " << i;
+  }
+}
+
 TEST(BlockingMpscQueueTest, TwoThreads) {
   BlockingMpscQueue<int> under_test;
   std::set<int> expectation;
@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <limits>
 
+#include "print_samples.h"
 #include "print_tallies.h"
 #include "session_result_spec.h"
 #include "session_spec.h"
@@ -175,6 +176,8 @@ static bool RunSession(const cpuperf::SessionSpec& spec,
 
     if (controller->config().GetMode() == perfmon::CollectionMode::kTally) {
       PrintTallyResults(stdout, spec, result_spec, model_event_manager, controller);
+    } else {
+      PrintSampleResults(stdout, model_event_manager, controller);
     }
   }
 
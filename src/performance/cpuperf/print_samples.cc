@@ -0,0 +1,53 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "print_samples.h"
+
+#include <inttypes.h>
+#include <lib/syslog/cpp/macros.h>
+
+#include <memory>
+
+#include "sample_profile.h"
+
+// The number of PCs to print for each event.
+constexpr size_t kMaxLocationsPerEvent = 20;
+
+void PrintSampleResults(FILE* f, const perfmon::ModelEventManager* model_event_manager,
+                        perfmon::Controller* controller) {
+  std::unique_ptr<perfmon::Reader> reader = controller->GetReader();
+  if (!reader) {
+    return;
+  }
+
+  // Samples from all cpus are counted together.
+  cpuperf::SampleProfile profile;
+  uint32_t trace;
+  perfmon::SampleRecord record;
+  while (reader->ReadNextRecord(&trace, &record) == perfmon::ReaderStatus::kOk) {
+    if (record.header->event == 0 || record.type() != perfmon::kRecordTypePc) {
+      continue;
+    }
+    profile.AddSample(record.header->event, record.pc->aspace, record.pc->pc);
+  }
+
+  for (perfmon::EventId id : profile.GetEvents()) {
+    const perfmon::EventDetails* details;
+    const char* name = "Unknown";
+    if (model_event_manager->EventIdToEventDetails(id, &details)) {
+      name = details->name;
+    } else {
+      FX_LOGS(WARNING) << "Unknown event: 0x" << std::hex << id;
+    }
+    uint64_t total = profile.GetSampleCount(id);
+    fprintf(f, "%s: %" PRIu64 " samples\n", name, total);
+    fprintf(f, "%10s %7s %18s  %s\n", "Samples", "%", "Aspace", "PC");
+    for (const auto& entry : profile.GetTopLocations(id, kMaxLocationsPerEvent)) {
+      double percent = 100.0 * static_cast<double>(entry.count) / static_cast<double>(total);
+      fprintf(f, "%10" PRIu64 " %6.2f%% 0x%016" PRIx64 "  {{{pc:0x%" PRIx64 "}}}\n", entry.count,
+              percent, entry.aspace, entry.pc);
+    }
+    fprintf(f, "\n");
+  }
+}
@@ -0,0 +1,18 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SRC_PERFORMANCE_CPUPERF_PRINT_SAMPLES_H_
+#define SRC_PERFORMANCE_CPUPERF_PRINT_SAMPLES_H_
+
+#include <stdio.h>
+
+#include "src/performance/lib/perfmon/controller.h"
+#include "src/performance/lib/perfmon/events.h"
+
+// Print, for each sampled event, the PCs at which it was sampled most often.
+// PCs are printed as symbolizer markup so that the output can be symbolized.
+void PrintSampleResults(FILE* f, const perfmon::ModelEventManager* model_event_manager,
+                        perfmon::Controller* controller);
+
+#endif  // SRC_PERFORMANCE_CPUPERF_PRINT_SAMPLES_H_
@@ -0,0 +1,56 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/performance/cpuperf/sample_profile.h"
+
+#include <algorithm>
+
+namespace cpuperf {
+
+void SampleProfile::AddSample(perfmon::EventId event, uint64_t aspace, uint64_t pc) {
+  EventSamples& samples = events_[event];
+  ++samples.total;
+  ++samples.counts[Location{aspace, pc}];
+}
+
+std::vector<perfmon::EventId> SampleProfile::GetEvents() const {
+  std::vector<perfmon::EventId> events;
+  for (const auto& [event, samples] : events_) {
+    events.push_back(event);
+  }
+  return events;
+}
+
+uint64_t SampleProfile::GetSampleCount(perfmon::EventId event) const {
+  auto iter = events_.find(event);
+  if (iter == events_.end()) {
+    return 0;
+  }
+  return iter->second.total;
+}
+
+std::vector<SampleProfile::Entry> SampleProfile::GetTopLocations(perfmon::EventId event,
+                                                                 size_t max_entries) const {
+  std::vector<Entry> entries;
+  auto iter = events_.find(event);
+  if (iter == events_.end()) {
+    return entries;
+  }
+  for (const auto& [location, count] : iter->second.counts) {
+    entries.push_back(Entry{location.first, location.second, count});
+  }
+
+  size_t num_entries = std::min(max_entries, entries.size());
+  std::partial_sort(entries.begin(), entries.begin() + num_entries, entries.end(),
+                    [](const Entry& a, const Entry& b) {
+                      if (a.count != b.count) {
+                        return a.count > b.count;
+                      }
+                      return std::make_pair(a.aspace, a.pc) < std::make_pair(b.aspace, b.pc);
+                    });
+  entries.resize(num_entries);
+  return entries;
+}
+
+}  // namespace cpuperf
@@ -0,0 +1,58 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SRC_PERFORMANCE_CPUPERF_SAMPLE_PROFILE_H_
+#define SRC_PERFORMANCE_CPUPERF_SAMPLE_PROFILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "src/performance/lib/perfmon/events.h"
+
+namespace cpuperf {
+
+// Counts the samples of each event taken at each PC, so that the code in
+// which an event (e.g., cache misses or branch mispredicts) happens most
+// often can be found.
+//
+// The hardware only records the address space along with the PC, so that is
+// as fine grained as attribution gets: samples taken in different threads of
+// the same process are counted together.
+class SampleProfile {
+ public:
+  struct Entry {
+    uint64_t aspace;
+    uint64_t pc;
+    uint64_t count;
+  };
+
+  void AddSample(perfmon::EventId event, uint64_t aspace, uint64_t pc);
+
+  // Return the events which have samples, in increasing order of id.
+  std::vector<perfmon::EventId> GetEvents() const;
+
+  // Return the total number of samples of |event|.
+  uint64_t GetSampleCount(perfmon::EventId event) const;
+
+  // Return at most |max_entries| locations with the most samples of |event|,
+  // most first. Locations with the same count are ordered by aspace and pc.
+  std::vector<Entry> GetTopLocations(perfmon::EventId event, size_t max_entries) const;
+
+ private:
+  using Location = std::pair<uint64_t, uint64_t>;
+
+  struct EventSamples {
+    uint64_t total = 0;
+    std::map<Location, uint64_t> counts;
+  };
+
+  std::map<perfmon::EventId, EventSamples> events_;
+};
+
+}  // namespace cpuperf
+
+#endif  // SRC_PERFORMANCE_CPUPERF_SAMPLE_PROFILE_H_
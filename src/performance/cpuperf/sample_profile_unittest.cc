@@ -0,0 +1,67 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/performance/cpuperf/sample_profile.h"
+
+#include <gtest/gtest.h>
+
+namespace cpuperf {
+
+namespace {
+
+constexpr perfmon::EventId kCycles = 1;
+constexpr perfmon::EventId kCacheMisses = 2;
+constexpr uint64_t kAspace = 0x1000;
+
+TEST(SampleProfile, Empty) {
+  SampleProfile profile;
+  EXPECT_TRUE(profile.GetEvents().empty());
+  EXPECT_EQ(0u, profile.GetSampleCount(kCycles));
+  EXPECT_TRUE(profile.GetTopLocations(kCycles, 10).empty());
+}
+
+TEST(SampleProfile, CountsEventsSeparately) {
+  SampleProfile profile;
+  profile.AddSample(kCacheMisses, kAspace, 0x10);
+  profile.AddSample(kCycles, kAspace, 0x10);
+  profile.AddSample(kCycles, kAspace, 0x20);
+
+  std::vector<perfmon::EventId> events = profile.GetEvents();
+  ASSERT_EQ(2u, events.size());
+  EXPECT_EQ(kCycles, events[0]);
+  EXPECT_EQ(kCacheMisses, events[1]);
+  EXPECT_EQ(2u, profile.GetSampleCount(kCycles));
+  EXPECT_EQ(1u, profile.GetSampleCount(kCacheMisses));
+}
+
+TEST(SampleProfile, TopLocations) {
+  SampleProfile profile;
+  for (int i = 0; i < 3; ++i) {
+    profile.AddSample(kCycles, kAspace, 0x30);
+  }
+  profile.AddSample(kCycles, kAspace, 0x20);
+  profile.AddSample(kCycles, kAspace, 0x10);
+  // The same pc in a different aspace is a different location.
+  for (int i = 0; i < 2; ++i) {
+    profile.AddSample(kCycles, kAspace + 1, 0x30);
+  }
+
+  std::vector<SampleProfile::Entry> top = profile.GetTopLocations(kCycles, 3);
+  ASSERT_EQ(3u, top.size());
+  EXPECT_EQ(0x30u, top[0].pc);
+  EXPECT_EQ(kAspace, top[0].aspace);
+  EXPECT_EQ(3u, top[0].count);
+  EXPECT_EQ(0x30u, top[1].pc);
+  EXPECT_EQ(kAspace + 1, top[1].aspace);
+  EXPECT_EQ(2u, top[1].count);
+  // Ties are broken by pc.
+  EXPECT_EQ(0x10u, top[2].pc);
+  EXPECT_EQ(1u, top[2].count);
+
+  EXPECT_EQ(4u, profile.GetTopLocations(kCycles, 10).size());
+}
+
+}  // namespace
+
+}  // namespace cpuperf
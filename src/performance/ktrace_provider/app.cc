@@ -93,13 +93,14 @@ void RequestKtraceStart(Controller_SyncProxy& controller, trace_buffering_mode_t
   zx_status_t status;
 
   switch (buffering_mode) {
-    // ktrace does not currently support streaming, so for now we preserve the
-    // legacy behavior of falling back on one-shot mode.
-    case TRACE_BUFFERING_MODE_STREAMING:
     case TRACE_BUFFERING_MODE_ONESHOT:
       status = controller.Start(group_mask, BufferingMode::ONESHOT, &start_status);
       break;
 
+    // ktrace cannot be drained while it is running, so the closest it gets to
+    // streaming is to keep recording into the circular buffer rather than to
+    // stop once it is full.
+    case TRACE_BUFFERING_MODE_STREAMING:
     case TRACE_BUFFERING_MODE_CIRCULAR:
       status = controller.Start(group_mask, BufferingMode::CIRCULAR, &start_status);
       break;
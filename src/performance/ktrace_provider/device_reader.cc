@@ -13,6 +13,7 @@
 #include <zircon/status.h>
 
 #include <algorithm>
+#include <cstring>
 
 #include <src/lib/files/eintr_wrapper.h>
 
@@ -20,7 +21,13 @@
 
 namespace ktrace_provider {
 
-DeviceReader::DeviceReader() : Reader(buffer_, kChunkSize) {}
+DeviceReader::DeviceReader()
+    : Reader(buffer_, kChunkSize),
+      merger_(
+          [this](size_t offset, size_t size, uint8_t* buffer) {
+            return ReadAt(offset, size, buffer);
+          },
+          kChunkSize) {}
 
 zx_status_t DeviceReader::Init() {
   auto [status, channel] = OpenKtraceReader();
@@ -50,12 +57,21 @@ void DeviceReader::ReadMoreData() {
   memmove(buffer_, current_, AvailableBytes());
   char* new_marker = buffer_ + AvailableBytes();
 
-  while (new_marker < end_) {
-    size_t read_size = std::distance(const_cast<const char*>(new_marker), end_);
-    read_size = std::clamp(read_size, 0lu, static_cast<size_t>(fuchsia::tracing::kernel::MAX_BUF));
+  size_t read_size = std::distance(const_cast<const char*>(new_marker), end_);
+  new_marker += merger_.Read(reinterpret_cast<uint8_t*>(new_marker), read_size);
+
+  marker_ = new_marker;
+  current_ = buffer_;
+}
+
+size_t DeviceReader::ReadAt(size_t offset, size_t size, uint8_t* buffer) {
+  size_t bytes_read = 0;
+  while (bytes_read < size) {
+    size_t read_size = std::min(size - bytes_read,
+                                static_cast<size_t>(fuchsia::tracing::kernel::MAX_BUF));
     zx_status_t out_status;
     std::vector<uint8_t> buf;
-    auto status = ktrace_reader_->ReadAt(read_size, offset_, &out_status, &buf);
+    auto status = ktrace_reader_->ReadAt(read_size, offset + bytes_read, &out_status, &buf);
     if (status != ZX_OK || out_status != ZX_OK) {
       FX_LOGS(ERROR) << "Failed to read from ktrace reader status:" << status
                      << "out_status:" << out_status;
@@ -66,13 +82,10 @@ void DeviceReader::ReadMoreData() {
       break;
     }
 
-    memcpy(new_marker, buf.data(), buf.size());
-    offset_ += buf.size();
-    new_marker += buf.size();
+    memcpy(buffer + bytes_read, buf.data(), buf.size());
+    bytes_read += buf.size();
   }
-
-  marker_ = new_marker;
-  current_ = buffer_;
+  return bytes_read;
 }
 
 }  // namespace ktrace_provider
@@ -24,9 +24,15 @@ class DeviceReader : public Reader {
   std::tuple<zx_status_t, zx::channel> OpenKtraceReader();
   void ReadMoreData() override;
 
+  // Reads up to |size| bytes of the trace at |offset| into |buffer|, and
+  // returns the number read.
+  size_t ReadAt(size_t offset, size_t size, uint8_t* buffer);
+
   fuchsia::tracing::kernel::ReaderSyncPtr ktrace_reader_;
-  size_t offset_ = 0;
-  char buffer_[kChunkSize];
+  // The records of each CPU are only in timestamp order within the blocks it
+  // claimed, so they're merged as they're read, a chunk at a time.
+  CpuBlockMerger merger_;
+  alignas(ktrace_header_t) char buffer_[kChunkSize];
 
   DeviceReader(const DeviceReader&) = delete;
   DeviceReader(DeviceReader&&) = delete;
@@ -93,6 +93,9 @@ Importer::Importer(trace_context_t* context)
       vaddr_name_ref_(MAKE_STRING("vaddr")),
       flags_name_ref_(MAKE_STRING("flags")),
       exit_address_name_ref_(MAKE_STRING("exit_address")),
+      vcpu_interrupts_name_ref_(MAKE_STRING("interrupts")),
+      exits_name_ref_(MAKE_STRING("exits")),
+      exits_avoided_name_ref_(MAKE_STRING("exits_avoided")),
       arg0_name_ref_(MAKE_STRING("arg0")),
       arg1_name_ref_(MAKE_STRING("arg1")),
       // Priority inheritance related strings.
@@ -396,6 +399,8 @@ bool Importer::ImportQuadRecord(const ktrace_rec_32b_t* record, const TagInfo& t
       return HandleVcpuBlock(record->ts, record->tid, record->a);
     case KTRACE_EVENT(TAG_VCPU_UNBLOCK):
       return HandleVcpuUnblock(record->ts, record->tid, record->a);
+    case KTRACE_EVENT(TAG_VCPU_INTERRUPT):
+      return HandleVcpuInterrupt(record->ts, record->tid, record->a, record->b != 0);
     default:
       return false;
   }
@@ -1109,6 +1114,26 @@ bool Importer::HandleVcpuUnblock(trace_ticks_t event_time, zx_koid_t thread, uin
   return true;
 }
 
+bool Importer::HandleVcpuInterrupt(trace_ticks_t event_time, zx_koid_t thread, uint32_t vector,
+                                   bool exit_avoided) {
+  // Report running totals of the interrupts sent by |thread| that did or did not need to force a
+  // VM exit of a running VCPU.
+  auto& counts = vcpu_interrupt_counts_[thread];
+  if (exit_avoided) {
+    counts.exits_avoided++;
+  } else {
+    counts.exits++;
+  }
+  trace_arg_t args[] = {
+      trace_make_arg(exits_name_ref_, trace_make_int64_arg_value(counts.exits)),
+      trace_make_arg(exits_avoided_name_ref_, trace_make_int64_arg_value(counts.exits_avoided)),
+  };
+  trace_thread_ref_t thread_ref = GetThreadRef(thread);
+  trace_context_write_counter_event_record(context_, event_time, &thread_ref, &vcpu_category_ref_,
+                                           &vcpu_interrupts_name_ref_, 0u, args, std::size(args));
+  return true;
+}
+
 bool Importer::HandleDurationBegin(trace_ticks_t event_time, zx_koid_t thread,
                                    uint32_t event_name_id, uint32_t group, bool cpu_trace) {
   trace_thread_ref_t thread_ref =
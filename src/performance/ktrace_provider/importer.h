@@ -144,6 +144,8 @@ class Importer {
                       uint64_t exit_address);
   bool HandleVcpuBlock(trace_ticks_t event_time, zx_koid_t thread, uint32_t meta);
   bool HandleVcpuUnblock(trace_ticks_t event_time, zx_koid_t thread, uint32_t meta);
+  bool HandleVcpuInterrupt(trace_ticks_t event_time, zx_koid_t thread, uint32_t vector,
+                           bool exit_avoided);
 
   struct CpuInfo {
     zx_koid_t current_thread = ZX_KOID_INVALID;
@@ -187,6 +189,9 @@ class Importer {
   trace_string_ref_t const vaddr_name_ref_;
   trace_string_ref_t const flags_name_ref_;
   trace_string_ref_t const exit_address_name_ref_;
+  trace_string_ref_t const vcpu_interrupts_name_ref_;
+  trace_string_ref_t const exits_name_ref_;
+  trace_string_ref_t const exits_avoided_name_ref_;
   trace_string_ref_t const arg0_name_ref_;
   trace_string_ref_t const arg1_name_ref_;
   trace_string_ref_t const inherit_prio_name_ref_;
@@ -231,6 +236,12 @@ class Importer {
   };
   std::unordered_map<zx_koid_t, VcpuDuration> vcpu_durations_;
 
+  struct VcpuInterruptCounts {
+    int64_t exits = 0;
+    int64_t exits_avoided = 0;
+  };
+  std::unordered_map<zx_koid_t, VcpuInterruptCounts> vcpu_interrupt_counts_;
+
   struct SyscallDuration {
     trace_ticks_t begin;
     uint32_t syscall;
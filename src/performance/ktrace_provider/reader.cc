@@ -8,6 +8,14 @@
 #include <lib/zircon-internal/ktrace.h>
 #include <zircon/assert.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <queue>
+#include <utility>
+
 namespace ktrace_provider {
 
 Reader::Reader(const char* buffer, size_t buffer_size)
@@ -61,4 +69,178 @@ const ktrace_header_t* Reader::ReadNextRecord() {
   return record;
 }
 
+std::vector<uint8_t> MergeCpuBlocks(const uint8_t* data, size_t size) {
+  CpuBlockMerger merger(
+      [data, size](size_t offset, size_t count, uint8_t* buffer) {
+        count = offset < size ? std::min(count, size - offset) : 0;
+        memcpy(buffer, data + offset, count);
+        return count;
+      },
+      size);
+
+  std::vector<uint8_t> merged(size);
+  merged.resize(merger.Read(merged.data(), merged.size()));
+  return merged;
+}
+
+CpuBlockMerger::CpuBlockMerger(ReadAt read_at, size_t chunk_size)
+    : read_at_(std::move(read_at)), chunk_size_(chunk_size) {}
+
+void CpuBlockMerger::Index() {
+  // Stream 0 holds the records written outside of any block, the others hold
+  // the records of the blocks of one CPU each.
+  streams_.resize(1);
+  std::map<uint32_t, size_t> cpu_streams;
+  size_t block_stream = 0;
+  size_t block_end = 0;
+  size_t segment_start = 0;
+
+  std::vector<uint8_t> chunk(chunk_size_);
+  size_t chunk_offset = 0;
+  size_t chunk_size = 0;
+  size_t offset = 0;
+  auto end_segment = [&]() {
+    if (offset > segment_start) {
+      streams_[block_stream].segments.emplace_back(segment_start, offset);
+    }
+    segment_start = offset;
+  };
+
+  while (true) {
+    if (offset + sizeof(ktrace_header_t) > chunk_offset + chunk_size) {
+      // Start a new chunk at the record, so that it's read in whole.
+      chunk_offset = offset;
+      chunk_size = read_at_(chunk_offset, chunk.size(), chunk.data());
+      if (chunk_size < sizeof(ktrace_header_t)) {
+        break;
+      }
+    }
+    auto record = reinterpret_cast<const ktrace_header_t*>(chunk.data() + offset - chunk_offset);
+    const uint32_t len = KTRACE_LEN(record->tag);
+    if (!len || len > chunk_size_) {
+      FX_LOGS(WARNING) << "Found bad record at offset " << offset << ", merge stopped.";
+      break;
+    }
+    if (offset + len > chunk_offset + chunk_size) {
+      chunk_offset = offset;
+      chunk_size = read_at_(chunk_offset, chunk.size(), chunk.data());
+      if (chunk_size < len) {
+        // The trace ends part way through the record.
+        break;
+      }
+      record = reinterpret_cast<const ktrace_header_t*>(chunk.data());
+    }
+
+    if (block_stream != 0 && offset >= block_end) {
+      end_segment();
+      block_stream = 0;
+    }
+
+    if (KTRACE_GROUP(record->tag) == 0 && KTRACE_EVENT(record->tag) == KTRACE_EVENT_CPU_BLOCK &&
+        len == sizeof(ktrace_header_t)) {
+      end_segment();
+      auto [it, inserted] = cpu_streams.try_emplace(record->tid, streams_.size());
+      if (inserted) {
+        streams_.emplace_back();
+      }
+      block_stream = it->second;
+      block_end = offset + std::min<uint64_t>(record->ts, SIZE_MAX - offset);
+    }
+    offset += len;
+  }
+  end_segment();
+
+  for (size_t i = 0; i < streams_.size(); ++i) {
+    if (!streams_[i].segments.empty()) {
+      streams_[i].offset = streams_[i].segments[0].first;
+    }
+    PushHead(i);
+  }
+}
+
+void CpuBlockMerger::Fill(Stream& stream, size_t offset) {
+  stream.chunk.resize(chunk_size_);
+  stream.chunk.resize(read_at_(offset, chunk_size_, stream.chunk.data()));
+  stream.chunk_offset = offset;
+}
+
+const ktrace_header_t* CpuBlockMerger::Peek(Stream& stream) {
+  while (stream.segment < stream.segments.size()) {
+    const auto [start, end] = stream.segments[stream.segment];
+    if (stream.offset >= end) {
+      if (++stream.segment < stream.segments.size()) {
+        stream.offset = stream.segments[stream.segment].first;
+      }
+      continue;
+    }
+
+    // The indexing pass checked that each record of the segments is whole.
+    if (stream.offset < stream.chunk_offset ||
+        stream.offset + sizeof(ktrace_header_t) > stream.chunk_offset + stream.chunk.size()) {
+      Fill(stream, stream.offset);
+    }
+    auto record = reinterpret_cast<const ktrace_header_t*>(stream.chunk.data() + stream.offset -
+                                                           stream.chunk_offset);
+    const uint32_t len = KTRACE_LEN(record->tag);
+    if (stream.offset + len > stream.chunk_offset + stream.chunk.size()) {
+      Fill(stream, stream.offset);
+      record = reinterpret_cast<const ktrace_header_t*>(stream.chunk.data());
+      if (stream.chunk.size() < len) {
+        // The trace changed since it was indexed.
+        stream.segment = stream.segments.size();
+        return nullptr;
+      }
+    }
+
+    // Block headers and padding are dropped.
+    if (KTRACE_GROUP(record->tag) == 0) {
+      stream.offset += len;
+      continue;
+    }
+    return record;
+  }
+  return nullptr;
+}
+
+void CpuBlockMerger::PushHead(size_t index) {
+  Stream& stream = streams_[index];
+  const ktrace_header_t* record = Peek(stream);
+  if (!record) {
+    return;
+  }
+  // Metadata and FXT records do not carry a ktrace timestamp, so they sort
+  // along with the record written before them on the same stream.
+  if (!(KTRACE_GROUP(record->tag) & (KTRACE_GRP_META | KTRACE_GRP_FXT))) {
+    stream.last_key = record->ts;
+  }
+  heads_.emplace(stream.last_key, index);
+}
+
+size_t CpuBlockMerger::Read(uint8_t* buffer, size_t size) {
+  if (!indexed_) {
+    indexed_ = true;
+    Index();
+  }
+
+  // Merge the streams, preferring the lower numbered stream on ties so that
+  // the records from outside of any block come first.
+  size_t copied = 0;
+  while (!heads_.empty()) {
+    const size_t index = heads_.top().second;
+    Stream& stream = streams_[index];
+    const ktrace_header_t* record = Peek(stream);
+    const uint32_t len = KTRACE_LEN(record->tag);
+    if (len > size - copied) {
+      break;
+    }
+    heads_.pop();
+
+    memcpy(buffer + copied, record, len);
+    copied += len;
+    stream.offset += len;
+    PushHead(index);
+  }
+  return copied;
+}
+
 }  // namespace ktrace_provider
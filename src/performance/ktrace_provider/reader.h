@@ -7,7 +7,11 @@
 
 #include <lib/zircon-internal/ktrace.h>
 
+#include <functional>
 #include <iterator>
+#include <queue>
+#include <utility>
+#include <vector>
 
 #include <fbl/unique_fd.h>
 
@@ -40,6 +44,64 @@ class Reader {
   Reader& operator=(Reader&&) = delete;
 };
 
+// Reorders the records of a complete trace which has been read out of the
+// kernel so that the records of the blocks written by each CPU (see
+// KTRACE_EVENT_CPU_BLOCK) are interleaved with each other, and with the records
+// written outside of any block, in timestamp order.  The records of each block
+// stay in the order they were written in.  Block headers and padding records
+// are dropped.
+std::vector<uint8_t> MergeCpuBlocks(const uint8_t* data, size_t size);
+
+// Produces the same records as |MergeCpuBlocks| while holding no more than a
+// chunk of the trace per stream in memory.  The trace is fetched through
+// |read_at|, which reads up to |size| bytes at |offset| into |buffer| and
+// returns the number read, or zero at the end of the trace.  The trace is read
+// twice: once to find the blocks of each CPU and once to merge them.
+class CpuBlockMerger {
+ public:
+  using ReadAt = std::function<size_t(size_t offset, size_t size, uint8_t* buffer)>;
+
+  CpuBlockMerger(ReadAt read_at, size_t chunk_size);
+
+  // Copies as many whole merged records as fit into |buffer|, and returns the
+  // number of bytes copied.  Returns zero once all records have been copied.
+  size_t Read(uint8_t* buffer, size_t size);
+
+ private:
+  // The records of one stream, which are in timestamp order.
+  struct Stream {
+    // The byte ranges of the trace which hold the stream's records.
+    std::vector<std::pair<size_t, size_t>> segments;
+    size_t segment = 0;
+    size_t offset = 0;
+    uint64_t last_key = 0;
+
+    // The part of the trace which has been read in for the stream.
+    std::vector<uint8_t> chunk;
+    size_t chunk_offset = 0;
+  };
+  using Head = std::pair<uint64_t, size_t>;
+
+  // Finds the segments of each stream.
+  void Index();
+
+  // Makes the next record of |stream| available in its chunk, and returns it,
+  // or returns null if the stream has none left.
+  const ktrace_header_t* Peek(Stream& stream);
+
+  // Reads the part of the trace at |offset| into the chunk of |stream|.
+  void Fill(Stream& stream, size_t offset);
+
+  // Pushes a head for the next record of the stream at |index|, if it has one.
+  void PushHead(size_t index);
+
+  ReadAt read_at_;
+  const size_t chunk_size_;
+  bool indexed_ = false;
+  std::vector<Stream> streams_;
+  std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heads_;
+};
+
 }  // namespace ktrace_provider
 
 #endif  // SRC_PERFORMANCE_KTRACE_PROVIDER_READER_H_
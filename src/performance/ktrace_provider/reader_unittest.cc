@@ -0,0 +1,137 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/performance/ktrace_provider/reader.h"
+
+#include <lib/zircon-internal/ktrace.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace ktrace_provider {
+namespace {
+
+class TraceBuilder {
+ public:
+  void Record(uint32_t group, uint32_t event, uint32_t tid, uint64_t ts) {
+    Append(ktrace_header_t{.tag = KTRACE_TAG(event, group, 16), .tid = tid, .ts = ts});
+  }
+
+  void Block(uint32_t cpu, uint64_t size) { Record(0, KTRACE_EVENT_CPU_BLOCK, cpu, size); }
+  void Padding() { Record(0, 0, 0, 0); }
+
+  const std::vector<ktrace_header_t>& records() const { return records_; }
+  const uint8_t* data() const { return reinterpret_cast<const uint8_t*>(records_.data()); }
+  size_t size() const { return records_.size() * sizeof(ktrace_header_t); }
+
+ private:
+  void Append(const ktrace_header_t& record) { records_.push_back(record); }
+
+  std::vector<ktrace_header_t> records_;
+};
+
+std::vector<ktrace_header_t> Merge(const TraceBuilder& builder) {
+  std::vector<uint8_t> merged = MergeCpuBlocks(builder.data(), builder.size());
+  EXPECT_EQ(0u, merged.size() % sizeof(ktrace_header_t));
+  const auto* records = reinterpret_cast<const ktrace_header_t*>(merged.data());
+  return {records, records + merged.size() / sizeof(ktrace_header_t)};
+}
+
+TEST(ReaderTest, MergeWithoutCpuBlocks) {
+  TraceBuilder builder;
+  builder.Record(KTRACE_GRP_META, 1, 0, 0);
+  builder.Record(KTRACE_GRP_SCHEDULER, 2, 1, 20);
+  builder.Padding();
+  builder.Record(KTRACE_GRP_SCHEDULER, 3, 2, 10);
+
+  // Without blocks all of the records are in a single stream, which keeps the
+  // order they were written in.
+  std::vector<ktrace_header_t> merged = Merge(builder);
+  ASSERT_EQ(3u, merged.size());
+  EXPECT_EQ(1u, KTRACE_EVENT(merged[0].tag));
+  EXPECT_EQ(2u, KTRACE_EVENT(merged[1].tag));
+  EXPECT_EQ(3u, KTRACE_EVENT(merged[2].tag));
+}
+
+TEST(ReaderTest, MergeCpuBlocks) {
+  constexpr uint64_t kBlockSize = 4 * sizeof(ktrace_header_t);
+
+  TraceBuilder builder;
+  builder.Record(KTRACE_GRP_META, 1, 0, 0);
+  builder.Block(0, kBlockSize);
+  builder.Record(KTRACE_GRP_SCHEDULER, 2, 0, 10);
+  builder.Record(KTRACE_GRP_META, 3, 0, 0);
+  builder.Record(KTRACE_GRP_SCHEDULER, 4, 0, 30);
+  builder.Block(1, kBlockSize);
+  builder.Record(KTRACE_GRP_SCHEDULER, 5, 1, 20);
+  builder.Record(KTRACE_GRP_SCHEDULER, 6, 1, 40);
+  builder.Padding();
+  builder.Record(KTRACE_GRP_SCHEDULER, 7, 2, 25);
+  builder.Block(0, kBlockSize);
+  builder.Record(KTRACE_GRP_SCHEDULER, 8, 0, 50);
+  builder.Padding();
+  builder.Padding();
+
+  // Metadata without a timestamp sorts with the record before it on the same
+  // CPU, and records from outside of any block come first on ties.
+  std::vector<ktrace_header_t> merged = Merge(builder);
+  const uint32_t kExpectedEvents[] = {1, 2, 3, 5, 7, 4, 6, 8};
+  ASSERT_EQ(std::size(kExpectedEvents), merged.size());
+  for (size_t i = 0; i < merged.size(); ++i) {
+    EXPECT_EQ(kExpectedEvents[i], KTRACE_EVENT(merged[i].tag)) << "record " << i;
+  }
+}
+
+TEST(ReaderTest, MergeInChunks) {
+  constexpr uint64_t kBlockSize = 4 * sizeof(ktrace_header_t);
+  // Chunks which don't hold a whole number of records.
+  constexpr size_t kChunkSize = 2 * sizeof(ktrace_header_t) + 8;
+
+  TraceBuilder builder;
+  builder.Record(KTRACE_GRP_META, 1, 0, 0);
+  builder.Block(0, kBlockSize);
+  builder.Record(KTRACE_GRP_SCHEDULER, 2, 0, 10);
+  builder.Record(KTRACE_GRP_META, 3, 0, 0);
+  builder.Record(KTRACE_GRP_SCHEDULER, 4, 0, 30);
+  builder.Block(1, kBlockSize);
+  builder.Record(KTRACE_GRP_SCHEDULER, 5, 1, 20);
+  builder.Record(KTRACE_GRP_SCHEDULER, 6, 1, 40);
+  builder.Padding();
+  builder.Record(KTRACE_GRP_SCHEDULER, 7, 2, 25);
+  builder.Block(0, kBlockSize);
+  builder.Record(KTRACE_GRP_SCHEDULER, 8, 0, 50);
+  builder.Padding();
+  builder.Padding();
+
+  size_t largest_read = 0;
+  CpuBlockMerger merger(
+      [&](size_t offset, size_t size, uint8_t* buffer) {
+        largest_read = std::max(largest_read, size);
+        size = offset < builder.size() ? std::min(size, builder.size() - offset) : 0;
+        memcpy(buffer, builder.data() + offset, size);
+        return size;
+      },
+      kChunkSize);
+
+  // Read the merged records out a few at a time, like DeviceReader does.
+  std::vector<ktrace_header_t> merged;
+  ktrace_header_t records[3];
+  while (size_t size = merger.Read(reinterpret_cast<uint8_t*>(records), sizeof(records))) {
+    ASSERT_EQ(0u, size % sizeof(ktrace_header_t));
+    merged.insert(merged.end(), records, records + size / sizeof(ktrace_header_t));
+  }
+  EXPECT_LE(largest_read, kChunkSize);
+
+  const std::vector<ktrace_header_t> expected = Merge(builder);
+  ASSERT_EQ(expected.size(), merged.size());
+  for (size_t i = 0; i < merged.size(); ++i) {
+    EXPECT_EQ(KTRACE_EVENT(expected[i].tag), KTRACE_EVENT(merged[i].tag)) << "record " << i;
+  }
+}
+
+}  // namespace
+}  // namespace ktrace_provider
@@ -0,0 +1,247 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/performance/lib/heap_profiler/heap_profiler.h"
+
+#include <math.h>
+#include <zircon/sanitizer.h>
+
+#include <algorithm>
+#include <string>
+
+// From compiler-rt/include/sanitizer/allocator_interface.h. This is weak so that the hooks are only
+// used when a sanitizer runtime provides them.
+extern "C" __attribute__((weak)) int __sanitizer_install_malloc_and_free_hooks(  // NOLINT
+    void (*malloc_hook)(const volatile void*, size_t), void (*free_hook)(const volatile void*));
+
+namespace heap_profiler {
+namespace {
+
+// Per-thread sampling state. These are plain values so that accessing them never allocates.
+thread_local int64_t t_bytes_until_sample = 0;
+thread_local uint64_t t_random_state = 0;
+
+std::atomic<uint64_t> g_random_seed = 0;
+
+// Returns a random number in (0, 1].
+double NextRandom() {
+  if (t_random_state == 0) {
+    t_random_state = g_random_seed.fetch_add(0x9e3779b97f4a7c15, std::memory_order_relaxed) |
+                     reinterpret_cast<uintptr_t>(&t_random_state) | 1;
+  }
+  // xorshift64*.
+  t_random_state ^= t_random_state >> 12;
+  t_random_state ^= t_random_state << 25;
+  t_random_state ^= t_random_state >> 27;
+  uint64_t value = t_random_state * 0x2545f4914f6cdd1d;
+  return static_cast<double>((value >> 11) + 1) / static_cast<double>(uint64_t{1} << 53);
+}
+
+// Returns the number of bytes to allocate before the next sample. This is exponentially
+// distributed, which makes every byte allocated equally likely to be sampled.
+int64_t NextSampleDistance(double interval) {
+  return static_cast<int64_t>(-log(NextRandom()) * interval) + 1;
+}
+
+uint64_t HashAddress(uintptr_t address) {
+  // Allocations are aligned and often evenly spaced, so take the well mixed high bits of the
+  // product rather than its low bits.
+  return (address * 0x9e3779b97f4a7c15) >> 32;
+}
+
+uint64_t HashFrames(const uintptr_t* frames, size_t frame_count) {
+  uint64_t hash = 0xcbf29ce484222325;
+  for (size_t i = 0; i < frame_count; ++i) {
+    hash = (hash ^ frames[i]) * 0x100000001b3;
+  }
+  return hash;
+}
+
+HeapProfiler* g_hooked_profiler = nullptr;
+
+void MallocHook(const volatile void* ptr, size_t size) {
+  g_hooked_profiler->RecordAllocation(ptr, size);
+}
+
+void FreeHook(const volatile void* ptr) { g_hooked_profiler->RecordFree(ptr); }
+
+}  // namespace
+
+HeapProfiler::HeapProfiler(size_t sample_interval_bytes)
+    : sample_interval_bytes_(sample_interval_bytes) {}
+
+bool HeapProfiler::ShouldSample(size_t size, uint64_t* weight) {
+  if (sample_interval_bytes_ == 0) {
+    *weight = size;
+    return true;
+  }
+  double interval = static_cast<double>(sample_interval_bytes_);
+  if (t_random_state == 0) {
+    // This is the first allocation on this thread.
+    t_bytes_until_sample = NextSampleDistance(interval);
+  }
+  t_bytes_until_sample -= static_cast<int64_t>(size);
+  if (t_bytes_until_sample > 0) {
+    return false;
+  }
+  t_bytes_until_sample = NextSampleDistance(interval);
+  // An allocation of |size| bytes is sampled with probability 1 - exp(-size / interval), so it
+  // stands for |size| divided by that many bytes.
+  double probability = -expm1(-static_cast<double>(size) / interval);
+  *weight = static_cast<uint64_t>(static_cast<double>(size) / probability);
+  return true;
+}
+
+void HeapProfiler::RecordAllocation(const volatile void* ptr, size_t size) {
+  uint64_t weight;
+  if (ptr == nullptr || !ShouldSample(size, &weight)) {
+    return;
+  }
+  uintptr_t frames[kMaxFrames + 1];
+  size_t frame_count = __sanitizer_fast_backtrace(frames, kMaxFrames + 1);
+  // Skip this function's own frame.
+  size_t skip = std::min<size_t>(frame_count, 1);
+  AddSample(reinterpret_cast<uintptr_t>(ptr), weight, frames + skip, frame_count - skip);
+}
+
+void HeapProfiler::RecordAllocationWithStack(const volatile void* ptr, size_t size,
+                                             const uintptr_t* frames, size_t frame_count) {
+  uint64_t weight;
+  if (ptr == nullptr || !ShouldSample(size, &weight)) {
+    return;
+  }
+  AddSample(reinterpret_cast<uintptr_t>(ptr), weight, frames, std::min(frame_count, kMaxFrames));
+}
+
+void HeapProfiler::AddSample(uintptr_t address, uint64_t weight, const uintptr_t* frames,
+                             size_t frame_count) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  uint32_t call_site_index = FindOrAddCallSite(frames, frame_count);
+  if (call_site_index == kMaxCallSites) {
+    dropped_samples_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  const uint64_t hash = HashAddress(address);
+  for (size_t probe = 0; probe < kMaxProbes; ++probe) {
+    LiveSample& slot = live_samples_[(hash + probe) % kMaxLiveSamples];
+    uintptr_t current = slot.address.load(std::memory_order_relaxed);
+    if (current != 0 && current != kTombstone) {
+      continue;
+    }
+    slot.call_site = call_site_index;
+    slot.weight = weight;
+    // Publish the address last, since |RecordFree()| looks for it without the lock.
+    slot.address.store(address, std::memory_order_release);
+    live_sample_count_.fetch_add(1, std::memory_order_relaxed);
+
+    CallSite& call_site = call_sites_[call_site_index].call_site;
+    call_site.live_bytes += weight;
+    ++call_site.live_samples;
+    return;
+  }
+  dropped_samples_.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint32_t HeapProfiler::FindOrAddCallSite(const uintptr_t* frames, size_t frame_count) {
+  const uint64_t hash = HashFrames(frames, frame_count);
+  for (size_t probe = 0; probe < kMaxCallSites; ++probe) {
+    const uint32_t index = static_cast<uint32_t>((hash + probe) % kMaxCallSites);
+    CallSiteSlot& slot = call_sites_[index];
+    if (!slot.used) {
+      slot.used = true;
+      slot.hash = hash;
+      std::copy(frames, frames + frame_count, slot.call_site.frames);
+      slot.call_site.frame_count = frame_count;
+      return index;
+    }
+    if (slot.hash == hash && slot.call_site.frame_count == frame_count &&
+        std::equal(frames, frames + frame_count, slot.call_site.frames)) {
+      return index;
+    }
+  }
+  return kMaxCallSites;
+}
+
+void HeapProfiler::RecordFree(const volatile void* ptr) {
+  if (live_sample_count_.load(std::memory_order_relaxed) == 0 || ptr == nullptr) {
+    return;
+  }
+  const uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+  const uint64_t hash = HashAddress(address);
+  for (size_t probe = 0; probe < kMaxProbes; ++probe) {
+    LiveSample& slot = live_samples_[(hash + probe) % kMaxLiveSamples];
+    uintptr_t current = slot.address.load(std::memory_order_acquire);
+    if (current == 0) {
+      // Samples are never placed beyond an empty slot, so this wasn't sampled.
+      return;
+    }
+    if (current != address) {
+      continue;
+    }
+    // Only this thread can be freeing |ptr|, so the slot can't change before the lock is taken.
+    std::lock_guard<std::mutex> lock(mutex_);
+    CallSite& call_site = call_sites_[slot.call_site].call_site;
+    call_site.live_bytes -= slot.weight;
+    --call_site.live_samples;
+    slot.address.store(kTombstone, std::memory_order_relaxed);
+    live_sample_count_.fetch_sub(1, std::memory_order_relaxed);
+    return;
+  }
+}
+
+std::vector<HeapProfiler::CallSite> HeapProfiler::GetLiveCallSites() const {
+  std::vector<CallSite> call_sites;
+  // Reserve up front, so that nothing is allocated while the lock is held. An allocation then
+  // would call back into this profiler and deadlock.
+  call_sites.reserve(kMaxCallSites);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const CallSiteSlot& slot : call_sites_) {
+      if (slot.used && slot.call_site.live_samples > 0) {
+        call_sites.push_back(slot.call_site);
+      }
+    }
+  }
+  std::sort(call_sites.begin(), call_sites.end(), [](const CallSite& a, const CallSite& b) {
+    return a.live_bytes > b.live_bytes;
+  });
+  return call_sites;
+}
+
+void HeapProfiler::RecordInspect(inspect::Node& node) const {
+  node.RecordUint("sample_interval_bytes", sample_interval_bytes_);
+  node.RecordUint("dropped_samples", dropped_samples());
+  std::vector<CallSite> call_sites = GetLiveCallSites();
+  uint64_t live_bytes = 0;
+  for (const CallSite& call_site : call_sites) {
+    live_bytes += call_site.live_bytes;
+  }
+  node.RecordUint("live_bytes", live_bytes);
+  node.RecordChild("call_sites", [&call_sites](inspect::Node& call_sites_node) {
+    for (size_t i = 0; i < call_sites.size(); ++i) {
+      const CallSite& call_site = call_sites[i];
+      call_sites_node.RecordChild(std::to_string(i), [&call_site](inspect::Node& call_site_node) {
+        call_site_node.RecordUint("live_bytes", call_site.live_bytes);
+        call_site_node.RecordUint("live_samples", call_site.live_samples);
+        inspect::UintArray frames =
+            call_site_node.CreateUintArray("frames", call_site.frame_count);
+        for (size_t j = 0; j < call_site.frame_count; ++j) {
+          frames.Set(j, call_site.frames[j]);
+        }
+        call_site_node.Record(std::move(frames));
+      });
+    }
+  });
+}
+
+bool InstallAllocatorHooks(HeapProfiler* profiler) {
+  if (!__sanitizer_install_malloc_and_free_hooks) {
+    return false;
+  }
+  g_hooked_profiler = profiler;
+  return __sanitizer_install_malloc_and_free_hooks(MallocHook, FreeHook) != 0;
+}
+
+}  // namespace heap_profiler
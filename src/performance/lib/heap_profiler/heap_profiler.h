@@ -0,0 +1,119 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SRC_PERFORMANCE_LIB_HEAP_PROFILER_HEAP_PROFILER_H_
+#define SRC_PERFORMANCE_LIB_HEAP_PROFILER_HEAP_PROFILER_H_
+
+#include <lib/inspect/cpp/vmo/types.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <zircon/compiler.h>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace heap_profiler {
+
+// Samples heap allocations and records the call stacks of those which are still live, so that the
+// call sites responsible for most of a long-running process's heap can be found.
+//
+// On average one allocation is sampled for every |sample_interval_bytes| bytes allocated, so large
+// allocations are more likely to be sampled than small ones. Each sample is weighted by the number
+// of bytes it stands for, which makes the reported sizes estimates of the live heap allocated at
+// each call site. An interval of zero samples every allocation.
+//
+// |RecordAllocation()| and |RecordFree()| are meant to be called from an allocator's hooks, so they
+// never allocate: there is room for a fixed number of live samples and call sites, and samples
+// which don't fit are dropped (and counted). Freeing an allocation which wasn't sampled, which is
+// by far the common case, doesn't take any locks.
+class HeapProfiler {
+ public:
+  static constexpr size_t kDefaultSampleIntervalBytes = 512 * 1024;
+  static constexpr size_t kMaxFrames = 16;
+  static constexpr size_t kMaxLiveSamples = 4096;
+  static constexpr size_t kMaxCallSites = 1024;
+
+  struct CallSite {
+    uintptr_t frames[kMaxFrames];
+    size_t frame_count;
+    // The estimated number of bytes allocated by this call site which are still live.
+    uint64_t live_bytes;
+    uint64_t live_samples;
+  };
+
+  explicit HeapProfiler(size_t sample_interval_bytes = kDefaultSampleIntervalBytes);
+
+  HeapProfiler(const HeapProfiler&) = delete;
+  HeapProfiler& operator=(const HeapProfiler&) = delete;
+
+  size_t sample_interval_bytes() const { return sample_interval_bytes_; }
+
+  // Records an allocation of |size| bytes at |ptr|, which may or may not be sampled.
+  void RecordAllocation(const volatile void* ptr, size_t size);
+
+  // Records that |ptr| has been freed. This must be called before the memory can be reused.
+  void RecordFree(const volatile void* ptr);
+
+  // Like |RecordAllocation()|, but with the call stack given rather than collected here, for
+  // callers which have one already.
+  void RecordAllocationWithStack(const volatile void* ptr, size_t size, const uintptr_t* frames,
+                                 size_t frame_count);
+
+  // Returns the call sites which have live samples, with the most live bytes first.
+  std::vector<CallSite> GetLiveCallSites() const;
+
+  // The number of samples which were dropped because there was no room for them.
+  uint64_t dropped_samples() const { return dropped_samples_.load(std::memory_order_relaxed); }
+
+  // Records the live call sites as children of |node|, e.g. from a lazy node's callback. Frames are
+  // recorded as PCs, which can be symbolized with the process's module layout.
+  void RecordInspect(inspect::Node& node) const;
+
+ private:
+  struct LiveSample {
+    // Zero if the slot is empty, or |kTombstone| if it was emptied.
+    std::atomic<uintptr_t> address;
+    uint32_t call_site;
+    uint64_t weight;
+  };
+
+  struct CallSiteSlot {
+    bool used;
+    uint64_t hash;
+    CallSite call_site;
+  };
+
+  static constexpr uintptr_t kTombstone = 1;
+  // The number of slots of |live_samples_| which may be probed for an address.
+  static constexpr size_t kMaxProbes = 16;
+
+  // Returns whether this allocation should be sampled and, if so, the number of bytes it stands for.
+  bool ShouldSample(size_t size, uint64_t* weight);
+
+  // Adds a sample standing for |weight| bytes to the live samples.
+  void AddSample(uintptr_t address, uint64_t weight, const uintptr_t* frames, size_t frame_count);
+
+  // Returns the index of the slot of |call_sites_| for this stack, or |kMaxCallSites| if full.
+  uint32_t FindOrAddCallSite(const uintptr_t* frames, size_t frame_count) __TA_REQUIRES(mutex_);
+
+  const size_t sample_interval_bytes_;
+  std::atomic<uint64_t> dropped_samples_ = 0;
+  // The number of non-empty slots of |live_samples_|, which lets frees skip the table when it's
+  // empty.
+  std::atomic<size_t> live_sample_count_ = 0;
+
+  mutable std::mutex mutex_;
+  LiveSample live_samples_[kMaxLiveSamples] = {};
+  CallSiteSlot call_sites_[kMaxCallSites] __TA_GUARDED(mutex_) = {};
+};
+
+// Installs hooks which record every allocation and free of the process in |profiler|, which must
+// outlive the process. This uses the allocator hooks provided by the sanitizer runtimes, and
+// returns false if the current runtime doesn't provide them.
+bool InstallAllocatorHooks(HeapProfiler* profiler);
+
+}  // namespace heap_profiler
+
+#endif  // SRC_PERFORMANCE_LIB_HEAP_PROFILER_HEAP_PROFILER_H_
@@ -0,0 +1,120 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/performance/lib/heap_profiler/heap_profiler.h"
+
+#include <lib/inspect/cpp/hierarchy.h>
+#include <lib/inspect/cpp/inspector.h>
+#include <lib/inspect/cpp/reader.h>
+
+#include <iterator>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+namespace heap_profiler {
+namespace {
+
+constexpr uintptr_t kStackA[] = {0x1000, 0x2000, 0x3000};
+constexpr uintptr_t kStackB[] = {0x1000, 0x2000, 0x4000};
+
+void* Address(uintptr_t address) { return reinterpret_cast<void*>(address); }
+
+TEST(HeapProfilerTest, AttributesLiveBytesToCallSites) {
+  auto profiler = std::make_unique<HeapProfiler>(0);
+  profiler->RecordAllocationWithStack(Address(0x10000), 100, kStackA, std::size(kStackA));
+  profiler->RecordAllocationWithStack(Address(0x20000), 200, kStackB, std::size(kStackB));
+  profiler->RecordAllocationWithStack(Address(0x30000), 150, kStackA, std::size(kStackA));
+
+  std::vector<HeapProfiler::CallSite> call_sites = profiler->GetLiveCallSites();
+  ASSERT_EQ(call_sites.size(), 2u);
+  EXPECT_EQ(call_sites[0].live_bytes, 250u);
+  EXPECT_EQ(call_sites[0].live_samples, 2u);
+  ASSERT_EQ(call_sites[0].frame_count, std::size(kStackA));
+  EXPECT_EQ(call_sites[0].frames[2], kStackA[2]);
+  EXPECT_EQ(call_sites[1].live_bytes, 200u);
+  EXPECT_EQ(call_sites[1].frames[2], kStackB[2]);
+
+  profiler->RecordFree(Address(0x10000));
+  profiler->RecordFree(Address(0x30000));
+  call_sites = profiler->GetLiveCallSites();
+  ASSERT_EQ(call_sites.size(), 1u);
+  EXPECT_EQ(call_sites[0].frames[2], kStackB[2]);
+}
+
+TEST(HeapProfilerTest, IgnoresFreesOfUnsampledAllocations) {
+  auto profiler = std::make_unique<HeapProfiler>(0);
+  profiler->RecordFree(Address(0x10000));
+  profiler->RecordAllocationWithStack(Address(0x10000), 100, kStackA, std::size(kStackA));
+  profiler->RecordFree(Address(0x20000));
+  profiler->RecordFree(nullptr);
+
+  std::vector<HeapProfiler::CallSite> call_sites = profiler->GetLiveCallSites();
+  ASSERT_EQ(call_sites.size(), 1u);
+  EXPECT_EQ(call_sites[0].live_bytes, 100u);
+}
+
+TEST(HeapProfilerTest, ReusesSlotsOfFreedSamples) {
+  auto profiler = std::make_unique<HeapProfiler>(0);
+  for (uintptr_t i = 0; i < 4 * HeapProfiler::kMaxLiveSamples; ++i) {
+    profiler->RecordAllocationWithStack(Address(0x10000), 100, kStackA, std::size(kStackA));
+    profiler->RecordFree(Address(0x10000));
+  }
+  EXPECT_TRUE(profiler->GetLiveCallSites().empty());
+  EXPECT_EQ(profiler->dropped_samples(), 0u);
+}
+
+TEST(HeapProfilerTest, DropsSamplesWhenCallSitesAreFull) {
+  auto profiler = std::make_unique<HeapProfiler>(0);
+  for (uintptr_t i = 0; i <= HeapProfiler::kMaxCallSites; ++i) {
+    uintptr_t frame = 0x1000 + i;
+    profiler->RecordAllocationWithStack(Address(0x10000 + 16 * i), 100, &frame, 1);
+  }
+  EXPECT_EQ(profiler->GetLiveCallSites().size(), HeapProfiler::kMaxCallSites);
+  EXPECT_EQ(profiler->dropped_samples(), 1u);
+}
+
+TEST(HeapProfilerTest, EstimatesLiveBytesWhenSampling) {
+  constexpr size_t kSampleInterval = 8 * 1024;
+  constexpr size_t kAllocationSize = 1000;
+  constexpr size_t kAllocationCount = 10000;
+  auto profiler = std::make_unique<HeapProfiler>(kSampleInterval);
+  for (uintptr_t i = 0; i < kAllocationCount; ++i) {
+    profiler->RecordAllocationWithStack(Address(0x10000 + 1024 * i), kAllocationSize, kStackA,
+                                        std::size(kStackA));
+  }
+  ASSERT_EQ(profiler->dropped_samples(), 0u);
+
+  // About 1200 samples are expected, so the estimate should be well within 20%.
+  std::vector<HeapProfiler::CallSite> call_sites = profiler->GetLiveCallSites();
+  ASSERT_EQ(call_sites.size(), 1u);
+  const double expected = static_cast<double>(kAllocationSize * kAllocationCount);
+  EXPECT_GT(static_cast<double>(call_sites[0].live_bytes), expected * 0.8);
+  EXPECT_LT(static_cast<double>(call_sites[0].live_bytes), expected * 1.2);
+  EXPECT_LT(call_sites[0].live_samples, kAllocationCount / 4);
+}
+
+TEST(HeapProfilerTest, RecordInspect) {
+  auto profiler = std::make_unique<HeapProfiler>(0);
+  profiler->RecordAllocationWithStack(Address(0x10000), 100, kStackA, std::size(kStackA));
+
+  inspect::Inspector inspector;
+  profiler->RecordInspect(inspector.GetRoot());
+  fpromise::result<inspect::Hierarchy> result = inspect::ReadFromVmo(inspector.DuplicateVmo());
+  ASSERT_TRUE(result.is_ok());
+  const inspect::Hierarchy& root = result.value();
+
+  const auto* live_bytes = root.node().get_property<inspect::UintPropertyValue>("live_bytes");
+  ASSERT_NE(live_bytes, nullptr);
+  EXPECT_EQ(live_bytes->value(), 100u);
+  const inspect::Hierarchy* call_site = root.GetByPath({"call_sites", "0"});
+  ASSERT_NE(call_site, nullptr);
+  const auto* frames = call_site->node().get_property<inspect::UintArrayValue>("frames");
+  ASSERT_NE(frames, nullptr);
+  ASSERT_EQ(frames->value().size(), std::size(kStackA));
+  EXPECT_EQ(frames->value()[0], kStackA[0]);
+}
+
+}  // namespace
+}  // namespace heap_profiler
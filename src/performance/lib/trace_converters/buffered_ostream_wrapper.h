@@ -0,0 +1,58 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SRC_PERFORMANCE_LIB_TRACE_CONVERTERS_BUFFERED_OSTREAM_WRAPPER_H_
+#define SRC_PERFORMANCE_LIB_TRACE_CONVERTERS_BUFFERED_OSTREAM_WRAPPER_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <ostream>
+
+namespace tracing {
+
+// A rapidjson output stream which writes to a std::ostream in blocks.
+//
+// rapidjson::OStreamWrapper hands every character to std::ostream::put() on its own, which costs
+// far more than formatting it did. Nothing reaches the std::ostream until the buffer fills or
+// |Flush()| is called.
+class BufferedOStreamWrapper {
+ public:
+  using Ch = char;
+
+  static constexpr size_t kBufferSize = 64 * 1024;
+
+  explicit BufferedOStreamWrapper(std::ostream& stream)
+      : stream_(stream), buffer_(new Ch[kBufferSize]) {}
+  ~BufferedOStreamWrapper() { Flush(); }
+
+  void Put(Ch c) {
+    if (used_ == kBufferSize) {
+      WriteBuffer();
+    }
+    buffer_[used_++] = c;
+  }
+
+  void Flush() {
+    WriteBuffer();
+    stream_.flush();
+  }
+
+ private:
+  void WriteBuffer() {
+    stream_.write(buffer_.get(), static_cast<std::streamsize>(used_));
+    used_ = 0;
+  }
+
+  std::ostream& stream_;
+  std::unique_ptr<Ch[]> buffer_;
+  size_t used_ = 0;
+
+  BufferedOStreamWrapper(const BufferedOStreamWrapper&) = delete;
+  BufferedOStreamWrapper& operator=(const BufferedOStreamWrapper&) = delete;
+};
+
+}  // namespace tracing
+
+#endif  // SRC_PERFORMANCE_LIB_TRACE_CONVERTERS_BUFFERED_OSTREAM_WRAPPER_H_
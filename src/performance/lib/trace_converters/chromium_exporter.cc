@@ -10,6 +10,7 @@
 #include <lib/trace-engine/types.h>
 
 #include <utility>
+#include <vector>
 
 #include <third_party/modp_b64/modp_b64.h>
 #include <trace-reader/reader.h>
@@ -26,6 +27,19 @@ constexpr char kProcessArgKey[] = "process";
 constexpr zx_koid_t kNoProcess = 0u;
 constexpr uint32_t kUnicodeReplacementCharacter = 0xFFFD;
 
+// Context switch records are saved in this form until they can be emitted.
+struct SavedContextSwitch {
+  trace_ticks_t timestamp;
+  zx_koid_t outgoing_process_koid;
+  zx_koid_t outgoing_thread_koid;
+  zx_koid_t incoming_process_koid;
+  zx_koid_t incoming_thread_koid;
+  trace_cpu_number_t cpu_number;
+  trace_thread_state_t outgoing_thread_state;
+  trace_thread_priority_t outgoing_thread_priority;
+  trace_thread_priority_t incoming_thread_priority;
+};
+
 bool IsEventTypeSupported(trace::EventType type) {
   switch (type) {
     case trace::EventType::kInstant:
@@ -56,6 +70,17 @@ const trace::ArgumentValue* GetArgumentValue(const fbl::Vector<trace::Argument>&
   return nullptr;
 }
 
+// Whether |str| is plain ASCII, which is always valid UTF-8. This is by far the most common case,
+// and saves making a cleaned copy of the string.
+bool IsAscii(const fbl::String& str) {
+  for (char c : str) {
+    if (static_cast<unsigned char>(c) >= 0x80) {
+      return false;
+    }
+  }
+  return true;
+}
+
 // The JSON specification requires that the JSON is valid unicode. This function
 // replaces any invalid unicode sequences with the replacement character, so
 // that the output will be valid UTF-8, even if a trace provider gives us
@@ -123,7 +148,7 @@ void ChromiumExporter::Stop() {
     writer_.Key("pid");
     writer_.Uint64(process_koid);
     writer_.Key("name");
-    writer_.String(CleanString(name));
+    WriteString(name);
 
     if (process_koid == kNoProcess) {
       writer_.Key("sort_index");
@@ -145,25 +170,45 @@ void ChromiumExporter::Stop() {
       writer_.Key("tid");
       writer_.Uint64(thread_koid);
       writer_.Key("name");
-      writer_.String(CleanString(name));
+      WriteString(name);
       writer_.EndObject();
     }
   }
 
-  for (const auto& record : context_switch_records_) {
-    ExportContextSwitch(record);
+  context_switch_records_.StartReading();
+  SavedContextSwitch saved;
+  while (context_switch_records_.Read(&saved, sizeof(saved))) {
+    trace::Record::ContextSwitch context_switch{
+        .timestamp = saved.timestamp,
+        .cpu_number = saved.cpu_number,
+        .outgoing_thread_state = static_cast<trace::ThreadState>(saved.outgoing_thread_state),
+        .outgoing_thread =
+            trace::ProcessThread(saved.outgoing_process_koid, saved.outgoing_thread_koid),
+        .incoming_thread =
+            trace::ProcessThread(saved.incoming_process_koid, saved.incoming_thread_koid),
+        .outgoing_thread_priority = saved.outgoing_thread_priority,
+        .incoming_thread_priority = saved.incoming_thread_priority,
+    };
+    ExportContextSwitch(context_switch);
   }
 
   writer_.EndArray();
   writer_.EndObject();  // Finishes systemTraceEvents
 
-  if (last_branch_records_.size() > 0) {
+  if (!last_branch_records_.empty()) {
     writer_.Key("lastBranch");
     writer_.StartObject();
     writer_.Key("records");
     writer_.StartArray();
-    for (const auto record : last_branch_records_) {
-      ExportLastBranchBlob(*record);
+    last_branch_records_.StartReading();
+    size_t blob_size;
+    std::vector<uint64_t> blob;
+    while (last_branch_records_.Read(&blob_size, sizeof(blob_size))) {
+      blob.resize((blob_size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+      if (!last_branch_records_.Read(blob.data(), blob_size)) {
+        break;
+      }
+      ExportLastBranchBlob(*reinterpret_cast<const perfmon::LastBranchRecordBlob*>(blob.data()));
     }
     writer_.EndArray();
     writer_.EndObject();
@@ -191,8 +236,7 @@ void ChromiumExporter::ExportRecord(const trace::Record& record) {
     case trace::RecordType::kBlob: {
       const auto& blob = record.GetBlob();
       if (blob.type == TRACE_BLOB_TYPE_LAST_BRANCH) {
-        auto lbr = reinterpret_cast<const perfmon::LastBranchRecordBlob*>(blob.blob);
-        last_branch_records_.push_back(lbr);
+        SaveLastBranchBlob(blob);
       } else {
         // Drop the record.
         FX_LOGS(INFO) << "Dropping blob record: "
@@ -205,7 +249,7 @@ void ChromiumExporter::ExportRecord(const trace::Record& record) {
       break;
     case trace::RecordType::kContextSwitch:
       // We can't emit these into the regular stream, save them for later.
-      context_switch_records_.push_back(record.GetContextSwitch());
+      SaveContextSwitch(record.GetContextSwitch());
       break;
     case trace::RecordType::kString:
     case trace::RecordType::kThread:
@@ -231,9 +275,9 @@ void ChromiumExporter::ExportEvent(const trace::Record::Event& event) {
   writer_.StartObject();
 
   writer_.Key("cat");
-  writer_.String(CleanString(event.category));
+  WriteString(event.category);
   writer_.Key("name");
-  writer_.String(CleanString(event.name));
+  WriteString(event.name);
   writer_.Key("ts");
   writer_.Double(event.timestamp * tick_scale_);
   writer_.Key("pid");
@@ -415,7 +459,7 @@ void ChromiumExporter::ExportLog(const trace::Record::Log& log) {
   writer_.Key("args");
   writer_.StartObject();
   writer_.Key("message");
-  writer_.String(CleanString(log.message));
+  WriteString(log.message);
   writer_.EndObject();
   writer_.EndObject();
 }
@@ -471,6 +515,35 @@ void ChromiumExporter::ExportContextSwitch(const trace::Record::ContextSwitch& c
   writer_.EndObject();
 }
 
+void ChromiumExporter::SaveContextSwitch(const trace::Record::ContextSwitch& context_switch) {
+  const SavedContextSwitch saved{
+      .timestamp = context_switch.timestamp,
+      .outgoing_process_koid = context_switch.outgoing_thread.process_koid(),
+      .outgoing_thread_koid = context_switch.outgoing_thread.thread_koid(),
+      .incoming_process_koid = context_switch.incoming_thread.process_koid(),
+      .incoming_thread_koid = context_switch.incoming_thread.thread_koid(),
+      .cpu_number = context_switch.cpu_number,
+      .outgoing_thread_state =
+          static_cast<trace_thread_state_t>(context_switch.outgoing_thread_state),
+      .outgoing_thread_priority = context_switch.outgoing_thread_priority,
+      .incoming_thread_priority = context_switch.incoming_thread_priority,
+  };
+  context_switch_records_.Append(&saved, sizeof(saved));
+}
+
+void ChromiumExporter::SaveLastBranchBlob(const trace::Record::Blob& blob) {
+  if (blob.blob_size < perfmon::LastBranchRecordBlobSize(0) ||
+      blob.blob_size <
+          perfmon::LastBranchRecordBlobSize(
+              reinterpret_cast<const perfmon::LastBranchRecordBlob*>(blob.blob)->num_branches)) {
+    FX_LOGS(WARNING) << "Dropping truncated last branch record of size " << blob.blob_size;
+    return;
+  }
+  const size_t blob_size = blob.blob_size;
+  last_branch_records_.Append(&blob_size, sizeof(blob_size));
+  last_branch_records_.Append(blob.blob, blob_size);
+}
+
 void ChromiumExporter::ExportBlob(const trace::LargeRecordData::Blob& data) {
   if (cpp17::holds_alternative<trace::LargeRecordData::BlobEvent>(data)) {
     const auto& blob = cpp17::get<trace::LargeRecordData::BlobEvent>(data);
@@ -499,9 +572,9 @@ void ChromiumExporter::ExportFidlBlob(const trace::LargeRecordData::BlobEvent& b
   writer_.Key("id");
   writer_.String("");
   writer_.Key("cat");
-  writer_.String(CleanString(blob.category));
+  WriteString(blob.category);
   writer_.Key("name");
-  writer_.String(CleanString(blob.name));
+  WriteString(blob.name);
   writer_.Key("ts");
   writer_.Double(blob.timestamp * tick_scale_);
   writer_.Key("pid");
@@ -515,43 +588,59 @@ void ChromiumExporter::ExportFidlBlob(const trace::LargeRecordData::BlobEvent& b
   writer_.EndObject();
 }
 
+void ChromiumExporter::WriteKey(const fbl::String& str) {
+  if (IsAscii(str)) {
+    writer_.Key(str.data(), static_cast<rapidjson::SizeType>(str.length()));
+  } else {
+    writer_.Key(CleanString(str));
+  }
+}
+
+void ChromiumExporter::WriteString(const fbl::String& str) {
+  if (IsAscii(str)) {
+    writer_.String(str.data(), static_cast<rapidjson::SizeType>(str.length()));
+  } else {
+    writer_.String(CleanString(str));
+  }
+}
+
 void ChromiumExporter::WriteArgs(const fbl::Vector<trace::Argument>& arguments) {
   for (const auto& arg : arguments) {
     switch (arg.value().type()) {
       case trace::ArgumentType::kBool:
-        writer_.Key(CleanString(arg.name()));
+        WriteKey(arg.name());
         writer_.Bool(arg.value().GetBool());
         break;
       case trace::ArgumentType::kInt32:
-        writer_.Key(CleanString(arg.name()));
+        WriteKey(arg.name());
         writer_.Int(arg.value().GetInt32());
         break;
       case trace::ArgumentType::kUint32:
-        writer_.Key(CleanString(arg.name()));
+        WriteKey(arg.name());
         writer_.Uint(arg.value().GetUint32());
         break;
       case trace::ArgumentType::kInt64:
-        writer_.Key(CleanString(arg.name()));
+        WriteKey(arg.name());
         writer_.Int64(arg.value().GetInt64());
         break;
       case trace::ArgumentType::kUint64:
-        writer_.Key(CleanString(arg.name()));
+        WriteKey(arg.name());
         writer_.Uint64(arg.value().GetUint64());
         break;
       case trace::ArgumentType::kDouble:
-        writer_.Key(CleanString(arg.name()));
+        WriteKey(arg.name());
         writer_.Double(arg.value().GetDouble());
         break;
       case trace::ArgumentType::kString:
-        writer_.Key(CleanString(arg.name()));
-        writer_.String(CleanString(arg.value().GetString()));
+        WriteKey(arg.name());
+        WriteString(arg.value().GetString());
         break;
       case trace::ArgumentType::kPointer:
-        writer_.Key(CleanString(arg.name()));
+        WriteKey(arg.name());
         writer_.String(fxl::StringPrintf("0x%" PRIx64, arg.value().GetPointer()).c_str());
         break;
       case trace::ArgumentType::kKoid:
-        writer_.Key(CleanString(arg.name()));
+        WriteKey(arg.name());
         writer_.String(fxl::StringPrintf("#%" PRIu64, arg.value().GetKoid()).c_str());
         break;
       default:
@@ -9,13 +9,13 @@
 #include <ostream>
 #include <tuple>
 #include <unordered_map>
-#include <vector>
 
 #include <trace-reader/reader.h>
 
-#include "rapidjson/ostreamwrapper.h"
 #include "rapidjson/writer.h"
 #include "src/performance/lib/perfmon/writer.h"
+#include "src/performance/lib/trace_converters/buffered_ostream_wrapper.h"
+#include "src/performance/lib/trace_converters/spill_buffer.h"
 
 namespace tracing {
 
@@ -36,6 +36,8 @@ class ChromiumExporter {
   void ExportLog(const trace::Record::Log& log);
   void ExportMetadata(const trace::Record::Metadata& metadata);
   void ExportContextSwitch(const trace::Record::ContextSwitch& context_switch);
+  void SaveContextSwitch(const trace::Record::ContextSwitch& context_switch);
+  void SaveLastBranchBlob(const trace::Record::Blob& blob);
   void ExportBlob(const trace::LargeRecordData::Blob& blob);
   void ExportFidlBlob(const trace::LargeRecordData::BlobEvent& blob);
 
@@ -43,9 +45,13 @@ class ChromiumExporter {
   // "args" key object.
   void WriteArgs(const fbl::Vector<trace::Argument>& arguments);
 
+  // Write a string as a key or value, replacing any invalid UTF-8 in it.
+  void WriteKey(const fbl::String& str);
+  void WriteString(const fbl::String& str);
+
   std::unique_ptr<std::ostream> stream_out_;
-  rapidjson::OStreamWrapper wrapper_;
-  rapidjson::Writer<rapidjson::OStreamWrapper> writer_;
+  BufferedOStreamWrapper wrapper_;
+  rapidjson::Writer<BufferedOStreamWrapper> writer_;
 
   // Scale factor to get to microseconds.
   // By default ticks are in nanoseconds.
@@ -60,13 +66,15 @@ class ChromiumExporter {
 
   // The chromium/catapult trace file format doesn't support context switch
   // records, so we can't emit them inline. Save them for later emission to
-  // the systemTraceEvents section.
-  std::vector<trace::Record::ContextSwitch> context_switch_records_;
+  // the systemTraceEvents section. There can be millions of them, so they're
+  // kept in a SpillBuffer rather than in memory.
+  SpillBuffer context_switch_records_;
 
   // The chromium/catapult trace file format doesn't support random blobs,
-  // so we can't emit them inline. Save them for later emission.
+  // so we can't emit them inline. Save copies of them for later emission, as
+  // the reader reuses the memory they were read into.
   // LastBranch records will go to the lastBranch section.
-  std::vector<const perfmon::LastBranchRecordBlob*> last_branch_records_;
+  SpillBuffer last_branch_records_;
 };
 
 }  // namespace tracing
@@ -177,4 +177,26 @@ TEST(ChromiumExporterTest, LastBranchRecords) {
       "207}]}]}}");
 }
 
+TEST(ChromiumExporterTest, ContextSwitchRecords) {
+  trace::Record record(trace::Record::ContextSwitch{
+      1000, 2, trace::ThreadState::kBlocked, trace::ProcessThread(45, 46),
+      trace::ProcessThread(47, 48), 3, 4});
+
+  std::ostringstream out_stream;
+
+  // Enclosing the exporter in its own scope ensures that its
+  // cleanup routines are called by the destructor before the
+  // output stream is read. This way, we can obtain the full
+  // output rather than a truncated version.
+  {
+    tracing::ChromiumExporter exporter(out_stream);
+    exporter.ExportRecord(record);
+  }
+
+  EXPECT_EQ(out_stream.str(),
+            "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[],\"systemTraceEvents\":{\"type\":"
+            "\"fuchsia\",\"events\":[{\"ph\":\"k\",\"ts\":1.0,\"cpu\":2,\"out\":{\"pid\":45,"
+            "\"tid\":46,\"state\":3,\"prio\":3},\"in\":{\"pid\":47,\"tid\":48,\"prio\":4}}]}}");
+}
+
 }  // namespace
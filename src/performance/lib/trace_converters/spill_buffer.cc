@@ -0,0 +1,82 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/performance/lib/trace_converters/spill_buffer.h"
+
+#include <lib/syslog/cpp/macros.h>
+#include <string.h>
+
+namespace tracing {
+
+SpillBuffer::SpillBuffer(size_t memory_limit) : memory_limit_(memory_limit) {}
+
+SpillBuffer::~SpillBuffer() {
+  if (file_) {
+    fclose(file_);
+  }
+}
+
+void SpillBuffer::Append(const void* data, size_t size) {
+  FX_DCHECK(!reading_);
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  buffer_.insert(buffer_.end(), bytes, bytes + size);
+  size_ += size;
+  if (buffer_.size() >= memory_limit_ && !spill_failed_) {
+    Spill();
+  }
+}
+
+void SpillBuffer::Spill() {
+  if (!file_) {
+    file_ = tmpfile();
+    if (!file_) {
+      FX_LOGS(WARNING) << "Failed to create a temporary file, keeping everything in memory";
+      spill_failed_ = true;
+      return;
+    }
+  }
+  const size_t written = fwrite(buffer_.data(), 1, buffer_.size(), file_);
+  buffer_.erase(buffer_.begin(), buffer_.begin() + written);
+  if (!buffer_.empty()) {
+    FX_LOGS(WARNING) << "Failed to write to a temporary file, keeping the rest in memory";
+    spill_failed_ = true;
+  }
+}
+
+void SpillBuffer::StartReading() {
+  FX_DCHECK(!reading_);
+  reading_ = true;
+  if (!file_) {
+    return;
+  }
+  if (!spill_failed_) {
+    Spill();
+  }
+  // Anything which couldn't be written out is still in |buffer_|, and is read after the file.
+  rewind(file_);
+}
+
+bool SpillBuffer::Read(void* data, size_t size) {
+  FX_DCHECK(reading_);
+  auto* bytes = static_cast<uint8_t*>(data);
+  if (file_) {
+    const size_t actual = fread(bytes, 1, size, file_);
+    if (actual == size) {
+      return true;
+    }
+    // The rest may still be in memory.
+    fclose(file_);
+    file_ = nullptr;
+    bytes += actual;
+    size -= actual;
+  }
+  if (buffer_.size() - read_offset_ < size) {
+    return false;
+  }
+  memcpy(bytes, buffer_.data() + read_offset_, size);
+  read_offset_ += size;
+  return true;
+}
+
+}  // namespace tracing
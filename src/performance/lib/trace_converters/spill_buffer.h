@@ -0,0 +1,60 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SRC_PERFORMANCE_LIB_TRACE_CONVERTERS_SPILL_BUFFER_H_
+#define SRC_PERFORMANCE_LIB_TRACE_CONVERTERS_SPILL_BUFFER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <vector>
+
+namespace tracing {
+
+// An append-only log of bytes which is kept in memory until it grows past |memory_limit|, and is
+// then moved to an anonymous temporary file. This bounds the memory needed for data which has to
+// be held back until the end of a conversion, however long the trace is.
+//
+// If no temporary file can be created, everything is kept in memory instead.
+class SpillBuffer {
+ public:
+  static constexpr size_t kDefaultMemoryLimit = 1024 * 1024;
+
+  explicit SpillBuffer(size_t memory_limit = kDefaultMemoryLimit);
+  ~SpillBuffer();
+
+  bool empty() const { return size_ == 0; }
+
+  // The number of bytes appended so far.
+  size_t size() const { return size_; }
+
+  void Append(const void* data, size_t size);
+
+  // Rewinds to the first byte appended, after which the contents can be replayed with |Read()|.
+  // Nothing may be appended after this.
+  void StartReading();
+
+  // Reads the next |size| bytes. Returns false if there aren't that many left.
+  bool Read(void* data, size_t size);
+
+ private:
+  void Spill();
+
+  const size_t memory_limit_;
+  size_t size_ = 0;
+  // Bytes which haven't been spilled, or all of them if there is no file.
+  std::vector<uint8_t> buffer_;
+  size_t read_offset_ = 0;
+  FILE* file_ = nullptr;
+  bool reading_ = false;
+  bool spill_failed_ = false;
+
+  SpillBuffer(const SpillBuffer&) = delete;
+  SpillBuffer& operator=(const SpillBuffer&) = delete;
+};
+
+}  // namespace tracing
+
+#endif  // SRC_PERFORMANCE_LIB_TRACE_CONVERTERS_SPILL_BUFFER_H_
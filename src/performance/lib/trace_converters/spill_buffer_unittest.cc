@@ -0,0 +1,49 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/performance/lib/trace_converters/spill_buffer.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+
+TEST(SpillBufferTest, ReadsBackWhatWasAppended) {
+  // Small enough that most of the contents end up in the temporary file.
+  tracing::SpillBuffer buffer(/*memory_limit=*/16);
+  EXPECT_TRUE(buffer.empty());
+  for (uint32_t i = 0; i < 100; ++i) {
+    buffer.Append(&i, sizeof(i));
+  }
+  EXPECT_EQ(buffer.size(), 100 * sizeof(uint32_t));
+
+  buffer.StartReading();
+  for (uint32_t i = 0; i < 100; ++i) {
+    uint32_t value;
+    ASSERT_TRUE(buffer.Read(&value, sizeof(value)));
+    EXPECT_EQ(value, i);
+  }
+  uint32_t value;
+  EXPECT_FALSE(buffer.Read(&value, sizeof(value)));
+}
+
+TEST(SpillBufferTest, StaysInMemoryBelowTheLimit) {
+  tracing::SpillBuffer buffer;
+  const char data[] = "some data";
+  buffer.Append(data, sizeof(data));
+
+  buffer.StartReading();
+  char read[sizeof(data)];
+  ASSERT_TRUE(buffer.Read(read, sizeof(read)));
+  EXPECT_STREQ(read, data);
+  EXPECT_FALSE(buffer.Read(read, 1));
+}
+
+TEST(SpillBufferTest, Empty) {
+  tracing::SpillBuffer buffer;
+  buffer.StartReading();
+  char c;
+  EXPECT_FALSE(buffer.Read(&c, 1));
+}
+
+}  // namespace
@@ -0,0 +1,136 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/performance/sampling_provider/app.h"
+
+#include <fuchsia/kernel/cpp/fidl.h>
+#include <lib/async/default.h>
+#include <lib/syslog/cpp/macros.h>
+#include <lib/trace-engine/instrumentation.h>
+#include <lib/zx/job.h>
+#include <zircon/status.h>
+#include <zircon/syscalls/object.h>
+
+#include <algorithm>
+
+#include "src/lib/fxl/strings/string_number_conversions.h"
+
+namespace sampling_provider {
+namespace {
+
+std::vector<zx_koid_t> GetChildKoids(const zx::job& job, uint32_t topic) {
+  std::vector<zx_koid_t> koids;
+  size_t available = 0;
+  // Children may be added between the calls, so go around again until everything fits.
+  do {
+    koids.resize(available);
+    size_t actual;
+    if (job.get_info(topic, koids.data(), koids.size() * sizeof(zx_koid_t), &actual,
+                     &available) != ZX_OK) {
+      return {};
+    }
+    koids.resize(actual);
+  } while (koids.size() < available);
+  return koids;
+}
+
+void FindProcessesInJob(const zx::job& job, const std::vector<std::string>& names,
+                        std::vector<zx::process>* processes) {
+  for (zx_koid_t koid : GetChildKoids(job, ZX_INFO_JOB_PROCESSES)) {
+    zx::process process;
+    if (job.get_child(koid, ZX_RIGHT_SAME_RIGHTS, &process) != ZX_OK) {
+      continue;
+    }
+    char name[ZX_MAX_NAME_LEN];
+    if (process.get_property(ZX_PROP_NAME, name, sizeof(name)) != ZX_OK) {
+      continue;
+    }
+    if (std::find(names.begin(), names.end(), name) != names.end()) {
+      processes->push_back(std::move(process));
+    }
+  }
+  for (zx_koid_t koid : GetChildKoids(job, ZX_INFO_JOB_CHILDREN)) {
+    zx::job child;
+    if (job.get_child(koid, ZX_RIGHT_SAME_RIGHTS, &child) == ZX_OK) {
+      FindProcessesInJob(child, names, processes);
+    }
+  }
+}
+
+}  // namespace
+
+App::App(const fxl::CommandLine& command_line)
+    : component_context_(sys::ComponentContext::CreateAndServeOutgoingDirectory()) {
+  for (std::string_view name : command_line.GetOptionValues("process")) {
+    process_names_.emplace_back(name);
+  }
+
+  std::string value;
+  if (command_line.GetOptionValue("frequency", &value)) {
+    uint32_t frequency;
+    if (fxl::StringToNumberWithError(value, &frequency) && frequency > 0) {
+      config_.period = zx::sec(1) / frequency;
+    } else {
+      FX_LOGS(ERROR) << "Invalid --frequency: " << value;
+    }
+  }
+  if (command_line.GetOptionValue("max-depth", &value)) {
+    if (!fxl::StringToNumberWithError(value, &config_.max_depth) || config_.max_depth == 0) {
+      FX_LOGS(ERROR) << "Invalid --max-depth: " << value;
+      config_.max_depth = SamplerConfig().max_depth;
+    }
+  }
+  if (command_line.GetOptionValue("unwinder", &value)) {
+    if (value == "scs") {
+      config_.unwind_mode = UnwindMode::kShadowCallStack;
+    } else if (value != "fp") {
+      FX_LOGS(ERROR) << "Invalid --unwinder: " << value;
+    }
+  }
+
+  trace_observer_.Start(async_get_default_dispatcher(), [this] { UpdateState(); });
+}
+
+App::~App() = default;
+
+void App::UpdateState() {
+  const bool enabled = trace_state() == TRACE_STARTED &&
+                       trace_is_category_enabled(kSampleCategory) && !process_names_.empty();
+  if (!enabled) {
+    sampler_.reset();
+    return;
+  }
+  if (sampler_) {
+    return;
+  }
+
+  std::vector<zx::process> processes = FindProcesses();
+  if (processes.empty()) {
+    FX_LOGS(WARNING) << "None of the processes to sample are running";
+    return;
+  }
+  FX_LOGS(INFO) << "Sampling " << processes.size() << " processes";
+  sampler_ = std::make_unique<Sampler>(std::move(processes), config_);
+}
+
+std::vector<zx::process> App::FindProcesses() {
+  fuchsia::kernel::RootJobSyncPtr root_job_ptr;
+  zx_status_t status = component_context_->svc()->Connect(root_job_ptr.NewRequest());
+  if (status != ZX_OK) {
+    FX_PLOGS(ERROR, status) << "Cannot connect to fuchsia.kernel.RootJob";
+    return {};
+  }
+  zx::job root_job;
+  status = root_job_ptr->Get(&root_job);
+  if (status != ZX_OK) {
+    FX_PLOGS(ERROR, status) << "Cannot get root job handle";
+    return {};
+  }
+
+  std::vector<zx::process> processes;
+  FindProcessesInJob(root_job, process_names_, &processes);
+  return processes;
+}
+
+}  // namespace sampling_provider
@@ -0,0 +1,51 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SRC_PERFORMANCE_SAMPLING_PROVIDER_APP_H_
+#define SRC_PERFORMANCE_SAMPLING_PROVIDER_APP_H_
+
+#include <lib/sys/cpp/component_context.h>
+#include <lib/trace/observer.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/lib/fxl/command_line.h"
+#include "src/performance/sampling_provider/sampler.h"
+
+namespace sampling_provider {
+
+// Samples the processes named on the command line while the "cpu:profile" category is enabled.
+//
+// Options:
+//   --process=<name>      A process to sample. May be repeated.
+//   --frequency=<hz>      Samples per second, per thread. Defaults to 100.
+//   --max-depth=<frames>  The deepest stack recorded. Defaults to 64.
+//   --unwinder=fp|scs     Unwind with frame pointers or the shadow call stack (arm64 only).
+class App {
+ public:
+  explicit App(const fxl::CommandLine& command_line);
+  ~App();
+
+ private:
+  void UpdateState();
+
+  std::vector<zx::process> FindProcesses();
+
+  std::unique_ptr<sys::ComponentContext> component_context_;
+  trace::TraceObserver trace_observer_;
+  std::vector<std::string> process_names_;
+  SamplerConfig config_;
+  std::unique_ptr<Sampler> sampler_;
+
+  App(const App&) = delete;
+  App(App&&) = delete;
+  App& operator=(const App&) = delete;
+  App& operator=(App&&) = delete;
+};
+
+}  // namespace sampling_provider
+
+#endif  // SRC_PERFORMANCE_SAMPLING_PROVIDER_APP_H_
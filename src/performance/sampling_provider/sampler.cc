@@ -0,0 +1,151 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/performance/sampling_provider/sampler.h"
+
+#include <lib/syslog/cpp/macros.h>
+#include <lib/trace-engine/instrumentation.h>
+#include <lib/zx/suspend_token.h>
+#include <zircon/syscalls/debug.h>
+#include <zircon/syscalls/object.h>
+
+#include "src/performance/sampling_provider/unwinder.h"
+
+namespace sampling_provider {
+namespace {
+
+// How long to wait for a thread to suspend before giving up on sampling it.
+constexpr zx::duration kSuspendTimeout = zx::msec(1);
+
+constexpr char kSampleName[] = "sample";
+
+zx_koid_t GetKoid(const zx::object_base& object) {
+  zx_info_handle_basic_t info;
+  zx_status_t status =
+      object.get_info(ZX_INFO_HANDLE_BASIC, &info, sizeof(info), nullptr, nullptr);
+  return status == ZX_OK ? info.koid : ZX_KOID_INVALID;
+}
+
+}  // namespace
+
+Sampler::Sampler(std::vector<zx::process> processes, SamplerConfig config)
+    : config_(config), loop_(&kAsyncLoopConfigNoAttachToCurrentThread) {
+  for (zx::process& process : processes) {
+    zx_koid_t koid = GetKoid(process);
+    targets_.push_back({std::move(process), koid});
+  }
+  pcs_.reserve(config_.max_depth);
+  loop_.StartThread("sampler");
+  sample_task_.Post(loop_.dispatcher());
+}
+
+Sampler::~Sampler() { loop_.Shutdown(); }
+
+void Sampler::TakeSamples() {
+  sample_task_.PostDelayed(loop_.dispatcher(), config_.period);
+
+  trace_string_ref_t category_ref;
+  trace_context_t* context = trace_acquire_context_for_category(kSampleCategory, &category_ref);
+  if (!context) {
+    return;
+  }
+  if (!wrote_process_info_) {
+    for (const Target& target : targets_) {
+      char name[ZX_MAX_NAME_LEN];
+      if (target.process.get_property(ZX_PROP_NAME, name, sizeof(name)) == ZX_OK) {
+        trace_string_ref_t name_ref = trace_make_inline_c_string_ref(name);
+        trace_context_write_process_info_record(context, target.koid, &name_ref);
+      }
+    }
+    wrote_process_info_ = true;
+  }
+  for (const Target& target : targets_) {
+    SampleProcess(context, category_ref, target);
+  }
+  trace_release_context(context);
+}
+
+void Sampler::SampleProcess(trace_context_t* context, const trace_string_ref_t& category_ref,
+                            const Target& target) {
+  size_t available;
+  zx_status_t status =
+      target.process.get_info(ZX_INFO_PROCESS_THREADS, nullptr, 0, nullptr, &available);
+  if (status != ZX_OK) {
+    return;
+  }
+  thread_koids_.resize(available);
+  size_t actual;
+  status = target.process.get_info(ZX_INFO_PROCESS_THREADS, thread_koids_.data(),
+                                   thread_koids_.size() * sizeof(zx_koid_t), &actual, nullptr);
+  if (status != ZX_OK) {
+    return;
+  }
+  thread_koids_.resize(actual);
+
+  for (zx_koid_t thread_koid : thread_koids_) {
+    zx::thread thread;
+    if (target.process.get_child(thread_koid, ZX_RIGHT_SAME_RIGHTS, &thread) != ZX_OK) {
+      continue;  // The thread has exited since it was listed.
+    }
+    zx_info_thread_t info;
+    if (thread.get_info(ZX_INFO_THREAD, &info, sizeof(info), nullptr, nullptr) != ZX_OK ||
+        info.state != ZX_THREAD_STATE_RUNNING) {
+      // Blocked threads aren't doing any work worth attributing.
+      continue;
+    }
+    SampleThread(context, category_ref, target, thread_koid, thread);
+  }
+}
+
+void Sampler::SampleThread(trace_context_t* context, const trace_string_ref_t& category_ref,
+                           const Target& target, zx_koid_t thread_koid, const zx::thread& thread) {
+  zx_thread_state_general_regs_t regs;
+  trace_ticks_t ticks;
+  {
+    zx::suspend_token token;
+    if (thread.suspend(&token) != ZX_OK) {
+      return;
+    }
+    // A thread which terminates instead never signals ZX_THREAD_SUSPENDED.
+    zx_signals_t observed;
+    zx_status_t status = thread.wait_one(ZX_THREAD_SUSPENDED | ZX_THREAD_TERMINATED,
+                                         zx::deadline_after(kSuspendTimeout), &observed);
+    if (status != ZX_OK || (observed & ZX_THREAD_TERMINATED)) {
+      return;
+    }
+    ticks = zx_ticks_get();
+    if (thread.read_state(ZX_THREAD_STATE_GENERAL_REGS, &regs, sizeof(regs)) != ZX_OK) {
+      return;
+    }
+    // The registers are all that's needed from the thread itself, so it's resumed before the stack
+    // is walked. The stack may change underneath the walk, which the unwinder tolerates by
+    // stopping at the first frame that doesn't make sense.
+  }
+
+  MemoryReader read_memory = [&target](uint64_t address, uint64_t* value) {
+    size_t actual;
+    return target.process.read_memory(address, value, sizeof(*value), &actual) == ZX_OK &&
+           actual == sizeof(*value);
+  };
+  pcs_.clear();
+#if defined(__aarch64__)
+  if (config_.unwind_mode == UnwindMode::kShadowCallStack) {
+    UnwindShadowCallStack(regs.pc, regs.r[18], read_memory, config_.max_depth, &pcs_);
+  } else {
+    UnwindFramePointers(regs.pc, regs.r[29], read_memory, config_.max_depth, &pcs_);
+  }
+#elif defined(__x86_64__)
+  UnwindFramePointers(regs.rip, regs.rbp, read_memory, config_.max_depth, &pcs_);
+#else
+#error "Unsupported architecture"
+#endif
+
+  trace_thread_ref_t thread_ref =
+      trace_context_make_registered_thread(context, target.koid, thread_koid);
+  trace_string_ref_t name_ref = trace_context_make_registered_string_literal(context, kSampleName);
+  trace_context_write_blob_event_record(context, ticks, &thread_ref, &category_ref, &name_ref,
+                                        pcs_.data(), pcs_.size() * sizeof(uint64_t), nullptr, 0);
+}
+
+}  // namespace sampling_provider
@@ -0,0 +1,74 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SRC_PERFORMANCE_SAMPLING_PROVIDER_SAMPLER_H_
+#define SRC_PERFORMANCE_SAMPLING_PROVIDER_SAMPLER_H_
+
+#include <lib/async-loop/cpp/loop.h>
+#include <lib/async/cpp/task.h>
+#include <lib/trace-engine/context.h>
+#include <lib/zx/process.h>
+#include <lib/zx/thread.h>
+#include <lib/zx/time.h>
+
+#include <vector>
+
+namespace sampling_provider {
+
+// The category under which samples are recorded.
+constexpr char kSampleCategory[] = "cpu:profile";
+
+enum class UnwindMode {
+  kFramePointers,
+  // Only available on arm64. Falls back to frame pointers elsewhere.
+  kShadowCallStack,
+};
+
+struct SamplerConfig {
+  zx::duration period = zx::msec(10);
+  size_t max_depth = 64;
+  UnwindMode unwind_mode = UnwindMode::kFramePointers;
+};
+
+// Periodically suspends every running thread of a set of processes, unwinds its user stack and
+// records the stack in the trace as a blob event on the sampled thread.
+//
+// Sampling happens on a thread of the sampler's own so that it never holds up the trace provider.
+// Destroying the sampler stops it.
+class Sampler {
+ public:
+  Sampler(std::vector<zx::process> processes, SamplerConfig config);
+  ~Sampler();
+
+ private:
+  struct Target {
+    zx::process process;
+    zx_koid_t koid;
+  };
+
+  void TakeSamples();
+  void SampleProcess(trace_context_t* context, const trace_string_ref_t& category_ref,
+                     const Target& target);
+  void SampleThread(trace_context_t* context, const trace_string_ref_t& category_ref,
+                    const Target& target, zx_koid_t thread_koid, const zx::thread& thread);
+
+  const SamplerConfig config_;
+  std::vector<Target> targets_;
+  // Reused from sample to sample.
+  std::vector<zx_koid_t> thread_koids_;
+  std::vector<uint64_t> pcs_;
+  bool wrote_process_info_ = false;
+
+  async::Loop loop_;
+  async::TaskClosureMethod<Sampler, &Sampler::TakeSamples> sample_task_{this};
+
+  Sampler(const Sampler&) = delete;
+  Sampler(Sampler&&) = delete;
+  Sampler& operator=(const Sampler&) = delete;
+  Sampler& operator=(Sampler&&) = delete;
+};
+
+}  // namespace sampling_provider
+
+#endif  // SRC_PERFORMANCE_SAMPLING_PROVIDER_SAMPLER_H_
@@ -0,0 +1,56 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/performance/sampling_provider/unwinder.h"
+
+namespace sampling_provider {
+
+void UnwindFramePointers(uint64_t pc, uint64_t fp, const MemoryReader& read_memory,
+                         size_t max_depth, std::vector<uint64_t>* pcs) {
+  if (max_depth == 0) {
+    return;
+  }
+  pcs->push_back(pc);
+  for (size_t depth = 1; depth < max_depth; ++depth) {
+    if (fp == 0 || fp % sizeof(uint64_t) != 0) {
+      return;
+    }
+    uint64_t next_fp;
+    uint64_t return_address;
+    if (!read_memory(fp, &next_fp) || !read_memory(fp + sizeof(uint64_t), &return_address)) {
+      return;
+    }
+    if (return_address == 0) {
+      return;
+    }
+    pcs->push_back(return_address);
+    // Stacks grow down, so a caller's frame is always above its callee's. Anything else means the
+    // chain is corrupt or has reached code built without frame pointers.
+    if (next_fp <= fp) {
+      return;
+    }
+    fp = next_fp;
+  }
+}
+
+void UnwindShadowCallStack(uint64_t pc, uint64_t scsp, const MemoryReader& read_memory,
+                           size_t max_depth, std::vector<uint64_t>* pcs) {
+  if (max_depth == 0) {
+    return;
+  }
+  pcs->push_back(pc);
+  if (scsp % sizeof(uint64_t) != 0) {
+    return;
+  }
+  for (size_t depth = 1; depth < max_depth && scsp >= sizeof(uint64_t); ++depth) {
+    scsp -= sizeof(uint64_t);
+    uint64_t return_address;
+    if (!read_memory(scsp, &return_address) || return_address == 0) {
+      return;
+    }
+    pcs->push_back(return_address);
+  }
+}
+
+}  // namespace sampling_provider
@@ -0,0 +1,39 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SRC_PERFORMANCE_SAMPLING_PROVIDER_UNWINDER_H_
+#define SRC_PERFORMANCE_SAMPLING_PROVIDER_UNWINDER_H_
+
+#include <lib/fit/function.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+namespace sampling_provider {
+
+// Reads the 8 bytes at |address| in the sampled process. Returns false if they can't be read.
+using MemoryReader = fit::function<bool(uint64_t address, uint64_t* value)>;
+
+// Appends |pc| and then the return address of each frame found by following the chain of saved
+// frame pointers from |fp| to |pcs|, up to |max_depth| addresses in all.
+//
+// On both x64 and arm64 a frame pointer points at the caller's saved frame pointer, which is
+// followed by the return address. The walk stops at a null or misaligned frame pointer, at one
+// which doesn't move towards the base of the stack, or when memory can't be read.
+void UnwindFramePointers(uint64_t pc, uint64_t fp, const MemoryReader& read_memory,
+                         size_t max_depth, std::vector<uint64_t>* pcs);
+
+// Appends |pc| and then the return addresses saved on the shadow call stack below |scsp| to
+// |pcs|, up to |max_depth| addresses in all.
+//
+// The shadow call stack grows up and |scsp| points just past the most recently pushed return
+// address. Its base sits on a guard page, so the walk stops when memory can't be read. This works
+// whether or not the code being sampled was built with frame pointers.
+void UnwindShadowCallStack(uint64_t pc, uint64_t scsp, const MemoryReader& read_memory,
+                           size_t max_depth, std::vector<uint64_t>* pcs);
+
+}  // namespace sampling_provider
+
+#endif  // SRC_PERFORMANCE_SAMPLING_PROVIDER_UNWINDER_H_
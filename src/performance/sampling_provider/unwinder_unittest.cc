@@ -0,0 +1,104 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/performance/sampling_provider/unwinder.h"
+
+#include <map>
+
+#include <gtest/gtest.h>
+
+namespace sampling_provider {
+namespace {
+
+// Memory of a fake process, a word at a time.
+class FakeMemory {
+ public:
+  void Write(uint64_t address, uint64_t value) { words_[address] = value; }
+
+  MemoryReader reader() {
+    return [this](uint64_t address, uint64_t* value) {
+      auto it = words_.find(address);
+      if (it == words_.end()) {
+        return false;
+      }
+      *value = it->second;
+      return true;
+    };
+  }
+
+ private:
+  std::map<uint64_t, uint64_t> words_;
+};
+
+TEST(UnwindFramePointersTest, FollowsTheFrameChain) {
+  FakeMemory memory;
+  memory.Write(0x1000, 0x1100);
+  memory.Write(0x1008, 0xa1);
+  memory.Write(0x1100, 0x1200);
+  memory.Write(0x1108, 0xa2);
+  memory.Write(0x1200, 0);
+  memory.Write(0x1208, 0xa3);
+
+  std::vector<uint64_t> pcs;
+  UnwindFramePointers(0xa0, 0x1000, memory.reader(), 16, &pcs);
+  EXPECT_EQ(pcs, (std::vector<uint64_t>{0xa0, 0xa1, 0xa2, 0xa3}));
+}
+
+TEST(UnwindFramePointersTest, StopsAtMaxDepth) {
+  FakeMemory memory;
+  memory.Write(0x1000, 0x1100);
+  memory.Write(0x1008, 0xa1);
+  memory.Write(0x1100, 0x1200);
+  memory.Write(0x1108, 0xa2);
+
+  std::vector<uint64_t> pcs;
+  UnwindFramePointers(0xa0, 0x1000, memory.reader(), 2, &pcs);
+  EXPECT_EQ(pcs, (std::vector<uint64_t>{0xa0, 0xa1}));
+
+  pcs.clear();
+  UnwindFramePointers(0xa0, 0x1000, memory.reader(), 0, &pcs);
+  EXPECT_TRUE(pcs.empty());
+}
+
+TEST(UnwindFramePointersTest, StopsAtFramesWhichDontMoveUpTheStack) {
+  FakeMemory memory;
+  memory.Write(0x1000, 0x1000);
+  memory.Write(0x1008, 0xa1);
+
+  std::vector<uint64_t> pcs;
+  UnwindFramePointers(0xa0, 0x1000, memory.reader(), 16, &pcs);
+  EXPECT_EQ(pcs, (std::vector<uint64_t>{0xa0, 0xa1}));
+}
+
+TEST(UnwindFramePointersTest, StopsAtUnreadableOrMisalignedFrames) {
+  FakeMemory memory;
+  memory.Write(0x1000, 0x1104);
+  memory.Write(0x1008, 0xa1);
+
+  std::vector<uint64_t> pcs;
+  UnwindFramePointers(0xa0, 0x1000, memory.reader(), 16, &pcs);
+  EXPECT_EQ(pcs, (std::vector<uint64_t>{0xa0, 0xa1}));
+
+  pcs.clear();
+  UnwindFramePointers(0xa0, 0x2000, memory.reader(), 16, &pcs);
+  EXPECT_EQ(pcs, (std::vector<uint64_t>{0xa0}));
+}
+
+TEST(UnwindShadowCallStackTest, WalksDownFromTheTop) {
+  FakeMemory memory;
+  memory.Write(0x1000, 0xa3);
+  memory.Write(0x1008, 0xa2);
+  memory.Write(0x1010, 0xa1);
+
+  std::vector<uint64_t> pcs;
+  UnwindShadowCallStack(0xa0, 0x1018, memory.reader(), 16, &pcs);
+  EXPECT_EQ(pcs, (std::vector<uint64_t>{0xa0, 0xa1, 0xa2, 0xa3}));
+
+  pcs.clear();
+  UnwindShadowCallStack(0xa0, 0x1018, memory.reader(), 3, &pcs);
+  EXPECT_EQ(pcs, (std::vector<uint64_t>{0xa0, 0xa1, 0xa2}));
+}
+
+}  // namespace
+}  // namespace sampling_provider
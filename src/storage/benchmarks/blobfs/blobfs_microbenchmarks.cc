@@ -0,0 +1,264 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Microbenchmarks for blobfs which run an instance of it in-process on top of an in-memory block
+// device, so that the cost of blobfs itself is measured without the noise of the storage stack
+// underneath it or of FIDL.
+
+#include <lib/zx/vmo.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zircon/assert.h>
+#include <zircon/status.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fbl/ref_ptr.h>
+#include <perftest/perftest.h>
+
+#include "src/lib/digest/merkle-tree.h"
+#include "src/lib/fxl/strings/string_printf.h"
+#include "src/lib/storage/vfs/cpp/scoped_vnode_open.h"
+#include "src/storage/blobfs/blob.h"
+#include "src/storage/blobfs/blobfs.h"
+#include "src/storage/blobfs/compression_settings.h"
+#include "src/storage/blobfs/format.h"
+#include "src/storage/blobfs/test/blob_utils.h"
+#include "src/storage/blobfs/test/blobfs_test_setup.h"
+
+namespace blobfs {
+namespace {
+
+constexpr uint64_t kDeviceBlockSize = 512;
+constexpr uint64_t kDeviceBlockCount = UINT64_C(256) * 1024 * 1024 / kDeviceBlockSize;
+
+constexpr size_t kBlobSizes[] = {
+    UINT64_C(8) * 1024,
+    UINT64_C(128) * 1024,
+    UINT64_C(1) * 1024 * 1024,
+    UINT64_C(16) * 1024 * 1024,
+};
+
+constexpr CompressionAlgorithm kCompressionAlgorithms[] = {
+    CompressionAlgorithm::kUncompressed,
+    CompressionAlgorithm::kChunked,
+};
+
+// Fills |data| with something which compresses roughly as well as a typical binary: short random
+// runs separated by runs of a repeated byte. The first bytes are always random so that every blob
+// generated is distinct.
+void CompressibleFill(uint8_t* data, size_t length) {
+  size_t offset = 0;
+  while (offset < length) {
+    const size_t random_run = std::min(length - offset, size_t{16} + rand() % 48);
+    RandomFill(data + offset, random_run);
+    offset += random_run;
+    const size_t repeated_run = std::min(length - offset, size_t{rand() % 64});
+    memset(data + offset, data[offset - 1], repeated_run);
+    offset += repeated_run;
+  }
+}
+
+// A blobfs instance on a freshly formatted in-memory device.
+class BenchmarkFilesystem {
+ public:
+  explicit BenchmarkFilesystem(CompressionAlgorithm algorithm) {
+    mount_options_.compression_settings.compression_algorithm = algorithm;
+    const zx_status_t status =
+        setup_.CreateFormatMount(kDeviceBlockCount, kDeviceBlockSize,
+                                 FilesystemOptions{.num_inodes = 4096}, mount_options_);
+    ZX_ASSERT_MSG(status == ZX_OK, "Failed to mount blobfs: %s", zx_status_get_string(status));
+  }
+
+  // Writes |info| out as a new blob.
+  void Write(const BlobInfo& info) {
+    fbl::RefPtr<fs::Vnode> file;
+    zx_status_t status = setup_.OpenRoot()->Create(Name(info), 0, &file);
+    ZX_ASSERT_MSG(status == ZX_OK, "Failed to create blob: %s", zx_status_get_string(status));
+    status = file->Truncate(info.size_data);
+    ZX_ASSERT_MSG(status == ZX_OK, "Failed to truncate blob: %s", zx_status_get_string(status));
+    size_t actual = 0;
+    status = file->Write(info.data.get(), info.size_data, 0, &actual);
+    ZX_ASSERT_MSG(status == ZX_OK && actual == info.size_data, "Failed to write blob: %s",
+                  zx_status_get_string(status));
+    status = file->Close();
+    ZX_ASSERT_MSG(status == ZX_OK, "Failed to close blob: %s", zx_status_get_string(status));
+  }
+
+  void Unlink(const BlobInfo& info) {
+    const zx_status_t status = setup_.OpenRoot()->Unlink(Name(info), false);
+    ZX_ASSERT_MSG(status == ZX_OK, "Failed to unlink blob: %s", zx_status_get_string(status));
+    // Lets the blob be purged before the next one is written.
+    setup_.loop().RunUntilIdle();
+  }
+
+  fbl::RefPtr<Blob> Lookup(const BlobInfo& info) {
+    fbl::RefPtr<fs::Vnode> node;
+    const zx_status_t status = setup_.OpenRoot()->Lookup(Name(info), &node);
+    ZX_ASSERT_MSG(status == ZX_OK, "Failed to look up blob: %s", zx_status_get_string(status));
+    return fbl::RefPtr<Blob>::Downcast(std::move(node));
+  }
+
+  // Drops everything blobfs has cached. Any references to blobs must have been released.
+  void Remount() {
+    const zx_status_t status = setup_.Remount(mount_options_);
+    ZX_ASSERT_MSG(status == ZX_OK, "Failed to remount blobfs: %s", zx_status_get_string(status));
+  }
+
+ private:
+  static std::string Name(const BlobInfo& info) {
+    // Blob paths are generated relative to an empty mount path, skip the leading slash.
+    return std::string(info.path + 1);
+  }
+
+  MountOptions mount_options_;
+  BlobfsTestSetup setup_;
+};
+
+// Reads all of |blob| through its paged VMO, which is how blobs are read by almost everything.
+void ReadThroughVmo(Blob& blob, std::vector<uint8_t>& buffer) {
+  zx::vmo vmo;
+  zx_status_t status = blob.GetVmo(fuchsia_io::wire::VmoFlags::kRead, &vmo);
+  ZX_ASSERT_MSG(status == ZX_OK, "Failed to get blob VMO: %s", zx_status_get_string(status));
+  status = vmo.read(buffer.data(), 0, buffer.size());
+  ZX_ASSERT_MSG(status == ZX_OK, "Failed to read blob VMO: %s", zx_status_get_string(status));
+}
+
+// Measures paging in a blob which isn't cached at all. The remount that evicts it is reported as a
+// separate step.
+bool ColdPageInTest(perftest::RepeatState* state, CompressionAlgorithm algorithm, size_t size) {
+  state->DeclareStep("remount");
+  state->DeclareStep("page_in");
+  state->SetBytesProcessedPerRun(size);
+
+  BenchmarkFilesystem fs(algorithm);
+  std::unique_ptr<BlobInfo> info = GenerateBlob(CompressibleFill, "", size);
+  fs.Write(*info);
+  std::vector<uint8_t> buffer(size);
+
+  while (state->KeepRunning()) {
+    fs.Remount();
+    state->NextStep();
+    fbl::RefPtr<Blob> blob = fs.Lookup(*info);
+    fs::ScopedVnodeOpen opener;
+    ZX_ASSERT(opener.Open(blob) == ZX_OK);
+    ReadThroughVmo(*blob, buffer);
+    ZX_ASSERT(opener.Close() == ZX_OK);
+  }
+  return true;
+}
+
+// Measures reading a blob whose pages have all been supplied already.
+bool WarmPageInTest(perftest::RepeatState* state, CompressionAlgorithm algorithm, size_t size) {
+  state->SetBytesProcessedPerRun(size);
+
+  BenchmarkFilesystem fs(algorithm);
+  std::unique_ptr<BlobInfo> info = GenerateBlob(CompressibleFill, "", size);
+  fs.Write(*info);
+  std::vector<uint8_t> buffer(size);
+
+  fbl::RefPtr<Blob> blob = fs.Lookup(*info);
+  fs::ScopedVnodeOpen opener;
+  ZX_ASSERT(opener.Open(blob) == ZX_OK);
+  ReadThroughVmo(*blob, buffer);
+
+  while (state->KeepRunning()) {
+    ReadThroughVmo(*blob, buffer);
+  }
+  ZX_ASSERT(opener.Close() == ZX_OK);
+  return true;
+}
+
+// Measures looking up, opening and closing a blob which is already in the cache.
+bool OpenCloseTest(perftest::RepeatState* state) {
+  BenchmarkFilesystem fs(CompressionAlgorithm::kChunked);
+  std::unique_ptr<BlobInfo> info = GenerateBlob(CompressibleFill, "", kBlobfsBlockSize);
+  fs.Write(*info);
+
+  while (state->KeepRunning()) {
+    fbl::RefPtr<Blob> blob = fs.Lookup(*info);
+    fs::ScopedVnodeOpen opener;
+    ZX_ASSERT(opener.Open(blob) == ZX_OK);
+    ZX_ASSERT(opener.Close() == ZX_OK);
+  }
+  return true;
+}
+
+// Measures writing a new blob, which includes building its Merkle tree and compressing it. Every
+// blob is unlinked again in a separate step so that the device never fills up.
+bool WriteTest(perftest::RepeatState* state, CompressionAlgorithm algorithm, size_t size) {
+  state->DeclareStep("write");
+  state->DeclareStep("unlink");
+  state->SetBytesProcessedPerRun(size);
+
+  BenchmarkFilesystem fs(algorithm);
+  // Generating the data isn't part of what's being measured, so a few blobs are generated up front
+  // and reused in turn. Each is unlinked before it's written again.
+  constexpr size_t kBlobCount = 4;
+  std::vector<std::unique_ptr<BlobInfo>> infos;
+  for (size_t i = 0; i < kBlobCount; ++i) {
+    infos.push_back(GenerateBlob(CompressibleFill, "", size));
+  }
+
+  size_t next = 0;
+  while (state->KeepRunning()) {
+    const BlobInfo& info = *infos[next];
+    next = (next + 1) % kBlobCount;
+    fs.Write(info);
+    state->NextStep();
+    fs.Unlink(info);
+  }
+  return true;
+}
+
+// Measures verifying a whole blob against its Merkle tree, independent of how it's read.
+bool MerkleVerifyTest(perftest::RepeatState* state, size_t size) {
+  state->SetBytesProcessedPerRun(size);
+
+  std::unique_ptr<BlobInfo> info = GenerateBlob(RandomFill, "", size);
+  std::unique_ptr<MerkleTreeInfo> tree =
+      CreateMerkleTree(info->data.get(), info->size_data, /*use_compact_format=*/true);
+
+  while (state->KeepRunning()) {
+    const zx_status_t status = digest::MerkleTreeVerifier::Verify(
+        info->data.get(), info->size_data, 0, info->size_data, tree->merkle_tree.get(),
+        tree->merkle_tree_size, tree->root);
+    ZX_ASSERT_MSG(status == ZX_OK, "Failed to verify blob: %s", zx_status_get_string(status));
+  }
+  return true;
+}
+
+void RegisterTests() {
+  for (CompressionAlgorithm algorithm : kCompressionAlgorithms) {
+    const char* algorithm_name = CompressionAlgorithmToString(algorithm);
+    for (size_t size : kBlobSizes) {
+      perftest::RegisterTest(
+          fxl::StringPrintf("Blobfs/PageIn/Cold/%s/%zuKiB", algorithm_name, size / 1024).c_str(),
+          ColdPageInTest, algorithm, size);
+      perftest::RegisterTest(
+          fxl::StringPrintf("Blobfs/PageIn/Warm/%s/%zuKiB", algorithm_name, size / 1024).c_str(),
+          WarmPageInTest, algorithm, size);
+      perftest::RegisterTest(
+          fxl::StringPrintf("Blobfs/Write/%s/%zuKiB", algorithm_name, size / 1024).c_str(),
+          WriteTest, algorithm, size);
+    }
+  }
+  for (size_t size : kBlobSizes) {
+    perftest::RegisterTest(fxl::StringPrintf("Blobfs/MerkleVerify/%zuKiB", size / 1024).c_str(),
+                           MerkleVerifyTest, size);
+  }
+  perftest::RegisterTest("Blobfs/OpenClose", OpenCloseTest);
+}
+PERFTEST_CTOR(RegisterTests)
+
+}  // namespace
+}  // namespace blobfs
+
+int main(int argc, char** argv) {
+  constexpr char kTestSuiteName[] = "fuchsia.storage.blobfs";
+  return perftest::PerfTestMain(argc, argv, kTestSuiteName);
+}
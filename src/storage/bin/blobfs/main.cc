@@ -14,6 +14,7 @@
 #include <optional>
 #include <utility>
 
+#include "src/lib/files/file.h"
 #include "src/lib/storage/block_client/cpp/remote_block_device.h"
 #include "src/lib/storage/vfs/cpp/vfs.h"
 #include "src/storage/bin/blobfs/blobfs_component_config.h"
@@ -178,6 +179,8 @@ std::optional<blobfs::CachePolicy> ParseEvictionPolicy(const char* str) {
     return blobfs::CachePolicy::NeverEvict;
   } else if (!strcmp(str, "EVICT_IMMEDIATELY")) {
     return blobfs::CachePolicy::EvictImmediately;
+  } else if (!strcmp(str, "BOUNDED")) {
+    return blobfs::CachePolicy::Bounded;
   }
   return std::nullopt;
 }
@@ -193,7 +196,7 @@ std::optional<int> ParseInt(const char* str) {
   return static_cast<int>(ret);
 }
 
-std::optional<int> ParseUint64(const char* str) {
+std::optional<uint64_t> ParseUint64(const char* str) {
   char* pend;
   unsigned long ret = strtoul(str, &pend, 10);
   if (*pend != '\0') {
@@ -219,8 +222,15 @@ int usage() {
       "                                    blobs. Only used if -c is one of ZSTD*, in which case\n"
       "                                    the level is the zstd compression level.\n"
       "         -e|--eviction_policy |pol| Policy for when to evict pager-backed blobs with no\n"
-      "                                    handles. |pol| can be one of NEVER_EVICT or\n"
-      "                                    EVICT_IMMEDIATELY.\n"
+      "                                    handles. |pol| can be one of NEVER_EVICT,\n"
+      "                                    EVICT_IMMEDIATELY or BOUNDED.\n"
+      "         --cache_budget n           The number of bytes of memory that closed blobs may\n"
+      "                                    retain with the BOUNDED eviction policy.\n"
+      "         --prefetch_manifest path   Read in the blob ranges recorded in the prefetch\n"
+      "                                    manifest at |path| after mounting.\n"
+      "         --prefetch_record_secs n   Record the blob ranges paged in during the first |n|\n"
+      "                                    seconds after mounting into the prefetch manifest\n"
+      "                                    served at diagnostics/prefetch_manifest.\n"
       "         --deprecated_padded_format Turns on the deprecated format that uses more disk\n"
       "                                    space. Only valid for mkfs on Astro devices.\n"
       "         -i|--num_inodes n          The initial number of inodes to allocate space for.\n"
@@ -244,8 +254,11 @@ int usage() {
 zx::status<Options> ProcessArgs(int argc, char** argv, CommandFunction* func) {
   Options options{};
 
-  // This option has no short flag, use int value beyond a char.
+  // These options have no short flag, use int values beyond a char.
   constexpr int kDeprecatedPaddedFormat = 256;
+  constexpr int kCacheBudget = 257;
+  constexpr int kPrefetchManifest = 258;
+  constexpr int kPrefetchRecordSecs = 259;
 
   while (1) {
     static struct option opts[] = {
@@ -256,6 +269,9 @@ zx::status<Options> ProcessArgs(int argc, char** argv, CommandFunction* func) {
         {"compression_level", required_argument, nullptr, 'l'},
         {"eviction_policy", required_argument, nullptr, 'e'},
         {"deprecated_padded_format", no_argument, nullptr, kDeprecatedPaddedFormat},
+        {"cache_budget", required_argument, nullptr, kCacheBudget},
+        {"prefetch_manifest", required_argument, nullptr, kPrefetchManifest},
+        {"prefetch_record_secs", required_argument, nullptr, kPrefetchRecordSecs},
         {"num_inodes", required_argument, nullptr, 'i'},
         {"sandbox_decompression", no_argument, nullptr, 's'},
         {"paging_threads", no_argument, nullptr, 't'},
@@ -308,6 +324,32 @@ zx::status<Options> ProcessArgs(int argc, char** argv, CommandFunction* func) {
         options.mount_options.pager_backed_cache_policy = policy;
         break;
       }
+      case kCacheBudget: {
+        std::optional<uint64_t> budget = ParseUint64(optarg);
+        if (!budget) {
+          fprintf(stderr, "Invalid argument for --cache_budget: %s\n", optarg);
+          return zx::error(usage());
+        }
+        options.mount_options.cache_memory_budget = *budget;
+        break;
+      }
+      case kPrefetchManifest: {
+        // A missing or unreadable manifest only means there's nothing to prefetch.
+        if (!files::ReadFileToVector(optarg, &options.mount_options.prefetch_manifest)) {
+          FX_LOGS(WARNING) << "Could not read prefetch manifest " << optarg;
+          options.mount_options.prefetch_manifest.clear();
+        }
+        break;
+      }
+      case kPrefetchRecordSecs: {
+        std::optional<uint64_t> seconds = ParseUint64(optarg);
+        if (!seconds) {
+          fprintf(stderr, "Invalid argument for --prefetch_record_secs: %s\n", optarg);
+          return zx::error(usage());
+        }
+        options.mount_options.prefetch_record_duration = zx::sec(*seconds);
+        break;
+      }
       case 'v':
         options.mount_options.verbose = true;
         break;
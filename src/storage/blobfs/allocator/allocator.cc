@@ -97,6 +97,8 @@ zx_status_t Allocator::ResetFromStorage(fs::DeviceTransactionHandler& transactio
                             .length = NodeMapBlocks(info),
                         }});
 
+  // The block map is about to be overwritten from disk.
+  InvalidateFreeExtentIndex();
   return transaction_handler.RunRequests(operations);
 }
 
@@ -12,6 +12,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <mutex>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -20,6 +21,7 @@
 #include <safemath/safe_conversions.h>
 
 #include "src/storage/blobfs/allocator/extent_reserver.h"
+#include "src/storage/blobfs/allocator/free_extent_index.h"
 #include "src/storage/blobfs/allocator/node_reserver.h"
 #include "src/storage/blobfs/common.h"
 #include "src/storage/blobfs/format.h"
@@ -50,6 +52,7 @@ zx::status<bool> BaseAllocator::IsBlockAllocated(uint64_t block_number) const {
 
 zx_status_t BaseAllocator::ReserveBlocks(uint64_t num_blocks,
                                          std::vector<ReservedExtent>* out_extents) {
+  const size_t first_extent = out_extents->size();
   uint64_t actual_blocks;
 
   // TODO(smklein): If we allocate blocks up to the end of the block map, extend, and continue
@@ -57,20 +60,24 @@ zx_status_t BaseAllocator::ReserveBlocks(uint64_t num_blocks,
   // allocated blocks existed we could resize ahead-of-time and flatten this case, as an
   // optimization.
 
-  if ((FindBlocks(0, num_blocks, out_extents, &actual_blocks) != ZX_OK)) {
-    // If we have run out of blocks, attempt to add block slices via FVM. The new 'hint' is the
-    // first location we could try to find blocks after merely extending the allocation maps.
-    uint64_t hint = block_bitmap_.size() - std::min(num_blocks, uint64_t{block_bitmap_.size()});
-
+  if ((FindBlocks(num_blocks, out_extents, &actual_blocks) != ZX_OK)) {
+    // If we have run out of blocks, attempt to add block slices via FVM.
     ZX_DEBUG_ASSERT(actual_blocks < num_blocks);
     num_blocks -= actual_blocks;
 
     if (AddBlocks(num_blocks).is_error() ||
-        FindBlocks(hint, num_blocks, out_extents, &actual_blocks) != ZX_OK) {
+        FindBlocks(num_blocks, out_extents, &actual_blocks) != ZX_OK) {
       out_extents->clear();
       return ZX_ERR_NO_SPACE;
     }
   }
+
+  // Lay the blob out front to back, whatever order the regions were found in. This can't be done
+  // while holding the reservation lock because moving over a ReservedExtent unreserves it.
+  std::sort(out_extents->begin() + first_extent, out_extents->end(),
+            [](const ReservedExtent& a, const ReservedExtent& b) {
+              return a.extent().Start() < b.extent().Start();
+            });
   return ZX_OK;
 }
 
@@ -81,6 +88,9 @@ void BaseAllocator::MarkBlocksAllocated(const ReservedExtent& reserved_extent) {
 
   ZX_DEBUG_ASSERT(CheckBlocksUnallocated(start, end));
   ZX_ASSERT(block_bitmap_.Set(start, end) == ZX_OK);
+
+  std::scoped_lock lock(mutex());
+  free_extents_.Allocate(start, extent.Length());
 }
 
 ReservedExtent BaseAllocator::FreeBlocks(const Extent& extent) {
@@ -89,6 +99,10 @@ ReservedExtent BaseAllocator::FreeBlocks(const Extent& extent) {
 
   ZX_DEBUG_ASSERT(CheckBlocksAllocated(start, end));
   ZX_ASSERT(block_bitmap_.Clear(start, end) == ZX_OK);
+  {
+    std::scoped_lock lock(mutex());
+    free_extents_.Free(start, extent.Length());
+  }
 
   // Keep the blocks reserved until freeing the blocks has been persisted.
   return ExtentReserver::Reserve(extent);
@@ -180,6 +194,11 @@ void BaseAllocator::UnreserveNode(ReservedNode node) {
 
 uint64_t BaseAllocator::ReservedNodeCount() const { return reserved_node_count_; }
 
+void BaseAllocator::InvalidateFreeExtentIndex() {
+  std::scoped_lock lock(mutex());
+  free_extents_.Invalidate();
+}
+
 bool BaseAllocator::CheckBlocksUnallocated(uint64_t start_block, uint64_t end_block) const {
   ZX_DEBUG_ASSERT(end_block > start_block);
   size_t first_allocated;
@@ -187,171 +206,95 @@ bool BaseAllocator::CheckBlocksUnallocated(uint64_t start_block, uint64_t end_bl
                             &first_allocated) == ZX_OK;
 }
 
-bool BaseAllocator::FindUnallocatedExtent(uint64_t start, uint64_t block_length,
-                                          uint64_t* out_start, uint64_t* out_block_length) {
-  bool restart = false;
-  // Constraint: No contiguous run which can extend beyond the block
-  // bitmap.
-  block_length = std::min(block_length, block_bitmap_.size() - start);
-  size_t first_already_allocated;
-  if (!block_bitmap_.Scan(start, start + block_length, false, &first_already_allocated)) {
-    // Part of [start, start + block_length) is already allocated.
-    if (first_already_allocated == start) {
-      // Jump past as much of the allocated region as possible, and then restart searching for more
-      // free blocks.
-      size_t first_free;
-      if (block_bitmap_.Scan(start, block_bitmap_.size(), true, &first_free)) {
-        // All remaining blocks are already allocated.
-        start = block_bitmap_.size();
-      } else {
-        // Not all blocks are allocated; jump to the first free block we can find.
-        ZX_DEBUG_ASSERT(first_free > start);
-        start = first_free;
-      }
-      // We recommend restarting the search in this case because although there was a prefix
-      // collision, the suffix of this region may be followed by additional free blocks.
-      restart = true;
-    } else {
-      // Since |start| is free, we'll try allocating from as much of this region as we can until we
-      // hit previously-allocated blocks.
-      ZX_DEBUG_ASSERT(first_already_allocated > start);
-      block_length = first_already_allocated - start;
+template <typename Callback>
+void BaseAllocator::ForEachUnreservedRegion(uint64_t start, uint64_t length, Callback callback) {
+  const uint64_t end = start + length;
+  for (auto reserved = ReservedBlocksCbegin(); reserved != ReservedBlocksCend() && start < end;
+       ++reserved) {
+    if (reserved->end() <= start) {
+      continue;
+    }
+    if (reserved->start() >= end) {
+      break;
     }
+    if (reserved->start() > start) {
+      callback(BlockRegion{.offset = start, .length = reserved->start() - start});
+    }
+    start = reserved->end();
+  }
+  if (start < end) {
+    callback(BlockRegion{.offset = start, .length = end - start});
   }
-
-  *out_start = start;
-  *out_block_length = block_length;
-  return restart;
 }
 
-bool BaseAllocator::MunchUnreservedExtents(bitmap::RleBitmap::const_iterator reserved_iterator,
-                                           uint64_t remaining_blocks, uint64_t start,
-                                           uint64_t block_length,
-                                           std::vector<ReservedExtent>* out_extents,
-                                           bitmap::RleBitmap::const_iterator* out_reserved_iterator,
-                                           uint64_t* out_remaining_blocks, uint64_t* out_start,
-                                           uint64_t* out_block_length) {
-  bool collision = false;
-
-  const uint64_t start_max = start + block_length;
-
-  // There are remaining in-flight reserved blocks we might collide with; verify this allocation is
-  // not being held by another write operation.
-  while ((start < start_max) && (block_length != 0) &&
-         (reserved_iterator != ReservedBlocksCend())) {
-    // We should only be considering blocks which are not allocated.
-    ZX_DEBUG_ASSERT(start < start + block_length);
-    ZX_DEBUG_ASSERT(block_bitmap_.Scan(start, start + block_length, false));
-
-    if (reserved_iterator->end() <= start) {
-      // The reserved iterator is lagging behind this region.
-      ZX_DEBUG_ASSERT(reserved_iterator != ReservedBlocksCend());
-      reserved_iterator++;
-    } else if (start + block_length <= reserved_iterator->start()) {
-      // The remaining reserved blocks occur after this free region; this allocation doesn't
-      // collide.
+std::optional<BlockRegion> BaseAllocator::FindSmallestFreeRegion(uint64_t min_length) {
+  std::optional<BlockRegion> best;
+  const FreeExtentIndex::RunsByLength& runs = free_extents_.runs_by_length();
+  for (auto run = runs.lower_bound({min_length, 0}); run != runs.end(); ++run) {
+    // Reservations can only make a run smaller, so no later run can do better.
+    if (best && run->first >= best->length) {
       break;
-    } else {
-      // The reserved region ends at/after the start of the allocation. The reserved region starts
-      // before the end of the allocation.
-      //
-      // This implies a collision exists.
-      collision = true;
-      if (start >= reserved_iterator->start() && start + block_length <= reserved_iterator->end()) {
-        // The collision is total; move past the entire reserved region.
-        start = reserved_iterator->end();
-        block_length = 0;
-        break;
-      }
-      if (start < reserved_iterator->start()) {
-        // Free Prefix: Although the observed range overlaps with a reservation, it includes a
-        // prefix which is free from overlap.
-        //
-        // Take the most of the proposed allocation *before* the reservation.
-        Extent extent(start, reserved_iterator->start() - start);
-        ZX_DEBUG_ASSERT(
-            block_bitmap_.Scan(extent.Start(), extent.Start() + extent.Length(), false));
-        ZX_DEBUG_ASSERT(block_length > extent.Length());
-        // Jump past the end of this reservation.
-        uint64_t reserved_length = reserved_iterator->end() - reserved_iterator->start();
-        if (block_length > extent.Length() + reserved_length) {
-          block_length -= extent.Length() + reserved_length;
-        } else {
-          block_length = 0;
-        }
-        start = reserved_iterator->end();
-        remaining_blocks -= extent.Length();
-        out_extents->push_back(ExtentReserver::ReserveLocked(extent));
-        reserved_iterator = ReservedBlocksCbegin();
-      } else {
-        // Free Suffix: The observed range overlaps with a reservation, but not entirely.
-        //
-        // Jump to the end of the reservation, as free space exists there.
-        ZX_DEBUG_ASSERT(start + block_length > reserved_iterator->end());
-        block_length = (start + block_length) - reserved_iterator->end();
-        start = reserved_iterator->end();
-      }
     }
+    ForEachUnreservedRegion(run->second, run->first, [&](BlockRegion region) {
+      if (region.length >= min_length && (!best || region.length < best->length)) {
+        best = region;
+      }
+    });
   }
+  return best;
+}
 
-  *out_remaining_blocks = remaining_blocks;
-  *out_reserved_iterator = reserved_iterator;
-  *out_start = start;
-  *out_block_length = block_length;
-  return collision;
+std::optional<BlockRegion> BaseAllocator::FindLargestFreeRegion() {
+  std::optional<BlockRegion> best;
+  const FreeExtentIndex::RunsByLength& runs = free_extents_.runs_by_length();
+  for (auto run = runs.rbegin(); run != runs.rend(); ++run) {
+    if (best && run->first <= best->length) {
+      break;
+    }
+    ForEachUnreservedRegion(run->second, run->first, [&](BlockRegion region) {
+      if (!best || region.length > best->length) {
+        best = region;
+      }
+    });
+  }
+  return best;
 }
 
-zx_status_t BaseAllocator::FindBlocks(uint64_t start, uint64_t num_blocks,
-                                      std::vector<ReservedExtent>* out_extents,
+zx_status_t BaseAllocator::FindBlocks(uint64_t num_blocks, std::vector<ReservedExtent>* out_extents,
                                       uint64_t* out_actual_blocks) {
   std::scoped_lock lock(mutex());
 
-  // Using a single iterator over the reserved allocation map lets us avoid re-scanning portions of
-  // the reserved map. This is possible because the |reserved_blocks_| map should be immutable for
-  // the duration of this method, unless we actually find blocks, at which point the iterator is
-  // reset.
-  auto reserved_iterator = ReservedBlocksCbegin();
+  if (!free_extents_.valid() || free_extents_.block_count() != block_bitmap_.size()) {
+    free_extents_.Reset(block_bitmap_);
+  }
 
   uint64_t remaining_blocks = num_blocks;
   while (remaining_blocks != 0) {
-    // Look for |block_length| contiguous free blocks.
-    if (start >= block_bitmap_.size()) {
-      *out_actual_blocks = num_blocks - remaining_blocks;
-      return ZX_ERR_NO_SPACE;
-    }
     // Constraint: No contiguous run longer than the maximum permitted extent.
     uint64_t block_length = std::min(remaining_blocks, Extent::kBlockCountMax);
 
-    bool restart_search = FindUnallocatedExtent(start, block_length, &start, &block_length);
-    if (restart_search) {
-      continue;
+    // Taking the smallest region that fits keeps the large regions intact for large blobs. If
+    // nothing fits, taking the largest region minimizes the number of extents.
+    std::optional<BlockRegion> region = FindSmallestFreeRegion(block_length);
+    if (!region) {
+      region = FindLargestFreeRegion();
     }
-
-    // [start, start + block_length) is now a valid region of free blocks.
-    //
-    // Take the subset of this range that doesn't intersect with reserved blocks, and add it to our
-    // extent list.
-    restart_search = MunchUnreservedExtents(reserved_iterator, remaining_blocks, start,
-                                            block_length, out_extents, &reserved_iterator,
-                                            &remaining_blocks, &start, &block_length);
-    if (restart_search) {
+    if (!region) {
+      break;
+    }
+    if (!block_bitmap_.Scan(region->offset, region->offset + region->length, false)) {
+      // The bitmap was modified behind the index's back.
+      free_extents_.Reset(block_bitmap_);
       continue;
     }
 
-    if (block_length != 0) {
-      // The remainder of this window exists and does not collide with either the reservation map
-      // nor the committed blocks.
-      Extent extent(start, block_length);
-      ZX_DEBUG_ASSERT(block_bitmap_.Scan(extent.Start(), extent.Start() + extent.Length(), false));
-      start += extent.Length();
-      remaining_blocks -= extent.Length();
-      out_extents->push_back(ExtentReserver::ReserveLocked(extent));
-      reserved_iterator = ReservedBlocksCbegin();
-    }
+    Extent extent(region->offset, std::min(region->length, block_length));
+    remaining_blocks -= extent.Length();
+    out_extents->push_back(ExtentReserver::ReserveLocked(extent));
   }
 
-  *out_actual_blocks = num_blocks;
-  return ZX_OK;
+  *out_actual_blocks = num_blocks - remaining_blocks;
+  return remaining_blocks == 0 ? ZX_OK : ZX_ERR_NO_SPACE;
 }
 
 zx::status<uint32_t> BaseAllocator::FindNode() {
@@ -8,12 +8,14 @@
 #include <lib/stdcompat/span.h>
 
 #include <cstdint>
+#include <optional>
 #include <vector>
 
 #include <bitmap/raw-bitmap.h>
 #include <id_allocator/id_allocator.h>
 
 #include "src/storage/blobfs/allocator/extent_reserver.h"
+#include "src/storage/blobfs/allocator/free_extent_index.h"
 #include "src/storage/blobfs/allocator/node_reserver.h"
 #include "src/storage/blobfs/common.h"
 #include "src/storage/blobfs/format.h"
@@ -101,42 +103,37 @@ class BaseAllocator : private ExtentReserver, private NodeReserverInterface, pub
   id_allocator::IdAllocator& GetNodeBitmap() { return *node_bitmap_; }
   const id_allocator::IdAllocator& GetNodeBitmap() const { return *node_bitmap_; }
 
+  // Must be called after the block bitmap is modified without going through this class, e.g. when
+  // it is reloaded from disk.
+  void InvalidateFreeExtentIndex();
+
  private:
   // Returns true if [start_block, end_block) are unallocated.
   bool CheckBlocksUnallocated(uint64_t start_block, uint64_t end_block) const;
 
-  // Avoids a collision with the committed block map, moving the starting location / block length to
-  // find a region with no collision.
-  //
-  // Returns true if we should restart searching to attempt to maximally munch from the allocation
-  // pool.
-  bool FindUnallocatedExtent(uint64_t start, uint64_t block_length, uint64_t* out_start,
-                             uint64_t* out_block_length);
-
-  // Identifies the subset of blocks which don't collide with pending reservations. If any
-  // collisions exist, maximally munches the available free space into newly reserved extents.
-  //
-  // It is assumed that [start, start + block_length) is unallocated; this is internally asserted.
-  // |FindUnallocatedExtent| should be invoked first to provide this guarantee.
-  //
-  // Returns true if we should restart searching to attempt to maximally munch from the allocation
-  // pool. Otherwise, no collisions with pending reservations exist.
-  bool MunchUnreservedExtents(bitmap::RleBitmap::const_iterator reserved_iterator,
-                              uint64_t remaining_blocks, uint64_t start, uint64_t block_length,
-                              std::vector<ReservedExtent>* out_extents,
-                              bitmap::RleBitmap::const_iterator* out_reserved_iterator,
-                              uint64_t* out_remaining_blocks, uint64_t* out_start,
-                              uint64_t* out_block_length) __TA_REQUIRES(mutex());
-
   // Searches for |num_blocks| free blocks between the block_map_ and reserved_blocks_ bitmaps.
   //
-  // Appends the (possibly non-contiguous) region of allocated blocks to |out_extents|.
+  // Appends the (possibly non-contiguous) region of allocated blocks to |out_extents|, in disk
+  // order. Uses as few extents as the free space allows: the smallest free region which holds all
+  // of the blocks is preferred, and failing that the largest free regions are used first.
   //
   // May fail if not enough blocks can be found. In this case, an error will be returned, and the
   // number of found blocks will be returned in |out_actual_blocks|. This result is guaranteed to be
   // less than or equal to |num_blocks|.
-  zx_status_t FindBlocks(uint64_t start, uint64_t num_blocks,
-                         std::vector<ReservedExtent>* out_extents, uint64_t* out_actual_blocks);
+  zx_status_t FindBlocks(uint64_t num_blocks, std::vector<ReservedExtent>* out_extents,
+                         uint64_t* out_actual_blocks);
+
+  // Returns the smallest region of at least |min_length| blocks which is neither allocated nor
+  // reserved, if there is one.
+  std::optional<BlockRegion> FindSmallestFreeRegion(uint64_t min_length) __TA_REQUIRES(mutex());
+
+  // Returns the largest region which is neither allocated nor reserved, if there is one.
+  std::optional<BlockRegion> FindLargestFreeRegion() __TA_REQUIRES(mutex());
+
+  // Calls |callback| with each part of [start, start + length) which isn't reserved, in order.
+  template <typename Callback>
+  void ForEachUnreservedRegion(uint64_t start, uint64_t length, Callback callback)
+      __TA_REQUIRES(mutex());
 
   // Finds an unallocated node.
   zx::status<uint32_t> FindNode();
@@ -144,6 +141,9 @@ class BaseAllocator : private ExtentReserver, private NodeReserverInterface, pub
   // The number of nodes currently reserved.
   uint64_t reserved_node_count_ = 0;
   RawBitmap block_bitmap_;
+  // The free runs of |block_bitmap_|. Built on first use, and rebuilt whenever the bitmap is resized
+  // or changed without going through this class.
+  FreeExtentIndex free_extents_ __TA_GUARDED(mutex());
   std::unique_ptr<id_allocator::IdAllocator> node_bitmap_;
 };
 
@@ -0,0 +1,111 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/storage/blobfs/allocator/free_extent_index.h"
+
+#include <zircon/assert.h>
+
+#include <iterator>
+
+namespace blobfs {
+
+void FreeExtentIndex::Reset(const RawBitmap& bitmap) {
+  Invalidate();
+  block_count_ = bitmap.size();
+  size_t end = 0;
+  size_t start;
+  while (!bitmap.Scan(end, block_count_, true, &start)) {
+    if (bitmap.Scan(start, block_count_, false, &end)) {
+      end = block_count_;
+    }
+    Insert(start, end - start);
+  }
+  valid_ = true;
+}
+
+void FreeExtentIndex::Invalidate() {
+  valid_ = false;
+  block_count_ = 0;
+  free_block_count_ = 0;
+  runs_by_start_.clear();
+  runs_by_length_.clear();
+}
+
+void FreeExtentIndex::Free(uint64_t start, uint64_t length) {
+  if (!valid_ || length == 0) {
+    return;
+  }
+  uint64_t end = start + length;
+  if (end > block_count_) {
+    Invalidate();
+    return;
+  }
+
+  auto next = runs_by_start_.lower_bound(start);
+  if (next != runs_by_start_.end() && next->first < end) {
+    Invalidate();
+    return;
+  }
+  if (next != runs_by_start_.begin()) {
+    auto prev = std::prev(next);
+    uint64_t prev_end = prev->first + prev->second;
+    if (prev_end > start) {
+      Invalidate();
+      return;
+    }
+    if (prev_end == start) {
+      start = prev->first;
+      Erase(prev);
+    }
+  }
+  if (next != runs_by_start_.end() && next->first == end) {
+    end += next->second;
+    Erase(next);
+  }
+  Insert(start, end - start);
+}
+
+void FreeExtentIndex::Allocate(uint64_t start, uint64_t length) {
+  if (!valid_ || length == 0) {
+    return;
+  }
+  uint64_t end = start + length;
+
+  // Find the run containing |start|.
+  auto run = runs_by_start_.upper_bound(start);
+  if (run == runs_by_start_.begin()) {
+    Invalidate();
+    return;
+  }
+  --run;
+  uint64_t run_start = run->first;
+  uint64_t run_end = run_start + run->second;
+  if (end > run_end) {
+    Invalidate();
+    return;
+  }
+
+  Erase(run);
+  if (run_start < start) {
+    Insert(run_start, start - run_start);
+  }
+  if (end < run_end) {
+    Insert(end, run_end - end);
+  }
+}
+
+void FreeExtentIndex::Insert(uint64_t start, uint64_t length) {
+  ZX_DEBUG_ASSERT(length > 0);
+  runs_by_start_.emplace(start, length);
+  runs_by_length_.emplace(length, start);
+  free_block_count_ += length;
+}
+
+void FreeExtentIndex::Erase(std::map<uint64_t, uint64_t>::iterator run) {
+  runs_by_length_.erase({run->second, run->first});
+  free_block_count_ -= run->second;
+  runs_by_start_.erase(run);
+}
+
+}  // namespace blobfs
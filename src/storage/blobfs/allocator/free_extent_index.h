@@ -0,0 +1,70 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SRC_STORAGE_BLOBFS_ALLOCATOR_FREE_EXTENT_INDEX_H_
+#define SRC_STORAGE_BLOBFS_ALLOCATOR_FREE_EXTENT_INDEX_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <set>
+#include <utility>
+
+#include "src/storage/blobfs/common.h"
+
+namespace blobfs {
+
+// Tracks the maximal runs of free blocks in a block bitmap, ordered both by position and by length,
+// so that allocations can find a suitably sized run without scanning the bitmap.
+//
+// The index has to be told about every change made to the bitmap. If it is told about a change
+// which doesn't match what it has recorded, it assumes that the bitmap was changed behind its back
+// and invalidates itself; it's up to the owner to |Reset()| it before it's used again.
+class FreeExtentIndex {
+ public:
+  // Free runs ordered by (length, start), so the smallest run of at least some length is found with
+  // |lower_bound|.
+  using RunsByLength = std::set<std::pair<uint64_t, uint64_t>>;
+
+  FreeExtentIndex() = default;
+
+  // Rebuilds the index from the block bitmap.
+  void Reset(const RawBitmap& bitmap);
+
+  // Discards the contents of the index. |valid()| is false until the next |Reset()|.
+  void Invalidate();
+
+  bool valid() const { return valid_; }
+
+  // The size of the bitmap the index was built from.
+  uint64_t block_count() const { return block_count_; }
+
+  // Records that [start, start + length) has been freed, merging it with the neighbouring runs.
+  // Does nothing if the index isn't valid.
+  void Free(uint64_t start, uint64_t length);
+
+  // Records that [start, start + length) has been allocated, which must lie within one free run.
+  // Does nothing if the index isn't valid.
+  void Allocate(uint64_t start, uint64_t length);
+
+  const RunsByLength& runs_by_length() const { return runs_by_length_; }
+
+  uint64_t free_block_count() const { return free_block_count_; }
+
+ private:
+  void Insert(uint64_t start, uint64_t length);
+  void Erase(std::map<uint64_t, uint64_t>::iterator run);
+
+  bool valid_ = false;
+  uint64_t block_count_ = 0;
+  uint64_t free_block_count_ = 0;
+
+  // Maps the start of each free run to its length.
+  std::map<uint64_t, uint64_t> runs_by_start_;
+  RunsByLength runs_by_length_;
+};
+
+}  // namespace blobfs
+
+#endif  // SRC_STORAGE_BLOBFS_ALLOCATOR_FREE_EXTENT_INDEX_H_
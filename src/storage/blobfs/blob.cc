@@ -12,6 +12,7 @@
 #include <lib/sync/completion.h>
 #include <lib/syslog/cpp/macros.h>
 #include <lib/zx/status.h>
+#include <lib/zx/stream.h>
 #include <stdlib.h>
 #include <string.h>
 #include <strings.h>
@@ -23,6 +24,7 @@
 #include <algorithm>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <string_view>
 #include <utility>
 #include <vector>
@@ -32,6 +34,7 @@
 #include <fbl/string_buffer.h>
 #include <safemath/checked_math.h>
 
+#include "src/lib/chunked-compression/multithreaded-chunked-compressor.h"
 #include "src/lib/digest/digest.h"
 #include "src/lib/digest/merkle-tree.h"
 #include "src/lib/digest/node-digest.h"
@@ -114,6 +117,12 @@ struct Blob::WriteInfo {
 
   fzl::OwnedVmoMapper buffer;
 
+  // When compressing on |Blobfs::write_compressor()| rather than with |compressor|, this compresses
+  // each chunk of |buffer| as soon as it's been written, and |compressed_data| receives the result
+  // once all of the data has been written. Declared after |buffer| since it refers to it.
+  std::optional<chunked_compression::MultithreadedChunkedCompressor::Stream> compression_stream;
+  std::vector<uint8_t> compressed_data;
+
   std::unique_ptr<BlobLayout> blob_layout = nullptr;
 
   std::unique_ptr<fs::DataStreamer> streamer = nullptr;
@@ -226,7 +235,7 @@ zx_status_t Blob::PrepareWrite(uint64_t size_data, bool compress) {
   // Initialize write buffers. For compressed blobs, we only write into the compression buffer.
   // For uncompressed or pre-compressed blobs, we write into the data vmo.
   if (size_data > 0) {
-    if (compress) {
+    if (compress && blobfs_->write_compressor() == nullptr) {
       write_info_->compressor =
           BlobCompressor::Create(blobfs_->write_compression_settings(), blob_size_);
       if (!write_info_->compressor) {
@@ -245,6 +254,16 @@ zx_status_t Blob::PrepareWrite(uint64_t size_data, bool compress) {
                        << "): " << zx_status_get_string(status);
         return status;
       }
+      if (compress) {
+        zx::status stream = blobfs_->write_compressor()->StartStream(
+            ChunkedCompressor::ParamsForSettings(blobfs_->write_compression_settings(), blob_size_),
+            cpp20::span(static_cast<const uint8_t*>(write_info_->buffer.start()), blob_size_));
+        if (stream.is_error()) {
+          FX_LOGS(ERROR) << "Failed to initialize compressor: " << stream.status_string();
+          return stream.error_value();
+        }
+        write_info_->compression_stream = std::move(stream).value();
+      }
     }
 
     write_info_->streamer =
@@ -392,8 +411,9 @@ zx_status_t Blob::WriteInternal(const void* data, size_t len, size_t* actual) {
 
   const size_t to_write = std::min(len, write_info_->data_size - write_info_->bytes_written);
 
-  // If we're doing dynamic compression, write the incoming data into the compressor, otherwise
-  // cache the data in the write buffer VMO.
+  // If we're doing dynamic compression on this thread, write the incoming data into the compressor,
+  // otherwise cache the data in the write buffer VMO. Compression on |Blobfs::write_compressor()|
+  // reads the data from there.
   if (write_info_->compressor) {
     if (zx_status_t status = write_info_->compressor->Update(data, to_write); status != ZX_OK) {
       return status;
@@ -406,6 +426,9 @@ zx_status_t Blob::WriteInternal(const void* data, size_t len, size_t* actual) {
       FX_LOGS(ERROR) << "VMO write failed: " << zx_status_get_string(status);
       return status;
     }
+    if (write_info_->compression_stream) {
+      write_info_->compression_stream->SetAvailable(write_info_->bytes_written + to_write);
+    }
   }
 
   // If the blob data is pre-compressed, ensure we've initialized the decompressor first.
@@ -471,24 +494,41 @@ zx_status_t Blob::Commit() {
   }
 
   const size_t merkle_size = write_info_->merkle_tree_creator.GetTreeLength();
-  bool compress = write_info_->compressor.has_value();
-  if (compress) {
+  bool compress = false;
+  CompressionAlgorithm compression_algorithm = CompressionAlgorithm::kUncompressed;
+  cpp20::span<const uint8_t> compressed_data;
+  if (write_info_->compressor) {
     if (zx_status_t status = write_info_->compressor->End(); status != ZX_OK) {
       return status;
     }
-    // If we're using the chunked compressor, abort compression if we're not going to get any
-    // savings.  We can't easily do it for the other compression formats without changing the
-    // decompression API to support streaming.
-    if (write_info_->compressor->algorithm() == CompressionAlgorithm::kChunked &&
-        fbl::round_up(write_info_->compressor->Size() + merkle_size, GetBlockSize()) >=
-            fbl::round_up(blob_size_ + merkle_size, GetBlockSize())) {
-      compress = false;
+    compress = true;
+    compression_algorithm = write_info_->compressor->algorithm();
+    compressed_data = cpp20::span(static_cast<const uint8_t*>(write_info_->compressor->Data()),
+                                  write_info_->compressor->Size());
+  } else if (write_info_->compression_stream) {
+    zx::status archive = write_info_->compression_stream->Finish();
+    write_info_->compression_stream.reset();
+    if (archive.is_error()) {
+      FX_LOGS(ERROR) << "Failed to compress blob: " << archive.status_string();
+      return archive.error_value();
     }
+    write_info_->compressed_data = std::move(archive).value();
+    compress = true;
+    compression_algorithm = CompressionAlgorithm::kChunked;
+    compressed_data = write_info_->compressed_data;
+  }
+  // If we're using the chunked compressor, abort compression if we're not going to get any
+  // savings.  We can't easily do it for the other compression formats without changing the
+  // decompression API to support streaming.
+  if (compress && compression_algorithm == CompressionAlgorithm::kChunked &&
+      fbl::round_up(compressed_data.size() + merkle_size, GetBlockSize()) >=
+          fbl::round_up(blob_size_ + merkle_size, GetBlockSize())) {
+    compress = false;
   }
 
   if (compress) {
-    write_info_->data_format = write_info_->compressor->algorithm();
-    write_info_->data_size = write_info_->compressor->Size();
+    write_info_->data_format = compression_algorithm;
+    write_info_->data_size = compressed_data.size();
   }
 
   fs::Duration generation_time;
@@ -508,9 +548,7 @@ zx_status_t Blob::Commit() {
 
   if (compress) {
     // The data comes from the compression buffer.
-    data_ptr = &data.emplace<SimpleBlobDataProducer>(
-        cpp20::span(static_cast<const uint8_t*>(write_info_->compressor->Data()),
-                    write_info_->compressor->Size()));
+    data_ptr = &data.emplace<SimpleBlobDataProducer>(compressed_data);
   } else if (write_info_->compressor) {
     // In this case, we've decided against compressing because there are no savings, so we have to
     // decompress.
@@ -521,7 +559,8 @@ zx_status_t Blob::Commit() {
     }
     data_ptr = &data.emplace<DecompressBlobDataProducer>(std::move(producer_or).value());
   } else {
-    // The data comes from the data buffer.
+    // The data comes from the data buffer. This includes data which was compressed on
+    // |Blobfs::write_compressor()| without any savings, since the buffer still holds it.
     const uint8_t* buff = static_cast<const uint8_t*>(write_info_->buffer.start());
     data_ptr = &data.emplace<SimpleBlobDataProducer>(
         cpp20::span(buff + write_info_->bytes_persisted,
@@ -931,6 +970,34 @@ zx_status_t Blob::Verify() {
   }
 }
 
+zx_status_t Blob::Prefetch(uint64_t offset, uint64_t length) {
+  TRACE_DURATION("blobfs", "Blob::Prefetch", "offset", offset, "length", length);
+  {
+    std::lock_guard lock(mutex_);
+    if (state_ != BlobState::kReadable || deletable_)
+      return ZX_ERR_BAD_STATE;
+    if (blob_size_ == 0 || offset >= blob_size_)
+      return ZX_OK;
+
+    // Unlike LoadVmosFromDisk(), this doesn't require an open connection: a blob that is loaded
+    // but has no references is in the same state as one which was opened and closed again, and
+    // the cache retains it the same way.
+    if (!IsDataLoaded()) {
+      if (zx_status_t status = LoadPagedVmosFromDisk(); status != ZX_OK)
+        return status;
+      SetPagedVmoName(false);
+    }
+  }
+
+  // Committing reenters this blob on a pager thread, so only the shared lock may be held here, see
+  // Verify().
+  fs::SharedLock lock(mutex_);
+  if (!paged_vmo())
+    return ZX_ERR_BAD_STATE;
+  return paged_vmo().op_range(ZX_VMO_OP_COMMIT, offset, std::min(length, blob_size_ - offset),
+                              nullptr, 0);
+}
+
 void Blob::OnNoPagedVmoClones() {
   // Override the default behavior of PagedVnode to avoid clearing the paged_vmo. We keep this
   // alive for caching purposes as long as this object is alive, and this object's lifetime is
@@ -987,6 +1054,16 @@ void Blob::ActivateLowMemory() {
   // When the pager_reference goes out of scope here, it could delete |this|.
 }
 
+uint64_t Blob::GetMemoryUsage() const {
+  std::lock_guard lock(mutex_);
+  // Only the merkle tree and the verification state loaded with it count; the kernel can reclaim
+  // the pages of the data VMO on its own.
+  if (!loader_info_.layout) {
+    return 0;
+  }
+  return sizeof(Blob) + loader_info_.layout->MerkleTreeSize();
+}
+
 Blob::~Blob() { ActivateLowMemory(); }
 
 fs::VnodeProtocolSet Blob::GetProtocols() const { return fs::VnodeProtocol::kFile; }
@@ -1010,7 +1087,21 @@ zx_status_t Blob::GetNodeInfoForProtocol([[maybe_unused]] fs::VnodeProtocol prot
   if (zx_status_t status = GetReadableEvent(&observer); status != ZX_OK) {
     return status;
   }
-  *info = fs::VnodeRepresentation::File{.observer = std::move(observer)};
+  fs::VnodeRepresentation::File file{.observer = std::move(observer)};
+  // Read-only connections to readable blobs are handed a stream backed by a clone of the paged
+  // VMO, which lets clients read without a round trip to blobfs for every read. Pages that aren't
+  // resident yet are still supplied and verified by the pager.
+  if (rights.read && !rights.write && state() == BlobState::kReadable && blob_size_ > 0) {
+    zx::vmo vmo;
+    if (zx_status_t status = CloneDataVmo(ZX_RIGHTS_BASIC | ZX_RIGHT_READ, &vmo); status != ZX_OK) {
+      return status;
+    }
+    if (zx_status_t status = zx::stream::create(ZX_STREAM_MODE_READ, vmo, 0, &file.stream);
+        status != ZX_OK) {
+      return status;
+    }
+  }
+  *info = std::move(file);
   return ZX_OK;
 }
 
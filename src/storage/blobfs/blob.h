@@ -145,6 +145,10 @@ class Blob final : public CacheNode, fbl::Recyclable<Blob> {
   // Reads in and verifies the contents of this Blob.
   zx_status_t Verify() __TA_EXCLUDES(mutex_);
 
+  // Reads in [|offset|, |offset| + |length|) of the blob's data ahead of it being accessed, loading
+  // the blob first if needed. The blob doesn't need to be open, and is left loaded in the cache.
+  zx_status_t Prefetch(uint64_t offset, uint64_t length) __TA_EXCLUDES(mutex_);
+
  private:
   friend class BlobLoaderTest;
   friend class BlobTest;
@@ -172,6 +176,7 @@ class Blob final : public CacheNode, fbl::Recyclable<Blob> {
   BlobCache& GetCache() final;
   bool ShouldCache() const final __TA_EXCLUDES(mutex_);
   void ActivateLowMemory() final __TA_EXCLUDES(mutex_);
+  uint64_t GetMemoryUsage() const final __TA_EXCLUDES(mutex_);
 
   void set_state(BlobState new_state) __TA_REQUIRES(mutex_) { state_ = new_state; }
   BlobState state() const __TA_REQUIRES_SHARED(mutex_) { return state_; }
@@ -44,7 +44,35 @@ void BlobCache::Reset() {
   ResetLocked();
 }
 
+void BlobCache::SetMemoryBudget(uint64_t bytes) {
+  fbl::AutoLock lock(&hash_lock_);
+  memory_budget_ = bytes;
+  TrimLocked();
+}
+
+void BlobCache::SetMemoryPressure(MemoryPressure level) {
+  fbl::AutoLock lock(&hash_lock_);
+  memory_pressure_ = level;
+  TrimLocked();
+}
+
+void BlobCache::SetLookupObserver(LookupObserver observer) {
+  fbl::AutoLock lock(&hash_lock_);
+  lookup_observer_ = std::move(observer);
+}
+
+void BlobCache::SetMissHandler(MissHandler handler) {
+  fbl::AutoLock lock(&hash_lock_);
+  miss_handler_ = std::move(handler);
+}
+
 void BlobCache::ResetLocked() {
+  // The queues only hold nodes which are also in closed_hash_, which are about to be deleted.
+  probation_queue_.clear();
+  frequent_queue_.clear();
+  probation_bytes_ = 0;
+  frequent_bytes_ = 0;
+
   // All nodes in closed_hash_ have been leaked. If we're attempting to reset the
   // cache, these nodes must be explicitly deleted.
   CacheNode* node = nullptr;
@@ -112,10 +140,14 @@ zx_status_t BlobCache::Lookup(const Digest& digest, fbl::RefPtr<CacheNode>* out)
   // Avoid releasing a reference to |vnode| while holding |hash_lock_|.
   {
     fbl::AutoLock lock(&hash_lock_);
-    zx_status_t status = LookupLocked(digest, &vnode);
+    bool hit = false;
+    zx_status_t status = LookupLocked(digest, &vnode, &hit);
     if (status != ZX_OK) {
       return status;
     }
+    if (lookup_observer_) {
+      lookup_observer_(hit);
+    }
   }
   ZX_DEBUG_ASSERT(vnode != nullptr);
 
@@ -125,7 +157,8 @@ zx_status_t BlobCache::Lookup(const Digest& digest, fbl::RefPtr<CacheNode>* out)
   return ZX_OK;
 }
 
-zx_status_t BlobCache::LookupLocked(const digest::Digest& key, fbl::RefPtr<CacheNode>* out) {
+zx_status_t BlobCache::LookupLocked(const digest::Digest& key, fbl::RefPtr<CacheNode>* out,
+                                    bool* out_hit) {
   ZX_DEBUG_ASSERT(out != nullptr);
 
   // Try to acquire the node from the open hash, if possible.
@@ -149,6 +182,9 @@ zx_status_t BlobCache::LookupLocked(const digest::Digest& key, fbl::RefPtr<Cache
         release_cvar_.Wait(&hash_lock_);
         continue;
       }
+      if (out_hit != nullptr) {
+        *out_hit = true;
+      }
       return ZX_OK;
     }
     break;
@@ -157,7 +193,23 @@ zx_status_t BlobCache::LookupLocked(const digest::Digest& key, fbl::RefPtr<Cache
   // If the node doesn't exist in the open hash, acquire it from the closed hash.
   *out = UpgradeLocked(key);
   if (*out == nullptr) {
-    return ZX_ERR_NOT_FOUND;
+    // Failing that, it may not have been loaded yet.
+    if (!miss_handler_) {
+      return ZX_ERR_NOT_FOUND;
+    }
+    zx::status<fbl::RefPtr<CacheNode>> loaded = miss_handler_(key);
+    if (loaded.is_error()) {
+      return loaded.status_value();
+    }
+    open_hash_.insert(loaded->get());
+    *out = std::move(loaded).value();
+    if (out_hit != nullptr) {
+      *out_hit = false;
+    }
+    return ZX_OK;
+  }
+  if (out_hit != nullptr) {
+    *out_hit = (*out)->GetMemoryUsage() > 0;
   }
   return ZX_OK;
 }
@@ -169,8 +221,8 @@ zx_status_t BlobCache::Add(const fbl::RefPtr<CacheNode>& vnode) {
   fbl::RefPtr<CacheNode> old_node;
   {
     fbl::AutoLock lock(&hash_lock_);
-    if (LookupLocked(vnode->digest(), &old_node) == ZX_OK) {
-      return ZX_ERR_ALREADY_EXISTS;
+    if (zx_status_t status = LookupLocked(vnode->digest(), &old_node); status != ZX_ERR_NOT_FOUND) {
+      return status == ZX_OK ? ZX_ERR_ALREADY_EXISTS : status;
     }
     open_hash_.insert(vnode.get());
   }
@@ -235,6 +287,9 @@ void BlobCache::Downgrade(CacheNode* raw_vnode) {
       break;
     case CachePolicy::NeverEvict:
       break;
+    case CachePolicy::Bounded:
+      QueueLocked(vnode.get());
+      break;
     default:
       ZX_ASSERT_MSG(false, "Unexpected cache policy");
   }
@@ -250,10 +305,80 @@ fbl::RefPtr<CacheNode> BlobCache::UpgradeLocked(const digest::Digest& key) {
   if (raw_vnode == nullptr) {
     return nullptr;
   }
+  // A node which is reopened while it still retains its memory is in repeated use, and is kept in
+  // the frequently used queue the next time it is closed.
+  if (raw_vnode->queue_node_state_.InContainer()) {
+    DequeueLocked(raw_vnode);
+    raw_vnode->reopened_from_cache_ = true;
+  }
   open_hash_.insert(raw_vnode);
   // To have existed in the closed_hash_, this RefPtr must have been leaked. See the complement of
   // this adoption in Downgrade.
   return fbl::ImportFromRawPtr(raw_vnode);
 }
 
+void BlobCache::QueueLocked(CacheNode* vnode) {
+  ZX_DEBUG_ASSERT(!vnode->queue_node_state_.InContainer());
+  const uint64_t usage = vnode->GetMemoryUsage();
+  if (usage == 0) {
+    // There is nothing to retain.
+    vnode->reopened_from_cache_ = false;
+    return;
+  }
+
+  vnode->queued_memory_usage_ = usage;
+  if (vnode->reopened_from_cache_) {
+    frequent_queue_.push_back(vnode);
+    frequent_bytes_ += usage;
+  } else {
+    probation_queue_.push_back(vnode);
+    probation_bytes_ += usage;
+  }
+  TrimLocked();
+}
+
+void BlobCache::DequeueLocked(CacheNode* vnode) {
+  if (!vnode->queue_node_state_.InContainer()) {
+    return;
+  }
+  if (vnode->reopened_from_cache_) {
+    frequent_queue_.erase(*vnode);
+    frequent_bytes_ -= vnode->queued_memory_usage_;
+  } else {
+    probation_queue_.erase(*vnode);
+    probation_bytes_ -= vnode->queued_memory_usage_;
+  }
+  vnode->queued_memory_usage_ = 0;
+}
+
+void BlobCache::TrimLocked() {
+  uint64_t budget = memory_budget_;
+  switch (memory_pressure_) {
+    case MemoryPressure::kNormal:
+      break;
+    case MemoryPressure::kWarning:
+      budget /= 4;
+      break;
+    case MemoryPressure::kCritical:
+      budget = 0;
+      break;
+  }
+
+  // As in 2Q, the probation queue is limited to a quarter of the budget once the frequently used
+  // queue needs the rest, so that a scan over many blobs which are only opened once cannot flush
+  // the blobs in repeated use.
+  while (probation_bytes_ + frequent_bytes_ > budget) {
+    CacheNode* vnode;
+    if (!probation_queue_.is_empty() &&
+        (probation_bytes_ > budget / 4 || frequent_queue_.is_empty())) {
+      vnode = &probation_queue_.front();
+    } else {
+      vnode = &frequent_queue_.front();
+    }
+    DequeueLocked(vnode);
+    vnode->reopened_from_cache_ = false;
+    vnode->ActivateLowMemory();
+  }
+}
+
 }  // namespace blobfs
@@ -10,6 +10,7 @@
 #endif
 
 #include <lib/fit/function.h>
+#include <lib/zx/status.h>
 
 #include <fbl/condition_variable.h>
 #include <fbl/intrusive_wavl_tree.h>
@@ -50,6 +51,37 @@ class BlobCache {
   // Refer to the declaration of |CachePolicy| for more information.
   void SetCachePolicy(CachePolicy policy) { cache_policy_ = policy; }
 
+  // Sets the number of bytes that closed nodes may retain under |CachePolicy::Bounded|. Closed
+  // nodes are placed into a low-memory state as needed to honor the new budget.
+  void SetMemoryBudget(uint64_t bytes);
+
+  // The level of memory pressure on the system, see |SetMemoryPressure()|.
+  enum class MemoryPressure {
+    kNormal,
+    kWarning,
+    kCritical,
+  };
+
+  // Reacts to a change in the memory pressure of the system. Under |kWarning| closed nodes may only
+  // retain a quarter of the memory budget, and under |kCritical| none at all; the budget is
+  // restored with |kNormal|. Only nodes subject to |CachePolicy::Bounded| are affected.
+  void SetMemoryPressure(MemoryPressure level);
+
+  // Sets a callback which is invoked after every successful |Lookup()|. |hit| is true if the node
+  // was open or retained its in-memory state while closed, and false if the node had been placed
+  // into a low-memory state and must be reloaded. The callback is invoked with the lock of the
+  // cache held and must not call back into the cache.
+  using LookupObserver = fit::function<void(bool hit)>;
+  void SetLookupObserver(LookupObserver observer);
+
+  // Sets a callback which creates the node for |digest| when it isn't in the cache, for blobs which
+  // exist on disk but haven't been looked up yet. The callback returns ZX_ERR_NOT_FOUND if there is
+  // no such blob, and the node it returns is added to the live set. Both |Lookup()| and |Add()|
+  // consult it. The callback is invoked with the lock of the cache held; it must not call back into
+  // the cache, nor drop the last reference to a node.
+  using MissHandler = fit::function<zx::status<fbl::RefPtr<CacheNode>>(const Digest& digest)>;
+  void SetMissHandler(MissHandler handler);
+
   // Iterates over all non-evicted cached nodes with strong references, invoking |callback| on each
   // one.
   //
@@ -110,8 +142,11 @@ class BlobCache {
   //
   // Returns ZX_OK if the node is found and returned.
   // Returns ZX_ERR_NOT_FOUND if the node doesn't exist in the cache.
-  zx_status_t LookupLocked(const digest::Digest& key, fbl::RefPtr<CacheNode>* out)
-      __TA_REQUIRES(hash_lock_);
+  //
+  // If |out_hit| is not null, it is set to whether the node was either open or retained its
+  // in-memory state while closed.
+  zx_status_t LookupLocked(const digest::Digest& key, fbl::RefPtr<CacheNode>* out,
+                           bool* out_hit = nullptr) __TA_REQUIRES(hash_lock_);
 
   // Upgrades a Vnode which exists in the |closed_hash_| into |open_hash_|, and acquire the strong
   // reference the Vnode which was leaked by |Downgrade()|, if it exists.
@@ -122,6 +157,17 @@ class BlobCache {
   // Resets the cache by deleting all members |closed_hash_|.
   void ResetLocked() __TA_REQUIRES(hash_lock_);
 
+  // Queues a node which was just closed under |CachePolicy::Bounded|, if it retains any memory, and
+  // trims the queues to the budget.
+  void QueueLocked(CacheNode* vnode) __TA_REQUIRES(hash_lock_);
+
+  // Removes a node from whichever queue it is in, if any.
+  void DequeueLocked(CacheNode* vnode) __TA_REQUIRES(hash_lock_);
+
+  // Places queued nodes into a low-memory state until the memory they retain fits within the
+  // current budget.
+  void TrimLocked() __TA_REQUIRES(hash_lock_);
+
   // We need to define this structure to allow the CacheNodes to be indexable by a key which is
   // larger than a primitive type: the keys are 'digest::kSha256Length' bytes long.
   struct MerkleRootTraits {
@@ -144,6 +190,20 @@ class BlobCache {
   // All 'closed' blobs.
   WAVLTreeByMerkle closed_hash_ __TA_GUARDED(hash_lock_){};
 
+  // Closed blobs retaining memory under |CachePolicy::Bounded|, least recently closed first.
+  // |probation_queue_| holds blobs closed for the first time since they were loaded, and
+  // |frequent_queue_| holds blobs which were reopened from the cache before being closed again.
+  CacheNode::Queue probation_queue_ __TA_GUARDED(hash_lock_);
+  CacheNode::Queue frequent_queue_ __TA_GUARDED(hash_lock_);
+  uint64_t probation_bytes_ __TA_GUARDED(hash_lock_) = 0;
+  uint64_t frequent_bytes_ __TA_GUARDED(hash_lock_) = 0;
+
+  uint64_t memory_budget_ __TA_GUARDED(hash_lock_) = kDefaultCacheMemoryBudget;
+  MemoryPressure memory_pressure_ __TA_GUARDED(hash_lock_) = MemoryPressure::kNormal;
+
+  LookupObserver lookup_observer_ __TA_GUARDED(hash_lock_);
+  MissHandler miss_handler_ __TA_GUARDED(hash_lock_);
+
   // A condition variable which is signalled whenever a CacheNode has been removed from the
   // |open_hash_|. When a CacheNode runs out of references, it exists in the |open_hash_| with no
   // strong references for a short period of time before being removed and either resurrected or
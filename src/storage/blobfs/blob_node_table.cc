@@ -0,0 +1,50 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/storage/blobfs/blob_node_table.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+namespace blobfs {
+namespace {
+
+bool DigestLess(const uint8_t* a, const uint8_t* b) {
+  return memcmp(a, b, digest::kSha256Length) < 0;
+}
+
+}  // namespace
+
+void BlobNodeTable::Add(const digest::Digest& digest, uint32_t node_index) {
+  Entry& entry = entries_.emplace_back();
+  digest.CopyTo(entry.digest);
+  entry.node_index = node_index;
+}
+
+std::optional<digest::Digest> BlobNodeTable::Finalize() {
+  std::sort(entries_.begin(), entries_.end(),
+            [](const Entry& a, const Entry& b) { return DigestLess(a.digest, b.digest); });
+  auto duplicate =
+      std::adjacent_find(entries_.begin(), entries_.end(), [](const Entry& a, const Entry& b) {
+        return memcmp(a.digest, b.digest, digest::kSha256Length) == 0;
+      });
+  if (duplicate != entries_.end()) {
+    return digest::Digest(duplicate->digest);
+  }
+  entries_.shrink_to_fit();
+  return std::nullopt;
+}
+
+BlobNodeTable::Entry* BlobNodeTable::Find(const digest::Digest& digest) {
+  auto entry = std::lower_bound(
+      entries_.begin(), entries_.end(), digest.get(),
+      [](const Entry& entry, const uint8_t* digest) { return DigestLess(entry.digest, digest); });
+  if (entry == entries_.end() || digest != entry->digest || entry->loaded) {
+    return nullptr;
+  }
+  return &*entry;
+}
+
+}  // namespace blobfs
@@ -0,0 +1,55 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SRC_STORAGE_BLOBFS_BLOB_NODE_TABLE_H_
+#define SRC_STORAGE_BLOBFS_BLOB_NODE_TABLE_H_
+
+#include <stdint.h>
+
+#include <optional>
+#include <vector>
+
+#include "src/lib/digest/digest.h"
+
+namespace blobfs {
+
+// A sorted table mapping the Merkle roots of the blobs on disk to their inodes. It is built with a
+// single pass over the node map at mount, which is much cheaper than creating a vnode for every
+// blob, so that the vnodes can instead be created when the blobs are first looked up.
+//
+// Entries are never moved once the table is finalized, so they can be referred to by position.
+// This class is not thread-safe.
+class BlobNodeTable {
+ public:
+  struct Entry {
+    uint8_t digest[digest::kSha256Length];
+    uint32_t node_index;
+    // Whether the blob's extents have already been checked.
+    bool verified = false;
+    // Whether the blob's vnode has been created, after which the blob cache is responsible for it.
+    bool loaded = false;
+  };
+
+  BlobNodeTable() = default;
+
+  // Adds a blob to the table. Must be followed by |Finalize()| before the table is used.
+  void Add(const digest::Digest& digest, uint32_t node_index);
+
+  // Sorts the table. Returns the digest of a blob which was added more than once, if there is one.
+  std::optional<digest::Digest> Finalize();
+
+  // Returns the entry for the blob with |digest|, or null if it isn't in the table or has already
+  // been loaded.
+  Entry* Find(const digest::Digest& digest);
+
+  size_t size() const { return entries_.size(); }
+  Entry& entry(size_t index) { return entries_[index]; }
+
+ private:
+  std::vector<Entry> entries_;
+};
+
+}  // namespace blobfs
+
+#endif  // SRC_STORAGE_BLOBFS_BLOB_NODE_TABLE_H_
@@ -23,8 +23,11 @@
 #include <zircon/syscalls.h>
 #include <zircon/types.h>
 
+#include <algorithm>
 #include <limits>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string_view>
 #include <utility>
 
@@ -46,6 +49,7 @@
 #include "src/storage/blobfs/allocator/node_reserver.h"
 #include "src/storage/blobfs/blob.h"
 #include "src/storage/blobfs/blob_loader.h"
+#include "src/storage/blobfs/blob_node_table.h"
 #include "src/storage/blobfs/blobfs_checker.h"
 #include "src/storage/blobfs/common.h"
 #include "src/storage/blobfs/compression/compressor.h"
@@ -70,6 +74,10 @@ using ::id_allocator::IdAllocator;
 using ::storage::BlockingRingBuffer;
 using ::storage::VmoidRegistry;
 
+// Upper bound on the threads compressing blobs as they're written. Beyond this, writes are more
+// likely to be limited by the client or the disk than by compression.
+constexpr size_t kMaxCompressionThreads = 4;
+
 struct DirectoryCookie {
   size_t index;       // Index into node map
   uint64_t reserved;  // Unused
@@ -81,6 +89,8 @@ const char* CachePolicyToString(CachePolicy policy) {
       return "NEVER_EVICT";
     case CachePolicy::EvictImmediately:
       return "EVICT_IMMEDIATELY";
+    case CachePolicy::Bounded:
+      return "BOUNDED";
   }
 }
 
@@ -260,6 +270,12 @@ zx::status<std::unique_ptr<Blobfs>> Blobfs::Create(async_dispatcher_t* dispatche
                   << CachePolicyToString(*options.pager_backed_cache_policy);
   }
   fs->GetCache().SetCachePolicy(options.cache_policy);
+  fs->GetCache().SetMemoryBudget(options.cache_memory_budget);
+  fs->GetCache().SetLookupObserver(
+      [metrics = fs->GetMetrics()](bool hit) { metrics->UpdateCacheLookup(hit); });
+  fs->GetCache().SetMissHandler([fs = fs.get()](const Digest& digest) {
+    return fs->LoadVnode(digest);
+  });
 
   RawBitmap block_map;
   // Keep the block_map aligned to a block multiple
@@ -359,9 +375,64 @@ zx::status<std::unique_ptr<Blobfs>> Blobfs::Create(async_dispatcher_t* dispatche
 
   fs->InitializeInspectTree();
 
+  fs->verify_thread_ = std::thread(&Blobfs::VerifyUnloadedBlobs, fs.get());
+
+  if (options.prefetch_record_duration > zx::duration()) {
+    fs->page_loader_->prefetch_recorder().Start(options.prefetch_record_duration);
+  }
+  if (!options.prefetch_manifest.empty()) {
+    // Prefetched pages are only kept around by a cache policy which retains closed blobs.
+    const CachePolicy pager_cache_policy =
+        options.pager_backed_cache_policy.value_or(options.cache_policy);
+    zx::status<PrefetchManifest> manifest_or = PrefetchManifest::Parse(options.prefetch_manifest);
+    if (manifest_or.is_error()) {
+      FX_LOGS(WARNING) << "Ignoring invalid prefetch manifest: " << manifest_or.status_string();
+    } else if (pager_cache_policy == CachePolicy::EvictImmediately) {
+      FX_LOGS(INFO) << "Ignoring prefetch manifest with eviction policy "
+                    << CachePolicyToString(pager_cache_policy);
+    } else {
+      fs->prefetch_thread_ =
+          std::thread(&Blobfs::PrefetchBlobs, fs.get(), std::move(manifest_or).value());
+    }
+  }
+
   return zx::ok(std::move(fs));
 }
 
+void Blobfs::PrefetchBlobs(PrefetchManifest manifest) {
+  TRACE_DURATION("blobfs", "Blobfs::PrefetchBlobs", "entries", manifest.entries().size());
+  uint64_t prefetched_bytes = 0;
+  for (const PrefetchManifest::Entry& entry : manifest.entries()) {
+    if (prefetch_cancelled_.load(std::memory_order_relaxed)) {
+      return;
+    }
+    fbl::RefPtr<CacheNode> cache_node;
+    if (GetCache().Lookup(entry.digest, &cache_node) != ZX_OK) {
+      // The manifest was recorded with a different set of blobs.
+      continue;
+    }
+    // Each range is committed with a single request, which the pager serves with as few large
+    // reads as its buffers allow.
+    auto blob = fbl::RefPtr<Blob>::Downcast(std::move(cache_node));
+    if (zx_status_t status = blob->Prefetch(entry.offset, entry.length); status != ZX_OK) {
+      FX_LOGS(DEBUG) << "Failed to prefetch blob " << entry.digest << ": "
+                     << zx_status_get_string(status);
+      continue;
+    }
+    prefetched_bytes += entry.length;
+  }
+  FX_LOGS(INFO) << "Prefetched " << prefetched_bytes << " bytes of " << manifest.entries().size()
+                << " recorded ranges";
+}
+
+fbl::RefPtr<fs::PseudoFile> Blobfs::CreatePrefetchManifestFile() {
+  return fbl::MakeRefCounted<fs::BufferedPseudoFile>([this](fbl::String* output) {
+    std::vector<uint8_t> data = page_loader_->prefetch_recorder().manifest().Serialize();
+    *output = fbl::String(reinterpret_cast<const char*>(data.data()), data.size());
+    return ZX_OK;
+  });
+}
+
 void Blobfs::InitializeInspectTree() {
   fs_inspect::InfoData info{
       .version_major = kBlobfsCurrentMajorVersion,
@@ -854,6 +925,15 @@ Blobfs::Blobfs(async_dispatcher_t* dispatcher, std::unique_ptr<BlockDevice> devi
   ZX_ASSERT(vfs_->is_initialized());
 
   zx::event::create(0, &fs_id_);
+
+  if (writability_ == Writability::Writable &&
+      write_compression_settings_.compression_algorithm == CompressionAlgorithm::kChunked) {
+    const size_t thread_count = std::min<size_t>(zx_system_get_num_cpus(), kMaxCompressionThreads);
+    if (thread_count > 1) {
+      write_compressor_ =
+          std::make_unique<chunked_compression::MultithreadedChunkedCompressor>(thread_count);
+    }
+  }
 }
 
 std::unique_ptr<BlockDevice> Blobfs::Reset() {
@@ -867,6 +947,16 @@ std::unique_ptr<BlockDevice> Blobfs::Reset() {
 
   FX_LOGS(INFO) << "Shutting down";
 
+  // Stop prefetching before any of the blobs it might be reading in are torn down.
+  if (prefetch_thread_.joinable()) {
+    prefetch_cancelled_.store(true, std::memory_order_relaxed);
+    prefetch_thread_.join();
+  }
+  if (verify_thread_.joinable()) {
+    verify_cancelled_.store(true, std::memory_order_relaxed);
+    verify_thread_.join();
+  }
+
   // Shutdown all internal connections to blobfs.
   GetCache().ForAllOpenNodes([](fbl::RefPtr<CacheNode> cache_node) {
     auto blob = fbl::RefPtr<Blob>::Downcast(std::move(cache_node));
@@ -910,6 +1000,7 @@ zx_status_t Blobfs::InitializeVnodes() {
   GetCache().Reset();
   CompressionMetrics compression_metrics;
   uint32_t total_allocated = 0;
+  BlobNodeTable blobs;
 
   for (uint32_t node_index = 0; node_index < info_.inode_count; node_index++) {
     auto inode = GetNode(node_index);
@@ -927,28 +1018,10 @@ zx_status_t Blobfs::InitializeVnodes() {
       continue;
     }
 
-    zx_status_t validation_status =
-        AllocatedExtentIterator::VerifyIteration(GetNodeFinder(), node_index, inode.value().get());
-    if (validation_status != ZX_OK) {
-      // Whatever the more differentiated error is here, the real root issue is the integrity of the
-      // data that was just mirrored from the disk.
-      FX_LOGS(ERROR) << "failed to validate node @ index " << node_index;
-      return ZX_ERR_IO_DATA_INTEGRITY;
-    }
-
-    fbl::RefPtr<Blob> vnode = fbl::MakeRefCounted<Blob>(this, node_index, *inode.value());
-
-    // This blob is added to the cache, where it will quickly be relocated into the "closed set"
-    // once we drop our reference to |vnode|. Although we delay reading any of the contents of the
-    // blob from disk until requested, this pre-caching scheme allows us to quickly verify or deny
-    // the presence of a blob during blob lookup and creation.
-    zx_status_t status = GetCache().Add(vnode);
-    if (status != ZX_OK) {
-      FX_LOGS(ERROR) << "CORRUPTED FILESYSTEM: Duplicate node: " << vnode->digest() << " @ index "
-                     << node_index - 1;
-      return status;
-    }
-
+    // Creating the Vnode and walking the extents of every blob here would make mounting take time
+    // proportional to the number of blobs. Recording the blob is enough to verify or deny the
+    // presence of a blob during blob lookup and creation; the rest is done on first lookup.
+    blobs.Add(Digest(inode->merkle_root_hash), node_index);
     compression_metrics.Update(*inode);
   }
 
@@ -958,12 +1031,75 @@ zx_status_t Blobfs::InitializeVnodes() {
     return ZX_ERR_IO_OVERRUN;
   }
 
+  if (std::optional<Digest> duplicate = blobs.Finalize(); duplicate) {
+    FX_LOGS(ERROR) << "CORRUPTED FILESYSTEM: Duplicate node: " << *duplicate;
+    return ZX_ERR_ALREADY_EXISTS;
+  }
+  {
+    std::lock_guard lock(unloaded_blobs_mutex_);
+    unloaded_blobs_ = std::move(blobs);
+  }
+
   // Only update compression stats if the filesystem is in a valid state.
   inspect_tree_.UpdateCompressionMetrics(compression_metrics);
 
   return ZX_OK;
 }
 
+zx::status<fbl::RefPtr<CacheNode>> Blobfs::LoadVnode(const Digest& digest) {
+  TRACE_DURATION("blobfs", "Blobfs::LoadVnode");
+  std::lock_guard lock(unloaded_blobs_mutex_);
+  BlobNodeTable::Entry* entry = unloaded_blobs_.Find(digest);
+  if (entry == nullptr) {
+    return zx::error(ZX_ERR_NOT_FOUND);
+  }
+  auto inode = GetNode(entry->node_index);
+  if (inode.is_error()) {
+    return inode.take_error();
+  }
+  if (!entry->verified) {
+    if (AllocatedExtentIterator::VerifyIteration(GetNodeFinder(), entry->node_index,
+                                                 inode.value().get()) != ZX_OK) {
+      // Whatever the more differentiated error is here, the real root issue is the integrity of the
+      // data that was just mirrored from the disk.
+      FX_LOGS(ERROR) << "failed to validate node @ index " << entry->node_index;
+      return zx::error(ZX_ERR_IO_DATA_INTEGRITY);
+    }
+    entry->verified = true;
+  }
+  entry->loaded = true;
+  return zx::ok(
+      fbl::RefPtr<CacheNode>(fbl::MakeRefCounted<Blob>(this, entry->node_index, *inode.value())));
+}
+
+void Blobfs::VerifyUnloadedBlobs() {
+  TRACE_DURATION("blobfs", "Blobfs::VerifyUnloadedBlobs");
+  for (size_t i = 0;; ++i) {
+    if (verify_cancelled_.load(std::memory_order_relaxed)) {
+      return;
+    }
+    // The lock is taken for each blob so that lookups aren't held up for long. Blobs which haven't
+    // been loaded can't be modified, so their nodes are stable while it's held.
+    std::lock_guard lock(unloaded_blobs_mutex_);
+    if (i >= unloaded_blobs_.size()) {
+      return;
+    }
+    BlobNodeTable::Entry& entry = unloaded_blobs_.entry(i);
+    if (entry.loaded || entry.verified) {
+      continue;
+    }
+    auto inode = GetNode(entry.node_index);
+    if (inode.is_ok() && AllocatedExtentIterator::VerifyIteration(
+                             GetNodeFinder(), entry.node_index, inode.value().get()) == ZX_OK) {
+      entry.verified = true;
+    } else {
+      // Left unverified, so that looking the blob up fails.
+      FX_LOGS(ERROR) << "CORRUPTED FILESYSTEM: failed to validate node @ index "
+                     << entry.node_index;
+    }
+  }
+}
+
 void Blobfs::ComputeBlobFragmentation(uint32_t node_index, Inode& inode,
                                       FragmentationMetrics& fragmentation_metrics,
                                       FragmentationStats* out_stats) {
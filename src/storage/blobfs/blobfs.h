@@ -22,8 +22,11 @@
 #include <lib/zx/status.h>
 #include <lib/zx/vmo.h>
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
+#include <thread>
 
 #include <bitmap/raw-bitmap.h>
 #include <fbl/algorithm.h>
@@ -33,17 +36,20 @@
 #include <fbl/ref_ptr.h>
 #include <storage/operation/unbuffered_operations_builder.h>
 
+#include "src/lib/chunked-compression/multithreaded-chunked-compressor.h"
 #include "src/lib/digest/digest.h"
 #include "src/lib/storage/block_client/cpp/block_device.h"
 #include "src/lib/storage/block_client/cpp/client.h"
 #include "src/lib/storage/vfs/cpp/journal/journal.h"
 #include "src/lib/storage/vfs/cpp/paged_vfs.h"
+#include "src/lib/storage/vfs/cpp/pseudo_file.h"
 #include "src/lib/storage/vfs/cpp/vnode.h"
 #include "src/storage/blobfs/allocator/allocator.h"
 #include "src/storage/blobfs/allocator/extent_reserver.h"
 #include "src/storage/blobfs/allocator/node_reserver.h"
 #include "src/storage/blobfs/blob_cache.h"
 #include "src/storage/blobfs/blob_loader.h"
+#include "src/storage/blobfs/blob_node_table.h"
 #include "src/storage/blobfs/blobfs_inspect_tree.h"
 #include "src/storage/blobfs/blobfs_metrics.h"
 #include "src/storage/blobfs/common.h"
@@ -57,6 +63,7 @@
 #include "src/storage/blobfs/iterator/extent_iterator.h"
 #include "src/storage/blobfs/mount.h"
 #include "src/storage/blobfs/page_loader.h"
+#include "src/storage/blobfs/prefetch_manifest.h"
 #include "src/storage/blobfs/transaction.h"
 #include "src/storage/blobfs/transaction_manager.h"
 
@@ -141,6 +148,12 @@ class Blobfs : public TransactionManager, public BlockIteratorProvider {
 
   const CompressionSettings& write_compression_settings() { return write_compression_settings_; }
 
+  // Thread pool used to compress blobs as they're written. Null when there's no write compression,
+  // or only one CPU, in which case blobs are compressed on the thread writing them.
+  chunked_compression::MultithreadedChunkedCompressor* write_compressor() {
+    return write_compressor_.get();
+  }
+
   bool CheckBlocksAllocated(uint64_t start_block, uint64_t end_block,
                             uint64_t* first_unset = nullptr) const {
     return allocator_->CheckBlocksAllocated(start_block, end_block, first_unset);
@@ -192,6 +205,10 @@ class Blobfs : public TransactionManager, public BlockIteratorProvider {
   BlobLoader& loader() { return *loader_; }
   PageLoader& page_loader() { return *page_loader_; }
 
+  // Returns a file serving the ranges paged in while recording, see
+  // |MountOptions::prefetch_record_duration|, serialized as a PrefetchManifest.
+  fbl::RefPtr<fs::PseudoFile> CreatePrefetchManifestFile();
+
   zx_status_t RunRequests(const std::vector<storage::BufferedOperation>& operations) override;
 
   // Corruption notifier related.
@@ -252,14 +269,23 @@ class Blobfs : public TransactionManager, public BlockIteratorProvider {
   // block device.
   std::unique_ptr<BlockDevice> Reset();
 
-  // Does a single pass of all blobs, creating uninitialized Vnode
-  // objects for them all.
+  // Does a single pass of all blobs, marking their nodes as allocated and recording them in
+  // |unloaded_blobs_|.
   //
   // By executing this function at mount, we can quickly assert
   // either the presence or absence of a blob on the system without
-  // further scanning.
+  // further scanning. The Vnode for each blob is only created when the blob is first looked up, by
+  // |LoadVnode()|.
   [[nodiscard]] zx_status_t InitializeVnodes();
 
+  // Creates the Vnode of a blob recorded by |InitializeVnodes()|, checking its extents if that
+  // hasn't been done yet. This is the miss handler of the blob cache.
+  zx::status<fbl::RefPtr<CacheNode>> LoadVnode(const Digest& digest);
+
+  // Checks the extents of each blob which hasn't been looked up yet, so that corruption is noticed
+  // without waiting for the blob to be opened. Runs on |verify_thread_|.
+  void VerifyUnloadedBlobs();
+
   // Frees blocks from the allocated map (if allocated) and updates disk if necessary.
   void FreeExtent(const Extent& extent, BlobTransaction& transaction);
 
@@ -303,9 +329,16 @@ class Blobfs : public TransactionManager, public BlockIteratorProvider {
                                 FragmentationMetrics& fragmentation_metrics,
                                 FragmentationStats* out_stats);
 
+  // Reads in the ranges of |manifest| in order. Runs on |prefetch_thread_|, so that mounting isn't
+  // delayed by it.
+  void PrefetchBlobs(PrefetchManifest manifest);
+
   // Possibly-null reference to the Vfs associated with this object. See vfs() getter.
   fs::PagedVfs* vfs_ = nullptr;
 
+  // Declared before the blobs so that it outlives any compression streams they still hold.
+  std::unique_ptr<chunked_compression::MultithreadedChunkedCompressor> write_compressor_;
+
   // Journal object is only created if the filesystem is mounted as writable.
   std::unique_ptr<fs::Journal> journal_;
   Superblock info_;
@@ -347,6 +380,20 @@ class Blobfs : public TransactionManager, public BlockIteratorProvider {
 
   const bool use_streaming_writes_;
   const bool allow_offline_compression_;
+
+  // Replays |MountOptions::prefetch_manifest|, if there is one. Stopped by setting
+  // |prefetch_cancelled_| on teardown.
+  std::thread prefetch_thread_;
+  std::atomic<bool> prefetch_cancelled_ = false;
+
+  // The blobs found on disk at mount which haven't been loaded into the cache yet.
+  std::mutex unloaded_blobs_mutex_;
+  BlobNodeTable unloaded_blobs_ __TA_GUARDED(unloaded_blobs_mutex_);
+
+  // Runs |VerifyUnloadedBlobs()| after mounting. Stopped by setting |verify_cancelled_| on
+  // teardown.
+  std::thread verify_thread_;
+  std::atomic<bool> verify_cancelled_ = false;
 };
 
 }  // namespace blobfs
@@ -57,6 +57,23 @@ void BlobfsMetrics::UpdateLookup(uint64_t size) {
   blobs_opened_total_size_property_.Add(size);
 }
 
+void BlobfsMetrics::UpdateCacheLookup(bool hit) {
+  if (hit) {
+    cache_hits_property_.Add(1);
+  } else {
+    cache_misses_property_.Add(1);
+  }
+}
+
+void BlobfsMetrics::UpdateReadAhead(bool sequential, uint64_t read_ahead_bytes) {
+  if (sequential) {
+    sequential_page_requests_property_.Add(1);
+  } else {
+    random_page_requests_property_.Add(1);
+  }
+  read_ahead_bytes_property_.Add(read_ahead_bytes);
+}
+
 void BlobfsMetrics::UpdateClientWrite(uint64_t data_size, uint64_t merkle_size,
                                       const fs::Duration& enqueue_duration,
                                       const fs::Duration& generate_duration) {
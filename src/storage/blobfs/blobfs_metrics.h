@@ -46,6 +46,16 @@ class BlobfsMetrics final {
   // Updates aggregate information about the number of blobs opened since mounting.
   void UpdateLookup(uint64_t size);
 
+  // Updates aggregate information about lookups in the blob cache since mounting. |hit| is true if
+  // the blob was found with its in-memory state intact, and false if it must be reloaded.
+  void UpdateCacheLookup(bool hit);
+
+  // Updates aggregate information about the read-ahead of paged reads since mounting. |sequential|
+  // is true if the page request started where the read-ahead of the previous one for the same blob
+  // ended, i.e. all of that read-ahead was used. |read_ahead_bytes| is how many bytes beyond the
+  // requested range are being read in for this request.
+  void UpdateReadAhead(bool sequential, uint64_t read_ahead_bytes);
+
   // Updates aggregates information about blobs being written back to blobfs since mounting.
   void UpdateClientWrite(uint64_t data_size, uint64_t merkle_size,
                          const fs::Duration& enqueue_duration,
@@ -100,6 +110,8 @@ class BlobfsMetrics final {
   inspect::Node allocation_stats_ = root_.CreateChild("allocation_stats");
   inspect::Node writeback_stats_ = root_.CreateChild("writeback_stats");
   inspect::Node lookup_stats_ = root_.CreateChild("lookup_stats");
+  inspect::Node cache_stats_ = root_.CreateChild("cache_stats");
+  inspect::Node read_ahead_stats_ = root_.CreateChild("read_ahead_stats");
   inspect::Node paged_read_stats_ = root_.CreateChild("paged_read_stats");
   inspect::Node unpaged_read_stats_ = root_.CreateChild("unpaged_read_stats");
   inspect::Node page_in_frequency_stats_ = root_.CreateChild("page_in_frequency_stats");
@@ -128,6 +140,18 @@ class BlobfsMetrics final {
   inspect::UintProperty blobs_opened_total_size_property_ =
       lookup_stats_.CreateUint("blobs_opened_total_size", blobs_opened_total_size_);
 
+  // Cache properties
+  inspect::UintProperty cache_hits_property_ = cache_stats_.CreateUint("hits", 0);
+  inspect::UintProperty cache_misses_property_ = cache_stats_.CreateUint("misses", 0);
+
+  // Read-ahead properties
+  inspect::UintProperty sequential_page_requests_property_ =
+      read_ahead_stats_.CreateUint("sequential_requests", 0);
+  inspect::UintProperty random_page_requests_property_ =
+      read_ahead_stats_.CreateUint("random_requests", 0);
+  inspect::UintProperty read_ahead_bytes_property_ =
+      read_ahead_stats_.CreateUint("read_ahead_bytes", 0);
+
   // READ STATS
   ReadMetrics paged_read_metrics_{&paged_read_stats_};
   ReadMetrics unpaged_read_metrics_{&unpaged_read_stats_};
@@ -11,6 +11,7 @@
 
 #include <lib/fit/function.h>
 
+#include <fbl/intrusive_double_list.h>
 #include <fbl/intrusive_wavl_tree.h>
 #include <fbl/mutex.h>
 #include <fbl/ref_ptr.h>
@@ -67,6 +68,13 @@ class CacheNode : public fs::PagedVnode,
   // implementation of this method must not attempt to acquire a reference to |this|.
   virtual void ActivateLowMemory() = 0;
 
+  // Returns the number of bytes of memory that |ActivateLowMemory()| would release, or zero if the
+  // node is already in a low-memory state.
+  //
+  // The implementation of this method must not invoke any other CacheNode methods. The
+  // implementation of this method must not attempt to acquire a reference to |this|.
+  virtual uint64_t GetMemoryUsage() const = 0;
+
   // If the node should have a specific cache discipline, this method returns it. Otherwise, the
   // system-wide policy is applied.
   std::optional<CachePolicy> overriden_cache_policy() const { return overriden_cache_policy_; }
@@ -77,8 +85,26 @@ class CacheNode : public fs::PagedVnode,
   void RecycleNode() override;
 
  private:
+  friend class BlobCache;
+
+  // The BlobCache keeps closed nodes which are retaining memory under |CachePolicy::Bounded| in
+  // recency ordered queues.
+  using QueueNodeState = fbl::DoublyLinkedListNodeState<CacheNode*>;
+  struct QueueTraits {
+    static QueueNodeState& node_state(CacheNode& obj) { return obj.queue_node_state_; }
+  };
+  using Queue = fbl::DoublyLinkedListCustomTraits<CacheNode*, QueueTraits>;
+
   digest::Digest digest_;
   std::optional<CachePolicy> overriden_cache_policy_;
+
+  // The following are only accessed by the BlobCache, with its lock held.
+  QueueNodeState queue_node_state_;
+  // The memory charged to the budget of the cache while the node is queued.
+  uint64_t queued_memory_usage_ = 0;
+  // Whether the node was reopened while it was retaining memory in the cache, which places it in
+  // the frequently used queue once it is closed again.
+  bool reopened_from_cache_ = false;
 };
 
 }  // namespace blobfs
@@ -5,6 +5,8 @@
 #ifndef SRC_STORAGE_BLOBFS_CACHE_POLICY_H_
 #define SRC_STORAGE_BLOBFS_CACHE_POLICY_H_
 
+#include <stdint.h>
+
 namespace blobfs {
 
 // CachePolicy describes the techniques used to cache blobs in memory, avoiding re-reading and
@@ -24,8 +26,21 @@ enum class CachePolicy {
   // reduced, since the kernel can reclaim data pages as needed. This is the recommended
   // configuration. (Note that the kernel does not reclaim in-memory metadata such as merkle trees.)
   NeverEvict,
+
+  // Closed nodes keep their in-memory state for as long as it fits within the memory budget of the
+  // cache. When the budget is exceeded, |ActivateLowMemory()| is invoked on closed nodes following
+  // a 2Q discipline: nodes which have been closed only once since they were last loaded are evicted
+  // least recently closed first, while nodes which were reopened from the cache are kept in a
+  // separate queue which the once-used nodes cannot flush.
+  //
+  // This option bounds the memory used for merkle trees and node metadata, while avoiding the cost
+  // of reloading blobs that are repeatedly opened and closed.
+  Bounded,
 };
 
+// The default memory budget for closed nodes under |CachePolicy::Bounded|.
+constexpr uint64_t kDefaultCacheMemoryBudget = 16ull * 1024 * 1024;
+
 }  // namespace blobfs
 
 #endif  // SRC_STORAGE_BLOBFS_CACHE_POLICY_H_
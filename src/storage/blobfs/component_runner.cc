@@ -198,6 +198,7 @@ zx::status<> ComponentRunner::Configure(std::unique_ptr<BlockDevice> device,
   auto diagnostics_dir = fbl::MakeRefCounted<fs::PseudoDir>(this);
   outgoing_->AddEntry("diagnostics", diagnostics_dir);
   diagnostics_dir->AddEntry(fuchsia::inspect::Tree::Name_, inspect_tree);
+  diagnostics_dir->AddEntry("prefetch_manifest", blobfs_->CreatePrefetchManifestFile());
 
   auto svc_dir = fbl::MakeRefCounted<fs::PseudoDir>(this);
 
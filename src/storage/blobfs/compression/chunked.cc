@@ -37,12 +37,8 @@ zx_status_t ChunkedCompressor::Create(CompressionSettings settings, size_t input
                                       size_t* output_limit_out,
                                       std::unique_ptr<ChunkedCompressor>* out) {
   ZX_DEBUG_ASSERT(settings.compression_algorithm == CompressionAlgorithm::kChunked);
-  CompressionParams params = GetDefaultChunkedCompressionParams(input_size);
-  if (settings.compression_level) {
-    params.compression_level = *(settings.compression_level);
-  }
-
-  chunked_compression::StreamingChunkedCompressor compressor(params);
+  chunked_compression::StreamingChunkedCompressor compressor(
+      ParamsForSettings(settings, input_size));
 
   *output_limit_out = compressor.ComputeOutputSizeLimit(input_size);
   *out =
@@ -51,6 +47,15 @@ zx_status_t ChunkedCompressor::Create(CompressionSettings settings, size_t input
   return ZX_OK;
 }
 
+CompressionParams ChunkedCompressor::ParamsForSettings(CompressionSettings settings,
+                                                       size_t input_size) {
+  CompressionParams params = GetDefaultChunkedCompressionParams(input_size);
+  if (settings.compression_level) {
+    params.compression_level = *(settings.compression_level);
+  }
+  return params;
+}
+
 zx_status_t ChunkedCompressor::SetOutput(void* dst, size_t dst_len) {
   if (dst_len < compressor_.ComputeOutputSizeLimit(input_len_)) {
     return ZX_ERR_BUFFER_TOO_SMALL;
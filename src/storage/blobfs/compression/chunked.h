@@ -37,6 +37,10 @@ class ChunkedCompressor : public Compressor {
   static zx_status_t Create(CompressionSettings settings, size_t input_size,
                             size_t* output_limit_out, std::unique_ptr<ChunkedCompressor>* out);
 
+  // Returns the parameters used to compress |input_size| bytes with |settings|.
+  static chunked_compression::CompressionParams ParamsForSettings(CompressionSettings settings,
+                                                                  size_t input_size);
+
   // Registers |dst| as the output for compression.
   // Must be called before |Update()| or |End()| are called.
   zx_status_t SetOutput(void* dst, size_t dst_len);
@@ -27,6 +27,7 @@
 #include <new>
 #include <optional>
 #include <string>
+#include <thread>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -134,6 +135,9 @@ struct MerkleTreeInfo {
                                            BlobLayoutFormat blob_layout_format) {
     MerkleTreeCreator mtc;
     mtc.SetUseCompactFormat(blob_layout_format == BlobLayoutFormat::kCompactMerkleTreeAtEnd);
+    // Blobs are usually processed several at a time already, but a few large ones at the end would
+    // otherwise leave most of the cores idle. Small blobs are always hashed on this thread.
+    mtc.SetThreadCount(std::thread::hardware_concurrency());
     if (zx_status_t status = mtc.SetDataLength(data.size()); status != ZX_OK) {
       return zx::error(status);
     }
@@ -16,6 +16,17 @@
 
 namespace blobfs {
 
+// The access pattern of the page requests for a blob, used by PageLoader to size its read-ahead.
+// Only accessed by PageLoader, with its lock for pending transfers held.
+struct ReadAheadState {
+  // The end of the range read in for the last page request. A request which starts here is
+  // sequential.
+  uint64_t next_offset = 0;
+
+  // The current read-ahead window, or zero until the first page request.
+  uint64_t window = 0;
+};
+
 // Info required by to read in and verify pages.
 struct LoaderInfo {
   // Inode index for the blob.
@@ -30,6 +41,9 @@ struct LoaderInfo {
   // An optional decompressor used by the chunked compression strategy. The decompressor is invoked
   // on the raw bytes received from the disk. If unset, blob data is assumed to be uncompressed.
   std::unique_ptr<SeekableDecompressor> decompressor;
+
+  // Kept behind a pointer so that PageLoader can update it through a const LoaderInfo.
+  std::unique_ptr<ReadAheadState> read_ahead = std::make_unique<ReadAheadState>();
 };
 
 }  // namespace blobfs
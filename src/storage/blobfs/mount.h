@@ -11,8 +11,10 @@
 #include <lib/async-loop/default.h>
 #include <lib/fit/function.h>
 #include <lib/zx/resource.h>
+#include <lib/zx/time.h>
 
 #include <optional>
+#include <vector>
 
 #include "src/lib/storage/block_client/cpp/block_device.h"
 #include "src/storage/blobfs/cache_policy.h"
@@ -42,6 +44,9 @@ struct MountOptions {
   // Optional overriden cache policy for pager-backed blobs.
   std::optional<CachePolicy> pager_backed_cache_policy = std::nullopt;
 
+  // The number of bytes that closed blobs may retain under |CachePolicy::Bounded|.
+  uint64_t cache_memory_budget = kDefaultCacheMemoryBudget;
+
   CompressionSettings compression_settings{};
 
   // TODO(fxbug.dev/62177): Default this to true, then remove it altogether after updating tests.
@@ -55,6 +60,14 @@ struct MountOptions {
   DecompressorCreatorConnector* decompression_connector = nullptr;
 
   int32_t paging_threads = 2;
+
+  // A serialized PrefetchManifest whose ranges are read in after mounting, ahead of them being
+  // paged in. Typically recorded during a previous boot, see |prefetch_record_duration|.
+  std::vector<uint8_t> prefetch_manifest;
+
+  // How long after mounting the ranges that are paged in are recorded, to be served as a
+  // PrefetchManifest at diagnostics/prefetch_manifest. Recording is disabled if zero.
+  zx::duration prefetch_record_duration;
 #ifndef NDEBUG
   bool fsck_at_end_of_every_transaction = false;
 #endif
@@ -64,32 +64,52 @@ ReadRange GetBlockAlignedReadRange(const LoaderInfo& info, uint64_t offset, uint
   return {.offset = offset, .length = length};
 }
 
-// Returns a range at least as big as GetBlockAlignedReadRange(), extended by an implementation
-// defined read-ahead algorithm.
+// Read in at least 32KB at a time until the access pattern of a blob is known. This gives us the
+// best performance numbers w.r.t. memory savings and observed latencies. Detailed results from
+// experiments to tune this can be found in fxbug.dev/48519.
+constexpr uint64_t kDefaultReadAhead = UINT64_C(32) * (1 << 10);
+
+// The bounds of the read-ahead window of a blob, see |NextReadAheadWindow()|.
+constexpr uint64_t kMinReadAhead = kBlobfsBlockSize;
+constexpr uint64_t kMaxReadAhead = UINT64_C(1) << 20;
+
+// Returns a range at least as big as GetBlockAlignedReadRange(), extended to at least
+// |read_ahead| bytes.
 //
 // The same alignment guarantees for GetBlockAlignedReadRange() apply.
-ReadRange GetBlockAlignedExtendedRange(const LoaderInfo& info, uint64_t offset, uint64_t length) {
-  // TODO(rashaeqbal): Consider making the cluster size dynamic once we have prefetch read
-  // efficiency metrics from the kernel - i.e. what percentage of prefetched pages are actually
-  // used. Note that dynamic prefetch sizing might not play well with compression, since we
-  // always need to read in entire compressed frames.
-  //
+ReadRange GetBlockAlignedExtendedRange(const LoaderInfo& info, uint64_t offset, uint64_t length,
+                                       uint64_t read_ahead) {
   // TODO(rashaeqbal): Consider extending the range backwards as well. Will need some way to track
   // populated ranges.
-  //
-  // Read in at least 32KB at a time. This gives us the best performance numbers w.r.t. memory
-  // savings and observed latencies. Detailed results from experiments to tune this can be found in
-  // fxbug.dev/48519.
-  constexpr uint64_t kReadAheadClusterSize{UINT64_C(32) * (1 << 10)};
-
   size_t read_ahead_offset = offset;
-  size_t read_ahead_length = std::max(kReadAheadClusterSize, length);
+  size_t read_ahead_length = std::max(read_ahead, length);
   read_ahead_length = std::min(read_ahead_length, info.layout->FileSize() - read_ahead_offset);
 
   // Align to the block size for verification. (In practice this means alignment to 8k).
   return GetBlockAlignedReadRange(info, read_ahead_offset, read_ahead_length);
 }
 
+// Returns the read-ahead window for a page request at |offset| of the blob loaded with |info|, and
+// sets |sequential| to whether the request starts where the range read in for the previous one
+// ended, or at the start of the blob for its first request. The window doubles for every sequential
+// request and halves for every other one, so that streaming readers get large reads and random
+// readers don't waste memory on pages they never use.
+//
+// Kernel read-ahead efficiency metrics would be more accurate, but they are not available to the
+// userpager, and a request starting at the end of the previous range means all of it was used.
+uint64_t NextReadAheadWindow(const LoaderInfo& info, uint64_t offset, bool* sequential) {
+  ReadAheadState& state = *info.read_ahead;
+  uint64_t window = state.window ? state.window : kDefaultReadAhead;
+  *sequential = offset == state.next_offset;
+  if (*sequential) {
+    window = std::min(window * 2, kMaxReadAhead);
+  } else {
+    window = std::max(window / 2, kMinReadAhead);
+  }
+  state.window = window;
+  return window;
+}
+
 void SetDeadlineProfile(const std::vector<zx::unowned_thread>& threads) {
   zx::channel channel0, channel1;
   zx_status_t status = zx::channel::create(0u, &channel0, &channel1);
@@ -202,7 +222,7 @@ zx::status<std::unique_ptr<PageLoader::Worker>> PageLoader::Worker::Create(
 
 PagerErrorStatus PageLoader::Worker::TransferPages(const PageLoader::PageSupplier& page_supplier,
                                                    uint64_t offset, uint64_t length,
-                                                   const LoaderInfo& info) {
+                                                   uint64_t read_ahead, const LoaderInfo& info) {
   size_t end;
   if (add_overflow(offset, length, &end)) {
     FX_LOGS(ERROR) << "pager transfer range would overflow (off=" << offset << ", len=" << length
@@ -211,12 +231,12 @@ PagerErrorStatus PageLoader::Worker::TransferPages(const PageLoader::PageSupplie
   }
 
   if (info.decompressor)
-    return TransferChunkedPages(page_supplier, offset, length, info);
-  return TransferUncompressedPages(page_supplier, offset, length, info);
+    return TransferChunkedPages(page_supplier, offset, length, read_ahead, info);
+  return TransferUncompressedPages(page_supplier, offset, length, read_ahead, info);
 }
 
 // The requested range is aligned in multiple steps as follows:
-// 1. The range is extended to speculatively read in 32k at a time.
+// 1. The range is extended to speculatively read in |read_ahead| bytes at a time.
 // 2. The extended range is further aligned for Merkle tree verification later.
 // 3. This range is read in chunks equal to the size of the uncompressed_transfer_buffer_. Each
 // chunk is verified as it is read in, and spliced into the destination VMO with supply_pages().
@@ -226,11 +246,11 @@ PagerErrorStatus PageLoader::Worker::TransferPages(const PageLoader::PageSupplie
 // buffer (256MB) is 8k block aligned.
 PagerErrorStatus PageLoader::Worker::TransferUncompressedPages(
     const PageLoader::PageSupplier& page_supplier, uint64_t requested_offset,
-    uint64_t requested_length, const LoaderInfo& info) {
+    uint64_t requested_length, uint64_t read_ahead, const LoaderInfo& info) {
   ZX_DEBUG_ASSERT(!info.decompressor);
 
   const auto [start_offset, total_length] =
-      GetBlockAlignedExtendedRange(info, requested_offset, requested_length);
+      GetBlockAlignedExtendedRange(info, requested_offset, requested_length, read_ahead);
 
   TRACE_DURATION("blobfs", "PageLoader::TransferUncompressedPages", "offset", start_offset,
                  "length", total_length);
@@ -324,11 +344,12 @@ PagerErrorStatus PageLoader::Worker::TransferUncompressedPages(
 }
 
 // The requested range is aligned in multiple steps as follows:
-// 1. The desired uncompressed range is aligned for Merkle tree verification.
+// 1. The desired uncompressed range is extended to |read_ahead| bytes and aligned for Merkle tree
+// verification.
 // 2. This range is extended to span complete compression frames / chunks, since that is the
-// granularity we can decompress data in. The result of this alignment produces a
-// CompressionMapping, which contains the mapping of the requested uncompressed range to the
-// compressed range that needs to be read in from disk.
+// granularity we can decompress data in, so the read-ahead always ends on a frame boundary. The
+// result of this alignment produces a CompressionMapping, which contains the mapping of the
+// requested uncompressed range to the compressed range that needs to be read in from disk.
 // 3. The uncompressed range is processed in chunks equal to the decompression_buffer_size_. For
 // each chunk, we compute the CompressionMapping to determine the compressed range that needs to be
 // read in. Each chunk is uncompressed and verified as it is read in, and spliced into the
@@ -342,10 +363,11 @@ PagerErrorStatus PageLoader::Worker::TransferUncompressedPages(
 // buffer (256MB), and both these buffers are 8k block aligned.
 PagerErrorStatus PageLoader::Worker::TransferChunkedPages(
     const PageLoader::PageSupplier& page_supplier, uint64_t requested_offset,
-    uint64_t requested_length, const LoaderInfo& info) {
+    uint64_t requested_length, uint64_t read_ahead, const LoaderInfo& info) {
   ZX_DEBUG_ASSERT(info.decompressor);
 
-  const auto [offset, length] = GetBlockAlignedReadRange(info, requested_offset, requested_length);
+  const auto [offset, length] =
+      GetBlockAlignedExtendedRange(info, requested_offset, requested_length, read_ahead);
 
   TRACE_DURATION("blobfs", "PageLoader::TransferChunkedPages", "offset", offset, "length", length);
 
@@ -438,6 +460,19 @@ PagerErrorStatus PageLoader::Worker::TransferChunkedPages(
       decompress_status = decompressor.DecompressRange(
           offset_of_compressed_data, mapping.compressed_length, mapping.decompressed_length);
       if (decompress_status == ZX_OK) {
+        // The sandbox keeps its mapping of |sandbox_buffer_|, so its pages can't be spliced into
+        // the destination VMO directly: they could change in between being verified and being
+        // supplied. The kernel also refuses to supply pages from a snapshot of the buffer, so
+        // copying them out is the only way to take them out of the sandbox's reach.
+        //
+        // Commit the destination of the copy up front, so that it doesn't fault on every page.
+        if (zx_status_t status = decompression_buffer_.op_range(
+                ZX_VMO_OP_COMMIT, 0, fbl::round_up(mapping.decompressed_length, kBlobfsBlockSize),
+                nullptr, 0);
+            status != ZX_OK) {
+          FX_LOGS(INFO) << "Failed to pre-commit decompression buffer pages: "
+                        << zx_status_get_string(status);
+        }
         zx_status_t read_status =
             sandbox_buffer_.read(decompressed_mapper.start(), 0, mapping.decompressed_length);
         if (read_status != ZX_OK) {
@@ -493,8 +528,8 @@ PagerErrorStatus PageLoader::Worker::TransferChunkedPages(
   return PagerErrorStatus::kOK;
 }
 
-PageLoader::PageLoader(std::vector<std::unique_ptr<Worker>> workers)
-    : workers_(std::move(workers)) {}
+PageLoader::PageLoader(std::vector<std::unique_ptr<Worker>> workers, BlobfsMetrics* metrics)
+    : workers_(std::move(workers)), metrics_(metrics) {}
 
 zx::status<std::unique_ptr<PageLoader>> PageLoader::Create(
     std::vector<std::unique_ptr<WorkerResources>> resources, size_t decompression_buffer_size,
@@ -510,7 +545,7 @@ zx::status<std::unique_ptr<PageLoader>> PageLoader::Create(
     workers.push_back(std::move(worker_or.value()));
   }
 
-  auto pager = std::unique_ptr<PageLoader>(new PageLoader(std::move(workers)));
+  auto pager = std::unique_ptr<PageLoader>(new PageLoader(std::move(workers), metrics));
 
   // Initialize and start the watchdog.
   pager->watchdog_ = fs_watchdog::CreateWatchdog();
@@ -523,6 +558,31 @@ zx::status<std::unique_ptr<PageLoader>> PageLoader::Create(
   return zx::ok(std::move(pager));
 }
 
+std::vector<std::shared_ptr<PageLoader::PendingTransfer>> PageLoader::TrimPendingLocked(
+    const LoaderInfo& info, uint64_t* offset, uint64_t* end) {
+  std::vector<std::shared_ptr<PendingTransfer>> covering;
+  bool trimmed = true;
+  while (trimmed && *offset < *end) {
+    trimmed = false;
+    for (const auto& pending : pending_) {
+      if (pending->info != &info) {
+        continue;
+      }
+      if (pending->offset <= *offset && *offset < pending->end) {
+        *offset = std::min(pending->end, *end);
+      } else if (pending->offset < *end && *end <= pending->end) {
+        *end = std::max(pending->offset, *offset);
+      } else {
+        // Transfers strictly inside the range are not worth splitting it for.
+        continue;
+      }
+      covering.push_back(pending);
+      trimmed = true;
+    }
+  }
+  return covering;
+}
+
 uint32_t PageLoader::AllocateWorker() {
   std::lock_guard l(worker_allocation_lock_);
   ZX_DEBUG_ASSERT(worker_id_allocator_ < workers_.size());
@@ -537,7 +597,79 @@ PagerErrorStatus PageLoader::TransferPages(const PageSupplier& page_supplier, ui
 
   // Assigns a worker to each pager thread statically.
   thread_local uint32_t worker_id = AllocateWorker();
-  return workers_[worker_id]->TransferPages(page_supplier, offset, length, info);
+  Worker& worker = *workers_[worker_id];
+
+  uint64_t end;
+  if (add_overflow(offset, length, &end) || offset >= info.layout->FileSize()) {
+    // Leave reporting the bad request to the worker.
+    return worker.TransferPages(page_supplier, offset, length, kDefaultReadAhead, info);
+  }
+  prefetch_recorder_.Record(info.verifier->digest(), offset, length);
+
+  // Skip the parts of the request which other threads are already transferring, and register the
+  // remainder, as the worker will align and extend it, for requests that come after.
+  std::vector<std::shared_ptr<PendingTransfer>> covering;
+  std::shared_ptr<PendingTransfer> transfer;
+  uint64_t read_ahead;
+  {
+    std::lock_guard lock(pending_lock_);
+    const uint64_t requested_end = end;
+    bool sequential;
+    read_ahead = NextReadAheadWindow(info, offset, &sequential);
+    covering = TrimPendingLocked(info, &offset, &end);
+    uint64_t next_offset = requested_end;
+    for (const auto& pending : covering) {
+      next_offset = std::max(next_offset, pending->end);
+    }
+    uint64_t read_ahead_bytes = 0;
+    if (offset < end) {
+      const ReadRange range = GetBlockAlignedExtendedRange(info, offset, end - offset, read_ahead);
+      uint64_t range_end = range.offset + range.length;
+      if (info.decompressor) {
+        // The read-ahead extends to the end of the compression frame holding its last byte.
+        if (auto mapping =
+                info.decompressor->MappingForDecompressedRange(range_end - 1, 1, SIZE_MAX);
+            mapping.is_ok()) {
+          range_end = mapping->decompressed_offset + mapping->decompressed_length;
+        }
+      }
+      transfer = std::make_shared<PendingTransfer>(
+          PendingTransfer{.info = &info, .offset = range.offset, .end = range_end});
+      pending_.push_back(transfer);
+      next_offset = std::max(next_offset, range_end);
+      read_ahead_bytes = range_end > requested_end ? range_end - requested_end : 0;
+    }
+    // The next request of this blob is sequential if it starts where this one ends up.
+    info.read_ahead->next_offset = next_offset;
+    metrics_->UpdateReadAhead(sequential, read_ahead_bytes);
+  }
+
+  PagerErrorStatus status = PagerErrorStatus::kOK;
+  if (transfer) {
+    status = worker.TransferPages(page_supplier, offset, end - offset, read_ahead, info);
+    {
+      std::lock_guard lock(pending_lock_);
+      transfer->done = true;
+      transfer->status = status;
+      pending_.erase(std::find(pending_.begin(), pending_.end(), transfer));
+    }
+    pending_done_.notify_all();
+  }
+
+  // The pages of the rest of the request are only supplied once the transfers covering them are
+  // done. If one of them failed, so does this request, so that the caller reports the failure for
+  // the whole of its range.
+  if (!covering.empty()) {
+    TRACE_DURATION("blobfs", "PageLoader::WaitForPendingTransfers", "count", covering.size());
+    std::unique_lock lock(pending_lock_);
+    for (const auto& pending : covering) {
+      pending_done_.wait(lock, [&pending] { return pending->done; });
+      if (status == PagerErrorStatus::kOK) {
+        status = pending->status;
+      }
+    }
+  }
+  return status;
 }
 
 }  // namespace blobfs
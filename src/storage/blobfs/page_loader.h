@@ -15,13 +15,17 @@
 #include <lib/fzl/vmo-mapper.h>
 #include <lib/zx/pager.h>
 
+#include <condition_variable>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "src/lib/storage/vfs/cpp/paged_vfs.h"
 #include "src/storage/blobfs/blobfs_metrics.h"
 #include "src/storage/blobfs/compression/external_decompressor.h"
 #include "src/storage/blobfs/loader_info.h"
+#include "src/storage/blobfs/prefetch_manifest.h"
 #include "src/storage/blobfs/transaction_manager.h"
 #include "src/storage/blobfs/transfer_buffer.h"
 #include "src/storage/lib/watchdog/include/lib/watchdog/watchdog.h"
@@ -112,9 +116,19 @@ class PageLoader {
   // 3. ZX_ERR_BAD_STATE - Any other type of failure which prevents us from successfully completing
   // the page request, e.g. failure while decompressing, or while transferring pages from the
   // transfer buffer etc.
+  //
+  // Requests are coalesced per blob: the parts of the requested range which are covered by a
+  // transfer already in progress on another pager thread are not read again. Instead, the call
+  // waits for that transfer to finish, and fails if it failed.
+  //
+  // Each blob is read ahead by a window which grows while its page requests are sequential and
+  // shrinks when they are not, see |ReadAheadState|.
   [[nodiscard]] PagerErrorStatus TransferPages(const PageSupplier& page_supplier, uint64_t offset,
                                                uint64_t length, const LoaderInfo& info);
 
+  // Records the ranges of all page requests while it is started, see |Blobfs::PrefetchBlobs()|.
+  PrefetchRecorder& prefetch_recorder() { return prefetch_recorder_; }
+
  private:
   class Worker {
    public:
@@ -130,19 +144,20 @@ class PageLoader {
         BlobfsMetrics* metrics, DecompressorCreatorConnector* decompression_connector);
 
     // See |PageLoader::TransferPages()| which simply selects which Worker to delegate the
-    // actual work to.
+    // actual work to. |read_ahead| is the number of bytes to read in at least.
     [[nodiscard]] PagerErrorStatus TransferPages(const PageLoader::PageSupplier& page_supplier,
                                                  uint64_t offset, uint64_t length,
-                                                 const LoaderInfo& info);
+                                                 uint64_t read_ahead, const LoaderInfo& info);
 
    private:
     Worker(size_t decompression_buffer_size, BlobfsMetrics* metrics);
 
     PagerErrorStatus TransferChunkedPages(const PageLoader::PageSupplier& page_supplier,
-                                          uint64_t offset, uint64_t length, const LoaderInfo& info);
+                                          uint64_t offset, uint64_t length, uint64_t read_ahead,
+                                          const LoaderInfo& info);
     PagerErrorStatus TransferUncompressedPages(const PageLoader::PageSupplier& page_supplier,
                                                uint64_t offset, uint64_t length,
-                                               const LoaderInfo& info);
+                                               uint64_t read_ahead, const LoaderInfo& info);
 
     // Scratch buffer for pager transfers of uncompressed data.
     // NOTE: Per the constraints imposed by |zx_pager_supply_pages|, the VMO owned by this buffer
@@ -181,7 +196,24 @@ class PageLoader {
     BlobfsMetrics* metrics_ = nullptr;
   };
 
-  explicit PageLoader(std::vector<std::unique_ptr<Worker>> workers);
+  // A transfer in progress, which supplies the pages of [offset, end) of the blob loaded with
+  // |info|. The blob cannot go away while one of its page requests is being served, so the address
+  // of its LoaderInfo identifies it.
+  struct PendingTransfer {
+    const LoaderInfo* info;
+    uint64_t offset;
+    uint64_t end;
+    bool done = false;
+    PagerErrorStatus status = PagerErrorStatus::kOK;
+  };
+
+  PageLoader(std::vector<std::unique_ptr<Worker>> workers, BlobfsMetrics* metrics);
+
+  // Trims [|*offset|, |*end|) of the parts at its start and end which are covered by pending
+  // transfers for the blob loaded with |info|, and returns those transfers.
+  std::vector<std::shared_ptr<PendingTransfer>> TrimPendingLocked(const LoaderInfo& info,
+                                                                   uint64_t* offset, uint64_t* end)
+      __TA_REQUIRES(pending_lock_);
 
   // Watchdog which triggers if any page faults exceed a threshold deadline.  This *must* come
   // before the loop below so that the loop, whose threads might have references to the watchdog, is
@@ -200,6 +232,18 @@ class PageLoader {
   std::mutex worker_allocation_lock_;
   // Incremented on the first call within each pager thread to allocate a worker.
   uint32_t worker_id_allocator_ __TA_GUARDED(worker_allocation_lock_) = 0;
+
+  // The transfers in progress on all pager threads. There are at most as many as there are
+  // workers, so these are simply searched linearly.
+  std::mutex pending_lock_;
+  std::vector<std::shared_ptr<PendingTransfer>> pending_ __TA_GUARDED(pending_lock_);
+  // Notified whenever a pending transfer is done.
+  std::condition_variable pending_done_;
+
+  // Records the read-ahead metrics of all workers.
+  BlobfsMetrics* metrics_ = nullptr;
+
+  PrefetchRecorder prefetch_recorder_;
 };
 
 }  // namespace blobfs
@@ -0,0 +1,147 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/storage/blobfs/prefetch_manifest.h"
+
+#include <string.h>
+#include <zircon/syscalls.h>
+
+#include <algorithm>
+
+#include <fbl/algorithm.h>
+
+#include "src/storage/blobfs/format.h"
+
+namespace blobfs {
+namespace {
+
+constexpr uint64_t kPrefetchManifestMagic = 0x31666d70'626f6c62;  // "blobpmf1" on disk.
+constexpr uint32_t kPrefetchManifestVersion = 1;
+
+struct ManifestHeader {
+  uint64_t magic;
+  uint32_t version;
+  uint32_t entry_count;
+};
+static_assert(sizeof(ManifestHeader) == 16);
+
+// Ranges are stored in blocks to keep entries small.
+struct ManifestEntry {
+  uint8_t digest[digest::kSha256Length];
+  uint32_t block_offset;
+  uint32_t block_count;
+};
+static_assert(sizeof(ManifestEntry) == 40);
+
+}  // namespace
+
+zx::status<PrefetchManifest> PrefetchManifest::Parse(cpp20::span<const uint8_t> data) {
+  ManifestHeader header;
+  if (data.size() < sizeof(header)) {
+    return zx::error(ZX_ERR_IO_DATA_INTEGRITY);
+  }
+  memcpy(&header, data.data(), sizeof(header));
+  if (header.magic != kPrefetchManifestMagic) {
+    return zx::error(ZX_ERR_IO_DATA_INTEGRITY);
+  }
+  if (header.version != kPrefetchManifestVersion) {
+    return zx::error(ZX_ERR_NOT_SUPPORTED);
+  }
+  if (header.entry_count > kMaxEntries ||
+      data.size() != sizeof(header) + header.entry_count * sizeof(ManifestEntry)) {
+    return zx::error(ZX_ERR_IO_DATA_INTEGRITY);
+  }
+
+  PrefetchManifest manifest;
+  manifest.entries_.reserve(header.entry_count);
+  const uint8_t* next = data.data() + sizeof(header);
+  for (uint32_t i = 0; i < header.entry_count; ++i, next += sizeof(ManifestEntry)) {
+    ManifestEntry entry;
+    memcpy(&entry, next, sizeof(entry));
+    if (entry.block_count == 0) {
+      return zx::error(ZX_ERR_IO_DATA_INTEGRITY);
+    }
+    manifest.entries_.push_back({.digest = digest::Digest(entry.digest),
+                                 .offset = uint64_t{entry.block_offset} * kBlobfsBlockSize,
+                                 .length = uint64_t{entry.block_count} * kBlobfsBlockSize});
+  }
+  return zx::ok(std::move(manifest));
+}
+
+std::vector<uint8_t> PrefetchManifest::Serialize() const {
+  const ManifestHeader header = {
+      .magic = kPrefetchManifestMagic,
+      .version = kPrefetchManifestVersion,
+      .entry_count = static_cast<uint32_t>(entries_.size()),
+  };
+  std::vector<uint8_t> data(sizeof(header) + entries_.size() * sizeof(ManifestEntry));
+  memcpy(data.data(), &header, sizeof(header));
+  uint8_t* next = data.data() + sizeof(header);
+  for (const Entry& entry : entries_) {
+    ManifestEntry out;
+    entry.digest.CopyTo(out.digest);
+    out.block_offset = static_cast<uint32_t>(entry.offset / kBlobfsBlockSize);
+    out.block_count = static_cast<uint32_t>(entry.length / kBlobfsBlockSize);
+    memcpy(next, &out, sizeof(out));
+    next += sizeof(out);
+  }
+  return data;
+}
+
+bool PrefetchManifest::Add(const digest::Digest& digest, uint64_t offset, uint64_t length) {
+  if (length == 0) {
+    return true;
+  }
+  uint64_t start = fbl::round_down(offset, kBlobfsBlockSize);
+  uint64_t end = fbl::round_up(offset + length, kBlobfsBlockSize);
+  if (end / kBlobfsBlockSize > UINT32_MAX) {
+    // Not representable, and not a blob that fits on any device anyway.
+    return true;
+  }
+
+  // Blobs are mostly paged in front to back, so the range to merge with is usually a recent one.
+  for (auto entry = entries_.rbegin(); entry != entries_.rend(); ++entry) {
+    if (entry->digest != digest) {
+      continue;
+    }
+    const uint64_t entry_end = entry->offset + entry->length;
+    if (start <= entry_end + kMergeDistance && entry->offset <= end + kMergeDistance) {
+      start = std::min(start, entry->offset);
+      end = std::max(end, entry_end);
+      entry->offset = start;
+      entry->length = end - start;
+      return true;
+    }
+  }
+
+  if (entries_.size() >= kMaxEntries) {
+    return false;
+  }
+  entries_.push_back({.digest = digest, .offset = start, .length = end - start});
+  return true;
+}
+
+void PrefetchRecorder::Start(zx::duration duration) {
+  deadline_.store(zx_time_add_duration(zx_clock_get_monotonic(), duration.get()),
+                  std::memory_order_relaxed);
+}
+
+void PrefetchRecorder::Record(const digest::Digest& digest, uint64_t offset, uint64_t length) {
+  const zx_time_t deadline = deadline_.load(std::memory_order_relaxed);
+  if (deadline == ZX_TIME_INFINITE_PAST || zx_clock_get_monotonic() >= deadline) {
+    return;
+  }
+  std::lock_guard lock(mutex_);
+  if (!manifest_.Add(digest, offset, length)) {
+    // The manifest is full, there's no point in checking the rest of the requests.
+    deadline_.store(ZX_TIME_INFINITE_PAST, std::memory_order_relaxed);
+  }
+}
+
+PrefetchManifest PrefetchRecorder::manifest() const {
+  std::lock_guard lock(mutex_);
+  return manifest_;
+}
+
+}  // namespace blobfs
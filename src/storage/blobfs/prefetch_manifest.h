@@ -0,0 +1,84 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SRC_STORAGE_BLOBFS_PREFETCH_MANIFEST_H_
+#define SRC_STORAGE_BLOBFS_PREFETCH_MANIFEST_H_
+
+#ifndef __Fuchsia__
+#error Fuchsia-only Header
+#endif
+
+#include <lib/stdcompat/span.h>
+#include <lib/zx/status.h>
+#include <lib/zx/time.h>
+#include <zircon/compiler.h>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "src/lib/digest/digest.h"
+
+namespace blobfs {
+
+// A compact record of the blob ranges which were paged in shortly after mounting, in the order they
+// were first paged in. A later mount replays it to read those ranges in before they are faulted.
+//
+// Ranges are identified by the Merkle root of their blob, so a manifest recorded by a different
+// build simply refers to some blobs which no longer exist, and those are skipped on replay.
+class PrefetchManifest {
+ public:
+  struct Entry {
+    digest::Digest digest;
+    // Block aligned byte range of the blob's uncompressed data.
+    uint64_t offset;
+    uint64_t length;
+  };
+
+  // Bounds the size of a manifest, both on disk and in memory.
+  static constexpr size_t kMaxEntries = 4096;
+
+  // Ranges of the same blob which are at most this far apart are merged, so that they are read
+  // with one request on replay.
+  static constexpr uint64_t kMergeDistance = UINT64_C(64) * (1 << 10);
+
+  PrefetchManifest() = default;
+
+  // Parses a manifest written by |Serialize()|.
+  static zx::status<PrefetchManifest> Parse(cpp20::span<const uint8_t> data);
+  std::vector<uint8_t> Serialize() const;
+
+  // Adds [|offset|, |offset| + |length|) of the blob with |digest|, rounded out to blocks. Returns
+  // false if the manifest is full.
+  bool Add(const digest::Digest& digest, uint64_t offset, uint64_t length);
+
+  const std::vector<Entry>& entries() const { return entries_; }
+
+ private:
+  std::vector<Entry> entries_;
+};
+
+// Records the ranges paged in until a deadline into a PrefetchManifest. This class is thread-safe.
+class PrefetchRecorder {
+ public:
+  // Records every range passed to |Record()| until |duration| from now.
+  void Start(zx::duration duration);
+
+  void Record(const digest::Digest& digest, uint64_t offset, uint64_t length);
+
+  // Returns a copy of what has been recorded so far.
+  PrefetchManifest manifest() const;
+
+ private:
+  // Recording is off by default. This is checked before taking the lock so that page requests
+  // don't serialize on it once the deadline has passed.
+  std::atomic<zx_time_t> deadline_ = ZX_TIME_INFINITE_PAST;
+
+  mutable std::mutex mutex_;
+  PrefetchManifest manifest_ __TA_GUARDED(mutex_);
+};
+
+}  // namespace blobfs
+
+#endif  // SRC_STORAGE_BLOBFS_PREFETCH_MANIFEST_H_
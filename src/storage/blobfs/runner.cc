@@ -99,6 +99,7 @@ zx_status_t Runner::ServeRoot(fidl::ServerEnd<fuchsia_io::Directory> root) {
   auto diagnostics_dir = fbl::MakeRefCounted<fs::PseudoDir>(this);
   outgoing->AddEntry("diagnostics", diagnostics_dir);
   diagnostics_dir->AddEntry(fuchsia::inspect::Tree::Name_, inspect_tree);
+  diagnostics_dir->AddEntry("prefetch_manifest", blobfs_->CreatePrefetchManifestFile());
 
   outgoing->AddEntry(fidl::DiscoverableProtocolName<fuchsia_update_verify::BlobfsVerifier>,
                      fbl::MakeRefCounted<HealthCheckService>(loop_->dispatcher(), *blobfs_));
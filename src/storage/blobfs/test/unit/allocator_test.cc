@@ -250,11 +250,17 @@ TEST(AllocatorTest, InterleavedReservation) {
   // Free the first extent.
   reservation_group_a.clear();
 
-  // We should still be able to reserve the remaining two extents, split
-  // across the reservations and the committed block.
+  // We should still be able to reserve four blocks, and they should come from
+  // the free region after the reservations rather than be split across them.
   std::vector<ReservedExtent> extents;
   ASSERT_EQ(allocator->ReserveBlocks(4, &extents), ZX_OK);
-  ASSERT_EQ(2ul, extents.size());
+  ASSERT_EQ(1ul, extents.size());
+  ASSERT_EQ(4ul, extents[0].extent().Start());
+
+  // The rest of the free blocks are split across them.
+  std::vector<ReservedExtent> remainder;
+  ASSERT_EQ(allocator->ReserveBlocks(3, &remainder), ZX_OK);
+  ASSERT_EQ(2ul, remainder.size());
 }
 
 TEST(AllocatorTest, IsBlockAllocated) {
@@ -152,10 +152,66 @@ TEST(BaseAllocatorTest, ReserveBlocksWithReservedBlocksIsCorrect) {
 
   extents1.clear();
   std::vector<ReservedExtent> extents3;
-  EXPECT_OK(allocator.ReserveBlocks(4, &extents3));
-  ASSERT_THAT(extents3, SizeIs(2));
-  EXPECT_THAT(extents3[0], IsReservedExtent(/*start=*/0, /*length=*/2));
-  EXPECT_THAT(extents3[1], IsReservedExtent(/*start=*/4, /*length=*/2));
+  EXPECT_OK(allocator.ReserveBlocks(6, &extents3));
+  ASSERT_THAT(extents3, SizeIs(1));
+  EXPECT_THAT(extents3[0], IsReservedExtent(/*start=*/4, /*length=*/6));
+
+  std::vector<ReservedExtent> extents4;
+  EXPECT_OK(allocator.ReserveBlocks(2, &extents4));
+  ASSERT_THAT(extents4, SizeIs(1));
+  EXPECT_THAT(extents4[0], IsReservedExtent(/*start=*/0, /*length=*/2));
+}
+
+TEST(BaseAllocatorTest, ReserveBlocksPrefersTheSmallestRegionThatFits) {
+  AllocatorForTesting allocator(/*block_count=*/20, /*node_count=*/10, /*allow_growing=*/false);
+
+  // Free regions of 3, 6 and 9 blocks.
+  EXPECT_OK(allocator.GetBlockBitmap().Set(3, 4));
+  EXPECT_OK(allocator.GetBlockBitmap().Set(10, 11));
+
+  std::vector<ReservedExtent> extents1;
+  EXPECT_OK(allocator.ReserveBlocks(5, &extents1));
+  ASSERT_THAT(extents1, SizeIs(1));
+  EXPECT_THAT(extents1[0], IsReservedExtent(/*start=*/4, /*length=*/5));
+
+  std::vector<ReservedExtent> extents2;
+  EXPECT_OK(allocator.ReserveBlocks(9, &extents2));
+  ASSERT_THAT(extents2, SizeIs(1));
+  EXPECT_THAT(extents2[0], IsReservedExtent(/*start=*/11, /*length=*/9));
+}
+
+TEST(BaseAllocatorTest, ReserveBlocksUsesTheLargestRegionsFirstWhenNoneFit) {
+  AllocatorForTesting allocator(/*block_count=*/12, /*node_count=*/10, /*allow_growing=*/false);
+
+  // Free regions of 2, 5 and 3 blocks.
+  EXPECT_OK(allocator.GetBlockBitmap().Set(2, 3));
+  EXPECT_OK(allocator.GetBlockBitmap().Set(8, 9));
+
+  std::vector<ReservedExtent> extents;
+  EXPECT_OK(allocator.ReserveBlocks(8, &extents));
+  ASSERT_THAT(extents, SizeIs(2));
+  EXPECT_THAT(extents[0], IsReservedExtent(/*start=*/3, /*length=*/5));
+  EXPECT_THAT(extents[1], IsReservedExtent(/*start=*/9, /*length=*/3));
+}
+
+TEST(BaseAllocatorTest, ReserveBlocksSeesBlocksFreedAndAllocatedThroughTheAllocator) {
+  AllocatorForTesting allocator(/*block_count=*/10, /*node_count=*/10, /*allow_growing=*/false);
+
+  std::vector<ReservedExtent> extents;
+  EXPECT_OK(allocator.ReserveBlocks(10, &extents));
+  for (const ReservedExtent& extent : extents) {
+    allocator.MarkBlocksAllocated(extent);
+  }
+  extents.clear();
+
+  std::vector<ReservedExtent> failed_extents;
+  EXPECT_STATUS(allocator.ReserveBlocks(1, &failed_extents), ZX_ERR_NO_SPACE);
+
+  allocator.FreeBlocks(Extent(/*start=*/2, /*length=*/3));
+  allocator.FreeBlocks(Extent(/*start=*/6, /*length=*/4));
+  EXPECT_OK(allocator.ReserveBlocks(4, &extents));
+  ASSERT_THAT(extents, SizeIs(1));
+  EXPECT_THAT(extents[0], IsReservedExtent(/*start=*/6, /*length=*/4));
 }
 
 TEST(BaseAllocatorTest, ReserveBlocksWithTooManyBlocksForOneExtentIsCorrect) {
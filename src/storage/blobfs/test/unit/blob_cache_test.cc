@@ -24,6 +24,8 @@ namespace {
 // from memory when references are closed.
 class TestNode : public CacheNode, fbl::Recyclable<TestNode> {
  public:
+  static constexpr uint64_t kMemoryUsage = 100;
+
   explicit TestNode(const Digest& digest, BlobCache* cache)
       : CacheNode(nullptr, digest), cache_(cache) {}
 
@@ -36,6 +38,8 @@ class TestNode : public CacheNode, fbl::Recyclable<TestNode> {
 
   void ActivateLowMemory() final { using_memory_ = false; }
 
+  uint64_t GetMemoryUsage() const final { return using_memory_ ? kMemoryUsage : 0; }
+
   // fs::PagedVnode implementation.
   void VmoRead(uint64_t offset, uint64_t length) override {
     ASSERT_TRUE(false);  // Should not get called in these tests.
@@ -349,5 +353,146 @@ TEST(BlobCacheTest, CachePolicyOverrideSettingsRespected) {
   ASSERT_FALSE(node->UsingMemory());
 }
 
+// Adds a node using memory to the cache and closes it.
+void AddClosedNode(BlobCache* cache, const Digest& digest) {
+  auto node = fbl::MakeRefCounted<TestNode>(digest, cache);
+  node->SetHighMemory();
+  ASSERT_EQ(cache->Add(node), ZX_OK);
+}
+
+bool IsUsingMemory(BlobCache* cache, const Digest& digest) {
+  fbl::RefPtr<CacheNode> cache_node;
+  ZX_ASSERT(cache->Lookup(digest, &cache_node) == ZX_OK);
+  return fbl::RefPtr<TestNode>::Downcast(std::move(cache_node))->UsingMemory();
+}
+
+TEST(BlobCacheTest, CachePolicyBoundedEvictsLeastRecentlyClosed) {
+  BlobCache cache;
+  cache.SetCachePolicy(CachePolicy::Bounded);
+  cache.SetMemoryBudget(2 * TestNode::kMemoryUsage);
+
+  constexpr size_t kNodes = 3;
+  for (size_t i = 0; i < kNodes; ++i) {
+    AddClosedNode(&cache, GenerateDigest(i));
+  }
+
+  // Only the last two nodes fit in the budget.
+  ASSERT_TRUE(IsUsingMemory(&cache, GenerateDigest(2)));
+  ASSERT_TRUE(IsUsingMemory(&cache, GenerateDigest(1)));
+  ASSERT_FALSE(IsUsingMemory(&cache, GenerateDigest(0)));
+}
+
+TEST(BlobCacheTest, CachePolicyBoundedKeepsReopenedNodes) {
+  BlobCache cache;
+  cache.SetCachePolicy(CachePolicy::Bounded);
+  cache.SetMemoryBudget(4 * TestNode::kMemoryUsage);
+
+  // Reopen the first node while it is cached, which places it in the frequently used queue.
+  AddClosedNode(&cache, GenerateDigest(0));
+  ASSERT_TRUE(IsUsingMemory(&cache, GenerateDigest(0)));
+
+  // Many nodes which are only opened once must not flush it.
+  constexpr size_t kNodes = 16;
+  for (size_t i = 1; i <= kNodes; ++i) {
+    AddClosedNode(&cache, GenerateDigest(i));
+  }
+  ASSERT_TRUE(IsUsingMemory(&cache, GenerateDigest(0)));
+  ASSERT_TRUE(IsUsingMemory(&cache, GenerateDigest(kNodes)));
+  ASSERT_FALSE(IsUsingMemory(&cache, GenerateDigest(1)));
+}
+
+TEST(BlobCacheTest, CachePolicyBoundedMemoryPressure) {
+  BlobCache cache;
+  cache.SetCachePolicy(CachePolicy::Bounded);
+  cache.SetMemoryBudget(4 * TestNode::kMemoryUsage);
+
+  AddClosedNode(&cache, GenerateDigest(0));
+  cache.SetMemoryPressure(BlobCache::MemoryPressure::kCritical);
+  ASSERT_FALSE(IsUsingMemory(&cache, GenerateDigest(0)));
+
+  // Nothing is retained until the pressure is relieved.
+  AddClosedNode(&cache, GenerateDigest(1));
+  ASSERT_FALSE(IsUsingMemory(&cache, GenerateDigest(1)));
+
+  cache.SetMemoryPressure(BlobCache::MemoryPressure::kNormal);
+  AddClosedNode(&cache, GenerateDigest(2));
+  ASSERT_TRUE(IsUsingMemory(&cache, GenerateDigest(2)));
+}
+
+TEST(BlobCacheTest, LookupObserverCountsHitsAndMisses) {
+  BlobCache cache;
+  cache.SetCachePolicy(CachePolicy::EvictImmediately);
+  int hits = 0;
+  int misses = 0;
+  cache.SetLookupObserver([&](bool hit) { ++(hit ? hits : misses); });
+
+  Digest digest = GenerateDigest(0);
+  auto node = fbl::MakeRefCounted<TestNode>(digest, &cache);
+  node->SetHighMemory();
+  ASSERT_EQ(cache.Add(node), ZX_OK);
+
+  // The node is open.
+  ASSERT_EQ(cache.Lookup(digest, nullptr), ZX_OK);
+  EXPECT_EQ(hits, 1);
+  EXPECT_EQ(misses, 0);
+
+  // The node was placed into a low-memory state when it was closed.
+  node.reset();
+  ASSERT_EQ(cache.Lookup(digest, nullptr), ZX_OK);
+  EXPECT_EQ(hits, 1);
+  EXPECT_EQ(misses, 1);
+
+  ASSERT_EQ(ZX_ERR_NOT_FOUND, cache.Lookup(GenerateDigest(1), nullptr));
+  EXPECT_EQ(hits + misses, 2);
+}
+
+TEST(BlobCacheTest, MissHandlerCreatesNodesOnFirstLookup) {
+  BlobCache cache;
+  const Digest on_disk = GenerateDigest(0);
+  int created = 0;
+  cache.SetMissHandler([&](const Digest& digest) -> zx::status<fbl::RefPtr<CacheNode>> {
+    if (digest != on_disk) {
+      return zx::error(ZX_ERR_NOT_FOUND);
+    }
+    ++created;
+    return zx::ok(fbl::MakeRefCounted<TestNode>(digest, &cache));
+  });
+
+  fbl::RefPtr<CacheNode> node;
+  ASSERT_EQ(cache.Lookup(on_disk, &node), ZX_OK);
+  EXPECT_EQ(node->digest(), on_disk);
+  fbl::RefPtr<CacheNode> same_node;
+  ASSERT_EQ(cache.Lookup(on_disk, &same_node), ZX_OK);
+  EXPECT_EQ(same_node.get(), node.get());
+
+  // Once closed, the node is kept in the cache like any other.
+  node.reset();
+  same_node.reset();
+  ASSERT_EQ(cache.Lookup(on_disk, nullptr), ZX_OK);
+  EXPECT_EQ(created, 1);
+
+  EXPECT_EQ(ZX_ERR_NOT_FOUND, cache.Lookup(GenerateDigest(1), nullptr));
+
+  // A blob which already exists can't be added, even if it hasn't been looked up.
+  cache.Reset();
+  auto duplicate = fbl::MakeRefCounted<TestNode>(on_disk, &cache);
+  EXPECT_EQ(ZX_ERR_ALREADY_EXISTS, cache.Add(duplicate));
+  EXPECT_EQ(created, 2);
+  duplicate->SetCache(false);
+}
+
+TEST(BlobCacheTest, MissHandlerErrorsArePropagated) {
+  BlobCache cache;
+  cache.SetMissHandler([](const Digest& digest) -> zx::status<fbl::RefPtr<CacheNode>> {
+    return zx::error(ZX_ERR_IO_DATA_INTEGRITY);
+  });
+
+  Digest digest = GenerateDigest(0);
+  EXPECT_EQ(ZX_ERR_IO_DATA_INTEGRITY, cache.Lookup(digest, nullptr));
+  auto node = fbl::MakeRefCounted<TestNode>(digest, &cache);
+  EXPECT_EQ(ZX_ERR_IO_DATA_INTEGRITY, cache.Add(node));
+  node->SetCache(false);
+}
+
 }  // namespace
 }  // namespace blobfs
@@ -0,0 +1,60 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/storage/blobfs/blob_node_table.h"
+
+#include <gtest/gtest.h>
+
+namespace blobfs {
+namespace {
+
+digest::Digest GenerateDigest(size_t seed) {
+  digest::Digest digest;
+  digest.Init();
+  digest.Update(&seed, sizeof(seed));
+  digest.Final();
+  return digest;
+}
+
+TEST(BlobNodeTableTest, FindReturnsTheNodeOfEachBlob) {
+  BlobNodeTable table;
+  for (uint32_t i = 0; i < 100; ++i) {
+    table.Add(GenerateDigest(i), i);
+  }
+  ASSERT_FALSE(table.Finalize().has_value());
+  ASSERT_EQ(table.size(), 100u);
+
+  for (uint32_t i = 0; i < 100; ++i) {
+    BlobNodeTable::Entry* entry = table.Find(GenerateDigest(i));
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->node_index, i);
+    EXPECT_FALSE(entry->verified);
+  }
+  EXPECT_EQ(table.Find(GenerateDigest(100)), nullptr);
+}
+
+TEST(BlobNodeTableTest, LoadedBlobsAreNotFound) {
+  BlobNodeTable table;
+  table.Add(GenerateDigest(0), 0);
+  table.Add(GenerateDigest(1), 1);
+  ASSERT_FALSE(table.Finalize().has_value());
+
+  table.Find(GenerateDigest(0))->loaded = true;
+  EXPECT_EQ(table.Find(GenerateDigest(0)), nullptr);
+  EXPECT_NE(table.Find(GenerateDigest(1)), nullptr);
+}
+
+TEST(BlobNodeTableTest, FinalizeFindsDuplicates) {
+  BlobNodeTable table;
+  table.Add(GenerateDigest(0), 0);
+  table.Add(GenerateDigest(1), 1);
+  table.Add(GenerateDigest(0), 2);
+
+  std::optional<digest::Digest> duplicate = table.Finalize();
+  ASSERT_TRUE(duplicate.has_value());
+  EXPECT_EQ(*duplicate, GenerateDigest(0));
+}
+
+}  // namespace
+}  // namespace blobfs
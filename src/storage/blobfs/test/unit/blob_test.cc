@@ -4,6 +4,8 @@
 
 #include "src/storage/blobfs/blob.h"
 
+#include <lib/zx/stream.h>
+#include <string.h>
 #include <zircon/assert.h>
 #include <zircon/errors.h>
 #include <zircon/types.h>
@@ -12,6 +14,7 @@
 #include <chrono>
 #include <condition_variable>
 #include <memory>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -594,6 +597,42 @@ TEST_P(BlobTest, GetAttributes) {
   check_attributes(attributes);
 }
 
+TEST_P(BlobTest, ReadOnlyConnectionsAreGivenAStream) {
+  std::unique_ptr<BlobInfo> info = GenerateRandomBlob("", 3 * kBlobfsBlockSize + 17);
+  {
+    auto root = OpenRoot();
+    fbl::RefPtr<fs::Vnode> file;
+    ASSERT_EQ(root->Create(info->path + 1, 0, &file), ZX_OK);
+    ASSERT_EQ(file->Truncate(info->size_data), ZX_OK);
+    size_t out_actual;
+    ASSERT_EQ(file->Write(info->data.get(), info->size_data, 0, &out_actual), ZX_OK);
+    ASSERT_EQ(out_actual, info->size_data);
+  }
+
+  auto root = OpenRoot();
+  fbl::RefPtr<fs::Vnode> file;
+  ASSERT_EQ(root->Lookup(info->path + 1, &file), ZX_OK);
+  TestScopedVnodeOpen open(file);
+
+  fs::VnodeRepresentation representation;
+  ASSERT_EQ(file->GetNodeInfo(fs::Rights::ReadOnly(), &representation), ZX_OK);
+  ASSERT_TRUE(representation.is_file());
+  zx::stream& stream = representation.file().stream;
+  ASSERT_TRUE(stream.is_valid());
+
+  std::vector<uint8_t> data(info->size_data + 1);
+  zx_iovec_t vector = {.buffer = data.data(), .capacity = data.size()};
+  size_t actual = 0;
+  ASSERT_EQ(stream.readv(0, &vector, 1, &actual), ZX_OK);
+  ASSERT_EQ(actual, info->size_data);
+  EXPECT_EQ(memcmp(data.data(), info->data.get(), info->size_data), 0);
+
+  // Streams are read-only, so connections which can write don't get one.
+  ASSERT_EQ(file->GetNodeInfo(fs::Rights::ReadWrite(), &representation), ZX_OK);
+  ASSERT_TRUE(representation.is_file());
+  EXPECT_FALSE(representation.file().stream.is_valid());
+}
+
 TEST_P(BlobTest, AppendSetsOutEndCorrectly) {
   std::unique_ptr<BlobInfo> info = GenerateRandomBlob("", 64);
   auto root = OpenRoot();
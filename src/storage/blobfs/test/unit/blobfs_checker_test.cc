@@ -177,7 +177,8 @@ class BlobfsCheckerTest : public testing::Test {
 
   void CorruptExtentContainer(fit::callback<void(ExtentContainer& container)> corrupt_fn,
                               fit::callback<void(Inode& node)> corrupt_node_fn,
-                              std::unique_ptr<BlockDevice>* device_out) {
+                              std::unique_ptr<BlockDevice>* device_out,
+                              std::string* name_out = nullptr) {
     fbl::RefPtr<fs::Vnode> root;
     ASSERT_EQ(blobfs()->OpenRootNode(&root), ZX_OK);
 
@@ -201,6 +202,9 @@ class BlobfsCheckerTest : public testing::Test {
     // This should end up creating a blob that typically (depending on compression) uses 7 extents.
     std::string name;
     AddRandomBlob(*root, static_cast<size_t>(6) * 8192, nullptr, nullptr, &name);
+    if (name_out) {
+      *name_out = name;
+    }
 
     fbl::RefPtr<fs::Vnode> file;
     ASSERT_EQ(root->Lookup(name, &file), ZX_OK);
@@ -382,10 +386,15 @@ TEST_F(BlobfsCheckerTest, TestCorruptBlobs) {
 
 TEST_F(BlobfsCheckerTest, BadPreviousNode) {
   std::unique_ptr<BlockDevice> device;
+  std::string name;
   CorruptExtentContainer([](ExtentContainer& container) { ++container.previous_node; }, {},
-                         &device);
-  // At present, this issue gets caught at mount time.
-  ASSERT_EQ(setup_.Mount(std::move(device)), ZX_ERR_IO_DATA_INTEGRITY);
+                         &device, &name);
+  // The extents of a blob are checked when it's first looked up.
+  ASSERT_EQ(setup_.Mount(std::move(device)), ZX_OK);
+  fbl::RefPtr<fs::Vnode> root;
+  ASSERT_EQ(blobfs()->OpenRootNode(&root), ZX_OK);
+  fbl::RefPtr<fs::Vnode> file;
+  EXPECT_EQ(root->Lookup(name, &file), ZX_ERR_IO_DATA_INTEGRITY);
 }
 
 TEST_F(BlobfsCheckerTest, CorruptReserved) {
@@ -517,10 +526,15 @@ TEST_F(BlobfsCheckerTest, CorruptUnallocatedNode) {
 
 TEST_F(BlobfsCheckerTest, CorruptExtentCountInExtentContainer) {
   std::unique_ptr<BlockDevice> device;
+  std::string name;
   CorruptExtentContainer([](ExtentContainer& container) { container.extent_count += 100; },
-                         [](Inode& node) { node.extent_count += 100; }, &device);
-  // At present, this issue gets caught at mount time.
-  ASSERT_EQ(setup_.Mount(std::move(device)), ZX_ERR_IO_DATA_INTEGRITY);
+                         [](Inode& node) { node.extent_count += 100; }, &device, &name);
+  // The extents of a blob are checked when it's first looked up.
+  ASSERT_EQ(setup_.Mount(std::move(device)), ZX_OK);
+  fbl::RefPtr<fs::Vnode> root;
+  ASSERT_EQ(blobfs()->OpenRootNode(&root), ZX_OK);
+  fbl::RefPtr<fs::Vnode> file;
+  EXPECT_EQ(root->Lookup(name, &file), ZX_ERR_IO_DATA_INTEGRITY);
 }
 
 }  // namespace
@@ -0,0 +1,101 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/storage/blobfs/allocator/free_extent_index.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "src/storage/blobfs/common.h"
+
+namespace blobfs {
+namespace {
+
+using testing::ElementsAre;
+using testing::Pair;
+
+// Returns the runs as (start, length) pairs in disk order.
+std::vector<std::pair<uint64_t, uint64_t>> RunsOf(const FreeExtentIndex& index) {
+  std::vector<std::pair<uint64_t, uint64_t>> runs;
+  for (const auto& [length, start] : index.runs_by_length()) {
+    runs.emplace_back(start, length);
+  }
+  std::sort(runs.begin(), runs.end());
+  return runs;
+}
+
+TEST(FreeExtentIndexTest, ResetFindsFreeRuns) {
+  RawBitmap bitmap;
+  ASSERT_EQ(bitmap.Reset(20), ZX_OK);
+  ASSERT_EQ(bitmap.Set(0, 2), ZX_OK);
+  ASSERT_EQ(bitmap.Set(5, 6), ZX_OK);
+
+  FreeExtentIndex index;
+  EXPECT_FALSE(index.valid());
+  index.Reset(bitmap);
+  EXPECT_TRUE(index.valid());
+  EXPECT_EQ(index.block_count(), 20u);
+  EXPECT_EQ(index.free_block_count(), 17u);
+  EXPECT_THAT(RunsOf(index), ElementsAre(Pair(2, 3), Pair(6, 14)));
+}
+
+TEST(FreeExtentIndexTest, AllocateSplitsRuns) {
+  RawBitmap bitmap;
+  ASSERT_EQ(bitmap.Reset(10), ZX_OK);
+  FreeExtentIndex index;
+  index.Reset(bitmap);
+
+  index.Allocate(3, 2);
+  EXPECT_THAT(RunsOf(index), ElementsAre(Pair(0, 3), Pair(5, 5)));
+  index.Allocate(0, 3);
+  EXPECT_THAT(RunsOf(index), ElementsAre(Pair(5, 5)));
+  index.Allocate(8, 2);
+  EXPECT_THAT(RunsOf(index), ElementsAre(Pair(5, 3)));
+  EXPECT_EQ(index.free_block_count(), 3u);
+}
+
+TEST(FreeExtentIndexTest, FreeMergesWithNeighbours) {
+  RawBitmap bitmap;
+  ASSERT_EQ(bitmap.Reset(10), ZX_OK);
+  ASSERT_EQ(bitmap.Set(0, 10), ZX_OK);
+  FreeExtentIndex index;
+  index.Reset(bitmap);
+  EXPECT_TRUE(index.runs_by_length().empty());
+
+  index.Free(2, 2);
+  index.Free(6, 2);
+  EXPECT_THAT(RunsOf(index), ElementsAre(Pair(2, 2), Pair(6, 2)));
+  index.Free(4, 2);
+  EXPECT_THAT(RunsOf(index), ElementsAre(Pair(2, 6)));
+  EXPECT_EQ(index.free_block_count(), 6u);
+}
+
+TEST(FreeExtentIndexTest, InconsistentUpdatesInvalidate) {
+  RawBitmap bitmap;
+  ASSERT_EQ(bitmap.Reset(10), ZX_OK);
+  ASSERT_EQ(bitmap.Set(5, 10), ZX_OK);
+  FreeExtentIndex index;
+
+  // Freeing blocks which are already free.
+  index.Reset(bitmap);
+  index.Free(4, 2);
+  EXPECT_FALSE(index.valid());
+
+  // Allocating blocks which aren't all free.
+  index.Reset(bitmap);
+  index.Allocate(4, 2);
+  EXPECT_FALSE(index.valid());
+
+  // Freeing blocks past the end of the bitmap.
+  index.Reset(bitmap);
+  index.Free(9, 2);
+  EXPECT_FALSE(index.valid());
+}
+
+}  // namespace
+}  // namespace blobfs
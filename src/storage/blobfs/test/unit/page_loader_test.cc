@@ -0,0 +1,294 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/storage/blobfs/page_loader.h"
+
+#include <lib/fzl/owned-vmo-mapper.h>
+#include <lib/zx/status.h>
+#include <lib/zx/thread.h>
+#include <lib/zx/time.h>
+#include <lib/zx/vmo.h>
+#include <zircon/process.h>
+#include <zircon/syscalls.h>
+#include <zircon/syscalls/object.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "src/storage/blobfs/blob_layout.h"
+#include "src/storage/blobfs/blob_verifier.h"
+#include "src/storage/blobfs/blobfs_metrics.h"
+#include "src/storage/blobfs/format.h"
+#include "src/storage/blobfs/loader_info.h"
+#include "src/storage/blobfs/test/blob_utils.h"
+#include "src/storage/blobfs/transfer_buffer.h"
+
+namespace blobfs {
+namespace {
+
+constexpr uint64_t kBlobSize = 32 * kBlobfsBlockSize;
+constexpr uint64_t kTransferBufferBlocks = 64;
+constexpr size_t kNumWorkers = 4;
+
+// The reads of all transfer buffers of a PageLoader. Reads can be held until the test releases
+// them, to have several page requests in progress at once.
+class ReadLog {
+ public:
+  void set_hold(bool hold) {
+    std::lock_guard lock(mutex_);
+    hold_ = hold;
+  }
+
+  // Returns the offsets of the reads started so far, in order.
+  std::vector<uint64_t> reads() {
+    std::lock_guard lock(mutex_);
+    return reads_;
+  }
+
+  // Waits until |count| reads have started.
+  void WaitForReads(size_t count) {
+    std::unique_lock lock(mutex_);
+    condition_.wait(lock, [this, count] { return reads_.size() >= count; });
+  }
+
+  // Lets the held read at |offset| finish with |status|.
+  void Release(uint64_t offset, zx_status_t status = ZX_OK) {
+    std::lock_guard lock(mutex_);
+    released_[offset] = status;
+    condition_.notify_all();
+  }
+
+  zx_status_t Read(uint64_t offset) {
+    std::unique_lock lock(mutex_);
+    reads_.push_back(offset);
+    condition_.notify_all();
+    if (!hold_) {
+      return ZX_OK;
+    }
+    condition_.wait(lock, [this, offset] { return released_.find(offset) != released_.end(); });
+    return released_[offset];
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool hold_ = false;
+  std::vector<uint64_t> reads_;
+  std::map<uint64_t, zx_status_t> released_;
+};
+
+// A transfer buffer which reads the blob from memory instead of from storage.
+class FakeTransferBuffer : public TransferBuffer {
+ public:
+  FakeTransferBuffer(const std::vector<uint8_t>* blob, ReadLog* log) : blob_(blob), log_(log) {
+    ZX_ASSERT(zx::vmo::create(GetSize(), 0, &vmo_) == ZX_OK);
+  }
+
+  zx::status<> Populate(uint64_t offset, uint64_t length, const LoaderInfo& info) final {
+    if (zx_status_t status = log_->Read(offset); status != ZX_OK) {
+      return zx::error(status);
+    }
+    length = std::min(length, blob_->size() - offset);
+    return zx::make_status(vmo_.write(blob_->data() + offset, 0, length));
+  }
+
+  const zx::vmo& GetVmo() const final { return vmo_; }
+  size_t GetSize() const final { return kTransferBufferBlocks * kBlobfsBlockSize; }
+
+ private:
+  const std::vector<uint8_t>* const blob_;
+  ReadLog* const log_;
+  zx::vmo vmo_;
+};
+
+// A page request, served on a thread of its own like the pager threads do.
+class PageRequest {
+ public:
+  PageRequest(PageLoader* loader, const LoaderInfo* info, uint64_t offset, uint64_t length) {
+    std::promise<zx_handle_t> thread_promise;
+    std::future<zx_handle_t> thread_future = thread_promise.get_future();
+    thread_ = std::thread([this, loader, info, offset, length,
+                           thread_promise = std::move(thread_promise)]() mutable {
+      thread_promise.set_value(zx_thread_self());
+      status_ = loader->TransferPages(
+          [](uint64_t, uint64_t, const zx::vmo&, uint64_t) { return zx::ok(); }, offset, length,
+          *info);
+    });
+    thread_handle_ = thread_future.get();
+  }
+
+  ~PageRequest() {
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  // Waits until the request is blocked, i.e. waiting for a transfer of another request.
+  void WaitUntilBlocked() const {
+    while (true) {
+      zx_info_thread_t info;
+      ASSERT_EQ(zx_object_get_info(thread_handle_, ZX_INFO_THREAD, &info, sizeof(info), nullptr,
+                                   nullptr),
+                ZX_OK);
+      if (info.state == ZX_THREAD_STATE_BLOCKED_FUTEX) {
+        return;
+      }
+      zx::nanosleep(zx::deadline_after(zx::msec(1)));
+    }
+  }
+
+  PagerErrorStatus Wait() {
+    thread_.join();
+    return status_;
+  }
+
+ private:
+  std::thread thread_;
+  zx_handle_t thread_handle_ = ZX_HANDLE_INVALID;
+  PagerErrorStatus status_ = PagerErrorStatus::kOK;
+};
+
+class PageLoaderTest : public testing::Test {
+ public:
+  void SetUp() override {
+    blob_.resize(kBlobSize);
+    for (size_t i = 0; i < blob_.size(); ++i) {
+      blob_[i] = static_cast<uint8_t>(i * 7 + i / kBlobfsBlockSize);
+    }
+
+    constexpr BlobLayoutFormat kFormat = BlobLayoutFormat::kCompactMerkleTreeAtEnd;
+    auto layout = BlobLayout::CreateFromSizes(kFormat, kBlobSize, kBlobSize, kBlobfsBlockSize);
+    ASSERT_TRUE(layout.is_ok());
+    std::unique_ptr<MerkleTreeInfo> merkle_tree =
+        CreateMerkleTree(blob_.data(), blob_.size(), ShouldUseCompactMerkleTreeFormat(kFormat));
+    fzl::OwnedVmoMapper merkle_blocks;
+    ASSERT_EQ(merkle_blocks.CreateAndMap((*layout)->MerkleTreeBlockAlignedSize(), "merkle"), ZX_OK);
+    memcpy(static_cast<uint8_t*>(merkle_blocks.start()) +
+               (*layout)->MerkleTreeOffsetWithinBlockOffset(),
+           merkle_tree->merkle_tree.get(), merkle_tree->merkle_tree_size);
+    auto verifier = BlobVerifier::Create(
+        merkle_tree->root, metrics_,
+        cpp20::span(static_cast<const uint8_t*>(merkle_blocks.start()), merkle_blocks.size()),
+        **layout, nullptr);
+    ASSERT_TRUE(verifier.is_ok()) << verifier.status_string();
+    info_.layout = std::move(*layout);
+    info_.verifier = std::move(*verifier);
+
+    std::vector<std::unique_ptr<PageLoader::WorkerResources>> resources;
+    for (size_t i = 0; i < kNumWorkers; ++i) {
+      resources.push_back(std::make_unique<PageLoader::WorkerResources>(
+          std::make_unique<FakeTransferBuffer>(&blob_, &log_),
+          std::make_unique<FakeTransferBuffer>(&blob_, &log_)));
+    }
+    auto loader = PageLoader::Create(std::move(resources), kBlobfsBlockSize, metrics_.get(),
+                                     /*decompression_connector=*/nullptr);
+    ASSERT_TRUE(loader.is_ok()) << loader.status_string();
+    loader_ = std::move(*loader);
+  }
+
+  // Starts a request for [|offset|, |offset| + |length|) of the blob.
+  std::unique_ptr<PageRequest> Request(uint64_t offset, uint64_t length) {
+    return std::make_unique<PageRequest>(loader_.get(), &info_, offset, length);
+  }
+
+  ReadLog& log() { return log_; }
+
+ private:
+  std::shared_ptr<BlobfsMetrics> metrics_ = std::make_shared<BlobfsMetrics>(false);
+  std::vector<uint8_t> blob_;
+  ReadLog log_;
+  LoaderInfo info_;
+  std::unique_ptr<PageLoader> loader_;
+};
+
+// The first request of a blob reads ahead by twice the default of 32k, and a request which doesn't
+// start where the previous one ended by half as much as the previous one.
+constexpr uint64_t kFirstReadAhead = 8 * kBlobfsBlockSize;
+
+TEST_F(PageLoaderTest, OverlappingRequestOnlyReadsTheRest) {
+  log().set_hold(true);
+  auto first = Request(0, kBlobfsBlockSize);
+  log().WaitForReads(1);
+
+  // The start of this request is covered by the first transfer, which it no longer reads.
+  auto second = Request(kFirstReadAhead - kBlobfsBlockSize, 2 * kBlobfsBlockSize);
+  log().WaitForReads(2);
+  EXPECT_EQ(log().reads(), (std::vector<uint64_t>{0, kFirstReadAhead}));
+
+  // The second request waits for the first transfer before it returns.
+  log().Release(kFirstReadAhead);
+  second->WaitUntilBlocked();
+  log().Release(0);
+  EXPECT_EQ(first->Wait(), PagerErrorStatus::kOK);
+  EXPECT_EQ(second->Wait(), PagerErrorStatus::kOK);
+  EXPECT_EQ(log().reads().size(), 2u);
+}
+
+TEST_F(PageLoaderTest, CoveredRequestDoesNotRead) {
+  log().set_hold(true);
+  auto first = Request(0, kBlobfsBlockSize);
+  log().WaitForReads(1);
+
+  auto second = Request(2 * kBlobfsBlockSize, 2 * kBlobfsBlockSize);
+  second->WaitUntilBlocked();
+  log().Release(0);
+  EXPECT_EQ(first->Wait(), PagerErrorStatus::kOK);
+  EXPECT_EQ(second->Wait(), PagerErrorStatus::kOK);
+  EXPECT_EQ(log().reads(), std::vector<uint64_t>{0});
+}
+
+TEST_F(PageLoaderTest, AdjacentRequestDoesNotWait) {
+  log().set_hold(true);
+  auto first = Request(0, kBlobfsBlockSize);
+  log().WaitForReads(1);
+
+  // This request starts where the first transfer ends, so it neither skips nor waits for any of it.
+  auto second = Request(kFirstReadAhead, kBlobfsBlockSize);
+  log().WaitForReads(2);
+  EXPECT_EQ(log().reads(), (std::vector<uint64_t>{0, kFirstReadAhead}));
+  log().Release(kFirstReadAhead);
+  EXPECT_EQ(second->Wait(), PagerErrorStatus::kOK);
+
+  // A failure of the first transfer doesn't affect the second request either.
+  log().Release(0, ZX_ERR_IO);
+  EXPECT_EQ(first->Wait(), PagerErrorStatus::kErrIO);
+}
+
+TEST_F(PageLoaderTest, FailedTransferFailsTheRequestsWaitingForIt) {
+  log().set_hold(true);
+  auto first = Request(0, kBlobfsBlockSize);
+  log().WaitForReads(1);
+
+  auto covered = Request(2 * kBlobfsBlockSize, kBlobfsBlockSize);
+  covered->WaitUntilBlocked();
+  auto overlapping = Request(kFirstReadAhead - kBlobfsBlockSize, 2 * kBlobfsBlockSize);
+  log().WaitForReads(2);
+
+  // Even though the overlapping request reads the rest of its range, the pages of its start are
+  // never supplied, so it has to fail as well.
+  log().Release(kFirstReadAhead);
+  overlapping->WaitUntilBlocked();
+  log().Release(0, ZX_ERR_IO);
+  EXPECT_EQ(first->Wait(), PagerErrorStatus::kErrIO);
+  EXPECT_EQ(covered->Wait(), PagerErrorStatus::kErrIO);
+  EXPECT_EQ(overlapping->Wait(), PagerErrorStatus::kErrIO);
+
+  // Later requests for the same range read it again.
+  log().set_hold(false);
+  EXPECT_EQ(Request(0, kBlobfsBlockSize)->Wait(), PagerErrorStatus::kOK);
+  EXPECT_EQ(log().reads(), (std::vector<uint64_t>{0, kFirstReadAhead, 0}));
+}
+
+}  // namespace
+}  // namespace blobfs
@@ -0,0 +1,110 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/storage/blobfs/prefetch_manifest.h"
+
+#include <string.h>
+
+#include <gtest/gtest.h>
+
+#include "src/storage/blobfs/format.h"
+
+namespace blobfs {
+namespace {
+
+digest::Digest MakeDigest(uint8_t value) {
+  uint8_t bytes[digest::kSha256Length];
+  memset(bytes, value, sizeof(bytes));
+  return digest::Digest(bytes);
+}
+
+TEST(PrefetchManifestTest, AddRoundsRangesOutToBlocks) {
+  PrefetchManifest manifest;
+  ASSERT_TRUE(manifest.Add(MakeDigest(1), kBlobfsBlockSize + 1, 2));
+
+  ASSERT_EQ(manifest.entries().size(), 1u);
+  EXPECT_EQ(manifest.entries()[0].offset, kBlobfsBlockSize);
+  EXPECT_EQ(manifest.entries()[0].length, kBlobfsBlockSize);
+}
+
+TEST(PrefetchManifestTest, AddMergesNearbyRangesOfTheSameBlob) {
+  const digest::Digest first = MakeDigest(1);
+  const digest::Digest second = MakeDigest(2);
+  PrefetchManifest manifest;
+  ASSERT_TRUE(manifest.Add(first, 0, kBlobfsBlockSize));
+  ASSERT_TRUE(manifest.Add(second, 0, kBlobfsBlockSize));
+  // Within the merge distance of the first range, and the gap is filled in.
+  ASSERT_TRUE(manifest.Add(first, 2 * kBlobfsBlockSize, kBlobfsBlockSize));
+  // Too far away from it.
+  const uint64_t far_offset = 3 * kBlobfsBlockSize + 2 * PrefetchManifest::kMergeDistance;
+  ASSERT_TRUE(manifest.Add(first, far_offset, kBlobfsBlockSize));
+
+  ASSERT_EQ(manifest.entries().size(), 3u);
+  EXPECT_EQ(manifest.entries()[0].digest, first);
+  EXPECT_EQ(manifest.entries()[0].offset, 0u);
+  EXPECT_EQ(manifest.entries()[0].length, 3 * kBlobfsBlockSize);
+  EXPECT_EQ(manifest.entries()[1].digest, second);
+  EXPECT_EQ(manifest.entries()[2].digest, first);
+  EXPECT_EQ(manifest.entries()[2].offset, far_offset);
+}
+
+TEST(PrefetchManifestTest, AddFailsWhenFull) {
+  PrefetchManifest manifest;
+  const uint64_t stride = 2 * (PrefetchManifest::kMergeDistance + kBlobfsBlockSize);
+  for (size_t i = 0; i < PrefetchManifest::kMaxEntries; ++i) {
+    ASSERT_TRUE(manifest.Add(MakeDigest(1), i * stride, kBlobfsBlockSize));
+  }
+  EXPECT_FALSE(manifest.Add(MakeDigest(2), 0, kBlobfsBlockSize));
+  // Merging doesn't need another entry.
+  EXPECT_TRUE(manifest.Add(MakeDigest(1), kBlobfsBlockSize, kBlobfsBlockSize));
+}
+
+TEST(PrefetchManifestTest, SerializeAndParseRoundTrip) {
+  PrefetchManifest manifest;
+  ASSERT_TRUE(manifest.Add(MakeDigest(1), 0, 3 * kBlobfsBlockSize));
+  ASSERT_TRUE(manifest.Add(MakeDigest(2), 100 * kBlobfsBlockSize, kBlobfsBlockSize));
+
+  std::vector<uint8_t> data = manifest.Serialize();
+  zx::status<PrefetchManifest> parsed = PrefetchManifest::Parse(data);
+  ASSERT_TRUE(parsed.is_ok()) << parsed.status_string();
+
+  ASSERT_EQ(parsed->entries().size(), manifest.entries().size());
+  for (size_t i = 0; i < manifest.entries().size(); ++i) {
+    EXPECT_EQ(parsed->entries()[i].digest, manifest.entries()[i].digest);
+    EXPECT_EQ(parsed->entries()[i].offset, manifest.entries()[i].offset);
+    EXPECT_EQ(parsed->entries()[i].length, manifest.entries()[i].length);
+  }
+}
+
+TEST(PrefetchManifestTest, ParseRejectsCorruptData) {
+  PrefetchManifest manifest;
+  ASSERT_TRUE(manifest.Add(MakeDigest(1), 0, kBlobfsBlockSize));
+  const std::vector<uint8_t> data = manifest.Serialize();
+
+  EXPECT_EQ(PrefetchManifest::Parse({}).status_value(), ZX_ERR_IO_DATA_INTEGRITY);
+
+  std::vector<uint8_t> truncated(data.begin(), data.end() - 1);
+  EXPECT_EQ(PrefetchManifest::Parse(truncated).status_value(), ZX_ERR_IO_DATA_INTEGRITY);
+
+  std::vector<uint8_t> bad_magic = data;
+  bad_magic[0] ^= 0xff;
+  EXPECT_EQ(PrefetchManifest::Parse(bad_magic).status_value(), ZX_ERR_IO_DATA_INTEGRITY);
+}
+
+TEST(PrefetchRecorderTest, RecordsOnlyWhileStarted) {
+  PrefetchRecorder recorder;
+  recorder.Record(MakeDigest(1), 0, kBlobfsBlockSize);
+  EXPECT_TRUE(recorder.manifest().entries().empty());
+
+  recorder.Start(zx::duration::infinite());
+  recorder.Record(MakeDigest(1), 0, kBlobfsBlockSize);
+  EXPECT_EQ(recorder.manifest().entries().size(), 1u);
+
+  recorder.Start(zx::duration());
+  recorder.Record(MakeDigest(2), 0, kBlobfsBlockSize);
+  EXPECT_EQ(recorder.manifest().entries().size(), 1u);
+}
+
+}  // namespace
+}  // namespace blobfs
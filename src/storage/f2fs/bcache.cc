@@ -157,6 +157,7 @@ zx_status_t Bcache::Writeblk(block_t bno, const void* data) {
 
 #ifdef __Fuchsia__
 zx_status_t Bcache::RunRequests(const std::vector<storage::BufferedOperation>& operations) {
+  request_count_.fetch_add(1, std::memory_order_relaxed);
   std::shared_lock lock(mutex_);
   return DeviceTransactionHandler::RunRequests(operations);
 }
@@ -182,6 +183,7 @@ zx_status_t Bcache::RunOperation(const storage::Operation& operation,
 }
 
 zx_status_t Bcache::RunRequests(const std::vector<storage::BufferedOperation>& operations) {
+  request_count_.fetch_add(1, std::memory_order_relaxed);
   std::shared_lock lock(mutex_);
   for (auto& operation : operations) {
     const auto& op = operation.op;
@@ -11,6 +11,7 @@
 #ifdef __Fuchsia__
 #include <lib/zx/vmo.h>
 
+#include <storage/buffer/owned_vmoid.h>
 #include <storage/buffer/vmo_buffer.h>
 #include <storage/buffer/vmoid_registry.h>
 
@@ -23,6 +24,8 @@
 #include "src/lib/storage/vfs/cpp/transaction/transaction_handler.h"
 #endif  // __Fuchsia__
 
+#include <atomic>
+
 #include <fbl/algorithm.h>
 #include <fbl/array.h>
 #include <fbl/macros.h>
@@ -62,6 +65,9 @@ class Bcache : public fs::TransactionHandler {
   block_t BlockSize() const { return block_size_; }
 
   zx_status_t RunRequests(const std::vector<storage::BufferedOperation>& operations) override;
+  // The number of RunRequests() calls so far. Background work compares it over time to tell
+  // whether the device is idle.
+  uint64_t GetRequestCount() const { return request_count_.load(std::memory_order_relaxed); }
 #ifdef __Fuchsia__
   // This factory allows building this object from a BlockDevice. Bcache can take ownership of the
   // device (the first Create method), or not (the second Create method).
@@ -113,6 +119,7 @@ class Bcache : public fs::TransactionHandler {
   const uint64_t max_blocks_;
   std::mutex buffer_mutex_;
   std::shared_mutex mutex_;
+  std::atomic<uint64_t> request_count_ = 0;
 
 #ifdef __Fuchsia__
   Bcache(std::unique_ptr<block_client::BlockDevice> device, uint64_t max_blocks,
@@ -162,28 +162,32 @@ DirEntry *Dir::FindEntryOnDevice(std::string_view name, fbl::RefPtr<Page> *res_p
   unsigned int level;
 
   if (TestFlag(InodeInfoFlag::kInlineDentry)) {
-    return FindInInlineDir(name, res_page);
-  }
-
-  if (npages == 0)
-    return nullptr;
+    de = FindInInlineDir(name, res_page);
+  } else if (npages) {
+    *res_page = nullptr;
 
-  *res_page = nullptr;
+    name_hash = DentryHash(name);
+    max_depth = static_cast<unsigned int>(GetCurDirDepth());
 
-  name_hash = DentryHash(name);
-  max_depth = static_cast<unsigned int>(GetCurDirDepth());
+    for (level = 0; level < max_depth; ++level) {
+      if (de = FindInLevel(level, name, name_hash, res_page); de != nullptr)
+        break;
+    }
+    if (!de && !IsSameDirHash(name_hash)) {
+      SetDirHash(name_hash, level - 1);
+    }
 
-  for (level = 0; level < max_depth; ++level) {
-    if (de = FindInLevel(level, name, name_hash, res_page); de != nullptr)
-      break;
-  }
-  if (!de && !IsSameDirHash(name_hash)) {
-    SetDirHash(name_hash, level - 1);
+#ifdef __Fuchsia__
+    if (de != nullptr) {
+      fs()->GetDirEntryCache().UpdateDirEntry(Ino(), name, *de, (*res_page)->GetIndex());
+    }
+#endif  // __Fuchsia__
   }
 
 #ifdef __Fuchsia__
-  if (de != nullptr) {
-    fs()->GetDirEntryCache().UpdateDirEntry(Ino(), name, *de, (*res_page)->GetIndex());
+  // Remember the miss so that the next lookup for |name| does not need to scan dentry blocks.
+  if (de == nullptr) {
+    fs()->GetDirEntryCache().AddNegativeDirEntry(Ino(), name);
   }
 #endif  // __Fuchsia__
 
@@ -192,8 +196,11 @@ DirEntry *Dir::FindEntryOnDevice(std::string_view name, fbl::RefPtr<Page> *res_p
 
 DirEntry *Dir::FindEntry(std::string_view name, fbl::RefPtr<Page> *res_page) {
 #ifdef __Fuchsia__
-  if (auto cache_page_index = fs()->GetDirEntryCache().LookupDataPageIndex(Ino(), name);
-      !cache_page_index.is_error()) {
+  auto cache_page_index = fs()->GetDirEntryCache().LookupDataPageIndex(Ino(), name);
+  if (cache_page_index.status_value() == ZX_ERR_NOT_FOUND) {
+    return nullptr;
+  }
+  if (cache_page_index.is_ok()) {
     if (TestFlag(InodeInfoFlag::kInlineDentry)) {
       return FindInInlineDir(name, res_page);
     }
@@ -225,8 +232,8 @@ zx::status<DirEntry> Dir::FindEntry(std::string_view name) {
 
 #ifdef __Fuchsia__
   auto element = fs()->GetDirEntryCache().LookupDirEntry(Ino(), name);
-  if (!element.is_error()) {
-    return zx::ok(*element);
+  if (element.is_ok() || element.status_value() == ZX_ERR_NOT_FOUND) {
+    return element;
   }
 #endif  // __Fuchsia__
 
@@ -7,10 +7,15 @@
 
 namespace f2fs {
 
-DirEntryCache::DirEntryCache() {
+DirEntryCache::DirEntryCache() : max_slabs_(GetMaxSlabs()) {
   std::lock_guard lock(lock_);
 
-  slab_allocator_ = std::make_unique<ElementAllocator>(kDirEntryCacheSlabCount, true);
+  slab_allocator_ = std::make_unique<ElementAllocator>(max_slabs_, true);
+}
+
+size_t DirEntryCache::GetMaxSlabs() {
+  uint64_t slabs = zx_system_get_physmem() / kDirEntryCacheMemoryPerSlab;
+  return std::clamp(slabs, uint64_t{kDirEntryCacheSlabCount}, uint64_t{kDirEntryCacheMaxSlabCount});
 }
 
 DirEntryCache::~DirEntryCache() { Reset(); }
@@ -20,6 +25,9 @@ void DirEntryCache::Reset() {
 
   map_.clear();
   element_lru_list_.clear();
+  hit_count_ = 0;
+  negative_hit_count_ = 0;
+  miss_count_ = 0;
 }
 
 DirEntryCacheElement &DirEntryCache::AllocateElement(ino_t parent_ino,
@@ -81,6 +89,21 @@ void DirEntryCache::Evict() {
   }
 }
 
+zx::status<DirEntryCacheElement *> DirEntryCache::LookupElement(ino_t parent_ino,
+                                                                std::string_view child_name) {
+  DirEntryCacheElement *element = FindElement(parent_ino, child_name);
+  if (element == nullptr) {
+    ++miss_count_;
+    return zx::error(ZX_ERR_UNAVAILABLE);
+  }
+  if (element->IsNegative()) {
+    ++negative_hit_count_;
+    return zx::error(ZX_ERR_NOT_FOUND);
+  }
+  ++hit_count_;
+  return zx::ok(element);
+}
+
 zx::status<DirEntry> DirEntryCache::LookupDirEntry(ino_t parent_ino, std::string_view child_name) {
   if (IsDotOrDotDot(child_name)) {
     return zx::error(ZX_ERR_NOT_SUPPORTED);
@@ -88,14 +111,14 @@ zx::status<DirEntry> DirEntryCache::LookupDirEntry(ino_t parent_ino, std::string
 
   std::lock_guard lock(lock_);
 
-  DirEntryCacheElement *element = FindElement(parent_ino, child_name);
-  if (element == nullptr) {
-    return zx::error(ZX_ERR_NOT_FOUND);
+  auto element_or = LookupElement(parent_ino, child_name);
+  if (element_or.is_error()) {
+    return element_or.take_error();
   }
 
   // The |element| may be evicted while the caller is using it.
   // Therefore, return copied value rather than reference.
-  return zx::ok(element->GetDirEntry());
+  return zx::ok((*element_or)->GetDirEntry());
 }
 
 zx::status<pgoff_t> DirEntryCache::LookupDataPageIndex(ino_t parent_ino,
@@ -106,12 +129,12 @@ zx::status<pgoff_t> DirEntryCache::LookupDataPageIndex(ino_t parent_ino,
 
   std::lock_guard lock(lock_);
 
-  DirEntryCacheElement *element = FindElement(parent_ino, child_name);
-  if (element == nullptr) {
-    return zx::error(ZX_ERR_NOT_FOUND);
+  auto element_or = LookupElement(parent_ino, child_name);
+  if (element_or.is_error()) {
+    return element_or.take_error();
   }
 
-  return zx::ok(element->GetDataPageIndex());
+  return zx::ok((*element_or)->GetDataPageIndex());
 }
 
 void DirEntryCache::AddNewDirEntry(ino_t parent_ino, std::string_view child_name,
@@ -140,6 +163,20 @@ void DirEntryCache::UpdateDirEntry(ino_t parent_ino, std::string_view child_name
   element->SetDataPageIndex(data_page_index);
 }
 
+void DirEntryCache::AddNegativeDirEntry(ino_t parent_ino, std::string_view child_name) {
+  if (IsDotOrDotDot(child_name)) {
+    return;
+  }
+
+  std::lock_guard lock(lock_);
+
+  DirEntryCacheElement *element = FindElement(parent_ino, child_name);
+  if (element == nullptr) {
+    element = &AllocateElement(parent_ino, child_name);
+  }
+  element->SetNegative();
+}
+
 void DirEntryCache::RemoveDirEntry(ino_t parent_ino, std::string_view child_name) {
   if (IsDotOrDotDot(child_name)) {
     return;
@@ -153,13 +190,42 @@ void DirEntryCache::RemoveDirEntry(ino_t parent_ino, std::string_view child_name
   }
 }
 
+size_t DirEntryCache::GetSize() const {
+  std::lock_guard lock(lock_);
+  return map_.size();
+}
+
+uint64_t DirEntryCache::GetHitCount() const {
+  std::lock_guard lock(lock_);
+  return hit_count_;
+}
+
+uint64_t DirEntryCache::GetNegativeHitCount() const {
+  std::lock_guard lock(lock_);
+  return negative_hit_count_;
+}
+
+uint64_t DirEntryCache::GetMissCount() const {
+  std::lock_guard lock(lock_);
+  return miss_count_;
+}
+
 bool DirEntryCache::IsElementInCache(ino_t parent_ino, std::string_view child_name) const {
   std::lock_guard lock(lock_);
   auto search = map_.find(DirEntryCache::GenerateKey(parent_ino, child_name));
   if (search == map_.end()) {
     return false;
   }
-  return true;
+  return !search->second->IsNegative();
+}
+
+bool DirEntryCache::IsNegativeElementInCache(ino_t parent_ino, std::string_view child_name) const {
+  std::lock_guard lock(lock_);
+  auto search = map_.find(DirEntryCache::GenerateKey(parent_ino, child_name));
+  if (search == map_.end()) {
+    return false;
+  }
+  return search->second->IsNegative();
 }
 
 bool DirEntryCache::IsElementAtHead(ino_t parent_ino, std::string_view child_name) const {
@@ -11,7 +11,11 @@
 namespace f2fs {
 
 constexpr uint32_t kDirEntryCacheSlabSize = 65536;
+// The number of slabs scales with physical memory, one slab for every |kDirEntryCacheMemoryPerSlab|
+// bytes, between |kDirEntryCacheSlabCount| and |kDirEntryCacheMaxSlabCount|.
 constexpr uint32_t kDirEntryCacheSlabCount = 1;
+constexpr uint32_t kDirEntryCacheMaxSlabCount = 16;
+constexpr uint64_t kDirEntryCacheMemoryPerSlab = 512ULL * 1024 * 1024;
 
 // When a directory with inline dentry is converted to non-inline dentry, existing entries will be
 // located to the first data page (page 0) of the directory. By using page index 0 for cached inline
@@ -42,7 +46,14 @@ class DirEntryCacheElement : public fbl::RefCounted<DirEntryCacheElement>,
   std::string_view GetName() const { return name_.GetStringView(); }
 
   DirEntry GetDirEntry() const { return dir_entry_; }
-  void SetDirEntry(DirEntry &de) { dir_entry_ = de; }
+  void SetDirEntry(DirEntry &de) {
+    dir_entry_ = de;
+    negative_ = false;
+  }
+
+  // A negative element records that |name_| does not exist in |parent_ino_|.
+  bool IsNegative() const { return negative_; }
+  void SetNegative() { negative_ = true; }
 
   pgoff_t GetDataPageIndex() const { return data_page_index_; }
   void SetDataPageIndex(pgoff_t data_page_index) { data_page_index_ = data_page_index; }
@@ -52,6 +63,7 @@ class DirEntryCacheElement : public fbl::RefCounted<DirEntryCacheElement>,
   NameString name_;
   DirEntry dir_entry_;
   pgoff_t data_page_index_ = 0;
+  bool negative_ = false;
 };
 
 class DirEntryCache {
@@ -70,16 +82,34 @@ class DirEntryCache {
   // Therefore, explicit deallocation on unmount is needed.
   void Reset() __TA_EXCLUDES(lock_);
 
+  // The lookup methods return ZX_ERR_NOT_FOUND when |child_name| is known not to exist in
+  // |parent_ino|, and ZX_ERR_UNAVAILABLE when nothing is cached for |child_name|.
   zx::status<DirEntry> LookupDirEntry(ino_t parent_ino, std::string_view child_name)
       __TA_EXCLUDES(lock_);
   zx::status<pgoff_t> LookupDataPageIndex(ino_t parent_ino, std::string_view child_name)
       __TA_EXCLUDES(lock_);
+  // It also turns a negative element for |child_name| into a positive one, so it must be called
+  // whenever a dentry is added.
   void UpdateDirEntry(ino_t parent_ino, std::string_view child_name, DirEntry &dir_entry,
                       pgoff_t data_page_index) __TA_EXCLUDES(lock_);
+  // It records that a lookup for |child_name| in |parent_ino| has failed on disk.
+  void AddNegativeDirEntry(ino_t parent_ino, std::string_view child_name) __TA_EXCLUDES(lock_);
   void RemoveDirEntry(ino_t parent_ino, std::string_view child_name) __TA_EXCLUDES(lock_);
 
+  // The maximum number of elements, which is determined by the size of physical memory.
+  size_t GetMaxElements() const { return max_slabs_ * ElementAllocator::AllocsPerSlab; }
+  // The number of elements in the cache, including negative ones.
+  size_t GetSize() const __TA_EXCLUDES(lock_);
+  // Lookup statistics. Lookups for "." and ".." are not counted.
+  uint64_t GetHitCount() const __TA_EXCLUDES(lock_);
+  uint64_t GetNegativeHitCount() const __TA_EXCLUDES(lock_);
+  uint64_t GetMissCount() const __TA_EXCLUDES(lock_);
+
   // For testing
+  // It returns true only for a positive element.
   bool IsElementInCache(ino_t parent_ino, std::string_view child_name) const __TA_EXCLUDES(lock_);
+  bool IsNegativeElementInCache(ino_t parent_ino, std::string_view child_name) const
+      __TA_EXCLUDES(lock_);
   bool IsElementAtHead(ino_t parent_ino, std::string_view child_name) const __TA_EXCLUDES(lock_);
   const std::map<EntryKey, ElementRefPtr> &GetMap() const __TA_EXCLUDES(lock_);
 
@@ -96,16 +126,26 @@ class DirEntryCache {
   DirEntryCacheElement *FindElement(ino_t parent_ino, std::string_view child_name)
       __TA_REQUIRES(lock_);
 
+  // It finds the element for a lookup and updates the statistics.
+  zx::status<DirEntryCacheElement *> LookupElement(ino_t parent_ino, std::string_view child_name)
+      __TA_REQUIRES(lock_);
+
   void OnCacheHit(ElementRefPtr &element) __TA_REQUIRES(lock_);
   void Evict() __TA_REQUIRES(lock_);
 
+  static size_t GetMaxSlabs();
+
   static EntryKey GenerateKey(ino_t parent_ino, std::string_view child_name) {
     return EntryKey(parent_ino, std::string(child_name));
   }
 
+  const size_t max_slabs_;
   std::unique_ptr<ElementAllocator> slab_allocator_ __TA_GUARDED(lock_);
   std::map<EntryKey, ElementRefPtr> map_ __TA_GUARDED(lock_);
   ElementList element_lru_list_ __TA_GUARDED(lock_);
+  uint64_t hit_count_ __TA_GUARDED(lock_) = 0;
+  uint64_t negative_hit_count_ __TA_GUARDED(lock_) = 0;
+  uint64_t miss_count_ __TA_GUARDED(lock_) = 0;
   // Since LRU list needs modification even for lookup, using mutex rather than shared mutex
   mutable std::mutex lock_;
 };
@@ -197,6 +197,13 @@ zx::status<std::vector<LockedPage>> F2fs::MakeReadOperations(std::vector<LockedP
   return reader_->SubmitPages(std::move(pages), std::move(addrs));
 }
 
+#ifdef __Fuchsia__
+zx_status_t F2fs::MakeReadOperations(zx::vmo &vmo, const std::vector<block_t> &addrs,
+                                     PageType type) {
+  return reader_->ReadBlocks(vmo, addrs);
+}
+#endif  // __Fuchsia__
+
 zx_status_t F2fs::MakeWriteOperation(LockedPage& page, block_t blk_addr, PageType type) {
   return writer_->EnqueuePage(page, blk_addr, type).status_value();
 }
@@ -287,6 +287,10 @@ class F2fs final {
                                                          bool is_sync = true);
   zx::status<LockedPage> MakeReadOperation(LockedPage page, block_t blk_addr, PageType type,
                                            bool is_sync = true);
+#ifdef __Fuchsia__
+  // It reads the blocks of |addrs| into the zero-filled |vmo| without going through FileCache.
+  zx_status_t MakeReadOperations(zx::vmo &vmo, const std::vector<block_t> &addrs, PageType type);
+#endif  // __Fuchsia__
   zx_status_t MakeWriteOperation(LockedPage &page, block_t blk_addr, PageType type);
   zx_status_t MakeTrimOperation(block_t blk_addr, block_t nblocks);
 
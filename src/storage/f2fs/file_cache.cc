@@ -151,10 +151,8 @@ void Page::ClearWriteback() {
 
 void Page::SetMmapped() {
   ZX_DEBUG_ASSERT(IsLocked());
-  if (IsUptodate()) {
-    if (!SetFlag(PageFlag::kPageMmapped)) {
-      fs_->GetSuperblockInfo().IncreasePageCount(CountType::kMmapedData);
-    }
+  if (!SetFlag(PageFlag::kPageMmapped)) {
+    fs_->GetSuperblockInfo().IncreasePageCount(CountType::kMmapedData);
   }
 }
 
@@ -143,6 +143,8 @@ class Page : public PageRefCounted<Page>,
   bool ClearDirtyForIo();
 
   // It ensures that the contents of |this| is synchronized with the corresponding pager backed vmo.
+  // |this| doesn't need to be uptodate since the pager backed vmo can be supplied from disk
+  // directly. Any later change to |this| is written to the vmo as well.
   void SetMmapped();
   bool ClearMmapped();
 
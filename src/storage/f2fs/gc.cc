@@ -12,8 +12,7 @@ uint32_t SegmentManager::GetGcCost(uint32_t segno, const VictimSelPolicy &policy
   if (policy.gc_mode == GcMode::kGcGreedy) {
     return GetGreedyCost(segno);
   } else {
-    // TODO: Add GetCbCost() for GcMode::kGcCb when Background GC is implemented.
-    return kUint32Max;
+    return GetCbCost(segno);
   }
 }
 
@@ -27,6 +26,50 @@ uint32_t SegmentManager::GetGreedyCost(uint32_t segno) {
   }
 }
 
+uint32_t SegmentManager::GetCbCost(uint32_t segno) {
+  const uint32_t segs_per_sec = superblock_info_->GetSegsPerSec();
+  const uint32_t start = GetSecNo(segno) * segs_per_sec;
+
+  uint64_t mtime = 0;
+  for (uint32_t i = 0; i < segs_per_sec; ++i) {
+    mtime += GetSegmentEntry(start + i).mtime;
+  }
+  mtime /= segs_per_sec;
+  const uint32_t valid_blocks = GetValidBlocks(segno, segs_per_sec) / segs_per_sec;
+
+  // The utilization of the section in percent.
+  const uint64_t utilization =
+      (uint64_t{valid_blocks} * 100) >> superblock_info_->GetLogBlocksPerSeg();
+
+  // The system time may have been changed by the user.
+  sit_info_->min_mtime = std::min(sit_info_->min_mtime, mtime);
+  sit_info_->max_mtime = std::max(sit_info_->max_mtime, mtime);
+
+  // The age of the section relative to the others in percent. The oldest one is 100.
+  uint64_t age = 0;
+  if (sit_info_->max_mtime != sit_info_->min_mtime) {
+    age = 100 - (100 * (mtime - sit_info_->min_mtime)) /
+                    (sit_info_->max_mtime - sit_info_->min_mtime);
+  }
+
+  return kUint32Max -
+         static_cast<uint32_t>((100 * (100 - utilization) * age) / (100 + utilization));
+}
+
+uint32_t SegmentManager::CheckBgVictims() {
+  const uint32_t total_secs = superblock_info_->GetTotalSections();
+  for (uint32_t secno = FindNextBit(dirty_info_->victim_secmap.get(), total_secs, 0);
+       secno < total_secs;
+       secno = FindNextBit(dirty_info_->victim_secmap.get(), total_secs, secno + 1)) {
+    if (SecUsageCheck(secno)) {
+      continue;
+    }
+    ClearBit(secno, dirty_info_->victim_secmap.get());
+    return secno * superblock_info_->GetSegsPerSec();
+  }
+  return kNullSegNo;
+}
+
 VictimSelPolicy SegmentManager::GetVictimSelPolicy(GcType gc_type, CursegType type,
                                                    AllocMode alloc_mode) {
   VictimSelPolicy policy;
@@ -75,11 +118,9 @@ zx::status<uint32_t> SegmentManager::GetVictimByDefault(GcType gc_type, CursegTy
     return zx::error(ZX_ERR_UNAVAILABLE);
   }
 
-#if 0  // porting needed
-  //  if (p.alloc_mode == AllocMode::kLFS && gc_type == GcType::kFgGc) {
-  //    p.min_segno = CheckBgVictims();
-  //  }
-#endif
+  if (policy.alloc_mode == AllocMode::kLFS && gc_type == GcType::kFgGc) {
+    policy.min_segno = CheckBgVictims();
+  }
 
   auto gc_mode = static_cast<int>(policy.gc_mode);
   if (policy.min_segno == kNullSegNo) {
@@ -223,6 +264,95 @@ zx::status<uint32_t> GcManager::F2fsGc() {
   return zx::ok(sec_freed);
 }
 
+zx::status<> GcManager::F2fsBgGc() {
+  if (fs_->GetSuperblockInfo().TestCpFlags(CpFlag::kCpErrorFlag)) {
+    return zx::error(ZX_ERR_BAD_STATE);
+  }
+
+  std::lock_guard gc_lock(gc_mutex_);
+  uint32_t segno;
+  if (auto ret = GetGcVictim(GcType::kBgGc, CursegType::kNoCheckType); ret.is_error()) {
+    return ret.take_error();
+  } else {
+    segno = ret.value();
+  }
+
+  if (auto err = DoGarbageCollect(segno, GcType::kBgGc); err != ZX_OK) {
+    return zx::error(err);
+  }
+  bg_gc_count_.fetch_add(1, std::memory_order_relaxed);
+  return zx::ok();
+}
+
+bool GcManager::HasEnoughInvalidBlocks() {
+  SuperblockInfo &superblock_info = fs_->GetSuperblockInfo();
+  SegmentManager &segment_manager = fs_->GetSegmentManager();
+
+  const uint64_t user_blocks = superblock_info.GetUserBlockCount();
+  const uint64_t written_blocks = segment_manager.GetWrittenBlockCount();
+  const uint64_t invalid_blocks = user_blocks > written_blocks ? user_blocks - written_blocks : 0;
+
+  const uint64_t free_segments = segment_manager.FreeSegments();
+  const uint64_t overprovision_segments = segment_manager.OverprovisionSegments();
+  const uint64_t free_blocks =
+      free_segments > overprovision_segments
+          ? (free_segments - overprovision_segments) << superblock_info.GetLogBlocksPerSeg()
+          : 0;
+
+  return invalid_blocks > user_blocks * kLimitInvalidBlocks / 100 &&
+         free_blocks < user_blocks * kLimitFreeBlocks / 100;
+}
+
+void GcManager::StartGcThread() {
+  std::lock_guard lock(gc_thread_mutex_);
+  if (gc_thread_.joinable()) {
+    return;
+  }
+  stop_gc_thread_ = false;
+  gc_thread_ = std::thread([this] { GcThreadMain(); });
+}
+
+void GcManager::StopGcThread() {
+  {
+    std::lock_guard lock(gc_thread_mutex_);
+    if (!gc_thread_.joinable()) {
+      return;
+    }
+    stop_gc_thread_ = true;
+  }
+  gc_thread_cvar_.notify_all();
+  gc_thread_.join();
+}
+
+void GcManager::GcThreadMain() {
+  std::chrono::seconds wait_time = kGcThreadMinSleepTime;
+  uint64_t last_request_count = fs_->GetBc().GetRequestCount();
+
+  std::unique_lock lock(gc_thread_mutex_);
+  while (!gc_thread_cvar_.wait_for(
+      lock, wait_time, [this]() __TA_NO_THREAD_SAFETY_ANALYSIS { return stop_gc_thread_; })) {
+    lock.unlock();
+    if (fs_->GetBc().GetRequestCount() != last_request_count) {
+      // The device is in use. Back off so as not to compete with it.
+      wait_time = std::min(wait_time + kGcThreadSleepTimeStep, kGcThreadMaxSleepTime);
+    } else if (fs_->GetSegmentManager().HasNotEnoughFreeSecs()) {
+      // The next write would have to run foreground GC. Do it now while nothing waits for it.
+      if (auto ret = F2fsGc(); ret.is_error()) {
+        wait_time = kGcThreadNoGcSleepTime;
+      }
+    } else if (!HasEnoughInvalidBlocks()) {
+      wait_time = std::min(wait_time + kGcThreadSleepTimeStep, kGcThreadMaxSleepTime);
+    } else if (auto ret = F2fsBgGc(); ret.is_error()) {
+      wait_time = kGcThreadNoGcSleepTime;
+    } else {
+      wait_time = std::max(wait_time - kGcThreadSleepTimeStep, kGcThreadMinSleepTime);
+    }
+    // The I/O GC itself issued doesn't count as load.
+    last_request_count = fs_->GetBc().GetRequestCount();
+    lock.lock();
+  }
+}
+
 zx_status_t GcManager::DoGarbageCollect(uint32_t start_segno, GcType gc_type) {
   for (uint32_t i = 0; i < fs_->GetSuperblockInfo().GetSegsPerSec(); ++i) {
     uint32_t segno = start_segno + i;
@@ -5,6 +5,10 @@
 #ifndef SRC_STORAGE_F2FS_GC_H_
 #define SRC_STORAGE_F2FS_GC_H_
 
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+
 namespace f2fs {
 
 class GcManager {
@@ -15,9 +19,30 @@ class GcManager {
   GcManager &operator=(GcManager &&) = delete;
   GcManager() = delete;
   GcManager(F2fs *fs) : fs_(fs), cur_victim_sec_(kNullSecNo) {}
+  ~GcManager() { StopGcThread(); }
 
   zx::status<uint32_t> F2fsGc() __TA_EXCLUDES(gc_mutex_);
 
+  // It moves the valid blocks of one victim section chosen by the cost-benefit policy. The blocks
+  // are only marked dirty, so they are written by the next writeback or checkpoint, and the section
+  // is remembered for foreground GC to finish first. It returns ZX_ERR_UNAVAILABLE if there is no
+  // victim.
+  zx::status<> F2fsBgGc() __TA_EXCLUDES(gc_mutex_);
+
+  // It starts a thread which runs GC while the device is idle. The thread sleeps for between
+  // |kGcThreadMinSleepTime| and |kGcThreadMaxSleepTime| and backs off whenever there was I/O in the
+  // meantime, or when there isn't enough to collect.
+  void StartGcThread() __TA_EXCLUDES(gc_thread_mutex_);
+  // It stops the thread started by StartGcThread() and waits for it to exit.
+  void StopGcThread() __TA_EXCLUDES(gc_thread_mutex_);
+  bool IsGcThreadRunning() __TA_EXCLUDES(gc_thread_mutex_) {
+    std::lock_guard lock(gc_thread_mutex_);
+    return gc_thread_.joinable();
+  }
+
+  // The number of sections background GC has moved.
+  uint64_t GetBgGcCount() const { return bg_gc_count_.load(std::memory_order_relaxed); }
+
   // For testing
   void DisableFgGc() { disable_gc_for_test_ = true; }
   void EnableFgGc() { disable_gc_for_test_ = false; }
@@ -40,10 +65,30 @@ class GcManager {
   zx_status_t GcDataSegment(const SummaryBlock &sum_blk, unsigned int segno, GcType gc_type)
       __TA_REQUIRES(gc_mutex_);
 
+  // Background GC is worth its writes only when a large part of the user blocks is invalid while
+  // free space is getting short.
+  bool HasEnoughInvalidBlocks();
+  void GcThreadMain() __TA_EXCLUDES(gc_thread_mutex_);
+
+  static constexpr std::chrono::seconds kGcThreadMinSleepTime{30};
+  static constexpr std::chrono::seconds kGcThreadMaxSleepTime{60};
+  static constexpr std::chrono::seconds kGcThreadSleepTimeStep{10};
+  // How long to sleep when there was no victim.
+  static constexpr std::chrono::seconds kGcThreadNoGcSleepTime{300};
+  // The percentages of user blocks which are invalid and free for HasEnoughInvalidBlocks().
+  static constexpr uint64_t kLimitInvalidBlocks = 40;
+  static constexpr uint64_t kLimitFreeBlocks = 40;
+
   F2fs *fs_ = nullptr;
   std::mutex gc_mutex_;      // mutex for GC
   uint32_t cur_victim_sec_;  // current victim section num
 
+  std::mutex gc_thread_mutex_;
+  std::condition_variable gc_thread_cvar_;
+  std::thread gc_thread_;
+  bool stop_gc_thread_ __TA_GUARDED(gc_thread_mutex_) = false;
+  std::atomic<uint64_t> bg_gc_count_ = 0;
+
   // For testing
   bool disable_gc_for_test_ = false;
 };
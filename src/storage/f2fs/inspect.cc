@@ -101,7 +101,51 @@ fs_inspect::NodeCallbacks InspectTree::CreateCallbacks() {
             UpdateVolumeSizeInfo();
             return volume_;
           },
+      .detail_node_callback = [this] { return CreateDetailNode(); },
   };
 }
 
+fpromise::promise<inspect::Inspector> InspectTree::CreateDetailNode() const {
+  inspect::Inspector inspector;
+  if (!fs_->IsValid()) {
+    return fpromise::make_ok_promise(std::move(inspector));
+  }
+
+  inspect::Node gc = inspector.GetRoot().CreateChild("gc");
+  gc.CreateBool("background_gc_running", fs_->GetGcManager().IsGcThreadRunning(), &inspector);
+  gc.CreateUint("background_gc_sections", fs_->GetGcManager().GetBgGcCount(), &inspector);
+  inspector.emplace(std::move(gc));
+
+  SegmentManager &segment_manager = fs_->GetSegmentManager();
+  inspect::Node segments = inspector.GetRoot().CreateChild("segments");
+  segments.CreateUint("dirty", segment_manager.DirtySegments(), &inspector);
+  segments.CreateUint("free", segment_manager.FreeSegments(), &inspector);
+  inspect::LinearUintHistogram utilization =
+      segments.CreateLinearUintHistogram("utilization", 0, kUtilizationStep, kUtilizationBuckets);
+  {
+    const uint64_t blocks_per_segment = fs_->GetSuperblockInfo().GetBlocksPerSeg();
+    fs::SharedLock sentry_lock(segment_manager.GetSitInfo().sentry_lock);
+    for (uint32_t segno = 0; segno < segment_manager.TotalSegs(); ++segno) {
+      // Free segments are already counted above.
+      if (uint64_t valid_blocks = segment_manager.GetSegmentEntry(segno).valid_blocks;
+          valid_blocks > 0) {
+        utilization.Insert(valid_blocks * 100 / blocks_per_segment);
+      }
+    }
+  }
+  inspector.emplace(std::move(utilization));
+  inspector.emplace(std::move(segments));
+
+  DirEntryCache &dir_entry_cache = fs_->GetDirEntryCache();
+  inspect::Node dentry_cache = inspector.GetRoot().CreateChild("dir_entry_cache");
+  dentry_cache.CreateUint("capacity", dir_entry_cache.GetMaxElements(), &inspector);
+  dentry_cache.CreateUint("size", dir_entry_cache.GetSize(), &inspector);
+  dentry_cache.CreateUint("hits", dir_entry_cache.GetHitCount(), &inspector);
+  dentry_cache.CreateUint("negative_hits", dir_entry_cache.GetNegativeHitCount(), &inspector);
+  dentry_cache.CreateUint("misses", dir_entry_cache.GetMissCount(), &inspector);
+  inspector.emplace(std::move(dentry_cache));
+
+  return fpromise::make_ok_promise(std::move(inspector));
+}
+
 }  // namespace f2fs
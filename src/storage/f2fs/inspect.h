@@ -18,6 +18,14 @@ class InspectTree final {
  private:
   fs_inspect::NodeCallbacks CreateCallbacks();
 
+  // Creates fs.detail, which has the state of GC, a histogram of the utilization of the segments
+  // in use, and the statistics of DirEntryCache.
+  fpromise::promise<inspect::Inspector> CreateDetailNode() const;
+
+  // Utilization is bucketed in steps of 10%. The last bucket has the segments which are full.
+  static constexpr uint64_t kUtilizationStep = 10;
+  static constexpr size_t kUtilizationBuckets = 11;
+
   F2fs *fs_ = nullptr;
 
   mutable std::mutex info_mutex_{};
@@ -16,7 +16,7 @@ namespace f2fs {
 
 // TODO: set .configurable to true when the feature is supported.
 const MountOpt default_option[] = {
-    {"background_gc_off", 1, false},
+    {"background_gc_off", 1, true},
     {"disable_roll_forward", 0, true},
     {"discard", 1, true},
     {"no_heap", 1, false},
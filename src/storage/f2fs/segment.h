@@ -403,6 +403,15 @@ class SegmentManager {
 
   uint32_t GetGreedyCost(uint32_t segno);
 
+  // The cost-benefit cost of a section. It favours sections with few valid blocks that haven't been
+  // modified for a long time, as the blocks left in old sections are likely to stay valid.
+  uint32_t GetCbCost(uint32_t segno);
+
+  // It returns the first segment of a section that background GC has chosen before, so that
+  // foreground GC finishes the sections whose blocks are already being moved. If there is no such
+  // section, it returns kNullSegNo.
+  uint32_t CheckBgVictims();
+
  private:
   F2fs *fs_ = nullptr;
   SuperblockInfo *superblock_info_ = nullptr;
@@ -11,8 +11,8 @@ namespace f2fs {
 void F2fs::PutSuper() {
 #if 0  // porting needed
   // DestroyStats(superblock_info_.get());
-  // StopGcThread(superblock_info_.get());
 #endif
+  gc_manager_->StopGcThread();
 
   WriteCheckpoint(false, true);
   if (superblock_info_->TestCpFlags(CpFlag::kCpErrorFlag)) {
@@ -315,6 +315,9 @@ void F2fs::InitSuperblockInfo() {
 }
 
 void F2fs::Reset() {
+  if (gc_manager_) {
+    gc_manager_->StopGcThread();
+  }
   if (root_vnode_) {
     root_vnode_.reset();
   }
@@ -412,10 +415,11 @@ zx_status_t F2fs::FillSuper() {
   }
 
   // After POR, we can run background GC thread
-  // TODO: Enable wb thread first, and then impl gc thread
-  // err = StartGcThread(superblock_info);
-  // if (err)
-  //   goto fail;
+#ifdef __Fuchsia__
+  if (!superblock_info_->TestOpt(kMountBgGcOff)) {
+    gc_manager_->StartGcThread();
+  }
+#endif  // __Fuchsia__
   reset.cancel();
   return err;
 }
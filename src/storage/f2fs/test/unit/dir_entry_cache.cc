@@ -99,9 +99,40 @@ TEST_F(DirEntryCacheTest, SubDirectory) {
   ASSERT_EQ(child_dir->Close(), ZX_OK);
 }
 
+TEST_F(DirEntryCacheTest, NegativeEntry) {
+  DirEntryCache &cache = fs_->GetDirEntryCache();
+  fbl::RefPtr<fs::Vnode> tmp;
+
+  // A failed lookup leaves a negative element, and the next one is served from it.
+  ASSERT_EQ(root_dir_->Lookup("alpha", &tmp), ZX_ERR_NOT_FOUND);
+  ASSERT_TRUE(cache.IsNegativeElementInCache(root_dir_->Ino(), "alpha"));
+  ASSERT_FALSE(cache.IsElementInCache(root_dir_->Ino(), "alpha"));
+  uint64_t negative_hits = cache.GetNegativeHitCount();
+  ASSERT_EQ(root_dir_->Lookup("alpha", &tmp), ZX_ERR_NOT_FOUND);
+  ASSERT_EQ(cache.GetNegativeHitCount(), negative_hits + 1);
+
+  // Creating "alpha" turns it into a positive element.
+  FileTester::CreateChild(root_dir_.get(), S_IFDIR, "alpha");
+  ASSERT_FALSE(cache.IsNegativeElementInCache(root_dir_->Ino(), "alpha"));
+  ASSERT_TRUE(cache.IsElementInCache(root_dir_->Ino(), "alpha"));
+  uint64_t hits = cache.GetHitCount();
+  FileTester::Lookup(root_dir_.get(), "alpha", &tmp);
+  ASSERT_EQ(tmp->Close(), ZX_OK);
+  ASSERT_EQ(cache.GetHitCount(), hits + 1);
+
+  // Renaming "alpha" to a name with a negative element makes the new name visible.
+  ASSERT_EQ(root_dir_->Lookup("bravo", &tmp), ZX_ERR_NOT_FOUND);
+  ASSERT_TRUE(cache.IsNegativeElementInCache(root_dir_->Ino(), "bravo"));
+  ASSERT_EQ(root_dir_->Rename(root_dir_, "alpha", "bravo", true, true), ZX_OK);
+  ASSERT_TRUE(cache.IsElementInCache(root_dir_->Ino(), "bravo"));
+  FileTester::Lookup(root_dir_.get(), "bravo", &tmp);
+  ASSERT_EQ(tmp->Close(), ZX_OK);
+  ASSERT_EQ(root_dir_->Lookup("alpha", &tmp), ZX_ERR_NOT_FOUND);
+}
+
 TEST_F(DirEntryCacheTest, LRUEviction) {
   const uint32_t max_element =
-      kDirEntryCacheSlabSize * kDirEntryCacheSlabCount / sizeof(DirEntryCacheElement);
+      safemath::checked_cast<uint32_t>(fs_->GetDirEntryCache().GetMaxElements());
 
   std::unordered_set<std::string> child_set = {};
 
@@ -136,6 +136,36 @@ TEST_F(FileCacheTest, EvictActivePages) {
   vn = nullptr;
 }
 
+TEST_F(FileCacheTest, SyncSubmitWaitsForEveryPageType) {
+  fbl::RefPtr<fs::Vnode> test_file;
+  root_dir_->Create("test", S_IFREG, &test_file);
+  fbl::RefPtr<f2fs::File> vn = fbl::RefPtr<f2fs::File>::Downcast(std::move(test_file));
+  char buf[kPageSize];
+
+  FileTester::AppendToFile(vn.get(), buf, kPageSize);
+  // Keep the data Page in Writer.
+  WritebackOperation op;
+  vn->Writeback(op);
+  {
+    LockedPage page;
+    vn->GrabCachePage(0, &page);
+    ASSERT_TRUE(page->IsWriteback());
+  }
+
+  // Waiting for the node Pages to be written also waits for the data Pages submitted before them.
+  sync_completion_t completion;
+  fs_->ScheduleWriterSubmitPages(&completion, PageType::kNode);
+  ASSERT_EQ(sync_completion_wait(&completion, ZX_TIME_INFINITE), ZX_OK);
+  {
+    LockedPage page;
+    vn->GrabCachePage(0, &page);
+    ASSERT_FALSE(page->IsWriteback());
+  }
+
+  vn->Close();
+  vn = nullptr;
+}
+
 TEST_F(FileCacheTest, WritebackOperation) {
   fbl::RefPtr<fs::Vnode> test_file;
   root_dir_->Create("test", S_IFREG, &test_file);
@@ -133,6 +133,48 @@ TEST_F(GcManagerTest, PageColdData) {
   file->Close();
 }
 
+TEST_F(GcManagerTest, BackgroundGc) {
+  // Fill two segments with files, and invalidate every other one of them.
+  std::vector<std::string> file_names;
+  for (uint32_t i = 0; i < 2 * fs_->GetSuperblockInfo().GetBlocksPerSeg(); ++i) {
+    std::string file_name = std::to_string(i);
+    fbl::RefPtr<fs::Vnode> test_file;
+    ASSERT_EQ(root_dir_->Create(file_name, S_IFREG, &test_file), ZX_OK);
+    auto file_vn = fbl::RefPtr<File>::Downcast(std::move(test_file));
+    std::array<char, kPageSize> buf = {};
+    FileTester::AppendToFile(file_vn.get(), buf.data(), buf.size());
+    ASSERT_EQ(file_vn->Close(), ZX_OK);
+    file_names.push_back(file_name);
+  }
+  WritebackOperation op = {.bSync = true};
+  fs_->SyncDirtyDataPages(op);
+  fs_->WriteCheckpoint(false, false);
+  for (size_t i = 0; i < file_names.size(); i += 2) {
+    ASSERT_EQ(root_dir_->Unlink(file_names[i], false), ZX_OK);
+  }
+  fs_->SyncDirtyDataPages(op);
+  fs_->WriteCheckpoint(false, false);
+  ASSERT_FALSE(fs_->GetSegmentManager().HasNotEnoughFreeSecs());
+
+  // The cost-benefit policy only picks sections older than the newest one, and all of them were
+  // written just now.
+  fs_->GetSegmentManager().GetSitInfo().max_mtime += 100;
+
+  ASSERT_TRUE(fs_->GetGcManager().F2fsBgGc().is_ok());
+  ASSERT_EQ(fs_->GetGcManager().GetBgGcCount(), 1UL);
+
+  // The victim is left for foreground GC to pick first.
+  const uint32_t victim_seg = fs_->GetSegmentManager().CheckBgVictims();
+  ASSERT_NE(victim_seg, kNullSegNo);
+  const block_t segs_per_sec = fs_->GetSuperblockInfo().GetSegsPerSec();
+  ASSERT_NE(fs_->GetSegmentManager().GetValidBlocks(victim_seg, segs_per_sec), 0U);
+
+  // Its valid blocks move once they are written.
+  fs_->SyncDirtyDataPages(op);
+  fs_->WriteCheckpoint(false, false);
+  ASSERT_EQ(fs_->GetSegmentManager().GetValidBlocks(victim_seg, segs_per_sec), 0U);
+}
+
 class GcManagerTestWithLargeSec
     : public GcManagerTest,
       public testing::WithParamInterface<std::pair<uint64_t, uint32_t>> {
@@ -276,6 +276,60 @@ TEST_F(MmapTest, VmoRead) {
   test_vnode.reset();
 }
 
+TEST_F(MmapTest, VmoReadFromDisk) {
+  srand(testing::UnitTest::GetInstance()->random_seed());
+
+  fbl::RefPtr<fs::Vnode> test_fs_vnode;
+  std::string file_name("mmap_vmoread_from_disk_test");
+  ASSERT_EQ(root_dir_->Create(file_name, S_IFREG, &test_fs_vnode), ZX_OK);
+  fbl::RefPtr<VnodeF2fs> test_vnode = fbl::RefPtr<VnodeF2fs>::Downcast(std::move(test_fs_vnode));
+  File *test_file_ptr = static_cast<File *>(test_vnode.get());
+
+  uint8_t write_buf[PAGE_SIZE * 2];
+  for (uint8_t &character : write_buf) {
+    character = static_cast<uint8_t>(rand());
+  }
+
+  FileTester::AppendToFile(test_file_ptr, write_buf, sizeof(write_buf));
+
+  // Write out and evict the data Pages.
+  WritebackOperation op;
+  test_file_ptr->Writeback(op);
+  fs_->SyncFs();
+  test_file_ptr->Writeback(op);
+
+  zx::vmo vmo;
+  uint8_t read_buf[PAGE_SIZE * 2];
+  ASSERT_EQ(test_vnode->GetVmo(fuchsia_io::wire::VmoFlags::kRead, &vmo), ZX_OK);
+  test_vnode->VmoRead(0, sizeof(read_buf));
+  vmo.read(read_buf, 0, sizeof(read_buf));
+  ASSERT_EQ(memcmp(read_buf, write_buf, sizeof(write_buf)), 0);
+
+  // The data was supplied from disk without filling the Pages.
+  for (pgoff_t index = 0; index < 2; ++index) {
+    LockedPage page;
+    ASSERT_EQ(test_vnode->GrabCachePage(index, &page), ZX_OK);
+    ASSERT_TRUE(page->IsMmapped());
+    ASSERT_FALSE(page->IsUptodate());
+  }
+
+  // A later write still goes through to the pager-backed VMO.
+  for (uint8_t &character : write_buf) {
+    character = static_cast<uint8_t>(rand());
+  }
+  size_t out_actual;
+  ASSERT_EQ(test_file_ptr->Write(write_buf, PAGE_SIZE, 0, &out_actual), ZX_OK);
+  ASSERT_EQ(out_actual, static_cast<size_t>(PAGE_SIZE));
+  vmo.read(read_buf, 0, PAGE_SIZE);
+  ASSERT_EQ(memcmp(read_buf, write_buf, PAGE_SIZE), 0);
+
+  vmo.reset();
+  loop_.RunUntilIdle();
+
+  test_vnode->Close();
+  test_vnode.reset();
+}
+
 TEST_F(MmapTest, VmoReadException) {
   srand(testing::UnitTest::GetInstance()->random_seed());
 
@@ -254,11 +254,30 @@ TEST(MountTest, EnableDiscardOptions) {
   FileTester::Unmount(std::move(fs), &bc);
 }
 
+TEST(MountTest, BackgroundGcOptions) {
+  std::unique_ptr<f2fs::Bcache> bc;
+  FileTester::MkfsOnFakeDev(&bc);
+
+  std::unique_ptr<F2fs> fs;
+  async::Loop loop(&kAsyncLoopConfigAttachToCurrentThread);
+
+  // Background GC is off by default.
+  MountOptions options{};
+  FileTester::MountWithOptions(loop.dispatcher(), options, &bc, &fs);
+  ASSERT_FALSE(fs->GetGcManager().IsGcThreadRunning());
+  FileTester::Unmount(std::move(fs), &bc);
+
+  ASSERT_EQ(options.SetValue(options.GetNameView(kOptBgGcOff), 0), ZX_OK);
+  FileTester::MountWithOptions(loop.dispatcher(), options, &bc, &fs);
+  ASSERT_FALSE(fs->GetSuperblockInfo().TestOpt(kMountBgGcOff));
+  ASSERT_TRUE(fs->GetGcManager().IsGcThreadRunning());
+  FileTester::Unmount(std::move(fs), &bc);
+}
+
 TEST(MountTest, InvalidOptions) {
   MountOptions options{};
   ASSERT_EQ(options.SetValue(options.GetNameView(kOptActiveLogs), kMaxActiveLogs),
             ZX_ERR_INVALID_ARGS);
-  ASSERT_EQ(options.SetValue(options.GetNameView(kOptBgGcOff), 1), ZX_ERR_INVALID_ARGS);
   ASSERT_EQ(options.SetValue(options.GetNameView(kOptNoHeap), 1), ZX_ERR_INVALID_ARGS);
 }
 
@@ -204,24 +204,33 @@ zx::status<zx::vmo> VnodeF2fs::PopulateAndGetMmappedVmo(const size_t offset, con
     return zx::ok(std::move(vmo));
   }
 
-  pgoff_t block_index = safemath::CheckDiv<pgoff_t>(offset, kBlockSize).ValueOrDie();
-  for (size_t copied_bytes = 0; copied_bytes < length; copied_bytes += kBlockSize, ++block_index) {
+  // Uptodate Pages are copied to |vmo| as they can be newer than disk. The others are read from
+  // disk straight into |vmo| without filling the Pages, so that their data is kept only in the
+  // pager-backed vmo. Every Page in the range gets the mmapped flag to keep the pager-backed vmo
+  // synchronized with later writes, and it stays locked until |vmo| is filled.
+  const pgoff_t block_index = safemath::CheckDiv<pgoff_t>(offset, kBlockSize).ValueOrDie();
+  const size_t num_blocks = safemath::CheckDiv<size_t>(length, kBlockSize).ValueOrDie();
+  std::vector<LockedPage> data_pages;
+  std::vector<block_t> addrs(num_blocks, kNullAddr);
+  data_pages.reserve(num_blocks);
+  for (size_t i = 0; i < num_blocks; ++i) {
     LockedPage data_page;
-    if (zx_status_t status = GetLockedDataPage(block_index, &data_page); status != ZX_OK) {
-      // If |data_page| is not a valid Page, just grab one.
-      if (status = GrabCachePage(block_index, &data_page); status != ZX_OK) {
-        return zx::error(status);
-      }
-      // Just set a mmapped flag for an invalid page.
-      ZX_DEBUG_ASSERT(!data_page->IsUptodate());
-      data_page->SetMmapped();
-    } else {
-      data_page->SetMmapped();
-      // If it is a valid Page, fill |vmo| with |data_page|.
-      if (data_page->IsUptodate()) {
-        vmo.write(data_page->GetAddress(), copied_bytes, kBlockSize);
-      }
+    if (zx_status_t status = GrabCachePage(block_index + i, &data_page); status != ZX_OK) {
+      return zx::error(status);
+    }
+    if (data_page->IsUptodate()) {
+      vmo.write(data_page->GetAddress(), i * kBlockSize, kBlockSize);
+    } else if (auto addr_or = FindDataBlkAddr(block_index + i); addr_or.is_ok()) {
+      addrs[i] = addr_or.value();
+    } else if (addr_or.status_value() != ZX_ERR_NOT_FOUND) {
+      return addr_or.take_error();
     }
+    data_page->SetMmapped();
+    data_pages.push_back(std::move(data_page));
+  }
+
+  if (zx_status_t status = fs()->MakeReadOperations(vmo, addrs, PageType::kData); status != ZX_OK) {
+    return zx::error(status);
   }
   return zx::ok(std::move(vmo));
 }
@@ -6,8 +6,16 @@
 
 namespace f2fs {
 
+Writer::WriteQueue::WriteQueue(Bcache *bc, size_t capacity, PageType type)
+    : type(type),
+      write_buffer(std::make_unique<StorageBuffer>(bc, capacity, kBlockSize, "WriteBuffer")) {}
+
 Writer::Writer(Bcache *bc, size_t capacity) : transaction_handler_(bc) {
-  write_buffer_ = std::make_unique<StorageBuffer>(bc, capacity, kBlockSize, "WriteBuffer");
+  // Each queue has to be able to hold more Pages than EnqueuePage() merges before submitting them.
+  const size_t queue_capacity = std::max(capacity / kNumQueues, size_t{kDefaultBlocksPerSegment});
+  for (size_t i = 0; i < kNumQueues; ++i) {
+    queues_[i] = std::make_unique<WriteQueue>(bc, queue_capacity, static_cast<PageType>(i));
+  }
 }
 
 Writer::~Writer() {
@@ -15,14 +23,17 @@ Writer::~Writer() {
   ScheduleSubmitPages(&completion);
   ZX_ASSERT(sync_completion_wait(&completion, ZX_TIME_INFINITE) == ZX_OK);
 #ifdef __Fuchsia__
-  executor_.Terminate();
+  for (auto &queue : queues_) {
+    queue->executor.Terminate();
+  }
   writeback_executor_.Terminate();
 #endif
 }
 
 zx::status<> Writer::EnqueuePage(LockedPage &page, block_t blk_addr, PageType type) {
   ZX_DEBUG_ASSERT(type < PageType::kNrPageType);
-  auto ret = write_buffer_->ReserveWriteOperation(page.release(), blk_addr);
+  auto ret = queues_[static_cast<size_t>(type)]->write_buffer->ReserveWriteOperation(
+      page.release(), blk_addr);
   if (ret.is_error()) {
 #ifdef __Fuchsia__
     ZX_ASSERT_MSG(false, "Writer failed to reserve buffers. %s", ret.status_string());
@@ -35,50 +46,45 @@ zx::status<> Writer::EnqueuePage(LockedPage &page, block_t blk_addr, PageType ty
   return zx::ok();
 }
 
-fpromise::promise<> Writer::SubmitPages(sync_completion_t *completion, PageType type) {
+fpromise::promise<> Writer::SubmitPages(WriteQueue &queue, PageType requested_type) {
   // We don't need to release vmo buffers of |operations| in the same order they are reserved in
   // StorageBuffer.
-  auto operations = write_buffer_->TakeWriteOperations();
-  if (!completion && operations.IsEmpty()) {
+  auto operations = queue.write_buffer->TakeWriteOperations();
+  if (operations.IsEmpty()) {
     return fpromise::make_ok_promise();
   }
 
-  return fpromise::make_promise(
-      [this, completion, operations = std::move(operations), type]() mutable {
-        zx_status_t ret = ZX_OK;
-        if (!operations.IsEmpty()) {
-          if (ret = transaction_handler_->RunRequests(operations.TakeOperations()); ret != ZX_OK) {
-            FX_LOGS(WARNING) << "[f2fs] Write IO error. " << ret;
-          }
-          operations.Completion(ret, [ret, type](fbl::RefPtr<Page> page) {
-            if (ret != ZX_OK && page->IsUptodate()) {
-              if (type == PageType::kMeta || type == PageType::kNrPageType ||
-                  ret == ZX_ERR_UNAVAILABLE) {
-                // When it fails to write metadata or the block device is not available,
-                // set kCpErrorFlag to enter read-only mode.
-                page->GetVnode().fs()->GetSuperblockInfo().SetCpFlags(CpFlag::kCpErrorFlag);
-              } else {
-                // When IO errors occur with node and data Pages, just set a dirty flag
-                // to retry it with another LBA.
-                LockedPage locked_page(page);
-                locked_page->SetDirty();
-              }
-            }
-            page->ClearColdData();
-            page->ClearWriteback();
-            return ret;
-          });
-        }
-        if (completion) {
-          sync_completion_signal(completion);
+  return fpromise::make_promise([this, operations = std::move(operations), type = queue.type,
+                                 requested_type]() mutable {
+    zx_status_t ret = ZX_OK;
+    if (ret = transaction_handler_->RunRequests(operations.TakeOperations()); ret != ZX_OK) {
+      FX_LOGS(WARNING) << "[f2fs] Write IO error. " << ret;
+    }
+    operations.Completion(ret, [ret, type, requested_type](fbl::RefPtr<Page> page) {
+      if (ret != ZX_OK && page->IsUptodate()) {
+        if (type == PageType::kMeta || requested_type == PageType::kNrPageType ||
+            ret == ZX_ERR_UNAVAILABLE) {
+          // When it fails to write metadata or the block device is not available,
+          // set kCpErrorFlag to enter read-only mode.
+          page->GetVnode().fs()->GetSuperblockInfo().SetCpFlags(CpFlag::kCpErrorFlag);
+        } else {
+          // When IO errors occur with node and data Pages, just set a dirty flag
+          // to retry it with another LBA.
+          LockedPage locked_page(page);
+          locked_page->SetDirty();
         }
-        return fpromise::ok();
-      });
+      }
+      page->ClearColdData();
+      page->ClearWriteback();
+      return ret;
+    });
+    return fpromise::ok();
+  });
 }
 
-void Writer::ScheduleTask(fpromise::promise<> task) {
+void Writer::ScheduleTask(WriteQueue &queue, fpromise::promise<> task) {
 #ifdef __Fuchsia__
-  executor_.schedule_task(sequencer_.wrap(std::move(task)));
+  queue.executor.schedule_task(queue.sequencer.wrap(std::move(task)));
 #else   // __Fuchsia__
   [[maybe_unused]] auto result = fpromise::run_single_threaded(std::move(task));
   assert(result.is_ok());
@@ -94,11 +100,37 @@ void Writer::ScheduleWriteback(fpromise::promise<> task) {
 }
 
 void Writer::ScheduleSubmitPages(sync_completion_t *completion, PageType type) {
-  auto task = SubmitPages(completion, type);
-  ScheduleTask(std::move(task));
+  if (!completion) {
+    for (auto &queue : queues_) {
+      if (type == PageType::kNrPageType || queue->type == type) {
+        ScheduleTask(*queue, SubmitPages(*queue, type));
+      }
+    }
+    return;
+  }
+
+  // Callers wait for |completion| before writes that depend on everything written so far, such as
+  // a checkpoint. Every queue gets a task which runs after its earlier ones, and the last of them
+  // to finish signals |completion|.
+  auto remaining = std::make_shared<std::atomic<size_t>>(kNumQueues);
+  for (auto &queue : queues_) {
+    fpromise::promise<> task = fpromise::make_ok_promise();
+    if (type == PageType::kNrPageType || queue->type == type) {
+      task = SubmitPages(*queue, type);
+    }
+    ScheduleTask(*queue, std::move(task).then([completion, remaining](fpromise::result<> &) {
+      if (remaining->fetch_sub(1) == 1) {
+        sync_completion_signal(completion);
+      }
+      return fpromise::ok();
+    }));
+  }
 }
 
 Reader::Reader(Bcache *bc, size_t capacity) : transaction_handler_(bc) {
+#ifdef __Fuchsia__
+  bc_ = bc;
+#endif  // __Fuchsia__
   buffer_ = std::make_unique<StorageBuffer>(bc, capacity, kBlockSize, "ReadBuffer");
 }
 
@@ -129,4 +161,46 @@ zx::status<std::vector<LockedPage>> Reader::SubmitPages(std::vector<LockedPage>
   return zx::ok(std::move(pages));
 }
 
+#ifdef __Fuchsia__
+zx_status_t Reader::ReadBlocks(zx::vmo &vmo, const std::vector<block_t> &addrs) {
+  storage::OwnedVmoid vmoid(bc_);
+  std::vector<storage::BufferedOperation> operations;
+  for (size_t i = 0; i < addrs.size(); ++i) {
+    if (addrs[i] == kNullAddr || addrs[i] == kNewAddr) {
+      continue;
+    }
+    if (addrs[i] >= bc_->Maxblk()) {
+      return ZX_ERR_OUT_OF_RANGE;
+    }
+    if (!operations.empty()) {
+      storage::Operation &last = operations.back().op;
+      if (last.vmo_offset + last.length == i && last.dev_offset + last.length == addrs[i]) {
+        ++last.length;
+        continue;
+      }
+    }
+    if (!vmoid.IsAttached()) {
+      if (zx_status_t status = vmoid.AttachVmo(vmo); status != ZX_OK) {
+        return status;
+      }
+    }
+    operations.push_back({.vmoid = vmoid.get(),
+                          .op = {
+                              .type = storage::OperationType::kRead,
+                              .vmo_offset = i,
+                              .dev_offset = addrs[i],
+                              .length = 1,
+                          }});
+  }
+  if (operations.empty()) {
+    return ZX_OK;
+  }
+  if (zx_status_t ret = transaction_handler_->RunRequests(operations); ret != ZX_OK) {
+    FX_LOGS(WARNING) << "[f2fs] Read IO error. " << ret;
+    return ret;
+  }
+  return ZX_OK;
+}
+#endif  // __Fuchsia__
+
 }  // namespace f2fs
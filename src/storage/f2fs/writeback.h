@@ -5,6 +5,8 @@
 #ifndef SRC_STORAGE_F2FS_WRITEBACK_H_
 #define SRC_STORAGE_F2FS_WRITEBACK_H_
 
+#include <array>
+
 #ifdef __Fuchsia__
 #include "src/lib/storage/vfs/cpp/journal/background_executor.h"
 #else  // __Fuchsia__
@@ -23,6 +25,10 @@ constexpr int kMaxDirtyDataPages = 51200;
 // This class is final because there might be background threads running when its destructor runs
 // and that would be unsafe if this class had overridden virtual methods that might get called from
 // those background threads.
+//
+// Pages of each PageType are merged in, and submitted from, a queue of their own. It keeps the
+// sequential writes to each log from being broken up by the writes to the others, and lets the
+// queues run their I/Os in parallel.
 class Writer final {
  public:
   Writer(Bcache *bc, size_t capacity);
@@ -33,26 +39,40 @@ class Writer final {
   Writer &operator=(const Writer &&) = delete;
   ~Writer();
 
-  void ScheduleTask(fpromise::promise<> task);
   void ScheduleWriteback(fpromise::promise<> task);
-  // It schedules SubmitPages().
-  // If |completion| is set, it notifies the caller of the operation completion.
+  // It schedules SubmitPages() for the queue of |type|, or for every queue if |type| is
+  // kNrPageType.
+  // If |completion| is set, it notifies the caller once the Pages of every type that were submitted
+  // before are written, not just those of |type|.
   void ScheduleSubmitPages(sync_completion_t *completion = nullptr,
                            PageType type = PageType::kNrPageType);
   // It merges Pages to be written.
   zx::status<> EnqueuePage(LockedPage &page, block_t blk_addr, PageType type);
 
  private:
-  // It takes write operations from |writer_buffer_| and passes them to RunReqeusts()
+  static constexpr size_t kNumQueues = static_cast<size_t>(PageType::kNrPageType);
+
+  struct WriteQueue {
+    WriteQueue(Bcache *bc, size_t capacity, PageType type);
+
+    const PageType type;
+    std::unique_ptr<StorageBuffer> write_buffer;
+#ifdef __Fuchsia__
+    fpromise::sequencer sequencer;
+    fs::BackgroundExecutor executor;
+#endif  // __Fuchsia__
+  };
+
+  // It takes write operations from |queue|.write_buffer and passes them to RunReqeusts()
   // asynchronously. When the operations are complete, it wakes waiters on the completion of
-  // the Page writes.
-  fpromise::promise<> SubmitPages(sync_completion_t *completion, PageType type);
+  // the Page writes. |requested_type| is the type that the caller asked to submit.
+  fpromise::promise<> SubmitPages(WriteQueue &queue, PageType requested_type);
+  // Tasks scheduled on the same queue run in order.
+  void ScheduleTask(WriteQueue &queue, fpromise::promise<> task);
 
-  std::unique_ptr<StorageBuffer> write_buffer_;
   fs::TransactionHandler *transaction_handler_ = nullptr;
+  std::array<std::unique_ptr<WriteQueue>, kNumQueues> queues_;
 #ifdef __Fuchsia__
-  fpromise::sequencer sequencer_;
-  fs::BackgroundExecutor executor_;
   fs::BackgroundExecutor writeback_executor_;
 #endif  // __Fuchsia__
 };
@@ -70,8 +90,17 @@ class Reader {
   // synchronously.
   zx::status<std::vector<LockedPage>> SubmitPages(std::vector<LockedPage> pages,
                                                   std::vector<block_t> addrs);
+#ifdef __Fuchsia__
+  // It reads the blocks of |addrs| straight into |vmo| with the i-th block at the i-th page of
+  // |vmo|. Contiguous blocks are coalesced into one request. It leaves the pages for kNullAddr and
+  // kNewAddr untouched, so |vmo| is expected to be zero-filled.
+  zx_status_t ReadBlocks(zx::vmo &vmo, const std::vector<block_t> &addrs);
+#endif  // __Fuchsia__
 
  private:
+#ifdef __Fuchsia__
+  Bcache *bc_ = nullptr;
+#endif  // __Fuchsia__
   fs::TransactionHandler *transaction_handler_ = nullptr;
   std::unique_ptr<StorageBuffer> buffer_;
 };
@@ -38,6 +38,7 @@
 #include <zircon/types.h>
 
 #include <cctype>
+#include <iomanip>
 #include <memory>
 #include <utility>
 
@@ -589,8 +590,8 @@ zx_status_t BlockDevice::CheckFilesystem() {
   auto timer = fit::defer([before]() {
     auto after = zx::ticks::now();
     auto duration = fzl::TicksToNs(after - before);
-    FX_LOGS(INFO) << "fsck took " << duration.to_secs() << "." << duration.to_msecs() % 1000
-                  << " seconds";
+    FX_LOGS(INFO) << "fsck took " << duration.to_secs() << "." << std::setfill('0')
+                  << std::setw(3) << duration.to_msecs() % 1000 << " seconds";
   });
   FX_LOGS(INFO) << "fsck of " << DiskFormatString(format_) << " partition started";
 
@@ -709,6 +710,19 @@ zx_status_t BlockDevice::MountFilesystem() {
     zx::unowned_channel channel(disk_connection.borrow_channel());
     block_device.reset(fdio_service_clone(channel->get()));
   }
+
+  // Mount latency is on the boot path, so record it in the log alongside the fsck time, and in the
+  // mount timeline in inspect.
+  zx::ticks before = zx::ticks::now();
+  auto timer = fit::defer([this, before]() {
+    auto after = zx::ticks::now();
+    mounter_->inspect_manager().LogMountTime(format_, before, after);
+    auto duration = fzl::TicksToNs(after - before);
+    FX_LOGS(INFO) << "mounting " << DiskFormatString(format_) << " took " << duration.to_secs()
+                  << "." << std::setfill('0') << std::setw(3) << duration.to_msecs() % 1000
+                  << " seconds";
+  });
+
   switch (format_) {
     case fs_management::kDiskFormatFactoryfs: {
       FX_LOGS(INFO) << "BlockDevice::MountFilesystem(factoryfs)";
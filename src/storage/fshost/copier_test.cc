@@ -87,6 +87,26 @@ TEST_F(CopierTest, Copy) {
   EXPECT_EQ(GetFileContents(dst_path("dir/file2")), "hello2");
 }
 
+TEST_F(CopierTest, CopyFileWithZeroBlocks) {
+  // Zero blocks at the start, in the middle and at the end, around blocks with data.
+  std::string contents(64 * 1024, '\0');
+  contents.replace(20000, 5, "hello");
+  contents.replace(40000, 20000, std::string(20000, 'x'));
+  contents.back() = '\0';
+  ASSERT_TRUE(WriteFileContents(src_path("sparse"), contents));
+
+  fbl::unique_fd fd(open(src_dir().c_str(), O_RDONLY));
+  ASSERT_TRUE(fd);
+  auto data_or = Copier::Read(std::move(fd));
+  ASSERT_TRUE(data_or.is_ok()) << data_or.status_string();
+
+  fd = fbl::unique_fd(open(dst_dir().c_str(), O_RDONLY));
+  ASSERT_TRUE(fd);
+  EXPECT_EQ(data_or->Write(std::move(fd)), ZX_OK);
+
+  EXPECT_EQ(GetFileContents(dst_path("sparse")), contents);
+}
+
 TEST_F(CopierTest, ReadWithEmptyPathExcludedIsIgnored) {
   ASSERT_TRUE(WriteFileContents(src_path("file1"), "hello1"));
   ASSERT_TRUE(files::CreateDirectory(src_path("dir")));
@@ -195,4 +195,28 @@ TEST_F(InspectManagerTest, CorruptionEvents) {
   ASSERT_EQ(fxfs_corruption_events->value(), 3u);
 }
 
+TEST_F(InspectManagerTest, MountTimeline) {
+  fshost::FshostInspectManager inspect_manager;
+  // There should be no "mount_timeline" node until a mount is reported.
+  inspect::Hierarchy hierarchy = ReadInspect(inspect_manager.inspector());
+  ASSERT_EQ(hierarchy.GetByPath({"mount_timeline"}), nullptr);
+
+  inspect_manager.LogMountTime(fs_management::DiskFormat::kDiskFormatBlobfs, zx::ticks(100),
+                               zx::ticks(250));
+
+  hierarchy = ReadInspect(inspect_manager.inspector());
+  const inspect::Hierarchy* blobfs_mount = hierarchy.GetByPath({"mount_timeline", "blobfs"});
+  ASSERT_NE(blobfs_mount, nullptr);
+
+  const auto* start_ticks =
+      blobfs_mount->node().get_property<inspect::IntPropertyValue>("start_ticks");
+  ASSERT_NE(start_ticks, nullptr);
+  ASSERT_EQ(start_ticks->value(), 100);
+
+  const auto* end_ticks =
+      blobfs_mount->node().get_property<inspect::IntPropertyValue>("end_ticks");
+  ASSERT_NE(end_ticks, nullptr);
+  ASSERT_EQ(end_ticks->value(), 250);
+}
+
 }  // namespace
@@ -184,6 +184,17 @@ void FshostInspectManager::LogMigrationStatus(zx_status_t status) {
   }
 }
 
+void FshostInspectManager::LogMountTime(fs_management::DiskFormat format, zx::ticks start,
+                                        zx::ticks end) {
+  if (!mount_timeline_node_.has_value()) {
+    mount_timeline_node_ = inspector_.GetRoot().CreateChild("mount_timeline");
+  }
+  inspect::Node mount_node = mount_timeline_node_->CreateChild(DiskFormatString(format));
+  mount_node.CreateInt("start_ticks", start.get(), &mount_timeline_values_);
+  mount_node.CreateInt("end_ticks", end.get(), &mount_timeline_values_);
+  mount_timeline_values_.emplace(std::move(mount_node));
+}
+
 void FshostInspectManager::LogCorruption(fs_management::DiskFormat format) {
   if (!corruption_node_.has_value()) {
     corruption_node_ = inspector_.GetRoot().CreateChild("corruption_events");
@@ -6,6 +6,7 @@
 #define SRC_STORAGE_FSHOST_INSPECT_MANAGER_H_
 
 #include <lib/inspect/cpp/inspector.h>
+#include <lib/zx/time.h>
 
 #include <map>
 #include <optional>
@@ -40,6 +41,11 @@ class FshostInspectManager {
   // Used to log the status of filesystem migrations (minfs to fxfs).
   void LogMigrationStatus(zx_status_t status);
 
+  // Records when mounting a filesystem of the given `format` started and ended. The times are in
+  // ticks, on the same timeline as the kernel's boot.timeline.* kcounters, so that the mounts can
+  // be placed in the boot timeline.
+  void LogMountTime(fs_management::DiskFormat format, zx::ticks start, zx::ticks end);
+
  private:
   inspect::Inspector inspector_;
 
@@ -55,6 +61,11 @@ class FshostInspectManager {
   std::optional<inspect::Node> migration_status_node_;
   std::optional<inspect::IntProperty> migration_status_;
 
+  // Node which contains a child with the start and end times of each filesystem mount. Will be
+  // lazily created when the first mount is reported via |LogMountTime|.
+  std::optional<inspect::Node> mount_timeline_node_;
+  inspect::ValueList mount_timeline_values_;
+
   // Fills information about the size of files and directories under the given `root` under the
   // given `node` and emplaces it in the given `inspector`. Returns the total size of `root`.
   void FillFileTreeSizes(fidl::ClientEnd<fuchsia_io::Directory> root, inspect::Node node,
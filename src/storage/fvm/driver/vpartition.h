@@ -64,6 +64,9 @@ class VPartition : public PartitionDeviceType,
   // Returns true if the respective |vslice| is mapped to a physical slice, and sets |*pslice| to
   // the mapped physical slice. Returns false if the |vslice| is unallocated.
   bool SliceGetLocked(uint64_t vslice, uint64_t* out_pslice) const TA_REQ(lock_);
+  bool SliceGetUnsafe(uint64_t vslice, uint64_t* out_pslice) const TA_NO_THREAD_SAFETY_ANALYSIS {
+    return SliceGetLocked(vslice, out_pslice);
+  }
 
   // Check slices starting from |vslice_start|.
   // Sets |*count| to the number of contiguous allocated or unallocated slices found.
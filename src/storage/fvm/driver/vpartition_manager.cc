@@ -31,6 +31,7 @@
 #include <new>
 #include <sstream>
 #include <utility>
+#include <vector>
 
 #include <fbl/array.h>
 #include <fbl/auto_lock.h>
@@ -446,41 +447,90 @@ zx_status_t VPartitionManager::FindFreeVPartEntryLocked(size_t* out) const {
   return ZX_ERR_NO_SPACE;
 }
 
-zx_status_t VPartitionManager::FindFreeSliceLocked(size_t* out, size_t hint) const {
-  hint = std::max(hint, 1lu);
-  size_t slice_count = GetHeaderLocked()->GetAllocationTableUsedEntryCount();
-  for (size_t i = hint; i <= slice_count; i++) {
-    if (GetSliceEntryLocked(i)->IsFree()) {
-      *out = i;
-      return ZX_OK;
-    }
-  }
-  for (size_t i = 1; i < hint; i++) {
-    if (GetSliceEntryLocked(i)->IsFree()) {
-      *out = i;
-      return ZX_OK;
+size_t VPartitionManager::FindFreeSliceRunLocked(size_t hint, size_t count) const {
+  const size_t slice_count = GetHeaderLocked()->GetAllocationTableUsedEntryCount();
+  hint = std::clamp(hint, 1lu, std::max(slice_count, 1lu));
+
+  size_t best_start = 0;
+  size_t best_length = 0;
+  // Scans [begin, end) and returns true once a run of |count| free slices is found. Runs are not
+  // joined across the point where the scan wraps around.
+  auto scan = [&](size_t begin, size_t end) TA_NO_THREAD_SAFETY_ANALYSIS {
+    size_t run_start = 0;
+    size_t run_length = 0;
+    for (size_t i = begin; i < end; i++) {
+      if (!GetSliceEntryLocked(i)->IsFree()) {
+        run_length = 0;
+        continue;
+      }
+      if (run_length++ == 0) {
+        run_start = i;
+      }
+      if (run_length > best_length) {
+        best_start = run_start;
+        best_length = run_length;
+        if (best_length >= count) {
+          return true;
+        }
+      }
     }
+    return false;
+  };
+  if (!scan(hint, slice_count + 1)) {
+    scan(1, hint);
   }
-  return ZX_ERR_NO_SPACE;
+  return best_start;
 }
 
 zx_status_t VPartitionManager::AllocateSlices(VPartition* vp, size_t vslice_start, size_t count) {
+  const slice_extent_t extent = {.offset = vslice_start, .length = count};
+  return AllocateSlices(vp, cpp20::span(&extent, 1));
+}
+
+zx_status_t VPartitionManager::AllocateSlices(VPartition* vp,
+                                              cpp20::span<const slice_extent_t> extents) {
   fbl::AutoLock lock(&lock_);
-  return AllocateSlicesLocked(vp, vslice_start, count);
+  return AllocateSlicesLocked(vp, extents);
 }
 
 zx_status_t VPartitionManager::AllocateSlicesLocked(VPartition* vp, size_t vslice_start,
                                                     size_t count) {
+  const slice_extent_t extent = {.offset = vslice_start, .length = count};
+  return AllocateSlicesLocked(vp, cpp20::span(&extent, 1));
+}
+
+zx_status_t VPartitionManager::AllocateSlicesLocked(VPartition* vp,
+                                                    cpp20::span<const slice_extent_t> extents) {
+  uint64_t count = 0;
+  for (const slice_extent_t& extent : extents) {
+    if (safemath::ClampAdd(extent.offset, extent.length) > VSliceMax()) {
+      return ZX_ERR_INVALID_ARGS;
+    }
+    count = safemath::ClampAdd(count, extent.length);
+  }
   if (count == 0) {
     return ZX_OK;  // Nothing to do.
   }
-  if (safemath::ClampAdd(vslice_start, count) > VSliceMax()) {
-    return ZX_ERR_INVALID_ARGS;
+  // Check against the free slices before anything is sized by |count|, which the caller controls.
+  if (count > GetHeaderLocked()->pslice_count - pslice_allocated_count_) {
+    return ZX_ERR_NO_SPACE;
   }
 
   zx_status_t status = ZX_OK;
-  size_t hint = 0;
   size_t total_slices_reserved = 0;
+  // The vslices allocated so far, so that they can be undone on failure.
+  std::vector<uint64_t> allocated;
+  allocated.reserve(count);
+  auto undo = [&]() TA_NO_THREAD_SAFETY_ANALYSIS {
+    for (auto vslice = allocated.rbegin(); vslice != allocated.rend(); ++vslice) {
+      uint64_t pslice;
+      // Will always return true, because partition slice allocation is synchronized.
+      if (vp->SliceGetLocked(*vslice, &pslice)) {
+        FreePhysicalSlice(vp, pslice);
+        vp->SliceFreeLocked(*vslice);
+      }
+    }
+  };
 
   {
     fbl::AutoLock lock(&vp->lock_);
@@ -499,31 +549,40 @@ zx_status_t VPartitionManager::AllocateSlicesLocked(VPartition* vp, size_t vslic
       }
     }
 
-    for (size_t i = 0; i < count; i++) {
-      size_t pslice;
-      auto vslice = vslice_start + i;
-      if (vp->SliceGetLocked(vslice, &pslice)) {
-        zxlogf(ERROR, "FVM: Attempting to allocate vslice %zu that is already allocated.", vslice);
-        status = ZX_ERR_INVALID_ARGS;
+    const size_t slice_count = GetHeaderLocked()->GetAllocationTableUsedEntryCount();
+    for (const slice_extent_t& extent : extents) {
+      // Keep the extent physically contiguous with the slice that precedes it in the partition if
+      // possible, so that a growing partition stays contiguous on disk.
+      uint64_t pslice = 0;
+      if (extent.offset > 0 && vp->SliceGetLocked(extent.offset - 1, &pslice)) {
+        ++pslice;
       }
+      for (uint64_t i = 0; i < extent.length; i++) {
+        uint64_t vslice = extent.offset + i;
+        uint64_t mapped_pslice;
+        if (vp->SliceGetLocked(vslice, &mapped_pslice)) {
+          zxlogf(ERROR, "FVM: Attempting to allocate vslice %zu that is already allocated.",
+                 vslice);
+          undo();
+          return ZX_ERR_INVALID_ARGS;
+        }
 
-      // If the vslice is invalid, or there are no more free physical slices, undo all
-      // previous allocations.
-      if ((status != ZX_OK) || ((status = FindFreeSliceLocked(&pslice, hint)) != ZX_OK)) {
-        for (int j = safemath::checked_cast<int>(i) - 1; j >= 0; j--) {
-          vslice = vslice_start + j;
-          vp->SliceGetLocked(vslice, &pslice);
-          FreePhysicalSlice(vp, pslice);
-          vp->SliceFreeLocked(vslice);
+        // Unless the next physical slice is free, move to the first free run which can hold the
+        // rest of the extent, or the longest run if there is none.
+        if (pslice == 0 || pslice > slice_count || !GetSliceEntryLocked(pslice)->IsFree()) {
+          pslice = FindFreeSliceRunLocked(pslice, extent.length - i);
+          if (pslice == 0) {
+            undo();
+            return ZX_ERR_NO_SPACE;
+          }
         }
 
-        return status;
+        // Allocate the slice in the partition then mark as allocated.
+        vp->SliceSetLocked(vslice, pslice);
+        AllocatePhysicalSlice(vp, pslice, vslice);
+        allocated.push_back(vslice);
+        ++pslice;
       }
-
-      // Allocate the slice in the partition then mark as allocated.
-      vp->SliceSetLocked(vslice, pslice);
-      AllocatePhysicalSlice(vp, pslice, vslice);
-      hint = pslice + 1;
     }
 
     total_slices_reserved = vp->NumSlicesLocked();
@@ -535,15 +594,7 @@ zx_status_t VPartitionManager::AllocateSlicesLocked(VPartition* vp, size_t vslic
   } else {
     // Undo allocation in the event of failure; avoid holding VPartition lock while writing to fvm.
     fbl::AutoLock lock(&vp->lock_);
-    for (int j = safemath::checked_cast<int>(count) - 1; j >= 0; j--) {
-      auto vslice = vslice_start + j;
-      uint64_t pslice;
-      // Will always return true, because partition slice allocation is synchronized.
-      if (vp->SliceGetLocked(vslice, &pslice)) {
-        FreePhysicalSlice(vp, pslice);
-        vp->SliceFreeLocked(vslice);
-      }
-    }
+    undo();
   }
 
   return status;
@@ -586,6 +637,12 @@ zx_status_t VPartitionManager::FreeSlices(VPartition* vp, size_t vslice_start, s
   return FreeSlicesLocked(vp, safemath::strict_cast<uint64_t>(vslice_start), count);
 }
 
+zx_status_t VPartitionManager::FreeSlices(VPartition* vp,
+                                          cpp20::span<const slice_extent_t> extents) {
+  fbl::AutoLock lock(&lock_);
+  return FreeSlicesLocked(vp, extents);
+}
+
 zx_status_t VPartitionManager::FreeSlicesLocked(VPartition* vp, uint64_t vslice_start,
                                                 size_t count) {
   if (count == 0) {
@@ -595,9 +652,12 @@ zx_status_t VPartitionManager::FreeSlicesLocked(VPartition* vp, uint64_t vslice_
     return ZX_ERR_INVALID_ARGS;
   }
 
-  bool valid_range = false;
+  if (vslice_start != 0) {
+    const slice_extent_t extent = {.offset = vslice_start, .length = count};
+    return FreeSlicesLocked(vp, cpp20::span(&extent, 1));
+  }
+
   std::string partition_name;
-  size_t total_slices_reserved = 0;
   {
     fbl::AutoLock lock(&vp->lock_);
     if (vp->IsKilledLocked())
@@ -606,27 +666,59 @@ zx_status_t VPartitionManager::FreeSlicesLocked(VPartition* vp, uint64_t vslice_
     auto entry = GetVPartEntryLocked(vp->entry_index());
     partition_name = entry->name();
 
-    if (vslice_start == 0) {
-      // Special case: Freeing entire VPartition
-      for (auto extent = vp->ExtentBegin(); extent.IsValid(); extent = vp->ExtentBegin()) {
-        for (size_t i = extent->start(); i < extent->end(); i++) {
-          uint64_t pslice;
-          vp->SliceGetLocked(i, &pslice);
-          FreePhysicalSlice(vp, pslice);
-        }
-        vp->ExtentDestroyLocked(extent->start());
+    // Special case: Freeing entire VPartition
+    for (auto extent = vp->ExtentBegin(); extent.IsValid(); extent = vp->ExtentBegin()) {
+      for (size_t i = extent->start(); i < extent->end(); i++) {
+        uint64_t pslice;
+        vp->SliceGetLocked(i, &pslice);
+        FreePhysicalSlice(vp, pslice);
       }
+      vp->ExtentDestroyLocked(extent->start());
+    }
 
-      // Remove device, VPartition if this was a request to release all slices.
-      if (vp->zxdev()) {
-        vp->DdkAsyncRemove();
-      }
-      entry->Release();
-      vp->KillLocked();
-      valid_range = true;
-    } else {
-      for (int i = safemath::checked_cast<int>(count - 1); i >= 0; i--) {
-        auto vslice = vslice_start + i;
+    // Remove device, VPartition if this was a request to release all slices.
+    if (vp->zxdev()) {
+      vp->DdkAsyncRemove();
+    }
+    entry->Release();
+    vp->KillLocked();
+  }
+
+  zx_status_t status = WriteFvmLocked();
+  if (status == ZX_OK) {
+    diagnostics().UpdatePartitionMetrics(partition_name, 0);
+  }
+  return status;
+}
+
+zx_status_t VPartitionManager::FreeSlicesLocked(VPartition* vp,
+                                                cpp20::span<const slice_extent_t> extents) {
+  uint64_t count = 0;
+  for (const slice_extent_t& extent : extents) {
+    // vslice 0 is reserved for freeing the entire partition, see FreeSlices().
+    if (extent.offset == 0 || safemath::ClampAdd(extent.offset, extent.length) > VSliceMax()) {
+      return ZX_ERR_INVALID_ARGS;
+    }
+    count = safemath::ClampAdd(count, extent.length);
+  }
+  if (count == 0) {
+    return ZX_OK;  // Nothing to do.
+  }
+
+  bool valid_range = false;
+  std::string partition_name;
+  size_t total_slices_reserved = 0;
+  {
+    fbl::AutoLock lock(&vp->lock_);
+    if (vp->IsKilledLocked())
+      return ZX_ERR_BAD_STATE;
+
+    auto entry = GetVPartEntryLocked(vp->entry_index());
+    partition_name = entry->name();
+
+    for (const slice_extent_t& extent : extents) {
+      for (uint64_t i = extent.length; i > 0; i--) {
+        auto vslice = extent.offset + i - 1;
         if (vp->SliceCanFree(vslice)) {
           uint64_t pslice;
           vp->SliceGetLocked(vslice, &pslice);
@@ -11,6 +11,7 @@
 #include <lib/ddk/device.h>
 #include <lib/fidl-utils/bind.h>
 #include <lib/fzl/owned-vmo-mapper.h>
+#include <lib/stdcompat/span.h>
 #include <lib/sync/completion.h>
 #include <lib/zircon-internal/thread_annotations.h>
 #include <lib/zx/status.h>
@@ -73,11 +74,22 @@ class VPartitionManager : public ManagerDeviceType {
   // Allocate 'count' slices, write back the FVM.
   zx_status_t AllocateSlices(VPartition* vp, size_t vslice_start, size_t count) TA_EXCL(lock_);
 
+  // Allocate the slices of every extent in |extents| and write back the FVM once. Either all of
+  // the extents are allocated or none of them are. Each extent is placed in physically contiguous
+  // slices when possible, continuing from the physical slice mapped to the vslice before it.
+  zx_status_t AllocateSlices(VPartition* vp, cpp20::span<const slice_extent_t> extents)
+      TA_EXCL(lock_);
+
   // Deallocate 'count' slices, write back the FVM.
   // If a request is made to remove vslice_count = 0, deallocates the entire
   // VPartition.
   zx_status_t FreeSlices(VPartition* vp, size_t vslice_start, size_t count) TA_EXCL(lock_);
 
+  // Deallocate the slices of every extent in |extents| and write back the FVM once. Unlike the
+  // version above, an extent may not start at vslice 0.
+  zx_status_t FreeSlices(VPartition* vp, cpp20::span<const slice_extent_t> extents)
+      TA_EXCL(lock_);
+
   // Returns global information about the FVM.
   void GetInfoInternal(VolumeManagerInfo* info) TA_EXCL(lock_);
 
@@ -145,11 +157,19 @@ class VPartitionManager : public ManagerDeviceType {
   zx_status_t WriteFvmLocked() TA_REQ(lock_);
 
   zx_status_t AllocateSlicesLocked(VPartition* vp, size_t vslice_start, size_t count) TA_REQ(lock_);
+  zx_status_t AllocateSlicesLocked(VPartition* vp, cpp20::span<const slice_extent_t> extents)
+      TA_REQ(lock_);
 
   zx_status_t FreeSlicesLocked(VPartition* vp, size_t vslice_start, size_t count) TA_REQ(lock_);
+  zx_status_t FreeSlicesLocked(VPartition* vp, cpp20::span<const slice_extent_t> extents)
+      TA_REQ(lock_);
 
   zx_status_t FindFreeVPartEntryLocked(size_t* out) const TA_REQ(lock_);
-  zx_status_t FindFreeSliceLocked(size_t* out, size_t hint) const TA_REQ(lock_);
+
+  // Returns the first physical slice of the first run of at least |count| free slices, searching
+  // from |hint| and wrapping around. If there is no such run, returns the start of the longest
+  // one. Returns 0 if there are no free slices.
+  size_t FindFreeSliceRunLocked(size_t hint, size_t count) const TA_REQ(lock_);
 
   // See also GetHeader() for unlocked access.
   Header* GetHeaderLocked() const TA_REQ(lock_) { return &metadata_.GetHeader(); }
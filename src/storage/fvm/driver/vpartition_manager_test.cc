@@ -285,6 +285,70 @@ TEST_F(VPartitionManagerTest, InspectVmoTracksSliceAllocations) {
   }
 }
 
+TEST_F(VPartitionManagerTest, AllocateSlicesPrefersContiguousSlices) {
+  // Lays out pslices 1, 2 and 3 for three partitions, then frees pslice 2.
+  auto first_or = AllocatePartition("first");
+  ASSERT_TRUE(first_or.is_ok());
+  auto second_or = AllocatePartition("second");
+  ASSERT_TRUE(second_or.is_ok());
+  auto third_or = AllocatePartition("third");
+  ASSERT_TRUE(third_or.is_ok());
+  ASSERT_EQ(device_->FreeSlices(second_or.value().get(), 0, 1), ZX_OK);
+
+  VPartition* third = third_or.value().get();
+  uint64_t pslice = 0;
+  ASSERT_TRUE(third->SliceGetUnsafe(0, &pslice));
+  ASSERT_EQ(pslice, 3u);
+
+  // Both extents are allocated with one metadata write. The first one follows on from vslice 0,
+  // and the second one skips the hole at pslice 2, which cannot hold it.
+  const uint64_t generation = device_->GetHeader().generation;
+  const slice_extent_t extents[] = {{.offset = 1, .length = 2}, {.offset = 0x100, .length = 2}};
+  ASSERT_EQ(device_->AllocateSlices(third, extents), ZX_OK);
+  EXPECT_EQ(device_->GetHeader().generation, generation + 1);
+
+  const uint64_t expected[][2] = {{1, 4}, {2, 5}, {0x100, 6}, {0x101, 7}};
+  for (const auto& [vslice, expected_pslice] : expected) {
+    ASSERT_TRUE(third->SliceGetUnsafe(vslice, &pslice));
+    EXPECT_EQ(pslice, expected_pslice);
+  }
+
+  ASSERT_EQ(device_->FreeSlices(third, extents), ZX_OK);
+  EXPECT_EQ(device_->GetHeader().generation, generation + 2);
+  EXPECT_FALSE(third->SliceGetUnsafe(1, &pslice));
+  EXPECT_FALSE(third->SliceGetUnsafe(0x100, &pslice));
+  EXPECT_TRUE(third->SliceGetUnsafe(0, &pslice));
+}
+
+TEST_F(VPartitionManagerTest, AllocateSlicesIsAllOrNothing) {
+  auto partition_or = AllocatePartition();
+  ASSERT_TRUE(partition_or.is_ok());
+  VPartition* partition = partition_or.value().get();
+
+  // The second extent overlaps vslice 0, which is already allocated.
+  const slice_extent_t extents[] = {{.offset = 1, .length = 2}, {.offset = 0, .length = 1}};
+  ASSERT_EQ(device_->AllocateSlices(partition, extents), ZX_ERR_INVALID_ARGS);
+  uint64_t pslice = 0;
+  EXPECT_FALSE(partition->SliceGetUnsafe(1, &pslice));
+  EXPECT_FALSE(partition->SliceGetUnsafe(2, &pslice));
+}
+
+TEST_F(VPartitionManagerTest, AllocateMoreSlicesThanFreeFails) {
+  auto partition_or = AllocatePartition();
+  ASSERT_TRUE(partition_or.is_ok());
+  VPartition* partition = partition_or.value().get();
+
+  const uint64_t generation = device_->GetHeader().generation;
+  const uint64_t slice_count = device_->GetHeader().pslice_count;
+  ASSERT_EQ(device_->AllocateSlices(partition, 1, slice_count), ZX_ERR_NO_SPACE);
+  // Far more slices than could ever be allocated must fail the same way.
+  ASSERT_EQ(device_->AllocateSlices(partition, 1, device_->VSliceMax() - 1), ZX_ERR_NO_SPACE);
+
+  EXPECT_EQ(device_->GetHeader().generation, generation);
+  uint64_t pslice = 0;
+  EXPECT_FALSE(partition->SliceGetUnsafe(1, &pslice));
+}
+
 TEST_F(VPartitionManagerTest, InspectVmoTracksPartitionLimit) {
   constexpr uint64_t kNewSliceLimit = 4u;
   static_assert(kNewSliceLimit > 0, "Slice limit must be greater than zero for test to be valid.");
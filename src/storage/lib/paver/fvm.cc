@@ -17,12 +17,18 @@
 #include <lib/zx/fifo.h>
 #include <lib/zx/time.h>
 #include <lib/zx/vmo.h>
+#include <zircon/assert.h>
 #include <zircon/status.h>
 #include <zircon/syscalls.h>
 
 #include <algorithm>
+#include <condition_variable>
 #include <cstddef>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include <fbl/algorithm.h>
 #include <fbl/array.h>
@@ -162,12 +168,192 @@ zx_status_t FlushClient(block_client::Client* client) {
   return client->Transaction(&request, 1);
 }
 
-// Stream an FVM partition to disk.
+// Writes an FVM partition out from a set of buffers in the stream VMO, so that several writes can
+// be in flight on the block FIFO while the next buffer is being filled from the sparse image.
+//
+// The last buffer in the VMO is kept zeroed and is used for the zeroes which follow each extent.
+class StreamWriter {
+ public:
+  // The size of each buffer, and how many of them there are for data. The stream VMO must be
+  // |kVmoSize| bytes.
+  static constexpr size_t kBufferSize = 512 * 1024;
+  static constexpr size_t kDataBufferCount = 4;
+  static constexpr size_t kVmoSize = kBufferSize * (kDataBufferCount + 1);
+
+  StreamWriter(const fzl::VmoMapper& mapper, block_client::Client& client, vmoid_t vmoid,
+               size_t block_size)
+      : mapper_(mapper), client_(client), vmoid_(vmoid), block_size_(block_size) {
+    ZX_ASSERT(mapper_.size() >= kVmoSize);
+    memset(BufferData(kDataBufferCount), 0, kBufferSize);
+    for (size_t i = 0; i < kDataBufferCount; ++i) {
+      free_buffers_.push_back(i);
+      threads_.emplace_back([this] { WriteLoop(); });
+    }
+  }
+
+  StreamWriter(const StreamWriter&) = delete;
+  StreamWriter& operator=(const StreamWriter&) = delete;
+
+  ~StreamWriter() {
+    {
+      std::lock_guard lock(mutex_);
+      stopping_ = true;
+    }
+    condition_.notify_all();
+    for (std::thread& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  uint8_t* BufferData(size_t buffer) const {
+    return reinterpret_cast<uint8_t*>(mapper_.start()) + buffer * kBufferSize;
+  }
+
+  // Waits for a buffer which isn't being written and returns its index, or the error from a write
+  // which has failed.
+  zx::status<size_t> AcquireBuffer() {
+    std::unique_lock lock(mutex_);
+    condition_.wait(lock, [this] { return status_ != ZX_OK || !free_buffers_.empty(); });
+    if (status_ != ZX_OK) {
+      return zx::error(status_);
+    }
+    size_t buffer = free_buffers_.back();
+    free_buffers_.pop_back();
+    return zx::ok(buffer);
+  }
+
+  // Queues a write of the first |length| bytes of |buffer| to |dev_offset| bytes into the
+  // partition. The buffer is released again once it has been written.
+  zx_status_t Write(size_t buffer, uint64_t dev_offset, size_t length) {
+    if (length % block_size_ != 0) {
+      ERROR("Cannot write non-block size multiple: %zu\n", length);
+      Release(buffer);
+      return ZX_ERR_IO;
+    }
+    Queue({.buffer = buffer, .dev_offset = dev_offset, .length = length});
+    return ZX_OK;
+  }
+
+  // Queues writes of zeroes to the |length| bytes at |dev_offset| bytes into the partition.
+  zx_status_t WriteZeroes(uint64_t dev_offset, size_t length) {
+    if (length % block_size_ != 0) {
+      ERROR("Cannot write non-block size multiple of zeroes: %zu\n", length);
+      return ZX_ERR_IO;
+    }
+    while (length > 0) {
+      const size_t chunk = std::min(length, kBufferSize * kMaxRequestsPerTransaction);
+      Queue({.buffer = kDataBufferCount, .dev_offset = dev_offset, .length = chunk});
+      dev_offset += chunk;
+      length -= chunk;
+    }
+    return ZX_OK;
+  }
+
+  // Waits for all of the queued writes to complete and returns the first error, if any.
+  zx_status_t Finish() {
+    std::unique_lock lock(mutex_);
+    condition_.wait(lock, [this] { return pending_.empty() && in_flight_ == 0; });
+    return status_;
+  }
+
+ private:
+  // Zeroes are written from the same buffer by several requests in one transaction.
+  static constexpr size_t kMaxRequestsPerTransaction = 16;
+
+  struct PendingWrite {
+    size_t buffer;
+    uint64_t dev_offset;
+    size_t length;
+  };
+
+  void Queue(PendingWrite write) {
+    {
+      std::lock_guard lock(mutex_);
+      pending_.push_back(write);
+    }
+    condition_.notify_all();
+  }
+
+  void Release(size_t buffer) {
+    if (buffer == kDataBufferCount) {
+      return;
+    }
+    {
+      std::lock_guard lock(mutex_);
+      free_buffers_.push_back(buffer);
+    }
+    condition_.notify_all();
+  }
+
+  void WriteLoop() {
+    std::unique_lock lock(mutex_);
+    while (true) {
+      condition_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+      if (pending_.empty()) {
+        return;
+      }
+      PendingWrite write = pending_.front();
+      pending_.pop_front();
+      ++in_flight_;
+      // Once a write has failed the rest are dropped, the caller finds out through |Finish()| or
+      // |AcquireBuffer()|.
+      const bool skip = status_ != ZX_OK;
+      lock.unlock();
+
+      zx_status_t status = skip ? ZX_OK : Transact(write);
+      Release(write.buffer);
+
+      lock.lock();
+      if (status != ZX_OK && status_ == ZX_OK) {
+        status_ = status;
+      }
+      --in_flight_;
+      condition_.notify_all();
+    }
+  }
+
+  zx_status_t Transact(const PendingWrite& write) {
+    block_fifo_request_t requests[kMaxRequestsPerTransaction];
+    size_t count = 0;
+    for (size_t offset = 0; offset < write.length; offset += kBufferSize) {
+      ZX_ASSERT(count < kMaxRequestsPerTransaction);
+      const size_t length = std::min(write.length - offset, kBufferSize);
+      requests[count++] = {
+          .opcode = BLOCKIO_WRITE,
+          .vmoid = vmoid_,
+          .length = static_cast<uint32_t>(length / block_size_),
+          .vmo_offset = write.buffer * kBufferSize / block_size_,
+          .dev_offset = (write.dev_offset + offset) / block_size_,
+      };
+    }
+    if (zx_status_t status = client_.Transaction(requests, count); status != ZX_OK) {
+      ERROR("Error writing partition data length:%zu dev_offset:%lu: %s\n", write.length,
+            write.dev_offset, zx_status_get_string(status));
+      return status;
+    }
+    return ZX_OK;
+  }
+
+  const fzl::VmoMapper& mapper_;
+  block_client::Client& client_;
+  const vmoid_t vmoid_;
+  const size_t block_size_;
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::vector<size_t> free_buffers_;  // Guarded by mutex_.
+  std::deque<PendingWrite> pending_;  // Guarded by mutex_.
+  size_t in_flight_ = 0;              // Guarded by mutex_.
+  zx_status_t status_ = ZX_OK;        // Guarded by mutex_.
+  bool stopping_ = false;             // Guarded by mutex_.
+  std::vector<std::thread> threads_;
+};
+
+// Stream an FVM partition to disk. Reading and decompressing the image happens on this thread while
+// the data read so far is written out by |writer|.
 zx_status_t StreamFvmPartition(fvm::SparseReader* reader, PartitionInfo* part,
-                               const fzl::VmoMapper& mapper, block_client::Client& client,
-                               size_t block_size, block_fifo_request_t* request) {
+                               StreamWriter& writer) {
   size_t slice_size = reader->Image()->slice_size;
-  const size_t vmo_cap = mapper.size();
   for (size_t e = 0; e < part->aligned_pd.extent_count; e++) {
     LOG("Writing extent %zu... \n", e);
     fvm::ExtentDescriptor ext = GetExtent(part->pd, e);
@@ -176,42 +362,29 @@ zx_status_t StreamFvmPartition(fvm::SparseReader* reader, PartitionInfo* part,
 
     // Write real data
     while (bytes_left > 0) {
+      zx::status<size_t> buffer = writer.AcquireBuffer();
+      if (buffer.is_error()) {
+        return buffer.error_value();
+      }
       size_t actual;
-      zx_status_t status = reader->ReadData(reinterpret_cast<uint8_t*>(mapper.start()),
-                                            std::min(bytes_left, vmo_cap), &actual);
+      zx_status_t status =
+          reader->ReadData(writer.BufferData(*buffer),
+                           std::min(bytes_left, StreamWriter::kBufferSize), &actual);
       if (status != ZX_OK) {
         ERROR("Error reading extent data with %zu bytes of %zu remaining: %s\n", bytes_left,
               ext.extent_length, zx_status_get_string(status));
         return status;
       }
-
-      const size_t vmo_sz = actual;
-      bytes_left -= actual;
-
-      if (vmo_sz == 0) {
+      if (actual == 0) {
         ERROR("Read nothing from src_fd; %zu bytes left\n", bytes_left);
         return ZX_ERR_IO;
-      } else if (vmo_sz % block_size != 0) {
-        ERROR("Cannot write non-block size multiple: %zu\n", vmo_sz);
-        return ZX_ERR_IO;
-      }
-
-      uint64_t length = vmo_sz / block_size;
-      if (length > UINT32_MAX) {
-        ERROR("Error writing partition: Too large\n");
-        return ZX_ERR_OUT_OF_RANGE;
       }
-      request->length = static_cast<uint32_t>(length);
-      request->vmo_offset = 0;
-      request->dev_offset = offset / block_size;
-
-      ssize_t r;
-      if ((r = client.Transaction(request, 1)) != ZX_OK) {
-        ERROR("Error writing partition data\n");
-        return static_cast<zx_status_t>(r);
+      if (status = writer.Write(*buffer, offset, actual); status != ZX_OK) {
+        return status;
       }
 
-      offset += vmo_sz;
+      bytes_left -= actual;
+      offset += actual;
     }
 
     // Write trailing zeroes (which are implied, but were omitted from
@@ -219,30 +392,12 @@ zx_status_t StreamFvmPartition(fvm::SparseReader* reader, PartitionInfo* part,
     bytes_left = (ext.slice_count * slice_size) - ext.extent_length;
     if (bytes_left > 0) {
       LOG("%zu bytes written, %zu zeroes left\n", ext.extent_length, bytes_left);
-      memset(mapper.start(), 0, vmo_cap);
-    }
-    while (bytes_left > 0) {
-      uint64_t length = std::min(bytes_left, vmo_cap) / block_size;
-      if (length > UINT32_MAX) {
-        ERROR("Error writing trailing zeroes: Too large(%lu)\n", length);
-        return ZX_ERR_OUT_OF_RANGE;
-      }
-      request->length = static_cast<uint32_t>(length);
-      request->vmo_offset = 0;
-      request->dev_offset = offset / block_size;
-
-      zx_status_t status;
-      if ((status = client.Transaction(request, 1)) != ZX_OK) {
-        ERROR("Error writing trailing zeroes length:%u dev_offset:%lu vmo_offset:%lu\n",
-              request->length, request->dev_offset, request->vmo_offset);
+      if (zx_status_t status = writer.WriteZeroes(offset, bytes_left); status != ZX_OK) {
         return status;
       }
-
-      offset += request->length * block_size;
-      bytes_left -= request->length * block_size;
     }
   }
-  return ZX_OK;
+  return writer.Finish();
 }
 
 }  // namespace
@@ -730,11 +885,10 @@ zx::status<> FvmStreamPartitions(const fbl::unique_fd& devfs_root,
 
   LOG("Partition space pre-allocated successfully.\n");
 
-  constexpr size_t vmo_size = 1 << 20;
-
   fzl::VmoMapper mapping;
   zx::vmo vmo;
-  if (mapping.CreateAndMap(vmo_size, ZX_VM_PERM_READ | ZX_VM_PERM_WRITE, nullptr, &vmo) != ZX_OK) {
+  if (mapping.CreateAndMap(StreamWriter::kVmoSize, ZX_VM_PERM_READ | ZX_VM_PERM_WRITE, nullptr,
+                          &vmo) != ZX_OK) {
     ERROR("Failed to create stream VMO\n");
     return zx::error(ZX_ERR_NO_MEMORY);
   }
@@ -764,15 +918,16 @@ zx::status<> FvmStreamPartitions(const fbl::unique_fd& devfs_root,
     }
 
     size_t block_size = response.info->block_size;
-
-    block_fifo_request_t request;
-    request.group = 0;
-    request.vmoid = vmoid;
-    request.opcode = BLOCKIO_WRITE;
+    if (StreamWriter::kBufferSize % block_size != 0) {
+      ERROR("Unsupported partition block size %zu\n", block_size);
+      return zx::error(ZX_ERR_NOT_SUPPORTED);
+    }
 
     LOG("Streaming partition %zu\n", p);
-    status = zx::make_status(
-        StreamFvmPartition(reader.get(), &parts[p], mapping, *client, block_size, &request));
+    {
+      StreamWriter writer(mapping, *client, vmoid, block_size);
+      status = zx::make_status(StreamFvmPartition(reader.get(), &parts[p], writer));
+    }
     LOG("Done streaming partition %zu\n", p);
     if (status.is_error()) {
       ERROR("Failed to stream partition status=%d\n", status.error_value());
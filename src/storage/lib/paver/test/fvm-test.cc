@@ -5,12 +5,20 @@
 #include "src/storage/lib/paver/fvm.h"
 
 #include <lib/driver-integration-test/fixture.h>
+#include <lib/fdio/fd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
 
 #include <zxtest/zxtest.h>
 
 #include "src/lib/storage/fs_management/cpp/fvm.h"
 #include "src/storage/fvm/format.h"
 #include "src/storage/fvm/fvm_sparse.h"
+#include "src/storage/fvm/sparse_reader.h"
+#include "src/storage/lib/paver/partition-client.h"
 #include "src/storage/lib/paver/test/test-utils.h"
 
 namespace {
@@ -56,6 +64,12 @@ class FvmTest : public zxtest::Test {
 
   int borrow_fd() { return device_->fd(); }
 
+  std::unique_ptr<paver::PartitionClient> partition_client() {
+    fidl::ClientEnd<fuchsia_hardware_block::Block> block;
+    EXPECT_OK(fdio_get_service_handle(fd().release(), block.channel().reset_and_get_address()));
+    return std::make_unique<paver::BlockPartitionClient>(std::move(block));
+  }
+
   fbl::unique_fd fd() { return fbl::unique_fd(dup(device_->fd())); }
 
   const fbl::unique_fd& devfs_root() { return devmgr_.devfs_root(); }
@@ -276,4 +290,181 @@ TEST_F(FvmTest, UnbindInvalidPath) {
   data.reset();
 }
 
+// An extent of a sparse FVM image, of which the first |length| bytes hold data.
+struct SparseExtent {
+  uint64_t slice_start;
+  uint64_t slice_count;
+  uint64_t length;
+};
+
+struct SparsePartition {
+  std::string name;
+  std::vector<SparseExtent> extents;
+};
+
+constexpr uint8_t kStreamType[GPT_GUID_LEN] = {0x5a, 0x4b, 0x3c, 0x2d, 0x1e, 0x0f, 0x01, 0x02,
+                                               0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a};
+
+// The data of |extent| of |partition| at |offset| bytes into the extent.
+uint8_t ExtentData(size_t partition, size_t extent, size_t offset) {
+  return static_cast<uint8_t>(partition * 31 + extent * 7 + offset / kBlockSize + offset);
+}
+
+// Returns an uncompressed sparse FVM image of |partitions|.
+std::vector<uint8_t> CreateSparseImage(size_t slice_size,
+                                       const std::vector<SparsePartition>& partitions) {
+  size_t header_length = sizeof(fvm::SparseImage);
+  for (const SparsePartition& partition : partitions) {
+    header_length += sizeof(fvm::PartitionDescriptor) +
+                     partition.extents.size() * sizeof(fvm::ExtentDescriptor);
+  }
+  std::vector<uint8_t> image(header_length);
+  auto append = [&image, offset = size_t{0}](const auto& value) mutable {
+    memcpy(&image[offset], &value, sizeof(value));
+    offset += sizeof(value);
+  };
+  append(fvm::SparseImage{
+      .magic = fvm::kSparseFormatMagic,
+      .version = fvm::kSparseFormatVersion,
+      .header_length = header_length,
+      .slice_size = slice_size,
+      .partition_count = partitions.size(),
+  });
+  for (const SparsePartition& partition : partitions) {
+    fvm::PartitionDescriptor descriptor = {
+        .magic = fvm::kPartitionDescriptorMagic,
+        .extent_count = static_cast<uint32_t>(partition.extents.size()),
+    };
+    memcpy(descriptor.type, kStreamType, sizeof(kStreamType));
+    memcpy(descriptor.name, partition.name.data(), partition.name.size());
+    append(descriptor);
+    for (const SparseExtent& extent : partition.extents) {
+      append(fvm::ExtentDescriptor{
+          .magic = fvm::kExtentDescriptorMagic,
+          .slice_start = extent.slice_start,
+          .slice_count = extent.slice_count,
+          .extent_length = extent.length,
+      });
+    }
+  }
+  for (size_t p = 0; p < partitions.size(); ++p) {
+    for (size_t e = 0; e < partitions[p].extents.size(); ++e) {
+      for (size_t i = 0; i < partitions[p].extents[e].length; ++i) {
+        image.push_back(ExtentData(p, e, i));
+      }
+    }
+  }
+  return image;
+}
+
+// Reads an in-memory image, at most |kMaxRead| bytes at a time.
+class BufferReader final : public fvm::ReaderInterface {
+ public:
+  static constexpr size_t kMaxRead = 96 * 1024;
+
+  explicit BufferReader(std::vector<uint8_t> data) : data_(std::move(data)) {}
+
+  zx_status_t Read(void* buf, size_t buf_size, size_t* size_actual) final {
+    *size_actual = std::min({buf_size, kMaxRead, data_.size() - offset_});
+    memcpy(buf, data_.data() + offset_, *size_actual);
+    offset_ += *size_actual;
+    return ZX_OK;
+  }
+
+ private:
+  const std::vector<uint8_t> data_;
+  size_t offset_ = 0;
+};
+
+class FvmStreamTest : public FvmTest {
+ public:
+  // Large enough for several of the paver's stream buffers per slice.
+  static constexpr size_t kStreamSliceSize = 1024 * 1024;
+  static constexpr size_t kStreamBlockCount = 32 * kStreamSliceSize / kBlockSize;
+
+  void SetUp() override {
+    ASSERT_NO_FAILURES(CreateRamdiskWithBlockCount(kStreamBlockCount));
+    // Fill the device with stale data, which the streamed zeroes have to overwrite.
+    std::vector<uint8_t> stale(kStreamSliceSize, 0xa5);
+    for (size_t offset = 0; offset < kStreamBlockCount * kBlockSize; offset += stale.size()) {
+      ASSERT_EQ(pwrite(borrow_fd(), stale.data(), stale.size(), offset),
+                static_cast<ssize_t>(stale.size()));
+    }
+  }
+
+  zx::status<> Stream(const std::vector<SparsePartition>& partitions) {
+    return paver::FvmStreamPartitions(
+        devfs_root(), partition_client(),
+        std::make_unique<BufferReader>(CreateSparseImage(kStreamSliceSize, partitions)));
+  }
+
+  // Checks that the |index|th partition of the FVM holds the data of |partition|, followed by
+  // zeroes to the end of each extent.
+  void ExpectPartition(size_t index, const SparsePartition& partition) {
+    const std::string path = "sys/platform/00:00:2d/ramctl/ramdisk-0/block/fvm/" + partition.name +
+                             "-p-" + std::to_string(index + 1) + "/block";
+    fbl::unique_fd part(openat(devfs_root().get(), path.c_str(), O_RDONLY));
+    ASSERT_TRUE(part.is_valid(), "%s", path.c_str());
+
+    for (size_t e = 0; e < partition.extents.size(); ++e) {
+      const SparseExtent& extent = partition.extents[e];
+      const size_t size = extent.slice_count * kStreamSliceSize;
+      std::vector<uint8_t> expected(size, 0);
+      for (size_t i = 0; i < extent.length; ++i) {
+        expected[i] = ExtentData(index, e, i);
+      }
+      std::vector<uint8_t> actual(size);
+      ASSERT_EQ(pread(part.get(), actual.data(), size, extent.slice_start * kStreamSliceSize),
+                static_cast<ssize_t>(size));
+      ASSERT_BYTES_EQ(actual.data(), expected.data(), size, "extent %zu", e);
+    }
+  }
+};
+
+TEST_F(FvmStreamTest, StreamPartitions) {
+  const std::vector<SparsePartition> partitions = {
+      {
+          .name = "stream-a",
+          // Several full buffers, a partial one and then zeroes.
+          .extents = {{.slice_start = 0,
+                       .slice_count = 4,
+                       .length = 2 * kStreamSliceSize + 3 * kBlockSize}},
+      },
+      {
+          .name = "stream-b",
+          .extents =
+              {
+                  {.slice_start = 0, .slice_count = 1, .length = 5 * kBlockSize},
+                  // Nothing but zeroes.
+                  {.slice_start = 4, .slice_count = 2, .length = 0},
+                  {.slice_start = 8, .slice_count = 3, .length = kStreamSliceSize + kBlockSize},
+              },
+      },
+  };
+  ASSERT_OK(Stream(partitions));
+  for (size_t p = 0; p < partitions.size(); ++p) {
+    ASSERT_NO_FATAL_FAILURE(ExpectPartition(p, partitions[p]));
+  }
+}
+
+TEST_F(FvmStreamTest, TruncatedImageFails) {
+  const std::vector<SparsePartition> partitions = {{
+      .name = "stream-a",
+      .extents = {{.slice_start = 0, .slice_count = 2, .length = 2 * kStreamSliceSize}},
+  }};
+  std::vector<uint8_t> image = CreateSparseImage(kStreamSliceSize, partitions);
+  image.resize(image.size() - kStreamSliceSize);
+  EXPECT_TRUE(paver::FvmStreamPartitions(devfs_root(), partition_client(),
+                                         std::make_unique<BufferReader>(std::move(image)))
+                  .is_error());
+}
+
+TEST_F(FvmStreamTest, UnalignedExtentFails) {
+  const std::vector<SparsePartition> partitions = {{
+      .name = "stream-a",
+      .extents = {{.slice_start = 0, .slice_count = 1, .length = kBlockSize + 1}},
+  }};
+  EXPECT_TRUE(Stream(partitions).is_error());
+}
+
 }  // namespace
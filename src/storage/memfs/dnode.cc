@@ -37,6 +37,9 @@ std::unique_ptr<Dnode> Dnode::RemoveFromParent() {
   std::unique_ptr<Dnode> node;
   // Detach from parent
   if (parent_) {
+    if (name_) {
+      parent_->children_by_name_.erase(Name());
+    }
     node = parent_->children_.erase(*this);
     if (IsDirectory()) {
       // '..' no longer references parent.
@@ -82,18 +85,19 @@ void Dnode::AddChild(Dnode* parent, std::unique_ptr<Dnode> child) {
   } else {
     child->ordering_token_ = parent->children_.back().ordering_token_ + 1;
   }
-  parent->children_.push_back(std::move(child));
+  parent->children_by_name_.emplace(child->Name(), child.get());
+  parent->children_.insert(std::move(child));
   parent->vnode_->UpdateModified();
 }
 
 zx_status_t Dnode::Lookup(std::string_view name, Dnode** out) {
-  auto dn = children_.find_if([&name](const Dnode& elem) -> bool { return elem.NameMatch(name); });
-  if (dn == children_.end()) {
+  auto dn = children_by_name_.find(name);
+  if (dn == children_by_name_.end()) {
     return ZX_ERR_NOT_FOUND;
   }
 
   if (out != nullptr) {
-    *out = &(*dn);
+    *out = dn->second;
   }
   return ZX_OK;
 }
@@ -147,13 +151,10 @@ void Dnode::Readdir(fs::DirentFiller* df, void* cookie) const {
     }
   }
 
-  for (const auto& dn : children_) {
-    if (dn.ordering_token_ < c->order) {
-      continue;
-    }
+  for (auto iter = children_.lower_bound(c->order); iter != children_.end(); ++iter) {
+    const Dnode& dn = *iter;
     uint32_t vtype = dn.IsDirectory() ? V_TYPE_DIR : V_TYPE_FILE;
-    if ((r = df->Next(std::string_view(dn.name_.get(), dn.NameLen()), VTYPE_TO_DTYPE(vtype),
-                      dn.AcquireVnode()->ino())) != ZX_OK) {
+    if ((r = df->Next(dn.Name(), VTYPE_TO_DTYPE(vtype), dn.AcquireVnode()->ino())) != ZX_OK) {
       return;
     }
     c->order = dn.ordering_token_ + 1;
@@ -174,7 +175,13 @@ bool Dnode::IsSubdirectory(const Dnode* dn) const {
   return false;
 }
 
-std::unique_ptr<char[]> Dnode::TakeName() { return std::move(name_); }
+std::unique_ptr<char[]> Dnode::TakeName() {
+  // The parent's name index refers to the name, so it must not outlive it.
+  if (parent_ && name_) {
+    parent_->children_by_name_.erase(Name());
+  }
+  return std::move(name_);
+}
 
 void Dnode::PutName(std::unique_ptr<char[]> name, size_t len) {
   flags_ = static_cast<uint32_t>((flags_ & ~kDnodeNameMax) | len);
@@ -194,8 +201,4 @@ Dnode::~Dnode() = default;
 
 size_t Dnode::NameLen() const { return flags_ & kDnodeNameMax; }
 
-bool Dnode::NameMatch(std::string_view name) const {
-  return name == std::string_view(name_.get(), NameLen());
-}
-
 }  // namespace memfs
@@ -11,8 +11,9 @@
 
 #include <memory>
 #include <string_view>
+#include <unordered_map>
 
-#include <fbl/intrusive_double_list.h>
+#include <fbl/intrusive_wavl_tree.h>
 #include <fbl/ref_counted.h>
 #include <fbl/ref_ptr.h>
 
@@ -36,10 +37,14 @@ static_assert(((kDnodeNameMax + 1) & kDnodeNameMax) == 0,
 // Vnodes may be represented by multiple Dnodes (a vnode may have many names).
 //
 // Dnodes are owned by their parents.
-class Dnode : public fbl::DoublyLinkedListable<std::unique_ptr<Dnode>> {
+class Dnode : public fbl::WAVLTreeContainable<std::unique_ptr<Dnode>> {
  public:
   DISALLOW_COPY_ASSIGN_AND_MOVE(Dnode);
 
+  // Children are kept sorted by their ordering token, so that Readdir can resume from a cookie
+  // without walking the entries it already returned.
+  size_t GetKey() const { return ordering_token_; }
+
   // Allocates a dnode, attached to a vnode
   static std::unique_ptr<Dnode> Create(std::string_view name, fbl::RefPtr<Vnode> vn);
 
@@ -105,7 +110,7 @@ class Dnode : public fbl::DoublyLinkedListable<std::unique_ptr<Dnode>> {
   Dnode(fbl::RefPtr<Vnode> vn, std::unique_ptr<char[]> name, uint32_t flags);
 
   size_t NameLen() const;
-  bool NameMatch(std::string_view name) const;
+  std::string_view Name() const { return std::string_view(name_.get(), NameLen()); }
 
   fbl::RefPtr<Vnode> vnode_;
   // Refers to the parent named node in the directory hierarchy.
@@ -114,7 +119,10 @@ class Dnode : public fbl::DoublyLinkedListable<std::unique_ptr<Dnode>> {
   Dnode* parent_;
   // Used to impose an absolute order on dnodes within a directory.
   size_t ordering_token_;
-  fbl::DoublyLinkedList<std::unique_ptr<Dnode>> children_;
+  fbl::WAVLTree<size_t, std::unique_ptr<Dnode>> children_;
+  // Index of |children_| by name, so that lookups in large directories do not scan every entry.
+  // The keys refer to the names owned by the children.
+  std::unordered_map<std::string_view, Dnode*> children_by_name_;
   uint32_t flags_;
   std::unique_ptr<char[]> name_;
 };
@@ -4,8 +4,12 @@
 
 #include <lib/async-loop/cpp/loop.h>
 #include <lib/async-loop/default.h>
+#include <lib/fdio/vfs.h>
 #include <sys/stat.h>
 
+#include <set>
+#include <string>
+
 #include <zxtest/zxtest.h>
 
 #include "src/storage/memfs/memfs.h"
@@ -152,5 +156,53 @@ TEST(MemfsTest, LocalClone) {
   EXPECT_NE(original_vmo_info.koid, vnode_vmo_info.koid);
 }
 
+TEST(MemfsTest, LargeDirectory) {
+  async::Loop loop(&kAsyncLoopConfigAttachToCurrentThread);
+
+  std::unique_ptr<Memfs> vfs;
+  fbl::RefPtr<VnodeDir> root;
+  ASSERT_OK(Memfs::Create(loop.dispatcher(), "<tmp>", &vfs, &root));
+
+  constexpr int kFileCount = 1000;
+  for (int i = 0; i < kFileCount; i++) {
+    fbl::RefPtr<fs::Vnode> file;
+    ASSERT_OK(root->Create("file-" + std::to_string(i), S_IFREG, &file));
+  }
+
+  // Remove the odd files, then rename "file-0" over "file-2".
+  for (int i = 1; i < kFileCount; i += 2) {
+    ASSERT_OK(root->Unlink("file-" + std::to_string(i), false));
+  }
+  ASSERT_OK(root->Rename(root, "file-0", "file-2", false, false));
+
+  std::set<std::string> expected;
+  for (int i = 2; i < kFileCount; i += 2) {
+    fbl::RefPtr<fs::Vnode> file;
+    ASSERT_OK(root->Lookup("file-" + std::to_string(i), &file));
+    expected.insert("file-" + std::to_string(i));
+  }
+  fbl::RefPtr<fs::Vnode> file;
+  EXPECT_EQ(root->Lookup("file-0", &file), ZX_ERR_NOT_FOUND);
+  EXPECT_EQ(root->Lookup("file-1", &file), ZX_ERR_NOT_FOUND);
+
+  // Read the directory in small chunks so that each call resumes from the cookie.
+  std::set<std::string> found;
+  fs::VdirCookie cookie;
+  uint8_t buffer[256];
+  size_t actual;
+  do {
+    ASSERT_OK(root->Readdir(&cookie, buffer, sizeof(buffer), &actual));
+    for (size_t offset = 0; offset < actual;) {
+      auto entry = reinterpret_cast<const vdirent_t*>(buffer + offset);
+      std::string name(entry->name, entry->size);
+      if (name != ".") {
+        EXPECT_TRUE(found.insert(name).second, "%s returned twice", name.c_str());
+      }
+      offset += sizeof(vdirent_t) + entry->size;
+    }
+  } while (actual != 0);
+  EXPECT_EQ(found, expected);
+}
+
 }  // namespace
 }  // namespace memfs
@@ -158,8 +158,11 @@ class Allocator {
   // The following methods are restricted to AllocatorReservation via the passkey
   // idiom. They are public, but require an empty |AllocatorReservationKey|.
 
-  // Allocate a single element and return its newly allocated index.
-  size_t Allocate(AllocatorReservationKey, AllocatorReservation* reservation) __TA_EXCLUDES(lock_);
+  // Allocate a single element and return its newly allocated index. If |goal| is non-zero and
+  // free, it is allocated in preference to the first free element so that callers can lay out
+  // consecutive elements contiguously.
+  size_t Allocate(AllocatorReservationKey, AllocatorReservation* reservation, size_t goal = 0)
+      __TA_EXCLUDES(lock_);
 
   // Reserve |count| elements. This is required in order to later allocate them.
   // Outputs a |reservation| which contains reservation details.
@@ -206,6 +209,9 @@ class Allocator {
   // called when reserved_ > 0.
   size_t FindNextUnreserved(size_t start) const __TA_REQUIRES(lock_);
 
+  // Returns true if |index| is free and isn't held by any pending change.
+  bool IsAvailableLocked(size_t index) const __TA_REQUIRES(lock_);
+
   // Adds & removes |change| from the vector of pending changes.
   void AddPendingChange(PendingChange* change);
   void RemovePendingChange(PendingChange* change);
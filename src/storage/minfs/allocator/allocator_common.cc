@@ -6,6 +6,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <utility>
@@ -119,6 +120,16 @@ size_t Allocator::FindLocked() const {
   }
 }
 
+bool Allocator::IsAvailableLocked(size_t index) const {
+  if (index >= map_.size() || map_.GetOne(index)) {
+    return false;
+  }
+  return std::all_of(pending_changes_.begin(), pending_changes_.end(),
+                     [index](const PendingChange* change) {
+                       return change->GetNextUnreserved(index) == index;
+                     });
+}
+
 void Allocator::Commit(PendingWork* transaction, AllocatorReservation* reservation) {
   PendingAllocations& allocations = reservation->GetPendingAllocations(this);
   PendingDeallocations& deallocations = reservation->GetPendingDeallocations(this);
@@ -215,17 +226,27 @@ bool Allocator::CheckAllocated(size_t index) const {
   return map_.Get(index, index + 1);
 }
 
-size_t Allocator::Allocate(AllocatorReservationKey, AllocatorReservation* reservation) {
+size_t Allocator::Allocate(AllocatorReservationKey, AllocatorReservation* reservation,
+                           size_t goal) {
   PendingAllocations& allocations = reservation->GetPendingAllocations(this);
 
   std::scoped_lock lock(lock_);
   ZX_DEBUG_ASSERT(reserved_ > 0);
 
-  size_t new_index = FindLocked();
+  size_t new_index;
+  if (goal > 0 && IsAvailableLocked(goal)) {
+    new_index = goal;
+    // Elements before |goal| may still be free, so |first_free_| only moves if we took it.
+    if (new_index == first_free_) {
+      first_free_ = new_index + 1;
+    }
+  } else {
+    new_index = FindLocked();
+    first_free_ = new_index + 1;
+  }
   ZX_DEBUG_ASSERT(!allocations.bitmap().GetOne(new_index));
   ZX_ASSERT(allocations.bitmap().SetOne(new_index) == ZX_OK);
   reserved_--;
-  first_free_ = new_index + 1;
   return new_index;
 }
 
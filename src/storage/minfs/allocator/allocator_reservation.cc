@@ -34,20 +34,20 @@ zx::status<> AllocatorReservation::ExtendReservation(PendingWork* transaction, s
   return status;
 }
 
-size_t AllocatorReservation::Allocate() {
+size_t AllocatorReservation::Allocate(size_t goal) {
   ZX_ASSERT(reserved_ > 0);
   reserved_--;
-  return allocator_.Allocate({}, this);
+  return allocator_.Allocate({}, this, goal);
 }
 
 void AllocatorReservation::Deallocate(size_t element) { allocator_.Free(this, element); }
 
 #ifdef __Fuchsia__
-size_t AllocatorReservation::Swap(size_t old_index) {
+size_t AllocatorReservation::Swap(size_t old_index, size_t goal) {
   if (old_index > 0) {
     allocator_.Free(this, old_index);
   }
-  return Allocate();
+  return Allocate(goal);
 }
 
 #endif
@@ -48,8 +48,9 @@ class AllocatorReservation {
   // Returns an error if not enough elements are available for reservation.
   zx::status<> ExtendReservation(PendingWork* transaction, size_t reserved);
 
-  // Allocate a new item in allocator_. Return the index of the newly allocated item.
-  size_t Allocate();
+  // Allocate a new item in allocator_. Return the index of the newly allocated item. |goal|, if
+  // non-zero, is the index to allocate if it is free.
+  size_t Allocate(size_t goal = 0);
 
   // Deallocate a new item from allocate_.
   void Deallocate(size_t element);
@@ -60,8 +61,8 @@ class AllocatorReservation {
 #ifdef __Fuchsia__
   // Swap the element currently allocated at |old_index| for a new index.
   // If |old_index| is 0, a new block will still be allocated, but no blocks will be de-allocated.
-  // The swap will not be persisted until a call to Commit is made.
-  size_t Swap(size_t old_index);
+  // The swap will not be persisted until a call to Commit is made. |goal| is as for |Allocate|.
+  size_t Swap(size_t old_index, size_t goal = 0);
 
   //  size_t GetReserved() const { return reserved_; }
 #endif
@@ -444,5 +444,25 @@ TEST(AllocatorTest, PendingDeallocationIsReserved) {
   EXPECT_EQ(item, reservation.Allocate());
 }
 
+TEST(AllocatorTest, AllocatePrefersFreeGoal) {
+  std::unique_ptr<Allocator> allocator;
+  ASSERT_NO_FATAL_FAILURE(CreateAllocator(&allocator));
+
+  AllocatorReservation reservation(allocator.get());
+  FakeTransaction transaction;
+  ASSERT_TRUE(reservation.Reserve(&transaction, 4).is_ok());
+  EXPECT_EQ(reservation.Allocate(10), 10ul);
+  // Taking the goal doesn't skip over the free elements before it.
+  EXPECT_EQ(reservation.Allocate(), 1ul);
+  EXPECT_EQ(reservation.Allocate(11), 11ul);
+
+  // A goal that is already pending falls back to the first free element.
+  AllocatorReservation reservation2(allocator.get());
+  ASSERT_TRUE(reservation2.Reserve(&transaction, 2).is_ok());
+  EXPECT_EQ(reservation2.Allocate(10), 2ul);
+  // As does one past the end of the map.
+  EXPECT_EQ(reservation2.Allocate(kTotalElements + 1), 3ul);
+}
+
 }  // namespace
 }  // namespace minfs
@@ -98,16 +98,21 @@ void File::AllocateAndCommitData(std::unique_ptr<Transaction> transaction) {
         BlocksSwap(transaction.get(), bno_start, bno_count, allocated_blocks.data()).is_ok(),
         "Failed to reserve blocks.");
 
-    // Enqueue each data block one at a time, as they may not be contiguous on disk.
+    // Enqueue one data write per run of blocks which ended up contiguous on disk.
     UnownedVmoBuffer buffer(vmo());
-    for (blk_t i = 0; i < bno_count; i++) {
+    for (blk_t i = 0; i < bno_count;) {
+      blk_t run = 1;
+      while (i + run < bno_count && allocated_blocks[i + run] == allocated_blocks[i] + run) {
+        ++run;
+      }
       storage::Operation operation = {
           .type = storage::OperationType::kWrite,
           .vmo_offset = bno_start + i,
           .dev_offset = allocated_blocks[i] + Vfs()->Info().dat_block,
-          .length = 1,
+          .length = run,
       };
       transaction->EnqueueData(operation, &buffer);
+      i += run;
     }
 
     // Since we are updating the file in "chunks", only update the on-disk inode size
@@ -161,6 +166,9 @@ zx::status<> File::BlocksSwap(Transaction* transaction, blk_t start, blk_t count
   if (status.is_error())
     return status.take_error();
 
+  // Each block is placed directly after the previous one where that's possible, so that a range
+  // written in one go is laid out, and later read, contiguously.
+  blk_t goal_block = 0;
   while (count > 0) {
     const blk_t file_block = static_cast<blk_t>(iterator.file_block());
     ZX_DEBUG_ASSERT(allocation_state_.IsPending(file_block));
@@ -173,11 +181,12 @@ zx::status<> File::BlocksSwap(Transaction* transaction, blk_t start, blk_t count
     }
     // For copy-on-write, swap the block out if it's a data block.
     blk_t new_block = old_block;
-    Vfs()->BlockSwap(transaction, old_block, &new_block);
+    Vfs()->BlockSwap(transaction, old_block, goal_block, &new_block);
     status = iterator.SetBlk(new_block);
     if (status.is_error())
       return status.take_error();
     *bnos++ = new_block;
+    goal_block = new_block + 1;
     bool cleared = allocation_state_.ClearPending(file_block, old_block != 0);
     ZX_DEBUG_ASSERT(cleared);
     // We have cleared pending bit for the block. Update the accounting for the dirty block.
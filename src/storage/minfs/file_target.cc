@@ -45,22 +45,23 @@ zx::status<> File::WalkFileBlocks(size_t offset, size_t length,
   blk_t start_block = static_cast<blk_t>(offset / Vfs()->BlockSize());
   blk_t end_block =
       static_cast<blk_t>((offset + length + Vfs()->BlockSize() - 1) / Vfs()->BlockSize());
-  size_t aligned_length = (end_block - start_block) * Vfs()->BlockSize();
-  while (aligned_length > 0) {
-    VnodeMapper mapper(this);
-    VnodeIterator iterator;
-    if (auto status = iterator.Init(&mapper, nullptr, start_block); status.is_error()) {
-      return status.take_error();
-    }
-
+  // One iterator is used for the whole walk so that the block pointers are only looked up again
+  // when the walk crosses into another indirect block.
+  VnodeMapper mapper(this);
+  VnodeIterator iterator;
+  if (auto status = iterator.Init(&mapper, nullptr, start_block); status.is_error()) {
+    return status.take_error();
+  }
+  for (blk_t block = start_block; block < end_block; ++block) {
     bool allocated = !(iterator.Blk() == 0);
-    bool is_pending = allocation_state_.IsPending(start_block);
+    bool is_pending = allocation_state_.IsPending(block);
 
-    if (auto status = handler(start_block, allocated, is_pending); status.is_error()) {
+    if (auto status = handler(block, allocated, is_pending); status.is_error()) {
       return status;
     }
-    aligned_length -= Vfs()->BlockSize();
-    start_block++;
+    if (auto status = iterator.Advance(); status.is_error()) {
+      return status.take_error();
+    }
   }
   return zx::ok();
 }
@@ -1056,12 +1056,12 @@ void Minfs::UpdateFlags(PendingWork* transaction, uint32_t flags, bool set) {
 }
 
 #ifdef __Fuchsia__
-void Minfs::BlockSwap(Transaction* transaction, blk_t in_bno, blk_t* out_bno) {
+void Minfs::BlockSwap(Transaction* transaction, blk_t in_bno, blk_t goal_bno, blk_t* out_bno) {
   if (in_bno > 0) {
     ValidateBno(in_bno);
   }
 
-  size_t allocated_bno = transaction->SwapBlock(in_bno);
+  size_t allocated_bno = transaction->SwapBlock(in_bno, goal_bno);
   *out_bno = static_cast<blk_t>(allocated_bno);
   ValidateBno(*out_bno);
 }
@@ -1323,7 +1323,11 @@ zx::status<> Minfs::InitializeJournal(fs::JournalSuperblock journal_superblock)
 
   journal_ = std::make_unique<fs::Journal>(GetMutableBcache(), std::move(journal_superblock),
                                            std::move(journal_buffer), std::move(writeback_buffer),
-                                           JournalStartBlock(sb_->Info()));
+                                           JournalStartBlock(sb_->Info()),
+                                           fs::Journal::Options{.group_commit = true});
+  journal_->set_commit_batch_callback([this](size_t transaction_count, size_t sync_count) {
+    inspect_tree_.OnJournalCommitBatch(transaction_count, sync_count);
+  });
   return zx::ok();
 }
 
@@ -7,6 +7,8 @@
 #include <lib/syslog/cpp/macros.h>
 #include <lib/zx/clock.h>
 
+#include <algorithm>
+
 #include <safemath/checked_math.h>
 
 namespace minfs {
@@ -83,6 +85,15 @@ void MinfsInspectTree::SubtractDirtyBytes(uint64_t bytes) {
   dirty_bytes_ = safemath::CheckSub(dirty_bytes_, bytes).ValueOrDie();
 }
 
+void MinfsInspectTree::OnJournalCommitBatch(size_t transaction_count, size_t sync_count) {
+  std::lock_guard guard(journal_mutex_);
+  ++journal_commit_batches_;
+  journal_batched_transactions_ += transaction_count;
+  journal_batched_syncs_ += sync_count;
+  journal_max_batch_transactions_ =
+      std::max<uint64_t>(journal_max_batch_transactions_, transaction_count);
+}
+
 fs_inspect::VolumeData MinfsInspectTree::GetVolumeData() {
   zx::status<fs_inspect::VolumeData::SizeInfo> size_info = zx::error(ZX_ERR_BAD_HANDLE);
   {
@@ -112,6 +123,15 @@ inspect::LazyNodeCallbackFn MinfsInspectTree::CreateDetailNode() const {
     }
     insp.GetRoot().CreateUint("recovered_space_events", recovered_space_events, &insp);
     insp.GetRoot().CreateUint("dirty_bytes", dirty_bytes, &insp);
+    {
+      std::lock_guard guard(journal_mutex_);
+      inspect::Node journal = insp.GetRoot().CreateChild("journal");
+      journal.CreateUint("commit_batches", journal_commit_batches_, &insp);
+      journal.CreateUint("batched_transactions", journal_batched_transactions_, &insp);
+      journal.CreateUint("batched_syncs", journal_batched_syncs_, &insp);
+      journal.CreateUint("max_batch_transactions", journal_max_batch_transactions_, &insp);
+      insp.emplace(std::move(journal));
+    }
     return fpromise::make_ok_promise(insp);
   };
 }
@@ -46,6 +46,11 @@ class MinfsInspectTree final {
   // Subtract |bytes| from the dirty bytes counter.
   void SubtractDirtyBytes(uint64_t bytes) __TA_EXCLUDES(volume_mutex_);
 
+  // Record a journal commit batch containing |transaction_count| transactions and |sync_count|
+  // syncs.
+  void OnJournalCommitBatch(size_t transaction_count, size_t sync_count)
+      __TA_EXCLUDES(journal_mutex_);
+
   // Reference to the Inspector this object owns.
   const inspect::Inspector& Inspector() { return inspector_; }
 
@@ -102,6 +107,13 @@ class MinfsInspectTree final {
   // Number of bytes currently in the dirty cache.
   uint64_t dirty_bytes_ __TA_GUARDED(volume_mutex_){};
 
+  // Journal group commit statistics. The mean batch size can be derived from the totals.
+  mutable std::mutex journal_mutex_{};
+  uint64_t journal_commit_batches_ __TA_GUARDED(journal_mutex_){};
+  uint64_t journal_batched_transactions_ __TA_GUARDED(journal_mutex_){};
+  uint64_t journal_batched_syncs_ __TA_GUARDED(journal_mutex_){};
+  uint64_t journal_max_batch_transactions_ __TA_GUARDED(journal_mutex_){};
+
   inspect::LazyNodeCallbackFn CreateDetailNode() const;
 
   // The Inspector to which the tree is attached.
@@ -222,9 +222,10 @@ class Minfs final : public TransactionalFs {
   // Set/Unset the flags.
   void UpdateFlags(PendingWork* transaction, uint32_t flags, bool set);
 
-  // Mark |in_bno| for de-allocation (if it is > 0), and return a new block |*out_bno|.
+  // Mark |in_bno| for de-allocation (if it is > 0), and return a new block |*out_bno|. The new
+  // block will be |goal_bno| if that is non-zero and free.
   // The swap will not be persisted until the transaction is commited.
-  void BlockSwap(Transaction* transaction, blk_t in_bno, blk_t* out_bno);
+  void BlockSwap(Transaction* transaction, blk_t in_bno, blk_t goal_bno, blk_t* out_bno);
 
   // Free ino in inode bitmap, release all blocks held by inode.
   [[nodiscard]] zx::status<> InoFree(Transaction* transaction, VnodeMinfs* vn);
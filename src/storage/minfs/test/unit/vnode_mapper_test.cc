@@ -239,6 +239,28 @@ TEST_F(VnodeMapperTest, VnodeMapperIndirectBlocksAreMapped) {
   EXPECT_EQ(device_range.value().count(), 1ul);
 }
 
+TEST_F(VnodeMapperTest, VnodeMapperContiguousBlocksAreCoalescedAcrossIndirectBlocks) {
+  vnode_->GetMutableInode()->dnum[kMinfsDirect - 1] = 18;
+  vnode_->GetMutableInode()->inum[0] = 17;
+  blk_t buffer[kMinfsDirectPerIndirect] = {19, 20, 22};
+  ASSERT_TRUE(runner_->minfs()
+                  .GetMutableBcache()
+                  ->Writeblk(runner_->minfs().Info().dat_block + 17, buffer)
+                  .is_ok());
+  VnodeMapper mapper(vnode_.get());
+  uint64_t block = kMinfsDirect - 1;
+  zx::status<DeviceBlockRange> device_range = mapper.Map(BlockRange(block, block + 4));
+  ASSERT_EQ(device_range.status_value(), ZX_OK);
+  ASSERT_TRUE(device_range.value().IsMapped());
+  EXPECT_EQ(runner_->minfs().Info().dat_block + 18, device_range.value().block());
+  EXPECT_EQ(device_range.value().count(), 3ul);
+
+  // The run is still limited by the requested range.
+  device_range = mapper.Map(BlockRange(block, block + 2));
+  ASSERT_EQ(device_range.status_value(), ZX_OK);
+  EXPECT_EQ(device_range.value().count(), 2ul);
+}
+
 TEST_F(VnodeMapperTest, VnodeMapperDoubleIndirectBlocksAreMapped) {
   vnode_->GetMutableInode()->dinum[0] = 17;
   blk_t buffer[kMinfsDirectPerIndirect] = {19};
@@ -255,7 +255,24 @@ zx::status<std::pair<blk_t, uint64_t>> VnodeMapper::MapToBlk(BlockRange range) {
   auto status = iterator.Init(this, nullptr, range.Start());
   if (status.is_error())
     return status.take_error();
-  return zx::ok(std::make_pair(iterator.Blk(), iterator.GetContiguousBlockCount(range.Length())));
+  const blk_t first_block = iterator.Blk();
+  uint64_t run = iterator.GetContiguousBlockCount(range.Length());
+  uint64_t count = run;
+  // The iterator only finds allocated runs within one bank of block pointers, but large files are
+  // usually allocated contiguously across those boundaries, so carry on into the next banks while
+  // the run continues. This lets large sequential reads be issued as fewer, larger requests.
+  if (first_block != 0) {
+    while (count < range.Length()) {
+      status = iterator.Advance(run);
+      if (status.is_error())
+        return status.take_error();
+      if (iterator.Blk() != first_block + count)
+        break;
+      run = iterator.GetContiguousBlockCount(range.Length() - count);
+      count += run;
+    }
+  }
+  return zx::ok(std::make_pair(first_block, count));
 }
 
 zx::status<DeviceBlockRange> VnodeMapper::Map(BlockRange range) {
@@ -103,7 +103,10 @@ class Transaction final : public PendingWork {
     return data_operations_.TakeOperations();
   }
 
-  size_t SwapBlock(size_t old_bno) { return block_reservation_->Swap(old_bno); }
+  // Swaps |old_bno| for a newly allocated block, which will be |goal_bno| if that is free.
+  size_t SwapBlock(size_t old_bno, size_t goal_bno = 0) {
+    return block_reservation_->Swap(old_bno, goal_bno);
+  }
 
   std::vector<fbl::RefPtr<VnodeMinfs>> RemovePinnedVnodes();
 
@@ -111,7 +111,8 @@ void CpuWatcher::Measure() {
         .timestamp = start.get(), .cpu_time = exited_cpu_, .queue_time = exited_queue_};
     // We store measurement-lists in the leaves, but histograms in the parents of the leaves.
     // to_measure is pair <parent, child> treating root as the parent of itself.
-    std::vector<std::pair<CpuWatcher::Task*, CpuWatcher::Task*>> to_measure;
+    auto& to_measure = to_measure_;
+    to_measure.clear();
     to_measure.reserve(task_count_);
     to_measure.push_back(std::make_pair(&root_, &root_));
 
@@ -166,19 +167,20 @@ cpp17::optional<CpuWatcher::Measurement> CpuWatcher::Task::Measure(
   if (stats_reader_) {
     TRACE_DURATION("appmgr", "CpuWatcher::Task::Measure");
     zx_info_task_runtime_t info;
-    if (ZX_OK == stats_reader_->GetCpuStats(&info)) {
-      TRACE_DURATION("appmgr", "CpuWatcher::Task::Measure::AddMeasurement");
-      AddMeasurementToList(timestamp, info.cpu_time, info.queue_time);
-      ZX_DEBUG_ASSERT(parent != nullptr);
-      if (parent != nullptr) {
-        auto histogram = parent->histogram();
-        if (histogram) {
-          AddMeasurementToHistogram(timestamp, info.cpu_time - previous_cpu_, parameters,
-                                    histogram);
-        }
+    if (ZX_OK != stats_reader_->GetCpuStats(&info)) {
+      // Do not fold an unread |info| into the parent's totals.
+      return cpp17::nullopt;
+    }
+    TRACE_DURATION("appmgr", "CpuWatcher::Task::Measure::AddMeasurement");
+    AddMeasurementToList(timestamp, info.cpu_time, info.queue_time);
+    ZX_DEBUG_ASSERT(parent != nullptr);
+    if (parent != nullptr) {
+      auto histogram = parent->histogram();
+      if (histogram) {
+        AddMeasurementToHistogram(timestamp, info.cpu_time - previous_cpu_, parameters, histogram);
       }
-      previous_cpu_ = info.cpu_time;
     }
+    previous_cpu_ = info.cpu_time;
     return cpp17::make_optional(Measurement{
         .timestamp = timestamp.get(), .cpu_time = info.cpu_time, .queue_time = info.queue_time});
   } else {
@@ -17,6 +17,8 @@
 #include <map>
 #include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 
 #include <src/lib/fxl/macros.h>
 #include <src/sys/appmgr/component_controller_impl.h>
@@ -210,6 +212,10 @@ class CpuWatcher {
   size_t task_count_ __TA_GUARDED(mutex_) = 1;  // 1 for root_
   Task root_ __TA_GUARDED(mutex_);
 
+  // Scratch list of <parent, child> pairs to measure, kept between calls to Measure so that each
+  // sample does not reallocate it.
+  std::vector<std::pair<Task*, Task*>> to_measure_ __TA_GUARDED(mutex_);
+
   // Total CPU and queue time of exited tasks. Used to ensure those values are not lost when
   // calculating overall CPU usage on the system.
   zx_duration_t exited_cpu_ __TA_GUARDED(mutex_) = 0;
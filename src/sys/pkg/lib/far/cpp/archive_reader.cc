@@ -13,6 +13,11 @@
 
 #include <fbl/algorithm.h>
 
+#ifdef __Fuchsia__
+#include <lib/fdio/io.h>
+#include <zircon/status.h>
+#endif
+
 #include "src/lib/files/directory.h"
 #include "src/lib/files/path.h"
 #include "src/lib/fxl/strings/concatenate.h"
@@ -93,6 +98,28 @@ bool ArchiveReader::CopyFile(std::string_view archive_path, int dst_fd) const {
   return true;
 }
 
+#ifdef __Fuchsia__
+bool ArchiveReader::GetFileVmo(std::string_view archive_path, zx::vmo* out) const {
+  DirectoryTableEntry entry;
+  if (!GetDirectoryEntryByPath(archive_path, &entry))
+    return false;
+  if (!archive_vmo_) {
+    zx_status_t status = fdio_get_vmo_clone(fd_.get(), archive_vmo_.reset_and_get_address());
+    if (status != ZX_OK) {
+      fprintf(stderr, "error: Failed to get archive VMO: %s.\n", zx_status_get_string(status));
+      return false;
+    }
+  }
+  zx_status_t status = archive_vmo_.create_child(ZX_VMO_CHILD_SNAPSHOT_AT_LEAST_ON_WRITE,
+                                                 entry.data_offset, entry.data_length, out);
+  if (status != ZX_OK) {
+    fprintf(stderr, "error: Failed to create VMO for file: %s.\n", zx_status_get_string(status));
+    return false;
+  }
+  return true;
+}
+#endif
+
 bool ArchiveReader::GetDirectoryEntryByIndex(uint64_t index, DirectoryTableEntry* entry) const {
   if (index >= directory_table_.size())
     return false;
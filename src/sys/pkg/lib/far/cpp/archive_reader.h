@@ -13,6 +13,10 @@
 
 #include "src/sys/pkg/lib/far/cpp/format.h"
 
+#ifdef __Fuchsia__
+#include <lib/zx/vmo.h>
+#endif
+
 namespace archive {
 
 class ArchiveReader {
@@ -41,6 +45,12 @@ class ArchiveReader {
   bool ExtractFile(std::string_view archive_path, const char* output_path) const;
   bool CopyFile(std::string_view archive_path, int dst_fd) const;
 
+#ifdef __Fuchsia__
+  // Returns the contents of |archive_path| as a copy-on-write child of the archive's VMO, without
+  // copying the data. The archive must be backed by a VMO.
+  bool GetFileVmo(std::string_view archive_path, zx::vmo* out) const;
+#endif
+
   bool GetDirectoryEntryByIndex(uint64_t index, DirectoryTableEntry* entry) const;
   bool GetDirectoryEntryByPath(std::string_view archive_path, DirectoryTableEntry* entry) const;
 
@@ -66,6 +76,11 @@ class ArchiveReader {
   std::vector<IndexEntry> index_;
   std::vector<DirectoryTableEntry> directory_table_;
   std::vector<char> path_data_;
+
+#ifdef __Fuchsia__
+  // A clone of the archive file's VMO, fetched by the first call to GetFileVmo.
+  mutable zx::vmo archive_vmo_;
+#endif
 };
 
 }  // namespace archive
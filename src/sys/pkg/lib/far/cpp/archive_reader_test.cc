@@ -108,6 +108,32 @@ TEST(ValidateArchive, ValidExampleArchive) {
   ASSERT_TRUE(TestReadArchive(kExampleArchive.data(), kExampleArchive.size()));
 }
 
+#ifdef __Fuchsia__
+TEST(ArchiveReader, GetFileVmo) {
+  files::ScopedTempDir dir;
+  std::string path;
+  ASSERT_TRUE(dir.NewTempFile(&path));
+  fbl::unique_fd fd(open(path.c_str(), O_RDWR));
+  ASSERT_TRUE(fd);
+  ASSERT_TRUE(fxl::WriteFileDescriptor(
+      fd.get(), reinterpret_cast<const char*>(kExampleArchive.data()), kExampleArchive.size()));
+
+  ArchiveReader reader(std::move(fd));
+  ASSERT_TRUE(reader.Read());
+
+  zx::vmo vmo;
+  ASSERT_TRUE(reader.GetFileVmo("dir/c", &vmo));
+  uint64_t content_size = 0;
+  ASSERT_EQ(ZX_OK, vmo.get_prop_content_size(&content_size));
+  EXPECT_EQ(6u, content_size);
+  char contents[6];
+  ASSERT_EQ(ZX_OK, vmo.read(contents, 0, sizeof(contents)));
+  EXPECT_EQ("dir/c\n", std::string_view(contents, sizeof(contents)));
+
+  EXPECT_FALSE(reader.GetFileVmo("missing", &vmo));
+}
+#endif
+
 TEST(ValidateArchive, GeneratedArchiveIsInvalid) {
   // Generated invalid archives from the "//src/sys/pkg/testing/invalid-fars:resource"
   // target to test various constraints mandated by the spec.
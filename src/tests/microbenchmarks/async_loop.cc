@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <fidl/fuchsia.zircon.benchmarks/cpp/wire.h>
 #include <fuchsia/zircon/benchmarks/cpp/fidl.h>
 #include <lib/async-loop/cpp/loop.h>
 #include <lib/async-loop/default.h>
@@ -13,6 +14,8 @@
 #include <thread>
 #include <vector>
 
+#include <fbl/string_printf.h>
+
 #include "assert.h"
 #include "test_runner.h"
 
@@ -24,6 +27,9 @@
 //
 // The server process phase exercises Zircon's channel waiting and reading
 // mechanisms, trivial FIDL message decoding, and the libasync dispatch loop.
+//
+// The same is measured for a server using the wire bindings, both waiting on
+// the loop for every message and draining the whole batch on one wakeup.
 
 namespace {
 
@@ -65,6 +71,44 @@ bool AsyncLoopProcessBatch(uint32_t count, perftest::RepeatState* state) {
   return true;
 }
 
+class WireNotificationImpl : public fidl::WireServer<fuchsia_zircon_benchmarks::Notification> {
+ public:
+  void Notify(NotifyCompleter::Sync& completer) override {}
+};
+
+bool WireAsyncLoopProcessBatch(uint32_t count, uint32_t max_messages_per_wakeup,
+                               perftest::RepeatState* state) {
+  state->DeclareStep("client_write");
+  state->DeclareStep("server_process");
+
+  // Set up client.
+  auto endpoints = fidl::CreateEndpoints<fuchsia_zircon_benchmarks::Notification>();
+  ASSERT_OK(endpoints.status_value());
+  fidl::WireSyncClient client(std::move(endpoints->client));
+
+  // Set up server.
+  WireNotificationImpl service_impl;
+  async::Loop loop(&kAsyncLoopConfigAttachToCurrentThread);
+  fidl::ServerBindingRef binding =
+      fidl::BindServer(loop.dispatcher(), std::move(endpoints->server), &service_impl);
+  binding.SetMaxMessagesPerWakeup(max_messages_per_wakeup);
+
+  // Start the benchmark.
+  while (state->KeepRunning()) {
+    // Enqueue 'count' messages.
+    for (uint32_t i = 0; i < count; i++) {
+      ASSERT_OK(client->Notify().status());
+    }
+
+    state->NextStep();
+
+    // Process all messages.
+    loop.RunUntilIdle();
+  }
+
+  return true;
+}
+
 void RegisterTests() {
   // Return a benchmark function the processes "count" messages per batch.
   auto AsyncLoopProcessBatchN = [](uint32_t count) {
@@ -76,6 +120,19 @@ void RegisterTests() {
   perftest::RegisterTest("AsyncLoopProcessBatch/4", AsyncLoopProcessBatchN(4));
   perftest::RegisterTest("AsyncLoopProcessBatch/8", AsyncLoopProcessBatchN(8));
   perftest::RegisterTest("AsyncLoopProcessBatch/16", AsyncLoopProcessBatchN(16));
+
+  // The wire bindings either wait on the loop for every message, or dispatch
+  // the whole batch per wakeup.
+  for (uint32_t count : {1, 2, 4, 8, 16}) {
+    perftest::RegisterTest(fbl::StringPrintf("WireAsyncLoopProcessBatch/%u", count).c_str(),
+                           [count](perftest::RepeatState* state) {
+                             return WireAsyncLoopProcessBatch(count, 1, state);
+                           });
+    perftest::RegisterTest(fbl::StringPrintf("WireAsyncLoopProcessBatch/%u/Drain", count).c_str(),
+                           [count](perftest::RepeatState* state) {
+                             return WireAsyncLoopProcessBatch(count, count, state);
+                           });
+  }
 }
 PERFTEST_CTOR(RegisterTests)
 
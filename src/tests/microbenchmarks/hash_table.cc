@@ -0,0 +1,171 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+
+#include <fbl/flat_hash_map.h>
+#include <fbl/intrusive_hash_table.h>
+#include <fbl/intrusive_single_list.h>
+#include <fbl/string_printf.h>
+#include <perftest/perftest.h>
+
+namespace {
+
+// Keys are allocated sequentially from an arbitrary base, the way koids are.
+constexpr uint64_t kFirstKey = 1024;
+
+// A map from koid-like keys to values built from fbl::HashTable, which needs a heap allocated node
+// per entry.
+class ChainedMap {
+ public:
+  bool Insert(uint64_t key, uint64_t value) {
+    table_.insert_or_replace(std::make_unique<Node>(key, value));
+    return true;
+  }
+  const uint64_t* Find(uint64_t key) const {
+    auto it = table_.find(key);
+    return it.IsValid() ? &it->value : nullptr;
+  }
+  bool Erase(uint64_t key) { return table_.erase(key) != nullptr; }
+  void Clear() { table_.clear(); }
+
+ private:
+  struct Node : public fbl::SinglyLinkedListable<std::unique_ptr<Node>> {
+    Node(uint64_t key, uint64_t value) : key(key), value(value) {}
+    uint64_t GetKey() const { return key; }
+    static size_t GetHash(uint64_t key) { return key; }
+
+    uint64_t key;
+    uint64_t value;
+  };
+
+  // A fixed number of buckets, as fbl::HashTable never rehashes.
+  static constexpr size_t kNumBuckets = 1024;
+  fbl::HashTable<uint64_t, std::unique_ptr<Node>, fbl::SinglyLinkedList<std::unique_ptr<Node>>,
+                 size_t, kNumBuckets>
+      table_;
+};
+
+class FlatMap {
+ public:
+  bool Insert(uint64_t key, uint64_t value) { return map_.InsertOrReplace(key, value); }
+  const uint64_t* Find(uint64_t key) const { return map_.Find(key); }
+  bool Erase(uint64_t key) { return map_.Erase(key); }
+  void Clear() { map_.Clear(); }
+
+ private:
+  fbl::FlatHashMap<uint64_t, uint64_t> map_;
+};
+
+template <typename Map>
+bool Fill(Map* map, uint32_t count) {
+  for (uint64_t i = 0; i < count; ++i) {
+    if (!map->Insert(kFirstKey + i, i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Measure the time taken to insert |count| entries into an empty map, including any growth, and to
+// clear it.
+template <typename Map>
+bool InsertTest(perftest::RepeatState* state, uint32_t count) {
+  state->DeclareStep("insert");
+  state->DeclareStep("clear");
+  Map map;
+  while (state->KeepRunning()) {
+    if (!Fill(&map, count)) {
+      return false;
+    }
+    state->NextStep();
+    map.Clear();
+  }
+  return true;
+}
+
+// Measure the time taken to look up a key in a map of |count| entries.
+template <typename Map>
+bool LookupTest(perftest::RepeatState* state, uint32_t count) {
+  Map map;
+  if (!Fill(&map, count)) {
+    return false;
+  }
+  uint64_t i = 0;
+  while (state->KeepRunning()) {
+    const uint64_t* value = map.Find(kFirstKey + i);
+    perftest::DoNotOptimize(value);
+    if (++i == count) {
+      i = 0;
+    }
+  }
+  return true;
+}
+
+// Measure the time taken to look up a key which isn't in a map of |count| entries.
+template <typename Map>
+bool LookupMissingTest(perftest::RepeatState* state, uint32_t count) {
+  Map map;
+  if (!Fill(&map, count)) {
+    return false;
+  }
+  uint64_t i = 0;
+  while (state->KeepRunning()) {
+    const uint64_t* value = map.Find(kFirstKey + count + i);
+    perftest::DoNotOptimize(value);
+    if (++i == count) {
+      i = 0;
+    }
+  }
+  return true;
+}
+
+// Measure the time taken to erase an entry from a map of |count| entries and to insert it back,
+// the way handles come and go in a handle table.
+template <typename Map>
+bool EraseInsertTest(perftest::RepeatState* state, uint32_t count) {
+  state->DeclareStep("erase");
+  state->DeclareStep("insert");
+  Map map;
+  if (!Fill(&map, count)) {
+    return false;
+  }
+  uint64_t i = 0;
+  while (state->KeepRunning()) {
+    if (!map.Erase(kFirstKey + i)) {
+      return false;
+    }
+    state->NextStep();
+    if (!map.Insert(kFirstKey + i, i)) {
+      return false;
+    }
+    if (++i == count) {
+      i = 0;
+    }
+  }
+  return true;
+}
+
+template <typename Map>
+void RegisterMapTests(const char* name) {
+  for (uint32_t count : {16, 1024, 65536}) {
+    perftest::RegisterTest(fbl::StringPrintf("HashTable/%s/Insert/%u", name, count).c_str(),
+                           InsertTest<Map>, count);
+    perftest::RegisterTest(fbl::StringPrintf("HashTable/%s/Lookup/%u", name, count).c_str(),
+                           LookupTest<Map>, count);
+    perftest::RegisterTest(fbl::StringPrintf("HashTable/%s/LookupMissing/%u", name, count).c_str(),
+                           LookupMissingTest<Map>, count);
+    perftest::RegisterTest(fbl::StringPrintf("HashTable/%s/EraseInsert/%u", name, count).c_str(),
+                           EraseInsertTest<Map>, count);
+  }
+}
+
+void RegisterTests() {
+  RegisterMapTests<ChainedMap>("Chained");
+  RegisterMapTests<FlatMap>("Flat");
+}
+
+PERFTEST_CTOR(RegisterTests)
+
+}  // namespace
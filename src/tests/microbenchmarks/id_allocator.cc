@@ -0,0 +1,116 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <zircon/syscalls.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <fbl/auto_lock.h>
+#include <fbl/mutex.h>
+#include <id_allocator/concurrent_id_allocator.h>
+#include <id_allocator/id_allocator.h>
+#include <perftest/perftest.h>
+
+#include "assert.h"
+
+namespace {
+
+// Enough ids for every thread to hold a queue's worth of transactions.
+constexpr size_t kIdCount = 4096;
+
+// An IdAllocator behind a lock, the way drivers share one today.
+class LockedIdAllocator {
+ public:
+  LockedIdAllocator() { ASSERT_OK(id_allocator::IdAllocator::Create(kIdCount, &allocator_)); }
+
+  zx_status_t Allocate(size_t* id) {
+    fbl::AutoLock lock(&lock_);
+    return allocator_->Allocate(id);
+  }
+
+  zx_status_t Free(size_t id) {
+    fbl::AutoLock lock(&lock_);
+    return allocator_->Free(id);
+  }
+
+ private:
+  fbl::Mutex lock_;
+  std::unique_ptr<id_allocator::IdAllocator> allocator_ __TA_GUARDED(lock_);
+};
+
+class ConcurrentIdAllocator {
+ public:
+  ConcurrentIdAllocator() {
+    ASSERT_OK(id_allocator::ConcurrentIdAllocator::Create(kIdCount, &allocator_));
+  }
+
+  zx_status_t Allocate(size_t* id) { return allocator_->Allocate(id); }
+  zx_status_t Free(size_t id) { return allocator_->Free(id); }
+
+ private:
+  std::unique_ptr<id_allocator::ConcurrentIdAllocator> allocator_;
+};
+
+// Allocates and frees an id, the way an I/O path gets a transaction id for
+// every request and gives it back on completion.
+template <typename Allocator>
+void AllocateFree(Allocator* allocator) {
+  size_t id;
+  ASSERT_OK(allocator->Allocate(&id));
+  ASSERT_OK(allocator->Free(id));
+}
+
+// Helper function that will run in its own thread. Continuously allocates and
+// frees ids until told to stop via a shared variable.
+template <typename Allocator>
+void DoAllocateFree(std::atomic<bool>* stop, Allocator* allocator) {
+  while (!stop->load(std::memory_order_relaxed)) {
+    AllocateFree(allocator);
+  }
+}
+
+// Measure how long allocating and freeing an id takes whilst |num_threads| - 1
+// other threads are doing the same with the same allocator.
+//
+// Should not be invoked with more threads than there are cpus, see
+// handle.cc.
+template <typename Allocator>
+bool AllocateFreeTest(perftest::RepeatState* state, uint32_t num_threads) {
+  Allocator allocator;
+  std::atomic<bool> stop(false);
+
+  std::vector<std::thread> threads(num_threads - 1);
+  for (auto& t : threads) {
+    t = std::thread(&DoAllocateFree<Allocator>, &stop, &allocator);
+  }
+
+  while (state->KeepRunning()) {
+    AllocateFree(&allocator);
+  }
+
+  stop.store(true, std::memory_order_seq_cst);
+  for (auto& t : threads) {
+    t.join();
+  }
+  return true;
+}
+
+void RegisterTests() {
+  const uint32_t num_cpus = zx_system_get_num_cpus();
+  perftest::RegisterTest("IdAllocator/Locked/AllocateFree/1Threads",
+                         AllocateFreeTest<LockedIdAllocator>, 1);
+  perftest::RegisterTest("IdAllocator/Locked/AllocateFree/CpuCountThreads",
+                         AllocateFreeTest<LockedIdAllocator>, num_cpus);
+  perftest::RegisterTest("IdAllocator/Concurrent/AllocateFree/1Threads",
+                         AllocateFreeTest<ConcurrentIdAllocator>, 1);
+  perftest::RegisterTest("IdAllocator/Concurrent/AllocateFree/CpuCountThreads",
+                         AllocateFreeTest<ConcurrentIdAllocator>, num_cpus);
+}
+
+PERFTEST_CTOR(RegisterTests)
+
+}  // namespace
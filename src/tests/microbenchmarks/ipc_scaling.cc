@@ -0,0 +1,458 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <lib/syslog/cpp/macros.h>
+#include <lib/zx/channel.h>
+#include <lib/zx/fifo.h>
+#include <lib/zx/port.h>
+#include <lib/zx/socket.h>
+#include <zircon/syscalls.h>
+#include <zircon/syscalls/port.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <fbl/string_printf.h>
+#include <perftest/perftest.h>
+
+#include "assert.h"
+#include "util.h"
+
+// This file measures how the kernel IPC primitives scale with the number
+// of CPUs that use them at the same time.
+//
+// Each test runs a number of independent client/server thread pairs.
+// Each pair has its own channel, socket, fifo, port pair or futex pair, so
+// the only contention between pairs is inside the kernel (for example on
+// scheduler state, the handle table, or allocators).  A single test run
+// consists of every pair completing a fixed amount of work concurrently,
+// so with perfect scaling the time per run stays the same as pairs are
+// added.
+//
+// There are two modes:
+//
+//  * "PingPong": the client sends one message and waits for the reply,
+//    which measures round-trip latency under load.
+//  * "Stream": the client sends a batch of messages and the server replies
+//    once it has read the whole batch, which measures throughput.  This is
+//    not instantiated for futexes, since futex wakeups do not queue.
+//
+// Each test is instantiated with the threads left to the scheduler
+// ("Unpinned") and with each thread pinned to its own CPU ("Pinned"), where
+// CPUs are assigned to pairs in order, client first.
+
+namespace {
+
+// Round trips per pair in a single run of a PingPong test.
+constexpr uint32_t kRoundTripsPerRun = 100;
+// Messages per batch, and batches per pair in a single run, of a Stream test.
+constexpr uint32_t kStreamBatchSize = 64;
+constexpr uint32_t kStreamBatchesPerRun = 16;
+
+// The messages sent by all primitives.
+using Message = uint64_t;
+
+// A link between a client thread and a server thread, built on one IPC
+// primitive.  In each direction it delivers a stream of small messages.
+class Link {
+ public:
+  virtual ~Link() = default;
+
+  // Sends |count| messages to the server.
+  virtual void ClientSend(uint32_t count) = 0;
+  // Waits for a reply from the server.
+  virtual void ClientReceive() = 0;
+  // Waits for |count| messages from the client.  Returns false once the
+  // link has been shut down.
+  virtual bool ServerReceive(uint32_t count) = 0;
+  // Sends a reply to the client.
+  virtual void ServerSend() = 0;
+  // Makes ServerReceive() return false.  Called once the client is done.
+  virtual void Shutdown() = 0;
+};
+
+class ChannelLink : public Link {
+ public:
+  ChannelLink() { ASSERT_OK(zx::channel::create(0, &client_, &server_)); }
+
+  void ClientSend(uint32_t count) override {
+    for (uint32_t i = 0; i < count; ++i) {
+      Write(client_);
+    }
+  }
+  void ClientReceive() override { FX_CHECK(Read(client_)); }
+  bool ServerReceive(uint32_t count) override {
+    for (uint32_t i = 0; i < count; ++i) {
+      if (!Read(server_))
+        return false;
+    }
+    return true;
+  }
+  void ServerSend() override { Write(server_); }
+  void Shutdown() override { client_.reset(); }
+
+ private:
+  static void Write(const zx::channel& channel) {
+    Message msg = 0;
+    ASSERT_OK(channel.write(0, &msg, sizeof(msg), nullptr, 0));
+  }
+  // Returns false if the channel's peer was closed.
+  static bool Read(const zx::channel& channel) {
+    zx_signals_t observed;
+    ASSERT_OK(channel.wait_one(ZX_CHANNEL_READABLE | ZX_CHANNEL_PEER_CLOSED, zx::time::infinite(),
+                               &observed));
+    if (!(observed & ZX_CHANNEL_READABLE))
+      return false;
+    Message msg;
+    uint32_t bytes_read;
+    ASSERT_OK(channel.read(0, &msg, nullptr, sizeof(msg), 0, &bytes_read, nullptr));
+    FX_CHECK(bytes_read == sizeof(msg));
+    return true;
+  }
+
+  zx::channel client_;
+  zx::channel server_;
+};
+
+class SocketLink : public Link {
+ public:
+  SocketLink() { ASSERT_OK(zx::socket::create(ZX_SOCKET_STREAM, &client_, &server_)); }
+
+  void ClientSend(uint32_t count) override { Write(client_, count); }
+  void ClientReceive() override { FX_CHECK(Read(client_, 1)); }
+  bool ServerReceive(uint32_t count) override { return Read(server_, count); }
+  void ServerSend() override { Write(server_, 1); }
+  void Shutdown() override { client_.reset(); }
+
+ private:
+  static void Write(const zx::socket& socket, uint32_t count) {
+    Message msgs[kStreamBatchSize] = {};
+    FX_CHECK(count <= std::size(msgs));
+    size_t actual;
+    ASSERT_OK(socket.write(0, msgs, count * sizeof(Message), &actual));
+    FX_CHECK(actual == count * sizeof(Message));
+  }
+  // Returns false if the socket's peer was closed.
+  static bool Read(const zx::socket& socket, uint32_t count) {
+    Message msgs[kStreamBatchSize];
+    FX_CHECK(count <= std::size(msgs));
+    // A stream socket may return fewer bytes than were written at once.
+    size_t remaining = count * sizeof(Message);
+    while (remaining > 0) {
+      zx_signals_t observed;
+      ASSERT_OK(socket.wait_one(ZX_SOCKET_READABLE | ZX_SOCKET_PEER_CLOSED, zx::time::infinite(),
+                                &observed));
+      if (!(observed & ZX_SOCKET_READABLE))
+        return false;
+      size_t actual;
+      ASSERT_OK(socket.read(0, msgs, remaining, &actual));
+      remaining -= actual;
+    }
+    return true;
+  }
+
+  zx::socket client_;
+  zx::socket server_;
+};
+
+class FifoLink : public Link {
+ public:
+  FifoLink() {
+    ASSERT_OK(zx::fifo::create(kStreamBatchSize, sizeof(Message), 0, &client_, &server_));
+  }
+
+  void ClientSend(uint32_t count) override { Write(client_, count); }
+  void ClientReceive() override { FX_CHECK(Read(client_, 1)); }
+  bool ServerReceive(uint32_t count) override { return Read(server_, count); }
+  void ServerSend() override { Write(server_, 1); }
+  void Shutdown() override { client_.reset(); }
+
+ private:
+  static void Write(const zx::fifo& fifo, uint32_t count) {
+    Message msgs[kStreamBatchSize] = {};
+    FX_CHECK(count <= std::size(msgs));
+    size_t actual;
+    ASSERT_OK(fifo.write(sizeof(Message), msgs, count, &actual));
+    FX_CHECK(actual == count);
+  }
+  // Returns false if the fifo's peer was closed.
+  static bool Read(const zx::fifo& fifo, uint32_t count) {
+    Message msgs[kStreamBatchSize];
+    FX_CHECK(count <= std::size(msgs));
+    while (count > 0) {
+      zx_signals_t observed;
+      ASSERT_OK(fifo.wait_one(ZX_FIFO_READABLE | ZX_FIFO_PEER_CLOSED, zx::time::infinite(),
+                              &observed));
+      if (!(observed & ZX_FIFO_READABLE))
+        return false;
+      size_t actual;
+      ASSERT_OK(fifo.read(sizeof(Message), msgs, count, &actual));
+      count -= static_cast<uint32_t>(actual);
+    }
+    return true;
+  }
+
+  zx::fifo client_;
+  zx::fifo server_;
+};
+
+// Uses one port for each direction, with user packets as messages.
+class PortLink : public Link {
+ public:
+  PortLink() {
+    ASSERT_OK(zx::port::create(0, &client_port_));
+    ASSERT_OK(zx::port::create(0, &server_port_));
+  }
+
+  void ClientSend(uint32_t count) override {
+    for (uint32_t i = 0; i < count; ++i) {
+      Queue(server_port_, kMessageKey);
+    }
+  }
+  void ClientReceive() override { FX_CHECK(Wait(client_port_)); }
+  bool ServerReceive(uint32_t count) override {
+    for (uint32_t i = 0; i < count; ++i) {
+      if (!Wait(server_port_))
+        return false;
+    }
+    return true;
+  }
+  void ServerSend() override { Queue(client_port_, kMessageKey); }
+  void Shutdown() override { Queue(server_port_, kShutdownKey); }
+
+ private:
+  static constexpr uint64_t kMessageKey = 1;
+  static constexpr uint64_t kShutdownKey = 2;
+
+  static void Queue(const zx::port& port, uint64_t key) {
+    zx_port_packet_t packet = {};
+    packet.key = key;
+    packet.type = ZX_PKT_TYPE_USER;
+    ASSERT_OK(port.queue(&packet));
+  }
+  // Returns false if the shutdown packet was received.
+  static bool Wait(const zx::port& port) {
+    zx_port_packet_t packet;
+    ASSERT_OK(port.wait(zx::time::infinite(), &packet));
+    return packet.key == kMessageKey;
+  }
+
+  zx::port client_port_;
+  zx::port server_port_;
+};
+
+// Uses one futex for each direction, each counting the messages sent in
+// that direction.
+class FutexLink : public Link {
+ public:
+  void ClientSend(uint32_t count) override { Signal(&requests_, count); }
+  void ClientReceive() override {
+    ++replies_received_;
+    FX_CHECK(WaitFor(&replies_, replies_received_));
+  }
+  bool ServerReceive(uint32_t count) override {
+    requests_received_ += count;
+    return WaitFor(&requests_, requests_received_);
+  }
+  void ServerSend() override { Signal(&replies_, 1); }
+  void Shutdown() override {
+    // Changing the value as well makes sure that a server about to wait
+    // sees the shutdown.
+    shutdown_.store(true);
+    Signal(&requests_, 1);
+  }
+
+ private:
+  static zx_futex_t* Futex(std::atomic<zx_futex_t>* value) {
+    return reinterpret_cast<zx_futex_t*>(value);
+  }
+  static void Signal(std::atomic<zx_futex_t>* value, uint32_t count) {
+    value->fetch_add(static_cast<zx_futex_t>(count));
+    ASSERT_OK(zx_futex_wake(Futex(value), 1));
+  }
+  // Waits until |value| reaches |target|.  Returns false if the link has
+  // been shut down first.
+  bool WaitFor(std::atomic<zx_futex_t>* value, zx_futex_t target) {
+    for (;;) {
+      if (shutdown_.load())
+        return false;
+      zx_futex_t current = value->load();
+      if (current >= target)
+        return true;
+      zx_status_t status =
+          zx_futex_wait(Futex(value), current, ZX_HANDLE_INVALID, ZX_TIME_INFINITE);
+      // zx_futex_wait() returns ZX_ERR_BAD_STATE if the value already changed.
+      FX_CHECK(status == ZX_OK || status == ZX_ERR_BAD_STATE);
+    }
+  }
+
+  std::atomic<zx_futex_t> requests_ = 0;
+  std::atomic<zx_futex_t> replies_ = 0;
+  std::atomic<bool> shutdown_ = false;
+  // Only accessed by the server and the client respectively.
+  zx_futex_t requests_received_ = 0;
+  zx_futex_t replies_received_ = 0;
+};
+
+// Starts runs on all client threads at once and waits for them to finish.
+class RunGate {
+ public:
+  explicit RunGate(uint32_t clients) : clients_(clients) {}
+
+  // Called by the benchmark thread for each run.
+  void Run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++generation_;
+    remaining_ = clients_;
+    start_.notify_all();
+    done_.wait(lock, [this] { return remaining_ == 0; });
+  }
+
+  // Called by the benchmark thread once all runs are done.
+  void Stop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+    start_.notify_all();
+  }
+
+  // Called by client threads.  Waits for the next run after the one given
+  // by |*generation|, and returns false if the test is stopping instead.
+  bool WaitForRun(uint64_t* generation) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    start_.wait(lock, [this, generation] { return stopped_ || generation_ != *generation; });
+    *generation = generation_;
+    return !stopped_;
+  }
+
+  // Called by client threads at the end of each run.
+  void Finish() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--remaining_ == 0)
+      done_.notify_one();
+  }
+
+ private:
+  const uint32_t clients_;
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable done_;
+  uint64_t generation_ = 0;
+  uint32_t remaining_ = 0;
+  bool stopped_ = false;
+};
+
+enum class Mode { kPingPong, kStream };
+
+using LinkFactory = std::unique_ptr<Link> (*)();
+
+template <class LinkClass>
+std::unique_ptr<Link> MakeLink() {
+  return std::make_unique<LinkClass>();
+}
+
+// Returns the affinity mask for thread |index| of the test, or 0 if it is
+// not pinned.  Only the bottom 32 CPUs can be pinned to.
+uint32_t ThreadCpuMask(bool pinned, uint32_t index) {
+  const uint32_t cpu = index % zx_system_get_num_cpus();
+  return pinned && cpu < 32 ? 1u << cpu : 0;
+}
+
+bool IpcScalingTest(perftest::RepeatState* state, LinkFactory make_link, Mode mode, uint32_t pairs,
+                    bool pinned) {
+  const uint32_t batch_size = mode == Mode::kPingPong ? 1 : kStreamBatchSize;
+  const uint32_t batches_per_run =
+      mode == Mode::kPingPong ? kRoundTripsPerRun : kStreamBatchesPerRun;
+
+  std::vector<std::unique_ptr<Link>> links;
+  for (uint32_t i = 0; i < pairs; ++i) {
+    links.push_back(make_link());
+  }
+
+  RunGate gate(pairs);
+  std::vector<std::thread> servers;
+  std::vector<std::thread> clients;
+  for (uint32_t i = 0; i < pairs; ++i) {
+    Link* link = links[i].get();
+    const uint32_t client_mask = ThreadCpuMask(pinned, 2 * i);
+    const uint32_t server_mask = ThreadCpuMask(pinned, 2 * i + 1);
+    clients.emplace_back([&gate, link, batch_size, batches_per_run, client_mask] {
+      util::SetCpuAffinity(client_mask);
+      for (uint64_t generation = 0; gate.WaitForRun(&generation);) {
+        for (uint32_t j = 0; j < batches_per_run; ++j) {
+          link->ClientSend(batch_size);
+          link->ClientReceive();
+        }
+        gate.Finish();
+      }
+    });
+    servers.emplace_back([link, batch_size, server_mask] {
+      util::SetCpuAffinity(server_mask);
+      while (link->ServerReceive(batch_size)) {
+        link->ServerSend();
+      }
+    });
+  }
+
+  while (state->KeepRunning()) {
+    gate.Run();
+  }
+
+  gate.Stop();
+  for (auto& client : clients) {
+    client.join();
+  }
+  for (auto& link : links) {
+    link->Shutdown();
+  }
+  for (auto& server : servers) {
+    server.join();
+  }
+  return true;
+}
+
+void RegisterTests() {
+  struct Primitive {
+    const char* name;
+    LinkFactory make_link;
+    bool streams;
+  };
+  static const Primitive kPrimitives[] = {
+      {"Channel", MakeLink<ChannelLink>, true}, {"Socket", MakeLink<SocketLink>, true},
+      {"Fifo", MakeLink<FifoLink>, true},       {"Port", MakeLink<PortLink>, true},
+      {"Futex", MakeLink<FutexLink>, false},
+  };
+
+  // Powers of two up to one pair per two CPUs, plus that maximum itself.
+  const uint32_t max_pairs = std::max(zx_system_get_num_cpus() / 2, 1u);
+  std::vector<uint32_t> pair_counts;
+  for (uint32_t pairs = 1; pairs < max_pairs; pairs *= 2) {
+    pair_counts.push_back(pairs);
+  }
+  pair_counts.push_back(max_pairs);
+
+  for (const Primitive& primitive : kPrimitives) {
+    for (Mode mode : {Mode::kPingPong, Mode::kStream}) {
+      if (mode == Mode::kStream && !primitive.streams)
+        continue;
+      for (uint32_t pairs : pair_counts) {
+        for (bool pinned : {false, true}) {
+          auto name = fbl::StringPrintf("IpcScaling/%s/%s/%upairs/%s", primitive.name,
+                                        mode == Mode::kPingPong ? "PingPong" : "Stream", pairs,
+                                        pinned ? "Pinned" : "Unpinned");
+          perftest::RegisterTest(name.c_str(), IpcScalingTest, primitive.make_link, mode, pairs,
+                                 pinned);
+        }
+      }
+    }
+  }
+}
+PERFTEST_CTOR(RegisterTests)
+
+}  // namespace
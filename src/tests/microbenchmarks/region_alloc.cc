@@ -0,0 +1,113 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+
+#include <fbl/alloc_checker.h>
+#include <fbl/string_printf.h>
+#include <perftest/perftest.h>
+#include <region-alloc/region-alloc.h>
+
+namespace {
+
+constexpr uint64_t kPageSize = 0x1000;
+constexpr size_t kPoolMaxMemory = 8 << 20;
+
+// Make an allocator whose available space is fragmented into |hole_count| page
+// sized regions which are not page aligned, a single page aligned page and a
+// large region, the way an IOVA or MMIO space looks after many small
+// allocations and frees.
+bool MakeFragmentedAllocator(RegionAllocator* alloc, uint32_t hole_count) {
+  for (uint64_t i = 0; i < hole_count; ++i) {
+    if (alloc->AddRegion({.base = (i * 2 * kPageSize) + (kPageSize / 2), .size = kPageSize}) !=
+        ZX_OK) {
+      return false;
+    }
+  }
+  const uint64_t end = uint64_t{hole_count} * 2 * kPageSize;
+  return alloc->AddRegion({.base = end + kPageSize, .size = kPageSize}) == ZX_OK &&
+         alloc->AddRegion({.base = end + 4 * kPageSize, .size = 1 << 30}) == ZX_OK;
+}
+
+// Measure the time taken to allocate a page aligned region of |size| out of a
+// fragmented allocator and to give it back.
+bool GetReleaseTest(perftest::RepeatState* state, uint32_t hole_count, uint64_t size) {
+  state->DeclareStep("get");
+  state->DeclareStep("release");
+  RegionAllocator alloc(RegionAllocator::RegionPool::Create(kPoolMaxMemory));
+  if (!MakeFragmentedAllocator(&alloc, hole_count)) {
+    return false;
+  }
+
+  while (state->KeepRunning()) {
+    RegionAllocator::Region::UPtr region;
+    if (alloc.GetRegion(size, kPageSize, region) != ZX_OK) {
+      return false;
+    }
+    state->NextStep();
+    region.reset();
+  }
+  return true;
+}
+
+// Measure the time taken to allocate |count| pages and to give them back, one
+// at a time or with the bulk APIs.
+template <bool kBulk>
+bool GetReleaseManyTest(perftest::RepeatState* state, uint32_t count) {
+  state->DeclareStep("get");
+  state->DeclareStep("release");
+  RegionAllocator alloc(RegionAllocator::RegionPool::Create(kPoolMaxMemory));
+  if (alloc.AddRegion({.base = 0, .size = 1 << 30}) != ZX_OK) {
+    return false;
+  }
+
+  fbl::AllocChecker ac;
+  std::unique_ptr<RegionAllocator::Region::UPtr[]> regions(new (&ac)
+                                                               RegionAllocator::Region::UPtr[count]);
+  if (!ac.check()) {
+    return false;
+  }
+
+  while (state->KeepRunning()) {
+    if constexpr (kBulk) {
+      if (alloc.GetRegions(kPageSize, kPageSize, count, regions.get()) != ZX_OK) {
+        return false;
+      }
+      state->NextStep();
+      alloc.ReleaseRegions(regions.get(), count);
+    } else {
+      for (uint32_t i = 0; i < count; ++i) {
+        if (alloc.GetRegion(kPageSize, kPageSize, regions[i]) != ZX_OK) {
+          return false;
+        }
+      }
+      state->NextStep();
+      for (uint32_t i = 0; i < count; ++i) {
+        regions[i].reset();
+      }
+    }
+  }
+  return true;
+}
+
+void RegisterTests() {
+  for (uint32_t hole_count : {16, 1024, 16384}) {
+    perftest::RegisterTest(
+        fbl::StringPrintf("RegionAlloc/GetRelease/ExactFit/%uholes", hole_count).c_str(),
+        GetReleaseTest, hole_count, kPageSize);
+    perftest::RegisterTest(
+        fbl::StringPrintf("RegionAlloc/GetRelease/Split/%uholes", hole_count).c_str(),
+        GetReleaseTest, hole_count, 2 * kPageSize);
+  }
+  for (uint32_t count : {16, 256}) {
+    perftest::RegisterTest(fbl::StringPrintf("RegionAlloc/GetReleaseMany/%u", count).c_str(),
+                           GetReleaseManyTest<false>, count);
+    perftest::RegisterTest(fbl::StringPrintf("RegionAlloc/GetReleaseMany/%u/Bulk", count).c_str(),
+                           GetReleaseManyTest<true>, count);
+  }
+}
+
+PERFTEST_CTOR(RegisterTests)
+
+}  // namespace
@@ -0,0 +1,110 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <zircon/syscalls-next.h>
+
+#include <perftest/perftest.h>
+
+#include "assert.h"
+
+#if defined(__x86_64__)
+
+// Restricted mode code that makes a syscall, and so returns to normal mode,
+// each time it is entered.
+asm(R"(
+.globl restricted_bench_syscall_loop
+restricted_bench_syscall_loop:
+0:
+  syscall
+  jmp 0b
+)");
+
+// Called in normal mode on return from restricted mode, with the context passed
+// to zx_restricted_enter() in rdi. Unwinds the stack back to the caller of
+// restricted_bench_enter() as though it had returned ZX_OK.
+asm(R"(
+.globl restricted_bench_vector
+restricted_bench_vector:
+  mov  %rdi,%rsp
+  pop  %rsp
+  pop  %r15
+  pop  %r14
+  pop  %r13
+  pop  %r12
+  pop  %rbp
+  pop  %rbx
+  xor  %rax,%rax
+  ret
+)");
+
+// Saves the callee saved registers, which are not preserved across restricted
+// mode, and enters restricted mode with the stack pointer as the context.
+asm(R"(
+.globl restricted_bench_enter
+restricted_bench_enter:
+  push  %rbx
+  push  %rbp
+  push  %r12
+  push  %r13
+  push  %r14
+  push  %r15
+  push  %rsp
+  mov   %rsp,%rdx
+  call  zx_restricted_enter
+  add   $(7*8),%rsp
+  ret
+)");
+
+extern "C" void restricted_bench_syscall_loop();
+extern "C" void restricted_bench_vector();
+extern "C" zx_status_t restricted_bench_enter(uint32_t options, uintptr_t vector_table);
+
+#endif  // defined(__x86_64__)
+
+namespace {
+
+// Measure the time taken to set the restricted mode register state.
+bool RestrictedWriteStateTest() {
+  zx_restricted_state state = {};
+  ASSERT_OK(zx_restricted_write_state(&state, sizeof(state)));
+  return true;
+}
+
+// Measure the time taken to read back the restricted mode register state.
+bool RestrictedReadStateTest() {
+  zx_restricted_state state;
+  ASSERT_OK(zx_restricted_read_state(&state, sizeof(state)));
+  perftest::DoNotOptimize(state);
+  return true;
+}
+
+#if defined(__x86_64__)
+
+// Measure the time taken to enter restricted mode and return to normal mode
+// because of a syscall made in restricted mode. This is the path taken for
+// every syscall of a program run in restricted mode.
+bool RestrictedEnterExitTest(perftest::RepeatState* state) {
+  zx_restricted_state regs = {};
+  regs.ip = reinterpret_cast<uint64_t>(restricted_bench_syscall_loop);
+  ASSERT_OK(zx_restricted_write_state(&regs, sizeof(regs)));
+
+  while (state->KeepRunning()) {
+    ASSERT_OK(restricted_bench_enter(0, reinterpret_cast<uintptr_t>(restricted_bench_vector)));
+  }
+  return true;
+}
+
+#endif  // defined(__x86_64__)
+
+void RegisterTests() {
+  perftest::RegisterSimpleTest<RestrictedWriteStateTest>("RestrictedMode/WriteState");
+  perftest::RegisterSimpleTest<RestrictedReadStateTest>("RestrictedMode/ReadState");
+#if defined(__x86_64__)
+  // Entering restricted mode is not implemented on other architectures yet.
+  perftest::RegisterTest("RestrictedMode/EnterExit", RestrictedEnterExitTest);
+#endif
+}
+PERFTEST_CTOR(RegisterTests)
+
+}  // namespace
@@ -4,7 +4,6 @@
 
 #include "round_trips.h"
 
-#include <fidl/fuchsia.scheduler/cpp/wire.h>
 #include <fuchsia/zircon/benchmarks/cpp/fidl.h>
 #include <lib/async-loop/cpp/loop.h>
 #include <lib/async-loop/default.h>
@@ -28,6 +27,7 @@
 #include "lib/fidl/cpp/binding.h"
 #include "src/lib/fxl/strings/string_number_conversions.h"
 #include "test_runner.h"
+#include "util.h"
 
 // This file measures two things:
 //
@@ -119,28 +119,6 @@ void ChannelServe(const zx::channel& channel, uint32_t count, uint32_t size) {
   }
 }
 
-// Set the CPU affinity for the current thread.  This allows setting
-// only the bottom 32 bits of the CPU affinity mask, but that is
-// enough for pinning threads to the same or different CPUs.
-void SetCpuAffinity(uint32_t cpu_mask) {
-  if (cpu_mask == 0)
-    return;
-
-  auto endpoints = fidl::CreateEndpoints<fuchsia_scheduler::ProfileProvider>();
-  ASSERT_OK(endpoints.status_value());
-  ASSERT_OK(fdio_service_connect_by_name(
-      fidl::DiscoverableProtocolName<fuchsia_scheduler::ProfileProvider>,
-      endpoints->server.channel().release()));
-  auto provider = std::move(endpoints->client);
-
-  fuchsia_scheduler::wire::CpuSet cpu_set = {};
-  cpu_set.mask[0] = cpu_mask;
-  auto result = fidl::WireCall(provider)->GetCpuAffinityProfile(cpu_set);
-  ASSERT_OK(result.status());
-  ASSERT_OK(result.value().status);
-  ASSERT_OK(zx::thread::self()->set_profile(result.value().profile, 0));
-}
-
 typedef void (*ThreadFunc)(std::vector<zx::handle>&& handles);
 ThreadFunc GetThreadFunc(const char* name);
 
@@ -186,7 +164,7 @@ class ThreadOrProcess {
       }
     } else {
       auto thread_func = [=](std::vector<zx::handle>&& handles) {
-        SetCpuAffinity(cpu_mask);
+        util::SetCpuAffinity(cpu_mask);
         GetThreadFunc(func_name)(std::move(handles));
       };
       thread_ = std::thread(thread_func, std::move(handles));
@@ -320,11 +298,12 @@ class ChannelPortTest {
 // uses zx_channel_call() for the send+wait+read.
 class ChannelCallTest {
  public:
-  explicit ChannelCallTest(MultiProc multiproc) {
+  explicit ChannelCallTest(MultiProc multiproc, uint32_t child_thread_cpu_mask = 0) {
     zx::channel server;
     ASSERT_OK(zx::channel::create(0, &server, &client_));
-    thread_or_process_.Launch("ChannelCallTest::ThreadFunc", MakeHandleVector(server.release()),
-                              multiproc);
+    thread_or_process_.LaunchWithCpuAffinity("ChannelCallTest::ThreadFunc",
+                                             MakeHandleVector(server.release()), multiproc,
+                                             child_thread_cpu_mask);
 
     msg_ = 0;
     args_.wr_bytes = reinterpret_cast<void*>(&msg_);
@@ -637,7 +616,7 @@ void CallWithCpuAffinity(uint32_t cpu_mask, std::function<void()> func) {
     func();
   } else {
     std::thread thread([=] {
-      SetCpuAffinity(cpu_mask);
+      util::SetCpuAffinity(cpu_mask);
       func();
     });
     thread.join();
@@ -720,9 +699,12 @@ void RegisterTests() {
   RegisterTestMultiProc<FidlTest>("RoundTrip_Fidl");
 
   // To avoid creating too many test instantiations and metrics, we
-  // only instantiate one of these tests for the same-CPU and
-  // different-CPU cases.
+  // only instantiate a few of these tests for the same-CPU and
+  // different-CPU cases.  zx_channel_call() is included because the
+  // cost of waking the caller with the reply depends on whether the
+  // server runs on the same CPU.
   RegisterTestMultiProcSameDiffCpu<ChannelPortTest>("RoundTrip_ChannelPort");
+  RegisterTestMultiProcSameDiffCpu<ChannelCallTest>("RoundTrip_ChannelCall");
 }
 PERFTEST_CTOR(RegisterTests)
 
@@ -742,7 +724,7 @@ void RunSubprocess(const char* func_name, const char* cpu_mask_arg) {
 
   uint32_t cpu_mask;
   FX_CHECK(fxl::StringToNumberWithError(cpu_mask_arg, &cpu_mask));
-  SetCpuAffinity(cpu_mask);
+  util::SetCpuAffinity(cpu_mask);
 
   func(std::move(handles));
 }
@@ -4,9 +4,14 @@
 
 #include "util.h"
 
+#include <fidl/fuchsia.scheduler/cpp/wire.h>
+#include <lib/fdio/directory.h>
+#include <lib/zx/thread.h>
+
 #include <algorithm>
 #include <random>
 
+#include "assert.h"
 #include "src/lib/fxl/strings/string_printf.h"
 
 namespace util {
@@ -22,4 +27,23 @@ std::vector<std::string> MakeDeterministicNamesList(size_t length) {
   return ret;
 }
 
+void SetCpuAffinity(uint32_t cpu_mask) {
+  if (cpu_mask == 0)
+    return;
+
+  auto endpoints = fidl::CreateEndpoints<fuchsia_scheduler::ProfileProvider>();
+  ASSERT_OK(endpoints.status_value());
+  ASSERT_OK(fdio_service_connect_by_name(
+      fidl::DiscoverableProtocolName<fuchsia_scheduler::ProfileProvider>,
+      endpoints->server.channel().release()));
+  auto provider = std::move(endpoints->client);
+
+  fuchsia_scheduler::wire::CpuSet cpu_set = {};
+  cpu_set.mask[0] = cpu_mask;
+  auto result = fidl::WireCall(provider)->GetCpuAffinityProfile(cpu_set);
+  ASSERT_OK(result.status());
+  ASSERT_OK(result.value().status);
+  ASSERT_OK(zx::thread::self()->set_profile(result.value().profile, 0));
+}
+
 }  // namespace util
@@ -5,12 +5,20 @@
 #ifndef SRC_TESTS_MICROBENCHMARKS_UTIL_H_
 #define SRC_TESTS_MICROBENCHMARKS_UTIL_H_
 
+#include <cstdint>
+#include <string>
 #include <vector>
 
 namespace util {
 
 std::vector<std::string> MakeDeterministicNamesList(size_t length);
 
+// Set the CPU affinity for the current thread.  This allows setting
+// only the bottom 32 bits of the CPU affinity mask, but that is
+// enough for pinning threads to the same or different CPUs.  A mask
+// of 0 leaves the affinity unchanged.
+void SetCpuAffinity(uint32_t cpu_mask);
+
 }  // namespace util
 
 #endif  // SRC_TESTS_MICROBENCHMARKS_UTIL_H_
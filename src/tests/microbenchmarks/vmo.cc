@@ -269,6 +269,39 @@ bool VmoCloneReadOrWriteTest(perftest::RepeatState* state, uint32_t copy_size, b
   return true;
 }
 
+// Measure the time taken to fault in pages of the last clone in a chain of |depth| nested snapshot
+// clones, where every clone in the chain stays open. Each fault has to look up the page through the
+// hidden parents of the chain, so this shows how fault latency scales with clone history.
+bool VmoCloneChainFaultTest(perftest::RepeatState* state, uint32_t copy_size, uint32_t depth) {
+  const size_t kPageSize = zx_system_get_page_size();
+  state->DeclareStep("map");
+  state->DeclareStep("fault");
+  state->DeclareStep("unmap");
+
+  std::vector<zx::vmo> chain(depth + 1);
+  ASSERT_OK(zx::vmo::create(copy_size, 0, &chain[0]));
+  ASSERT_OK(chain[0].op_range(ZX_VMO_OP_COMMIT, 0, copy_size, nullptr, 0));
+  for (uint32_t i = 1; i <= depth; i++) {
+    ASSERT_OK(chain[i - 1].create_child(ZX_VMO_CHILD_SNAPSHOT, 0, copy_size, &chain[i]));
+  }
+
+  while (state->KeepRunning()) {
+    zx_vaddr_t addr = 0;
+    ASSERT_OK(zx::vmar::root_self()->map(ZX_VM_PERM_READ, 0, chain[depth], 0, copy_size, &addr));
+    state->NextStep();
+
+    auto p = reinterpret_cast<volatile uint8_t*>(addr);
+    for (size_t offset = 0; offset < copy_size; offset += kPageSize) {
+      p[offset];
+    }
+    state->NextStep();
+
+    ASSERT_OK(zx::vmar::root_self()->unmap(addr, copy_size));
+  }
+
+  return true;
+}
+
 // Measure the times taken to create, write and then read some data from a VMO on a single thread.
 // This is used to measure the performance of a brand new VMO's entire lifecycle up to data read
 // completion time. This test is useful because this is essentially what users of `fuchsia.mem.Data`
@@ -374,6 +407,11 @@ void RegisterTests() {
     }
   }
 
+  for (uint32_t depth : {1, 8, 64}) {
+    name = fbl::StringPrintf("Vmo/CloneChain%u/Fault", depth);
+    RegisterVmoTest(name.c_str(), VmoCloneChainFaultTest, depth);
+  }
+
   name = fbl::StringPrintf("Vmo/CreateWriteReadClose");
   RegisterVmoTest(name.c_str(), VmoCreateWriteReadCloseTest);
 }
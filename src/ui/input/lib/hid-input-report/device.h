@@ -36,7 +36,7 @@ enum class DeviceType : uint32_t {
 };
 
 template <typename T>
-fidl::ObjectView<T> Extract(const uint8_t* data, size_t len, hid::Attributes attr,
+fidl::ObjectView<T> Extract(const uint8_t* data, size_t len, const hid::Attributes& attr,
                             fidl::AnyArena& allocator) {
   double value;
   if (!hid::ExtractAsUnitType(data, len, attr, &value)) {
@@ -6,6 +6,8 @@
 
 #include <stdint.h>
 
+#include <array>
+
 #include <hid-parser/parser.h>
 #include <hid-parser/report.h>
 #include <hid-parser/units.h>
@@ -361,35 +363,27 @@ ParseResult Touch::ParseInputReportInternal(const uint8_t* data, size_t len,
   }
   fuchsia_input_report::wire::TouchInputReport touch(allocator);
 
-  // Calculate the number of active contacts.
+  // Find the active contacts up front, so that only as many contacts as are reported get allocated.
+  // A contact is active unless its tip switch reads as zero.
+  std::array<bool, fuchsia_input_report::wire::kTouchMaxContacts> active_contacts;
   size_t num_active_contacts = 0;
   for (size_t i = 0; i < num_contacts_; i++) {
-    if (!contacts_[i].tip_switch) {
-      num_active_contacts = num_contacts_;
-      break;
-    }
-    double val_out_double;
-    if (!ExtractAsUnitType(data, len, *contacts_[i].tip_switch, &val_out_double)) {
-      continue;
-    }
-    if (static_cast<uint32_t>(val_out_double) != 0) {
+    double val_out;
+    active_contacts[i] = !contacts_[i].tip_switch ||
+                         !ExtractAsUnitType(data, len, *contacts_[i].tip_switch, &val_out) ||
+                         static_cast<uint32_t>(val_out) != 0;
+    if (active_contacts[i]) {
       num_active_contacts++;
     }
   }
 
   fidl::VectorView<fuchsia_input_report::wire::ContactInputReport> input_contacts(
-      allocator, num_active_contacts, num_contacts_);
+      allocator, num_active_contacts);
 
   size_t contact_index = 0;
   for (size_t i = 0; i < num_contacts_; i++) {
-    double val_out;
-
-    if (contacts_[i].tip_switch) {
-      if (ExtractAsUnitType(data, len, *contacts_[i].tip_switch, &val_out)) {
-        if (static_cast<uint32_t>(val_out) == 0) {
-          continue;
-        }
-      }
+    if (!active_contacts[i]) {
+      continue;
     }
 
     fuchsia_input_report::wire::ContactInputReport contact(allocator);
@@ -254,7 +254,8 @@ void RectangleCompositor::DrawBatch(CommandBuffer* cmd_buf,
                                     const std::vector<const TexturePtr>& textures,
                                     const std::vector<ColorData>& color_data,
                                     const ImagePtr& output_image, const TexturePtr& depth_buffer,
-                                    bool apply_color_conversion) {
+                                    bool apply_color_conversion,
+                                    std::optional<vk::Rect2D> render_area) {
   // TODO(fxbug.dev/43278): Add custom clear colors. We could either pass in another parameter to
   // this function or try to embed clear-data into the existing api. For example, one could
   // check to see if the back rectangle is fullscreen and solid-color, in which case we can
@@ -265,9 +266,12 @@ void RectangleCompositor::DrawBatch(CommandBuffer* cmd_buf,
   FX_CHECK(rectangles.size() == textures.size());
   FX_CHECK(rectangles.size() == color_data.size());
 
-  // Initialize the render pass.
+  // Initialize the render pass. Attachments are only cleared and stored within the render area, and
+  // the scissor is set to it, so the rest of the output image is left untouched.
   RenderPassInfo render_pass;
-  vk::Rect2D render_area = {{0, 0}, {output_image->width(), output_image->height()}};
+  if (!render_area) {
+    render_area = vk::Rect2D({0, 0}, {output_image->width(), output_image->height()});
+  }
 
   // Construct the bounds that are used in the vertex shader to convert the
   // renderable positions into normalized device coordinates (NDC). The width
@@ -280,7 +284,7 @@ void RectangleCompositor::DrawBatch(CommandBuffer* cmd_buf,
   // If we don't have any color conversion data, stick to a single subpass.
   if (!apply_color_conversion) {
     // Setup a standard 1-pass renderpass where we render directly into the output image.
-    if (!RenderPassInfo::InitRenderPassInfo(&render_pass, render_area, output_image,
+    if (!RenderPassInfo::InitRenderPassInfo(&render_pass, *render_area, output_image,
                                             depth_buffer)) {
       FX_LOGS(ERROR) << "RectangleCompositor::DrawBatch(): RenderPassInfo initialization failed. "
                         "Exiting.";
@@ -305,7 +309,7 @@ void RectangleCompositor::DrawBatch(CommandBuffer* cmd_buf,
     // we try to use a transient buffer to avoid flushing memory from GPU caches to GPU-external
     // memory) and then use that as an input attachment for the output pass, where we finally
     // apply color correction.
-    if (!SetupColorConversionDualPass(&render_pass, render_area, transient_image, output_image,
+    if (!SetupColorConversionDualPass(&render_pass, *render_area, transient_image, output_image,
                                       depth_buffer)) {
       FX_LOGS(ERROR) << "RectangleCompositor::DrawBatch(): RenderPassInfo initialization failed. "
                         "Exiting.";
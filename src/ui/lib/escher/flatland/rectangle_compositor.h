@@ -5,6 +5,8 @@
 #ifndef SRC_UI_LIB_ESCHER_FLATLAND_RECTANGLE_COMPOSITOR_H_
 #define SRC_UI_LIB_ESCHER_FLATLAND_RECTANGLE_COMPOSITOR_H_
 
+#include <optional>
+
 #include "src/ui/lib/escher/flatland/flatland_static_config.h"
 #include "src/ui/lib/escher/forward_declarations.h"
 #include "src/ui/lib/escher/util/hash_map.h"
@@ -46,13 +48,16 @@ class RectangleCompositor {
   // - depth_buffer: The depth texture to be used for z-buffering.
   // - apply_color_conversion: Does a color conversion pass over the rendered output
   //   using the data set with |SetColorConversionParams|.
+  // - render_area: If set, only the pixels within this area are rendered, and the rest of
+  //   |output_image| keeps its content. Defaults to the whole |output_image|.
   //
   // Depth is implicit. Renderables are drawn in the order they appear in the input
   // vector, with the first entry being the furthest back, and the last the closest.
   void DrawBatch(CommandBuffer* cmd_buf, const std::vector<Rectangle2D>& rectangles,
                  const std::vector<const TexturePtr>& textures,
                  const std::vector<ColorData>& color_data, const ImagePtr& output_image,
-                 const TexturePtr& depth_buffer, bool apply_color_conversion = false);
+                 const TexturePtr& depth_buffer, bool apply_color_conversion = false,
+                 std::optional<vk::Rect2D> render_area = std::nullopt);
 
   // This data is used to apply a color-conversion post processing effect over the entire
   // rendered output, when making a call to |DrawBatch|. The color conversion formula
@@ -73,6 +73,14 @@ scenic_impl::ConfigValues GetConfig(sys::ComponentContext* app_context) {
             values.pointer_auto_focus_on = value.boolval();
           },
       },
+      {
+          "touch_batch_interval_in_us",
+          [&values](auto& key, auto& value) {
+            FX_CHECK(value.is_intval()) << key << " must be an integer";
+            FX_CHECK(value.intval() >= 0) << key << " must be greater than 0";
+            values.touch_batch_interval = zx::usec(value.intval());
+          },
+      },
       {
           "flatland_buffer_collection_import_mode",
           [&values](auto& key, auto& value) {
@@ -170,6 +178,7 @@ scenic_impl::ConfigValues GetConfig(sys::ComponentContext* app_context) {
   FX_LOGS(INFO) << "i_can_haz_flatland: " << values.i_can_haz_flatland;
   FX_LOGS(INFO) << "enable_allocator_for_flatland: " << values.enable_allocator_for_flatland;
   FX_LOGS(INFO) << "Scenic pointer auto focus: " << values.pointer_auto_focus_on;
+  FX_LOGS(INFO) << "Scenic touch_batch_interval(us): " << values.touch_batch_interval.to_usecs();
   FX_LOGS(INFO) << "flatland_buffer_collection_import_mode: "
                 << StringFromBufferCollectionImportMode(
                        values.flatland_buffer_collection_import_mode);
@@ -644,7 +653,8 @@ void App::InitializeInput() {
           const zx_koid_t request = koid != ZX_KOID_INVALID ? koid : requestor;
           focus_manager_->RequestFocus(requestor, request);
         }
-      });
+      },
+      config_values_.touch_batch_interval);
   FX_DCHECK(input_);
   scenic_->SetRegisterTouchSource(
       [this](fidl::InterfaceRequest<fuchsia::ui::pointer::TouchSource> touch_source,
@@ -74,6 +74,9 @@ struct ConfigValues {
 #endif  // USE_FLATLAND_BY_DEFAULT
   bool enable_allocator_for_flatland = true;
   bool pointer_auto_focus_on = true;
+  // How long touch movements are held back so that they reach clients in batches. Zero disables
+  // batching.
+  zx::duration touch_batch_interval = zx::duration(0);
   flatland::BufferCollectionImportMode flatland_buffer_collection_import_mode =
       flatland::BufferCollectionImportMode::RendererOnly;
   // TODO(fxb/76985): Remove these when we have proper multi-display support.
@@ -9,6 +9,7 @@
 #include <lib/trace/event.h>
 #include <zircon/pixelformat.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
@@ -96,6 +97,62 @@ fuchsia::hardware::display::AlphaMode GetAlphaMode(
   return alpha_mode;
 }
 
+// Returns true if the display controller is given the same layer configs for |a| and |b|, i.e. if
+// the frames only differ in which of the images of the same buffer collections they show.
+bool IsSameLayerLayout(const RenderData& a, const RenderData& b) {
+  if (a.display_id != b.display_id || a.rectangles != b.rectangles ||
+      a.images.size() != b.images.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.images.size(); ++i) {
+    const auto& image_a = a.images[i];
+    const auto& image_b = b.images[i];
+    if (image_a.collection_id != image_b.collection_id ||
+        (image_a.identifier == allocation::kInvalidImageId) !=
+            (image_b.identifier == allocation::kInvalidImageId) ||
+        image_a.width != image_b.width || image_a.height != image_b.height ||
+        image_a.blend_mode != image_b.blend_mode ||
+        image_a.multiply_color != image_b.multiply_color) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns the bounding box of |a| and |b|. Empty rectangles are ignored.
+fuchsia::math::Rect UnionRects(const fuchsia::math::Rect& a, const fuchsia::math::Rect& b) {
+  if (a.width <= 0 || a.height <= 0) {
+    return b;
+  }
+  if (b.width <= 0 || b.height <= 0) {
+    return a;
+  }
+  const int32_t x = std::min(a.x, b.x);
+  const int32_t y = std::min(a.y, b.y);
+  return {.x = x,
+          .y = y,
+          .width = std::max(a.x + a.width, b.x + b.width) - x,
+          .height = std::max(a.y + a.height, b.y + b.height) - y};
+}
+
+// Returns the part of |rect| which lies within a |width| x |height| image.
+fuchsia::math::Rect ClampRectToImage(const fuchsia::math::Rect& rect, uint32_t width,
+                                     uint32_t height) {
+  const int32_t x = std::clamp(rect.x, 0, static_cast<int32_t>(width));
+  const int32_t y = std::clamp(rect.y, 0, static_cast<int32_t>(height));
+  return {.x = x,
+          .y = y,
+          .width = std::clamp(rect.x + rect.width, x, static_cast<int32_t>(width)) - x,
+          .height = std::clamp(rect.y + rect.height, y, static_cast<int32_t>(height)) - y};
+}
+
+fuchsia::math::Rect FullImageRect(const allocation::ImageMetadata& image) {
+  return {.x = 0,
+          .y = 0,
+          .width = static_cast<int32_t>(image.width),
+          .height = static_cast<int32_t>(image.height)};
+}
+
 }  // anonymous namespace
 
 DisplayCompositor::DisplayCompositor(
@@ -456,6 +513,98 @@ bool DisplayCompositor::SetRenderDataOnDisplay(const RenderData& data) {
   return true;
 }
 
+DisplayCompositor::LayoutCheckResults& DisplayCompositor::GetLayoutCheckResults(
+    const RenderData& data) {
+  auto it = display_engine_data_map_.find(data.display_id);
+  FX_DCHECK(it != display_engine_data_map_.end());
+  auto& results = it->second.layout_check_results;
+  if (!results || !IsSameLayerLayout(results->layout, data)) {
+    results = LayoutCheckResults{.layout = data};
+  }
+  return *results;
+}
+
+uint32_t DisplayCompositor::SetHybridRenderDataOnDisplay(
+    const RenderData& data, const allocation::ImageMetadata& render_target,
+    const FrameEventData& event_data, bool cache_result) {
+  TRACE_DURATION("gfx", "flatland::DisplayCompositor::SetHybridRenderDataOnDisplay");
+  const uint32_t num_images = static_cast<uint32_t>(data.images.size());
+  std::vector<uint64_t> layers;
+  {
+    std::unique_lock<std::mutex> lock(lock_);
+    auto it = display_engine_data_map_.find(data.display_id);
+    FX_DCHECK(it != display_engine_data_map_.end());
+    layers = it->second.layers;
+  }
+  if (layers.size() < 2 || num_images < 2) {
+    return 0;
+  }
+
+  // The GPU composited rectangles go on the backmost layer, so only the topmost rectangles can be
+  // moved to hardware layers without changing the order in which rectangles are blended.
+  auto& results = GetLayoutCheckResults(data);
+  uint32_t max_hardware_layers =
+      std::min(static_cast<uint32_t>(layers.size()) - 1, num_images - 1);
+  if (results.max_hardware_layers) {
+    max_hardware_layers = std::min(max_hardware_layers, *results.max_hardware_layers);
+  }
+
+  uint32_t num_candidates = 0;
+  bool image_in_use = false;
+  for (; num_candidates < max_hardware_layers; ++num_candidates) {
+    const auto& image = data.images[num_images - 1 - num_candidates];
+
+    // Solid color rectangles can only be composited by the display as the backmost layer, see
+    // SetRenderDataOnDisplay().
+    if (image.identifier == allocation::kInvalidImageId ||
+        !buffer_collection_supports_display_[image.collection_id]) {
+      break;
+    }
+
+    // An image which the display is still reading from cannot be used again.
+    const auto event_kv = image_event_map_.find(image.identifier);
+    if (event_kv != image_event_map_.end() &&
+        event_kv->second.signal_event.wait_one(ZX_EVENT_SIGNALED, zx::time(), nullptr) != ZX_OK) {
+      image_in_use = true;
+      break;
+    }
+  }
+
+  // Greedily assign as many rectangles as possible to hardware layers, and one fewer each time the
+  // display controller rejects the config.
+  const glm::vec2 render_target_extent(render_target.width, render_target.height);
+  uint32_t num_hardware_layers = num_candidates;
+  for (; num_hardware_layers > 0; --num_hardware_layers) {
+    const uint32_t first_hardware_image = num_images - num_hardware_layers;
+    const auto active_layers_end = layers.begin() + num_hardware_layers + 1;
+    SetDisplayLayers(data.display_id, std::vector<uint64_t>(layers.begin(), active_layers_end));
+    ApplyLayerImage(layers[0], {glm::vec2(0), render_target_extent}, render_target,
+                    event_data.wait_id, event_data.signal_id);
+    for (uint32_t i = first_hardware_image; i < num_images; ++i) {
+      const auto& image = data.images[i];
+      if (image_event_map_.find(image.identifier) == image_event_map_.end()) {
+        image_event_map_[image.identifier] = NewImageEventData();
+      }
+      ApplyLayerImage(layers[i - first_hardware_image + 1], data.rectangles[i], image,
+                      /*wait_id*/ 0, /*signal_id*/ image_event_map_[image.identifier].signal_id);
+    }
+
+    auto [result, /*ops*/ _] = CheckConfig();
+    if (result == fuchsia::hardware::display::ConfigResult::OK) {
+      for (uint32_t i = first_hardware_image; i < num_images; ++i) {
+        pending_images_in_config_.push_back(data.images[i].identifier);
+      }
+      break;
+    }
+  }
+
+  // A busy image only limits this frame, so the result does not hold for the layout.
+  if (cache_result && !image_in_use) {
+    results.max_hardware_layers = num_hardware_layers;
+  }
+  return num_hardware_layers;
+}
+
 void DisplayCompositor::ApplyLayerColor(uint32_t layer_id, escher::Rectangle2D rectangle,
                                         allocation::ImageMetadata image) {
   std::unique_lock<std::mutex> lock(lock_);
@@ -583,13 +732,31 @@ void DisplayCompositor::RenderFrame(uint64_t frame_number, zx::time presentation
   // Config should be reset before doing anything new.
   DiscardConfig();
 
+  // Every render target of a display has to be updated with the damage of this frame the next
+  // time it is rendered into, regardless of how this frame is composited.
+  for (auto& data : render_data_list) {
+    const auto it = display_engine_data_map_.find(data.display_id);
+    if (it == display_engine_data_map_.end()) {
+      continue;
+    }
+    auto& display_engine_data = it->second;
+    for (size_t i = 0; i < display_engine_data.target_damage.size(); ++i) {
+      const auto& target = display_engine_data.targets[i];
+      display_engine_data.target_damage[i] =
+          data.damage ? UnionRects(display_engine_data.target_damage[i],
+                                   ClampRectToImage(*data.damage, target.width, target.height))
+                      : FullImageRect(target);
+    }
+  }
+
   // Create and set layers, one per image/rectangle, set the layer images and the layer transforms.
   // Afterwards we check the config, if it fails for whatever reason, such as there being too many
   // layers, then we fall back to software composition.
   bool hardware_fail = false;
   if (!kDisableDisplayComposition) {
     for (auto& data : render_data_list) {
-      if (!SetRenderDataOnDisplay(data)) {
+      // Skip the direct scanout if the display controller already rejected it for this layout.
+      if (GetLayoutCheckResults(data).direct_scanout_rejected || !SetRenderDataOnDisplay(data)) {
         // TODO(fxbug.dev/77416): just because setting the data on one display fails (e.g. due to
         // too many layers), that doesn't mean that all displays need to use GPU-composition.  Some
         // day we might want to use GPU-composition for some client images, and direct-scanout for
@@ -616,6 +783,11 @@ void DisplayCompositor::RenderFrame(uint64_t frame_number, zx::time presentation
   } else {
     auto [result, ops] = CheckConfig();
     fallback_to_gpu_composition = (result != fuchsia::hardware::display::ConfigResult::OK);
+
+    // The result of a config for several displays cannot be attributed to the layout of any one.
+    if (fallback_to_gpu_composition && render_data_list.size() == 1) {
+      GetLayoutCheckResults(render_data_list[0]).direct_scanout_rejected = true;
+    }
   }
 
   // If the results are not okay, we have to do GPU composition using the renderer.
@@ -631,6 +803,10 @@ void DisplayCompositor::RenderFrame(uint64_t frame_number, zx::time presentation
     // frame.
     zx::event render_finished_fence = utils::CreateEvent();
 
+    // Whether any client images are scanned out from hardware layers, next to the GPU composited
+    // ones.
+    bool uses_hardware_layers = false;
+
     for (size_t i = 0; i < render_data_list.size(); ++i) {
       const bool is_final_display = (i + 1 == render_data_list.size());
       const auto& data = render_data_list[i];
@@ -670,34 +846,67 @@ void DisplayCompositor::RenderFrame(uint64_t frame_number, zx::time presentation
       event_data.wait_event.signal(ZX_EVENT_SIGNALED, 0);
       event_data.signal_event.signal(ZX_EVENT_SIGNALED, 0);
 
+      // Move as many of the topmost rectangles as possible to hardware layers; only the rest are
+      // GPU composited.
+      const uint32_t num_hardware_layers =
+          kDisableDisplayComposition
+              ? 0
+              : SetHybridRenderDataOnDisplay(data, render_target, event_data,
+                                             /*cache_result*/ render_data_list.size() == 1);
+      uses_hardware_layers |= num_hardware_layers > 0;
+      const size_t num_gpu_images = data.images.size() - num_hardware_layers;
+      const std::vector<Rectangle2D> rectangles(data.rectangles.begin(),
+                                                data.rectangles.begin() + num_gpu_images);
+      std::vector<allocation::ImageMetadata> images(data.images.begin(),
+                                                    data.images.begin() + num_gpu_images);
+
       // Apply the debugging color to the images.
 #ifdef VISUAL_DEBUGGING_ENABLED
-      auto images = data.images;
       for (auto& image : images) {
         image.multiply_color[0] *= kDebugColor[0];
         image.multiply_color[1] *= kDebugColor[1];
         image.multiply_color[2] *= kDebugColor[2];
         image.multiply_color[3] *= kDebugColor[3];
       }
-#else
-      auto& images = data.images;
 #endif  // VISUAL_DEBUGGING_ENABLED
 
+      // The render target keeps the content it was last rendered with, so only the region which
+      // changed since then needs to be rendered again. A hybrid frame leaves out the rectangles on
+      // hardware layers, so the target has to be rendered completely the next time.
+      auto& target_damage = display_engine_data.target_damage[curr_vmo];
+      const auto render_area = target_damage;
+      target_damage =
+          num_hardware_layers > 0 ? FullImageRect(render_target) : fuchsia::math::Rect{};
+      const auto render = [&](const std::vector<zx::event>& fences) {
+        if (num_hardware_layers == 0 && render_area.width > 0 && render_area.height > 0 &&
+            (render_area.width < static_cast<int32_t>(render_target.width) ||
+             render_area.height < static_cast<int32_t>(render_target.height))) {
+          renderer_->RenderRegion(render_target, render_area, rectangles, images, fences);
+        } else {
+          renderer_->Render(render_target, rectangles, images, fences);
+        }
+      };
+
       std::vector<zx::event> render_fences;
       render_fences.push_back(std::move(event_data.wait_event));
       // Only add render_finished_fence if we're rendering the final display's framebuffer.
       if (is_final_display) {
         render_fences.push_back(std::move(render_finished_fence));
-        renderer_->Render(render_target, data.rectangles, images, render_fences);
+        render(render_fences);
         // Retrieve fence.
         render_finished_fence = std::move(render_fences.back());
       } else {
-        renderer_->Render(render_target, data.rectangles, images, render_fences);
+        render(render_fences);
       }
 
       // Retrieve fence.
       event_data.wait_event = std::move(render_fences[0]);
 
+      // The layers of a hybrid frame have already been set and checked.
+      if (num_hardware_layers > 0) {
+        continue;
+      }
+
       auto layer = display_engine_data.layers[0];
       SetDisplayLayers(data.display_id, {layer});
       ApplyLayerImage(layer, {glm::vec2(0), glm::vec2(render_target.width, render_target.height)},
@@ -712,10 +921,20 @@ void DisplayCompositor::RenderFrame(uint64_t frame_number, zx::time presentation
       }
     }
 
-    // See ReleaseFenceManager comments for details.
-    FX_DCHECK(render_finished_fence);
-    release_fence_manager_.OnGpuCompositedFrame(frame_number, std::move(render_finished_fence),
-                                                std::move(release_fences), std::move(callback));
+    if (uses_hardware_layers) {
+      // Client images on hardware layers are read by the display until the next frame is on
+      // screen, so the whole frame has to be released like a direct-scanout frame.
+      for (auto id : pending_images_in_config_) {
+        image_event_map_[id].signal_event.signal(ZX_EVENT_SIGNALED, 0);
+      }
+      release_fence_manager_.OnDirectScanoutFrame(frame_number, std::move(release_fences),
+                                                  std::move(callback));
+    } else {
+      // See ReleaseFenceManager comments for details.
+      FX_DCHECK(render_finished_fence);
+      release_fence_manager_.OnGpuCompositedFrame(frame_number, std::move(render_finished_fence),
+                                                  std::move(release_fences), std::move(callback));
+    }
   } else {
     // Unsignal image events before applying config.
     for (auto id : pending_images_in_config_) {
@@ -931,6 +1150,7 @@ allocation::GlobalBufferCollectionId DisplayCompositor::AddDisplay(
                                         .height = height};
     display_engine_data.frame_event_datas.push_back(NewFrameEventData());
     display_engine_data.targets.push_back(target);
+    display_engine_data.target_damage.push_back(FullImageRect(target));
     bool res = ImportBufferImage(target, BufferCollectionUsage::kRenderTarget);
     FX_DCHECK(res);
   }
@@ -952,6 +1172,13 @@ void DisplayCompositor::SetColorConversionValues(const std::array<float, 9>& coe
                                            (preoffsets != kDefaultColorConversionOffsets) ||
                                            (postoffsets != kDefaultColorConversionOffsets);
   renderer_->SetColorConversionValues(coefficients, preoffsets, postoffsets);
+
+  // The content of the render targets was rendered with the old values.
+  for (auto& [_, display_engine_data] : display_engine_data_map_) {
+    for (size_t i = 0; i < display_engine_data.target_damage.size(); ++i) {
+      display_engine_data.target_damage[i] = FullImageRect(display_engine_data.targets[i]);
+    }
+  }
 }
 
 bool DisplayCompositor::SetMinimumRgb(uint8_t minimum_rgb) {
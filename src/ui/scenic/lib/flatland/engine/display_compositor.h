@@ -10,6 +10,7 @@
 
 #include <deque>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 
 #include "src/lib/fxl/memory/weak_ptr.h"
@@ -141,6 +142,20 @@ class DisplayCompositor final : public allocation::BufferCollectionImporter,
     zx::event signal_event;
   };
 
+  // The CheckConfig() results for a layout of layers on a display. These stay valid for as long as
+  // the layout does not change, so that each frame does not retry the configs which the display
+  // controller is known to reject.
+  struct LayoutCheckResults {
+    RenderData layout;
+
+    // Whether scanning out every rectangle directly from hardware layers was rejected.
+    bool direct_scanout_rejected = false;
+
+    // The largest number of topmost rectangles which were accepted on hardware layers, above a
+    // layer with the rest GPU composited, if this has been checked.
+    std::optional<uint32_t> max_hardware_layers;
+  };
+
   struct DisplayEngineData {
     // The hardware layers we've created to use on this display.
     std::vector<uint64_t> layers;
@@ -155,8 +170,14 @@ class DisplayCompositor final : public allocation::BufferCollectionImporter,
     // The information used to create images for each render target from the vmo data.
     std::vector<allocation::ImageMetadata> targets;
 
+    // For each render target, the region whose content changed since it was last rendered into.
+    std::vector<fuchsia::math::Rect> target_damage;
+
     // Used to synchronize buffer rendering with setting the buffer on the display.
     std::vector<FrameEventData> frame_event_datas;
+
+    // The CheckConfig() results for the layout of the last frame, see GetLayoutCheckResults().
+    std::optional<LayoutCheckResults> layout_check_results;
   };
 
   // Generates a new FrameEventData struct to be used with a render target on a display.
@@ -174,6 +195,20 @@ class DisplayCompositor final : public allocation::BufferCollectionImporter,
   // be completed.
   bool SetRenderDataOnDisplay(const RenderData& data);
 
+  // Returns the CheckConfig() results for the layout of |data|, which are reset whenever the
+  // layout of the display changes.
+  LayoutCheckResults& GetLayoutCheckResults(const RenderData& data);
+
+  // Sets up the display for GPU composition of the bottommost rectangles of |data| into
+  // |render_target|, with as many of the topmost rectangles as the display controller accepts
+  // composited on hardware layers above it. Returns the number of rectangles assigned to hardware
+  // layers; if this is zero, nothing has been set on the display. The result is only kept for the
+  // layout if |cache_result|, as CheckConfig() results for configs which span several displays
+  // cannot be attributed to the layout of any one of them.
+  uint32_t SetHybridRenderDataOnDisplay(const RenderData& data,
+                                        const allocation::ImageMetadata& render_target,
+                                        const FrameEventData& event_data, bool cache_result);
+
   // Sets the provided layers onto the display referenced by the given display_id.
   void SetDisplayLayers(uint64_t display_id, const std::vector<uint64_t>& layers);
 
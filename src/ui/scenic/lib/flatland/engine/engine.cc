@@ -20,6 +20,7 @@
 #include <sstream>
 #include <string>
 #include <unordered_set>
+#include <utility>
 
 // Hardcoded double buffering.
 // TODO(fxbug.dev/76640): make this configurable.  Even fancier: is it worth considering sharing a
@@ -75,7 +76,7 @@ void Engine::RenderScheduledFrame(uint64_t frame_number, zx::time presentation_t
   FX_CHECK(frame_number == last_rendered_frame_ + 1);
   last_rendered_frame_ = frame_number;
 
-  SceneState scene_state(*this, display.root_transform());
+  SceneState scene_state(*this, display.root_transform(), std::exchange(last_frame_, std::nullopt));
   const auto hw_display = display.display();
 
 #if defined(USE_FLATLAND_VERBOSE_LOGGING)
@@ -120,14 +121,28 @@ void Engine::RenderScheduledFrame(uint64_t frame_number, zx::time presentation_t
                                      /*num_vmos*/ kNumDisplayFramebuffers, &render_target_info);
   }
 
+  // Culling drops the instance of each rectangle, so the next frame's damage is computed from the
+  // unculled rectangles.
+  auto unculled_images = scene_state.images;
+  auto unculled_rectangles = scene_state.image_rectangles;
   CullRectangles(&scene_state.image_rectangles, &scene_state.images, hw_display->width_in_px(),
                  hw_display->height_in_px());
 
   flatland_compositor_->RenderFrame(frame_number, presentation_time,
                                     {{.rectangles = std::move(scene_state.image_rectangles),
                                       .images = std::move(scene_state.images),
-                                      .display_id = hw_display->display_id()}},
+                                      .display_id = hw_display->display_id(),
+                                      .damage = scene_state.damage}},
                                     flatland_presenter_->TakeReleaseFences(), std::move(callback));
+
+  last_frame_ = LastFrame{.root_transform = display.root_transform(),
+                          .snapshot = std::move(scene_state.snapshot),
+                          .links = std::move(scene_state.links),
+                          .topology_data = std::move(scene_state.topology_data),
+                          .global_matrices = std::move(scene_state.global_matrices),
+                          .images = std::move(unculled_images),
+                          .image_rectangles = std::move(unculled_rectangles),
+                          .image_instances = std::move(scene_state.image_instances)};
 }
 
 view_tree::SubtreeSnapshot Engine::GenerateViewTreeSnapshot(
@@ -167,16 +182,29 @@ Renderables Engine::GetRenderables(const FlatlandDisplay& display) {
   return std::make_pair(std::move(scene_state.image_rectangles), std::move(scene_state.images));
 }
 
-Engine::SceneState::SceneState(Engine& engine, TransformHandle root_transform) {
+Engine::SceneState::SceneState(Engine& engine, TransformHandle root_transform,
+                               std::optional<LastFrame> last_frame) {
   snapshot = engine.uber_struct_system_->Snapshot();
 
-  const auto links = engine.link_system_->GetResolvedTopologyLinks();
+  links = engine.link_system_->GetResolvedTopologyLinks();
   const auto link_system_id = engine.link_system_->GetInstanceId();
 
-  topology_data = GlobalTopologyData::ComputeGlobalTopologyData(snapshot, links, link_system_id,
-                                                                root_transform);
-  global_matrices =
-      ComputeGlobalMatrices(topology_data.topology_vector, topology_data.parent_indices, snapshot);
+  // Most frames only change the transforms of a few instances, so reuse the last frame's topology
+  // and matrices whenever no local topology or link changed.
+  if (last_frame && last_frame->root_transform == root_transform &&
+      GlobalTopologyData::IsSameTopology(snapshot, links, last_frame->snapshot,
+                                         last_frame->links)) {
+    topology_data = std::move(last_frame->topology_data);
+    GlobalTopologyData::UpdateGlobalTopologyData(snapshot, &topology_data);
+    global_matrices = std::move(last_frame->global_matrices);
+    UpdateGlobalMatrices(topology_data.topology_vector, topology_data.parent_indices, snapshot,
+                         last_frame->snapshot, &global_matrices);
+  } else {
+    topology_data = GlobalTopologyData::ComputeGlobalTopologyData(snapshot, links, link_system_id,
+                                                                  root_transform);
+    global_matrices = ComputeGlobalMatrices(topology_data.topology_vector,
+                                            topology_data.parent_indices, snapshot);
+  }
 
   auto [indices, im] =
       ComputeGlobalImageData(topology_data.topology_vector, topology_data.parent_indices, snapshot);
@@ -193,6 +221,33 @@ Engine::SceneState::SceneState(Engine& engine, TransformHandle root_transform) {
       ComputeGlobalRectangles(SelectAttribute(global_matrices, image_indices),
                               SelectAttribute(global_image_sample_regions, image_indices),
                               SelectAttribute(global_clip_regions, image_indices), images);
+
+  image_instances.reserve(image_indices.size());
+  for (const auto index : image_indices) {
+    image_instances.push_back(topology_data.topology_vector[index].GetInstanceId());
+  }
+
+  if (last_frame && last_frame->root_transform == root_transform) {
+    damage = ComputeDamage(*this, *last_frame);
+  }
+}
+
+fuchsia::math::Rect Engine::ComputeDamage(const SceneState& scene_state,
+                                          const LastFrame& last_frame) {
+  const auto instance_changed = [&scene_state, &last_frame](TransformHandle::InstanceId id) {
+    const auto uber_struct_kv = scene_state.snapshot.find(id);
+    const auto last_uber_struct_kv = last_frame.snapshot.find(id);
+    return uber_struct_kv == scene_state.snapshot.end() ||
+           last_uber_struct_kv == last_frame.snapshot.end() ||
+           uber_struct_kv->second != last_uber_struct_kv->second;
+  };
+
+  return flatland::ComputeDamage(
+      scene_state.image_rectangles, scene_state.images, last_frame.image_rectangles,
+      last_frame.images, [&](size_t i) {
+        return scene_state.image_instances[i] != last_frame.image_instances[i] ||
+               instance_changed(scene_state.image_instances[i]);
+      });
 }
 
 }  // namespace flatland
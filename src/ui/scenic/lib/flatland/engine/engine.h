@@ -60,23 +60,52 @@ class Engine {
   // Initialize all inspect::Nodes, so that the Engine state can be observed.
   void InitializeInspectObjects();
 
+  // The scene of the last frame rendered by RenderScheduledFrame(), so that the next frame only
+  // recomputes the parts of the global topology and matrices that changed.
+  struct LastFrame {
+    TransformHandle root_transform;
+    UberStruct::InstanceMap snapshot;
+    flatland::GlobalTopologyData::LinkTopologyMap links;
+    flatland::GlobalTopologyData topology_data;
+    flatland::GlobalMatrixVector global_matrices;
+    // The unculled rectangles and images, along with the instance each image belongs to, used to
+    // compute the damage of the next frame.
+    flatland::GlobalImageVector images;
+    flatland::GlobalRectangleVector image_rectangles;
+    std::vector<TransformHandle::InstanceId> image_instances;
+  };
+
   struct SceneState {
     UberStruct::InstanceMap snapshot;
+    flatland::GlobalTopologyData::LinkTopologyMap links;
     flatland::GlobalTopologyData topology_data;
     flatland::GlobalMatrixVector global_matrices;
     flatland::GlobalImageVector images;
     flatland::GlobalIndexVector image_indices;
     flatland::GlobalRectangleVector image_rectangles;
-
-    SceneState(Engine& engine, TransformHandle root_transform);
+    std::vector<TransformHandle::InstanceId> image_instances;
+    // The region which changed since |last_frame|, see RenderData::damage.
+    std::optional<fuchsia::math::Rect> damage;
+
+    // If |last_frame| has the same topology as the current scene, its topology data and matrices
+    // are updated rather than recomputed.
+    SceneState(Engine& engine, TransformHandle root_transform,
+               std::optional<LastFrame> last_frame = std::nullopt);
   };
 
+  // Returns the bounding box of every rectangle which differs between |scene_state| and
+  // |last_frame|. A rectangle differs if its position, image or the UberStruct of its instance
+  // changed, since a new UberStruct may come with new image content.
+  static fuchsia::math::Rect ComputeDamage(const SceneState& scene_state,
+                                           const LastFrame& last_frame);
+
   std::shared_ptr<flatland::DisplayCompositor> flatland_compositor_;
   std::shared_ptr<flatland::FlatlandPresenterImpl> flatland_presenter_;
   std::shared_ptr<flatland::UberStructSystem> uber_struct_system_;
   std::shared_ptr<flatland::LinkSystem> link_system_;
 
   uint64_t last_rendered_frame_ = 0;
+  std::optional<LastFrame> last_frame_;
 
   // TODO(fxbug.dev/76640): hack so that we can call DisplayCompositor::AddDisplay() when we first
   // encounter a new display.  Need a more straightforward way to call AddDisplay().
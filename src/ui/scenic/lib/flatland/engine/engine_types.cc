@@ -4,6 +4,11 @@
 
 #include "src/ui/scenic/lib/flatland/engine/engine_types.h"
 
+#include <lib/syslog/cpp/macros.h>
+
+#include <algorithm>
+#include <limits>
+
 namespace flatland {
 
 DisplaySrcDstFrames DisplaySrcDstFrames::New(escher::Rectangle2D rectangle,
@@ -29,6 +34,50 @@ DisplaySrcDstFrames DisplaySrcDstFrames::New(escher::Rectangle2D rectangle,
   return {.src = src_frame, .dst = dst_frame};
 }
 
+fuchsia::math::Rect ComputeDamage(const std::vector<Rectangle2D>& rectangles,
+                                  const std::vector<allocation::ImageMetadata>& images,
+                                  const std::vector<Rectangle2D>& last_rectangles,
+                                  const std::vector<allocation::ImageMetadata>& last_images,
+                                  const std::function<bool(size_t)>& content_changed) {
+  FX_DCHECK(rectangles.size() == images.size());
+  FX_DCHECK(last_rectangles.size() == last_images.size());
+
+  glm::vec2 min(std::numeric_limits<float>::max());
+  glm::vec2 max(std::numeric_limits<float>::lowest());
+  const auto add_damage = [&min, &max](const Rectangle2D& rectangle) {
+    min = glm::min(min, rectangle.origin);
+    max = glm::max(max, rectangle.origin + rectangle.extent);
+  };
+
+  for (size_t i = 0; i < std::max(rectangles.size(), last_rectangles.size()); ++i) {
+    if (i >= rectangles.size()) {
+      add_damage(last_rectangles[i]);
+      continue;
+    }
+    if (i >= last_rectangles.size()) {
+      add_damage(rectangles[i]);
+      continue;
+    }
+
+    const auto& image = images[i];
+    const auto& last_image = last_images[i];
+    if (rectangles[i] == last_rectangles[i] && image.identifier == last_image.identifier &&
+        image.multiply_color == last_image.multiply_color &&
+        image.blend_mode == last_image.blend_mode && !content_changed(i)) {
+      continue;
+    }
+    add_damage(rectangles[i]);
+    add_damage(last_rectangles[i]);
+  }
+
+  if (min.x > max.x || min.y > max.y) {
+    return {.x = 0, .y = 0, .width = 0, .height = 0};
+  }
+  const glm::ivec2 origin(glm::floor(min));
+  const glm::ivec2 end(glm::ceil(max));
+  return {.x = origin.x, .y = origin.y, .width = end.x - origin.x, .height = end.y - origin.y};
+}
+
 BufferCollectionImportMode StringToBufferCollectionImportMode(const std::string& str) {
   if (str == "enforce_display_constraints") {
     return BufferCollectionImportMode::EnforceDisplayConstraints;
@@ -37,6 +37,9 @@ struct RenderData {
   // RenderData keyed by display_id?  That would have the benefit of guaranteeing by construction
   // that each display_id could only appear once.
   uint64_t display_id;
+  // The region of the display whose content may differ from the previous frame rendered for
+  // |display_id|, or std::nullopt if the whole display must be assumed to have changed.
+  std::optional<fuchsia::math::Rect> damage;
 };
 
 // Struct to combine the source and destination frames used to set a layer's
@@ -72,6 +75,17 @@ enum class BufferCollectionImportMode {
   RendererOnly
 };
 
+// Returns the bounding box, in whole pixels, of every rectangle which differs between the previous
+// frame, given by |last_rectangles| and |last_images|, and the current one. Rectangles are drawn
+// in order, so a rectangle differs if its position or image differs from those of the rectangle
+// with the same index in the other frame, or if |content_changed(i)| reports that the content of
+// the i-th image may have changed although it is the same image.
+fuchsia::math::Rect ComputeDamage(const std::vector<Rectangle2D>& rectangles,
+                                  const std::vector<allocation::ImageMetadata>& images,
+                                  const std::vector<Rectangle2D>& last_rectangles,
+                                  const std::vector<allocation::ImageMetadata>& last_images,
+                                  const std::function<bool(size_t)>& content_changed);
+
 BufferCollectionImportMode StringToBufferCollectionImportMode(const std::string& str);
 
 const char* StringFromBufferCollectionImportMode(BufferCollectionImportMode mode);
@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <atomic>
 #include <memory>
 
 #include "src/lib/fsl/handles/object_info.h"
@@ -102,6 +103,16 @@ class DisplayCompositorTest : public DisplayCompositorTestBase {
     return display_compositor_->pending_apply_configs_;
   }
 
+  uint32_t SetHybridRenderDataOnDisplay(const RenderData& data, const ImageMetadata& render_target,
+                                        bool cache_result) {
+    return display_compositor_->SetHybridRenderDataOnDisplay(
+        data, render_target, DisplayCompositor::FrameEventData{}, cache_result);
+  }
+
+  std::optional<uint32_t> GetCachedMaxHardwareLayers(const RenderData& data) {
+    return display_compositor_->GetLayoutCheckResults(data).max_hardware_layers;
+  }
+
  protected:
   const zx_pixel_format_t kPixelFormat = ZX_PIXEL_FORMAT_RGB_x888;
   std::unique_ptr<flatland::MockDisplayController> mock_display_controller_;
@@ -924,6 +935,103 @@ TEST_F(DisplayCompositorTest, ChecksDisplayImageSignalFences) {
   server.join();
 }
 
+// Tests that the number of rectangles which the display controller accepts on hardware layers, next
+// to the GPU composited ones, is only kept for the layout when the config is for a single display.
+TEST_F(DisplayCompositorTest, HybridConfigResultIsOnlyCachedForSingleDisplay) {
+  const allocation::GlobalBufferCollectionId kGlobalBufferCollectionId = 1;
+  const uint64_t kDisplayId = 1;
+  const glm::uvec2 kResolution(1024, 768);
+
+  // Serve the display controller until the display compositor closes its channel.
+  auto mock = mock_display_controller_.get();
+  std::thread server([&mock]() mutable {
+    while (mock->WaitForMessage() == ZX_OK) {
+    }
+  });
+
+  uint64_t layer_id = 1;
+  EXPECT_CALL(*mock, CreateLayer(_))
+      .Times(2)
+      .WillRepeatedly(testing::Invoke([&](MockDisplayController::CreateLayerCallback callback) {
+        callback(ZX_OK, layer_id++);
+      }));
+  EXPECT_CALL(*renderer_.get(), ChoosePreferredPixelFormat(_));
+  DisplayInfo display_info = {kResolution, {kPixelFormat}};
+  scenic_impl::display::Display display(kDisplayId, kResolution.x, kResolution.y);
+  display_compositor_->AddDisplay(&display, display_info, /*num_vmos*/ 0,
+                                  /*out_buffer_collection*/ nullptr);
+  SetDisplaySupported(kGlobalBufferCollectionId, true);
+
+  // Two image rectangles, the topmost of which can go on the second hardware layer.
+  const ImageMetadata render_target = {
+      .collection_id = kGlobalBufferCollectionId,
+      .identifier = allocation::GenerateUniqueImageId(),
+      .vmo_index = 0,
+      .width = kResolution.x,
+      .height = kResolution.y,
+  };
+  RenderData data = {.display_id = kDisplayId};
+  for (uint32_t i = 0; i < 2; ++i) {
+    data.rectangles.push_back(Rectangle2D(glm::vec2(10 * i, 0), glm::vec2(100, 100)));
+    data.images.push_back({
+        .collection_id = kGlobalBufferCollectionId,
+        .identifier = allocation::GenerateUniqueImageId(),
+        .vmo_index = i + 1,
+        .width = 128,
+        .height = 128,
+        .blend_mode = fuchsia::ui::composition::BlendMode::SRC,
+    });
+  }
+
+  std::atomic<bool> accept_config = false;
+  std::atomic<uint32_t> num_checks = 0;
+  EXPECT_CALL(*mock, CheckConfig(false, _))
+      .WillRepeatedly(
+          testing::Invoke([&](bool, MockDisplayController::CheckConfigCallback callback) {
+            ++num_checks;
+            fuchsia::hardware::display::ConfigResult result =
+                accept_config ? fuchsia::hardware::display::ConfigResult::OK
+                              : fuchsia::hardware::display::ConfigResult::UNSUPPORTED_CONFIG;
+            std::vector<fuchsia::hardware::display::ClientCompositionOp> ops;
+            callback(result, ops);
+          }));
+  EXPECT_CALL(*mock, CheckConfig(true, _))
+      .WillRepeatedly(
+          testing::Invoke([&](bool, MockDisplayController::CheckConfigCallback callback) {
+            fuchsia::hardware::display::ConfigResult result =
+                fuchsia::hardware::display::ConfigResult::OK;
+            std::vector<fuchsia::hardware::display::ClientCompositionOp> ops;
+            callback(result, ops);
+          }));
+  // Only the topmost image is put on a hardware layer.
+  EXPECT_CALL(*mock, ImportEvent(_, _)).Times(1);
+
+  // A rejection of a config which spans several displays does not limit later frames.
+  EXPECT_EQ(SetHybridRenderDataOnDisplay(data, render_target, /*cache_result*/ false), 0u);
+  EXPECT_EQ(num_checks, 1u);
+  EXPECT_FALSE(GetCachedMaxHardwareLayers(data).has_value());
+
+  accept_config = true;
+  EXPECT_EQ(SetHybridRenderDataOnDisplay(data, render_target, /*cache_result*/ false), 1u);
+  EXPECT_EQ(num_checks, 2u);
+  EXPECT_FALSE(GetCachedMaxHardwareLayers(data).has_value());
+
+  // A rejection of a config for this display alone holds for as long as the layout does, so the
+  // display controller is not asked again.
+  accept_config = false;
+  EXPECT_EQ(SetHybridRenderDataOnDisplay(data, render_target, /*cache_result*/ true), 0u);
+  EXPECT_EQ(num_checks, 3u);
+  EXPECT_EQ(GetCachedMaxHardwareLayers(data), 0u);
+
+  accept_config = true;
+  EXPECT_EQ(SetHybridRenderDataOnDisplay(data, render_target, /*cache_result*/ true), 0u);
+  EXPECT_EQ(num_checks, 3u);
+
+  EXPECT_CALL(*mock, DestroyLayer(_)).Times(2);
+  display_compositor_.reset();
+  server.join();
+}
+
 // Tests that RenderOnly mode does not attempt to ImportBufferCollection() to display.
 TEST_F(DisplayCompositorTest, RendererOnly_ImportAndReleaseBufferCollectionTest) {
   SetBufferCollectionImportMode(BufferCollectionImportMode::RendererOnly);
@@ -0,0 +1,107 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/ui/scenic/lib/flatland/engine/engine_types.h"
+
+#include <gtest/gtest.h>
+
+#include "src/ui/scenic/lib/allocation/id.h"
+
+namespace flatland {
+namespace test {
+namespace {
+
+using allocation::ImageMetadata;
+
+bool RectEq(const fuchsia::math::Rect& a, const fuchsia::math::Rect& b) {
+  return a.x == b.x && a.y == b.y && a.width == b.width && a.height == b.height;
+}
+
+#define EXPECT_RECT_EQ(a, b)                                                               \
+  EXPECT_TRUE(RectEq(a, b)) << "actual: {" << (a).x << ", " << (a).y << ", " << (a).width \
+                            << ", " << (a).height << "}"
+
+constexpr fuchsia::math::Rect kNoDamage = {.x = 0, .y = 0, .width = 0, .height = 0};
+
+// Two rectangles with their images, the second on top of the first.
+class ComputeDamageTest : public ::testing::Test {
+ protected:
+  ComputeDamageTest()
+      : rectangles_({Rectangle2D(glm::vec2(0, 0), glm::vec2(100, 50)),
+                     Rectangle2D(glm::vec2(20, 10), glm::vec2(30, 20))}),
+        images_({ImageMetadata{.identifier = allocation::GenerateUniqueImageId(),
+                               .width = 100,
+                               .height = 50},
+                 ImageMetadata{.identifier = allocation::kInvalidImageId,
+                               .multiply_color = {1, 0, 0, 1}}}) {}
+
+  fuchsia::math::Rect Damage(const std::vector<Rectangle2D>& rectangles,
+                             const std::vector<ImageMetadata>& images,
+                             std::function<bool(size_t)> content_changed = [](size_t) {
+                               return false;
+                             }) {
+    return ComputeDamage(rectangles, images, rectangles_, images_, content_changed);
+  }
+
+  const std::vector<Rectangle2D> rectangles_;
+  const std::vector<ImageMetadata> images_;
+};
+
+TEST_F(ComputeDamageTest, SameFrameHasNoDamage) {
+  EXPECT_RECT_EQ(Damage(rectangles_, images_), kNoDamage);
+  EXPECT_RECT_EQ(ComputeDamage({}, {}, {}, {}, [](size_t) { return false; }), kNoDamage);
+}
+
+TEST_F(ComputeDamageTest, MovedRectangleDamagesBothPositions) {
+  auto rectangles = rectangles_;
+  rectangles[1] = Rectangle2D(glm::vec2(60, 30), glm::vec2(30, 20));
+  EXPECT_RECT_EQ(Damage(rectangles, images_), (fuchsia::math::Rect{20, 10, 70, 40}));
+}
+
+TEST_F(ComputeDamageTest, ChangedImageDamagesItsRectangle) {
+  auto images = images_;
+  images[1].multiply_color = {0, 1, 0, 1};
+  EXPECT_RECT_EQ(Damage(rectangles_, images), (fuchsia::math::Rect{20, 10, 30, 20}));
+
+  images = images_;
+  images[1].blend_mode = fuchsia::ui::composition::BlendMode::SRC_OVER;
+  EXPECT_RECT_EQ(Damage(rectangles_, images), (fuchsia::math::Rect{20, 10, 30, 20}));
+
+  images = images_;
+  images[0].identifier = allocation::GenerateUniqueImageId();
+  EXPECT_RECT_EQ(Damage(rectangles_, images), (fuchsia::math::Rect{0, 0, 100, 50}));
+}
+
+TEST_F(ComputeDamageTest, ChangedContentDamagesItsRectangle) {
+  EXPECT_RECT_EQ(Damage(rectangles_, images_, [](size_t i) { return i == 1; }),
+                 (fuchsia::math::Rect{20, 10, 30, 20}));
+}
+
+TEST_F(ComputeDamageTest, AddedAndRemovedRectanglesAreDamaged) {
+  auto rectangles = rectangles_;
+  auto images = images_;
+  rectangles.push_back(Rectangle2D(glm::vec2(200, 100), glm::vec2(10, 10)));
+  images.push_back(images_[1]);
+  EXPECT_RECT_EQ(Damage(rectangles, images), (fuchsia::math::Rect{200, 100, 10, 10}));
+
+  rectangles = {rectangles_[0]};
+  images = {images_[0]};
+  EXPECT_RECT_EQ(Damage(rectangles, images), (fuchsia::math::Rect{20, 10, 30, 20}));
+}
+
+// Rectangles are drawn in order, so removing one shifts the ones on top of it to other indices,
+// and they have to be drawn again as well.
+TEST_F(ComputeDamageTest, RemovingBottomRectangleDamagesRectanglesAbove) {
+  EXPECT_RECT_EQ(Damage({rectangles_[1]}, {images_[1]}), (fuchsia::math::Rect{0, 0, 100, 50}));
+}
+
+TEST_F(ComputeDamageTest, DamageIsRoundedOutToWholePixels) {
+  auto rectangles = rectangles_;
+  rectangles[1] = Rectangle2D(glm::vec2(20.5f, 10.25f), glm::vec2(30, 20));
+  EXPECT_RECT_EQ(Damage(rectangles, images_), (fuchsia::math::Rect{20, 10, 31, 21}));
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace flatland
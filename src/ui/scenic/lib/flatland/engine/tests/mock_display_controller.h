@@ -13,7 +13,7 @@ class MockDisplayController : public fuchsia::hardware::display::testing::Contro
  public:
   explicit MockDisplayController() : binding_(this) {}
 
-  void WaitForMessage() { binding_.WaitForMessage(); }
+  zx_status_t WaitForMessage() { return binding_.WaitForMessage(); }
 
   void Bind(zx::channel device_channel, zx::channel controller_channel,
             async_dispatcher_t* dispatcher = nullptr) {
@@ -260,6 +260,54 @@ GlobalMatrixVector ComputeGlobalMatrices(
   return matrices;
 }
 
+void UpdateGlobalMatrices(const GlobalTopologyData::TopologyVector& global_topology,
+                          const GlobalTopologyData::ParentIndexVector& parent_indices,
+                          const UberStruct::InstanceMap& uber_structs,
+                          const UberStruct::InstanceMap& previous_uber_structs,
+                          GlobalMatrixVector* matrices) {
+  FX_DCHECK(matrices);
+  FX_DCHECK(matrices->size() == global_topology.size());
+  FX_DCHECK(parent_indices.size() == global_topology.size());
+
+  // Entries of the same instance are mostly adjacent in the topology, so only look up the
+  // UberStruct again when the instance changes.
+  TransformHandle::InstanceId instance_id = 0;
+  const UberStruct* uber_struct = nullptr;
+  bool instance_changed = false;
+
+  // Whether each entry was recomputed, so that the children of recomputed entries are too.
+  std::vector<bool> dirty(global_topology.size(), false);
+  for (size_t i = 0; i < global_topology.size(); ++i) {
+    const TransformHandle& handle = global_topology[i];
+    if (uber_struct == nullptr || handle.GetInstanceId() != instance_id) {
+      instance_id = handle.GetInstanceId();
+
+      // Every entry in the global topology comes from an UberStruct.
+      const auto uber_struct_kv = uber_structs.find(instance_id);
+      FX_DCHECK(uber_struct_kv != uber_structs.end());
+      const auto previous_kv = previous_uber_structs.find(instance_id);
+      uber_struct = uber_struct_kv->second.get();
+      instance_changed =
+          previous_kv == previous_uber_structs.end() || previous_kv->second.get() != uber_struct;
+    }
+
+    // The root entry's parent index points to itself.
+    const bool parent_dirty = i != 0 && dirty[parent_indices[i]];
+    if (!instance_changed && !parent_dirty) {
+      continue;
+    }
+    dirty[i] = true;
+
+    const glm::mat3 parent_matrix = i == 0 ? glm::mat3() : (*matrices)[parent_indices[i]];
+    const auto matrix_kv = uber_struct->local_matrices.find(handle);
+    if (matrix_kv == uber_struct->local_matrices.end()) {
+      (*matrices)[i] = parent_matrix;
+    } else {
+      (*matrices)[i] = parent_matrix * matrix_kv->second;
+    }
+  }
+}
+
 GlobalImageSampleRegionVector ComputeGlobalImageSampleRegions(
     const GlobalTopologyData::TopologyVector& global_topology,
     const GlobalTopologyData::ParentIndexVector& parent_indices,
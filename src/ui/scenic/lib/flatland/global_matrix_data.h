@@ -40,6 +40,15 @@ GlobalMatrixVector ComputeGlobalMatrices(
     const GlobalTopologyData::ParentIndexVector& parent_indices,
     const UberStruct::InstanceMap& uber_structs);
 
+// Updates |matrices|, computed by ComputeGlobalMatrices() from |previous_uber_structs| for the
+// same |global_topology|, to the local matrices in |uber_structs|. Only the transforms whose
+// UberStruct, or the UberStruct of one of their ancestors, changed are recomputed.
+void UpdateGlobalMatrices(const GlobalTopologyData::TopologyVector& global_topology,
+                          const GlobalTopologyData::ParentIndexVector& parent_indices,
+                          const UberStruct::InstanceMap& uber_structs,
+                          const UberStruct::InstanceMap& previous_uber_structs,
+                          GlobalMatrixVector* matrices);
+
 // Gathers the image sample regions for each transform in |global_topology| using the local
 // image sample regions in the |uber_structs|. If a transform doesn't have image sample
 // regions present in the appropriate UberStruct, this function assumes the region is null.
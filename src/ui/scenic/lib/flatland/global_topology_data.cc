@@ -564,6 +564,61 @@ GlobalTopologyData GlobalTopologyData::ComputeGlobalTopologyData(
           .clip_regions = std::move(clip_regions)};
 }
 
+// static
+bool GlobalTopologyData::IsSameTopology(const UberStruct::InstanceMap& uber_structs,
+                                        const LinkTopologyMap& links,
+                                        const UberStruct::InstanceMap& previous_uber_structs,
+                                        const LinkTopologyMap& previous_links) {
+  // Instances being added or removed can change how links resolve, even if no link changed.
+  if (links != previous_links || uber_structs.size() != previous_uber_structs.size()) {
+    return false;
+  }
+
+  for (const auto& [instance_id, uber_struct] : uber_structs) {
+    const auto previous_kv = previous_uber_structs.find(instance_id);
+    if (previous_kv == previous_uber_structs.end()) {
+      return false;
+    }
+    if (previous_kv->second != uber_struct &&
+        previous_kv->second->local_topology != uber_struct->local_topology) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// static
+void GlobalTopologyData::UpdateGlobalTopologyData(const UberStruct::InstanceMap& uber_structs,
+                                                  GlobalTopologyData* data) {
+  FX_DCHECK(data);
+
+  data->view_refs.clear();
+  data->debug_names.clear();
+  data->clip_regions.clear();
+  for (const auto& [_, uber_struct] : uber_structs) {
+    if (uber_struct->local_topology.empty()) {
+      continue;
+    }
+
+    const auto& root_handle = uber_struct->local_topology[0].handle;
+    data->view_refs.emplace(root_handle, uber_struct->view_ref);
+
+    // Every local topology in the global topology is reached through its root, so the debug name
+    // and clip regions only come from the instances whose root is live.
+    if (data->live_handles.count(root_handle) == 0) {
+      continue;
+    }
+    if (!uber_struct->debug_name.empty()) {
+      data->debug_names.emplace(root_handle, uber_struct->debug_name);
+    }
+    for (auto& [child_handle, child_clip_region] : uber_struct->local_clip_regions) {
+      TransformClipRegion clip_region;
+      fidl::Clone(child_clip_region, &clip_region);
+      data->clip_regions.try_emplace(child_handle, std::move(clip_region));
+    }
+  }
+}
+
 view_tree::SubtreeSnapshot GlobalTopologyData::GenerateViewTreeSnapshot(
     const GlobalTopologyData& data, const std::vector<TransformClipRegion>& global_clip_regions,
     const std::vector<glm::mat3>& global_matrix_vector,
@@ -85,6 +85,22 @@ struct GlobalTopologyData {
                                                       TransformHandle::InstanceId link_instance_id,
                                                       TransformHandle root);
 
+  // Returns true if ComputeGlobalTopologyData() computes the same topology for |uber_structs| and
+  // |links| as for |previous_uber_structs| and |previous_links|, given the same root. This is the
+  // case when the links and the set of instances are unchanged, and every UberStruct that was
+  // replaced has the same local topology as the one it replaced.
+  static bool IsSameTopology(const UberStruct::InstanceMap& uber_structs,
+                             const LinkTopologyMap& links,
+                             const UberStruct::InstanceMap& previous_uber_structs,
+                             const LinkTopologyMap& previous_links);
+
+  // Updates the parts of |data| which do not depend on the topology (the ViewRefs, debug names and
+  // clip regions) from |uber_structs|. |data| must have been computed for UberStructs with the
+  // same topology as |uber_structs|, see IsSameTopology(). This is much cheaper than recomputing
+  // |data| when only the contents of the local topologies changed.
+  static void UpdateGlobalTopologyData(const UberStruct::InstanceMap& uber_structs,
+                                       GlobalTopologyData* data);
+
   static view_tree::SubtreeSnapshot GenerateViewTreeSnapshot(
       const GlobalTopologyData& data, const std::vector<TransformClipRegion>& global_clip_regions,
       const std::vector<glm::mat3>& global_matrix_vector,
@@ -50,6 +50,19 @@ class Renderer : public allocation::BufferCollectionImporter {
                       const std::vector<zx::event>& release_fences = {},
                       bool apply_color_conversion = false) = 0;
 
+  // Same as Render(), but only renders the pixels of |render_target| within |render_area|, and the
+  // rest keeps its content from when |render_target| was last rendered into. Callers use this
+  // when only part of the scene changed since then. Renderers which cannot keep the content of
+  // render targets render all of it.
+  virtual void RenderRegion(const allocation::ImageMetadata& render_target,
+                            const fuchsia::math::Rect& render_area,
+                            const std::vector<Rectangle2D>& rectangles,
+                            const std::vector<allocation::ImageMetadata>& images,
+                            const std::vector<zx::event>& release_fences = {},
+                            bool apply_color_conversion = false) {
+    Render(render_target, rectangles, images, release_fences, apply_color_conversion);
+  }
+
   // Values needed to adjust the color of the framebuffer as a postprocessing effect.
   virtual void SetColorConversionValues(const std::array<float, 9>& coefficients,
                                         const std::array<float, 3>& preoffsets,
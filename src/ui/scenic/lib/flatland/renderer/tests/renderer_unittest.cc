@@ -8,6 +8,7 @@
 #include <lib/async/default.h>
 
 #include <cstdint>
+#include <functional>
 #include <thread>
 
 #include "src/lib/fsl/handles/object_info.h"
@@ -1410,6 +1411,90 @@ VK_TEST_F(VulkanRendererTest, MultipleSolidColorTest) {
       });
 }
 
+// Tests that RenderRegion() only renders the pixels within its render area. The rest of the
+// render target keeps what was rendered into it before, and pixels within the area that no
+// rectangle covers are cleared.
+VK_TEST_F(VulkanRendererTest, RenderRegionTest) {
+  SKIP_TEST_IF_ESCHER_USES_DEVICE(VirtualGpu);
+  auto env = escher::test::EscherEnvironment::GetGlobalTestEnvironment();
+  auto unique_escher = std::make_unique<escher::Escher>(
+      env->GetVulkanDevice(), env->GetFilesystem(), /*gpu_allocator*/ nullptr);
+  VkRenderer renderer(unique_escher->GetWeakPtr());
+
+  // Setup the render target collection.
+  fuchsia::sysmem::BufferCollectionInfo_2 client_target_info;
+  fuchsia::sysmem::BufferCollectionSyncPtr target_ptr;
+  auto target_id = SetupBufferCollection(1, 60, 40, BufferCollectionUsage::kRenderTarget, &renderer,
+                                         sysmem_allocator_.get(), &client_target_info, target_ptr);
+
+  // Create the render_target image metadata.
+  const uint32_t kTargetWidth = 16;
+  const uint32_t kTargetHeight = 8;
+  ImageMetadata render_target = {.collection_id = target_id,
+                                 .identifier = allocation::GenerateUniqueImageId(),
+                                 .vmo_index = 0,
+                                 .width = kTargetWidth,
+                                 .height = kTargetHeight};
+  renderer.ImportBufferImage(render_target, BufferCollectionUsage::kRenderTarget);
+
+  // Solid color renderables covering the whole render target. Values are BGRA.
+  const Rectangle2D fullscreen(glm::vec2(0, 0), glm::vec2(kTargetWidth, kTargetHeight));
+  const ImageMetadata red = {.identifier = allocation::kInvalidImageId,
+                             .multiply_color = {1, 0, 0, 1},
+                             .blend_mode = fuchsia::ui::composition::BlendMode::SRC_OVER};
+  const ImageMetadata blue = {.identifier = allocation::kInvalidImageId,
+                              .multiply_color = {0, 0, 1, 1},
+                              .blend_mode = fuchsia::ui::composition::BlendMode::SRC_OVER};
+  const glm::ivec4 kRed(0, 0, 255, 255);
+  const glm::ivec4 kBlue(255, 0, 0, 255);
+  const glm::ivec4 kBlack(0, 0, 0, 0);
+
+  // Calls |expected(x, y)| for each pixel of the render target to check its color.
+  const auto check_pixels = [&](const std::function<glm::ivec4(uint32_t, uint32_t)>& expected) {
+    MapHostPointer(client_target_info, render_target.vmo_index,
+                   [&](uint8_t* vmo_host, uint32_t num_bytes) mutable {
+                     // Flush the cache before reading back target image.
+                     EXPECT_EQ(ZX_OK,
+                               zx_cache_flush(vmo_host, kTargetWidth * kTargetHeight * 4,
+                                              ZX_CACHE_FLUSH_DATA | ZX_CACHE_FLUSH_INVALIDATE));
+
+                     uint8_t linear_vals[num_bytes];
+                     sRGBtoLinear(vmo_host, linear_vals, num_bytes);
+                     for (uint32_t x = 0; x < kTargetWidth; x++) {
+                       for (uint32_t y = 0; y < kTargetHeight; y++) {
+                         EXPECT_EQ(GetPixel(linear_vals, kTargetWidth, x, y), expected(x, y))
+                             << "x: " << x << " y: " << y;
+                       }
+                     }
+                   });
+  };
+  const auto within = [](const fuchsia::math::Rect& area, uint32_t x, uint32_t y) {
+    return static_cast<int32_t>(x) >= area.x && static_cast<int32_t>(x) < area.x + area.width &&
+           static_cast<int32_t>(y) >= area.y && static_cast<int32_t>(y) < area.y + area.height;
+  };
+
+  renderer.Render(render_target, {fullscreen}, {red});
+  renderer.WaitIdle();
+  check_pixels([&](uint32_t, uint32_t) { return kRed; });
+
+  // The blue renderable covers the whole render target, but only lands within the render area.
+  const fuchsia::math::Rect kBlueArea = {.x = 4, .y = 2, .width = 8, .height = 4};
+  renderer.RenderRegion(render_target, kBlueArea, {fullscreen}, {blue});
+  renderer.WaitIdle();
+  check_pixels([&](uint32_t x, uint32_t y) { return within(kBlueArea, x, y) ? kBlue : kRed; });
+
+  // Without renderables, the render area is only cleared.
+  const fuchsia::math::Rect kClearArea = {.x = 0, .y = 0, .width = 6, .height = 3};
+  renderer.RenderRegion(render_target, kClearArea, {}, {});
+  renderer.WaitIdle();
+  check_pixels([&](uint32_t x, uint32_t y) {
+    if (within(kClearArea, x, y)) {
+      return kBlack;
+    }
+    return within(kBlueArea, x, y) ? kBlue : kRed;
+  });
+}
+
 // Tests if the VK renderer can handle rendering a solid color rectangle as well as
 // an image-backed rectangle. Make sure that the two rectangles, if given the same
 // dimensions, occupy the exact same number of pixels.
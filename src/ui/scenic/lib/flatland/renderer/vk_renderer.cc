@@ -553,6 +553,33 @@ void VkRenderer::Render(const ImageMetadata& render_target,
                         const std::vector<ImageMetadata>& images,
                         const std::vector<zx::event>& release_fences, bool apply_color_conversion) {
   TRACE_DURATION("gfx", "VkRenderer::Render");
+  RenderInternal(render_target, std::nullopt, rectangles, images, release_fences,
+                 apply_color_conversion);
+}
+
+void VkRenderer::RenderRegion(const ImageMetadata& render_target,
+                              const fuchsia::math::Rect& render_area,
+                              const std::vector<Rectangle2D>& rectangles,
+                              const std::vector<ImageMetadata>& images,
+                              const std::vector<zx::event>& release_fences,
+                              bool apply_color_conversion) {
+  TRACE_DURATION("gfx", "VkRenderer::RenderRegion", "width", render_area.width, "height",
+                 render_area.height);
+  FX_DCHECK(render_area.x >= 0 && render_area.y >= 0 && render_area.width >= 0 &&
+            render_area.height >= 0);
+  RenderInternal(render_target,
+                 vk::Rect2D({render_area.x, render_area.y},
+                            {static_cast<uint32_t>(render_area.width),
+                             static_cast<uint32_t>(render_area.height)}),
+                 rectangles, images, release_fences, apply_color_conversion);
+}
+
+void VkRenderer::RenderInternal(const ImageMetadata& render_target,
+                                std::optional<vk::Rect2D> render_area,
+                                const std::vector<Rectangle2D>& rectangles,
+                                const std::vector<ImageMetadata>& images,
+                                const std::vector<zx::event>& release_fences,
+                                bool apply_color_conversion) {
 
   FX_DCHECK(rectangles.size() == images.size())
       << "# rects: " << rectangles.size() << " and #images: " << images.size();
@@ -632,15 +659,17 @@ void VkRenderer::Render(const ImageMetadata& render_target,
   const auto depth_texture = local_depth_target_map.at(render_target.identifier);
 
   // Transition to eColorAttachmentOptimal for rendering.  Note the src queue family is FOREIGN,
-  // since we assume that this image was previously presented to the display controller.
+  // since we assume that this image was previously presented to the display controller. When only
+  // part of the image is rendered the rest must be kept, so transition from the layout it was
+  // presented in rather than discarding its content.
   auto render_image_layout = vk::ImageLayout::eColorAttachmentOptimal;
-  command_buffer->impl()->TransitionImageLayout(output_image, vk::ImageLayout::eUndefined,
-                                                render_image_layout, VK_QUEUE_FAMILY_FOREIGN_EXT,
-                                                escher_->device()->vk_main_queue_family());
+  command_buffer->impl()->TransitionImageLayout(
+      output_image, render_area ? vk::ImageLayout::eGeneral : vk::ImageLayout::eUndefined,
+      render_image_layout, VK_QUEUE_FAMILY_FOREIGN_EXT, escher_->device()->vk_main_queue_family());
 
   // Now the compositor can finally draw.
   compositor_.DrawBatch(command_buffer, rectangles, textures, color_data, output_image,
-                        depth_texture, apply_color_conversion);
+                        depth_texture, apply_color_conversion, render_area);
 
   const auto readback_image_it = local_readback_image_map.find(render_target.identifier);
   // Copy to the readback image if there is a readback image.
@@ -8,6 +8,7 @@
 #include <fuchsia/images/cpp/fidl.h>
 
 #include <iterator>
+#include <optional>
 #include <set>
 #include <unordered_map>
 
@@ -53,6 +54,13 @@ class VkRenderer final : public Renderer {
               const std::vector<zx::event>& release_fences = {},
               bool apply_color_conversion = false) override;
 
+  // |Renderer|.
+  void RenderRegion(const ImageMetadata& render_target, const fuchsia::math::Rect& render_area,
+                    const std::vector<Rectangle2D>& rectangles,
+                    const std::vector<ImageMetadata>& images,
+                    const std::vector<zx::event>& release_fences = {},
+                    bool apply_color_conversion = false) override;
+
   // |Renderer|.
   void SetColorConversionValues(const std::array<float, 9>& coefficients,
                                 const std::array<float, 3>& preoffsets,
@@ -73,6 +81,13 @@ class VkRenderer final : public Renderer {
     vk::BufferCollectionFUCHSIA vk_collection;
   };
 
+  // Implements Render() and RenderRegion(). Renders the whole |render_target| if |render_area| is
+  // not set.
+  void RenderInternal(const ImageMetadata& render_target, std::optional<vk::Rect2D> render_area,
+                      const std::vector<Rectangle2D>& rectangles,
+                      const std::vector<ImageMetadata>& images,
+                      const std::vector<zx::event>& release_fences, bool apply_color_conversion);
+
   // The function ExtractImage() creates an escher Image from a sysmem collection vmo.
   escher::ImagePtr ExtractImage(const ImageMetadata& metadata,
                                 vk::BufferCollectionFUCHSIA collection, vk::ImageUsageFlags usage,
@@ -128,6 +128,67 @@ TEST(GlobalTopologyDataTest, GlobalTopologyLinkExpansion) {
   EXPECT_THAT(output.parent_indices, ::testing::ElementsAreArray(expected_parent_indices));
 }
 
+TEST(GlobalTopologyDataTest, IsSameTopology) {
+  UberStruct::InstanceMap uber_structs;
+  GlobalTopologyData::LinkTopologyMap links;
+
+  const auto link_2 = GetInternalLinkHandle(2);
+
+  const TransformGraph::TopologyVector vectors[] = {{{{1, 0}, 1}, {link_2, 0}},  // 1:0 - 0:2
+                                                    {{{2, 0}, 0}}};              // 2:0
+
+  MakeLink(links, 2);  // 0:2 - 2:0
+
+  for (const auto& v : vectors) {
+    auto uber_struct = std::make_unique<UberStruct>();
+    uber_struct->local_topology = v;
+    uber_structs[v[0].handle.GetInstanceId()] = std::move(uber_struct);
+  }
+  EXPECT_TRUE(GlobalTopologyData::IsSameTopology(uber_structs, links, uber_structs, links));
+
+  // A new UberStruct with the same local topology, e.g. with only its matrices changed.
+  {
+    auto changed = uber_structs;
+    auto uber_struct = std::make_shared<UberStruct>();
+    uber_struct->local_topology = changed[2]->local_topology;
+    uber_struct->local_matrices[{2, 0}] = glm::scale(glm::mat3(), {2.f, 2.f});
+    uber_struct->debug_name = "changed";
+    changed[2] = uber_struct;
+    EXPECT_TRUE(GlobalTopologyData::IsSameTopology(changed, links, uber_structs, links));
+
+    // The debug name is picked up without recomputing the topology.
+    auto output =
+        GlobalTopologyData::ComputeGlobalTopologyData(uber_structs, links, kLinkInstanceId, {1, 0});
+    GlobalTopologyData::UpdateGlobalTopologyData(changed, &output);
+    EXPECT_EQ(output.debug_names.at({2, 0}), "changed");
+  }
+
+  // A new UberStruct with a different local topology.
+  {
+    auto changed = uber_structs;
+    auto uber_struct = std::make_shared<UberStruct>();
+    uber_struct->local_topology = {{{2, 0}, 1}, {{2, 1}, 0}};
+    changed[2] = uber_struct;
+    EXPECT_FALSE(GlobalTopologyData::IsSameTopology(changed, links, uber_structs, links));
+  }
+
+  // A new instance, which could resolve a link that previously had no UberStruct.
+  {
+    auto changed = uber_structs;
+    auto uber_struct = std::make_shared<UberStruct>();
+    uber_struct->local_topology = {{{3, 0}, 0}};
+    changed[3] = uber_struct;
+    EXPECT_FALSE(GlobalTopologyData::IsSameTopology(changed, links, uber_structs, links));
+  }
+
+  // A changed link.
+  {
+    auto changed = links;
+    changed.erase(link_2);
+    EXPECT_FALSE(GlobalTopologyData::IsSameTopology(uber_structs, changed, uber_structs, links));
+  }
+}
+
 TEST(GlobalTopologyDataTest, GlobalTopologyIncompleteLink) {
   UberStruct::InstanceMap uber_structs;
   GlobalTopologyData::LinkTopologyMap links;
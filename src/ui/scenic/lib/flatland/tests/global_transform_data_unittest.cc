@@ -179,6 +179,59 @@ TEST(GlobalMatrixDataTest, GlobalMatricesMultipleUberStructs) {
   EXPECT_THAT(global_matrices, ::testing::ElementsAreArray(expected_matrices));
 }
 
+TEST(GlobalMatrixDataTest, UpdateGlobalMatricesOnlyRecomputesChangedInstances) {
+  UberStruct::InstanceMap uber_structs;
+
+  // Make a global topology representing the following graph:
+  //
+  // 1:0 - 2:0 - 2:1
+  //     \
+  //       1:1
+  GlobalTopologyData::TopologyVector topology_vector = {{1, 0}, {2, 0}, {2, 1}, {1, 1}};
+  GlobalTopologyData::ParentIndexVector parent_indices = {0, 0, 1, 0};
+
+  auto uber_struct1 = std::make_shared<UberStruct>();
+  auto uber_struct2 = std::make_shared<UberStruct>();
+  uber_struct1->local_matrices[{1, 0}] = glm::scale(glm::mat3(), {2.f, 2.f});
+  uber_struct1->local_matrices[{1, 1}] = glm::scale(glm::mat3(), {3.f, 3.f});
+  uber_struct2->local_matrices[{2, 1}] = glm::scale(glm::mat3(), {5.f, 5.f});
+  uber_structs[1] = uber_struct1;
+  uber_structs[2] = uber_struct2;
+
+  auto global_matrices = ComputeGlobalMatrices(topology_vector, parent_indices, uber_structs);
+
+  // Replace the UberStruct of instance 2 only. Entries of the unchanged instance are not
+  // recomputed, which is shown here by clobbering the one for 1:1 beforehand.
+  auto previous_uber_structs = uber_structs;
+  auto new_uber_struct2 = std::make_shared<UberStruct>();
+  new_uber_struct2->local_matrices = uber_struct2->local_matrices;
+  new_uber_struct2->local_matrices[{2, 0}] = glm::scale(glm::mat3(), {7.f, 7.f});
+  uber_structs[2] = new_uber_struct2;
+  global_matrices[3] = glm::mat3(0.f);
+
+  UpdateGlobalMatrices(topology_vector, parent_indices, uber_structs, previous_uber_structs,
+                       &global_matrices);
+  std::vector<glm::mat3> expected_matrices = {
+      glm::scale(glm::mat3(), glm::vec2(2.f)),   // 1:0 = 2
+      glm::scale(glm::mat3(), glm::vec2(14.f)),  // 1:0 * 2:0 = 2 * 7 = 14
+      glm::scale(glm::mat3(), glm::vec2(70.f)),  // 1:0 * 2:0 * 2:1 = 2 * 7 * 5 = 70
+      glm::mat3(0.f),                            // 1:1 was not recomputed
+  };
+  EXPECT_THAT(global_matrices, ::testing::ElementsAreArray(expected_matrices));
+
+  // Replacing the parent instance recomputes all of its descendants.
+  previous_uber_structs = uber_structs;
+  auto new_uber_struct1 = std::make_shared<UberStruct>();
+  new_uber_struct1->local_matrices = uber_struct1->local_matrices;
+  new_uber_struct1->local_matrices[{1, 0}] = glm::scale(glm::mat3(), {11.f, 11.f});
+  uber_structs[1] = new_uber_struct1;
+
+  UpdateGlobalMatrices(topology_vector, parent_indices, uber_structs, previous_uber_structs,
+                       &global_matrices);
+  EXPECT_THAT(global_matrices, ::testing::ElementsAreArray(ComputeGlobalMatrices(
+                                   topology_vector, parent_indices, uber_structs)));
+}
+
 // The following tests ensure that different clip boundaries affect rectangles in the proper manner.
 
 // Test that if a clip region is completely larger than the rectangle, it has no effect on the
@@ -7,14 +7,16 @@
 namespace scenic_impl::input {
 
 InputSystem::InputSystem(sys::ComponentContext* context, inspect::Node& inspect_node,
-                         fxl::WeakPtr<gfx::SceneGraph> scene_graph, RequestFocusFunc request_focus)
+                         fxl::WeakPtr<gfx::SceneGraph> scene_graph, RequestFocusFunc request_focus,
+                         zx::duration touch_batch_interval)
     : request_focus_(std::move(request_focus)),
       hit_tester_(view_tree_snapshot_, inspect_node),
       mouse_system_(context, view_tree_snapshot_, hit_tester_,
                     [this](zx_koid_t koid) { request_focus_(koid); }),
       touch_system_(
           context, view_tree_snapshot_, hit_tester_, inspect_node,
-          [this](zx_koid_t koid) { request_focus_(koid); }, std::move(scene_graph)),
+          [this](zx_koid_t koid) { request_focus_(koid); }, std::move(scene_graph),
+          touch_batch_interval),
       pointerinjector_registry_(
           context,
           /*inject_touch_exclusive=*/
@@ -18,7 +18,8 @@ namespace scenic_impl::input {
 class InputSystem {
  public:
   explicit InputSystem(sys::ComponentContext* context, inspect::Node& inspect_node,
-                       fxl::WeakPtr<gfx::SceneGraph> scene_graph, RequestFocusFunc request_focus);
+                       fxl::WeakPtr<gfx::SceneGraph> scene_graph, RequestFocusFunc request_focus,
+                       zx::duration touch_batch_interval = zx::duration(0));
   ~InputSystem() = default;
 
   void OnNewViewTreeSnapshot(std::shared_ptr<const view_tree::Snapshot> snapshot) {
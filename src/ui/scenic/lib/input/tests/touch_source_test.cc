@@ -798,4 +798,52 @@ TEST_F(TouchSourceTest, TouchDeviceInfo_ShouldBeSent_OncePerDevice) {
   }
 }
 
+
+TEST_F(TouchSourceTest, WithBatchInterval_PointerMovementsShouldBeBatched) {
+  constexpr zx::duration kBatchInterval = zx::msec(8);
+  fuchsia::ui::pointer::TouchSourcePtr client_ptr;
+  TouchSource touch_source(
+      kViewRefKoid, client_ptr.NewRequest(), /*respond*/ [](auto...) {},
+      /*error_handler*/ [] {}, inspector_, kBatchInterval);
+
+  std::vector<fuchsia::ui::pointer::TouchEvent> received_events;
+  const auto watch = [&client_ptr, &received_events](size_t num_responses) {
+    std::vector<fuchsia::ui::pointer::TouchResponse> responses;
+    for (size_t i = 0; i < num_responses; ++i) {
+      responses.emplace_back(CreateResponse(TouchResponseType::MAYBE));
+    }
+    client_ptr->Watch(std::move(responses),
+                      [&received_events](auto events) { received_events = std::move(events); });
+  };
+
+  // The start of a stream is sent immediately.
+  watch(0);
+  touch_source.UpdateStream(kStreamId, IPEventTemplate(Phase::kAdd), kStreamOngoing,
+                            kEmptyBoundingBox);
+  RunLoopUntilIdle();
+  EXPECT_EQ(received_events.size(), 1u);
+
+  // Movements are held back until the first one has waited for |kBatchInterval|.
+  watch(received_events.size());
+  received_events.clear();
+  for (int i = 0; i < 3; ++i) {
+    touch_source.UpdateStream(kStreamId, IPEventTemplate(Phase::kChange), kStreamOngoing,
+                              kEmptyBoundingBox);
+    RunLoopFor(zx::msec(1));
+  }
+  EXPECT_TRUE(received_events.empty());
+  RunLoopFor(kBatchInterval);
+  EXPECT_EQ(received_events.size(), 3u);
+
+  // The end of a stream is sent immediately, along with the movements held back before it.
+  watch(received_events.size());
+  received_events.clear();
+  touch_source.UpdateStream(kStreamId, IPEventTemplate(Phase::kChange), kStreamOngoing,
+                            kEmptyBoundingBox);
+  touch_source.UpdateStream(kStreamId, IPEventTemplate(Phase::kRemove), kStreamEnding,
+                            kEmptyBoundingBox);
+  RunLoopUntilIdle();
+  EXPECT_EQ(received_events.size(), 2u);
+}
+
 }  // namespace input::test
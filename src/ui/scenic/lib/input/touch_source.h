@@ -18,10 +18,12 @@ namespace scenic_impl::input {
 class TouchSource : public TouchSourceBase, public fuchsia::ui::pointer::TouchSource {
  public:
   // |respond_| must not destroy the TouchSource object.
+  // See TouchSourceBase for |batch_interval|.
   TouchSource(zx_koid_t view_ref_koid,
               fidl::InterfaceRequest<fuchsia::ui::pointer::TouchSource> touch_source,
               fit::function<void(StreamId, const std::vector<GestureResponse>&)> respond,
-              fit::function<void()> error_handler, GestureContenderInspector& inspector);
+              fit::function<void()> error_handler, GestureContenderInspector& inspector,
+              zx::duration batch_interval = zx::duration(0));
 
   ~TouchSource() override = default;
 
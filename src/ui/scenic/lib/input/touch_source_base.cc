@@ -109,6 +109,15 @@ void AddViewParametersToEvent(fuchsia::ui::pointer::TouchEvent& event, const Vie
   });
 }
 
+// Returns true if |event| only moves a pointer, and can therefore be batched with the events
+// following it.
+bool IsBatchable(const fuchsia::ui::pointer::TouchEvent& event) {
+  return event.has_pointer_sample() &&
+         event.pointer_sample().phase() == fuchsia::ui::pointer::EventPhase::CHANGE &&
+         !event.has_interaction_result() && !event.has_view_parameters() &&
+         !event.has_device_info();
+}
+
 bool IsHold(GestureResponse response) {
   switch (response) {
     case GestureResponse::kHold:
@@ -136,9 +145,10 @@ TouchSourceBase::TouchSourceBase(
     fit::function<void(StreamId, const std::vector<GestureResponse>&)> respond,
     fit::function<void(zx_status_t)> close_channel,
     fit::function<void(AugmentedTouchEvent&, const InternalTouchEvent&)> augment,
-    GestureContenderInspector& inspector)
+    GestureContenderInspector& inspector, zx::duration batch_interval)
     : GestureContender(view_ref_koid),
       channel_koid_(channel_koid),
+      batch_interval_(batch_interval),
       respond_(std::move(respond)),
       close_channel_(std::move(close_channel)),
       augment_(std::move(augment)),
@@ -211,7 +221,7 @@ void TouchSourceBase::UpdateStream(StreamId stream_id, const InternalTouchEvent&
     }
 
     augment_(out_event, event);
-    pending_events_.push({.stream_id = stream_id, .event = std::move(out_event)});
+    PushPendingEvent(stream_id, std::move(out_event));
   }
 
   stream.stream_has_ended = is_end_of_stream;
@@ -243,7 +253,7 @@ void TouchSourceBase::EndContest(StreamId stream_id, bool awarded_win) {
   stream.was_won = awarded_win;
   AugmentedTouchEvent event{
       .touch_event = NewEndEvent(stream_id, stream.device_id, stream.pointer_id, awarded_win)};
-  pending_events_.push({.stream_id = stream_id, .event = std::move(event)});
+  PushPendingEvent(stream_id, std::move(event));
   SendPendingIfWaiting();
 
   if (!awarded_win) {
@@ -397,18 +407,53 @@ void TouchSourceBase::UpdateResponseBase(fuchsia::ui::pointer::TouchInteractionI
   callback();
 }
 
+void TouchSourceBase::PushPendingEvent(StreamId stream_id, AugmentedTouchEvent event) {
+  if (!IsBatchable(event.touch_event)) {
+    ++num_unbatchable_pending_events_;
+  }
+  pending_events_.push({.stream_id = stream_id,
+                        .event = std::move(event),
+                        .arrival_time = async::Now(async_get_default_dispatcher())});
+}
+
 void TouchSourceBase::SendPendingIfWaiting() {
   if (!pending_callback_ || pending_events_.empty()) {
     return;
   }
+
+  // Hold back batchable events until the oldest one has waited for |batch_interval_|, or until
+  // there are enough for a full batch.
+  if (batch_interval_ > zx::duration(0) && num_unbatchable_pending_events_ == 0 &&
+      pending_events_.size() < fuchsia::ui::pointer::TOUCH_MAX_EVENT) {
+    const zx::time send_time = pending_events_.front().arrival_time + batch_interval_;
+    if (async::Now(async_get_default_dispatcher()) < send_time) {
+      if (!batch_task_.is_pending()) {
+        batch_task_.PostForTime(async_get_default_dispatcher(), send_time);
+      }
+      return;
+    }
+  }
+
+  SendPending();
+}
+
+void TouchSourceBase::SendPending() {
+  batch_task_.Cancel();
+  if (!pending_callback_ || pending_events_.empty()) {
+    return;
+  }
   FX_DCHECK(return_tickets_.empty());
 
   std::vector<AugmentedTouchEvent> events;
   for (size_t i = 0; !pending_events_.empty() && i < fuchsia::ui::pointer::TOUCH_MAX_EVENT; ++i) {
-    auto [stream_id, event] = std::move(pending_events_.front());
+    auto [stream_id, event, _] = std::move(pending_events_.front());
     TRACE_FLOW_BEGIN("input", "dispatch_event_to_client", event.touch_event.trace_flow_id());
 
     pending_events_.pop();
+    if (!IsBatchable(event.touch_event)) {
+      FX_DCHECK(num_unbatchable_pending_events_ > 0);
+      --num_unbatchable_pending_events_;
+    }
     return_tickets_.push_back(
         {.stream_id = stream_id, .expects_response = event.touch_event.has_pointer_sample()});
     events.emplace_back(std::move(event));
@@ -5,8 +5,10 @@
 #ifndef SRC_UI_SCENIC_LIB_INPUT_TOUCH_SOURCE_BASE_H_
 #define SRC_UI_SCENIC_LIB_INPUT_TOUCH_SOURCE_BASE_H_
 
+#include <lib/async/cpp/task.h>
 #include <lib/fit/function.h>
 #include <lib/inspect/cpp/inspect.h>
+#include <lib/zx/time.h>
 
 #include <queue>
 #include <unordered_map>
@@ -52,11 +54,15 @@ class TouchSourceBase : public GestureContender {
   };
 
   // |respond_| must not destroy the TouchSourceBase object.
+  // If |batch_interval| is non-zero, events which only move a pointer are held back for up to
+  // |batch_interval| before being sent to a waiting Watch() call, so that high-rate touchscreens
+  // don't wake up the client for every sample. Every other event is sent immediately, along with
+  // all events held back before it.
   TouchSourceBase(zx_koid_t channel_koid, zx_koid_t view_ref_koid,
                   fit::function<void(StreamId, const std::vector<GestureResponse>&)> respond,
                   fit::function<void(zx_status_t)> close_channel,
                   fit::function<void(AugmentedTouchEvent&, const InternalTouchEvent&)> augment,
-                  GestureContenderInspector& inspector);
+                  GestureContenderInspector& inspector, zx::duration batch_interval);
 
   void WatchBase(std::vector<fuchsia::ui::pointer::TouchResponse> responses,
                  fit::function<void(std::vector<AugmentedTouchEvent>)> callback);
@@ -92,10 +98,18 @@ class TouchSourceBase : public GestureContender {
   struct PendingEvent {
     StreamId stream_id = kInvalidStreamId;
     AugmentedTouchEvent event;
+    zx::time arrival_time;
   };
 
+  void PushPendingEvent(StreamId stream_id, AugmentedTouchEvent event);
+
+  // Sends pending events if there is a waiting Watch() call, unless they are held back for
+  // batching.
   void SendPendingIfWaiting();
 
+  // Sends pending events to the waiting Watch() call.
+  void SendPending();
+
   // Checks that the input is valid for the current state. If not valid it returns the error string
   // to print and the epitaph to send on the channel when closing.
   static zx_status_t ValidateResponses(
@@ -114,6 +128,11 @@ class TouchSourceBase : public GestureContender {
   // Events waiting to be sent to client. Sent in batches of up to
   // fuchsia::ui::pointer::TOUCH_MAX_EVENT events on each call to Watch().
   std::queue<PendingEvent> pending_events_;
+  // The number of events in |pending_events_| which must not be held back for batching.
+  size_t num_unbatchable_pending_events_ = 0;
+
+  const zx::duration batch_interval_;
+  async::TaskClosureMethod<TouchSourceBase, &TouchSourceBase::SendPending> batch_task_{this};
   // When a vector of events is sent out in response to a Watch() call, the next Watch() call must
   // contain responses matching the previous set of events. |return_tickets_| tracks the expected
   // responses for the previous set of events.
@@ -27,7 +27,7 @@ TouchSourceWithLocalHit::TouchSourceWithLocalHit(
                 .local_point = local_point,
             };
           },
-          inspector),
+          inspector, /*batch_interval*/ zx::duration(0)),
       binding_(this, std::move(request)),
       error_handler_(std::move(error_handler)),
       get_local_hit_(std::move(get_local_hit)) {
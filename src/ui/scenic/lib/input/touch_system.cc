@@ -84,11 +84,13 @@ void ChattyA11yLog(const fuchsia::ui::input::accessibility::PointerEvent& event)
 TouchSystem::TouchSystem(sys::ComponentContext* context,
                          std::shared_ptr<const view_tree::Snapshot>& view_tree_snapshot,
                          HitTester& hit_tester, inspect::Node& parent_node,
-                         RequestFocusFunc request_focus, fxl::WeakPtr<gfx::SceneGraph> scene_graph)
+                         RequestFocusFunc request_focus, fxl::WeakPtr<gfx::SceneGraph> scene_graph,
+                         zx::duration touch_batch_interval)
     : view_tree_snapshot_(view_tree_snapshot),
       hit_tester_(hit_tester),
       request_focus_(std::move(request_focus)),
       scene_graph_(std::move(scene_graph)),
+      touch_batch_interval_(touch_batch_interval),
       contender_inspector_(parent_node.CreateChild("GestureContenders")) {
   a11y_pointer_event_registry_.emplace(
       context,
@@ -287,7 +289,7 @@ void TouchSystem::RegisterTouchSource(
                           [this, contender_id, client_view_ref_koid] {
                             EraseContender(contender_id, client_view_ref_koid);
                           },
-                          contender_inspector_));
+                          contender_inspector_, touch_batch_interval_));
     FX_DCHECK(success);
   }
   {
@@ -30,7 +30,8 @@ class TouchSystem : public fuchsia::ui::pointer::augment::LocalHit {
   explicit TouchSystem(sys::ComponentContext* context,
                        std::shared_ptr<const view_tree::Snapshot>& view_tree_snapshot,
                        HitTester& hit_tester, inspect::Node& parent_node,
-                       RequestFocusFunc request_focus, fxl::WeakPtr<gfx::SceneGraph> scene_graph);
+                       RequestFocusFunc request_focus, fxl::WeakPtr<gfx::SceneGraph> scene_graph,
+                       zx::duration touch_batch_interval = zx::duration(0));
   ~TouchSystem() = default;
 
   fuchsia::ui::input::accessibility::PointerEventListenerPtr&
@@ -104,6 +105,8 @@ class TouchSystem : public fuchsia::ui::pointer::augment::LocalHit {
   const RequestFocusFunc request_focus_;
   // TODO(fxbug.dev/64206): Remove when we no longer have any legacy clients.
   fxl::WeakPtr<gfx::SceneGraph> scene_graph_;
+  // How long TouchSources hold back pointer movements for batching, see TouchSourceBase.
+  const zx::duration touch_batch_interval_;
   // An inspector that tracks all GestureContenders, so data can persist past contender lifetimes.
   // Must outlive all contenders.
   GestureContenderInspector contender_inspector_;
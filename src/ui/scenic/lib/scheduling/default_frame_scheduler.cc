@@ -33,6 +33,7 @@ DefaultFrameScheduler::DefaultFrameScheduler(std::unique_ptr<FramePredictor> pre
       frame_predictor_(std::move(predictor)),
       inspect_node_(std::move(inspect_node)),
       stats_(inspect_node_.CreateChild("Frame Stats"), metrics_logger),
+      session_present_stats_(inspect_node_.CreateChild("Session Present Stats")),
       weak_factory_(this) {
   FX_DCHECK(frame_predictor_);
 
@@ -169,6 +170,7 @@ void DefaultFrameScheduler::MaybeRenderFrame(async_dispatcher_t*, async::TaskBas
 
   // Apply all updates
   const zx::time update_start_time = zx::time(async_now(dispatcher_));
+  session_present_stats_.RecordLatchPoint(update_start_time, target_presentation_time);
 
   // The second value, |wakeup_time_|, here is important for ensuring our flows stay connected.
   // If you change it please ensure the "request_to_render" flow stays connected.
@@ -261,10 +263,15 @@ void DefaultFrameScheduler::ScheduleUpdateForSession(zx::time requested_presenta
                 << " requested_presentation_time: " << requested_presentation_time.get();
   }
 
+  const zx::time now = zx::time(async_now(dispatcher_));
+  session_present_stats_.RecordPresentArrival(id_pair.session_id, requested_presentation_time,
+                                              now);
+
   const trace_flow_id_t flow_id = TRACE_NONCE();
   TRACE_FLOW_BEGIN("gfx", "request_to_render", flow_id);
   pending_present_requests_.emplace(std::make_pair(
       id_pair, PresentRequest{.requested_presentation_time = requested_presentation_time,
+                              .arrival_time = now,
                               .flow_id = flow_id,
                               .squashable = squashable}));
 
@@ -391,11 +398,13 @@ void DefaultFrameScheduler::RemoveSession(SessionId session_id) {
   RemoveSessionIdFromMap(session_id, &presents_);
   RemoveSessionIdFromMap(session_id, &pending_present_requests_);
   RemoveSessionIdFromMap(session_id, &release_fences_);
+  session_present_stats_.RemoveSession(session_id);
 }
 
 std::unordered_map<SessionId, PresentId> DefaultFrameScheduler::CollectUpdatesForThisFrame(
     zx::time target_presentation_time) {
   std::unordered_map<SessionId, PresentId> updates;
+  const zx::time latch_point = zx::time(async_now(dispatcher_));
 
   SessionId current_session = scheduling::kInvalidSessionId;
   bool hit_limit = false;
@@ -414,6 +423,8 @@ std::unordered_map<SessionId, PresentId> DefaultFrameScheduler::CollectUpdatesFo
         preceding_update_is_squashable &&
         sessions_with_unsquashable_updates_pending_presentation_.count(id_pair.session_id) == 0) {
       TRACE_FLOW_END("gfx", "request_to_render", present_request.flow_id);
+      session_present_stats_.RecordPresentLatched(id_pair.session_id, present_request.arrival_time,
+                                                  latch_point);
       // Return only the last relevant present id for each session.
       updates[current_session] = id_pair.present_id;
       if (!present_request.squashable) {
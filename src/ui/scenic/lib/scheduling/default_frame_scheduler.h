@@ -18,6 +18,7 @@
 #include "src/ui/scenic/lib/scheduling/frame_predictor.h"
 #include "src/ui/scenic/lib/scheduling/frame_scheduler.h"
 #include "src/ui/scenic/lib/scheduling/frame_stats.h"
+#include "src/ui/scenic/lib/scheduling/session_present_stats.h"
 #include "src/ui/scenic/lib/scheduling/vsync_timing.h"
 
 namespace scheduling {
@@ -123,6 +124,8 @@ class DefaultFrameScheduler final : public FrameScheduler {
 
   struct PresentRequest {
     zx::time requested_presentation_time;
+    // The time at which ScheduleUpdateForSession() was called.
+    zx::time arrival_time;
     trace_flow_id_t flow_id;
     // Determines if this Present can be combined with following Presents, or must be displayed for
     // at least one frame.
@@ -185,6 +188,7 @@ class DefaultFrameScheduler final : public FrameScheduler {
   zx::time last_successful_render_start_time_ = zx::time(0);
 
   FrameStats stats_;
+  SessionPresentStats session_present_stats_;
 
   fxl::WeakPtrFactory<DefaultFrameScheduler> weak_factory_;  // must be last
 
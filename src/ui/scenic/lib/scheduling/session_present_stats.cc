@@ -0,0 +1,65 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/ui/scenic/lib/scheduling/session_present_stats.h"
+
+#include <lib/syslog/cpp/macros.h>
+
+#include <algorithm>
+#include <string>
+
+namespace scheduling {
+
+SessionPresentStats::SessionPresentStats(inspect::Node inspect_node)
+    : inspect_node_(std::move(inspect_node)) {}
+
+void SessionPresentStats::RecordLatchPoint(zx::time latch_point,
+                                           zx::time target_presentation_time) {
+  FX_DCHECK(latch_point <= target_presentation_time);
+  last_latch_point_ = latch_point;
+  last_target_presentation_time_ = target_presentation_time;
+}
+
+void SessionPresentStats::RecordPresentArrival(SessionId session_id,
+                                               zx::time requested_presentation_time,
+                                               zx::time arrival_time) {
+  if (arrival_time <= last_latch_point_ || arrival_time >= last_target_presentation_time_ ||
+      requested_presentation_time > last_target_presentation_time_) {
+    return;
+  }
+
+  auto& stats = GetStats(session_id);
+  stats.missed_latch_points.Set(++stats.missed_latch_points_count);
+  stats.missed_by_us.Insert((arrival_time - last_latch_point_).to_usecs());
+}
+
+void SessionPresentStats::RecordPresentLatched(SessionId session_id, zx::time arrival_time,
+                                               zx::time latch_point) {
+  auto& stats = GetStats(session_id);
+  stats.presents.Set(++stats.presents_count);
+  stats.lead_time_us.Insert(std::max(latch_point - arrival_time, zx::duration(0)).to_usecs());
+}
+
+void SessionPresentStats::RemoveSession(SessionId session_id) { session_stats_.erase(session_id); }
+
+SessionPresentStats::Stats& SessionPresentStats::GetStats(SessionId session_id) {
+  auto it = session_stats_.find(session_id);
+  if (it != session_stats_.end()) {
+    return it->second;
+  }
+
+  Stats stats;
+  stats.node = inspect_node_.CreateChild("session_" + std::to_string(session_id));
+  stats.presents = stats.node.CreateUint("presents", 0);
+  stats.missed_latch_points = stats.node.CreateUint("missed_latch_points", 0);
+  stats.lead_time_us = stats.node.CreateExponentialUintHistogram(
+      "lead_time_us", kLeadTimeHistogramFloorUs, kLeadTimeHistogramInitialStepUs,
+      kLeadTimeHistogramStepMultiplier, kLeadTimeHistogramBuckets);
+  stats.missed_by_us = stats.node.CreateExponentialUintHistogram(
+      "missed_by_us", kLeadTimeHistogramFloorUs, kLeadTimeHistogramInitialStepUs,
+      kLeadTimeHistogramStepMultiplier, kLeadTimeHistogramBuckets);
+  return session_stats_.emplace(session_id, std::move(stats)).first->second;
+}
+
+}  // namespace scheduling
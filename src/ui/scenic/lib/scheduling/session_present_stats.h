@@ -0,0 +1,72 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SRC_UI_SCENIC_LIB_SCHEDULING_SESSION_PRESENT_STATS_H_
+#define SRC_UI_SCENIC_LIB_SCHEDULING_SESSION_PRESENT_STATS_H_
+
+#include <lib/zx/time.h>
+
+#include <unordered_map>
+
+#include "lib/inspect/cpp/inspect.h"
+#include "src/ui/scenic/lib/scheduling/id.h"
+
+namespace scheduling {
+
+// Class for collecting per-session stats on when presents arrive relative to the latch points of
+// the FrameScheduler. Presents arriving long before the latch point they are applied at add
+// latency, and presents arriving shortly after a latch point they could have made are shown a frame
+// later than needed. Used for debug data, i.e. inspect, to tune frame prediction.
+class SessionPresentStats {
+ public:
+  explicit SessionPresentStats(inspect::Node inspect_node);
+
+  // Records a new latch point, at which the updates for |target_presentation_time| were applied.
+  void RecordLatchPoint(zx::time latch_point, zx::time target_presentation_time);
+
+  // Records that a present of |session_id| for |requested_presentation_time| arrived at
+  // |arrival_time|. Counts it as having missed the last latch point if it arrived after the last
+  // latch point, but in time to be shown at the frame which was being latched.
+  void RecordPresentArrival(SessionId session_id, zx::time requested_presentation_time,
+                            zx::time arrival_time);
+
+  // Records that a present of |session_id| which arrived at |arrival_time| was applied at
+  // |latch_point|.
+  void RecordPresentLatched(SessionId session_id, zx::time arrival_time, zx::time latch_point);
+
+  // Removes the stats of |session_id|.
+  void RemoveSession(SessionId session_id);
+
+  // Lead times are histogrammed in exponentially growing buckets, starting at 500us.
+  static constexpr uint64_t kLeadTimeHistogramFloorUs = 0;
+  static constexpr uint64_t kLeadTimeHistogramInitialStepUs = 500;
+  static constexpr uint64_t kLeadTimeHistogramStepMultiplier = 2;
+  static constexpr size_t kLeadTimeHistogramBuckets = 9;
+
+ private:
+  struct Stats {
+    inspect::Node node;
+    inspect::UintProperty presents;
+    inspect::UintProperty missed_latch_points;
+    // The times between the arrival of presents and the latch points they were applied at.
+    inspect::ExponentialUintHistogram lead_time_us;
+    // The times by which presents missed the latch point they could have made.
+    inspect::ExponentialUintHistogram missed_by_us;
+
+    uint64_t presents_count = 0;
+    uint64_t missed_latch_points_count = 0;
+  };
+
+  Stats& GetStats(SessionId session_id);
+
+  zx::time last_latch_point_ = zx::time(0);
+  zx::time last_target_presentation_time_ = zx::time(0);
+
+  inspect::Node inspect_node_;
+  std::unordered_map<SessionId, Stats> session_stats_;
+};
+
+}  // namespace scheduling
+
+#endif  // SRC_UI_SCENIC_LIB_SCHEDULING_SESSION_PRESENT_STATS_H_
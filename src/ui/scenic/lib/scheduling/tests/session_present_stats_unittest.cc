@@ -0,0 +1,95 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/ui/scenic/lib/scheduling/session_present_stats.h"
+
+#include <lib/inspect/cpp/hierarchy.h>
+#include <lib/inspect/cpp/reader.h>
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "lib/inspect/cpp/inspect.h"
+
+namespace scheduling {
+namespace test {
+
+namespace {
+
+constexpr char kNodeName[] = "SessionPresentStatsTest";
+
+uint64_t GetUint(const inspect::Hierarchy& root, SessionId session_id, const std::string& name) {
+  const auto* node = root.GetByPath({kNodeName, "session_" + std::to_string(session_id)});
+  EXPECT_TRUE(node);
+  if (!node) {
+    return 0;
+  }
+  const auto* property = node->node().get_property<inspect::UintPropertyValue>(name);
+  EXPECT_TRUE(property);
+  return property ? property->value() : 0;
+}
+
+uint64_t CountSamples(const inspect::Hierarchy& root, SessionId session_id,
+                      const std::string& name) {
+  const auto* node = root.GetByPath({kNodeName, "session_" + std::to_string(session_id)});
+  EXPECT_TRUE(node);
+  if (!node) {
+    return 0;
+  }
+  const auto* histogram = node->node().get_property<inspect::UintArrayValue>(name);
+  EXPECT_TRUE(histogram);
+  if (!histogram) {
+    return 0;
+  }
+  uint64_t count = 0;
+  for (const auto& bucket : histogram->GetBuckets()) {
+    count += bucket.count;
+  }
+  return count;
+}
+
+}  // namespace
+
+TEST(SessionPresentStatsTest, CountsMissedLatchPoints) {
+  inspect::Inspector inspector;
+  SessionPresentStats stats(inspector.GetRoot().CreateChild(kNodeName));
+
+  stats.RecordLatchPoint(zx::time(10'000'000), zx::time(16'000'000));
+  // Arrived after the latch point, and could have been shown at 16ms.
+  stats.RecordPresentArrival(/*session_id*/ 1, zx::time(0), zx::time(11'000'000));
+  // Requested a later presentation time, so it did not miss anything.
+  stats.RecordPresentArrival(/*session_id*/ 2, zx::time(32'000'000), zx::time(11'000'000));
+  // Arrived after the frame was shown.
+  stats.RecordPresentArrival(/*session_id*/ 3, zx::time(0), zx::time(17'000'000));
+
+  stats.RecordLatchPoint(zx::time(26'000'000), zx::time(32'000'000));
+  stats.RecordPresentLatched(/*session_id*/ 1, zx::time(11'000'000), zx::time(26'000'000));
+  stats.RecordPresentLatched(/*session_id*/ 2, zx::time(11'000'000), zx::time(26'000'000));
+  stats.RecordPresentLatched(/*session_id*/ 3, zx::time(17'000'000), zx::time(26'000'000));
+
+  const inspect::Hierarchy root = inspect::ReadFromVmo(inspector.DuplicateVmo()).take_value();
+  EXPECT_EQ(GetUint(root, 1, "missed_latch_points"), 1u);
+  EXPECT_EQ(GetUint(root, 2, "missed_latch_points"), 0u);
+  EXPECT_EQ(GetUint(root, 3, "missed_latch_points"), 0u);
+  EXPECT_EQ(CountSamples(root, 1, "missed_by_us"), 1u);
+  for (SessionId session_id = 1; session_id <= 3; ++session_id) {
+    EXPECT_EQ(GetUint(root, session_id, "presents"), 1u);
+    EXPECT_EQ(CountSamples(root, session_id, "lead_time_us"), 1u);
+  }
+}
+
+TEST(SessionPresentStatsTest, RemoveSession_ShouldRemoveItsNode) {
+  inspect::Inspector inspector;
+  SessionPresentStats stats(inspector.GetRoot().CreateChild(kNodeName));
+
+  stats.RecordPresentLatched(/*session_id*/ 1, zx::time(0), zx::time(1'000'000));
+  stats.RemoveSession(1);
+
+  const inspect::Hierarchy root = inspect::ReadFromVmo(inspector.DuplicateVmo()).take_value();
+  EXPECT_FALSE(root.GetByPath({kNodeName, "session_1"}));
+}
+
+}  // namespace test
+}  // namespace scheduling
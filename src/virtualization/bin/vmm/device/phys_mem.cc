@@ -6,6 +6,8 @@
 
 #include <lib/zx/vmar.h>
 
+#include <algorithm>
+
 zx_status_t PhysMem::Init(zx::vmo vmo) {
   size_t vmo_size;
   zx_status_t status = vmo.get_size(&vmo_size);
@@ -61,6 +63,46 @@ zx_status_t PhysMem::Init(const std::vector<GuestMemoryRegion>& guest_mem, zx::v
   return ZX_OK;
 }
 
+zx_status_t PhysMem::DecommitRanges(cpp20::span<const GuestMemoryRegion> ranges) const {
+  static const uint32_t page_size = zx_system_get_page_size();
+  std::vector<GuestMemoryRegion> sorted(ranges.begin(), ranges.end());
+  for (const GuestMemoryRegion& range : sorted) {
+    if (range.base % page_size != 0 || range.size % page_size != 0) {
+      return ZX_ERR_INVALID_ARGS;
+    }
+    if (range.base + range.size < range.base || range.base + range.size > vmo_size_) {
+      return ZX_ERR_OUT_OF_RANGE;
+    }
+  }
+  std::sort(sorted.begin(), sorted.end(), GuestMemoryRegion::CompareMinByBase);
+
+  auto decommit = [this](const GuestMemoryRegion& run) -> zx_status_t {
+    if (run.size == 0) {
+      return ZX_OK;
+    }
+    zx_status_t status = vmo_.op_range(ZX_VMO_OP_DECOMMIT, run.base, run.size, nullptr, 0);
+    if (status != ZX_OK) {
+      FX_PLOGS(ERROR, status) << "Failed to decommit guest memory " << std::hex << run.base
+                              << " - " << run.base + run.size;
+    }
+    return status;
+  };
+
+  GuestMemoryRegion run = {.base = 0, .size = 0};
+  for (const GuestMemoryRegion& range : sorted) {
+    if (run.size != 0 && range.base <= run.base + run.size) {
+      run.size = std::max(run.base + run.size, range.base + range.size) - run.base;
+      continue;
+    }
+    zx_status_t status = decommit(run);
+    if (status != ZX_OK) {
+      return status;
+    }
+    run = range;
+  }
+  return decommit(run);
+}
+
 PhysMem::~PhysMem() {
   if (child_vmar_.is_valid()) {
     zx_status_t status = child_vmar_.destroy();
@@ -43,6 +43,14 @@ class PhysMem {
   const zx::vmo& vmo() const { return vmo_; }
   size_t size() const { return vmo_size_; }
 
+  // Decommits the given ranges of guest memory, returning their pages to the host. The guest will
+  // read zeros from these ranges until it writes to them again.
+  //
+  // Ranges must be page aligned, but may be given in any order. Adjacent and overlapping ranges
+  // are merged so that the VMO sees as few decommit operations as possible, which matters when a
+  // guest reports free memory as many small, mostly contiguous chunks.
+  zx_status_t DecommitRanges(cpp20::span<const GuestMemoryRegion> ranges) const;
+
   // Requests a pointer to the guest memory at the given offset, valid for the
   // given number of bytes.
   //
@@ -105,4 +105,42 @@ TEST_F(PhysMemDeathTest, InitializeWithoutPageAlignment) {
                "Guest memory region must end at a page aligned address");
 }
 
+TEST_F(PhysMemTest, DecommitRanges) {
+  ASSERT_EQ(ZX_OK, InitializeVmoWithRandomData(static_cast<uint64_t>(kPageSize * 4)));
+
+  PhysMem physmem;
+  ASSERT_EQ(ZX_OK, physmem.Init(std::move(vmo_)));
+
+  // Out of order, adjacent ranges are merged into a single decommit of pages 1 and 2.
+  std::vector<GuestMemoryRegion> ranges = {{.base = kPageSize * 2, .size = kPageSize},
+                                           {.base = kPageSize, .size = kPageSize}};
+  ASSERT_EQ(ZX_OK, physmem.DecommitRanges(ranges));
+
+  zx_info_vmo_t info;
+  ASSERT_EQ(ZX_OK, physmem.vmo().get_info(ZX_INFO_VMO, &info, sizeof(info), nullptr, nullptr));
+  EXPECT_EQ(info.committed_bytes, static_cast<uint64_t>(kPageSize) * 2);
+
+  std::vector<uint8_t> buffer(static_cast<size_t>(kPageSize) * 4);
+  memcpy(buffer.data(), physmem.ptr(0, buffer.size()), buffer.size());
+  EXPECT_THAT(cpp20::span(buffer).subspan(0, kPageSize),
+              ElementsAreArray(data_.begin(), data_.begin() + kPageSize));
+  EXPECT_THAT(cpp20::span(buffer).subspan(kPageSize, static_cast<size_t>(kPageSize) * 2),
+              ::testing::Each(0));
+  EXPECT_THAT(cpp20::span(buffer).subspan(static_cast<size_t>(kPageSize) * 3),
+              ElementsAreArray(data_.begin() + static_cast<uint64_t>(kPageSize * 3), data_.end()));
+}
+
+TEST_F(PhysMemTest, DecommitInvalidRanges) {
+  ASSERT_EQ(ZX_OK, InitializeVmoWithRandomData(static_cast<uint64_t>(kPageSize * 4)));
+
+  PhysMem physmem;
+  ASSERT_EQ(ZX_OK, physmem.Init(std::move(vmo_)));
+
+  std::vector<GuestMemoryRegion> unaligned = {{.base = kPageSize / 2, .size = kPageSize}};
+  EXPECT_EQ(ZX_ERR_INVALID_ARGS, physmem.DecommitRanges(unaligned));
+
+  std::vector<GuestMemoryRegion> out_of_range = {{.base = kPageSize * 3, .size = kPageSize * 2}};
+  EXPECT_EQ(ZX_ERR_OUT_OF_RANGE, physmem.DecommitRanges(out_of_range));
+}
+
 }  // namespace
@@ -317,24 +317,46 @@ void GuestEthernet::NetworkDeviceImplSetSnoop(bool snoop) {
 }
 
 void GuestEthernet::TxComplete(uint32_t buffer_id, zx_status_t status) {
-  async::PostTask(dispatcher_, [this, buffer_id, status]() {
-    tx_result result = {
-        .id = buffer_id,
-        .status = status,
-    };
-    parent_.CompleteTx(&result, /*tx_count=*/1);
+  if (pending_tx_results_.empty()) {
+    async::PostTask(dispatcher_, [this]() { FlushTxComplete(); });
+  }
+  pending_tx_results_.push_back({
+      .id = buffer_id,
+      .status = status,
   });
 }
 
 void GuestEthernet::RxComplete(uint32_t buffer_id, size_t length) {
   FX_DCHECK(length < UINT32_MAX);
-  async::PostTask(dispatcher_, [this, buffer_id, length = static_cast<uint32_t>(length)]() {
-    rx_buffer_part part = {
-        .id = buffer_id,
-        .offset = 0,
-        .length = static_cast<uint32_t>(length),
-    };
-    rx_buffer rx_info = {
+  if (pending_rx_parts_.empty()) {
+    async::PostTask(dispatcher_, [this]() { FlushRxComplete(); });
+  }
+  pending_rx_parts_.push_back({
+      .id = buffer_id,
+      .offset = 0,
+      .length = static_cast<uint32_t>(length),
+  });
+}
+
+void GuestEthernet::FlushTxComplete() {
+  std::vector<tx_result> results;
+  {
+    std::lock_guard guard(mutex_);
+    results.swap(pending_tx_results_);
+  }
+  parent_.CompleteTx(results.data(), results.size());
+}
+
+void GuestEthernet::FlushRxComplete() {
+  std::vector<rx_buffer_part> parts;
+  {
+    std::lock_guard guard(mutex_);
+    parts.swap(pending_rx_parts_);
+  }
+  std::vector<rx_buffer> buffers;
+  buffers.reserve(parts.size());
+  for (const rx_buffer_part& part : parts) {
+    buffers.push_back({
         .meta =
             {
                 .port = kPortId,
@@ -342,9 +364,9 @@ void GuestEthernet::RxComplete(uint32_t buffer_id, size_t length) {
             },
         .data_list = &part,
         .data_count = 1,
-    };
-    parent_.CompleteRx(&rx_info, /*rx_count=*/1);
-  });
+    });
+  }
+  parent_.CompleteRx(buffers.data(), buffers.size());
 }
 
 zx::status<cpp20::span<uint8_t>> GuestEthernet::GetIoRegion(uint8_t vmo_id, uint64_t offset,
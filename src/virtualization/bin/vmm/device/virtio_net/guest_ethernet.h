@@ -87,12 +87,20 @@ class GuestEthernet : public ddk::NetworkDeviceImplProtocol<GuestEthernet>,
   };
 
   // Notify this device that transmission of the given packet has completed.
-  void TxComplete(uint32_t buffer_id, zx_status_t status);
+  void TxComplete(uint32_t buffer_id, zx_status_t status) __TA_REQUIRES(mutex_);
 
   // Notify netstack that the given buffer has been processed.
   //
   // A length of 0 can be used to indicate that the buffer was unused.
-  void RxComplete(uint32_t buffer_id, size_t length);
+  void RxComplete(uint32_t buffer_id, size_t length) __TA_REQUIRES(mutex_);
+
+  // Deliver all pending TX or RX completions to netstack in a single call.
+  //
+  // Completions are queued by TxComplete and RxComplete, and a flush is posted to the dispatcher
+  // when the first completion of a batch is queued. A burst of packets processed in one pass over
+  // a virtqueue is therefore returned to netstack with one FIFO write rather than one per packet.
+  void FlushTxComplete();
+  void FlushRxComplete();
 
   // If the device is in the ShuttingDown state and no packets are pending, finish
   // device shutdown.
@@ -128,6 +136,10 @@ class GuestEthernet : public ddk::NetworkDeviceImplProtocol<GuestEthernet>,
     cpp20::span<uint8_t> region;
   };
   std::vector<AvailableBuffer> available_buffers_ __TA_GUARDED(mutex_);
+
+  // Completions waiting to be delivered to netstack by FlushTxComplete and FlushRxComplete.
+  std::vector<tx_result> pending_tx_results_ __TA_GUARDED(mutex_);
+  std::vector<rx_buffer_part> pending_rx_parts_ __TA_GUARDED(mutex_);
 };
 
 #endif  // SRC_VIRTUALIZATION_BIN_VMM_DEVICE_VIRTIO_NET_GUEST_ETHERNET_H_
@@ -134,6 +134,9 @@ class TxStream {
 
   void Notify() {
     std::lock_guard guard(checker_);
+    // Chains are returned without interrupting the guest, and the guest is interrupted at most once
+    // for the whole batch on the way out.
+    auto notify_used = fit::defer([this] { queue_.NotifyUsed(); });
 
     // If Send returned ZX_ERR_SHOULD_WAIT last time Notify was called, then we should process that
     // descriptor first.
@@ -142,10 +145,10 @@ class TxStream {
       if (!processed) {
         return;
       }
-      pending_chain_.Return();
+      pending_chain_.Return(VirtioQueue::SET_QUEUE);
     }
 
-    for (VirtioChain chain; queue_.NextChain(&chain); chain.Return()) {
+    for (VirtioChain chain; queue_.NextChain(&chain); chain.Return(VirtioQueue::SET_QUEUE)) {
       VirtioDescriptor desc;
       chain.NextDescriptor(&desc);
       if (desc.has_next) {
@@ -33,6 +33,8 @@ void VirtioQueue::Configure(uint16_t size, zx_gpaddr_t desc, zx_gpaddr_t avail,
 
   const uintptr_t avail_event_addr = used + used_size;
   ring_.avail_event = phys_mem_->aligned_as<uint16_t>(avail_event_addr);
+
+  checked_used_index_ = ring_.used->idx;
 }
 
 bool VirtioQueue::NextChain(VirtioChain* chain) {
@@ -69,6 +71,32 @@ bool VirtioQueue::NextChain(VirtioChain* chain) {
   return true;
 }
 
+size_t VirtioQueue::NextChains(VirtioChain* chains, size_t max_chains) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (ring_.avail == nullptr) {
+    return 0;
+  }
+  uint16_t avail_index = __atomic_load_n(&ring_.avail->idx, __ATOMIC_ACQUIRE);
+  uint16_t length = avail_index - ring_.index;
+  // Same validation as NextChain().
+  if (length > ring_.size) {
+    return 0;
+  }
+  size_t count = 0;
+  while (count < max_chains && ring_.index != avail_index) {
+    uint16_t head = ring_.avail->ring[ring_.index % ring_.size];
+    if (head >= ring_.size) {
+      break;
+    }
+    chains[count++] = VirtioChain(this, head);
+    ring_.index++;
+  }
+  if (use_event_index_ && count > 0) {
+    *ring_.avail_event = ring_.index;
+  }
+  return count;
+}
+
 zx_status_t VirtioQueue::NextAvailLocked(uint16_t* index) {
   if (!HasAvailLocked()) {
     return ZX_ERR_SHOULD_WAIT;
@@ -145,32 +173,8 @@ zx_status_t VirtioQueue::Return(uint16_t index, uint32_t len, uint8_t actions) {
     // can use the cheaper __atomic_store instead of __atomic_add_fetch
     __atomic_store_n(&ring_.used->idx, ring_.used->idx + 1, __ATOMIC_RELEASE);
 
-    // Must ensure the read of flags or used_event occurs *after* we have returned the chain and
-    // published the index. We also need to ensure that in the event we do send an interrupt that
-    // any state and idx updates have been written. In this case acquire/release is not sufficient
-    // since the 'acquire' will prevent future loads re-ordering earlier, and the release will
-    // prevent past writes from re-ordering later, but we need a past write and a future load to not
-    // be re-ordered. Therefore we require sequentially consistent semantics.
-    std::atomic_thread_fence(std::memory_order_seq_cst);
-
-    // Virtio 1.0 Section 2.4.7.2: Virtqueue Interrupt Suppression
-    if (!use_event_index_) {
-      // If the VIRTIO_F_EVENT_IDX feature bit is not negotiated:
-      //  - The device MUST ignore the used_event value.
-      //  - After the device writes a descriptor index into the used ring:
-      //    - If flags is 1, the device SHOULD NOT send an interrupt.
-      //    - If flags is 0, the device MUST send an interrupt.
-      needs_interrupt = ring_.avail->flags == 0;
-    } else {
-      // Otherwise, if the VIRTIO_F_EVENT_IDX feature bit is negotiated:
-      //
-      //  - The device MUST ignore the lower bit of flags.
-      //  - After the device writes a descriptor index into the used ring:
-      //    - If the idx field in the used ring (which determined where that
-      //      descriptor index was placed) was equal to used_event, the device
-      //      MUST send an interrupt.
-      //    - Otherwise the device SHOULD NOT send an interrupt.
-      needs_interrupt = ring_.used->idx == (*ring_.used_event + 1);
+    if (actions & TRY_INTERRUPT) {
+      needs_interrupt = NeedsInterruptLocked();
     }
   }
 
@@ -180,6 +184,61 @@ zx_status_t VirtioQueue::Return(uint16_t index, uint32_t len, uint8_t actions) {
   return ZX_OK;
 }
 
+zx_status_t VirtioQueue::NotifyUsed(uint8_t actions) {
+  bool needs_interrupt;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (ring_.used == nullptr) {
+      return ZX_OK;
+    }
+    needs_interrupt = NeedsInterruptLocked();
+  }
+
+  if (needs_interrupt) {
+    return interrupt_(actions);
+  }
+  return ZX_OK;
+}
+
+bool VirtioQueue::NeedsInterruptLocked() {
+  const uint16_t old_index = checked_used_index_;
+  const uint16_t new_index = ring_.used->idx;
+  checked_used_index_ = new_index;
+  if (old_index == new_index) {
+    return false;
+  }
+
+  // Must ensure the read of flags or used_event occurs *after* we have returned the chain and
+  // published the index. We also need to ensure that in the event we do send an interrupt that
+  // any state and idx updates have been written. In this case acquire/release is not sufficient
+  // since the 'acquire' will prevent future loads re-ordering earlier, and the release will
+  // prevent past writes from re-ordering later, but we need a past write and a future load to not
+  // be re-ordered. Therefore we require sequentially consistent semantics.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  // Virtio 1.0 Section 2.4.7.2: Virtqueue Interrupt Suppression
+  if (!use_event_index_) {
+    // If the VIRTIO_F_EVENT_IDX feature bit is not negotiated:
+    //  - The device MUST ignore the used_event value.
+    //  - After the device writes a descriptor index into the used ring:
+    //    - If flags is 1, the device SHOULD NOT send an interrupt.
+    //    - If flags is 0, the device MUST send an interrupt.
+    return ring_.avail->flags == 0;
+  }
+  // Otherwise, if the VIRTIO_F_EVENT_IDX feature bit is negotiated:
+  //
+  //  - The device MUST ignore the lower bit of flags.
+  //  - After the device writes a descriptor index into the used ring:
+  //    - If the idx field in the used ring (which determined where that
+  //      descriptor index was placed) was equal to used_event, the device
+  //      MUST send an interrupt.
+  //    - Otherwise the device SHOULD NOT send an interrupt.
+  //
+  // Since several descriptors may have been written since the last check, this sends an interrupt
+  // if any of them was placed at used_event.
+  return vring_need_event(*ring_.used_event, new_index, old_index);
+}
+
 VirtioChain::VirtioChain(VirtioQueue* queue, uint16_t head)
     : queue_(queue), head_(head), next_(head), has_next_(true) {}
 
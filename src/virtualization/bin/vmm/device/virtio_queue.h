@@ -94,6 +94,10 @@ class VirtioQueue {
 
   bool NextChain(VirtioChain* chain);
 
+  // Reads up to |max_chains| chains from the avail ring into |chains|, loading the avail index
+  // once for the whole batch. Returns the number of chains read.
+  size_t NextChains(VirtioChain* chains, size_t max_chains);
+
   // Get the index of the next descriptor in the available ring.
   //
   // If a buffer is a available, the descriptor index is written to |index|, the
@@ -124,8 +128,16 @@ class VirtioQueue {
   // if (for example) the device is returning several descriptors sequentially.
   // The |SEND_INTERRUPT| flag will still respect any requirements enforced by
   // the bus regarding interrupt suppression.
+  //
+  // Descriptors returned without |TRY_INTERRUPT| are still taken into account by the next call
+  // that has it, so a device can return a batch of chains with |SET_QUEUE| only, followed by a
+  // single |NotifyUsed|, and the guest gets at most one interrupt for the whole batch.
   zx_status_t Return(uint16_t index, uint32_t len, uint8_t actions = SET_QUEUE | TRY_INTERRUPT);
 
+  // Sends an interrupt for all descriptors returned since the last interrupt check, if the guest
+  // requires one.
+  zx_status_t NotifyUsed(uint8_t actions = SET_QUEUE | TRY_INTERRUPT);
+
   // Reads a single descriptor from the queue.
   //
   // This method should only be called using descriptor indices acquired with
@@ -136,6 +148,7 @@ class VirtioQueue {
  private:
   zx_status_t NextAvailLocked(uint16_t* index) __TA_REQUIRES(mutex_);
   bool HasAvailLocked() const __TA_REQUIRES(mutex_);
+  bool NeedsInterruptLocked() __TA_REQUIRES(mutex_);
 
   mutable std::mutex mutex_;
   const PhysMem* phys_mem_ = nullptr;
@@ -143,6 +156,9 @@ class VirtioQueue {
   VirtioRing ring_ __TA_GUARDED(mutex_) = {};
   zx::event event_;
   bool use_event_index_ __TA_GUARDED(mutex_) = false;
+  // The used index as of the last interrupt check. Descriptors between this and the current used
+  // index have been returned without the guest having been considered for an interrupt yet.
+  uint16_t checked_used_index_ __TA_GUARDED(mutex_) = 0;
 
   friend class VirtioQueueFake;
 };
@@ -5,6 +5,7 @@
 #include "src/virtualization/bin/vmm/device/virtio_queue.h"
 
 #include <gtest/gtest.h>
+#include <virtio/virtio_ring.h>
 
 #include "src/virtualization/bin/vmm/device/virtio_queue_fake.h"
 
@@ -59,4 +60,84 @@ TEST(VirtioQueueTest, VirtioReadDesc) {
   ASSERT_EQ(queue.ReadDesc(2, &desc), ZX_ERR_OUT_OF_RANGE);
 }
 
+class VirtioQueueBatchTest : public ::testing::Test {
+ protected:
+  static constexpr uint16_t kQueueSize = 16;
+
+  void SetUp() override {
+    zx::vmo vmo;
+    ASSERT_EQ(zx::vmo::create(4 * PAGE_SIZE, 0, &vmo), ZX_OK);
+    ASSERT_EQ(phys_mem_.Init(std::move(vmo)), ZX_OK);
+    queue_.set_phys_mem(&phys_mem_);
+    queue_.set_interrupt([this](uint8_t) {
+      interrupt_count_++;
+      return ZX_OK;
+    });
+    queue_.Configure(kQueueSize, 0, PAGE_SIZE, 2 * PAGE_SIZE);
+    avail_ = phys_mem_.aligned_as<vring_avail>(PAGE_SIZE);
+    used_event_ = reinterpret_cast<uint16_t*>(&avail_->ring[kQueueSize]);
+  }
+
+  // Makes |count| single-descriptor chains available to the device.
+  void MakeAvail(uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) {
+      avail_->ring[avail_->idx % kQueueSize] = avail_->idx % kQueueSize;
+      avail_->idx++;
+    }
+  }
+
+  PhysMem phys_mem_;
+  VirtioQueue queue_;
+  vring_avail* avail_;
+  uint16_t* used_event_;
+  size_t interrupt_count_ = 0;
+};
+
+TEST_F(VirtioQueueBatchTest, NextChains) {
+  MakeAvail(3);
+
+  VirtioChain chains[4];
+  ASSERT_EQ(queue_.NextChains(chains, 2), 2u);
+  ASSERT_EQ(queue_.NextChains(chains + 2, 2), 1u);
+  ASSERT_EQ(queue_.NextChains(chains + 3, 1), 0u);
+  for (size_t i = 0; i < 3; i++) {
+    ASSERT_TRUE(chains[i].IsValid());
+    chains[i].Return();
+  }
+  ASSERT_FALSE(chains[3].IsValid());
+}
+
+TEST_F(VirtioQueueBatchTest, OneInterruptPerBatch) {
+  MakeAvail(4);
+
+  VirtioChain chains[4];
+  ASSERT_EQ(queue_.NextChains(chains, 4), 4u);
+  for (auto& chain : chains) {
+    chain.Return(VirtioQueue::SET_QUEUE);
+  }
+  EXPECT_EQ(interrupt_count_, 0u);
+  EXPECT_EQ(queue_.NotifyUsed(), ZX_OK);
+  EXPECT_EQ(interrupt_count_, 1u);
+
+  // Nothing new has been returned since.
+  EXPECT_EQ(queue_.NotifyUsed(), ZX_OK);
+  EXPECT_EQ(interrupt_count_, 1u);
+}
+
+TEST_F(VirtioQueueBatchTest, EventIndexWithinBatch) {
+  queue_.set_use_event_index(true);
+  MakeAvail(4);
+  // Ask for an interrupt once the third descriptor has been used.
+  *used_event_ = 2;
+
+  VirtioChain chains[4];
+  ASSERT_EQ(queue_.NextChains(chains, 4), 4u);
+  chains[0].Return();
+  EXPECT_EQ(interrupt_count_, 0u);
+  chains[1].Return(VirtioQueue::SET_QUEUE);
+  chains[2].Return(VirtioQueue::SET_QUEUE);
+  chains[3].Return();
+  EXPECT_EQ(interrupt_count_, 1u);
+}
+
 }  // namespace
@@ -225,7 +225,7 @@ bool Guest::GenerateGuestMemoryRegions(uint64_t guest_memory,
   return true;
 }
 
-zx_status_t Guest::Init(uint64_t guest_memory) {
+zx_status_t Guest::Init(uint64_t guest_memory, bool large_pages) {
   zx::resource hypervisor_resource;
   zx_status_t status = get_hypervisor_resource(&hypervisor_resource);
   if (status != ZX_OK) {
@@ -253,7 +253,7 @@ zx_status_t Guest::Init(uint64_t guest_memory) {
   uint64_t vmo_size = memory_regions_.back().base + memory_regions_.back().size;
 
   zx::vmo vmo;
-  status = zx::vmo::create(vmo_size, 0, &vmo);
+  status = zx::vmo::create(vmo_size, large_pages ? ZX_VMO_LARGE_PAGES : 0, &vmo);
   if (status != ZX_OK) {
     FX_PLOGS(ERROR, status) << "Failed to create VMO of size " << vmo_size;
     return status;
@@ -280,11 +280,26 @@ zx_status_t Guest::Init(uint64_t guest_memory) {
   vmar_regions.push_back({512 * kOneKibibyte, 512 * kOneKibibyte});
 #endif
 
+  zx_vm_option_t map_options = ZX_VM_PERM_READ | ZX_VM_PERM_WRITE | ZX_VM_PERM_EXECUTE |
+                               ZX_VM_SPECIFIC | ZX_VM_REQUIRE_NON_RESIZABLE;
+  if (large_pages) {
+    // Guest physical addresses match VMO offsets, so the contiguous runs are suitably aligned in
+    // the guest. Commit them before mapping, so that the mappings can be established with large
+    // pages immediately.
+    for (const GuestMemoryRegion& region : memory_regions_) {
+      status = vmo.op_range(ZX_VMO_OP_COMMIT, region.base, region.size, nullptr, 0);
+      if (status != ZX_OK) {
+        FX_PLOGS(ERROR, status) << "Failed to commit guest memory region " << region.base << " - "
+                                << region.base + region.size;
+        return status;
+      }
+    }
+    map_options |= ZX_VM_MAP_RANGE;
+  }
+
   for (const GuestMemoryRegion& region : vmar_regions) {
     zx_gpaddr_t addr;
-    status = vmar_.map(ZX_VM_PERM_READ | ZX_VM_PERM_WRITE | ZX_VM_PERM_EXECUTE | ZX_VM_SPECIFIC |
-                           ZX_VM_REQUIRE_NON_RESIZABLE,
-                       region.base, vmo, region.base, region.size, &addr);
+    status = vmar_.map(map_options, region.base, vmo, region.base, region.size, &addr);
     if (status != ZX_OK) {
       FX_PLOGS(ERROR, status) << "Failed to map guest physical memory region " << region.base
                               << " - " << region.base + region.size;
@@ -39,7 +39,10 @@ class Guest {
   using VcpuArray = std::array<std::optional<Vcpu>, kMaxVcpus>;
   using IoMappingList = std::forward_list<IoMapping>;
 
-  zx_status_t Init(uint64_t guest_memory);
+  // Creates the guest and its physical memory. If |large_pages| is set, guest memory is committed
+  // up front from physically contiguous runs where possible, so that the kernel can map it into the
+  // guest with large pages, falling back to small pages where host memory is fragmented.
+  zx_status_t Init(uint64_t guest_memory, bool large_pages = false);
 
   const PhysMem& phys_mem() const { return phys_mem_; }
   const zx::guest& object() { return guest_; }
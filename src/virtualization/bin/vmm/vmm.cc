@@ -104,7 +104,10 @@ fitx::result<GuestError> Vmm::Initialize(GuestConfig cfg, ::sys::ComponentContex
 
   DevMem dev_mem;
   guest_ = std::make_unique<::Guest>();
-  zx_status_t status = guest_->Init(cfg.guest_memory());
+  // Without a balloon guest memory is never returned to the host, so it may as well be committed
+  // up front and mapped with large pages.
+  const bool large_pages = !(cfg.has_virtio_balloon() && cfg.virtio_balloon());
+  zx_status_t status = guest_->Init(cfg.guest_memory(), large_pages);
   if (status != ZX_OK) {
     return fitx::error(GuestError::GUEST_INITIALIZATION_FAILURE);
   }
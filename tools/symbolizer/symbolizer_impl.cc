@@ -148,9 +148,15 @@ void SymbolizerImpl::Reset(bool symbolizing_dart) {
   address_to_module_id_.clear();
   if (target_->GetState() == zxdb::Target::State::kRunning) {
     // OnProcessExiting() will destroy the Process, ProcessSymbols.
-    // Retain references to loaded TargetSymbols in |previous_modules_| so that they can be
-    // potentially reused for the subsequent stack trace.
-    previous_modules_ = target_->GetProcess()->GetSymbols()->target_symbols()->TakeModules();
+    // Retain references to loaded TargetSymbols in |retained_modules_| so that they can be
+    // potentially reused for subsequent stack traces.
+    for (auto& module : target_->GetProcess()->GetSymbols()->target_symbols()->TakeModules()) {
+      retained_modules_.remove(module);
+      retained_modules_.push_front(std::move(module));
+    }
+    while (retained_modules_.size() > kMaxRetainedModules) {
+      retained_modules_.pop_back();
+    }
     target_->OnProcessExiting(/*return_code=*/0, /*timestamp=*/0);
   }
 
@@ -284,10 +290,6 @@ void SymbolizerImpl::Backtrace(uint64_t frame_id, uint64_t address, AddressType
   zxdb::Stack& stack = target_->GetProcess()->GetThreads()[0]->GetStack();
   stack.SetFrames(debug_ipc::ThreadRecord::StackAmount::kFull, {frame});
 
-  // All modules for this stack trace have been loaded by this point, so we can discard retained
-  // data from previously handled stack traces (if any).
-  previous_modules_.clear();
-
   bool symbolized = false;
   for (size_t i = 0; i < stack.size(); i++) {
     std::string out = FormatFrameIdAndAddress(frame_id, stack.size() - i - 1, address);
@@ -7,6 +7,7 @@
 
 #include <cstdint>
 #include <iostream>
+#include <list>
 #include <memory>
 #include <string_view>
 #include <unordered_map>
@@ -104,9 +105,11 @@ class SymbolizerImpl : public Symbolizer,
   // commands. It's different from build_id.
   std::unordered_map<uint64_t, ModuleInfo> modules_;
 
-  // Holds symbol data from the previously handled stack trace.
-  // Replaced immediately once a new stack trace is handled.
-  std::vector<fxl::RefPtr<zxdb::ModuleSymbols>> previous_modules_;
+  // Holds symbol data of the modules used by the most recent stack traces, most recently used
+  // first, so that a module referenced again later in the log is not loaded and parsed again.
+  // SystemSymbols only reuses the ModuleSymbols which are still referenced.
+  static constexpr size_t kMaxRetainedModules = 64;
+  std::list<fxl::RefPtr<zxdb::ModuleSymbols>> retained_modules_;
 
   // Mapping from base address of each module to the module_id.
   // Useful when doing binary search for the module from an address.
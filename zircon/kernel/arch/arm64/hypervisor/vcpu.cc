@@ -268,11 +268,19 @@ zx_status_t Vcpu::Enter(zx_port_packet_t& packet) {
     if (status != ZX_OK) {
       return status;
     }
+    guest_mode_.Enter();
     timer_maybe_interrupt(guest_state, &gich_state_);
     gich_maybe_interrupt(&gich_state_, ich_state);
     {
       AutoGich auto_gich(ich_state, gich_state_.Pending());
 
+      // Interrupts were enabled while we populated the list registers, so if an
+      // interrupt was sent since then, the IPI for it may have been taken by the
+      // host. Populate the list registers again instead of entering the guest.
+      if (guest_mode_.Notified()) {
+        continue;
+      }
+
       // We check whether a kick was requested before entering the guest so that:
       // 1. When we enter the syscall, we can return immediately without entering
       //    the guest.
@@ -286,12 +294,14 @@ zx_status_t Vcpu::Enter(zx_port_packet_t& packet) {
       // is fired after we have disabled interrupts, when we enter the guest we
       // will exit due to the interrupt, and run this check again.
       if (kicked_.exchange(false)) {
+        guest_mode_.Exit();
         return ZX_ERR_CANCELED;
       }
 
       ktrace(TAG_VCPU_ENTER, 0, 0, 0, 0);
       GUEST_STATS_INC(vm_entries);
       status = arm64_el2_enter(vttbr, el2_state_.PhysicalAddress(), hcr_);
+      guest_mode_.Exit();
       GUEST_STATS_INC(vm_exits);
     }
     gich_state_.TrackAllListRegisters(ich_state);
@@ -330,6 +340,14 @@ void Vcpu::Kick() {
 
 void Vcpu::Interrupt(uint32_t vector) {
   gich_state_.Interrupt(vector);
+  // Only IPI the VCPU if it is in guest mode and has not been sent an IPI since
+  // it entered the guest. Otherwise it will pick up the interrupt before its
+  // next entry.
+  if (!guest_mode_.ShouldNotify()) {
+    ktrace_vcpu_interrupt(vector, true);
+    return;
+  }
+  ktrace_vcpu_interrupt(vector, false);
   // Check if the VCPU is running and whether to send an IPI. We hold the thread
   // lock to guard against thread migration between CPUs during the check.
   //
@@ -334,7 +334,7 @@ zx_status_t handle_data_abort(uint32_t iss, GuestState* guest_state,
       packet->key = (*trap)->key();
       packet->type = ZX_PKT_TYPE_GUEST_BELL;
       packet->guest_bell.addr = guest_paddr;
-      if (!(*trap)->HasPort()) {
+      if (!(*trap)->HasPort() && !(*trap)->HasEvent()) {
         return ZX_ERR_BAD_STATE;
       }
       return (*trap)->Queue(*packet).status_value();
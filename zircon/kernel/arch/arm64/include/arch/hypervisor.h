@@ -48,7 +48,7 @@ class Guest {
   Guest& operator=(const Guest&) = delete;
 
   zx_status_t SetTrap(uint32_t kind, zx_vaddr_t addr, size_t len, fbl::RefPtr<PortDispatcher> port,
-                      uint64_t key);
+                      fbl::RefPtr<EventDispatcher> event, uint64_t key);
 
   hypervisor::GuestPhysicalAddressSpace& AddressSpace() { return gpas_; }
   fbl::RefPtr<VmAddressRegion> RootVmar() const { return gpas_.RootVmar(); }
@@ -130,6 +130,7 @@ class Vcpu {
   // |thread_| will be set to nullptr when the thread exits.
   ktl::atomic<Thread*> thread_;
   ktl::atomic<bool> kicked_ = false;
+  hypervisor::GuestModeTracker guest_mode_;
   // We allocate El2State in its own page as it is passed between EL1 and EL2,
   // which have different address space mappings. This ensures that El2State
   // will not cross a page boundary and be incorrectly accessed in EL2.
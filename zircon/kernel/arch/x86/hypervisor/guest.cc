@@ -104,23 +104,25 @@ zx::status<ktl::unique_ptr<Guest>> NormalGuest::Create() {
 }
 
 zx_status_t NormalGuest::SetTrap(uint32_t kind, zx_vaddr_t addr, size_t len,
-                                 fbl::RefPtr<PortDispatcher> port, uint64_t key) {
+                                 fbl::RefPtr<PortDispatcher> port,
+                                 fbl::RefPtr<EventDispatcher> event, uint64_t key) {
   switch (kind) {
     case ZX_GUEST_TRAP_MEM:
-      if (port) {
+      if (port || event) {
         return ZX_ERR_INVALID_ARGS;
       }
       break;
     case ZX_GUEST_TRAP_BELL:
-      if (!port) {
+      // Bells are delivered to exactly one of a port or an event.
+      if (!port == !event) {
         return ZX_ERR_INVALID_ARGS;
       }
       break;
     case ZX_GUEST_TRAP_IO:
-      if (port) {
+      if (port || event) {
         return ZX_ERR_INVALID_ARGS;
       }
-      return traps_.InsertTrap(kind, addr, len, nullptr, key).status_value();
+      return traps_.InsertTrap(kind, addr, len, nullptr, nullptr, key).status_value();
     default:
       return ZX_ERR_INVALID_ARGS;
   }
@@ -132,7 +134,8 @@ zx_status_t NormalGuest::SetTrap(uint32_t kind, zx_vaddr_t addr, size_t len,
   if (auto result = gpas_.UnmapRange(addr, len); result.is_error()) {
     return result.status_value();
   }
-  return traps_.InsertTrap(kind, addr, len, ktl::move(port), key).status_value();
+  return traps_.InsertTrap(kind, addr, len, ktl::move(port), ktl::move(event), key)
+      .status_value();
 }
 
 // static
@@ -965,8 +965,12 @@ zx_status_t Vcpu::EnterInternal(PreEnterFn pre_enter, PostExitFn post_exit,
       return ZX_ERR_CANCELED;
     }
 
+    // Interrupts stay disabled until the guest entry, so any IPI sent after
+    // this point will cause a VM exit as soon as we have entered the guest.
+    guest_mode_.Enter();
     status = pre_enter(vmcs);
     if (status != ZX_OK) {
+      guest_mode_.Exit();
       return status;
     }
 
@@ -988,6 +992,7 @@ zx_status_t Vcpu::EnterInternal(PreEnterFn pre_enter, PostExitFn post_exit,
     ktrace(TAG_VCPU_ENTER, 0, 0, 0, 0);
     GUEST_STATS_INC(vm_entries);
     status = vmx_enter(&vmx_state_);
+    guest_mode_.Exit();
     GUEST_STATS_INC(vm_exits);
 
     if (!gBootOptions->x86_disable_spec_mitigations) {
@@ -1154,6 +1159,15 @@ void NormalVcpu::Kick() {
 void NormalVcpu::Interrupt(uint32_t vector) {
   local_apic_state_.interrupt_tracker.Interrupt(vector);
 
+  // Only IPI the VCPU if it is in guest mode and has not been sent an IPI since
+  // it entered the guest. Otherwise it will pick up the interrupt before its
+  // next entry.
+  if (!guest_mode_.ShouldNotify()) {
+    ktrace_vcpu_interrupt(vector, true);
+    return;
+  }
+  ktrace_vcpu_interrupt(vector, false);
+
   Guard<MonitoredSpinLock, IrqSave> guard{ThreadLock::Get(), SOURCE_TAG};
   interrupt_cpu(thread_.load(), last_cpu_);
 }
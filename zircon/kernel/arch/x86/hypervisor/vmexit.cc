@@ -921,7 +921,7 @@ zx_status_t handle_trap(const ExitInfo& exit_info, AutoVmcs& vmcs, bool read,
       packet.key = (*trap)->key();
       packet.type = ZX_PKT_TYPE_GUEST_BELL;
       packet.guest_bell.addr = guest_paddr;
-      if (!(*trap)->HasPort()) {
+      if (!(*trap)->HasPort() && !(*trap)->HasEvent()) {
         return ZX_ERR_BAD_STATE;
       }
       return (*trap)->Queue(packet, &vmcs).status_value();
@@ -66,7 +66,7 @@ class NormalGuest : public Guest {
   static zx::status<ktl::unique_ptr<Guest>> Create();
 
   zx_status_t SetTrap(uint32_t kind, zx_vaddr_t addr, size_t len, fbl::RefPtr<PortDispatcher> port,
-                      uint64_t key);
+                      fbl::RefPtr<EventDispatcher> event, uint64_t key);
 
   zx::status<uint16_t> TryAllocVpid() { return vpid_allocator_.TryAlloc(); }
   zx::status<> FreeVpid(uint16_t vpid) { return vpid_allocator_.Free(vpid); }
@@ -142,6 +142,7 @@ class Vcpu {
   // |thread_| will be set to nullptr when the thread exits.
   ktl::atomic<Thread*> thread_;
   ktl::atomic<bool> kicked_ = false;
+  hypervisor::GuestModeTracker guest_mode_;
   VmxPage host_msr_page_;
   VmxPage guest_msr_page_;
   VmxPage vmcs_page_;
@@ -70,9 +70,15 @@ void X86ArchRestrictedState::EnterRestricted() {
   DEBUG_ASSERT(x86_is_vaddr_canonical(state_.fs_base));
   DEBUG_ASSERT(x86_is_vaddr_canonical(state_.gs_base));
 
-  // load the user fs/gs base from restricted mode
-  write_msr(X86_MSR_IA32_FS_BASE, state_.fs_base);
-  write_msr(X86_MSR_IA32_KERNEL_GS_BASE, state_.gs_base);
+  // load the user fs/gs base from restricted mode. The MSRs still hold the normal mode values
+  // saved by SaveStatePreRestrictedEntry, and writing them is relatively expensive, so skip any
+  // that are unchanged.
+  if (state_.fs_base != normal_fs_base_) {
+    write_msr(X86_MSR_IA32_FS_BASE, state_.fs_base);
+  }
+  if (state_.gs_base != normal_gs_base_) {
+    write_msr(X86_MSR_IA32_KERNEL_GS_BASE, state_.gs_base);
+  }
 
   // copy to a kernel iframe_t
   // struct iframe_t {
@@ -139,11 +145,16 @@ void X86ArchRestrictedState::SaveRestrictedSyscallState(const syscall_regs_t *re
 }
 
 void X86ArchRestrictedState::EnterFull(uintptr_t vector_table, uintptr_t context, uint64_t code) {
-  // load the user fs/gs base from normal mode
+  // load the user fs/gs base from normal mode. The MSRs still hold the restricted mode values
+  // read by SaveRestrictedSyscallState, so as on entry, only write the ones that differ.
   DEBUG_ASSERT(x86_is_vaddr_canonical(normal_fs_base_));
   DEBUG_ASSERT(x86_is_vaddr_canonical(normal_gs_base_));
-  write_msr(X86_MSR_IA32_FS_BASE, normal_fs_base_);
-  write_msr(X86_MSR_IA32_KERNEL_GS_BASE, normal_gs_base_);
+  if (normal_fs_base_ != state_.fs_base) {
+    write_msr(X86_MSR_IA32_FS_BASE, normal_fs_base_);
+  }
+  if (normal_gs_base_ != state_.gs_base) {
+    write_msr(X86_MSR_IA32_KERNEL_GS_BASE, normal_gs_base_);
+  }
 
   // set up a mostly blank iframe and return back to normal mode
   iframe_t iframe{};
@@ -522,6 +522,33 @@ static bool interrupt_bitmap() {
   END_TEST;
 }
 
+static bool guest_mode_tracker() {
+  BEGIN_TEST;
+
+  hypervisor::GuestModeTracker guest_mode;
+
+  // Not in guest mode, so no IPI is needed.
+  EXPECT_FALSE(guest_mode.ShouldNotify());
+
+  // Entering the guest clears any earlier notification.
+  guest_mode.Enter();
+  EXPECT_FALSE(guest_mode.Notified());
+
+  // Only the first interrupt after entering the guest needs an IPI.
+  EXPECT_TRUE(guest_mode.ShouldNotify());
+  EXPECT_TRUE(guest_mode.Notified());
+  EXPECT_FALSE(guest_mode.ShouldNotify());
+
+  // After exiting, interrupts are picked up before the next entry.
+  guest_mode.Exit();
+  EXPECT_FALSE(guest_mode.ShouldNotify());
+
+  guest_mode.Enter();
+  EXPECT_TRUE(guest_mode.ShouldNotify());
+
+  END_TEST;
+}
+
 static bool trap_map_insert_trap_intersecting() {
   BEGIN_TEST;
 
@@ -530,34 +557,40 @@ static bool trap_map_insert_trap_intersecting() {
   // 1. [10, 19]
   // 2. [20, 29]
   // 3. [35, 5]
-  EXPECT_EQ(ZX_OK, trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, 10, 10, nullptr, 0).status_value());
-  EXPECT_EQ(ZX_OK, trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, 20, 10, nullptr, 0).status_value());
-  EXPECT_EQ(ZX_OK, trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, 35, 5, nullptr, 0).status_value());
+  EXPECT_EQ(ZX_OK,
+            trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, 10, 10, nullptr, nullptr, 0).status_value());
+  EXPECT_EQ(ZX_OK,
+            trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, 20, 10, nullptr, nullptr, 0).status_value());
+  EXPECT_EQ(ZX_OK,
+            trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, 35, 5, nullptr, nullptr, 0).status_value());
   // Trap at [0, 10] intersects with trap 1.
   EXPECT_EQ(ZX_ERR_ALREADY_EXISTS,
-            trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, 0, 11, nullptr, 0).status_value());
+            trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, 0, 11, nullptr, nullptr, 0).status_value());
   // Trap at [10, 19] intersects with trap 1.
   EXPECT_EQ(ZX_ERR_ALREADY_EXISTS,
-            trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, 10, 10, nullptr, 0).status_value());
+            trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, 10, 10, nullptr, nullptr, 0).status_value());
   // Trap at [11, 18] intersects with trap 1.
   EXPECT_EQ(ZX_ERR_ALREADY_EXISTS,
-            trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, 11, 8, nullptr, 0).status_value());
+            trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, 11, 8, nullptr, nullptr, 0).status_value());
   // Trap at [15, 24] intersects with trap 1 and trap 2.
   EXPECT_EQ(ZX_ERR_ALREADY_EXISTS,
-            trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, 15, 10, nullptr, 0).status_value());
+            trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, 15, 10, nullptr, nullptr, 0).status_value());
   // Trap at [30, 39] intersects with trap 3.
   EXPECT_EQ(ZX_ERR_ALREADY_EXISTS,
-            trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, 30, 10, nullptr, 0).status_value());
+            trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, 30, 10, nullptr, nullptr, 0).status_value());
   // Trap at [36, 40] intersects with trap 3.
   EXPECT_EQ(ZX_ERR_ALREADY_EXISTS,
-            trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, 36, 5, nullptr, 0).status_value());
+            trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, 36, 5, nullptr, nullptr, 0).status_value());
 
   // Add a trap at the beginning.
-  EXPECT_EQ(ZX_OK, trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, 0, 10, nullptr, 0).status_value());
+  EXPECT_EQ(ZX_OK,
+            trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, 0, 10, nullptr, nullptr, 0).status_value());
   // In the gap.
-  EXPECT_EQ(ZX_OK, trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, 30, 5, nullptr, 0).status_value());
+  EXPECT_EQ(ZX_OK,
+            trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, 30, 5, nullptr, nullptr, 0).status_value());
   // And at the end.
-  EXPECT_EQ(ZX_OK, trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, 40, 10, nullptr, 0).status_value());
+  EXPECT_EQ(ZX_OK,
+            trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, 40, 10, nullptr, nullptr, 0).status_value());
 
   END_TEST;
 }
@@ -567,18 +600,65 @@ static bool trap_map_insert_trap_out_of_range() {
 
   hypervisor::TrapMap trap_map;
   EXPECT_EQ(ZX_ERR_OUT_OF_RANGE,
-            trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, 0, 0, nullptr, 0).status_value());
-  EXPECT_EQ(
-      ZX_ERR_OUT_OF_RANGE,
-      trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, UINT32_MAX, UINT64_MAX, nullptr, 0).status_value());
+            trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, 0, 0, nullptr, nullptr, 0).status_value());
+  EXPECT_EQ(ZX_ERR_OUT_OF_RANGE,
+            trap_map.InsertTrap(ZX_GUEST_TRAP_MEM, UINT32_MAX, UINT64_MAX, nullptr, nullptr, 0)
+                .status_value());
 #ifdef ARCH_X86
   EXPECT_EQ(ZX_ERR_OUT_OF_RANGE,
-            trap_map.InsertTrap(ZX_GUEST_TRAP_IO, 0, UINT32_MAX, nullptr, 0).status_value());
+            trap_map.InsertTrap(ZX_GUEST_TRAP_IO, 0, UINT32_MAX, nullptr, nullptr, 0)
+                .status_value());
 #endif  // ARCH_X86
 
   END_TEST;
 }
 
+static bool trap_map_coalesce_bells() {
+  BEGIN_TEST;
+
+  KernelHandle<PortDispatcher> port_handle;
+  zx_rights_t rights;
+  ASSERT_EQ(ZX_OK, PortDispatcher::Create(0, &port_handle, &rights));
+  fbl::RefPtr<PortDispatcher> port = port_handle.dispatcher();
+
+  hypervisor::TrapMap trap_map;
+  ASSERT_EQ(ZX_OK, trap_map.InsertTrap(ZX_GUEST_TRAP_BELL, 0, 16, port, nullptr, 1).status_value());
+  auto trap = trap_map.FindTrap(ZX_GUEST_TRAP_BELL, 0);
+  ASSERT_EQ(ZX_OK, trap.status_value());
+
+  zx_port_packet_t bell = {};
+  bell.key = 1;
+  bell.type = ZX_PKT_TYPE_GUEST_BELL;
+  bell.guest_bell.addr = 8;
+
+  // A second bell for the same address is coalesced with the queued packet.
+  EXPECT_EQ(ZX_OK, (*trap)->Queue(bell).status_value());
+  EXPECT_EQ(ZX_OK, (*trap)->Queue(bell).status_value());
+  zx_port_packet_t packet;
+  EXPECT_EQ(ZX_OK, port->Dequeue(Deadline::infinite_past(), &packet));
+  EXPECT_EQ(8u, packet.guest_bell.addr);
+  EXPECT_EQ(ZX_ERR_TIMED_OUT, port->Dequeue(Deadline::infinite_past(), &packet));
+
+  // Once the packet has been read, the next bell is queued again.
+  EXPECT_EQ(ZX_OK, (*trap)->Queue(bell).status_value());
+  EXPECT_EQ(ZX_OK, port->Dequeue(Deadline::infinite_past(), &packet));
+
+  // Bells for an event-backed trap assert ZX_USER_SIGNAL_0.
+  KernelHandle<EventDispatcher> event_handle;
+  ASSERT_EQ(ZX_OK, EventDispatcher::Create(0, &event_handle, &rights));
+  fbl::RefPtr<EventDispatcher> event = event_handle.dispatcher();
+  ASSERT_EQ(ZX_OK,
+            trap_map.InsertTrap(ZX_GUEST_TRAP_BELL, 16, 16, nullptr, event, 2).status_value());
+  trap = trap_map.FindTrap(ZX_GUEST_TRAP_BELL, 16);
+  ASSERT_EQ(ZX_OK, trap.status_value());
+  bell.guest_bell.addr = 16;
+  EXPECT_EQ(ZX_OK, (*trap)->Queue(bell).status_value());
+  EXPECT_EQ(ZX_OK, (*trap)->Queue(bell).status_value());
+  EXPECT_TRUE(event->PollSignals() & ZX_USER_SIGNAL_0);
+
+  END_TEST;
+}
+
 // Use the function name as the test name
 #define HYPERVISOR_UNITTEST(fname) UNITTEST(#fname, fname)
 
@@ -597,6 +677,8 @@ HYPERVISOR_UNITTEST(guest_physical_address_space_protect)
 HYPERVISOR_UNITTEST(direct_address_space_create)
 HYPERVISOR_UNITTEST(id_allocator_alloc_and_free)
 HYPERVISOR_UNITTEST(interrupt_bitmap)
+HYPERVISOR_UNITTEST(guest_mode_tracker)
 HYPERVISOR_UNITTEST(trap_map_insert_trap_intersecting)
 HYPERVISOR_UNITTEST(trap_map_insert_trap_out_of_range)
+HYPERVISOR_UNITTEST(trap_map_coalesce_bells)
 UNITTEST_END_TESTCASE(hypervisor, "hypervisor", "Hypervisor unit tests.")
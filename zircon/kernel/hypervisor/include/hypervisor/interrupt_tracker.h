@@ -17,6 +17,7 @@
 #include <hypervisor/state_invalidator.h>
 #include <kernel/auto_lock.h>
 #include <kernel/event.h>
+#include <ktl/atomic.h>
 
 namespace hypervisor {
 
@@ -155,6 +156,36 @@ class InterruptTracker {
   InterruptBitmap<N> bitmap_ TA_GUARDED(lock_);
 };
 
+// Tracks whether a VCPU is running in guest mode, so that an interrupt for a
+// running VCPU costs at most one IPI and VM exit per guest entry.
+//
+// The VCPU calls `Enter` before it checks for pending interrupts ahead of a
+// guest entry, and `Exit` after the VM exit. Senders call `ShouldNotify` after
+// tracking an interrupt. An IPI is only needed if the VCPU is in guest mode and
+// no other sender has sent one since the last entry. Otherwise the VCPU either
+// sees the interrupt before its next entry, or is about to exit anyway.
+class GuestModeTracker {
+ public:
+  void Enter() { state_.store(kInGuest); }
+  void Exit() { state_.store(0); }
+
+  // Returns whether an interrupt was tracked for the VCPU since `Enter`. If the
+  // VCPU is not able to keep interrupts disabled from `Enter` until the guest
+  // entry, it should re-check for pending interrupts if this returns true, as
+  // the IPI may have been taken by the host.
+  bool Notified() const { return state_.load() & kNotified; }
+
+  // Returns whether the sender of an interrupt should IPI the VCPU to force a
+  // VM exit.
+  bool ShouldNotify() { return state_.fetch_or(kNotified) == kInGuest; }
+
+ private:
+  static constexpr uint8_t kInGuest = 1u << 0;
+  static constexpr uint8_t kNotified = 1u << 1;
+
+  ktl::atomic<uint8_t> state_ = 0;
+};
+
 }  // namespace hypervisor
 
 #endif  // ZIRCON_KERNEL_HYPERVISOR_INCLUDE_HYPERVISOR_INTERRUPT_TRACKER_H_
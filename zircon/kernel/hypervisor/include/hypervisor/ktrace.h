@@ -55,5 +55,9 @@ enum VcpuExit : uint32_t {
 void ktrace_report_vcpu_meta();
 void ktrace_vcpu(uint32_t tag, VcpuMeta meta);
 void ktrace_vcpu_exit(VcpuExit exit, uint64_t exit_address);
+// Records an interrupt sent to a VCPU, and whether an IPI and the VM exit it
+// causes were avoided because the VCPU was not running in guest mode, or had
+// already been notified since its last entry.
+void ktrace_vcpu_interrupt(uint32_t vector, bool exit_avoided);
 
 #endif  // ZIRCON_KERNEL_HYPERVISOR_INCLUDE_HYPERVISOR_KTRACE_H_
@@ -12,20 +12,26 @@
 #include <fbl/ref_ptr.h>
 #include <hypervisor/state_invalidator.h>
 #include <kernel/semaphore.h>
+#include <kernel/spinlock.h>
+#include <ktl/array.h>
+#include <object/event_dispatcher.h>
 #include <object/port_dispatcher.h>
 
 namespace hypervisor {
 
+class Trap;
+
 // Blocks on allocation if the arena is empty.
 class BlockingPortAllocator final : public PortAllocator {
  public:
-  BlockingPortAllocator();
+  explicit BlockingPortAllocator(Trap* trap);
 
   zx::status<> Init() TA_NO_THREAD_SAFETY_ANALYSIS;
   PortPacket* AllocBlocking();
   virtual void Free(PortPacket* port_packet) override;
 
  private:
+  Trap* const trap_;
   Semaphore semaphore_;
   fbl::TypedArena<PortPacket, Mutex> arena_;
 
@@ -33,9 +39,15 @@ class BlockingPortAllocator final : public PortAllocator {
 };
 
 // Describes a single trap within a guest.
+//
+// An asynchronous trap is delivered either as a packet on |port|, or by
+// asserting ZX_USER_SIGNAL_0 on |event|. Bell packets for an address that
+// already has a packet queued on the port are coalesced with that packet, as
+// the handler of the first packet will observe the effect of both.
 class Trap : public fbl::WAVLTreeContainable<ktl::unique_ptr<Trap>> {
  public:
-  Trap(uint32_t kind, zx_gpaddr_t addr, size_t len, fbl::RefPtr<PortDispatcher> port, uint64_t key);
+  Trap(uint32_t kind, zx_gpaddr_t addr, size_t len, fbl::RefPtr<PortDispatcher> port,
+       fbl::RefPtr<EventDispatcher> event, uint64_t key);
   ~Trap();
 
   zx::status<> Init();
@@ -44,6 +56,7 @@ class Trap : public fbl::WAVLTreeContainable<ktl::unique_ptr<Trap>> {
   zx_gpaddr_t GetKey() const { return addr_; }
   bool Contains(zx_gpaddr_t val) const { return val >= addr_ && val < addr_ + len_; }
   bool HasPort() const { return !!port_; }
+  bool HasEvent() const { return !!event_; }
 
   uint32_t kind() const { return kind_; }
   zx_gpaddr_t addr() const { return addr_; }
@@ -51,19 +64,38 @@ class Trap : public fbl::WAVLTreeContainable<ktl::unique_ptr<Trap>> {
   uint64_t key() const { return key_; }
 
  private:
+  friend class BlockingPortAllocator;
+
+  // The maximum number of addresses with a bell packet queued on the port that
+  // are tracked for coalescing. Once exceeded, further bell packets are queued
+  // without coalescing.
+  static constexpr size_t kMaxPendingBells = 16;
+
+  // Returns true if a bell packet for |addr| is already queued, and otherwise
+  // starts tracking |addr| if there is room.
+  bool CoalesceBell(zx_gpaddr_t addr);
+  // Stops tracking the address of a bell packet once it has left the port.
+  void BellDequeued(const zx_port_packet_t& packet);
+
   const uint32_t kind_;
   const zx_gpaddr_t addr_;
   const size_t len_;
   const fbl::RefPtr<PortDispatcher> port_;
+  const fbl::RefPtr<EventDispatcher> event_;
   const uint64_t key_;  // Key for packets in this port range.
   BlockingPortAllocator port_allocator_;
+
+  DECLARE_SPINLOCK(Trap) pending_lock_;
+  ktl::array<zx_gpaddr_t, kMaxPendingBells> pending_bells_ TA_GUARDED(pending_lock_);
+  size_t num_pending_bells_ TA_GUARDED(pending_lock_) = 0;
 };
 
 // Contains all the traps within a guest.
 class TrapMap {
  public:
   zx::status<> InsertTrap(uint32_t kind, zx_gpaddr_t addr, size_t len,
-                          fbl::RefPtr<PortDispatcher> port, uint64_t key);
+                          fbl::RefPtr<PortDispatcher> port, fbl::RefPtr<EventDispatcher> event,
+                          uint64_t key);
   zx::status<Trap*> FindTrap(uint32_t kind, zx_gpaddr_t addr);
 
  private:
@@ -71,3 +71,7 @@ void ktrace_vcpu_exit(VcpuExit exit, uint64_t exit_address) {
   ktrace(TAG_VCPU_EXIT, exit, static_cast<uint32_t>(exit_address),
          static_cast<uint32_t>(exit_address >> 32), 0);
 }
+
+void ktrace_vcpu_interrupt(uint32_t vector, bool exit_avoided) {
+  ktrace(TAG_VCPU_INTERRUPT, vector, exit_avoided ? 1 : 0, 0, 0);
+}
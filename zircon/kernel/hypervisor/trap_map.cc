@@ -4,6 +4,7 @@
 // license that can be found in the LICENSE file or at
 // https://opensource.org/licenses/MIT
 
+#include <lib/counters.h>
 #include <lib/ktrace.h>
 #include <zircon/errors.h>
 #include <zircon/syscalls/hypervisor.h>
@@ -15,6 +16,10 @@
 #include <hypervisor/trap_map.h>
 #include <kernel/range_check.h>
 
+KCOUNTER(bell_traps_queued, "hypervisor.trap.bell.queued")
+KCOUNTER(bell_traps_coalesced, "hypervisor.trap.bell.coalesced")
+KCOUNTER(bell_traps_signaled, "hypervisor.trap.bell.signaled")
+
 namespace {
 
 constexpr size_t kMaxPacketsPerRange = 256;
@@ -39,7 +44,8 @@ bool ValidRange(uint32_t kind, zx_gpaddr_t addr, size_t len) {
 
 namespace hypervisor {
 
-BlockingPortAllocator::BlockingPortAllocator() : semaphore_(kMaxPacketsPerRange) {}
+BlockingPortAllocator::BlockingPortAllocator(Trap* trap)
+    : trap_(trap), semaphore_(kMaxPacketsPerRange) {}
 
 zx::status<> BlockingPortAllocator::Init() {
   zx_status_t status = arena_.Init("hypervisor-packets", kMaxPacketsPerRange);
@@ -61,13 +67,20 @@ PortPacket* BlockingPortAllocator::Alloc() {
 }
 
 void BlockingPortAllocator::Free(PortPacket* port_packet) {
+  trap_->BellDequeued(port_packet->packet);
   arena_.Delete(port_packet);
   semaphore_.Post();
 }
 
 Trap::Trap(uint32_t kind, zx_gpaddr_t addr, size_t len, fbl::RefPtr<PortDispatcher> port,
-           uint64_t key)
-    : kind_(kind), addr_(addr), len_(len), port_(ktl::move(port)), key_(key) {}
+           fbl::RefPtr<EventDispatcher> event, uint64_t key)
+    : kind_(kind),
+      addr_(addr),
+      len_(len),
+      port_(ktl::move(port)),
+      event_(ktl::move(event)),
+      key_(key),
+      port_allocator_(this) {}
 
 Trap::~Trap() {
   if (port_ == nullptr) {
@@ -78,13 +91,58 @@ Trap::~Trap() {
 
 zx::status<> Trap::Init() { return port_allocator_.Init(); }
 
+bool Trap::CoalesceBell(zx_gpaddr_t addr) {
+  Guard<SpinLock, IrqSave> guard{&pending_lock_};
+  for (size_t i = 0; i < num_pending_bells_; i++) {
+    if (pending_bells_[i] == addr) {
+      return true;
+    }
+  }
+  if (num_pending_bells_ < pending_bells_.size()) {
+    pending_bells_[num_pending_bells_++] = addr;
+  }
+  return false;
+}
+
+void Trap::BellDequeued(const zx_port_packet_t& packet) {
+  if (packet.type != ZX_PKT_TYPE_GUEST_BELL) {
+    return;
+  }
+  Guard<SpinLock, IrqSave> guard{&pending_lock_};
+  for (size_t i = 0; i < num_pending_bells_; i++) {
+    if (pending_bells_[i] == packet.guest_bell.addr) {
+      pending_bells_[i] = pending_bells_[--num_pending_bells_];
+      return;
+    }
+  }
+}
+
 zx::status<> Trap::Queue(const zx_port_packet_t& packet, StateInvalidator* invalidator) {
-  if (invalidator != nullptr) {
-    invalidator->Invalidate();
+  if (event_ != nullptr) {
+    // Asserting a signal does not allocate, and repeated bells are coalesced
+    // until the handler clears the signal.
+    DEBUG_ASSERT(packet.type == ZX_PKT_TYPE_GUEST_BELL);
+    if (invalidator != nullptr) {
+      invalidator->Invalidate();
+    }
+    bell_traps_signaled.Add(1);
+    return zx::make_status(event_->user_signal_self(0, ZX_USER_SIGNAL_0));
   }
   if (port_ == nullptr) {
     return zx::error(ZX_ERR_NOT_FOUND);
   }
+  if (packet.type == ZX_PKT_TYPE_GUEST_BELL) {
+    // If a packet for the same address has not been read from the port yet,
+    // there is no need to queue another one, or to wake up the handler again.
+    if (CoalesceBell(packet.guest_bell.addr)) {
+      bell_traps_coalesced.Add(1);
+      return zx::ok();
+    }
+    bell_traps_queued.Add(1);
+  }
+  if (invalidator != nullptr) {
+    invalidator->Invalidate();
+  }
   PortPacket* port_packet = port_allocator_.AllocBlocking();
   if (port_packet == nullptr) {
     return zx::error(ZX_ERR_NO_MEMORY);
@@ -102,7 +160,8 @@ zx::status<> Trap::Queue(const zx_port_packet_t& packet, StateInvalidator* inval
 }
 
 zx::status<> TrapMap::InsertTrap(uint32_t kind, zx_gpaddr_t addr, size_t len,
-                                 fbl::RefPtr<PortDispatcher> port, uint64_t key) {
+                                 fbl::RefPtr<PortDispatcher> port,
+                                 fbl::RefPtr<EventDispatcher> event, uint64_t key) {
   if (!ValidRange(kind, addr, len)) {
     return zx::error(ZX_ERR_OUT_OF_RANGE);
   }
@@ -112,7 +171,8 @@ zx::status<> TrapMap::InsertTrap(uint32_t kind, zx_gpaddr_t addr, size_t len,
   }
 
   fbl::AllocChecker ac;
-  ktl::unique_ptr<Trap> range(new (&ac) Trap(kind, addr, len, ktl::move(port), key));
+  ktl::unique_ptr<Trap> range(
+      new (&ac) Trap(kind, addr, len, ktl::move(port), ktl::move(event), key));
   if (!ac.check()) {
     return zx::error(ZX_ERR_NO_MEMORY);
   }
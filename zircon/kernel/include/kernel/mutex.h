@@ -38,14 +38,21 @@ class TA_CAP("mutex") Mutex {
   // and describe how to optimize this value.
   static constexpr zx_duration_t SPIN_MAX_DURATION = ZX_USEC(150);
 
+  // Passed as the spin duration to spin for the adaptive budget of the mutex
+  // instead of a fixed duration.  The budget is learned from how long
+  // contending threads have had to wait for the mutex in the past, and is never
+  // more than SPIN_MAX_DURATION.  See Mutex::AcquireContendedMutex.
+  static constexpr zx_duration_t SPIN_ADAPTIVE = -1;
+
   // A constant for users of AutoExpiringPreemptDisabler to select a value
   // consistent with the defaults for Mutex/CriticalMutex. Using this constant
   // also improves readablity, providing a link to the motivating use case for
   // timeslice extension.
   static constexpr zx_duration_t DEFAULT_TIMESLICE_EXTENSION = SPIN_MAX_DURATION;
 
-  // Acquire the mutex.
-  inline void Acquire(zx_duration_t spin_max_duration = SPIN_MAX_DURATION) TA_ACQ()
+  // Acquire the mutex, spinning for at most |spin_max_duration| if it is held
+  // by a thread running on another CPU.
+  inline void Acquire(zx_duration_t spin_max_duration = SPIN_ADAPTIVE) TA_ACQ()
       TA_EXCL(thread_lock);
 
   // Release the mutex. Must be held by the current thread.
@@ -64,6 +71,13 @@ class TA_CAP("mutex") Mutex {
   // a lock. The asserts may be optimized away in release builds.
   void AssertHeld() const TA_ASSERT() { DEBUG_ASSERT(IsHeld()); }
 
+  // Returns the duration that contending threads currently spin for when
+  // acquiring the mutex with SPIN_ADAPTIVE.
+  zx_duration_t spin_budget() const {
+    const uint32_t budget = spin_budget_.load(ktl::memory_order_relaxed);
+    return budget == 0 ? SPIN_MAX_DURATION : budget;
+  }
+
  protected:
   // TimesliceExtension is used to control whether a timeslice extension will be
   // set and if so, what value will be used.
@@ -112,6 +126,11 @@ class TA_CAP("mutex") Mutex {
   void ReleaseContendedMutex(Thread* current_thread, uintptr_t old_mutex_state)
       TA_REQ(thread_lock, preempt_disabled_token);
 
+  // Folds the time a contending thread waited for the mutex into the adaptive
+  // spin budget.  |spun| is true if the thread acquired the mutex while
+  // spinning rather than after blocking.
+  void UpdateSpinBudget(zx_duration_t wait_duration, bool spun);
+
   void RecordInitialAssignedCpu() {
     maybe_acquired_on_cpu_.store(arch_curr_cpu_num(), ktl::memory_order_relaxed);
   }
@@ -139,6 +158,9 @@ class TA_CAP("mutex") Mutex {
   // this variable, and how it affects the spin phase behavior of
   // Mutex::AcquireContendedMutex
   ktl::atomic<cpu_num_t> maybe_acquired_on_cpu_{INVALID_CPU};
+  // The adaptive spin budget in nanoseconds, or zero if nothing has been
+  // learned yet, in which case SPIN_MAX_DURATION is used.
+  ktl::atomic<uint32_t> spin_budget_{0};
   ktl::atomic<uintptr_t> val_{STATE_FREE};
   OwnedWaitQueue wait_;
 };
@@ -196,11 +218,12 @@ class TA_CAP("mutex") CriticalMutex : private Mutex {
   CriticalMutex& operator=(CriticalMutex&&) = delete;
 
   // Acquire the mutex.
-  void Acquire(zx_duration_t spin_max_duration = Mutex::SPIN_MAX_DURATION) TA_ACQ()
+  void Acquire(zx_duration_t spin_max_duration = Mutex::SPIN_ADAPTIVE) TA_ACQ()
       TA_EXCL(thread_lock) {
     // TODO(maniscalco): What's the right duration here?  Is it a function of
     // spin_max_duration?
-    const TimesliceExtension<true> timeslice_extension{spin_max_duration};
+    const TimesliceExtension<true> timeslice_extension{
+        spin_max_duration == Mutex::SPIN_ADAPTIVE ? Mutex::SPIN_MAX_DURATION : spin_max_duration};
     should_clear_ = Mutex::AcquireCommon(spin_max_duration, timeslice_extension);
   }
 
@@ -243,7 +266,7 @@ class TA_CAP("mutex") CriticalMutex : private Mutex {
 //
 struct MutexPolicy {
   struct State {
-    const zx_duration_t spin_max_duration{Mutex::SPIN_MAX_DURATION};
+    const zx_duration_t spin_max_duration{Mutex::SPIN_ADAPTIVE};
   };
 
   // No special actions are needed during pre-validation.
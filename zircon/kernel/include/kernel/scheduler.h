@@ -85,6 +85,18 @@ class Scheduler {
   // increased to limit intra-cluster spill over.
   static constexpr SchedDuration kIntraClusterThreshold = SchedUs(25);
 
+  // The minimum interval between attempts by a busy CPU to pull fair work from
+  // a more heavily loaded CPU. Idle CPUs steal work whenever they run out of
+  // work, this handles CPUs that never become idle while others stay
+  // oversubscribed. The imbalance required to pull a thread is also subject to
+  // the intra- and inter-cluster thresholds above.
+  static constexpr SchedDuration kBalancePeriod = SchedMs(10);
+
+  // The completion time, including queueing, within which a fair thread must
+  // be expected to finish its next run on a candidate CPU for energy-aware
+  // placement to choose that CPU. See kernel.scheduler.energy-aware-placement.
+  static constexpr SchedDuration kEnergyAwareLatencyLimit = kDefaultTargetLatency;
+
   // The per-CPU deadline utilization limit to attempt to honor when selecting a
   // CPU to place a task. It is up to userspace to ensure that the total set of
   // deadline tasks can honor this limit. Even if userspace ensures the total
@@ -339,6 +351,14 @@ class Scheduler {
   // associated with the local Scheduler instance.
   Thread* StealWork(SchedTime now) TA_EXCL(queue_lock_);
 
+  // Moves a queued fair thread from the most heavily loaded CPU to the local
+  // run queue, if its load exceeds the local load by enough to justify the
+  // migration.
+  void BalanceFairWork(SchedTime now) TA_EXCL(queue_lock_);
+
+  // Records a thread migrated to this CPU by StealWork or BalanceFairWork.
+  void TraceMigration();
+
   // Returns the time that the next deadline task will become eligible or infinite
   // if there are no ready deadline tasks.
   SchedTime GetNextEligibleTime() TA_REQ(queue_lock_);
@@ -518,6 +538,14 @@ class Scheduler {
   // The system time that the current time slice started.
   SchedTime start_of_current_time_slice_ns_{0};
 
+  // The earliest system time at which to attempt the next call to
+  // BalanceFairWork.
+  TA_GUARDED(queue_lock_)
+  SchedTime next_balance_time_ns_{0};
+
+  // The number of threads migrated to this CPU by StealWork or BalanceFairWork.
+  uint64_t migration_count_{0};
+
   // The system time that the current thread should be preempted. Initialized to
   // ZX_TIME_INFINITE to pass the assertion now < target_preemption_time_ns_ (or
   // else the current time slice is expired) on the first entry into the
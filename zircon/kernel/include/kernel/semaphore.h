@@ -37,6 +37,10 @@ class Semaphore {
   // of ZX_ERR_INTERNAL_INTR errors if the thread had a signal delivered.
   zx_status_t Wait(const Deadline& deadline);
 
+  // Decrement the count by up to |max|, without waiting, and return the amount
+  // it was decremented by.
+  uint64_t TryWaitUpTo(uint64_t max);
+
   // Observe the current internal count of the semaphore.
   uint64_t count() {
     Guard<MonitoredSpinLock, IrqSave> guard{ThreadLock::Get(), SOURCE_TAG};
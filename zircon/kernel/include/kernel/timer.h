@@ -139,6 +139,12 @@ class TimerQueue {
   // periodically by some hardware timer.
   void Tick(zx_time_t now, cpu_num_t cpu);
 
+  // Returns the time in [|earliest|, |latest|] with the most trailing zero
+  // bits, which is where a timer with that slack window is scheduled when
+  // kernel.timer.slack-buckets is enabled and it cannot coalesce with another
+  // timer. |earliest| must be positive and no later than |latest|.
+  static zx_time_t SlackBucket(zx_time_t earliest, zx_time_t latest);
+
  private:
   // Timers can directly call Insert and Cancel.
   friend class Timer;
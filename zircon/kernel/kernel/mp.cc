@@ -13,6 +13,7 @@
 #include <lib/arch/intrin.h>
 #include <lib/console.h>
 #include <lib/fit/defer.h>
+#include <lib/heap.h>
 #include <lib/lockup_detector.h>
 #include <lib/zircon-internal/macros.h>
 #include <platform.h>
@@ -360,6 +361,7 @@ static zx_status_t mp_unplug_cpu_mask_single_locked(cpu_num_t cpu_id, zx_time_t
   percpu& current_percpu = percpu::GetCurrent();
   current_percpu.timer_queue.TransitionOffCpu(percpu_to_unplug.timer_queue);
   current_percpu.dpc_queue.TransitionOffCpu(percpu_to_unplug.dpc_queue);
+  heap_flush_cpu_cache(cpu_id);
 
   return platform_mp_cpu_unplug(cpu_id);
 }
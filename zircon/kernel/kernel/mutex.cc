@@ -22,6 +22,7 @@
 #include <lib/affine/ratio.h>
 #include <lib/affine/utils.h>
 #include <lib/arch/intrin.h>
+#include <lib/counters.h>
 #include <lib/ktrace.h>
 #include <lib/zircon-internal/ktrace.h>
 #include <lib/zircon-internal/macros.h>
@@ -37,14 +38,30 @@
 #include <kernel/task_runtime_timers.h>
 #include <kernel/thread.h>
 #include <kernel/thread_lock.h>
+#include <ktl/algorithm.h>
 #include <ktl/type_traits.h>
 
 #include <ktl/enforce.h>
 
 #define LOCAL_TRACE 0
 
+// Outcomes of the spin phase of contended acquisitions.
+KCOUNTER(mutex_spin_acquired, "kernel.mutex.spin.acquired")
+KCOUNTER(mutex_spin_timed_out, "kernel.mutex.spin.timed_out")
+KCOUNTER(mutex_spin_contested, "kernel.mutex.spin.contested")
+KCOUNTER(mutex_spin_same_cpu, "kernel.mutex.spin.same_cpu")
+
 namespace {
 
+// The adaptive spin budget never drops below this, so that a mutex whose
+// critical sections become short again has a chance of being acquired while
+// spinning and relearning a longer budget.
+constexpr zx_duration_t kMinSpinBudget = ZX_USEC(2);
+
+// The weight of each new observation in the adaptive spin budget is
+// 1 / 2^kSpinBudgetShift.
+constexpr uint32_t kSpinBudgetShift = 3;
+
 enum class KernelMutexTracingLevel {
   None,       // No tracing is ever done.  All code drops out at compile time.
   Contested,  // Trace events are only generated when mutexes are contested.
@@ -126,6 +143,24 @@ Mutex::~Mutex() {
   val_.store(STATE_FREE, ktl::memory_order_relaxed);
 }
 
+void Mutex::UpdateSpinBudget(zx_duration_t wait_duration, bool spun) {
+  // Aim to spin for twice as long as the last few waits for the mutex took, so
+  // that a contender usually finds the mutex released before it gives up. A
+  // wait which outlasted the longest spin that is allowed is not worth
+  // spinning for at all.
+  zx_duration_t target;
+  if (spun || wait_duration <= SPIN_MAX_DURATION) {
+    target = ktl::clamp(zx_duration_mul_int64(wait_duration, 2), kMinSpinBudget, SPIN_MAX_DURATION);
+  } else {
+    target = kMinSpinBudget;
+  }
+
+  // Concurrent updates may lose an observation, which is harmless.
+  const int64_t budget = spin_budget();
+  const int64_t updated = budget + ((target - budget) >> kSpinBudgetShift);
+  spin_budget_.store(static_cast<uint32_t>(updated), ktl::memory_order_relaxed);
+}
+
 // By parameterizing on whether we're going to set a timeslice extension or not
 // we can shave a few cycles.
 template <bool TimesliceExtensionEnabled>
@@ -223,6 +258,16 @@ __NO_INLINE bool Mutex::AcquireContendedMutex(
   // So, it is possible to keep spinning when we probably shouldn't, and also
   // possible to drop out of a spin when we might want to stay in it.
   //
+  // Notes about |spin_max_duration|:
+  //
+  // Callers passing SPIN_ADAPTIVE spin for the adaptive budget of this mutex.
+  // Every contended acquisition records how long it had to wait for the mutex,
+  // from the start of the spin phase until it spun its way to ownership or
+  // was woken as the new owner.  The budget tracks an exponentially weighted
+  // average of twice those waits, so each mutex learns to spin just past the
+  // typical remaining hold time of its owners, and to all but stop spinning if
+  // they hold it for longer than SPIN_MAX_DURATION.
+  //
   // TODO(fxbug.dev/34646): Optimize cache pressure of spinners and default spin max.
 
   const uintptr_t new_mutex_state = reinterpret_cast<uintptr_t>(current_thread);
@@ -238,8 +283,14 @@ __NO_INLINE bool Mutex::AcquireContendedMutex(
     preempt_disabler.Disable();
   }
 
+  const bool adaptive = spin_max_duration == SPIN_ADAPTIVE;
+  if (adaptive) {
+    spin_max_duration = spin_budget();
+  }
+
   // Remember the last call to current_ticks.
   zx_ticks_t now_ticks = current_ticks();
+  const zx_ticks_t spin_start_ticks = now_ticks;
 
   const affine::Ratio time_to_ticks = platform_get_ticks_to_time_ratio().Inverse();
   const zx_ticks_t spin_until_ticks =
@@ -260,6 +311,12 @@ __NO_INLINE bool Mutex::AcquireContendedMutex(
       // threads.
       KTracer{}.KernelMutexUncontestedAcquire(this);
 
+      kcounter_add(mutex_spin_acquired, 1);
+      if (adaptive) {
+        const zx_ticks_t waited = current_ticks() - spin_start_ticks;
+        UpdateSpinBudget(platform_get_ticks_to_time_ratio().Scale(waited), true);
+      }
+
       if constexpr (TimesliceExtensionEnabled) {
         return Thread::Current::preemption_state().SetTimesliceExtension(timeslice_extension.value);
       }
@@ -269,6 +326,7 @@ __NO_INLINE bool Mutex::AcquireContendedMutex(
     // Stop spinning if the mutex is or becomes contested. All spinners convert
     // to blocking when the first one reaches the max spin duration.
     if (old_mutex_state & STATE_FLAG_CONTESTED) {
+      kcounter_add(mutex_spin_contested, 1);
       break;
     }
 
@@ -280,6 +338,7 @@ __NO_INLINE bool Mutex::AcquireContendedMutex(
       // currently enabled or not and whether we re-enable it below.
       const cpu_num_t curr_cpu_num = arch_curr_cpu_num();
       if (curr_cpu_num == maybe_acquired_on_cpu_.load(ktl::memory_order_relaxed)) {
+        kcounter_add(mutex_spin_same_cpu, 1);
         break;
       }
 
@@ -300,6 +359,10 @@ __NO_INLINE bool Mutex::AcquireContendedMutex(
     now_ticks = current_ticks();
   } while (now_ticks < spin_until_ticks);
 
+  if (now_ticks >= spin_until_ticks) {
+    kcounter_add(mutex_spin_timed_out, 1);
+  }
+
   if ((LK_DEBUGLEVEL > 0) && unlikely(this->IsHeld())) {
     panic("Mutex::Acquire: thread %p (%s) tried to acquire mutex %p it already owns.\n",
           current_thread, current_thread->name(), this);
@@ -369,6 +432,11 @@ __NO_INLINE bool Mutex::AcquireContendedMutex(
     LOCK_TRACE_FLOW_END("contend_mutex", flow_id);
   }
 
+  if (adaptive) {
+    const zx_ticks_t waited = current_ticks() - spin_start_ticks;
+    UpdateSpinBudget(platform_get_ticks_to_time_ratio().Scale(waited), false);
+  }
+
   if constexpr (TimesliceExtensionEnabled) {
     return Thread::Current::preemption_state().SetTimesliceExtension(timeslice_extension.value);
   }
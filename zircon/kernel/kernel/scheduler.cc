@@ -9,6 +9,7 @@
 #include <assert.h>
 #include <debug.h>
 #include <inttypes.h>
+#include <lib/boot-options/boot-options.h>
 #include <lib/counters.h>
 #include <lib/ktrace.h>
 #include <lib/zircon-internal/macros.h>
@@ -45,6 +46,9 @@
 using ffl::FromRatio;
 using ffl::Round;
 
+KCOUNTER(counter_steal_migrations, "scheduler.steal.migrations")
+KCOUNTER(counter_balance_migrations, "scheduler.balance.migrations")
+
 // Determines which subset of tracers are enabled when detailed tracing is
 // enabled. When queue tracing is enabled the minimum trace level is
 // KTRACE_COMMON.
@@ -262,6 +266,11 @@ inline void Scheduler::UpdateTotalDeadlineUtilization(SchedUtilization delta) {
   LOCAL_KTRACE_COUNTER(KTRACE_COUNTER, "Est Util", Round<uint64_t>(scaled * 10000), this_cpu());
 }
 
+inline void Scheduler::TraceMigration() {
+  migration_count_++;
+  LOCAL_KTRACE_COUNTER(KTRACE_COUNTER, "Migrations", migration_count_, this_cpu());
+}
+
 inline void Scheduler::TraceTotalRunnableThreads() const {
   LOCAL_KTRACE_COUNTER(KTRACE_COUNTER, "Run-Q Len",
                        runnable_fair_task_count_ + runnable_deadline_task_count_, this_cpu());
@@ -538,6 +547,13 @@ void Scheduler::RemoveFirstThread(Thread* thread) {
 // threads. If there is no eligible work, attempt to steal work from other busy
 // CPUs.
 Thread* Scheduler::DequeueThread(SchedTime now, Guard<MonitoredSpinLock, NoIrqSave>& queue_guard) {
+  // Periodically even out fair work with more heavily loaded CPUs, which
+  // otherwise only shed work to CPUs that become idle.
+  if (now >= next_balance_time_ns_ && !fair_run_queue_.is_empty()) {
+    next_balance_time_ns_ = now + kBalancePeriod;
+    queue_guard.CallUnlocked([&] { BalanceFairWork(now); });
+  }
+
   if (IsDeadlineThreadEligible(now)) {
     return DequeueDeadlineThread(now);
   }
@@ -634,10 +650,70 @@ Thread* Scheduler::StealWork(SchedTime now) {
     // will run immediately on this CPU as if dequeued from a local queue.
     Guard<MonitoredSpinLock, NoIrqSave> queue_guard{&queue_lock_, SOURCE_TAG};
     Insert(now, thread, Placement::Association);
+    kcounter_add(counter_steal_migrations, 1);
+    TraceMigration();
   }
   return thread;
 }
 
+void Scheduler::BalanceFairWork(SchedTime now) {
+  LocalTraceDuration<KTRACE_DETAILED> trace{"balance_fair_work"_stringref};
+
+  const cpu_num_t current_cpu = this_cpu();
+  const cpu_mask_t current_cpu_mask = cpu_num_to_mask(current_cpu);
+  const cpu_mask_t active_cpu_mask = mp_get_active_mask();
+  const SchedDuration local_queue_time_ns = predicted_queue_time_ns();
+
+  // Find the CPU with the largest load in excess of the local load and the
+  // migration threshold that applies to it.
+  Scheduler* busiest = nullptr;
+  SchedDuration busiest_imbalance_ns{0};
+  const CpuSearchSet& search_set = percpu::Get(current_cpu).search_set;
+  for (const auto& entry : search_set.const_iterator()) {
+    if (entry.cpu == current_cpu || !(active_cpu_mask & cpu_num_to_mask(entry.cpu))) {
+      continue;
+    }
+    const SchedDuration threshold =
+        cluster() == entry.cluster ? kIntraClusterThreshold : kInterClusterThreshold;
+    const SchedDuration imbalance_ns = Get(entry.cpu)->predicted_queue_time_ns() -
+                                       local_queue_time_ns;
+    if (imbalance_ns > threshold && imbalance_ns > busiest_imbalance_ns) {
+      busiest = Get(entry.cpu);
+      busiest_imbalance_ns = imbalance_ns;
+    }
+  }
+  if (busiest == nullptr) {
+    return;
+  }
+
+  Thread* thread = nullptr;
+  {
+    Guard<MonitoredSpinLock, NoIrqSave> queue_guard{&busiest->queue_lock_, SOURCE_TAG};
+
+    // Take the queued thread that would run last on the busy CPU, provided it
+    // can run here and moving it does not simply reverse the imbalance.
+    for (auto iter = --busiest->fair_run_queue_.end(); iter.IsValid(); --iter) {
+      const SchedulerState& state = iter->scheduler_state();
+      if ((current_cpu_mask & state.GetEffectiveCpuMask(active_cpu_mask)) &&
+          !iter->has_migrate_fn() && state.expected_runtime_ns_ * 2 <= busiest_imbalance_ns) {
+        thread = &*iter;
+        break;
+      }
+    }
+    if (thread == nullptr) {
+      return;
+    }
+    busiest->fair_run_queue_.erase(*thread);
+    busiest->Remove(thread);
+    busiest->TraceThreadQueueEvent("tqe_deque_balance_fair_work"_stringref, thread);
+  }
+
+  Guard<MonitoredSpinLock, NoIrqSave> queue_guard{&queue_lock_, SOURCE_TAG};
+  Insert(now, thread);
+  kcounter_add(counter_balance_migrations, 1);
+  TraceMigration();
+}
+
 // Dequeues the eligible thread with the earliest virtual finish time. The
 // caller must ensure that there is at least one thread in the queue.
 Thread* Scheduler::DequeueFairThread() {
@@ -960,24 +1036,57 @@ cpu_num_t Scheduler::FindTargetCpu(Thread* thread) {
            predicted_utilization + scaled_utilization <= kCpuUtilizationLimit;
   };
 
-  // Loop over the search set for CPU the task last ran on to find a suitable
-  // target.
   cpu_num_t target_cpu = INVALID_CPU;
   Scheduler* target_queue = nullptr;
 
-  for (const auto& entry : search_set.const_iterator()) {
-    const cpu_num_t candidate_cpu = entry.cpu;
-    const bool candidate_available = available_mask & cpu_num_to_mask(candidate_cpu);
-    Scheduler* const candidate_queue = Get(candidate_cpu);
-
-    if (candidate_available &&
-        (target_queue == nullptr || compare(candidate_queue, target_queue))) {
-      target_cpu = candidate_cpu;
-      target_queue = candidate_queue;
+  // When energy-aware placement is enabled, prefer the lowest performance CPU
+  // that is expected to complete the next run of a fair thread, on top of its
+  // current load, within the latency limit. The expected runtime is tracked
+  // relative to the highest performance CPU and scaled to each candidate.
+  // Among equally capable candidates, the least loaded wins, and ties are won
+  // by the candidate with the best cache affinity.
+  if (IsFairThread(thread) && gBootOptions->scheduler_energy_aware_placement) {
+    const SchedDuration expected_runtime_ns = thread->scheduler_state().expected_runtime_ns_;
+    for (const auto& entry : search_set.const_iterator()) {
+      const cpu_num_t candidate_cpu = entry.cpu;
+      if (!(available_mask & cpu_num_to_mask(candidate_cpu))) {
+        continue;
+      }
+      Scheduler* const candidate_queue = Get(candidate_cpu);
+      const SchedDuration completion_ns =
+          candidate_queue->predicted_queue_time_ns() + candidate_queue->ScaleUp(expected_runtime_ns);
+      if (completion_ns > kEnergyAwareLatencyLimit) {
+        continue;
+      }
+      const auto capacity_and_load = [](const Scheduler* queue) {
+        return ktl::pair{queue->performance_scale(), queue->predicted_queue_time_ns()};
+      };
+      if (target_queue == nullptr ||
+          capacity_and_load(candidate_queue) < capacity_and_load(target_queue)) {
+        target_cpu = candidate_cpu;
+        target_queue = candidate_queue;
+      }
+    }
+    LOCAL_KTRACE(KTRACE_DETAILED, "energy_aware: cpu", target_cpu);
+  }
 
-      // Stop searching at the first sufficiently unloaded CPU.
-      if (is_sufficient(target_queue)) {
-        break;
+  // Loop over the search set for CPU the task last ran on to find a suitable
+  // target, unless one was already chosen above.
+  if (target_queue == nullptr) {
+    for (const auto& entry : search_set.const_iterator()) {
+      const cpu_num_t candidate_cpu = entry.cpu;
+      const bool candidate_available = available_mask & cpu_num_to_mask(candidate_cpu);
+      Scheduler* const candidate_queue = Get(candidate_cpu);
+
+      if (candidate_available &&
+          (target_queue == nullptr || compare(candidate_queue, target_queue))) {
+        target_cpu = candidate_cpu;
+        target_queue = candidate_queue;
+
+        // Stop searching at the first sufficiently unloaded CPU.
+        if (is_sufficient(target_queue)) {
+          break;
+        }
       }
     }
   }
@@ -10,6 +10,7 @@
 #include <zircon/types.h>
 
 #include <kernel/thread_lock.h>
+#include <ktl/algorithm.h>
 
 void Semaphore::Post() {
   Guard<MonitoredSpinLock, IrqSave> guard{ThreadLock::Get(), SOURCE_TAG};
@@ -43,3 +44,11 @@ zx_status_t Semaphore::Wait(const Deadline& deadline) {
   // the wait operation ended.
   return waitq_.Block(deadline, Interruptible::Yes);
 }
+
+uint64_t Semaphore::TryWaitUpTo(uint64_t max) {
+  Guard<MonitoredSpinLock, IrqSave> guard{ThreadLock::Get(), SOURCE_TAG};
+
+  const uint64_t taken = ktl::min(count_, max);
+  count_ -= taken;
+  return taken;
+}
@@ -139,9 +139,30 @@ static bool signal_test() {
   END_TEST;
 }
 
+static bool try_wait_up_to_test() {
+  BEGIN_TEST;
+
+  Semaphore sema(5);
+  ASSERT_EQ(0u, sema.TryWaitUpTo(0));
+  ASSERT_EQ(5u, sema.count());
+
+  ASSERT_EQ(3u, sema.TryWaitUpTo(3));
+  ASSERT_EQ(2u, sema.count());
+
+  ASSERT_EQ(2u, sema.TryWaitUpTo(10));
+  ASSERT_EQ(0u, sema.count());
+
+  ASSERT_EQ(0u, sema.TryWaitUpTo(10));
+  ASSERT_EQ(0u, sema.count());
+  ASSERT_EQ(0u, sema.num_waiters());
+
+  END_TEST;
+}
+
 UNITTEST_START_TESTCASE(semaphore_tests)
 UNITTEST("smoke_test", smoke_test)
 UNITTEST("timeout_test", timeout_test)
+UNITTEST("try_wait_up_to_test", try_wait_up_to_test)
 UNITTEST("post_signal_test", signal_test<Signal::kPost>)
 UNITTEST("kill_signal_test", signal_test<Signal::kKill>)
 UNITTEST("suspend_signal_test", signal_test<Signal::kSuspend>)
@@ -25,6 +25,7 @@
 #include <inttypes.h>
 #include <lib/affine/ratio.h>
 #include <lib/arch/intrin.h>
+#include <lib/boot-options/boot-options.h>
 #include <lib/counters.h>
 #include <lib/zircon-internal/macros.h>
 #include <platform.h>
@@ -54,6 +55,10 @@ KCOUNTER(timer_created_counter, "timer.created")
 // Number of timers merged into an existing timer because of slack.
 KCOUNTER(timer_coalesced_counter, "timer.coalesced")
 
+// Number of timers that were moved by their slack and then fired in the same tick as an earlier
+// timer, i.e. the wakeups that slack saved.
+KCOUNTER(timer_wakeups_saved_counter, "timer.wakeups_saved")
+
 // Number of timers that have fired (i.e. callback was invoked).
 KCOUNTER(timer_fired_counter, "timer.fired")
 
@@ -96,11 +101,37 @@ void TimerQueue::UpdatePlatformTimer(zx_time_t new_deadline) {
   }
 }
 
+zx_time_t TimerQueue::SlackBucket(zx_time_t earliest, zx_time_t latest) {
+  DEBUG_ASSERT(earliest > 0);
+  DEBUG_ASSERT(earliest <= latest);
+  // |latest| and |earliest| - 1 share all bits above the highest bit in which they differ, which
+  // is set in |latest|. Clearing every bit of |latest| below that one gives the most aligned time
+  // that is still later than |earliest| - 1.
+  const uint64_t before = static_cast<uint64_t>(earliest - 1);
+  const uint64_t last = static_cast<uint64_t>(latest);
+  const uint64_t low_bits = (uint64_t{1} << (63 - __builtin_clzll(before ^ last))) - 1;
+  return static_cast<zx_time_t>(last & ~low_bits);
+}
+
 void TimerQueue::Insert(Timer* timer, zx_time_t earliest_deadline, zx_time_t latest_deadline) {
   DEBUG_ASSERT(arch_ints_disabled());
   cpu_num_t cpu = arch_curr_cpu_num();
   LTRACEF("timer %p, cpu %u, scheduled %" PRIi64 "\n", timer, cpu, timer->scheduled_time_);
 
+  // Schedules a timer that does not coalesce with any timer in the queue. Every timer in the queue
+  // is then either before |earliest_deadline| or after |latest_deadline|, so the timer can be
+  // moved anywhere in its slack window without changing where it is inserted.
+  auto schedule_uncoalesced = [&]() {
+    if (gBootOptions->timer_slack_buckets && earliest_deadline > 0 &&
+        earliest_deadline < latest_deadline) {
+      const zx_time_t bucket = SlackBucket(earliest_deadline, latest_deadline);
+      timer->slack_ = zx_time_sub_time(bucket, timer->scheduled_time_);
+      timer->scheduled_time_ = bucket;
+    } else {
+      timer->slack_ = 0;
+    }
+  };
+
   // For inserting the timer we consider several cases. In general we
   // want to coalesce with the current timer unless we can prove that
   // either that:
@@ -117,10 +148,10 @@ void TimerQueue::Insert(Timer* timer, zx_time_t earliest_deadline, zx_time_t lat
   for (Timer& entry : timer_list_) {
     if (entry.scheduled_time_ > latest_deadline) {
       // New timer latest is earlier than the current timer.
-      // Just add upfront as is, without slack.
+      // Just add upfront.
       //
       //   ---------t---)--e-------------------------------> time
-      timer->slack_ = 0ll;
+      schedule_uncoalesced();
       timer_list_.insert(entry, timer);
       return;
     }
@@ -195,7 +226,7 @@ void TimerQueue::Insert(Timer* timer, zx_time_t earliest_deadline, zx_time_t lat
   }
 
   // Walked off the end of the list and there was no overlap.
-  timer->slack_ = 0;
+  schedule_uncoalesced();
   timer_list_.push_back(timer);
 }
 
@@ -253,7 +284,7 @@ void Timer::Set(const Deadline& deadline, Callback callback, void* arg) {
 
   if (!timer_queue.timer_list_.is_empty() && &timer_queue.timer_list_.front() == this) {
     // We just modified the head of the timer queue.
-    timer_queue.UpdatePlatformTimer(deadline.when());
+    timer_queue.UpdatePlatformTimer(scheduled_time_);
   }
 }
 
@@ -364,6 +395,7 @@ void TimerQueue::Tick(zx_time_t now, cpu_num_t cpu) {
 
   Guard<MonitoredSpinLock, NoIrqSave> guard{TimerLock::Get(), SOURCE_TAG};
 
+  bool fired = false;
   for (;;) {
     // See if there's an event to process.
     if (timer_list_.is_empty()) {
@@ -385,6 +417,11 @@ void TimerQueue::Tick(zx_time_t now, cpu_num_t cpu) {
                      (uint)timer.magic_);
     timer_list_.erase(timer);
 
+    if (fired && timer.slack_ != 0) {
+      kcounter_add(timer_wakeups_saved_counter, 1);
+    }
+    fired = true;
+
     // Mark the timer busy.
     timer.active_cpu_.store(cpu, ktl::memory_order_relaxed);
     // Unlocking the spinlock in CallUnlocked acts as a release fence.
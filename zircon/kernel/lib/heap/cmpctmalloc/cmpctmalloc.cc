@@ -1107,6 +1107,15 @@ NO_ASAN void* cmpct_memalign(size_t alignment, size_t size) {
 
 void cmpct_set_fill_on_alloc_threshold(size_t size) { g_fill_on_alloc_threshold = size; }
 
+size_t cmpct_fill_on_alloc_threshold(void) { return g_fill_on_alloc_threshold; }
+
+NO_ASAN size_t cmpct_usable_size(const void* payload) {
+  // The header of an allocated block is only modified when the block is
+  // allocated or freed, so it can be read without the heap lock.
+  const header_t* header = static_cast<const header_t*>(payload) - 1;
+  return header->size - sizeof(header_t);
+}
+
 void cmpct_init(void) {
   LTRACE_ENTRY;
   LockGuard guard(TheHeapLock::Get());
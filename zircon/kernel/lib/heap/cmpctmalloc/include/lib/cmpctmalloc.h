@@ -37,6 +37,11 @@ void* cmpct_memalign(size_t alignment, size_t size) TA_EXCL(TheHeapLock::Get());
 
 // Zero-fill allocations smaller than |size|
 void cmpct_set_fill_on_alloc_threshold(size_t size);
+size_t cmpct_fill_on_alloc_threshold(void);
+
+// Returns the usable size of the allocated block at |payload|, which is at
+// least the size that it was allocated with.
+size_t cmpct_usable_size(const void* payload);
 void cmpct_init(void) TA_EXCL(TheHeapLock::Get());
 void cmpct_dump(bool panic_time) TA_EXCL(TheHeapLock::Get());
 void cmpct_get_info(size_t* used_bytes, size_t* free_bytes, size_t* cached_bytes) TA_EXCL(TheHeapLock::Get());
@@ -8,9 +8,12 @@
 #include <align.h>
 #include <assert.h>
 #include <debug.h>
+#include <lib/boot-options/boot-options.h>
 #include <lib/cmpctmalloc.h>
 #include <lib/console.h>
+#include <lib/counters.h>
 #include <lib/heap.h>
+#include <lib/heap_cpu_cache.h>
 #include <lib/heap_internal.h>
 #include <lib/instrumentation/asan.h>
 #include <lib/lazy_init/lazy_init.h>
@@ -24,8 +27,11 @@
 #include <arch/ops.h>
 #include <fbl/intrusive_double_list.h>
 #include <kernel/auto_lock.h>
+#include <kernel/auto_preempt_disabler.h>
+#include <kernel/cpu.h>
 #include <kernel/spinlock.h>
 #include <kernel/thread.h>
+#include <ktl/atomic.h>
 #include <vm/physmap.h>
 #include <vm/pmm.h>
 #include <vm/vm.h>
@@ -43,6 +49,10 @@
 /* heap tracing */
 static bool heap_trace = false;
 
+KCOUNTER(malloc_cpu_cache_hit, "malloc.cpu_cache.hit")
+KCOUNTER(malloc_cpu_cache_miss, "malloc.cpu_cache.miss")
+KCOUNTER(malloc_cpu_cache_flush, "malloc.cpu_cache.flush")
+
 // keep a list of unique caller:size sites in a list
 namespace {
 
@@ -125,8 +135,108 @@ void dump_stats() {
   }
 }
 
+// The per-CPU caches in front of cmpctmalloc, see HeapCpuCache. heap_get_info() adds the cached
+// blocks to the free bytes.
+namespace cpu_cache {
+
+HeapCpuCache caches[SMP_MAX_CPUS];
+
+// Set from kernel.heap.cpu-cache by heap_init(). The caches would hide use after free from the
+// address sanitizer, so they are never used with it.
+bool enabled = false;
+
+void* Alloc(size_t size) {
+  if (!enabled || size == 0 || size > HeapCpuCache::kMaxAllocSize) {
+    return nullptr;
+  }
+  AutoPreemptDisabler preempt_disable;
+  return caches[arch_curr_cpu_num()].Alloc(size);
+}
+
+// Returns true if |ptr| was cached, otherwise it must be freed to cmpctmalloc.
+bool Free(void* ptr) {
+  if (!enabled) {
+    return false;
+  }
+  AutoPreemptDisabler preempt_disable;
+  return caches[arch_curr_cpu_num()].Free(ptr);
+}
+
+size_t CachedBytes() {
+  size_t total = 0;
+  for (const HeapCpuCache& cache : caches) {
+    total += cache.bytes();
+  }
+  return total;
+}
+
+}  // namespace cpu_cache
+
 }  // namespace
 
+void* HeapCpuCache::Alloc(size_t size) {
+  if (size == 0 || size > kMaxAllocSize) {
+    return nullptr;
+  }
+
+  const size_t index = (size + kClassSize - 1) / kClassSize;
+  Block* block = heads_[index];
+  if (block == nullptr) {
+    kcounter_add(malloc_cpu_cache_miss, 1);
+    return nullptr;
+  }
+  DEBUG_ASSERT(block->tag == kCachedTag);
+  heads_[index] = block->next;
+  counts_[index]--;
+  bytes_.store(bytes() - cmpct_usable_size(block), ktl::memory_order_relaxed);
+  block->tag = 0;
+  kcounter_add(malloc_cpu_cache_hit, 1);
+
+  if (size < cmpct_fill_on_alloc_threshold()) {
+    memset(block, 0, size);
+  }
+  return block;
+}
+
+bool HeapCpuCache::Free(void* ptr) {
+  if (ptr == nullptr) {
+    return false;
+  }
+
+  const size_t usable = cmpct_usable_size(ptr);
+  const size_t index = usable / kClassSize;
+  if (index == 0 || index >= kClassCount) {
+    return false;
+  }
+
+  Block* block = static_cast<Block*>(ptr);
+  // The same check cmpctmalloc makes on its free blocks.
+  DEBUG_ASSERT_MSG(block->tag != kCachedTag, "double free of cached block %p", ptr);
+  if (counts_[index] >= kMaxBlocksPerClass || bytes() + usable > kMaxBytes) {
+    return false;
+  }
+  block->next = heads_[index];
+  block->tag = kCachedTag;
+  heads_[index] = block;
+  counts_[index]++;
+  bytes_.store(bytes() + usable, ktl::memory_order_relaxed);
+  return true;
+}
+
+void HeapCpuCache::Flush() {
+  for (size_t i = 0; i < kClassCount; i++) {
+    while (heads_[i] != nullptr) {
+      Block* block = heads_[i];
+      heads_[i] = block->next;
+      block->tag = 0;
+      cmpct_free(block);
+    }
+    counts_[i] = 0;
+  }
+  bytes_.store(0, ktl::memory_order_relaxed);
+  kcounter_add(malloc_cpu_cache_flush, 1);
+}
+
 void heap_init() {
   if constexpr (VIRTUAL_HEAP) {
     virtual_alloc.Initialize(vm_page_state::HEAP);
@@ -143,6 +253,8 @@ void heap_init() {
   }
 
   cmpct_init();
+
+  cpu_cache::enabled = !__has_feature(address_sanitizer) && gBootOptions->heap_cpu_cache;
 }
 
 void* malloc(size_t size) {
@@ -153,7 +265,10 @@ void* malloc(size_t size) {
 
   add_stat(__GET_CALLER(), size);
 
-  void* ptr = cmpct_alloc(size);
+  void* ptr = cpu_cache::Alloc(size);
+  if (!ptr) {
+    ptr = cmpct_alloc(size);
+  }
   if (unlikely(heap_trace)) {
     printf("caller %p malloc %zu -> %p\n", __GET_CALLER(), size, ptr);
   }
@@ -195,7 +310,10 @@ void* calloc(size_t count, size_t size) {
 
   size_t realsize = count * size;
 
-  void* ptr = cmpct_alloc(realsize);
+  void* ptr = cpu_cache::Alloc(realsize);
+  if (!ptr) {
+    ptr = cmpct_alloc(realsize);
+  }
   if (likely(ptr)) {
     memset(ptr, 0, realsize);
   }
@@ -213,7 +331,9 @@ void free(void* ptr) {
     printf("caller %p free %p\n", __GET_CALLER(), ptr);
   }
 
-  cmpct_free(ptr);
+  if (!cpu_cache::Free(ptr)) {
+    cmpct_free(ptr);
+  }
 }
 
 void sized_free(void* ptr, size_t s) {
@@ -224,10 +344,23 @@ void sized_free(void* ptr, size_t s) {
     printf("caller %p free %p size %lu\n", __GET_CALLER(), ptr, s);
   }
 
-  cmpct_sized_free(ptr, s);
+  if (ptr) {
+    DEBUG_ASSERT(cmpct_usable_size(ptr) >= s);
+  }
+  if (!cpu_cache::Free(ptr)) {
+    cmpct_sized_free(ptr, s);
+  }
+}
+
+void heap_flush_cpu_cache(cpu_num_t cpu) {
+  DEBUG_ASSERT(is_valid_cpu_num(cpu));
+  cpu_cache::caches[cpu].Flush();
 }
 
-static void heap_dump(bool panic_time) { cmpct_dump(panic_time); }
+static void heap_dump(bool panic_time) {
+  cmpct_dump(panic_time);
+  dprintf(INFO, "\tper-cpu caches %zu bytes\n", cpu_cache::CachedBytes());
+}
 
 void heap_get_info(size_t* total_bytes, size_t* free_bytes) {
   size_t used_bytes;
@@ -236,6 +369,10 @@ void heap_get_info(size_t* total_bytes, size_t* free_bytes) {
   if (total_bytes) {
     *total_bytes = used_bytes + cached_bytes;
   }
+  // Blocks in the per-CPU caches are allocated from cmpctmalloc, but are free for the heap's users.
+  if (free_bytes) {
+    *free_bytes += cpu_cache::CachedBytes();
+  }
 }
 
 static void heap_test() { cmpct_test(); }
@@ -9,6 +9,7 @@
 #define ZIRCON_KERNEL_LIB_HEAP_INCLUDE_LIB_HEAP_H_
 
 #include <stddef.h>
+#include <stdint.h>
 #include <sys/types.h>
 #include <zircon/compiler.h>
 
@@ -35,6 +36,11 @@ void heap_get_info(size_t* total_bytes, size_t* free_bytes);
 // called once at kernel initialization
 void heap_init(void);
 
+// Returns the blocks held by the per-CPU cache of |cpu| to the heap. Must only
+// be called once |cpu| has been unplugged, as the cache is otherwise only
+// accessed from its own CPU.
+void heap_flush_cpu_cache(uint32_t cpu);
+
 __END_CDECLS
 
 #endif  // ZIRCON_KERNEL_LIB_HEAP_INCLUDE_LIB_HEAP_H_
@@ -0,0 +1,63 @@
+// Copyright 2026 The Fuchsia Authors
+//
+// Use of this source code is governed by a MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT
+
+#ifndef ZIRCON_KERNEL_LIB_HEAP_INCLUDE_LIB_HEAP_CPU_CACHE_H_
+#define ZIRCON_KERNEL_LIB_HEAP_INCLUDE_LIB_HEAP_CPU_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <arch/defines.h>
+#include <ktl/atomic.h>
+
+// A cache of small blocks in front of cmpctmalloc.
+//
+// A small free() stashes its block in the cache of the current CPU instead of taking the heap lock,
+// and a later malloc() on that CPU takes it back. The cached blocks remain allocated as far as
+// cmpctmalloc is concerned. The heap keeps one cache per CPU, which is only accessed by its own CPU
+// with preemption disabled, or by another CPU once it has been unplugged.
+class alignas(MAX_CACHE_LINE) HeapCpuCache {
+ public:
+  // Blocks are grouped by usable size in classes of |kClassSize| bytes. A block is cached in the
+  // class of its usable size rounded down, and an allocation is taken from the class of its
+  // requested size rounded up, so that any block of that class is large enough.
+  static constexpr size_t kClassSize = 16;
+  static constexpr size_t kClassCount = 16;
+  static constexpr size_t kMaxAllocSize = kClassSize * (kClassCount - 1);
+
+  // Limits on the blocks held by each class and the usable bytes held by each cache.
+  static constexpr size_t kMaxBlocksPerClass = 32;
+  static constexpr size_t kMaxBytes = 16 * 1024;
+
+  // Returns a cached block of at least |size| bytes, or nullptr if there is none.
+  void* Alloc(size_t size);
+
+  // Returns true if the cmpctmalloc block |ptr| was cached, otherwise it must be freed to
+  // cmpctmalloc.
+  bool Free(void* ptr);
+
+  // Frees all the cached blocks to cmpctmalloc.
+  void Flush();
+
+  // The usable bytes of the cached blocks. May be read from any CPU.
+  size_t bytes() const { return bytes_.load(ktl::memory_order_relaxed); }
+
+ private:
+  // Cached blocks are tagged, so that freeing one again can be caught like cmpctmalloc catches a
+  // double free. Every size class is large enough for both fields.
+  struct Block {
+    Block* next;
+    uint64_t tag;
+  };
+  static constexpr uint64_t kCachedTag = 0x6361636865644b48;  // "HKcached"
+
+  Block* heads_[kClassCount] = {};
+  uint8_t counts_[kClassCount] = {};
+  // Only written by the owning CPU.
+  ktl::atomic<size_t> bytes_{0};
+};
+
+#endif  // ZIRCON_KERNEL_LIB_HEAP_INCLUDE_LIB_HEAP_CPU_CACHE_H_
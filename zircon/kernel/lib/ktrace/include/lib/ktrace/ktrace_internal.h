@@ -66,6 +66,15 @@ class KTraceState {
   // mode will be part of the static region of the buffer.  It is, however, not
   // legal to start a trace in Circular mode, then stop it, and then attempt to
   // start it again in Saturate mode.
+  //
+  // When a non-zero CPU block size is passed to Init, writers in Saturate mode
+  // do not contend on a single shared write pointer.  Each CPU instead claims
+  // blocks of that size from the buffer and fills them with its own records,
+  // only taking the write lock to claim another block.  A claimed block starts
+  // with a KTRACE_EVENT_CPU_BLOCK padding record, and its unused tail is padded
+  // when the trace is stopped.  Readers which want a single timeline have to
+  // merge the blocks of different CPUs by timestamp.  Circular mode always
+  // writes through the shared write pointer.
   enum class StartMode { Saturate, Circular };
 
   constexpr KTraceState() = default;
@@ -84,7 +93,12 @@ class KTraceState {
   // group mask is zero, allocation is delayed until the first time that start
   // is called.
   //
-  void Init(uint32_t target_bufsize, uint32_t initial_groups) TA_EXCL(lock_, write_lock_);
+  // |cpu_block_size| : The size (in bytes) of the per-CPU blocks used in
+  // saturating mode, or 0 to write all records through the shared write
+  // pointer.  Must be a multiple of 8 bytes.
+  //
+  void Init(uint32_t target_bufsize, uint32_t initial_groups, uint32_t cpu_block_size = 0)
+      TA_EXCL(lock_, write_lock_);
 
   [[nodiscard]] zx_status_t Start(uint32_t groups, StartMode mode) TA_EXCL(lock_, write_lock_);
   [[nodiscard]] zx_status_t Stop() TA_EXCL(lock_, write_lock_);
@@ -105,7 +119,8 @@ class KTraceState {
       TA_EXCL(write_lock_);
 
   inline uint32_t grpmask() const {
-    return static_cast<uint32_t>(grpmask_and_inflight_writes_.load(ktl::memory_order_acquire));
+    return static_cast<uint32_t>(grpmask_and_inflight_writes_.load(ktl::memory_order_acquire) &
+                                 ~kCpuBlocksFlag);
   }
 
   // Check to see if a tag is currently enabled using either a new observation
@@ -161,10 +176,8 @@ class KTraceState {
    public:
     explicit AutoWriteInFlight(KTraceState& ks)
         : ks_(ks),
-          observed_grpmask_(
-              static_cast<uint32_t>(ks_.grpmask_and_inflight_writes_.fetch_add(
-                                        kInflightWritesInc, ktl::memory_order_acq_rel) &
-                                    ~kInflightWritesMask)) {}
+          observed_state_(ks_.grpmask_and_inflight_writes_.fetch_add(kInflightWritesInc,
+                                                                     ktl::memory_order_acq_rel)) {}
 
     ~AutoWriteInFlight() {
       [[maybe_unused]] uint64_t prev;
@@ -173,11 +186,27 @@ class KTraceState {
       DEBUG_ASSERT((prev & kInflightWritesMask) > 0);
     }
 
-    uint32_t observed_grpmask() const { return observed_grpmask_; }
+    uint32_t observed_grpmask() const {
+      return static_cast<uint32_t>(observed_state_ & ~(kInflightWritesMask | kCpuBlocksFlag));
+    }
+
+    // Whether this write may reserve space from the per-CPU block of the
+    // current CPU.  Stop operations clear the flag together with the group
+    // mask, and then wait for the writers which observed it before padding
+    // the blocks.
+    bool observed_cpu_blocks() const { return (observed_state_ & kCpuBlocksFlag) != 0; }
 
    private:
     KTraceState& ks_;
-    const uint32_t observed_grpmask_;
+    const uint64_t observed_state_;
+  };
+
+  // The portion of the buffer claimed by a CPU in which it writes its records.
+  // Only accessed by its CPU with interrupts disabled while writing, or while
+  // there are no writers in flight.
+  struct CpuBlock {
+    uint8_t* wr{nullptr};
+    uint8_t* end{nullptr};
   };
 
   // A small helper class which should make it impossible to forget to commit a
@@ -233,6 +262,7 @@ class KTraceState {
                : static_cast<uint32_t>(Thread::Current::Get()->tid());
   }
 
+  [[nodiscard]] zx_status_t StopLocked() TA_REQ(lock_);
   [[nodiscard]] zx_status_t RewindLocked() TA_REQ(lock_);
 
   // Add static names (eg syscalls and probes) to the trace buffer.  Called
@@ -269,11 +299,20 @@ class KTraceState {
   zx_status_t AllocBuffer() TA_REQ(lock_);
 
   // Reserve KTRACE_LEN(tag) bytes of contiguous space in the buffer, if
-  // possible.
-  PendingCommit Reserve(uint32_t tag);
+  // possible.  |cpu_blocks| is the observation of the writer's
+  // AutoWriteInFlight, see |AutoWriteInFlight::observed_cpu_blocks|.
+  PendingCommit Reserve(uint32_t tag, bool cpu_blocks);
   // Reserve the specified number of bytes in the buffer, if possible, without
   // the PendingCommit wrapper.
-  void* ReserveRaw(uint32_t num_bytes);
+  void* ReserveRaw(uint32_t num_bytes, bool cpu_blocks);
+
+  // Reserve the specified number of bytes from the block of the current CPU,
+  // claiming a new block if the current one is full.  Interrupts must be
+  // disabled.
+  void* ReserveFromCpuBlock(uint32_t num_bytes) TA_EXCL(write_lock_);
+
+  // Fill the unused remainder of |block| with padding records.
+  static void PadCpuBlock(CpuBlock& block);
 
   inline void DisableGroupMask() {
     grpmask_and_inflight_writes_.fetch_and(kInflightWritesMask, ktl::memory_order_release);
@@ -321,8 +360,13 @@ class KTraceState {
   // 2) Spinning on the in-flight-writes portion of the mask with acquire
   //    semantics until an in-flight count of zero is observed.
   //
+  // The state also holds |kCpuBlocksFlag| in the bits below the group mask,
+  // which is set together with a non-zero group mask when writers should
+  // reserve space from per-CPU blocks.
   static constexpr uint64_t kInflightWritesMask = 0xFFFFFFFF00000000;
   static constexpr uint64_t kInflightWritesInc = 0x0000000100000000;
+  static constexpr uint64_t kCpuBlocksFlag = 0x1;
+  static_assert((KTRACE_GRP_TO_MASK(KTRACE_GRP_ALL) & kCpuBlocksFlag) == 0);
   ktl::atomic<uint64_t> grpmask_and_inflight_writes_{0};
 
   // The target buffer size (in bytes) we would like to use, when we eventually
@@ -432,6 +476,11 @@ class KTraceState {
   //
   uint8_t* buffer_ TA_GUARDED(write_lock_){nullptr};
   uint32_t bufsize_ TA_GUARDED(write_lock_){0};
+
+  // The size of the blocks claimed by each CPU in saturate mode, or 0 if
+  // per-CPU blocks are not used.  Set during the call to Init.
+  uint32_t cpu_block_size_ TA_GUARDED(write_lock_){0};
+  CpuBlock cpu_blocks_[SMP_MAX_CPUS];
 };
 
 }  // namespace internal
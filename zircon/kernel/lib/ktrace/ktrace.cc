@@ -17,6 +17,7 @@
 #include <zircon/errors.h>
 #include <zircon/types.h>
 
+#include <arch/interrupt.h>
 #include <arch/ops.h>
 #include <arch/user_copy.h>
 #include <fbl/alloc_checker.h>
@@ -104,16 +105,25 @@ KTraceState::~KTraceState() {
   }
 }
 
-void KTraceState::Init(uint32_t target_bufsize, uint32_t initial_groups) {
+void KTraceState::Init(uint32_t target_bufsize, uint32_t initial_groups,
+                       uint32_t cpu_block_size) {
   Guard<Mutex> guard(&lock_);
   ASSERT_MSG(target_bufsize_ == 0,
              "Double init of KTraceState instance (tgt_bs %u, new tgt_bs %u)!", target_bufsize_,
              target_bufsize);
   ASSERT(is_started_ == false);
+  ASSERT((cpu_block_size % sizeof(uint64_t)) == 0);
 
   // Allocations are rounded up to the nearest page size.
   target_bufsize_ = fbl::round_up(target_bufsize, static_cast<uint32_t>(PAGE_SIZE));
 
+  bool cpu_blocks;
+  {
+    Guard<SpinLock, IrqSave> write_guard{&write_lock_};
+    cpu_block_size_ = cpu_block_size;
+    cpu_blocks = (cpu_block_size_ != 0);
+  }
+
   if (initial_groups != 0) {
     if (AllocBuffer() == ZX_OK) {
       ReportThreadProcessNames();
@@ -121,7 +131,8 @@ void KTraceState::Init(uint32_t target_bufsize, uint32_t initial_groups) {
     }
   }
 
-  SetGroupMask(KTRACE_GRP_TO_MASK(initial_groups));
+  SetGroupMask(KTRACE_GRP_TO_MASK(initial_groups) |
+               ((cpu_blocks && initial_groups) ? kCpuBlocksFlag : 0));
 }
 
 zx_status_t KTraceState::Start(uint32_t groups, StartMode mode) {
@@ -139,11 +150,24 @@ zx_status_t KTraceState::Start(uint32_t groups, StartMode mode) {
   // that we were not previously operating in circular mode.  It is not legal to
   // re-start a ktrace buffer in saturating mode which had been operating in
   // circular mode.
+  bool cpu_blocks = false;
   if (mode == StartMode::Saturate) {
     Guard<SpinLock, IrqSave> write_guard{&write_lock_};
     if (circular_size_ != 0) {
       return ZX_ERR_BAD_STATE;
     }
+    cpu_blocks = (cpu_block_size_ != 0);
+  }
+
+  // Circular mode writes every record through the shared write pointer.  If we
+  // are switching to it while writers are still using their per-CPU blocks,
+  // stop first so that the blocks are closed before the circular portion of
+  // the buffer is marked out.
+  if ((mode == StartMode::Circular) && is_started_ &&
+      (grpmask_and_inflight_writes_.load(ktl::memory_order_acquire) & kCpuBlocksFlag)) {
+    if (zx_status_t status = StopLocked(); status != ZX_OK) {
+      return status;
+    }
   }
 
   // If we are not yet started, we need to report the current thread and process
@@ -167,14 +191,17 @@ zx_status_t KTraceState::Start(uint32_t groups, StartMode mode) {
   }
 
   is_started_ = true;
-  SetGroupMask(KTRACE_GRP_TO_MASK(groups));
+  SetGroupMask(KTRACE_GRP_TO_MASK(groups) | (cpu_blocks ? kCpuBlocksFlag : 0));
 
   return ZX_OK;
 }
 
 zx_status_t KTraceState::Stop() {
   Guard<Mutex> guard(&lock_);
+  return StopLocked();
+}
 
+zx_status_t KTraceState::StopLocked() {
   // Start by setting the group mask to 0.  This should prevent any new
   // writers from starting write operations.  The non-write lock should
   // prevent anyone else from writing to this field while we are finishing
@@ -198,6 +225,18 @@ zx_status_t KTraceState::Stop() {
     return ZX_ERR_TIMED_OUT;
   }
 
+  // No writer can be using its per-CPU block anymore.  Fill out the unused
+  // remainder of each block, so that the records which follow in the buffer
+  // can still be found by readers, and make each CPU claim a new block the
+  // next time it writes.
+  {
+    Guard<SpinLock, IrqSave> write_guard{&write_lock_};
+    for (CpuBlock& block : cpu_blocks_) {
+      PadCpuBlock(block);
+      block = CpuBlock{};
+    }
+  }
+
   // Great, we are now officially stopped.  Record this.
   is_started_ = false;
   return ZX_OK;
@@ -423,7 +462,9 @@ void KTraceState::WriteRecord(uint32_t effective_tag, uint64_t explicit_ts) {
     explicit_ts = ktrace_timestamp();
   }
 
-  if (PendingCommit reservation = Reserve(effective_tag); reservation.is_valid()) {
+  if (PendingCommit reservation =
+          Reserve(effective_tag, inflight_manager.observed_cpu_blocks());
+      reservation.is_valid()) {
     reservation.hdr()->ts = explicit_ts;
     reservation.hdr()->tid = MakeTidField(effective_tag);
   } else {
@@ -447,7 +488,9 @@ void KTraceState::WriteRecord(uint32_t effective_tag, uint64_t explicit_ts, Args
     explicit_ts = ktrace_timestamp();
   }
 
-  if (PendingCommit reservation = Reserve(effective_tag); reservation.is_valid()) {
+  if (PendingCommit reservation =
+          Reserve(effective_tag, inflight_manager.observed_cpu_blocks());
+      reservation.is_valid()) {
     // Fill out most of the header.  Do not commit the tag until we have the
     // entire record written.
     reservation.hdr()->ts = explicit_ts;
@@ -475,7 +518,8 @@ void KTraceState::WriteRecordTiny(uint32_t tag, uint32_t arg) {
   // Tiny records are always 16 bytes.
   tag = (tag & 0xFFFFFFF0) | 2;
 
-  if (PendingCommit reservation = Reserve(tag); reservation.is_valid()) {
+  if (PendingCommit reservation = Reserve(tag, inflight_manager.observed_cpu_blocks());
+      reservation.is_valid()) {
     reservation.hdr()->ts = ktrace_timestamp();
     reservation.hdr()->tid = arg;
   } else {
@@ -500,7 +544,8 @@ void KTraceState::WriteNameEtc(uint32_t tag, uint32_t id, uint32_t arg, const ch
     // set size to: sizeof(hdr) + len + 1, round up to multiple of 8
     tag = (tag & 0xFFFFFFF0) | ((KTRACE_NAMESIZE + len + 1 + 7) >> 3);
 
-    if (PendingCommit reservation = Reserve(tag); reservation.is_valid()) {
+    if (PendingCommit reservation = Reserve(tag, in_flight_manager.observed_cpu_blocks());
+        reservation.is_valid()) {
       ktrace_rec_name_t* rec = reinterpret_cast<ktrace_rec_name_t*>(reservation.hdr());
       rec->id = id;
       rec->arg = arg;
@@ -571,8 +616,8 @@ zx_status_t KTraceState::AllocBuffer() {
   return ZX_OK;
 }
 
-KTraceState::PendingCommit KTraceState::Reserve(uint32_t tag) {
-  void* ptr = ReserveRaw(KTRACE_LEN(tag));
+KTraceState::PendingCommit KTraceState::Reserve(uint32_t tag, bool cpu_blocks) {
+  void* ptr = ReserveRaw(KTRACE_LEN(tag), cpu_blocks);
   if (ptr != nullptr) {
     return {ptr, tag};
   } else {
@@ -580,7 +625,71 @@ KTraceState::PendingCommit KTraceState::Reserve(uint32_t tag) {
   }
 }
 
-void* KTraceState::ReserveRaw(uint32_t num_bytes) {
+void KTraceState::PadCpuBlock(CpuBlock& block) {
+  // The length field of a tag is 4 bits of 8 byte words, so fill the rest of
+  // the block with the largest padding records we can express.
+  constexpr uint32_t kMaxPaddingRecord = 15 * sizeof(uint64_t);
+  while (block.wr < block.end) {
+    const uint32_t len =
+        static_cast<uint32_t>(ktl::min<ptrdiff_t>(block.end - block.wr, kMaxPaddingRecord));
+    ktl::atomic_ref(*reinterpret_cast<uint32_t*>(block.wr))
+        .store(KTRACE_TAG(0u, 0u, len), ktl::memory_order_release);
+    block.wr += len;
+  }
+}
+
+void* KTraceState::ReserveFromCpuBlock(uint32_t num_bytes) {
+  constexpr uint32_t kUncommitedRecordTag = 0;
+  constexpr uint32_t kBlockHeaderSize = sizeof(ktrace_header_t);
+
+  DEBUG_ASSERT(arch_ints_disabled());
+  const cpu_num_t cpu = arch_curr_cpu_num();
+  CpuBlock& block = cpu_blocks_[cpu];
+
+  // Records normally go into the block of this CPU without touching the shared
+  // write pointer.  Nothing else touches this block while the writer is in
+  // flight with interrupts disabled.  Only when the block is full do we need
+  // the write lock to claim another.
+  if (static_cast<size_t>(block.end - block.wr) < num_bytes) {
+    Guard<SpinLock, NoIrqSave> write_guard{&write_lock_};
+    if (!bufsize_) {
+      return nullptr;
+    }
+    DEBUG_ASSERT(circular_size_ == 0);
+    DEBUG_ASSERT(bufsize_ >= wr_);
+
+    // Close out the current block, then claim the next one.  The last block in
+    // the buffer may be smaller than the others, but it must still be able to
+    // hold its header and this record, or else the buffer is full.
+    PadCpuBlock(block);
+    const uint32_t size =
+        static_cast<uint32_t>(ktl::min<uint64_t>(cpu_block_size_, bufsize_ - wr_));
+    if (size < (kBlockHeaderSize + num_bytes)) {
+      block = CpuBlock{};
+      return nullptr;
+    }
+
+    // Each block starts with a header which tells readers which CPU the
+    // records in it came from, and how far the block extends.
+    auto hdr = reinterpret_cast<ktrace_header_t*>(buffer_ + wr_);
+    hdr->ts = size;
+    hdr->tid = cpu;
+    ktl::atomic_ref(hdr->tag).store(KTRACE_TAG(KTRACE_EVENT_CPU_BLOCK, 0u, kBlockHeaderSize),
+                                    ktl::memory_order_release);
+
+    block.wr = buffer_ + wr_ + kBlockHeaderSize;
+    block.end = buffer_ + wr_ + size;
+    wr_ += size;
+  }
+
+  void* ptr = block.wr;
+  ktl::atomic_ref(*static_cast<uint32_t*>(ptr)).store(kUncommitedRecordTag,
+                                                      ktl::memory_order_release);
+  block.wr += num_bytes;
+  return ptr;
+}
+
+void* KTraceState::ReserveRaw(uint32_t num_bytes, bool cpu_blocks) {
   constexpr uint32_t kUncommitedRecordTag = 0;
   auto Commit = [](void* ptr, uint32_t tag) -> void {
     ktl::atomic_ref(*static_cast<uint32_t*>(ptr)).store(tag, ktl::memory_order_release);
@@ -589,6 +698,11 @@ void* KTraceState::ReserveRaw(uint32_t num_bytes) {
   DEBUG_ASSERT(num_bytes >= sizeof(uint32_t));
   DEBUG_ASSERT(num_bytes % sizeof(uint64_t) == 0);
 
+  if (cpu_blocks) {
+    InterruptDisableGuard irqd;
+    return ReserveFromCpuBlock(num_bytes);
+  }
+
   Guard<SpinLock, IrqSave> write_guard{&write_lock_};
   if (!bufsize_) {
     return nullptr;
@@ -692,7 +806,10 @@ zx::status<KTraceState::FxtCompatWriter::Reservation> KTraceState::FxtCompatWrit
     return zx::error(ZX_ERR_OUT_OF_RANGE);
   }
 
-  void* ptr = ks_.ReserveRaw((fxt_words + 1) * sizeof(uint64_t));
+  // FXT writers do not hold an AutoWriteInFlight, and so may not use the
+  // per-CPU blocks, which are only guaranteed to stay open while a writer is
+  // in flight.
+  void* ptr = ks_.ReserveRaw((fxt_words + 1) * sizeof(uint64_t), false);
   if (ptr == nullptr) {
     return zx::error(ZX_ERR_NO_RESOURCES);
   }
@@ -807,13 +924,14 @@ static void ktrace_init(unsigned level) {
   const bool syscalls_enabled = gBootOptions->enable_debugging_syscalls;
   const uint32_t bufsize = syscalls_enabled ? (gBootOptions->ktrace_bufsize << 20) : 0;
   const uint32_t initial_grpmask = gBootOptions->ktrace_grpmask;
+  const uint32_t cpu_block_size = gBootOptions->ktrace_cpu_block_kb << 10;
 
   if (!bufsize) {
     dprintf(INFO, "ktrace: disabled\n");
     return;
   }
 
-  KTRACE_STATE.Init(bufsize, initial_grpmask);
+  KTRACE_STATE.Init(bufsize, initial_grpmask, cpu_block_size);
 
   if (!initial_grpmask) {
     dprintf(INFO, "ktrace: delaying buffer allocation\n");
@@ -8,6 +8,8 @@
 #include <lib/ktrace/ktrace_internal.h>
 #include <lib/unittest/unittest.h>
 
+#include <kernel/cpu.h>
+#include <kernel/thread.h>
 #include <ktl/algorithm.h>
 #include <ktl/limits.h>
 #include <ktl/unique_ptr.h>
@@ -456,6 +458,109 @@ class TestKTraceState : public ::internal::KTraceState {
     END_TEST;
   }
 
+  static bool CpuBlocksTest() {
+    BEGIN_TEST;
+
+    // Pin ourselves to our current CPU, so that all of our records end up in
+    // the blocks claimed by a single CPU.
+    Thread* const current_thread = Thread::Current::Get();
+    const cpu_mask_t original_affinity = current_thread->GetCpuAffinity();
+    const auto restore_affinity =
+        fit::defer([&]() { current_thread->SetCpuAffinity(original_affinity); });
+    current_thread->SetCpuAffinity(cpu_num_to_mask(arch_curr_cpu_num()));
+    const cpu_num_t cpu = arch_curr_cpu_num();
+
+    // Create a small trace buffer which holds three full blocks after its
+    // metadata, followed by a final smaller one.
+    constexpr uint32_t kGroups = 0x1;
+    constexpr uint32_t kBlockSize = 1024;
+    constexpr uint32_t kMetadataSize = sizeof(ktrace_rec_32b_t) * 2;
+    constexpr uint32_t kHeaderSize = sizeof(ktrace_header_t);
+    constexpr uint32_t kRecordsPerBlock = (kBlockSize - kHeaderSize) / 16;
+    constexpr uint32_t kLastBlockSize = (kDefaultBufferSize - kMetadataSize) % kBlockSize;
+    constexpr uint32_t kMaxRecords =
+        (((kDefaultBufferSize - kMetadataSize) / kBlockSize) * kRecordsPerBlock) +
+        ((kLastBlockSize - kHeaderSize) / 16);
+    TestKTraceState state;
+    ASSERT_TRUE(state.Init(kDefaultBufferSize, kGroups, kBlockSize));
+
+    // Nothing is claimed until the first record is written.
+    ASSERT_TRUE(state.CheckExpectedOffset(kMetadataSize));
+
+    auto MakeTag = [](uint32_t wr_ndx) { return KTRACE_TAG(wr_ndx + 1, 1, 0); };
+    uint32_t records = 0;
+    uint32_t blocks = 0;
+    uint64_t block_end = 0;
+    uint32_t rd_offset = kMetadataSize;
+    auto checker = [&](const ktrace_header_t* hdr) -> bool {
+      BEGIN_TEST;
+      ASSERT_NONNULL(hdr);
+
+      if (KTRACE_GROUP(hdr->tag) == 0) {
+        // Only padding records and block headers have no group.  Headers must
+        // start where the previous block ended, and padding must stay within
+        // the block.
+        if (KTRACE_EVENT(hdr->tag) == KTRACE_EVENT_CPU_BLOCK) {
+          EXPECT_EQ(kHeaderSize, KTRACE_LEN(hdr->tag));
+          EXPECT_EQ(cpu, hdr->tid);
+          EXPECT_EQ(block_end, rd_offset);
+          EXPECT_TRUE(hdr->ts == kBlockSize || hdr->ts == kLastBlockSize);
+          block_end = rd_offset + hdr->ts;
+          ++blocks;
+        } else {
+          EXPECT_LE(rd_offset + KTRACE_LEN(hdr->tag), block_end);
+        }
+      } else {
+        EXPECT_LT(rd_offset, block_end);
+        EXPECT_EQ(KTRACE_EVENT(MakeTag(records)), KTRACE_EVENT(hdr->tag));
+        EXPECT_EQ(records, hdr->tid);
+        ++records;
+      }
+
+      rd_offset += KTRACE_LEN(hdr->tag);
+      END_TEST;
+    };
+
+    // Write a few records, then stop.  The first block should have been
+    // claimed and padded out to its full size.
+    constexpr uint32_t kFewRecords = 3;
+    for (uint32_t i = 0; i < kFewRecords; ++i) {
+      state.WriteRecordTiny(MakeTag(i), i);
+    }
+    EXPECT_EQ(KTRACE_GRP_TO_MASK(kGroups), state.grpmask());
+    ASSERT_OK(state.Stop());
+
+    uint32_t rcnt = 0;
+    block_end = kMetadataSize;
+    ASSERT_TRUE(state.TestAllRecords(rcnt, checker));
+    EXPECT_TRUE(state.CheckExpectedOffset(kMetadataSize + kBlockSize));
+    EXPECT_EQ(1u, blocks);
+    EXPECT_EQ(kFewRecords, records);
+
+    // Rewind, then fill the buffer.  The last block is smaller than the rest,
+    // and the buffer is full once it is.
+    ASSERT_OK(state.Rewind());
+    ASSERT_OK(state.Start(kGroups, StartMode::Saturate));
+    for (uint32_t i = 0; i < kMaxRecords; ++i) {
+      state.WriteRecordTiny(MakeTag(i), i);
+    }
+    EXPECT_EQ(KTRACE_GRP_TO_MASK(kGroups), state.grpmask());
+    state.WriteRecordTiny(MakeTag(kMaxRecords), kMaxRecords);
+    EXPECT_EQ(0u, state.grpmask());
+    ASSERT_OK(state.Stop());
+
+    records = 0;
+    blocks = 0;
+    block_end = kMetadataSize;
+    rd_offset = kMetadataSize;
+    ASSERT_TRUE(state.TestAllRecords(rcnt, checker));
+    EXPECT_TRUE(state.CheckExpectedOffset(kDefaultBufferSize));
+    EXPECT_EQ(4u, blocks);
+    EXPECT_EQ(kMaxRecords, records);
+
+    END_TEST;
+  }
+
   static bool RewindTest() {
     BEGIN_TEST;
 
@@ -863,7 +968,8 @@ class TestKTraceState : public ::internal::KTraceState {
 
   // We interpose ourselves in the Init path so that we can allocate the side
   // buffer we will use for validation.
-  [[nodiscard]] bool Init(uint32_t target_bufsize, uint32_t initial_groups) {
+  [[nodiscard]] bool Init(uint32_t target_bufsize, uint32_t initial_groups,
+                          uint32_t cpu_block_size = 0) {
     BEGIN_TEST;
 
     // Tests should always be allocating in units of page size.
@@ -876,7 +982,7 @@ class TestKTraceState : public ::internal::KTraceState {
     ASSERT_TRUE(ac.check());
     validation_buffer_size_ = target_bufsize;
 
-    KTraceState::Init(target_bufsize, initial_groups);
+    KTraceState::Init(target_bufsize, initial_groups, cpu_block_size);
 
     // Make sure that the buffer size we requested was allocated exactly.
     {
@@ -1007,6 +1113,7 @@ UNITTEST("names", ktrace_tests::TestKTraceState::NamesTest)
 UNITTEST("write record", ktrace_tests::TestKTraceState::WriteRecordsTest)
 UNITTEST("write tiny record", ktrace_tests::TestKTraceState::WriteTinyRecordsTest)
 UNITTEST("saturation", ktrace_tests::TestKTraceState::SaturationTest)
+UNITTEST("cpu blocks", ktrace_tests::TestKTraceState::CpuBlocksTest)
 UNITTEST("rewind", ktrace_tests::TestKTraceState::RewindTest)
 UNITTEST("state check", ktrace_tests::TestKTraceState::StateCheckTest)
 UNITTEST("circular", ktrace_tests::TestKTraceState::CircularWriteTest)
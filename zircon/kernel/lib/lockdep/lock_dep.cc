@@ -7,6 +7,7 @@
 #include <debug.h>
 #include <inttypes.h>
 #include <lib/console.h>
+#include <platform.h>
 #include <string.h>
 
 #include <new>
@@ -38,6 +39,12 @@ Event detection_complete_event;
 // Synchronizes the access to the loop detection completion event.
 DECLARE_SINGLETON_MUTEX(DetectionCompleteLock);
 
+// Acquisitions which wait at least this many ticks for their lock are counted
+// as contended.  Anything shorter is within the cost of an uncontended acquire.
+// Nothing is counted as contended until this is set during init.
+constexpr zx_duration_t kContendedWaitThreshold = ZX_USEC(1);
+RelaxedAtomic<uint64_t> contended_wait_ticks{UINT64_MAX};
+
 // Loop detection thread. Traverses the lock dependency graph to find circular
 // lock dependencies.
 int LockDepThread(void* /*arg*/) {
@@ -55,10 +62,83 @@ int LockDepThread(void* /*arg*/) {
 }
 
 void LockDepInit(unsigned /*level*/) {
+  contended_wait_ticks.store(static_cast<uint64_t>(
+      platform_get_ticks_to_time_ratio().Inverse().Scale(kContendedWaitThreshold)));
+
   Thread* t = Thread::Create("lockdep", &LockDepThread, NULL, LOW_PRIORITY);
   t->DetachAndResume();
 }
 
+// Tracks the maximum of the values stored to |max|.
+void UpdateMax(ktl::atomic<uint64_t>& max, uint64_t value) {
+  uint64_t current = max.load(ktl::memory_order_relaxed);
+  while (value > current &&
+         !max.compare_exchange_weak(current, value, ktl::memory_order_relaxed)) {
+  }
+}
+
+// Dumps the lock classes with the most total wait time, and their statistics.
+void DumpLockStats(size_t count) {
+  const affine::Ratio ticks_to_time = platform_get_ticks_to_time_ratio();
+  auto ToUsec = [&ticks_to_time](const ktl::atomic<uint64_t>& ticks) -> uint64_t {
+    const zx_ticks_t value = static_cast<zx_ticks_t>(ticks.load(ktl::memory_order_relaxed));
+    return static_cast<uint64_t>(ticks_to_time.Scale(value) / ZX_USEC(1));
+  };
+
+  printf("%-40s %12s %12s %14s %10s %14s %10s\n", "lock class", "acquired", "contended",
+         "wait(us)", "max(us)", "hold(us)", "max(us)");
+
+  // Select the classes in order of decreasing total wait time, breaking ties by
+  // address, without having to allocate space to sort them.
+  uint64_t prev_wait = UINT64_MAX;
+  const lockdep::LockClassState* prev = nullptr;
+  for (size_t i = 0; i < count; ++i) {
+    lockdep::LockClassState* next = nullptr;
+    uint64_t next_wait = 0;
+    for (auto& state : lockdep::LockClassState::Iter()) {
+      auto& stats = state.stats();
+      if (stats.acquisitions.load(ktl::memory_order_relaxed) == 0) {
+        continue;
+      }
+      const uint64_t wait = stats.total_wait_time.load(ktl::memory_order_relaxed);
+      const bool after_prev = wait < prev_wait || (wait == prev_wait && &state < prev);
+      const bool before_next = next == nullptr || wait > next_wait ||
+                               (wait == next_wait && &state > next);
+      if (after_prev && before_next) {
+        next = &state;
+        next_wait = wait;
+      }
+    }
+    if (next == nullptr) {
+      break;
+    }
+
+    auto& stats = next->stats();
+    printf("%-40s %12" PRIu64 " %12" PRIu64 " %14" PRIu64 " %10" PRIu64 " %14" PRIu64
+           " %10" PRIu64 "\n",
+           next->name(), stats.acquisitions.load(ktl::memory_order_relaxed),
+           stats.contentions.load(ktl::memory_order_relaxed), ToUsec(stats.total_wait_time),
+           ToUsec(stats.max_wait_time), ToUsec(stats.total_hold_time),
+           ToUsec(stats.max_hold_time));
+
+    prev = next;
+    prev_wait = next_wait;
+  }
+}
+
+// Resets the statistics of every lock class.
+void ResetLockStats() {
+  for (auto& state : lockdep::LockClassState::Iter()) {
+    auto& stats = state.stats();
+    stats.acquisitions.store(0, ktl::memory_order_relaxed);
+    stats.contentions.store(0, ktl::memory_order_relaxed);
+    stats.total_wait_time.store(0, ktl::memory_order_relaxed);
+    stats.max_wait_time.store(0, ktl::memory_order_relaxed);
+    stats.total_hold_time.store(0, ktl::memory_order_relaxed);
+    stats.max_hold_time.store(0, ktl::memory_order_relaxed);
+  }
+}
+
 // Dumps the state of the lock dependency graph.
 void DumpLockClassState() {
   printf("Lock class states:\n");
@@ -107,6 +187,34 @@ int CommandLockDep(int argc, const cmd_args* argv, uint32_t flags) {
   return 0;
 }
 
+// Lock statistics command.
+int CommandLockStat(int argc, const cmd_args* argv, uint32_t flags) {
+  if (!lockdep::kLockStatsEnabled) {
+    printf("Lock statistics are not enabled in this build (LOCK_DEP_ENABLE_STATS).\n");
+    return -1;
+  }
+
+  if (argc < 2) {
+    printf("Not enough arguments:\n");
+  usage:
+    printf("%s dump [count]      : dump the lock classes with the most wait time\n",
+           argv[0].str);
+    printf("%s reset             : reset lock statistics\n", argv[0].str);
+    return -1;
+  }
+
+  if (strcmp(argv[1].str, "dump") == 0) {
+    DumpLockStats(argc >= 3 ? argv[2].u : 20);
+  } else if (strcmp(argv[1].str, "reset") == 0) {
+    ResetLockStats();
+  } else {
+    printf("Unrecognized subcommand: '%s'\n", argv[1].str);
+    goto usage;
+  }
+
+  return 0;
+}
+
 }  // anonymous namespace
 
 // Wait for a loop detection pass to complete, or timeout.
@@ -119,6 +227,7 @@ zx_status_t TriggerAndWaitForLoopDetection(zx_time_t deadline) {
 
 STATIC_COMMAND_START
 STATIC_COMMAND("lockdep", "kernel lock diagnostics", &CommandLockDep)
+STATIC_COMMAND("lockstat", "kernel lock contention statistics", &CommandLockStat)
 STATIC_COMMAND_END(lockdep)
 
 LK_INIT_HOOK(lockdep, LockDepInit, LK_INIT_LEVEL_THREADING)
@@ -186,6 +295,26 @@ void SystemInitThreadLockState(ThreadLockState*) {}
 // every 2 seconds, clearing the flag and performing a check if the flag is set.
 void SystemTriggerLoopDetection() { loop_detection_graph_is_dirty.store(true); }
 
+// Lock statistics are measured in ticks, which are converted to time when they
+// are dumped.  These hooks must not acquire any locks of their own.
+uint64_t SystemLockStatsTimestamp() { return current_ticks(); }
+
+void SystemLockAcquired(LockClassId id, uint64_t wait_time) {
+  LockClassState::Stats& stats = LockClassState::GetStats(id);
+  stats.acquisitions.fetch_add(1, ktl::memory_order_relaxed);
+  if (wait_time >= contended_wait_ticks.load()) {
+    stats.contentions.fetch_add(1, ktl::memory_order_relaxed);
+  }
+  stats.total_wait_time.fetch_add(wait_time, ktl::memory_order_relaxed);
+  UpdateMax(stats.max_wait_time, wait_time);
+}
+
+void SystemLockReleased(LockClassId id, uint64_t hold_time) {
+  LockClassState::Stats& stats = LockClassState::GetStats(id);
+  stats.total_hold_time.fetch_add(hold_time, ktl::memory_order_relaxed);
+  UpdateMax(stats.max_hold_time, hold_time);
+}
+
 }  // namespace lockdep
 
 #endif
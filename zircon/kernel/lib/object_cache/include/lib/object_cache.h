@@ -255,6 +255,20 @@ class ObjectCache<T, Option::Single, Allocator> {
 
   static constexpr size_t objects_per_slab() { return kEntriesPerSlab; }
 
+  // Releases every empty slab retained by this cache, including the reserve
+  // slabs, back to the allocator. The reserve is rebuilt on demand by later
+  // allocations. Returns the number of slabs released.
+  size_t Trim() TA_EXCL(lock_) {
+    LocalTraceDuration<Detail> trace{"ObjectCache::Trim"_stringref};
+    Guard<Mutex> guard{&lock_};
+    size_t count = 0;
+    while (!empty_list_.is_empty()) {
+      RemoveSlab(&empty_list_.front());
+      count++;
+    }
+    return count;
+  }
+
  private:
   template <typename, typename>
   friend struct Deleter;
@@ -642,6 +656,16 @@ class ObjectCache<T, Option::PerCpu, Allocator> {
     return count;
   }
 
+  // Releases the empty slabs retained by each of the per-CPU caches. Returns
+  // the total number of slabs released.
+  size_t Trim() {
+    size_t count = 0;
+    for (size_t i = 0; i < processor_count_; i++) {
+      count += cpu_caches_[i]->Trim();
+    }
+    return count;
+  }
+
  private:
   using CpuCache = ktl::optional<ObjectCache<T, Option::Single, Allocator>>;
 
@@ -187,6 +187,14 @@ bool ObjectCacheTests() {
 
     EXPECT_EQ(TestObject::constructor_count, TestObject::destructor_count);
     EXPECT_EQ(object_count, TestObject::destructor_count);
+
+    // Trimming releases the retained reserve slabs.
+    const size_t retained_slabs = static_cast<size_t>(ktl::min(retain_slabs, slab_count));
+    EXPECT_EQ(retained_slabs, object_cache->slab_count());
+    EXPECT_EQ(retained_slabs, object_cache->Trim());
+    EXPECT_EQ(0u, object_cache->slab_count());
+    EXPECT_EQ(TestAllocator::allocated_slabs, TestAllocator::freed_slabs);
+    EXPECT_EQ(0u, object_cache->Trim());
   }
   EXPECT_EQ(TestObject::constructor_count, TestObject::destructor_count);
 
@@ -145,10 +145,49 @@ class PageCache {
     }
   }
 
+  struct AllocateZeroedResult {
+    // The page allocated by the request.
+    vm_page_t* page{nullptr};
+
+    // True if the page came from the pre-zeroed pool and is already filled
+    // with zeros. Otherwise the caller must zero the page itself.
+    bool zeroed{false};
+
+    // The number of pages remaining in the pre-zeroed pool after the request.
+    size_t zeroed_pages{0};
+  };
+
+  // Allocates a single page, taking it from the pre-zeroed pool of the current
+  // CPU when possible. Falls back to Allocate() if the pool is empty or the
+  // request is for low mem/loaned pages.
+  zx::status<AllocateZeroedResult> AllocateZeroed(uint alloc_flags = 0);
+
+  // Tops up the pre-zeroed pool of every CPU to the given number of pages,
+  // zeroing new pages outside of the cache locks. Returns the number of pages
+  // added, or an error if the PMM could not provide a page. The cost of zeroing
+  // is paid by the caller, which is expected to be a lowest priority thread that
+  // only runs when the CPUs are otherwise idle.
+  zx::status<size_t> FillZeroedPages(size_t target_pages);
+
+  // The pre-zeroed pool counters of the calling CPU. The counters are shared by
+  // every PageCache instance, so tests compare the values before and after an
+  // operation rather than the absolute values.
+  struct ZeroedCounts {
+    int64_t hit_pages;
+    int64_t inline_pages;
+    int64_t fill_pages;
+    int64_t available_pages;
+  };
+  static ZeroedCounts GetZeroedCountsCurrCpu();
+
   size_t reserve_pages() const { return reserve_pages_; }
 
  private:
   struct alignas(MAX_CACHE_LINE) CpuCache {
+    // The pages left in the pre-zeroed pool are freed with the cache, and no
+    // longer available.
+    ~CpuCache() { CountZeroedReleasePages(zeroed_pages); }
+
     DECLARE_MUTEX(CpuCache) fill_lock;
     DECLARE_MUTEX(CpuCache) cache_lock;
 
@@ -157,6 +196,12 @@ class PageCache {
 
     TA_GUARDED(cache_lock)
     PageList free_list;
+
+    TA_GUARDED(cache_lock)
+    size_t zeroed_pages{0};
+
+    TA_GUARDED(cache_lock)
+    PageList zeroed_list;
   };
 
   explicit PageCache(size_t reserve_pages, ktl::unique_ptr<CpuCache[]> entries)
@@ -167,6 +212,10 @@ class PageCache {
   static void CountRefillPages(size_t page_count);
   static void CountReturnPages(size_t page_count);
   static void CountFreePages(size_t page_count);
+  static void CountZeroedHitPages(size_t page_count);
+  static void CountZeroedInlinePages(size_t page_count);
+  static void CountZeroedFillPages(size_t page_count);
+  static void CountZeroedReleasePages(size_t page_count);
 
   // Attempts to allocate the given number of pages from the CPU cache. If the
   // cache is insufficient for the request, falls back to the PMM to fulfill the
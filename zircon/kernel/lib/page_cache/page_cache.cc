@@ -11,6 +11,7 @@
 #include <new>
 
 #include <arch/defines.h>
+#include <arch/ops.h>
 #include <kernel/percpu.h>
 
 KCOUNTER(page_cache_hit_pages, "cache.page.hit")
@@ -18,6 +19,10 @@ KCOUNTER(page_cache_miss_pages, "cache.page.missed")
 KCOUNTER(page_cache_refill_pages, "cache.page.refilled")
 KCOUNTER(page_cache_return_pages, "cache.page.returned")
 KCOUNTER(page_cache_free_pages, "cache.page.freed")
+KCOUNTER(page_cache_zeroed_hit_pages, "cache.page.zeroed.hit")
+KCOUNTER(page_cache_zeroed_inline_pages, "cache.page.zeroed.inline")
+KCOUNTER(page_cache_zeroed_fill_pages, "cache.page.zeroed.filled")
+KCOUNTER(page_cache_zeroed_available_pages, "cache.page.zeroed.available")
 
 namespace page_cache {
 
@@ -34,6 +39,78 @@ zx::status<PageCache> PageCache::Create(size_t reserve_pages) {
   return zx::ok(PageCache{reserve_pages, ktl::move(entries)});
 }
 
+zx::status<PageCache::AllocateZeroedResult> PageCache::AllocateZeroed(uint alloc_flags) {
+  LocalTraceDuration trace{"PageCache::AllocateZeroed"_stringref};
+  DEBUG_ASSERT(per_cpu_caches_ != nullptr);
+
+  // Pre-zeroed pages are never low mem or loaned pages.
+  if (!(alloc_flags &
+        (PMM_ALLOC_FLAG_LO_MEM | PMM_ALLOC_FLAG_MUST_BORROW | PMM_ALLOC_FLAG_CAN_BORROW))) {
+    AutoPreemptDisabler preempt_disable;
+    CpuCache& entry = per_cpu_caches_[arch_curr_cpu_num()];
+
+    Guard<Mutex> guard{&entry.cache_lock};
+    if (entry.zeroed_pages > 0) {
+      vm_page* page = list_remove_head_type(&entry.zeroed_list, vm_page, queue_node);
+      DEBUG_ASSERT(page != nullptr);
+      page->set_state(vm_page_state::ALLOC);
+      entry.zeroed_pages--;
+
+      CountZeroedHitPages(1);
+      return zx::ok(AllocateZeroedResult{page, true, entry.zeroed_pages});
+    }
+  }
+
+  zx::status<AllocateResult> result = Allocate(1, alloc_flags);
+  if (result.is_error()) {
+    return zx::error_status(result.error_value());
+  }
+
+  vm_page* page = list_remove_head_type(&result->page_list, vm_page, queue_node);
+  DEBUG_ASSERT(page != nullptr);
+  DEBUG_ASSERT(result->page_list.is_empty());
+
+  CountZeroedInlinePages(1);
+  return zx::ok(AllocateZeroedResult{page, false, 0});
+}
+
+zx::status<size_t> PageCache::FillZeroedPages(size_t target_pages) {
+  LocalTraceDuration trace{"PageCache::FillZeroedPages"_stringref};
+  DEBUG_ASSERT(per_cpu_caches_ != nullptr);
+
+  size_t filled_pages = 0;
+  const cpu_num_t cpu_count = percpu::processor_count();
+  for (cpu_num_t cpu = 0; cpu < cpu_count; cpu++) {
+    CpuCache& entry = per_cpu_caches_[cpu];
+    while (true) {
+      {
+        Guard<Mutex> guard{&entry.cache_lock};
+        if (entry.zeroed_pages >= target_pages) {
+          break;
+        }
+      }
+
+      vm_page* page;
+      paddr_t pa;
+      const zx_status_t status = pmm_alloc_page(0, &page, &pa);
+      if (status != ZX_OK) {
+        return zx::error_status(status);
+      }
+      arch_zero_page(paddr_to_physmap(pa));
+      page->set_state(vm_page_state::CACHE);
+
+      Guard<Mutex> guard{&entry.cache_lock};
+      list_add_tail(&entry.zeroed_list, &page->queue_node);
+      entry.zeroed_pages++;
+      filled_pages++;
+
+      CountZeroedFillPages(1);
+    }
+  }
+
+  return zx::ok(filled_pages);
+}
+
 void PageCache::CountHitPages(size_t page_count) {
   page_cache_hit_pages.Add(static_cast<int64_t>(page_count));
 }
@@ -54,4 +131,31 @@ void PageCache::CountFreePages(size_t page_count) {
   page_cache_free_pages.Add(static_cast<int64_t>(page_count));
 }
 
+void PageCache::CountZeroedHitPages(size_t page_count) {
+  page_cache_zeroed_hit_pages.Add(static_cast<int64_t>(page_count));
+  page_cache_zeroed_available_pages.Add(-static_cast<int64_t>(page_count));
+}
+
+void PageCache::CountZeroedInlinePages(size_t page_count) {
+  page_cache_zeroed_inline_pages.Add(static_cast<int64_t>(page_count));
+}
+
+void PageCache::CountZeroedFillPages(size_t page_count) {
+  page_cache_zeroed_fill_pages.Add(static_cast<int64_t>(page_count));
+  page_cache_zeroed_available_pages.Add(static_cast<int64_t>(page_count));
+}
+
+void PageCache::CountZeroedReleasePages(size_t page_count) {
+  page_cache_zeroed_available_pages.Add(-static_cast<int64_t>(page_count));
+}
+
+PageCache::ZeroedCounts PageCache::GetZeroedCountsCurrCpu() {
+  return ZeroedCounts{
+      .hit_pages = page_cache_zeroed_hit_pages.ValueCurrCpu(),
+      .inline_pages = page_cache_zeroed_inline_pages.ValueCurrCpu(),
+      .fill_pages = page_cache_zeroed_fill_pages.ValueCurrCpu(),
+      .available_pages = page_cache_zeroed_available_pages.ValueCurrCpu(),
+  };
+}
+
 }  // namespace page_cache
@@ -11,6 +11,7 @@
 
 #include <arch/ops.h>
 #include <kernel/auto_preempt_disabler.h>
+#include <kernel/percpu.h>
 
 namespace {
 
@@ -117,8 +118,124 @@ bool page_cache_tests() {
   END_TEST;
 }
 
+bool page_cache_zeroed_tests() {
+  BEGIN_TEST;
+
+  auto page_cache_result = page_cache::PageCache::Create(8);
+  ASSERT_TRUE(page_cache_result.is_ok());
+  page_cache::PageCache page_cache = ktl::move(page_cache_result.value());
+
+  // See page_cache_tests() above.
+  Thread* const current_thread = Thread::Current::Get();
+  const cpu_mask_t original_affinity_mask = current_thread->GetCpuAffinity();
+
+  const auto restore_affinity = fit::defer([original_affinity_mask, current_thread]() {
+    current_thread->SetCpuAffinity(original_affinity_mask);
+  });
+
+  {
+    AutoPreemptDisabler preempt_disable;
+    const cpu_num_t current_cpu = arch_curr_cpu_num();
+    current_thread->SetCpuAffinity(cpu_num_to_mask(current_cpu));
+  }
+
+  const auto free_page = [&page_cache](vm_page_t* page) {
+    page_cache::PageCache::PageList page_list;
+    list_add_tail(&page_list, &page->queue_node);
+    page_cache.Free(ktl::move(page_list));
+  };
+
+  // The counters are global, and every page cache operation below runs on the
+  // current CPU, so they are checked relative to their values at the start.
+  const page_cache::PageCache::ZeroedCounts start_counts =
+      page_cache::PageCache::GetZeroedCountsCurrCpu();
+  const auto counts_since_start = [&start_counts]() {
+    const page_cache::PageCache::ZeroedCounts counts =
+        page_cache::PageCache::GetZeroedCountsCurrCpu();
+    return page_cache::PageCache::ZeroedCounts{
+        .hit_pages = counts.hit_pages - start_counts.hit_pages,
+        .inline_pages = counts.inline_pages - start_counts.inline_pages,
+        .fill_pages = counts.fill_pages - start_counts.fill_pages,
+        .available_pages = counts.available_pages - start_counts.available_pages,
+    };
+  };
+
+  // An allocation from an empty pool falls back to the regular cache and must
+  // be zeroed by the caller.
+  {
+    auto result = page_cache.AllocateZeroed();
+    ASSERT_TRUE(result.is_ok());
+    ASSERT_NONNULL(result->page);
+    EXPECT_FALSE(result->zeroed);
+    free_page(result->page);
+    EXPECT_EQ(1, counts_since_start().inline_pages);
+  }
+
+  // Filling the pool adds the requested number of pages for every CPU, and
+  // filling a full pool is a no-op.
+  const size_t zeroed_pages = 4;
+  {
+    auto result = page_cache.FillZeroedPages(zeroed_pages);
+    ASSERT_TRUE(result.is_ok());
+    EXPECT_EQ(zeroed_pages * percpu::processor_count(), result.value());
+
+    auto refill_result = page_cache.FillZeroedPages(zeroed_pages);
+    ASSERT_TRUE(refill_result.is_ok());
+    EXPECT_EQ(0u, refill_result.value());
+
+    const page_cache::PageCache::ZeroedCounts counts = counts_since_start();
+    EXPECT_EQ(static_cast<int64_t>(result.value()), counts.fill_pages);
+    EXPECT_EQ(static_cast<int64_t>(result.value()), counts.available_pages);
+  }
+
+  // Allocations drain the pool of the current CPU and return zeroed pages.
+  for (size_t i = 1; i <= zeroed_pages; i++) {
+    auto result = page_cache.AllocateZeroed();
+    ASSERT_TRUE(result.is_ok());
+    ASSERT_NONNULL(result->page);
+    EXPECT_TRUE(result->zeroed);
+    EXPECT_EQ(zeroed_pages - i, result->zeroed_pages);
+
+    const auto* data = static_cast<const uint8_t*>(paddr_to_physmap(result->page->paddr()));
+    size_t nonzero_bytes = 0;
+    for (size_t j = 0; j < PAGE_SIZE; j++) {
+      nonzero_bytes += data[j] != 0;
+    }
+    EXPECT_EQ(0u, nonzero_bytes);
+    free_page(result->page);
+  }
+  {
+    const page_cache::PageCache::ZeroedCounts counts = counts_since_start();
+    EXPECT_EQ(static_cast<int64_t>(zeroed_pages), counts.hit_pages);
+    EXPECT_EQ(1, counts.inline_pages);
+    EXPECT_EQ(static_cast<int64_t>(zeroed_pages * (percpu::processor_count() - 1)),
+              counts.available_pages);
+  }
+
+  // Low mem allocations never use the pool.
+  {
+    auto fill_result = page_cache.FillZeroedPages(zeroed_pages);
+    ASSERT_TRUE(fill_result.is_ok());
+    EXPECT_EQ(zeroed_pages, fill_result.value());
+
+    auto result = page_cache.AllocateZeroed(PMM_ALLOC_FLAG_LO_MEM);
+    if (result.is_ok()) {
+      EXPECT_FALSE(result->zeroed);
+      pmm_free_page(result->page);
+    }
+  }
+
+  // Destroying the cache releases its pools, which leaves the available count
+  // where it started.
+  page_cache = page_cache::PageCache();
+  EXPECT_EQ(0, counts_since_start().available_pages);
+
+  END_TEST;
+}
+
 }  // anonymous namespace
 
 UNITTEST_START_TESTCASE(page_cache_tests)
 UNITTEST("page_cache_tests", page_cache_tests)
+UNITTEST("page_cache_zeroed_tests", page_cache_zeroed_tests)
 UNITTEST_END_TESTCASE(page_cache_tests, "page_cache", "page_cache tests")
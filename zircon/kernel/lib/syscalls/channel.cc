@@ -16,6 +16,7 @@
 
 #include <fbl/algorithm.h>
 #include <fbl/ref_ptr.h>
+#include <ktl/span.h>
 #include <ktl/type_traits.h>
 #include <object/channel_dispatcher.h>
 #include <object/handle.h>
@@ -66,17 +67,25 @@ static void record_recv_msg_sz(uint32_t size) {
 
 // zx_status_t zx_channel_create
 zx_status_t sys_channel_create(uint32_t options, user_out_handle* out0, user_out_handle* out1) {
-  if (options != 0u)
+  if ((options & ~ZX_CHANNEL_SHARED_RING) != 0u)
     return ZX_ERR_INVALID_ARGS;
 
   auto up = ProcessDispatcher::GetCurrent();
   zx_status_t res = up->EnforceBasicPolicy(ZX_POL_NEW_CHANNEL);
   if (res != ZX_OK)
     return res;
+  // The shared ring is a VMO, and so creating one is also subject to the VMO policy.
+  if (options & ZX_CHANNEL_SHARED_RING) {
+    res = up->EnforceBasicPolicy(ZX_POL_NEW_VMO);
+    if (res != ZX_OK)
+      return res;
+  }
 
   KernelHandle<ChannelDispatcher> handle0, handle1;
   zx_rights_t rights;
-  zx_status_t result = ChannelDispatcher::Create(&handle0, &handle1, &rights);
+  zx_status_t result = (options & ZX_CHANNEL_SHARED_RING)
+                           ? ChannelDispatcher::CreateWithSharedRing(&handle0, &handle1, &rights)
+                           : ChannelDispatcher::Create(&handle0, &handle1, &rights);
   if (result != ZX_OK)
     return result;
 
@@ -125,13 +134,13 @@ static __WARN_UNUSED_RESULT zx_status_t msg_get_handles(ProcessDispatcher* up, M
 
   // The MessagePacket currently owns the handle.  Only after transferring the handles into this
   // process's handle table can we relieve MessagePacket of its handle ownership responsibility.
+  HandleOwner owners[kMaxMessageHandles];
   for (size_t i = 0; i < num_handles; ++i) {
     if (handle_list[i]->dispatcher()->is_waitable())
       handle_list[i]->dispatcher()->Cancel(handle_list[i]);
-    HandleOwner handle(handle_list[i]);
-    // TODO(fxbug.dev/30916): This takes a lock per call. Consider doing these in a batch.
-    up->handle_table().AddHandle(ktl::move(handle));
+    owners[i] = HandleOwner(handle_list[i]);
   }
+  up->handle_table().AddHandles(ktl::span(owners, num_handles));
   msg->set_owns_handles(false);
 
   return ZX_OK;
@@ -8,6 +8,7 @@
 #include <zircon/syscalls/hypervisor.h>
 
 #include <fbl/ref_ptr.h>
+#include <object/event_dispatcher.h>
 #include <object/guest_dispatcher.h>
 #include <object/handle.h>
 #include <object/port_dispatcher.h>
@@ -53,14 +54,20 @@ zx_status_t sys_guest_set_trap(zx_handle_t handle, uint32_t kind, zx_vaddr_t add
   }
 
   fbl::RefPtr<PortDispatcher> port;
+  fbl::RefPtr<EventDispatcher> event;
   if (port_handle != ZX_HANDLE_INVALID) {
     status = up->handle_table().GetDispatcherWithRights(*up, port_handle, ZX_RIGHT_WRITE, &port);
+    if (status == ZX_ERR_WRONG_TYPE && kind == ZX_GUEST_TRAP_BELL) {
+      // A bell trap may instead signal an event.
+      status =
+          up->handle_table().GetDispatcherWithRights(*up, port_handle, ZX_RIGHT_SIGNAL, &event);
+    }
     if (status != ZX_OK) {
       return status;
     }
   }
 
-  return guest->SetTrap(kind, addr, size, ktl::move(port), key);
+  return guest->SetTrap(kind, addr, size, ktl::move(port), ktl::move(event), key);
 }
 
 zx_status_t sys_vcpu_create(zx_handle_t guest_handle, uint32_t options, zx_vaddr_t entry,
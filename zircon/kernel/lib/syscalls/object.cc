@@ -38,6 +38,7 @@
 #include <object/vcpu_dispatcher.h>
 #include <object/vm_address_region_dispatcher.h>
 #include <object/vm_object_dispatcher.h>
+#include <vm/compression.h>
 #include <vm/pmm.h>
 #include <vm/vm.h>
 
@@ -762,8 +763,9 @@ zx_status_t sys_object_get_info(zx_handle_t handle, uint32_t topic, user_out_ptr
 
       // Populate additional stats for the ZX_INFO_KMEM_STATS_EXTENDED topic, that are more
       // expensive to compute than ZX_INFO_KMEM_STATS.
+      // When anonymous pages are reclaimable by compression they share the reclaim queues, and so
+      // are included in these counts.
       PageQueues::ReclaimCounts pager_counts = pmm_page_queues()->GetReclaimQueueCounts();
-      ASSERT(PageQueues::ReclaimIsOnlyPagerBacked());
       stats_ext.vmo_pager_total_bytes = pager_counts.total * PAGE_SIZE;
       stats_ext.vmo_pager_newest_bytes = pager_counts.newest * PAGE_SIZE;
       stats_ext.vmo_pager_oldest_bytes = pager_counts.oldest * PAGE_SIZE;
@@ -775,6 +777,62 @@ zx_status_t sys_object_get_info(zx_handle_t handle, uint32_t topic, user_out_ptr
 
       return single_record_result(_buffer, buffer_size, _actual, _avail, stats_ext);
     }
+    case ZX_INFO_KMEM_STATS_COMPRESSION: {
+      auto status =
+          validate_ranged_resource(handle, ZX_RSRC_KIND_SYSTEM, ZX_RSRC_SYSTEM_INFO_BASE, 1);
+      if (status != ZX_OK)
+        return status;
+
+      zx_info_kmem_stats_compression_t stats = {};
+      if (VmCompression* compression = pmm_page_compression()) {
+        VmCompression::Stats compression_stats = compression->GetStats();
+        stats.uncompressed_storage_bytes = compression_stats.uncompressed_storage_bytes;
+        stats.compressed_storage_bytes = compression_stats.compressed_storage_bytes;
+        stats.total_page_compression_attempts = compression_stats.compression_attempts;
+        stats.failed_page_compression_attempts = compression_stats.failed_compression_attempts;
+        stats.total_page_decompressions = compression_stats.decompressions;
+      }
+      return single_record_result(_buffer, buffer_size, _actual, _avail, stats);
+    }
+    case ZX_INFO_KMEM_STATS_NUMA: {
+      auto status =
+          validate_ranged_resource(handle, ZX_RSRC_KIND_SYSTEM, ZX_RSRC_SYSTEM_INFO_BASE, 1);
+      if (status != ZX_OK)
+        return status;
+
+      const size_t num_domains = pmm_num_numa_domains();
+      const size_t num_space_for = buffer_size / sizeof(zx_info_kmem_stats_numa_t);
+      const size_t num_to_copy = ktl::min(num_domains, num_space_for);
+      user_out_ptr<zx_info_kmem_stats_numa_t> numa_buf =
+          _buffer.reinterpret<zx_info_kmem_stats_numa_t>();
+
+      for (size_t i = 0; i < num_to_copy; i++) {
+        pmm_numa_domain_stats_t domain_stats;
+        status = pmm_get_numa_domain_stats(i, &domain_stats);
+        if (status != ZX_OK)
+          return status;
+
+        zx_info_kmem_stats_numa_t stats = {};
+        stats.domain = static_cast<uint32_t>(i);
+        stats.total_bytes = domain_stats.total_pages * PAGE_SIZE;
+        stats.free_bytes = domain_stats.free_pages * PAGE_SIZE;
+        stats.used_bytes = stats.total_bytes - stats.free_bytes;
+        if (numa_buf.copy_array_to_user(&stats, 1, i) != ZX_OK)
+          return ZX_ERR_INVALID_ARGS;
+      }
+
+      if (_actual) {
+        zx_status_t copy_status = _actual.copy_to_user(num_to_copy);
+        if (copy_status != ZX_OK)
+          return copy_status;
+      }
+      if (_avail) {
+        zx_status_t copy_status = _avail.copy_to_user(num_domains);
+        if (copy_status != ZX_OK)
+          return copy_status;
+      }
+      return ZX_OK;
+    }
     case ZX_INFO_RESOURCE: {
       // grab a reference to the dispatcher
       fbl::RefPtr<ResourceDispatcher> resource;
@@ -1087,6 +1145,29 @@ zx_status_t sys_object_get_property(zx_handle_t handle_value, uint32_t property,
       uint64_t value = vmo->GetContentSize();
       return _value.reinterpret<uint64_t>().copy_to_user(value);
     }
+    case ZX_PROP_VMO_ZERO_PAGE_DEDUP: {
+      if (size < sizeof(uint32_t)) {
+        return ZX_ERR_BUFFER_TOO_SMALL;
+      }
+      auto vmo = DownCastDispatcher<VmObjectDispatcher>(&dispatcher);
+      if (!vmo) {
+        return ZX_ERR_WRONG_TYPE;
+      }
+
+      uint32_t value;
+      switch (vmo->vmo()->GetZeroPageDedupPolicy()) {
+        case VmObject::ZeroPageDedupPolicy::Disabled:
+          value = ZX_VMO_ZERO_PAGE_DEDUP_DISABLED;
+          break;
+        case VmObject::ZeroPageDedupPolicy::Eager:
+          value = ZX_VMO_ZERO_PAGE_DEDUP_EAGER;
+          break;
+        default:
+          value = ZX_VMO_ZERO_PAGE_DEDUP_DEFAULT;
+          break;
+      }
+      return _value.reinterpret<uint32_t>().copy_to_user(value);
+    }
     case ZX_PROP_STREAM_MODE_APPEND: {
       if (size < sizeof(uint8_t)) {
         return ZX_ERR_BUFFER_TOO_SMALL;
@@ -1323,6 +1404,35 @@ zx_status_t sys_object_set_property(zx_handle_t handle_value, uint32_t property,
       }
       return vmo->SetContentSize(value);
     }
+    case ZX_PROP_VMO_ZERO_PAGE_DEDUP: {
+      if (size < sizeof(uint32_t)) {
+        return ZX_ERR_BUFFER_TOO_SMALL;
+      }
+      auto vmo = DownCastDispatcher<VmObjectDispatcher>(&dispatcher);
+      if (!vmo) {
+        return ZX_ERR_WRONG_TYPE;
+      }
+      uint32_t value = 0;
+      zx_status_t status = _value.reinterpret<const uint32_t>().copy_from_user(&value);
+      if (status != ZX_OK) {
+        return status;
+      }
+      VmObject::ZeroPageDedupPolicy policy;
+      switch (value) {
+        case ZX_VMO_ZERO_PAGE_DEDUP_DEFAULT:
+          policy = VmObject::ZeroPageDedupPolicy::Default;
+          break;
+        case ZX_VMO_ZERO_PAGE_DEDUP_DISABLED:
+          policy = VmObject::ZeroPageDedupPolicy::Disabled;
+          break;
+        case ZX_VMO_ZERO_PAGE_DEDUP_EAGER:
+          policy = VmObject::ZeroPageDedupPolicy::Eager;
+          break;
+        default:
+          return ZX_ERR_INVALID_ARGS;
+      }
+      return vmo->vmo()->SetZeroPageDedupPolicy(policy);
+    }
     case ZX_PROP_STREAM_MODE_APPEND: {
       if (size < sizeof(uint8_t)) {
         return ZX_ERR_BUFFER_TOO_SMALL;
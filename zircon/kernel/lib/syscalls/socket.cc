@@ -6,6 +6,7 @@
 
 #include <inttypes.h>
 #include <lib/syscalls/forward.h>
+#include <lib/user_copy/user_iovec.h>
 #include <lib/user_copy/user_ptr.h>
 #include <platform.h>
 #include <stdint.h>
@@ -50,9 +51,12 @@ zx_status_t sys_socket_write(zx_handle_t handle, uint32_t options, user_in_ptr<c
   if ((size > 0u) && !buffer)
     return ZX_ERR_INVALID_ARGS;
 
-  if (options)
+  if (options & ~ZX_SOCKET_USE_IOVEC)
     return ZX_ERR_INVALID_ARGS;
 
+  if ((options & ZX_SOCKET_USE_IOVEC) && size > ZX_SOCKET_MAX_IOVECS)
+    return ZX_ERR_OUT_OF_RANGE;
+
   auto up = ProcessDispatcher::GetCurrent();
 
   fbl::RefPtr<SocketDispatcher> socket;
@@ -62,7 +66,12 @@ zx_status_t sys_socket_write(zx_handle_t handle, uint32_t options, user_in_ptr<c
     return status;
 
   size_t nwritten;
-  status = socket->Write(buffer.reinterpret<const char>(), size, &nwritten);
+  if (options & ZX_SOCKET_USE_IOVEC) {
+    status = socket->WriteVector(
+        make_user_in_iovec(buffer.reinterpret<const zx_iovec_t>(), size), &nwritten);
+  } else {
+    status = socket->Write(buffer.reinterpret<const char>(), size, &nwritten);
+  }
 
   // Caller may ignore results if desired.
   if (status == ZX_OK && actual)
@@ -79,9 +88,12 @@ zx_status_t sys_socket_read(zx_handle_t handle, uint32_t options, user_out_ptr<v
   if (!buffer && size > 0)
     return ZX_ERR_INVALID_ARGS;
 
-  if (options & ~ZX_SOCKET_PEEK)
+  if (options & ~(ZX_SOCKET_PEEK | ZX_SOCKET_USE_IOVEC))
     return ZX_ERR_INVALID_ARGS;
 
+  if ((options & ZX_SOCKET_USE_IOVEC) && size > ZX_SOCKET_MAX_IOVECS)
+    return ZX_ERR_OUT_OF_RANGE;
+
   auto up = ProcessDispatcher::GetCurrent();
 
   fbl::RefPtr<SocketDispatcher> socket;
@@ -95,7 +107,12 @@ zx_status_t sys_socket_read(zx_handle_t handle, uint32_t options, user_out_ptr<v
                                         : SocketDispatcher::ReadType::kConsume;
 
   size_t nread;
-  status = socket->Read(type, buffer.reinterpret<char>(), size, &nread);
+  if (options & ZX_SOCKET_USE_IOVEC) {
+    status = socket->ReadVector(type, make_user_out_iovec(buffer.reinterpret<zx_iovec_t>(), size),
+                                &nread);
+  } else {
+    status = socket->Read(type, buffer.reinterpret<char>(), size, &nread);
+  }
 
   // Caller may ignore results if desired.
   if (status == ZX_OK && actual)
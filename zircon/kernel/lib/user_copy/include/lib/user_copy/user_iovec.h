@@ -30,6 +30,26 @@ class user_iovec {
 
   explicit user_iovec(VecType* vector, size_t count) : vector_(vector), count_(count) {}
 
+  // Returns the number of buffers in the vector.
+  size_t count() const { return count_; }
+
+  // Copies in the |index|th buffer of the vector.
+  zx_status_t GetBuffer(size_t index, PtrType* out_ptr, size_t* out_capacity) const {
+    if (index >= count_) {
+      return ZX_ERR_OUT_OF_RANGE;
+    }
+    user_in_ptr<const zx_iovec_t> user_current =
+        user_in_ptr<const zx_iovec_t>(vector_).element_offset(index);
+    zx_iovec_t current = {};
+    zx_status_t status = user_current.copy_from_user(&current);
+    if (status != ZX_OK) {
+      return status;
+    }
+    *out_ptr = PtrType(static_cast<DataType*>(current.buffer));
+    *out_capacity = current.capacity;
+    return ZX_OK;
+  }
+
   zx_status_t GetTotalCapacity(size_t* out_capacity) const {
     size_t total_capacity = 0;
     zx_status_t status = ForEach([&total_capacity](PtrType ptr, size_t capacity) {
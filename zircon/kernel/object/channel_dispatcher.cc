@@ -13,6 +13,7 @@
 #include <trace.h>
 #include <zircon/errors.h>
 #include <zircon/rights.h>
+#include <zircon/syscalls/channel.h>
 #include <zircon/syscalls/object.h>
 #include <zircon/types.h>
 
@@ -23,6 +24,8 @@
 #include <object/message_packet.h>
 #include <object/process_dispatcher.h>
 #include <object/thread_dispatcher.h>
+#include <object/vm_object_dispatcher.h>
+#include <vm/vm_object_paged.h>
 
 #define LOCAL_TRACE 0
 
@@ -35,6 +38,7 @@ KCOUNTER(channel_packet_depth_unbounded, "channel.depth.unbounded")
 KCOUNTER(channel_full, "channel.full")
 KCOUNTER(dispatcher_channel_create_count, "dispatcher.channel.create")
 KCOUNTER(dispatcher_channel_destroy_count, "dispatcher.channel.destroy")
+KCOUNTER(dispatcher_channel_shared_ring_create_count, "dispatcher.channel.shared_ring.create")
 
 namespace {
 
@@ -88,6 +92,72 @@ zx_status_t ChannelDispatcher::Create(KernelHandle<ChannelDispatcher>* handle0,
   return ZX_OK;
 }
 
+// static
+zx_status_t ChannelDispatcher::CreateWithSharedRing(KernelHandle<ChannelDispatcher>* handle0,
+                                                    KernelHandle<ChannelDispatcher>* handle1,
+                                                    zx_rights_t* rights) {
+  static_assert(sizeof(zx_channel_ring_header_t) <= ZX_CHANNEL_RING_HEADER_SIZE);
+  static_assert(ZX_CHANNEL_RING_HEADER_SIZE % PAGE_SIZE == 0);
+  static_assert((ZX_CHANNEL_RING_DATA_SIZE & (ZX_CHANNEL_RING_DATA_SIZE - 1)) == 0);
+  constexpr uint64_t kRingSize = ZX_CHANNEL_RING_HEADER_SIZE + ZX_CHANNEL_RING_DATA_SIZE;
+
+  KernelHandle<ChannelDispatcher> new_handle0, new_handle1;
+  zx_status_t status = Create(&new_handle0, &new_handle1, rights);
+  if (status != ZX_OK) {
+    return status;
+  }
+
+  // The VMO starts out zero filled, which is an empty ring with no waiting reader.
+  fbl::RefPtr<VmObjectPaged> vmo;
+  status = VmObjectPaged::Create(PMM_ALLOC_FLAG_ANY | PMM_ALLOC_FLAG_CAN_WAIT, 0u, 2 * kRingSize,
+                                 &vmo);
+  if (status != ZX_OK) {
+    return status;
+  }
+  KernelHandle<VmObjectDispatcher> vmo_handle;
+  zx_rights_t vmo_rights;
+  status = VmObjectDispatcher::Create(ktl::move(vmo), 2 * kRingSize,
+                                      VmObjectDispatcher::InitialMutability::kMutable, &vmo_handle,
+                                      &vmo_rights);
+  if (status != ZX_OK) {
+    return status;
+  }
+  fbl::RefPtr<VmObjectDispatcher> vmo_dispatcher = vmo_handle.release();
+
+  // Endpoint 0 writes to the first ring and endpoint 1 to the second. The message for each endpoint
+  // is written by its peer, as that is how it ends up in the endpoint's own queue.
+  KernelHandle<ChannelDispatcher>* endpoints[2] = {&new_handle0, &new_handle1};
+  for (uint32_t i = 0; i < 2; i++) {
+    zx_channel_ring_info_t info = {};
+    info.version = ZX_CHANNEL_RING_VERSION;
+    info.tx_offset = i * kRingSize;
+    info.rx_offset = (1 - i) * kRingSize;
+    info.data_size = ZX_CHANNEL_RING_DATA_SIZE;
+
+    MessagePacketPtr msg;
+    status = MessagePacket::Create(reinterpret_cast<const char*>(&info), sizeof(info), 1, &msg);
+    if (status != ZX_OK) {
+      return status;
+    }
+    HandleOwner handle = Handle::Make(vmo_dispatcher, vmo_rights & kRingVmoRights);
+    if (!handle) {
+      return ZX_ERR_NO_MEMORY;
+    }
+    msg->mutable_handles()[0] = handle.release();
+    msg->set_owns_handles(true);
+
+    status = endpoints[1 - i]->dispatcher()->Write(ZX_KOID_INVALID, ktl::move(msg));
+    if (status != ZX_OK) {
+      return status;
+    }
+  }
+
+  kcounter_add(dispatcher_channel_shared_ring_create_count, 1);
+  *handle0 = ktl::move(new_handle0);
+  *handle1 = ktl::move(new_handle1);
+  return ZX_OK;
+}
+
 ChannelDispatcher::ChannelDispatcher(fbl::RefPtr<PeerHolder<ChannelDispatcher>> holder)
     : PeeredDispatcher(ktl::move(holder), ZX_CHANNEL_WRITABLE) {
   kcounter_add(dispatcher_channel_create_count, 1);
@@ -368,6 +438,13 @@ zx_status_t ChannelDispatcher::ResumeInterruptedCall(MessageWaiter* waiter,
       // do not clear the waiter.
       return status;
     }
+    if (status == ZX_OK) {
+      // (3C) has occurred: the reply was installed and the waiter removed from the list before
+      // the event was signaled, and only this thread touches the waiter from now on. Take the reply
+      // without the channel lock, which the replying thread is likely still holding while it
+      // finishes its write. Reacquiring it here would make us block right after being woken.
+      return waiter->EndWait(reply);
+    }
   }
 
   // (3) see (3A), (3B) above or (3C) below for paths where
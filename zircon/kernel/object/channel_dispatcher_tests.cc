@@ -0,0 +1,94 @@
+// Copyright 2022 The Fuchsia Authors
+//
+// Use of this source code is governed by a MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT
+
+#include <lib/unittest/unittest.h>
+#include <lib/unittest/user_memory.h>
+#include <zircon/syscalls/channel.h>
+
+#include <object/channel_dispatcher.h>
+#include <object/handle.h>
+#include <object/message_packet.h>
+#include <object/vm_object_dispatcher.h>
+
+namespace {
+
+// Each endpoint of a shared ring channel starts with a kernel message describing the rings.
+bool TestSharedRingInitialMessages() {
+  BEGIN_TEST;
+
+  KernelHandle<ChannelDispatcher> handle0, handle1;
+  zx_rights_t rights;
+  ASSERT_EQ(ChannelDispatcher::CreateWithSharedRing(&handle0, &handle1, &rights), ZX_OK);
+
+  ktl::unique_ptr<testing::UserMemory> buffer =
+      testing::UserMemory::Create(sizeof(zx_channel_ring_info_t));
+  ASSERT_NONNULL(buffer);
+
+  zx_channel_ring_info_t infos[2] = {};
+  fbl::RefPtr<Dispatcher> vmos[2];
+  KernelHandle<ChannelDispatcher>* endpoints[2] = {&handle0, &handle1};
+  for (int i = 0; i < 2; i++) {
+    uint32_t msg_size = sizeof(zx_channel_ring_info_t);
+    uint32_t msg_handle_count = 1;
+    MessagePacketPtr msg;
+    ASSERT_EQ(endpoints[i]->dispatcher()->Read(ZX_KOID_INVALID, &msg_size, &msg_handle_count,
+                                               &msg, false),
+              ZX_OK);
+    ASSERT_EQ(msg_size, sizeof(zx_channel_ring_info_t));
+    ASSERT_EQ(msg_handle_count, 1u);
+
+    ASSERT_EQ(msg->CopyDataTo(buffer->user_out<char>()), ZX_OK);
+    infos[i] = buffer->get<zx_channel_ring_info_t>();
+    EXPECT_EQ(infos[i].version, ZX_CHANNEL_RING_VERSION);
+    EXPECT_EQ(infos[i].data_size, ZX_CHANNEL_RING_DATA_SIZE);
+
+    Handle* handle = msg->handles()[0];
+    EXPECT_EQ(handle->dispatcher()->get_type(), ZX_OBJ_TYPE_VMO);
+    EXPECT_EQ(handle->rights() & ~ChannelDispatcher::kRingVmoRights, 0u);
+    vmos[i] = handle->dispatcher();
+
+    // No further messages were queued.
+    msg_size = 0;
+    msg_handle_count = 0;
+    EXPECT_EQ(endpoints[i]->dispatcher()->Read(ZX_KOID_INVALID, &msg_size, &msg_handle_count,
+                                               &msg, false),
+              ZX_ERR_SHOULD_WAIT);
+  }
+
+  // Both endpoints share one VMO, and each one transmits on the ring that the other receives on.
+  EXPECT_EQ(vmos[0].get(), vmos[1].get());
+  EXPECT_NE(infos[0].tx_offset, infos[0].rx_offset);
+  EXPECT_EQ(infos[0].tx_offset, infos[1].rx_offset);
+  EXPECT_EQ(infos[0].rx_offset, infos[1].tx_offset);
+
+  END_TEST;
+}
+
+// The ring wakeup signal can be raised on the peer and cleared locally on any channel.
+bool TestRingSignal() {
+  BEGIN_TEST;
+
+  KernelHandle<ChannelDispatcher> handle0, handle1;
+  zx_rights_t rights;
+  ASSERT_EQ(ChannelDispatcher::Create(&handle0, &handle1, &rights), ZX_OK);
+
+  EXPECT_EQ(handle0.dispatcher()->user_signal_peer(0, ZX_CHANNEL_RING_SIGNALED), ZX_OK);
+  EXPECT_TRUE(handle1.dispatcher()->PollSignals() & ZX_CHANNEL_RING_SIGNALED);
+  EXPECT_FALSE(handle0.dispatcher()->PollSignals() & ZX_CHANNEL_RING_SIGNALED);
+
+  EXPECT_EQ(handle1.dispatcher()->user_signal_self(ZX_CHANNEL_RING_SIGNALED, 0), ZX_OK);
+  EXPECT_FALSE(handle1.dispatcher()->PollSignals() & ZX_CHANNEL_RING_SIGNALED);
+
+  END_TEST;
+}
+
+}  // namespace
+
+UNITTEST_START_TESTCASE(channel_dispatcher_tests)
+UNITTEST("TestSharedRingInitialMessages", TestSharedRingInitialMessages)
+UNITTEST("TestRingSignal", TestRingSignal)
+UNITTEST_END_TESTCASE(channel_dispatcher_tests, "channel_dispatcher_tests",
+                      "ChannelDispatcher tests")
@@ -17,6 +17,7 @@
 
 KCOUNTER(dispatcher_fifo_create_count, "dispatcher.fifo.create")
 KCOUNTER(dispatcher_fifo_destroy_count, "dispatcher.fifo.destroy")
+KCOUNTER(dispatcher_fifo_readable_suppressed_count, "dispatcher.fifo.readable_suppressed")
 
 // static
 zx_status_t FifoDispatcher::Create(size_t count, size_t elemsize, uint32_t options,
@@ -29,6 +30,10 @@ zx_status_t FifoDispatcher::Create(size_t count, size_t elemsize, uint32_t optio
     return ZX_ERR_OUT_OF_RANGE;
   }
 
+  if (options & ~ZX_FIFO_READ_POLLING) {
+    return ZX_ERR_INVALID_ARGS;
+  }
+
   fbl::AllocChecker ac;
   auto holder0 = fbl::AdoptRef(new (&ac) PeerHolder<FifoDispatcher>());
   if (!ac.check())
@@ -64,9 +69,10 @@ zx_status_t FifoDispatcher::Create(size_t count, size_t elemsize, uint32_t optio
   return ZX_OK;
 }
 
-FifoDispatcher::FifoDispatcher(fbl::RefPtr<PeerHolder<FifoDispatcher>> holder, uint32_t /*options*/,
+FifoDispatcher::FifoDispatcher(fbl::RefPtr<PeerHolder<FifoDispatcher>> holder, uint32_t options,
                                uint32_t count, uint32_t elem_size, ktl::unique_ptr<uint8_t[]> data)
     : PeeredDispatcher(ktl::move(holder), ZX_FIFO_WRITABLE),
+      options_(options),
       elem_count_(count),
       elem_size_(elem_size),
       head_(0u),
@@ -173,9 +179,14 @@ ktl::variant<zx_status_t, UserCopyCaptureFaultsResult> FifoDispatcher::WriteSelf
     ptr = ptr.byte_offset(to_copy * elem_size_);
   }
 
-  // if was empty, we've become readable
+  // if was empty, we've become readable, unless our reader is polling and so will read again
+  // without waiting
   if (was_empty) {
-    UpdateStateLocked(0u, ZX_FIFO_READABLE);
+    if (polling_) {
+      kcounter_add(dispatcher_fifo_readable_suppressed_count, 1);
+    } else {
+      UpdateStateLocked(0u, ZX_FIFO_READABLE);
+    }
   }
 
   // if now full, we're no longer writable
@@ -238,6 +249,8 @@ ktl::variant<zx_status_t, UserCopyCaptureFaultsResult> FifoDispatcher::ReadToUse
   size_t avail = (head_ - tail_);
 
   if (avail == 0) {
+    // The reader may wait after this, so the next write must assert ZX_FIFO_READABLE again.
+    polling_ = false;
     return peer() ? ZX_ERR_SHOULD_WAIT : ZX_ERR_PEER_CLOSED;
   }
 
@@ -282,6 +295,10 @@ ktl::variant<zx_status_t, UserCopyCaptureFaultsResult> FifoDispatcher::ReadToUse
     UpdateStateLocked(ZX_FIFO_READABLE, 0u);
   }
 
+  if (options_ & ZX_FIFO_READ_POLLING) {
+    polling_ = true;
+  }
+
   *actual = (tail_ - old_tail);
   return ZX_OK;
 }
@@ -0,0 +1,93 @@
+// Copyright 2022 The Fuchsia Authors
+//
+// Use of this source code is governed by a MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT
+
+#include <lib/unittest/unittest.h>
+#include <lib/unittest/user_memory.h>
+
+#include <object/fifo_dispatcher.h>
+
+namespace {
+
+constexpr size_t kElemSize = sizeof(uint64_t);
+
+bool WriteOne(FifoDispatcher* fifo, testing::UserMemory* mem) {
+  BEGIN_TEST;
+
+  size_t actual = 0;
+  ASSERT_EQ(fifo->WriteFromUser(kElemSize, mem->user_in<uint8_t>(), 1, &actual), ZX_OK);
+  ASSERT_EQ(actual, 1u);
+
+  END_TEST;
+}
+
+bool IsReadable(FifoDispatcher* fifo) { return fifo->PollSignals() & ZX_FIFO_READABLE; }
+
+// Without ZX_FIFO_READ_POLLING, every write to an empty fifo asserts ZX_FIFO_READABLE.
+bool TestReadableWithoutPolling() {
+  BEGIN_TEST;
+
+  ktl::unique_ptr<testing::UserMemory> mem = testing::UserMemory::Create(PAGE_SIZE);
+
+  KernelHandle<FifoDispatcher> handle0, handle1;
+  zx_rights_t rights;
+  ASSERT_EQ(FifoDispatcher::Create(4, kElemSize, 0, &handle0, &handle1, &rights), ZX_OK);
+  FifoDispatcher* writer = handle0.dispatcher().get();
+  FifoDispatcher* reader = handle1.dispatcher().get();
+
+  for (int i = 0; i < 2; i++) {
+    ASSERT_TRUE(WriteOne(writer, mem.get()));
+    EXPECT_TRUE(IsReadable(reader));
+    size_t actual = 0;
+    ASSERT_EQ(reader->ReadToUser(kElemSize, mem->user_out<uint8_t>(), 1, &actual), ZX_OK);
+    EXPECT_FALSE(IsReadable(reader));
+  }
+
+  END_TEST;
+}
+
+// With ZX_FIFO_READ_POLLING, writes do not assert ZX_FIFO_READABLE between a read that returns
+// elements and a read that finds the fifo empty.
+bool TestReadableSuppressedWhilePolling() {
+  BEGIN_TEST;
+
+  ktl::unique_ptr<testing::UserMemory> mem = testing::UserMemory::Create(PAGE_SIZE);
+
+  KernelHandle<FifoDispatcher> handle0, handle1;
+  zx_rights_t rights;
+  ASSERT_EQ(
+      FifoDispatcher::Create(4, kElemSize, ZX_FIFO_READ_POLLING, &handle0, &handle1, &rights),
+      ZX_OK);
+  FifoDispatcher* writer = handle0.dispatcher().get();
+  FifoDispatcher* reader = handle1.dispatcher().get();
+
+  // The reader is not polling until it has read something.
+  ASSERT_TRUE(WriteOne(writer, mem.get()));
+  EXPECT_TRUE(IsReadable(reader));
+  size_t actual = 0;
+  ASSERT_EQ(reader->ReadToUser(kElemSize, mem->user_out<uint8_t>(), 1, &actual), ZX_OK);
+  EXPECT_FALSE(IsReadable(reader));
+
+  // Now it is, and the next write is found by reading again.
+  ASSERT_TRUE(WriteOne(writer, mem.get()));
+  EXPECT_FALSE(IsReadable(reader));
+  ASSERT_EQ(reader->ReadToUser(kElemSize, mem->user_out<uint8_t>(), 1, &actual), ZX_OK);
+  EXPECT_EQ(actual, 1u);
+
+  // Finding the fifo empty ends polling.
+  EXPECT_EQ(reader->ReadToUser(kElemSize, mem->user_out<uint8_t>(), 1, &actual),
+            ZX_ERR_SHOULD_WAIT);
+  ASSERT_TRUE(WriteOne(writer, mem.get()));
+  EXPECT_TRUE(IsReadable(reader));
+
+  END_TEST;
+}
+
+}  // namespace
+
+UNITTEST_START_TESTCASE(fifo_dispatcher_tests)
+UNITTEST("TestReadableWithoutPolling", TestReadableWithoutPolling)
+UNITTEST("TestReadableSuppressedWhilePolling", TestReadableSuppressedWhilePolling)
+UNITTEST_END_TESTCASE(fifo_dispatcher_tests, "fifo_dispatcher_tests", "FifoDispatcher tests")
@@ -73,10 +73,12 @@ GuestDispatcher::GuestDispatcher(uint32_t options, ktl::unique_ptr<Guest> guest)
 GuestDispatcher::~GuestDispatcher() { kcounter_add(dispatcher_guest_destroy_count, 1); }
 
 zx_status_t GuestDispatcher::SetTrap(uint32_t kind, zx_vaddr_t addr, size_t len,
-                                     fbl::RefPtr<PortDispatcher> port, uint64_t key) {
+                                     fbl::RefPtr<PortDispatcher> port,
+                                     fbl::RefPtr<EventDispatcher> event, uint64_t key) {
   canary_.Assert();
   if (options_ == ZX_GUEST_OPT_NORMAL) {
-    return static_cast<NormalGuest*>(guest_.get())->SetTrap(kind, addr, len, ktl::move(port), key);
+    return static_cast<NormalGuest*>(guest_.get())
+        ->SetTrap(kind, addr, len, ktl::move(port), ktl::move(event), key);
   }
   return ZX_ERR_NOT_SUPPORTED;
 }
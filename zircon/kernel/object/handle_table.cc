@@ -115,6 +115,14 @@ void HandleTable::AddHandle(HandleOwner handle) {
   AddHandleLocked(ktl::move(handle));
 }
 
+void HandleTable::AddHandles(ktl::span<HandleOwner> handles) {
+  AutoExpiringPreemptDisabler preempt_disable{ZX_USEC(150)};
+  Guard<BrwLockPi, BrwLockPi::Writer> guard{&lock_};
+  for (HandleOwner& handle : handles) {
+    AddHandleLocked(ktl::move(handle));
+  }
+}
+
 void HandleTable::AddHandleLocked(HandleOwner handle) {
   handle->set_handle_table_id(koid_);
   handles_.push_front(handle.release());
@@ -11,6 +11,7 @@
 #include <ktl/move.h>
 #include <object/dispatcher.h>
 #include <object/event_pair_dispatcher.h>
+#include <object/handle_table.h>
 
 #include "object/handle.h"
 
@@ -243,6 +244,47 @@ bool KernelHandleUpgrade() {
   END_TEST;
 }
 
+bool HandleTableAddHandles() {
+  BEGIN_TEST;
+
+  fbl::AllocChecker ac;
+  fbl::RefPtr<HandleTable> table = fbl::AdoptRef(new (&ac) HandleTable());
+  ASSERT_TRUE(ac.check());
+  HandleTable& handle_table = *table;
+
+  constexpr size_t kNumHandles = 3;
+  KernelHandle<EventPairDispatcher> eventpair[2];
+  zx_rights_t rights;
+  ASSERT_EQ(EventPairDispatcher::Create(&eventpair[0], &eventpair[1], &rights), ZX_OK);
+  fbl::RefPtr<Dispatcher> dispatcher = eventpair[0].release();
+
+  HandleOwner handles[kNumHandles];
+  zx_handle_t values[kNumHandles];
+  for (size_t i = 0; i < kNumHandles; i++) {
+    handles[i] = Handle::Make(dispatcher, rights);
+    ASSERT_TRUE(handles[i]);
+    values[i] = handle_table.MapHandleToValue(handles[i]);
+  }
+  EXPECT_EQ(dispatcher->current_handle_count(), kNumHandles);
+
+  handle_table.AddHandles(ktl::span(handles, kNumHandles));
+  EXPECT_EQ(handle_table.HandleCount(), kNumHandles);
+  for (size_t i = 0; i < kNumHandles; i++) {
+    EXPECT_FALSE(handles[i]);
+    fbl::RefPtr<EventPairDispatcher> found;
+    EXPECT_EQ(handle_table.GetDispatcherWithRightsNoPolicyCheck(values[i], ZX_RIGHT_NONE, &found,
+                                                                nullptr),
+              ZX_OK);
+    EXPECT_EQ(found.get(), dispatcher.get());
+  }
+
+  handle_table.Clean();
+  EXPECT_EQ(handle_table.HandleCount(), 0u);
+  EXPECT_EQ(dispatcher->current_handle_count(), 0u);
+
+  END_TEST;
+}
+
 }  // namespace
 
 UNITTEST_START_TESTCASE(handle_tests)
@@ -257,4 +299,5 @@ UNITTEST("KernelHandleMoveConstructorUpcast", KernelHandleMoveConstructorUpcast)
 UNITTEST("KernelHandleMoveAssignment", KernelHandleMoveAssignment)
 UNITTEST("KernelHandleMoveAssignmentUpcast", KernelHandleMoveAssignmentUpcast)
 UNITTEST("KernelHandleUpgrade", KernelHandleUpgrade)
+UNITTEST("HandleTableAddHandles", HandleTableAddHandles)
 UNITTEST_END_TESTCASE(handle_tests, "handle", "Handle test")
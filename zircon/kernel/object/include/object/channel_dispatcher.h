@@ -21,14 +21,28 @@
 #include <object/handle.h>
 #include <object/message_packet.h>
 
+// ZX_CHANNEL_RING_SIGNALED may be raised by userspace, which uses it to wake the reader of a shared
+// ring. See <zircon/syscalls/channel.h>.
 class ChannelDispatcher final
-    : public PeeredDispatcher<ChannelDispatcher, ZX_DEFAULT_CHANNEL_RIGHTS> {
+    : public PeeredDispatcher<ChannelDispatcher, ZX_DEFAULT_CHANNEL_RIGHTS,
+                              ZX_CHANNEL_RING_SIGNALED> {
  public:
   class MessageWaiter;
 
   static zx_status_t Create(KernelHandle<ChannelDispatcher>* handle0,
                             KernelHandle<ChannelDispatcher>* handle1, zx_rights_t* rights);
 
+  // Creates a channel as |Create| does, along with a VMO holding a ring for each direction. A
+  // message with a zx_channel_ring_info_t and a handle to the VMO with |kRingVmoRights| is queued
+  // on each endpoint.
+  static zx_status_t CreateWithSharedRing(KernelHandle<ChannelDispatcher>* handle0,
+                                          KernelHandle<ChannelDispatcher>* handle1,
+                                          zx_rights_t* rights);
+
+  // The rights of the VMO handles sent by |CreateWithSharedRing|.
+  static constexpr zx_rights_t kRingVmoRights =
+      ZX_RIGHTS_BASIC | ZX_RIGHTS_IO | ZX_RIGHT_MAP | ZX_RIGHT_GET_PROPERTY;
+
   ~ChannelDispatcher() final;
   zx_obj_type_t get_type() const final { return ZX_OBJ_TYPE_CHANNEL; }
 
@@ -58,11 +72,15 @@ class ChannelDispatcher final
   // MessageWaiter's state is guarded by the lock of the
   // owning ChannelDispatcher, and Deliver(), Signal(), Cancel(),
   // and EndWait() methods must only be called under
-  // that lock.
+  // that lock. The exception is EndWait() after a successful Wait(),
+  // as a waiter which has been delivered a message is no longer
+  // reachable from the channel.
   //
   // MessageWaiters are embedded in ThreadDispatchers, and the channel_ pointer
-  // can only be manipulated by their thread (via BeginWait() or EndWait()), and
-  // only transitions to nullptr while holding the ChannelDispatcher's lock.
+  // can only be manipulated by their thread (via BeginWait() or EndWait()). It
+  // transitions to nullptr while holding the ChannelDispatcher's lock, except
+  // in the EndWait() after a successful Wait(), where the waiter has already
+  // been removed from the channel's list and no other thread can observe it.
   //
   // See also: comments in ChannelDispatcher::Call()
   class MessageWaiter : public fbl::DoublyLinkedListable<MessageWaiter*> {
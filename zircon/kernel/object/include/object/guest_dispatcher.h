@@ -10,6 +10,7 @@
 #include <zircon/syscalls/hypervisor.h>
 #include <zircon/types.h>
 
+#include <object/event_dispatcher.h>
 #include <object/handle.h>
 #include <object/port_dispatcher.h>
 
@@ -29,7 +30,7 @@ class GuestDispatcher final : public SoloDispatcher<GuestDispatcher, ZX_DEFAULT_
   Guest& guest() const { return *guest_; }
 
   zx_status_t SetTrap(uint32_t kind, zx_vaddr_t addr, size_t len, fbl::RefPtr<PortDispatcher> port,
-                      uint64_t key);
+                      fbl::RefPtr<EventDispatcher> event, uint64_t key);
 
  private:
   uint32_t options_;
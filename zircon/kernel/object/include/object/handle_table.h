@@ -66,6 +66,9 @@ class HandleTable : public fbl::RefCounted<HandleTable> {
   void AddHandle(HandleOwner handle);
   void AddHandleLocked(HandleOwner handle) TA_REQ(lock_);
 
+  // Adds all of |handles| to this handle table, taking |lock_| once rather than once per handle.
+  void AddHandles(ktl::span<HandleOwner> handles);
+
   // Set of overloads that remove the |handle| or |handle_value| from this
   // handle table and returns ownership to the handle.
   HandleOwner RemoveHandleLocked(Handle* handle) TA_REQ(lock_);
@@ -7,6 +7,8 @@
 #ifndef ZIRCON_KERNEL_OBJECT_INCLUDE_OBJECT_MBUF_H_
 #define ZIRCON_KERNEL_OBJECT_INCLUDE_OBJECT_MBUF_H_
 
+#include <lib/object_cache.h>
+#include <lib/user_copy/user_iovec.h>
 #include <lib/user_copy/user_ptr.h>
 #include <stdint.h>
 #include <zircon/types.h>
@@ -56,6 +58,14 @@ class MBufChain {
   // Same as Read() but leaves the bytes in the chain instead of consuming them.
   zx_status_t Peek(user_out_ptr<char> dst, size_t len, bool datagram, size_t* actual) const;
 
+  // Vectored versions of the above. The data is gathered from, or scattered over, the buffers of
+  // |src| or |dst| in order, and |len| is at most their total capacity. A vectored datagram write
+  // still produces a single datagram, and a vectored datagram read still reads at most one.
+  zx_status_t WriteStream(user_in_iovec_t src, size_t len, size_t* written);
+  zx_status_t WriteDatagram(user_in_iovec_t src, size_t len, size_t* written);
+  zx_status_t Read(user_out_iovec_t dst, size_t len, bool datagram, size_t* actual);
+  zx_status_t Peek(user_out_iovec_t dst, size_t len, bool datagram, size_t* actual) const;
+
   bool is_full() const { return size_ >= kSizeMax; }
   bool is_empty() const { return size_ == 0; }
 
@@ -76,6 +86,13 @@ class MBufChain {
   // testing reasons.
   static size_t mbuf_payload_size() { return MBuf::kPayloadSize; }
 
+  // Init hook that sets up the per-CPU object cache that MBufs are allocated from.
+  static void InitializeCache(uint32_t level);
+
+  // Releases the empty slabs retained by the MBuf object cache, including its reserve. Returns the
+  // number of slabs released.
+  static size_t TrimCache();
+
  private:
   // An MBuf is a small fixed-size chainable memory buffer.
   struct MBuf : public fbl::SinglyLinkedListable<MBuf*> {
@@ -84,9 +101,9 @@ class MBufChain {
 
     // 8 for the linked list and explicit padding and 4 for the explicit uint32_t fields.
     static constexpr size_t kHeaderSize = (8 * 2) + (4 * 2);
-    // 16 is for the malloc header.
-    static constexpr size_t kMallocSize = 2048 - 16;
-    static constexpr size_t kPayloadSize = kMallocSize - kHeaderSize;
+    // Two MBufs fit in each page sized slab of the object cache, after the slab control block.
+    static constexpr size_t kAllocSize = (PAGE_SIZE - object_cache::kSlabControlMaxSize) / 2;
+    static constexpr size_t kPayloadSize = kAllocSize - kHeaderSize;
 
     // Returns number of bytes of free space in this MBuf.
     size_t rem() const { return kPayloadSize - len_; }
@@ -104,10 +121,19 @@ class MBufChain {
     char data_[kPayloadSize] = {0};
     // TODO: maybe union data_ with char* blocks for large messages
   };
-  static_assert(sizeof(MBuf) == MBuf::kMallocSize);
+  static_assert(sizeof(MBuf) == MBuf::kAllocSize);
 
   static constexpr size_t kSizeMax = 128 * MBuf::kPayloadSize;
 
+  // Allocates the slabs of the MBuf object cache, see mbuf.cc.
+  struct SlabAllocator;
+  using MBufCache = object_cache::ObjectCache<MBuf, object_cache::Option::PerCpu, SlabAllocator>;
+  using MBufPtr = object_cache::UniquePtr<MBuf, SlabAllocator>;
+
+  // MBufs are allocated from per-CPU slabs rather than the heap, so that sockets on different CPUs do
+  // not contend with each other when their free lists run dry.
+  static MBufCache cache_;
+
   MBuf* AllocMBuf();
   void FreeMBuf(MBuf* buf);
 
@@ -116,12 +142,19 @@ class MBufChain {
   // The static template function allows us to use the same code for both
   // const and non-const MBufChain objects. Const objects will peek,
   // non-const will read and consume.
-  template <typename T>
-  static zx_status_t ReadHelper(T* chain, user_out_ptr<char> dst, size_t len, bool datagram,
-                                size_t* actual);
+  //
+  // |Dst| and |Src| below are sequential cursors over either a single user buffer or a user iovec,
+  // see mbuf.cc.
+  template <typename T, typename Dst>
+  static zx_status_t ReadHelper(T* chain, Dst& dst, size_t len, bool datagram, size_t* actual);
+
+  template <typename Src>
+  zx_status_t WriteStreamHelper(Src& src, size_t len, size_t* written);
+  template <typename Src>
+  zx_status_t WriteDatagramHelper(Src& src, size_t len, size_t* written);
 
   // Inactive buffers that will be re-used for future writes. This serves as a cache to avoid
-  // bouncing buffers in and out of the heap all the time.
+  // bouncing buffers in and out of the object cache all the time.
   fbl::SinglyLinkedList<MBuf*> freelist_;
   // The active buffers that make up this chain. buffers_.front() + read_cursor_off_ is the read
   // cursor.
@@ -109,6 +109,10 @@ class PagerProxy : public PageProvider,
   // Queue of page_request_t's that have come in while packet_ is busy. The
   // head of this queue is sent to the port when packet_ is freed.
   fbl::TaggedDoublyLinkedList<PageRequest*, PageProviderTag> pending_requests_ TA_GUARDED(mtx_);
+  // Requests taken from pending_requests_ because they continue the range of active_request_, and
+  // so are covered by the same packet_. They go back to pending_requests_ if packet_ is cancelled
+  // before the pager service receives it, and are otherwise dropped once packet_ is freed.
+  fbl::TaggedDoublyLinkedList<PageRequest*, PageProviderTag> merged_requests_ TA_GUARDED(mtx_);
 
   // PageRequest used for the complete message.
   PageRequest complete_request_ TA_GUARDED(mtx_);
@@ -123,6 +127,9 @@ class PagerProxy : public PageProvider,
   // Queues the page request, either sending it to the port or putting it in pending_requests_.
   void QueuePacketLocked(PageRequest* request) TA_REQ(mtx_);
 
+  // Returns true if |request| is in merged_requests_ rather than pending_requests_.
+  bool IsMergedLocked(const PageRequest* request) const TA_REQ(mtx_);
+
   // Called when the packet becomes free. If pending_requests_ is non-empty, queues the
   // next request.
   void OnPacketFreedLocked() TA_REQ(mtx_);
@@ -191,6 +191,11 @@ class PortDispatcher final : public SoloDispatcher<PortDispatcher, ZX_DEFAULT_PO
   zx_status_t QueueUser(const zx_port_packet_t& packet);
   bool QueueInterruptPacket(PortInterruptPacket* port_packet, zx_time_t timestamp);
   zx_status_t Dequeue(const Deadline& deadline, zx_port_packet_t* packet);
+  // Waits as |Dequeue| does, then also takes up to |max_packets| - 1 further packets that are
+  // already queued, without waiting for them. The number of packets written to |packets| is
+  // returned in |actual|.
+  zx_status_t DequeueMany(const Deadline& deadline, zx_port_packet_t* packets, size_t max_packets,
+                          size_t* actual);
   bool RemoveInterruptPacket(PortInterruptPacket* port_packet);
 
   // This method determines the observer's fate. Upon return, one of the following will have
@@ -219,6 +224,10 @@ class PortDispatcher final : public SoloDispatcher<PortDispatcher, ZX_DEFAULT_PO
   // Init hook that sets up the cache allocators used by this dispatcher.
   static void InitializeCacheAllocators(uint32_t level);
 
+  // Releases the empty slabs retained by the cache allocators used by this dispatcher, including
+  // their reserves. Returns the number of slabs released.
+  static size_t TrimCacheAllocators();
+
  private:
   explicit PortDispatcher(uint32_t options);
 
@@ -7,6 +7,7 @@
 #ifndef ZIRCON_KERNEL_OBJECT_INCLUDE_OBJECT_SOCKET_DISPATCHER_H_
 #define ZIRCON_KERNEL_OBJECT_INCLUDE_OBJECT_SOCKET_DISPATCHER_H_
 
+#include <lib/user_copy/user_iovec.h>
 #include <lib/user_copy/user_ptr.h>
 #include <lib/zx/status.h>
 #include <stdint.h>
@@ -51,6 +52,11 @@ class SocketDispatcher final : public PeeredDispatcher<SocketDispatcher, ZX_DEFA
 
   zx_status_t Read(ReadType type, user_out_ptr<char> dst, size_t len, size_t* nread);
 
+  // Vectored versions of Write() and Read() that gather from, or scatter over, the buffers of
+  // |src| or |dst|. On a datagram socket all of the buffers make up a single datagram.
+  zx_status_t WriteVector(user_in_iovec_t src, size_t* written);
+  zx_status_t ReadVector(ReadType type, user_out_iovec_t dst, size_t* nread);
+
   // Property methods.
   size_t GetReadThreshold() const;
   zx_status_t SetReadThreshold(size_t value);
@@ -68,8 +74,14 @@ class SocketDispatcher final : public PeeredDispatcher<SocketDispatcher, ZX_DEFA
 
   SocketDispatcher(fbl::RefPtr<PeerHolderType> holder, zx_signals_t starting_signals,
                    uint32_t flags);
-  zx_status_t WriteSelfLocked(user_in_ptr<const char> src, size_t len, size_t* nwritten,
-                              Guard<CriticalMutex>& guard) TA_REQ(get_lock());
+  // |Src| and |Dst| are either a single user buffer or a user iovec.
+  template <typename Src>
+  zx_status_t WriteHelper(Src src, size_t len, size_t* nwritten);
+  template <typename Dst>
+  zx_status_t ReadHelper(ReadType type, Dst dst, size_t len, size_t* nread);
+  template <typename Src>
+  zx_status_t WriteSelfLocked(Src src, size_t len, size_t* nwritten, Guard<CriticalMutex>& guard)
+      TA_REQ(get_lock());
   void UpdateReadStatus(Disposition disposition_peer) TA_REQ(get_lock());
   [[nodiscard]] bool IsDispositionStateValid(Disposition disposition_peer) const TA_REQ(get_lock());
 
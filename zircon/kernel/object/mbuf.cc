@@ -6,14 +6,16 @@
 
 #include "object/mbuf.h"
 
+#include <lib/boot-options/boot-options.h>
 #include <lib/counters.h>
 #include <lib/fit/defer.h>
 #include <lib/user_copy/user_ptr.h>
 
 #include <fbl/algorithm.h>
-#include <fbl/alloc_checker.h>
 #include <ktl/algorithm.h>
+#include <ktl/move.h>
 #include <ktl/type_traits.h>
+#include <lk/init.h>
 
 #include <ktl/enforce.h>
 
@@ -25,28 +27,163 @@ KCOUNTER(mbuf_total_bytes_count, "mbuf.total_bytes")
 // Amount of memory occupied by MBuf objects on free lists.
 KCOUNTER(mbuf_free_list_bytes_count, "mbuf.free_list_bytes")
 
+// Number of slabs currently held by the MBuf object cache, whether in use or retained.
+KCOUNTER(mbuf_cache_slabs_count, "mbuf.cache.slabs")
+
+// Number of MBuf object cache slabs released under memory pressure.
+KCOUNTER(mbuf_cache_slabs_trimmed_count, "mbuf.cache.slabs_trimmed")
+
+namespace {
+
+// Copies sequentially to or from a single user buffer.
+template <typename Ptr>
+class BufferCursor {
+ public:
+  explicit BufferCursor(Ptr ptr) : ptr_(ptr) {}
+
+  zx_status_t CopyToUser(const char* src, size_t len) {
+    zx_status_t status = ptr_.byte_offset(pos_).copy_array_to_user(src, len);
+    pos_ += len;
+    return status;
+  }
+
+  zx_status_t CopyFromUser(char* dst, size_t len) {
+    zx_status_t status = ptr_.byte_offset(pos_).copy_array_from_user(dst, len);
+    pos_ += len;
+    return status;
+  }
+
+ private:
+  Ptr ptr_;
+  size_t pos_ = 0;
+};
+
+// Copies sequentially to or from the buffers of a user iovec, reading each entry of the vector
+// from user memory only once it is reached.
+template <typename Iovec>
+class IovecCursor {
+ public:
+  explicit IovecCursor(const Iovec& iovec) : iovec_(iovec) {}
+
+  zx_status_t CopyToUser(const char* src, size_t len) {
+    return Copy(len, [&src](typename Iovec::PtrType ptr, size_t copy_len) {
+      zx_status_t status = ptr.copy_array_to_user(src, copy_len);
+      src += copy_len;
+      return status;
+    });
+  }
+
+  zx_status_t CopyFromUser(char* dst, size_t len) {
+    return Copy(len, [&dst](typename Iovec::PtrType ptr, size_t copy_len) {
+      zx_status_t status = ptr.copy_array_from_user(dst, copy_len);
+      dst += copy_len;
+      return status;
+    });
+  }
+
+ private:
+  template <typename Fn>
+  zx_status_t Copy(size_t len, Fn copy) {
+    while (len > 0) {
+      while (offset_ == capacity_) {
+        // The vector may have been changed by another thread since its capacity was computed, in
+        // which case it can run out before |len| does.
+        if (index_ == iovec_.count()) {
+          return ZX_ERR_INVALID_ARGS;
+        }
+        zx_status_t status = iovec_.GetBuffer(index_++, &ptr_, &capacity_);
+        if (status != ZX_OK) {
+          return status;
+        }
+        offset_ = 0;
+      }
+      size_t copy_len = ktl::min(len, capacity_ - offset_);
+      zx_status_t status = copy(ptr_.byte_offset(offset_), copy_len);
+      if (status != ZX_OK) {
+        return status;
+      }
+      offset_ += copy_len;
+      len -= copy_len;
+    }
+    return ZX_OK;
+  }
+
+  const Iovec iovec_;
+  typename Iovec::PtrType ptr_{nullptr};
+  size_t index_ = 0;
+  size_t offset_ = 0;
+  size_t capacity_ = 0;
+};
+
+}  // namespace
+
+// Allocates page sized slabs from the PMM like the default allocator, additionally tracking the
+// occupancy of the MBuf object cache.
+struct MBufChain::SlabAllocator : public object_cache::DefaultAllocator {
+  static void CountSlabAllocation() {
+    DefaultAllocator::CountSlabAllocation();
+    kcounter_add(mbuf_cache_slabs_count, 1);
+  }
+  static void CountSlabFree() {
+    DefaultAllocator::CountSlabFree();
+    kcounter_add(mbuf_cache_slabs_count, -1);
+  }
+};
+
+MBufChain::MBufCache MBufChain::cache_;
+
+void MBufChain::InitializeCache(uint32_t /*level*/) {
+  static_assert(object_cache::ObjectCache<MBuf, object_cache::Option::Single,
+                                          SlabAllocator>::objects_per_slab() >= 2);
+
+  zx::status result = MBufCache::Create(gBootOptions->mbuf_reserve_pages);
+  ASSERT(result.is_ok());
+  cache_ = ktl::move(*result);
+}
+
+size_t MBufChain::TrimCache() {
+  const size_t count = cache_.Trim();
+  kcounter_add(mbuf_cache_slabs_trimmed_count, static_cast<int64_t>(count));
+  return count;
+}
+
+// Initialize the cache after the percpu data structures are initialized.
+LK_INIT_HOOK(mbuf_cache_init, MBufChain::InitializeCache, LK_INIT_LEVEL_KERNEL + 1)
+
 MBufChain::~MBufChain() {
   while (!buffers_.is_empty()) {
-    delete buffers_.pop_front();
+    MBufPtr destroyer{buffers_.pop_front()};
   }
   while (!freelist_.is_empty()) {
     kcounter_add(mbuf_free_list_bytes_count, -static_cast<int64_t>(sizeof(MBufChain::MBuf)));
-    delete freelist_.pop_front();
+    MBufPtr destroyer{freelist_.pop_front()};
   }
 }
 
 zx_status_t MBufChain::Read(user_out_ptr<char> dst, size_t len, bool datagram, size_t* actual) {
-  return ReadHelper(this, dst, len, datagram, actual);
+  BufferCursor cursor(dst);
+  return ReadHelper(this, cursor, len, datagram, actual);
 }
 
 zx_status_t MBufChain::Peek(user_out_ptr<char> dst, size_t len, bool datagram,
                             size_t* actual) const {
-  return ReadHelper(this, dst, len, datagram, actual);
+  BufferCursor cursor(dst);
+  return ReadHelper(this, cursor, len, datagram, actual);
+}
+
+zx_status_t MBufChain::Read(user_out_iovec_t dst, size_t len, bool datagram, size_t* actual) {
+  IovecCursor cursor(dst);
+  return ReadHelper(this, cursor, len, datagram, actual);
+}
+
+zx_status_t MBufChain::Peek(user_out_iovec_t dst, size_t len, bool datagram,
+                            size_t* actual) const {
+  IovecCursor cursor(dst);
+  return ReadHelper(this, cursor, len, datagram, actual);
 }
 
-template <class T>
-zx_status_t MBufChain::ReadHelper(T* chain, user_out_ptr<char> dst, size_t len, bool datagram,
-                                  size_t* actual) {
+template <class T, class Dst>
+zx_status_t MBufChain::ReadHelper(T* chain, Dst& dst, size_t len, bool datagram, size_t* actual) {
   if (chain->size_ == 0) {
     *actual = 0;
     return ZX_OK;
@@ -68,7 +205,7 @@ zx_status_t MBufChain::ReadHelper(T* chain, user_out_ptr<char> dst, size_t len,
   while (pos < len && iter != chain->buffers_.end()) {
     const char* src = iter->data_ + read_off;
     size_t copy_len = ktl::min(static_cast<size_t>(iter->len_ - read_off), len - pos);
-    zx_status_t status = dst.byte_offset(pos).copy_array_to_user(src, copy_len);
+    zx_status_t status = dst.CopyToUser(src, copy_len);
     if (status != ZX_OK) {
       // Record the fact that some data might have been read, even if the overall operation is
       // considered a failure.
@@ -126,6 +263,17 @@ zx_status_t MBufChain::ReadHelper(T* chain, user_out_ptr<char> dst, size_t len,
 }
 
 zx_status_t MBufChain::WriteDatagram(user_in_ptr<const char> src, size_t len, size_t* written) {
+  BufferCursor cursor(src);
+  return WriteDatagramHelper(cursor, len, written);
+}
+
+zx_status_t MBufChain::WriteDatagram(user_in_iovec_t src, size_t len, size_t* written) {
+  IovecCursor cursor(src);
+  return WriteDatagramHelper(cursor, len, written);
+}
+
+template <class Src>
+zx_status_t MBufChain::WriteDatagramHelper(Src& src, size_t len, size_t* written) {
   if (len == 0) {
     *written = 0;
     return ZX_ERR_INVALID_ARGS;
@@ -155,7 +303,7 @@ zx_status_t MBufChain::WriteDatagram(user_in_ptr<const char> src, size_t len, si
   size_t pos = 0;
   for (auto& buf : bufs) {
     size_t copy_len = ktl::min(MBuf::kPayloadSize, len - pos);
-    if (src.byte_offset(pos).copy_array_from_user(buf.data_, copy_len) != ZX_OK) {
+    if (src.CopyFromUser(buf.data_, copy_len) != ZX_OK) {
       while (!bufs.is_empty()) {
         FreeMBuf(bufs.pop_front());
       }
@@ -186,6 +334,17 @@ zx_status_t MBufChain::WriteDatagram(user_in_ptr<const char> src, size_t len, si
 }
 
 zx_status_t MBufChain::WriteStream(user_in_ptr<const char> src, size_t len, size_t* written) {
+  BufferCursor cursor(src);
+  return WriteStreamHelper(cursor, len, written);
+}
+
+zx_status_t MBufChain::WriteStream(user_in_iovec_t src, size_t len, size_t* written) {
+  IovecCursor cursor(src);
+  return WriteStreamHelper(cursor, len, written);
+}
+
+template <class Src>
+zx_status_t MBufChain::WriteStreamHelper(Src& src, size_t len, size_t* written) {
   if (write_cursor_ == nullptr) {
     DEBUG_ASSERT(buffers_.is_empty());
     write_cursor_ = AllocMBuf();
@@ -212,7 +371,7 @@ zx_status_t MBufChain::WriteStream(user_in_ptr<const char> src, size_t len, size
       if (copy_len == 0)
         break;
     }
-    zx_status_t status = src.byte_offset(pos).copy_array_from_user(dst, copy_len);
+    zx_status_t status = src.CopyFromUser(dst, copy_len);
     if (status != ZX_OK) {
       // TODO(fxbug.dev/34143): Note that although we set |written| for the benefit of the
       // socket dispatcher updating signals, ultimately we're not indicating to the caller
@@ -240,9 +399,8 @@ zx_status_t MBufChain::WriteStream(user_in_ptr<const char> src, size_t len, size
 
 MBufChain::MBuf* MBufChain::AllocMBuf() {
   if (freelist_.is_empty()) {
-    fbl::AllocChecker ac;
-    MBuf* buf = new (&ac) MBuf();
-    return (!ac.check()) ? nullptr : buf;
+    zx::status<MBufPtr> result = cache_.Allocate();
+    return result.is_ok() ? result->release() : nullptr;
   }
   kcounter_add(mbuf_free_list_bytes_count, -static_cast<int64_t>(sizeof(MBufChain::MBuf)));
   return freelist_.pop_front();
@@ -595,6 +595,29 @@ static bool datagram_peek_underflow() {
   END_TEST;
 }
 
+// Trimming the MBuf cache releases only empty slabs, so it must not disturb live chains, and later
+// writes must be able to allocate again.
+static bool trim_cache() {
+  BEGIN_TEST;
+
+  MBufChain chain;
+  ASSERT_TRUE(WriteHelper(&chain, "abc", MessageType::kStream));
+
+  MBufChain::TrimCache();
+  EXPECT_TRUE(Equal(ReadHelper(&chain, 3, MessageType::kStream, ReadType::kPeek), "abc"));
+
+  {
+    MBufChain other;
+    ASSERT_TRUE(WriteHelper(&other, "xyz", MessageType::kStream));
+  }
+  MBufChain::TrimCache();
+
+  ASSERT_TRUE(WriteHelper(&chain, "123", MessageType::kStream));
+  EXPECT_TRUE(Equal(ReadHelper(&chain, 6, MessageType::kStream, ReadType::kRead), "abc123"));
+
+  END_TEST;
+}
+
 }  // namespace
 
 UNITTEST_START_TESTCASE(mbuf_tests)
@@ -620,4 +643,5 @@ UNITTEST("datagram_peek", datagram_peek)
 UNITTEST("datagram_peek_empty", datagram_peek_empty)
 UNITTEST("datagram_peek_zero", datagram_peek_zero)
 UNITTEST("datagram_peek_underflow", datagram_peek_underflow)
+UNITTEST("trim_cache", trim_cache)
 UNITTEST_END_TESTCASE(mbuf_tests, "mbuf", "MBuf test")
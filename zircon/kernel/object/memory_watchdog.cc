@@ -9,7 +9,9 @@
 #include <lib/zircon-internal/macros.h>
 
 #include <object/executor.h>
+#include <object/mbuf.h>
 #include <object/memory_watchdog.h>
+#include <object/port_dispatcher.h>
 #include <platform/halt_helper.h>
 #include <platform/halt_token.h>
 #include <vm/scanner.h>
@@ -33,6 +35,13 @@ const char* PressureLevelToString(MemoryWatchdog::PressureLevel level) {
   }
 }
 
+// Returns the empty slabs retained by the object caches of frequently allocated kernel objects to
+// the PMM. The caches rebuild their reserves on demand once allocations resume.
+void ReclaimObjectCaches() {
+  const size_t slabs = MBufChain::TrimCache() + PortDispatcher::TrimCacheAllocators();
+  printf("memory-pressure: released %zu object cache slabs\n", slabs);
+}
+
 void HandleOnOomReboot() {
   // Notify the pmm that although we are out of memory, we would like to never wait for memory.
   // This ensures that if userspace needs to allocate to do a graceful shutdown it is able to.
@@ -284,6 +293,10 @@ void MemoryWatchdog::WorkerThread() {
         pmm_evictor()->DisableContinuousEviction();
       }
 
+      if (idx <= PressureLevel::kCritical) {
+        ReclaimObjectCaches();
+      }
+
       // Unsignal the last event that was signaled.
       zx_status_t status =
           mem_pressure_events_[prev_mem_event_idx_]->user_signal_self(ZX_EVENT_SIGNALED, 0);
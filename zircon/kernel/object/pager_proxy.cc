@@ -87,6 +87,21 @@ void PagerProxy::QueuePacketLocked(PageRequest* request) {
     uint64_t unused;
     DEBUG_ASSERT(!add_overflow(offset, length, &unused));
 
+    // Extend the packet over any pending requests of the same type that continue its range, so
+    // that a pager service can answer a run of faults, such as a sequential page-in, with a single
+    // supply. A single pass in arrival order is enough to catch requests that come in ascending
+    // order.
+    DEBUG_ASSERT(merged_requests_.is_empty());
+    for (auto iter = pending_requests_.begin(); iter != pending_requests_.end();) {
+      auto cur = iter++;
+      if (&*cur != &complete_request_ && GetRequestType(&*cur) == GetRequestType(request) &&
+          GetRequestOffset(&*cur) == offset + length) {
+        length += GetRequestLen(&*cur);
+        DEBUG_ASSERT(!add_overflow(offset, length, &unused));
+        merged_requests_.push_back(pending_requests_.erase(cur));
+      }
+    }
+
     // Trace flow events require an enclosing duration.
     VM_KTRACE_DURATION(1, "page_request_queue", offset, length);
     VM_KTRACE_FLOW_BEGIN(1, "page_request_queue", reinterpret_cast<uintptr_t>(&packet_));
@@ -129,10 +144,16 @@ void PagerProxy::ClearAsyncRequest(PageRequest* request) {
     // Condition on whether or not we actually cancel the packet, to make sure
     // we don't race with a call to PagerProxy::Free.
     if (port_->CancelQueued(&packet_)) {
+      // The pager service never saw the packet, so the requests merged into it still need one.
+      pending_requests_.splice(pending_requests_.begin(), merged_requests_);
       OnPacketFreedLocked();
     }
   } else if (fbl::InContainer<PageProviderTag>(*request)) {
-    pending_requests_.erase(*request);
+    if (IsMergedLocked(request)) {
+      merged_requests_.erase(*request);
+    } else {
+      pending_requests_.erase(*request);
+    }
   }
 }
 
@@ -141,8 +162,9 @@ void PagerProxy::SwapAsyncRequest(PageRequest* old, PageRequest* new_req) {
   ASSERT(!page_source_closed_);
 
   if (fbl::InContainer<PageProviderTag>(*old)) {
-    pending_requests_.insert(*old, new_req);
-    pending_requests_.erase(*old);
+    auto& list = IsMergedLocked(old) ? merged_requests_ : pending_requests_;
+    list.insert(*old, new_req);
+    list.erase(*old);
   } else if (old == active_request_) {
     active_request_ = new_req;
   }
@@ -269,11 +291,25 @@ void PagerProxy::Free(PortPacket* packet) {
   }
 }
 
+bool PagerProxy::IsMergedLocked(const PageRequest* request) const {
+  for (const auto& merged : merged_requests_) {
+    if (&merged == request) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void PagerProxy::OnPacketFreedLocked() {
   // We are here because the active request has been freed. And packet_busy_ is still true, so no
   // new request will have become active yet.
   DEBUG_ASSERT(active_request_ == nullptr);
   packet_busy_ = false;
+  // Any requests still merged into the packet were delivered with it. They remain outstanding with
+  // the PageSource until the pager service resolves them, but no longer need a packet.
+  while (!merged_requests_.is_empty()) {
+    merged_requests_.pop_front();
+  }
   if (!pending_requests_.is_empty()) {
     QueuePacketLocked(pending_requests_.pop_front());
   }
@@ -378,6 +414,15 @@ void PagerProxy::Dump(uint depth) {
     printf("  no active request on pager port\n");
   }
 
+  for (auto& req : merged_requests_) {
+    for (uint i = 0; i < depth; ++i) {
+      printf("  ");
+    }
+    printf("  merged %s req on pager port [0x%lx, 0x%lx)\n",
+           PageRequestTypeToString(GetRequestType(&req)), GetRequestOffset(&req),
+           GetRequestOffset(&req) + GetRequestLen(&req));
+  }
+
   if (pending_requests_.is_empty()) {
     for (uint i = 0; i < depth; ++i) {
       printf("  ");
@@ -311,8 +311,16 @@ zx_status_t PortDispatcher::Queue(PortPacket* port_packet, zx_signals_t observed
 }
 
 zx_status_t PortDispatcher::Dequeue(const Deadline& deadline, zx_port_packet_t* out_packet) {
+  size_t actual;
+  return DequeueMany(deadline, out_packet, 1, &actual);
+}
+
+zx_status_t PortDispatcher::DequeueMany(const Deadline& deadline, zx_port_packet_t* out_packets,
+                                        size_t max_packets, size_t* actual) {
   canary_.Assert();
+  DEBUG_ASSERT(max_packets > 0);
 
+  size_t count = 0;
   while (true) {
     // Wait until one of the queues has a packet.
     {
@@ -321,46 +329,64 @@ zx_status_t PortDispatcher::Dequeue(const Deadline& deadline, zx_port_packet_t*
       if (st != ZX_OK)
         return st;
     }
+    // Claim any other packets that are already queued, up to |max_packets|. Every claimed count
+    // was posted after its packet was queued, so a count that finds both queues empty belonged to a
+    // packet that has since been removed and can be dropped, as with a spurious wakeup.
+    const size_t claimed = 1 + sema_.TryWaitUpTo(max_packets - 1);
 
     // Interrupt packets are higher priority so service the interrupt packet queue first.
     if (options_ == ZX_PORT_BIND_TO_INTERRUPT) {
       Guard<SpinLock, IrqSave> guard{&spinlock_};
-      PortInterruptPacket* port_interrupt_packet = interrupt_packets_.pop_front();
-      if (port_interrupt_packet != nullptr) {
+      while (count < claimed) {
+        PortInterruptPacket* port_interrupt_packet = interrupt_packets_.pop_front();
+        if (port_interrupt_packet == nullptr) {
+          break;
+        }
+        zx_port_packet_t* out_packet = &out_packets[count++];
         *out_packet = {};
         out_packet->key = port_interrupt_packet->key;
         out_packet->type = ZX_PKT_TYPE_INTERRUPT;
         out_packet->status = ZX_OK;
         out_packet->interrupt.timestamp = port_interrupt_packet->timestamp;
-        break;
       }
     }
 
-    // No interrupt packets queued. Check the regular packets.
-    {
-      Guard<CriticalMutex> guard{get_lock()};
-      PortPacket* port_packet = packets_.pop_front();
-      if (port_packet != nullptr) {
-        if (IsDefaultAllocatedEphemeral(*port_packet)) {
-          --num_ephemeral_packets_;
-        }
-        *out_packet = port_packet->packet;
-
-        bool is_ephemeral = port_packet->is_ephemeral();
-        // The reference to the port that the observer holds cannot be the last one
-        // because another reference was used to call Dequeue, so we don't need to
-        // worry about destroying ourselves.
-        port_packet->observer.reset();
-        guard.Release();
-
-        // If the packet is ephemeral, free it outside of the lock. We need to read
-        // is_ephemeral inside the lock because it's possible for a non-ephemeral packet
-        // to get deleted after a call to |MaybeReap| as soon as we release the lock.
-        if (is_ephemeral) {
-          port_packet->Free();
+    // Take the rest from the regular packets.
+    if (count < claimed) {
+      fbl::DoublyLinkedList<PortPacket*> ephemeral_packets;
+      {
+        Guard<CriticalMutex> guard{get_lock()};
+        while (count < claimed) {
+          PortPacket* port_packet = packets_.pop_front();
+          if (port_packet == nullptr) {
+            break;
+          }
+          if (IsDefaultAllocatedEphemeral(*port_packet)) {
+            --num_ephemeral_packets_;
+          }
+          out_packets[count++] = port_packet->packet;
+
+          // The reference to the port that the observer holds cannot be the last one
+          // because another reference was used to call Dequeue, so we don't need to
+          // worry about destroying ourselves.
+          port_packet->observer.reset();
+
+          // We need to read is_ephemeral inside the lock because it's possible for a non-ephemeral
+          // packet to get deleted after a call to |MaybeReap| as soon as we release the lock.
+          if (port_packet->is_ephemeral()) {
+            ephemeral_packets.push_back(port_packet);
+          }
         }
-        break;
       }
+
+      // Free the ephemeral packets outside of the lock.
+      while (PortPacket* port_packet = ephemeral_packets.pop_front()) {
+        port_packet->Free();
+      }
+    }
+
+    if (count > 0) {
+      break;
     }
 
     // Both queues were empty. The packet must have been removed before we were able to
@@ -368,7 +394,8 @@ zx_status_t PortDispatcher::Dequeue(const Deadline& deadline, zx_port_packet_t*
     kcounter_add(port_dequeue_spurious_count, 1);
   }
 
-  kcounter_add(port_dequeue_count, 1);
+  kcounter_add(port_dequeue_count, static_cast<int64_t>(count));
+  *actual = count;
   return ZX_OK;
 }
 
@@ -523,6 +550,10 @@ void PortDispatcher::InitializeCacheAllocators(uint32_t /*level*/) {
   packet_allocator = ktl::move(*packet_result);
 }
 
+size_t PortDispatcher::TrimCacheAllocators() {
+  return observer_allocator.Trim() + packet_allocator.Trim();
+}
+
 // Initialize the cache after the percpu data structures are initialized.
 LK_INIT_HOOK(port_observer_cache_init, PortDispatcher::InitializeCacheAllocators,
              LK_INIT_LEVEL_KERNEL + 1)
@@ -0,0 +1,94 @@
+// Copyright 2022 The Fuchsia Authors
+//
+// Use of this source code is governed by a MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT
+
+#include <lib/unittest/unittest.h>
+#include <zircon/syscalls/port.h>
+
+#include <ktl/iterator.h>
+#include <object/port_dispatcher.h>
+
+namespace {
+
+bool QueueUserPackets(PortDispatcher* port, uint64_t first_key, size_t count) {
+  BEGIN_TEST;
+
+  for (size_t i = 0; i < count; i++) {
+    zx_port_packet_t packet = {};
+    packet.key = first_key + i;
+    packet.type = ZX_PKT_TYPE_USER;
+    ASSERT_EQ(port->QueueUser(packet), ZX_OK);
+  }
+
+  END_TEST;
+}
+
+// DequeueMany returns the packets that are already queued, in order, up to the limit.
+bool TestDequeueMany() {
+  BEGIN_TEST;
+
+  KernelHandle<PortDispatcher> handle;
+  zx_rights_t rights;
+  ASSERT_EQ(PortDispatcher::Create(0, &handle, &rights), ZX_OK);
+  PortDispatcher* port = handle.dispatcher().get();
+
+  ASSERT_TRUE(QueueUserPackets(port, 0, 5));
+
+  zx_port_packet_t packets[8];
+  size_t actual = 0;
+  ASSERT_EQ(port->DequeueMany(Deadline::infinite(), packets, 3, &actual), ZX_OK);
+  ASSERT_EQ(actual, 3u);
+  for (size_t i = 0; i < actual; i++) {
+    EXPECT_EQ(packets[i].key, i);
+    EXPECT_EQ(packets[i].type, static_cast<uint32_t>(ZX_PKT_TYPE_USER));
+  }
+
+  ASSERT_EQ(port->DequeueMany(Deadline::infinite(), packets, ktl::size(packets), &actual), ZX_OK);
+  ASSERT_EQ(actual, 2u);
+  EXPECT_EQ(packets[0].key, 3u);
+  EXPECT_EQ(packets[1].key, 4u);
+
+  EXPECT_EQ(port->DequeueMany(Deadline::infinite_past(), packets, ktl::size(packets), &actual),
+            ZX_ERR_TIMED_OUT);
+
+  END_TEST;
+}
+
+// Dequeue and DequeueMany can be mixed on the same port.
+bool TestDequeueAndDequeueMany() {
+  BEGIN_TEST;
+
+  KernelHandle<PortDispatcher> handle;
+  zx_rights_t rights;
+  ASSERT_EQ(PortDispatcher::Create(0, &handle, &rights), ZX_OK);
+  PortDispatcher* port = handle.dispatcher().get();
+
+  ASSERT_TRUE(QueueUserPackets(port, 0, 4));
+
+  zx_port_packet_t packet;
+  ASSERT_EQ(port->Dequeue(Deadline::infinite(), &packet), ZX_OK);
+  EXPECT_EQ(packet.key, 0u);
+
+  zx_port_packet_t packets[2];
+  size_t actual = 0;
+  ASSERT_EQ(port->DequeueMany(Deadline::infinite(), packets, ktl::size(packets), &actual), ZX_OK);
+  ASSERT_EQ(actual, 2u);
+  EXPECT_EQ(packets[0].key, 1u);
+  EXPECT_EQ(packets[1].key, 2u);
+
+  ASSERT_EQ(port->Dequeue(Deadline::infinite(), &packet), ZX_OK);
+  EXPECT_EQ(packet.key, 3u);
+
+  EXPECT_EQ(port->Dequeue(Deadline::infinite_past(), &packet), ZX_ERR_TIMED_OUT);
+
+  END_TEST;
+}
+
+}  // namespace
+
+UNITTEST_START_TESTCASE(port_dispatcher_tests)
+UNITTEST("TestDequeueMany", TestDequeueMany)
+UNITTEST("TestDequeueAndDequeueMany", TestDequeueAndDequeueMany)
+UNITTEST_END_TESTCASE(port_dispatcher_tests, "port_dispatcher_tests", "PortDispatcher tests")
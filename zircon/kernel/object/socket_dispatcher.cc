@@ -182,6 +182,20 @@ zx_status_t SocketDispatcher::SetDisposition(Disposition disposition,
 }
 
 zx_status_t SocketDispatcher::Write(user_in_ptr<const char> src, size_t len, size_t* nwritten) {
+  return WriteHelper(src, len, nwritten);
+}
+
+zx_status_t SocketDispatcher::WriteVector(user_in_iovec_t src, size_t* nwritten) {
+  size_t len;
+  zx_status_t status = src.GetTotalCapacity(&len);
+  if (status != ZX_OK) {
+    return status;
+  }
+  return WriteHelper(src, len, nwritten);
+}
+
+template <typename Src>
+zx_status_t SocketDispatcher::WriteHelper(Src src, size_t len, size_t* nwritten) {
   canary_.Assert();
 
   LTRACE_ENTRY;
@@ -205,8 +219,9 @@ zx_status_t SocketDispatcher::Write(user_in_ptr<const char> src, size_t len, siz
   return peer()->WriteSelfLocked(src, len, nwritten, guard);
 }
 
-zx_status_t SocketDispatcher::WriteSelfLocked(user_in_ptr<const char> src, size_t len,
-                                              size_t* written, Guard<CriticalMutex>& guard) {
+template <typename Src>
+zx_status_t SocketDispatcher::WriteSelfLocked(Src src, size_t len, size_t* written,
+                                              Guard<CriticalMutex>& guard) {
   canary_.Assert();
 
   if (is_full())
@@ -269,6 +284,20 @@ zx_status_t SocketDispatcher::WriteSelfLocked(user_in_ptr<const char> src, size_
 
 zx_status_t SocketDispatcher::Read(ReadType type, user_out_ptr<char> dst, size_t len,
                                    size_t* nread) {
+  return ReadHelper(type, dst, len, nread);
+}
+
+zx_status_t SocketDispatcher::ReadVector(ReadType type, user_out_iovec_t dst, size_t* nread) {
+  size_t len;
+  zx_status_t status = dst.GetTotalCapacity(&len);
+  if (status != ZX_OK) {
+    return status;
+  }
+  return ReadHelper(type, dst, len, nread);
+}
+
+template <typename Dst>
+zx_status_t SocketDispatcher::ReadHelper(ReadType type, Dst dst, size_t len, size_t* nread) {
   canary_.Assert();
 
   LTRACE_ENTRY;
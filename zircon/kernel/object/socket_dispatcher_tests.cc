@@ -6,8 +6,10 @@
 
 #include <lib/unittest/unittest.h>
 #include <lib/unittest/user_memory.h>
+#include <lib/user_copy/user_iovec.h>
 #include <lib/user_copy/user_ptr.h>
 
+#include <ktl/iterator.h>
 #include <object/socket_dispatcher.h>
 
 namespace {
@@ -96,6 +98,79 @@ bool TestCreateWriteReadClose() {
   END_TEST;
 }
 
+// Vectored writes and reads of a datagram socket preserve the datagram boundaries, regardless of
+// how the datagrams are split across buffers.
+bool TestWriteReadVectorDatagram() {
+  BEGIN_TEST;
+
+  static constexpr size_t kWriteVecOffset = 0;
+  static constexpr size_t kReadVecOffset = 256;
+  static constexpr size_t kWriteDataOffset = PAGE_SIZE;
+  static constexpr size_t kReadDataOffset = 3 * PAGE_SIZE;
+  static constexpr size_t kWriteSizes[] = {1000, 3000, 5};
+  static constexpr size_t kReadSizes[] = {7, PAGE_SIZE + 1};
+  static constexpr size_t kDatagramSize = 1000 + 3000 + 5;
+  ktl::unique_ptr<testing::UserMemory> mem = testing::UserMemory::Create(5 * PAGE_SIZE);
+
+  size_t offset = kWriteDataOffset;
+  for (size_t i = 0; i < ktl::size(kWriteSizes); i++) {
+    mem->put<zx_iovec_t>({reinterpret_cast<void*>(mem->base() + offset), kWriteSizes[i]},
+                         kWriteVecOffset / sizeof(zx_iovec_t) + i);
+    offset += kWriteSizes[i];
+  }
+  offset = kReadDataOffset;
+  for (size_t i = 0; i < ktl::size(kReadSizes); i++) {
+    mem->put<zx_iovec_t>({reinterpret_cast<void*>(mem->base() + offset), kReadSizes[i]},
+                         kReadVecOffset / sizeof(zx_iovec_t) + i);
+    offset += kReadSizes[i];
+  }
+  for (size_t i = 0; i < kDatagramSize; i++) {
+    mem->put<unsigned char>(static_cast<unsigned char>(i * 7), kWriteDataOffset + i);
+  }
+
+  KernelHandle<SocketDispatcher> dispatcher0, dispatcher1;
+  zx_rights_t rights;
+  ASSERT_EQ(SocketDispatcher::Create(ZX_SOCKET_DATAGRAM, &dispatcher0, &dispatcher1, &rights),
+            ZX_OK);
+
+  user_in_iovec_t write_vec = make_user_in_iovec(
+      mem->user_in<zx_iovec_t>().element_offset(kWriteVecOffset / sizeof(zx_iovec_t)),
+      ktl::size(kWriteSizes));
+  size_t written = 0;
+  ASSERT_EQ(dispatcher0.dispatcher()->WriteVector(write_vec, &written), ZX_OK);
+  EXPECT_EQ(written, kDatagramSize);
+  ASSERT_EQ(dispatcher0.dispatcher()->WriteVector(write_vec, &written), ZX_OK);
+  EXPECT_EQ(written, kDatagramSize);
+
+  zx_info_socket info = {};
+  dispatcher1.dispatcher()->GetInfo(&info);
+  EXPECT_EQ(info.rx_buf_available, kDatagramSize);
+  EXPECT_EQ(info.rx_buf_size, 2 * kDatagramSize);
+
+  user_out_iovec_t read_vec = make_user_out_iovec(
+      mem->user_out<zx_iovec_t>().element_offset(kReadVecOffset / sizeof(zx_iovec_t)),
+      ktl::size(kReadSizes));
+  for (int i = 0; i < 2; i++) {
+    size_t nread = 0;
+    ASSERT_EQ(dispatcher1.dispatcher()->ReadVector(SocketDispatcher::ReadType::kPeek, read_vec,
+                                                   &nread),
+              ZX_OK);
+    EXPECT_EQ(nread, kDatagramSize);
+    ASSERT_EQ(dispatcher1.dispatcher()->ReadVector(SocketDispatcher::ReadType::kConsume, read_vec,
+                                                   &nread),
+              ZX_OK);
+    EXPECT_EQ(nread, kDatagramSize);
+    for (size_t j = 0; j < kDatagramSize; j++) {
+      EXPECT_EQ(mem->get<unsigned char>(kReadDataOffset + j), static_cast<unsigned char>(j * 7));
+    }
+  }
+
+  dispatcher1.dispatcher()->GetInfo(&info);
+  EXPECT_EQ(info.rx_buf_size, 0u);
+
+  END_TEST;
+}
+
 bool TestDispositionSwitchMustBeExhaustive() {
   BEGIN_TEST;
 
@@ -120,5 +195,6 @@ bool TestDispositionSwitchMustBeExhaustive() {
 UNITTEST_START_TESTCASE(socket_dispatcher_tests)
 UNITTEST("TestCreateDestroyManySockets", TestCreateDestroyManySockets)
 UNITTEST("TestCreateWriteReadClose", TestCreateWriteReadClose)
+UNITTEST("TestWriteReadVectorDatagram", TestWriteReadVectorDatagram)
 UNITTEST("TestDispositionSwitchMustBeExhaustive", TestDispositionSwitchMustBeExhaustive)
 UNITTEST_END_TESTCASE(socket_dispatcher_tests, "socket_dispatcher_tests", "SocketDispatcher tests")
@@ -237,6 +237,17 @@ zx_status_t VmAddressRegionDispatcher::RangeOp(uint32_t op, vaddr_t base, size_t
     return vmar_->RangeOp(VmAddressRegion::RangeOpType::DontNeed, base, len, buffer, buffer_size);
   } else if (op == ZX_VMAR_OP_ALWAYS_NEED) {
     return vmar_->RangeOp(VmAddressRegion::RangeOpType::AlwaysNeed, base, len, buffer, buffer_size);
+  } else if (op == ZX_VMAR_OP_DECOMMIT_BATCH || op == ZX_VMAR_OP_DONT_NEED_BATCH) {
+    if (base != 0 || len != 0) {
+      return ZX_ERR_INVALID_ARGS;
+    }
+    const VmAddressRegion::RangeOpType type = op == ZX_VMAR_OP_DECOMMIT_BATCH
+                                                  ? VmAddressRegion::RangeOpType::Decommit
+                                                  : VmAddressRegion::RangeOpType::DontNeed;
+    return VmObject::ForEachUserRangeBatch(
+        buffer, buffer_size, [this, type](ktl::span<const VmObject::Range> ranges) {
+          return vmar_->RangeOpBatch(type, ranges);
+        });
   }
   return ZX_ERR_INVALID_ARGS;
 }
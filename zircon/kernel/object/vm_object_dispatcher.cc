@@ -40,6 +40,10 @@ zx_status_t VmObjectDispatcher::parse_create_syscall_flags(uint32_t flags, uint3
     res |= VmObjectPaged::kDiscardable;
     flags &= ~ZX_VMO_DISCARDABLE;
   }
+  if (flags & ZX_VMO_LARGE_PAGES) {
+    res |= VmObjectPaged::kPreferLargePages;
+    flags &= ~ZX_VMO_LARGE_PAGES;
+  }
 
   if (flags) {
     return ZX_ERR_INVALID_ARGS;
@@ -373,6 +377,24 @@ zx_status_t VmObjectDispatcher::RangeOp(uint32_t op, uint64_t offset, uint64_t s
       return vmo_->HintRange(offset, size, VmObject::EvictionHint::AlwaysNeed);
     case ZX_VMO_OP_DONT_NEED:
       return vmo_->HintRange(offset, size, VmObject::EvictionHint::DontNeed);
+    case ZX_VMO_OP_DECOMMIT_BATCH:
+      if ((rights & ZX_RIGHT_WRITE) == 0) {
+        return ZX_ERR_ACCESS_DENIED;
+      }
+      if (offset != 0 || size != 0) {
+        return ZX_ERR_INVALID_ARGS;
+      }
+      return VmObject::ForEachUserRangeBatch(
+          buffer, buffer_size,
+          [this](ktl::span<const VmObject::Range> ranges) { return vmo_->DecommitRanges(ranges); });
+    case ZX_VMO_OP_DONT_NEED_BATCH:
+      if (offset != 0 || size != 0) {
+        return ZX_ERR_INVALID_ARGS;
+      }
+      return VmObject::ForEachUserRangeBatch(
+          buffer, buffer_size, [this](ktl::span<const VmObject::Range> ranges) {
+            return vmo_->HintRanges(ranges, VmObject::EvictionHint::DontNeed);
+          });
     default:
       return ZX_ERR_INVALID_ARGS;
   }
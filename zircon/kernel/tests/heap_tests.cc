@@ -6,10 +6,17 @@
 
 #include <bits.h>
 #include <lib/boot-options/boot-options.h>
+#include <lib/fit/defer.h>
+#include <lib/heap.h>
+#include <lib/heap_cpu_cache.h>
 #include <lib/unittest/unittest.h>
 #include <zircon/errors.h>
 #include <zircon/types.h>
 
+#include <kernel/cpu.h>
+#include <kernel/mp.h>
+#include <kernel/thread.h>
+
 static bool test_alloc_fill_threshold() {
   BEGIN_TEST;
 
@@ -25,6 +32,132 @@ static bool test_alloc_fill_threshold() {
   END_TEST;
 }
 
+// The HeapCpuCache tests use caches of their own rather than the heap's per-CPU caches, so that
+// they don't depend on kernel.heap.cpu-cache and nothing else touches the cache under test.
+
+static bool test_cpu_cache_hit() {
+  BEGIN_TEST;
+
+  HeapCpuCache cache;
+  void* const block = malloc(64);
+  ASSERT_NONNULL(block);
+
+  ASSERT_TRUE(cache.Free(block));
+  EXPECT_GE(cache.bytes(), 64u);
+
+  // Any allocation of the same size class gets the cached block back.
+  EXPECT_EQ(block, cache.Alloc(60));
+  EXPECT_EQ(0u, cache.bytes());
+  EXPECT_NULL(cache.Alloc(60));
+
+  free(block);
+
+  END_TEST;
+}
+
+static bool test_cpu_cache_miss() {
+  BEGIN_TEST;
+
+  HeapCpuCache cache;
+  EXPECT_NULL(cache.Alloc(64));
+  EXPECT_NULL(cache.Alloc(0));
+  EXPECT_NULL(cache.Alloc(HeapCpuCache::kMaxAllocSize + 1));
+
+  // Blocks which are too large are not cached.
+  void* const large = malloc(HeapCpuCache::kMaxAllocSize * 4);
+  ASSERT_NONNULL(large);
+  EXPECT_FALSE(cache.Free(large));
+  free(large);
+
+  // A cached block is not handed out for a larger size class.
+  void* const block = malloc(64);
+  ASSERT_NONNULL(block);
+  ASSERT_TRUE(cache.Free(block));
+  EXPECT_NULL(cache.Alloc(64 + HeapCpuCache::kClassSize));
+  EXPECT_EQ(block, cache.Alloc(64));
+  free(block);
+
+  END_TEST;
+}
+
+static bool test_cpu_cache_flush() {
+  BEGIN_TEST;
+
+  HeapCpuCache cache;
+  void* blocks[HeapCpuCache::kMaxBlocksPerClass + 1];
+  for (void*& block : blocks) {
+    block = malloc(32);
+    ASSERT_NONNULL(block);
+  }
+
+  // Each size class only holds so many blocks, the rest go back to the heap.
+  for (size_t i = 0; i < HeapCpuCache::kMaxBlocksPerClass; i++) {
+    EXPECT_TRUE(cache.Free(blocks[i]));
+  }
+  void* const extra = blocks[HeapCpuCache::kMaxBlocksPerClass];
+  EXPECT_FALSE(cache.Free(extra));
+  free(extra);
+  EXPECT_GE(cache.bytes(), 32u * HeapCpuCache::kMaxBlocksPerClass);
+
+  // Flushing returns every cached block to the heap.
+  cache.Flush();
+  EXPECT_EQ(0u, cache.bytes());
+  EXPECT_NULL(cache.Alloc(32));
+
+  // The class can be filled again after a flush.
+  void* const block = malloc(32);
+  ASSERT_NONNULL(block);
+  EXPECT_TRUE(cache.Free(block));
+  EXPECT_EQ(block, cache.Alloc(32));
+  free(block);
+
+  END_TEST;
+}
+
+// A block allocated on one CPU can be freed to the cache of another, which then hands it out.
+static bool test_cpu_cache_cross_cpu_free() {
+  BEGIN_TEST;
+
+  cpu_mask_t online = mp_get_online_mask();
+  if (lowest_cpu_set(online) == highest_cpu_set(online)) {
+    printf("skipping test, needs more than one CPU\n");
+    END_TEST;
+  }
+
+  Thread* const current = Thread::Current::Get();
+  const cpu_mask_t old_affinity = current->GetCpuAffinity();
+  const cpu_mask_t this_cpu = cpu_num_to_mask(lowest_cpu_set(online));
+  current->SetCpuAffinity(this_cpu);
+  auto restore_affinity = fit::defer([current, old_affinity]() {
+    current->SetCpuAffinity(old_affinity);
+  });
+
+  void* block = nullptr;
+  Thread* const t = Thread::Create(
+      "heap cpu cache alloc",
+      [](void* arg) -> int {
+        *static_cast<void**>(arg) = malloc(48);
+        return 0;
+      },
+      &block, DEFAULT_PRIORITY);
+  ASSERT_NONNULL(t);
+  t->SetCpuAffinity(online & ~this_cpu);
+  t->Resume();
+  t->Join(nullptr, ZX_TIME_INFINITE);
+  ASSERT_NONNULL(block);
+
+  HeapCpuCache cache;
+  EXPECT_TRUE(cache.Free(block));
+  EXPECT_EQ(block, cache.Alloc(48));
+  free(block);
+
+  END_TEST;
+}
+
 UNITTEST_START_TESTCASE(heap_tests)
 UNITTEST("test allocations are zeroed if alloc_fill_threshold is set", test_alloc_fill_threshold)
+UNITTEST("cpu cache hands out cached blocks", test_cpu_cache_hit)
+UNITTEST("cpu cache misses", test_cpu_cache_miss)
+UNITTEST("cpu cache flush", test_cpu_cache_flush)
+UNITTEST("cpu cache free of a block allocated on another cpu", test_cpu_cache_cross_cpu_free)
 UNITTEST_END_TESTCASE(heap_tests, "heap", "heap tests")
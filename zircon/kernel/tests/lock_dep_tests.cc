@@ -1321,8 +1321,43 @@ static bool bug_84827_regression_test() {
   END_TEST;
 }
 
+static bool lock_stats_test() {
+  BEGIN_TEST;
+
+  if constexpr (!lockdep::kLockStatsEnabled) {
+    printf("Lock statistics are not enabled, skipping test.\n");
+    END_TEST;
+  }
+
+  struct StatsTestLock {
+    DECLARE_MUTEX(StatsTestLock) lock;
+  } test;
+  auto& stats = lockdep::LockClassState::GetStats(test.lock.id());
+
+  const uint64_t acquisitions = stats.acquisitions.load();
+  const uint64_t total_hold_time = stats.total_hold_time.load();
+  constexpr int kAcquisitions = 3;
+  for (int i = 0; i < kAcquisitions; ++i) {
+    Guard<Mutex> guard{&test.lock};
+    // Hold the lock for a measurable amount of time.
+    const zx_ticks_t start = current_ticks();
+    while (current_ticks() == start) {
+    }
+  }
+
+  // Each acquisition is counted, and the time spent in the critical sections
+  // is accounted for on release.
+  EXPECT_EQ(acquisitions + kAcquisitions, stats.acquisitions.load());
+  EXPECT_GE(stats.total_hold_time.load(), total_hold_time + kAcquisitions);
+  EXPECT_GE(stats.max_hold_time.load(), 1u);
+  EXPECT_LE(stats.max_wait_time.load(), stats.total_wait_time.load());
+
+  END_TEST;
+}
+
 UNITTEST_START_TESTCASE(lock_dep_regression_tests)
 UNITTEST("Bug #84827 regression test", bug_84827_regression_test)
+UNITTEST("lock stats", lock_stats_test)
 UNITTEST_END_TESTCASE(lock_dep_regression_tests, "lock_dep_regression_tests",
                       "lock_dep_regression_tests")
 #endif
@@ -154,8 +154,89 @@ bool mutex_spin_time_test(void) {
 
   END_TEST;
 }
+
+bool mutex_adaptive_spin_test(void) {
+  BEGIN_TEST;
+
+  cpu_mask_t holder_mask;
+  cpu_mask_t waiter_mask;
+  {
+    cpu_mask_t avail_mask = mp_get_online_mask();
+    if (ktl::popcount(avail_mask) < 2) {
+      printf("Insufficient cores online to run the mutex adaptive spin tests.  Skipping!\n");
+      END_TEST;
+    }
+
+    for (holder_mask = 0x1; (holder_mask & avail_mask) == 0; holder_mask <<= 1)
+      ;
+
+    for (waiter_mask = holder_mask << 1; (waiter_mask & avail_mask) == 0; waiter_mask <<= 1)
+      ;
+  }
+
+  auto cleanup =
+      fit::defer([affinity = Thread::Current::Get()->GetCpuAffinity(),
+                  priority = Thread::Current::Get()->scheduler_state().base_priority()]() {
+        Thread::Current::Get()->SetCpuAffinity(affinity);
+        Thread::Current::Get()->SetPriority(priority);
+      });
+
+  struct Args {
+    DECLARE_MUTEX(Args) the_mutex;
+    ktl::atomic<bool> started{false};
+  } args;
+
+  // Nothing has been learned about a new mutex, so it spins for the longest
+  // budget.
+  EXPECT_EQ(Mutex::SPIN_MAX_DURATION, args.the_mutex.lock().spin_budget());
+
+  // The waiter acquires the mutex with the default, adaptive, spin budget.
+  auto thunk = [](void* ctx) -> int {
+    auto& args = *(static_cast<Args*>(ctx));
+    args.started.store(true);
+    Guard<Mutex> guard{&args.the_mutex};
+    return 0;
+  };
+
+  Thread::Current::Get()->SetCpuAffinity(holder_mask);
+  Thread::Current::Get()->SetPriority(HIGH_PRIORITY);
+
+  // Hold the mutex for much longer than the longest spin every time a waiter
+  // contends for it.  Each wait should shrink the spin budget.
+  constexpr int kRounds = 8;
+  for (int i = 0; i < kRounds; ++i) {
+    args.started.store(false);
+    Thread* waiter = Thread::Create("mutex adaptive spin", thunk, &args, HIGH_PRIORITY);
+    ASSERT_NONNULL(waiter, "Failed to create test thread");
+    waiter->SetCpuAffinity(waiter_mask);
+
+    {
+      Guard<Mutex> guard{&args.the_mutex};
+      waiter->Resume();
+      while (!args.started.load()) {
+        arch::Yield();
+      }
+      const zx_ticks_t hold_until =
+          current_ticks() +
+          platform_get_ticks_to_time_ratio().Inverse().Scale(Mutex::SPIN_MAX_DURATION * 4);
+      while (current_ticks() < hold_until) {
+        arch::Yield();
+      }
+    }
+
+    zx_status_t status = waiter->Join(nullptr, current_time() + ZX_SEC(30));
+    ASSERT_EQ(status, ZX_OK, "test thread failed to exit!");
+  }
+
+  printf("Adaptive spin budget after %d long holds: %ld nSec\n", kRounds,
+         args.the_mutex.lock().spin_budget());
+  EXPECT_LT(args.the_mutex.lock().spin_budget(), Mutex::SPIN_MAX_DURATION);
+
+  END_TEST;
+}
 }  // namespace
 
 UNITTEST_START_TESTCASE(mutex_spin_time_tests)
 UNITTEST("Mutex spin timeouts", (mutex_spin_time_test))
+UNITTEST("Mutex adaptive spin budget", (mutex_adaptive_spin_test))
 UNITTEST_END_TESTCASE(mutex_spin_time_tests, "mutex_spin_time", "mutex_spin_time tests")
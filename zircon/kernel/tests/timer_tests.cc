@@ -583,6 +583,32 @@ static bool deadline_after() {
   END_TEST;
 }
 
+static bool slack_bucket() {
+  BEGIN_TEST;
+
+  // A window of a single instant has only one choice.
+  EXPECT_EQ(ZX_MSEC(5), TimerQueue::SlackBucket(ZX_MSEC(5), ZX_MSEC(5)));
+
+  EXPECT_EQ(0x1800, TimerQueue::SlackBucket(0x1001, 0x1fff));
+  EXPECT_EQ(0x1000, TimerQueue::SlackBucket(0x1000, 0x1fff));
+  EXPECT_EQ(0x2000, TimerQueue::SlackBucket(0x1001, 0x2000));
+  EXPECT_EQ(0x1234, TimerQueue::SlackBucket(0x1234, 0x1235));
+
+  // The bucket is within the window, and any narrower window that still contains it picks the
+  // same bucket.
+  const zx_time_t now = current_time();
+  for (zx_duration_t slack = ZX_USEC(1); slack <= ZX_SEC(1); slack *= 10) {
+    const zx_time_t earliest = now + ZX_MSEC(1);
+    const zx_time_t bucket = TimerQueue::SlackBucket(earliest, earliest + slack);
+    EXPECT_LE(earliest, bucket);
+    EXPECT_GE(earliest + slack, bucket);
+    EXPECT_EQ(bucket, TimerQueue::SlackBucket(earliest, bucket));
+    EXPECT_EQ(bucket, TimerQueue::SlackBucket(bucket, earliest + slack));
+  }
+
+  END_TEST;
+}
+
 UNITTEST_START_TESTCASE(timer_tests)
 UNITTEST("cancel_before_deadline", cancel_before_deadline)
 UNITTEST("cancel_after_fired", cancel_after_fired)
@@ -592,4 +618,5 @@ UNITTEST("trylock_or_cancel_canceled", trylock_or_cancel_canceled)
 UNITTEST("trylock_or_cancel_get_lock", trylock_or_cancel_get_lock)
 UNITTEST("print_timer_queue", print_timer_queues)
 UNITTEST("Deadline::after", deadline_after)
+UNITTEST("slack_bucket", slack_bucket)
 UNITTEST_END_TESTCASE(timer_tests, "timer", "timer tests")
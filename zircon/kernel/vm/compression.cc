@@ -0,0 +1,147 @@
+// Copyright 2022 The Fuchsia Authors
+//
+// Use of this source code is governed by a MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT
+
+#include "vm/compression.h"
+
+#include <lib/counters.h>
+#include <stdlib.h>
+#include <string.h>
+#include <trace.h>
+
+#include <vm/compression.h>
+
+#include <ktl/enforce.h>
+
+#define LOCAL_TRACE 0
+
+KCOUNTER(compression_pages_compressed, "vm.compression.pages_compressed")
+KCOUNTER(compression_pages_incompressible, "vm.compression.pages_incompressible")
+KCOUNTER(compression_pages_storage_full, "vm.compression.pages_storage_full")
+KCOUNTER(compression_pages_decompressed, "vm.compression.pages_decompressed")
+
+ktl::optional<VmCompression::CompressedRef> VmCompression::Compress(const void* page_src) {
+  compression_attempts_.fetch_add(1, ktl::memory_order_relaxed);
+  const uint64_t* src = static_cast<const uint64_t*>(page_src);
+
+  // Count the literals first so that the allocation can be sized exactly, and so that we can
+  // give up early on incompressible pages without having allocated anything.
+  constexpr uint32_t kMaxLiterals =
+      (kThresholdBytes - sizeof(Header) - kTagBytes) / sizeof(uint64_t);
+  uint32_t literals = 0;
+  uint64_t last_literal = 0;
+  for (size_t i = 0; i < kWordsPerPage; i++) {
+    const uint64_t word = src[i];
+    if (word != 0 && word != last_literal) {
+      if (++literals > kMaxLiterals) {
+        failed_compression_attempts_.fetch_add(1, ktl::memory_order_relaxed);
+        compression_pages_incompressible.Add(1);
+        return ktl::nullopt;
+      }
+      last_literal = word;
+    }
+  }
+
+  const size_t alloc_size = AllocSize(literals);
+  if (storage_bytes_.fetch_add(alloc_size, ktl::memory_order_relaxed) + alloc_size >
+      max_storage_bytes_) {
+    storage_bytes_.fetch_sub(alloc_size, ktl::memory_order_relaxed);
+    failed_compression_attempts_.fetch_add(1, ktl::memory_order_relaxed);
+    compression_pages_storage_full.Add(1);
+    return ktl::nullopt;
+  }
+
+  Header* header = static_cast<Header*>(memalign(alignof(Header), alloc_size));
+  if (!header) {
+    storage_bytes_.fetch_sub(alloc_size, ktl::memory_order_relaxed);
+    failed_compression_attempts_.fetch_add(1, ktl::memory_order_relaxed);
+    compression_pages_storage_full.Add(1);
+    return ktl::nullopt;
+  }
+  header->alloc_size = static_cast<uint32_t>(alloc_size);
+  header->literals = literals;
+
+  if (literals > 0) {
+    uint8_t* tags = reinterpret_cast<uint8_t*>(header + 1);
+    uint64_t* out = reinterpret_cast<uint64_t*>(tags + kTagBytes);
+    memset(tags, 0, kTagBytes);
+    last_literal = 0;
+    for (size_t i = 0; i < kWordsPerPage; i++) {
+      const uint64_t word = src[i];
+      uint8_t tag;
+      if (word == 0) {
+        tag = kTagZero;
+      } else if (word == last_literal) {
+        tag = kTagRepeat;
+      } else {
+        tag = kTagLiteral;
+        *out++ = word;
+        last_literal = word;
+      }
+      tags[i / 4] |= static_cast<uint8_t>(tag << ((i % 4) * 2));
+    }
+    DEBUG_ASSERT(out == reinterpret_cast<uint64_t*>(tags + kTagBytes) + literals);
+  }
+
+  compressed_pages_.fetch_add(1, ktl::memory_order_relaxed);
+  compression_pages_compressed.Add(1);
+  LTRACEF("compressed page to %zu bytes (%u literals)\n", alloc_size, literals);
+  return CompressedRef(reinterpret_cast<uint64_t>(header));
+}
+
+void VmCompression::Decompress(CompressedRef ref, void* page_dest) {
+  const Header* header = reinterpret_cast<const Header*>(ref.value());
+  DEBUG_ASSERT(header);
+  uint64_t* dest = static_cast<uint64_t*>(page_dest);
+
+  if (header->literals == 0) {
+    memset(dest, 0, PAGE_SIZE);
+  } else {
+    const uint8_t* tags = reinterpret_cast<const uint8_t*>(header + 1);
+    const uint64_t* in = reinterpret_cast<const uint64_t*>(tags + kTagBytes);
+    uint64_t last_literal = 0;
+    for (size_t i = 0; i < kWordsPerPage; i++) {
+      const uint8_t tag = (tags[i / 4] >> ((i % 4) * 2)) & 0b11;
+      if (tag == kTagZero) {
+        dest[i] = 0;
+      } else if (tag == kTagRepeat) {
+        dest[i] = last_literal;
+      } else {
+        DEBUG_ASSERT(tag == kTagLiteral);
+        last_literal = *in++;
+        dest[i] = last_literal;
+      }
+    }
+    DEBUG_ASSERT(in == reinterpret_cast<const uint64_t*>(tags + kTagBytes) + header->literals);
+  }
+
+  decompressions_.fetch_add(1, ktl::memory_order_relaxed);
+  compression_pages_decompressed.Add(1);
+  Free(ref);
+}
+
+void VmCompression::Free(CompressedRef ref) {
+  Header* header = reinterpret_cast<Header*>(ref.value());
+  DEBUG_ASSERT(header);
+  DEBUG_ASSERT(header->alloc_size == AllocSize(header->literals));
+  [[maybe_unused]] const uint64_t prev_bytes =
+      storage_bytes_.fetch_sub(header->alloc_size, ktl::memory_order_relaxed);
+  DEBUG_ASSERT(prev_bytes >= header->alloc_size);
+  [[maybe_unused]] const uint64_t prev_pages =
+      compressed_pages_.fetch_sub(1, ktl::memory_order_relaxed);
+  DEBUG_ASSERT(prev_pages > 0);
+  free(header);
+}
+
+VmCompression::Stats VmCompression::GetStats() const {
+  Stats stats;
+  stats.compressed_pages = compressed_pages_.load(ktl::memory_order_relaxed);
+  stats.uncompressed_storage_bytes = stats.compressed_pages * PAGE_SIZE;
+  stats.compressed_storage_bytes = storage_bytes_.load(ktl::memory_order_relaxed);
+  stats.compression_attempts = compression_attempts_.load(ktl::memory_order_relaxed);
+  stats.failed_compression_attempts = failed_compression_attempts_.load(ktl::memory_order_relaxed);
+  stats.decompressions = decompressions_.load(ktl::memory_order_relaxed);
+  return stats;
+}
@@ -168,6 +168,9 @@ Evictor::EvictedPageCounts Evictor::EvictOneShotFromPreloadedTarget() {
       printf("[EVICT]: Evicted %lu pages from discardable vmos\n",
              total_evicted_counts.discardable);
     }
+    if (total_evicted_counts.compressed > 0) {
+      printf("[EVICT]: Compressed %lu anonymous pages\n", total_evicted_counts.compressed);
+    }
   }
 
   return total_evicted_counts;
@@ -189,7 +192,7 @@ uint64_t Evictor::EvictOneShotSynchronous(uint64_t min_mem_to_free, EvictionLeve
   });
 
   auto evicted_counts = EvictOneShotFromPreloadedTarget();
-  return evicted_counts.pager_backed + evicted_counts.discardable;
+  return evicted_counts.pager_backed + evicted_counts.discardable + evicted_counts.compressed;
 }
 
 void Evictor::EvictOneShotAsynchronous(uint64_t min_mem_to_free, uint64_t free_mem_target,
@@ -268,9 +271,11 @@ Evictor::EvictedPageCounts Evictor::EvictUntilTargetsMet(uint64_t min_pages_to_e
         EvictPagerBacked(pages_to_free_pager_backed, level);
     total_evicted_counts.pager_backed += pages_freed_pager_backed.pager_backed;
     total_evicted_counts.pager_backed_loaned += pages_freed_pager_backed.pager_backed_loaned;
-    total_non_loaned_pages_freed += pages_freed_pager_backed.pager_backed;
+    total_evicted_counts.compressed += pages_freed_pager_backed.compressed;
+    total_non_loaned_pages_freed +=
+        pages_freed_pager_backed.pager_backed + pages_freed_pager_backed.compressed;
 
-    pages_freed += pages_freed_pager_backed.pager_backed;
+    pages_freed += pages_freed_pager_backed.pager_backed + pages_freed_pager_backed.compressed;
 
     // Should we fail to free any pages then we give up and consider the eviction request complete.
     if (pages_freed == 0) {
@@ -333,7 +338,7 @@ Evictor::EvictedPageCounts Evictor::EvictPagerBacked(uint64_t target_pages,
   __UNINITIALIZED StackOwnedLoanedPagesInterval raii_interval;
 
   DEBUG_ASSERT(page_queues_);
-  while (counts.pager_backed < target_pages) {
+  while (counts.pager_backed + counts.compressed < target_pages) {
     // TODO(rashaeqbal): The sequence of actions in PeekPagerBacked() and RemovePageForEviction()
     // implicitly guarantee forward progress in this loop, so that we're not stuck trying to evict
     // the same page (i.e. PeekPagerBacked keeps returning the same page). It would be nice to have
@@ -346,7 +351,10 @@ Evictor::EvictedPageCounts Evictor::EvictPagerBacked(uint64_t target_pages,
       }
       if (backlink->cow->ReclaimPage(backlink->page, backlink->offset, hint_action)) {
         list_add_tail(&freed_list, &backlink->page->queue_node);
-        if (backlink->page->is_loaned()) {
+        if (!backlink->cow->can_evict()) {
+          // Pages reclaimed from VMOs without a page source to evict to were compressed.
+          counts.compressed++;
+        } else if (backlink->page->is_loaned()) {
           counts.pager_backed_loaned++;
         } else {
           counts.pager_backed++;
@@ -413,7 +421,7 @@ int Evictor::EvictionThreadLoop() {
     // request. If both one-shot and continuous modes are used together, at worst we will wait for
     // |next_eviction_interval_| before evicting as required by the continuous mode, which should
     // still be fine.
-    if (evicted.discardable + evicted.pager_backed > 0) {
+    if (evicted.discardable + evicted.pager_backed + evicted.compressed > 0) {
       continue;
     }
 
@@ -438,9 +446,12 @@ int Evictor::EvictionThreadLoop() {
       if (evicted.discardable > 0) {
         printf("[EVICT]: Evicted %lu pages from discardable vmos\n", evicted.discardable);
       }
+      if (evicted.compressed > 0) {
+        printf("[EVICT]: Compressed %lu anonymous pages\n", evicted.compressed);
+      }
     }
 
-    uint64_t total_evicted = evicted.discardable + evicted.pager_backed;
+    uint64_t total_evicted = evicted.discardable + evicted.pager_backed + evicted.compressed;
     // If no pages were evicted, we don't have anything to decrement from the min pages target. Skip
     // the rest of the loop.
     if (total_evicted == 0) {
@@ -0,0 +1,58 @@
+// Copyright 2022 The Fuchsia Authors
+//
+// Use of this source code is governed by a MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT
+
+#include "vm/fault_lookup_cache.h"
+
+#include <lib/counters.h>
+
+#include <ktl/algorithm.h>
+
+#include <ktl/enforce.h>
+
+KCOUNTER(fault_lookup_cache_inserts, "vm.fault_lookup_cache.inserts")
+KCOUNTER(fault_lookup_cache_invalidations, "vm.fault_lookup_cache.invalidations")
+
+void VmFaultLookupCache::Insert(uint64_t offset, const paddr_t* paddrs, size_t count) {
+  DEBUG_ASSERT(IS_PAGE_ALIGNED(offset));
+  // Inserting more pages than there are entries would only overwrite the earlier pages.
+  count = ktl::min(count, kNumEntries);
+
+  Guard<BrwLockPi, BrwLockPi::Writer> guard{&lock_};
+  for (size_t i = 0; i < count; i++) {
+    const uint64_t page_offset = offset + i * PAGE_SIZE;
+    entries_[EntryIndex(page_offset)] = {page_offset, paddrs[i]};
+  }
+  fault_lookup_cache_inserts.Add(count);
+}
+
+void VmFaultLookupCache::Invalidate(uint64_t offset, uint64_t len) {
+  DEBUG_ASSERT(IS_PAGE_ALIGNED(offset));
+  DEBUG_ASSERT(IS_PAGE_ALIGNED(len));
+  if (len == 0) {
+    return;
+  }
+
+  Guard<BrwLockPi, BrwLockPi::Writer> guard{&lock_};
+  // Ranges that cover at least every entry can be handled by checking each entry once, instead of
+  // checking the slot of every page in the range.
+  if (len / PAGE_SIZE >= kNumEntries) {
+    for (Entry& entry : entries_) {
+      if (entry.offset != kEmptyOffset && entry.offset >= offset && entry.offset - offset < len) {
+        entry.offset = kEmptyOffset;
+        fault_lookup_cache_invalidations.Add(1);
+      }
+    }
+    return;
+  }
+
+  for (uint64_t page_offset = offset; page_offset < offset + len; page_offset += PAGE_SIZE) {
+    Entry& entry = entries_[EntryIndex(page_offset)];
+    if (entry.offset == page_offset) {
+      entry.offset = kEmptyOffset;
+      fault_lookup_cache_invalidations.Add(1);
+    }
+  }
+}
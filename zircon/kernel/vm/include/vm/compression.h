@@ -0,0 +1,102 @@
+// Copyright 2022 The Fuchsia Authors
+//
+// Use of this source code is governed by a MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT
+
+#ifndef ZIRCON_KERNEL_VM_INCLUDE_VM_COMPRESSION_H_
+#define ZIRCON_KERNEL_VM_INCLUDE_VM_COMPRESSION_H_
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include <ktl/atomic.h>
+#include <ktl/optional.h>
+#include <vm/vm_page_list.h>
+
+// In memory store of compressed page contents. This is used to reclaim anonymous pages, which have
+// no page source to bring their contents back in, by replacing them with a Reference to a
+// compressed copy of their contents that is decompressed back into a new page when next needed.
+//
+// Contents are compressed by classifying each 64-bit word of the page as being either zero, a
+// repeat of the last literal, or a new literal. This is cheap to compute and to reverse, and is
+// effective on the sparse and repetitive data that makes up most cold anonymous memory.
+//
+// The compressed data is allocated from the kernel heap, and the total amount held is bounded by
+// |max_storage_bytes|. This class is thread-safe and performs no blocking operations, so it may be
+// used whilst holding VMO locks.
+class VmCompression {
+ public:
+  using CompressedRef = VmPageOrMarker::ReferenceValue;
+
+  explicit VmCompression(size_t max_storage_bytes) : max_storage_bytes_(max_storage_bytes) {}
+  ~VmCompression() = default;
+
+  VmCompression(const VmCompression&) = delete;
+  VmCompression& operator=(const VmCompression&) = delete;
+
+  // Pages whose compressed form would be larger than this are not considered worth storing.
+  static constexpr size_t kThresholdBytes = PAGE_SIZE * 3 / 4;
+
+  // Attempts to compress the PAGE_SIZE bytes at |page_src|. On success returns a reference to the
+  // stored compressed data, which is owned by the caller and must eventually be passed to either
+  // |Decompress| or |Free|. Returns nullopt if the page does not compress below |kThresholdBytes|,
+  // or there is no space left to store it.
+  ktl::optional<CompressedRef> Compress(const void* page_src);
+
+  // Decompresses the contents of |ref| into the PAGE_SIZE bytes at |page_dest|, and then frees
+  // |ref|.
+  void Decompress(CompressedRef ref, void* page_dest);
+
+  // Frees the compressed data held by |ref| without decompressing it.
+  void Free(CompressedRef ref);
+
+  struct Stats {
+    // Number of pages currently held in compressed form, and the size of their contents.
+    uint64_t compressed_pages = 0;
+    uint64_t uncompressed_storage_bytes = 0;
+    // Bytes currently allocated to hold the compressed data, including any metadata.
+    uint64_t compressed_storage_bytes = 0;
+    // Total number of calls to Compress, and how many of those did not produce a reference.
+    uint64_t compression_attempts = 0;
+    uint64_t failed_compression_attempts = 0;
+    // Total number of calls to Decompress.
+    uint64_t decompressions = 0;
+  };
+  Stats GetStats() const;
+
+ private:
+  // Header stored at the start of every allocation. Its address is used as the reference value,
+  // and so it must be aligned to leave the low bits of the reference available to the page list.
+  struct alignas(1u << CompressedRef::kAlignBits) Header {
+    // Total size of the allocation, including this header.
+    uint32_t alloc_size;
+    // Number of literal words that follow the tags. A page with no literals is entirely zero and
+    // stores no tags either.
+    uint32_t literals;
+  };
+
+  // Every word of a page has a 2-bit tag.
+  static constexpr size_t kWordsPerPage = PAGE_SIZE / sizeof(uint64_t);
+  static constexpr size_t kTagBytes = kWordsPerPage / 4;
+  static constexpr uint8_t kTagZero = 0b00;
+  static constexpr uint8_t kTagRepeat = 0b01;
+  static constexpr uint8_t kTagLiteral = 0b10;
+
+  static size_t AllocSize(uint32_t literals) {
+    if (literals == 0) {
+      return sizeof(Header);
+    }
+    return sizeof(Header) + kTagBytes + literals * sizeof(uint64_t);
+  }
+
+  const size_t max_storage_bytes_;
+
+  ktl::atomic<uint64_t> compressed_pages_ = 0;
+  ktl::atomic<uint64_t> storage_bytes_ = 0;
+  ktl::atomic<uint64_t> compression_attempts_ = 0;
+  ktl::atomic<uint64_t> failed_compression_attempts_ = 0;
+  ktl::atomic<uint64_t> decompressions_ = 0;
+};
+
+#endif  // ZIRCON_KERNEL_VM_INCLUDE_VM_COMPRESSION_H_
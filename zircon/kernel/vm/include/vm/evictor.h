@@ -66,6 +66,8 @@ class Evictor {
     uint64_t pager_backed_loaned = 0;
     // evicted from/via discardable VMO page count
     uint64_t discardable = 0;
+    // reclaimed from anonymous VMOs by compression page count
+    uint64_t compressed = 0;
   };
 
   explicit Evictor(PmmNode *node);
@@ -154,8 +156,9 @@ class Evictor {
   // number of pages evicted. This may acquire arbitrary vmo and aspace locks.
   uint64_t EvictDiscardable(uint64_t target_pages) const TA_EXCL(lock_);
 
-  // Evict the requested number of |target_pages| from pager-backed vmos. The returned struct has
-  // the number of pages evicted (discardable will be 0). The |eviction_level| is a rough control
+  // Evict the requested number of |target_pages| from pager-backed vmos, or from anonymous vmos by
+  // compression if it is enabled, since both share the reclaimable page queues. The returned struct
+  // has the number of pages evicted (discardable will be 0). The |eviction_level| is a rough control
   // that maps to how old a page needs to be for being considered for eviction. This may acquire
   // arbitrary vmo and aspace locks.
   EvictedPageCounts EvictPagerBacked(uint64_t target_pages, EvictionLevel eviction_level) const
@@ -0,0 +1,94 @@
+// Copyright 2022 The Fuchsia Authors
+//
+// Use of this source code is governed by a MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT
+
+#ifndef ZIRCON_KERNEL_VM_INCLUDE_VM_FAULT_LOOKUP_CACHE_H_
+#define ZIRCON_KERNEL_VM_INCLUDE_VM_FAULT_LOOKUP_CACHE_H_
+
+#include <lib/zircon-internal/thread_annotations.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include <kernel/brwlock.h>
+#include <kernel/lockdep.h>
+#include <vm/vm.h>
+
+// Remembers the physical pages that recent read faults on a VMO resolved to, so that later read
+// faults of the same offsets can be resolved without acquiring the VMO lock. The VMO lock is shared
+// by the entire VMO hierarchy, and so without this all soft faults on, for example, a shared
+// library mapped into many processes would serialize on it.
+//
+// Correctness relies on the invariant that a VMO performs an Unmap range change whenever the page
+// that a read fault at an offset would return changes, as otherwise existing read only mappings of
+// the old page would be left behind. The owning VMO calls |Invalidate| from that range change, and
+// |Lookup| holds the cache lock across both the lookup and the creation of any mapping. Either the
+// mapping is created before the invalidation, in which case the unmap that follows the
+// invalidation removes it, or the lookup happens after and misses.
+//
+// |Insert| and |Invalidate| must be called with the owning VMO lock held. |Lookup| requires no VMO
+// lock and concurrent lookups do not exclude each other.
+class VmFaultLookupCache {
+ public:
+  VmFaultLookupCache() { Clear(); }
+  ~VmFaultLookupCache() = default;
+
+  VmFaultLookupCache(const VmFaultLookupCache&) = delete;
+  VmFaultLookupCache& operator=(const VmFaultLookupCache&) = delete;
+
+  // Number of pages that are remembered. Entries are direct mapped by page offset.
+  static constexpr size_t kNumEntries = 32;
+
+  // Records that a read fault at |offset| would map the |count| consecutive pages in |paddrs|.
+  void Insert(uint64_t offset, const paddr_t* paddrs, size_t count);
+
+  // Forgets any pages previously recorded in the range [offset, offset + len).
+  void Invalidate(uint64_t offset, uint64_t len);
+
+  // Looks up to |max_pages| consecutive pages starting at |offset|. If at least the first page is
+  // found |func| is invoked as |func(paddrs, count)| and its boolean result returned, otherwise
+  // false is returned. Any read only mapping of the pages made by |func| is guaranteed to be
+  // removed by the owning VMO if the pages are later removed or replaced.
+  template <typename F>
+  bool Lookup(uint64_t offset, size_t max_pages, F func) {
+    DEBUG_ASSERT(IS_PAGE_ALIGNED(offset));
+    DEBUG_ASSERT(max_pages > 0 && max_pages <= kNumEntries);
+    Guard<BrwLockPi, BrwLockPi::Reader> guard{&lock_};
+    paddr_t paddrs[kNumEntries];
+    size_t count = 0;
+    for (; count < max_pages; count++) {
+      const uint64_t page_offset = offset + count * PAGE_SIZE;
+      const Entry& entry = entries_[EntryIndex(page_offset)];
+      if (entry.offset != page_offset) {
+        break;
+      }
+      paddrs[count] = entry.paddr;
+    }
+    if (count == 0) {
+      return false;
+    }
+    return func(paddrs, count);
+  }
+
+ private:
+  static constexpr uint64_t kEmptyOffset = UINT64_MAX;
+
+  struct Entry {
+    uint64_t offset;
+    paddr_t paddr;
+  };
+
+  static size_t EntryIndex(uint64_t offset) { return (offset / PAGE_SIZE) % kNumEntries; }
+
+  void Clear() TA_NO_THREAD_SAFETY_ANALYSIS {
+    for (Entry& entry : entries_) {
+      entry.offset = kEmptyOffset;
+    }
+  }
+
+  DECLARE_BRWLOCK_PI(VmFaultLookupCache) lock_;
+  Entry entries_[kNumEntries] TA_GUARDED(lock_);
+};
+
+#endif  // ZIRCON_KERNEL_VM_INCLUDE_VM_FAULT_LOOKUP_CACHE_H_
@@ -342,9 +342,15 @@ struct vm_page {
   static constexpr uint8_t kLoanedStateIsLoanCancelled = 2;
   uint8_t loaned_state_priv;
 
+  // offset 0x2d
+
+  // logically private, use access_count() and set_access_count(). Only meaningful whilst the page
+  // is in the PageQueues, which reset it whenever a page is first placed in a queue.
+  uint8_t access_count_priv;
+
   // This padding is inserted here to make sizeof(vm_page) a multiple of 8 and help validate that
   // all commented offsets were indeed correct.
-  char padding_bytes[3];
+  char padding_bytes[2];
 
   // helper routines
 
@@ -390,6 +396,16 @@ struct vm_page {
     ktl::atomic_ref<uint8_t>(loaned_state_priv).fetch_and(~kLoanedStateIsLoanCancelled);
   }
 
+  // Saturating count, maintained by the PageQueues, of the number of aging epochs in which this
+  // page has been seen to be accessed. Updates are relaxed and may be lost when racing, as this is
+  // only used as a reclamation hint.
+  uint8_t access_count() const {
+    return ktl::atomic_ref<const uint8_t>(access_count_priv).load(ktl::memory_order_relaxed);
+  }
+  void set_access_count(uint8_t count) {
+    ktl::atomic_ref<uint8_t>(access_count_priv).store(count, ktl::memory_order_relaxed);
+  }
+
   void dump() const;
 
   // return the physical address
@@ -463,7 +479,9 @@ static_assert(offsetof(vm_page_t, state_priv) == 0x2b);
 static_assert(offsetof(vm_page_t, state_priv) % alignof(decltype(vm_page_t::state_priv)) == 0);
 static_assert(offsetof(vm_page_t, state_priv) % alignof(vm_page_state) == 0);
 
-static_assert(offsetof(vm_page_t, padding_bytes) == 0x2d);
+static_assert(offsetof(vm_page_t, access_count_priv) == 0x2d);
+
+static_assert(offsetof(vm_page_t, padding_bytes) == 0x2e);
 
 // assert that the page structure isn't growing uncontrollably
 static_assert(sizeof(vm_page) == 0x30);
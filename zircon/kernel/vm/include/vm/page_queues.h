@@ -59,6 +59,14 @@ class PageQueues {
   static constexpr size_t kNumOldestQueues = 2;
   static_assert(kNumOldestQueues + kNumActiveQueues <= kNumReclaim);
 
+  // Pages that are seen to be accessed in multiple aging epochs build up an access count, which
+  // grants them that many second chances when they would otherwise be returned for eviction from
+  // the LRU queue. Each second chance costs one access and moves the page to the next oldest
+  // inactive queue. This protects frequently used pages from being evicted due to a single long gap
+  // in their use. The count is capped so that a page that stops being used still ages out after a
+  // bounded number of extra epochs.
+  static constexpr uint8_t kMaxAccessCount = 3;
+
   static constexpr zx_duration_t kDefaultMinMruRotateTime = ZX_SEC(5);
   static constexpr zx_duration_t kDefaultMaxMruRotateTime = ZX_SEC(5);
 
@@ -96,6 +104,9 @@ class PageQueues {
       }
     } while (!queue_ref.compare_exchange_weak(old_gen, static_cast<uint8_t>(target_queue),
                                               ktl::memory_order_relaxed));
+    if (old_gen != target_queue) {
+      RecordAccess(page);
+    }
     page_queue_counts_[old_gen].fetch_sub(1, ktl::memory_order_relaxed);
     page_queue_counts_[target_queue].fetch_add(1, ktl::memory_order_relaxed);
   }
@@ -273,11 +284,10 @@ class PageQueues {
 
   void Dump() TA_EXCL(lock_);
 
-  // Returns whether or not the reclaim queues only include pager backed pages or not.
-  // TODO(fxb/60238) This is a temporary method to ensure existing page queues usages that make
-  // assumptions on all reclaimable pages being pager backed are updated before any non pager backed
-  // reclamation is enabled.
-  static bool ReclaimIsOnlyPagerBacked() { return !kAnonymousIsReclaimable; }
+  // Returns whether or not the reclaim queues only include pager backed pages or not. This is false
+  // when anonymous pages can be reclaimed by compression, in which case they are aged in the
+  // reclaim queues alongside pager backed pages.
+  static bool ReclaimIsOnlyPagerBacked() { return !AnonymousIsReclaimable(); }
 
   // These query functions are marked Debug as it is generally a racy way to determine a pages state
   // and these are exposed for the purpose of writing tests or asserts against the pagequeue.
@@ -456,6 +466,15 @@ class PageQueues {
   ktl::optional<PageQueues::VmoBacklink> ProcessQueueHelper(ProcessingQueue processing_queue,
                                                             uint64_t target_gen, bool peek);
 
+  // Increments the access count of a page, saturating at kMaxAccessCount. This is called whenever a
+  // page is moved into the MRU queue due to an access.
+  static void RecordAccess(vm_page_t* page) {
+    const uint8_t count = page->access_count();
+    if (count < kMaxAccessCount) {
+      page->set_access_count(static_cast<uint8_t>(count + 1));
+    }
+  }
+
   // Helpers for adding and removing to the queues. All of the public Set/Move/Remove operations
   // are convenience wrappers around these.
   void RemoveLocked(vm_page_t* page) TA_REQ(lock_);
@@ -490,9 +509,9 @@ class PageQueues {
   bool NeedsLruProcessing() const;
 
   // Determines if anonymous pages are placed in the reclaimable queues, or in their own non aging
-  // anonymous queues.
-  // TODO(fxbug.dev/60238): Add tests and support options other than hard coding to false.
-  static constexpr bool kAnonymousIsReclaimable = false;
+  // anonymous queues. This is fixed for the lifetime of the system by the `kernel.vm.compression`
+  // boot option, so pages never need to be migrated between the two.
+  static bool AnonymousIsReclaimable();
 
   // The lock_ is needed to protect the linked lists queues as these cannot be implemented with
   // atomics.
@@ -27,6 +27,7 @@ typedef struct pmm_arena_info {
 
 class PhysicalPageBorrowingConfig;
 class LoanSweeper;
+class VmCompression;
 
 #define PMM_ARENA_FLAG_LO_MEM \
   (0x1)  // this arena is contained within architecturally-defined 'low memory'
@@ -138,12 +139,29 @@ uint64_t pmm_count_loan_cancelled_pages();
 // Return amount of physical memory in system, in bytes.
 uint64_t pmm_count_total_bytes();
 
+// Return the number of NUMA domains that physical memory is grouped in, which is always at least 1.
+size_t pmm_num_numa_domains();
+
+typedef struct pmm_numa_domain_stats {
+  // Number of physical pages in the domain.
+  uint64_t total_pages;
+  // Number of those pages that are unallocated, not including loaned pages.
+  uint64_t free_pages;
+} pmm_numa_domain_stats_t;
+
+// Fill out |stats| for the |domain|-th NUMA domain.  Returns ZX_ERR_OUT_OF_RANGE if |domain| is not
+// less than |pmm_num_numa_domains|.
+zx_status_t pmm_get_numa_domain_stats(size_t domain, pmm_numa_domain_stats_t* stats);
+
 // Return the PageQueues.
 PageQueues* pmm_page_queues();
 
 // Return the Evictor.
 Evictor* pmm_evictor();
 
+// Return the compressed page store, or nullptr if compression of anonymous pages is disabled.
+VmCompression* pmm_page_compression();
+
 // Return the singleton PhysicalPageBorrowingConfig.
 PhysicalPageBorrowingConfig* pmm_physical_page_borrowing_config();
 
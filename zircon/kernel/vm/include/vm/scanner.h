@@ -8,6 +8,7 @@
 #define ZIRCON_KERNEL_VM_INCLUDE_VM_SCANNER_H_
 
 #include <sys/types.h>
+#include <zircon/time.h>
 
 #include <fbl/macros.h>
 #include <vm/evictor.h>
@@ -23,11 +24,11 @@ void scanner_push_disable_count();
 void scanner_pop_disable_count();
 
 // Attempts to scan for, and dedupe, zero pages. Page candidates are pulled from the
-// anonymous_zero_fork page queue. It will consider up to `limit` candidates, and return the
-// number of pages actually deduped.
+// anonymous_zero_fork page queue. It will consider up to `limit` candidates, stopping early if
+// `budget` has elapsed, and return the number of pages actually deduped.
 // This is expected to be used internally by the scanner thread, but is exposed for testing,
 // debugging and other code to use.
-uint64_t scanner_do_zero_scan(uint64_t limit);
+uint64_t scanner_do_zero_scan(uint64_t limit, zx_duration_t budget = ZX_TIME_INFINITE);
 
 // Sets the scanner to reclaim page tables when harvesting accessed bits in the future, unless
 // page table reclamation was explicitly disabled on the command line. Repeatedly enabling does not
@@ -136,6 +136,17 @@ class VmAddressRegionOrMapping
     return base >= base_ && offset < size_ && size_ - offset >= size;
   }
 
+  // Sets the size, in pages, of the fault-around window of this region. When a page fault in a
+  // mapping of a pager backed VMO is resolved, any pages of the naturally aligned window around the
+  // faulting address that are already resident in the VMO are mapped in at the same time. A value
+  // of 0 or 1 disables fault-around, and |kFaultAroundDefault| selects the default from the
+  // kernel.vm.fault-around-pages boot option.
+  //
+  // For a VmAddressRegion this applies to every existing descendant, and is inherited by any
+  // regions and mappings created in it later.
+  void SetFaultAroundPages(uint32_t pages);
+  static constexpr uint32_t kFaultAroundDefault = UINT32_MAX;
+
  private:
   fbl::Canary<fbl::magic("VMRM")> canary_;
   const bool is_mapping_;
@@ -220,6 +231,9 @@ class VmAddressRegionOrMapping
 
   // pointer back to our parent region (nullptr if root or destroyed)
   VmAddressRegion* parent_ TA_GUARDED(lock());
+
+  // Fault-around window, in pages. See |SetFaultAroundPages|.
+  uint32_t fault_around_pages_ TA_GUARDED(lock()) = kFaultAroundDefault;
 };
 
 // A list of regions ordered by virtual address. Templated to allow for test code to avoid needing
@@ -536,6 +550,13 @@ class VmAddressRegion final : public VmAddressRegionOrMapping {
   zx_status_t RangeOp(RangeOpType op, vaddr_t base, size_t len, user_inout_ptr<void> buffer,
                       size_t buffer_size);
 
+  // Apply |op| to each range in |ranges| in order, stopping at the first failure. Each range is an
+  // absolute address and length, validated as for RangeOp. All the ranges are validated before any
+  // of them is applied, so only a failure of the operation itself leaves earlier ranges applied.
+  // The parts of the ranges that map the same VMO are handed to it together, so that a Decommit
+  // unmaps them with a single TLB invalidation. Only Decommit and DontNeed are supported.
+  zx_status_t RangeOpBatch(RangeOpType op, ktl::span<const VmObject::Range> ranges);
+
   // Unmap a subset of the region of memory in the containing address space,
   // returning it to this region to allocate.  If a subregion is entirely in
   // the range, that subregion is destroyed.  If a subregion is partially in
@@ -951,6 +972,37 @@ class VmMapping final : public VmAddressRegionOrMapping,
   // Implementation for Protect().
   zx_status_t ProtectLocked(vaddr_t base, size_t size, uint new_arch_mmu_flags) TA_REQ(lock());
 
+  // Implementation for MapRange(). |currently_faulting_| must already be set by the caller.
+  zx_status_t MapRangeLocked(size_t offset, size_t len, bool commit, bool ignore_existing)
+      TA_REQ(lock()) TA_REQ(object_->lock());
+
+  // Maps in any pages of the fault-around window surrounding |va| that are already resident in
+  // the VMO, skipping the |num_pages| that the fault itself has mapped starting at |va|. See
+  // |SetFaultAroundPages|.
+  void FaultAroundLocked(vaddr_t va, uint64_t num_pages) TA_REQ(lock()) TA_REQ(object_->lock());
+
+  // Attempts to resolve a read fault at |va| using the lookup cache of |object_|, without acquiring
+  // the object lock. At most |max_pages| pages, which must be covered by |mmu_flags|, are mapped,
+  // and always without write permission. Returns whether the fault was resolved, otherwise the
+  // full fault path must be taken.
+  bool TryLocklessReadFaultLocked(vaddr_t va, uint64_t vmo_offset, uint mmu_flags,
+                                  uint64_t max_pages) TA_REQ(lock());
+
+  // Size of the large pages that user and guest physical mappings will opportunistically be mapped
+  // with.
+  static constexpr size_t kLargePageSize = 2ul * 1024 * 1024;
+  // Size of the larger pages that guest physical mappings can additionally be mapped with by
+  // MapRange, where a single page walk covers the most guest memory.
+  static constexpr size_t kHugePageSize = 1ul * 1024 * 1024 * 1024;
+
+  // Attempts to map the |size| aligned range starting at |va| with a single large page of |size|,
+  // which is only possible if the VMO has that entire range committed and physically contiguous
+  // with a matching alignment. |mmu_flags| must apply to the whole range. If |replace_existing| any
+  // existing small page mappings in the range are removed first, otherwise they cause the attempt
+  // to fail. Returns whether the large page was mapped.
+  bool TryMapLargePageLocked(vaddr_t va, size_t size, uint mmu_flags, bool replace_existing)
+      TA_REQ(lock()) TA_REQ(object_->lock());
+
   // Helper for protect and unmap.
   static zx_status_t ProtectOrUnmap(const fbl::RefPtr<VmAspace>& aspace, vaddr_t base, size_t size,
                                     uint new_arch_mmu_flags);
@@ -261,6 +261,14 @@ class VmAspace : public fbl::DoublyLinkedListable<VmAspace*>, public fbl::RefCou
                                             : ArchVmAspace::EnlargeOperation::No;
   }
 
+  // Removes every arch mapping in [base, base + size) ahead of the mappings covering the range
+  // being unmapped or destroyed one by one. Doing so in a single arch operation lets the TLB
+  // invalidations of all the mappings be coalesced into one, which falls back to a full flush past
+  // the arch's threshold, and leaves nothing for the later per mapping unmaps to invalidate. This
+  // is only done for user aspaces, where any mapping that ends up not being removed after all just
+  // faults its pages back in.
+  void CoalescedArchUnmapLocked(vaddr_t base, size_t size) TA_REQ(lock_);
+
   fbl::RefPtr<VmAddressRegion> RootVmarLocked() TA_REQ(lock_);
 
   // internal page fault routine, friended to be only called by vmm_page_fault_handler
@@ -33,6 +33,7 @@
 
 // Forward declare these so VmCowPages helpers can accept references.
 class BatchPQRemove;
+class VmCompression;
 class VmObjectPaged;
 
 namespace internal {
@@ -54,6 +55,11 @@ enum class VmCowPagesOptions : uint32_t {
   // to/from contiguous while not pinned.
   kCannotDecommitZeroPages = (1u << 0),
 
+  // With this set, CommitRangeLocked allocates each empty, naturally aligned large page sized chunk
+  // of the range as a single physically contiguous run of pages where the PMM can provide one, and
+  // falls back to individual pages otherwise.
+  kPreferLargePages = (1u << 4),
+
   // Internal-only flags:
   kHidden = (1u << 1),
   kSlice = (1u << 2),
@@ -430,6 +436,13 @@ class VmCowPages final
   // operation that is guaranteed to succeed, but may not release memory.
   zx_status_t DecommitRangeLocked(uint64_t offset, uint64_t len) TA_REQ(lock_);
 
+  // Decommits each of |ranges| in order as DecommitRangeLocked does, stopping at the first range
+  // that fails, with the ranges before it staying decommitted. The pages of all the decommitted
+  // ranges are unmapped with a single range change over the union of the ranges, so that each
+  // mapping does one unmap and TLB invalidation for the whole batch. Pages in the union that are
+  // not in any of the ranges stay committed, and are faulted back in by their next access.
+  zx_status_t DecommitRangesLocked(ktl::span<const VmObject::Range> ranges) TA_REQ(lock_);
+
   // After successful completion the range of pages will all read as zeros. The mechanism used to
   // achieve this is not guaranteed to decommit, but it will try to.
   // |page_start_base| and |page_end_base| must be page aligned offsets within the range of the
@@ -503,6 +516,9 @@ class VmCowPages final
   // keep finding this page as a reclamation candidate and infinitely retry it.
   //
   // |hint_action| indicates whether the |always_need| eviction hint should be respected or ignored.
+  //
+  // Pages of pager backed VMOs are reclaimed by eviction, and pages of anonymous VMOs are reclaimed
+  // by compression if a compressed page store is available.
   bool ReclaimPage(vm_page_t* page, uint64_t offset, EvictionHintAction hint_action);
 
   // Swap an old page for a new page.  The old page must be at offset.  The new page must be in
@@ -585,6 +601,14 @@ class VmCowPages final
 
   void MarkAsLatencySensitiveLocked() TA_REQ(lock_);
 
+  // Sets the policy the zero page scanner applies to pages owned by this VmCowPages. Setting the
+  // policy to Eager queues every currently committed page that could be deduped for scanning.
+  // Returns ZX_ERR_NOT_SUPPORTED if zero pages can never be deduped from this VmCowPages.
+  zx_status_t SetZeroPageDedupPolicyLocked(VmObject::ZeroPageDedupPolicy policy) TA_REQ(lock_);
+  VmObject::ZeroPageDedupPolicy zero_page_dedup_policy_locked() const TA_REQ(lock_) {
+    return zero_page_dedup_policy_;
+  }
+
   zx_status_t LockRangeLocked(uint64_t offset, uint64_t len, zx_vmo_lock_state_t* lock_state_out);
   zx_status_t TryLockRangeLocked(uint64_t offset, uint64_t len);
   zx_status_t UnlockRangeLocked(uint64_t offset, uint64_t len);
@@ -765,11 +789,28 @@ class VmCowPages final
   zx_status_t ReplaceReferenceWithPageLocked(VmPageOrMarkerRef page_or_mark, uint64_t offset,
                                              LazyPageRequest* page_request) TA_REQ(lock_);
 
+  // Allocates a page and fills it with the contents of |parent_paddr|. When |parent_paddr| is the
+  // zero page and |use_zeroed_pool| is true, the page is taken from the pre-zeroed page pool if
+  // possible, to avoid zeroing it inline.
   static zx_status_t AllocateCopyPage(uint32_t pmm_alloc_flags, paddr_t parent_paddr,
                                       list_node_t* alloc_list, LazyPageRequest* request,
-                                      vm_page_t** clone);
+                                      vm_page_t** clone, bool use_zeroed_pool = false);
+
+  // Preallocates into |alloc_list| the pages needed to commit the missing pages of the range
+  // [|offset|, |offset| + |len|), in offset order, for a VmCowPages with kPreferLargePages. Each
+  // empty and naturally aligned large page sized chunk of the range is allocated as a single
+  // physically contiguous run, so that the run ends up at matching offsets when the list is
+  // consumed in order. Returns ZX_ERR_SHOULD_WAIT if the allocations stopped early, in which case
+  // |alloc_list| holds pages for a prefix of the range, and on any other error |alloc_list| is
+  // left empty.
+  zx_status_t AllocateCommitPagesLocked(uint64_t offset, uint64_t len, list_node_t* alloc_list)
+      TA_REQ(lock_);
 
   static zx_status_t CacheAllocPage(uint alloc_flags, vm_page_t** p, paddr_t* pa);
+  // Like CacheAllocPage, but prefers pages from the pre-zeroed page pool. |zeroed| is set to true
+  // if the returned page is already filled with zeros.
+  static zx_status_t CacheAllocZeroedPage(uint alloc_flags, vm_page_t** p, paddr_t* pa,
+                                          bool* zeroed);
   static void CacheFree(list_node_t* list);
   static void CacheFree(vm_page_t* p);
 
@@ -1205,6 +1246,13 @@ class VmCowPages final
   bool RemovePageForEvictionLocked(vm_page_t* page, uint64_t offset, EvictionHintAction hint_action)
       TA_REQ(lock_);
 
+  // Internal helper for performing reclamation via compression on anonymous VMOs. Replaces the page
+  // with a Reference to its compressed contents in |compression|. Assumes that the page is owned by
+  // this VMO at the specified offset.
+  bool RemovePageForCompressionLocked(vm_page_t* page, uint64_t offset,
+                                      VmCompression* compression, EvictionHintAction hint_action)
+      TA_REQ(lock_);
+
   // Eviction wrapper that exists to be called from the VmCowPagesContainer. Unlike ReclaimPage this
   // wrapper can assume it just needs to evict, and has no requirements on updating any reclamation
   // lists.
@@ -1370,6 +1418,11 @@ class VmCowPages final
   // separate mechanism for that. Once fxb/101641 is resolved this might change.
   bool is_latency_sensitive_ TA_GUARDED(lock_) = false;
 
+  // Policy applied by the zero page scanner to pages owned by this VmCowPages. This is not
+  // inherited by children.
+  VmObject::ZeroPageDedupPolicy zero_page_dedup_policy_ TA_GUARDED(lock_) =
+      VmObject::ZeroPageDedupPolicy::Default;
+
   using Cursor =
       VmoCursor<VmCowPages, DiscardableVmosLock, DiscardableList, DiscardableList::iterator>;
 
@@ -1395,6 +1448,10 @@ class VmCowPages final
 
   // PageCache instance for COW page allocations.
   inline static page_cache::PageCache page_cache_;
+
+  // Starts the thread that keeps the pre-zeroed page pool of |page_cache_| topped up.
+  static void InitializeZeroedPagePool(uint32_t level);
+  static int ZeroedPageThread(void* arg);
 };
 
 // VmCowPagesContainer exists to essentially split the VmCowPages ref_count_ into two counts, so
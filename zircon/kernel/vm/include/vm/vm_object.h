@@ -29,7 +29,9 @@
 #include <fbl/ref_ptr.h>
 #include <kernel/lockdep.h>
 #include <kernel/mutex.h>
+#include <ktl/algorithm.h>
 #include <ktl/move.h>
+#include <ktl/span.h>
 #include <vm/page.h>
 #include <vm/vm.h>
 #include <vm/vm_page_list.h>
@@ -282,6 +284,8 @@ class VmObject : public VmHierarchyBase,
   virtual bool is_discardable() const { return false; }
   // Returns true if the VMO was created via CreatePagerVmo().
   virtual bool is_user_pager_backed() const { return false; }
+  // Same as is_user_pager_backed(), for use when the VMO's lock is already held.
+  virtual bool is_user_pager_backed_locked() const TA_REQ(lock_) { return false; }
   // Returns true if the VMO supports CloneType::PrivatePagerCopy.
   virtual bool is_private_pager_copy_supported() const { return false; }
   // Returns true if the VMO's pages require dirty bit tracking.
@@ -310,6 +314,58 @@ class VmObject : public VmHierarchyBase,
   // free a range of the vmo back to the default state
   virtual zx_status_t DecommitRange(uint64_t offset, uint64_t len) { return ZX_ERR_NOT_SUPPORTED; }
 
+  // A range of the vmo, used by the batched range operations.
+  struct Range {
+    uint64_t offset;
+    uint64_t len;
+  };
+
+  // Batched range operations are handed at most this many ranges at a time, which bounds how long
+  // any lock is held for across the batch.
+  static constexpr size_t kMaxBatchRanges = 16;
+
+  // Copies the array of zx_op_range_t that is |buffer_size| bytes long at |buffer| from user memory
+  // in chunks of at most kMaxBatchRanges, and calls |func| with each chunk as a
+  // ktl::span<const Range>. Stops at the first error from either the copy or |func|.
+  template <typename F>
+  static zx_status_t ForEachUserRangeBatch(user_inout_ptr<void> buffer, size_t buffer_size,
+                                           F func) {
+    if (buffer_size % sizeof(zx_op_range_t) != 0) {
+      return ZX_ERR_INVALID_ARGS;
+    }
+    const size_t count = buffer_size / sizeof(zx_op_range_t);
+    auto user_ranges = buffer.reinterpret<zx_op_range_t>();
+    zx_op_range_t user_chunk[kMaxBatchRanges];
+    Range chunk[kMaxBatchRanges];
+    for (size_t i = 0; i < count; i += kMaxBatchRanges) {
+      const size_t chunk_count = ktl::min(count - i, kMaxBatchRanges);
+      zx_status_t status = user_ranges.copy_array_from_user(user_chunk, chunk_count, i);
+      if (status != ZX_OK) {
+        return status;
+      }
+      for (size_t j = 0; j < chunk_count; j++) {
+        chunk[j] = Range{.offset = user_chunk[j].offset, .len = user_chunk[j].size};
+      }
+      status = func(ktl::span<const Range>(chunk, chunk_count));
+      if (status != ZX_OK) {
+        return status;
+      }
+    }
+    return ZX_OK;
+  }
+
+  // Batched version of DecommitRange that decommits each of |ranges| in order, stopping at the
+  // first failure. Ranges before the failing one remain decommitted.
+  virtual zx_status_t DecommitRanges(ktl::span<const Range> ranges) {
+    for (const Range& range : ranges) {
+      zx_status_t status = DecommitRange(range.offset, range.len);
+      if (status != ZX_OK) {
+        return status;
+      }
+    }
+    return ZX_OK;
+  }
+
   // Zero a range of the VMO. May release physical pages in the process.
   // May block on user pager requests and must be called without locks held.
   virtual zx_status_t ZeroRange(uint64_t offset, uint64_t len) { return ZX_ERR_NOT_SUPPORTED; }
@@ -367,6 +423,15 @@ class VmObject : public VmHierarchyBase,
     return ZX_ERR_NOT_SUPPORTED;
   }
 
+  // Checks whether every page in the range [offset, offset + len) is committed, physically
+  // contiguous and may be mapped with a single large page, returning the paddr of the start of the
+  // range if so. Returns ZX_ERR_NOT_FOUND if the range is not committed or not contiguous, and
+  // ZX_ERR_NOT_SUPPORTED if this object can never be mapped with large pages.
+  virtual zx_status_t LookupLargePageLocked(uint64_t offset, uint64_t len, paddr_t* out_paddr)
+      TA_REQ(lock_) {
+    return ZX_ERR_NOT_SUPPORTED;
+  }
+
   // read/write operators against user space pointers only
   //
   // The |out_actual| field will be set to the number of bytes successfully processed, even upon
@@ -466,12 +531,42 @@ class VmObject : public VmHierarchyBase,
     return ZX_OK;
   }
 
+  // Batched version of HintRange that applies |hint| to each of |ranges| in order, stopping at the
+  // first failure.
+  // May block on user pager requests and must be called without locks held.
+  virtual zx_status_t HintRanges(ktl::span<const Range> ranges, EvictionHint hint) {
+    for (const Range& range : ranges) {
+      zx_status_t status = HintRange(range.offset, range.len, hint);
+      if (status != ZX_OK) {
+        return status;
+      }
+    }
+    return ZX_OK;
+  }
+
   // TODO(fxb/101641): This is a temporary solution and needs to be replaced with something that is
   // formalized.
   virtual void MarkAsLatencySensitive() {
     // This does nothing by default.
   }
 
+  // Controls how the zero page scanner treats committed pages of this VMO.
+  enum class ZeroPageDedupPolicy : uint8_t {
+    // Pages forked from the zero page by hardware faults are candidates for deduping.
+    Default,
+    // No pages are ever deduped back to the zero page by the scanner.
+    Disabled,
+    // All committed pages, including those written by software faults and those already present
+    // when the policy is set, are candidates for deduping.
+    Eager,
+  };
+  virtual zx_status_t SetZeroPageDedupPolicy(ZeroPageDedupPolicy policy) {
+    return ZX_ERR_NOT_SUPPORTED;
+  }
+  virtual ZeroPageDedupPolicy GetZeroPageDedupPolicy() const {
+    return ZeroPageDedupPolicy::Default;
+  }
+
   // The associated VmObjectDispatcher will set an observer to notify user mode.
   void SetChildObserver(VmObjectChildObserver* child_observer);
 
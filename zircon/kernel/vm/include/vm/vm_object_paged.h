@@ -21,6 +21,8 @@
 #include <fbl/ref_counted.h>
 #include <fbl/ref_ptr.h>
 #include <kernel/mutex.h>
+#include <ktl/atomic.h>
+#include <vm/fault_lookup_cache.h>
 #include <vm/page_source.h>
 #include <vm/pmm.h>
 #include <vm/vm.h>
@@ -37,6 +39,10 @@ class VmObjectPaged final : public VmObject {
   static constexpr uint32_t kSlice = (1u << 3);
   static constexpr uint32_t kDiscardable = (1u << 4);
   static constexpr uint32_t kAlwaysPinned = (1u << 5);
+  // Committing a range of the VMO backs it with physically contiguous and aligned runs of pages
+  // where possible, so that mappings of it can use large pages. See
+  // VmCowPagesOptions::kPreferLargePages.
+  static constexpr uint32_t kPreferLargePages = (1u << 6);
   static constexpr uint32_t kCanBlockOnPageRequests = (1u << 31);
 
   static zx_status_t Create(uint32_t pmm_alloc_flags, uint32_t options, uint64_t size,
@@ -76,6 +82,9 @@ class VmObjectPaged final : public VmObject {
     Guard<CriticalMutex> guard{&lock_};
     return cow_pages_locked()->is_root_source_user_pager_backed_locked();
   }
+  bool is_user_pager_backed_locked() const override TA_REQ(lock_) {
+    return cow_pages_locked()->is_root_source_user_pager_backed_locked();
+  }
   bool is_private_pager_copy_supported() const override {
     Guard<CriticalMutex> guard{&lock_};
     return cow_pages_locked()->is_private_pager_copy_supported();
@@ -131,6 +140,7 @@ class VmObjectPaged final : public VmObject {
     return CommitRangeInternal(offset, len, /*pin=*/true, write);
   }
   zx_status_t DecommitRange(uint64_t offset, uint64_t len) override;
+  zx_status_t DecommitRanges(ktl::span<const Range> ranges) override;
   zx_status_t ZeroRange(uint64_t offset, uint64_t len) override;
 
   void Unpin(uint64_t offset, uint64_t len) override {
@@ -152,6 +162,8 @@ class VmObjectPaged final : public VmObject {
   zx_status_t Write(const void* ptr, uint64_t offset, size_t len) override;
   zx_status_t Lookup(uint64_t offset, uint64_t len, VmObject::LookupFunction lookup_fn) override;
   zx_status_t LookupContiguous(uint64_t offset, uint64_t len, paddr_t* out_paddr) override;
+  zx_status_t LookupLargePageLocked(uint64_t offset, uint64_t len, paddr_t* out_paddr) override
+      TA_REQ(lock_);
 
   zx_status_t ReadUser(VmAspace* current_aspace, user_out_ptr<char> ptr, uint64_t offset,
                        size_t len, size_t* out_actual) override;
@@ -271,6 +283,16 @@ class VmObjectPaged final : public VmObject {
   // Apply the specified operation to all mappings in the given range.
   void RangeChangeUpdateLocked(uint64_t offset, uint64_t len, RangeChangeOp op) TA_REQ(lock_);
 
+  // Returns the cache of pages found by previous read faults, which may be used to resolve read
+  // faults without acquiring the lock. Returns null if no read faults have been recorded.
+  VmFaultLookupCache* fault_lookup_cache() const {
+    return fault_lookup_cache_.load(ktl::memory_order_acquire);
+  }
+
+  // Records that a read fault at |offset| mapped the |count| pages in |paddrs| without write
+  // permission, so that subsequent read faults can find them in the fault_lookup_cache().
+  void RecordReadFaultLocked(uint64_t offset, const paddr_t* paddrs, size_t count) TA_REQ(lock_);
+
   // This is exposed so that VmCowPages can call it. It is used to update the VmCowPages object
   // that this VMO points to for its operations. When updating it must be set to a non-null
   // reference, and any mappings or pin operations must remain equivalently valid.
@@ -286,12 +308,22 @@ class VmObjectPaged final : public VmObject {
   // Hint how the specified range is intended to be used, so that the hint can be taken into
   // consideration when reclaiming pages under memory pressure (if applicable).
   zx_status_t HintRange(uint64_t offset, uint64_t len, EvictionHint hint) override;
+  zx_status_t HintRanges(ktl::span<const Range> ranges, EvictionHint hint) override;
 
   void MarkAsLatencySensitive() override {
     Guard<CriticalMutex> guard{&lock_};
     cow_pages_locked()->MarkAsLatencySensitiveLocked();
   }
 
+  zx_status_t SetZeroPageDedupPolicy(ZeroPageDedupPolicy policy) override {
+    Guard<CriticalMutex> guard{&lock_};
+    return cow_pages_locked()->SetZeroPageDedupPolicyLocked(policy);
+  }
+  ZeroPageDedupPolicy GetZeroPageDedupPolicy() const override {
+    Guard<CriticalMutex> guard{&lock_};
+    return cow_pages_locked()->zero_page_dedup_policy_locked();
+  }
+
  private:
   // private constructor (use Create())
   VmObjectPaged(uint32_t options, fbl::RefPtr<VmHierarchyState> root_state);
@@ -365,6 +397,10 @@ class VmObjectPaged final : public VmObject {
   // consequence if this is null it implies that the VMO is *not* in the global list. Otherwise it
   // can generally be assumed that this is non-null.
   fbl::RefPtr<VmCowPages> cow_pages_ TA_GUARDED(lock_);
+
+  // Lazily allocated by RecordReadFaultLocked with the lock held, and then only freed by the
+  // destructor. Once set it can be read without holding the lock.
+  ktl::atomic<VmFaultLookupCache*> fault_lookup_cache_ = nullptr;
 };
 
 #endif  // ZIRCON_KERNEL_VM_INCLUDE_VM_VM_OBJECT_PAGED_H_
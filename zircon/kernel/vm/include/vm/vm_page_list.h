@@ -163,6 +163,12 @@ class VmPageOrMarker {
     return VmPageOrMarker{raw | kPageType};
   }
 
+  [[nodiscard]] static VmPageOrMarker Reference(ReferenceValue ref, bool left_split,
+                                                bool right_split) {
+    return VmPageOrMarker(ref.value() | (left_split ? kReferenceLeftSplit : 0) |
+                          (right_split ? kReferenceRightSplit : 0) | kReferenceType);
+  }
+
  private:
   explicit VmPageOrMarker(uint64_t raw) : raw_(raw) {}
 
@@ -190,14 +196,6 @@ class VmPageOrMarker {
 
   uint64_t GetType() const { return raw_ & BIT_MASK(kTypeBits); }
 
-  // TODO(fxb/60238): Make this public once tests are added and all TODO code paths for handling
-  // reference types are resolved.
-  [[nodiscard]] static VmPageOrMarker Reference(ReferenceValue ref, bool left_split,
-                                                bool right_split) {
-    return VmPageOrMarker(ref.value() | (left_split ? kReferenceLeftSplit : 0) |
-                          (right_split ? kReferenceRightSplit : 0) | kReferenceType);
-  }
-
   uint64_t Release() {
     const uint64_t p = raw_;
     raw_ = 0;
@@ -242,8 +240,18 @@ class VmPageOrMarkerRef {
     page_or_marker_->SetPageOrRefRightSplit(value);
   }
 
-  // TODO(fxb/60238): Add an equivalent SwapPageForReference method once tests are added and all
-  // code paths for handling reference types are resolved.
+  // Changing the kind of content is an allowed mutation and this takes ownership of the provided
+  // reference and returns ownership of the previous page. The split bits of the page are carried
+  // over to the reference.
+  [[nodiscard]] vm_page_t* SwapPageForReference(VmPageOrMarker::ReferenceValue ref) {
+    DEBUG_ASSERT(page_or_marker_);
+    vm_page_t* page = page_or_marker_->ReleasePage();
+    DEBUG_ASSERT(page);
+    *page_or_marker_ = VmPageOrMarker::Reference(ref, page->object.cow_left_split,
+                                                 page->object.cow_right_split);
+    return page;
+  }
+
   // Changing the kind of content is an allowed mutation and this takes ownership of the provided
   // page and returns ownership of the previous reference.
   [[nodiscard]] VmPageOrMarker::ReferenceValue SwapReferenceForPage(vm_page_t* p) {
@@ -4,6 +4,7 @@
 // license that can be found in the LICENSE file or at
 // https://opensource.org/licenses/MIT
 
+#include <lib/boot-options/boot-options.h>
 #include <lib/counters.h>
 #include <lib/fit/defer.h>
 #include <lib/zircon-internal/macros.h>
@@ -29,6 +30,7 @@ KCOUNTER(pq_aging_reason_active_ratio, "pq.aging.reason.active_ratio")
 KCOUNTER(pq_aging_reason_manual, "pq.aging.reason.manual")
 KCOUNTER(pq_aging_blocked_on_lru, "pq.aging.blocked_on_lru")
 KCOUNTER(pq_lru_spurious_wakeup, "pq.lru.spurious_wakeup")
+KCOUNTER(pq_lru_second_chance, "pq.lru.second_chance")
 
 }  // namespace
 
@@ -545,7 +547,8 @@ ktl::optional<PageQueues::VmoBacklink> PageQueues::ProcessQueueHelper(
           ++sweep_to_loaned_count;
         }
       }
-    } else if (peek) {
+    } else if (peek && !(processing_queue == ProcessingQueue::Lru && page->access_count() > 0 &&
+                         !queue_is_active(gen_to_queue(lru + 1), mru_queue))) {
       VmCowPages* cow = reinterpret_cast<VmCowPages*>(page->object.get_object());
       uint64_t page_offset = page->object.get_page_offset();
       DEBUG_ASSERT(cow);
@@ -557,6 +560,12 @@ ktl::optional<PageQueues::VmoBacklink> PageQueues::ProcessQueueHelper(
       // destructor gets a chance to run.
       return VmoBacklink{fbl::MakeRefPtrUpgradeFromRaw(cow, lock_), page, page_offset};
     } else {
+      // If we are peeking then this page has a second chance remaining, which it spends to be aged
+      // into the next queue instead of being returned for eviction.
+      if (peek) {
+        page->set_access_count(static_cast<uint8_t>(page->access_count() - 1));
+        pq_lru_second_chance.Add(1);
+      }
       // Force it into our target queue, don't care about races. If we happened to access it at
       // the same time then too bad.
       PageQueue new_queue = processing_queue == ProcessingQueue::DontNeed ? PageQueueReclaimDontNeed
@@ -715,6 +724,7 @@ void PageQueues::MarkAccessed(vm_page_t* page) {
   // Double check again that this was previously reclaimable
   DEBUG_ASSERT(old_queue != PageQueueNone && old_queue >= PageQueueReclaimDontNeed);
   if (old_queue != queue) {
+    RecordAccess(page);
     page_queue_counts_[old_queue].fetch_sub(1, ktl::memory_order_relaxed);
     page_queue_counts_[queue].fetch_add(1, ktl::memory_order_relaxed);
     UpdateActiveInactiveLocked(old_queue, queue);
@@ -732,6 +742,7 @@ void PageQueues::SetQueueBacklinkLocked(vm_page_t* page, void* object, uintptr_t
 
   page->object.set_object(object);
   page->object.set_page_offset(page_offset);
+  page->set_access_count(0);
 
   DEBUG_ASSERT(page->object.get_page_queue_ref().load(ktl::memory_order_relaxed) == PageQueueNone);
   page->object.get_page_queue_ref().store(queue, ktl::memory_order_relaxed);
@@ -766,16 +777,18 @@ void PageQueues::MoveToWired(vm_page_t* page) {
   MoveToQueueLocked(page, PageQueueWired);
 }
 
+bool PageQueues::AnonymousIsReclaimable() { return gBootOptions->vm_compression; }
+
 void PageQueues::SetAnonymous(vm_page_t* page, VmCowPages* object, uint64_t page_offset) {
   Guard<CriticalMutex> guard{&lock_};
   DEBUG_ASSERT(object);
   SetQueueBacklinkLocked(page, object, page_offset,
-                         kAnonymousIsReclaimable ? mru_gen_to_queue() : PageQueueAnonymous);
+                         AnonymousIsReclaimable() ? mru_gen_to_queue() : PageQueueAnonymous);
 }
 
 void PageQueues::MoveToAnonymous(vm_page_t* page) {
   Guard<CriticalMutex> guard{&lock_};
-  MoveToQueueLocked(page, kAnonymousIsReclaimable ? mru_gen_to_queue() : PageQueueAnonymous);
+  MoveToQueueLocked(page, AnonymousIsReclaimable() ? mru_gen_to_queue() : PageQueueAnonymous);
 }
 
 void PageQueues::SetPagerBacked(vm_page_t* page, VmCowPages* object, uint64_t page_offset) {
@@ -791,6 +804,8 @@ void PageQueues::MoveToPagerBacked(vm_page_t* page) {
 
 void PageQueues::MoveToPagerBackedDontNeed(vm_page_t* page) {
   Guard<CriticalMutex> guard{&lock_};
+  // An explicit DontNeed hint overrides any access history.
+  page->set_access_count(0);
   MoveToQueueLocked(page, PageQueueReclaimDontNeed);
 }
 
@@ -984,7 +999,7 @@ bool PageQueues::DebugPageIsPagerBackedDirty(const vm_page_t* page) const {
 }
 
 bool PageQueues::DebugPageIsAnonymous(const vm_page_t* page) const {
-  if (kAnonymousIsReclaimable) {
+  if (AnonymousIsReclaimable()) {
     return DebugPageIsReclaim(page);
   }
   return page->object.get_page_queue_ref().load(ktl::memory_order_relaxed) == PageQueueAnonymous;
@@ -1015,7 +1030,7 @@ ktl::optional<PageQueues::VmoBacklink> PageQueues::PopAnonymousZeroFork() {
   VmCowPages* cow = reinterpret_cast<VmCowPages*>(page->object.get_object());
   uint64_t page_offset = page->object.get_page_offset();
   DEBUG_ASSERT(cow);
-  MoveToQueueLocked(page, PageQueueAnonymous);
+  MoveToQueueLocked(page, AnonymousIsReclaimable() ? mru_gen_to_queue() : PageQueueAnonymous);
 
   // We may be racing with destruction of VMO. As we currently hold our lock we know that our
   // back pointer is correct in so far as the VmCowPages has not yet had completed running its
@@ -13,6 +13,7 @@
 #include <lib/console.h>
 #include <lib/counters.h>
 #include <lib/ktrace.h>
+#include <lib/system-topology.h>
 #include <platform.h>
 #include <pow2.h>
 #include <stdlib.h>
@@ -24,14 +25,17 @@
 
 #include <new>
 
+#include <fbl/alloc_checker.h>
 #include <fbl/auto_lock.h>
 #include <fbl/intrusive_double_list.h>
+#include <kernel/cpu_distance_map.h>
 #include <kernel/mp.h>
 #include <kernel/mutex.h>
 #include <kernel/timer.h>
 #include <ktl/algorithm.h>
 #include <lk/init.h>
 #include <vm/bootalloc.h>
+#include <vm/compression.h>
 #include <vm/physmap.h>
 #include <vm/pmm_checker.h>
 #include <vm/scanner.h>
@@ -54,6 +58,9 @@ static PmmNode pmm_node;
 // Singleton
 static PhysicalPageBorrowingConfig ppb_config;
 
+// Created at LK_INIT_LEVEL_VM, once the heap is available, only if compression is enabled.
+static VmCompression* page_compression = nullptr;
+
 // Check that if random should wait is requested that this is a debug build with assertions as it is
 // currently assumed that enabling this in a non-debug build would be a mistake that should be
 // caught.
@@ -69,6 +76,110 @@ LK_INIT_HOOK(pmm_check_alloc_random_should_wait, &pmm_check_alloc_random_should_
 static void pmm_fill_free_pages(uint level) { pmm_node.FillFreePagesAndArm(); }
 LK_INIT_HOOK(pmm_fill, &pmm_fill_free_pages, LK_INIT_LEVEL_VM)
 
+// Enable the per-CPU magazines once the percpu structures and the heap are available.
+static void pmm_init_magazines(uint level) {
+  zx_status_t status = pmm_node.EnableMagazines(gBootOptions->pmm_magazine_pages);
+  if (status != ZX_OK) {
+    printf("pmm: failed to enable per-cpu magazines: %d\n", status);
+  }
+}
+LK_INIT_HOOK(pmm_magazines, &pmm_init_magazines, LK_INIT_LEVEL_KERNEL + 1)
+
+// Group memory by the NUMA regions of the system topology, which along with the CPU distance map is
+// available from LK_INIT_LEVEL_TOPOLOGY.
+static void pmm_init_numa(uint level) {
+  if (!gBootOptions->pmm_numa_aware) {
+    return;
+  }
+
+  PmmNode::NumaConfig config;
+  // A CPU of each domain, through which the distance between domains is measured.
+  cpu_num_t domain_cpu[PmmNode::kMaxNumaDomains] = {};
+  for (system_topology::Node* processor : system_topology::GetSystemTopology().processors()) {
+    const system_topology::Node* node = processor->parent;
+    while (node && node->entity_type != ZBI_TOPOLOGY_ENTITY_NUMA_REGION) {
+      node = node->parent;
+    }
+    if (!node) {
+      continue;
+    }
+    const zbi_topology_numa_region_t& region = node->entity.numa_region;
+    // Several nodes may describe the same region, such as one for each die of a package.
+    uint8_t domain = 0;
+    while (domain < config.domain_count && (config.regions[domain].start != region.start_address ||
+                                            config.regions[domain].end != region.end_address)) {
+      domain++;
+    }
+    if (domain == config.domain_count) {
+      if (config.domain_count == PmmNode::kMaxNumaDomains ||
+          region.start_address >= region.end_address) {
+        // The memory and CPUs of this region are left in domain 0.
+        continue;
+      }
+      config.regions[domain] = {region.start_address, region.end_address};
+      domain_cpu[domain] = processor->entity.processor.logical_ids[0];
+      config.domain_count++;
+    }
+    // Logical ids are used as CPU numbers, as they are when the CPU distance map is created.
+    const zbi_topology_processor_t& info = processor->entity.processor;
+    for (uint8_t i = 0; i < info.logical_id_count; i++) {
+      if (info.logical_ids[i] < SMP_MAX_CPUS) {
+        config.cpu_domain[info.logical_ids[i]] = domain;
+      }
+    }
+  }
+  if (config.domain_count < 2) {
+    return;
+  }
+
+  // Each domain spills over into the others in order of increasing distance between their CPUs.
+  const CpuDistanceMap& distance_map = CpuDistanceMap::Get();
+  auto distance = [&](uint8_t from, uint8_t to) -> CpuDistanceMap::Distance {
+    const size_t cpu_count = distance_map.cpu_count();
+    if (domain_cpu[from] >= cpu_count || domain_cpu[to] >= cpu_count) {
+      return 0;
+    }
+    return distance_map[{domain_cpu[from], domain_cpu[to]}];
+  };
+  for (uint8_t domain = 0; domain < config.domain_count; domain++) {
+    uint8_t* order = config.spill_order[domain];
+    order[0] = domain;
+    uint8_t count = 1;
+    for (uint8_t other = 0; other < config.domain_count; other++) {
+      if (other == domain) {
+        continue;
+      }
+      // Insertion sort, keeping equidistant domains in index order.
+      uint8_t i = count++;
+      for (; i > 1 && distance(domain, order[i - 1]) > distance(domain, other); i--) {
+        order[i] = order[i - 1];
+      }
+      order[i] = other;
+    }
+  }
+
+  zx_status_t status = pmm_node.ConfigureNumaDomains(config);
+  if (status != ZX_OK) {
+    printf("pmm: failed to configure %u numa domains: %d\n", config.domain_count, status);
+    return;
+  }
+  dprintf(INFO, "pmm: memory grouped in %u numa domains\n", config.domain_count);
+}
+LK_INIT_HOOK(pmm_numa, &pmm_init_numa, LK_INIT_LEVEL_TOPOLOGY + 1)
+
+static void pmm_init_compression(uint level) {
+  if (!gBootOptions->vm_compression) {
+    return;
+  }
+  fbl::AllocChecker ac;
+  page_compression =
+      new (&ac) VmCompression(size_t{gBootOptions->vm_compression_max_storage_mb} * MB);
+  ASSERT(ac.check());
+  dprintf(INFO, "pmm: anonymous page compression enabled with %uMB of storage\n",
+          gBootOptions->vm_compression_max_storage_mb);
+}
+LK_INIT_HOOK(pmm_compression, &pmm_init_compression, LK_INIT_LEVEL_VM)
+
 vm_page_t* paddr_to_vm_page(paddr_t addr) { return pmm_node.PaddrToPage(addr); }
 
 zx_status_t pmm_add_arena(const pmm_arena_info_t* info) { return pmm_node.AddArena(info); }
@@ -164,10 +275,28 @@ uint64_t pmm_count_loan_cancelled_pages() { return pmm_node.CountLoanCancelledPa
 
 uint64_t pmm_count_total_bytes() { return pmm_node.CountTotalBytes(); }
 
+size_t pmm_num_numa_domains() { return pmm_node.NumNumaDomains(); }
+
+zx_status_t pmm_get_numa_domain_stats(size_t domain, pmm_numa_domain_stats_t* stats) {
+  if (domain >= PmmNode::kMaxNumaDomains) {
+    return ZX_ERR_OUT_OF_RANGE;
+  }
+  PmmNode::NumaDomainStats domain_stats;
+  zx_status_t status = pmm_node.GetNumaDomainStats(static_cast<uint8_t>(domain), &domain_stats);
+  if (status != ZX_OK) {
+    return status;
+  }
+  stats->total_pages = domain_stats.total_pages;
+  stats->free_pages = domain_stats.free_pages;
+  return ZX_OK;
+}
+
 PageQueues* pmm_page_queues() { return pmm_node.GetPageQueues(); }
 
 Evictor* pmm_evictor() { return pmm_node.GetEvictor(); }
 
+VmCompression* pmm_page_compression() { return page_compression; }
+
 PhysicalPageBorrowingConfig* pmm_physical_page_borrowing_config() {
   // singleton
   return &ppb_config;
@@ -35,6 +35,10 @@ class PmmArena : public fbl::DoublyLinkedListable<PmmArena*> {
   size_t size() const { return info_.size; }
   unsigned int flags() const { return info_.flags; }
 
+  // The NUMA domain of the arena's memory, see |PmmNode::ConfigureNumaDomains|.
+  uint8_t numa_domain() const { return numa_domain_; }
+  void set_numa_domain(uint8_t numa_domain) { numa_domain_ = numa_domain; }
+
   // Counts the number of pages in every state. For each page in the arena,
   // increments the corresponding vm_page_state::*-indexed entry of
   // |state_count|. Does not zero out the entries first.
@@ -75,6 +79,7 @@ class PmmArena : public fbl::DoublyLinkedListable<PmmArena*> {
   // The index into |page_array_| at which the next |FindFreeContiguous| serach
   // should begin.  Used to optimize |FindFreeContiguous|.
   uint64_t search_hint_ = 0;
+  uint8_t numa_domain_ = 0;
 };
 
 #endif  // ZIRCON_KERNEL_VM_PMM_ARENA_H_
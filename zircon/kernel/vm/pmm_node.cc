@@ -19,6 +19,7 @@
 #include <fbl/algorithm.h>
 #include <kernel/auto_preempt_disabler.h>
 #include <kernel/mp.h>
+#include <kernel/percpu.h>
 #include <kernel/thread.h>
 #include <pretty/cpp/sizes.h>
 #include <vm/bootalloc.h>
@@ -37,6 +38,17 @@ using pretty::FormattedBytes;
 // The number of PMM allocation calls that have failed.
 KCOUNTER(pmm_alloc_failed, "vm.pmm.alloc.failed")
 KCOUNTER(pmm_alloc_delayed, "vm.pmm.alloc.delayed")
+// Single page allocations served from, or missing in, a per-CPU magazine.  The hit rate of the
+// magazines is hit / (hit + miss).
+KCOUNTER(pmm_magazine_hit, "vm.pmm.magazine.hit")
+KCOUNTER(pmm_magazine_miss, "vm.pmm.magazine.miss")
+// Pages moved from the free list into a magazine, and from a magazine back to the free list.
+KCOUNTER(pmm_magazine_refill_pages, "vm.pmm.magazine.refill_pages")
+KCOUNTER(pmm_magazine_drain_pages, "vm.pmm.magazine.drain_pages")
+// Pages allocated from the free list of the allocating CPU's NUMA domain, and pages that had to be
+// allocated from another domain as the local one had no free pages.
+KCOUNTER(pmm_numa_local_alloc_pages, "vm.pmm.numa.local_alloc_pages")
+KCOUNTER(pmm_numa_spilled_alloc_pages, "vm.pmm.numa.spilled_alloc_pages")
 
 namespace {
 
@@ -159,9 +171,11 @@ void PmmNode::AddFreePages(list_node* list) TA_NO_THREAD_SAFETY_ANALYSIS {
     DEBUG_ASSERT(!page->is_loaned());
     DEBUG_ASSERT(!page->is_loan_cancelled());
     DEBUG_ASSERT(page->is_free());
-    list_add_tail(&free_list_, &page->queue_node);
+    // Arenas are only assigned to NUMA domains once the topology is known.
+    list_add_tail(&numa_domains_[0].free_list, &page->queue_node);
     ++free_count;
   }
+  numa_domains_[0].free_count += free_count;
   free_count_.fetch_add(free_count);
   ASSERT(free_count_);
   free_pages_evt_.Signal();
@@ -177,8 +191,10 @@ void PmmNode::FillFreePagesAndArm() {
   }
 
   vm_page* page;
-  list_for_every_entry (&free_list_, page, vm_page, queue_node) {
-    checker_.FillPattern(page);
+  for (NumaDomain& domain : numa_domains_) {
+    list_for_every_entry (&domain.free_list, page, vm_page, queue_node) {
+      checker_.FillPattern(page);
+    }
   }
   list_for_every_entry (&free_loaned_list_, page, vm_page, queue_node) {
     checker_.FillPattern(page);
@@ -200,9 +216,14 @@ void PmmNode::CheckAllFreePages() {
   uint64_t free_page_count = 0;
   uint64_t free_loaned_page_count = 0;
   vm_page* page;
-  list_for_every_entry (&free_list_, page, vm_page, queue_node) {
-    checker_.AssertPattern(page);
-    ++free_page_count;
+  for (NumaDomain& domain : numa_domains_) {
+    uint64_t domain_free_page_count = 0;
+    list_for_every_entry (&domain.free_list, page, vm_page, queue_node) {
+      checker_.AssertPattern(page);
+      ++domain_free_page_count;
+    }
+    ASSERT(domain_free_page_count == domain.free_count);
+    free_page_count += domain_free_page_count;
   }
   list_for_every_entry (&free_loaned_list_, page, vm_page, queue_node) {
     checker_.AssertPattern(page);
@@ -218,9 +239,11 @@ void PmmNode::PoisonAllFreePages() {
   Guard<Mutex> guard{&lock_};
 
   vm_page* page;
-  list_for_every_entry (&free_list_, page, vm_page, queue_node) {
-    AsanPoisonPage(page, kAsanPmmFreeMagic);
-  };
+  for (NumaDomain& domain : numa_domains_) {
+    list_for_every_entry (&domain.free_list, page, vm_page, queue_node) {
+      AsanPoisonPage(page, kAsanPmmFreeMagic);
+    };
+  }
   list_for_every_entry (&free_loaned_list_, page, vm_page, queue_node) {
     AsanPoisonPage(page, kAsanPmmFreeMagic);
   };
@@ -228,7 +251,12 @@ void PmmNode::PoisonAllFreePages() {
 #endif  // __has_feature(address_sanitizer)
 
 void PmmNode::EnableFreePageFilling(size_t fill_size, PmmChecker::Action action) {
+  AutoPreemptDisabler preempt_disable;
   Guard<Mutex> guard{&lock_};
+  // Pages in a magazine are never filled, so bypass and empty the magazines while the checker is in
+  // use.
+  magazine_capacity_.store(0, ktl::memory_order_relaxed);
+  DrainMagazinesLocked();
   checker_.SetFillSize(fill_size);
   checker_.SetAction(action);
   free_fill_enabled_ = true;
@@ -238,6 +266,7 @@ void PmmNode::DisableChecker() {
   Guard<Mutex> guard{&lock_};
   checker_.Disarm();
   free_fill_enabled_ = false;
+  magazine_capacity_.store(magazine_max_capacity_, ktl::memory_order_release);
 }
 
 void PmmNode::AllocPageHelperLocked(vm_page_t* page) {
@@ -270,6 +299,17 @@ void PmmNode::AllocPageHelperLocked(vm_page_t* page) {
 zx_status_t PmmNode::AllocPage(uint alloc_flags, vm_page_t** page_out, paddr_t* pa_out) {
   DEBUG_ASSERT(Thread::Current::memory_allocation_state().IsEnabled());
   AutoPreemptDisabler preempt_disable;
+
+  if (vm_page* page = AllocPageFromMagazine(alloc_flags); page) {
+    if (pa_out) {
+      *pa_out = page->paddr();
+    }
+    if (page_out) {
+      *page_out = page;
+    }
+    return ZX_OK;
+  }
+
   Guard<Mutex> guard{&lock_};
 
   // If the caller sets PMM_ALLOC_FLAG_MUST_BORROW, the caller must also set
@@ -281,7 +321,6 @@ zx_status_t PmmNode::AllocPage(uint alloc_flags, vm_page_t** page_out, paddr_t*
                           !!(alloc_flags & PMM_ALLOC_FLAG_CAN_BORROW);
   const bool must_borrow = can_borrow && !!(alloc_flags & PMM_ALLOC_FLAG_MUST_BORROW);
   const bool use_loaned_list = can_borrow && (!list_is_empty(&free_loaned_list_) || must_borrow);
-  list_node* const which_list = use_loaned_list ? &free_loaned_list_ : &free_list_;
 
   // Note that we do not care if the allocation is happening from the loaned list or not since if
   // we are in the OOM state we still want to preference those loaned pages to allocations that
@@ -291,7 +330,18 @@ zx_status_t PmmNode::AllocPage(uint alloc_flags, vm_page_t** page_out, paddr_t*
     return ZX_ERR_SHOULD_WAIT;
   }
 
-  vm_page* page = list_remove_head_type(which_list, vm_page, queue_node);
+  vm_page* page;
+  if (use_loaned_list) {
+    page = list_remove_head_type(&free_loaned_list_, vm_page, queue_node);
+  } else {
+    const uint8_t domain = CurrentNumaDomain();
+    page = RemoveHeadFromFreeListsLocked(domain);
+    if (!page) {
+      // Pages may be sitting in the magazines of other CPUs, give those a chance before failing.
+      DrainMagazinesLocked();
+      page = RemoveHeadFromFreeListsLocked(domain);
+    }
+  }
   if (!page) {
     if (!must_borrow) {
       // Allocation failures from the regular free list are likely to become user-visible.
@@ -307,6 +357,7 @@ zx_status_t PmmNode::AllocPage(uint alloc_flags, vm_page_t** page_out, paddr_t*
     DecrementFreeLoanedCountLocked(1);
   } else {
     DecrementFreeCountLocked(1);
+    RefillMagazineLocked();
   }
 
   if (pa_out) {
@@ -363,6 +414,12 @@ zx_status_t PmmNode::AllocPages(size_t count, uint alloc_flags, list_node* list)
     available_count += free_loaned_count;
   }
 
+  if (unlikely(count > available_count) && !must_borrow) {
+    DrainMagazinesLocked();
+    free_count = free_count_.load(ktl::memory_order_relaxed);
+    available_count = free_count + free_loaned_count;
+  }
+
   if (unlikely(count > available_count)) {
     if ((alloc_flags & PMM_ALLOC_FLAG_CAN_WAIT) && !never_return_should_wait_) {
       pmm_alloc_delayed.Add(1);
@@ -396,45 +453,55 @@ zx_status_t PmmNode::AllocPages(size_t count, uint alloc_flags, list_node* list)
 
   DecrementFreeLoanedCountLocked(from_loaned_free);
 
-  do {
-    DEBUG_ASSERT(count == from_loaned_free + from_free);
-    list_node* which_list;
-    size_t which_count;
-    if (can_borrow && !list_is_empty(&free_loaned_list_)) {
-      which_list = &free_loaned_list_;
-      which_count = from_loaned_free;
-      from_loaned_free = 0;
-    } else {
-      DEBUG_ASSERT(!must_borrow);
-      which_list = &free_list_;
-      which_count = from_free;
-      from_free = 0;
-    }
-    count -= which_count;
-
-    DEBUG_ASSERT(which_count > 0);
-    auto node = which_list;
-    while (which_count > 0) {
-      node = list_next(which_list, node);
-      DEBUG_ASSERT(can_borrow || !containerof(node, vm_page, queue_node)->is_loaned());
-      AllocPageHelperLocked(containerof(node, vm_page, queue_node));
-      --which_count;
-    }
+  if (from_loaned_free > 0) {
+    DEBUG_ASSERT(can_borrow);
+    AllocListPrefixLocked(&free_loaned_list_, from_loaned_free, list);
+  }
 
-    list_node tmp_list = LIST_INITIAL_VALUE(tmp_list);
-    list_split_after(which_list, node, &tmp_list);
-    if (list_is_empty(list)) {
-      list_move(which_list, list);
+  // Take the remaining pages from the domains in the spill order of the current CPU's domain.  The
+  // domain free counts add up to the free count checked above, so this finds every page.
+  const uint8_t local_domain = CurrentNumaDomain();
+  for (uint8_t i = 0; from_free > 0; i++) {
+    DEBUG_ASSERT(!must_borrow);
+    DEBUG_ASSERT(i < numa_domain_count_.load(ktl::memory_order_relaxed));
+    NumaDomain& domain = numa_domains_[numa_domains_[local_domain].spill_order[i]];
+    const uint64_t domain_count = ktl::min(from_free, domain.free_count);
+    if (domain_count == 0) {
+      continue;
+    }
+    AllocListPrefixLocked(&domain.free_list, domain_count, list);
+    domain.free_count -= domain_count;
+    from_free -= domain_count;
+    if (i == 0) {
+      pmm_numa_local_alloc_pages.Add(static_cast<int64_t>(domain_count));
     } else {
-      list_splice_after(which_list, list_peek_tail(list));
+      pmm_numa_spilled_alloc_pages.Add(static_cast<int64_t>(domain_count));
     }
-    list_move(&tmp_list, which_list);
-    DEBUG_ASSERT(count == from_loaned_free + from_free);
-  } while (count > 0);
+  }
 
   return ZX_OK;
 }
 
+void PmmNode::AllocListPrefixLocked(list_node* free_list, size_t count, list_node* list) {
+  DEBUG_ASSERT(count > 0);
+  auto node = free_list;
+  for (size_t i = 0; i < count; i++) {
+    node = list_next(free_list, node);
+    DEBUG_ASSERT(free_list == &free_loaned_list_ ||
+                 !containerof(node, vm_page, queue_node)->is_loaned());
+    AllocPageHelperLocked(containerof(node, vm_page, queue_node));
+  }
+
+  list_node tmp_list = LIST_INITIAL_VALUE(tmp_list);
+  list_split_after(free_list, node, &tmp_list);
+  if (list_is_empty(list)) {
+    list_move(free_list, list);
+  } else {
+    list_splice_after(free_list, list_peek_tail(list));
+  }
+  list_move(&tmp_list, free_list);
+}
+
 zx_status_t PmmNode::AllocRange(paddr_t address, size_t count, list_node* list) {
   LTRACEF("address %#" PRIxPTR ", count %zu\n", address, count);
 
@@ -455,6 +522,9 @@ zx_status_t PmmNode::AllocRange(paddr_t address, size_t count, list_node* list)
   AutoPreemptDisabler preempt_disable;
   Guard<Mutex> guard{&lock_};
 
+  // Any of the requested pages might be held in a magazine, where they are not FREE.
+  DrainMagazinesLocked();
+
   // walk through the arenas, looking to see if the physical page belongs to it
   for (auto& a : arena_list_) {
     for (; allocated < count && a.address_in_arena(address); address += PAGE_SIZE) {
@@ -475,7 +545,7 @@ zx_status_t PmmNode::AllocRange(paddr_t address, size_t count, list_node* list)
         break;
       }
 
-      list_delete(&page->queue_node);
+      RemoveFromFreeListLocked(page, a.numa_domain());
 
       AllocPageHelperLocked(page);
 
@@ -520,36 +590,46 @@ zx_status_t PmmNode::AllocContiguous(const size_t count, uint alloc_flags, uint8
   AutoPreemptDisabler preempt_disable;
   Guard<Mutex> guard{&lock_};
 
-  for (auto& a : arena_list_) {
-    // FindFreeContiguous will search the arena for FREE pages. As we hold lock_, any pages in the
-    // FREE state are assumed to be owned by us, and would only be modified if lock_ were held.
-    vm_page_t* p = a.FindFreeContiguous(count, alignment_log2);
-    if (!p) {
-      continue;
+  // Pages held in magazines are not FREE and so can break up an otherwise free run.  Search once
+  // as is, and should that fail search again after returning the magazines to the free list.
+  for (int attempt = 0; attempt < 2; attempt++) {
+    if (attempt > 0) {
+      if (CountMagazinePages() == 0) {
+        break;
+      }
+      DrainMagazinesLocked();
     }
+    for (auto& a : arena_list_) {
+      // FindFreeContiguous will search the arena for FREE pages. As we hold lock_, any pages in the
+      // FREE state are assumed to be owned by us, and would only be modified if lock_ were held.
+      vm_page_t* p = a.FindFreeContiguous(count, alignment_log2);
+      if (!p) {
+        continue;
+      }
 
-    *pa = p->paddr();
+      *pa = p->paddr();
 
-    // remove the pages from the run out of the free list
-    for (size_t i = 0; i < count; i++, p++) {
-      DEBUG_ASSERT_MSG(p->is_free(), "p %p state %u\n", p, static_cast<uint32_t>(p->state()));
-      // Loaned pages are never returned by FindFreeContiguous() above.
-      DEBUG_ASSERT(!p->is_loaned());
-      DEBUG_ASSERT(list_in_list(&p->queue_node));
+      // remove the pages from the run out of the free list
+      for (size_t i = 0; i < count; i++, p++) {
+        DEBUG_ASSERT_MSG(p->is_free(), "p %p state %u\n", p, static_cast<uint32_t>(p->state()));
+        // Loaned pages are never returned by FindFreeContiguous() above.
+        DEBUG_ASSERT(!p->is_loaned());
+        DEBUG_ASSERT(list_in_list(&p->queue_node));
 
-      // Atomically (that is, in a single lock acquisition) remove this page from both the free list
-      // and FREE state, ensuring it is owned by us.
-      list_delete(&p->queue_node);
-      p->set_state(vm_page_state::ALLOC);
+        // Atomically (that is, in a single lock acquisition) remove this page from both the free
+        // list and FREE state, ensuring it is owned by us.
+        RemoveFromFreeListLocked(p, a.numa_domain());
+        p->set_state(vm_page_state::ALLOC);
 
-      DecrementFreeCountLocked(1);
-      AsanUnpoisonPage(p);
-      checker_.AssertPattern(p);
+        DecrementFreeCountLocked(1);
+        AsanUnpoisonPage(p);
+        checker_.AssertPattern(p);
 
-      list_add_tail(list, &p->queue_node);
-    }
+        list_add_tail(list, &p->queue_node);
+      }
 
-    return ZX_OK;
+      return ZX_OK;
+    }
   }
 
   // We could potentially move contents of non-pinned pages out of the way for critical contiguous
@@ -602,32 +682,36 @@ void PmmNode::FreePageHelperLocked(vm_page* page) {
 
 void PmmNode::FreePage(vm_page* page) {
   AutoPreemptDisabler preempt_disable;
-  Guard<Mutex> guard{&lock_};
 
   // pages freed individually shouldn't be in a queue
   DEBUG_ASSERT(!list_in_list(&page->queue_node));
 
+  list_node overflow = LIST_INITIAL_VALUE(overflow);
+  if (FreePageToMagazine(page, &overflow)) {
+    if (!list_is_empty(&overflow)) {
+      Guard<Mutex> guard{&lock_};
+      FreeListLocked(&overflow);
+    }
+    return;
+  }
+
+  Guard<Mutex> guard{&lock_};
+
   FreePageHelperLocked(page);
 
-  list_node* which_list = nullptr;
+  // Add the page to the appropriate free queue, unless loan_cancelled.  The loan_cancelled pages
+  // don't go in any free queue because they shouldn't get re-used until reclaimed by their
+  // underlying contiguous VMO or until that underlying contiguous VMO is deleted.
   if (!page->is_loaned()) {
     IncrementFreeCountLocked(1);
-    which_list = &free_list_;
+    AddToFreeListLocked(page);
   } else if (!page->is_loan_cancelled()) {
     IncrementFreeLoanedCountLocked(1);
-    which_list = &free_loaned_list_;
-  }
-
-  // Add the page to the appropriate free queue, unless loan_cancelled.  The loan_cancelled pages
-  // don't go in any free queue because they shouldn't get re-used until reclaimed by their
-  // underlying contiguous VMO or until that underlying contiguous VMO is deleted.
-  DEBUG_ASSERT(which_list || page->is_loan_cancelled());
-  if (which_list) {
     if constexpr (!__has_feature(address_sanitizer)) {
-      list_add_head(which_list, &page->queue_node);
+      list_add_head(&free_loaned_list_, &page->queue_node);
     } else {
       // If address sanitizer is enabled, put the page at the tail to maximize reuse distance.
-      list_add_tail(which_list, &page->queue_node);
+      list_add_tail(&free_loaned_list_, &page->queue_node);
     }
   }
 }
@@ -636,6 +720,15 @@ void PmmNode::FreeListLocked(list_node* list) {
   DEBUG_ASSERT(list);
 
   // process list backwards so the head is as hot as possible
+  // Pages that remain in |list| are returned to domain 0, pages of any other NUMA domain are moved
+  // to the corresponding entry of |freed_domain_lists|.
+  const uint8_t domain_count = numa_domain_count_.load(ktl::memory_order_relaxed);
+  list_node freed_domain_lists[kMaxNumaDomains];
+  uint64_t domain_counts[kMaxNumaDomains] = {};
+  for (uint8_t i = 1; i < domain_count; i++) {
+    list_initialize(&freed_domain_lists[i]);
+  }
+
   uint64_t count = 0;
   uint64_t loaned_count = 0;
   list_node freed_loaned_list = LIST_INITIAL_VALUE(freed_loaned_list);
@@ -653,29 +746,38 @@ void PmmNode::FreeListLocked(list_node* list) {
           ++loaned_count;
         }
       } else {
+        const uint8_t domain = domain_count > 1 ? PageNumaDomain(page) : 0;
+        if (domain != 0) {
+          list_delete(&page->queue_node);
+          list_add_head(&freed_domain_lists[domain], &page->queue_node);
+        }
+        domain_counts[domain]++;
         count++;
       }
       page = next_page;
     }
   }  // end scope page
 
-  if constexpr (!__has_feature(address_sanitizer)) {
-    // splice list at the head of free_list_; free_loaned_list_.
-    list_splice_after(list, &free_list_);
-    list_splice_after(&freed_loaned_list, &free_loaned_list_);
-  } else {
-    // If address sanitizer is enabled, put the pages at the tail to maximize reuse distance.
-    if (!list_is_empty(&free_list_)) {
-      list_splice_after(list, list_peek_tail(&free_list_));
-    } else {
-      list_splice_after(list, &free_list_);
-    }
-    if (!list_is_empty(&free_loaned_list_)) {
-      list_splice_after(&freed_loaned_list, list_peek_tail(&free_loaned_list_));
+  auto splice = [](list_node* pages, list_node* free_list) {
+    if constexpr (!__has_feature(address_sanitizer)) {
+      // splice pages at the head of the free list.
+      list_splice_after(pages, free_list);
     } else {
-      list_splice_after(&freed_loaned_list, &free_loaned_list_);
+      // If address sanitizer is enabled, put the pages at the tail to maximize reuse distance.
+      if (!list_is_empty(free_list)) {
+        list_splice_after(pages, list_peek_tail(free_list));
+      } else {
+        list_splice_after(pages, free_list);
+      }
     }
+  };
+  splice(list, &numa_domains_[0].free_list);
+  numa_domains_[0].free_count += domain_counts[0];
+  for (uint8_t i = 1; i < domain_count; i++) {
+    splice(&freed_domain_lists[i], &numa_domains_[i].free_list);
+    numa_domains_[i].free_count += domain_counts[i];
   }
+  splice(&freed_loaned_list, &free_loaned_list_);
 
   IncrementFreeCountLocked(count);
   IncrementFreeLoanedCountLocked(loaned_count);
@@ -683,8 +785,30 @@ void PmmNode::FreeListLocked(list_node* list) {
 
 void PmmNode::FreeList(list_node* list) {
   AutoPreemptDisabler preempt_disable;
+
+  // Top up the current CPU's magazine from the head of the list. Once the magazine declines a page,
+  // or overflows, the remainder is freed under a single acquisition of lock_.
+  list_node overflow = LIST_INITIAL_VALUE(overflow);
+  vm_page* page;
+  while ((page = list_peek_head_type(list, vm_page, queue_node)) != nullptr) {
+    list_delete(&page->queue_node);
+    if (!FreePageToMagazine(page, &overflow)) {
+      list_add_head(list, &page->queue_node);
+      break;
+    }
+    if (!list_is_empty(&overflow)) {
+      break;
+    }
+  }
+  if (list_is_empty(list) && list_is_empty(&overflow)) {
+    return;
+  }
+
   Guard<Mutex> guard{&lock_};
 
+  if (!list_is_empty(&overflow)) {
+    FreeListLocked(&overflow);
+  }
   FreeListLocked(list);
 }
 
@@ -740,11 +864,17 @@ void PmmNode::Dump(bool is_panic) const {
   auto dump = [this]() TA_NO_THREAD_SAFETY_ANALYSIS {
     uint64_t free_count = free_count_.load(ktl::memory_order_relaxed);
     uint64_t free_loaned_count = free_loaned_count_.load(ktl::memory_order_relaxed);
+    uint64_t magazine_count = CountMagazinePages();
     printf(
-        "pmm node %p: free_count %zu (%zu bytes), free_loaned_count: %zu (%zu bytes), total size "
-        "%zu\n",
+        "pmm node %p: free_count %zu (%zu bytes), free_loaned_count: %zu (%zu bytes), "
+        "magazine_count: %zu (%zu bytes), total size %zu\n",
         this, free_count, free_count * PAGE_SIZE, free_loaned_count, free_loaned_count * PAGE_SIZE,
-        arena_cumulative_size_);
+        magazine_count, magazine_count * PAGE_SIZE, arena_cumulative_size_);
+    const uint8_t domain_count = numa_domain_count_.load(ktl::memory_order_relaxed);
+    for (uint8_t i = 0; domain_count > 1 && i < domain_count; i++) {
+      printf("  numa domain %u: free_count %zu (%zu bytes)\n", i, numa_domains_[i].free_count,
+             numa_domains_[i].free_count * PAGE_SIZE);
+    }
     for (auto& a : arena_list_) {
       a.Dump(false, false);
     }
@@ -1003,6 +1133,7 @@ void PmmNode::DeleteLender(paddr_t address, size_t count) {
   ForPagesInPhysRangeLocked(address, count,
                             [this, &removed_free_loaned_count, &loan_un_cancelled_count,
                              &added_free_count, &loan_ended_count](vm_page_t* page) {
+                              AssertHeld(lock_);
                               DEBUG_ASSERT(page->is_loaned());
                               if (page->is_free() && !page->is_loan_cancelled()) {
                                 // Remove from free_loaned_list_.
@@ -1012,19 +1143,13 @@ void PmmNode::DeleteLender(paddr_t address, size_t count) {
                               if (page->is_loan_cancelled()) {
                                 ++loan_un_cancelled_count;
                               }
+                              page->clear_is_loan_cancelled();
+                              page->clear_is_loaned();
                               if (page->is_free()) {
                                 // add it to the free queue
-                                if constexpr (!__has_feature(address_sanitizer)) {
-                                  list_add_head(&free_list_, &page->queue_node);
-                                } else {
-                                  // If address sanitizer is enabled, put the page at the tail to
-                                  // maximize reuse distance.
-                                  list_add_tail(&free_list_, &page->queue_node);
-                                }
+                                AddToFreeListLocked(page);
                                 added_free_count++;
                               }
-                              page->clear_is_loan_cancelled();
-                              page->clear_is_loaned();
                               ++loan_ended_count;
                             });
 
@@ -1073,6 +1198,357 @@ void PmmNode::ForPagesInPhysRangeLocked(paddr_t start, size_t count, F func) {
   DEBUG_ASSERT(page_addr == end);
 }
 
+zx_status_t PmmNode::EnableMagazines(size_t pages_per_cpu) {
+  DEBUG_ASSERT(!magazines_);
+  // Pages move between a magazine and the free list in batches of half the capacity, a capacity of
+  // less than two would make every free and allocation miss.
+  if (pages_per_cpu < 2) {
+    return ZX_OK;
+  }
+
+  const size_t cpu_count = percpu::processor_count();
+  DEBUG_ASSERT(cpu_count != 0);
+
+  fbl::AllocChecker ac;
+  ktl::unique_ptr<PageMagazine[]> magazines{new (&ac) PageMagazine[cpu_count]};
+  if (!ac.check()) {
+    return ZX_ERR_NO_MEMORY;
+  }
+
+  Guard<Mutex> guard{&lock_};
+  magazines_ = ktl::move(magazines);
+  magazine_count_ = cpu_count;
+  magazine_max_capacity_ = pages_per_cpu;
+  // The free fill checker requires every free page to be on a free list, so the magazines will be
+  // enabled by |DisableChecker| instead.
+  if (!free_fill_enabled_) {
+    magazine_capacity_.store(pages_per_cpu, ktl::memory_order_release);
+  }
+  return ZX_OK;
+}
+
+PmmNode::PageMagazine* PmmNode::CurrentMagazine() {
+  if (magazine_capacity_.load(ktl::memory_order_acquire) == 0) {
+    return nullptr;
+  }
+  const cpu_num_t cpu = arch_curr_cpu_num();
+  DEBUG_ASSERT(cpu < magazine_count_);
+  return &magazines_[cpu];
+}
+
+vm_page* PmmNode::AllocPageFromMagazine(uint alloc_flags) {
+  // Magazines only hold regular pages. Allocations that must, or would prefer to, borrow a loaned
+  // page go through the free lists so that loaned pages keep being preferred.
+  if (alloc_flags & (PMM_ALLOC_FLAG_LO_MEM | PMM_ALLOC_FLAG_MUST_BORROW)) {
+    return nullptr;
+  }
+  if ((alloc_flags & PMM_ALLOC_FLAG_CAN_BORROW) &&
+      pmm_physical_page_borrowing_config()->is_any_borrowing_enabled() &&
+      CountLoanedFreePages() > 0) {
+    return nullptr;
+  }
+
+  PageMagazine* magazine = CurrentMagazine();
+  if (!magazine) {
+    return nullptr;
+  }
+
+  vm_page* page;
+  {
+    Guard<Mutex> guard{&magazine->lock};
+    page = list_remove_head_type(&magazine->pages, vm_page, queue_node);
+    if (!page) {
+      pmm_magazine_miss.Add(1);
+      return nullptr;
+    }
+    magazine->count--;
+  }
+  pmm_magazine_hit.Add(1);
+
+  DEBUG_ASSERT(page->state() == vm_page_state::CACHE);
+  DEBUG_ASSERT(!page->is_loaned());
+  AsanUnpoisonPage(page);
+  page->set_state(vm_page_state::ALLOC);
+  return page;
+}
+
+void PmmNode::RefillMagazineLocked() {
+  // Hoarding pages is counter productive once the system is out of memory.
+  if (mem_avail_state_cur_index_ == 0) {
+    return;
+  }
+
+  PageMagazine* magazine = CurrentMagazine();
+  if (!magazine) {
+    return;
+  }
+
+  // Magazines only ever hold pages of the CPU's own NUMA domain, as pages allocated from them are
+  // not subject to the spill over order.
+  NumaDomain& domain = numa_domains_[CurrentNumaDomain()];
+  uint64_t moved = 0;
+  {
+    Guard<Mutex> guard{&magazine->lock};
+    // Re-check the capacity under the magazine lock to synchronize with |DrainMagazines|.
+    const size_t capacity = magazine_capacity_.load(ktl::memory_order_relaxed);
+    const size_t target = capacity / 2;
+    while (magazine->count < target) {
+      vm_page* page = list_remove_head_type(&domain.free_list, vm_page, queue_node);
+      if (!page) {
+        break;
+      }
+      DEBUG_ASSERT(page->is_free());
+      DEBUG_ASSERT(!page->is_loaned());
+      // Remaining poisoned while in the magazine, the page is unpoisoned when handed out.
+      page->set_state(vm_page_state::CACHE);
+      list_add_tail(&magazine->pages, &page->queue_node);
+      magazine->count++;
+      moved++;
+    }
+  }
+
+  if (moved > 0) {
+    pmm_magazine_refill_pages.Add(static_cast<int64_t>(moved));
+    domain.free_count -= moved;
+    DecrementFreeCountLocked(moved);
+  }
+}
+
+bool PmmNode::FreePageToMagazine(vm_page* page, list_node* overflow) {
+  DEBUG_ASSERT(!list_in_list(&page->queue_node));
+  if (page->is_loaned()) {
+    return false;
+  }
+
+  PageMagazine* magazine = CurrentMagazine();
+  if (!magazine) {
+    return false;
+  }
+  // Pages of another NUMA domain go back to the free list of their domain.
+  if (numa_domain_count_.load(ktl::memory_order_acquire) > 1 &&
+      PageNumaDomain(page) != CurrentNumaDomain()) {
+    return false;
+  }
+
+  LTRACEF("page %p state %zu paddr %#" PRIxPTR "\n", page, VmPageStateIndex(page->state()),
+          page->paddr());
+  DEBUG_ASSERT(!page->is_free());
+  DEBUG_ASSERT(page->state() != vm_page_state::OBJECT || page->object.pin_count == 0);
+  // Only borrowed pages are ever stack owned.
+  DEBUG_ASSERT(!page->object.is_stack_owned());
+
+  Guard<Mutex> guard{&magazine->lock};
+  const size_t capacity = magazine_capacity_.load(ktl::memory_order_relaxed);
+  if (capacity == 0) {
+    return false;
+  }
+
+  if (magazine->count >= capacity) {
+    // Spill the coldest half of the magazine for the caller to return to the free list.
+    const size_t spill = capacity / 2;
+    list_node* node = &magazine->pages;
+    for (size_t i = 0; i < capacity - spill; i++) {
+      node = list_next(&magazine->pages, node);
+    }
+    list_split_after(&magazine->pages, node, overflow);
+    magazine->count -= spill;
+    pmm_magazine_drain_pages.Add(static_cast<int64_t>(spill));
+  }
+
+  page->set_state(vm_page_state::CACHE);
+  AsanPoisonPage(page, kAsanPmmFreeMagic);
+  if constexpr (!__has_feature(address_sanitizer)) {
+    list_add_head(&magazine->pages, &page->queue_node);
+  } else {
+    // If address sanitizer is enabled, put the page at the tail to maximize reuse distance.
+    list_add_tail(&magazine->pages, &page->queue_node);
+  }
+  magazine->count++;
+  return true;
+}
+
+void PmmNode::DrainMagazinesLocked() {
+  if (!magazines_) {
+    return;
+  }
+
+  list_node drained = LIST_INITIAL_VALUE(drained);
+  uint64_t count = 0;
+  for (size_t i = 0; i < magazine_count_; i++) {
+    PageMagazine& magazine = magazines_[i];
+    Guard<Mutex> guard{&magazine.lock};
+    count += magazine.count;
+    magazine.count = 0;
+    list_splice_after(&magazine.pages, &drained);
+  }
+
+  if (count > 0) {
+    pmm_magazine_drain_pages.Add(static_cast<int64_t>(count));
+    FreeListLocked(&drained);
+  }
+}
+
+void PmmNode::DrainMagazines() {
+  AutoPreemptDisabler preempt_disable;
+  Guard<Mutex> guard{&lock_};
+  DrainMagazinesLocked();
+}
+
+uint64_t PmmNode::CountMagazinePages() const TA_NO_THREAD_SAFETY_ANALYSIS {
+  if (!magazines_) {
+    return 0;
+  }
+  // Racy by design; this is only used for diagnostics and as a hint.
+  uint64_t count = 0;
+  for (size_t i = 0; i < magazine_count_; i++) {
+    count += magazines_[i].count;
+  }
+  return count;
+}
+
+zx_status_t PmmNode::ConfigureNumaDomains(const NumaConfig& config) {
+  if (config.domain_count == 0 || config.domain_count > kMaxNumaDomains) {
+    return ZX_ERR_INVALID_ARGS;
+  }
+  for (uint8_t domain : config.cpu_domain) {
+    if (domain >= config.domain_count) {
+      return ZX_ERR_INVALID_ARGS;
+    }
+  }
+  for (uint8_t i = 0; i < config.domain_count; i++) {
+    if (config.regions[i].start >= config.regions[i].end ||
+        config.spill_order[i][0] != i) {
+      return ZX_ERR_INVALID_ARGS;
+    }
+    uint32_t seen = 0;
+    for (uint8_t j = 0; j < config.domain_count; j++) {
+      const uint8_t domain = config.spill_order[i][j];
+      if (domain >= config.domain_count || (seen & (1u << domain))) {
+        return ZX_ERR_INVALID_ARGS;
+      }
+      seen |= 1u << domain;
+    }
+  }
+
+  AutoPreemptDisabler preempt_disable;
+  Guard<Mutex> guard{&lock_};
+  if (numa_domains_configured_) {
+    return ZX_ERR_BAD_STATE;
+  }
+  numa_domains_configured_ = true;
+
+  // Magazines may hold pages that are about to become remote to their CPU.
+  DrainMagazinesLocked();
+
+  for (auto& a : arena_list_) {
+    for (uint8_t i = 0; i < config.domain_count; i++) {
+      if (a.base() >= config.regions[i].start && a.base() < config.regions[i].end) {
+        a.set_numa_domain(i);
+        break;
+      }
+    }
+    dprintf(INFO, "PMM: arena '%s' base %#" PRIxPTR " is in NUMA domain %u\n", a.name(), a.base(),
+            a.numa_domain());
+  }
+  for (uint8_t i = 0; i < config.domain_count; i++) {
+    memcpy(numa_domains_[i].spill_order, config.spill_order[i], sizeof(config.spill_order[i]));
+  }
+  memcpy(cpu_numa_domain_, config.cpu_domain, sizeof(cpu_numa_domain_));
+  static_assert(sizeof(cpu_numa_domain_) == sizeof(config.cpu_domain));
+  numa_domain_count_.store(config.domain_count, ktl::memory_order_release);
+
+  // Every free page is currently in domain 0, move those of the other domains across.  This is a
+  // walk of the whole free list, but only happens once during boot.
+  NumaDomain& domain_zero = numa_domains_[0];
+  vm_page *page, *temp;
+  list_for_every_entry_safe (&domain_zero.free_list, page, temp, vm_page, queue_node) {
+    const uint8_t domain = PageNumaDomain(page);
+    if (domain != 0) {
+      list_delete(&page->queue_node);
+      list_add_tail(&numa_domains_[domain].free_list, &page->queue_node);
+      domain_zero.free_count--;
+      numa_domains_[domain].free_count++;
+    }
+  }
+  return ZX_OK;
+}
+
+uint8_t PmmNode::NumNumaDomains() const {
+  return numa_domain_count_.load(ktl::memory_order_acquire);
+}
+
+zx_status_t PmmNode::GetNumaDomainStats(uint8_t domain, NumaDomainStats* stats) const {
+  Guard<Mutex> guard{&lock_};
+  if (domain >= numa_domain_count_.load(ktl::memory_order_relaxed)) {
+    return ZX_ERR_OUT_OF_RANGE;
+  }
+  *stats = {};
+  for (auto& a : arena_list_) {
+    if (a.numa_domain() == domain) {
+      stats->total_pages += a.size() / PAGE_SIZE;
+    }
+  }
+  stats->free_pages = numa_domains_[domain].free_count;
+  return ZX_OK;
+}
+
+uint8_t PmmNode::PageNumaDomain(const vm_page* page) const TA_NO_THREAD_SAFETY_ANALYSIS {
+  if (numa_domain_count_.load(ktl::memory_order_acquire) == 1) {
+    return 0;
+  }
+  // The arena list and the arena domains are not modified once the domains are configured.
+  for (auto& a : arena_list_) {
+    if (a.page_belongs_to_arena(page)) {
+      return a.numa_domain();
+    }
+  }
+  return 0;
+}
+
+uint8_t PmmNode::CurrentNumaDomain() const {
+  if (numa_domain_count_.load(ktl::memory_order_acquire) == 1) {
+    return 0;
+  }
+  return cpu_numa_domain_[arch_curr_cpu_num()];
+}
+
+void PmmNode::AddToFreeListLocked(vm_page* page) {
+  DEBUG_ASSERT(!page->is_loaned());
+  NumaDomain& domain = numa_domains_[PageNumaDomain(page)];
+  if constexpr (!__has_feature(address_sanitizer)) {
+    list_add_head(&domain.free_list, &page->queue_node);
+  } else {
+    // If address sanitizer is enabled, put the page at the tail to maximize reuse distance.
+    list_add_tail(&domain.free_list, &page->queue_node);
+  }
+  domain.free_count++;
+}
+
+void PmmNode::RemoveFromFreeListLocked(vm_page* page, uint8_t domain) {
+  DEBUG_ASSERT(domain == PageNumaDomain(page));
+  DEBUG_ASSERT(numa_domains_[domain].free_count > 0);
+  list_delete(&page->queue_node);
+  numa_domains_[domain].free_count--;
+}
+
+vm_page* PmmNode::RemoveHeadFromFreeListsLocked(uint8_t domain) {
+  const uint8_t domain_count = numa_domain_count_.load(ktl::memory_order_relaxed);
+  for (uint8_t i = 0; i < domain_count; i++) {
+    NumaDomain& candidate = numa_domains_[numa_domains_[domain].spill_order[i]];
+    vm_page* page = list_remove_head_type(&candidate.free_list, vm_page, queue_node);
+    if (page) {
+      candidate.free_count--;
+      if (i == 0) {
+        pmm_numa_local_alloc_pages.Add(1);
+      } else {
+        pmm_numa_spilled_alloc_pages.Add(1);
+      }
+      return page;
+    }
+  }
+  return nullptr;
+}
+
 void PmmNode::ReportAllocFailure() {
   kcounter_add(pmm_alloc_failed, 1);
 
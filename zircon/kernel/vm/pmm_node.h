@@ -8,9 +8,11 @@
 
 #include <fbl/canary.h>
 #include <fbl/intrusive_double_list.h>
+#include <kernel/cpu.h>
 #include <kernel/event.h>
 #include <kernel/lockdep.h>
 #include <kernel/mutex.h>
+#include <ktl/unique_ptr.h>
 #include <vm/loan_sweeper.h>
 #include <vm/physical_page_borrowing_config.h>
 #include <vm/pmm.h>
@@ -134,7 +136,117 @@ class PmmNode {
 
   Evictor* GetEvictor() { return &evictor_; }
 
+  // Enable per-CPU magazines of free pages in front of the free list, each holding at most
+  // |pages_per_cpu| pages.  See |PageMagazine|.  Must be called at most once, after the percpu
+  // structures have been initialized.
+  zx_status_t EnableMagazines(size_t pages_per_cpu);
+
+  // Return every page held in a per-CPU magazine to the free list.
+  void DrainMagazines();
+
+  // Return the number of pages currently held in per-CPU magazines.  Pages in a magazine are in the
+  // CACHE state and are not included in |CountFreePages|.
+  uint64_t CountMagazinePages() const;
+
+  // The maximum number of NUMA domains that memory can be grouped in.
+  static constexpr uint8_t kMaxNumaDomains = 8;
+
+  // Describes how memory and CPUs are grouped in NUMA domains.  See |ConfigureNumaDomains|.
+  struct NumaConfig {
+    // Number of domains described, between 1 and |kMaxNumaDomains|.
+    uint8_t domain_count = 0;
+    // Physical address range [start, end) of the memory in each domain.
+    struct {
+      paddr_t start;
+      paddr_t end;
+    } regions[kMaxNumaDomains] = {};
+    // Domain of each CPU.
+    uint8_t cpu_domain[SMP_MAX_CPUS] = {};
+    // The order in which allocations made on a CPU of each domain search the domains for free
+    // pages.  The order of a domain must start with the domain itself, and contain every domain.
+    uint8_t spill_order[kMaxNumaDomains][kMaxNumaDomains] = {};
+  };
+
+  // Groups the arenas, and their free pages, by NUMA domain.  Each arena is placed in the domain
+  // whose region contains its base address, or in domain 0 if there is none.  From then on pages
+  // are allocated from the domain of the current CPU, and only spill over into the other domains,
+  // in the configured order, once that domain has no free pages.  Until this is called all memory
+  // is in domain 0.  May only be called once.
+  zx_status_t ConfigureNumaDomains(const NumaConfig& config);
+
+  // Returns the number of NUMA domains that memory is grouped in, which is always at least 1.
+  uint8_t NumNumaDomains() const;
+
+  struct NumaDomainStats {
+    // Number of pages in the arenas of the domain.
+    uint64_t total_pages = 0;
+    // Number of those pages that are on the free list.  As with |CountFreePages| this excludes
+    // both loaned pages and pages held in per-CPU magazines.
+    uint64_t free_pages = 0;
+  };
+  // Returns ZX_ERR_OUT_OF_RANGE if |domain| is not less than |NumNumaDomains|.
+  zx_status_t GetNumaDomainStats(uint8_t domain, NumaDomainStats* stats) const;
+
  private:
+  // The free, non-loaned, pages of a NUMA domain.  The sum of |free_count| across every domain is
+  // |free_count_|, which remains the count used for memory availability.
+  struct NumaDomain {
+    list_node free_list = LIST_INITIAL_VALUE(free_list);
+    uint64_t free_count = 0;
+    uint8_t spill_order[kMaxNumaDomains] = {};
+  };
+
+  // Returns the NUMA domain of |page|, or 0 if it is not in any arena.
+  uint8_t PageNumaDomain(const vm_page* page) const;
+
+  // Returns the NUMA domain of the current CPU.  Preemption must be disabled.
+  uint8_t CurrentNumaDomain() const;
+
+  // Places the non-loaned |page| on the free list of its NUMA domain.  Does not update
+  // |free_count_|.
+  void AddToFreeListLocked(vm_page* page) TA_REQ(lock_);
+
+  // Removes |page| from the free list of |domain|.  Does not update |free_count_|.
+  void RemoveFromFreeListLocked(vm_page* page, uint8_t domain) TA_REQ(lock_);
+
+  // Removes the first free page found by searching the domains in the spill order of |domain|, or
+  // returns nullptr if there are no free pages.  Does not update |free_count_|.
+  vm_page* RemoveHeadFromFreeListsLocked(uint8_t domain) TA_REQ(lock_);
+
+  // Allocates the first |count| pages of |free_list| by moving them to the tail of |list|.
+  void AllocListPrefixLocked(list_node* free_list, size_t count, list_node* list) TA_REQ(lock_);
+
+  // A per-CPU cache of free, non-loaned pages that AllocPage and FreePage consult before falling
+  // back to |free_list_|.  Pages move between a magazine and |free_list_| in batches of half the
+  // magazine capacity, so that a single acquisition of |lock_| is amortized over many faults.
+  //
+  // Lock ordering is |lock_| before |PageMagazine::lock|.  Paths that need to return pages from a
+  // magazine to the free list must drop the magazine lock before acquiring |lock_|.
+  struct alignas(MAX_CACHE_LINE) PageMagazine {
+    DECLARE_MUTEX(PageMagazine) lock;
+    list_node pages TA_GUARDED(lock) = LIST_INITIAL_VALUE(pages);
+    size_t count TA_GUARDED(lock) = 0;
+  };
+
+  // Returns the magazine of the current CPU, or nullptr if magazines are not enabled.  Preemption
+  // must be disabled.
+  PageMagazine* CurrentMagazine();
+
+  // Attempts to satisfy a single page allocation from the current CPU's magazine.  Returns nullptr
+  // if the allocation is not eligible for the magazine, or if the magazine is empty.
+  vm_page* AllocPageFromMagazine(uint alloc_flags);
+
+  // Moves up to half of the magazine capacity worth of pages from |free_list_| into the current
+  // CPU's magazine.  Does nothing while in the lowest memory availability state.
+  void RefillMagazineLocked() TA_REQ(lock_);
+
+  // Attempts to place |page| into the current CPU's magazine.  Should the magazine be full, half of
+  // it is moved to |overflow|, which the caller must then free to |free_list_|.  Returns false if
+  // |page| was not placed in the magazine.
+  bool FreePageToMagazine(vm_page* page, list_node* overflow);
+
+  void DrainMagazinesLocked() TA_REQ(lock_);
+
   void FreePageHelperLocked(vm_page* page) TA_REQ(lock_);
   void FreeListLocked(list_node* list) TA_REQ(lock_);
 
@@ -207,8 +319,13 @@ class PmmNode {
 
   fbl::SizedDoublyLinkedList<PmmArena*> arena_list_ TA_GUARDED(lock_);
 
-  // Free pages where !loaned.
-  list_node free_list_ TA_GUARDED(lock_) = LIST_INITIAL_VALUE(free_list_);
+  // Free pages where !loaned, by NUMA domain.  Only the first |numa_domain_count_| are used.
+  NumaDomain numa_domains_[kMaxNumaDomains] TA_GUARDED(lock_);
+  // Set once, under lock_, by |ConfigureNumaDomains|.  The arena domains and |cpu_numa_domain_| are
+  // only modified prior to that, and so may be read without the lock once this has been loaded.
+  ktl::atomic<uint8_t> numa_domain_count_ = 1;
+  uint8_t cpu_numa_domain_[SMP_MAX_CPUS] = {};
+  bool numa_domains_configured_ TA_GUARDED(lock_) = false;
   // Free pages where loaned && !loan_cancelled.
   list_node free_loaned_list_ TA_GUARDED(lock_) = LIST_INITIAL_VALUE(free_loaned_list_);
 
@@ -235,6 +352,14 @@ class PmmNode {
 
   bool free_fill_enabled_ TA_GUARDED(lock_) = false;
   PmmChecker checker_ TA_GUARDED(lock_);
+
+  // Per-CPU magazines, allocated by |EnableMagazines|.  |magazine_capacity_| is zero whenever the
+  // magazines must be bypassed, such as while the free fill checker is enabled, as the checker
+  // expects every free page to be on |free_list_| or |free_loaned_list_|.
+  ktl::unique_ptr<PageMagazine[]> magazines_;
+  size_t magazine_count_ = 0;
+  size_t magazine_max_capacity_ = 0;
+  ktl::atomic<size_t> magazine_capacity_ = 0;
 };
 
 // We don't need to hold the arena lock while executing this, since it is
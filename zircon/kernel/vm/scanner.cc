@@ -15,6 +15,7 @@
 #include <kernel/thread.h>
 #include <ktl/algorithm.h>
 #include <lk/init.h>
+#include <vm/compression.h>
 #include <vm/physical_page_borrowing_config.h>
 #include <vm/scanner.h>
 #include <vm/vm.h>
@@ -43,6 +44,11 @@ zx_duration_t page_table_evict_time = ZX_SEC(10);
 // set during init before the scanner thread starts up, at which point it becomes read only.
 uint64_t zero_page_scans_per_second = 0;
 
+// Maximum amount of time to spend in each of the once a second zero page scans. This is not atomic
+// as it is only set during init before the scanner thread starts up, at which point it becomes read
+// only.
+zx_duration_t zero_page_scan_budget = ZX_TIME_INFINITE;
+
 PageTableEvictionPolicy page_table_reclaim_policy = PageTableEvictionPolicy::kAlways;
 
 // Tracks what the scanner should do when it is next woken up.
@@ -75,6 +81,12 @@ KCOUNTER(zero_scan_requests, "vm.scanner.zero_scan.requests")
 KCOUNTER(zero_scan_ends_empty, "vm.scanner.zero_scan.queue_emptied")
 KCOUNTER(zero_scan_pages_scanned, "vm.scanner.zero_scan.total_pages_considered")
 KCOUNTER(zero_scan_pages_deduped, "vm.scanner.zero_scan.pages_deduped")
+KCOUNTER(zero_scan_bytes_deduped, "vm.scanner.zero_scan.bytes_deduped")
+KCOUNTER_DECLARE(zero_scan_max_pass_bytes_deduped, "vm.scanner.zero_scan.max_pass_bytes_deduped",
+                 Max)
+KCOUNTER(zero_scan_time_spent, "vm.scanner.zero_scan.time_spent_ns")
+KCOUNTER_DECLARE(zero_scan_max_pass_time, "vm.scanner.zero_scan.max_pass_time_ns", Max)
+KCOUNTER(zero_scan_budget_exhausted, "vm.scanner.zero_scan.budget_exhausted")
 
 void scanner_print_stats() {
   uint64_t zero_pages = VmObject::ScanAllForZeroPages(false);
@@ -89,6 +101,13 @@ void scanner_print_stats() {
   VmCowPages::DiscardablePageCounts counts = VmCowPages::DebugDiscardablePageCounts();
   printf("[SCAN]: Found %lu locked pages in discardable vmos\n", counts.locked);
   printf("[SCAN]: Found %lu unlocked pages in discardable vmos\n", counts.unlocked);
+  if (VmCompression* compression = pmm_page_compression()) {
+    VmCompression::Stats stats = compression->GetStats();
+    printf("[SCAN]: Found %lu compressed pages using %lu bytes of storage\n",
+           stats.compressed_pages, stats.compressed_storage_bytes);
+    printf("[SCAN]: %lu of %lu compression attempts failed, %lu pages decompressed\n",
+           stats.failed_compression_attempts, stats.compression_attempts, stats.decompressions);
+  }
   pmm_page_queues()->Dump();
 }
 
@@ -214,7 +233,8 @@ int scanner_request_thread(void *) {
     }
     if (current >= next_zero_scan_deadline || reclaim_all) {
       const uint64_t scan_limit = reclaim_all ? UINT64_MAX : zero_page_scans_per_second;
-      const uint64_t pages = scanner_do_zero_scan(scan_limit);
+      const zx_duration_t budget = reclaim_all ? ZX_TIME_INFINITE : zero_page_scan_budget;
+      const uint64_t pages = scanner_do_zero_scan(scan_limit, budget);
       if (print) {
         printf("[SCAN]: De-duped %lu pages that were recently forked from the zero page\n", pages);
       }
@@ -287,11 +307,21 @@ PageQueues::ActiveInactiveCounts scanner_synchronized_active_inactive_counts() {
   return counts;
 }
 
-uint64_t scanner_do_zero_scan(uint64_t limit) {
+uint64_t scanner_do_zero_scan(uint64_t limit, zx_duration_t budget) {
+  // Checking the time for every candidate would be a noticeable fraction of the cost of checking
+  // the page itself, so only check it every this many candidates.
+  constexpr uint64_t kCandidatesPerTimeCheck = 32;
+  const zx_time_t start = current_time();
+  const zx_time_t deadline = zx_time_add_duration(start, budget);
   uint64_t deduped = 0;
   uint64_t considered;
   zero_scan_requests.Add(1);
   for (considered = 0; considered < limit; considered++) {
+    if (considered % kCandidatesPerTimeCheck == kCandidatesPerTimeCheck - 1 &&
+        current_time() >= deadline) {
+      zero_scan_budget_exhausted.Add(1);
+      break;
+    }
     if (ktl::optional<PageQueues::VmoBacklink> backlink =
             pmm_page_queues()->PopAnonymousZeroFork()) {
       if (!backlink->cow) {
@@ -306,8 +336,18 @@ uint64_t scanner_do_zero_scan(uint64_t limit) {
     }
   }
 
+  const zx_duration_t elapsed = zx_time_sub_time(current_time(), start);
+  const uint64_t deduped_bytes = deduped * PAGE_SIZE;
   zero_scan_pages_scanned.Add(considered);
   zero_scan_pages_deduped.Add(deduped);
+  zero_scan_bytes_deduped.Add(deduped_bytes);
+  zero_scan_time_spent.Add(elapsed);
+  if (static_cast<int64_t>(deduped_bytes) > zero_scan_max_pass_bytes_deduped.ValueCurrCpu()) {
+    zero_scan_max_pass_bytes_deduped.Set(deduped_bytes);
+  }
+  if (elapsed > zero_scan_max_pass_time.ValueCurrCpu()) {
+    zero_scan_max_pass_time.Set(elapsed);
+  }
   return deduped;
 }
 
@@ -353,6 +393,9 @@ static void scanner_init_func(uint level) {
       Thread::Create("scanner-request-thread", scanner_request_thread, nullptr, LOW_PRIORITY);
   DEBUG_ASSERT(thread);
   zero_page_scans_per_second = gBootOptions->page_scanner_zero_page_scans_per_second;
+  if (gBootOptions->page_scanner_zero_page_scan_budget_us > 0) {
+    zero_page_scan_budget = ZX_USEC(gBootOptions->page_scanner_zero_page_scan_budget_us);
+  }
   if (!gBootOptions->page_scanner_start_at_boot) {
     Guard<Mutex> guard{scanner_disabled_lock::Get()};
     scanner_disable_count++;
@@ -898,6 +898,57 @@ static bool vm_mapping_attribution_merge_test() {
   END_TEST;
 }
 
+// Tests that an aligned and committed contiguous VMO is mapped correctly when it is eligible for
+// large pages, and that the mapping is correctly split when part of it is protected.
+static bool vm_mapping_large_page_test() {
+  BEGIN_TEST;
+  AutoVmScannerDisable scanner_disable;
+
+  fbl::RefPtr<VmAspace> aspace = VmAspace::Create(VmAspace::Type::User, "test-aspace");
+  ASSERT_NONNULL(aspace);
+
+  constexpr uint8_t kLargePageShift = 21;
+  constexpr size_t kLargePage = 1ul << kLargePageShift;
+  constexpr size_t kSize = 2 * kLargePage;
+  fbl::RefPtr<VmObjectPaged> vmo;
+  zx_status_t status =
+      VmObjectPaged::CreateContiguous(PMM_ALLOC_FLAG_ANY, kSize, kLargePageShift, &vmo);
+  ASSERT_EQ(ZX_OK, status);
+  paddr_t base_pa;
+  ASSERT_EQ(ZX_OK, vmo->LookupContiguous(0, kSize, &base_pa));
+
+  fbl::RefPtr<VmMapping> mapping;
+  status = aspace->RootVmar()->CreateVmMapping(0, kSize, kLargePageShift, 0, vmo, 0,
+                                               kArchRwUserFlags, "test-mapping", &mapping);
+  ASSERT_EQ(ZX_OK, status);
+  ASSERT_EQ(ZX_OK, mapping->MapRange(0, kSize, false));
+
+  auto check_range = [&](size_t offset, size_t len, uint flags) -> bool {
+    for (size_t i = offset; i < offset + len; i += PAGE_SIZE) {
+      paddr_t pa;
+      uint mmu_flags;
+      if (aspace->arch_aspace().Query(mapping->base() + i, &pa, &mmu_flags) != ZX_OK ||
+          pa != base_pa + i || mmu_flags != flags) {
+        return false;
+      }
+    }
+    return true;
+  };
+  EXPECT_TRUE(check_range(0, kSize, kArchRwUserFlags));
+
+  // Removing write from a single page must only affect that page.
+  status = mapping->Protect(mapping->base() + PAGE_SIZE, PAGE_SIZE,
+                            ARCH_MMU_FLAG_PERM_READ | ARCH_MMU_FLAG_PERM_USER);
+  ASSERT_EQ(ZX_OK, status);
+  EXPECT_TRUE(check_range(0, PAGE_SIZE, kArchRwUserFlags));
+  EXPECT_TRUE(check_range(PAGE_SIZE, PAGE_SIZE, ARCH_MMU_FLAG_PERM_READ | ARCH_MMU_FLAG_PERM_USER));
+  EXPECT_TRUE(check_range(2 * PAGE_SIZE, kSize - 2 * PAGE_SIZE, kArchRwUserFlags));
+
+  EXPECT_EQ(ZX_OK, aspace->Destroy());
+
+  END_TEST;
+}
+
 static bool arch_noncontiguous_map() {
   BEGIN_TEST;
 
@@ -988,6 +1039,48 @@ static bool is_vaddr_mapped(ArchVmAspace* aspace, vaddr_t vaddr) {
   return get_vaddr_flags(aspace, vaddr) != 0;
 }
 
+// Tests that unmapping a range covering several mappings removes exactly the pages of the range
+// from the arch aspace.
+static bool vmaspace_unmap_multiple_mappings_test() {
+  BEGIN_TEST;
+  AutoVmScannerDisable scanner_disable;
+
+  fbl::RefPtr<VmAspace> aspace = VmAspace::Create(VmAspace::Type::User, "test-aspace");
+  ASSERT_NONNULL(aspace);
+
+  constexpr size_t kNumMappings = 4;
+  fbl::RefPtr<VmAddressRegion> vmar;
+  ASSERT_OK(aspace->RootVmar()->CreateSubVmar(
+      0, PAGE_SIZE * kNumMappings, 0,
+      VMAR_FLAG_CAN_MAP_SPECIFIC | VMAR_FLAG_CAN_MAP_READ | VMAR_FLAG_CAN_MAP_WRITE, "test vmar",
+      &vmar));
+
+  fbl::RefPtr<VmObjectPaged> vmo;
+  ASSERT_OK(VmObjectPaged::Create(PMM_ALLOC_FLAG_ANY, 0u, PAGE_SIZE * kNumMappings, &vmo));
+  ASSERT_OK(vmo->CommitRange(0, PAGE_SIZE * kNumMappings));
+
+  fbl::RefPtr<VmMapping> mappings[kNumMappings];
+  for (size_t i = 0; i < kNumMappings; i++) {
+    ASSERT_OK(vmar->CreateVmMapping(PAGE_SIZE * i, PAGE_SIZE, 0, VMAR_FLAG_SPECIFIC, vmo,
+                                    PAGE_SIZE * i, kArchRwUserFlags, "test-mapping", &mappings[i]));
+    ASSERT_OK(mappings[i]->MapRange(0, PAGE_SIZE, false));
+    EXPECT_TRUE(is_vaddr_mapped(&aspace->arch_aspace(), mappings[i]->base()));
+  }
+
+  // Unmap all but the last mapping, and the start of the range should be gone from the arch aspace
+  // with the last page untouched.
+  ASSERT_OK(vmar->Unmap(vmar->base(), PAGE_SIZE * (kNumMappings - 1)));
+  for (size_t i = 0; i < kNumMappings - 1; i++) {
+    EXPECT_FALSE(is_vaddr_mapped(&aspace->arch_aspace(), vmar->base() + PAGE_SIZE * i));
+  }
+  EXPECT_TRUE(
+      is_vaddr_mapped(&aspace->arch_aspace(), vmar->base() + PAGE_SIZE * (kNumMappings - 1)));
+
+  EXPECT_EQ(ZX_OK, aspace->Destroy());
+
+  END_TEST;
+}
+
 static bool arch_vm_aspace_protect_split_pages() {
   BEGIN_TEST;
 
@@ -1770,6 +1863,8 @@ VM_UNITTEST(vmaspace_merge_mapping_test)
 VM_UNITTEST(vm_mapping_attribution_commit_decommit_test)
 VM_UNITTEST(vm_mapping_attribution_map_unmap_test)
 VM_UNITTEST(vm_mapping_attribution_merge_test)
+VM_UNITTEST(vm_mapping_large_page_test)
+VM_UNITTEST(vmaspace_unmap_multiple_mappings_test)
 VM_UNITTEST(arch_is_user_accessible_range)
 VM_UNITTEST(validate_user_address_range)
 VM_UNITTEST(arch_noncontiguous_map)
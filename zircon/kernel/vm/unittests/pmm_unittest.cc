@@ -391,6 +391,111 @@ static bool pmm_node_oversized_alloc_test() {
   END_TEST;
 }
 
+// Allocates and frees through the per-CPU magazines and makes sure pages held in magazines are
+// neither lost nor counted as free, and can still be allocated in bulk.
+static bool pmm_node_magazine_test() {
+  BEGIN_TEST;
+  ManagedPmmNode node;
+  static constexpr size_t kMagazinePages = 8;
+  ASSERT_EQ(ZX_OK, node.node().EnableMagazines(kMagazinePages));
+
+  list_node list = LIST_INITIAL_VALUE(list);
+  static constexpr size_t kAllocCount = 4;
+  for (size_t i = 0; i < kAllocCount; i++) {
+    vm_page_t* page;
+    ASSERT_EQ(ZX_OK, node.node().AllocPage(0, &page, nullptr));
+    EXPECT_EQ(vm_page_state::ALLOC, page->state());
+    list_add_tail(&list, &page->queue_node);
+  }
+  // The first allocation on a CPU refills its magazine from the free list.
+  EXPECT_GT(node.node().CountMagazinePages(), 0u);
+  EXPECT_EQ(ManagedPmmNode::kNumPages - kAllocCount,
+            node.node().CountFreePages() + node.node().CountMagazinePages());
+
+  node.node().FreeList(&list);
+  EXPECT_EQ(ManagedPmmNode::kNumPages,
+            node.node().CountFreePages() + node.node().CountMagazinePages());
+
+  node.node().DrainMagazines();
+  EXPECT_EQ(0u, node.node().CountMagazinePages());
+  EXPECT_EQ(ManagedPmmNode::kNumPages, node.node().CountFreePages());
+
+  // Fill a magazine again and make sure a bulk allocation of every page still succeeds.
+  vm_page_t* page;
+  ASSERT_EQ(ZX_OK, node.node().AllocPage(0, &page, nullptr));
+  node.node().FreePage(page);
+  EXPECT_GT(node.node().CountMagazinePages(), 0u);
+  ASSERT_EQ(ZX_OK, node.node().AllocPages(ManagedPmmNode::kNumPages, 0, &list));
+  EXPECT_EQ(ManagedPmmNode::kNumPages, list_length(&list));
+  EXPECT_EQ(0u, node.node().CountMagazinePages());
+
+  node.node().FreeList(&list);
+  END_TEST;
+}
+
+static bool pmm_node_numa_domain_test() {
+  BEGIN_TEST;
+  ManagedPmmNode node;
+  EXPECT_EQ(1u, node.node().NumNumaDomains());
+
+  // Every CPU is in domain 1, which has no memory, so allocations must spill over to domain 0.
+  PmmNode::NumaConfig config;
+  config.domain_count = 2;
+  config.regions[0] = {0, PAGE_SIZE};
+  config.regions[1] = {PAGE_SIZE, 2 * PAGE_SIZE};
+  memset(config.cpu_domain, 1, sizeof(config.cpu_domain));
+  config.spill_order[0][0] = 0;
+  config.spill_order[0][1] = 1;
+  config.spill_order[1][0] = 1;
+  config.spill_order[1][1] = 0;
+
+  PmmNode::NumaConfig bad_config = config;
+  bad_config.spill_order[1][1] = 1;
+  EXPECT_EQ(ZX_ERR_INVALID_ARGS, node.node().ConfigureNumaDomains(bad_config));
+  bad_config = config;
+  bad_config.domain_count = 0;
+  EXPECT_EQ(ZX_ERR_INVALID_ARGS, node.node().ConfigureNumaDomains(bad_config));
+  EXPECT_EQ(1u, node.node().NumNumaDomains());
+
+  ASSERT_EQ(ZX_OK, node.node().ConfigureNumaDomains(config));
+  EXPECT_EQ(2u, node.node().NumNumaDomains());
+  EXPECT_EQ(ZX_ERR_BAD_STATE, node.node().ConfigureNumaDomains(config));
+
+  // The node has no arenas, so all of its pages are in domain 0.
+  PmmNode::NumaDomainStats stats;
+  ASSERT_EQ(ZX_OK, node.node().GetNumaDomainStats(0, &stats));
+  EXPECT_EQ(ManagedPmmNode::kNumPages, stats.free_pages);
+  ASSERT_EQ(ZX_OK, node.node().GetNumaDomainStats(1, &stats));
+  EXPECT_EQ(0u, stats.free_pages);
+  EXPECT_EQ(ZX_ERR_OUT_OF_RANGE, node.node().GetNumaDomainStats(2, &stats));
+
+  vm_page_t* page;
+  ASSERT_EQ(ZX_OK, node.node().AllocPage(0, &page, nullptr));
+  node.node().FreePage(page);
+
+  list_node list = LIST_INITIAL_VALUE(list);
+  ASSERT_EQ(ZX_OK, node.node().AllocPages(ManagedPmmNode::kNumPages, 0, &list));
+  ASSERT_EQ(ZX_OK, node.node().GetNumaDomainStats(0, &stats));
+  EXPECT_EQ(0u, stats.free_pages);
+
+  node.node().FreeList(&list);
+  node.node().DrainMagazines();
+  ASSERT_EQ(ZX_OK, node.node().GetNumaDomainStats(0, &stats));
+  EXPECT_EQ(ManagedPmmNode::kNumPages, stats.free_pages);
+
+  // The domains of the global PMM account for all of its memory.
+  uint64_t total_pages = 0;
+  for (size_t i = 0; i < pmm_num_numa_domains(); i++) {
+    pmm_numa_domain_stats_t domain_stats;
+    ASSERT_EQ(ZX_OK, pmm_get_numa_domain_stats(i, &domain_stats));
+    EXPECT_LE(domain_stats.free_pages, domain_stats.total_pages);
+    total_pages += domain_stats.total_pages;
+  }
+  EXPECT_EQ(pmm_count_total_bytes() / PAGE_SIZE, total_pages);
+
+  END_TEST;
+}
+
 // Checks the correctness of the reported watermark level.
 static bool pmm_node_watermark_level_test() {
   BEGIN_TEST;
@@ -1068,6 +1173,66 @@ static bool pq_toggle_dont_need_queue() {
   END_TEST;
 }
 
+static bool pq_access_count_second_chance() {
+  BEGIN_TEST;
+
+  PageQueues pq;
+
+  pq.SetActiveRatioMultiplier(0);
+  pq.StartThreads(0, ZX_TIME_INFINITE);
+
+  // Pretend we have an allocated pager-backed page.
+  vm_page_t page = {};
+  page.set_state(vm_page_state::OBJECT);
+
+  fbl::RefPtr<VmObjectPaged> vmo;
+  zx_status_t status = VmObjectPaged::Create(0, 0, PAGE_SIZE, &vmo);
+  ASSERT_EQ(ZX_OK, status);
+
+  pq.SetPagerBacked(&page, vmo->DebugGetCowPages().get(), 0);
+  EXPECT_EQ(0u, page.access_count());
+
+  // Accessing the page in the same epoch it was added in is not a new access.
+  pq.MarkAccessed(&page);
+  EXPECT_EQ(0u, page.access_count());
+
+  // Accessing it after aging counts, and the count saturates.
+  for (uint8_t i = 0; i < PageQueues::kMaxAccessCount + 1; i++) {
+    pq.RotateReclaimQueues();
+    pq.MarkAccessed(&page);
+  }
+  EXPECT_EQ(PageQueues::kMaxAccessCount, page.access_count());
+  page.set_access_count(1);
+
+  // Age the page to the second oldest queue. Attempting to evict from there should spend its
+  // second chance and move it into the next queue instead of returning it.
+  for (size_t i = 0; i < PageQueues::kNumReclaim - 2; i++) {
+    pq.RotateReclaimQueues();
+  }
+  size_t queue;
+  EXPECT_TRUE(pq.DebugPageIsReclaim(&page, &queue));
+  EXPECT_EQ(PageQueues::kNumReclaim - 2, queue);
+  auto backlink = pq.PeekReclaim(PageQueues::kNumReclaim - 2);
+  EXPECT_TRUE(backlink == ktl::nullopt);
+  EXPECT_EQ(0u, page.access_count());
+  EXPECT_TRUE(pq.DebugPageIsReclaim(&page, &queue));
+  EXPECT_EQ(PageQueues::kNumReclaim - 3, queue);
+
+  // With no chances left the page is now returned.
+  backlink = pq.PeekReclaim(PageQueues::kNumReclaim - 3);
+  EXPECT_TRUE(backlink != ktl::nullopt && backlink->page == &page);
+
+  // A DontNeed hint clears any access history.
+  pq.MarkAccessed(&page);
+  EXPECT_EQ(1u, page.access_count());
+  pq.MoveToPagerBackedDontNeed(&page);
+  EXPECT_EQ(0u, page.access_count());
+
+  pq.Remove(&page);
+
+  END_TEST;
+}
+
 static bool physmap_for_each_gap_test() {
   BEGIN_TEST;
 
@@ -1205,6 +1370,8 @@ VM_UNITTEST(pmm_node_singlton_list_test)
 VM_UNITTEST(pmm_node_loan_borrow_cancel_reclaim_end)
 VM_UNITTEST(pmm_node_loan_delete_lender)
 VM_UNITTEST(pmm_node_oversized_alloc_test)
+VM_UNITTEST(pmm_node_magazine_test)
+VM_UNITTEST(pmm_node_numa_domain_test)
 VM_UNITTEST(pmm_node_watermark_level_test)
 VM_UNITTEST(pmm_node_multi_watermark_level_test)
 VM_UNITTEST(pmm_node_multi_watermark_level_test2)
@@ -1222,6 +1389,7 @@ VM_UNITTEST(pq_move_queues)
 VM_UNITTEST(pq_move_self_queue)
 VM_UNITTEST(pq_rotate_queue)
 VM_UNITTEST(pq_toggle_dont_need_queue)
+VM_UNITTEST(pq_access_count_second_chance)
 UNITTEST_END_TESTCASE(page_queues_tests, "pq", "PageQueues tests")
 
 UNITTEST_START_TESTCASE(physmap_tests)
@@ -6,6 +6,8 @@
 
 #include <lib/fit/defer.h>
 
+#include <vm/compression.h>
+#include <vm/fault_lookup_cache.h>
 #include <vm/pinned_vm_object.h>
 
 #include "test_helper.h"
@@ -82,6 +84,43 @@ static bool vmo_commit_test() {
   END_TEST;
 }
 
+// Commits a VMO that prefers large pages around a page that is already committed, to check that
+// the preallocated runs and pages end up at the right offsets.
+static bool vmo_commit_large_pages_test() {
+  BEGIN_TEST;
+
+  AutoVmScannerDisable scanner_disable;
+
+  static const size_t kLargePage = 2ul * 1024 * 1024;
+  static const size_t alloc_size = 2 * kLargePage;
+  fbl::RefPtr<VmObjectPaged> vmo;
+  zx_status_t status =
+      VmObjectPaged::Create(PMM_ALLOC_FLAG_ANY, VmObjectPaged::kPreferLargePages, alloc_size, &vmo);
+  ASSERT_EQ(status, ZX_OK, "vmobject creation\n");
+
+  // The second chunk already has a page, so only the first one can be allocated as a single run.
+  const uint64_t written_offset = kLargePage + PAGE_SIZE;
+  const uint64_t data = 0x1234abcd;
+  ASSERT_EQ(ZX_OK, vmo->Write(&data, written_offset, sizeof(data)));
+  paddr_t written_pa;
+  ASSERT_EQ(ZX_OK, vmo->LookupContiguous(written_offset, PAGE_SIZE, &written_pa));
+
+  ASSERT_EQ(ZX_OK, vmo->CommitRange(0, alloc_size));
+  EXPECT_EQ(alloc_size, PAGE_SIZE * vmo->AttributedPages());
+
+  // The existing page is untouched and every new page is zero.
+  paddr_t pa;
+  EXPECT_EQ(ZX_OK, vmo->LookupContiguous(written_offset, PAGE_SIZE, &pa));
+  EXPECT_EQ(written_pa, pa);
+  for (uint64_t offset = 0; offset < alloc_size; offset += PAGE_SIZE) {
+    uint64_t val;
+    ASSERT_EQ(ZX_OK, vmo->Read(&val, offset, sizeof(val)));
+    EXPECT_EQ(offset == written_offset ? data : 0u, val);
+  }
+
+  END_TEST;
+}
+
 // Creates paged VMOs, pins them, and tries operations that should unpin.
 static bool vmo_pin_test() {
   BEGIN_TEST;
@@ -1780,6 +1819,111 @@ static bool vmo_eviction_test() {
   END_TEST;
 }
 
+// Tests that VmCompression round trips page contents and enforces its limits.
+static bool vmo_compression_round_trip_test() {
+  BEGIN_TEST;
+
+  fbl::AllocChecker ac;
+  fbl::Vector<uint64_t> src;
+  src.reserve(PAGE_SIZE / sizeof(uint64_t), &ac);
+  ASSERT_TRUE(ac.check());
+  fbl::Vector<uint64_t> dst;
+  dst.reserve(PAGE_SIZE / sizeof(uint64_t), &ac);
+  ASSERT_TRUE(ac.check());
+  uint64_t* words = src.data();
+
+  // Only allow enough storage for a zero page and a single sparse page.
+  VmCompression compression(256);
+
+  // A zero page compresses to almost nothing.
+  memset(src.data(), 0, PAGE_SIZE);
+  ktl::optional<VmCompression::CompressedRef> zero_ref = compression.Compress(src.data());
+  ASSERT_TRUE(zero_ref);
+  EXPECT_LT(compression.GetStats().compressed_storage_bytes, 64u);
+
+  // A sparse page with repeated values compresses.
+  for (size_t i = 0; i < PAGE_SIZE / sizeof(uint64_t); i++) {
+    words[i] = (i % 8 == 0) ? (i / 64) + 1 : 0;
+  }
+  ktl::optional<VmCompression::CompressedRef> sparse_ref = compression.Compress(src.data());
+  ASSERT_TRUE(sparse_ref);
+  EXPECT_EQ(2u, compression.GetStats().compressed_pages);
+  EXPECT_EQ(2u * PAGE_SIZE, compression.GetStats().uncompressed_storage_bytes);
+
+  // The store is now too full to take another copy.
+  EXPECT_FALSE(compression.Compress(src.data()));
+
+  // Random data does not compress.
+  compression.Free(*sparse_ref);
+  fill_region(0x42, src.data(), PAGE_SIZE);
+  EXPECT_FALSE(compression.Compress(src.data()));
+  EXPECT_EQ(2u, compression.GetStats().failed_compression_attempts);
+
+  // Decompression restores the original contents.
+  for (size_t i = 0; i < PAGE_SIZE / sizeof(uint64_t); i++) {
+    words[i] = (i % 3 == 0) ? 0 : (i / 128 + 1) * 0x1234;
+  }
+  sparse_ref = compression.Compress(src.data());
+  ASSERT_TRUE(sparse_ref);
+  compression.Decompress(*sparse_ref, dst.data());
+  EXPECT_EQ(0, memcmp(src.data(), dst.data(), PAGE_SIZE));
+
+  memset(dst.data(), 0xff, PAGE_SIZE);
+  compression.Decompress(*zero_ref, dst.data());
+  memset(src.data(), 0, PAGE_SIZE);
+  EXPECT_EQ(0, memcmp(src.data(), dst.data(), PAGE_SIZE));
+
+  VmCompression::Stats stats = compression.GetStats();
+  EXPECT_EQ(0u, stats.compressed_pages);
+  EXPECT_EQ(0u, stats.compressed_storage_bytes);
+  EXPECT_EQ(2u, stats.decompressions);
+
+  END_TEST;
+}
+
+// Tests that anonymous pages can be reclaimed by compression and faulted back in.
+static bool vmo_compression_reclaim_test() {
+  BEGIN_TEST;
+  AutoVmScannerDisable scanner_disable;
+
+  if (!pmm_page_compression()) {
+    printf("Compression is not enabled, skipping test\n");
+    END_TEST;
+  }
+
+  fbl::RefPtr<VmObjectPaged> vmo;
+  ASSERT_OK(VmObjectPaged::Create(PMM_ALLOC_FLAG_ANY, 0u, PAGE_SIZE, &vmo));
+
+  fbl::AllocChecker ac;
+  fbl::Vector<uint64_t> buf;
+  buf.reserve(PAGE_SIZE / sizeof(uint64_t), &ac);
+  ASSERT_TRUE(ac.check());
+  uint64_t* words = buf.data();
+  for (size_t i = 0; i < PAGE_SIZE / sizeof(uint64_t); i++) {
+    words[i] = (i % 4 == 0) ? i : 0;
+  }
+  ASSERT_OK(vmo->Write(buf.data(), 0, PAGE_SIZE));
+  vm_page_t* page = vmo->DebugGetPage(0);
+  ASSERT_NONNULL(page);
+
+  // Reclaiming should replace the page, which still counts as committed content.
+  ASSERT_TRUE(
+      vmo->DebugGetCowPages()->ReclaimPage(page, 0, VmCowPages::EvictionHintAction::Follow));
+  pmm_free_page(page);
+  EXPECT_NULL(vmo->DebugGetPage(0));
+  EXPECT_EQ(1u, vmo->AttributedPages());
+
+  // Reading the page back in decompresses it.
+  memset(buf.data(), 0, PAGE_SIZE);
+  ASSERT_OK(vmo->Read(buf.data(), 0, PAGE_SIZE));
+  for (size_t i = 0; i < PAGE_SIZE / sizeof(uint64_t); i++) {
+    EXPECT_EQ((i % 4 == 0) ? i : 0u, words[i]);
+  }
+  EXPECT_NONNULL(vmo->DebugGetPage(0));
+
+  END_TEST;
+}
+
 // This test exists to provide a location for VmObjectPaged::DebugValidatePageSplits to be
 // regularly called so that it doesn't bitrot. Additionally it *might* detect VMO object corruption,
 // but it's primary goal is to test the implementation of DebugValidatePageSplits
@@ -3694,6 +3838,102 @@ static bool vmo_dedup_dirty_test() {
   END_TEST;
 }
 
+// Tests that the zero page dedup policy controls which pages are scanned and deduped.
+static bool vmo_zero_page_dedup_policy_test() {
+  BEGIN_TEST;
+
+  AutoVmScannerDisable scanner_disable;
+
+  fbl::RefPtr<VmObjectPaged> vmo;
+  zx_status_t status = VmObjectPaged::Create(PMM_ALLOC_FLAG_ANY, 0, PAGE_SIZE * 2, &vmo);
+  ASSERT_EQ(ZX_OK, status);
+  EXPECT_EQ(VmObject::ZeroPageDedupPolicy::Default, vmo->GetZeroPageDedupPolicy());
+
+  // Explicitly committed pages are not candidates for scanning by default.
+  EXPECT_OK(vmo->CommitRange(0, PAGE_SIZE * 2));
+  vm_page_t* page0 = vmo->DebugGetPage(0);
+  vm_page_t* page1 = vmo->DebugGetPage(PAGE_SIZE);
+  EXPECT_FALSE(pmm_page_queues()->DebugPageIsAnonymousZeroFork(page0));
+  EXPECT_FALSE(pmm_page_queues()->DebugPageIsAnonymousZeroFork(page1));
+
+  // Opting in to eager deduping queues the existing pages for the scanner.
+  EXPECT_OK(vmo->SetZeroPageDedupPolicy(VmObject::ZeroPageDedupPolicy::Eager));
+  EXPECT_EQ(VmObject::ZeroPageDedupPolicy::Eager, vmo->GetZeroPageDedupPolicy());
+  EXPECT_TRUE(pmm_page_queues()->DebugPageIsAnonymousZeroFork(page0));
+  EXPECT_TRUE(pmm_page_queues()->DebugPageIsAnonymousZeroFork(page1));
+
+  // Once disabled, no pages can be deduped.
+  EXPECT_OK(vmo->SetZeroPageDedupPolicy(VmObject::ZeroPageDedupPolicy::Disabled));
+  EXPECT_FALSE(vmo->DebugGetCowPages()->DedupZeroPage(page0, 0));
+  EXPECT_FALSE(vmo->DebugGetCowPages()->DedupZeroPage(page1, PAGE_SIZE));
+  EXPECT_EQ(2u, vmo->AttributedPages());
+
+  // Restoring the default allows deduping again.
+  EXPECT_OK(vmo->SetZeroPageDedupPolicy(VmObject::ZeroPageDedupPolicy::Default));
+  EXPECT_TRUE(vmo->DebugGetCowPages()->DedupZeroPage(page0, 0));
+  EXPECT_EQ(1u, vmo->AttributedPages());
+
+  // VMOs that can never have zero pages deduped do not support a policy.
+  fbl::RefPtr<VmObjectPaged> contig_vmo;
+  status = VmObjectPaged::CreateContiguous(PMM_ALLOC_FLAG_ANY, PAGE_SIZE, 0, &contig_vmo);
+  ASSERT_EQ(ZX_OK, status);
+  EXPECT_EQ(ZX_ERR_NOT_SUPPORTED,
+            contig_vmo->SetZeroPageDedupPolicy(VmObject::ZeroPageDedupPolicy::Eager));
+
+  END_TEST;
+}
+
+// Tests that the fault lookup cache only returns recorded runs of pages until they are invalidated.
+static bool vmo_fault_lookup_cache_test() {
+  BEGIN_TEST;
+
+  fbl::AllocChecker ac;
+  ktl::unique_ptr<VmFaultLookupCache> cache = ktl::make_unique<VmFaultLookupCache>(&ac);
+  ASSERT_TRUE(ac.check());
+
+  size_t found = 0;
+  paddr_t found_paddrs[VmFaultLookupCache::kNumEntries];
+  auto record = [&](const paddr_t* paddrs, size_t count) {
+    found = count;
+    memcpy(found_paddrs, paddrs, count * sizeof(paddr_t));
+    return true;
+  };
+
+  // Nothing is found before anything is inserted.
+  EXPECT_FALSE(cache->Lookup(0, 4, record));
+
+  const paddr_t paddrs[] = {0x10000, 0x20000, 0x30000};
+  cache->Insert(PAGE_SIZE, paddrs, ktl::size(paddrs));
+
+  // Lookups return the run of consecutive recorded pages, limited by the requested count.
+  EXPECT_FALSE(cache->Lookup(0, 4, record));
+  EXPECT_TRUE(cache->Lookup(PAGE_SIZE, 4, record));
+  EXPECT_EQ(3u, found);
+  EXPECT_EQ(paddrs[0], found_paddrs[0]);
+  EXPECT_EQ(paddrs[2], found_paddrs[2]);
+  EXPECT_TRUE(cache->Lookup(PAGE_SIZE * 2, 1, record));
+  EXPECT_EQ(1u, found);
+  EXPECT_EQ(paddrs[1], found_paddrs[0]);
+
+  // An offset that aliases a recorded entry is not found.
+  EXPECT_FALSE(cache->Lookup(PAGE_SIZE * (1 + VmFaultLookupCache::kNumEntries), 1, record));
+
+  // Invalidating the middle page splits the run.
+  cache->Invalidate(PAGE_SIZE * 2, PAGE_SIZE);
+  EXPECT_TRUE(cache->Lookup(PAGE_SIZE, 4, record));
+  EXPECT_EQ(1u, found);
+  EXPECT_FALSE(cache->Lookup(PAGE_SIZE * 2, 4, record));
+  EXPECT_TRUE(cache->Lookup(PAGE_SIZE * 3, 4, record));
+  EXPECT_EQ(1u, found);
+
+  // Large invalidations remove everything in range.
+  cache->Invalidate(0, PAGE_SIZE * VmFaultLookupCache::kNumEntries * 2);
+  EXPECT_FALSE(cache->Lookup(PAGE_SIZE, 1, record));
+  EXPECT_FALSE(cache->Lookup(PAGE_SIZE * 3, 1, record));
+
+  END_TEST;
+}
+
 UNITTEST_START_TESTCASE(vmo_tests)
 VM_UNITTEST(vmo_create_test)
 VM_UNITTEST(vmo_create_maximum_size)
@@ -3702,6 +3942,7 @@ VM_UNITTEST(vmo_pin_contiguous_test)
 VM_UNITTEST(vmo_multiple_pin_test)
 VM_UNITTEST(vmo_multiple_pin_contiguous_test)
 VM_UNITTEST(vmo_commit_test)
+VM_UNITTEST(vmo_commit_large_pages_test)
 VM_UNITTEST(vmo_odd_size_commit_test)
 VM_UNITTEST(vmo_create_physical_test)
 VM_UNITTEST(vmo_physical_pin_test)
@@ -3726,6 +3967,9 @@ VM_UNITTEST(vmo_eviction_hints_test)
 VM_UNITTEST(vmo_always_need_evicts_loaned_test)
 VM_UNITTEST(vmo_eviction_hints_clone_test)
 VM_UNITTEST(vmo_eviction_test)
+VM_UNITTEST(vmo_compression_round_trip_test)
+VM_UNITTEST(vmo_compression_reclaim_test)
+VM_UNITTEST(vmo_fault_lookup_cache_test)
 VM_UNITTEST(vmo_validate_page_splits_test)
 VM_UNITTEST(vmo_attribution_clones_test)
 VM_UNITTEST(vmo_attribution_ops_test)
@@ -3750,6 +3994,7 @@ VM_UNITTEST(vmo_supply_zero_offset_test)
 VM_UNITTEST(vmo_zero_pinned_test)
 VM_UNITTEST(vmo_pinned_wrapper_test)
 VM_UNITTEST(vmo_dedup_dirty_test)
+VM_UNITTEST(vmo_zero_page_dedup_policy_test)
 UNITTEST_END_TESTCASE(vmo_tests, "vmo", "VmObject tests")
 
 }  // namespace vm_unittest
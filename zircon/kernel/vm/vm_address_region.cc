@@ -561,6 +561,138 @@ void VmAddressRegion::Activate() {
   parent_->subregions_.InsertRegion(fbl::RefPtr<VmAddressRegionOrMapping>(this));
 }
 
+zx_status_t VmAddressRegion::RangeOpBatch(RangeOpType op,
+                                          ktl::span<const VmObject::Range> ranges) {
+  canary_.Assert();
+  if (op != RangeOpType::Decommit && op != RangeOpType::DontNeed) {
+    return ZX_ERR_INVALID_ARGS;
+  }
+
+  // The part of a range that lies in a single mapping, as a range of the mapping's VMO. These are
+  // declared before the guard so that the VMO references are dropped without the aspace lock held.
+  struct Segment {
+    fbl::RefPtr<VmObject> vmo;
+    VmObject::Range range;
+  };
+  Segment segments[VmObject::kMaxBatchRanges];
+  size_t num_segments = 0;
+
+  // Applies |op| to the collected segments, which must be called without the aspace lock held.
+  // Consecutive segments of the same VMO are handed to it together, so that decommitting them
+  // unmaps and invalidates the TLB once for all of them rather than once per range.
+  auto apply = [&segments, &num_segments, op]() -> zx_status_t {
+    VmObject::Range vmo_ranges[VmObject::kMaxBatchRanges];
+    zx_status_t result = ZX_OK;
+    for (size_t i = 0; i < num_segments && result == ZX_OK;) {
+      VmObject* vmo = segments[i].vmo.get();
+      size_t count = 0;
+      while (i < num_segments && segments[i].vmo.get() == vmo) {
+        vmo_ranges[count++] = segments[i++].range;
+      }
+      const ktl::span<const VmObject::Range> group(vmo_ranges, count);
+      result = op == RangeOpType::Decommit
+                   ? vmo->DecommitRanges(group)
+                   : vmo->HintRanges(group, VmObject::EvictionHint::DontNeed);
+    }
+    for (size_t i = 0; i < num_segments; i++) {
+      segments[i].vmo.reset();
+    }
+    num_segments = 0;
+    return result;
+  };
+
+  Guard<CriticalMutex> guard{aspace_->lock()};
+  if (state_ != LifeCycleState::ALIVE) {
+    return ZX_ERR_BAD_STATE;
+  }
+
+  // Check every range before applying any of them, so that a bad range fails the batch without
+  // side effects. The same checks are made by RangeOp.
+  for (const VmObject::Range& range : ranges) {
+    const vaddr_t base = range.offset;
+    const size_t len = ROUNDUP(range.len, PAGE_SIZE);
+    if (len == 0 || !IS_PAGE_ALIGNED(base)) {
+      return ZX_ERR_INVALID_ARGS;
+    }
+    if (!is_in_range(base, len)) {
+      return ZX_ERR_OUT_OF_RANGE;
+    }
+    if (aspace_->IntersectsVdsoCodeLocked(base, len)) {
+      return ZX_ERR_ACCESS_DENIED;
+    }
+    VmAddressRegionEnumerator<VmAddressRegionEnumeratorType::PausableMapping> enumerator(
+        *this, base, base + len);
+    AssertHeld(enumerator.lock_ref());
+    vaddr_t expected = base;
+    while (auto map = enumerator.next()) {
+      VmMapping* mapping = map->region_or_mapping;
+      AssertHeld(mapping->lock_ref());
+      if (mapping->base() > expected) {
+        return ZX_ERR_BAD_STATE;
+      }
+      // Decommit zeroes pages of the VMO, equivalent to writing to it.
+      if (op == RangeOpType::Decommit &&
+          !mapping->is_valid_mapping_flags(ARCH_MMU_FLAG_PERM_WRITE)) {
+        return ZX_ERR_ACCESS_DENIED;
+      }
+      expected = mapping->base() + mapping->size();
+    }
+    if (expected < base + len) {
+      return ZX_ERR_BAD_STATE;
+    }
+  }
+
+  for (const VmObject::Range& range : ranges) {
+    const vaddr_t base = range.offset;
+    const vaddr_t last_addr = base + ROUNDUP(range.len, PAGE_SIZE);
+    VmAddressRegionEnumerator<VmAddressRegionEnumeratorType::PausableMapping> enumerator(
+        *this, base, last_addr);
+    AssertHeld(enumerator.lock_ref());
+    vaddr_t expected = base;
+    while (auto map = enumerator.next()) {
+      VmMapping* mapping = map->region_or_mapping;
+      AssertHeld(mapping->lock_ref());
+      // The mappings were checked above, but may have changed if the lock was dropped to apply a
+      // full set of segments.
+      if (mapping->base() > expected) {
+        return ZX_ERR_BAD_STATE;
+      }
+      if (op == RangeOpType::Decommit &&
+          !mapping->is_valid_mapping_flags(ARCH_MMU_FLAG_PERM_WRITE)) {
+        return ZX_ERR_ACCESS_DENIED;
+      }
+      const size_t mapping_offset = expected - mapping->base();
+      const size_t size = ktl::min(last_addr - expected, mapping->size() - mapping_offset);
+      segments[num_segments++] = Segment{
+          .vmo = mapping->vmo_locked(),
+          .range = {.offset = mapping->object_offset_locked() + mapping_offset, .len = size},
+      };
+      expected += size;
+
+      if (num_segments == VmObject::kMaxBatchRanges) {
+        zx_status_t result = ZX_OK;
+        enumerator.pause();
+        guard.CallUnlocked([&result, &apply] { result = apply(); });
+        if (result != ZX_OK) {
+          return result;
+        }
+        // Since the lock was dropped we must re-validate before doing anything else.
+        if (state_ != LifeCycleState::ALIVE) {
+          return ZX_ERR_BAD_STATE;
+        }
+        enumerator.resume();
+      }
+    }
+    if (expected < last_addr) {
+      return ZX_ERR_BAD_STATE;
+    }
+  }
+
+  zx_status_t result = ZX_OK;
+  guard.CallUnlocked([&result, &apply] { result = apply(); });
+  return result;
+}
+
 zx_status_t VmAddressRegion::RangeOp(RangeOpType op, vaddr_t base, size_t len,
                                      user_inout_ptr<void> buffer, size_t buffer_size) {
   canary_.Assert();
@@ -768,6 +900,15 @@ zx_status_t VmAddressRegion::UnmapInternalLocked(vaddr_t base, size_t size,
     }
   }
 
+  // Everything in the range is about to be unmapped, so when the range covers more than a single
+  // mapping clear it from the arch aspace in one go.
+  if (begin != end) {
+    auto second = begin;
+    if (!begin->is_mapping() || ++second != end) {
+      aspace_->CoalescedArchUnmapLocked(base, size);
+    }
+  }
+
   bool at_top = true;
   for (auto itr = begin; itr != end;) {
     uint64_t curr_base;
@@ -11,6 +11,7 @@
 #include <zircon/types.h>
 
 #include <vm/vm.h>
+#include <vm/vm_address_region_enumerator.h>
 #include <vm/vm_aspace.h>
 
 #include "vm/vm_address_region.h"
@@ -18,9 +19,12 @@
 
 #define LOCAL_TRACE VM_GLOBAL_TRACE(0)
 
+// Thread safety analysis is disabled as the parent's |fault_around_pages_| is read in the
+// constructor. Every path that creates a child region holds the aspace lock, except for the VMARs
+// of the kernel aspace that are created during early boot.
 VmAddressRegionOrMapping::VmAddressRegionOrMapping(vaddr_t base, size_t size, uint32_t flags,
                                                    VmAspace* aspace, VmAddressRegion* parent,
-                                                   bool is_mapping)
+                                                   bool is_mapping) TA_NO_THREAD_SAFETY_ANALYSIS
     : is_mapping_(is_mapping),
       state_(LifeCycleState::NOT_READY),
       base_(base),
@@ -29,6 +33,26 @@ VmAddressRegionOrMapping::VmAddressRegionOrMapping(vaddr_t base, size_t size, ui
       aspace_(aspace),
       parent_(parent) {
   LTRACEF("%p\n", this);
+  // New regions inherit the fault-around window of their parent.
+  if (parent) {
+    fault_around_pages_ = parent->fault_around_pages_;
+  }
+}
+
+void VmAddressRegionOrMapping::SetFaultAroundPages(uint32_t pages) {
+  canary_.Assert();
+  Guard<CriticalMutex> guard{aspace_->lock()};
+  fault_around_pages_ = pages;
+  if (is_mapping()) {
+    return;
+  }
+  VmAddressRegionEnumerator<VmAddressRegionEnumeratorType::UnpausableVmarOrMapping> enumerator(
+      *as_vm_address_region_ptr(), 0, UINT64_MAX);
+  AssertHeld(enumerator.lock_ref());
+  while (auto result = enumerator.next()) {
+    AssertHeld(result->region_or_mapping->lock_ref());
+    result->region_or_mapping->fault_around_pages_ = pages;
+  }
 }
 
 zx_status_t VmAddressRegionOrMapping::Destroy() {
@@ -58,6 +58,7 @@ KCOUNTER(vm_aspace_marked_latency_sensitive, "vm.aspace.latency_sensitive.marked
 KCOUNTER(vm_aspace_latency_sensitive_destroyed, "vm.aspace.latency_sensitive.destroyed")
 KCOUNTER(vm_aspace_accessed_harvests_performed, "vm.aspace.accessed_harvest.performed")
 KCOUNTER(vm_aspace_accessed_harvests_skipped, "vm.aspace.accessed_harvest.skipped")
+KCOUNTER(vm_aspace_coalesced_unmaps, "vm.aspace.coalesced_unmaps")
 
 // the singleton kernel address space
 lazy_init::LazyInit<VmAspace, lazy_init::CheckType::None, lazy_init::Destructor::Disabled>
@@ -278,6 +279,7 @@ zx_status_t VmAspace::Destroy() {
   // tear down and free all of the regions in our address space
   if (root_vmar_) {
     AssertHeld(root_vmar_->lock_ref());
+    CoalescedArchUnmapLocked(root_vmar_->base(), root_vmar_->size());
     zx_status_t status = root_vmar_->DestroyLocked();
     if (status != ZX_OK && status != ZX_ERR_BAD_STATE) {
       return status;
@@ -296,6 +298,19 @@ zx_status_t VmAspace::Destroy() {
   return ZX_OK;
 }
 
+void VmAspace::CoalescedArchUnmapLocked(vaddr_t base, size_t size) {
+  canary_.Assert();
+
+  if (!is_user() || size == 0) {
+    return;
+  }
+  // Failing to unmap here is harmless, as each mapping will still be unmapped individually.
+  zx_status_t status = arch_aspace_.Unmap(base, size / PAGE_SIZE, EnlargeArchUnmap(), nullptr);
+  if (status == ZX_OK) {
+    vm_aspace_coalesced_unmaps.Add(1);
+  }
+}
+
 bool VmAspace::is_destroyed() const {
   Guard<CriticalMutex> guard{&lock_};
   return aspace_destroyed_;
@@ -6,14 +6,19 @@
 
 #include "vm/vm_cow_pages.h"
 
+#include <lib/boot-options/boot-options.h>
 #include <lib/counters.h>
 #include <lib/fit/defer.h>
+#include <pow2.h>
 #include <trace.h>
 
+#include <kernel/event.h>
 #include <kernel/range_check.h>
+#include <kernel/thread.h>
 #include <ktl/move.h>
 #include <lk/init.h>
 #include <vm/anonymous_page_requester.h>
+#include <vm/compression.h>
 #include <vm/fault.h>
 #include <vm/physmap.h>
 #include <vm/pmm.h>
@@ -57,6 +62,17 @@ namespace {
 
 KCOUNTER(vm_vmo_marked_latency_sensitive, "vm.vmo.latency_sensitive.marked")
 KCOUNTER(vm_vmo_latency_sensitive_destroyed, "vm.vmo.latency_sensitive.destroyed")
+KCOUNTER(vm_vmo_zero_dedup_eager_pages_queued, "vm.vmo.zero_dedup.eager_pages_queued")
+KCOUNTER(vm_vmo_large_page_runs_allocated, "vm.vmo.large_pages.runs_allocated")
+KCOUNTER(vm_vmo_large_page_runs_failed, "vm.vmo.large_pages.runs_failed")
+
+// Sizes of the physically contiguous runs that VMOs preferring large pages are committed with,
+// largest first. These correspond to the large page sizes that user and guest physical mappings
+// can use.
+constexpr uint64_t kLargePageRunSizes[] = {1ul << 30, 2ul << 20};
+
+// Signaled when the pre-zeroed page pool of a CPU runs low, to wake the thread that refills it.
+AutounsignalEvent zeroed_page_pool_low;
 
 void ZeroPage(paddr_t pa) {
   void* ptr = paddr_to_physmap(pa);
@@ -96,10 +112,10 @@ inline uint64_t CheckedAdd(uint64_t a, uint64_t b) {
   return result;
 }
 
-// TODO(fxbug.dev/60238): Implement this once compressed pages are supported and Reference types
-// can be generated.
 void FreeReference(VmPageOrMarker::ReferenceValue content) {
-  panic("Reference should never be generated.");
+  VmCompression* compression = pmm_page_compression();
+  DEBUG_ASSERT(compression);
+  compression->Free(content);
 }
 
 }  // namespace
@@ -185,7 +201,7 @@ class BatchPQRemove {
 // Allocates a new page and populates it with the data at |parent_paddr|.
 zx_status_t VmCowPages::AllocateCopyPage(uint32_t pmm_alloc_flags, paddr_t parent_paddr,
                                          list_node_t* alloc_list, LazyPageRequest* request,
-                                         vm_page_t** clone) {
+                                         vm_page_t** clone, bool use_zeroed_pool) {
   DEBUG_ASSERT(request || !(pmm_alloc_flags & PMM_ALLOC_FLAG_CAN_WAIT));
 
   vm_page_t* p_clone = nullptr;
@@ -194,10 +210,14 @@ zx_status_t VmCowPages::AllocateCopyPage(uint32_t pmm_alloc_flags, paddr_t paren
   }
 
   paddr_t pa_clone;
+  bool zeroed = false;
   if (p_clone) {
     pa_clone = p_clone->paddr();
   } else {
-    zx_status_t status = CacheAllocPage(pmm_alloc_flags, &p_clone, &pa_clone);
+    zx_status_t status =
+        use_zeroed_pool && parent_paddr == vm_get_zero_page_paddr()
+            ? CacheAllocZeroedPage(pmm_alloc_flags, &p_clone, &pa_clone, &zeroed)
+            : CacheAllocPage(pmm_alloc_flags, &p_clone, &pa_clone);
     if (status != ZX_OK) {
       DEBUG_ASSERT(!p_clone);
       if (status == ZX_ERR_SHOULD_WAIT) {
@@ -218,7 +238,7 @@ zx_status_t VmCowPages::AllocateCopyPage(uint32_t pmm_alloc_flags, paddr_t paren
     const void* src = paddr_to_physmap(parent_paddr);
     DEBUG_ASSERT(src);
     memcpy(dst, src, PAGE_SIZE);
-  } else {
+  } else if (!zeroed) {
     // avoid pointless fetches by directly zeroing dst
     arch_zero_page(dst);
   }
@@ -247,6 +267,30 @@ zx_status_t VmCowPages::CacheAllocPage(uint alloc_flags, vm_page_t** p, paddr_t*
   return ZX_OK;
 }
 
+zx_status_t VmCowPages::CacheAllocZeroedPage(uint alloc_flags, vm_page_t** p, paddr_t* pa,
+                                             bool* zeroed) {
+  if (!page_cache_ || gBootOptions->vm_zeroed_pages == 0) {
+    *zeroed = false;
+    return CacheAllocPage(alloc_flags, p, pa);
+  }
+
+  zx::status result = page_cache_.AllocateZeroed(alloc_flags);
+  if (result.is_error()) {
+    return result.error_value();
+  }
+
+  // Wake the zeroing thread once the pool of this CPU has been drained to half of its target, so
+  // that it is refilled before it runs dry.
+  if (result->zeroed_pages <= gBootOptions->vm_zeroed_pages / 2) {
+    zeroed_page_pool_low.Signal();
+  }
+
+  *p = result->page;
+  *pa = result->page->paddr();
+  *zeroed = result->zeroed;
+  return ZX_OK;
+}
+
 void VmCowPages::CacheFree(list_node_t* list) {
   if (!page_cache_) {
     pmm_free(list);
@@ -266,12 +310,30 @@ void VmCowPages::CacheFree(vm_page_t* p) {
   page_cache_.Free(ktl::move(list));
 }
 
-// TODO(fxbug.dev/60238): Implement this once compressed pages are supported and Reference types
-// can be generated.
 zx_status_t VmCowPages::MakePageFromReference(VmPageOrMarkerRef page_or_mark,
                                               LazyPageRequest* page_request) {
   DEBUG_ASSERT(page_or_mark->IsReference());
-  panic("Reference should never be generated.");
+  DEBUG_ASSERT(page_request || !(pmm_alloc_flags_ & PMM_ALLOC_FLAG_CAN_WAIT));
+  VmCompression* compression = pmm_page_compression();
+  DEBUG_ASSERT(compression);
+
+  vm_page_t* p;
+  paddr_t pa;
+  zx_status_t status = CacheAllocPage(pmm_alloc_flags_, &p, &pa);
+  if (status != ZX_OK) {
+    if (status == ZX_ERR_SHOULD_WAIT) {
+      status = AnonymousPageRequester::Get().FillRequest(page_request->get());
+    }
+    return status;
+  }
+  InitializeVmPage(p);
+  // The split bits are tracked in the reference while it is compressed, and need to be restored
+  // into the page before it replaces the reference.
+  p->object.cow_left_split = page_or_mark->PageOrRefLeftSplit();
+  p->object.cow_right_split = page_or_mark->PageOrRefRightSplit();
+
+  VmPageOrMarker::ReferenceValue ref = page_or_mark.SwapReferenceForPage(p);
+  compression->Decompress(ref, paddr_to_physmap(pa));
   return ZX_OK;
 }
 
@@ -417,6 +479,10 @@ bool VmCowPages::DedupZeroPage(vm_page_t* page, uint64_t offset) {
     return false;
   }
 
+  if (zero_page_dedup_policy_ == VmObject::ZeroPageDedupPolicy::Disabled) {
+    return false;
+  }
+
   if (paged_ref_) {
     AssertHeld(paged_ref_->lock_ref());
     if (!paged_ref_->CanDedupZeroPagesLocked()) {
@@ -2560,7 +2626,8 @@ zx_status_t VmCowPages::LookupPagesLocked(uint64_t offset, uint pf_flags,
     // allocate a writable page for this vmo.
     DEBUG_ASSERT(page_request);
     zx_status_t alloc_status =
-        AllocateCopyPage(pmm_alloc_flags_, p->paddr(), alloc_list, page_request, &res_page);
+        AllocateCopyPage(pmm_alloc_flags_, p->paddr(), alloc_list, page_request, &res_page,
+                         is_latency_sensitive_);
     if (unlikely(alloc_status != ZX_OK)) {
       return alloc_status;
     }
@@ -2601,7 +2668,8 @@ zx_status_t VmCowPages::LookupPagesLocked(uint64_t offset, uint pf_flags,
       return status;
     }
     // Interpret a software fault as an explicit desire to have potential zero pages and don't
-    // consider them for cleaning, this is an optimization.
+    // consider them for cleaning, this is an optimization. VMOs that have opted in to eager
+    // deduping have asked for these pages to be considered anyway.
     //
     // We explicitly must *not* place pages from a page_source_ that's using pager queues into the
     // zero scanning queue, as the pager queues are already using the backlink.
@@ -2609,7 +2677,9 @@ zx_status_t VmCowPages::LookupPagesLocked(uint64_t offset, uint pf_flags,
     // We don't need to scan for zeroes if on finding zeroes we wouldn't be able to remove the page
     // anyway.
     if (p == vm_get_zero_page() && !is_source_preserving_page_content() &&
-        can_decommit_zero_pages_locked() && !(pf_flags & VMM_PF_FLAG_SW_FAULT)) {
+        can_decommit_zero_pages_locked() &&
+        (!(pf_flags & VMM_PF_FLAG_SW_FAULT) ||
+         zero_page_dedup_policy_ == VmObject::ZeroPageDedupPolicy::Eager)) {
       pmm_page_queues()->MoveToAnonymousZeroFork(res_page);
     }
 
@@ -2703,7 +2773,9 @@ zx_status_t VmCowPages::CommitRangeLocked(uint64_t offset, uint64_t len, uint64_
       return ZX_OK;
     }
 
-    zx_status_t status = pmm_alloc_pages(count, pmm_alloc_flags_, &page_list);
+    zx_status_t status = !!(options_ & VmCowPagesOptions::kPreferLargePages)
+                             ? AllocateCommitPagesLocked(offset, len, &page_list)
+                             : pmm_alloc_pages(count, pmm_alloc_flags_, &page_list);
     // Ignore ZX_ERR_SHOULD_WAIT since the loop below will fall back to a page by page allocation,
     // allowing us to wait for single pages should we need to.
     if (status != ZX_OK && status != ZX_ERR_SHOULD_WAIT) {
@@ -2783,6 +2855,71 @@ zx_status_t VmCowPages::CommitRangeLocked(uint64_t offset, uint64_t len, uint64_
   return ZX_OK;
 }
 
+zx_status_t VmCowPages::AllocateCommitPagesLocked(uint64_t offset, uint64_t len,
+                                                  list_node_t* alloc_list) {
+  DEBUG_ASSERT(!!(options_ & VmCowPagesOptions::kPreferLargePages));
+  const uint64_t end = offset + len;
+  // Contiguous allocations can neither borrow nor wait.
+  const uint32_t contiguous_flags =
+      pmm_alloc_flags_ & ~(PMM_ALLOC_FLAG_CAN_BORROW | PMM_ALLOC_FLAG_CAN_WAIT);
+
+  auto count_missing = [this](uint64_t start, uint64_t stop) {
+    AssertHeld(lock_);
+    size_t missing = (stop - start) / PAGE_SIZE;
+    page_list_.ForEveryPageInRange(
+        [&missing](const auto* p, uint64_t off) {
+          if (p->IsPage()) {
+            missing--;
+          }
+          return ZX_ERR_NEXT;
+        },
+        start, stop);
+    return missing;
+  };
+
+  while (offset < end) {
+    // Use the largest run that is aligned at |offset|, fits in the range and has no pages
+    // committed yet. Otherwise allocate the missing pages up to the next boundary of the smallest
+    // run individually.
+    uint64_t chunk_end = offset;
+    bool allocated = false;
+    for (const uint64_t run_size : kLargePageRunSizes) {
+      chunk_end = ktl::min(ROUNDUP(offset + 1, run_size), end);
+      if (!IS_ALIGNED(offset, run_size) || chunk_end - offset != run_size ||
+          count_missing(offset, chunk_end) != run_size / PAGE_SIZE) {
+        continue;
+      }
+      list_node_t run_list = LIST_INITIAL_VALUE(run_list);
+      paddr_t pa;
+      if (pmm_alloc_contiguous(run_size / PAGE_SIZE, contiguous_flags,
+                               static_cast<uint8_t>(log2_ulong_floor(run_size)), &pa,
+                               &run_list) == ZX_OK) {
+        vm_vmo_large_page_runs_allocated.Add(1);
+        list_splice_after(&run_list, alloc_list->prev);
+        allocated = true;
+        break;
+      }
+      vm_vmo_large_page_runs_failed.Add(1);
+    }
+    if (!allocated) {
+      list_node_t chunk_list = LIST_INITIAL_VALUE(chunk_list);
+      zx_status_t status =
+          pmm_alloc_pages(count_missing(offset, chunk_end), pmm_alloc_flags_, &chunk_list);
+      if (status != ZX_OK) {
+        if (status != ZX_ERR_SHOULD_WAIT) {
+          // We are freeing pages we got from the PMM and did not end up using, so we do not own
+          // them.
+          FreePagesLocked(alloc_list, /*freeing_owned_pages=*/false);
+        }
+        return status;
+      }
+      list_splice_after(&chunk_list, alloc_list->prev);
+    }
+    offset = chunk_end;
+  }
+  return ZX_OK;
+}
+
 zx_status_t VmCowPages::PinRangeLocked(uint64_t offset, uint64_t len) {
   canary_.Assert();
   LTRACEF("offset %#" PRIx64 ", len %#" PRIx64 "\n", offset, len);
@@ -2918,6 +3055,69 @@ zx_status_t VmCowPages::DecommitRangeLocked(uint64_t offset, uint64_t len) {
   return status;
 }
 
+zx_status_t VmCowPages::DecommitRangesLocked(ktl::span<const VmObject::Range> ranges) {
+  canary_.Assert();
+
+  // As in DecommitRangeLocked, ranges are trimmed against this node, and then applied to the root
+  // ancestor if this is a slice.
+  uint64_t root_offset = 0;
+  VmCowPages* root = this;
+  if (is_slice_locked()) {
+    root = PagedParentOfSliceLocked(&root_offset);
+  }
+  AssertHeld(root->lock_);
+  DEBUG_ASSERT(!root->is_slice_locked());
+
+  // Currently, we can't decommit if the absence of a page doesn't imply zeroes.
+  if (root->parent_ || root->is_source_preserving_page_content()) {
+    return ZX_ERR_NOT_SUPPORTED;
+  }
+  DEBUG_ASSERT(root->can_decommit());
+
+  list_node_t freed_list;
+  list_initialize(&freed_list);
+  uint64_t union_start = UINT64_MAX;
+  uint64_t union_end = 0;
+  zx_status_t status = ZX_OK;
+  for (const VmObject::Range& range : ranges) {
+    uint64_t len;
+    if (!TrimRange(range.offset, range.len, size_, &len)) {
+      status = ZX_ERR_OUT_OF_RANGE;
+      break;
+    }
+    if (len == 0) {
+      continue;
+    }
+    if (!IS_PAGE_ALIGNED(range.offset) || !IS_PAGE_ALIGNED(range.len)) {
+      status = ZX_ERR_INVALID_ARGS;
+      break;
+    }
+    const uint64_t offset = range.offset + root_offset;
+    if (root->AnyPagesPinnedLocked(offset, len)) {
+      status = ZX_ERR_BAD_STATE;
+      break;
+    }
+
+    // The pages stay mapped until the range change below, but they cannot be freed before then,
+    // and the lock keeps faults from finding them missing in the meantime.
+    __UNINITIALIZED BatchPQRemove page_remover(&freed_list);
+    root->page_list_.RemovePages(page_remover.RemovePagesCallback(), offset, offset + len);
+    page_remover.Flush();
+
+    union_start = ktl::min(union_start, offset);
+    union_end = ktl::max(union_end, offset + len);
+  }
+
+  if (union_start < union_end) {
+    root->RangeChangeUpdateLocked(union_start, union_end - union_start, RangeChangeOp::Unmap);
+  }
+  root->FreePagesLocked(&freed_list, /*freeing_owned_pages=*/true);
+
+  VMO_VALIDATION_ASSERT(root->DebugValidatePageSplitsHierarchyLocked());
+  VMO_FRUGAL_VALIDATION_ASSERT(root->DebugValidateVmoPageBorrowingLocked());
+  return status;
+}
+
 zx_status_t VmCowPages::UnmapAndRemovePagesLocked(uint64_t offset, uint64_t len,
                                                   list_node_t* freed_list,
                                                   uint64_t* pages_freed_out) {
@@ -3233,7 +3433,8 @@ zx_status_t VmCowPages::ZeroPagesLocked(uint64_t page_start_base, uint64_t page_
         vm_page_t* p;
         // Do not pass our freed_list here as this takes an |alloc_list| list to allocate from.
         zx_status_t status =
-            AllocateCopyPage(pmm_alloc_flags_, vm_get_zero_page_paddr(), nullptr, page_request, &p);
+            AllocateCopyPage(pmm_alloc_flags_, vm_get_zero_page_paddr(), nullptr, page_request, &p,
+                             is_latency_sensitive_);
         if (status != ZX_OK) {
           return status;
         }
@@ -3615,6 +3816,35 @@ void VmCowPages::MarkAsLatencySensitiveLocked() {
   }
 }
 
+zx_status_t VmCowPages::SetZeroPageDedupPolicyLocked(VmObject::ZeroPageDedupPolicy policy) {
+  canary_.Assert();
+
+  // Pages from a source that preserves content are tracked by the pager queues and cannot share the
+  // zero fork queue, and pages that cannot be decommitted would never be deduped anyway.
+  if (is_source_preserving_page_content() || !can_decommit_zero_pages_locked()) {
+    return ZX_ERR_NOT_SUPPORTED;
+  }
+
+  zero_page_dedup_policy_ = policy;
+  if (policy != VmObject::ZeroPageDedupPolicy::Eager || is_latency_sensitive_) {
+    return ZX_OK;
+  }
+
+  // Queue all the existing pages that the scanner would be willing to dedupe. Pinned pages are
+  // skipped as they are in the wired queue, and will be rechecked by DedupZeroPage regardless.
+  PageQueues* pq = pmm_page_queues();
+  uint64_t queued = 0;
+  page_list_.ForEveryPage([pq, &queued](const auto* p, uint64_t) {
+    if (p->IsPage() && p->Page()->object.pin_count == 0) {
+      pq->MoveToAnonymousZeroFork(p->Page());
+      queued++;
+    }
+    return ZX_ERR_NEXT;
+  });
+  vm_vmo_zero_dedup_eager_pages_queued.Add(queued);
+  return ZX_OK;
+}
+
 void VmCowPages::UnpinLocked(uint64_t offset, uint64_t len, bool allow_gaps) {
   canary_.Assert();
 
@@ -5468,12 +5698,57 @@ bool VmCowPages::ReclaimPage(vm_page_t* page, uint64_t offset, EvictionHintActio
   if (can_evict()) {
     return RemovePageForEvictionLocked(page, offset, hint_action);
   }
+  // Otherwise try to reclaim anonymous content by compressing it. Anything with a page source, such
+  // as a contiguous VMO, must keep its physical pages, and latency sensitive VMOs should never have
+  // to wait on decompression.
+  if (VmCompression* compression = pmm_page_compression();
+      compression && !page_source_ && !is_latency_sensitive_) {
+    return RemovePageForCompressionLocked(page, offset, compression, hint_action);
+  }
   // No other reclamation strategies, so to avoid this page remaining in a reclamation list we
   // simulate an access.
   UpdateOnAccessLocked(page, VMM_PF_FLAG_SW_FAULT);
   return false;
 }
 
+bool VmCowPages::RemovePageForCompressionLocked(vm_page_t* page, uint64_t offset,
+                                                VmCompression* compression,
+                                                EvictionHintAction hint_action) {
+  DEBUG_ASSERT(!page_source_);
+  DEBUG_ASSERT(page->object.pin_count == 0);
+
+  // Respect the |always_need| hint in the same way as eviction does.
+  if (page->object.always_need == 1 && hint_action == EvictionHintAction::Follow) {
+    UpdateOnAccessLocked(page, VMM_PF_FLAG_SW_FAULT);
+    return false;
+  }
+
+  // Remove any mappings to this page before reading its contents. Any other modification to the
+  // page requires our lock, so once unmapped its contents are stable.
+  RangeChangeUpdateLocked(offset, PAGE_SIZE, RangeChangeOp::Unmap);
+
+  ktl::optional<VmCompression::CompressedRef> ref =
+      compression->Compress(paddr_to_physmap(page->paddr()));
+  if (!ref) {
+    // The page either did not compress well or the store is full. Treat it as accessed so that it
+    // is not immediately found again, and will only be retried once it has aged again.
+    UpdateOnAccessLocked(page, VMM_PF_FLAG_SW_FAULT);
+    return false;
+  }
+
+  VmPageOrMarkerRef slot = page_list_.LookupMutable(offset);
+  DEBUG_ASSERT(slot);
+  [[maybe_unused]] vm_page_t* released = slot.SwapPageForReference(*ref);
+  DEBUG_ASSERT(released == page);
+  pmm_page_queues()->Remove(page);
+
+  IncrementHierarchyGenerationCountLocked();
+  VMO_VALIDATION_ASSERT(DebugValidatePageSplitsHierarchyLocked());
+  VMO_FRUGAL_VALIDATION_ASSERT(DebugValidateVmoPageBorrowingLocked());
+  // |page| is now owned by the caller.
+  return true;
+}
+
 void VmCowPages::SwapPageLocked(uint64_t offset, vm_page_t* old_page, vm_page_t* new_page) {
   DEBUG_ASSERT(!old_page->object.pin_count);
   DEBUG_ASSERT(new_page->state() == vm_page_state::ALLOC);
@@ -6579,3 +6854,33 @@ void VmCowPages::InitializePageCache(uint32_t level) {
 
 // Initialize the cache after the percpu data structures are initialized.
 LK_INIT_HOOK(vm_cow_pages_cache_init, VmCowPages::InitializePageCache, LK_INIT_LEVEL_KERNEL + 1)
+
+int VmCowPages::ZeroedPageThread(void* arg) {
+  const size_t target_pages = gBootOptions->vm_zeroed_pages;
+  while (true) {
+    zx::status<size_t> result = page_cache_.FillZeroedPages(target_pages);
+    if (result.is_error()) {
+      // Leave the free memory to regular allocations for now and try again the next time the pool
+      // runs low.
+      LTRACEF("zeroed page pool fill failed: %d\n", result.error_value());
+    }
+    zeroed_page_pool_low.Wait();
+  }
+  return 0;
+}
+
+void VmCowPages::InitializeZeroedPagePool(uint32_t level) {
+  if (!page_cache_ || gBootOptions->vm_zeroed_pages == 0) {
+    return;
+  }
+
+  // Run at the lowest priority, so that pages are only zeroed when the CPUs have nothing else to
+  // do. Latency sensitive faults that find the pool empty still zero their page inline.
+  Thread* thread =
+      Thread::Create("zeroed-page-thread", &VmCowPages::ZeroedPageThread, nullptr, LOWEST_PRIORITY);
+  ASSERT(thread);
+  thread->DetachAndResume();
+}
+
+LK_INIT_HOOK(vm_cow_pages_zeroed_page_pool_init, VmCowPages::InitializeZeroedPagePool,
+             LK_INIT_LEVEL_THREADING)
@@ -7,8 +7,10 @@
 #include <align.h>
 #include <assert.h>
 #include <inttypes.h>
+#include <lib/boot-options/boot-options.h>
 #include <lib/counters.h>
 #include <lib/fit/defer.h>
+#include <pow2.h>
 #include <trace.h>
 #include <zircon/errors.h>
 #include <zircon/types.h>
@@ -38,6 +40,12 @@ KCOUNTER(vm_mapping_attribution_cache_hits, "vm.attributed_pages.mapping.cache_h
 KCOUNTER(vm_mapping_attribution_cache_misses, "vm.attributed_pages.mapping.cache_misses")
 KCOUNTER(vm_mappings_merged, "vm.aspace.mapping.merged_neighbors")
 KCOUNTER(vm_mappings_protect_no_write, "vm.aspace.mapping.protect_without_write")
+KCOUNTER(vm_mapping_fault_around, "vm.aspace.mapping.fault_around")
+KCOUNTER(vm_mapping_fault_around_scanned_pages, "vm.aspace.mapping.fault_around_scanned_pages")
+KCOUNTER(vm_mapping_large_pages_mapped, "vm.aspace.mapping.large_pages_mapped")
+KCOUNTER(vm_mapping_large_pages_promoted, "vm.aspace.mapping.large_pages_promoted")
+KCOUNTER(vm_mapping_huge_pages_mapped, "vm.aspace.mapping.huge_pages_mapped")
+KCOUNTER(vm_mapping_lockless_faults, "vm.aspace.mapping.lockless_read_faults")
 
 }  // namespace
 
@@ -645,9 +653,6 @@ zx_status_t VmMapping::MapRange(size_t offset, size_t len, bool commit, bool ign
   // grab the lock for the vmo
   Guard<CriticalMutex> object_guard{object_->lock()};
 
-  // Cache whether the object is dirty tracked, we need to know this when computing mmu flags later.
-  const bool dirty_tracked = object_->is_dirty_tracked_locked();
-
   // set the currently faulting flag for any recursive calls the vmo may make back into us.
   DEBUG_ASSERT(!currently_faulting_);
   currently_faulting_ = true;
@@ -656,6 +661,18 @@ zx_status_t VmMapping::MapRange(size_t offset, size_t len, bool commit, bool ign
     currently_faulting_ = false;
   });
 
+  return MapRangeLocked(offset, len, commit, ignore_existing);
+}
+
+zx_status_t VmMapping::MapRangeLocked(size_t offset, size_t len, bool commit,
+                                      bool ignore_existing) {
+  DEBUG_ASSERT(currently_faulting_);
+  DEBUG_ASSERT(IS_PAGE_ALIGNED(offset) && IS_PAGE_ALIGNED(len));
+  DEBUG_ASSERT(is_in_range(base_ + offset, len));
+
+  // Cache whether the object is dirty tracked, we need to know this when computing mmu flags later.
+  const bool dirty_tracked = object_->is_dirty_tracked_locked();
+
   // The region to map could have multiple different current arch mmu flags, so we need to iterate
   // over them to ensure we install mappings with the correct permissions.
   return EnumerateProtectionRangesLocked(
@@ -694,6 +711,28 @@ zx_status_t VmMapping::MapRange(size_t offset, size_t len, bool commit, bool ign
                                                      : ArchVmAspace::ExistingEntryAction::Error);
         __UNINITIALIZED VmObject::LookupInfo pages;
         for (size_t offset = 0; offset < len;) {
+          // Any aligned chunk that the VMO already has contiguously committed can skip the page by
+          // page lookup and be mapped with a single large page. Guest physical mappings try a huge
+          // page first.
+          if (!dirty_tracked) {
+            size_t large_size = 0;
+            if (aspace_->is_guest_physical() && IS_ALIGNED(base + offset, kHugePageSize) &&
+                len - offset >= kHugePageSize &&
+                TryMapLargePageLocked(base + offset, kHugePageSize, mmu_flags,
+                                      /*replace_existing=*/false)) {
+              large_size = kHugePageSize;
+            } else if (IS_ALIGNED(base + offset, kLargePageSize) &&
+                       len - offset >= kLargePageSize &&
+                       TryMapLargePageLocked(base + offset, kLargePageSize, mmu_flags,
+                                             /*replace_existing=*/false)) {
+              large_size = kLargePageSize;
+            }
+            if (large_size != 0) {
+              offset += large_size;
+              continue;
+            }
+          }
+
           const uint64_t vmo_offset = object_offset_ + (base - base_) + offset;
 
           zx_status_t status;
@@ -862,13 +901,22 @@ zx_status_t VmMapping::PageFault(vaddr_t va, const uint pf_flags, LazyPageReques
     return ZX_ERR_ACCESS_DENIED;
   }
 
-  // grab the lock for the vmo
-  Guard<CriticalMutex> guard{object_->lock()};
-
   // Determine how far to the end of the page table so we do not cause extra allocations.
   const uint64_t next_pt_base = ArchVmAspace::NextUserPageTableOffset(va);
   // Find the minimum between the size of this protection range and the end of the page table.
   const uint64_t max_map = ktl::min(next_pt_base, range.region_top);
+
+  // Read faults of pages that an earlier fault already found can usually be resolved without the
+  // object lock. Guest faults are excluded as they need the extra cache maintenance below.
+  if (!(pf_flags & (VMM_PF_FLAG_WRITE | VMM_PF_FLAG_GUEST)) && object_->is_paged() &&
+      TryLocklessReadFaultLocked(
+          va, vmo_offset, range.mmu_flags,
+          ktl::min((max_map - va) / PAGE_SIZE, VmObject::LookupInfo::kMaxPages))) {
+    return ZX_OK;
+  }
+
+  // grab the lock for the vmo
+  Guard<CriticalMutex> guard{object_->lock()};
   // Convert this into a number of pages, limited by the max lookup window.
   //
   // If this is a write fault and the VMO supports dirty tracking, only lookup 1 page. The pages
@@ -923,6 +971,12 @@ zx_status_t VmMapping::PageFault(vaddr_t va, const uint pf_flags, LazyPageReques
   if (!(pf_flags & VMM_PF_FLAG_WRITE) && !lookup_info.writable) {
     // we read faulted, so only map with read permissions
     range.mmu_flags &= ~ARCH_MMU_FLAG_PERM_WRITE;
+
+    // Remember these pages so that read faults on them from other mappings can skip the lock.
+    if (!(pf_flags & VMM_PF_FLAG_GUEST) && object_->is_paged()) {
+      static_cast<VmObjectPaged*>(object_.get())
+          ->RecordReadFaultLocked(vmo_offset, lookup_info.paddrs, lookup_info.num_pages);
+    }
   }
 
   // If we are faulting a page into a guest, clean the caches.
@@ -1033,11 +1087,152 @@ zx_status_t VmMapping::PageFault(vaddr_t va, const uint pf_flags, LazyPageReques
       return status;
     }
     DEBUG_ASSERT(mapped >= 1);
+
+    // Pager backed VMOs are typically files that are accessed sequentially, so opportunistically
+    // map in any of their resident pages around a fresh fault.
+    if (!(pf_flags & VMM_PF_FLAG_GUEST) && object_->is_user_pager_backed_locked()) {
+      FaultAroundLocked(va, lookup_info.num_pages);
+    }
+
+    // If this fault may have completed a contiguously committed, aligned large page worth of the
+    // VMO then promote the surrounding small mappings to a large page. Checking that the physical
+    // and virtual addresses are congruent first avoids walking the VMO for the common case of
+    // discontiguous pages.
+    const vaddr_t large_base = ROUNDDOWN(va, kLargePageSize);
+    if ((pf_flags & VMM_PF_FLAG_WRITE || lookup_info.writable) &&
+        IS_ALIGNED(lookup_info.paddrs[0] - va, kLargePageSize) && large_base >= base_ &&
+        large_base + kLargePageSize <= base_ + size_) {
+      const MappingProtectionRanges::FlagsRange large_range =
+          ProtectRangesLocked().FlagsRangeAtAddr(base_, size_, large_base);
+      if (large_range.region_top >= large_base + kLargePageSize &&
+          TryMapLargePageLocked(large_base, kLargePageSize, large_range.mmu_flags,
+                                /*replace_existing=*/true)) {
+        vm_mapping_large_pages_promoted.Add(1);
+      }
+    }
   }
 
   return ZX_OK;
 }
 
+bool VmMapping::TryLocklessReadFaultLocked(vaddr_t va, uint64_t vmo_offset, uint mmu_flags,
+                                           uint64_t max_pages) {
+  VmFaultLookupCache* cache = static_cast<VmObjectPaged*>(object_.get())->fault_lookup_cache();
+  if (!cache) {
+    return false;
+  }
+
+  auto map_pages = [&](const paddr_t* paddrs, size_t count) {
+    // Anything already mapped here, such as a read only mapping being faulted for an access flag,
+    // needs the full fault path to resolve.
+    paddr_t pa;
+    uint page_flags;
+    if (aspace_->arch_aspace().Query(va, &pa, &page_flags) == ZX_OK) {
+      return false;
+    }
+    size_t num_mapped;
+    zx_status_t status =
+        aspace_->arch_aspace().Map(va, paddrs, count, mmu_flags & ~ARCH_MMU_FLAG_PERM_WRITE,
+                                   ArchVmAspace::ExistingEntryAction::Skip, &num_mapped);
+    return status == ZX_OK && num_mapped >= 1;
+  };
+  const bool mapped = cache->Lookup(vmo_offset, max_pages, map_pages);
+  if (mapped) {
+    vm_mapping_lockless_faults.Add(1);
+  }
+  return mapped;
+}
+
+bool VmMapping::TryMapLargePageLocked(vaddr_t va, size_t size, uint mmu_flags,
+                                      bool replace_existing) {
+  DEBUG_ASSERT(size == kLargePageSize || size == kHugePageSize);
+  DEBUG_ASSERT(IS_ALIGNED(va, size));
+  DEBUG_ASSERT(is_in_range(va, size));
+
+  // Restrict large pages to user and guest physical mappings, where TLB pressure matters most and
+  // where mappings are never required to be split without being able to fall back to enlarging the
+  // unmap.
+  if (!(aspace_->is_user() || aspace_->is_guest_physical()) || !gBootOptions->vm_large_pages ||
+      !(mmu_flags & ARCH_MMU_FLAG_PERM_RWX_MASK)) {
+    return false;
+  }
+
+  paddr_t pa;
+  if (object_->LookupLargePageLocked(object_offset_ + (va - base_), size, &pa) != ZX_OK ||
+      !IS_ALIGNED(pa, size)) {
+    return false;
+  }
+
+  const size_t count = size / PAGE_SIZE;
+  if (replace_existing) {
+    // The range is exactly one large page, so removing it never needs to split a larger mapping.
+    zx_status_t status =
+        aspace_->arch_aspace().Unmap(va, count, ArchVmAspace::EnlargeOperation::No, nullptr);
+    if (status != ZX_OK) {
+      return false;
+    }
+  }
+
+  // Failure here leaves the range unmapped, which is safe since any access will fault the small
+  // pages back in.
+  size_t mapped;
+  zx_status_t status = aspace_->arch_aspace().MapContiguous(va, pa, count, mmu_flags, &mapped);
+  if (status != ZX_OK) {
+    LTRACEF("failed to map large page at va %#" PRIxPTR ": %d\n", va, status);
+    return false;
+  }
+  DEBUG_ASSERT(mapped == count);
+  if (size == kHugePageSize) {
+    vm_mapping_huge_pages_mapped.Add(1);
+  } else {
+    vm_mapping_large_pages_mapped.Add(1);
+  }
+  return true;
+}
+
+void VmMapping::FaultAroundLocked(vaddr_t va, uint64_t num_pages) {
+  uint64_t window_pages = fault_around_pages_;
+  if (window_pages == kFaultAroundDefault) {
+    window_pages = gBootOptions->vm_fault_around_pages;
+  }
+  if (window_pages <= 1) {
+    return;
+  }
+  // Round down to a power of two so that the window can be naturally aligned.
+  window_pages = 1ul << log2_floor(window_pages);
+  if (window_pages <= num_pages) {
+    return;
+  }
+
+  // Constrain the window to this mapping and to the page table that |va| is in, so that fault-around
+  // never causes additional page table allocations.
+  const vaddr_t next_pt_base = ArchVmAspace::NextUserPageTableOffset(va);
+  const vaddr_t pt_base = next_pt_base - ArchVmAspace::NextUserPageTableOffset(0);
+  const uint64_t window_size = window_pages * PAGE_SIZE;
+  const vaddr_t aligned_base = ROUNDDOWN(va, window_size);
+  const vaddr_t window_base = ktl::max(aligned_base, ktl::max(base_, pt_base));
+  const vaddr_t window_top =
+      ktl::min(aligned_base + window_size, ktl::min(base_ + size_, next_pt_base));
+  const vaddr_t fault_top = va + num_pages * PAGE_SIZE;
+
+  // Only pages that are already resident are mapped in, no pages are committed, and any existing
+  // mappings are left alone. Failure here is not fatal to the fault, which has already been
+  // resolved, so errors are ignored.
+  uint64_t scanned_pages = 0;
+  if (window_base < va) {
+    MapRangeLocked(window_base - base_, va - window_base, /*commit=*/false,
+                   /*ignore_existing=*/true);
+    scanned_pages += (va - window_base) / PAGE_SIZE;
+  }
+  if (fault_top < window_top) {
+    MapRangeLocked(fault_top - base_, window_top - fault_top, /*commit=*/false,
+                   /*ignore_existing=*/true);
+    scanned_pages += (window_top - fault_top) / PAGE_SIZE;
+  }
+  vm_mapping_fault_around.Add(1);
+  vm_mapping_fault_around_scanned_pages.Add(static_cast<int64_t>(scanned_pages));
+}
+
 void VmMapping::ActivateLocked() {
   DEBUG_ASSERT(state_ == LifeCycleState::NOT_READY);
   DEBUG_ASSERT(parent_);
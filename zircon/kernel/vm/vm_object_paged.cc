@@ -8,6 +8,7 @@
 #include <align.h>
 #include <assert.h>
 #include <inttypes.h>
+#include <lib/boot-options/boot-options.h>
 #include <lib/console.h>
 #include <lib/counters.h>
 #include <lib/fit/defer.h>
@@ -55,6 +56,8 @@ VmObjectPaged::~VmObjectPaged() {
 
   LTRACEF("%p\n", this);
 
+  delete fault_lookup_cache_.load(ktl::memory_order_relaxed);
+
   if (!cow_pages_) {
     // Initialization didn't finish. This is not in the global list and any complex destruction can
     // all be skipped.
@@ -145,6 +148,39 @@ zx_status_t VmObjectPaged::HintRange(uint64_t offset, uint64_t len, EvictionHint
   return ZX_OK;
 }
 
+zx_status_t VmObjectPaged::HintRanges(ktl::span<const Range> ranges, EvictionHint hint) {
+  canary_.Assert();
+
+  // AlwaysNeed may need to drop the lock to wait on page requests, so gains nothing from being
+  // batched under a single lock acquisition.
+  if (hint != EvictionHint::DontNeed) {
+    return VmObject::HintRanges(ranges, hint);
+  }
+
+  // As in HintRange, ranges that overflow are rejected even when the hint would be ignored.
+  for (const Range& range : ranges) {
+    uint64_t end_offset;
+    if (add_overflow(range.offset, range.len, &end_offset)) {
+      return ZX_ERR_OUT_OF_RANGE;
+    }
+  }
+
+  Guard<CriticalMutex> guard{lock()};
+
+  // Hints are silently ignored for VMOs that cannot be evicted, see HintRange.
+  if (!cow_pages_locked()->can_root_source_evict_locked()) {
+    return ZX_OK;
+  }
+
+  for (const Range& range : ranges) {
+    if (!InRange(range.offset, range.len, size_locked())) {
+      return ZX_ERR_OUT_OF_RANGE;
+    }
+    cow_pages_locked()->PromoteRangeForReclamationLocked(range.offset, range.len);
+  }
+  return ZX_OK;
+}
+
 bool VmObjectPaged::CanDedupZeroPagesLocked() {
   canary_.Assert();
 
@@ -216,8 +252,12 @@ zx_status_t VmObjectPaged::CreateCommon(uint32_t pmm_alloc_flags, uint32_t optio
     return ZX_ERR_NO_MEMORY;
   }
 
+  VmCowPagesOptions cow_options = VmCowPagesOptions::kNone;
+  if (options & kPreferLargePages) {
+    cow_options |= VmCowPagesOptions::kPreferLargePages;
+  }
   fbl::RefPtr<VmCowPages> cow_pages;
-  status = VmCowPages::Create(state, VmCowPagesOptions::kNone, pmm_alloc_flags, size, &cow_pages);
+  status = VmCowPages::Create(state, cow_options, pmm_alloc_flags, size, &cow_pages);
   if (status != ZX_OK) {
     return status;
   }
@@ -991,6 +1031,20 @@ zx_status_t VmObjectPaged::DecommitRange(uint64_t offset, uint64_t len) {
   return DecommitRangeLocked(offset, len);
 }
 
+zx_status_t VmObjectPaged::DecommitRanges(ktl::span<const Range> ranges) {
+  canary_.Assert();
+  LTRACEF("%zu ranges\n", ranges.size());
+  Guard<CriticalMutex> guard{&lock_};
+  if (is_contiguous() && !pmm_physical_page_borrowing_config()->is_loaning_enabled()) {
+    return ZX_ERR_NOT_SUPPORTED;
+  }
+  DEBUG_ASSERT(!is_resizable() || !is_contiguous());
+  zx_status_t status = cow_pages_locked()->DecommitRangesLocked(ranges);
+  // The ranges before a failing one are decommitted too, so the hierarchy changes either way.
+  IncrementHierarchyGenerationCountLocked();
+  return status;
+}
+
 zx_status_t VmObjectPaged::DecommitRangeLocked(uint64_t offset, uint64_t len) {
   canary_.Assert();
 
@@ -1463,6 +1517,49 @@ zx_status_t VmObjectPaged::LookupContiguous(uint64_t offset, uint64_t len, paddr
   return ZX_OK;
 }
 
+zx_status_t VmObjectPaged::LookupLargePageLocked(uint64_t offset, uint64_t len,
+                                                 paddr_t* out_paddr) {
+  canary_.Assert();
+  DEBUG_ASSERT(len > 0 && IS_PAGE_ALIGNED(offset) && IS_PAGE_ALIGNED(len));
+
+  // Pager backed and dirty tracked pages rely on per page accessed and dirty tracking in the page
+  // tables, which would be lost with a large page.
+  if (is_user_pager_backed_locked() || is_dirty_tracked_locked()) {
+    return ZX_ERR_NOT_SUPPORTED;
+  }
+
+  if (unlikely(!InRange(offset, len, size_locked()))) {
+    return ZX_ERR_OUT_OF_RANGE;
+  }
+
+  // Only pages owned directly by this VMO (or by the parent of a slice) are considered, as any page
+  // that would be supplied from a parent still has to be copied on write.
+  paddr_t first_paddr = 0;
+  uint64_t count = 0;
+  bool contiguous = true;
+  zx_status_t status = cow_pages_locked()->LookupLocked(
+      offset, len,
+      [offset, &first_paddr, &count, &contiguous](uint64_t cur_offset, paddr_t pa) mutable {
+        if (count == 0) {
+          first_paddr = pa;
+        }
+        if (cur_offset != offset + count * PAGE_SIZE || pa != first_paddr + count * PAGE_SIZE) {
+          contiguous = false;
+          return ZX_ERR_STOP;
+        }
+        ++count;
+        return ZX_ERR_NEXT;
+      });
+  ASSERT(status == ZX_OK);
+  if (!contiguous || count != len / PAGE_SIZE) {
+    return ZX_ERR_NOT_FOUND;
+  }
+  if (out_paddr) {
+    *out_paddr = first_paddr;
+  }
+  return ZX_OK;
+}
+
 zx_status_t VmObjectPaged::ReadUser(VmAspace* current_aspace, user_out_ptr<char> ptr,
                                     uint64_t offset, size_t len, size_t* out_actual) {
   canary_.Assert();
@@ -1732,6 +1829,14 @@ void VmObjectPaged::RangeChangeUpdateLocked(uint64_t offset, uint64_t len, Range
   const uint64_t aligned_offset = ROUNDDOWN(offset, PAGE_SIZE);
   const uint64_t aligned_len = ROUNDUP(offset + len, PAGE_SIZE) - aligned_offset;
 
+  // Any pages being unmapped may no longer be what a read fault would find, and so must be removed
+  // from the lookup cache before the mappings are updated.
+  if (op == RangeChangeOp::Unmap) {
+    if (VmFaultLookupCache* cache = fault_lookup_cache()) {
+      cache->Invalidate(aligned_offset, aligned_len);
+    }
+  }
+
   for (auto& m : mapping_list_) {
     m.assert_object_lock();
     if (op == RangeChangeOp::Unmap) {
@@ -1746,6 +1851,37 @@ void VmObjectPaged::RangeChangeUpdateLocked(uint64_t offset, uint64_t len, Range
   }
 }
 
+void VmObjectPaged::RecordReadFaultLocked(uint64_t offset, const paddr_t* paddrs, size_t count) {
+  canary_.Assert();
+
+  VmFaultLookupCache* cache = fault_lookup_cache();
+  if (!cache) {
+    // Only create a cache for VMOs whose faults are likely to contend on the lock with faults from
+    // other mappings. User pager backed hierarchies hold files, such as shared libraries, that are
+    // mapped by many processes through many related VMOs.
+    if (!gBootOptions->vm_fault_lookup_cache ||
+        (!is_user_pager_backed_locked() && mapping_list_len_ < 2)) {
+      return;
+    }
+    fbl::AllocChecker ac;
+    cache = new (&ac) VmFaultLookupCache();
+    if (!ac.check()) {
+      return;
+    }
+    fault_lookup_cache_.store(cache, ktl::memory_order_release);
+  }
+
+  // Faults that find the zero page are always resolved through the full fault path, so that
+  // committing a page in its place never needs to consider the cache.
+  size_t cacheable = 0;
+  while (cacheable < count && paddrs[cacheable] != vm_get_zero_page_paddr()) {
+    cacheable++;
+  }
+  if (cacheable > 0) {
+    cache->Insert(offset, paddrs, cacheable);
+  }
+}
+
 zx_status_t VmObjectPaged::LockRange(uint64_t offset, uint64_t len,
                                      zx_vmo_lock_state_t* lock_state_out) {
   if (!is_discardable()) {
@@ -153,6 +153,10 @@ typedef uint16_t groupid_t;
 #define BLOCKIO_CLOSE_VMO 0x00000005
 #define BLOCKIO_OP_MASK 0x000000FF
 
+// Don't start this request until every earlier request on the FIFO has completed. Without it, the
+// server may reorder requests, for example to let reads go ahead of writes.
+#define BLOCKIO_BARRIER_BEFORE 0x00000100
+
 // Associate the following request with |group|.
 #define BLOCKIO_GROUP_ITEM 0x00000400
 
@@ -0,0 +1,109 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SYSROOT_ZIRCON_SYSCALLS_CHANNEL_H_
+#define SYSROOT_ZIRCON_SYSCALLS_CHANNEL_H_
+
+#include <zircon/compiler.h>
+#include <zircon/types.h>
+
+__BEGIN_CDECLS
+
+// Shared rings of channels created with ZX_CHANNEL_SHARED_RING.
+//
+// The first message read from each endpoint of such a channel is sent by the
+// kernel. It holds a zx_channel_ring_info_t and a single handle to a VMO that
+// is shared by both endpoints. The VMO contains one ring per direction, each
+// a zx_channel_ring_header_t followed, at ZX_CHANNEL_RING_HEADER_SIZE bytes,
+// by |data_size| bytes of records.
+//
+// Once both processes have mapped the VMO, small messages without handles can
+// be exchanged by appending ZX_CHANNEL_RING_RECORD_DATA records to the
+// transmit ring without entering the kernel. All other messages are written
+// with zx_channel_write() as usual, after first appending a
+// ZX_CHANNEL_RING_RECORD_CHANNEL record, so that the reader knows when the
+// next message in order must be taken with zx_channel_read() instead.
+//
+// A writer that observes ZX_CHANNEL_RING_READER_WAITING in the header of its
+// transmit ring after updating |tail| asserts ZX_CHANNEL_RING_SIGNALED on the
+// peer with zx_object_signal_peer(). A reader that finds its receive ring
+// empty sets ZX_CHANNEL_RING_READER_WAITING, checks the ring once more, and
+// then waits for ZX_CHANNEL_RING_SIGNALED, which it clears with
+// zx_object_signal() before resuming.
+//
+// //zircon/system/ulib/channel-ring implements this protocol.
+
+// clang-format off
+
+#define ZX_CHANNEL_RING_VERSION             ((uint32_t)1u)
+
+// Offset of the records of a ring from its header.
+#define ZX_CHANNEL_RING_HEADER_SIZE         ((uint64_t)4096u)
+
+// The size of the records of each ring. This is a power of two, so that the
+// free running |head| and |tail| counters can be reduced to an offset by
+// masking.
+#define ZX_CHANNEL_RING_DATA_SIZE           ((uint64_t)65536u)
+
+// Largest payload of a ZX_CHANNEL_RING_RECORD_DATA record. Larger messages are
+// sent with zx_channel_write().
+#define ZX_CHANNEL_RING_MAX_DATA_BYTES      ((uint32_t)4096u)
+
+// Records start at a multiple of this alignment.
+#define ZX_CHANNEL_RING_RECORD_ALIGN        ((uint32_t)8u)
+
+// zx_channel_ring_record_t::type
+// A message of |size| bytes follows the record.
+#define ZX_CHANNEL_RING_RECORD_DATA         ((uint32_t)1u)
+// The next message is read with zx_channel_read(). |size| is zero.
+#define ZX_CHANNEL_RING_RECORD_CHANNEL      ((uint32_t)2u)
+// The remainder of the ring up to its end is unused, the next record is at
+// the start of the ring. Written when a record would otherwise wrap.
+#define ZX_CHANNEL_RING_RECORD_PADDING      ((uint32_t)3u)
+
+// zx_channel_ring_header_t::reader_flags
+#define ZX_CHANNEL_RING_READER_WAITING      ((uint32_t)1u)
+
+// clang-format on
+
+typedef struct zx_channel_ring_info {
+    // ZX_CHANNEL_RING_VERSION.
+    uint32_t version;
+    uint8_t padding1[4];
+
+    // Offsets in the VMO of the header of the ring that this endpoint writes
+    // to, and of the ring that it reads from.
+    uint64_t tx_offset;
+    uint64_t rx_offset;
+
+    // The size of the records of each ring, ZX_CHANNEL_RING_DATA_SIZE.
+    uint64_t data_size;
+} zx_channel_ring_info_t;
+
+// The reader and writer fields are on separate cache lines. Both counters are
+// free running byte counts, and so the ring is empty when they are equal.
+typedef struct zx_channel_ring_header {
+    // Bytes consumed by the reader. Only written by the reader, with release
+    // semantics after it has finished with the records.
+    uint64_t head;
+    // ZX_CHANNEL_RING_READER_* flags, only written by the reader.
+    uint32_t reader_flags;
+    uint8_t padding1[52];
+
+    // Bytes produced by the writer. Only written by the writer, with release
+    // semantics after the records have been written.
+    uint64_t tail;
+    uint8_t padding2[56];
+} zx_channel_ring_header_t;
+
+typedef struct zx_channel_ring_record {
+    // ZX_CHANNEL_RING_RECORD_* type.
+    uint32_t type;
+    // Number of payload bytes that follow the record.
+    uint32_t size;
+} zx_channel_ring_record_t;
+
+__END_CDECLS
+
+#endif  // SYSROOT_ZIRCON_SYSCALLS_CHANNEL_H_
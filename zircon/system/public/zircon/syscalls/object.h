@@ -52,6 +52,8 @@ typedef uint32_t zx_object_info_topic_t;
 #define ZX_INFO_TASK_RUNTIME                __ZX_INFO_TOPIC(30u, 1)        // zx_info_task_runtime_t[1]
 #define ZX_INFO_KMEM_STATS_EXTENDED         ((zx_object_info_topic_t) 31u) // zx_info_kmem_stats_extended_t[1]
 #define ZX_INFO_VCPU                        ((zx_object_info_topic_t) 32u) // zx_info_vcpu_t[1]
+#define ZX_INFO_KMEM_STATS_COMPRESSION      ((zx_object_info_topic_t) 33u) // zx_info_kmem_stats_compression_t[1]
+#define ZX_INFO_KMEM_STATS_NUMA             ((zx_object_info_topic_t) 34u) // zx_info_kmem_stats_numa_t[n]
 
 // Return codes set when a task is killed.
 #define ZX_TASK_RETCODE_SYSCALL_KILL            ((int64_t) -1024)   // via zx_task_kill().
@@ -723,6 +725,47 @@ typedef struct zx_info_kmem_stats_extended {
     uint64_t other_bytes;
 } zx_info_kmem_stats_extended_t;
 
+// Information about the kernel's store of compressed anonymous pages. All
+// fields are zero if compression is not enabled.
+typedef struct zx_info_kmem_stats_compression {
+    // The size of the uncompressed contents of all the pages that are
+    // currently held in compressed form.
+    uint64_t uncompressed_storage_bytes;
+
+    // The amount of memory, including any metadata, that is currently used to
+    // hold compressed pages.
+    uint64_t compressed_storage_bytes;
+
+    // The total number of times the kernel has attempted to compress a page.
+    uint64_t total_page_compression_attempts;
+
+    // The total number of compression attempts where the page was left
+    // uncompressed, either because it did not compress well or because the
+    // store was full.
+    uint64_t failed_page_compression_attempts;
+
+    // The total number of pages that have been decompressed.
+    uint64_t total_page_decompressions;
+} zx_info_kmem_stats_compression_t;
+
+// Information about the physical memory of a single NUMA domain. Systems
+// without NUMA information report all memory as a single domain.
+typedef struct zx_info_kmem_stats_numa {
+    // The index of the domain.
+    uint32_t domain;
+    uint8_t padding1[4];
+
+    // The total amount of physical memory in the domain.
+    uint64_t total_bytes;
+
+    // The amount of unallocated memory in the domain.
+    uint64_t free_bytes;
+
+    // The amount of memory in the domain that is allocated, or is otherwise
+    // unavailable for allocation.
+    uint64_t used_bytes;
+} zx_info_kmem_stats_numa_t;
+
 typedef struct zx_info_resource {
     // The resource kind; resource object kinds are detailed in the resource.md
     uint32_t kind;
@@ -821,6 +864,20 @@ typedef struct zx_info_vcpu {
 // Argument is a uint8_t.
 #define ZX_PROP_STREAM_MODE_APPEND          19u
 
+// How the kernel's zero page scanner treats committed pages of a VMO.
+//
+// One of the ZX_VMO_ZERO_PAGE_DEDUP_* values below. By default only pages that
+// are first written through a mapping are candidates for being deduped back to
+// the zero page. DISABLED opts the VMO out of deduping entirely, and EAGER
+// makes every committed page of the VMO a candidate.
+//
+// Argument is a uint32_t.
+#define ZX_PROP_VMO_ZERO_PAGE_DEDUP         20u
+
+#define ZX_VMO_ZERO_PAGE_DEDUP_DEFAULT      ((uint32_t)0u)
+#define ZX_VMO_ZERO_PAGE_DEDUP_DISABLED     ((uint32_t)1u)
+#define ZX_VMO_ZERO_PAGE_DEDUP_EAGER        ((uint32_t)2u)
+
 // Basic thread states, in zx_info_thread_t.state.
 #define ZX_THREAD_STATE_NEW                 ((zx_thread_state_t) 0x0000u)
 #define ZX_THREAD_STATE_RUNNING             ((zx_thread_state_t) 0x0001u)
@@ -122,6 +122,9 @@ typedef uint32_t zx_signals_t;
 #define ZX_CHANNEL_READABLE         __ZX_OBJECT_READABLE
 #define ZX_CHANNEL_WRITABLE         __ZX_OBJECT_WRITABLE
 #define ZX_CHANNEL_PEER_CLOSED      __ZX_OBJECT_PEER_CLOSED
+// Only meaningful for channels created with ZX_CHANNEL_SHARED_RING, see
+// <zircon/syscalls/channel.h>.
+#define ZX_CHANNEL_RING_SIGNALED    __ZX_OBJECT_SIGNAL_4
 
 // Clock
 #define ZX_CLOCK_STARTED            __ZX_OBJECT_SIGNAL_4
@@ -189,6 +192,7 @@ typedef struct zx_wait_item {
 // VM Object creation options
 #define ZX_VMO_RESIZABLE                 ((uint32_t)1u << 1)
 #define ZX_VMO_DISCARDABLE               ((uint32_t)1u << 2)
+#define ZX_VMO_LARGE_PAGES               ((uint32_t)1u << 3)
 
 // VM Object opcodes
 #define ZX_VMO_OP_COMMIT                 ((uint32_t)1u)
@@ -205,6 +209,10 @@ typedef struct zx_wait_item {
 #define ZX_VMO_OP_TRY_LOCK               ((uint32_t)11u)
 #define ZX_VMO_OP_DONT_NEED              ((uint32_t)12u)
 #define ZX_VMO_OP_ALWAYS_NEED            ((uint32_t)13u)
+// Keep value in sync with ZX_VMAR_OP_DECOMMIT_BATCH.
+#define ZX_VMO_OP_DECOMMIT_BATCH         ((uint32_t)14u)
+// Keep value in sync with ZX_VMAR_OP_DONT_NEED_BATCH.
+#define ZX_VMO_OP_DONT_NEED_BATCH        ((uint32_t)15u)
 
 // |buffer| for zx_vmo_op_range() with ZX_VMO_OP_LOCK.
 typedef struct zx_vmo_lock_state {
@@ -221,6 +229,15 @@ typedef struct zx_vmo_lock_state {
   uint64_t discarded_size;
 } zx_vmo_lock_state_t;
 
+// |buffer| for zx_vmo_op_range() and zx_vmar_op_range() with the *_BATCH opcodes, which apply the
+// equivalent non batched op to every range in an array of these, in order. The |offset| and |size|
+// arguments of the call must both be zero, and |buffer_size| is the size of the array in bytes.
+typedef struct zx_op_range {
+  // Offset into the VMO, or address in the VMAR, of the start of the range.
+  uint64_t offset;
+  uint64_t size;
+} zx_op_range_t;
+
 // VMAR opcodes
 // Keep value in sync with ZX_VMO_OP_COMMIT.
 #define ZX_VMAR_OP_COMMIT                ((uint32_t)1u)
@@ -231,6 +248,10 @@ typedef struct zx_vmo_lock_state {
 #define ZX_VMAR_OP_DONT_NEED             ((uint32_t)12u)
 // Keep value in sync with ZX_VMO_OP_ALWAYS_NEED.
 #define ZX_VMAR_OP_ALWAYS_NEED           ((uint32_t)13u)
+// Keep value in sync with ZX_VMO_OP_DECOMMIT_BATCH.
+#define ZX_VMAR_OP_DECOMMIT_BATCH        ((uint32_t)14u)
+// Keep value in sync with ZX_VMO_OP_DONT_NEED_BATCH.
+#define ZX_VMAR_OP_DONT_NEED_BATCH       ((uint32_t)15u)
 
 // Pager opcodes
 #define ZX_PAGER_OP_FAIL                 ((uint32_t)1u)
@@ -342,6 +363,8 @@ typedef struct zx_iovec {
 // Channel options and limits.
 #define ZX_CHANNEL_READ_MAY_DISCARD         ((uint32_t)1u)
 #define ZX_CHANNEL_WRITE_USE_IOVEC          ((uint32_t)2u)
+// zx_channel_create() option, see <zircon/syscalls/channel.h>.
+#define ZX_CHANNEL_SHARED_RING              ((uint32_t)1u)
 
 // TODO(fxbug.dev/7802): This must be manually kept in sync with zx_common.fidl.
 // Eventually (some of) this file will be generated from //zircon/vdso.
@@ -349,7 +372,14 @@ typedef struct zx_iovec {
 #define ZX_CHANNEL_MAX_MSG_HANDLES          ((uint32_t)64u)
 #define ZX_CHANNEL_MAX_MSG_IOVECS           ((uint32_t)8192u)
 
-// Fifo limits.
+// Fifo options and limits.
+
+// These can be passed to zx_fifo_create(). With ZX_FIFO_READ_POLLING, an
+// endpoint from which elements have been read is polling: its reader promises
+// to read again before waiting, and writes that make it non-empty do not
+// assert ZX_FIFO_READABLE. A read that finds the endpoint empty ends polling.
+#define ZX_FIFO_READ_POLLING                ((uint32_t)1u << 0)
+
 #define ZX_FIFO_MAX_SIZE_BYTES              ZX_PAGE_SIZE
 
 // Socket options and limits.
@@ -366,6 +396,12 @@ typedef struct zx_iovec {
 // These can be passed to zx_socket_read().
 #define ZX_SOCKET_PEEK                      ((uint32_t)1u << 3)
 
+// These can be passed to zx_socket_read() and zx_socket_write(). The buffer is
+// an array of zx_iovec_t and the size is the number of entries, at most
+// ZX_SOCKET_MAX_IOVECS.
+#define ZX_SOCKET_USE_IOVEC                 ((uint32_t)1u << 4)
+#define ZX_SOCKET_MAX_IOVECS                ((uint32_t)8192u)
+
 // These can be passed to zx_stream_create().
 #define ZX_STREAM_MODE_READ                 ((uint32_t)1u << 0)
 #define ZX_STREAM_MODE_WRITE                ((uint32_t)1u << 1)
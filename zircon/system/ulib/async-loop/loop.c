@@ -23,6 +23,9 @@
 // The port wait key associated with the dispatcher's control messages.
 #define KEY_CONTROL (0u)
 
+// The maximum number of batches of due tasks dispatched per timer expiration.
+#define MAX_TASK_BATCHES (4u)
+
 static zx_time_t async_loop_now(async_dispatcher_t* dispatcher);
 static zx_status_t async_loop_begin_wait(async_dispatcher_t* dispatcher, async_wait_t* wait);
 static zx_status_t async_loop_cancel_wait(async_dispatcher_t* dispatcher, async_wait_t* wait);
@@ -100,6 +103,7 @@ static zx_status_t async_loop_dispatch_wait(async_loop_t* loop, async_wait_t* wa
 static zx_status_t async_loop_dispatch_irq(async_loop_t* loop, async_irq_t* irq, zx_status_t status,
                                            const zx_packet_interrupt_t* interrupt);
 static zx_status_t async_loop_dispatch_tasks(async_loop_t* loop);
+static bool async_loop_take_due_tasks_locked(async_loop_t* loop);
 static void async_loop_dispatch_task(async_loop_t* loop, async_task_t* task, zx_status_t status);
 static zx_status_t async_loop_dispatch_packet(async_loop_t* loop, async_receiver_t* receiver,
                                               zx_status_t status, const zx_packet_user_t* data);
@@ -400,43 +404,36 @@ static zx_status_t async_loop_dispatch_tasks(async_loop_t* loop) {
   if (!loop->dispatching_tasks) {
     loop->dispatching_tasks = true;
 
-    // Extract all of the tasks that are due into |due_list| for dispatch
-    // unless we already have some waiting from a previous iteration which
-    // we would like to process in order.
-    list_node_t* node;
-    if (list_is_empty(&loop->due_list)) {
-      zx_time_t due_time = async_loop_now((async_dispatcher_t*)loop);
-      list_node_t* tail = NULL;
-      list_for_every(&loop->task_list, node) {
-        if (node_to_task(node)->deadline > due_time)
+    // Tasks which come due while a batch is being dispatched (typically ones
+    // posted by the tasks being run) are picked up here directly rather than
+    // by rearming the timer and waiting for it on the port again.  The number
+    // of batches is bounded so that tasks which keep reposting themselves
+    // cannot starve waits and packets.
+    bool runnable = true;
+    for (uint32_t batch = 0; runnable && batch < MAX_TASK_BATCHES; batch++) {
+      // Dispatch the tasks left in |due_list| by a previous iteration first
+      // so that they are processed in order.
+      if (list_is_empty(&loop->due_list) && !async_loop_take_due_tasks_locked(loop))
+        break;
+
+      // Dispatch all due tasks.  Note that they might be canceled concurrently
+      // so we need to grab the lock during each iteration to fetch the next
+      // item from the list.
+      list_node_t* node;
+      while ((node = list_remove_head(&loop->due_list))) {
+        mtx_unlock(&loop->lock);
+
+        // Invoke the handler.  Note that it might destroy itself.
+        async_task_t* task = node_to_task(node);
+        async_loop_dispatch_task(loop, task, ZX_OK);
+
+        mtx_lock(&loop->lock);
+        async_loop_state_t state = atomic_load_explicit(&loop->state, memory_order_acquire);
+        if (state != ASYNC_LOOP_RUNNABLE) {
+          runnable = false;
           break;
-        tail = node;
+        }
       }
-      if (tail) {
-        list_node_t* head = loop->task_list.next;
-        loop->task_list.next = tail->next;
-        tail->next->prev = &loop->task_list;
-        loop->due_list.next = head;
-        head->prev = &loop->due_list;
-        loop->due_list.prev = tail;
-        tail->next = &loop->due_list;
-      }
-    }
-
-    // Dispatch all due tasks.  Note that they might be canceled concurrently
-    // so we need to grab the lock during each iteration to fetch the next
-    // item from the list.
-    while ((node = list_remove_head(&loop->due_list))) {
-      mtx_unlock(&loop->lock);
-
-      // Invoke the handler.  Note that it might destroy itself.
-      async_task_t* task = node_to_task(node);
-      async_loop_dispatch_task(loop, task, ZX_OK);
-
-      mtx_lock(&loop->lock);
-      async_loop_state_t state = atomic_load_explicit(&loop->state, memory_order_acquire);
-      if (state != ASYNC_LOOP_RUNNABLE)
-        break;
     }
 
     loop->dispatching_tasks = false;
@@ -447,6 +444,30 @@ static zx_status_t async_loop_dispatch_tasks(async_loop_t* loop) {
   return ZX_OK;
 }
 
+// Moves all of the tasks that are due from |task_list| into |due_list|.
+// Returns false if no tasks are due.
+static bool async_loop_take_due_tasks_locked(async_loop_t* loop) {
+  zx_time_t due_time = async_loop_now((async_dispatcher_t*)loop);
+  list_node_t* tail = NULL;
+  list_node_t* node;
+  list_for_every(&loop->task_list, node) {
+    if (node_to_task(node)->deadline > due_time)
+      break;
+    tail = node;
+  }
+  if (!tail)
+    return false;
+
+  list_node_t* head = loop->task_list.next;
+  loop->task_list.next = tail->next;
+  tail->next->prev = &loop->task_list;
+  loop->due_list.next = head;
+  head->prev = &loop->due_list;
+  loop->due_list.prev = tail;
+  tail->next = &loop->due_list;
+  return true;
+}
+
 static void async_loop_dispatch_task(async_loop_t* loop, async_task_t* task, zx_status_t status) {
   // Invoke the handler.  Note that it might destroy itself.
   async_loop_invoke_prologue(loop);
@@ -725,12 +746,26 @@ static void async_loop_insert_task_locked(async_loop_t* loop, async_task_t* task
   // that insertion into the task queue will typically take no more than a few steps.
   // If this assumption proves false and the cost of insertion becomes a problem, we
   // should consider using a more efficient representation for maintaining order.
-  list_node_t* node;
-  for (node = loop->task_list.prev; node != &loop->task_list; node = node->prev) {
-    if (task->deadline >= node_to_task(node)->deadline)
-      break;
+  //
+  // The queue is scanned from both ends at once, so that tasks posted to run
+  // immediately are inserted cheaply even when many tasks with long deadlines
+  // (such as timeouts) are pending.  Tasks with equal deadlines are kept in
+  // the order in which they were posted.
+  list_node_t* back = loop->task_list.prev;
+  list_node_t* front = loop->task_list.next;
+  for (;;) {
+    if (back == &loop->task_list || task->deadline >= node_to_task(back)->deadline) {
+      list_add_after(back, task_to_node(task));
+      return;
+    }
+    ZX_DEBUG_ASSERT(front != &loop->task_list);
+    if (task->deadline < node_to_task(front)->deadline) {
+      list_add_before(front, task_to_node(task));
+      return;
+    }
+    back = back->prev;
+    front = front->next;
   }
-  list_add_after(node, task_to_node(task));
 }
 
 static zx_time_t async_loop_next_deadline_locked(async_loop_t* loop) {
@@ -30,6 +30,7 @@
 #include <atomic>
 #include <random>
 #include <utility>
+#include <vector>
 
 #include <fbl/auto_lock.h>
 #include <fbl/mutex.h>
@@ -808,6 +809,47 @@ TEST(Loop, Task) {
   loop.Shutdown();
 }
 
+TEST(Loop, TasksPostedByDueTasksRunInTheSamePass) {
+  async::Loop loop(&kAsyncLoopConfigNoAttachToCurrentThread);
+
+  uint32_t run_count = 0u;
+  EXPECT_OK(async::PostTask(loop.dispatcher(), [&loop, &run_count] {
+    run_count++;
+    EXPECT_OK(async::PostTask(loop.dispatcher(), [&run_count] { run_count++; }));
+  }));
+
+  // A single timer expiration dispatches both the task and the one it posted.
+  EXPECT_OK(loop.Run(zx::time::infinite(), true));
+  EXPECT_EQ(2u, run_count);
+
+  loop.Shutdown();
+}
+
+TEST(Loop, TasksRunInDeadlineOrderBehindLongTimeouts) {
+  async::Loop loop(&kAsyncLoopConfigNoAttachToCurrentThread);
+
+  const zx::time now = async::Now(loop.dispatcher());
+  for (int i = 0; i < 8; i++) {
+    EXPECT_OK(async::PostTaskForTime(
+        loop.dispatcher(), [] { ADD_FAILURE("timeout ran"); }, now + zx::hour(1)));
+  }
+
+  // Deadlines in the past, posted out of order.  Tasks with equal deadlines
+  // run in the order they were posted.
+  std::vector<int> order;
+  const zx::time base = now - zx::sec(1);
+  const int64_t offsets_ms[] = {2, 0, 0, 1, 3, 1};
+  for (int i = 0; i < 6; i++) {
+    EXPECT_OK(async::PostTaskForTime(
+        loop.dispatcher(), [&order, i] { order.push_back(i); }, base + zx::msec(offsets_ms[i])));
+  }
+
+  EXPECT_OK(loop.RunUntilIdle());
+  EXPECT_EQ(order, (std::vector<int>{1, 2, 3, 5, 0, 4}));
+
+  loop.Shutdown();
+}
+
 TEST(Loop, TaskShutdown) {
   async::Loop loop(&kAsyncLoopConfigNoAttachToCurrentThread);
 
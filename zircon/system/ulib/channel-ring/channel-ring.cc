@@ -0,0 +1,271 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "lib/channel-ring/channel-ring.h"
+
+#include <lib/zx/vmar.h>
+#include <string.h>
+#include <zircon/assert.h>
+#include <zircon/errors.h>
+#include <zircon/syscalls/object.h>
+
+#include <utility>
+
+namespace channel_ring {
+namespace {
+
+constexpr uint64_t RecordSize(uint64_t payload) {
+  return (sizeof(zx_channel_ring_record_t) + payload + ZX_CHANNEL_RING_RECORD_ALIGN - 1) &
+         ~static_cast<uint64_t>(ZX_CHANNEL_RING_RECORD_ALIGN - 1);
+}
+
+// Checks that a ring with |data_size| bytes of records at |offset| lies within a VMO of
+// |vmo_size| bytes.
+bool RingFits(uint64_t offset, uint64_t data_size, uint64_t vmo_size) {
+  return offset % ZX_CHANNEL_RING_RECORD_ALIGN == 0 && offset <= vmo_size &&
+         vmo_size - offset >= ZX_CHANNEL_RING_HEADER_SIZE &&
+         vmo_size - offset - ZX_CHANNEL_RING_HEADER_SIZE >= data_size;
+}
+
+}  // namespace
+
+ChannelRing::ChannelRing(zx::channel channel, zx::vmo vmo, uintptr_t mapping, size_t mapping_size,
+                         const zx_channel_ring_info_t& info)
+    : channel_(std::move(channel)),
+      vmo_(std::move(vmo)),
+      mapping_(mapping),
+      mapping_size_(mapping_size),
+      info_(info) {}
+
+ChannelRing::~ChannelRing() { zx::vmar::root_self()->unmap(mapping_, mapping_size_); }
+
+// static
+zx_status_t ChannelRing::Create(zx::channel channel, std::unique_ptr<ChannelRing>* out) {
+  zx_channel_ring_info_t info;
+  zx_handle_t handle = ZX_HANDLE_INVALID;
+  uint32_t actual_bytes = 0;
+  uint32_t actual_handles = 0;
+  zx_status_t status =
+      channel.read(0, &info, &handle, sizeof(info), 1, &actual_bytes, &actual_handles);
+  if (status == ZX_ERR_BUFFER_TOO_SMALL) {
+    return ZX_ERR_NOT_SUPPORTED;
+  }
+  if (status != ZX_OK) {
+    return status;
+  }
+  zx::vmo vmo(handle);
+  if (actual_bytes != sizeof(info) || actual_handles != 1 ||
+      info.version != ZX_CHANNEL_RING_VERSION) {
+    return ZX_ERR_NOT_SUPPORTED;
+  }
+  zx_info_handle_basic_t basic;
+  status = vmo.get_info(ZX_INFO_HANDLE_BASIC, &basic, sizeof(basic), nullptr, nullptr);
+  if (status != ZX_OK || basic.type != ZX_OBJ_TYPE_VMO) {
+    return ZX_ERR_NOT_SUPPORTED;
+  }
+
+  // The ring must hold at least two of the largest records, and its size has to be a power of two
+  // for the counters to wrap around it.
+  const uint64_t data_size = info.data_size;
+  if (data_size < 2 * RecordSize(ZX_CHANNEL_RING_MAX_DATA_BYTES) ||
+      (data_size & (data_size - 1)) != 0) {
+    return ZX_ERR_NOT_SUPPORTED;
+  }
+  uint64_t vmo_size;
+  status = vmo.get_size(&vmo_size);
+  if (status != ZX_OK) {
+    return status;
+  }
+  if (!RingFits(info.tx_offset, data_size, vmo_size) ||
+      !RingFits(info.rx_offset, data_size, vmo_size)) {
+    return ZX_ERR_NOT_SUPPORTED;
+  }
+
+  zx_vaddr_t mapping;
+  status = zx::vmar::root_self()->map(ZX_VM_PERM_READ | ZX_VM_PERM_WRITE, 0, vmo, 0, vmo_size,
+                                      &mapping);
+  if (status != ZX_OK) {
+    return status;
+  }
+  out->reset(new ChannelRing(std::move(channel), std::move(vmo), mapping, vmo_size, info));
+  return ZX_OK;
+}
+
+zx_channel_ring_header_t* ChannelRing::tx_header() const {
+  return reinterpret_cast<zx_channel_ring_header_t*>(mapping_ + info_.tx_offset);
+}
+
+zx_channel_ring_header_t* ChannelRing::rx_header() const {
+  return reinterpret_cast<zx_channel_ring_header_t*>(mapping_ + info_.rx_offset);
+}
+
+uint8_t* ChannelRing::tx_data() const {
+  return reinterpret_cast<uint8_t*>(mapping_ + info_.tx_offset + ZX_CHANNEL_RING_HEADER_SIZE);
+}
+
+uint8_t* ChannelRing::rx_data() const {
+  return reinterpret_cast<uint8_t*>(mapping_ + info_.rx_offset + ZX_CHANNEL_RING_HEADER_SIZE);
+}
+
+zx_status_t ChannelRing::Reserve(uint32_t payload, uint64_t* out_tail) {
+  zx_channel_ring_header_t* header = tx_header();
+  const uint64_t size = info_.data_size;
+  const uint64_t head = __atomic_load_n(&header->head, __ATOMIC_ACQUIRE);
+  // Only this endpoint writes |tail|, so it needs no ordering here.
+  uint64_t tail = __atomic_load_n(&header->tail, __ATOMIC_RELAXED);
+
+  const uint64_t record = RecordSize(payload);
+  const uint64_t offset = tail & (size - 1);
+  const uint64_t padding = offset + record > size ? size - offset : 0;
+  if (tail - head > size || size - (tail - head) < padding + record) {
+    return ZX_ERR_SHOULD_WAIT;
+  }
+  if (padding != 0) {
+    auto* pad = reinterpret_cast<zx_channel_ring_record_t*>(tx_data() + offset);
+    pad->type = ZX_CHANNEL_RING_RECORD_PADDING;
+    pad->size = static_cast<uint32_t>(padding - sizeof(zx_channel_ring_record_t));
+    tail += padding;
+  }
+  *out_tail = tail;
+  return ZX_OK;
+}
+
+void ChannelRing::Publish(uint64_t tail) {
+  zx_channel_ring_header_t* header = tx_header();
+  // Both the store of |tail| and the load of |reader_flags| are sequentially consistent, pairing
+  // with the reverse order in Wait(), so that either the writer sees the reader waiting or the
+  // reader sees the new records.
+  __atomic_store_n(&header->tail, tail, __ATOMIC_SEQ_CST);
+  if (__atomic_load_n(&header->reader_flags, __ATOMIC_SEQ_CST) & ZX_CHANNEL_RING_READER_WAITING) {
+    channel_.signal_peer(0, ZX_CHANNEL_RING_SIGNALED);
+  }
+}
+
+zx_status_t ChannelRing::Write(const void* bytes, uint32_t num_bytes, const zx_handle_t* handles,
+                               uint32_t num_handles) {
+  const bool use_ring = num_handles == 0 && num_bytes <= ZX_CHANNEL_RING_MAX_DATA_BYTES;
+  const uint32_t payload = use_ring ? num_bytes : 0;
+  uint64_t tail;
+  zx_status_t status = Reserve(payload, &tail);
+  if (status != ZX_OK) {
+    return status;
+  }
+
+  auto* record =
+      reinterpret_cast<zx_channel_ring_record_t*>(tx_data() + (tail & (info_.data_size - 1)));
+  if (use_ring) {
+    record->type = ZX_CHANNEL_RING_RECORD_DATA;
+    record->size = num_bytes;
+    memcpy(record + 1, bytes, num_bytes);
+  } else {
+    // The message is queued before its record is published, so that a reader that finds the
+    // record never has to wait for the message.
+    status = channel_.write(0, bytes, num_bytes, handles, num_handles);
+    if (status != ZX_OK) {
+      return status;
+    }
+    record->type = ZX_CHANNEL_RING_RECORD_CHANNEL;
+    record->size = 0;
+  }
+  Publish(tail + RecordSize(payload));
+  return ZX_OK;
+}
+
+bool ChannelRing::RxEmpty() const {
+  zx_channel_ring_header_t* header = rx_header();
+  return __atomic_load_n(&header->tail, __ATOMIC_SEQ_CST) ==
+         __atomic_load_n(&header->head, __ATOMIC_RELAXED);
+}
+
+zx_status_t ChannelRing::Read(void* bytes, uint32_t num_bytes, uint32_t* actual_bytes,
+                              zx_handle_t* handles, uint32_t num_handles,
+                              uint32_t* actual_handles) {
+  zx_channel_ring_header_t* header = rx_header();
+  const uint64_t size = info_.data_size;
+  uint64_t head = __atomic_load_n(&header->head, __ATOMIC_RELAXED);
+  for (;;) {
+    const uint64_t tail = __atomic_load_n(&header->tail, __ATOMIC_ACQUIRE);
+    if (tail == head) {
+      return ZX_ERR_SHOULD_WAIT;
+    }
+    // Everything in the ring was written by the peer, so check it all before use.
+    const uint64_t available = tail - head;
+    const uint64_t offset = head & (size - 1);
+    if (available > size || available < sizeof(zx_channel_ring_record_t)) {
+      return ZX_ERR_IO_DATA_INTEGRITY;
+    }
+    zx_channel_ring_record_t record;
+    memcpy(&record, rx_data() + offset, sizeof(record));
+
+    switch (record.type) {
+      case ZX_CHANNEL_RING_RECORD_PADDING: {
+        const uint64_t skip = size - offset;
+        if (skip > available) {
+          return ZX_ERR_IO_DATA_INTEGRITY;
+        }
+        head += skip;
+        __atomic_store_n(&header->head, head, __ATOMIC_RELEASE);
+        continue;
+      }
+      case ZX_CHANNEL_RING_RECORD_DATA: {
+        const uint64_t record_size = RecordSize(record.size);
+        if (record.size > ZX_CHANNEL_RING_MAX_DATA_BYTES || record_size > available ||
+            offset + record_size > size) {
+          return ZX_ERR_IO_DATA_INTEGRITY;
+        }
+        if (actual_bytes) {
+          *actual_bytes = record.size;
+        }
+        if (actual_handles) {
+          *actual_handles = 0;
+        }
+        if (record.size > num_bytes) {
+          return ZX_ERR_BUFFER_TOO_SMALL;
+        }
+        memcpy(bytes, rx_data() + offset + sizeof(record), record.size);
+        __atomic_store_n(&header->head, head + record_size, __ATOMIC_RELEASE);
+        return ZX_OK;
+      }
+      case ZX_CHANNEL_RING_RECORD_CHANNEL: {
+        zx_status_t status =
+            channel_.read(0, bytes, handles, num_bytes, num_handles, actual_bytes, actual_handles);
+        if (status != ZX_OK) {
+          return status == ZX_ERR_SHOULD_WAIT ? ZX_ERR_IO_DATA_INTEGRITY : status;
+        }
+        __atomic_store_n(&header->head, head + RecordSize(0), __ATOMIC_RELEASE);
+        return ZX_OK;
+      }
+      default:
+        return ZX_ERR_IO_DATA_INTEGRITY;
+    }
+  }
+}
+
+zx_status_t ChannelRing::Wait(zx::time deadline) {
+  if (!RxEmpty()) {
+    return ZX_OK;
+  }
+  zx_channel_ring_header_t* header = rx_header();
+  __atomic_store_n(&header->reader_flags, ZX_CHANNEL_RING_READER_WAITING, __ATOMIC_SEQ_CST);
+  zx_status_t status = ZX_OK;
+  while (RxEmpty()) {
+    zx_signals_t observed = 0;
+    status = channel_.wait_one(ZX_CHANNEL_RING_SIGNALED | ZX_CHANNEL_PEER_CLOSED, deadline,
+                               &observed);
+    if (status != ZX_OK) {
+      break;
+    }
+    if (observed & ZX_CHANNEL_RING_SIGNALED) {
+      // The ring is checked again after clearing, so a signal raised in between is not lost.
+      channel_.signal(ZX_CHANNEL_RING_SIGNALED, 0);
+    } else if (RxEmpty()) {
+      status = ZX_ERR_PEER_CLOSED;
+      break;
+    }
+  }
+  __atomic_store_n(&header->reader_flags, 0u, __ATOMIC_RELAXED);
+  return status;
+}
+
+}  // namespace channel_ring
@@ -0,0 +1,90 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LIB_CHANNEL_RING_CHANNEL_RING_H_
+#define LIB_CHANNEL_RING_CHANNEL_RING_H_
+
+#include <lib/zx/channel.h>
+#include <lib/zx/time.h>
+#include <lib/zx/vmo.h>
+#include <zircon/syscalls/channel.h>
+#include <zircon/types.h>
+
+#include <memory>
+
+namespace channel_ring {
+
+// One endpoint of a channel created with ZX_CHANNEL_SHARED_RING, implementing the protocol
+// described in <zircon/syscalls/channel.h>.
+//
+// Small messages without handles are exchanged through the shared ring, without entering the
+// kernel unless the peer is waiting. Any other message is written to the channel, in order with
+// the messages sent through the ring.
+//
+// An endpoint may be used by one writing and one reading thread at the same time. Concurrent
+// calls to Write(), or to Read() and Wait(), must be serialized by the caller.
+class ChannelRing {
+ public:
+  ChannelRing(const ChannelRing&) = delete;
+  ChannelRing& operator=(const ChannelRing&) = delete;
+  ~ChannelRing();
+
+  // Takes over |channel|, which must be an endpoint of a channel created with
+  // ZX_CHANNEL_SHARED_RING that has not been read from yet. Reads the ring information that the
+  // kernel queued on it and maps the shared rings.
+  //
+  // Returns ZX_ERR_NOT_SUPPORTED if the first message is not a valid ring information message.
+  static zx_status_t Create(zx::channel channel, std::unique_ptr<ChannelRing>* out);
+
+  // Sends a message. Messages of at most ZX_CHANNEL_RING_MAX_DATA_BYTES without handles go
+  // through the ring, anything else through zx_channel_write(). On failure no message is sent,
+  // and |handles| are consumed only if zx_channel_write() consumed them.
+  //
+  // Returns ZX_ERR_SHOULD_WAIT if the ring is too full to take the message, or the record that
+  // orders a channel message with the ring.
+  zx_status_t Write(const void* bytes, uint32_t num_bytes, const zx_handle_t* handles,
+                    uint32_t num_handles);
+
+  // Receives the next message, from the ring or from the channel as the writer ordered them.
+  //
+  // Returns ZX_ERR_SHOULD_WAIT if there is no message, and ZX_ERR_BUFFER_TOO_SMALL, with
+  // |actual_bytes| and |actual_handles| set, if the message does not fit. Returns
+  // ZX_ERR_IO_DATA_INTEGRITY if the peer wrote a malformed record.
+  zx_status_t Read(void* bytes, uint32_t num_bytes, uint32_t* actual_bytes, zx_handle_t* handles,
+                   uint32_t num_handles, uint32_t* actual_handles);
+
+  // Waits until Read() has a message to return, or |deadline| passes.
+  //
+  // Returns ZX_ERR_PEER_CLOSED if there is no message and the peer is closed.
+  zx_status_t Wait(zx::time deadline);
+
+  const zx::channel& channel() const { return channel_; }
+
+ private:
+  ChannelRing(zx::channel channel, zx::vmo vmo, uintptr_t mapping, size_t mapping_size,
+              const zx_channel_ring_info_t& info);
+
+  zx_channel_ring_header_t* tx_header() const;
+  zx_channel_ring_header_t* rx_header() const;
+  uint8_t* tx_data() const;
+  uint8_t* rx_data() const;
+
+  // Reserves room for a record with |payload| bytes in the transmit ring, adding padding if it
+  // would wrap. Returns the position of the record in |out_tail|, or ZX_ERR_SHOULD_WAIT.
+  zx_status_t Reserve(uint32_t payload, uint64_t* out_tail);
+  // Makes the records up to |tail| visible to the reader, and wakes it if it is waiting.
+  void Publish(uint64_t tail);
+
+  bool RxEmpty() const;
+
+  zx::channel channel_;
+  zx::vmo vmo_;
+  uintptr_t mapping_;
+  size_t mapping_size_;
+  zx_channel_ring_info_t info_;
+};
+
+}  // namespace channel_ring
+
+#endif  // LIB_CHANNEL_RING_CHANNEL_RING_H_
@@ -0,0 +1,435 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FBL_FLAT_HASH_MAP_H_
+#define FBL_FLAT_HASH_MAP_H_
+
+#include <stdint.h>
+#include <zircon/assert.h>
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <fbl/alloc_checker.h>
+#include <fbl/macros.h>
+
+namespace fbl {
+
+// DefaultFlatHashMapTraits defines the hash function and key comparison used by a FlatHashMap
+// whose keys are integers, enums or pointers, such as koids and handle values.
+//
+// A class or struct which is to be used as the traits of a FlatHashMap must define...
+//
+// GetHash : A static method which takes a constant reference to a key and returns a uint64_t hash
+//           of it. The low bits of the hash pick the slot, so they must be well mixed.
+// EqualTo : A static method which takes two constant references to keys and returns whether they
+//           are equal.
+template <typename KeyType>
+struct DefaultFlatHashMapTraits {
+  static_assert(std::is_integral_v<KeyType> || std::is_enum_v<KeyType> ||
+                    std::is_pointer_v<KeyType>,
+                "Keys other than integers, enums and pointers need custom traits");
+
+  static uint64_t GetHash(const KeyType& key) {
+    uint64_t x;
+    if constexpr (std::is_pointer_v<KeyType>) {
+      x = reinterpret_cast<uintptr_t>(key);
+    } else {
+      x = static_cast<uint64_t>(key);
+    }
+    // The splitmix64 finalizer, so that sequential keys don't land in sequential slots.
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+    return x ^ (x >> 31);
+  }
+
+  static bool EqualTo(const KeyType& a, const KeyType& b) { return a == b; }
+};
+
+namespace internal {
+
+// A single open addressing table using linear probing with Robin Hood hashing.
+//
+// The probe distance of every slot is kept in an array of bytes separate from the entries, so a
+// probe mostly reads metadata which is densely packed into cache lines, and only reads an entry
+// when its distance matches that of the key being looked for. Entries are removed by shifting the
+// ones after them back, so there are no tombstones.
+template <typename KeyType, typename ValueType, typename Traits>
+class FlatHashTable {
+ public:
+  struct Entry {
+    KeyType key;
+    ValueType value;
+  };
+
+  static constexpr size_t kNotFound = SIZE_MAX;
+  // Distances are 1 + the number of slots an entry is away from its home slot, and 0 marks an
+  // empty slot.
+  static constexpr uint8_t kMaxDistance = UINT8_MAX;
+
+  FlatHashTable() = default;
+  ~FlatHashTable() { Reset(); }
+
+  FlatHashTable(FlatHashTable&& other) { *this = std::move(other); }
+  FlatHashTable& operator=(FlatHashTable&& other) {
+    if (this != &other) {
+      Reset();
+      distances_ = other.distances_;
+      slots_ = other.slots_;
+      mask_ = other.mask_;
+      size_ = other.size_;
+      other.distances_ = nullptr;
+      other.slots_ = nullptr;
+      other.mask_ = 0;
+      other.size_ = 0;
+    }
+    return *this;
+  }
+
+  DISALLOW_COPY_AND_ASSIGN_ALLOW_MOVE(FlatHashTable);
+
+  // Allocates an empty table with |capacity| slots, which must be a power of two.
+  bool Init(size_t capacity) {
+    ZX_DEBUG_ASSERT(capacity > 0 && (capacity & (capacity - 1)) == 0);
+    ZX_DEBUG_ASSERT(slots_ == nullptr);
+    AllocChecker ac;
+    distances_ = new (&ac) uint8_t[capacity]();
+    if (!ac.check()) {
+      return false;
+    }
+    slots_ = new (&ac) Slot[capacity];
+    if (!ac.check()) {
+      delete[] distances_;
+      distances_ = nullptr;
+      return false;
+    }
+    mask_ = capacity - 1;
+    return true;
+  }
+
+  // Destroys every entry and frees the table.
+  void Reset() {
+    if (slots_ != nullptr) {
+      for (size_t i = 0; i <= mask_; ++i) {
+        if (distances_[i] != 0) {
+          slots_[i].entry.~Entry();
+        }
+      }
+    }
+    delete[] slots_;
+    delete[] distances_;
+    slots_ = nullptr;
+    distances_ = nullptr;
+    mask_ = 0;
+    size_ = 0;
+  }
+
+  bool is_allocated() const { return slots_ != nullptr; }
+  size_t capacity() const { return is_allocated() ? mask_ + 1 : 0; }
+  size_t size() const { return size_; }
+
+  bool is_occupied(size_t index) const { return distances_[index] != 0; }
+  Entry& entry(size_t index) { return slots_[index].entry; }
+  const Entry& entry(size_t index) const { return slots_[index].entry; }
+
+  // Returns the index of |key|, or kNotFound.
+  size_t Find(const KeyType& key, uint64_t hash) const {
+    if (!is_allocated()) {
+      return kNotFound;
+    }
+    size_t index = hash & mask_;
+    for (uint8_t distance = 1;; ++distance) {
+      // An entry closer to its home than |key| would be means |key| would have displaced it.
+      if (distances_[index] < distance) {
+        return kNotFound;
+      }
+      if (distances_[index] == distance && Traits::EqualTo(slots_[index].entry.key, key)) {
+        return index;
+      }
+      if (distance == kMaxDistance) {
+        return kNotFound;
+      }
+      index = (index + 1) & mask_;
+    }
+  }
+
+  // Returns whether an entry with |hash| can be inserted without any entry getting further than
+  // kMaxDistance from its home. This walks the same slots Insert() would, without moving anything.
+  bool CanInsert(uint64_t hash) const {
+    if (size_ > mask_) {
+      return false;
+    }
+    size_t index = hash & mask_;
+    for (uint8_t distance = 1;; ++distance) {
+      if (distances_[index] == 0) {
+        return true;
+      }
+      if (distances_[index] < distance) {
+        // Insert() would carry on with the entry it displaced here.
+        distance = distances_[index];
+      }
+      if (distance == kMaxDistance) {
+        return false;
+      }
+      index = (index + 1) & mask_;
+    }
+  }
+
+  // Inserts |entry|, which mustn't be in the table, given that CanInsert(hash) is true.
+  void Insert(Entry&& entry, uint64_t hash) {
+    ZX_DEBUG_ASSERT(CanInsert(hash));
+    Entry carried = std::move(entry);
+    size_t index = hash & mask_;
+    for (uint8_t distance = 1;; ++distance) {
+      if (distances_[index] == 0) {
+        new (&slots_[index].entry) Entry(std::move(carried));
+        distances_[index] = distance;
+        ++size_;
+        return;
+      }
+      if (distances_[index] < distance) {
+        // Take the slot from an entry closer to its home and carry on inserting that one instead.
+        std::swap(carried, slots_[index].entry);
+        std::swap(distance, distances_[index]);
+      }
+      index = (index + 1) & mask_;
+    }
+  }
+
+  // Moves the entry at |index| out of the table.
+  Entry Remove(size_t index) {
+    ZX_DEBUG_ASSERT(is_occupied(index));
+    Entry removed = std::move(slots_[index].entry);
+    // Shift back the entries after it which aren't in their home slot.
+    for (size_t next = (index + 1) & mask_; distances_[next] > 1; next = (next + 1) & mask_) {
+      slots_[index].entry = std::move(slots_[next].entry);
+      distances_[index] = static_cast<uint8_t>(distances_[next] - 1);
+      index = next;
+    }
+    slots_[index].entry.~Entry();
+    distances_[index] = 0;
+    --size_;
+    return removed;
+  }
+
+ private:
+  union Slot {
+    Slot() {}
+    ~Slot() {}
+    Entry entry;
+  };
+
+  uint8_t* distances_ = nullptr;
+  Slot* slots_ = nullptr;
+  size_t mask_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace internal
+
+// FlatHashMap is a non-intrusive hash map which stores its entries in a single open addressing
+// table, instead of chaining them through intrusive lists like fbl::HashTable. Lookups touch a
+// handful of contiguous slots rather than following a pointer per entry, which makes it a better
+// fit for large maps of small keys and values, such as koid or handle maps.
+//
+// FlatHashMap never throws. Operations which may allocate return false when allocation fails, in
+// which case the map is left unchanged. It grows incrementally: when a larger table is allocated,
+// the entries of the previous one are moved over a few at a time by every following
+// InsertOrReplace() or Erase(), so no single operation has to rehash the whole map.
+//
+// Pointers to values are invalidated by any InsertOrReplace(), Erase() or Reserve().
+//
+// FlatHashMap is not thread safe.
+template <typename KeyType, typename ValueType,
+          typename Traits = DefaultFlatHashMapTraits<KeyType>>
+class FlatHashMap {
+ public:
+  // The number of slots of the previous table which get moved over by every InsertOrReplace() or
+  // Erase().
+  static constexpr size_t kMigrationSlotsPerOperation = 8;
+  static constexpr size_t kMinCapacity = 8;
+
+  FlatHashMap() = default;
+  ~FlatHashMap() = default;
+
+  FlatHashMap(FlatHashMap&& other) { *this = std::move(other); }
+  FlatHashMap& operator=(FlatHashMap&& other) {
+    if (this != &other) {
+      current_ = std::move(other.current_);
+      previous_ = std::move(other.previous_);
+      migration_index_ = other.migration_index_;
+      other.migration_index_ = 0;
+    }
+    return *this;
+  }
+
+  DISALLOW_COPY_AND_ASSIGN_ALLOW_MOVE(FlatHashMap);
+
+  size_t size() const { return current_.size() + previous_.size(); }
+  bool is_empty() const { return size() == 0; }
+
+  // Returns the value of |key|, or nullptr if it isn't in the map.
+  ValueType* Find(const KeyType& key) {
+    return const_cast<ValueType*>(static_cast<const FlatHashMap*>(this)->Find(key));
+  }
+  const ValueType* Find(const KeyType& key) const {
+    const uint64_t hash = Traits::GetHash(key);
+    if (size_t index = current_.Find(key, hash); index != Table::kNotFound) {
+      return &current_.entry(index).value;
+    }
+    if (size_t index = previous_.Find(key, hash); index != Table::kNotFound) {
+      return &previous_.entry(index).value;
+    }
+    return nullptr;
+  }
+
+  // Sets the value of |key| to |value|, whether or not it was in the map already. Returns false if
+  // a larger table couldn't be allocated, or if so many keys have the same hash that it can't be
+  // inserted at all.
+  bool InsertOrReplace(KeyType key, ValueType value) {
+    const uint64_t hash = Traits::GetHash(key);
+    if (size_t index = current_.Find(key, hash); index != Table::kNotFound) {
+      current_.entry(index).value = std::move(value);
+      return true;
+    }
+    if (size_t index = previous_.Find(key, hash); index != Table::kNotFound) {
+      previous_.entry(index).value = std::move(value);
+      return true;
+    }
+
+    if (!current_.is_allocated() || NeedsToGrow(size() + 1) || !current_.CanInsert(hash)) {
+      if (!Grow(current_.capacity() * 2) || !current_.CanInsert(hash)) {
+        return false;
+      }
+    }
+
+    current_.Insert({std::move(key), std::move(value)}, hash);
+    Migrate(kMigrationSlotsPerOperation);
+    return true;
+  }
+
+  // Removes |key| from the map. Returns whether it was in the map.
+  bool Erase(const KeyType& key) {
+    const uint64_t hash = Traits::GetHash(key);
+    bool erased = false;
+    if (size_t index = current_.Find(key, hash); index != Table::kNotFound) {
+      current_.Remove(index);
+      erased = true;
+    } else if (size_t index = previous_.Find(key, hash); index != Table::kNotFound) {
+      previous_.Remove(index);
+      erased = true;
+    }
+    Migrate(kMigrationSlotsPerOperation);
+    return erased;
+  }
+
+  // Makes room for |count| entries in total without another allocation.
+  bool Reserve(size_t count) {
+    size_t capacity = current_.is_allocated() ? current_.capacity() : kMinCapacity;
+    while (capacity * kMaxLoadNumerator / kMaxLoadDenominator < count) {
+      capacity *= 2;
+    }
+    if (capacity == current_.capacity()) {
+      return true;
+    }
+    return Grow(capacity);
+  }
+
+  // Removes every entry and frees all memory.
+  void Clear() {
+    current_.Reset();
+    previous_.Reset();
+    migration_index_ = 0;
+  }
+
+  // Calls |func| with a const reference to the key and a reference to the value of every entry, in
+  // no particular order. |func| mustn't modify the map.
+  template <typename Func>
+  void ForEach(Func func) {
+    ForEach(current_, func);
+    ForEach(previous_, func);
+  }
+
+ private:
+  using Table = internal::FlatHashTable<KeyType, ValueType, Traits>;
+
+  // Tables grow once they're 7/8 full, which Robin Hood hashing keeps probes short up to.
+  static constexpr size_t kMaxLoadNumerator = 7;
+  static constexpr size_t kMaxLoadDenominator = 8;
+
+  bool NeedsToGrow(size_t count) const {
+    return count > current_.capacity() * kMaxLoadNumerator / kMaxLoadDenominator;
+  }
+
+  // Replaces the current table with an empty one with |capacity| slots, and starts moving the
+  // entries of the current one over.
+  bool Grow(size_t capacity) {
+    capacity = capacity < kMinCapacity ? kMinCapacity : capacity;
+    Table table;
+    if (!table.Init(capacity)) {
+      return false;
+    }
+
+    // Only one previous table is kept, so any earlier migration is finished first.
+    if (!Migrate(SIZE_MAX)) {
+      return false;
+    }
+    previous_ = std::move(current_);
+    current_ = std::move(table);
+    migration_index_ = 0;
+    return true;
+  }
+
+  // Moves the entries of up to |slots| slots of the previous table to the current one, freeing the
+  // previous table once it's empty. Returns whether it is.
+  bool Migrate(size_t slots) {
+    if (!previous_.is_allocated()) {
+      return true;
+    }
+    const size_t mask = previous_.capacity() - 1;
+    // Removing an entry can shift the one after it back into the slot which was just visited, and
+    // an Erase() elsewhere can shift an entry back past |migration_index_|, so the slot is visited
+    // again after a removal and the scan wraps around until the table is empty. The current table
+    // is at least twice as large as the previous one so there's room for every entry, but an entry
+    // is left behind if so many keys share its hash that it can't be inserted. The scan gives up
+    // after visiting every slot without moving anything.
+    for (size_t unmoved = 0; slots > 0 && previous_.size() > 0 && unmoved <= mask; --slots) {
+      if (!previous_.is_occupied(migration_index_) ||
+          !current_.CanInsert(Traits::GetHash(previous_.entry(migration_index_).key))) {
+        migration_index_ = (migration_index_ + 1) & mask;
+        ++unmoved;
+        continue;
+      }
+      const uint64_t hash = Traits::GetHash(previous_.entry(migration_index_).key);
+      current_.Insert(previous_.Remove(migration_index_), hash);
+      unmoved = 0;
+    }
+    if (previous_.size() > 0) {
+      return false;
+    }
+    previous_.Reset();
+    migration_index_ = 0;
+    return true;
+  }
+
+  template <typename Func>
+  static void ForEach(Table& table, Func& func) {
+    for (size_t i = 0; i < table.capacity(); ++i) {
+      if (table.is_occupied(i)) {
+        func(std::as_const(table.entry(i).key), table.entry(i).value);
+      }
+    }
+  }
+
+  Table current_;
+  // The table entries are being moved out of after the current one was allocated.
+  Table previous_;
+  size_t migration_index_ = 0;
+};
+
+}  // namespace fbl
+
+#endif  // FBL_FLAT_HASH_MAP_H_
@@ -0,0 +1,187 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+
+#include <fbl/flat_hash_map.h>
+#include <zxtest/zxtest.h>
+
+namespace {
+
+using Map = fbl::FlatHashMap<uint64_t, uint64_t>;
+
+TEST(FlatHashMapTest, Empty) {
+  Map map;
+  EXPECT_TRUE(map.is_empty());
+  EXPECT_EQ(map.size(), 0);
+  EXPECT_NULL(map.Find(1));
+  EXPECT_FALSE(map.Erase(1));
+}
+
+TEST(FlatHashMapTest, InsertFindErase) {
+  Map map;
+  ASSERT_TRUE(map.InsertOrReplace(1, 10));
+  ASSERT_TRUE(map.InsertOrReplace(2, 20));
+  EXPECT_EQ(map.size(), 2);
+
+  ASSERT_NOT_NULL(map.Find(1));
+  EXPECT_EQ(*map.Find(1), 10);
+  ASSERT_NOT_NULL(map.Find(2));
+  EXPECT_EQ(*map.Find(2), 20);
+  EXPECT_NULL(map.Find(3));
+
+  // Replacing a value doesn't add an entry.
+  ASSERT_TRUE(map.InsertOrReplace(1, 11));
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(*map.Find(1), 11);
+
+  EXPECT_TRUE(map.Erase(1));
+  EXPECT_FALSE(map.Erase(1));
+  EXPECT_NULL(map.Find(1));
+  EXPECT_EQ(*map.Find(2), 20);
+  EXPECT_EQ(map.size(), 1);
+}
+
+// Enough entries to grow the map many times, so that lookups and erasures happen while entries are
+// being moved from one table to the next.
+TEST(FlatHashMapTest, GrowsIncrementally) {
+  constexpr uint64_t kCount = 10000;
+  Map map;
+  for (uint64_t i = 0; i < kCount; ++i) {
+    ASSERT_TRUE(map.InsertOrReplace(i, i * 2));
+    ASSERT_EQ(map.size(), i + 1);
+    // Every entry inserted so far is still found, wherever it currently is.
+    if (i % 97 == 0) {
+      for (uint64_t j = 0; j <= i; ++j) {
+        ASSERT_NOT_NULL(map.Find(j));
+        ASSERT_EQ(*map.Find(j), j * 2);
+      }
+    }
+  }
+
+  // Erase every other entry.
+  for (uint64_t i = 0; i < kCount; i += 2) {
+    ASSERT_TRUE(map.Erase(i));
+  }
+  EXPECT_EQ(map.size(), kCount / 2);
+  for (uint64_t i = 0; i < kCount; ++i) {
+    if (i % 2 == 0) {
+      EXPECT_NULL(map.Find(i));
+    } else {
+      ASSERT_NOT_NULL(map.Find(i));
+      EXPECT_EQ(*map.Find(i), i * 2);
+    }
+  }
+}
+
+TEST(FlatHashMapTest, EraseWhileGrowing) {
+  Map map;
+  // Insert just enough to trigger a growth, then erase everything before the migration is done.
+  uint64_t count = 0;
+  for (; count < Map::kMinCapacity; ++count) {
+    ASSERT_TRUE(map.InsertOrReplace(count, count));
+  }
+  for (uint64_t i = 0; i < count; ++i) {
+    ASSERT_TRUE(map.Erase(i));
+    for (uint64_t j = i + 1; j < count; ++j) {
+      ASSERT_NOT_NULL(map.Find(j));
+    }
+  }
+  EXPECT_TRUE(map.is_empty());
+}
+
+TEST(FlatHashMapTest, Reserve) {
+  Map map;
+  ASSERT_TRUE(map.Reserve(1000));
+  for (uint64_t i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(map.InsertOrReplace(i, i));
+  }
+  EXPECT_EQ(map.size(), 1000);
+  ASSERT_TRUE(map.Reserve(10));
+  EXPECT_EQ(map.size(), 1000);
+}
+
+TEST(FlatHashMapTest, ForEach) {
+  constexpr uint64_t kCount = 100;
+  Map map;
+  for (uint64_t i = 0; i < kCount; ++i) {
+    ASSERT_TRUE(map.InsertOrReplace(i, i));
+  }
+
+  uint64_t sum = 0;
+  size_t entries = 0;
+  map.ForEach([&](const uint64_t& key, uint64_t& value) {
+    EXPECT_EQ(key, value);
+    sum += key;
+    ++entries;
+    value = 0;
+  });
+  EXPECT_EQ(entries, kCount);
+  EXPECT_EQ(sum, kCount * (kCount - 1) / 2);
+  for (uint64_t i = 0; i < kCount; ++i) {
+    EXPECT_EQ(*map.Find(i), 0);
+  }
+}
+
+TEST(FlatHashMapTest, ClearAndMove) {
+  Map map;
+  for (uint64_t i = 0; i < 100; ++i) {
+    ASSERT_TRUE(map.InsertOrReplace(i, i));
+  }
+
+  Map moved(std::move(map));
+  EXPECT_TRUE(map.is_empty());
+  EXPECT_EQ(moved.size(), 100);
+  EXPECT_EQ(*moved.Find(42), 42);
+
+  moved.Clear();
+  EXPECT_TRUE(moved.is_empty());
+  EXPECT_NULL(moved.Find(42));
+  ASSERT_TRUE(moved.InsertOrReplace(42, 1));
+  EXPECT_EQ(*moved.Find(42), 1);
+}
+
+// Values which aren't trivially destructible are destroyed exactly once.
+TEST(FlatHashMapTest, MoveOnlyValues) {
+  fbl::FlatHashMap<uint32_t, std::unique_ptr<uint32_t>> map;
+  for (uint32_t i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(map.InsertOrReplace(i, std::make_unique<uint32_t>(i)));
+  }
+  for (uint32_t i = 0; i < 1000; i += 3) {
+    ASSERT_TRUE(map.Erase(i));
+  }
+  for (uint32_t i = 0; i < 1000; ++i) {
+    auto* value = map.Find(i);
+    if (i % 3 == 0) {
+      EXPECT_NULL(value);
+    } else {
+      ASSERT_NOT_NULL(value);
+      EXPECT_EQ(**value, i);
+    }
+  }
+}
+
+struct CollidingTraits {
+  static uint64_t GetHash(const uint32_t&) { return 0; }
+  static bool EqualTo(const uint32_t& a, const uint32_t& b) { return a == b; }
+};
+
+// Keys which all have the same hash still work, up to the maximum probe distance.
+TEST(FlatHashMapTest, CollidingHashes) {
+  fbl::FlatHashMap<uint32_t, uint32_t, CollidingTraits> map;
+  uint32_t count = 0;
+  while (map.InsertOrReplace(count, count)) {
+    ++count;
+    ASSERT_LT(count, 1000);
+  }
+  EXPECT_GT(count, 100);
+  EXPECT_EQ(map.size(), count);
+  for (uint32_t i = 0; i < count; ++i) {
+    ASSERT_NOT_NULL(map.Find(i));
+    EXPECT_EQ(*map.Find(i), i);
+  }
+  EXPECT_NULL(map.Find(count));
+}
+
+}  // namespace
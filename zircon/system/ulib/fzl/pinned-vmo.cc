@@ -5,6 +5,7 @@
 #include <lib/fit/defer.h>
 #include <lib/fzl/pinned-vmo.h>
 
+#include <algorithm>
 #include <climits>
 #include <limits>
 #include <memory>
@@ -65,6 +66,23 @@ zx_status_t PinnedVmo::PinInternal(uint64_t offset, uint64_t len, const zx::vmo&
     page_count = 1;
   }
 
+  // If the BTI maps memory in chunks larger than a page, ask for one address per chunk rather than
+  // per page. Large pins then return, and have to merge, far fewer addresses. Every chunk but the
+  // last is |chunk_size| bytes long.
+  size_t chunk_size = kPageSize;
+  if (!(options & ZX_BTI_CONTIGUOUS)) {
+    zx_info_bti_t info;
+    if (bti.get_info(ZX_INFO_BTI, &info, sizeof(info), nullptr, nullptr) == ZX_OK &&
+        info.minimum_contiguity > kPageSize) {
+      chunk_size = info.minimum_contiguity;
+      page_count = static_cast<uint32_t>((len + chunk_size - 1) / chunk_size);
+      options |= ZX_BTI_COMPRESS;
+    }
+  }
+  auto chunk_len = [chunk_size, len](uint32_t i) {
+    return std::min<uint64_t>(chunk_size, len - static_cast<uint64_t>(i) * chunk_size);
+  };
+
   std::unique_ptr<zx_paddr_t[]> addrs(new (&ac) zx_paddr_t[page_count]);
   if (!ac.check()) {
     return ZX_ERR_NO_MEMORY;
@@ -101,7 +119,7 @@ zx_status_t PinnedVmo::PinInternal(uint64_t offset, uint64_t len, const zx::vmo&
   zx_paddr_t last = addrs[0];
   region_count_ = 1;
   for (uint32_t i = 1; i < page_count; ++i) {
-    if (addrs[i] != (last + kPageSize)) {
+    if (addrs[i] != (last + chunk_size)) {
       ++region_count_;
     }
     last = addrs[i];
@@ -116,19 +134,19 @@ zx_status_t PinnedVmo::PinInternal(uint64_t offset, uint64_t len, const zx::vmo&
   // Finally, go ahead and merge any adjacent pages to compute our set of
   // regions and we should be good to go;
   regions_[0].phys_addr = addrs[0];
-  regions_[0].size = kPageSize;
+  regions_[0].size = chunk_len(0);
   for (uint32_t i = 1, j = 0; i < page_count; ++i) {
     ZX_DEBUG_ASSERT(j < region_count_);
 
     if ((regions_[j].phys_addr + regions_[j].size) == addrs[i]) {
       // Merge!
-      regions_[j].size += kPageSize;
+      regions_[j].size += chunk_len(i);
     } else {
       // New Region!
       ++j;
       ZX_DEBUG_ASSERT(j < region_count_);
       regions_[j].phys_addr = addrs[i];
-      regions_[j].size = kPageSize;
+      regions_[j].size = chunk_len(i);
     }
   }
 
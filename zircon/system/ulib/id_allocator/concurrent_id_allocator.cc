@@ -0,0 +1,153 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <zircon/assert.h>
+#include <zircon/errors.h>
+
+#include <fbl/algorithm.h>
+#include <fbl/alloc_checker.h>
+#include <fbl/auto_lock.h>
+#include <id_allocator/concurrent_id_allocator.h>
+
+namespace id_allocator {
+
+namespace {
+constexpr size_t kBitsPerWord = 64;
+constexpr size_t kNoId = SIZE_MAX;
+}  // namespace
+
+zx_status_t ConcurrentIdAllocator::Create(size_t id_count,
+                                          std::unique_ptr<ConcurrentIdAllocator>* ida_out) {
+  std::unique_ptr<IdAllocator> allocator;
+  zx_status_t status = IdAllocator::Create(id_count, &allocator);
+  if (status != ZX_OK) {
+    return status;
+  }
+
+  fbl::AllocChecker ac;
+  std::unique_ptr<ConcurrentIdAllocator> ida(new (&ac) ConcurrentIdAllocator(id_count));
+  if (!ac.check()) {
+    return ZX_ERR_NO_MEMORY;
+  }
+
+  const size_t words = fbl::round_up(id_count, kBitsPerWord) / kBitsPerWord;
+  ida->busy_.reset(new (&ac) std::atomic<uint64_t>[words]);
+  if (!ac.check()) {
+    return ZX_ERR_NO_MEMORY;
+  }
+  for (size_t i = 0; i < words; i++) {
+    ida->busy_[i].store(0, std::memory_order_relaxed);
+  }
+
+  {
+    fbl::AutoLock lock(&ida->lock_);
+    ida->allocator_ = std::move(allocator);
+  }
+  *ida_out = std::move(ida);
+  return ZX_OK;
+}
+
+ConcurrentIdAllocator::Cache& ConcurrentIdAllocator::CurrentCache() {
+  // Threads are given a cache index once, for all allocators.
+  static std::atomic<size_t> next_index{0};
+  thread_local const size_t index = next_index.fetch_add(1, std::memory_order_relaxed);
+  return caches_[index % kCacheCount];
+}
+
+bool ConcurrentIdAllocator::MarkBusy(size_t id) {
+  const uint64_t bit = uint64_t{1} << (id % kBitsPerWord);
+  return (busy_[id / kBitsPerWord].fetch_or(bit, std::memory_order_relaxed) & bit) == 0;
+}
+
+bool ConcurrentIdAllocator::IsBusy(size_t id) const {
+  if (id >= id_count_) {
+    return false;
+  }
+  const uint64_t bit = uint64_t{1} << (id % kBitsPerWord);
+  return (busy_[id / kBitsPerWord].load(std::memory_order_relaxed) & bit) != 0;
+}
+
+void ConcurrentIdAllocator::RefillLocked(Cache& cache) {
+  ZX_DEBUG_ASSERT(cache.count == 0);
+  size_t ids[kBatchSize];
+  size_t count = 0;
+  {
+    fbl::AutoLock lock(&lock_);
+    while (count < kBatchSize && allocator_->Allocate(&ids[count]) == ZX_OK) {
+      count++;
+    }
+  }
+
+  // IdAllocator hands out ascending ids. Store them the other way around so
+  // that the lowest is popped first.
+  while (count > 0) {
+    cache.ids[cache.count++] = ids[--count];
+  }
+}
+
+void ConcurrentIdAllocator::ReturnLocked(Cache& cache, size_t count) {
+  ZX_DEBUG_ASSERT(count <= cache.count);
+  fbl::AutoLock lock(&lock_);
+  for (; count > 0; count--) {
+    ZX_ASSERT(allocator_->Free(cache.ids[--cache.count]) == ZX_OK);
+  }
+}
+
+zx_status_t ConcurrentIdAllocator::Allocate(size_t* out_id) {
+  size_t id = kNoId;
+  {
+    Cache& cache = CurrentCache();
+    fbl::AutoLock lock(&cache.lock);
+    if (cache.count == 0) {
+      RefillLocked(cache);
+    }
+    if (cache.count > 0) {
+      id = cache.ids[--cache.count];
+    }
+  }
+
+  // The shared allocator is exhausted, but other caches may still hold free
+  // ids. Take one, one cache at a time so that no two cache locks are ever held
+  // at once.
+  for (size_t i = 0; id == kNoId && i < kCacheCount; i++) {
+    fbl::AutoLock lock(&caches_[i].lock);
+    if (caches_[i].count > 0) {
+      id = caches_[i].ids[--caches_[i].count];
+    }
+  }
+
+  if (id == kNoId) {
+    return ZX_ERR_NO_RESOURCES;
+  }
+  ZX_ASSERT(MarkBusy(id));
+  *out_id = id;
+  return ZX_OK;
+}
+
+zx_status_t ConcurrentIdAllocator::Free(size_t id) {
+  if (id >= id_count_) {
+    return ZX_ERR_OUT_OF_RANGE;
+  }
+  const uint64_t bit = uint64_t{1} << (id % kBitsPerWord);
+  if ((busy_[id / kBitsPerWord].fetch_and(~bit, std::memory_order_relaxed) & bit) == 0) {
+    return ZX_ERR_BAD_STATE;
+  }
+
+  Cache& cache = CurrentCache();
+  fbl::AutoLock lock(&cache.lock);
+  if (cache.count == kMaxCachedIds) {
+    ReturnLocked(cache, kBatchSize);
+  }
+  cache.ids[cache.count++] = id;
+  return ZX_OK;
+}
+
+void ConcurrentIdAllocator::Flush() {
+  for (auto& cache : caches_) {
+    fbl::AutoLock lock(&cache.lock);
+    ReturnLocked(cache, cache.count);
+  }
+}
+
+}  // namespace id_allocator
@@ -0,0 +1,109 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zircon/compiler.h>
+#include <zircon/types.h>
+
+#include <atomic>
+#include <memory>
+
+#include <fbl/macros.h>
+#include <fbl/mutex.h>
+#include <id_allocator/id_allocator.h>
+
+namespace id_allocator {
+
+// ConcurrentIdAllocator hands out ids from a fixed range to many threads at
+// once, for hot paths such as per I/O transaction ids.
+//
+// The ids are managed by an IdAllocator behind a single lock, in front of which
+// sit a small number of caches of free ids. Threads are spread over the caches,
+// and only move ids between their cache and the IdAllocator kBatchSize at a time,
+// so the shared lock is taken once every kBatchSize allocations or frees at most.
+//
+// IdAllocator always hands out the lowest free id. The caches weaken that
+// guarantee only by the ids they hold: every allocated id is below the number of
+// allocated ids plus kCacheCount * kMaxCachedIds, no matter how long the
+// allocator has been running. Allocation only fails when no id is free, neither
+// in the shared allocator nor in any cache.
+//
+// This class is thread-safe.
+class ConcurrentIdAllocator {
+ public:
+  // The number of ids moved between a cache and the shared allocator at once.
+  static constexpr size_t kBatchSize = 16;
+  // The number of ids a cache holds before returning a batch.
+  static constexpr size_t kMaxCachedIds = 2 * kBatchSize;
+  // The number of caches. Threads get one each, round robin.
+  static constexpr size_t kCacheCount = 16;
+
+  DISALLOW_COPY_ASSIGN_AND_MOVE(ConcurrentIdAllocator);
+
+  // Creates a new allocator to manage allocation and free of id_count number
+  // of ids. Unlike IdAllocator, the number of ids can't change afterwards.
+  static zx_status_t Create(size_t id_count, std::unique_ptr<ConcurrentIdAllocator>* ida_out);
+
+  // Find and allocate an id that is not busy. Returns ZX_OK on success and
+  // allocated id in *out_id*, or ZX_ERR_NO_RESOURCES if every id is busy.
+  zx_status_t Allocate(size_t* out_id);
+
+  // Frees an allocated id. Returns ZX_ERR_OUT_OF_RANGE or ZX_ERR_BAD_STATE if
+  // the id is out of range or not allocated.
+  zx_status_t Free(size_t id);
+
+  // Returns true if the given id is allocated. Ids sitting in a cache are free.
+  bool IsBusy(size_t id) const;
+
+  // Returns the number of ids being managed.
+  size_t Size() const { return id_count_; }
+
+  // Returns every cached id to the shared allocator, e.g. so that the lowest
+  // free ids are handed out first again after a burst of allocations.
+  void Flush();
+
+ private:
+  // Keep the caches on separate cache lines so that threads using different
+  // ones don't contend.
+  struct alignas(64) Cache {
+    fbl::Mutex lock;
+    // Sorted from highest to lowest after a refill, so that the lowest ids are
+    // handed out first.
+    size_t ids[kMaxCachedIds] __TA_GUARDED(lock);
+    size_t count __TA_GUARDED(lock) = 0;
+  };
+
+  explicit ConcurrentIdAllocator(size_t id_count) : id_count_(id_count) {}
+
+  // Returns the cache of the calling thread.
+  Cache& CurrentCache();
+
+  // Moves up to kBatchSize ids from the shared allocator to |cache|.
+  void RefillLocked(Cache& cache) __TA_REQUIRES(cache.lock) __TA_EXCLUDES(lock_);
+
+  // Returns the |count| most recently cached ids of |cache| to the shared
+  // allocator.
+  void ReturnLocked(Cache& cache, size_t count) __TA_REQUIRES(cache.lock) __TA_EXCLUDES(lock_);
+
+  // Marks |id| allocated in |busy_|, returning whether it was free.
+  bool MarkBusy(size_t id);
+
+  const size_t id_count_;
+
+  // The shared allocator holds every id which is either allocated or cached.
+  // Cache locks may be held while acquiring it, never the other way around.
+  fbl::Mutex lock_;
+  std::unique_ptr<IdAllocator> allocator_ __TA_GUARDED(lock_);
+
+  // One bit per id, set when the id is allocated, to catch double frees
+  // without going through the shared allocator.
+  std::unique_ptr<std::atomic<uint64_t>[]> busy_;
+
+  Cache caches_[kCacheCount];
+};
+
+}  // namespace id_allocator
@@ -0,0 +1,127 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <id_allocator/concurrent_id_allocator.h>
+#include <zxtest/zxtest.h>
+
+namespace id_allocator {
+namespace {
+
+TEST(ConcurrentIdAllocatorTests, AllocatesLowestIdsFirst) {
+  std::unique_ptr<ConcurrentIdAllocator> ida;
+  ASSERT_OK(ConcurrentIdAllocator::Create(1000, &ida));
+  EXPECT_EQ(ida->Size(), 1000);
+
+  for (size_t expected = 0; expected < 100; expected++) {
+    size_t id;
+    ASSERT_OK(ida->Allocate(&id));
+    EXPECT_EQ(id, expected);
+    EXPECT_TRUE(ida->IsBusy(id));
+  }
+  EXPECT_FALSE(ida->IsBusy(100));
+
+  // Freed ids are reused before any other.
+  ASSERT_OK(ida->Free(42));
+  EXPECT_FALSE(ida->IsBusy(42));
+  size_t id;
+  ASSERT_OK(ida->Allocate(&id));
+  EXPECT_EQ(id, 42);
+}
+
+TEST(ConcurrentIdAllocatorTests, FreeErrors) {
+  std::unique_ptr<ConcurrentIdAllocator> ida;
+  ASSERT_OK(ConcurrentIdAllocator::Create(10, &ida));
+
+  size_t id;
+  ASSERT_OK(ida->Allocate(&id));
+  EXPECT_OK(ida->Free(id));
+  EXPECT_EQ(ida->Free(id), ZX_ERR_BAD_STATE);
+  EXPECT_EQ(ida->Free(5), ZX_ERR_BAD_STATE);
+  EXPECT_EQ(ida->Free(10), ZX_ERR_OUT_OF_RANGE);
+}
+
+// Ids left in the cache of another thread can still be allocated once the shared allocator is
+// exhausted.
+TEST(ConcurrentIdAllocatorTests, AllocatesIdsCachedByOtherThreads) {
+  constexpr size_t kIdCount = 64;
+  std::unique_ptr<ConcurrentIdAllocator> ida;
+  ASSERT_OK(ConcurrentIdAllocator::Create(kIdCount, &ida));
+
+  std::thread([&ida] {
+    size_t ids[10];
+    for (auto& id : ids) {
+      ASSERT_OK(ida->Allocate(&id));
+    }
+    for (auto id : ids) {
+      ASSERT_OK(ida->Free(id));
+    }
+  }).join();
+
+  std::vector<bool> allocated(kIdCount, false);
+  for (size_t i = 0; i < kIdCount; i++) {
+    size_t id;
+    ASSERT_OK(ida->Allocate(&id));
+    ASSERT_LT(id, kIdCount);
+    EXPECT_FALSE(allocated[id]);
+    allocated[id] = true;
+  }
+  size_t id;
+  EXPECT_EQ(ida->Allocate(&id), ZX_ERR_NO_RESOURCES);
+}
+
+TEST(ConcurrentIdAllocatorTests, ConcurrentAllocateAndFree) {
+  constexpr size_t kIdCount = 1024;
+  constexpr size_t kThreadCount = 8;
+  constexpr size_t kIdsPerThread = 24;
+  constexpr size_t kIterations = 5000;
+  std::unique_ptr<ConcurrentIdAllocator> ida;
+  ASSERT_OK(ConcurrentIdAllocator::Create(kIdCount, &ida));
+
+  // Every id must be held by at most one thread at a time.
+  std::atomic<bool> held[kIdCount] = {};
+  std::atomic<size_t> max_id{0};
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < kThreadCount; t++) {
+    threads.emplace_back([&] {
+      size_t ids[kIdsPerThread];
+      for (size_t i = 0; i < kIterations; i++) {
+        const size_t count = (i % kIdsPerThread) + 1;
+        for (size_t j = 0; j < count; j++) {
+          ASSERT_OK(ida->Allocate(&ids[j]));
+          ASSERT_FALSE(held[ids[j]].exchange(true));
+          size_t max = max_id.load();
+          while (ids[j] > max && !max_id.compare_exchange_weak(max, ids[j])) {
+          }
+        }
+        for (size_t j = 0; j < count; j++) {
+          held[ids[j]].store(false);
+          ASSERT_OK(ida->Free(ids[j]));
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // Ids stay dense: no more than the cached ids beyond what was live at once.
+  EXPECT_LT(max_id.load(), kThreadCount * kIdsPerThread +
+                               ConcurrentIdAllocator::kCacheCount *
+                                   ConcurrentIdAllocator::kMaxCachedIds);
+
+  // Once the caches are flushed, the lowest ids come first again, and every id can be allocated.
+  ida->Flush();
+  for (size_t expected = 0; expected < kIdCount; expected++) {
+    size_t id;
+    ASSERT_OK(ida->Allocate(&id));
+    EXPECT_EQ(id, expected);
+  }
+}
+
+}  // namespace
+}  // namespace id_allocator
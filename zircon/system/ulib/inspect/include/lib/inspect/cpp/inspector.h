@@ -51,6 +51,13 @@ struct InspectStats final {
 
   // The number of failed allocations over the lifetime of the inspector.
   size_t failed_allocations;
+
+  // The number of bytes in blocks that are currently allocated.
+  size_t allocated_bytes;
+
+  // The size of the largest block that can be allocated without growing the VMO. When this is
+  // small while |size| is well above |allocated_bytes|, the free space is fragmented.
+  size_t largest_free_block;
 };
 
 // The entry point into the Inspection API.
@@ -309,6 +309,25 @@ inline cpp17::optional<size_t> GetHeaderVmoSize(const Block* block) {
   return {size};
 }
 
+// The number of live |IntCounter| and |UintCounter| values in the buffer is kept after the VMO
+// size. Their updates don't change the generation count, so a reader can tell from the generation
+// count alone that nothing has changed only while this is zero.
+inline void SetHeaderCounterCount(Block* block, uint64_t count) {
+  if (GetType(block) != BlockType::kHeader || GetOrder(block) != kVmoHeaderOrder) {
+    return;
+  }
+  memcpy(block->payload_ptr() + sizeof(block->payload) + sizeof(size_t), &count, sizeof(count));
+}
+
+inline uint64_t GetHeaderCounterCount(const Block* block) {
+  if (GetType(block) != BlockType::kHeader || GetOrder(block) != kVmoHeaderOrder) {
+    return 0;
+  }
+  uint64_t count = 0;
+  memcpy(&count, block->payload_ptr() + sizeof(block->payload) + sizeof(size_t), sizeof(count));
+  return count;
+}
+
 }  // namespace internal
 }  // namespace inspect
 
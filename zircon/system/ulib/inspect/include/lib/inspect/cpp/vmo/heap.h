@@ -11,6 +11,8 @@
 #include <lib/zx/vmo.h>
 #include <zircon/assert.h>
 
+#include <set>
+
 namespace inspect {
 namespace internal {
 
@@ -25,6 +27,11 @@ namespace internal {
 // heap using the least amount of physical memory to
 // satisfy requests.
 //
+// Allocations always reuse the lowest suitable free block. This keeps live
+// blocks packed towards the start of the VMO, leaving the blocks above them
+// free to merge back together, so that creating and deleting values doesn't
+// fragment the heap until it runs out of space.
+//
 // This class is not thread safe.
 class Heap final {
  public:
@@ -73,6 +80,12 @@ class Heap final {
   // Return the maximum size of the VMO.
   size_t maximum_size() const { return max_size_; }
 
+  // Return the number of bytes in blocks that are currently allocated.
+  size_t allocated_bytes() const { return allocated_bytes_; }
+
+  // Return the size of the largest block that can be allocated without extending the VMO.
+  size_t LargestFreeBlockSize() const;
+
   // Set header block.
   void SetHeaderBlock(Block* const hb) { header_block = {hb}; }
 
@@ -80,9 +93,6 @@ class Heap final {
   cpp17::optional<Block*> GetHeaderBlock() const { return header_block; }
 
  private:
-  // Returns true if the given block is free and of the expected order.
-  inline bool IsFreeBlock(BlockIndex block, size_t expected_order) const;
-
   bool SplitBlock(BlockIndex block);
   bool RemoveFree(BlockIndex block);
   zx_status_t Extend(size_t new_size);
@@ -92,22 +102,16 @@ class Heap final {
   size_t total_allocated_blocks_ = 0;
   size_t total_deallocated_blocks_ = 0;
   size_t total_failed_allocations_ = 0;
+  size_t allocated_bytes_ = 0;
   size_t max_size_ = 0;
   uintptr_t buffer_addr_ = 0;
-  BlockIndex free_blocks_[8] = {};
+
+  // The free blocks of each order, ordered by index.
+  std::set<BlockIndex> free_blocks_[kNumOrders];
 
   cpp17::optional<Block*> header_block = {};
 };
 
-bool Heap::IsFreeBlock(BlockIndex block, size_t expected_order) const {
-  ZX_DEBUG_ASSERT_MSG(block < IndexForOffset(cur_size_), "Block out of bounds");
-  if (block >= cur_size_ / kMinOrderSize) {
-    return false;
-  }
-  auto* b = GetBlock(block);
-  return GetType(b) == BlockType::kFree && GetOrder(b) == expected_order;
-}
-
 }  // namespace internal
 }  // namespace inspect
 
@@ -93,6 +93,14 @@ class Snapshot final {
   // snapshot, an error status is returned. There are no observers or writers involved.
   static zx_status_t Create(BackingBuffer&& buffer, Snapshot* out_snapshot);
 
+  // Create a new snapshot of the given VMO using default options, or share the data of
+  // |previous| if the VMO hasn't changed since |previous| was taken of it. Only the header block
+  // is read in that case, which makes polling a VMO that rarely changes cheap.
+  //
+  // Changes are detected through the generation count. |IntCounter| and |UintCounter| don't
+  // increment it, so a VMO that has any of those is always read in full.
+  static zx_status_t Create(const zx::vmo& vmo, const Snapshot& previous, Snapshot* out_snapshot);
+
   Snapshot() = default;
   ~Snapshot() = default;
   Snapshot(Snapshot&&) = default;
@@ -108,6 +116,9 @@ class Snapshot final {
   // Returns the size of the snapshot.
   size_t size() const { return buffer_ ? buffer_->Size() : 0; }
 
+  // Returns the generation count the VMO had when the snapshot was taken.
+  uint64_t generation() const { return generation_; }
+
  private:
   // Read from the VMO into a buffer.
   static zx_status_t Read(const zx::vmo& vmo, size_t size, uint8_t* buffer);
@@ -126,6 +137,9 @@ class Snapshot final {
 
   // The buffer storing the snapshot.
   std::shared_ptr<BackingBuffer> buffer_;
+
+  // The generation count read from the header of the buffer.
+  uint64_t generation_ = 0;
 };
 
 namespace internal {
@@ -87,6 +87,14 @@ class State final {
   // the property when destroyed.
   UintProperty CreateUintProperty(BorrowedStringValue name, BlockIndex parent, uint64_t value);
 
+  // Create a new |IntCounter| in the Inspect VMO. The returned value releases
+  // the counter when destroyed.
+  IntCounter CreateIntCounter(BorrowedStringValue name, BlockIndex parent, int64_t value);
+
+  // Create a new |UintCounter| in the Inspect VMO. The returned value releases
+  // the counter when destroyed.
+  UintCounter CreateUintCounter(BorrowedStringValue name, BlockIndex parent, uint64_t value);
+
   // Create a new |DoubleProperty| in the Inspect VMO. The returned value releases
   // the property when destroyed.
   DoubleProperty CreateDoubleProperty(BorrowedStringValue name, BlockIndex parent, double value);
@@ -185,6 +193,8 @@ class State final {
   // Free various entities
   void FreeIntProperty(IntProperty* property);
   void FreeUintProperty(UintProperty* property);
+  void FreeIntCounter(IntCounter* counter);
+  void FreeUintCounter(UintCounter* counter);
   void FreeDoubleProperty(DoubleProperty* property);
   void FreeBoolProperty(BoolProperty* property);
   void FreeIntArray(IntArray* array);
@@ -334,6 +344,13 @@ class State final {
   template <typename WrapperType>
   void InnerFreeArray(WrapperType* value);
 
+  // Helper function to free a counter type.
+  template <typename WrapperType>
+  void InnerFreeCounter(WrapperType* counter);
+
+  // Adds |delta| to the count of live counters recorded in the header block.
+  void AdjustHeaderCounterCount(int64_t delta) __TA_REQUIRES(mutex_);
+
   // Helper function to generate a unique name for a link.
   std::string UniqueLinkName(cpp17::string_view prefix);
 
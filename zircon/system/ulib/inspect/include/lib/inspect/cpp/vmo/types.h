@@ -23,6 +23,7 @@
 #include <mutex>
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace inspect {
@@ -347,6 +348,68 @@ class Property final {
   internal::BlockIndex value_index_;
 };
 
+// A numeric property which may only be added to or subtracted from, and does so without taking
+// the lock that serializes all other changes to the buffer. Use it instead of |NumericProperty|
+// for counters which are updated on hot paths, from many threads at once. Concrete
+// implementations are available only for int64_t and uint64_t.
+//
+// Readers see an ordinary int or uint property. Each update is a single atomic read-modify-write
+// of the value's word in the buffer, which the generation count doesn't need to cover: a reader
+// can't see the word half written, so any snapshot holds a value the counter really had.
+template <typename T>
+class NumericCounter final {
+ public:
+  // Construct a default counter. Operations on this counter are no-ops.
+  NumericCounter() = default;
+  ~NumericCounter();
+
+  // Allow moving, disallow copying.
+  NumericCounter(const NumericCounter& other) = delete;
+  NumericCounter(NumericCounter&& other) noexcept
+      : state_(std::move(other.state_)),
+        name_index_(other.name_index_),
+        value_index_(other.value_index_),
+        value_(std::exchange(other.value_, nullptr)) {}
+  NumericCounter& operator=(const NumericCounter& other) = delete;
+  NumericCounter& operator=(NumericCounter&& other) noexcept;
+
+  // Add the given value to the value of this counter.
+  void Add(T value) {
+    if (value_) {
+      __atomic_fetch_add(value_, value, __ATOMIC_RELAXED);
+    }
+  }
+
+  // Subtract the given value from the value of this counter.
+  void Subtract(T value) {
+    if (value_) {
+      __atomic_fetch_sub(value_, value, __ATOMIC_RELAXED);
+    }
+  }
+
+  // Return true if this counter is stored in a buffer. False otherwise.
+  explicit operator bool() const { return state_ != nullptr; }
+
+ private:
+  friend class ::inspect::internal::State;
+  NumericCounter(std::shared_ptr<internal::State> state, internal::BlockIndex name,
+                 internal::BlockIndex value, T* value_ptr)
+      : state_(std::move(state)), name_index_(name), value_index_(value), value_(value_ptr) {}
+
+  // Reference to the state containing this counter.
+  std::shared_ptr<internal::State> state_;
+
+  // Index of the name block in the state.
+  internal::BlockIndex name_index_;
+
+  // Index of the value block in the state.
+  internal::BlockIndex value_index_;
+
+  // The value in the buffer. The buffer stays mapped at the same address for as long as |state_|
+  // is alive, and the block isn't freed until this counter is.
+  T* value_ = nullptr;
+};
+
 }  // namespace internal
 
 using IntProperty = internal::NumericProperty<int64_t>;
@@ -354,6 +417,9 @@ using UintProperty = internal::NumericProperty<uint64_t>;
 using DoubleProperty = internal::NumericProperty<double>;
 using BoolProperty = internal::Property<bool>;
 
+using IntCounter = internal::NumericCounter<int64_t>;
+using UintCounter = internal::NumericCounter<uint64_t>;
+
 using IntArray = internal::ArrayValue<int64_t>;
 using UintArray = internal::ArrayValue<uint64_t>;
 using DoubleArray = internal::ArrayValue<double>;
@@ -603,6 +669,16 @@ class Node final {
     list->emplace(CreateUint(name, value));
   }
 
+  // Create a new |IntCounter| with the given name that is a child of this node.
+  // If this node is not stored in a buffer, the created counter will
+  // also not be stored in a buffer.
+  IntCounter CreateIntCounter(BorrowedStringValue name, int64_t value) __WARN_UNUSED_RESULT;
+
+  // Create a new |UintCounter| with the given name that is a child of this node.
+  // If this node is not stored in a buffer, the created counter will
+  // also not be stored in a buffer.
+  UintCounter CreateUintCounter(BorrowedStringValue name, uint64_t value) __WARN_UNUSED_RESULT;
+
   // Create a new |DoubleProperty| with the given name that is a child of this node.
   // If this node is not stored in a buffer, the created metric will
   // also not be stored in a buffer.
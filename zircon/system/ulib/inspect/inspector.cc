@@ -130,6 +130,8 @@ const char* TOTAL_DYNAMIC_CHILDREN_KEY = "total_dynamic_children";
 const char* ALLOCATED_BLOCKS_KEY = "allocated_blocks";
 const char* DEALLOCATED_BLOCKS_KEY = "deallocated_blocks";
 const char* FAILED_ALLOCATIONS_KEY = "failed_allocations";
+const char* ALLOCATED_BYTES_KEY = "allocated_bytes";
+const char* LARGEST_FREE_BLOCK_KEY = "largest_free_block";
 }  // namespace
 
 void Inspector::CreateStatsNode() {
@@ -144,6 +146,8 @@ void Inspector::CreateStatsNode() {
         insp.GetRoot().CreateUint(ALLOCATED_BLOCKS_KEY, stats.allocated_blocks, &insp);
         insp.GetRoot().CreateUint(DEALLOCATED_BLOCKS_KEY, stats.deallocated_blocks, &insp);
         insp.GetRoot().CreateUint(FAILED_ALLOCATIONS_KEY, stats.failed_allocations, &insp);
+        insp.GetRoot().CreateUint(ALLOCATED_BYTES_KEY, stats.allocated_bytes, &insp);
+        insp.GetRoot().CreateUint(LARGEST_FREE_BLOCK_KEY, stats.largest_free_block, &insp);
         return fpromise::make_ok_promise(insp);
       },
       this);
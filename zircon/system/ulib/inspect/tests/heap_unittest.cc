@@ -121,13 +121,13 @@ TEST(Heap, Allocate) {
   heap.Free(4);
   heap.Free(0);
 
-  // Allocate small blocks again to see that we get the same ones in reverse order.
+  // Allocate small blocks again to see that we get the same ones, lowest first.
   EXPECT_OK(heap.Allocate(kMinAllocationSize, &b));
   EXPECT_EQ(0u, b);
   EXPECT_OK(heap.Allocate(kMinAllocationSize, &b));
-  EXPECT_EQ(4u, b);
-  EXPECT_OK(heap.Allocate(kMinAllocationSize, &b));
   EXPECT_EQ(2u, b);
+  EXPECT_OK(heap.Allocate(kMinAllocationSize, &b));
+  EXPECT_EQ(4u, b);
 
   // Free everything except for the first two.
   heap.Free(4);
@@ -181,6 +181,68 @@ TEST(Heap, Allocate) {
   heap.Free(128);
 }
 
+TEST(Heap, FragmentationStats) {
+  auto vmo = MakeVmo(4096);
+  ASSERT_TRUE(!!vmo);
+  Heap heap(std::move(vmo));
+  EXPECT_EQ(0u, heap.allocated_bytes());
+  EXPECT_EQ(2048u, heap.LargestFreeBlockSize());
+
+  // A small block in each half leaves plenty of space, but nothing large.
+  BlockIndex a, b;
+  EXPECT_OK(heap.Allocate(kMinAllocationSize, &a));
+  EXPECT_EQ(0u, a);
+  EXPECT_OK(heap.Allocate(1024, &b));
+  EXPECT_EQ(64u, b);
+  EXPECT_EQ(1024u + kMinAllocationSize, heap.allocated_bytes());
+  EXPECT_EQ(2048u, heap.LargestFreeBlockSize());
+
+  BlockIndex c;
+  EXPECT_OK(heap.Allocate(2048, &c));
+  EXPECT_EQ(128u, c);
+  EXPECT_EQ(512u, heap.LargestFreeBlockSize());
+
+  heap.Free(b);
+  EXPECT_EQ(2048u + kMinAllocationSize, heap.allocated_bytes());
+  EXPECT_EQ(1024u, heap.LargestFreeBlockSize());
+
+  heap.Free(a);
+  heap.Free(c);
+  EXPECT_EQ(0u, heap.allocated_bytes());
+  EXPECT_EQ(2048u, heap.LargestFreeBlockSize());
+}
+
+TEST(Heap, ReuseLowestFreeBlock) {
+  auto vmo = MakeVmo(4096);
+  ASSERT_TRUE(!!vmo);
+  Heap heap(std::move(vmo));
+
+  // Fill the first half of the buffer with small blocks.
+  BlockIndex b;
+  for (BlockIndex i = 0; i < 128; ++i) {
+    EXPECT_OK(heap.Allocate(kMinAllocationSize, &b));
+    EXPECT_EQ(i, b);
+  }
+
+  // Free a block from the start of that half, then some from its end.
+  heap.Free(1);
+  heap.Free(127);
+  heap.Free(126);
+
+  // The block at the start is reused first, even though it was freed earliest, so that the end of
+  // the half may still merge back together.
+  EXPECT_OK(heap.Allocate(kMinAllocationSize, &b));
+  EXPECT_EQ(1u, b);
+  heap.Free(1);
+  for (BlockIndex i = 0; i < 126; ++i) {
+    if (i != 1) {
+      heap.Free(i);
+    }
+  }
+
+  MatchDebugBlockVectors({{0, BlockType::kFree, 7}, {128, BlockType::kFree, 7}}, dump(heap));
+}
+
 TEST(Heap, MergeBlockedByAllocation) {
   auto vmo = MakeVmo(4096);
   ASSERT_TRUE(!!vmo);
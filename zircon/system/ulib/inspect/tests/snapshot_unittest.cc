@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include <lib/fzl/owned-vmo-mapper.h>
+#include <lib/inspect/cpp/inspector.h>
 #include <lib/inspect/cpp/vmo/block.h>
 #include <lib/inspect/cpp/vmo/limits.h>
 #include <lib/inspect/cpp/vmo/snapshot.h>
@@ -24,6 +25,7 @@ using inspect::internal::kMinOrderSize;
 using inspect::internal::kMinVmoSize;
 using inspect::internal::kVmoHeaderBlockSize;
 using inspect::internal::kVmoHeaderOrder;
+using inspect::internal::SetHeaderCounterCount;
 using inspect::internal::SetHeaderVmoSize;
 
 TEST(Snapshot, ValidRead) {
@@ -273,6 +275,64 @@ TEST(Snapshot, FrozenVmo) {
   EXPECT_EQ(inspect::internal::kVmoFrozen, header_block->payload.u64);
 }
 
+TEST(Snapshot, ReusePreviousSnapshot) {
+  fzl::OwnedVmoMapper vmo;
+  ASSERT_OK(vmo.CreateAndMap(4096, "test"));
+  memset(vmo.start(), 'a', 4096);
+  Block* header = reinterpret_cast<Block*>(vmo.start());
+  header->header = HeaderBlockFields::Order::Make(kVmoHeaderOrder) |
+                   HeaderBlockFields::Type::Make(BlockType::kHeader) |
+                   HeaderBlockFields::Version::Make(0);
+  memcpy(&header->header_data[4], kMagicNumber, 4);
+  header->payload.u64 = 2;
+  SetHeaderVmoSize(header, vmo.size());
+  SetHeaderCounterCount(header, 0);
+  uint8_t* last_byte = reinterpret_cast<uint8_t*>(vmo.start()) + 4095;
+
+  // Without a previous snapshot the VMO is read in full.
+  Snapshot first;
+  ASSERT_OK(Snapshot::Create(vmo.vmo(), Snapshot(), &first));
+  EXPECT_EQ(2u, first.generation());
+  EXPECT_EQ('a', first.data()[4095]);
+
+  // The generation is unchanged, so the previous data is shared rather than read again.
+  *last_byte = 'b';
+  Snapshot second;
+  ASSERT_OK(Snapshot::Create(vmo.vmo(), first, &second));
+  EXPECT_EQ(first.data(), second.data());
+  EXPECT_EQ('a', second.data()[4095]);
+
+  // A write in progress isn't mistaken for the same generation.
+  header->payload.u64 = 3;
+  Snapshot pending;
+  EXPECT_EQ(ZX_ERR_INTERNAL, Snapshot::Create(vmo.vmo(), first, &pending));
+
+  header->payload.u64 = 4;
+  Snapshot third;
+  ASSERT_OK(Snapshot::Create(vmo.vmo(), first, &third));
+  EXPECT_NE(first.data(), third.data());
+  EXPECT_EQ(4u, third.generation());
+  EXPECT_EQ('b', third.data()[4095]);
+}
+
+TEST(Snapshot, CounterUpdateIsNotReused) {
+  inspect::Inspector inspector;
+  inspect::UintCounter counter = inspector.GetRoot().CreateUintCounter("counter", 0);
+  zx::vmo vmo = inspector.DuplicateVmo();
+
+  Snapshot first;
+  ASSERT_OK(Snapshot::Create(vmo, Snapshot(), &first));
+
+  // Only the counter changes, which leaves the generation count where it was.
+  counter.Add(1);
+  Snapshot second;
+  ASSERT_OK(Snapshot::Create(vmo, first, &second));
+  EXPECT_EQ(first.generation(), second.generation());
+  EXPECT_NE(first.data(), second.data());
+  ASSERT_EQ(first.size(), second.size());
+  EXPECT_NE(0, memcmp(first.data(), second.data(), first.size()));
+}
+
 TEST(Snapshot, VmoWithUnusedSpace) {
   fzl::OwnedVmoMapper vmo;
   size_t size = 4 * kMinVmoSize;
@@ -32,6 +32,7 @@ using inspect::ByteVectorProperty;
 using inspect::DoubleArray;
 using inspect::DoubleProperty;
 using inspect::IntArray;
+using inspect::IntCounter;
 using inspect::IntProperty;
 using inspect::Link;
 using inspect::Node;
@@ -39,6 +40,7 @@ using inspect::Snapshot;
 using inspect::StringArray;
 using inspect::StringProperty;
 using inspect::UintArray;
+using inspect::UintCounter;
 using inspect::UintProperty;
 using inspect::internal::ArrayBlockFormat;
 using inspect::internal::ArrayBlockPayload;
@@ -489,6 +491,66 @@ TEST(State, CreateUintProperty) {
   CompareBlock(blocks.find(7)->block, MakeInlinedOrder0StringReferenceBlock("c"));
 }
 
+TEST(State, CreateCounters) {
+  auto state = InitState(4096);
+  ASSERT_TRUE(state != NULL);
+
+  IntCounter a = state->CreateIntCounter("a", 0, 0);
+  UintCounter b = state->CreateUintCounter("b", 0, 10);
+
+  a.Subtract(5);
+  b.Add(15);
+  b.Subtract(10);
+
+  fbl::WAVLTree<BlockIndex, std::unique_ptr<ScannedBlock>> blocks;
+  size_t free_blocks, allocated_blocks;
+  auto snapshot = SnapshotAndScan(state->GetVmo(), &blocks, &free_blocks, &allocated_blocks);
+  ASSERT_TRUE(snapshot);
+
+  // Header and 2 for each counter.
+  EXPECT_EQ(5u, allocated_blocks);
+
+  // Only creating the counters changes the generation. The header records that they exist.
+  CompareBlock(blocks.find(0)->block, MakeHeader(4));
+  EXPECT_EQ(2u, inspect::internal::GetHeaderCounterCount(blocks.find(0)->block));
+  CompareBlock(blocks.find(2)->block,
+               MakeIntBlock(ValueBlockFields::Type::Make(BlockType::kIntValue) |
+                                ValueBlockFields::NameIndex::Make(3),
+                            -5));
+  CompareBlock(blocks.find(3)->block, MakeInlinedOrder0StringReferenceBlock("a"));
+  CompareBlock(blocks.find(4)->block,
+               MakeBlock(ValueBlockFields::Type::Make(BlockType::kUintValue) |
+                             ValueBlockFields::NameIndex::Make(5),
+                         15));
+  CompareBlock(blocks.find(5)->block, MakeInlinedOrder0StringReferenceBlock("b"));
+}
+
+TEST(State, FreeCounter) {
+  auto state = InitState(4096);
+  ASSERT_TRUE(state != NULL);
+
+  UintCounter moved;
+  {
+    UintCounter counter = state->CreateUintCounter("a", 0, 0);
+    moved = std::move(counter);
+    // Operations on a moved-from counter are no-ops.
+    counter.Add(1);
+  }
+  moved.Add(2);
+  moved = UintCounter();
+  moved.Add(3);
+
+  fbl::WAVLTree<BlockIndex, std::unique_ptr<ScannedBlock>> blocks;
+  size_t free_blocks, allocated_blocks;
+  auto snapshot = SnapshotAndScan(state->GetVmo(), &blocks, &free_blocks, &allocated_blocks);
+  ASSERT_TRUE(snapshot);
+
+  // Only the header remains.
+  EXPECT_EQ(1u, allocated_blocks);
+  EXPECT_EQ(0u, inspect::internal::GetHeaderCounterCount(blocks.find(0)->block));
+  CompareBlock(blocks.find(0)->block, MakeHeader(4));
+}
+
 TEST(State, CreateDoubleProperty) {
   auto state = InitState(4096);
   ASSERT_TRUE(state != NULL);
@@ -1560,6 +1622,10 @@ TEST(State, GetStatsTest) {
   EXPECT_EQ(1u, stats.allocated_blocks);
   EXPECT_EQ(0u, stats.deallocated_blocks);
   EXPECT_EQ(0u, stats.failed_allocations);
+  // Only the header is allocated, the second half of the buffer is free.
+  EXPECT_EQ(inspect::internal::OrderToSize(inspect::internal::kVmoHeaderOrder),
+            stats.allocated_bytes);
+  EXPECT_EQ(inspect::internal::kMaxOrderSize, stats.largest_free_block);
 }
 
 TEST(State, GetStatsWithFailedAllocationTest) {
@@ -1686,6 +1752,59 @@ TEST(State, MultithreadingTest) {
   CompareBlock(blocks.find(5)->block, MakeInlinedOrder0StringReferenceBlock("root"));
 }
 
+struct CounterThreadArgs {
+  UintCounter* counter;
+  uint64_t value;
+  bool add;
+};
+
+int CounterThread(void* input) {
+  auto* args = reinterpret_cast<CounterThreadArgs*>(input);
+  for (size_t i = 0; i < kThreadTimes; i++) {
+    if (args->add) {
+      args->counter->Add(args->value);
+    } else {
+      args->counter->Subtract(args->value);
+    }
+  }
+
+  return 0;
+}
+
+TEST(State, MultithreadedCounterTest) {
+  auto state = InitState(10 * 4096);
+  ASSERT_TRUE(state != NULL);
+
+  UintCounter counter = state->CreateUintCounter("a", 0, 0);
+  Node root = state->CreateNode("root", 0);
+
+  // The counter is updated without the lock, while other threads change the buffer with it held.
+  CounterThreadArgs adder_1{.counter = &counter, .value = 2, .add = true};
+  CounterThreadArgs adder_2{.counter = &counter, .value = 2, .add = true};
+  CounterThreadArgs subtractor{.counter = &counter, .value = 1, .add = false};
+  thrd_t add_thread_1, add_thread_2, subtract_thread, child_thread;
+  thrd_create(&add_thread_1, CounterThread, &adder_1);
+  thrd_create(&add_thread_2, CounterThread, &adder_2);
+  thrd_create(&subtract_thread, CounterThread, &subtractor);
+  thrd_create(&child_thread, ChildThread, &root);
+  thrd_join(add_thread_1, nullptr);
+  thrd_join(add_thread_2, nullptr);
+  thrd_join(subtract_thread, nullptr);
+  thrd_join(child_thread, nullptr);
+
+  fbl::WAVLTree<BlockIndex, std::unique_ptr<ScannedBlock>> blocks;
+  size_t free_blocks, allocated_blocks;
+  auto snapshot = SnapshotAndScan(state->GetVmo(), &blocks, &free_blocks, &allocated_blocks);
+  ASSERT_TRUE(snapshot);
+
+  // Counter "a" is at index 2. None of the updates may be lost.
+  CompareBlock(blocks.find(2)->block,
+               MakeBlock(ValueBlockFields::Type::Make(BlockType::kUintValue) |
+                             ValueBlockFields::NameIndex::Make(3),
+                         3 * kThreadTimes));
+  CompareBlock(blocks.find(3)->block, MakeInlinedOrder0StringReferenceBlock("a"));
+}
+
 TEST(State, OutOfOrderDeletion) {
   // Ensure that deleting properties after their parent does not cause a crash.
   auto state = State::CreateWithSize(4096);
@@ -52,7 +52,7 @@ zx_status_t Heap::Allocate(size_t min_size, BlockIndex* out_block) {
   // what is needed.
   BlockOrder next_order = kNumOrders;
   for (BlockOrder i = min_fit_order; i < kNumOrders; i++) {
-    if (IsFreeBlock(free_blocks_[i], i)) {
+    if (!free_blocks_[i].empty()) {
       next_order = i;
       break;
     }
@@ -67,12 +67,13 @@ zx_status_t Heap::Allocate(size_t min_size, BlockIndex* out_block) {
       return status;
     }
     next_order = kNumOrders - 1;
-    ZX_ASSERT(IsFreeBlock(free_blocks_[kNumOrders - 1], kNumOrders - 1));
+    ZX_ASSERT(!free_blocks_[kNumOrders - 1].empty());
   }
 
   // Once a free block is found, split it repeatedly until it is the
-  // right size.
-  BlockIndex next_block_index = free_blocks_[next_order];
+  // right size. Taking the lowest free block keeps live blocks packed
+  // towards the start of the VMO.
+  BlockIndex next_block_index = *free_blocks_[next_order].begin();
   while (GetOrder(GetBlock(next_block_index)) > min_fit_order) {
     if (!SplitBlock(next_block_index)) {
       return ZX_ERR_INTERNAL;
@@ -87,12 +88,14 @@ zx_status_t Heap::Allocate(size_t min_size, BlockIndex* out_block) {
                        BlockFields::Type::Make(BlockType::kReserved);
 
   *out_block = next_block_index;
+  allocated_bytes_ += OrderToSize(GetOrder(next_block));
   ++total_allocated_blocks_;
   return ZX_OK;
 }
 
 void Heap::Free(BlockIndex block_index) {
   auto* block = GetBlock(block_index);
+  allocated_bytes_ -= OrderToSize(GetOrder(block));
   BlockIndex buddy_index = Buddy(block_index, GetOrder(block));
   auto* buddy = GetBlock(buddy_index);
 
@@ -113,11 +116,10 @@ void Heap::Free(BlockIndex block_index) {
     buddy = GetBlock(buddy_index);
   }
 
-  // Complete freeing the block by linking it onto the free list.
+  // Complete freeing the block by adding it to the free list.
   block->header = BlockFields::Order::Make(GetOrder(block)) |
-                  BlockFields::Type::Make(BlockType::kFree) |
-                  FreeBlockFields::NextFreeBlock::Make(free_blocks_[GetOrder(block)]);
-  free_blocks_[GetOrder(block)] = block_index;
+                  BlockFields::Type::Make(BlockType::kFree);
+  free_blocks_[GetOrder(block)].insert(block_index);
   ++total_deallocated_blocks_;
 }
 
@@ -135,13 +137,11 @@ bool Heap::SplitBlock(BlockIndex block) {
   // onto the free list of the new order.
   BlockIndex buddy_index = Buddy(block, order - 1);
   auto* buddy = GetBlock(buddy_index);
-  cur->header = BlockFields::Order::Make(order - 1) | BlockFields::Type::Make(BlockType::kFree) |
-                FreeBlockFields::NextFreeBlock::Make(buddy_index);
+  cur->header = BlockFields::Order::Make(order - 1) | BlockFields::Type::Make(BlockType::kFree);
+  buddy->header = BlockFields::Order::Make(order - 1) | BlockFields::Type::Make(BlockType::kFree);
 
-  buddy->header = BlockFields::Order::Make(order - 1) | BlockFields::Type::Make(BlockType::kFree) |
-                  FreeBlockFields::NextFreeBlock::Make(free_blocks_[order - 1]);
-
-  free_blocks_[order - 1] = block;
+  free_blocks_[order - 1].insert(block);
+  free_blocks_[order - 1].insert(buddy_index);
 
   return true;
 }
@@ -154,27 +154,16 @@ bool Heap::RemoveFree(BlockIndex block) {
     return false;
   }
 
-  // If the block we are removing is at the head of the list,
-  // immediately unlink it and return.
-  BlockIndex next = free_blocks_[order];
-  if (next == block) {
-    free_blocks_[order] = FreeBlockFields::NextFreeBlock::Get<size_t>(to_remove->header);
-    return true;
-  }
+  return free_blocks_[order].erase(block) != 0;
+}
 
-  // Look through the free list until we find the position for the block,
-  // then unlink it.
-  while (IsFreeBlock(next, order)) {
-    auto* cur = GetBlock(next);
-    next = FreeBlockFields::NextFreeBlock::Get<size_t>(cur->header);
-    if (next == block) {
-      FreeBlockFields::NextFreeBlock::Set(
-          &cur->header, FreeBlockFields::NextFreeBlock::Get<size_t>(to_remove->header));
-      return true;
+size_t Heap::LargestFreeBlockSize() const {
+  for (BlockOrder order = kNumOrders; order-- > 0;) {
+    if (!free_blocks_[order].empty()) {
+      return OrderToSize(order);
     }
   }
-
-  return false;
+  return 0;
 }
 
 zx_status_t Heap::Extend(size_t new_size) {
@@ -189,22 +178,17 @@ zx_status_t Heap::Extend(size_t new_size) {
   }
 
   size_t min_index = IndexForOffset(cur_size_);
-  size_t last_index = free_blocks_[kNumOrders - 1];
   // Ensure we start on an index at a page boundary.
-  // Convert each new max order block to a free block in descending
-  // order on the free list.
+  // Convert each new max order block to a free block.
   size_t cur_index = IndexForOffset(new_size - new_size % kMinVmoSize);
   do {
     cur_index -= IndexForOffset(kMaxOrderSize);
     auto* block = GetBlock(cur_index);
     block->header = BlockFields::Order::Make(kNumOrders - 1) |
-                    BlockFields::Type::Make(BlockType::kFree) |
-                    FreeBlockFields::NextFreeBlock::Make(last_index);
-    last_index = cur_index;
+                    BlockFields::Type::Make(BlockType::kFree);
+    free_blocks_[kNumOrders - 1].insert(cur_index);
   } while (cur_index > min_index);
 
-  free_blocks_[kNumOrders - 1] = last_index;
-
   cur_size_ = new_size;
   if (header_block) {
     SetHeaderVmoSize(header_block.value(), cur_size_);
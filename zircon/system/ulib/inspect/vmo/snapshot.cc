@@ -37,11 +37,11 @@ zx_status_t Snapshot::Create(BackingBuffer&& buffer, Snapshot* out_snapshot) {
     return ZX_ERR_INVALID_ARGS;
   }
 
-  // A buffer does not have concurrent writers or observers, so we don't use
-  // this.
-  uint64_t unused;
+  // A buffer does not have concurrent writers or observers, so the generation
+  // is only recorded.
+  uint64_t generation;
   // Verify that the buffer can, in fact, be parsed as a snapshot.
-  zx_status_t status = Snapshot::ParseHeader(buffer.Data(), &unused);
+  zx_status_t status = Snapshot::ParseHeader(buffer.Data(), &generation);
   if (status != ZX_OK) {
     return status;
   }
@@ -49,9 +49,30 @@ zx_status_t Snapshot::Create(BackingBuffer&& buffer, Snapshot* out_snapshot) {
   if (!*out_snapshot) {
     return ZX_ERR_INTERNAL;
   }
+  out_snapshot->generation_ = generation;
   return ZX_OK;
 }
 
+zx_status_t Snapshot::Create(const zx::vmo& vmo, const Snapshot& previous,
+                             Snapshot* out_snapshot) {
+  if (previous) {
+    uint8_t header[kVmoHeaderBlockSize];
+    uint64_t generation;
+    // An odd generation means a write is in progress, and a snapshot with the
+    // same even generation was taken before it started. Counters change their
+    // values without touching the generation, so nothing is reused while the
+    // VMO has any.
+    if (Snapshot::Read(vmo, sizeof(header), header) == ZX_OK &&
+        Snapshot::ParseHeader(header, &generation) == ZX_OK && generation % 2 == 0 &&
+        generation == previous.generation_ &&
+        internal::GetHeaderCounterCount(reinterpret_cast<const Block*>(header)) == 0) {
+      *out_snapshot = previous;
+      return ZX_OK;
+    }
+  }
+  return Snapshot::Create(vmo, kDefaultOptions, out_snapshot);
+}
+
 zx_status_t Snapshot::Create(const zx::vmo& vmo, Snapshot* out_snapshot) {
   return Snapshot::Create(vmo, kDefaultOptions, out_snapshot);
 }
@@ -71,6 +92,7 @@ zx_status_t Snapshot::Create(const zx::vmo& vmo, Options options, ReadObserver r
     }
 
     *out_snapshot = Snapshot(std::move(maybe_frozen));
+    out_snapshot->generation_ = generation;
     return ZX_OK;
   }
 
@@ -144,6 +166,7 @@ zx_status_t Snapshot::Create(const zx::vmo& vmo, Options options, ReadObserver r
     }
 
     *out_snapshot = Snapshot(BackingBuffer(std::move(buffer)));
+    out_snapshot->generation_ = generation;
 
     return ZX_OK;
   }
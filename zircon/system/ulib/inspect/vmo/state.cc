@@ -246,6 +246,7 @@ std::shared_ptr<State> State::Create(std::unique_ptr<Heap> heap) {
   memcpy(&block->header_data[4], kMagicNumber, 4);
   block->payload.u64 = 0;
   SetHeaderVmoSize(block, heap->size());
+  SetHeaderCounterCount(block, 0);
   heap->SetHeaderBlock(block);
 
   std::shared_ptr<State> ret(new State(std::move(heap), header));
@@ -368,6 +369,42 @@ UintProperty State::CreateUintProperty(BorrowedStringValue name, BlockIndex pare
   return UintProperty(weak_self_ptr_.lock(), name_index, value_index);
 }
 
+IntCounter State::CreateIntCounter(BorrowedStringValue name, BlockIndex parent, int64_t value) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::unique_ptr<AutoGenerationIncrement> gen = MaybeIncrementGeneration();
+
+  BlockIndex name_index, value_index;
+  zx_status_t status;
+  status = InnerCreateValue(name, BlockType::kIntValue, parent, &name_index, &value_index);
+  if (status != ZX_OK) {
+    return IntCounter();
+  }
+
+  auto* block = heap_->GetBlock(value_index);
+  block->payload.i64 = value;
+  AdjustHeaderCounterCount(1);
+
+  return IntCounter(weak_self_ptr_.lock(), name_index, value_index, &block->payload.i64);
+}
+
+UintCounter State::CreateUintCounter(BorrowedStringValue name, BlockIndex parent, uint64_t value) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::unique_ptr<AutoGenerationIncrement> gen = MaybeIncrementGeneration();
+
+  BlockIndex name_index, value_index;
+  zx_status_t status;
+  status = InnerCreateValue(name, BlockType::kUintValue, parent, &name_index, &value_index);
+  if (status != ZX_OK) {
+    return UintCounter();
+  }
+
+  auto* block = heap_->GetBlock(value_index);
+  block->payload.u64 = value;
+  AdjustHeaderCounterCount(1);
+
+  return UintCounter(weak_self_ptr_.lock(), name_index, value_index, &block->payload.u64);
+}
+
 DoubleProperty State::CreateDoubleProperty(BorrowedStringValue name, BlockIndex parent,
                                            double value) {
   std::lock_guard<std::mutex> lock(mutex_);
@@ -825,6 +862,34 @@ void State::FreeUintProperty(UintProperty* metric) {
   metric->state_ = nullptr;
 }
 
+template <typename WrapperType>
+void State::InnerFreeCounter(WrapperType* counter) {
+  ZX_DEBUG_ASSERT_MSG(counter->state_.get() == this, "Counter being freed from the wrong state");
+  if (counter->state_.get() != this) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::unique_ptr<AutoGenerationIncrement> gen = MaybeIncrementGeneration();
+
+  DecrementParentRefcount(counter->value_index_);
+
+  InnerReleaseStringReference(counter->name_index_);
+  heap_->Free(counter->value_index_);
+  AdjustHeaderCounterCount(-1);
+  counter->state_ = nullptr;
+  counter->value_ = nullptr;
+}
+
+void State::AdjustHeaderCounterCount(int64_t delta) {
+  Block* header = heap_->GetBlock(header_);
+  SetHeaderCounterCount(header, GetHeaderCounterCount(header) + delta);
+}
+
+void State::FreeIntCounter(IntCounter* counter) { InnerFreeCounter(counter); }
+
+void State::FreeUintCounter(UintCounter* counter) { InnerFreeCounter(counter); }
+
 void State::FreeDoubleProperty(DoubleProperty* metric) {
   ZX_DEBUG_ASSERT_MSG(metric->state_.get() == this, "Property being freed from the wrong state");
   if (metric->state_.get() != this) {
@@ -1302,6 +1367,8 @@ InspectStats State::GetStats() const {
   ret.allocated_blocks = heap_->TotalAllocatedBlocks();
   ret.deallocated_blocks = heap_->TotalDeallocatedBlocks();
   ret.failed_allocations = heap_->TotalFailedAllocations();
+  ret.allocated_bytes = heap_->allocated_bytes();
+  ret.largest_free_block = heap_->LargestFreeBlockSize();
   return ret;
 }
 
@@ -9,6 +9,7 @@
 #include <lib/zx/event.h>
 
 #include <cstdint>
+#include <utility>
 
 using inspect::internal::ArrayBlockFormat;
 
@@ -94,6 +95,46 @@ void internal::NumericProperty<uint64_t>::Subtract(uint64_t value) {
   }
 }
 
+template <>
+internal::NumericCounter<int64_t>::~NumericCounter<int64_t>() {
+  if (state_) {
+    state_->FreeIntCounter(this);
+  }
+}
+
+template <>
+internal::NumericCounter<int64_t>& internal::NumericCounter<int64_t>::operator=(
+    internal::NumericCounter<int64_t>&& other) noexcept {
+  if (state_) {
+    state_->FreeIntCounter(this);
+  }
+  state_ = std::move(other.state_);
+  name_index_ = other.name_index_;
+  value_index_ = other.value_index_;
+  value_ = std::exchange(other.value_, nullptr);
+  return *this;
+}
+
+template <>
+internal::NumericCounter<uint64_t>::~NumericCounter<uint64_t>() {
+  if (state_) {
+    state_->FreeUintCounter(this);
+  }
+}
+
+template <>
+internal::NumericCounter<uint64_t>& internal::NumericCounter<uint64_t>::operator=(
+    internal::NumericCounter<uint64_t>&& other) noexcept {
+  if (state_) {
+    state_->FreeUintCounter(this);
+  }
+  state_ = std::move(other.state_);
+  name_index_ = other.name_index_;
+  value_index_ = other.value_index_;
+  value_ = std::exchange(other.value_, nullptr);
+  return *this;
+}
+
 template <>
 internal::NumericProperty<double>::~NumericProperty<double>() {
   if (state_) {
@@ -385,6 +426,20 @@ void Node::RecordUint(BorrowedStringValue name, uint64_t value) {
   value_list_.emplace(CreateUint(name, value));
 }
 
+IntCounter Node::CreateIntCounter(BorrowedStringValue name, int64_t value) {
+  if (state_) {
+    return state_->CreateIntCounter(name, value_index_, value);
+  }
+  return IntCounter();
+}
+
+UintCounter Node::CreateUintCounter(BorrowedStringValue name, uint64_t value) {
+  if (state_) {
+    return state_->CreateUintCounter(name, value_index_, value);
+  }
+  return UintCounter();
+}
+
 DoubleProperty Node::CreateDouble(BorrowedStringValue name, double value) {
   if (state_) {
     return state_->CreateDoubleProperty(name, value_index_, value);
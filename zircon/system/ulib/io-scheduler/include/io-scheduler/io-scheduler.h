@@ -133,6 +133,9 @@ class Scheduler {
   // Find an open stream by ID.
   zx_status_t FindLocked(uint32_t id, StreamRef* out = nullptr) __TA_REQUIRES(lock_);
 
+  // Add a stream which has ops ready to |ready_streams_|. Streams of the same priority take turns.
+  void ScheduleStreamLocked(StreamRef stream) __TA_REQUIRES(lock_);
+
   // Insert a single op into a stream.
   zx_status_t InsertOp(UniqueOp op, UniqueOp* op_err) __TA_EXCLUDES(lock_);
 
@@ -150,7 +153,8 @@ class Scheduler {
   // Map of id to stream ref.
   Stream::WAVLTreeSortById all_streams_ __TA_GUARDED(lock_);
 
-  // List of all streams that have ops ready to be issued, in priority order.
+  // List of all streams that have ops ready to be issued, in priority order. Ops are always taken
+  // from the stream at the front, so higher priority streams are drained first.
   Stream::ReadyStreamList ready_streams_ __TA_GUARDED(lock_);
 
   // List of streams that have deferred ops, in fifo order.
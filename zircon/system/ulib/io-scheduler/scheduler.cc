@@ -137,7 +137,7 @@ zx_status_t Scheduler::InsertOp(UniqueOp op, UniqueOp* op_err) {
     return status;
   }
   if (!was_ready) {
-    ready_streams_.push_back(std::move(stream));
+    ScheduleStreamLocked(std::move(stream));
   }
   ops_available_.Signal();
   return ZX_OK;
@@ -181,8 +181,9 @@ zx_status_t Scheduler::Dequeue(bool wait, UniqueOp* out) {
       stream->GetNext(out);
       ZX_DEBUG_ASSERT(*out != nullptr);
       if (stream->HasReady()) {
-        // Stream has more ops, return to tail of ready stream queue.
-        ready_streams_.push_back(std::move(stream));
+        // Stream has more ops, return it to the ready stream queue behind any others of the same
+        // priority.
+        ScheduleStreamLocked(std::move(stream));
       }
       return ZX_OK;
     }
@@ -243,6 +244,14 @@ void Scheduler::ReleaseOp(UniqueOp op) {
   }
 }
 
+void Scheduler::ScheduleStreamLocked(StreamRef stream) {
+  auto iter = ready_streams_.begin();
+  while (iter != ready_streams_.end() && iter->priority() >= stream->priority()) {
+    ++iter;
+  }
+  ready_streams_.insert(iter, std::move(stream));
+}
+
 zx_status_t Scheduler::FindLocked(uint32_t id, StreamRef* out) {
   auto iter = all_streams_.find(id);
   if (!iter.IsValid()) {
@@ -6,6 +6,8 @@
 #include <string.h>
 #include <unistd.h>
 
+#include <vector>
+
 #include <fbl/auto_lock.h>
 #include <fbl/intrusive_double_list.h>
 #include <fbl/ref_counted.h>
@@ -96,6 +98,7 @@ class IOSchedTestFixture : public zxtest::Test, public SchedulerClient {
     issued_list_.clear();
     completed_list_.clear();
     released_list_.clear();
+    issued_ids_.clear();
     sched_.reset();
   }
 
@@ -120,6 +123,12 @@ class IOSchedTestFixture : public zxtest::Test, public SchedulerClient {
   void CheckExpectedResult();
   void CheckExpectedResultWithFailures(uint32_t acquire_failures);
 
+  // IDs of ops in the order they were issued.
+  std::vector<uint32_t> IssuedIds() {
+    fbl::AutoLock lock(&lock_);
+    return issued_ids_;
+  }
+
   // Callback methods.
   bool CanReorder(StreamOp* first, StreamOp* second) override { return false; }
 
@@ -185,6 +194,9 @@ class IOSchedTestFixture : public zxtest::Test, public SchedulerClient {
 
   // List of ops released by the scheduler.
   fbl::DoublyLinkedList<TopRef> released_list_ __TA_GUARDED(lock_);
+
+  // IDs of ops in the order they were issued.
+  std::vector<uint32_t> issued_ids_ __TA_GUARDED(lock_);
 };
 
 void IOSchedTestFixture::InsertOp(TopRef top) {
@@ -324,6 +336,7 @@ zx_status_t IOSchedTestFixture::Issue(StreamOp* sop) {
   fbl::AutoLock lock(&lock_);
   issued_total_++;
   TopRef top = acquired_list_.erase(*static_cast<TestOp*>(sop->cookie()));
+  issued_ids_.push_back(top->id());
   if (top->async()) {
     // Will be completed asynchronously.
     top->set_stage(Stage::kStageIssued);
@@ -565,4 +578,29 @@ TEST_F(IOSchedTestFixture, ServeTestInvalidStreams) { DoInvalidStreamTest(0); }
 TEST_F(IOSchedTestFixture, ServeTestInvalidStreamsAsync) { DoInvalidStreamTest(100); }
 TEST_F(IOSchedTestFixture, ServeTestInvalidStreamsMixed) { DoInvalidStreamTest(50); }
 
+// Ops in higher priority streams are issued before those in lower priority ones.
+TEST_F(IOSchedTestFixture, ServeTestPriority) {
+  ASSERT_OK(sched_->Init(this, kOptionStrictlyOrdered), "Failed to init scheduler");
+  const uint32_t kLowStream = 1;
+  const uint32_t kHighStream = 2;
+  ASSERT_OK(sched_->StreamOpen(kLowStream, kDefaultPriority), "Failed to open stream");
+  ASSERT_OK(sched_->StreamOpen(kHighStream, kMaxPriority), "Failed to open stream");
+
+  // Few enough ops that they are all acquired at once. Even IDs go in the low priority stream.
+  const uint32_t num_ops = 8;
+  for (uint32_t i = 0; i < num_ops; i++) {
+    InsertOp(fbl::AdoptRef(new TestOp(i, (i % 2 == 0) ? kLowStream : kHighStream)));
+  }
+  ASSERT_OK(sched_->Serve(), "Failed to begin service");
+  WaitAcquire();
+  sched_->Shutdown();
+  CheckExpectedResult();
+
+  std::vector<uint32_t> issued_ids = IssuedIds();
+  ASSERT_EQ(issued_ids.size(), num_ops);
+  for (uint32_t i = 0; i < num_ops / 2; i++) {
+    EXPECT_EQ(issued_ids[i] % 2, 1, "Low priority op issued ahead of high priority op");
+  }
+}
+
 }  // namespace ioscheduler
@@ -84,7 +84,6 @@ VmoToInspectMapper::VmoToInspectMapper() : inspector_() {
       initialization_status_ = ZX_ERR_IO;
       return;
     }
-    status = desc_mapper_.Map(std::move(vmo), size, ZX_VM_PERM_READ);
     desc_ = reinterpret_cast<counters::DescriptorVmo*>(desc_mapper_.start());
     if (desc_->magic != counters::DescriptorVmo::kMagic) {
       fprintf(stderr, "%s: magic number %" PRIu64 " != expected %" PRIu64 "\n",
@@ -92,7 +91,6 @@ VmoToInspectMapper::VmoToInspectMapper() : inspector_() {
       initialization_status_ = ZX_ERR_IO;
       return;
     }
-    status = desc_mapper_.Map(std::move(vmo), size, ZX_VM_PERM_READ);
     if (size < sizeof(*desc_) + desc_->descriptor_table_size) {
       fprintf(stderr, "%s size %#" PRIx64 " too small for %" PRIu64 " bytes of descriptor table\n",
               counters::DescriptorVmo::kVmoName, size, desc_->descriptor_table_size);
@@ -204,6 +202,7 @@ void VmoToInspectMapper::BuildCounterToMetricVMOMapping() {
     if (!ShouldInclude(entry)) {
       continue;
     }
+    included_indices_.push_back(i);
 
     auto parts = SplitString(entry.name, '.');
     ZX_ASSERT(parts.size() > 1);
@@ -241,12 +240,7 @@ zx_status_t VmoToInspectMapper::UpdateInspectVMO() {
     // Regardless of the number of times this function is called, the data will
     // not be updated more frequently than once per second.
 
-    for (size_t i = 0; i < desc_->num_counters(); ++i) {
-      const auto& entry = desc_->descriptor_table[i];
-      if (!ShouldInclude(entry)) {
-        continue;
-      }
-
+    for (size_t i : included_indices_) {
       int64_t value = 0;
       for (uint64_t cpu = 0; cpu < desc_->max_cpus; ++cpu) {
         const int64_t cpu_value = arena_[(cpu * desc_->num_counters()) + i];
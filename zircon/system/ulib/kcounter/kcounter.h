@@ -45,6 +45,8 @@ class VmoToInspectMapper final {
   inspect::Inspector inspector_;
   std::map<fbl::String, inspect::Node> intermediate_nodes_;
   std::vector<inspect::IntProperty> metric_by_index_;
+  // Indices of the counters that pass ShouldInclude, so that updates do not match names again.
+  std::vector<size_t> included_indices_;
 
   DISALLOW_COPY_AND_ASSIGN_ALLOW_MOVE(VmoToInspectMapper);
 };
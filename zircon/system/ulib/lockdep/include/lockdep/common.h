@@ -30,6 +30,14 @@ namespace lockdep {
 #define LOCK_DEP_ENABLE_VALIDATION 0
 #endif
 
+// Configures whether lock statistics are collected or not. Defaults to
+// disabled. When enabled along with validation, guards measure the time taken
+// to acquire each lock and the time each lock is held for, and report them to
+// the system through SystemLockAcquired() and SystemLockReleased().
+#ifndef LOCK_DEP_ENABLE_STATS
+#define LOCK_DEP_ENABLE_STATS 0
+#endif
+
 // Id type used to identify each lock class.
 using LockClassId = uintptr_t;
 
@@ -74,6 +82,10 @@ static_assert(kMaxLockDependencies != 0, "LOCK_DEP_MAX_DEPENDENCIES too large!")
 // Whether or not lock validation is globally enabled.
 constexpr bool kLockValidationEnabled = static_cast<bool>(LOCK_DEP_ENABLE_VALIDATION);
 
+// Whether or not lock statistics are globally enabled.
+constexpr bool kLockStatsEnabled =
+    kLockValidationEnabled && static_cast<bool>(LOCK_DEP_ENABLE_STATS);
+
 // Utility template alias to simplify selecting different types based whether
 // lock validation is enabled or disabled.
 template <typename EnabledType, typename DisabledType>
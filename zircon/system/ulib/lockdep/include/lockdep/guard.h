@@ -180,6 +180,7 @@ class __TA_SCOPED_CAPABILITY
     LockType* lock_ptr = validator_.lock();
 
     if (lock_ptr != nullptr) {
+      validator_.ReportRelease();
       validator_.ValidateRelease();
       validator_.Clear();
       LockPolicy<LockType, Option>::Release(lock_ptr, &state_, std::forward<Args>(args)...);
@@ -238,6 +239,7 @@ class __TA_SCOPED_CAPABILITY
   void CallUnlocked(Op&& op, ReleaseArgs&&... release_args) __TA_NO_THREAD_SAFETY_ANALYSIS {
     ZX_DEBUG_ASSERT(validator_.lock() != nullptr);
 
+    validator_.ReportRelease();
     validator_.ValidateRelease();
     LockPolicy<LockType, Option>::Release(validator_.lock(), &state_,
                                           std::forward<ReleaseArgs>(release_args)...);
@@ -294,9 +296,12 @@ class __TA_SCOPED_CAPABILITY
     // _after_ successfully obtaining the lock.
     LockPolicy<LockType, Option>::PreValidate(validator_.lock(), &state_);
     validator_.ValidateAcquire();
+    validator_.StartAcquire();
     if (!LockPolicy<LockType, Option>::Acquire(validator_.lock(), &state_)) {
       validator_.ValidateRelease();
       validator_.Clear();
+    } else {
+      validator_.ReportAcquire();
     }
   }
 
@@ -321,9 +326,31 @@ class __TA_SCOPED_CAPABILITY
     void ValidateRelease() { ThreadLockState::Get(kLockFlags)->Release(&lock_entry); }
     void Clear() { lock_entry.Clear(); }
 
+    // Lock statistics bookkeeping, see LOCK_DEP_ENABLE_STATS. The timestamp
+    // taken before waiting for the lock is replaced by the time the lock was
+    // acquired, to measure the hold time on release.
+    void StartAcquire() {
+      if constexpr (kLockStatsEnabled) {
+        timestamp = SystemLockStatsTimestamp();
+      }
+    }
+    void ReportAcquire() {
+      if constexpr (kLockStatsEnabled) {
+        const uint64_t now = SystemLockStatsTimestamp();
+        SystemLockAcquired(lock_entry.id(), now - timestamp);
+        timestamp = now;
+      }
+    }
+    void ReportRelease() {
+      if constexpr (kLockStatsEnabled) {
+        SystemLockReleased(lock_entry.id(), SystemLockStatsTimestamp() - timestamp);
+      }
+    }
+
     LockType* lock() const { return static_cast<LockType*>(lock_entry.address()); }
 
     AcquiredLockEntry lock_entry;
+    uint64_t timestamp{0};
   };
 
   // Validator type used when lock validation is disabled.
@@ -342,6 +369,9 @@ class __TA_SCOPED_CAPABILITY
     void ValidateAcquire() {}
     void ValidateRelease() {}
     void Clear() { address = nullptr; }
+    void StartAcquire() {}
+    void ReportAcquire() {}
+    void ReportRelease() {}
 
     LockType* lock() const { return address; }
 
@@ -413,6 +443,7 @@ class __TA_SCOPED_CAPABILITY Guard<LockType, Option, internal::EnableIfShared<Lo
     LockType* lock_ptr = validator_.lock();
 
     if (lock_ptr != nullptr) {
+      validator_.ReportRelease();
       validator_.ValidateRelease();
       validator_.Clear();
       LockPolicy<LockType, Option>::Release(lock_ptr, &state_, std::forward<Args>(args)...);
@@ -472,6 +503,7 @@ class __TA_SCOPED_CAPABILITY Guard<LockType, Option, internal::EnableIfShared<Lo
   void CallUnlocked(Op&& op, ReleaseArgs&&... release_args) __TA_NO_THREAD_SAFETY_ANALYSIS {
     ZX_DEBUG_ASSERT(validator_.lock() != nullptr);
 
+    validator_.ReportRelease();
     validator_.ValidateRelease();
     LockPolicy<LockType, Option>::Release(validator_.lock(), &state_,
                                           std::forward<ReleaseArgs>(release_args)...);
@@ -528,9 +560,12 @@ class __TA_SCOPED_CAPABILITY Guard<LockType, Option, internal::EnableIfShared<Lo
     // _after_ successfully obtaining the lock.
     LockPolicy<LockType, Option>::PreValidate(validator_.lock(), &state_);
     validator_.ValidateAcquire();
+    validator_.StartAcquire();
     if (!LockPolicy<LockType, Option>::Acquire(validator_.lock(), &state_)) {
       validator_.ValidateRelease();
       validator_.Clear();
+    } else {
+      validator_.ReportAcquire();
     }
   }
 
@@ -555,9 +590,31 @@ class __TA_SCOPED_CAPABILITY Guard<LockType, Option, internal::EnableIfShared<Lo
     void ValidateRelease() { ThreadLockState::Get(kLockFlags)->Release(&lock_entry); }
     void Clear() { lock_entry.Clear(); }
 
+    // Lock statistics bookkeeping, see LOCK_DEP_ENABLE_STATS. The timestamp
+    // taken before waiting for the lock is replaced by the time the lock was
+    // acquired, to measure the hold time on release.
+    void StartAcquire() {
+      if constexpr (kLockStatsEnabled) {
+        timestamp = SystemLockStatsTimestamp();
+      }
+    }
+    void ReportAcquire() {
+      if constexpr (kLockStatsEnabled) {
+        const uint64_t now = SystemLockStatsTimestamp();
+        SystemLockAcquired(lock_entry.id(), now - timestamp);
+        timestamp = now;
+      }
+    }
+    void ReportRelease() {
+      if constexpr (kLockStatsEnabled) {
+        SystemLockReleased(lock_entry.id(), SystemLockStatsTimestamp() - timestamp);
+      }
+    }
+
     LockType* lock() const { return static_cast<LockType*>(lock_entry.address()); }
 
     AcquiredLockEntry lock_entry;
+    uint64_t timestamp{0};
   };
 
   // Validator type used when lock validation is disabled.
@@ -576,6 +633,9 @@ class __TA_SCOPED_CAPABILITY Guard<LockType, Option, internal::EnableIfShared<Lo
     void ValidateAcquire() {}
     void ValidateRelease() {}
     void Clear() { address = nullptr; }
+    void StartAcquire() {}
+    void ReportAcquire() {}
+    void ReportRelease() {}
 
     LockType* lock() const { return address; }
 
@@ -87,6 +87,22 @@ class LockClassState {
     return !!(Get(id)->flags_ & LockFlagsTrackingDisabled);
   }
 
+  // Statistics about the acquisitions of a lock class. These are only updated
+  // by the system, in response to SystemLockAcquired() and
+  // SystemLockReleased() when LOCK_DEP_ENABLE_STATS is set. The units of the
+  // times are those of SystemLockStatsTimestamp().
+  struct Stats {
+    std::atomic<uint64_t> acquisitions{0};
+    std::atomic<uint64_t> contentions{0};
+    std::atomic<uint64_t> total_wait_time{0};
+    std::atomic<uint64_t> max_wait_time{0};
+    std::atomic<uint64_t> total_hold_time{0};
+    std::atomic<uint64_t> max_hold_time{0};
+  };
+
+  // Returns the statistics of the given lock class.
+  static Stats& GetStats(LockClassId id) { return Get(id)->stats_; }
+
   // Iterator type to traverse the set of LockClassState instances.
   class Iterator {
    public:
@@ -125,6 +141,9 @@ class LockClassState {
   // Returns the dependency set for this lock class.
   const LockDependencySet& dependency_set() const { return *dependency_set_; }
 
+  // Returns the statistics of this lock class.
+  Stats& stats() { return stats_; }
+
   LockClassState* connected_set() { return LoopDetector::FindSet(&loop_node_)->ToState(); }
 
   uint64_t index() const { return loop_node_.index; }
@@ -150,6 +169,9 @@ class LockClassState {
   // Flags specifying which which rules to apply during lock validation.
   const LockFlags flags_;
 
+  // Acquisition statistics of this lock class.
+  Stats stats_{};
+
   // Head pointer to linked list of state instances.
   inline static LockClassState* head_{nullptr};
 
@@ -15,6 +15,9 @@
 
 namespace lockdep {
 
+// Id type used to identify each lock class, see common.h.
+using LockClassId = uintptr_t;
+
 // Forward declarations.
 class AcquiredLockEntry;
 class ThreadLockState;
@@ -49,4 +52,17 @@ extern void SystemInitThreadLockState(ThreadLockState* state);
 // given time interval.
 extern void SystemTriggerLoopDetection();
 
+// System-defined hooks used to collect lock statistics when
+// LOCK_DEP_ENABLE_STATS is set. These are only referenced when statistics are
+// enabled.
+//
+// SystemLockStatsTimestamp() returns the current time in arbitrary, monotonic
+// units. SystemLockAcquired() is called after the lock class |id| is acquired,
+// with the time since the guard started waiting for the lock.
+// SystemLockReleased() is called just before the lock is released, with the
+// time that it was held for.
+extern uint64_t SystemLockStatsTimestamp();
+extern void SystemLockAcquired(LockClassId id, uint64_t wait_time);
+extern void SystemLockReleased(LockClassId id, uint64_t hold_time);
+
 }  // namespace lockdep
@@ -16,8 +16,8 @@
 // This is a library for writing performance tests.  It supports
 // performance tests that involve running an operation repeatedly,
 // sequentially, and recording the times taken by each run of the
-// operation.  (It does not yet support other types of performance test,
-// such as where we run an operation concurrently in multiple threads.)
+// operation.  It also supports running such a test concurrently on
+// multiple threads (see "Multi-threaded tests" below).
 //
 // There are two ways to implement a test:
 //
@@ -91,6 +91,36 @@
 // state->NextStep() between each step.
 //
 //
+// ## Multi-threaded tests
+//
+// Some costs only show up under concurrency, such as lock contention or
+// cache line bouncing.  A test function can be run on several threads at
+// once using RegisterMultiThreadedTest():
+//
+//   // Measure the time taken by FooOp() when called from several threads.
+//   bool FooOpContendedTest(perftest::RepeatState* state, uint32_t thread_index) {
+//       while (state->KeepRunning()) {
+//           FooOp();
+//       }
+//       return true;
+//   }
+//   void RegisterTests() {
+//       perftest::RegisterMultiThreadedTest("FooOpContended/4threads", 4,
+//                                           FooOpContendedTest);
+//   }
+//
+// Each thread gets its own RepeatState and does the full number of runs.
+// The threads' first runs start together, once every thread has finished
+// its setup phase (i.e. has made its first call to KeepRunning()).  The
+// times taken by all the threads' runs are reported together as a single
+// test case, so that the reported percentiles reflect every thread.
+//
+// |thread_index| ranges from 0 to the thread count minus 1.  A test that
+// wants its threads to run on particular CPUs can use it to pick a CPU and
+// set the affinity of the current thread before its first call to
+// KeepRunning().  All the threads must declare the same steps.
+//
+//
 // ## Test coding style
 //
 // ### Comments
@@ -152,9 +182,15 @@ class RepeatState {
 
 typedef bool TestFunc(RepeatState* state);
 typedef bool SimpleTestFunc();
+typedef bool MultiThreadedTestFunc(RepeatState* state, uint32_t thread_index);
 
 void RegisterTest(const char* name, fit::function<TestFunc> test_func);
 
+// Registers a test whose function will be called concurrently on
+// |thread_count| threads.  |test_func| must be safe to call concurrently.
+void RegisterMultiThreadedTest(const char* name, uint32_t thread_count,
+                               fit::function<MultiThreadedTestFunc> test_func);
+
 // Convenience routine for registering parameterized perf tests.
 template <typename Func, typename Arg, typename... Args>
 void RegisterTest(const char* name, Func test_func, Arg arg, Args... args) {
@@ -201,6 +237,14 @@ bool RunTest(const char* test_suite, const char* test_name,
              const fit::function<TestFunc>& test_func, uint32_t run_count, ResultsSet* results_set,
              fbl::String* error_out);
 
+// Like RunTest(), but calls |test_func| concurrently on |thread_count|
+// threads, each of which does |run_count| runs.  The times from all the
+// threads are added to |results_set| together.
+bool RunMultiThreadedTest(const char* test_suite, const char* test_name,
+                          const fit::function<MultiThreadedTestFunc>& test_func,
+                          uint32_t thread_count, uint32_t run_count, ResultsSet* results_set,
+                          fbl::String* error_out);
+
 // DoNotOptimize() can be used to prevent the computation of |value| from
 // being optimized away by the compiler.  It also prevents the compiler
 // from optimizing away reads or writes to memory that |value| points to
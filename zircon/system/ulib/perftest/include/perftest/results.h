@@ -31,6 +31,11 @@ struct SummaryStatistics {
   double mean;
   double std_dev;
   double median;
+  // Percentiles, interpolated in the same way as the median (which is the
+  // 50th percentile).  These show up tail latencies which the mean hides.
+  double p90;
+  double p99;
+  double p999;
 };
 
 // This represents the results for a particular test case.  It contains a
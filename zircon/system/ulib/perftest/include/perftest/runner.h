@@ -20,6 +20,9 @@ namespace internal {
 struct NamedTest {
   fbl::String name;
   fit::function<TestFunc> test_func;
+  // For multi-threaded tests, this is set instead of |test_func|.
+  fit::function<MultiThreadedTestFunc> multi_threaded_test_func{};
+  uint32_t thread_count = 1;
 };
 
 typedef fbl::Vector<NamedTest> TestList;
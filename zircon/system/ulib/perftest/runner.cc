@@ -18,9 +18,12 @@
 
 #include <algorithm>
 #include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <random>
+#include <thread>
 
 #include <fbl/string.h>
 #include <fbl/string_printf.h>
@@ -53,9 +56,33 @@ double GetDurationNanos(Timestamp t1, Timestamp t2) {
 // items have been added to the list, because that would clobber the list.
 internal::TestList* g_tests;
 
+// This is used by multi-threaded tests so that the threads start their
+// first test runs together rather than as each one finishes its setup.
+class StartBarrier {
+ public:
+  explicit StartBarrier(uint32_t thread_count) : thread_count_(thread_count) {}
+
+  // Blocks until Wait() has been called by |thread_count| threads.
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (++arrived_count_ == thread_count_) {
+      condvar_.notify_all();
+      return;
+    }
+    condvar_.wait(lock, [this] { return arrived_count_ == thread_count_; });
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable condvar_;
+  const uint32_t thread_count_;
+  uint32_t arrived_count_ = 0;
+};
+
 class RepeatStateImpl : public RepeatState {
  public:
-  explicit RepeatStateImpl(uint32_t run_count) : run_count_(run_count) {}
+  explicit RepeatStateImpl(uint32_t run_count, StartBarrier* start_barrier = nullptr)
+      : run_count_(run_count), start_barrier_(start_barrier) {}
 
   void SetBytesProcessedPerRun(uint64_t bytes) override {
     if (started_) {
@@ -121,6 +148,9 @@ class RepeatStateImpl : public RepeatState {
       next_idx_ = 1;
       end_of_run_idx_ = step_count_;
       started_ = true;
+      if (start_barrier_) {
+        start_barrier_->Wait();
+      }
       timestamps_[0] = Now();
       return run_count_ != 0;
     }
@@ -146,6 +176,10 @@ class RepeatStateImpl : public RepeatState {
     overall_start_time_ = Now();
     bool result = test_func(this);
     overall_end_time_ = Now();
+    if (start_barrier_ && !started_) {
+      // Don't leave the other threads waiting for this one to start.
+      start_barrier_->Wait();
+    }
     if (error_) {
       return error_;
     }
@@ -273,6 +307,8 @@ class RepeatStateImpl : public RepeatState {
 
   // Number of test runs that we intend to do.
   uint32_t run_count_;
+  // For multi-threaded tests, this is shared with the other threads.
+  StartBarrier* start_barrier_;
   // Number of steps per test run.  Once initialized, this is >= 1.
   uint32_t step_count_;
   // Names for steps.  May be empty if the test has only one step.
@@ -315,6 +351,16 @@ void RegisterTest(const char* name, fit::function<TestFunc> test_func) {
   g_tests->push_back(std::move(new_test));
 }
 
+void RegisterMultiThreadedTest(const char* name, uint32_t thread_count,
+                               fit::function<MultiThreadedTestFunc> test_func) {
+  ZX_ASSERT(thread_count > 0);
+  if (!g_tests) {
+    g_tests = new internal::TestList;
+  }
+  internal::NamedTest new_test{name, nullptr, std::move(test_func), thread_count};
+  g_tests->push_back(std::move(new_test));
+}
+
 bool RunTest(const char* test_suite, const char* test_name,
              const fit::function<TestFunc>& test_func, uint32_t run_count, ResultsSet* results_set,
              fbl::String* error_out) {
@@ -332,6 +378,78 @@ bool RunTest(const char* test_suite, const char* test_name,
   return true;
 }
 
+bool RunMultiThreadedTest(const char* test_suite, const char* test_name,
+                          const fit::function<MultiThreadedTestFunc>& test_func,
+                          uint32_t thread_count, uint32_t run_count, ResultsSet* results_set,
+                          fbl::String* error_out) {
+  StartBarrier start_barrier(thread_count);
+  fbl::Vector<std::unique_ptr<RepeatStateImpl>> states;
+  fbl::Vector<const char*> errors;
+  for (uint32_t i = 0; i < thread_count; ++i) {
+    states.push_back(std::make_unique<RepeatStateImpl>(run_count, &start_barrier));
+    errors.push_back(nullptr);
+  }
+
+  fbl::Vector<std::thread> threads;
+  for (uint32_t i = 0; i < thread_count; ++i) {
+    threads.push_back(std::thread([&, i] {
+      fit::function<TestFunc> thread_func = [&, i](RepeatState* state) {
+        return test_func(state, i);
+      };
+      errors[i] = states[i]->RunTestFunc(test_name, thread_func);
+      if (!errors[i]) {
+        // Trace events are attributed to the thread that writes them.
+        states[i]->WriteTraceEvents();
+      }
+    }));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (uint32_t i = 0; i < thread_count; ++i) {
+    if (errors[i]) {
+      if (error_out) {
+        *error_out = fbl::StringPrintf("Thread %u: %s", i, errors[i]);
+      }
+      return false;
+    }
+  }
+
+  // Gather each thread's results, then combine them so that there is one
+  // test case per step, as for a single-threaded test.
+  fbl::Vector<ResultsSet> thread_results;
+  for (uint32_t i = 0; i < thread_count; ++i) {
+    ResultsSet results;
+    states[i]->CopyTimeResults(test_suite, test_name, &results);
+    thread_results.push_back(std::move(results));
+  }
+  const fbl::Vector<TestCaseResults>& first = *thread_results[0].results();
+  for (auto& results : thread_results) {
+    bool same_steps = results.results()->size() == first.size();
+    for (size_t j = 0; same_steps && j < first.size(); ++j) {
+      same_steps = (*results.results())[j].label == first[j].label;
+    }
+    if (!same_steps) {
+      if (error_out) {
+        *error_out = "Threads of multi-threaded test declared different steps";
+      }
+      return false;
+    }
+  }
+  for (size_t j = 0; j < first.size(); ++j) {
+    TestCaseResults* dest = results_set->AddTestCase(test_suite, first[j].label, first[j].unit);
+    dest->bytes_processed_per_run = first[j].bytes_processed_per_run;
+    dest->values.reserve(static_cast<size_t>(run_count) * thread_count);
+    for (auto& results : thread_results) {
+      for (double value : (*results.results())[j].values) {
+        dest->AppendValue(value);
+      }
+    }
+  }
+  return true;
+}
+
 namespace internal {
 
 bool RunTests(const char* test_suite, TestList* test_list, uint32_t run_count,
@@ -386,8 +504,14 @@ bool RunTests(const char* test_suite, TestList* test_list, uint32_t run_count,
     }
 
     fbl::String error_string;
-    if (!RunTest(test_suite, test_name, test_case->test_func, run_count, results_set,
-                 &error_string)) {
+    bool passed = test_case->multi_threaded_test_func
+                      ? RunMultiThreadedTest(test_suite, test_name,
+                                             test_case->multi_threaded_test_func,
+                                             test_case->thread_count, run_count, results_set,
+                                             &error_string)
+                      : RunTest(test_suite, test_name, test_case->test_func, run_count,
+                                results_set, &error_string);
+    if (!passed) {
       fprintf(log_stream, "Error: %s\n", error_string.c_str());
       fprintf(log_stream, "[  FAILED  ] %s\n", test_name);
       fflush(log_stream);
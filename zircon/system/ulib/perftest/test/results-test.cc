@@ -61,6 +61,32 @@ TEST(PerfTestResults, TestSummaryStatistics) {
   EXPECT_EQ(stats.median, 110);
 }
 
+TEST(PerfTestResults, TestPercentiles) {
+  perftest::ResultsSet results;
+  perftest::TestCaseResults* test_case =
+      results.AddTestCase("results_test", "ExampleNullSyscall", "nanoseconds");
+  // Append the values 0 to 1000 in a non-sorted order.
+  for (int i = 1000; i >= 0; --i) {
+    test_case->AppendValue(i);
+  }
+
+  perftest::SummaryStatistics stats = test_case->GetSummaryStatistics();
+  EXPECT_EQ(stats.median, 500);
+  EXPECT_EQ(stats.p90, 900);
+  EXPECT_EQ(stats.p99, 990);
+  EXPECT_EQ(stats.p999, 999);
+
+  // With few values, the percentiles are interpolated between the largest
+  // two values.
+  test_case->values.reset();
+  test_case->AppendValue(10);
+  test_case->AppendValue(20);
+  stats = test_case->GetSummaryStatistics();
+  EXPECT_EQ(stats.median, 15);
+  EXPECT_EQ(stats.p90, 19);
+  EXPECT_EQ(stats.max, 20);
+}
+
 // Test escaping special characters in strings in JSON output.
 TEST(PerfTestResults, TestJsonStringEscaping) {
   char buf[1000];
@@ -5,6 +5,7 @@
 #include <zircon/assert.h>
 
 #include <algorithm>
+#include <atomic>
 #include <iterator>
 #include <string>
 #include <utility>
@@ -163,6 +164,66 @@ TEST(PerfTestRunner, TestMultistepTest) {
   }
 }
 
+// Example of a multi-threaded test which records which threads ran.
+static bool MultiThreadedTest(perftest::RepeatState* state, uint32_t thread_index,
+                              std::atomic<uint32_t>* threads_seen) {
+  state->DeclareStep("step1");
+  state->DeclareStep("step2");
+  threads_seen->fetch_or(1u << thread_index);
+  while (state->KeepRunning()) {
+    state->NextStep();
+  }
+  return true;
+}
+
+// Test that a multi-threaded test is run on each of its threads, and that
+// the times from all the threads are reported together.
+TEST(PerfTestRunner, TestMultiThreadedTest) {
+  const uint32_t kThreadCount = 3;
+  std::atomic<uint32_t> threads_seen = 0;
+  perftest::internal::TestList test_list;
+  perftest::internal::NamedTest test{"example_test", nullptr,
+                                     [&](perftest::RepeatState* state, uint32_t thread_index) {
+                                       return MultiThreadedTest(state, thread_index,
+                                                                &threads_seen);
+                                     },
+                                     kThreadCount};
+  test_list.push_back(std::move(test));
+
+  const uint32_t kRunCount = 7;
+  perftest::ResultsSet results;
+  DummyOutputStream out;
+  EXPECT_TRUE(
+      perftest::internal::RunTests("test-suite", &test_list, kRunCount, "", out.fp(), &results));
+  EXPECT_EQ(threads_seen.load(), (1u << kThreadCount) - 1);
+  ASSERT_EQ(results.results()->size(), 2);
+  EXPECT_STREQ((*results.results())[0].label.c_str(), "example_test.step1");
+  EXPECT_STREQ((*results.results())[1].label.c_str(), "example_test.step2");
+  for (auto& test_case : *results.results()) {
+    EXPECT_EQ(test_case.values.size(), kRunCount * kThreadCount);
+    EXPECT_TRUE(check_times(&test_case));
+  }
+}
+
+// Test that a multi-threaded test fails if any one of its threads fails,
+// including when that thread fails before starting its test runs.
+TEST(PerfTestRunner, TestMultiThreadedTestWithFailingThread) {
+  auto test_func = [](perftest::RepeatState* state, uint32_t thread_index) {
+    if (thread_index == 1) {
+      return false;
+    }
+    while (state->KeepRunning()) {
+    }
+    return true;
+  };
+  perftest::ResultsSet results;
+  fbl::String error;
+  EXPECT_FALSE(perftest::RunMultiThreadedTest("test-suite", "example_test", test_func, 2, 7,
+                                              &results, &error));
+  EXPECT_STREQ(error.c_str(), "Thread 1: Too few calls to KeepRunning()");
+  EXPECT_EQ(results.results()->size(), 0);
+}
+
 static bool MultistepTestWithDuplicateNames(perftest::RepeatState* state) {
   // These duplicate names should be caught as an error.
   state->DeclareStep("step1");
@@ -14,6 +14,7 @@
 #include <utility>
 
 #include <fbl/auto_lock.h>
+#include <fbl/intrusive_double_list.h>
 #include <fbl/intrusive_single_list.h>
 #include <fbl/intrusive_wavl_tree.h>
 #include <fbl/mutex.h>
@@ -143,6 +144,7 @@ class RegionAllocator {
   // simultaneously.
   struct SortByBaseTag {};
   struct SortBySizeTag {};
+  struct SizeClassTag {};
 
  public:
   static constexpr uint64_t kRegionPoolSlabSize = (4u << 10);
@@ -176,7 +178,8 @@ class RegionAllocator {
       : public ralloc_region_t,
         public fbl::SlabAllocated<RegionSlabTraits>,
         public fbl::ContainableBaseClasses<fbl::TaggedWAVLTreeContainable<Region*, SortByBaseTag>,
-                                           fbl::TaggedWAVLTreeContainable<Region*, SortBySizeTag>> {
+                                           fbl::TaggedWAVLTreeContainable<Region*, SortBySizeTag>,
+                                           fbl::TaggedDoublyLinkedListable<Region*, SizeClassTag>> {
    private:
     struct RegionDeleter;
 
@@ -228,6 +231,7 @@ class RegionAllocator {
         fbl::TaggedWAVLTree<uint64_t, Region*, SortByBaseTag, KeyTraitsSortByBase>;
     using WAVLTreeSortBySize =
         fbl::TaggedWAVLTree<ralloc_region_t, Region*, SortBySizeTag, KeyTraitsSortBySize>;
+    using SizeClassList = fbl::TaggedDoublyLinkedList<Region*, SizeClassTag>;
 
     // Used by SortByBase key traits
     uint64_t GetKey() const { return base; }
@@ -399,6 +403,23 @@ class RegionAllocator {
     return ret;
   }
 
+  // Get |count| regions which have a specified size and alignment out of the
+  // set of currently available regions, acquiring the allocation lock only
+  // once.  The allocation is all or nothing; either every entry of
+  // |out_regions| holds a region, or none of them do and the regions which
+  // had already been allocated are returned to the set of available regions.
+  //
+  // Possible return values are the same as those of GetRegion(size,
+  // alignment, out_region).
+  zx_status_t GetRegions(uint64_t size, uint64_t alignment, size_t count,
+                         Region::UPtr* out_regions) __TA_EXCLUDES(alloc_lock_);
+
+  // Return |count| regions to the set of available regions, acquiring the
+  // allocation lock only once.  Every region must have been allocated from
+  // this allocator.  Null entries are skipped, and every entry is null when
+  // this returns.
+  void ReleaseRegions(Region::UPtr* regions, size_t count) __TA_EXCLUDES(alloc_lock_);
+
   // Returns true if |region| intersects any of the regions in either the set of
   // currently allocated regions, or currently available regions.
   //
@@ -476,9 +497,24 @@ class RegionAllocator {
   }
 
  private:
+  // Available regions whose size is a power of two smaller than
+  // 2^kNumSizeClasses, and whose base is aligned to their size, are also kept
+  // on the free list of their size class.  Allocations of such a size with no
+  // more than that alignment are then satisfied by an exact fit without
+  // searching, no matter how many misaligned regions of the same size there
+  // are, and without any bookkeeping allocation since no split is needed.
+  static constexpr size_t kNumSizeClasses = 32;
+
+  // Returns the size class of a region at |base| of |size|, or kNumSizeClasses
+  // if it does not belong to any.
+  static size_t SizeClassOf(uint64_t base, uint64_t size);
+
   zx_status_t AddSubtractSanityCheckLocked(const ralloc_region_t& region)
       __TA_REQUIRES(alloc_lock_);
+  zx_status_t GetRegionLocked(uint64_t size, uint64_t alignment, Region::UPtr& out_region)
+      __TA_REQUIRES(alloc_lock_);
   void ReleaseRegion(Region* region) __TA_EXCLUDES(alloc_lock_);
+  void ReleaseRegionLocked(Region* region) __TA_REQUIRES(alloc_lock_);
   void AddRegionToAvailLocked(Region* region, AllowOverlap allow_overlap = AllowOverlap::No)
       __TA_REQUIRES(alloc_lock_);
 
@@ -494,6 +530,12 @@ class RegionAllocator {
   bool ContainedByLocked(const Region::WAVLTreeSortByBase& tree,
                          const ralloc_region_t& region) const __TA_REQUIRES(alloc_lock_);
 
+  // Add |region| to, or remove it from, the available regions sorted by size as
+  // well as the free list of its size class.  Every change to the size or base
+  // of an available region must happen between the two.
+  void InsertAvailBySizeLocked(Region* region) __TA_REQUIRES(alloc_lock_);
+  Region* EraseAvailBySizeLocked(Region& region) __TA_REQUIRES(alloc_lock_);
+
   // Create a region by allocating it from the current RegionPool, or from the
   // heap if we have no assigned region pool.
   Region* CreateRegion() __TA_REQUIRES(alloc_lock_);
@@ -506,7 +548,7 @@ class RegionAllocator {
    *
    * alloc_lock_ protects all of the bookkeeping members of the
    * RegionAllocator.  This includes the allocated index, the available
-   * indices (by base and by size) and the region pool.
+   * indices (by base, by size and by size class) and the region pool.
    *
    * The alloc_lock_ may be held while calling into a RegionAllocator's
    * assigned RegionPool, but code from the RegionPool will never call into
@@ -516,6 +558,7 @@ class RegionAllocator {
   Region::WAVLTreeSortByBase allocated_regions_by_base_ __TA_GUARDED(alloc_lock_);
   Region::WAVLTreeSortByBase avail_regions_by_base_ __TA_GUARDED(alloc_lock_);
   Region::WAVLTreeSortBySize avail_regions_by_size_ __TA_GUARDED(alloc_lock_);
+  Region::SizeClassList avail_regions_by_size_class_[kNumSizeClasses] __TA_GUARDED(alloc_lock_);
   RegionPool::RefPtr region_pool_ __TA_GUARDED(alloc_lock_);
 };
 
@@ -37,6 +37,9 @@ RegionAllocator::~RegionAllocator() {
 
   // Return all of our bookkeeping to our region pool.
   avail_regions_by_base_.clear();
+  for (auto& list : avail_regions_by_size_class_) {
+    list.clear();
+  }
   while (!avail_regions_by_size_.is_empty()) {
     DestroyRegion(avail_regions_by_size_.pop_front());
   }
@@ -47,7 +50,7 @@ void RegionAllocator::Reset() {
 
   Region* removed;
   while ((removed = avail_regions_by_base_.pop_front()) != nullptr) {
-    avail_regions_by_size_.erase(*removed);
+    EraseAvailBySizeLocked(*removed);
     DestroyRegion(removed);
   }
 
@@ -132,7 +135,7 @@ zx_status_t RegionAllocator::SubtractRegion(const ralloc_region_t& to_subtract,
       // Case 1: The regions are the same.  This one is easy.
       if ((region.base == before->base) && (region_end == before_end)) {
         Region* removed = avail_regions_by_base_.erase(before);
-        avail_regions_by_size_.erase(*removed);
+        EraseAvailBySizeLocked(*removed);
         DestroyRegion(removed);
         return ZX_OK;
       }
@@ -150,14 +153,14 @@ zx_status_t RegionAllocator::SubtractRegion(const ralloc_region_t& to_subtract,
         // the two regions which will be left over, then update the first
         // region's position in the size index, and add the second region to
         // the set of available regions.
-        Region* first = avail_regions_by_size_.erase(*before);
+        Region* first = EraseAvailBySizeLocked(*before);
         first->size = region.base - first->base;
         second->base = region_end;
         second->size = before_end - region_end;
 
-        avail_regions_by_size_.insert(first);
+        InsertAvailBySizeLocked(first);
         avail_regions_by_base_.insert(second);
-        avail_regions_by_size_.insert(second);
+        InsertAvailBySizeLocked(second);
         return ZX_OK;
       }
 
@@ -168,10 +171,10 @@ zx_status_t RegionAllocator::SubtractRegion(const ralloc_region_t& to_subtract,
       if (region.base == before->base) {
         ZX_DEBUG_ASSERT(region_end < before_end);
 
-        Region* bptr = avail_regions_by_size_.erase(*before);
+        Region* bptr = EraseAvailBySizeLocked(*before);
         bptr->base += region.size;
         bptr->size -= region.size;
-        avail_regions_by_size_.insert(bptr);
+        InsertAvailBySizeLocked(bptr);
 
         return ZX_OK;
       }
@@ -181,9 +184,9 @@ zx_status_t RegionAllocator::SubtractRegion(const ralloc_region_t& to_subtract,
       ZX_DEBUG_ASSERT(region.base != before->base);
       ZX_DEBUG_ASSERT(region_end == before_end);
 
-      Region* bptr = avail_regions_by_size_.erase(*before);
+      Region* bptr = EraseAvailBySizeLocked(*before);
       bptr->size -= region.size;
-      avail_regions_by_size_.insert(bptr);
+      InsertAvailBySizeLocked(bptr);
 
       return ZX_OK;
     }
@@ -208,7 +211,7 @@ zx_status_t RegionAllocator::SubtractRegion(const ralloc_region_t& to_subtract,
     ZX_DEBUG_ASSERT(region_end > before_end);
     if (before_end > region.base) {
       // No matter what, 'before' needs to be removed from the size index.
-      Region* bptr = avail_regions_by_size_.erase(*before);
+      Region* bptr = EraseAvailBySizeLocked(*before);
 
       // If before's base is the same as the region's base, then we are
       // subtracting out all of before.  Otherwise, we are trimming the back
@@ -218,7 +221,7 @@ zx_status_t RegionAllocator::SubtractRegion(const ralloc_region_t& to_subtract,
         DestroyRegion(bptr);
       } else {
         bptr->size = region.base - bptr->base;
-        avail_regions_by_size_.insert(bptr);
+        InsertAvailBySizeLocked(bptr);
       }
 
       // Either way, the region we are subtracting now starts where before
@@ -249,14 +252,14 @@ zx_status_t RegionAllocator::SubtractRegion(const ralloc_region_t& to_subtract,
     // 1) Advance after, re-naming the old 'after' to 'trim in the process.
     // 2) Remove trim from the size index.
     auto trim_iter = after++;
-    Region* trim = avail_regions_by_size_.erase(*trim_iter);
+    Region* trim = EraseAvailBySizeLocked(*trim_iter);
     uint64_t trim_end = trim->base + trim->size;
 
     if (trim_end > region_end) {
       // Case #2.  We are guaranteed to be done at this point.
       trim->base = region_end;
       trim->size = trim_end - trim->base;
-      avail_regions_by_size_.insert(trim);
+      InsertAvailBySizeLocked(trim);
       break;
     }
 
@@ -282,13 +285,63 @@ zx_status_t RegionAllocator::SubtractRegion(const ralloc_region_t& to_subtract,
 zx_status_t RegionAllocator::GetRegion(uint64_t size, uint64_t alignment,
                                        Region::UPtr& out_region) {
   fbl::AutoLock alloc_lock(&alloc_lock_);
+  out_region = nullptr;
+  return GetRegionLocked(size, alignment, out_region);
+}
+
+zx_status_t RegionAllocator::GetRegions(uint64_t size, uint64_t alignment, size_t count,
+                                        Region::UPtr* out_regions) {
+  fbl::AutoLock alloc_lock(&alloc_lock_);
+
+  for (size_t i = 0; i < count; ++i) {
+    out_regions[i] = nullptr;
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    zx_status_t res = GetRegionLocked(size, alignment, out_regions[i]);
+    if (res != ZX_OK) {
+      // Give back everything we got so far.  We cannot simply reset the
+      // pointers; their deleter would try to acquire the lock we are holding.
+      for (size_t j = 0; j < i; ++j) {
+        ReleaseRegionLocked(const_cast<Region*>(out_regions[j].release()));
+      }
+      return res;
+    }
+  }
+
+  return ZX_OK;
+}
+
+void RegionAllocator::ReleaseRegions(Region::UPtr* regions, size_t count) {
+  fbl::AutoLock alloc_lock(&alloc_lock_);
+
+  for (size_t i = 0; i < count; ++i) {
+    if (regions[i] != nullptr) {
+      ZX_DEBUG_ASSERT(regions[i]->owner_ == this);
+      ReleaseRegionLocked(const_cast<Region*>(regions[i].release()));
+    }
+  }
+}
 
+zx_status_t RegionAllocator::GetRegionLocked(uint64_t size, uint64_t alignment,
+                                             Region::UPtr& out_region) {
   // Sanity check the arguments.
-  out_region = nullptr;
+  ZX_DEBUG_ASSERT(out_region == nullptr);
   if (!size || !alignment || !cpp20::has_single_bit(alignment)) {
     return ZX_ERR_INVALID_ARGS;
   }
 
+  // If there is an available region of exactly this size which is naturally
+  // aligned, it is both the best fit and aligned well enough.  Take it without
+  // searching.
+  const size_t size_class = SizeClassOf(0, size);
+  if ((size_class < kNumSizeClasses) && (alignment <= size) &&
+      !avail_regions_by_size_class_[size_class].is_empty()) {
+    Region& region = avail_regions_by_size_class_[size_class].front();
+    return AllocFromAvailLocked(avail_regions_by_size_.make_iterator(region), out_region,
+                                region.base, size);
+  }
+
   // Compute the things we will need round-up align base addresses.
   uint64_t mask = alignment - 1;
   uint64_t inv_mask = ~mask;
@@ -393,7 +446,10 @@ zx_status_t RegionAllocator::AddSubtractSanityCheckLocked(const ralloc_region_t&
 
 void RegionAllocator::ReleaseRegion(Region* region) {
   fbl::AutoLock alloc_lock(&alloc_lock_);
+  ReleaseRegionLocked(region);
+}
 
+void RegionAllocator::ReleaseRegionLocked(Region* region) {
   ZX_DEBUG_ASSERT(region != nullptr);
 
   // When a region comes back from a user, it should be in the
@@ -432,7 +488,7 @@ zx_status_t RegionAllocator::AllocFromAvailLocked(Region::WAVLTreeSortBySize::it
     // If no splits are required, then this should be easy.  Take the region
     // out of the avail bookkeeping, add it to the allocated bookkeeping and
     // we are finished.
-    Region* region = avail_regions_by_size_.erase(source);
+    Region* region = EraseAvailBySizeLocked(*source);
     avail_regions_by_base_.erase(*region);
     allocated_regions_by_base_.insert(region);
     out_region.reset(region);
@@ -445,14 +501,14 @@ zx_status_t RegionAllocator::AllocFromAvailLocked(Region::WAVLTreeSortBySize::it
       return ZX_ERR_NO_MEMORY;
     }
 
-    Region* after_region = avail_regions_by_size_.erase(source);
+    Region* after_region = EraseAvailBySizeLocked(*source);
 
     before_region->base = after_region->base;
     before_region->size = size;
     after_region->base += size;
     after_region->size -= size;
 
-    avail_regions_by_size_.insert(after_region);
+    InsertAvailBySizeLocked(after_region);
     allocated_regions_by_base_.insert(before_region);
 
     out_region.reset(before_region);
@@ -466,13 +522,13 @@ zx_status_t RegionAllocator::AllocFromAvailLocked(Region::WAVLTreeSortBySize::it
       return ZX_ERR_NO_MEMORY;
     }
 
-    Region* before_region = avail_regions_by_size_.erase(source);
+    Region* before_region = EraseAvailBySizeLocked(*source);
 
     after_region->base = base;
     after_region->size = size;
     before_region->size -= size;
 
-    avail_regions_by_size_.insert(before_region);
+    InsertAvailBySizeLocked(before_region);
     allocated_regions_by_base_.insert(after_region);
 
     out_region.reset(after_region);
@@ -490,7 +546,7 @@ zx_status_t RegionAllocator::AllocFromAvailLocked(Region::WAVLTreeSortBySize::it
       return ZX_ERR_NO_MEMORY;
     }
 
-    Region* before_region = avail_regions_by_size_.erase(source);
+    Region* before_region = EraseAvailBySizeLocked(*source);
 
     region->base = before_region->base + overhead;
     region->size = size;
@@ -498,8 +554,8 @@ zx_status_t RegionAllocator::AllocFromAvailLocked(Region::WAVLTreeSortBySize::it
     after_region->size = before_region->size - size - overhead;
     before_region->size = overhead;
 
-    avail_regions_by_size_.insert(before_region);
-    avail_regions_by_size_.insert(after_region);
+    InsertAvailBySizeLocked(before_region);
+    InsertAvailBySizeLocked(after_region);
     avail_regions_by_base_.insert(after_region);
     allocated_regions_by_base_.insert(region);
 
@@ -513,6 +569,7 @@ void RegionAllocator::AddRegionToAvailLocked(Region* region, AllowOverlap allow_
   // should not overlap with any of the regions we are currently tracking.
   ZX_DEBUG_ASSERT(!fbl::InContainer<SortByBaseTag>(*region));
   ZX_DEBUG_ASSERT(!fbl::InContainer<SortBySizeTag>(*region));
+  ZX_DEBUG_ASSERT(!fbl::InContainer<SizeClassTag>(*region));
   ZX_DEBUG_ASSERT(!IntersectsLocked(allocated_regions_by_base_, *region));
   ZX_DEBUG_ASSERT((allow_overlap == AllowOverlap::Yes) ||
                   !IntersectsLocked(avail_regions_by_base_, *region));
@@ -534,7 +591,7 @@ void RegionAllocator::AddRegionToAvailLocked(Region* region, AllowOverlap allow_
       region->base = before->base;
 
       auto removed = avail_regions_by_base_.erase(before);
-      avail_regions_by_size_.erase(*removed);
+      EraseAvailBySizeLocked(*removed);
       DestroyRegion(removed);
     }
   }
@@ -554,7 +611,7 @@ void RegionAllocator::AddRegionToAvailLocked(Region* region, AllowOverlap allow_
 
     auto remove_me = after++;
     auto removed = avail_regions_by_base_.erase(remove_me);
-    avail_regions_by_size_.erase(*removed);
+    EraseAvailBySizeLocked(*removed);
     DestroyRegion(removed);
 
     if (allow_overlap != AllowOverlap::Yes) {
@@ -566,7 +623,7 @@ void RegionAllocator::AddRegionToAvailLocked(Region* region, AllowOverlap allow_
   // place, then add the region to the two indexes.
   region->size = region_end - region->base;
   avail_regions_by_base_.insert(region);
-  avail_regions_by_size_.insert(region);
+  InsertAvailBySizeLocked(region);
 }
 
 bool RegionAllocator::IntersectsLocked(const Region::WAVLTreeSortByBase& tree,
@@ -612,6 +669,28 @@ bool RegionAllocator::ContainedByLocked(const Region::WAVLTreeSortByBase& tree,
   return false;
 }
 
+size_t RegionAllocator::SizeClassOf(uint64_t base, uint64_t size) {
+  if (!cpp20::has_single_bit(size) || (base & (size - 1))) {
+    return kNumSizeClasses;
+  }
+  return std::min<size_t>(cpp20::countr_zero(size), kNumSizeClasses);
+}
+
+void RegionAllocator::InsertAvailBySizeLocked(Region* region) {
+  avail_regions_by_size_.insert(region);
+  if (const size_t size_class = SizeClassOf(region->base, region->size);
+      size_class < kNumSizeClasses) {
+    avail_regions_by_size_class_[size_class].push_front(region);
+  }
+}
+
+RegionAllocator::Region* RegionAllocator::EraseAvailBySizeLocked(Region& region) {
+  if (fbl::InContainer<SizeClassTag>(region)) {
+    avail_regions_by_size_class_[SizeClassOf(region.base, region.size)].erase(region);
+  }
+  return avail_regions_by_size_.erase(region);
+}
+
 RegionAllocator::Region* RegionAllocator::CreateRegion() {
   if (region_pool_ != nullptr) {
     return region_pool_->New(this);
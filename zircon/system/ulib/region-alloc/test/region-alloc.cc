@@ -186,6 +186,112 @@ TEST(RegionAllocCppApiTestCase, AllocBySizeFromHeap) {
   ASSERT_NO_FAILURES(AllocBySizeHelper(TestFlavor::UseHeap));
 }
 
+void SizeClassHelper(TestFlavor flavor) {
+  RegionAllocator alloc((flavor == TestFlavor::UsePool)
+                            ? RegionAllocator::RegionPool::Create(REGION_POOL_MAX_SIZE)
+                            : nullptr);
+
+  // Add a number of page sized regions which are not page aligned, followed by
+  // a single page aligned one and a large region.
+  constexpr uint64_t kPageSize = 0x1000;
+  constexpr size_t kMisalignedCount = 16;
+  for (size_t i = 0; i < kMisalignedCount; ++i) {
+    ASSERT_OK(alloc.AddRegion({.base = (i * 0x10000) + 0x800, .size = kPageSize}));
+  }
+  ASSERT_OK(alloc.AddRegion({.base = 0x200000, .size = kPageSize}));
+  ASSERT_OK(alloc.AddRegion({.base = 0x400000, .size = 0x100000}));
+  ASSERT_EQ(kMisalignedCount + 2, alloc.AvailableRegionCount());
+
+  // A page aligned page is an exact fit for the aligned region, which is used
+  // whole.
+  RegionAllocator::Region::UPtr exact;
+  ASSERT_OK(alloc.GetRegion(kPageSize, kPageSize, exact));
+  EXPECT_EQ(0x200000u, exact->base);
+  EXPECT_EQ(kPageSize, exact->size);
+  EXPECT_EQ(kMisalignedCount + 1, alloc.AvailableRegionCount());
+
+  // No exact fit is left, so the next one is carved out of the large region.
+  RegionAllocator::Region::UPtr carved;
+  ASSERT_OK(alloc.GetRegion(kPageSize, kPageSize, carved));
+  EXPECT_EQ(0x400000u, carved->base);
+
+  // Without an aligned exact fit, a misaligned one is found by searching the
+  // size index when the alignment allows it.
+  RegionAllocator::Region::UPtr misaligned;
+  ASSERT_OK(alloc.GetRegion(kPageSize, 0x800, misaligned));
+  EXPECT_EQ(0x800u, misaligned->base);
+
+  // Once the exact fit is given back, it can be found again.
+  exact.reset();
+  ASSERT_OK(alloc.GetRegion(kPageSize, kPageSize, exact));
+  EXPECT_EQ(0x200000u, exact->base);
+}
+
+TEST(RegionAllocCppApiTestCase, SizeClassFromPool) {
+  ASSERT_NO_FAILURES(SizeClassHelper(TestFlavor::UsePool));
+}
+
+TEST(RegionAllocCppApiTestCase, SizeClassFromHeap) {
+  ASSERT_NO_FAILURES(SizeClassHelper(TestFlavor::UseHeap));
+}
+
+void BulkHelper(TestFlavor flavor) {
+  RegionAllocator alloc((flavor == TestFlavor::UsePool)
+                            ? RegionAllocator::RegionPool::Create(REGION_POOL_MAX_SIZE)
+                            : nullptr);
+
+  constexpr uint64_t kPageSize = 0x1000;
+  constexpr size_t kCount = 32;
+  ASSERT_OK(alloc.AddRegion({.base = 0x10000000, .size = kCount * kPageSize}));
+
+  // Allocate the whole region one page at a time.
+  RegionAllocator::Region::UPtr regions[kCount];
+  ASSERT_OK(alloc.GetRegions(kPageSize, kPageSize, kCount, regions));
+  for (size_t i = 0; i < kCount; ++i) {
+    ASSERT_NOT_NULL(regions[i].get());
+    EXPECT_EQ(kPageSize, regions[i]->size);
+    EXPECT_EQ(0u, regions[i]->base & (kPageSize - 1));
+  }
+  EXPECT_EQ(kCount, alloc.AllocatedRegionCount());
+  EXPECT_EQ(0u, alloc.AvailableRegionCount());
+
+  RegionAllocator::Region::UPtr extra;
+  EXPECT_EQ(ZX_ERR_NOT_FOUND, alloc.GetRegions(kPageSize, kPageSize, 1, &extra));
+  EXPECT_NULL(extra.get());
+
+  // Give back the first half, then ask for one region more than is available.
+  // Nothing is allocated, and the available space merges back together.
+  alloc.ReleaseRegions(regions, kCount / 2);
+  for (size_t i = 0; i < kCount / 2; ++i) {
+    EXPECT_NULL(regions[i].get());
+  }
+  EXPECT_EQ(kCount / 2, alloc.AllocatedRegionCount());
+  EXPECT_EQ(1u, alloc.AvailableRegionCount());
+
+  RegionAllocator::Region::UPtr more[kCount / 2 + 1];
+  EXPECT_EQ(ZX_ERR_NOT_FOUND, alloc.GetRegions(kPageSize, kPageSize, std::size(more), more));
+  for (const auto& region : more) {
+    EXPECT_NULL(region.get());
+  }
+  EXPECT_EQ(kCount / 2, alloc.AllocatedRegionCount());
+  EXPECT_EQ(1u, alloc.AvailableRegionCount());
+
+  // Null entries are skipped when releasing.
+  alloc.ReleaseRegions(regions, kCount);
+  EXPECT_EQ(0u, alloc.AllocatedRegionCount());
+  EXPECT_EQ(1u, alloc.AvailableRegionCount());
+
+  EXPECT_EQ(ZX_ERR_INVALID_ARGS, alloc.GetRegions(0, kPageSize, 1, &extra));
+}
+
+TEST(RegionAllocCppApiTestCase, BulkFromPool) {
+  ASSERT_NO_FAILURES(BulkHelper(TestFlavor::UsePool));
+}
+
+TEST(RegionAllocCppApiTestCase, BulkFromHeap) {
+  ASSERT_NO_FAILURES(BulkHelper(TestFlavor::UseHeap));
+}
+
 void AllocSpecificHelper(TestFlavor flavor) {
   // Make an allocator.  If we are not using the heap for bookkeeping, then make
   // a pool and attach it to the allocator.
@@ -30,6 +30,19 @@ struct condition_impl_internal::MutexOps<sync_mutex_t> {
     sync_completion_signal_requeue(completion, &mutex->futex,
                                    libsync_mutex_make_owner_from_state(mutex_val));
   }
+
+  static bool signal_requeue_if_owned(sync_completion_t* completion, sync_mutex_t* mutex) {
+    zx_futex_storage_t mutex_val = __atomic_load_n(&mutex->futex, __ATOMIC_RELAXED);
+    if (libsync_mutex_make_owner_from_state(mutex_val) != _zx_thread_self()) {
+      return false;
+    }
+    // While we hold the mutex, other threads can only mark it contested, so a
+    // plain store cannot lose an update.  The unlock will then wake the
+    // requeued waiter.
+    __atomic_store_n(&mutex->futex, libsync_mutex_make_contested(mutex_val), __ATOMIC_RELAXED);
+    sync_completion_signal_requeue(completion, &mutex->futex, _zx_thread_self());
+    return true;
+  }
 };
 
 void sync_condition_wait(sync_condition_t* condition, sync_mutex_t* mutex) {
@@ -42,6 +42,12 @@ struct MutexOps {
 
   // Requeue all of the memebrs waiting in |completion| to the futex backing |mutex|.
   static void signal_requeue(sync_completion_t* completion, Mutex* mutex);
+
+  // If the calling thread holds |mutex|, mark it as having waiters, requeue
+  // the members waiting in |completion| to the futex backing |mutex| as
+  // signal_requeue() does, and return true. Otherwise, return false without
+  // signaling |completion|.
+  static bool signal_requeue_if_owned(sync_completion_t* completion, Mutex* mutex);
 };
 
 // Note that this library is used by libc, and as such needs to use
@@ -88,6 +94,10 @@ struct Waiter {
   int state = WAITING;
   sync_completion_t ready;
   int* notify = nullptr;
+  // The mutex this waiter will reacquire, and MutexOps::signal_requeue_if_owned()
+  // for its type.
+  void* mutex = nullptr;
+  bool (*signal_requeue_if_owned)(sync_completion_t* completion, void* mutex) = nullptr;
 };
 
 // Return value:
@@ -102,6 +112,10 @@ static inline zx_status_t timedwait(Condition* c, Mutex* mutex, zx_time_t deadli
   sync_mutex_lock(reinterpret_cast<sync_mutex_t*>(&c->lock));
 
   Waiter node;
+  node.mutex = mutex;
+  node.signal_requeue_if_owned = [](sync_completion_t* completion, void* mutex) {
+    return MutexOps<Mutex>::signal_requeue_if_owned(completion, static_cast<Mutex*>(mutex));
+  };
 
   // Add our waiter node onto the condition's list.  We add the node to the
   // head of the list, but this is logically the end of the queue.
@@ -283,8 +297,11 @@ static inline void signal(Condition* c, int n) {
     wait(&ref, cur);
   }
 
-  // Allow first signaled waiter, if any, to proceed.
-  if (first) {
+  // Allow first signaled waiter, if any, to proceed.  When the signaling
+  // thread holds the mutex, as it usually does, waking the waiter would only
+  // see it block again on the mutex.  Requeue it to the mutex instead, so that
+  // it lends its priority to this thread and is woken by our unlock.
+  if (first && !first->signal_requeue_if_owned(&first->ready, first->mutex)) {
     sync_completion_signal(&first->ready);
   }
 }
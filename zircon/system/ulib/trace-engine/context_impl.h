@@ -177,6 +177,10 @@ struct trace_context {
   // We round this up to 1MB.
   static constexpr size_t kMaxDurableBufferSize = 1024 * 1024;
 
+  // Used to keep the allocation pointer apart from the fields that are only
+  // read while tracing.
+  static constexpr size_t kCacheLineSize = 64;
+
   // Given a buffer of size |SIZE| in bytes, not including the header,
   // return how much to use for the durable buffer. This is further adjusted
   // to be at most |kMaxDurableBufferSize|, and to account for rolling
@@ -309,12 +313,17 @@ struct trace_context {
   //
   // This value is also used for durable records in oneshot mode: in
   // oneshot mode durable and non-durable records share the same buffer.
-  std::atomic<uint64_t> rolling_buffer_current_;
+  //
+  // Every record allocation writes this, from every tracing thread, so it
+  // gets a cache line to itself. Otherwise each allocation would also evict
+  // the read-only buffer pointers and sizes above from the other threads'
+  // caches.
+  alignas(kCacheLineSize) std::atomic<uint64_t> rolling_buffer_current_;
 
   // Offset beyond the last successful allocation, or zero if not full.
   // Only ever set to non-zero once when the buffer fills.
   // This will only be set in oneshot and streaming modes.
-  std::atomic<uint64_t> rolling_buffer_full_mark_[2];
+  alignas(kCacheLineSize) std::atomic<uint64_t> rolling_buffer_full_mark_[2];
 
   // A count of the number of records that have been dropped.
   std::atomic<uint64_t> num_records_dropped_{0};
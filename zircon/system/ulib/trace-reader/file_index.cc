@@ -0,0 +1,246 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <lib/trace-engine/fields.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+#include <utility>
+
+#include <trace-reader/file_index.h>
+
+namespace trace {
+namespace {
+
+constexpr size_t kHeaderWords = BytesToWords(sizeof(FileIndex::Header));
+constexpr size_t kRangeWords = BytesToWords(sizeof(FileIndex::Range));
+static_assert(WordsToBytes(kHeaderWords) == sizeof(FileIndex::Header));
+static_assert(WordsToBytes(kRangeWords) == sizeof(FileIndex::Range));
+
+// Large enough for the largest record, large records included.
+constexpr size_t kReadBufferWords = BytesToWords(TRACE_ENCODED_INLINE_LARGE_RECORD_MAX_SIZE);
+
+bool IsStateRecord(RecordType type) {
+  switch (type) {
+    case RecordType::kMetadata:
+    case RecordType::kInitialization:
+    case RecordType::kString:
+    case RecordType::kThread:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Everything which identifies a range but its offsets: bucket, provider, process and thread.
+using RangeKey = std::tuple<uint64_t, uint64_t, zx_koid_t, zx_koid_t>;
+
+}  // namespace
+
+// static
+bool FileIndex::Build(const char* file_path, trace_ticks_t bucket_ticks,
+                      TraceReader::ErrorHandler error_handler,
+                      std::unique_ptr<FileIndex>* out_index) {
+  ZX_DEBUG_ASSERT(out_index != nullptr);
+  ZX_DEBUG_ASSERT(bucket_ticks > 0);
+
+  FILE* file = fopen(file_path, "rb");
+  if (file == nullptr) {
+    return false;
+  }
+
+  std::vector<uint64_t> state_record_offsets;
+  std::map<RangeKey, std::pair<uint64_t, uint64_t>> ranges;
+  // The bounds of the record being read.
+  uint64_t record_begin = 0u;
+  uint64_t record_end = 0u;
+  const TraceReader* reader_ptr = nullptr;
+  TraceReader reader(
+      [&](Record record) {
+        trace_ticks_t timestamp;
+        ProcessThread process_thread;
+        switch (record.type()) {
+          case RecordType::kEvent:
+            timestamp = record.GetEvent().timestamp;
+            process_thread = record.GetEvent().process_thread;
+            break;
+          case RecordType::kLog:
+            timestamp = record.GetLog().timestamp;
+            process_thread = record.GetLog().process_thread;
+            break;
+          case RecordType::kLargeRecord: {
+            const LargeRecordData::Blob& blob = record.GetLargeRecord().GetBlob();
+            if (!cpp17::holds_alternative<LargeRecordData::BlobEvent>(blob)) {
+              return;
+            }
+            const auto& blob_event = cpp17::get<LargeRecordData::BlobEvent>(blob);
+            timestamp = blob_event.timestamp;
+            process_thread = blob_event.process_thread;
+            break;
+          }
+          default:
+            return;
+        }
+        RangeKey key{timestamp / bucket_ticks, reader_ptr->current_provider_id(),
+                     process_thread.process_koid(), process_thread.thread_koid()};
+        auto [it, inserted] = ranges.try_emplace(key, record_begin, record_end);
+        if (!inserted) {
+          it->second.second = record_end;
+        }
+      },
+      std::move(error_handler));
+  reader_ptr = &reader;
+
+  // Records are handed to the reader one at a time so that the bounds of each are known.
+  std::unique_ptr<uint64_t[]> buffer(new uint64_t[kReadBufferWords]);
+  size_t buffer_end = 0u;
+  uint64_t buffer_offset = 0u;
+  bool corrupt = false;
+  for (;;) {
+    const size_t actual =
+        fread(buffer.get() + buffer_end, sizeof(uint64_t), kReadBufferWords - buffer_end, file);
+    buffer_end += actual;
+
+    size_t position = 0u;
+    while (position < buffer_end) {
+      const RecordHeader header = buffer[position];
+      const size_t size = RecordSizeWords(header);
+      if (size == 0 || size > kReadBufferWords) {
+        corrupt = true;
+        break;
+      }
+      if (position + size > buffer_end) {
+        break;  // need more data
+      }
+      record_begin = buffer_offset + WordsToBytes(position);
+      record_end = record_begin + WordsToBytes(size);
+      if (IsStateRecord(RecordFields::Type::Get<RecordType>(header))) {
+        state_record_offsets.push_back(record_begin);
+      }
+      Chunk chunk(buffer.get() + position, size);
+      if (!reader.ReadRecords(chunk)) {
+        corrupt = true;
+        break;
+      }
+      position += size;
+    }
+    if (corrupt) {
+      break;
+    }
+
+    memmove(buffer.get(), buffer.get() + position, WordsToBytes(buffer_end - position));
+    buffer_end -= position;
+    buffer_offset += WordsToBytes(position);
+    if (actual == 0) {
+      break;
+    }
+  }
+  fclose(file);
+
+  if (corrupt || buffer_end != 0) {
+    reader.error_handler()("Trace stream is corrupted");
+    return false;
+  }
+
+  std::unique_ptr<FileIndex> index(new FileIndex());
+  index->storage_.reserve(kHeaderWords + state_record_offsets.size() +
+                          ranges.size() * kRangeWords);
+  index->storage_.resize(kHeaderWords);
+  Header* header = reinterpret_cast<Header*>(index->storage_.data());
+  header->magic = kMagic;
+  header->version = kVersion;
+  header->bucket_ticks = bucket_ticks;
+  header->state_record_count = state_record_offsets.size();
+  header->range_count = ranges.size();
+  index->storage_.insert(index->storage_.end(), state_record_offsets.begin(),
+                         state_record_offsets.end());
+  for (const auto& [key, offsets] : ranges) {
+    const Range range{
+        .bucket = std::get<0>(key),
+        .provider_id = std::get<1>(key),
+        .process_koid = std::get<2>(key),
+        .thread_koid = std::get<3>(key),
+        .begin_offset = offsets.first,
+        .end_offset = offsets.second,
+    };
+    const auto* words = reinterpret_cast<const uint64_t*>(&range);
+    index->storage_.insert(index->storage_.end(), words, words + kRangeWords);
+  }
+
+  if (!index->Init(index->storage_)) {
+    return false;
+  }
+  *out_index = std::move(index);
+  return true;
+}
+
+// static
+bool FileIndex::Create(const void* data, size_t size, std::unique_ptr<FileIndex>* out_index) {
+  ZX_DEBUG_ASSERT(out_index != nullptr);
+
+  if (reinterpret_cast<uintptr_t>(data) % sizeof(uint64_t) != 0 || size % sizeof(uint64_t) != 0) {
+    return false;
+  }
+  std::unique_ptr<FileIndex> index(new FileIndex());
+  if (!index->Init({static_cast<const uint64_t*>(data), size / sizeof(uint64_t)})) {
+    return false;
+  }
+  *out_index = std::move(index);
+  return true;
+}
+
+bool FileIndex::Init(cpp20::span<const uint64_t> words) {
+  if (words.size() < kHeaderWords) {
+    return false;
+  }
+  const auto& header = *reinterpret_cast<const Header*>(words.data());
+  if (header.magic != kMagic || header.version != kVersion || header.bucket_ticks == 0) {
+    return false;
+  }
+  const size_t available = words.size() - kHeaderWords;
+  if (header.state_record_count > available ||
+      header.range_count != (available - header.state_record_count) / kRangeWords ||
+      (available - header.state_record_count) % kRangeWords != 0) {
+    return false;
+  }
+
+  words_ = words;
+  state_record_offsets_ = words.subspan(kHeaderWords, header.state_record_count);
+  ranges_ = {reinterpret_cast<const Range*>(words.data() + kHeaderWords +
+                                            header.state_record_count),
+             header.range_count};
+  return true;
+}
+
+bool FileIndex::WriteFile(const char* file_path) const {
+  FILE* file = fopen(file_path, "wb");
+  if (file == nullptr) {
+    return false;
+  }
+  const bool written = fwrite(data(), 1u, size(), file) == size();
+  return fclose(file) == 0 && written;
+}
+
+cpp20::span<const FileIndex::Range> FileIndex::RangesBetween(trace_ticks_t begin,
+                                                              trace_ticks_t end) const {
+  if (begin > end) {
+    return {};
+  }
+  const uint64_t first_bucket = begin / bucket_ticks();
+  const uint64_t last_bucket = end / bucket_ticks();
+  auto first = std::lower_bound(ranges_.begin(), ranges_.end(), first_bucket,
+                                [](const Range& range, uint64_t bucket) {
+                                  return range.bucket < bucket;
+                                });
+  auto last = std::upper_bound(first, ranges_.end(), last_bucket,
+                               [](uint64_t bucket, const Range& range) {
+                                 return bucket < range.bucket;
+                               });
+  return ranges_.subspan(first - ranges_.begin(), last - first);
+}
+
+}  // namespace trace
@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+
 #include <trace-reader/file_reader.h>
 
 namespace trace {
@@ -50,4 +52,66 @@ void FileReader::ReadFile() {
   }
 }
 
+void FileReader::ReadRange(const FileIndex& index, uint64_t begin_offset, uint64_t end_offset) {
+  ZX_DEBUG_ASSERT(begin_offset <= end_offset);
+
+  // Everything the reader has seen since the start makes for the same state as long as it's read in
+  // order, so start over if the range comes before what's already been read.
+  if (begin_offset < state_offset_) {
+    state_offset_ = 0u;
+  }
+  cpp20::span<const uint64_t> offsets = index.state_record_offsets();
+  for (auto it = std::lower_bound(offsets.begin(), offsets.end(), state_offset_);
+       it != offsets.end() && *it < begin_offset; ++it) {
+    if (!ReadRecordAt(*it)) {
+      ReportError("Trace stream is corrupted");
+      return;
+    }
+  }
+
+  if (!ReadBetween(begin_offset, end_offset)) {
+    ReportError("Trace stream is corrupted");
+    return;
+  }
+  state_offset_ = end_offset;
+}
+
+bool FileReader::ReadRecordAt(uint64_t offset) {
+  RecordHeader header;
+  if (fseeko(file_, static_cast<off_t>(offset), SEEK_SET) != 0 ||
+      fread(&header, sizeof(header), 1u, file_) != 1u) {
+    return false;
+  }
+  const size_t size = RecordSizeWords(header);
+  return size != 0 && ReadBetween(offset, offset + trace::WordsToBytes(size));
+}
+
+bool FileReader::ReadBetween(uint64_t begin_offset, uint64_t end_offset) {
+  if (fseeko(file_, static_cast<off_t>(begin_offset), SEEK_SET) != 0) {
+    return false;
+  }
+  buffer_end_ = 0u;
+  uint64_t remaining = end_offset - begin_offset;
+  while (remaining > 0) {
+    size_t to_read = std::min<uint64_t>(buffer_.size() - buffer_end_, remaining);
+    size_t actual = fread(buffer_.data() + buffer_end_, 1u, to_read, file_);
+    if (actual == 0) {
+      return false;
+    }
+    remaining -= actual;
+    buffer_end_ += actual;
+
+    trace::Chunk chunk(reinterpret_cast<const uint64_t*>(buffer_.data()),
+                       trace::BytesToWords(buffer_end_));
+    if (!ReadRecords(chunk)) {
+      return false;
+    }
+    size_t bytes_consumed = buffer_end_ - trace::WordsToBytes(chunk.remaining_words());
+    memmove(buffer_.data(), buffer_.data() + bytes_consumed, buffer_end_ - bytes_consumed);
+    buffer_end_ -= bytes_consumed;
+  }
+  // The range must end at a record boundary.
+  return buffer_end_ == 0u;
+}
+
 }  // namespace trace
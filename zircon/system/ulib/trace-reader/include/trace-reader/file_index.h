@@ -0,0 +1,100 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TRACE_READER_FILE_INDEX_H_
+#define TRACE_READER_FILE_INDEX_H_
+
+#include <lib/stdcompat/span.h>
+#include <lib/trace-engine/types.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include <fbl/macros.h>
+#include <trace-reader/reader.h>
+
+namespace trace {
+
+// A side index over a trace file, in fxt file format, which lets |FileReader::ReadRange()| read
+// just the records of interest rather than the whole file.
+//
+// Events are grouped into ranges of the file by the time bucket they fall in, the provider which
+// wrote them and the thread they happened on. Each range runs from the first to the last record of
+// its group, so it may also hold records from other groups, which readers are expected to skip.
+// The index also lists the offset of every record which the reader needs to have seen to decode
+// those which follow it: metadata, initialization, string and thread records.
+//
+// An index is built once by scanning the whole trace. Its serialized form is an array of 64-bit
+// words which can be written out next to the trace and later used in place, e.g. from a mapping
+// of the file, without being parsed.
+class FileIndex {
+ public:
+  static constexpr uint64_t kMagic = 0x78646e4974786621;  // "!fxtIndx"
+  static constexpr uint64_t kVersion = 1;
+
+  struct Header {
+    uint64_t magic;
+    uint64_t version;
+    uint64_t bucket_ticks;
+    uint64_t state_record_count;
+    uint64_t range_count;
+  };
+
+  struct Range {
+    uint64_t bucket;
+    uint64_t provider_id;
+    zx_koid_t process_koid;
+    zx_koid_t thread_koid;
+    // Byte offsets of the start of the first record and the end of the last record in the group.
+    uint64_t begin_offset;
+    uint64_t end_offset;
+  };
+
+  // Scans the trace at |file_path| and indexes it, with time buckets |bucket_ticks| long.
+  // Returns false if the file can't be read or the trace is corrupt.
+  static bool Build(const char* file_path, trace_ticks_t bucket_ticks,
+                    TraceReader::ErrorHandler error_handler, std::unique_ptr<FileIndex>* out_index);
+
+  // Uses the serialized index in |data|, which must stay valid and unchanged for the lifetime of
+  // the returned index and be aligned to 8 bytes. Returns false if it isn't a valid index.
+  static bool Create(const void* data, size_t size, std::unique_ptr<FileIndex>* out_index);
+
+  // The serialized index.
+  const void* data() const { return words_.data(); }
+  size_t size() const { return words_.size_bytes(); }
+
+  // Writes the serialized index to |file_path|.
+  bool WriteFile(const char* file_path) const;
+
+  trace_ticks_t bucket_ticks() const { return header().bucket_ticks; }
+
+  // The offsets of the records needed to decode the records which follow them, in file order.
+  cpp20::span<const uint64_t> state_record_offsets() const { return state_record_offsets_; }
+
+  // All ranges, ordered by bucket, then provider, then thread.
+  cpp20::span<const Range> ranges() const { return ranges_; }
+
+  // The ranges holding the events between the |begin| and |end| ticks, inclusive.
+  cpp20::span<const Range> RangesBetween(trace_ticks_t begin, trace_ticks_t end) const;
+
+ private:
+  FileIndex() = default;
+
+  bool Init(cpp20::span<const uint64_t> words);
+
+  const Header& header() const { return *reinterpret_cast<const Header*>(words_.data()); }
+
+  // Set when the index was built rather than wrapping existing data.
+  std::vector<uint64_t> storage_;
+  cpp20::span<const uint64_t> words_;
+  cpp20::span<const uint64_t> state_record_offsets_;
+  cpp20::span<const Range> ranges_;
+
+  DISALLOW_COPY_ASSIGN_AND_MOVE(FileIndex);
+};
+
+}  // namespace trace
+
+#endif  // TRACE_READER_FILE_INDEX_H_
@@ -11,6 +11,7 @@
 #include <array>
 #include <memory>
 
+#include <trace-reader/file_index.h>
 #include <trace-reader/reader.h>
 
 namespace trace {
@@ -24,12 +25,26 @@ class FileReader : public TraceReader {
 
   void ReadFile();
 
+  // Reads the records in [begin_offset, end_offset) of the file, which must be the bounds of
+  // records, e.g. those of one of the ranges in |index|.
+  //
+  // Any of the records which |index| lists as needed to decode the rest that come before
+  // |begin_offset|, and haven't been read by an earlier call, are read first. They are passed to
+  // the record consumer like any other record. Reading ranges in file order avoids reading any of
+  // these more than once.
+  void ReadRange(const FileIndex& index, uint64_t begin_offset, uint64_t end_offset);
+
  private:
   // Note: Buffer needs to be big enough to store records of maximum size.
   static constexpr size_t kReadBufferSize = trace::RecordFields::kMaxRecordSizeBytes * 4;
 
   explicit FileReader(FILE* file, RecordConsumer record_consumer, ErrorHandler error_handler);
 
+  // Reads the records in [begin_offset, end_offset) of the file.
+  bool ReadBetween(uint64_t begin_offset, uint64_t end_offset);
+  // Reads the one record at |offset|.
+  bool ReadRecordAt(uint64_t offset);
+
   FILE* const file_;
   RecordConsumer const record_consumer_;
   ErrorHandler const error_handler_;
@@ -39,6 +54,8 @@ class FileReader : public TraceReader {
   std::array<uint8_t, kReadBufferSize> buffer_;
   // The amount of space in use in |buffer_|.
   size_t buffer_end_ = 0u;
+  // The offset up to which |ReadRange()| has read all the records needed to decode what follows.
+  uint64_t state_offset_ = 0u;
 
   DISALLOW_COPY_AND_ASSIGN_ALLOW_MOVE(FileReader);
 };
@@ -24,6 +24,9 @@ namespace trace {
 
 class Chunk;
 
+// Returns the size of the record with header |header| in words, including the header itself.
+size_t RecordSizeWords(RecordHeader header);
+
 // Reads trace records.
 // The input is a collection of |Chunk| objects (see class Chunk below).
 //
@@ -13,6 +13,19 @@
 
 namespace trace {
 
+size_t RecordSizeWords(RecordHeader header) {
+  size_t size;
+  if (RecordFields::Type::Get<RecordType>(header) != RecordType::kLargeRecord) {
+    size = RecordFields::RecordSize::Get<size_t>(header);
+    ZX_DEBUG_ASSERT(size <= RecordFields::kMaxRecordSizeWords);
+    static_assert(RecordFields::kMaxRecordSizeBytes <= TRACE_ENCODED_INLINE_LARGE_RECORD_MAX_SIZE);
+  } else {
+    size = LargeBlobFields::RecordSize::Get<size_t>(header);
+    ZX_DEBUG_ASSERT(size <= BytesToWords(TRACE_ENCODED_INLINE_LARGE_RECORD_MAX_SIZE));
+  }
+  return size;
+}
+
 TraceReader::TraceReader(RecordConsumer record_consumer, ErrorHandler error_handler)
     : record_consumer_(std::move(record_consumer)), error_handler_(std::move(error_handler)) {
   // Provider ids begin at 1. We don't have a provider yet but we want to
@@ -32,16 +45,7 @@ bool TraceReader::ReadRecords(Chunk& chunk) {
 
     auto type = RecordFields::Type::Get<RecordType>(pending_header_);
 
-    size_t size;
-    if (type != RecordType::kLargeRecord) {
-      size = RecordFields::RecordSize::Get<size_t>(pending_header_);
-      ZX_DEBUG_ASSERT(size <= RecordFields::kMaxRecordSizeWords);
-      static_assert(RecordFields::kMaxRecordSizeBytes <=
-                    TRACE_ENCODED_INLINE_LARGE_RECORD_MAX_SIZE);
-    } else {
-      size = LargeBlobFields::RecordSize::Get<size_t>(pending_header_);
-      ZX_DEBUG_ASSERT(size <= BytesToWords(TRACE_ENCODED_INLINE_LARGE_RECORD_MAX_SIZE));
-    }
+    const size_t size = RecordSizeWords(pending_header_);
     if (size == 0) {
       ReportError("Unexpected record of size 0");
       return false;  // fatal error
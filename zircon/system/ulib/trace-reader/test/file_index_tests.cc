@@ -0,0 +1,163 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <lib/trace-engine/fields.h>
+#include <lib/trace-engine/types.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <fbl/vector.h>
+#include <trace-reader/file_index.h>
+#include <trace-reader/file_reader.h>
+#include <zxtest/zxtest.h>
+
+#include "reader_tests.h"
+
+namespace trace {
+namespace {
+
+const char kTestInputFile[] = "/tmp/trace-reader-index-test.fxt";
+const char kTestIndexFile[] = "/tmp/trace-reader-index-test.fxt.index";
+
+constexpr zx_koid_t kProcessKoid = 42;
+constexpr zx_koid_t kThreadKoids[] = {43, 44};
+constexpr trace_ticks_t kBucketTicks = 1000;
+
+void AppendThreadRecord(std::vector<uint64_t>* words, trace_thread_index_t index,
+                        zx_koid_t thread_koid) {
+  uint64_t header = 0;
+  ThreadRecordFields::Type::Set(header, static_cast<uint64_t>(RecordType::kThread));
+  ThreadRecordFields::RecordSize::Set(header, 3);
+  ThreadRecordFields::ThreadIndex::Set(header, index);
+  words->insert(words->end(), {header, kProcessKoid, thread_koid});
+}
+
+void AppendInstantEvent(std::vector<uint64_t>* words, trace_thread_index_t thread_index,
+                        trace_ticks_t timestamp) {
+  uint64_t header = 0;
+  EventRecordFields::Type::Set(header, static_cast<uint64_t>(RecordType::kEvent));
+  EventRecordFields::RecordSize::Set(header, 3);
+  EventRecordFields::EventType::Set(header, static_cast<uint64_t>(EventType::kInstant));
+  EventRecordFields::ThreadRef::Set(header, thread_index);
+  words->insert(words->end(), {header, timestamp, TRACE_SCOPE_THREAD});
+}
+
+// Writes a trace with a thread record for each of |kThreadKoids| followed by four events on them.
+void WriteTestTrace() {
+  std::vector<uint64_t> words;
+  AppendThreadRecord(&words, 1, kThreadKoids[0]);
+  AppendThreadRecord(&words, 2, kThreadKoids[1]);
+  AppendInstantEvent(&words, 1, 100);
+  AppendInstantEvent(&words, 2, 5000);
+  AppendInstantEvent(&words, 1, 9000);
+  AppendInstantEvent(&words, 1, 9500);
+
+  FILE* f = fopen(kTestInputFile, "wb");
+  ASSERT_NOT_NULL(f);
+  ASSERT_EQ(fwrite(words.data(), sizeof(uint64_t), words.size(), f), words.size());
+  ASSERT_EQ(fclose(f), 0);
+}
+
+TEST(TraceFileIndex, Build) {
+  ASSERT_NO_FATAL_FAILURE(WriteTestTrace());
+
+  fbl::String error;
+  std::unique_ptr<FileIndex> index;
+  ASSERT_TRUE(FileIndex::Build(kTestInputFile, kBucketTicks, test::MakeErrorHandler(&error),
+                               &index));
+  EXPECT_TRUE(error.empty());
+  EXPECT_EQ(index->bucket_ticks(), kBucketTicks);
+
+  ASSERT_EQ(index->state_record_offsets().size(), 2u);
+  EXPECT_EQ(index->state_record_offsets()[0], 0u);
+  EXPECT_EQ(index->state_record_offsets()[1], 24u);
+
+  ASSERT_EQ(index->ranges().size(), 3u);
+  const FileIndex::Range& first = index->ranges()[0];
+  EXPECT_EQ(first.bucket, 0u);
+  EXPECT_EQ(first.process_koid, kProcessKoid);
+  EXPECT_EQ(first.thread_koid, kThreadKoids[0]);
+  EXPECT_EQ(first.begin_offset, 48u);
+  EXPECT_EQ(first.end_offset, 72u);
+  // Both events in the last bucket are in the one range.
+  const FileIndex::Range& last = index->ranges()[2];
+  EXPECT_EQ(last.bucket, 9u);
+  EXPECT_EQ(last.begin_offset, 96u);
+  EXPECT_EQ(last.end_offset, 144u);
+
+  EXPECT_EQ(index->RangesBetween(4000, 6000).size(), 1u);
+  EXPECT_EQ(index->RangesBetween(0, 9000).size(), 3u);
+  EXPECT_EQ(index->RangesBetween(1000, 4999).size(), 0u);
+}
+
+TEST(TraceFileIndex, WriteAndCreate) {
+  ASSERT_NO_FATAL_FAILURE(WriteTestTrace());
+
+  fbl::String error;
+  std::unique_ptr<FileIndex> index;
+  ASSERT_TRUE(FileIndex::Build(kTestInputFile, kBucketTicks, test::MakeErrorHandler(&error),
+                               &index));
+  ASSERT_TRUE(index->WriteFile(kTestIndexFile));
+
+  FILE* f = fopen(kTestIndexFile, "rb");
+  ASSERT_NOT_NULL(f);
+  std::vector<uint64_t> data(index->size() / sizeof(uint64_t));
+  ASSERT_EQ(fread(data.data(), sizeof(uint64_t), data.size(), f), data.size());
+  ASSERT_EQ(fclose(f), 0);
+
+  std::unique_ptr<FileIndex> loaded;
+  ASSERT_TRUE(FileIndex::Create(data.data(), index->size(), &loaded));
+  EXPECT_EQ(loaded->bucket_ticks(), kBucketTicks);
+  EXPECT_EQ(loaded->state_record_offsets().size(), index->state_record_offsets().size());
+  EXPECT_EQ(loaded->ranges().size(), index->ranges().size());
+
+  // Truncated or corrupt indexes are rejected.
+  EXPECT_FALSE(FileIndex::Create(data.data(), index->size() - sizeof(uint64_t), &loaded));
+  data[0] ^= 1;
+  EXPECT_FALSE(FileIndex::Create(data.data(), index->size(), &loaded));
+}
+
+TEST(TraceFileIndex, ReadRange) {
+  ASSERT_NO_FATAL_FAILURE(WriteTestTrace());
+
+  fbl::String error;
+  std::unique_ptr<FileIndex> index;
+  ASSERT_TRUE(FileIndex::Build(kTestInputFile, kBucketTicks, test::MakeErrorHandler(&error),
+                               &index));
+  cpp20::span<const FileIndex::Range> ranges = index->RangesBetween(4000, 6000);
+  ASSERT_EQ(ranges.size(), 1u);
+
+  std::unique_ptr<FileReader> reader;
+  fbl::Vector<Record> records;
+  ASSERT_TRUE(FileReader::Create(kTestInputFile, test::MakeRecordConsumer(&records),
+                                 test::MakeErrorHandler(&error), &reader));
+  reader->ReadRange(*index, ranges[0].begin_offset, ranges[0].end_offset);
+  EXPECT_TRUE(error.empty());
+
+  // The thread records are read first so that the event's thread can be decoded.
+  ASSERT_EQ(records.size(), 3u);
+  EXPECT_EQ(records[0].type(), RecordType::kThread);
+  EXPECT_EQ(records[1].type(), RecordType::kThread);
+  ASSERT_EQ(records[2].type(), RecordType::kEvent);
+  EXPECT_EQ(records[2].GetEvent().timestamp, 5000u);
+  EXPECT_EQ(records[2].GetEvent().process_thread.thread_koid(), kThreadKoids[1]);
+
+  // They're not read again for a later range.
+  records.reset();
+  ranges = index->RangesBetween(9000, 9000);
+  ASSERT_EQ(ranges.size(), 1u);
+  reader->ReadRange(*index, ranges[0].begin_offset, ranges[0].end_offset);
+  EXPECT_TRUE(error.empty());
+  ASSERT_EQ(records.size(), 2u);
+  EXPECT_EQ(records[0].GetEvent().timestamp, 9000u);
+  EXPECT_EQ(records[1].GetEvent().timestamp, 9500u);
+}
+
+}  // namespace
+}  // namespace trace
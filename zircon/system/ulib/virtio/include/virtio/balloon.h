@@ -11,6 +11,9 @@
 #define VIRTIO_BALLOON_F_MUST_TELL_HOST   (1u << 0)
 #define VIRTIO_BALLOON_F_STATS_VQ         (1u << 1)
 #define VIRTIO_BALLOON_F_DEFLATE_ON_OOM   (1u << 2)
+#define VIRTIO_BALLOON_F_FREE_PAGE_HINT   (1u << 3)
+#define VIRTIO_BALLOON_F_PAGE_POISON      (1u << 4)
+#define VIRTIO_BALLOON_F_PAGE_REPORTING   (1u << 5)
 
 #define VIRTIO_BALLOON_S_SWAP_IN          0
 #define VIRTIO_BALLOON_S_SWAP_OUT         1
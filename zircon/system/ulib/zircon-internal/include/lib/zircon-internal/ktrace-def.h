@@ -137,9 +137,10 @@ KTRACE_DEF(0x150, 32B, WAIT_ONE, IPC)       // id, signals, timeoutlo, timeouthi
 KTRACE_DEF(0x151, 32B, WAIT_ONE_DONE, IPC)  // id, status, pending
 
 KTRACE_DEF(0x170, 32B, VCPU_ENTER, TASKS)
-KTRACE_DEF(0x171, 32B, VCPU_EXIT, TASKS)     // meta, exit_address_hi, exit_address_lo
-KTRACE_DEF(0x172, 32B, VCPU_BLOCK, TASKS)    // meta
-KTRACE_DEF(0x173, 32B, VCPU_UNBLOCK, TASKS)  // meta
+KTRACE_DEF(0x171, 32B, VCPU_EXIT, TASKS)       // meta, exit_address_hi, exit_address_lo
+KTRACE_DEF(0x172, 32B, VCPU_BLOCK, TASKS)      // meta
+KTRACE_DEF(0x173, 32B, VCPU_UNBLOCK, TASKS)    // meta
+KTRACE_DEF(0x174, 32B, VCPU_INTERRUPT, TASKS)  // vector, exit_avoided
 
 // events from 0x200-0x2ff are for arch-specific needs
 
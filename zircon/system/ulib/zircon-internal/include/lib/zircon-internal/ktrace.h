@@ -48,6 +48,13 @@ __BEGIN_CDECLS
 
 #define KTRACE_VERSION            (0x00020000u)
 
+// Records with a group of 0 are padding, which readers skip. Those with this
+// event are 16 byte headers that start a block of the trace written by a single
+// CPU: |tid| holds the CPU number and |ts| the size of the block in bytes,
+// including the header. The records of a block are in the order that they were
+// written on that CPU, but the blocks of different CPUs overlap in time.
+#define KTRACE_EVENT_CPU_BLOCK    (0x001)
+
 // Filter Groups
 #define KTRACE_GRP_ALL            0xFFF
 #define KTRACE_GRP_META           0x001
@@ -0,0 +1,287 @@
+// Copyright 2022 The Fuchsia Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <lib/channel-ring/channel-ring.h>
+#include <lib/fit/function.h>
+#include <lib/zx/channel.h>
+#include <lib/zx/event.h>
+#include <lib/zx/vmo.h>
+#include <zircon/errors.h>
+#include <zircon/rights.h>
+#include <zircon/syscalls/channel.h>
+#include <zircon/syscalls/object.h>
+#include <zircon/types.h>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <zxtest/zxtest.h>
+
+#include "utils.h"
+
+namespace channel {
+namespace {
+
+using channel_ring::ChannelRing;
+
+// Data used for writing into a channel.
+constexpr uint32_t kChannelData = 0xdeadbeef;
+
+void CreateRings(std::unique_ptr<ChannelRing>* a, std::unique_ptr<ChannelRing>* b) {
+  zx::channel local, remote;
+  ASSERT_OK(zx::channel::create(ZX_CHANNEL_SHARED_RING, &local, &remote));
+  ASSERT_OK(ChannelRing::Create(std::move(local), a));
+  ASSERT_OK(ChannelRing::Create(std::move(remote), b));
+}
+
+bool IsReadable(const zx::channel& channel) {
+  zx_signals_t observed = 0;
+  channel.wait_one(ZX_CHANNEL_READABLE, zx::time::infinite_past(), &observed);
+  return observed & ZX_CHANNEL_READABLE;
+}
+
+TEST(ChannelRingTest, CreateWithUnknownOptionsFails) {
+  zx::channel local, remote;
+  EXPECT_STATUS(zx::channel::create(~ZX_CHANNEL_SHARED_RING, &local, &remote),
+                ZX_ERR_INVALID_ARGS);
+  EXPECT_STATUS(zx::channel::create(ZX_CHANNEL_SHARED_RING << 1, &local, &remote),
+                ZX_ERR_INVALID_ARGS);
+}
+
+TEST(ChannelRingTest, EachEndpointReceivesRingInfo) {
+  zx::channel endpoints[2];
+  ASSERT_OK(zx::channel::create(ZX_CHANNEL_SHARED_RING, &endpoints[0], &endpoints[1]));
+
+  zx_channel_ring_info_t info[2];
+  zx_info_handle_basic_t vmo_info[2];
+  for (int i = 0; i < 2; i++) {
+    zx_handle_t handle;
+    uint32_t actual_bytes, actual_handles;
+    ASSERT_OK(endpoints[i].read(0, &info[i], &handle, sizeof(info[i]), 1, &actual_bytes,
+                                &actual_handles));
+    EXPECT_EQ(actual_bytes, sizeof(info[i]));
+    ASSERT_EQ(actual_handles, 1u);
+    zx::vmo vmo(handle);
+    ASSERT_OK(
+        vmo.get_info(ZX_INFO_HANDLE_BASIC, &vmo_info[i], sizeof(vmo_info[i]), nullptr, nullptr));
+    EXPECT_EQ(vmo_info[i].type, ZX_OBJ_TYPE_VMO);
+    EXPECT_EQ(vmo_info[i].rights & (ZX_RIGHT_READ | ZX_RIGHT_WRITE | ZX_RIGHT_MAP),
+              ZX_RIGHT_READ | ZX_RIGHT_WRITE | ZX_RIGHT_MAP);
+    EXPECT_EQ(vmo_info[i].rights & ZX_RIGHT_EXECUTE, 0u);
+
+    uint64_t vmo_size;
+    ASSERT_OK(vmo.get_size(&vmo_size));
+    EXPECT_EQ(info[i].version, ZX_CHANNEL_RING_VERSION);
+    EXPECT_EQ(info[i].data_size, ZX_CHANNEL_RING_DATA_SIZE);
+    EXPECT_LE(info[i].tx_offset + ZX_CHANNEL_RING_HEADER_SIZE + info[i].data_size, vmo_size);
+    EXPECT_LE(info[i].rx_offset + ZX_CHANNEL_RING_HEADER_SIZE + info[i].data_size, vmo_size);
+
+    // Only the ring information was queued.
+    EXPECT_FALSE(IsReadable(endpoints[i]));
+  }
+
+  // Both endpoints share one VMO, and each one reads what the other writes.
+  EXPECT_EQ(vmo_info[0].koid, vmo_info[1].koid);
+  EXPECT_EQ(info[0].tx_offset, info[1].rx_offset);
+  EXPECT_EQ(info[0].rx_offset, info[1].tx_offset);
+  EXPECT_NE(info[0].tx_offset, info[0].rx_offset);
+}
+
+TEST(ChannelRingTest, CreateRejectsPlainChannel) {
+  zx::channel local, remote;
+  ASSERT_OK(zx::channel::create(0, &local, &remote));
+  ASSERT_OK(remote.write(0, &kChannelData, sizeof(kChannelData), nullptr, 0));
+  std::unique_ptr<ChannelRing> ring;
+  EXPECT_STATUS(ChannelRing::Create(std::move(local), &ring), ZX_ERR_NOT_SUPPORTED);
+}
+
+TEST(ChannelRingTest, SmallMessageSkipsTheChannel) {
+  std::unique_ptr<ChannelRing> a, b;
+  ASSERT_NO_FATAL_FAILURE(CreateRings(&a, &b));
+
+  const char kMessage[] = "through the ring";
+  ASSERT_OK(a->Write(kMessage, sizeof(kMessage), nullptr, 0));
+  EXPECT_FALSE(IsReadable(b->channel()));
+
+  char buffer[sizeof(kMessage)] = {};
+  uint32_t actual_bytes = 0, actual_handles = 1;
+  ASSERT_OK(b->Read(buffer, sizeof(buffer), &actual_bytes, nullptr, 0, &actual_handles));
+  EXPECT_EQ(actual_bytes, sizeof(kMessage));
+  EXPECT_EQ(actual_handles, 0u);
+  EXPECT_BYTES_EQ(buffer, kMessage, sizeof(kMessage));
+
+  EXPECT_STATUS(b->Read(buffer, sizeof(buffer), &actual_bytes, nullptr, 0, &actual_handles),
+                ZX_ERR_SHOULD_WAIT);
+}
+
+TEST(ChannelRingTest, ReadIntoSmallBufferKeepsMessage) {
+  std::unique_ptr<ChannelRing> a, b;
+  ASSERT_NO_FATAL_FAILURE(CreateRings(&a, &b));
+
+  uint64_t value = 0x1122334455667788;
+  ASSERT_OK(a->Write(&value, sizeof(value), nullptr, 0));
+
+  uint32_t small = 0;
+  uint32_t actual_bytes = 0;
+  EXPECT_STATUS(b->Read(&small, sizeof(small), &actual_bytes, nullptr, 0, nullptr),
+                ZX_ERR_BUFFER_TOO_SMALL);
+  EXPECT_EQ(actual_bytes, sizeof(value));
+
+  uint64_t read_value = 0;
+  ASSERT_OK(b->Read(&read_value, sizeof(read_value), &actual_bytes, nullptr, 0, nullptr));
+  EXPECT_EQ(read_value, value);
+}
+
+TEST(ChannelRingTest, ChannelMessagesStayInOrder) {
+  std::unique_ptr<ChannelRing> a, b;
+  ASSERT_NO_FATAL_FAILURE(CreateRings(&a, &b));
+
+  // A large message and a message with a handle go through the channel, between messages that go
+  // through the ring.
+  std::vector<uint8_t> large(ZX_CHANNEL_RING_MAX_DATA_BYTES + 1, 0xab);
+  zx::event event;
+  ASSERT_OK(zx::event::create(0, &event));
+  zx_handle_t event_handle = event.release();
+  const uint32_t kFirst = 1, kWithHandle = 2, kLast = 3;
+  ASSERT_OK(a->Write(&kFirst, sizeof(kFirst), nullptr, 0));
+  ASSERT_OK(a->Write(large.data(), static_cast<uint32_t>(large.size()), nullptr, 0));
+  ASSERT_OK(a->Write(&kWithHandle, sizeof(kWithHandle), &event_handle, 1));
+  ASSERT_OK(a->Write(&kLast, sizeof(kLast), nullptr, 0));
+
+  std::vector<uint8_t> buffer(large.size());
+  uint32_t actual_bytes = 0, actual_handles = 0;
+  zx_handle_t handle = ZX_HANDLE_INVALID;
+
+  ASSERT_OK(b->Read(buffer.data(), static_cast<uint32_t>(buffer.size()), &actual_bytes, &handle,
+                    1, &actual_handles));
+  ASSERT_EQ(actual_bytes, sizeof(kFirst));
+  EXPECT_BYTES_EQ(buffer.data(), &kFirst, sizeof(kFirst));
+
+  ASSERT_OK(b->Read(buffer.data(), static_cast<uint32_t>(buffer.size()), &actual_bytes, &handle,
+                    1, &actual_handles));
+  ASSERT_EQ(actual_bytes, large.size());
+  EXPECT_EQ(actual_handles, 0u);
+  EXPECT_BYTES_EQ(buffer.data(), large.data(), large.size());
+
+  ASSERT_OK(b->Read(buffer.data(), static_cast<uint32_t>(buffer.size()), &actual_bytes, &handle,
+                    1, &actual_handles));
+  ASSERT_EQ(actual_bytes, sizeof(kWithHandle));
+  EXPECT_BYTES_EQ(buffer.data(), &kWithHandle, sizeof(kWithHandle));
+  ASSERT_EQ(actual_handles, 1u);
+  zx::event received(handle);
+  zx_info_handle_basic_t info;
+  ASSERT_OK(received.get_info(ZX_INFO_HANDLE_BASIC, &info, sizeof(info), nullptr, nullptr));
+  EXPECT_EQ(info.type, ZX_OBJ_TYPE_EVENT);
+
+  ASSERT_OK(b->Read(buffer.data(), static_cast<uint32_t>(buffer.size()), &actual_bytes, &handle,
+                    1, &actual_handles));
+  ASSERT_EQ(actual_bytes, sizeof(kLast));
+  EXPECT_BYTES_EQ(buffer.data(), &kLast, sizeof(kLast));
+  EXPECT_FALSE(IsReadable(b->channel()));
+}
+
+TEST(ChannelRingTest, FullRingWrapsAround) {
+  std::unique_ptr<ChannelRing> a, b;
+  ASSERT_NO_FATAL_FAILURE(CreateRings(&a, &b));
+
+  // Messages of the largest size don't divide the ring evenly, so refilling it has to pad the end.
+  std::vector<uint32_t> message(ZX_CHANNEL_RING_MAX_DATA_BYTES / sizeof(uint32_t));
+  const uint32_t message_bytes = static_cast<uint32_t>(message.size() * sizeof(uint32_t));
+  uint32_t written = 0;
+  for (;;) {
+    message[0] = written;
+    zx_status_t status = a->Write(message.data(), message_bytes, nullptr, 0);
+    if (status == ZX_ERR_SHOULD_WAIT) {
+      break;
+    }
+    ASSERT_OK(status);
+    written++;
+  }
+  ASSERT_GT(written, 1u);
+  ASSERT_LT(written, ZX_CHANNEL_RING_DATA_SIZE / ZX_CHANNEL_RING_MAX_DATA_BYTES + 1);
+
+  // Keep the ring full while going around it a few times.
+  std::vector<uint32_t> buffer(message.size());
+  uint32_t read = 0;
+  while (written * uint64_t{message_bytes} < 4 * ZX_CHANNEL_RING_DATA_SIZE) {
+    uint32_t actual_bytes = 0;
+    ASSERT_OK(b->Read(buffer.data(), message_bytes, &actual_bytes, nullptr, 0, nullptr));
+    ASSERT_EQ(actual_bytes, message_bytes);
+    ASSERT_EQ(buffer[0], read);
+    read++;
+
+    for (;;) {
+      message[0] = written;
+      zx_status_t status = a->Write(message.data(), message_bytes, nullptr, 0);
+      if (status == ZX_ERR_SHOULD_WAIT) {
+        break;
+      }
+      ASSERT_OK(status);
+      written++;
+    }
+    // The ring never holds more than it did when it was first filled.
+    ASSERT_LE(written - read, ZX_CHANNEL_RING_DATA_SIZE / ZX_CHANNEL_RING_MAX_DATA_BYTES);
+  }
+
+  while (read < written) {
+    uint32_t actual_bytes = 0;
+    ASSERT_OK(b->Read(buffer.data(), message_bytes, &actual_bytes, nullptr, 0, nullptr));
+    EXPECT_EQ(buffer[0], read);
+    read++;
+  }
+  EXPECT_STATUS(b->Read(buffer.data(), message_bytes, nullptr, nullptr, 0, nullptr),
+                ZX_ERR_SHOULD_WAIT);
+}
+
+TEST(ChannelRingTest, WaitWakesOnRingWrite) {
+  std::unique_ptr<ChannelRing> a, b;
+  ASSERT_NO_FATAL_FAILURE(CreateRings(&a, &b));
+
+  EXPECT_STATUS(b->Wait(zx::deadline_after(zx::msec(1))), ZX_ERR_TIMED_OUT);
+
+  constexpr uint32_t kMessages = 1000;
+  AutoJoinThread writer([&a]() {
+    for (uint32_t i = 0; i < kMessages; i++) {
+      while (a->Write(&i, sizeof(i), nullptr, 0) == ZX_ERR_SHOULD_WAIT) {
+        zx::nanosleep(zx::deadline_after(zx::usec(10)));
+      }
+    }
+  });
+
+  for (uint32_t i = 0; i < kMessages; i++) {
+    uint32_t value = 0;
+    zx_status_t status;
+    while ((status = b->Read(&value, sizeof(value), nullptr, nullptr, 0, nullptr)) ==
+           ZX_ERR_SHOULD_WAIT) {
+      ASSERT_OK(b->Wait(zx::time::infinite()));
+    }
+    ASSERT_OK(status);
+    ASSERT_EQ(value, i);
+  }
+  writer.Join();
+
+  // No channel message was needed to carry the data or the wake ups.
+  EXPECT_FALSE(IsReadable(b->channel()));
+}
+
+TEST(ChannelRingTest, WaitReturnsPeerClosed) {
+  std::unique_ptr<ChannelRing> a, b;
+  ASSERT_NO_FATAL_FAILURE(CreateRings(&a, &b));
+
+  const uint32_t kValue = 7;
+  ASSERT_OK(a->Write(&kValue, sizeof(kValue), nullptr, 0));
+  a.reset();
+
+  // What was written before the peer closed is still delivered.
+  ASSERT_OK(b->Wait(zx::time::infinite()));
+  uint32_t value = 0;
+  ASSERT_OK(b->Read(&value, sizeof(value), nullptr, nullptr, 0, nullptr));
+  EXPECT_EQ(value, kValue);
+
+  EXPECT_STATUS(b->Wait(zx::time::infinite()), ZX_ERR_PEER_CLOSED);
+}
+
+}  // namespace
+}  // namespace channel
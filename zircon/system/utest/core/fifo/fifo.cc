@@ -36,6 +36,18 @@ TEST(FifoTest, InvalidParametersReturnOutOfRange) {
             ZX_ERR_OUT_OF_RANGE);  // invalid options
 }
 
+TEST(FifoTest, UnknownOptionsReturnInvalidArgs) {
+  zx::fifo fifo_a, fifo_b;
+
+  EXPECT_EQ(zx::fifo::create(4, kElementSize, ZX_FIFO_READ_POLLING << 1, &fifo_a, &fifo_b),
+            ZX_ERR_INVALID_ARGS);
+  EXPECT_EQ(zx::fifo::create(4, kElementSize, ~ZX_FIFO_READ_POLLING, &fifo_a, &fifo_b),
+            ZX_ERR_INVALID_ARGS);
+  EXPECT_EQ(zx::fifo::create(4, kElementSize, UINT32_MAX, &fifo_a, &fifo_b), ZX_ERR_INVALID_ARGS);
+
+  EXPECT_OK(zx::fifo::create(4, kElementSize, ZX_FIFO_READ_POLLING, &fifo_a, &fifo_b));
+}
+
 TEST(FifoTest, EndpointsAreRelated) {
   zx::fifo fifo_a, fifo_b;
 
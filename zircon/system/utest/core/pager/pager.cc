@@ -165,6 +165,38 @@ VMO_VMAR_TEST(Pager, ConcurrentMultipageAccessTest) {
   ASSERT_TRUE(t2.Wait());
 }
 
+// Tests that adjacent requests queued behind an outstanding packet are merged into one packet.
+VMO_VMAR_TEST(Pager, MergedAdjacentRequestsTest) {
+  UserPager pager;
+
+  ASSERT_TRUE(pager.Init());
+
+  Vmo* vmo;
+  ASSERT_TRUE(pager.CreateVmo(3, &vmo));
+
+  TestThread t([vmo, check_vmar]() -> bool { return check_buffer(vmo, 0, 1, check_vmar); });
+  TestThread t2([vmo, check_vmar]() -> bool { return check_buffer(vmo, 1, 1, check_vmar); });
+  TestThread t3([vmo, check_vmar]() -> bool { return check_buffer(vmo, 2, 1, check_vmar); });
+
+  // The request for page 0 occupies the packet, so the requests for pages 1 and 2 stay pending.
+  ASSERT_TRUE(t.Start());
+  ASSERT_TRUE(t.WaitForBlocked());
+  ASSERT_TRUE(t2.Start());
+  ASSERT_TRUE(t2.WaitForBlocked());
+  ASSERT_TRUE(t3.Start());
+  ASSERT_TRUE(t3.WaitForBlocked());
+
+  ASSERT_TRUE(pager.WaitForPageRead(vmo, 0, 1, ZX_TIME_INFINITE));
+  ASSERT_TRUE(pager.WaitForPageRead(vmo, 1, 2, ZX_TIME_INFINITE));
+  ASSERT_TRUE(pager.SupplyPages(vmo, 0, 3));
+
+  ASSERT_TRUE(t.Wait());
+  ASSERT_TRUE(t2.Wait());
+  ASSERT_TRUE(t3.Wait());
+
+  ASSERT_FALSE(pager.WaitForPageRead(vmo, 2, 1, 0));
+}
+
 // Tests that multiple threads can concurrently access a single page.
 VMO_VMAR_TEST(Pager, ConcurrentOverlappingAccessTest) {
   UserPager pager;
@@ -6,6 +6,8 @@
 #include <sched.h>
 #include <threads.h>
 #include <zircon/syscalls.h>
+#include <zircon/syscalls/object.h>
+#include <zircon/threads.h>
 
 #include <zxtest/zxtest.h>
 
@@ -107,6 +109,80 @@ TEST(SyncCondition, ConditionTest) {
   thrd_join(thread3, nullptr);
 }
 
+int broadcast_thread(void* arg) {
+  auto* ctx = static_cast<Context*>(arg);
+
+  ctx->mutex.lock();
+  ctx->threads_started++;
+  ctx->cond.wait(&ctx->mutex);
+  ctx->threads_waked++;
+  ctx->mutex.unlock();
+  return 0;
+}
+
+zx_info_thread_t thread_info(thrd_t thread) {
+  zx_info_thread_t info = {};
+  EXPECT_OK(zx_object_get_info(thrd_get_zx_handle(thread), ZX_INFO_THREAD, &info, sizeof(info),
+                               nullptr, nullptr));
+  return info;
+}
+
+zx_duration_t thread_runtime(thrd_t thread) {
+  zx_info_thread_stats_t stats = {};
+  EXPECT_OK(zx_object_get_info(thrd_get_zx_handle(thread), ZX_INFO_THREAD_STATS, &stats,
+                               sizeof(stats), nullptr, nullptr));
+  return stats.total_runtime;
+}
+
+// Signaling while holding the mutex hands the waiters over to the mutex, so
+// none of them may run before the mutex is released.
+TEST(SyncCondition, BroadcastWhileHoldingMutexTest) {
+  Context ctx;
+
+  thrd_t threads[3];
+  for (auto& thread : threads) {
+    thrd_create(&thread, broadcast_thread, &ctx);
+  }
+
+  // Wait for all the threads to report that they've started.
+  while (true) {
+    ctx.mutex.lock();
+    int started = ctx.threads_started;
+    ctx.mutex.unlock();
+    if (started == 3) {
+      break;
+    }
+    sched_yield();
+  }
+
+  // Once they are all blocked in the wait, none of them runs until woken.
+  ctx.mutex.lock();
+  zx_duration_t runtimes[3];
+  for (size_t i = 0; i < 3; ++i) {
+    while (thread_info(threads[i]).state != ZX_THREAD_STATE_BLOCKED_FUTEX) {
+      sched_yield();
+    }
+    runtimes[i] = thread_runtime(threads[i]);
+  }
+
+  // A waiter which was woken rather than requeued would run, only to block on
+  // the mutex again, so its runtime would grow.
+  ctx.cond.broadcast();
+  zx_nanosleep(zx_deadline_after(ZX_MSEC(1)));
+  EXPECT_EQ(ctx.threads_waked, 0);
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(thread_info(threads[i]).state, ZX_THREAD_STATE_BLOCKED_FUTEX);
+    EXPECT_EQ(thread_runtime(threads[i]), runtimes[i], "thread %zu ran while the mutex was held",
+              i);
+  }
+  ctx.mutex.unlock();
+
+  for (auto& thread : threads) {
+    thrd_join(thread, nullptr);
+  }
+  EXPECT_EQ(ctx.threads_waked, 3);
+}
+
 TEST(SyncCondition, TimeoutTest) {
   Condition cond;
   Mutex mutex;
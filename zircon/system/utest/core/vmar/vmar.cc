@@ -4,6 +4,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <lib/fit/defer.h>
 #include <lib/fzl/memory-probe.h>
 #include <lib/zircon-internal/align.h>
 #include <lib/zx/job.h>
@@ -2498,4 +2499,137 @@ TEST(Vmar, ProtectReadIfXomUnsupported) {
   EXPECT_EQ(probe_for_read(reinterpret_cast<void*>(addr)), xomUnsupported);
 }
 
+// Test zx_vmar_op_range ZX_VMAR_OP_DECOMMIT_BATCH across mappings of different VMOs.
+TEST(Vmar, RangeOpDecommitBatch) {
+  const size_t kPageSize = zx_system_get_page_size();
+  auto root_vmar = zx::vmar::root_self();
+  zx::vmar vmar;
+  zx_vaddr_t base;
+  ASSERT_OK(root_vmar->allocate(ZX_VM_CAN_MAP_SPECIFIC | ZX_VM_CAN_MAP_READ | ZX_VM_CAN_MAP_WRITE,
+                                0, 8 * kPageSize, &vmar, &base));
+  auto destroy = fit::defer([&vmar]() { vmar.destroy(); });
+
+  // Two adjacent mappings of four pages each, of different VMOs.
+  zx::vmo vmos[2];
+  for (size_t i = 0; i < 2; i++) {
+    ASSERT_OK(zx::vmo::create(4 * kPageSize, 0, &vmos[i]));
+    zx_vaddr_t addr;
+    ASSERT_OK(vmar.map(ZX_VM_SPECIFIC | ZX_VM_PERM_READ | ZX_VM_PERM_WRITE, i * 4 * kPageSize,
+                       vmos[i], 0, 4 * kPageSize, &addr));
+  }
+  auto page = [base, kPageSize](size_t i) {
+    return reinterpret_cast<volatile uint32_t*>(base + i * kPageSize);
+  };
+  for (uint32_t i = 0; i < 8; i++) {
+    *page(i) = i + 1;
+  }
+
+  // The second range spans both mappings.
+  const zx_op_range_t ranges[] = {
+      {.offset = base, .size = kPageSize},
+      {.offset = base + 3 * kPageSize, .size = 2 * kPageSize},
+      {.offset = base + 6 * kPageSize, .size = kPageSize},
+  };
+  ASSERT_OK(vmar.op_range(ZX_VMAR_OP_DECOMMIT_BATCH, 0, 0, const_cast<zx_op_range_t*>(ranges),
+                          sizeof(ranges)));
+  for (uint32_t i : {0u, 3u, 4u, 6u}) {
+    EXPECT_EQ(*page(i), 0u, "page %u", i);
+  }
+  for (uint32_t i : {1u, 2u, 5u, 7u}) {
+    EXPECT_EQ(*page(i), i + 1, "page %u", i);
+  }
+  for (const zx::vmo& vmo : vmos) {
+    zx_info_vmo_t info;
+    ASSERT_OK(vmo.get_info(ZX_INFO_VMO, &info, sizeof(info), nullptr, nullptr));
+    EXPECT_EQ(info.committed_bytes, 2 * kPageSize);
+  }
+}
+
+// Test that a bad range in a ZX_VMAR_OP_DECOMMIT_BATCH fails the batch before any range is
+// decommitted.
+TEST(Vmar, RangeOpDecommitBatchBadRange) {
+  const size_t kPageSize = zx_system_get_page_size();
+  auto root_vmar = zx::vmar::root_self();
+  zx::vmar vmar;
+  zx_vaddr_t base;
+  ASSERT_OK(root_vmar->allocate(ZX_VM_CAN_MAP_SPECIFIC | ZX_VM_CAN_MAP_READ | ZX_VM_CAN_MAP_WRITE,
+                                0, 4 * kPageSize, &vmar, &base));
+  auto destroy = fit::defer([&vmar]() { vmar.destroy(); });
+
+  // A writable page, a gap, and a read-only page.
+  zx::vmo vmo;
+  ASSERT_OK(zx::vmo::create(4 * kPageSize, 0, &vmo));
+  zx_vaddr_t addr;
+  ASSERT_OK(vmar.map(ZX_VM_SPECIFIC | ZX_VM_PERM_READ | ZX_VM_PERM_WRITE, 0, vmo, 0, kPageSize,
+                     &addr));
+  ASSERT_OK(vmar.map(ZX_VM_SPECIFIC | ZX_VM_PERM_READ, 2 * kPageSize, vmo, 2 * kPageSize,
+                     kPageSize, &addr));
+  *reinterpret_cast<volatile uint32_t*>(base) = 42;
+  const uint32_t kValue = 43;
+  ASSERT_OK(vmo.write(&kValue, 2 * kPageSize, sizeof(kValue)));
+
+  auto check_untouched = [&]() {
+    EXPECT_EQ(*reinterpret_cast<volatile uint32_t*>(base), 42u);
+    uint32_t value = 0;
+    EXPECT_OK(vmo.read(&value, 2 * kPageSize, sizeof(value)));
+    EXPECT_EQ(value, kValue);
+  };
+
+  struct {
+    zx_op_range_t second;
+    zx_status_t expected;
+  } cases[] = {
+      // Unmapped.
+      {{.offset = base + kPageSize, .size = kPageSize}, ZX_ERR_BAD_STATE},
+      // Read only.
+      {{.offset = base + 2 * kPageSize, .size = kPageSize}, ZX_ERR_ACCESS_DENIED},
+      // Outside the VMAR.
+      {{.offset = base + 4 * kPageSize, .size = kPageSize}, ZX_ERR_OUT_OF_RANGE},
+      // Unaligned.
+      {{.offset = base + 1, .size = kPageSize}, ZX_ERR_INVALID_ARGS},
+      // Empty.
+      {{.offset = base, .size = 0}, ZX_ERR_INVALID_ARGS},
+  };
+  for (const auto& c : cases) {
+    const zx_op_range_t ranges[] = {{.offset = base, .size = kPageSize}, c.second};
+    EXPECT_STATUS(vmar.op_range(ZX_VMAR_OP_DECOMMIT_BATCH, 0, 0,
+                                const_cast<zx_op_range_t*>(ranges), sizeof(ranges)),
+                  c.expected);
+    ASSERT_NO_FAILURES(check_untouched());
+  }
+
+  // The ranges are only taken from the buffer, which must hold a whole number of them.
+  zx_op_range_t range = {.offset = base, .size = kPageSize};
+  EXPECT_STATUS(vmar.op_range(ZX_VMAR_OP_DECOMMIT_BATCH, base, kPageSize, &range, sizeof(range)),
+                ZX_ERR_INVALID_ARGS);
+  EXPECT_STATUS(vmar.op_range(ZX_VMAR_OP_DECOMMIT_BATCH, 0, 0, &range, sizeof(range) - 1),
+                ZX_ERR_INVALID_ARGS);
+  check_untouched();
+
+  // The good range on its own goes through.
+  EXPECT_OK(vmar.op_range(ZX_VMAR_OP_DECOMMIT_BATCH, 0, 0, &range, sizeof(range)));
+  EXPECT_EQ(*reinterpret_cast<volatile uint32_t*>(base), 0u);
+}
+
+// Test zx_vmar_op_range ZX_VMAR_OP_DONT_NEED_BATCH leaves the contents alone.
+TEST(Vmar, RangeOpDontNeedBatch) {
+  const size_t kPageSize = zx_system_get_page_size();
+  zx::vmo vmo;
+  ASSERT_OK(zx::vmo::create(2 * kPageSize, 0, &vmo));
+  zx_vaddr_t base;
+  ASSERT_OK(zx::vmar::root_self()->map(ZX_VM_PERM_READ, 0, vmo, 0, 2 * kPageSize, &base));
+  auto unmap = fit::defer([&]() { zx::vmar::root_self()->unmap(base, 2 * kPageSize); });
+  const uint32_t kValue = 7;
+  ASSERT_OK(vmo.write(&kValue, kPageSize, sizeof(kValue)));
+
+  // Unlike decommit, the hint does not need the mapping to be writable.
+  const zx_op_range_t ranges[] = {
+      {.offset = base, .size = kPageSize},
+      {.offset = base + kPageSize, .size = kPageSize},
+  };
+  EXPECT_OK(zx::vmar::root_self()->op_range(ZX_VMAR_OP_DONT_NEED_BATCH, 0, 0,
+                                            const_cast<zx_op_range_t*>(ranges), sizeof(ranges)));
+  EXPECT_EQ(*reinterpret_cast<volatile uint32_t*>(base + kPageSize), kValue);
+}
+
 }  // namespace
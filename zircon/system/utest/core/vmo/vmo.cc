@@ -2014,4 +2014,161 @@ TEST(VmoTestCase, NoWriteResizable) {
                              zx_system_get_page_size(), &child));
 }
 
+// Tags each page of |vmo| with its index plus one, as vmo_test::InitPageTaggedVmo does.
+void TagPages(const zx::vmo &vmo, uint32_t page_count) {
+  for (uint32_t i = 0; i < page_count; i++) {
+    ASSERT_NO_FATAL_FAILURE(vmo_test::VmoWrite(vmo, i + 1, i * zx_system_get_page_size()));
+  }
+}
+
+TEST(VmoTestCase, DecommitBatch) {
+  const size_t kPageSize = zx_system_get_page_size();
+  constexpr uint32_t kPages = 8;
+  zx::vmo vmo;
+  ASSERT_OK(zx::vmo::create(kPages * kPageSize, 0, &vmo));
+  ASSERT_NO_FATAL_FAILURE(TagPages(vmo, kPages));
+
+  // Map the VMO, so that the pages between the ranges are in the single unmap the batch does.
+  zx_vaddr_t addr;
+  ASSERT_OK(zx::vmar::root_self()->map(ZX_VM_PERM_READ | ZX_VM_PERM_WRITE, 0, vmo, 0,
+                                       kPages * kPageSize, &addr));
+  auto unmap = fit::defer([&]() { zx::vmar::root_self()->unmap(addr, kPages * kPageSize); });
+  auto page = [addr, kPageSize](uint32_t i) {
+    return reinterpret_cast<volatile uint32_t *>(addr + i * kPageSize);
+  };
+  for (uint32_t i = 0; i < kPages; i++) {
+    EXPECT_EQ(*page(i), i + 1);
+  }
+
+  const zx_op_range_t ranges[] = {
+      {.offset = 1 * kPageSize, .size = kPageSize},
+      {.offset = 3 * kPageSize, .size = 2 * kPageSize},
+      {.offset = 6 * kPageSize, .size = kPageSize},
+  };
+  ASSERT_OK(vmo.op_range(ZX_VMO_OP_DECOMMIT_BATCH, 0, 0, const_cast<zx_op_range_t *>(ranges),
+                         sizeof(ranges)));
+  EXPECT_EQ(vmo_test::VmoCommittedBytes(vmo), 4 * kPageSize);
+
+  // Only the pages in the ranges were decommitted, through the VMO and through the mapping.
+  for (uint32_t i : {1u, 3u, 4u, 6u}) {
+    EXPECT_EQ(vmo_test::VmoRead(vmo, i * kPageSize), 0u, "page %u", i);
+    EXPECT_EQ(*page(i), 0u, "page %u", i);
+  }
+  for (uint32_t i : {0u, 2u, 5u, 7u}) {
+    EXPECT_EQ(vmo_test::VmoRead(vmo, i * kPageSize), i + 1, "page %u", i);
+    EXPECT_EQ(*page(i), i + 1, "page %u", i);
+  }
+  // Reading the decommitted pages through the mapping did not commit them again.
+  EXPECT_EQ(vmo_test::VmoCommittedBytes(vmo), 4 * kPageSize);
+
+  // A batch of no ranges does nothing.
+  EXPECT_OK(vmo.op_range(ZX_VMO_OP_DECOMMIT_BATCH, 0, 0, nullptr, 0));
+  EXPECT_EQ(vmo_test::VmoCommittedBytes(vmo), 4 * kPageSize);
+}
+
+TEST(VmoTestCase, DecommitBatchManyRanges) {
+  // More ranges than the kernel handles at a time, decommitting every other page.
+  const size_t kPageSize = zx_system_get_page_size();
+  constexpr uint32_t kPages = 80;
+  zx::vmo vmo;
+  ASSERT_OK(zx::vmo::create(kPages * kPageSize, 0, &vmo));
+  ASSERT_NO_FATAL_FAILURE(TagPages(vmo, kPages));
+
+  std::vector<zx_op_range_t> ranges;
+  for (uint32_t i = 0; i < kPages; i += 2) {
+    ranges.push_back({.offset = i * kPageSize, .size = kPageSize});
+  }
+  ASSERT_OK(vmo.op_range(ZX_VMO_OP_DECOMMIT_BATCH, 0, 0, ranges.data(),
+                         ranges.size() * sizeof(zx_op_range_t)));
+  EXPECT_EQ(vmo_test::VmoCommittedBytes(vmo), kPages / 2 * kPageSize);
+  for (uint32_t i = 0; i < kPages; i++) {
+    EXPECT_EQ(vmo_test::VmoRead(vmo, i * kPageSize), i % 2 ? i + 1 : 0u, "page %u", i);
+  }
+}
+
+TEST(VmoTestCase, DecommitBatchPartialFailure) {
+  const size_t kPageSize = zx_system_get_page_size();
+  constexpr uint32_t kPages = 4;
+  zx::vmo vmo;
+  ASSERT_OK(zx::vmo::create(kPages * kPageSize, 0, &vmo));
+  ASSERT_NO_FATAL_FAILURE(TagPages(vmo, kPages));
+
+  // The ranges before the one that fails are decommitted, the ones after it are not.
+  const zx_op_range_t ranges[] = {
+      {.offset = 0, .size = kPageSize},
+      {.offset = kPages * kPageSize, .size = kPageSize},
+      {.offset = 2 * kPageSize, .size = kPageSize},
+  };
+  EXPECT_STATUS(vmo.op_range(ZX_VMO_OP_DECOMMIT_BATCH, 0, 0, const_cast<zx_op_range_t *>(ranges),
+                             sizeof(ranges)),
+                ZX_ERR_OUT_OF_RANGE);
+  EXPECT_EQ(vmo_test::VmoCommittedBytes(vmo), (kPages - 1) * kPageSize);
+  EXPECT_EQ(vmo_test::VmoRead(vmo, 0), 0u);
+  EXPECT_EQ(vmo_test::VmoRead(vmo, 2 * kPageSize), 3u);
+
+  // An unaligned range fails the same way.
+  const zx_op_range_t unaligned[] = {
+      {.offset = kPageSize, .size = kPageSize},
+      {.offset = 2 * kPageSize + 1, .size = kPageSize},
+  };
+  EXPECT_STATUS(vmo.op_range(ZX_VMO_OP_DECOMMIT_BATCH, 0, 0,
+                             const_cast<zx_op_range_t *>(unaligned), sizeof(unaligned)),
+                ZX_ERR_INVALID_ARGS);
+  EXPECT_EQ(vmo_test::VmoCommittedBytes(vmo), (kPages - 2) * kPageSize);
+  EXPECT_EQ(vmo_test::VmoRead(vmo, kPageSize), 0u);
+  EXPECT_EQ(vmo_test::VmoRead(vmo, 2 * kPageSize), 3u);
+}
+
+TEST(VmoTestCase, BatchOpsRejectBadArguments) {
+  const size_t kPageSize = zx_system_get_page_size();
+  zx::vmo vmo;
+  ASSERT_OK(zx::vmo::create(2 * kPageSize, 0, &vmo));
+  ASSERT_NO_FATAL_FAILURE(TagPages(vmo, 2));
+  zx_op_range_t range = {.offset = 0, .size = kPageSize};
+
+  for (uint32_t op : {ZX_VMO_OP_DECOMMIT_BATCH, ZX_VMO_OP_DONT_NEED_BATCH}) {
+    // The ranges are only taken from the buffer.
+    EXPECT_STATUS(vmo.op_range(op, 0, kPageSize, &range, sizeof(range)), ZX_ERR_INVALID_ARGS);
+    EXPECT_STATUS(vmo.op_range(op, kPageSize, 0, &range, sizeof(range)), ZX_ERR_INVALID_ARGS);
+    // The buffer must hold a whole number of ranges.
+    EXPECT_STATUS(vmo.op_range(op, 0, 0, &range, sizeof(range) - 1), ZX_ERR_INVALID_ARGS);
+    // The buffer must be readable.
+    EXPECT_STATUS(vmo.op_range(op, 0, 0, nullptr, sizeof(range)), ZX_ERR_INVALID_ARGS);
+  }
+
+  // Decommitting needs the write right.
+  zx::vmo read_only;
+  ASSERT_OK(vmo.duplicate(ZX_RIGHT_READ | ZX_RIGHT_MAP | ZX_RIGHT_GET_PROPERTY, &read_only));
+  EXPECT_STATUS(read_only.op_range(ZX_VMO_OP_DECOMMIT_BATCH, 0, 0, &range, sizeof(range)),
+                ZX_ERR_ACCESS_DENIED);
+  EXPECT_EQ(vmo_test::VmoCommittedBytes(vmo), 2 * kPageSize);
+}
+
+TEST(VmoTestCase, DontNeedBatch) {
+  const size_t kPageSize = zx_system_get_page_size();
+  zx::vmo vmo;
+  ASSERT_OK(zx::vmo::create(4 * kPageSize, 0, &vmo));
+  ASSERT_NO_FATAL_FAILURE(TagPages(vmo, 4));
+
+  // The hint leaves the contents alone.
+  const zx_op_range_t ranges[] = {
+      {.offset = 0, .size = kPageSize},
+      {.offset = 2 * kPageSize, .size = 2 * kPageSize},
+  };
+  EXPECT_OK(vmo.op_range(ZX_VMO_OP_DONT_NEED_BATCH, 0, 0, const_cast<zx_op_range_t *>(ranges),
+                         sizeof(ranges)));
+  for (uint32_t i = 0; i < 4; i++) {
+    EXPECT_EQ(vmo_test::VmoRead(vmo, i * kPageSize), i + 1);
+  }
+
+  // Hints on anonymous VMOs are ignored, but a range that wraps around is still rejected.
+  const zx_op_range_t out_of_range[] = {
+      {.offset = 0, .size = kPageSize},
+      {.offset = UINT64_MAX - kPageSize + 1, .size = 2 * kPageSize},
+  };
+  EXPECT_STATUS(vmo.op_range(ZX_VMO_OP_DONT_NEED_BATCH, 0, 0,
+                             const_cast<zx_op_range_t *>(out_of_range), sizeof(out_of_range)),
+                ZX_ERR_OUT_OF_RANGE);
+}
+
 }  // namespace
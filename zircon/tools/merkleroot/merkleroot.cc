@@ -70,7 +70,7 @@ int handle_argument(char** argv, const char* arg, std::vector<FileEntry>* entrie
   }
 }
 
-void handle_entry(FileEntry* entry) {
+void handle_entry(FileEntry* entry, size_t tree_threads) {
   fbl::unique_fd fd{open(entry->filename.c_str(), O_RDONLY)};
   if (!fd) {
     perror(entry->filename.c_str());
@@ -98,7 +98,8 @@ void handle_entry(FileEntry* entry) {
   std::unique_ptr<uint8_t[]> tree;
   size_t len;
   Digest digest;
-  zx_status_t rc = MerkleTreeCreator::Create(data, info.st_size, &tree, &len, &digest);
+  zx_status_t rc =
+      MerkleTreeCreator::Create(data, info.st_size, &tree, &len, &digest, tree_threads);
   if (info.st_size != 0 && munmap(data, info.st_size) != 0) {
     perror("munmap");
     exit(1);
@@ -145,9 +146,12 @@ int main(int argc, char** argv) {
   if (!n_threads) {
     n_threads = 4;
   }
+  size_t n_cores = n_threads;
   if (n_threads > entries.size()) {
     n_threads = entries.size();
   }
+  // With fewer files than cores, spread the rest of the cores over hashing each file.
+  size_t tree_threads = n_threads ? n_cores / n_threads : 1;
   for (size_t i = n_threads; i > 0; --i) {
     threads.push_back(std::thread([&] {
       while (true) {
@@ -157,7 +161,7 @@ int main(int argc, char** argv) {
         if (j >= entries.size()) {
           return;
         }
-        handle_entry(&entries[j]);
+        handle_entry(&entries[j], tree_threads);
       }
     }));
   }